@@ -0,0 +1,470 @@
+/*****************************************************************/ /**
+ * @file   bench.cpp
+ * @brief  Contains the runner of 'coltcpp_bench'.
+ * Usage: `coltcpp_bench [options]`
+ * - `--filter <str>`: only runs the benchmarks whose name contains 'str'
+ * - `--simd <flags>`: restricts the SIMD implementations to 'flags' (such
+ *   as "SSE42" or "DEFAULT", see 'parse_simd_flags'). Implementations are
+ *   chosen once per process: to compare the instruction sets, run the
+ *   executable once per flag (see scripts/run_benchmarks.py).
+ * - `--sizes <a,b,...>`: overrides the sizes of all the benchmarks
+ * - `--min-time <ms>`: the minimum duration of a measurement (100 ms)
+ * - `--repetitions <n>`: the count of measurements (5), whose median
+ *   is reported
+ * - `--perf`: reads the hardware counters around the measurements and
+ *   reports the counts per iteration (see `perf_counters.h`)
+ * - `--json <path>`: writes the results as JSON to 'path' ('-' for stdout)
+ * - `--list`: prints the name of the benchmarks
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "bench.h"
+#include "colt/algo/detect_simd.h"
+
+namespace clt::bench
+{
+  /// @brief A registered benchmark
+  struct Benchmark
+  {
+    /// @brief The name of the benchmark
+    const char* name;
+    /// @brief The benchmark function
+    bench_fn fn;
+    /// @brief The sizes for which to run the benchmark
+    std::vector<size_t> sizes;
+  };
+
+  /// @brief The result of running a benchmark for a size
+  struct Result
+  {
+    /// @brief The benchmark
+    const Benchmark* bench;
+    /// @brief The size
+    size_t size;
+    /// @brief The iterations per repetition
+    u64 iterations;
+    /// @brief The median time of an iteration
+    double median_ns;
+    /// @brief The minimum time of an iteration
+    double min_ns;
+    /// @brief The bytes processed per iteration
+    u64 bytes;
+    /// @brief The items processed per iteration
+    u64 items;
+    /// @brief The counts of all the repetitions (empty without '--perf')
+    PerfCounts counts;
+    /// @brief The count of iterations measured by 'counts'
+    u64 measured;
+
+    /// @brief Returns a counter per iteration
+    /// @param counter The counter
+    /// @return The average count of an iteration
+    double per_iteration(PerfCounter counter) const noexcept
+    {
+      return static_cast<double>(counts[counter]) / static_cast<double>(measured);
+    }
+  };
+
+  /// @brief The options of the runner
+  struct Options
+  {
+    /// @brief Only the benchmarks containing 'filter' are run
+    std::string_view filter = {};
+    /// @brief Overrides the sizes of the benchmarks (if not empty)
+    std::vector<size_t> sizes = {};
+    /// @brief The minimum duration of a measurement
+    double min_time_ns = 100'000'000.0;
+    /// @brief The count of measurements
+    u32 repetitions = 5;
+    /// @brief The path of the JSON output (null for none)
+    const char* json = nullptr;
+    /// @brief True to only list the benchmarks
+    bool list = false;
+    /// @brief True to read the hardware counters
+    bool perf = false;
+  };
+
+  /// @brief Returns the registered benchmarks
+  /// @return The benchmarks (a function-local to not depend on the
+  ///         initialization order of the translation units)
+  static std::vector<Benchmark>& registry() noexcept
+  {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+  }
+
+  Register::Register(
+      const char* name, bench_fn fn, std::initializer_list<size_t> sizes) noexcept
+  {
+    registry().push_back({name, fn, sizes});
+  }
+
+  /// @brief Runs a repetition of a benchmark
+  /// @param fn The benchmark
+  /// @param size The size
+  /// @param iterations The count of iterations
+  /// @param counters The counters to read (or null)
+  /// @return The state after the run
+  static State run_once(
+      bench_fn fn, size_t size, u64 iterations,
+      const PerfCounters* counters) noexcept
+  {
+    State state = {size, iterations, counters};
+    fn(state);
+    return state;
+  }
+
+  /// @brief Runs a benchmark: the count of iterations is increased until
+  /// a measurement lasts at least 'min_time_ns', then repeated.
+  /// @param bench The benchmark
+  /// @param size The size
+  /// @param opt The options
+  /// @return The result
+  static Result run(const Benchmark& bench, size_t size, const Options& opt) noexcept
+  {
+    const PerfCounters* counters = opt.perf ? &PerfCounters::this_thread() : nullptr;
+    u64 iterations               = 1;
+    State state                  = run_once(bench.fn, size, iterations, counters);
+    while (state.elapsed_ns() < opt.min_time_ns && iterations < (u64{1} << 40))
+    {
+      const double elapsed = std::max(state.elapsed_ns(), 1.0);
+      // Aim 20% past the minimum time, growing by at most 10x per step
+      const double factor =
+          std::clamp(opt.min_time_ns * 1.2 / elapsed, 2.0, 10.0);
+      iterations = static_cast<u64>(static_cast<double>(iterations) * factor);
+      state      = run_once(bench.fn, size, iterations, counters);
+    }
+
+    std::vector<double> times = {state.elapsed_ns()};
+    PerfCounts counts         = state.counts();
+    for (u32 i = 1; i < opt.repetitions; i++)
+    {
+      const auto repetition = run_once(bench.fn, size, iterations, counters);
+      times.push_back(repetition.elapsed_ns());
+      counts += repetition.counts();
+    }
+    std::sort(times.begin(), times.end());
+    const double iters = static_cast<double>(iterations);
+    return {
+        &bench,
+        size,
+        iterations,
+        times[times.size() / 2] / iters,
+        times.front() / iters,
+        state.bytes_processed(),
+        state.items_processed(),
+        counts,
+        iterations * opt.repetitions};
+  }
+
+  /// @brief Converts flags to names separated by '|' (parsable by
+  ///        'parse_simd_flags')
+  /// @param flags The flags
+  /// @return The names of the flags ("DEFAULT" if none)
+  static std::string simd_names(simd_flag flags) noexcept
+  {
+    std::string ret;
+    simd_flag printed = simd_flag::DEFAULT;
+    for (const auto& [value, name] : details::SIMD_FLAG_NAMES)
+    {
+      // Flags sharing a value are only printed once
+      if (is_enabled(flags, value) && !is_enabled(printed, value))
+      {
+        if (!ret.empty())
+          ret.push_back('|');
+        ret += name;
+      }
+      printed = printed | value;
+    }
+    return ret.empty() ? "DEFAULT" : ret;
+  }
+
+  /// @brief Writes a string as a JSON string literal
+  /// @param out The output
+  /// @param str The string
+  static void write_json_string(std::string& out, std::string_view str) noexcept
+  {
+    out.push_back('"');
+    for (char c : str)
+    {
+      if (c == '"' || c == '\\')
+        out.push_back('\\');
+      if (static_cast<unsigned char>(c) < 0x20)
+        fmt::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<int>(c));
+      else
+        out.push_back(c);
+    }
+    out.push_back('"');
+  }
+
+  /// @brief Converts the results to JSON
+  /// @param results The results
+  /// @param opt The options
+  /// @return The JSON document
+  static std::string to_json(const std::vector<Result>& results, const Options& opt)
+  {
+    auto out = std::string{};
+    auto it  = std::back_inserter(out);
+    fmt::format_to(it, "{{\n  \"context\": {{\n    \"version\": ");
+    write_json_string(out, COLT_VERSION_STRING);
+    fmt::format_to(it, ",\n    \"hardware_simd\": ");
+    write_json_string(out, simd_names(detect_hardware_architectures()));
+    fmt::format_to(it, ",\n    \"simd\": ");
+    write_json_string(out, simd_names(detect_supported_architectures()));
+    fmt::format_to(
+        it, ",\n    \"min_time_ns\": {},\n    \"repetitions\": {}",
+        opt.min_time_ns, opt.repetitions);
+    if (opt.perf)
+    {
+      fmt::format_to(it, ",\n    \"perf_counters\": [");
+      const auto& counters = PerfCounters::this_thread();
+      bool first           = true;
+      for (u8 i = 0; i < PERF_COUNTER_COUNT; i++)
+      {
+        if (!counters.is_available(static_cast<PerfCounter>(i)))
+          continue;
+        fmt::format_to(it, "{}", first ? "" : ", ");
+        write_json_string(out, to_str(static_cast<PerfCounter>(i)));
+        first = false;
+      }
+      out.push_back(']');
+    }
+    fmt::format_to(it, "\n  }},\n");
+
+    // The implementations chosen while running the benchmarks
+    fmt::format_to(it, "  \"dispatches\": [");
+    auto dispatches = simd_dispatches();
+    for (size_t i = 0; i < dispatches.size(); i++)
+    {
+      fmt::format_to(it, "{}\n    {{\"function\": ", i == 0 ? "" : ",");
+      write_json_string(out, dispatches[i].function);
+      fmt::format_to(it, ", \"chosen\": ");
+      write_json_string(out, simd_names(dispatches[i].chosen));
+      out.push_back('}');
+    }
+    fmt::format_to(it, "\n  ],\n  \"benchmarks\": [");
+    for (size_t i = 0; i < results.size(); i++)
+    {
+      const auto& result = results[i];
+      fmt::format_to(it, "{}\n    {{\"name\": ", i == 0 ? "" : ",");
+      write_json_string(out, result.bench->name);
+      fmt::format_to(
+          it,
+          ", \"size\": {}, \"iterations\": {}, \"ns_per_iter\": {}, "
+          "\"min_ns_per_iter\": {}",
+          result.size, result.iterations, result.median_ns, result.min_ns);
+      if (result.bytes != 0)
+        fmt::format_to(
+            it, ", \"bytes_per_second\": {}",
+            static_cast<double>(result.bytes) * 1e9 / result.median_ns);
+      if (result.items != 0)
+        fmt::format_to(
+            it, ", \"items_per_second\": {}",
+            static_cast<double>(result.items) * 1e9 / result.median_ns);
+      // As "cycles_per_iter", "cache_misses_per_iter"...
+      for (u8 j = 0; j < PERF_COUNTER_COUNT; j++)
+      {
+        const auto counter = static_cast<PerfCounter>(j);
+        if (!result.counts.is_available(counter))
+          continue;
+        std::string key = to_str(counter);
+        std::replace(key.begin(), key.end(), '-', '_');
+        fmt::format_to(
+            it, ", \"{}_per_iter\": {}", key, result.per_iteration(counter));
+      }
+      if (result.counts.ipc() != 0.0)
+        fmt::format_to(it, ", \"ipc\": {}", result.counts.ipc());
+      out.push_back('}');
+    }
+    fmt::format_to(it, "\n  ]\n}}\n");
+    return out;
+  }
+
+  /// @brief Parses a count
+  /// @param str The string to parse
+  /// @param value The parsed value
+  /// @return True on success
+  template<typename T>
+  static bool parse_count(std::string_view str, T& value) noexcept
+  {
+    auto [ptr, err] = std::from_chars(str.data(), str.data() + str.size(), value);
+    return err == std::errc{} && ptr == str.data() + str.size();
+  }
+
+  /// @brief Parses the command line arguments
+  /// @param argc The count of arguments
+  /// @param argv The arguments
+  /// @param opt The options to fill
+  /// @return True on success
+  static bool parse_options(int argc, const char** argv, Options& opt) noexcept
+  {
+    for (int i = 1; i < argc; i++)
+    {
+      const std::string_view arg = argv[i];
+      if (arg == "--list")
+      {
+        opt.list = true;
+        continue;
+      }
+      if (arg == "--perf")
+      {
+        opt.perf = true;
+        continue;
+      }
+      if (i + 1 == argc)
+      {
+        fmt::println(stderr, "Missing value for option '{}'!", arg);
+        return false;
+      }
+      const std::string_view value = argv[++i];
+      if (arg == "--filter")
+        opt.filter = value;
+      else if (arg == "--json")
+        opt.json = argv[i];
+      else if (arg == "--simd")
+      {
+        auto flags = parse_simd_flags(value);
+        if (flags.is_none())
+        {
+          fmt::println(stderr, "Invalid instruction sets '{}'!", value);
+          return false;
+        }
+        override_simd_support(*flags);
+      }
+      else if (arg == "--min-time")
+      {
+        u64 ms;
+        if (!parse_count(value, ms) || ms == 0)
+        {
+          fmt::println(stderr, "Invalid minimum time '{}'!", value);
+          return false;
+        }
+        opt.min_time_ns = static_cast<double>(ms) * 1'000'000.0;
+      }
+      else if (arg == "--repetitions")
+      {
+        if (!parse_count(value, opt.repetitions) || opt.repetitions == 0)
+        {
+          fmt::println(stderr, "Invalid count of repetitions '{}'!", value);
+          return false;
+        }
+      }
+      else if (arg == "--sizes")
+      {
+        std::string_view sizes = value;
+        while (!sizes.empty())
+        {
+          const size_t end = std::min(sizes.find(','), sizes.size());
+          size_t size;
+          if (!parse_count(sizes.substr(0, end), size))
+          {
+            fmt::println(stderr, "Invalid sizes '{}'!", value);
+            return false;
+          }
+          opt.sizes.push_back(size);
+          sizes.remove_prefix(std::min(end + 1, sizes.size()));
+        }
+      }
+      else
+      {
+        fmt::println(stderr, "Unknown option '{}'!", arg);
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// @brief Runs the benchmarks
+  /// @param opt The options
+  /// @return The exit code
+  static int run_all(const Options& opt) noexcept
+  {
+    auto& benchmarks = registry();
+    std::sort(
+        benchmarks.begin(), benchmarks.end(), [](const auto& a, const auto& b)
+        { return std::strcmp(a.name, b.name) < 0; });
+
+    // The table goes to stderr when the JSON is written to stdout
+    const bool json_stdout = opt.json != nullptr && std::strcmp(opt.json, "-") == 0;
+    FILE* table            = json_stdout ? stderr : stdout;
+
+    if (opt.perf && PerfCounters::this_thread().available() == 0)
+      fmt::println(
+          stderr,
+          "Hardware counters are not available (see "
+          "/proc/sys/kernel/perf_event_paranoid): only reading the timestamp.");
+
+    std::vector<Result> results;
+    for (const auto& bench : benchmarks)
+    {
+      if (std::string_view{bench.name}.find(opt.filter) == std::string_view::npos)
+        continue;
+      if (opt.list)
+      {
+        fmt::println("{}", bench.name);
+        continue;
+      }
+      auto sizes = opt.sizes.empty() ? bench.sizes : opt.sizes;
+      if (sizes.empty())
+        sizes.push_back(0);
+      for (size_t size : sizes)
+      {
+        const auto& result = results.emplace_back(run(bench, size, opt));
+        fmt::print(
+            table, "{:<40} {:>9} {:>14.2f} ns {:>12}", bench.name, size,
+            result.median_ns, result.iterations);
+        if (result.bytes != 0)
+          fmt::print(
+              table, " {:>10.2f} MiB/s",
+              static_cast<double>(result.bytes) * 1e9 / result.median_ns
+                  / (1024.0 * 1024.0));
+        if (result.items != 0)
+          fmt::print(
+              table, " {:>10.2f} M/s",
+              static_cast<double>(result.items) * 1e3 / result.median_ns);
+        if (result.counts.is_available(PerfCounter::CYCLES))
+          fmt::print(
+              table, " {:>10.1f} cycles",
+              result.per_iteration(PerfCounter::CYCLES));
+        if (result.counts.ipc() != 0.0)
+          fmt::print(table, " {:>5.2f} IPC", result.counts.ipc());
+        fmt::println(table, "");
+        std::fflush(table);
+      }
+    }
+    if (opt.list || opt.json == nullptr)
+      return 0;
+
+    const auto json = to_json(results, opt);
+    FILE* file      = json_stdout ? stdout : std::fopen(opt.json, "w");
+    if (file == nullptr)
+    {
+      fmt::println(stderr, "Could not open '{}'!", opt.json);
+      return 1;
+    }
+    std::fputs(json.c_str(), file);
+    if (!json_stdout)
+      std::fclose(file);
+    return 0;
+  }
+} // namespace clt::bench
+
+int main(int argc, const char** argv)
+{
+  clt::bench::Options opt;
+  if (!clt::bench::parse_options(argc, argv, opt))
+    return 1;
+  return clt::bench::run_all(opt);
+}
@@ -0,0 +1,194 @@
+/*****************************************************************/ /**
+ * @file   bench.h
+ * @brief  Contains the microbenchmark harness of 'coltcpp_bench'.
+ * A benchmark is a function taking a State, which runs the measured
+ * code while 'keep_running' returns true:
+ * @code{.cpp}
+ * static void bench_strlen(bench::State& state)
+ * {
+ *   auto str = make_string(state.size()); // not measured
+ *   while (state.keep_running())
+ *     bench::do_not_optimize(uni::strlen(str.data()));
+ *   state.set_bytes_processed(state.size());
+ * }
+ * COLT_BENCHMARK("uni::strlen", bench_strlen, 64, 4096);
+ * @endcode
+ * The harness chooses the count of iterations so that each measurement
+ * lasts at least the minimum time, and reports the median of the
+ * repetitions. With '--perf', the hardware counters (`perf_counters.h`)
+ * are read around the measured iterations.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_BENCH_BENCH
+#define HG_BENCH_BENCH
+
+#include <atomic>
+#include <chrono>
+#include <initializer_list>
+
+#include "colt/typedefs.h"
+#include "colt/macros.h"
+#include "colt/perf_counters.h"
+
+namespace clt::bench
+{
+  /// @brief The state of a running benchmark
+  class State
+  {
+    /// @brief The clock used for measurements
+    using clock = std::chrono::steady_clock;
+
+    /// @brief The size parameter of the benchmark
+    size_t size_;
+    /// @brief The iterations that were not run
+    u64 remaining;
+    /// @brief The count of iterations to run
+    u64 iterations_;
+    /// @brief The bytes processed per iteration
+    u64 bytes = 0;
+    /// @brief The items processed per iteration
+    u64 items = 0;
+    /// @brief The start of the measurement
+    clock::time_point start{};
+    /// @brief The end of the measurement
+    clock::time_point end{};
+    /// @brief The counters to read around the measurement (or null)
+    const PerfCounters* counters;
+    /// @brief The counts at the start of the measurement
+    PerfCounts counts_begin{};
+    /// @brief The counts of the measurement
+    PerfCounts counts_{};
+    /// @brief True once the first iteration started
+    bool started = false;
+
+  public:
+    /// @brief Constructor
+    /// @param size The size parameter of the benchmark
+    /// @param iterations The count of iterations to run
+    /// @param counters The counters to read around the measurement (or null)
+    constexpr State(
+        size_t size, u64 iterations, const PerfCounters* counters = nullptr) noexcept
+        : size_(size)
+        , remaining(iterations)
+        , iterations_(iterations)
+        , counters(counters)
+    {
+    }
+
+    /// @brief Returns true while iterations should be run.
+    /// The measurement starts on the first call, so that the setup of
+    /// the benchmark is not measured, and ends on the last call.
+    /// @return True if an iteration should be run
+    HEDLEY_ALWAYS_INLINE bool keep_running() noexcept
+    {
+      if (remaining != 0) [[likely]]
+      {
+        if (!started) [[unlikely]]
+        {
+          started = true;
+          start   = clock::now();
+          if (counters != nullptr)
+            counts_begin = counters->read();
+        }
+        --remaining;
+        return true;
+      }
+      if (counters != nullptr)
+        counts_ = counters->read() - counts_begin;
+      end = clock::now();
+      return false;
+    }
+
+    /// @brief Returns the size parameter of the benchmark
+    /// @return The size (whose meaning depends on the benchmark)
+    constexpr size_t size() const noexcept { return size_; }
+    /// @brief Returns the count of iterations to run
+    /// @return The count of iterations
+    constexpr u64 iterations() const noexcept { return iterations_; }
+
+    /// @brief Sets the bytes processed by each iteration (to report a throughput)
+    /// @param per_iteration The count of bytes
+    constexpr void set_bytes_processed(u64 per_iteration) noexcept
+    {
+      bytes = per_iteration;
+    }
+    /// @brief Sets the items processed by each iteration (to report a rate)
+    /// @param per_iteration The count of items
+    constexpr void set_items_processed(u64 per_iteration) noexcept
+    {
+      items = per_iteration;
+    }
+
+    /// @brief Returns the bytes processed by each iteration
+    /// @return The count of bytes (0 if not set)
+    constexpr u64 bytes_processed() const noexcept { return bytes; }
+    /// @brief Returns the items processed by each iteration
+    /// @return The count of items (0 if not set)
+    constexpr u64 items_processed() const noexcept { return items; }
+
+    /// @brief Returns the counts of the measurement
+    /// @return The counts (empty if no counters were read)
+    constexpr const PerfCounts& counts() const noexcept { return counts_; }
+
+    /// @brief Returns the duration of the measurement
+    /// @return The duration in nanoseconds (0 if no iteration ran)
+    double elapsed_ns() const noexcept
+    {
+      if (!started)
+        return 0.0;
+      return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+  };
+
+  /// @brief Prevents the compiler from optimizing out the computation of 'value'
+  /// @tparam T The type of the value
+  /// @param value The value to keep
+  template<typename T>
+  HEDLEY_ALWAYS_INLINE void do_not_optimize(const T& value) noexcept
+  {
+#if defined(COLT_MSVC)
+    // No inline assembly on MSVC x64: a volatile read of the address
+    static const volatile void* sink;
+    sink = &value;
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif // COLT_MSVC
+  }
+
+  /// @brief Prevents the compiler from assuming anything about memory
+  /// (forces pending writes to be performed)
+  HEDLEY_ALWAYS_INLINE void clobber_memory() noexcept
+  {
+#if defined(COLT_MSVC)
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#else
+    asm volatile("" : : : "memory");
+#endif // COLT_MSVC
+  }
+
+  /// @brief A benchmark function
+  using bench_fn = void (*)(State&);
+
+  /// @brief Registers a benchmark (at static initialization)
+  struct Register
+  {
+    /// @brief Registers a benchmark run once per size
+    /// @param name The name of the benchmark (which must outlive the program)
+    /// @param fn The benchmark function
+    /// @param sizes The sizes for which to run the benchmark
+    Register(
+        const char* name, bench_fn fn, std::initializer_list<size_t> sizes) noexcept;
+  };
+} // namespace clt::bench
+
+/// @brief Registers a benchmark function.
+/// The arguments following the function are the sizes for which to run it
+/// (the benchmark runs once with size 0 if none are specified).
+/// A template-id containing commas must be parenthesized.
+#define COLT_BENCHMARK(name, fn, ...)                                       \
+  static const ::clt::bench::Register COLT_CONCAT(colt_bench_, __LINE__) = { \
+      name, fn, {__VA_ARGS__}}
+
+#endif // !HG_BENCH_BENCH
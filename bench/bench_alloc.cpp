@@ -0,0 +1,89 @@
+/*****************************************************************/ /**
+ * @file   bench_alloc.cpp
+ * @brief  Benchmarks of the composable allocators.
+ * Each iteration allocates 'size' blocks of random sizes in [16, 256],
+ * then deallocates them in a random order (an arena is reset instead).
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "colt/mem/arena_alloc.h"
+#include "colt/mem/composable_alloc.h"
+#include "colt/mem/simple_alloc.h"
+
+namespace clt::bench
+{
+  template<typename Alloc>
+  /// @brief Benchmarks allocating and deallocating blocks
+  /// @tparam Alloc The allocator
+  static void bench_churn(State& state)
+  {
+    std::mt19937 rng{42};
+    std::vector<u64> sizes(state.size());
+    for (auto& size : sizes)
+      size = 16 + rng() % 241;
+    std::vector<size_t> order(state.size());
+    for (size_t i = 0; i < order.size(); i++)
+      order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+
+    Alloc alloc;
+    std::vector<mem::MemBlock> blocks(state.size());
+    while (state.keep_running())
+    {
+      for (size_t i = 0; i < sizes.size(); i++)
+        blocks[i] = alloc.alloc(sizes[i]);
+      clobber_memory();
+      if constexpr (requires { alloc.reset(); })
+        alloc.reset();
+      else
+      {
+        for (size_t i : order)
+          alloc.dealloc(blocks[i]);
+      }
+    }
+    state.set_items_processed(state.size());
+  }
+
+  /// @brief Pools stacked by size class (whose slabs are pages),
+  ///        falling back to malloc
+  using Pools = mem::Segregator<
+      64, mem::PoolAllocator<64, 16, mem::PageAllocator>,
+      mem::Segregator<
+          128, mem::PoolAllocator<128, 16, mem::PageAllocator>,
+          mem::Segregator<
+              256, mem::PoolAllocator<256, 16, mem::PageAllocator>,
+              mem::Mallocator>>>;
+
+  /// @brief A free list searched linearly
+  using List = mem::FreeList<mem::Mallocator, 16, 256, 1024>;
+  /// @brief A free list per size class
+  using Segregated = mem::SegregatedFreeList<mem::Mallocator, 16, 256, 16, 1024>;
+  /// @brief An arena growing by chunks of 64KiB
+  using Arena = mem::ArenaAllocator<mem::Mallocator>;
+  /// @brief Magazines per thread
+  using Caching = mem::ThreadCachingAllocator<mem::Mallocator, 16, 256>;
+
+  /// @brief A free list shared by threads
+  using SharedFreeList =
+      mem::ThreadSafeAllocator<mem::SegregatedFreeList<mem::Mallocator, 16, 256>>;
+
+  // clang-format off
+#define COLT_ALLOC_SIZES 16, 1024, 16 * 1024
+
+  COLT_BENCHMARK("mem::Mallocator", bench_churn<mem::Mallocator>, COLT_ALLOC_SIZES);
+  COLT_BENCHMARK("mem::FreeList", bench_churn<List>, COLT_ALLOC_SIZES);
+  COLT_BENCHMARK("mem::SegregatedFreeList", bench_churn<Segregated>, COLT_ALLOC_SIZES);
+  COLT_BENCHMARK("mem::PoolAllocator", bench_churn<Pools>, COLT_ALLOC_SIZES);
+  COLT_BENCHMARK("mem::ArenaAllocator", bench_churn<Arena>, COLT_ALLOC_SIZES);
+  COLT_BENCHMARK("mem::ThreadSafeAllocator", bench_churn<SharedFreeList>, COLT_ALLOC_SIZES);
+  COLT_BENCHMARK("mem::ThreadCachingAllocator", bench_churn<Caching>, COLT_ALLOC_SIZES);
+
+#undef COLT_ALLOC_SIZES
+  // clang-format on
+} // namespace clt::bench
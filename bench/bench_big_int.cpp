@@ -0,0 +1,122 @@
+/*****************************************************************/ /**
+ * @file   bench_big_int.cpp
+ * @brief  Benchmarks of the operations of BigInt.
+ * The size is the count of decimal digits of the operands: small
+ * sizes measure the inline (non-allocating) path of BigInt.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include <iterator>
+#include <random>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "bench.h"
+#include "colt/num/big_int.h"
+
+namespace clt::bench
+{
+  /// @brief Generates a random positive BigInt
+  /// @param digits The count of decimal digits
+  /// @param seed The seed of the generator
+  /// @return The BigInt
+  static num::BigInt random_big_int(size_t digits, u64 seed) noexcept
+  {
+    std::mt19937_64 rng{seed};
+    std::string str = {static_cast<char>('1' + rng() % 9)};
+    for (size_t i = 1; i < digits; i++)
+      str.push_back(static_cast<char>('0' + rng() % 10));
+    return *num::BigInt::from(str.c_str(), 10);
+  }
+
+  /// @brief Benchmarks additions
+  static void bench_add(State& state)
+  {
+    const auto a = random_big_int(state.size(), 1);
+    const auto b = random_big_int(state.size(), 2);
+    num::BigInt result;
+    while (state.keep_running())
+    {
+      result = a;
+      result += b;
+      do_not_optimize(result);
+    }
+  }
+
+  /// @brief Benchmarks multiplications
+  static void bench_mul(State& state)
+  {
+    const auto a = random_big_int(state.size(), 1);
+    const auto b = random_big_int(state.size(), 2);
+    num::BigInt result;
+    while (state.keep_running())
+    {
+      result = a * b;
+      do_not_optimize(result);
+    }
+  }
+
+  /// @brief Benchmarks fused multiply-adds
+  static void bench_mul_add(State& state)
+  {
+    const auto a = random_big_int(state.size(), 1);
+    const auto b = random_big_int(state.size(), 2);
+    const auto c = random_big_int(state.size(), 3);
+    num::BigInt result;
+    while (state.keep_running())
+    {
+      result = a * b + c;
+      do_not_optimize(result);
+    }
+  }
+
+  /// @brief Benchmarks divisions (of a 2 * size digits dividend)
+  static void bench_div(State& state)
+  {
+    const auto a = random_big_int(2 * state.size(), 1);
+    const auto b = random_big_int(state.size(), 2);
+    num::BigInt result;
+    while (state.keep_running())
+    {
+      result = a / b;
+      do_not_optimize(result);
+    }
+  }
+
+  /// @brief Benchmarks formatting to text
+  static void bench_format(State& state)
+  {
+    const auto a = random_big_int(state.size(), 1);
+    fmt::memory_buffer buffer;
+    while (state.keep_running())
+    {
+      buffer.clear();
+      fmt::format_to(std::back_inserter(buffer), "{}", a);
+      do_not_optimize(buffer.size());
+    }
+  }
+
+  /// @brief Benchmarks parsing from text
+  static void bench_from(State& state)
+  {
+    const auto text = fmt::format("{}", random_big_int(state.size(), 1));
+    while (state.keep_running())
+      do_not_optimize(num::BigInt::from(text.c_str(), 10));
+    state.set_bytes_processed(text.size());
+  }
+
+  // clang-format off
+#define COLT_BIG_INT_SIZES 9, 40, 400, 4000
+
+  COLT_BENCHMARK("BigInt/add", bench_add, COLT_BIG_INT_SIZES);
+  COLT_BENCHMARK("BigInt/mul", bench_mul, COLT_BIG_INT_SIZES);
+  COLT_BENCHMARK("BigInt/mul_add", bench_mul_add, COLT_BIG_INT_SIZES);
+  COLT_BENCHMARK("BigInt/div", bench_div, COLT_BIG_INT_SIZES);
+  COLT_BENCHMARK("BigInt/format", bench_format, COLT_BIG_INT_SIZES);
+  COLT_BENCHMARK("BigInt/from", bench_from, COLT_BIG_INT_SIZES);
+
+#undef COLT_BIG_INT_SIZES
+  // clang-format on
+} // namespace clt::bench
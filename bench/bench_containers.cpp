@@ -0,0 +1,192 @@
+/*****************************************************************/ /**
+ * @file   bench_containers.cpp
+ * @brief  Benchmarks of the hash containers (Map, Set and TrieMap).
+ * Each container is filled with 'size' random keys, then searched for
+ * keys that are (hit) or not (miss) part of it.
+ * The longest match of operators is compared between TrieMap and the
+ * compile-time DFA of meta::token_table.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "colt/dsa/map.h"
+#include "colt/dsa/set.h"
+#include "colt/dsa/trie.h"
+#include "colt/meta/token_table.h"
+
+namespace clt::bench
+{
+  /// @brief Generates distinct random integers
+  /// @param size The count of integers
+  /// @param seed The seed of the generator
+  /// @return The integers
+  static std::vector<u64> random_keys(size_t size, u64 seed) noexcept
+  {
+    std::mt19937_64 rng{seed};
+    std::vector<u64> ret(size);
+    for (auto& key : ret)
+      key = rng() | 1; // Misses are generated even
+    return ret;
+  }
+
+  /// @brief Generates random identifiers (of 4 to 20 characters)
+  /// @param size The count of identifiers
+  /// @param seed The seed of the generator
+  /// @return The identifiers
+  static std::vector<std::string> random_words(size_t size, u64 seed) noexcept
+  {
+    std::mt19937_64 rng{seed};
+    std::vector<std::string> ret(size);
+    for (auto& word : ret)
+    {
+      const size_t length = 4 + rng() % 17;
+      for (size_t i = 0; i < length; i++)
+        word.push_back(static_cast<char>('a' + rng() % 26));
+    }
+    return ret;
+  }
+
+  /// @brief Benchmarks inserting integers in a Map
+  static void bench_map_insert(State& state)
+  {
+    const auto keys = random_keys(state.size(), 42);
+    while (state.keep_running())
+    {
+      Map<u64, u64> map;
+      for (u64 key : keys)
+        map.insert({key, key});
+      do_not_optimize(map.size());
+    }
+    state.set_items_processed(state.size());
+  }
+
+  template<bool HIT>
+  /// @brief Benchmarks searching integers in a Map
+  static void bench_map_find(State& state)
+  {
+    const auto keys = random_keys(state.size(), 42);
+    Map<u64, u64> map;
+    for (u64 key : keys)
+      map.insert({key, key});
+    auto search = keys;
+    if constexpr (!HIT)
+    {
+      for (auto& key : search)
+        key ^= 1;
+    }
+    while (state.keep_running())
+    {
+      for (u64 key : search)
+        do_not_optimize(map.find(key) != map.end());
+    }
+    state.set_items_processed(state.size());
+  }
+
+  /// @brief Benchmarks inserting then searching integers in a Set
+  static void bench_set(State& state)
+  {
+    const auto keys = random_keys(state.size(), 42);
+    while (state.keep_running())
+    {
+      Set<u64> set;
+      for (u64 key : keys)
+        set.insert(key);
+      for (u64 key : keys)
+        do_not_optimize(set.contains(key));
+    }
+    state.set_items_processed(2 * state.size());
+  }
+
+  /// @brief Benchmarks inserting strings in a TrieMap
+  static void bench_trie_insert(State& state)
+  {
+    const auto words = random_words(state.size(), 42);
+    while (state.keep_running())
+    {
+      TrieMap<char, u64> trie;
+      for (size_t i = 0; i < words.size(); i++)
+        trie.insert_ks(words[i].data(), words[i].size(), i);
+      do_not_optimize(trie.size());
+    }
+    state.set_items_processed(state.size());
+  }
+
+  /// @brief Benchmarks searching strings in a TrieMap
+  static void bench_trie_find(State& state)
+  {
+    const auto words = random_words(state.size(), 42);
+    TrieMap<char, u64> trie;
+    for (size_t i = 0; i < words.size(); i++)
+      trie.insert_ks(words[i].data(), words[i].size(), i);
+    while (state.keep_running())
+    {
+      for (const auto& word : words)
+        do_not_optimize(trie.find_ks(word.data(), word.size()) != trie.end());
+    }
+    state.set_items_processed(state.size());
+  }
+
+  /// @brief The operators whose longest match is benchmarked
+  using Operators = meta::token_table<
+      "+", "++", "+=", "-", "--", "-=", "->", "*", "*=", "/", "/=", "%", "%=",
+      "<", "<<", "<=", "<<=", ">", ">>", ">=", ">>=", "=", "==", "!", "!=",
+      "&", "&&", "&=", "|", "||", "|=", "^", "^=", "~", ".", "...", "::">;
+
+  /// @brief Generates random operators followed by a random character
+  /// @param size The count of strings
+  /// @param seed The seed of the generator
+  /// @return The strings
+  static std::vector<std::string> random_operators(size_t size, u64 seed) noexcept
+  {
+    std::mt19937_64 rng{seed};
+    std::vector<std::string> ret(size);
+    for (auto& str : ret)
+    {
+      str = Operators::keys[rng() % Operators::size];
+      str.push_back("+-<=.a "[rng() % 7]);
+    }
+    return ret;
+  }
+
+  template<bool DFA>
+  /// @brief Benchmarks the longest match of operators using a TrieMap or
+  ///        a token_table
+  static void bench_longest_match(State& state)
+  {
+    const auto strs = random_operators(state.size(), 42);
+    TrieMap<char, size_t> trie;
+    for (size_t i = 0; i < Operators::size; i++)
+      trie.insert_ks(Operators::keys[i].data(), Operators::keys[i].size(), i);
+    while (state.keep_running())
+    {
+      for (const auto& str : strs)
+      {
+        if constexpr (DFA)
+          do_not_optimize(Operators::longest_match(str));
+        else
+          do_not_optimize(trie.longest_match(str.data(), str.size()));
+      }
+    }
+    state.set_items_processed(state.size());
+  }
+
+  // clang-format off
+#define COLT_CONTAINER_SIZES 64, 4096, 256 * 1024
+
+  COLT_BENCHMARK("Map<u64, u64>/insert", bench_map_insert, COLT_CONTAINER_SIZES);
+  COLT_BENCHMARK("Map<u64, u64>/find_hit", bench_map_find<true>, COLT_CONTAINER_SIZES);
+  COLT_BENCHMARK("Map<u64, u64>/find_miss", bench_map_find<false>, COLT_CONTAINER_SIZES);
+  COLT_BENCHMARK("Set<u64>/insert_contains", bench_set, COLT_CONTAINER_SIZES);
+  COLT_BENCHMARK("TrieMap<char, u64>/insert", bench_trie_insert, COLT_CONTAINER_SIZES);
+  COLT_BENCHMARK("TrieMap<char, u64>/find", bench_trie_find, COLT_CONTAINER_SIZES);
+  COLT_BENCHMARK("TrieMap<char, size_t>/longest_match", bench_longest_match<false>, 4096);
+  COLT_BENCHMARK("token_table/longest_match", bench_longest_match<true>, 4096);
+
+#undef COLT_CONTAINER_SIZES
+  // clang-format on
+} // namespace clt::bench
@@ -0,0 +1,110 @@
+/*****************************************************************/ /**
+ * @file   bench_format.cpp
+ * @brief  Benchmarks of parsing (`parse.h`) and printing (`print.h`).
+ * Each iteration parses or formats 'size' values.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "bench.h"
+#include "colt/io/parse.h"
+#include "colt/io/print.h"
+
+namespace clt::bench
+{
+  template<typename T>
+  /// @brief Generates the text of random numbers
+  /// @tparam T The type of the numbers
+  /// @param size The count of numbers
+  /// @return The numbers as text
+  static std::vector<std::string> random_numbers(size_t size) noexcept
+  {
+    std::mt19937_64 rng{42};
+    std::vector<std::string> ret(size);
+    for (auto& str : ret)
+    {
+      if constexpr (std::floating_point<T>)
+        str = fmt::format("{}", std::uniform_real_distribution<T>{-1e9, 1e9}(rng));
+      else // Numbers of varying count of digits
+        str = fmt::format("{}", static_cast<T>(rng() >> (rng() % 64)));
+    }
+    return ret;
+  }
+
+  template<typename T>
+  /// @brief Benchmarks parse (through scnlib)
+  static void bench_parse(State& state)
+  {
+    const auto numbers = random_numbers<T>(state.size());
+    while (state.keep_running())
+    {
+      for (const auto& str : numbers)
+        do_not_optimize(parse<T>(str));
+    }
+    state.set_items_processed(state.size());
+  }
+
+  template<typename T>
+  /// @brief Benchmarks parse_int or parse_float
+  static void bench_parse_fast(State& state)
+  {
+    const auto numbers = random_numbers<T>(state.size());
+    while (state.keep_running())
+    {
+      for (const auto& str : numbers)
+      {
+        if constexpr (std::floating_point<T>)
+          do_not_optimize(parse_float<T>(str));
+        else
+          do_not_optimize(parse_int<T>(str));
+      }
+    }
+    state.set_items_processed(state.size());
+  }
+
+  /// @brief Benchmarks formatting to a buffer
+  static void bench_format_to(State& state)
+  {
+    std::mt19937_64 rng{42};
+    std::vector<u64> values(state.size());
+    for (auto& value : values)
+      value = rng();
+    fmt::memory_buffer buffer;
+    while (state.keep_running())
+    {
+      buffer.clear();
+      for (u64 value : values)
+        clt::format_to(std::back_inserter(buffer), "{} {:.3f}\n", value, 0.5);
+      do_not_optimize(buffer.size());
+    }
+    state.set_items_processed(state.size());
+  }
+
+  /// @brief Benchmarks printing to a file (the null device)
+  static void bench_print(State& state)
+  {
+    auto& null = File::get_null_device();
+    while (state.keep_running())
+    {
+      for (size_t i = 0; i < state.size(); i++)
+        do_not_optimize(print(null, "{} {} {:.3f}", "value", i, 0.5));
+    }
+    state.set_items_processed(state.size());
+  }
+
+  COLT_BENCHMARK("parse<u64>", bench_parse<u64>, 1024);
+  COLT_BENCHMARK("parse<i32>", bench_parse<i32>, 1024);
+  COLT_BENCHMARK("parse<f64>", bench_parse<f64>, 1024);
+  COLT_BENCHMARK("parse_int<u64>", bench_parse_fast<u64>, 1024);
+  COLT_BENCHMARK("parse_int<i32>", bench_parse_fast<i32>, 1024);
+  COLT_BENCHMARK("parse_float<f64>", bench_parse_fast<f64>, 1024);
+  COLT_BENCHMARK("format_to", bench_format_to, 1024);
+  COLT_BENCHMARK("print/null_device", bench_print, 1024);
+} // namespace clt::bench
@@ -0,0 +1,77 @@
+/*****************************************************************/ /**
+ * @file   bench_hash.cpp
+ * @brief  Benchmarks of the hash algorithms of `hash.h`.
+ * The algorithms hash a buffer of 'size' bytes, while the universal
+ * hasher hashes 'size' integers (the use of Map and Set).
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "colt/hash.h"
+
+namespace clt::bench
+{
+  /// @brief Generates random bytes
+  /// @param size The count of bytes
+  /// @return The bytes
+  static std::vector<u8> random_bytes(size_t size) noexcept
+  {
+    std::mt19937 rng{42};
+    std::vector<u8> ret(size);
+    for (auto& byte : ret)
+      byte = static_cast<u8>(rng());
+    return ret;
+  }
+
+  template<meta::hash_algorithm Algo>
+  /// @brief Benchmarks hashing a buffer
+  /// @tparam Algo The hash algorithm
+  static void bench_hash_bytes(State& state)
+  {
+    const auto bytes = random_bytes(state.size());
+    while (state.keep_running())
+    {
+      Algo algo;
+      algo(bytes.data(), bytes.size());
+      do_not_optimize(static_cast<typename Algo::result_type>(algo));
+    }
+    state.set_bytes_processed(state.size());
+  }
+
+  template<meta::hash_algorithm Algo>
+  /// @brief Benchmarks hashing integers through the universal hasher
+  /// @tparam Algo The hash algorithm
+  static void bench_uhash_u64(State& state)
+  {
+    std::mt19937_64 rng{42};
+    std::vector<u64> keys(state.size());
+    for (auto& key : keys)
+      key = rng();
+    const uhash<Algo> hasher;
+    while (state.keep_running())
+    {
+      for (u64 key : keys)
+        do_not_optimize(hasher(key));
+    }
+    state.set_items_processed(state.size());
+  }
+
+  // clang-format off
+#define COLT_HASH_SIZES 8, 32, 256, 4096, 1024 * 1024
+
+  COLT_BENCHMARK("hash/fnv1a_h", bench_hash_bytes<fnv1a_h>, COLT_HASH_SIZES);
+  COLT_BENCHMARK("hash/murmur64a_h", bench_hash_bytes<murmur64a_h>, COLT_HASH_SIZES);
+  COLT_BENCHMARK("hash/siphash24_h", bench_hash_bytes<siphash24_h>, COLT_HASH_SIZES);
+  COLT_BENCHMARK("hash/wyhash_h", bench_hash_bytes<wyhash_h>, COLT_HASH_SIZES);
+  COLT_BENCHMARK("uhash<fnv1a_h>/u64", bench_uhash_u64<fnv1a_h>, 1024);
+  COLT_BENCHMARK("uhash<murmur64a_h>/u64", bench_uhash_u64<murmur64a_h>, 1024);
+  COLT_BENCHMARK("uhash<siphash24_h>/u64", bench_uhash_u64<siphash24_h>, 1024);
+  COLT_BENCHMARK("uhash<wyhash_h>/u64", bench_uhash_u64<wyhash_h>, 1024);
+
+#undef COLT_HASH_SIZES
+  // clang-format on
+} // namespace clt::bench
@@ -0,0 +1,127 @@
+/*****************************************************************/ /**
+ * @file   bench_queues.cpp
+ * @brief  Benchmarks of the concurrent queues (SpscRing and MpmcQueue).
+ * The measured thread competes with helper threads started before the
+ * measurement (and stopped after it): the reported rate is the count
+ * of operations of the measured thread, under contention.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "colt/dsa/concurrent_queue.h"
+
+namespace clt::bench
+{
+  /// @brief Benchmarks pushing 'size' integers in a SpscRing that a
+  ///        consumer thread drains
+  static void bench_spsc(State& state)
+  {
+    SpscRing<u64, 1024> ring;
+    std::atomic<bool> stop = false;
+    std::thread consumer{[&]
+                         {
+                           u64 out[64];
+                           while (!stop.load(std::memory_order_relaxed))
+                             do_not_optimize(ring.pop_batch(out));
+                         }};
+    while (state.keep_running())
+    {
+      for (u64 i = 0; i < state.size(); i++)
+      {
+        while (!ring.push(i))
+          std::this_thread::yield();
+      }
+    }
+    stop = true;
+    consumer.join();
+    state.set_items_processed(state.size());
+  }
+
+  /// @brief Benchmarks pushing 'size' integers in a SpscRing in batches
+  ///        of 64, that a consumer thread drains
+  static void bench_spsc_batch(State& state)
+  {
+    SpscRing<u64, 1024> ring;
+    std::atomic<bool> stop = false;
+    std::thread consumer{[&]
+                         {
+                           u64 out[64];
+                           while (!stop.load(std::memory_order_relaxed))
+                             do_not_optimize(ring.pop_batch(out));
+                         }};
+    u64 batch[64] = {};
+    while (state.keep_running())
+    {
+      for (u64 i = 0; i < state.size();)
+      {
+        const u64 count = state.size() - i < 64 ? state.size() - i : 64;
+        const u64 pushed = ring.push_batch({batch, count});
+        if (pushed == 0)
+          std::this_thread::yield();
+        i += pushed;
+      }
+    }
+    stop = true;
+    consumer.join();
+    state.set_items_processed(state.size());
+  }
+
+  template<bool BATCH>
+  /// @brief Benchmarks pushing then popping integers in a MpmcQueue,
+  ///        while 'size - 1' other threads do the same
+  static void bench_mpmc(State& state)
+  {
+    MpmcQueue<u64> queue{1024};
+    std::atomic<bool> stop = false;
+    auto run               = [&queue]
+    {
+      u64 values[16] = {};
+      if constexpr (BATCH)
+      {
+        do_not_optimize(queue.push_batch(values));
+        do_not_optimize(queue.pop_batch(values));
+      }
+      else
+      {
+        for (u64 value : values)
+          do_not_optimize(queue.push(value));
+        for (size_t i = 0; i < 16; i++)
+          do_not_optimize(queue.pop());
+      }
+    };
+    // The sizes may be overridden: at most one thread per hardware thread
+    const size_t threads =
+        std::min<size_t>(state.size(), std::thread::hardware_concurrency());
+    std::vector<std::thread> helpers;
+    for (size_t i = 1; i < threads; i++)
+    {
+      helpers.emplace_back(
+          [&]
+          {
+            while (!stop.load(std::memory_order_relaxed))
+              run();
+          });
+    }
+    while (state.keep_running())
+      run();
+    stop = true;
+    for (auto& helper : helpers)
+      helper.join();
+    // 16 pushes and 16 pops per iteration
+    state.set_items_processed(32);
+  }
+
+  // clang-format off
+  COLT_BENCHMARK("SpscRing<u64, 1024>/push", bench_spsc, 4096);
+  COLT_BENCHMARK("SpscRing<u64, 1024>/push_batch", bench_spsc_batch, 4096);
+  // The size is the count of threads using the queue
+  COLT_BENCHMARK("MpmcQueue<u64>/push_pop", bench_mpmc<false>, 1, 2, 4, 8);
+  COLT_BENCHMARK("MpmcQueue<u64>/push_pop_batch", bench_mpmc<true>, 1, 2, 4, 8);
+  // clang-format on
+} // namespace clt::bench
@@ -0,0 +1,264 @@
+/*****************************************************************/ /**
+ * @file   bench_unicode.cpp
+ * @brief  Benchmarks of the length kernels of `unicode.cpp` (and of
+ *         `uni::display_width` and `uni::utf16_len`).
+ * Each kernel is run on ASCII and on mixed text (1 to 4 bytes UTF8
+ * sequences, with surrogate pairs in UTF16), for each encoding.
+ * The size is the count of code points of the string.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include <concepts>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "colt/unicode/unicode.h"
+#include "colt/unicode/display_width.h"
+
+namespace clt::bench
+{
+  /// @brief The content of the generated strings
+  enum class Content : u8
+  {
+    /// @brief Only ASCII code points
+    Ascii,
+    /// @brief Mostly ASCII, with 2, 3 and 4 bytes UTF8 sequences
+    Mixed,
+  };
+
+  /// @brief Generates random code points (without NUL or surrogates)
+  /// @param count The count of code points
+  /// @param content The content of the string
+  /// @return The code points
+  static std::vector<char32_t> code_points(size_t count, Content content) noexcept
+  {
+    std::mt19937 rng{42};
+    std::vector<char32_t> ret;
+    ret.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+      const u32 kind = content == Content::Ascii ? 0 : static_cast<u32>(rng() % 20);
+      if (kind < 14)
+        ret.push_back(static_cast<char32_t>(0x20 + rng() % 0x5F));
+      else if (kind < 17)
+        ret.push_back(static_cast<char32_t>(0x80 + rng() % 0x780));
+      else if (kind < 19)
+        ret.push_back(static_cast<char32_t>(0x800 + rng() % 0x7800)); // < 0xD800
+      else
+        ret.push_back(static_cast<char32_t>(0x10000 + rng() % 0x100000));
+    }
+    return ret;
+  }
+
+  /// @brief Encodes code points to NUL-terminated UTF8
+  /// @param count The count of code points
+  /// @param content The content of the string
+  /// @return The units (including the NUL-terminator)
+  static std::vector<char8_t> make_utf8(size_t count, Content content) noexcept
+  {
+    std::vector<char8_t> ret;
+    for (char32_t cp : code_points(count, content))
+    {
+      if (cp < 0x80)
+        ret.push_back(static_cast<char8_t>(cp));
+      else if (cp < 0x800)
+      {
+        ret.push_back(static_cast<char8_t>(0xC0 | (cp >> 6)));
+        ret.push_back(static_cast<char8_t>(0x80 | (cp & 0x3F)));
+      }
+      else if (cp < 0x10000)
+      {
+        ret.push_back(static_cast<char8_t>(0xE0 | (cp >> 12)));
+        ret.push_back(static_cast<char8_t>(0x80 | ((cp >> 6) & 0x3F)));
+        ret.push_back(static_cast<char8_t>(0x80 | (cp & 0x3F)));
+      }
+      else
+      {
+        ret.push_back(static_cast<char8_t>(0xF0 | (cp >> 18)));
+        ret.push_back(static_cast<char8_t>(0x80 | ((cp >> 12) & 0x3F)));
+        ret.push_back(static_cast<char8_t>(0x80 | ((cp >> 6) & 0x3F)));
+        ret.push_back(static_cast<char8_t>(0x80 | (cp & 0x3F)));
+      }
+    }
+    ret.push_back(u8'\0');
+    return ret;
+  }
+
+  /// @brief Encodes code points to NUL-terminated UTF16
+  /// @param count The count of code points
+  /// @param content The content of the string
+  /// @param big True to encode in big endian
+  /// @return The units (including the NUL-terminator)
+  static std::vector<char16_t> make_utf16(
+      size_t count, Content content, bool big) noexcept
+  {
+    std::vector<char16_t> ret;
+    auto push = [&](u32 unit)
+    {
+      const auto value = static_cast<u16>(unit);
+      ret.push_back(static_cast<char16_t>(big ? htob(value) : htol(value)));
+    };
+    for (char32_t cp : code_points(count, content))
+    {
+      if (cp < 0x10000)
+        push(cp);
+      else
+      {
+        push(0xD800 + ((cp - 0x10000) >> 10));
+        push(0xDC00 + ((cp - 0x10000) & 0x3FF));
+      }
+    }
+    ret.push_back(u'\0');
+    return ret;
+  }
+
+  /// @brief Encodes code points to NUL-terminated UTF32
+  /// @param count The count of code points
+  /// @param content The content of the string
+  /// @return The units (including the NUL-terminator)
+  static std::vector<char32_t> make_utf32(size_t count, Content content) noexcept
+  {
+    auto ret = code_points(count, content);
+    ret.push_back(U'\0');
+    return ret;
+  }
+
+  template<Content CONTENT>
+  /// @brief Benchmarks details::len8
+  static void bench_len8(State& state)
+  {
+    const auto str = make_utf8(state.size(), CONTENT);
+    while (state.keep_running())
+      do_not_optimize(uni::details::len8(str.data()));
+    state.set_bytes_processed(str.size() - 1);
+  }
+
+  template<Content CONTENT>
+  /// @brief Benchmarks details::len16LE
+  static void bench_len16LE(State& state)
+  {
+    const auto str = make_utf16(state.size(), CONTENT, false);
+    while (state.keep_running())
+      do_not_optimize(uni::details::len16LE(str.data()));
+    state.set_bytes_processed((str.size() - 1) * sizeof(char16_t));
+  }
+
+  template<Content CONTENT>
+  /// @brief Benchmarks details::len16BE
+  static void bench_len16BE(State& state)
+  {
+    const auto str = make_utf16(state.size(), CONTENT, true);
+    while (state.keep_running())
+      do_not_optimize(uni::details::len16BE(str.data()));
+    state.set_bytes_processed((str.size() - 1) * sizeof(char16_t));
+  }
+
+  template<Content CONTENT>
+  /// @brief Benchmarks details::unitlen16
+  static void bench_unitlen16(State& state)
+  {
+    const auto str = make_utf16(state.size(), CONTENT, false);
+    while (state.keep_running())
+      do_not_optimize(uni::details::unitlen16(str.data()));
+    state.set_bytes_processed((str.size() - 1) * sizeof(char16_t));
+  }
+
+  template<Content CONTENT>
+  /// @brief Benchmarks details::unitlen32
+  static void bench_unitlen32(State& state)
+  {
+    const auto str = make_utf32(state.size(), CONTENT);
+    while (state.keep_running())
+      do_not_optimize(uni::details::unitlen32(str.data()));
+    state.set_bytes_processed((str.size() - 1) * sizeof(char32_t));
+  }
+
+  template<typename T>
+  /// @brief Generates a NUL-terminated string of code units of type 'T'
+  /// @param count The count of code points
+  /// @param content The content of the string
+  /// @return The string (as code units of the storage type of 'T')
+  static auto make_string(size_t count, Content content) noexcept
+  {
+    if constexpr (std::same_as<T, Char8>)
+      return make_utf8(count, content);
+    else if constexpr (std::same_as<T, Char16LE> || std::same_as<T, Char16BE>)
+      return make_utf16(count, content, std::same_as<T, Char16BE>);
+    else
+      return make_utf32(count, content);
+  }
+
+  template<typename T, Content CONTENT>
+  /// @brief Benchmarks uni::unitlen
+  static void bench_unitlen(State& state)
+  {
+    const auto str  = make_string<T>(state.size(), CONTENT);
+    const auto* ptr = reinterpret_cast<const T*>(str.data());
+    while (state.keep_running())
+      do_not_optimize(uni::unitlen(ptr));
+    state.set_bytes_processed((str.size() - 1) * sizeof(T));
+  }
+
+  template<typename T, Content CONTENT>
+  /// @brief Benchmarks uni::strlen
+  static void bench_strlen(State& state)
+  {
+    const auto str  = make_string<T>(state.size(), CONTENT);
+    const auto* ptr = reinterpret_cast<const T*>(str.data());
+    while (state.keep_running())
+      do_not_optimize(uni::strlen(ptr));
+    state.set_bytes_processed((str.size() - 1) * sizeof(T));
+  }
+
+  template<Content CONTENT>
+  /// @brief Benchmarks uni::display_width
+  static void bench_display_width(State& state)
+  {
+    const auto str = make_utf8(state.size(), CONTENT);
+    const u8StringView view = {
+        reinterpret_cast<const Char8*>(str.data()), str.size() - 1};
+    while (state.keep_running())
+      do_not_optimize(uni::display_width(view));
+    state.set_bytes_processed(str.size() - 1);
+  }
+
+  template<Content CONTENT>
+  /// @brief Benchmarks uni::utf16_len
+  static void bench_utf16_len(State& state)
+  {
+    const auto str  = make_utf8(state.size(), CONTENT);
+    const auto* ptr = reinterpret_cast<const Char8*>(str.data());
+    while (state.keep_running())
+      do_not_optimize(uni::utf16_len(ptr, str.size() - 1));
+    state.set_bytes_processed(str.size() - 1);
+  }
+
+  // clang-format off
+#define COLT_UNICODE_SIZES 15, 64, 1024, 64 * 1024
+
+  COLT_BENCHMARK("uni::details::len8/ascii", bench_len8<Content::Ascii>, COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::details::len8/mixed", bench_len8<Content::Mixed>, COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::details::len16LE/ascii", bench_len16LE<Content::Ascii>, COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::details::len16LE/mixed", bench_len16LE<Content::Mixed>, COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::details::len16BE/ascii", bench_len16BE<Content::Ascii>, COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::details::len16BE/mixed", bench_len16BE<Content::Mixed>, COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::details::unitlen16/mixed", bench_unitlen16<Content::Mixed>, COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::details::unitlen32/mixed", bench_unitlen32<Content::Mixed>, COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::unitlen<Char8>/mixed", (bench_unitlen<Char8, Content::Mixed>), COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::unitlen<Char16BE>/mixed", (bench_unitlen<Char16BE, Content::Mixed>), COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::unitlen<Char32>/mixed", (bench_unitlen<Char32, Content::Mixed>), COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::strlen<Char8>/ascii", (bench_strlen<Char8, Content::Ascii>), COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::strlen<Char8>/mixed", (bench_strlen<Char8, Content::Mixed>), COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::strlen<Char16LE>/mixed", (bench_strlen<Char16LE, Content::Mixed>), COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::strlen<Char16BE>/mixed", (bench_strlen<Char16BE, Content::Mixed>), COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::strlen<Char32>/mixed", (bench_strlen<Char32, Content::Mixed>), COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::display_width/ascii", bench_display_width<Content::Ascii>, COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::display_width/mixed", bench_display_width<Content::Mixed>, COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::utf16_len/ascii", bench_utf16_len<Content::Ascii>, COLT_UNICODE_SIZES);
+  COLT_BENCHMARK("uni::utf16_len/mixed", bench_utf16_len<Content::Mixed>, COLT_UNICODE_SIZES);
+
+#undef COLT_UNICODE_SIZES
+  // clang-format on
+} // namespace clt::bench
@@ -0,0 +1,151 @@
+/*****************************************************************/ /**
+ * @file   detect_simd.cpp
+ * @brief  Contains the implementation of `detect_simd.h`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "detect_simd.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+
+// We make use of simdutf internal header
+#include <simdutf/internal/isadetection.h>
+
+#if defined(COLT_LINUX) && defined(COLT_ARM64)
+  #include <sys/auxv.h>
+#elif defined(COLT_WINDOWS) && defined(COLT_ARM64)
+  #define NOMINMAX
+  #define WIN32_LEAN_AND_MEAN
+  #include <Windows.h>
+#endif
+
+namespace clt::details
+{
+  /// @brief Detects the instructions that simdutf does not detect
+  /// @return The detected instructions
+  static simd_flag detect_colt_architectures() noexcept
+  {
+    simd_flag ret = simd_flag::DEFAULT;
+#if defined(COLT_LINUX) && defined(COLT_ARM64)
+    // HWCAP_SVE and HWCAP2_SVE2 from <asm/hwcap.h>
+    constexpr unsigned long HWCAP_SVE_BIT   = 1UL << 22;
+    constexpr unsigned long HWCAP2_SVE2_BIT = 1UL << 1;
+    if (getauxval(AT_HWCAP) & HWCAP_SVE_BIT)
+      ret = ret | simd_flag::SVE;
+    if (getauxval(AT_HWCAP2) & HWCAP2_SVE2_BIT)
+      ret = ret | simd_flag::SVE2;
+#elif defined(COLT_WINDOWS) && defined(COLT_ARM64)
+  #ifdef PF_ARM_SVE_INSTRUCTIONS_AVAILABLE
+    if (IsProcessorFeaturePresent(PF_ARM_SVE_INSTRUCTIONS_AVAILABLE))
+      ret = ret | simd_flag::SVE;
+  #endif // PF_ARM_SVE_INSTRUCTIONS_AVAILABLE
+  #ifdef PF_ARM_SVE2_INSTRUCTIONS_AVAILABLE
+    if (IsProcessorFeaturePresent(PF_ARM_SVE2_INSTRUCTIONS_AVAILABLE))
+      ret = ret | simd_flag::SVE2;
+  #endif // PF_ARM_SVE2_INSTRUCTIONS_AVAILABLE
+#endif
+    return ret;
+  }
+
+  /// @brief Returns the instructions allowed by `COLT_SIMD_OVERRIDE`
+  /// @return The allowed instructions (all if the variable is not set)
+  static simd_flag environment_override() noexcept
+  {
+    constexpr auto ALL = static_cast<simd_flag>(~u64{0});
+    const char* env    = std::getenv("COLT_SIMD_OVERRIDE");
+    if (env == nullptr)
+      return ALL;
+    if (auto flags = parse_simd_flags(env); flags.is_value())
+      return *flags;
+    std::fputs("COLT_SIMD_OVERRIDE: invalid instruction set (ignored)!\n", stderr);
+    return ALL;
+  }
+
+  /// @brief The maximum count of recorded dispatches
+  static constexpr size_t MAX_DISPATCHES = 128;
+
+  /// @brief The recorded dispatches
+  static SimdDispatch dispatches[MAX_DISPATCHES];
+  /// @brief The count of recorded dispatches
+  static std::atomic<size_t> dispatch_count = 0;
+  /// @brief Protects the recording of the dispatches
+  static std::mutex dispatch_mutex;
+
+  /// @brief Returns the override of the supported instructions
+  /// @return The allowed instructions
+  static std::atomic<simd_flag>& allowed_architectures() noexcept
+  {
+    static std::atomic<simd_flag> allowed = environment_override();
+    return allowed;
+  }
+
+  void record_simd_dispatch(const char* function, simd_flag chosen) noexcept
+  {
+    std::scoped_lock lock = std::scoped_lock{dispatch_mutex};
+    const size_t count    = dispatch_count.load(std::memory_order_relaxed);
+    if (count == MAX_DISPATCHES)
+      return;
+    dispatches[count] = {function, chosen};
+    dispatch_count.store(count + 1, std::memory_order_release);
+  }
+} // namespace clt::details
+
+namespace clt
+{
+  simd_flag detect_hardware_architectures() noexcept
+  {
+    static const auto value =
+        static_cast<simd_flag>(simdutf::internal::detect_supported_architectures())
+        | details::detect_colt_architectures();
+    return value;
+  }
+
+  simd_flag detect_supported_architectures() noexcept
+  {
+    return detect_hardware_architectures()
+           & details::allowed_architectures().load(std::memory_order_acquire);
+  }
+
+  bool override_simd_support(simd_flag allowed) noexcept
+  {
+    details::allowed_architectures().store(allowed, std::memory_order_release);
+    return details::dispatch_count.load(std::memory_order_acquire) == 0;
+  }
+
+  Option<simd_flag> parse_simd_flags(std::string_view str) noexcept
+  {
+    simd_flag ret = simd_flag::DEFAULT;
+    while (!str.empty())
+    {
+      const size_t end = str.find('|');
+      auto name        = str.substr(0, end);
+      str.remove_prefix(end == std::string_view::npos ? str.size() : end + 1);
+      if (name == "DEFAULT")
+        continue;
+      bool found = false;
+      for (const auto& [flag, flag_name] : details::SIMD_FLAG_NAMES)
+      {
+        if (name == flag_name)
+        {
+          ret   = ret | flag;
+          found = true;
+          break;
+        }
+      }
+      if (!found)
+        return None;
+    }
+    return ret;
+  }
+
+  View<SimdDispatch> simd_dispatches() noexcept
+  {
+    // Recorded dispatches are never modified
+    return {
+        details::dispatches,
+        details::dispatch_count.load(std::memory_order_acquire)};
+  }
+} // namespace clt
@@ -20,6 +20,11 @@
  *   of the function,
  * - else return the third argument of the function.
  * The result is cached by unitlen32 to only check once which function to use.
+ * The choices are recorded, and can be inspected through 'simd_dispatches'.
+ * The instruction sets that are used can be restricted (to compare the
+ * throughput of different implementations on the same machine) through
+ * 'override_simd_support' or the environment variable `COLT_SIMD_OVERRIDE`
+ * (for example `COLT_SIMD_OVERRIDE=AVX2|SSE42` disables AVX-512).
  * 
  * @author RPC
  * @date   August 2024
@@ -27,12 +32,12 @@
 #ifndef HG_BIT_DETECT_SIMD
 #define HG_BIT_DETECT_SIMD
 
+#include <string_view>
 #include <fmt/format.h>
 #include <colt/typedefs.h>
 #include <colt/meta/traits.h>
-
-// We make use of simdutf internal header
-#include <simdutf/internal/isadetection.h>
+#include <colt/dsa/option.h>
+#include <colt/coltcpp_export.h>
 
 #if defined(COLT_CLANG) || defined(COLT_GNU)
   #define COLT_ATTRIBUTE_TARGET(_target) __attribute__((target(_target)))
@@ -75,21 +80,128 @@
 #elif defined(COLT_ARM_7or8)
   // +simd for ARM NEON
   #define COLT_FORCE_NEON COLT_ATTRIBUTE_TARGET("+simd")
+  // Scalable Vector Extension (SVE) - vectors whose length is only known
+  // at runtime (128 to 2048 bits).
+  #define COLT_FORCE_SVE COLT_ATTRIBUTE_TARGET("+sve")
+  // SVE2 - extends SVE with most of the NEON integer operations.
+  #define COLT_FORCE_SVE2 COLT_ATTRIBUTE_TARGET("+sve2")
   #include <arm_neon.h>
+#elif defined(COLT_RV32) || defined(COLT_RV64)
+  // RISC-V Vector extension (V) - vectors whose length is only known at runtime.
+  #define COLT_FORCE_RVV COLT_ATTRIBUTE_TARGET("arch=+v")
 #endif // COLT_x86_64
 
 namespace clt
 {
-  using simd_flag = simdutf::internal::instruction_set;
+  /// @brief Instruction sets that can be chosen by 'choose_simd_implementation'.
+  /// The values of the flags detected by simdutf are preserved. Some of them
+  /// share a value (AVX512CD and AVX512VPOPCNTDQ, and the RISC-V flags with
+  /// AVX512BW and AVX512VL): they are only meaningful on their architecture.
+  enum class simd_flag : u64
+  {
+    /// @brief No SIMD instructions (always supported)
+    DEFAULT         = 0x0,
+    NEON            = 0x1,
+    AVX2            = 0x4,
+    SSE42           = 0x8,
+    PCLMULQDQ       = 0x10,
+    BMI1            = 0x20,
+    BMI2            = 0x40,
+    ALTIVEC         = 0x80,
+    AVX512F         = 0x100,
+    AVX512DQ        = 0x200,
+    AVX512IFMA      = 0x400,
+    AVX512PF        = 0x800,
+    AVX512ER        = 0x1000,
+    AVX512CD        = 0x2000,
+    AVX512BW        = 0x4000,
+    AVX512VL        = 0x8000,
+    AVX512VBMI2     = 0x10000,
+    AVX512VPOPCNTDQ = 0x2000,
+    RVV             = 0x4000,
+    ZVBB            = 0x8000,
+    /// @brief Detected by colt (not by simdutf)
+    SVE = 0x1'0000'0000,
+    /// @brief Detected by colt (not by simdutf)
+    SVE2 = 0x2'0000'0000,
+  };
 
-  /// @brief Use to detect SIMD supported features
-  /// @return simd_flag with the supported features marked as 1
-  static inline simd_flag detect_supported_architectures() noexcept
+  /// @brief Combines two simd_flag
+  /// @param a The first flag
+  /// @param b The second flag
+  /// @return a | b
+  constexpr simd_flag operator|(simd_flag a, simd_flag b) noexcept
+  {
+    return static_cast<simd_flag>(static_cast<u64>(a) | static_cast<u64>(b));
+  }
+
+  /// @brief Returns the flags that are part of both flags
+  /// @param a The first flag
+  /// @param b The second flag
+  /// @return a & b
+  constexpr simd_flag operator&(simd_flag a, simd_flag b) noexcept
+  {
+    return static_cast<simd_flag>(static_cast<u64>(a) & static_cast<u64>(b));
+  }
+
+  /// @brief Check if a flag is part of flags.
+  /// DEFAULT is part of any flags.
+  /// @param flags The flags
+  /// @param flag The flag to check for
+  /// @return True if all the bits of 'flag' are part of 'flags'
+  constexpr bool is_enabled(simd_flag flags, simd_flag flag) noexcept
   {
-    static const auto value = simdutf::internal::detect_supported_architectures();
-    return static_cast<simd_flag>(value);
+    return (flags & flag) == flag;
   }
 
+  /// @brief The implementation chosen by a 'choose_simd_implementation'
+  struct SimdDispatch
+  {
+    /// @brief The name of the function that chose the implementation
+    const char* function;
+    /// @brief The instruction set of the chosen implementation
+    simd_flag chosen;
+  };
+
+  /// @brief Returns the SIMD instructions supported by the CPU.
+  /// The result of the detection is cached.
+  /// @return simd_flag with the supported features marked as 1
+  COLTCPP_EXPORT simd_flag detect_hardware_architectures() noexcept;
+
+  /// @brief Returns the SIMD instructions that 'choose_simd_implementation'
+  /// may use: the supported instructions, restricted by the override.
+  /// @return simd_flag with the usable features marked as 1
+  COLTCPP_EXPORT simd_flag detect_supported_architectures() noexcept;
+
+  /// @brief Restricts the SIMD instructions used by 'choose_simd_implementation'
+  /// to the supported instructions that are part of 'allowed'.
+  /// This overrides the environment variable `COLT_SIMD_OVERRIDE`.
+  /// Implementations that were already chosen are not changed: this should
+  /// be called at the beginning of 'main'.
+  /// @param allowed The allowed instructions (DEFAULT for no SIMD)
+  /// @return False if implementations were already chosen
+  COLTCPP_EXPORT bool override_simd_support(simd_flag allowed) noexcept;
+
+  /// @brief Parses flags separated by '|' (such as "AVX2|SSE42").
+  /// The names are the ones of the enumerators of simd_flag.
+  /// @param str The string to parse
+  /// @return None if a name is not a flag of the current architecture
+  COLTCPP_EXPORT Option<simd_flag> parse_simd_flags(std::string_view str) noexcept;
+
+  /// @brief Returns the implementations chosen by 'choose_simd_implementation'
+  /// in the order in which they were chosen (up to 128 are recorded).
+  /// @return The chosen implementations
+  COLTCPP_EXPORT View<SimdDispatch> simd_dispatches() noexcept;
+
+  namespace details
+  {
+    /// @brief Records the implementation chosen by a function
+    /// @param function The name of the function
+    /// @param chosen The chosen implementation
+    COLTCPP_EXPORT void record_simd_dispatch(
+        const char* function, simd_flag chosen) noexcept;
+  } // namespace details
+
   COLT_DISABLE_WARNING_PUSH
   COLT_DISABLE_WARNING("-Wunused-value", 4553)
 
@@ -100,7 +212,7 @@ namespace clt
         (PREFERED, ...) == simd_flag::DEFAULT,
         "The last item of PREFERED must be DEFAULT.");
 
-#ifdef COLT_DEBUG
+    /// @brief The location of the dispatch (recorded in 'simd_dispatches')
     clt::source_location src;
 
     constexpr choose_simd_implementation(
@@ -108,7 +220,6 @@ namespace clt
         : src(src)
     {
     }
-#endif // COLT_DEBUG
 
     template<typename Ty, typename... Tys>
     Ty operator()(Ty first, Tys... ts)
@@ -121,6 +232,7 @@ namespace clt
           "All function pointers must be of the same type!");
       if constexpr (sizeof...(ts) == 0)
       {
+        details::record_simd_dispatch(src.function_name(), simd_flag::DEFAULT);
         return first;
       }
       else
@@ -131,13 +243,14 @@ namespace clt
         const Ty ARRAYFN[]       = {first, ts...};
         for (size_t i = 0; i < ARRAY_SIZE - 1; i++)
         {
-          if (support & ARRAY[i])
+          if (is_enabled(support, ARRAY[i]))
           {
 #ifdef COLT_DEBUG
             fmt::println(
                 "Using {} implementation for '{}'.", ARRAY[i],
                 src.function_name());
 #endif // COLT_DEBUG
+            details::record_simd_dispatch(src.function_name(), ARRAY[i]);
             return ARRAYFN[i];
           }
         }
@@ -145,71 +258,59 @@ namespace clt
         fmt::println(
             "Using {} implementation for '{}'.", ARRAY[ARRAY_SIZE - 1], src.function_name());
 #endif // COLT_DEBUG
+        details::record_simd_dispatch(src.function_name(), ARRAY[ARRAY_SIZE - 1]);
         return ARRAYFN[ARRAY_SIZE - 1];
       }
     }
   };
-  COLT_DISABLE_WARNING_PUSH
+  COLT_DISABLE_WARNING_POP
 } // namespace clt::bit
 
-template<>
-struct fmt::formatter<clt::simd_flag>
+namespace clt::details
 {
-  static constexpr std::array FLAG_VALUES = {
-#if defined(COLT_RV32) || defined(COLT_RV64)
-    0x0,
-    0x4000,
-    0x8000,
-#else
-    0x0,
-    0x1,
-    0x4,
-    0x8,
-    0x10,
-    0x20,
-    0x40,
-    0x80,
-    0x100,
-    0x200,
-    0x400,
-    0x800,
-    0x1000,
-    0x2000,
-    0x4000,
-    0x8000,
-    0x10000,
-    0x2000,
-#endif // COLT_RV32 || COLT_RV64
+  /// @brief The name of a simd_flag
+  struct SimdFlagName
+  {
+    /// @brief The flag
+    simd_flag flag;
+    /// @brief The name of the flag
+    const char* name;
   };
-  static constexpr std::array FLAG_TO_STR = {
+
+  /// @brief The flags of the current architecture (without DEFAULT)
+  inline constexpr SimdFlagName SIMD_FLAG_NAMES[] = {
 #if defined(COLT_RV32) || defined(COLT_RV64)
-    "DEFAULT",
-    "RVV",
-    "ZVBB"
+      {simd_flag::RVV, "RVV"},
+      {simd_flag::ZVBB, "ZVBB"},
+#elif defined(COLT_ARM_7or8)
+      {simd_flag::NEON, "NEON"},
+      {simd_flag::SVE, "SVE"},
+      {simd_flag::SVE2, "SVE2"},
+#elif defined(COLT_x86_64)
+      {simd_flag::AVX2, "AVX2"},
+      {simd_flag::SSE42, "SSE42"},
+      {simd_flag::PCLMULQDQ, "PCLMULQDQ"},
+      {simd_flag::BMI1, "BMI1"},
+      {simd_flag::BMI2, "BMI2"},
+      {simd_flag::AVX512F, "AVX512F"},
+      {simd_flag::AVX512DQ, "AVX512DQ"},
+      {simd_flag::AVX512IFMA, "AVX512IFMA"},
+      {simd_flag::AVX512PF, "AVX512PF"},
+      {simd_flag::AVX512ER, "AVX512ER"},
+      {simd_flag::AVX512CD, "AVX512CD"},
+      {simd_flag::AVX512BW, "AVX512BW"},
+      {simd_flag::AVX512VL, "AVX512VL"},
+      {simd_flag::AVX512VBMI2, "AVX512VBMI2"},
+      {simd_flag::AVX512VPOPCNTDQ, "AVX512VPOPCNTDQ"},
 #else
-    "DEFAULT",
-    "NEON",
-    "AVX2",
-    "SSE42",
-    "PCLMULQDQ",
-    "BMI1",
-    "BMI2",
-    "ALTIVEC",
-    "AVX512F",
-    "AVX512DQ",
-    "AVX512IFMA",
-    "AVX512PF",
-    "AVX512ER",
-    "AVX512CD",
-    "AVX512BW",
-    "AVX512VL",
-    "AVX512VBMI2",
-    "AVX512VPOPCNTDQ",
-    "RVV",
-    "ZVBB"
+      {simd_flag::ALTIVEC, "ALTIVEC"},
 #endif // COLT_RV32 || COLT_RV64
   };
+} // namespace clt::details
 
+template<>
+struct fmt::formatter<clt::simd_flag>
+{
   template<typename ParseContext>
   constexpr auto parse(ParseContext& ctx)
   {
@@ -220,10 +321,16 @@ struct fmt::formatter<clt::simd_flag>
   template<typename FormatContext>
   auto format(clt::simd_flag flag, FormatContext& ctx) const
   {
+    using namespace clt;
     auto fmt_to = fmt::format_to(ctx.out(), "(");
-    for (size_t i = 1; i < FLAG_VALUES.size(); i++)
-      if (flag & FLAG_VALUES[i])
-        fmt_to = fmt::format_to(fmt_to, "{} | ", FLAG_TO_STR[i]);
+    simd_flag printed = simd_flag::DEFAULT;
+    for (const auto& [value, name] : details::SIMD_FLAG_NAMES)
+    {
+      // Flags sharing a value are only printed once
+      if (is_enabled(flag, value) && !is_enabled(printed, value))
+        fmt_to = fmt::format_to(fmt_to, "{} | ", name);
+      printed = printed | value;
+    }
     return fmt::format_to(fmt_to, "DEFAULT)");
   }
 };
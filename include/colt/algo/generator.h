@@ -0,0 +1,280 @@
+/*****************************************************************/ /**
+ * @file   generator.h
+ * @brief  Contains Generator, a lazy range whose elements are produced
+ * by a coroutine.
+ * The frames of the coroutines are allocated from a colt allocator
+ * (never through the global 'operator new'): the allocator is passed as
+ * the first two arguments of the coroutine, as for std::generator.
+ * @code{.cpp}
+ * Generator<u64> iota(std::allocator_arg_t, mem::AnyAllocatorRef, u64 n)
+ * {
+ *   for (u64 i = 0; i < n; i++)
+ *     co_yield i;
+ * }
+ * mem::ArenaAllocator<mem::Mallocator> arena;
+ * for (u64 i : iota(std::allocator_arg, arena, 10))
+ *   process(i);
+ * @endcode
+ * Coroutines that do not take an allocator use 'mem::GlobalAllocator'.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_ALGO_GENERATOR
+#define HG_ALGO_GENERATOR
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "colt/typedefs.h"
+#include "colt/mem/allocator_ref.h"
+
+namespace clt
+{
+  namespace details
+  {
+    /// @brief Stored after the frame of a coroutine, to free the frame
+    struct CoroutineFrameTrailer
+    {
+      /// @brief The allocator of the frame
+      mem::AnyAllocatorRef alloc;
+      /// @brief The block of the frame
+      mem::MemBlock blk;
+    };
+
+    /// @brief Returns the offset of the trailer of a frame of 'size' bytes
+    /// @param size The size of the frame
+    /// @return The offset of the trailer
+    constexpr size_t frame_trailer_offset(size_t size) noexcept
+    {
+      constexpr size_t align = alignof(CoroutineFrameTrailer);
+      return (size + align - 1) / align * align;
+    }
+
+    /// @brief Allocates the frame of a coroutine from 'alloc'.
+    /// The allocator and the block are stored after the frame.
+    /// @param size The size of the frame
+    /// @param alloc The allocator
+    /// @return Pointer to the frame
+    inline void* alloc_frame(size_t size, mem::AnyAllocatorRef alloc) noexcept
+    {
+      const size_t offset = frame_trailer_offset(size);
+      auto blk            = alloc.alloc(offset + sizeof(CoroutineFrameTrailer));
+      assert_true("Could not allocate the coroutine frame!", !blk.is_null());
+      auto ptr = static_cast<u8*>(blk.ptr());
+      new (ptr + offset) CoroutineFrameTrailer{alloc, blk};
+      return ptr;
+    }
+
+    /// @brief Frees the frame of a coroutine allocated by 'alloc_frame'
+    /// @param ptr The frame
+    /// @param size The size of the frame (as passed to 'alloc_frame')
+    inline void dealloc_frame(void* ptr, size_t size) noexcept
+    {
+      auto trailer = std::launder(reinterpret_cast<CoroutineFrameTrailer*>(
+          static_cast<u8*>(ptr) + frame_trailer_offset(size)));
+      const auto alloc = trailer->alloc;
+      const auto blk   = trailer->blk;
+      trailer->~CoroutineFrameTrailer();
+      alloc.dealloc(blk);
+    }
+  } // namespace details
+
+  template<typename T>
+  /// @brief Lazy range of the values yielded by a coroutine.
+  /// The coroutine starts on 'begin' and is resumed by each increment of
+  /// the iterator: a Generator can only be iterated once.
+  /// The values are not copied: the iterator points to the yielded value,
+  /// which lives until the coroutine is resumed.
+  /// @tparam T The type of the yielded values
+  class Generator
+  {
+  public:
+    /// @brief The promise of the coroutine
+    class promise_type
+    {
+      /// @brief The last yielded value
+      const T* value = nullptr;
+
+      friend class Generator;
+
+    public:
+      /// @brief Returns the Generator of the coroutine
+      /// @return The Generator
+      Generator get_return_object() noexcept
+      {
+        return Generator{
+            std::coroutine_handle<promise_type>::from_promise(*this)};
+      }
+
+      /// @brief The coroutine only starts when iterated
+      std::suspend_always initial_suspend() const noexcept { return {}; }
+      /// @brief The frame is destroyed by the Generator
+      std::suspend_always final_suspend() const noexcept { return {}; }
+
+      /// @brief Suspends the coroutine, yielding 'to_yield'
+      /// @param to_yield The value to yield
+      /// @return Awaitable suspending the coroutine
+      std::suspend_always yield_value(const T& to_yield) noexcept
+      {
+        value = std::addressof(to_yield);
+        return {};
+      }
+
+      /// @brief Generators do not return values
+      void return_void() const noexcept {}
+      /// @brief Exceptions are not supported
+      void unhandled_exception() const noexcept { std::terminate(); }
+
+      /// @brief Generators can only yield (not await)
+      template<typename U>
+      std::suspend_never await_transform(U&&) = delete;
+
+      /// @brief Allocates the frame from 'alloc'
+      /// @param size The size of the frame
+      /// @param alloc The allocator (of alignment std::max_align_t at least)
+      /// @return Pointer to the frame
+      template<typename... Args>
+      static void* operator new(
+          size_t size, std::allocator_arg_t, const mem::AnyAllocatorRef& alloc,
+          const Args&...)
+      {
+        return details::alloc_frame(size, alloc);
+      }
+
+      /// @brief Allocates the frame from the global allocator
+      /// @param size The size of the frame
+      /// @return Pointer to the frame
+      template<typename... Args>
+      static void* operator new(size_t size, const Args&...)
+      {
+        return details::alloc_frame(size, mem::GlobalAllocator);
+      }
+
+      /// @brief Frees the frame
+      /// @param ptr The frame
+      /// @param size The size of the frame
+      static void operator delete(void* ptr, size_t size) noexcept
+      {
+        details::dealloc_frame(ptr, size);
+      }
+    };
+
+    /// @brief Input iterator over the yielded values
+    class Iterator
+    {
+      /// @brief The coroutine
+      std::coroutine_handle<promise_type> handle;
+
+    public:
+      using value_type      = T;
+      using difference_type = std::ptrdiff_t;
+
+      /// @brief Constructor
+      /// @param handle The coroutine
+      explicit Iterator(std::coroutine_handle<promise_type> handle) noexcept
+          : handle(handle)
+      {
+      }
+
+      /// @brief Default constructor
+      Iterator() noexcept = default;
+
+      MAKE_DEFAULT_COPY_AND_MOVE_FOR(Iterator);
+
+      /// @brief Returns the last yielded value
+      /// @return The last yielded value
+      const T& operator*() const noexcept
+      {
+        assert_true("Cannot dereference the end!", !handle.done());
+        return *handle.promise().value;
+      }
+
+      /// @brief Returns the last yielded value
+      /// @return Pointer to the last yielded value
+      const T* operator->() const noexcept { return std::addressof(**this); }
+
+      /// @brief Resumes the coroutine until the next yielded value
+      /// @return Self
+      Iterator& operator++() noexcept
+      {
+        assert_true("Cannot advance past the end!", !handle.done());
+        handle.resume();
+        return *this;
+      }
+
+      /// @brief Resumes the coroutine until the next yielded value
+      void operator++(int) noexcept { ++(*this); }
+
+      /// @brief Check if the coroutine is done
+      /// @return True if no values are left
+      friend bool operator==(const Iterator& it, std::default_sentinel_t) noexcept
+      {
+        return it.handle.done();
+      }
+    };
+
+    Generator()                            = delete;
+    Generator(const Generator&)            = delete;
+    Generator& operator=(const Generator&) = delete;
+
+    /// @brief Move constructor
+    /// @param to_move The Generator to move
+    Generator(Generator&& to_move) noexcept
+        : handle(std::exchange(to_move.handle, nullptr))
+        , started(to_move.started)
+    {
+    }
+
+    /// @brief Move assignment operator
+    /// @param to_move The Generator to move
+    /// @return Self
+    Generator& operator=(Generator&& to_move) noexcept
+    {
+      std::swap(handle, to_move.handle);
+      std::swap(started, to_move.started);
+      return *this;
+    }
+
+    /// @brief Destructor, destroys the coroutine (and frees its frame)
+    ~Generator() noexcept
+    {
+      if (handle)
+        handle.destroy();
+    }
+
+    /// @brief Starts the coroutine.
+    /// Must be called only once.
+    /// @return Iterator to the first yielded value
+    Iterator begin() noexcept
+    {
+      assert_true("A Generator can only be iterated once!", !started);
+      started = true;
+      handle.resume();
+      return Iterator{handle};
+    }
+
+    /// @brief Returns the end sentinel
+    /// @return The end sentinel
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+  private:
+    /// @brief Constructor
+    /// @param handle The coroutine
+    explicit Generator(std::coroutine_handle<promise_type> handle) noexcept
+        : handle(handle)
+    {
+    }
+
+    /// @brief The coroutine (null if moved from)
+    std::coroutine_handle<promise_type> handle;
+    /// @brief True if 'begin' was called
+    bool started = false;
+  };
+} // namespace clt
+
+#endif // !HG_ALGO_GENERATOR
@@ -0,0 +1,455 @@
+/*****************************************************************/ /**
+ * @file   parallel.h
+ * @brief  Contains parallel algorithms (for_each, transform, reduce,
+ * inclusive_scan, sort and radix_sort) running on a Scheduler.
+ * Ranges are split in chunks of 'grain' elements, whose boundaries only
+ * depend on the size of the range and the grain (never on the count of
+ * workers or on timing), and partial results are always combined in the
+ * order of the chunks: the results are deterministic.
+ * The algorithms accept any contiguous range (View, Span, BasicVector...).
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_ALGO_PARALLEL
+#define HG_ALGO_PARALLEL
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include "colt/typedefs.h"
+#include "colt/exec/scheduler.h"
+
+namespace clt::par
+{
+  /// @brief The options of the parallel algorithms
+  struct Options
+  {
+    /// @brief The count of elements processed by a task.
+    /// Ranges of at most 'grain' elements are processed sequentially.
+    size_t grain = 4096;
+    /// @brief The scheduler running the tasks (null for 'default_scheduler')
+    exec::Scheduler* scheduler = nullptr;
+  };
+
+  namespace details
+  {
+    /// @brief Returns the scheduler of options
+    /// @param opt The options
+    /// @return The scheduler to use
+    inline exec::Scheduler& scheduler_of(const Options& opt) noexcept
+    {
+      return opt.scheduler == nullptr ? exec::default_scheduler() : *opt.scheduler;
+    }
+
+    /// @brief Returns the count of chunks of a range
+    /// @param size The size of the range
+    /// @param grain The size of the chunks
+    /// @return The count of chunks
+    constexpr size_t chunk_count(size_t size, size_t grain) noexcept
+    {
+      return (size + grain - 1) / grain;
+    }
+
+    /// @brief Runs 'fn' on the chunks [begin, end), splitting the chunks
+    /// in halves so that the tasks are spawned by the workers stealing them
+    /// @param group The group of the tasks
+    /// @param begin The first chunk
+    /// @param end The end of the chunks
+    /// @param fn The function called with each chunk index
+    template<typename Fn>
+    void spawn_chunks(exec::TaskGroup& group, size_t begin, size_t end, Fn& fn)
+    {
+      while (end - begin > 1)
+      {
+        const size_t middle = begin + (end - begin) / 2;
+        group.spawn([&group, &fn, middle, end]
+                    { spawn_chunks(group, middle, end, fn); });
+        end = middle;
+      }
+      fn(begin);
+    }
+
+    /// @brief Returns the count of elements of 'a' among the first 'p'
+    /// elements of the stable merge of 'a' and 'b' (merge path)
+    /// @param a The first sorted range
+    /// @param b The second sorted range
+    /// @param p The count of merged elements
+    /// @param comp The comparator
+    /// @return The count of elements taken from 'a'
+    template<typename T, typename Compare>
+    size_t co_rank(std::span<T> a, std::span<T> b, size_t p, Compare& comp)
+    {
+      size_t lo = p > b.size() ? p - b.size() : 0;
+      size_t hi = std::min(p, a.size());
+      while (lo < hi)
+      {
+        const size_t i = lo + (hi - lo) / 2;
+        // a[i] comes before b[p - i - 1]: more elements of 'a' are needed
+        if (!comp(b[p - i - 1], a[i]))
+          lo = i + 1;
+        else
+          hi = i;
+      }
+      return lo;
+    }
+  } // namespace details
+
+  /// @brief Calls 'fn(begin, end)' for each chunk of a range of 'size'
+  /// elements, in parallel. This is the building block of the other
+  /// algorithms: chunks are [i * grain, min((i + 1) * grain, size)).
+  /// @param size The size of the range
+  /// @param fn The function (called concurrently)
+  /// @param opt The options
+  template<typename Fn>
+    requires std::invocable<Fn&, size_t, size_t>
+  void for_each_chunk(size_t size, Fn&& fn, Options opt = {})
+  {
+    assert_true("The grain must not be 0!", opt.grain != 0);
+    if (size <= opt.grain)
+    {
+      if (size != 0)
+        fn(size_t{0}, size);
+      return;
+    }
+    auto chunk = [&fn, size, grain = opt.grain](size_t index)
+    { fn(index * grain, std::min(size, (index + 1) * grain)); };
+    exec::TaskGroup group = {details::scheduler_of(opt)};
+    details::spawn_chunks(group, 0, details::chunk_count(size, opt.grain), chunk);
+    group.wait();
+  }
+
+  /// @brief Calls 'fn' on each element of a range, in parallel
+  /// @param range The range
+  /// @param fn The function (called concurrently)
+  /// @param opt The options
+  template<std::ranges::contiguous_range R, typename Fn>
+  void for_each(R&& range, Fn&& fn, Options opt = {})
+  {
+    auto span = std::span{range};
+    for_each_chunk(
+        span.size(),
+        [&](size_t begin, size_t end)
+        {
+          for (size_t i = begin; i < end; i++)
+            fn(span[i]);
+        },
+        opt);
+  }
+
+  /// @brief Writes 'fn(from[i])' to 'to[i]', in parallel
+  /// @param from The input range
+  /// @param to The output range (of at least the size of 'from')
+  /// @param fn The function (called concurrently)
+  /// @param opt The options
+  template<
+      std::ranges::contiguous_range R, std::ranges::contiguous_range O,
+      typename Fn>
+  void transform(R&& from, O&& to, Fn&& fn, Options opt = {})
+  {
+    auto in  = std::span{from};
+    auto out = std::span{to};
+    assert_true("'to' is too small!", out.size() >= in.size());
+    assert_true("The grain must not be 0!", opt.grain != 0);
+    for_each_chunk(
+        in.size(),
+        [&](size_t begin, size_t end)
+        {
+          for (size_t i = begin; i < end; i++)
+            out[i] = fn(in[i]);
+        },
+        opt);
+  }
+
+  /// @brief Reduces 'fn(x)' for all 'x' of a range using 'op', in parallel.
+  /// The elements of each chunk are reduced in order, then the results of
+  /// the chunks are reduced in order, starting from 'init'.
+  /// As the chunks only depend on the size and grain, the result is the
+  /// same on each run (even for non-associative operations such as
+  /// floating point additions).
+  /// @param range The range
+  /// @param init The initial value
+  /// @param op The reduction (U, U) -> U
+  /// @param fn The transformation of the elements (T) -> U
+  /// @param opt The options
+  /// @return The reduction of the range
+  template<std::ranges::contiguous_range R, typename U, typename Op, typename Fn>
+  U transform_reduce(R&& range, U init, Op&& op, Fn&& fn, Options opt = {})
+  {
+    auto span = std::span{range};
+    assert_true("The grain must not be 0!", opt.grain != 0);
+    if (span.empty())
+      return init;
+    std::vector<std::optional<U>> partials(
+        details::chunk_count(span.size(), opt.grain));
+    for_each_chunk(
+        span.size(),
+        [&](size_t begin, size_t end)
+        {
+          U acc = fn(span[begin]);
+          for (size_t i = begin + 1; i < end; i++)
+            acc = op(std::move(acc), fn(span[i]));
+          partials[begin / opt.grain].emplace(std::move(acc));
+        },
+        opt);
+    for (auto& partial : partials)
+      init = op(std::move(init), std::move(*partial));
+    return init;
+  }
+
+  /// @brief Reduces a range using 'op', in parallel (see 'transform_reduce')
+  /// @param range The range
+  /// @param init The initial value
+  /// @param op The reduction (U, U) -> U
+  /// @param opt The options
+  /// @return The reduction of the range
+  template<std::ranges::contiguous_range R, typename U, typename Op = std::plus<>>
+  U reduce(R&& range, U init, Op&& op = {}, Options opt = {})
+  {
+    return transform_reduce(
+        std::forward<R>(range), std::move(init), op,
+        [](const auto& value) -> U { return value; }, opt);
+  }
+
+  /// @brief Writes the inclusive scan of 'from' using 'op' to 'to', in
+  /// parallel: 'to[i] = from[0] op ... op from[i]'.
+  /// Each chunk is reduced, the chunk results are scanned in order, then
+  /// each chunk is scanned starting from the result of the chunks before.
+  /// 'op' must be associative for the result to equal the sequential scan
+  /// (it is deterministic regardless).
+  /// @param from The input range
+  /// @param to The output range (of at least the size of 'from', which may
+  ///        be the same range as 'from')
+  /// @param op The operation
+  /// @param opt The options
+  template<
+      std::ranges::contiguous_range R, std::ranges::contiguous_range O,
+      typename Op = std::plus<>>
+  void inclusive_scan(R&& from, O&& to, Op&& op = {}, Options opt = {})
+  {
+    auto in  = std::span{from};
+    auto out = std::span{to};
+    using U  = std::ranges::range_value_t<O>;
+    assert_true("'to' is too small!", out.size() >= in.size());
+    assert_true("The grain must not be 0!", opt.grain != 0);
+    if (in.size() <= opt.grain)
+    {
+      if (!in.empty())
+        std::inclusive_scan(in.begin(), in.end(), out.begin(), op);
+      return;
+    }
+    const size_t chunks = details::chunk_count(in.size(), opt.grain);
+    std::vector<std::optional<U>> carry(chunks);
+    // Reduce each chunk (but the last, which never carries)
+    for_each_chunk(
+        in.size() - (in.size() - 1) % opt.grain - 1,
+        [&](size_t begin, size_t end)
+        {
+          U acc = in[begin];
+          for (size_t i = begin + 1; i < end; i++)
+            acc = op(std::move(acc), in[i]);
+          carry[begin / opt.grain + 1].emplace(std::move(acc));
+        },
+        opt);
+    // 'carry[i - 1]' is not moved from: it is the prefix of chunk 'i - 1'
+    for (size_t i = 2; i < chunks; i++)
+      carry[i] = op(*carry[i - 1], std::move(*carry[i]));
+    for_each_chunk(
+        in.size(),
+        [&](size_t begin, size_t end)
+        {
+          const auto& prefix = carry[begin / opt.grain];
+          U acc = prefix.has_value() ? op(*prefix, in[begin]) : U(in[begin]);
+          out[begin] = acc;
+          for (size_t i = begin + 1; i < end; i++)
+          {
+            acc    = op(std::move(acc), in[i]);
+            out[i] = acc;
+          }
+        },
+        opt);
+  }
+
+  /// @brief Sorts a range using a stable parallel merge sort.
+  /// Chunks of 'grain' elements are sorted in parallel, then pairs of runs
+  /// are merged in rounds. Each merge is split in pieces of 'grain' output
+  /// elements (using a merge path search), so that the last rounds remain
+  /// parallel. Equivalent elements keep their order: the result is
+  /// deterministic.
+  /// @param range The range to sort
+  /// @param comp The comparator
+  /// @param opt The options
+  template<std::ranges::contiguous_range R, typename Compare = std::less<>>
+  void sort(R&& range, Compare&& comp = {}, Options opt = {})
+  {
+    auto span = std::span{range};
+    using T   = std::ranges::range_value_t<R>;
+    static_assert(
+        std::is_default_constructible_v<T> && std::movable<T>,
+        "sort requires a default constructible and movable type!");
+    assert_true("The grain must not be 0!", opt.grain != 0);
+    const size_t size = span.size();
+    if (size <= opt.grain)
+    {
+      std::stable_sort(span.begin(), span.end(), comp);
+      return;
+    }
+    for_each_chunk(
+        size,
+        [&](size_t begin, size_t end)
+        { std::stable_sort(span.begin() + begin, span.begin() + end, comp); },
+        opt);
+
+    auto buffer   = std::make_unique_for_overwrite<T[]>(size);
+    std::span src = span;
+    std::span dst = std::span{buffer.get(), size};
+    for (size_t width = opt.grain; width < size; width *= 2)
+    {
+      // 'width' is a multiple of 'grain': no piece spans two pairs
+      for_each_chunk(
+          size,
+          [&](size_t begin, size_t end)
+          {
+            const size_t pair   = begin / (2 * width) * (2 * width);
+            const size_t middle = std::min(pair + width, size);
+            const auto a        = src.subspan(pair, middle - pair);
+            const auto b =
+                src.subspan(middle, std::min(pair + 2 * width, size) - middle);
+            const size_t ia = details::co_rank(a, b, begin - pair, comp);
+            const size_t ja = details::co_rank(a, b, end - pair, comp);
+            const size_t ib = begin - pair - ia;
+            const size_t jb = end - pair - ja;
+            std::merge(
+                std::make_move_iterator(a.begin() + ia),
+                std::make_move_iterator(a.begin() + ja),
+                std::make_move_iterator(b.begin() + ib),
+                std::make_move_iterator(b.begin() + jb), dst.begin() + begin,
+                comp);
+          },
+          opt);
+      std::swap(src, dst);
+    }
+    if (src.data() != span.data())
+    {
+      for_each_chunk(
+          size,
+          [&](size_t begin, size_t end)
+          {
+            std::move(
+                src.begin() + begin, src.begin() + end, span.begin() + begin);
+          },
+          opt);
+    }
+  }
+
+  /// @brief Sorts a range by an unsigned integer key using a stable
+  /// parallel least significant digit radix sort (8 bits per pass).
+  /// This is faster than 'sort' for hashes or indices: each pass counts
+  /// the digits of each chunk in parallel, then scatters each chunk in
+  /// parallel (in the order of the chunks, making the sort stable).
+  /// Passes whose digit is the same for all the keys are skipped.
+  /// @param range The range to sort
+  /// @param key Returns the key of an element (called multiple times)
+  /// @param opt The options
+  template<std::ranges::contiguous_range R, typename Key>
+    requires std::unsigned_integral<
+        std::invoke_result_t<Key&, const std::ranges::range_value_t<R>&>>
+  void radix_sort(R&& range, Key&& key, Options opt = {})
+  {
+    auto span = std::span{range};
+    using T   = std::ranges::range_value_t<R>;
+    using K   = std::invoke_result_t<Key&, const T&>;
+    static_assert(
+        std::is_default_constructible_v<T> && std::movable<T>,
+        "radix_sort requires a default constructible and movable type!");
+    assert_true("The grain must not be 0!", opt.grain != 0);
+    const size_t size = span.size();
+    if (size < 2)
+      return;
+    const size_t chunks = details::chunk_count(size, opt.grain);
+    std::vector<std::array<size_t, 256>> offsets(chunks);
+    std::unique_ptr<T[]> buffer;
+    std::span src = span;
+    std::span<T> dst;
+    for (size_t shift = 0; shift < sizeof(K) * 8; shift += 8)
+    {
+      auto digit = [&](const T& value)
+      { return static_cast<size_t>((key(value) >> shift) & 0xFF); };
+      for_each_chunk(
+          size,
+          [&](size_t begin, size_t end)
+          {
+            auto& count = offsets[begin / opt.grain];
+            count.fill(0);
+            for (size_t i = begin; i < end; i++)
+              ++count[digit(src[i])];
+          },
+          opt);
+      // Offsets in the order (digit, chunk), which keeps the sort stable
+      size_t total = 0;
+      bool skip    = false;
+      for (size_t d = 0; d < 256 && !skip; d++)
+      {
+        size_t digit_count = 0;
+        for (auto& count : offsets)
+        {
+          const size_t value = count[d];
+          count[d]           = total;
+          total += value;
+          digit_count += value;
+        }
+        skip = digit_count == size;
+      }
+      if (skip)
+        continue;
+      if (buffer == nullptr)
+      {
+        buffer = std::make_unique_for_overwrite<T[]>(size);
+        dst    = std::span{buffer.get(), size};
+      }
+      for_each_chunk(
+          size,
+          [&](size_t begin, size_t end)
+          {
+            auto& offset = offsets[begin / opt.grain];
+            for (size_t i = begin; i < end; i++)
+              dst[offset[digit(src[i])]++] = std::move(src[i]);
+          },
+          opt);
+      std::swap(src, dst);
+    }
+    if (src.data() != span.data())
+    {
+      for_each_chunk(
+          size,
+          [&](size_t begin, size_t end)
+          {
+            std::move(
+                src.begin() + begin, src.begin() + end, span.begin() + begin);
+          },
+          opt);
+    }
+  }
+
+  /// @brief Sorts a range of unsigned integers using 'radix_sort'
+  /// @param range The range to sort
+  /// @param opt The options
+  template<std::ranges::contiguous_range R>
+    requires std::unsigned_integral<std::ranges::range_value_t<R>>
+  void radix_sort(R&& range, Options opt = {})
+  {
+    radix_sort(
+        std::forward<R>(range), [](auto value) { return value; }, opt);
+  }
+} // namespace clt::par
+
+#endif // !HG_ALGO_PARALLEL
@@ -0,0 +1,420 @@
+/*****************************************************************/ /**
+ * @file   any_string_view.h
+ * @brief  Contains AnyStringView, a StringView whose encoding is only
+ * known at runtime.
+ *
+ * Each bulk operation (`size`, `len`, `validate`, `find`, `transcode`,
+ * hashing and comparisons) switches on the encoding once, then runs the
+ * operation of the typed BasicStringView (which uses the SIMD kernels of
+ * that encoding). Hot loops should do the same using `visit`:
+ * @code{.cpp}
+ * void consume(AnyStringView str)
+ * {
+ *   str.visit([]<StringEncoding ENCODING>(BasicStringView<ENCODING> view)
+ *   {
+ *     for (char32_t c : view) // no dispatch per code point
+ *       ...
+ *   });
+ * }
+ * @endcode
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_DSA_ANY_STRING_VIEW
+#define HG_DSA_ANY_STRING_VIEW
+
+#include <cstring>
+
+#include "string_view.h"
+#include "colt/hash.h"
+#include "colt/unicode/transcode.h"
+
+namespace clt
+{
+  namespace details
+  {
+    /// @brief A type convertible to a BasicStringView using 'to_view()'
+    template<typename T>
+    concept ToStringView = requires(const T& str) {
+      str.to_view();
+      decltype(str.to_view())::STR_ENCODING;
+    };
+
+    /// @brief Appends the UTF8 representation of a view to a hash algorithm.
+    /// The bytes are hashed in chunks of CHUNK_SIZE bytes (except for the
+    /// last one): as the chunks do not depend on the encoding of the view,
+    /// neither does the result (for any algorithm).
+    /// Non-UTF8 views are transcoded in blocks (by the SIMD kernels). If a
+    /// block is invalid, the rest of the view is hashed as is.
+    /// @tparam Algo The hashing algorithm
+    /// @tparam ENCODING The encoding of the view
+    /// @param algo The hashing algorithm object
+    /// @param view The view to hash
+    template<meta::hash_algorithm Algo, StringEncoding ENCODING>
+    void utf8_hash_append(Algo& algo, BasicStringView<ENCODING> view) noexcept
+    {
+      using ptr_t                        = meta::encoding_to_char_t<ENCODING>;
+      static constexpr size_t CHUNK_SIZE = 256;
+
+      const ptr_t* ptr = view.data();
+      const ptr_t* end = ptr + view.unit_len();
+      if constexpr (meta::is_any_of<ptr_t, char, Char8>)
+      {
+        // Already UTF8
+        for (; static_cast<size_t>(end - ptr) > CHUNK_SIZE; ptr += CHUNK_SIZE)
+          algo(ptr, CHUNK_SIZE);
+        if (ptr != end)
+          algo(ptr, static_cast<size_t>(end - ptr));
+      }
+      else
+      {
+        // A unit is transcoded to at most 4 bytes
+        static constexpr size_t BLOCK_SIZE = CHUNK_SIZE / 4;
+
+        Char8 buffer[CHUNK_SIZE * 2];
+        size_t size = 0;
+        while (ptr != end)
+        {
+          size_t block = clt::min(BLOCK_SIZE, static_cast<size_t>(end - ptr));
+          if constexpr (meta::is_any_of<ptr_t, Char16BE, Char16LE>)
+          {
+            // Do not split a surrogate pair
+            if (block == BLOCK_SIZE && ptr[block - 1].is_lead_surrogate())
+              --block;
+          }
+          auto written = uni::transcode<Char8>(
+              std::span<const ptr_t>{ptr, block},
+              Span<Char8>{buffer + size, 4 * block});
+          if (written.is_error())
+          {
+            if (size != 0)
+              algo(buffer, size);
+            algo(ptr, static_cast<size_t>(end - ptr) * sizeof(ptr_t));
+            return;
+          }
+          ptr += block;
+          size += *written;
+          if (size >= CHUNK_SIZE)
+          {
+            algo(buffer, CHUNK_SIZE);
+            size -= CHUNK_SIZE;
+            std::memcpy(buffer, buffer + CHUNK_SIZE, size);
+          }
+        }
+        if (size != 0)
+          algo(buffer, size);
+      }
+    }
+  } // namespace details
+
+  /// @brief Non-owning view over contiguous characters whose encoding is
+  ///        determined at runtime.
+  /// Use `visit` to obtain the typed BasicStringView.
+  class AnyStringView
+  {
+    /// @brief The pointer to the characters
+    const void* _ptr;
+    /// @brief The count of units in the view
+    size_t _size;
+    /// @brief The encoding of the characters
+    StringEncoding _encoding;
+
+    /// @brief Returns the typed view (the encoding must be ENCODING)
+    /// @tparam ENCODING The encoding
+    /// @return The typed view
+    template<StringEncoding ENCODING>
+    constexpr BasicStringView<ENCODING> _as() const noexcept
+    {
+      return {static_cast<const meta::encoding_to_char_t<ENCODING>*>(_ptr), _size};
+    }
+
+  public:
+    /// @brief Returned by find when not found
+    static constexpr size_t npos = (size_t)-1;
+
+    /// @brief Constructs an empty (ASCII) view
+    constexpr AnyStringView() noexcept
+        : _ptr(nullptr)
+        , _size(0)
+        , _encoding(StringEncoding::ASCII)
+    {
+    }
+
+    /// @brief Constructs a view from a typed view
+    /// @tparam ENCODING The encoding of the view
+    /// @tparam ZSTRING True if the view is NUL-terminated
+    /// @param str The view
+    template<StringEncoding ENCODING, bool ZSTRING>
+    constexpr AnyStringView(BasicStringView<ENCODING, ZSTRING> str) noexcept
+        : _ptr(str.data())
+        , _size(str.unit_len())
+        , _encoding(ENCODING)
+    {
+    }
+
+    /// @brief Constructs a view from a unicode literal
+    /// @tparam T The char type of the literal
+    /// @tparam N The size of the literal
+    /// @param str The literal
+    template<meta::CharType T, size_t N>
+    constexpr AnyStringView(const UnicodeLiteral<T, N>& str) noexcept
+        : AnyStringView(str.to_zview())
+    {
+    }
+
+    /// @brief Constructs a view from a string (such as a BasicString)
+    /// @tparam T The string type
+    /// @param str The string (which must outlive the view)
+    template<details::ToStringView T>
+    constexpr AnyStringView(const T& str) noexcept
+        : AnyStringView(str.to_view())
+    {
+    }
+
+    /// @brief Constructs a view over units of a runtime encoding
+    /// @param ptr The start of the units (can be null only if 'units' is 0)
+    /// @param units The count of units (of the size of the encoding)
+    /// @param encoding The encoding of the units
+    constexpr AnyStringView(
+        const void* ptr, size_t units, StringEncoding encoding) noexcept
+        : _ptr(ptr)
+        , _size(units)
+        , _encoding(encoding)
+    {
+      assert_true(
+          "ptr cannot be null if size != 0!", implies(_ptr == nullptr, _size == 0));
+    }
+
+    MAKE_DEFAULT_COPY_AND_MOVE_FOR(AnyStringView);
+
+    /// @brief Calls 'fn' with the typed BasicStringView.
+    /// The encoding is switched on once: 'fn' is instantiated for
+    /// each encoding, and must return the same type for all of them.
+    /// @tparam Fn The function type
+    /// @param fn The function taking a BasicStringView<ENCODING>
+    /// @return The result of 'fn'
+    template<typename Fn>
+    constexpr decltype(auto) visit(Fn&& fn) const
+    {
+      using enum StringEncoding;
+      switch_no_default(_encoding)
+      {
+      case ASCII:
+        return std::forward<Fn>(fn)(_as<ASCII>());
+      case UTF8:
+        return std::forward<Fn>(fn)(_as<UTF8>());
+      case UTF16BE:
+        return std::forward<Fn>(fn)(_as<UTF16BE>());
+      case UTF16LE:
+        return std::forward<Fn>(fn)(_as<UTF16LE>());
+      case UTF32BE:
+        return std::forward<Fn>(fn)(_as<UTF32BE>());
+      case UTF32LE:
+        return std::forward<Fn>(fn)(_as<UTF32LE>());
+      }
+    }
+
+    /// @brief Returns the typed view if the encoding is ENCODING
+    /// @tparam ENCODING The expected encoding
+    /// @return None if the encoding is not ENCODING
+    template<StringEncoding ENCODING>
+    constexpr Option<BasicStringView<ENCODING>> as() const noexcept
+    {
+      if (_encoding != ENCODING)
+        return None;
+      return _as<ENCODING>();
+    }
+
+    /// @brief Returns the encoding of the view
+    /// @return The encoding
+    constexpr StringEncoding encoding() const noexcept { return _encoding; }
+
+    /// @brief Returns a pointer to the units of the view
+    /// @return Pointer to the units (of the size of the encoding)
+    constexpr const void* data() const noexcept { return _ptr; }
+
+    /// @brief Returns the count of units of the view
+    /// @return The unit count
+    constexpr size_t unit_len() const noexcept { return _size; }
+
+    /// @brief Returns the count of bytes of the view
+    /// @return The byte count
+    constexpr size_t byte_len() const noexcept
+    {
+      return visit(
+          []<StringEncoding ENCODING>(BasicStringView<ENCODING> view)
+          {
+            return view.unit_len()
+                   * sizeof(meta::encoding_to_char_t<ENCODING>);
+          });
+    }
+
+    /// @brief Check if the view is empty
+    /// @return True if unit_len() == 0
+    constexpr bool is_empty() const noexcept { return _size == 0; }
+
+    /// @brief Returns the count of code points in the view
+    /// @return The count of code points
+    constexpr size_t size() const noexcept
+    {
+      return visit([](auto view) { return view.size(); });
+    }
+
+    /// @brief Returns the count of code points and of units of the view
+    /// @return The LenInfo of the view
+    constexpr uni::LenInfo len() const noexcept { return {size(), _size}; }
+
+    /// @brief Validates the view
+    /// @return None if invalid, else the count of code points and units
+    constexpr Option<uni::LenInfo> validate() const noexcept
+    {
+      return visit([](auto view)
+                   { return uni::validate(view.data(), view.unit_len()); });
+    }
+
+    /// @brief Searches for the first occurrence of a code point
+    /// @param chr The code point to search for
+    /// @param starting_offset The unit offset from which to start searching
+    /// @return The unit offset of the code point or npos if not found
+    constexpr size_t find(char32_t chr, size_t starting_offset = 0) const noexcept
+    {
+      return visit([=](auto view) { return view.find(chr, starting_offset); });
+    }
+
+    /// @brief Searches for the first occurrence of a view (of any encoding).
+    /// If the encodings differ, the first code point of 'strv' is searched
+    /// for, then the following ones are compared.
+    /// @param strv The view to search for
+    /// @param starting_offset The unit offset from which to start searching
+    /// @return The unit offset of the view or npos if not found
+    constexpr size_t find(
+        AnyStringView strv, size_t starting_offset = 0) const noexcept
+    {
+      return visit(
+          [&]<StringEncoding ENCODING>(BasicStringView<ENCODING> view)
+          {
+            return strv.visit(
+                [&]<StringEncoding ENCODING2>(BasicStringView<ENCODING2> needle)
+                {
+                  if constexpr (ENCODING == ENCODING2)
+                    return view.find(needle, starting_offset);
+                  else
+                  {
+                    if (needle.is_empty())
+                      return starting_offset <= view.unit_len() ? starting_offset
+                                                                : npos;
+                    const char32_t first = needle.front();
+                    for (size_t offset = view.find(first, starting_offset);
+                         offset != npos; offset = view.find(first, offset + 1))
+                    {
+                      uni::CodePointIterator<ENCODING> it = view.data() + offset;
+                      auto needle_it = needle.begin();
+                      while (it != view.end() && needle_it != needle.end()
+                             && *it == *needle_it)
+                      {
+                        ++it;
+                        ++needle_it;
+                      }
+                      if (needle_it == needle.end())
+                        return offset;
+                    }
+                    return npos;
+                  }
+                });
+          });
+    }
+
+    /// @brief Returns the number of 'To' units needed to convert the view
+    /// @tparam To The destination char type
+    /// @return The number of units or INVALID_INPUT
+    template<meta::CharType To>
+    constexpr Expect<size_t, uni::ConvError> transcode_size() const noexcept
+    {
+      return visit(
+          []<StringEncoding ENCODING>(BasicStringView<ENCODING> view)
+          {
+            using From = meta::encoding_to_char_t<ENCODING>;
+            return uni::transcode_size<To>(
+                std::span<const From>{view.data(), view.unit_len()});
+          });
+    }
+
+    /// @brief Converts the view to the encoding of 'To'
+    /// @tparam To The destination char type
+    /// @param to The buffer where to write (see 'transcode_size')
+    /// @return The number of units written, INVALID_INPUT or NOT_ENOUGH_SPACE
+    template<meta::CharType To>
+    constexpr Expect<size_t, uni::ConvError> transcode(Span<To> to) const noexcept
+    {
+      return visit(
+          [=]<StringEncoding ENCODING>(BasicStringView<ENCODING> view)
+          {
+            using From = meta::encoding_to_char_t<ENCODING>;
+            return uni::transcode<To>(
+                std::span<const From>{view.data(), view.unit_len()}, to);
+          });
+    }
+
+    /// @brief Check if two views contain the same code points
+    /// @param v1 The first view
+    /// @param v2 The second view
+    /// @return True if all the code points of both views are the same
+    friend constexpr bool operator==(AnyStringView v1, AnyStringView v2) noexcept
+    {
+      return v1.visit(
+          [=](auto view1)
+          { return v2.visit([=](auto view2) { return view1 == view2; }); });
+    }
+
+    /// @brief Lexicographically compare the code points of two views
+    /// @param v1 The first view
+    /// @param v2 The second view
+    /// @return Result of comparison
+    friend constexpr std::strong_ordering operator<=>(
+        AnyStringView v1, AnyStringView v2) noexcept
+    {
+      return v1.visit(
+          [=](auto view1)
+          {
+            return v2.visit(
+                [=](auto view2) -> std::strong_ordering
+                {
+                  return std::lexicographical_compare_three_way(
+                      view1.begin(), view1.end(), view2.begin(), view2.end());
+                });
+          });
+    }
+
+    /// @brief Hashes the code points of a view.
+    /// Views that are equal have the same hash, whatever their encodings.
+    /// @tparam Algo The hashing algorithm
+    /// @param algo The hashing algorithm object
+    /// @param str The view to hash
+    template<meta::hash_algorithm Algo>
+    friend void hash_append(Algo& algo, const AnyStringView& str) noexcept
+    {
+      str.visit([&](auto view) { details::utf8_hash_append(algo, view); });
+    }
+  };
+} // namespace clt
+
+template<>
+/// @brief {fmt} specialization of AnyStringView
+struct fmt::formatter<clt::AnyStringView>
+{
+  template<typename ParseContext>
+  constexpr auto parse(ParseContext& ctx)
+  {
+    return ctx.begin();
+  }
+
+  template<typename FormatContext>
+  auto format(const clt::AnyStringView& str, FormatContext& ctx) const
+  {
+    return str.visit([&](auto view)
+                     { return fmt::format_to(ctx.out(), "{}", view); });
+  }
+};
+
+#endif // !HG_DSA_ANY_STRING_VIEW
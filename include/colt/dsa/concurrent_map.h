@@ -0,0 +1,546 @@
+/*****************************************************************/ /**
+ * @file   concurrent_map.h
+ * @brief  Contains ConcurrentMap, a hash map for read-mostly workloads
+ * whose lookups are lock-free.
+ * The buckets are lists of immutable nodes. Lookups pin an EpochDomain
+ * and traverse the list of their bucket without writing to any shared
+ * memory: read throughput scales with the count of cores.
+ * Writers lock the stripe of their bucket, and never modify a node that
+ * was published: a node is replaced by a copy (copy-on-write), and the
+ * unlinked nodes are retired to the domain. Growing the map copies the
+ * buckets (all the stripes are locked) to a table that replaces the
+ * previous one at once.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_CONCURRENT_MAP
+#define HG_COLT_CONCURRENT_MAP
+
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "colt/hash.h"
+#include "colt/dsa/option.h"
+#include "colt/exec/epoch.h"
+#include "colt/mem/simple_alloc.h"
+
+namespace clt
+{
+  /// @brief Hash map whose lookups are lock-free, and whose modifications
+  ///        lock one of STRIPE_COUNT stripes of buckets.
+  /// As values are never modified in place, lookups return copies (see
+  /// 'find') or run a callable while the domain is pinned (see 'visit').
+  /// The memory is obtained from ALLOCATOR, which must be thread-safe and
+  /// copyable (use a LocalAllocatorRef to allocate from a local allocator).
+  /// @code{.cpp}
+  /// ConcurrentMap<u64, Symbol> symbols;
+  /// // Any thread
+  /// symbols.insert(id, symbol);
+  /// if (auto symbol = symbols.find(id); symbol.is_value())
+  ///   ...
+  /// @endcode
+  /// @tparam Key The key type
+  /// @tparam Value The value type
+  /// @tparam HASH The hasher object
+  /// @tparam KEY_EQUAL The key comparator
+  /// @tparam ALLOCATOR The allocator
+  template<
+      std::copy_constructible Key, std::copy_constructible Value,
+      typename HASH = clt::default_hash, typename KEY_EQUAL = std::equal_to<Key>,
+      meta::Allocator ALLOCATOR = mem::Mallocator>
+  class ConcurrentMap
+  {
+  public:
+    /// @brief The count of stripes (each protected by a mutex)
+    static constexpr size_t STRIPE_COUNT = 32;
+    /// @brief The minimum count of buckets (a bucket belongs to the stripe
+    ///        'hash % STRIPE_COUNT' whatever the count of buckets)
+    static constexpr size_t MIN_BUCKETS = STRIPE_COUNT;
+
+  private:
+    /// @brief An immutable node (except for 'next')
+    struct Node
+    {
+      /// @brief The hash of the key
+      u64 hash;
+      /// @brief The key
+      Key key;
+      /// @brief The value
+      Value value;
+      /// @brief The next node of the bucket
+      std::atomic<Node*> next;
+    };
+
+    /// @brief The buckets, followed by the array of buckets
+    struct Table
+    {
+      /// @brief The count of buckets - 1
+      size_t mask;
+      /// @brief The heads of the buckets
+      std::atomic<Node*>* buckets;
+    };
+
+    /// @brief A stripe (aligned to avoid false sharing between stripes)
+    struct alignas(64) Stripe
+    {
+      /// @brief Protects the buckets of the stripe
+      std::mutex mtx{};
+    };
+
+    static_assert(
+        ALLOCATOR::alignment >= alignof(Node)
+            && ALLOCATOR::alignment >= alignof(Table),
+        "The allocator does not provide the required alignment!");
+
+    /// @brief The current table
+    std::atomic<Table*> table_;
+    /// @brief The count of key-value pairs
+    std::atomic<size_t> size_ = 0;
+    /// @brief The domain protecting the nodes and the tables
+    exec::EpochDomain* domain_;
+    /// @brief True if a node or a table was retired to the domain
+    std::atomic<bool> retired_ = false;
+    /// @brief The stripes
+    Stripe stripes[STRIPE_COUNT];
+    /// @brief The allocator
+    [[no_unique_address]] ALLOCATOR allocator_;
+
+    /// @brief Hashes a key
+    /// @param key The key
+    /// @return The hash
+    static u64 hash_of(const Key& key) noexcept
+    {
+      return static_cast<u64>(HASH{}(key));
+    }
+
+    /// @brief Returns the stripe of a hash
+    /// @param hash The hash
+    /// @return The stripe protecting the bucket of 'hash'
+    Stripe& stripe_of(u64 hash) noexcept
+    {
+      return stripes[hash & (STRIPE_COUNT - 1)];
+    }
+
+    /// @brief Allocates a table of empty buckets
+    /// @param count The count of buckets (a power of 2)
+    /// @return The table
+    Table* make_table(size_t count) noexcept
+    {
+      auto blk =
+          allocator_.alloc(sizeof(Table) + count * sizeof(std::atomic<Node*>));
+      assert_true("Could not allocate memory!", !blk.is_null());
+      auto table = static_cast<Table*>(blk.ptr());
+      auto heads = reinterpret_cast<std::atomic<Node*>*>(table + 1);
+      for (size_t i = 0; i < count; i++)
+        std::construct_at(heads + i, nullptr);
+      return std::construct_at(table, Table{count - 1, heads});
+    }
+
+    /// @brief Destroys and deallocates a node
+    /// @param node The node
+    void free_node(Node* node) noexcept
+    {
+      std::destroy_at(node);
+      allocator_.dealloc({node, sizeof(Node)});
+    }
+
+    /// @brief Destroys and deallocates a table and its nodes
+    /// @param table The table
+    void free_table(Table* table) noexcept
+    {
+      const size_t count = table->mask + 1;
+      for (size_t i = 0; i < count; i++)
+      {
+        auto node = table->buckets[i].load(std::memory_order_relaxed);
+        while (node != nullptr)
+          free_node(std::exchange(node, node->next.load(std::memory_order_relaxed)));
+        std::destroy_at(table->buckets + i);
+      }
+      std::destroy_at(table);
+      allocator_.dealloc(
+          {table, sizeof(Table) + count * sizeof(std::atomic<Node*>)});
+    }
+
+    /// @brief Allocates a node
+    /// @param hash The hash of the key
+    /// @param key The key
+    /// @param value The value
+    /// @param next The next node
+    /// @return The node
+    template<typename K, typename V>
+    Node* make_node(u64 hash, K&& key, V&& value, Node* next) noexcept
+    {
+      auto blk = allocator_.alloc(sizeof(Node));
+      assert_true("Could not allocate memory!", !blk.is_null());
+      return std::construct_at(
+          static_cast<Node*>(blk.ptr()), hash, std::forward<K>(key),
+          std::forward<V>(value), next);
+    }
+
+    /// @brief Retires a node that was unlinked (a stripe must be locked)
+    /// @param node The node
+    void retire(Node* node) noexcept
+    {
+      retired_.store(true, std::memory_order_relaxed);
+      domain_->retire(
+          node,
+          +[](void* ptr, void* map) noexcept
+          { static_cast<ConcurrentMap*>(map)->free_node(static_cast<Node*>(ptr)); },
+          this);
+    }
+
+    /// @brief Retires a table that was replaced (all stripes must be locked)
+    /// @param table The table
+    void retire(Table* table) noexcept
+    {
+      retired_.store(true, std::memory_order_relaxed);
+      domain_->retire(
+          table,
+          +[](void* ptr, void* map) noexcept
+          {
+            static_cast<ConcurrentMap*>(map)->free_table(static_cast<Table*>(ptr));
+          },
+          this);
+    }
+
+    /// @brief Returns the link pointing to the node of a key.
+    /// The stripe of 'hash' must be locked.
+    /// @param hash The hash of the key
+    /// @param key The key
+    /// @return The link to the node (whose value is null if not found)
+    std::atomic<Node*>& find_link(u64 hash, const Key& key) noexcept
+    {
+      auto table = table_.load(std::memory_order_relaxed);
+      auto link  = &table->buckets[hash & table->mask];
+      for (auto node = link->load(std::memory_order_relaxed); node != nullptr;
+           node      = link->load(std::memory_order_relaxed))
+      {
+        if (node->hash == hash && KEY_EQUAL{}(node->key, key))
+          break;
+        link = &node->next;
+      }
+      return *link;
+    }
+
+    /// @brief Inserts a node at the head of its bucket.
+    /// The stripe of 'hash' must be locked.
+    /// @param hash The hash of the key
+    /// @param key The key
+    /// @param value The value
+    /// @return True if the map should grow
+    template<typename K, typename V>
+    bool push_node(u64 hash, K&& key, V&& value) noexcept
+    {
+      auto table = table_.load(std::memory_order_relaxed);
+      auto& head = table->buckets[hash & table->mask];
+      head.store(
+          make_node(
+              hash, std::forward<K>(key), std::forward<V>(value),
+              head.load(std::memory_order_relaxed)),
+          std::memory_order_release);
+      return size_.fetch_add(1, std::memory_order_relaxed) + 1 > table->mask + 1;
+    }
+
+    /// @brief Replaces a node by a copy holding another value.
+    /// The stripe of the node must be locked.
+    /// @param link The link to the node
+    /// @param value The new value
+    template<typename V>
+    void replace_node(std::atomic<Node*>& link, V&& value) noexcept
+    {
+      auto old = link.load(std::memory_order_relaxed);
+      link.store(
+          make_node(
+              old->hash, old->key, std::forward<V>(value),
+              old->next.load(std::memory_order_relaxed)),
+          std::memory_order_release);
+      retire(old);
+    }
+
+    /// @brief Locks all the stripes
+    void lock_all() noexcept
+    {
+      for (auto& stripe : stripes)
+        stripe.mtx.lock();
+    }
+
+    /// @brief Unlocks all the stripes
+    void unlock_all() noexcept
+    {
+      for (auto& stripe : stripes)
+        stripe.mtx.unlock();
+    }
+
+    /// @brief Doubles the count of buckets if the map is still overloaded.
+    /// No stripe may be locked.
+    void grow() noexcept
+    {
+      lock_all();
+      auto old           = table_.load(std::memory_order_relaxed);
+      const size_t count = old->mask + 1;
+      if (size_.load(std::memory_order_relaxed) > count)
+      {
+        // Readers may be traversing the nodes: they are copied
+        auto table = make_table(count * 2);
+        for (size_t i = 0; i < count; i++)
+        {
+          for (auto node = old->buckets[i].load(std::memory_order_relaxed);
+               node != nullptr; node = node->next.load(std::memory_order_relaxed))
+          {
+            auto& head = table->buckets[node->hash & table->mask];
+            head.store(
+                make_node(
+                    node->hash, node->key, node->value,
+                    head.load(std::memory_order_relaxed)),
+                std::memory_order_relaxed);
+          }
+        }
+        table_.store(table, std::memory_order_release);
+        retire(old);
+      }
+      unlock_all();
+    }
+
+  public:
+    /// @brief Constructs an empty map
+    /// @param buckets The initial count of buckets (rounded up to a power
+    ///        of 2, and at least MIN_BUCKETS)
+    /// @param domain The domain protecting the nodes (which must outlive
+    ///        the map)
+    /// @param alloc The allocator
+    explicit ConcurrentMap(
+        size_t buckets = MIN_BUCKETS,
+        exec::EpochDomain& domain = exec::EpochDomain::global(),
+        const ALLOCATOR& alloc = ALLOCATOR{}) noexcept
+      requires std::is_default_constructible_v<ALLOCATOR>
+        : domain_(&domain)
+        , allocator_(alloc)
+    {
+      table_.store(
+          make_table(std::bit_ceil(buckets < MIN_BUCKETS ? MIN_BUCKETS : buckets)),
+          std::memory_order_relaxed);
+    }
+
+    /// @brief Constructs an empty map using 'alloc'
+    /// @param alloc The allocator
+    /// @param domain The domain protecting the nodes (which must outlive
+    ///        the map)
+    explicit ConcurrentMap(
+        const ALLOCATOR& alloc,
+        exec::EpochDomain& domain = exec::EpochDomain::global()) noexcept
+        : domain_(&domain)
+        , allocator_(alloc)
+    {
+      table_.store(make_table(MIN_BUCKETS), std::memory_order_relaxed);
+    }
+
+    ConcurrentMap(const ConcurrentMap&)            = delete;
+    ConcurrentMap(ConcurrentMap&&)                 = delete;
+    ConcurrentMap& operator=(const ConcurrentMap&) = delete;
+    ConcurrentMap& operator=(ConcurrentMap&&)      = delete;
+
+    /// @brief Destroys the map.
+    /// No thread may access the map concurrently. If nodes were retired,
+    /// waits for their reclamation (the current thread must not be pinned).
+    ~ConcurrentMap() noexcept
+    {
+      // The reclaimers of the retired nodes refer to this map
+      if (retired_.load(std::memory_order_relaxed))
+        domain_->synchronize();
+      free_table(table_.load(std::memory_order_relaxed));
+    }
+
+    /// @brief Runs a callable on the value of a key.
+    /// The domain is pinned while 'fn' runs: 'fn' should be short, and
+    /// must not keep references to the value.
+    /// @tparam Fn The callable type
+    /// @param key The key
+    /// @param fn The callable (taking a const reference to the value)
+    /// @return True if the key was found (and 'fn' ran)
+    template<typename Fn>
+      requires std::invocable<Fn&, const Value&>
+    bool visit(const Key& key, Fn&& fn) const noexcept
+    {
+      const u64 hash = hash_of(key);
+      auto guard     = domain_->pin();
+      auto table     = table_.load(std::memory_order_acquire);
+      for (auto node = table->buckets[hash & table->mask].load(
+               std::memory_order_acquire);
+           node != nullptr; node = node->next.load(std::memory_order_acquire))
+      {
+        if (node->hash == hash && KEY_EQUAL{}(node->key, key))
+        {
+          fn(std::as_const(node->value));
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /// @brief Returns a copy of the value of a key
+    /// @param key The key
+    /// @return The value or None if not found
+    Option<Value> find(const Key& key) const noexcept
+    {
+      Option<Value> ret = None;
+      visit(key, [&](const Value& value) { ret = value; });
+      return ret;
+    }
+
+    /// @brief Check if the map contains a key
+    /// @param key The key
+    /// @return True if found
+    bool contains(const Key& key) const noexcept
+    {
+      return visit(key, [](const Value&) {});
+    }
+
+    /// @brief Inserts a key-value pair if the key is not in the map
+    /// @param key The key
+    /// @param value The value
+    /// @return True if inserted, false if the key was already in the map
+    bool insert(Key key, Value value) noexcept
+    {
+      const u64 hash = hash_of(key);
+      bool should_grow;
+      {
+        auto lock = std::scoped_lock{stripe_of(hash).mtx};
+        if (find_link(hash, key).load(std::memory_order_relaxed) != nullptr)
+          return false;
+        should_grow = push_node(hash, std::move(key), std::move(value));
+      }
+      if (should_grow)
+        grow();
+      return true;
+    }
+
+    /// @brief Inserts a key-value pair, or replaces the value of the key
+    /// @param key The key
+    /// @param value The value
+    /// @return True if inserted, false if the value was replaced
+    bool insert_or_assign(Key key, Value value) noexcept
+    {
+      const u64 hash = hash_of(key);
+      bool should_grow;
+      {
+        auto lock  = std::scoped_lock{stripe_of(hash).mtx};
+        auto& link = find_link(hash, key);
+        if (link.load(std::memory_order_relaxed) != nullptr)
+        {
+          replace_node(link, std::move(value));
+          return false;
+        }
+        should_grow = push_node(hash, std::move(key), std::move(value));
+      }
+      if (should_grow)
+        grow();
+      return true;
+    }
+
+    /// @brief Updates the value of a key.
+    /// 'fn' modifies a copy of the value, which then replaces it: the
+    /// update is atomic for the readers.
+    /// @tparam Fn The callable type
+    /// @param key The key
+    /// @param fn The callable (taking a reference to the copy)
+    /// @return True if the key was found (and updated)
+    template<typename Fn>
+      requires std::invocable<Fn&, Value&>
+    bool update(const Key& key, Fn&& fn) noexcept
+    {
+      const u64 hash = hash_of(key);
+      auto lock      = std::scoped_lock{stripe_of(hash).mtx};
+      auto& link     = find_link(hash, key);
+      auto node      = link.load(std::memory_order_relaxed);
+      if (node == nullptr)
+        return false;
+      Value copy = node->value;
+      fn(copy);
+      replace_node(link, std::move(copy));
+      return true;
+    }
+
+    /// @brief Removes a key
+    /// @param key The key
+    /// @return True if the key was found (and removed)
+    bool erase(const Key& key) noexcept
+    {
+      const u64 hash = hash_of(key);
+      auto lock      = std::scoped_lock{stripe_of(hash).mtx};
+      auto& link     = find_link(hash, key);
+      auto node      = link.load(std::memory_order_relaxed);
+      if (node == nullptr)
+        return false;
+      // Readers on 'node' still reach the rest of the bucket
+      link.store(
+          node->next.load(std::memory_order_relaxed), std::memory_order_release);
+      size_.fetch_sub(1, std::memory_order_relaxed);
+      retire(node);
+      return true;
+    }
+
+    /// @brief Removes all the keys (the count of buckets is kept)
+    void clear() noexcept
+    {
+      lock_all();
+      auto old = table_.load(std::memory_order_relaxed);
+      table_.store(make_table(old->mask + 1), std::memory_order_release);
+      size_.store(0, std::memory_order_relaxed);
+      retire(old);
+      unlock_all();
+    }
+
+    /// @brief Runs a callable on each key-value pair.
+    /// The traversal is weakly consistent: pairs inserted or removed
+    /// concurrently may or may not be visited. The domain is pinned during
+    /// the whole traversal.
+    /// @tparam Fn The callable type
+    /// @param fn The callable (taking const references to the key and value)
+    template<typename Fn>
+      requires std::invocable<Fn&, const Key&, const Value&>
+    void for_each(Fn&& fn) const noexcept
+    {
+      auto guard         = domain_->pin();
+      auto table         = table_.load(std::memory_order_acquire);
+      const size_t count = table->mask + 1;
+      for (size_t i = 0; i < count; i++)
+      {
+        for (auto node = table->buckets[i].load(std::memory_order_acquire);
+             node != nullptr; node = node->next.load(std::memory_order_acquire))
+          fn(std::as_const(node->key), std::as_const(node->value));
+      }
+    }
+
+    /// @brief Returns the count of key-value pairs
+    /// @return The count of pairs (which may be outdated once returned)
+    size_t size() const noexcept { return size_.load(std::memory_order_relaxed); }
+
+    /// @brief Check if the map is empty
+    /// @return True if empty (which may be outdated once returned)
+    bool is_empty() const noexcept { return size() == 0; }
+
+    /// @brief Returns the count of buckets
+    /// @return The count of buckets (a power of 2)
+    size_t bucket_count() const noexcept
+    {
+      auto guard = domain_->pin();
+      return table_.load(std::memory_order_acquire)->mask + 1;
+    }
+
+    /// @brief Returns the domain protecting the nodes
+    /// @return The domain
+    exec::EpochDomain& domain() const noexcept { return *domain_; }
+
+    /// @brief Returns the allocator
+    /// @return The allocator
+    const ALLOCATOR& allocator() const noexcept { return allocator_; }
+  };
+} // namespace clt
+
+#endif // !HG_COLT_CONCURRENT_MAP
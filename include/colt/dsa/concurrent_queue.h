@@ -0,0 +1,501 @@
+/*****************************************************************/ /**
+ * @file   concurrent_queue.h
+ * @brief  Contains SpscRing and MpmcQueue, bounded lock-free queues.
+ * SpscRing is a ring of a single producer and a single consumer: each
+ * side keeps a copy of the index of the other, so that the shared
+ * indices are only read when the ring looks full (or empty).
+ * MpmcQueue is Dmitry Vyukov's bounded queue of any count of producers
+ * and consumers: each slot holds a sequence number telling whether it
+ * can be written or read for a given position, and the slots are padded
+ * to a cache line so that neighboring positions do not false share.
+ * Both queues provide batch operations, which publish (or claim)
+ * consecutive positions at once.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_CONCURRENT_QUEUE
+#define HG_COLT_CONCURRENT_QUEUE
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "colt/typedefs.h"
+#include "colt/dsa/option.h"
+#include "colt/mem/simple_alloc.h"
+
+namespace clt
+{
+#if defined(__cpp_lib_hardware_interference_size)
+  #if defined(COLT_GNU)
+    #pragma GCC diagnostic push
+    // The value is fixed by the translation unit: the layouts using it are
+    // not part of any ABI of the library (they are templates)
+    #pragma GCC diagnostic ignored "-Winterference-size"
+  #endif // COLT_GNU
+  /// @brief The size of which objects written by different threads should
+  ///        be apart to avoid false sharing
+  inline constexpr size_t CACHE_LINE_SIZE =
+      std::hardware_destructive_interference_size;
+  #if defined(COLT_GNU)
+    #pragma GCC diagnostic pop
+  #endif // COLT_GNU
+#else
+  /// @brief The size of which objects written by different threads should
+  ///        be apart to avoid false sharing
+  inline constexpr size_t CACHE_LINE_SIZE = 64;
+#endif // __cpp_lib_hardware_interference_size
+
+  namespace details
+  {
+    /// @brief Allocates a block aligned on CACHE_LINE_SIZE
+    /// @tparam ALLOCATOR The allocator type
+    /// @param alloc The allocator
+    /// @param size The size of the block
+    /// @return The block as returned by 'alloc' (to deallocate) and the
+    ///         aligned pointer
+    template<meta::Allocator ALLOCATOR>
+    std::pair<mem::MemBlock, void*> alloc_cache_aligned(
+        ALLOCATOR& alloc, size_t size) noexcept
+    {
+      constexpr size_t EXTRA =
+          ALLOCATOR::alignment >= CACHE_LINE_SIZE
+              ? 0
+              : CACHE_LINE_SIZE - ALLOCATOR::alignment;
+      auto blk = alloc.alloc(size + EXTRA);
+      assert_true("Could not allocate memory!", !blk.is_null());
+      void* ptr    = blk.ptr();
+      size_t space = size + EXTRA;
+      std::align(CACHE_LINE_SIZE, size, ptr, space);
+      return {blk, ptr};
+    }
+  } // namespace details
+
+  /// @brief Bounded lock-free queue of a single producer and a single
+  ///        consumer.
+  /// Only one thread may push, and one thread may pop, at a time.
+  /// The slots are allocated from ALLOCATOR on construction.
+  /// @tparam T The type of the elements
+  /// @tparam N The capacity (a power of 2)
+  /// @tparam ALLOCATOR The allocator
+  template<
+      typename T, size_t N, meta::Allocator ALLOCATOR = mem::Mallocator>
+  class SpscRing
+  {
+    static_assert(
+        N >= 2 && std::has_single_bit(N), "The capacity must be a power of 2!");
+    static_assert(
+        std::is_nothrow_move_constructible_v<T>
+            && std::is_nothrow_destructible_v<T>,
+        "T must be nothrow move constructible and destructible!");
+
+    /// @brief The position of the next pop (written by the consumer)
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head = 0;
+    /// @brief The copy of 'tail' of the consumer
+    size_t cached_tail = 0;
+    /// @brief The position of the next push (written by the producer)
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail = 0;
+    /// @brief The copy of 'head' of the producer
+    size_t cached_head = 0;
+    /// @brief The slots (read-only after construction)
+    alignas(CACHE_LINE_SIZE) T* slots;
+    /// @brief The block of the slots
+    mem::MemBlock blk;
+    /// @brief The allocator
+    [[no_unique_address]] ALLOCATOR allocator;
+
+    /// @brief The mask to apply to positions
+    static constexpr size_t MASK = N - 1;
+
+    /// @brief Returns the count of free slots for the producer.
+    /// 'head' is only read if the copy does not show enough free slots.
+    /// @param pos The position of the next push
+    /// @param wanted The count of slots wanted
+    /// @return The count of slots that can be written (at most 'wanted')
+    size_t free_slots(size_t pos, size_t wanted) noexcept
+    {
+      if (N - (pos - cached_head) < wanted)
+        cached_head = head.load(std::memory_order_acquire);
+      return std::min(wanted, N - (pos - cached_head));
+    }
+
+    /// @brief Returns the count of readable slots for the consumer.
+    /// 'tail' is only read if the copy does not show enough elements.
+    /// @param pos The position of the next pop
+    /// @param wanted The count of elements wanted
+    /// @return The count of slots that can be read (at most 'wanted')
+    size_t used_slots(size_t pos, size_t wanted) noexcept
+    {
+      if (cached_tail - pos < wanted)
+        cached_tail = tail.load(std::memory_order_acquire);
+      return std::min(wanted, cached_tail - pos);
+    }
+
+  public:
+    /// @brief Constructs an empty ring
+    SpscRing() noexcept
+      requires std::is_default_constructible_v<ALLOCATOR>
+        : SpscRing(ALLOCATOR{})
+    {
+    }
+
+    /// @brief Constructs an empty ring using 'alloc'
+    /// @param alloc The allocator
+    explicit SpscRing(const ALLOCATOR& alloc) noexcept
+        : allocator(alloc)
+    {
+      auto [block, ptr] = details::alloc_cache_aligned(allocator, N * sizeof(T));
+      blk               = block;
+      slots             = static_cast<T*>(ptr);
+    }
+
+    SpscRing(const SpscRing&)            = delete;
+    SpscRing(SpscRing&&)                 = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+    SpscRing& operator=(SpscRing&&)      = delete;
+
+    /// @brief Destroys the remaining elements
+    ~SpscRing() noexcept
+    {
+      const size_t end = tail.load(std::memory_order_relaxed);
+      for (size_t i = head.load(std::memory_order_relaxed); i != end; i++)
+        std::destroy_at(slots + (i & MASK));
+      allocator.dealloc(blk);
+    }
+
+    /// @brief Constructs an element at the back of the ring (producer only)
+    /// @tparam ...Args The types of the arguments
+    /// @param ...args The arguments forwarded to the constructor of T
+    /// @return True if constructed, false if the ring was full
+    template<typename... Args>
+      requires std::is_constructible_v<T, Args...>
+    bool emplace(Args&&... args) noexcept
+    {
+      const size_t pos = tail.load(std::memory_order_relaxed);
+      if (free_slots(pos, 1) == 0)
+        return false;
+      std::construct_at(slots + (pos & MASK), std::forward<Args>(args)...);
+      tail.store(pos + 1, std::memory_order_release);
+      return true;
+    }
+
+    /// @brief Pushes an element at the back of the ring (producer only)
+    /// @param value The element to move
+    /// @return True if pushed, false if the ring was full
+    bool push(T&& value) noexcept { return emplace(std::move(value)); }
+
+    /// @brief Pushes an element at the back of the ring (producer only)
+    /// @param value The element to copy
+    /// @return True if pushed, false if the ring was full
+    bool push(const T& value) noexcept
+      requires std::is_copy_constructible_v<T>
+    {
+      return emplace(value);
+    }
+
+    /// @brief Pushes as many elements of a span as possible (producer only).
+    /// The elements are published at once.
+    /// @param values The elements to copy
+    /// @return The count of elements pushed (from the front of 'values')
+    size_t push_batch(View<T> values) noexcept
+      requires std::is_copy_constructible_v<T>
+    {
+      const size_t pos   = tail.load(std::memory_order_relaxed);
+      const size_t count = free_slots(pos, values.size());
+      for (size_t i = 0; i < count; i++)
+        std::construct_at(slots + ((pos + i) & MASK), values[i]);
+      if (count != 0)
+        tail.store(pos + count, std::memory_order_release);
+      return count;
+    }
+
+    /// @brief Pops the element at the front of the ring (consumer only)
+    /// @return The element or None if the ring was empty
+    Option<T> pop() noexcept
+    {
+      const size_t pos = head.load(std::memory_order_relaxed);
+      if (used_slots(pos, 1) == 0)
+        return None;
+      T* slot       = slots + (pos & MASK);
+      Option<T> ret = std::move(*slot);
+      std::destroy_at(slot);
+      head.store(pos + 1, std::memory_order_release);
+      return ret;
+    }
+
+    /// @brief Pops as many elements as possible (consumer only).
+    /// The slots are released at once.
+    /// @param out Where to move the elements (which are assigned)
+    /// @return The count of elements popped (to the front of 'out')
+    size_t pop_batch(Span<T> out) noexcept
+      requires std::is_move_assignable_v<T>
+    {
+      const size_t pos   = head.load(std::memory_order_relaxed);
+      const size_t count = used_slots(pos, out.size());
+      for (size_t i = 0; i < count; i++)
+      {
+        T* slot = slots + ((pos + i) & MASK);
+        out[i]  = std::move(*slot);
+        std::destroy_at(slot);
+      }
+      if (count != 0)
+        head.store(pos + count, std::memory_order_release);
+      return count;
+    }
+
+    /// @brief Returns the count of elements (which may be outdated)
+    /// @return The count of elements
+    size_t size() const noexcept
+    {
+      const size_t begin = head.load(std::memory_order_acquire);
+      return tail.load(std::memory_order_acquire) - begin;
+    }
+
+    /// @brief Check if the ring is empty (which may be outdated)
+    /// @return True if empty
+    bool is_empty() const noexcept { return size() == 0; }
+
+    /// @brief Returns the capacity of the ring
+    /// @return N
+    static constexpr size_t capacity() noexcept { return N; }
+  };
+
+  /// @brief Bounded lock-free queue of any count of producers and consumers.
+  /// Each operation claims a position through a single CAS. Contrary to a
+  /// queue protected by a lock, a stalled producer only blocks consumers
+  /// at its own position (which is then seen as empty).
+  /// The slots are allocated from ALLOCATOR on construction, which must be
+  /// copyable (use a LocalAllocatorRef to allocate from a local allocator).
+  /// @tparam T The type of the elements
+  /// @tparam ALLOCATOR The allocator
+  template<typename T, meta::Allocator ALLOCATOR = mem::Mallocator>
+  class MpmcQueue
+  {
+    static_assert(
+        std::is_nothrow_move_constructible_v<T>
+            && std::is_nothrow_destructible_v<T>,
+        "T must be nothrow move constructible and destructible!");
+
+    /// @brief A slot (padded to avoid false sharing between slots)
+    struct alignas(CACHE_LINE_SIZE) Slot
+    {
+      /// @brief Equal to the position for a write, or to the position + 1
+      ///        for a read (of the position it is at)
+      std::atomic<size_t> sequence;
+      /// @brief The storage of the element
+      alignas(T) unsigned char storage[sizeof(T)];
+
+      /// @brief Returns the element
+      /// @return The element (which must be constructed)
+      T* get() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    /// @brief The position of the next push
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail = 0;
+    /// @brief The position of the next pop
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head = 0;
+    /// @brief The slots (read-only after construction)
+    alignas(CACHE_LINE_SIZE) Slot* slots;
+    /// @brief The capacity - 1
+    size_t mask;
+    /// @brief The block of the slots
+    mem::MemBlock blk;
+    /// @brief The allocator
+    [[no_unique_address]] ALLOCATOR allocator;
+
+    /// @brief Claims up to 'max' consecutive positions.
+    /// A position is ready if the sequence of its slot is 'pos + OFFSET'.
+    /// @tparam OFFSET 0 to claim positions to write, 1 to read
+    /// @param index The index to advance (tail or head)
+    /// @param max The maximum count of positions to claim
+    /// @return The first claimed position and the count claimed (0 if none)
+    template<size_t OFFSET>
+    std::pair<size_t, size_t> claim(
+        std::atomic<size_t>& index, size_t max) noexcept
+    {
+      size_t pos = index.load(std::memory_order_relaxed);
+      for (;;)
+      {
+        size_t count = 0;
+        bool retry   = false;
+        while (count < max)
+        {
+          const size_t seq = slots[(pos + count) & mask].sequence.load(
+              std::memory_order_acquire);
+          const auto diff =
+              static_cast<std::ptrdiff_t>(seq - (pos + count + OFFSET));
+          if (diff == 0)
+          {
+            ++count;
+            continue;
+          }
+          // The position was claimed by another thread: reloads
+          retry = diff > 0 && count == 0;
+          break;
+        }
+        if (count == 0 && !retry)
+          return {pos, 0};
+        if (count == 0)
+        {
+          pos = index.load(std::memory_order_relaxed);
+          continue;
+        }
+        // A slot that is ready stays ready until its position is claimed
+        if (index.compare_exchange_weak(
+                pos, pos + count, std::memory_order_relaxed,
+                std::memory_order_relaxed))
+          return {pos, count};
+      }
+    }
+
+  public:
+    /// @brief Constructs an empty queue
+    /// @param capacity The capacity (rounded up to a power of 2, at least 2)
+    explicit MpmcQueue(size_t capacity) noexcept
+      requires std::is_default_constructible_v<ALLOCATOR>
+        : MpmcQueue(capacity, ALLOCATOR{})
+    {
+    }
+
+    /// @brief Constructs an empty queue using 'alloc'
+    /// @param capacity The capacity (rounded up to a power of 2, at least 2)
+    /// @param alloc The allocator
+    MpmcQueue(size_t capacity, const ALLOCATOR& alloc) noexcept
+        : allocator(alloc)
+    {
+      capacity          = std::bit_ceil(capacity < 2 ? size_t(2) : capacity);
+      mask              = capacity - 1;
+      auto [block, ptr] = details::alloc_cache_aligned(
+          allocator, capacity * sizeof(Slot));
+      blk               = block;
+      slots             = static_cast<Slot*>(ptr);
+      for (size_t i = 0; i < capacity; i++)
+        std::construct_at(&slots[i].sequence, i);
+    }
+
+    MpmcQueue(const MpmcQueue&)            = delete;
+    MpmcQueue(MpmcQueue&&)                 = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(MpmcQueue&&)      = delete;
+
+    /// @brief Destroys the remaining elements
+    ~MpmcQueue() noexcept
+    {
+      const size_t end = tail.load(std::memory_order_relaxed);
+      for (size_t i = head.load(std::memory_order_relaxed); i != end; i++)
+        std::destroy_at(slots[i & mask].get());
+      for (size_t i = 0; i <= mask; i++)
+        std::destroy_at(&slots[i].sequence);
+      allocator.dealloc(blk);
+    }
+
+    /// @brief Constructs an element at the back of the queue
+    /// @tparam ...Args The types of the arguments
+    /// @param ...args The arguments forwarded to the constructor of T
+    /// @return True if constructed, false if the queue was full
+    template<typename... Args>
+      requires std::is_constructible_v<T, Args...>
+    bool emplace(Args&&... args) noexcept
+    {
+      auto [pos, count] = claim<0>(tail, 1);
+      if (count == 0)
+        return false;
+      Slot& slot = slots[pos & mask];
+      std::construct_at(slot.get(), std::forward<Args>(args)...);
+      slot.sequence.store(pos + 1, std::memory_order_release);
+      return true;
+    }
+
+    /// @brief Pushes an element at the back of the queue
+    /// @param value The element to move
+    /// @return True if pushed, false if the queue was full
+    bool push(T&& value) noexcept { return emplace(std::move(value)); }
+
+    /// @brief Pushes an element at the back of the queue
+    /// @param value The element to copy
+    /// @return True if pushed, false if the queue was full
+    bool push(const T& value) noexcept
+      requires std::is_copy_constructible_v<T>
+    {
+      return emplace(value);
+    }
+
+    /// @brief Pushes as many elements of a span as possible.
+    /// The positions are claimed at once (they are consecutive).
+    /// @param values The elements to copy
+    /// @return The count of elements pushed (from the front of 'values')
+    size_t push_batch(View<T> values) noexcept
+      requires std::is_copy_constructible_v<T>
+    {
+      if (values.empty())
+        return 0;
+      auto [pos, count] = claim<0>(tail, values.size());
+      for (size_t i = 0; i < count; i++)
+      {
+        Slot& slot = slots[(pos + i) & mask];
+        std::construct_at(slot.get(), values[i]);
+        slot.sequence.store(pos + i + 1, std::memory_order_release);
+      }
+      return count;
+    }
+
+    /// @brief Pops the element at the front of the queue
+    /// @return The element or None if the queue was empty
+    Option<T> pop() noexcept
+    {
+      auto [pos, count] = claim<1>(head, 1);
+      if (count == 0)
+        return None;
+      Slot& slot    = slots[pos & mask];
+      Option<T> ret = std::move(*slot.get());
+      std::destroy_at(slot.get());
+      slot.sequence.store(pos + mask + 1, std::memory_order_release);
+      return ret;
+    }
+
+    /// @brief Pops as many elements as possible.
+    /// The positions are claimed at once (they are consecutive).
+    /// @param out Where to move the elements (which are assigned)
+    /// @return The count of elements popped (to the front of 'out')
+    size_t pop_batch(Span<T> out) noexcept
+      requires std::is_move_assignable_v<T>
+    {
+      if (out.empty())
+        return 0;
+      auto [pos, count] = claim<1>(head, out.size());
+      for (size_t i = 0; i < count; i++)
+      {
+        Slot& slot = slots[(pos + i) & mask];
+        out[i]     = std::move(*slot.get());
+        std::destroy_at(slot.get());
+        slot.sequence.store(pos + i + mask + 1, std::memory_order_release);
+      }
+      return count;
+    }
+
+    /// @brief Returns the count of elements (which may be outdated)
+    /// @return The count of elements
+    size_t size() const noexcept
+    {
+      const size_t begin = head.load(std::memory_order_acquire);
+      const size_t end   = tail.load(std::memory_order_acquire);
+      // Pops may have claimed positions whose pushes are not counted yet
+      return end > begin ? end - begin : 0;
+    }
+
+    /// @brief Check if the queue is empty (which may be outdated)
+    /// @return True if empty
+    bool is_empty() const noexcept { return size() == 0; }
+
+    /// @brief Returns the capacity of the queue
+    /// @return The capacity (a power of 2)
+    size_t capacity() const noexcept { return mask + 1; }
+  };
+} // namespace clt
+
+#endif // !HG_COLT_CONCURRENT_QUEUE
@@ -8,10 +8,149 @@
 #ifndef HG_DSA_EXPECT
 #define HG_DSA_EXPECT
 
+#include <memory>
 #include "common.h"
+#include "colt/meta/niche.h"
 
 namespace clt
 {
+  namespace details
+  {
+    template<
+        typename T, typename E, bool PACKED = meta::error_fits_in_niche<T, E>>
+    /// @brief The storage of an Expect: a union and a flag.
+    /// The active member is constructed and destroyed by the Expect.
+    /// @tparam T The expected type
+    /// @tparam E The error type
+    class ExpectStorage
+    {
+      union
+      {
+        /// @brief The expected value (active when is_error_v == false)
+        T expected;
+        /// @brief The error value (active when is_error_v == true)
+        E error_v;
+      };
+
+      /// @brief True if an error is stored in the Expect
+      bool is_error_v = false;
+
+    public:
+      /// @brief Constructs a storage without active member
+      constexpr ExpectStorage() noexcept {}
+      /// @brief Does not destroy the active member
+      constexpr ~ExpectStorage() noexcept {}
+
+      /// @brief Check if the storage contains an error
+      /// @return True if the storage contains an error
+      constexpr bool is_error() const noexcept { return is_error_v; }
+
+      /// @brief Returns the expected value
+      /// @return The expected value
+      constexpr T& value() noexcept { return expected; }
+      /// @brief Returns the expected value
+      /// @return The expected value
+      constexpr const T& value() const noexcept { return expected; }
+      /// @brief Returns the error
+      /// @return The error
+      constexpr E& error() noexcept { return error_v; }
+      /// @brief Returns the error
+      /// @return The error
+      constexpr const E& error() const noexcept { return error_v; }
+
+      template<typename... Args>
+      /// @brief Constructs the expected value (without active member)
+      /// @param ...args The arguments forwarded to the constructor
+      constexpr void construct_value(Args&&... args) noexcept(
+          std::is_nothrow_constructible_v<T, Args...>)
+      {
+        new (&expected) T(std::forward<Args>(args)...);
+        is_error_v = false;
+      }
+
+      template<typename... Args>
+      /// @brief Constructs the error (without active member)
+      /// @param ...args The arguments forwarded to the constructor
+      constexpr void construct_error(Args&&... args) noexcept(
+          std::is_nothrow_constructible_v<E, Args...>)
+      {
+        new (&error_v) E(std::forward<Args>(args)...);
+        is_error_v = true;
+      }
+
+      /// @brief Destroys the active member
+      constexpr void destroy() noexcept(
+          std::is_nothrow_destructible_v<T> && std::is_nothrow_destructible_v<E>)
+      {
+        if (is_error())
+          error_v.~E();
+        else
+          expected.~T();
+      }
+    };
+
+    template<typename T, typename E>
+    /// @brief The storage of an Expect whose errors fit in the niches of the
+    ///        expected type: the expected value, or the niche whose index is
+    ///        the index of the error (see meta::dense_values).
+    /// @tparam T The expected type
+    /// @tparam E The error type
+    class ExpectStorage<T, E, true>
+    {
+      /// @brief The expected value or a niche
+      T expected = meta::niche<T>::make(0);
+
+    public:
+      /// @brief Constructs a storage
+      constexpr ExpectStorage() noexcept = default;
+
+      /// @brief Check if the storage contains an error
+      /// @return True if the storage contains an error
+      constexpr bool is_error() const noexcept
+      {
+        return meta::niche<T>::index_of(expected) != meta::niche<T>::count;
+      }
+
+      /// @brief Returns the expected value
+      /// @return The expected value
+      constexpr T& value() noexcept { return expected; }
+      /// @brief Returns the expected value
+      /// @return The expected value
+      constexpr const T& value() const noexcept { return expected; }
+      /// @brief Returns the error
+      /// @return The error (by value)
+      constexpr E error() const noexcept
+      {
+        return meta::dense_values<E>::from_index(
+            meta::niche<T>::index_of(expected));
+      }
+
+      template<typename... Args>
+      /// @brief Constructs the expected value
+      /// @param ...args The arguments forwarded to the constructor
+      constexpr void construct_value(Args&&... args) noexcept(
+          std::is_nothrow_constructible_v<T, Args...>)
+      {
+        std::construct_at(&expected, std::forward<Args>(args)...);
+        assert_true(
+            "Niches of a type cannot be stored in an Expect!", !is_error());
+      }
+
+      template<typename... Args>
+      /// @brief Constructs the error
+      /// @param ...args The arguments forwarded to the constructor
+      constexpr void construct_error(Args&&... args) noexcept(
+          std::is_nothrow_constructible_v<E, Args...>)
+      {
+        expected = meta::niche<T>::make(
+            meta::dense_values<E>::to_index(E(std::forward<Args>(args)...)));
+      }
+
+      /// @brief Does nothing (both types are trivially destructible)
+      constexpr void destroy() noexcept {}
+    };
+  } // namespace details
+
   template<typename ExpectedTy, typename ErrorTy>
   /// @brief A helper class that can hold either a valid value or an error.
   /// This class can be seen as an Option, that carries error informations.
@@ -30,29 +169,27 @@ namespace clt
   ///   return { Error, "Division by zero is prohibited!" };
   /// }
   /// @endcode
+  /// If the errors fit in the niches of the expected type (see
+  /// meta::error_fits_in_niche, as for a bool and a reflected enum),
+  /// the Expect is the same size as the expected type, and error() returns
+  /// the error by value.
   /// @tparam ExpectedTy The expected type
   /// @tparam ErrorTy The error type
   class Expect
   {
-    /// @brief Buffer for both error type and expected value
-    union
-    {
-      /// @brief The expected value (active when is_error_v == false)
-      ExpectedTy expected;
-      /// @brief The error value (active when is_error_v == true)
-      ErrorTy error_v;
-    };
+    /// @brief True if the errors are stored in the niches of ExpectedTy
+    static constexpr bool IS_PACKED =
+        meta::error_fits_in_niche<ExpectedTy, ErrorTy>;
 
-    /// @brief True if an error is stored in the Expect
-    bool is_error_v;
+    /// @brief The expected value or the error
+    details::ExpectStorage<ExpectedTy, ErrorTy> storage;
 
   public:
     /// @brief Default constructs an error in the Expect
     /// @param  ErrorT tag
     constexpr Expect(error_t) noexcept(std::is_nothrow_constructible_v<ErrorTy>)
-        : is_error_v(true)
     {
-      new (&error_v) ErrorTy();
+      storage.construct_error();
     }
 
     /// @brief Copy constructs an error in the Expect
@@ -60,9 +197,8 @@ namespace clt
     /// @param value The value to copy
     constexpr Expect(error_t, const ErrorTy& value) noexcept(
         std::is_nothrow_copy_constructible_v<ErrorTy>)
-        : is_error_v(true)
     {
-      new (&error_v) ErrorTy(value);
+      storage.construct_error(value);
     }
 
     /// @brief Move constructs an error in the Expect
@@ -70,9 +206,8 @@ namespace clt
     /// @param to_move The value to move
     constexpr Expect(error_t, ErrorTy&& to_move) noexcept(
         std::is_nothrow_move_constructible_v<ErrorTy>)
-        : is_error_v(true)
     {
-      new (&error_v) ErrorTy(std::move(to_move));
+      storage.construct_error(std::move(to_move));
     }
 
     template<typename... Args>
@@ -81,43 +216,38 @@ namespace clt
     /// @param ...args Argument pack forwarded to the constructor
     constexpr Expect(in_place_t, error_t, Args&&... args) noexcept(
         std::is_nothrow_constructible_v<ErrorTy, Args...>)
-        : is_error_v(true)
     {
-      new (&error_v) ErrorTy(std::forward<Args>(args)...);
+      storage.construct_error(std::forward<Args>(args)...);
     }
 
     /// @brief Default constructs an expected value in the Expect
     constexpr Expect() noexcept(std::is_default_constructible_v<ExpectedTy>)
-        : is_error_v(false)
     {
-      new (&expected) ExpectedTy();
+      storage.construct_value();
     }
 
     /// @brief Copy constructs an expected value in the Expect
     /// @param value The value to copy
     constexpr Expect(const ExpectedTy& value) noexcept(
         std::is_nothrow_copy_constructible_v<ExpectedTy>)
-        : is_error_v(false)
     {
-      new (&expected) ExpectedTy(value);
+      storage.construct_value(value);
     }
 
     /// @brief Move constructs an expected value in the Expect
     /// @param to_move The value to move
     constexpr Expect(ExpectedTy&& to_move) noexcept(
         std::is_nothrow_move_constructible_v<ExpectedTy>)
-        : is_error_v(false)
     {
-      new (&expected) ExpectedTy(std::move(to_move));
+      storage.construct_value(std::move(to_move));
     }
 
     template<typename Ty, typename... Args>
       requires(!std::same_as<Ty, error_t>)
     constexpr Expect(in_place_t, Ty&& arg, Args&&... args) noexcept(
         std::is_nothrow_constructible_v<ExpectedTy, Ty, Args...>)
-        : is_error_v(false)
     {
-      new (&expected) ExpectedTy(std::forward<Ty>(arg), std::forward<Args>(args)...);
+      storage.construct_value(std::forward<Ty>(arg), std::forward<Args>(args)...);
     }
 
     /// @brief Copy constructs an Expect
@@ -125,12 +255,11 @@ namespace clt
     constexpr Expect(const Expect& copy) noexcept(
         std::is_nothrow_copy_constructible_v<ExpectedTy>
         && std::is_nothrow_copy_constructible_v<ErrorTy>)
-        : is_error_v(copy.is_error_v)
     {
-      if (is_error_v)
-        new (&error_v) ErrorTy(copy.error_v);
+      if (copy.is_error())
+        storage.construct_error(copy.storage.error());
       else
-        new (&expected) ExpectedTy(copy.expected);
+        storage.construct_value(copy.storage.value());
     }
 
     /// @brief Copy assignment operator
@@ -144,16 +273,11 @@ namespace clt
     {
       assert_true("Self-assignment is prohibited!", &copy != this);
 
-      if (is_error_v)
-        error_v.~ErrorTy();
+      storage.destroy();
+      if (copy.is_error())
+        storage.construct_error(copy.storage.error());
       else
-        expected.~ExpectedTy();
-
-      is_error_v = copy.is_error_v;
-      if (is_error_v)
-        new (&error_v) ErrorTy(copy.error_v);
-      else
-        new (&expected) ExpectedTy(copy.expected);
+        storage.construct_value(copy.storage.value());
 
       return *this;
     }
@@ -163,12 +287,11 @@ namespace clt
     constexpr Expect(Expect&& move) noexcept(
         std::is_nothrow_move_constructible_v<ExpectedTy>
         && std::is_nothrow_move_constructible_v<ErrorTy>)
-        : is_error_v(move.is_error_v)
     {
-      if (is_error_v)
-        new (&error_v) ErrorTy(std::move(move.error_v));
+      if (move.is_error())
+        storage.construct_error(std::move(move.storage.error()));
       else
-        new (&expected) ExpectedTy(std::move(move.expected));
+        storage.construct_value(std::move(move.storage.value()));
     }
 
     /// @brief Move assignment operator
@@ -182,16 +305,11 @@ namespace clt
     {
       assert_true("Self-assignment is prohibited!", &move != this);
 
-      if (is_error_v)
-        error_v.~ErrorTy();
+      storage.destroy();
+      if (move.is_error())
+        storage.construct_error(std::move(move.storage.error()));
       else
-        expected.~ExpectedTy();
-
-      is_error_v = move.is_error_v;
-      if (is_error_v)
-        new (&error_v) ErrorTy(std::move(move.error_v));
-      else
-        new (&expected) ExpectedTy(std::move(move.expected));
+        storage.construct_value(std::move(move.storage.value()));
 
       return *this;
     }
@@ -201,34 +319,31 @@ namespace clt
         std::is_nothrow_destructible_v<ExpectedTy>
         && std::is_nothrow_destructible_v<ErrorTy>)
     {
-      if (is_error_v)
-        error_v.~ErrorTy();
-      else
-        expected.~ExpectedTy();
+      storage.destroy();
     }
 
     /// @brief Check if the Expect contains an error
     /// @return True if the Expect contains an error
-    constexpr bool is_error() const noexcept { return is_error_v; }
+    constexpr bool is_error() const noexcept { return storage.is_error(); }
     /// @brief Check if the Expect contains an expected value
     /// @return True if the Expect contains an expected value
-    constexpr bool is_expect() const noexcept { return !is_error_v; }
+    constexpr bool is_expect() const noexcept { return !storage.is_error(); }
 
     /// @brief Check if the Expect contains an error.
     /// Same as is_error().
     /// @return True if the Expect contains an error
-    constexpr bool operator!() const noexcept { return is_error_v; }
+    constexpr bool operator!() const noexcept { return storage.is_error(); }
     /// @brief Check if the Expect contains an expected value.
     /// Same as is_expected().
     /// @return True if the Expect contains an expected value
-    explicit constexpr operator bool() const noexcept { return !is_error_v; }
+    explicit constexpr operator bool() const noexcept { return !storage.is_error(); }
 
     /// @brief Returns the stored Expect value.
     /// @return The Expect value
     constexpr const ExpectedTy* operator->() const noexcept
     {
       assert_true("Expect contained an error!", is_expect());
-      return &expected;
+      return &storage.value();
     }
 
     /// @brief Returns the stored Expect value.
@@ -236,7 +351,7 @@ namespace clt
     constexpr ExpectedTy* operator->() noexcept
     {
       assert_true("Expect contained an error!", is_expect());
-      return &expected;
+      return &storage.value();
     }
 
     /// @brief Returns the stored Expect value.
@@ -244,7 +359,7 @@ namespace clt
     constexpr const ExpectedTy& operator*() const& noexcept
     {
       assert_true("Expect contained an error!", is_expect());
-      return expected;
+      return storage.value();
     }
 
     /// @brief Returns the stored Expect value.
@@ -253,7 +368,7 @@ namespace clt
     constexpr ExpectedTy& operator*() & noexcept
     {
       assert_true("Expect contained an error!", is_expect());
-      return expected;
+      return storage.value();
     }
 
     /// @brief Returns the stored Expect value.
@@ -261,7 +376,7 @@ namespace clt
     constexpr const ExpectedTy&& operator*() const&& noexcept
     {
       assert_true("Expect contained an error!", is_expect());
-      return expected;
+      return storage.value();
     }
 
     /// @brief Returns the stored Expect value.
@@ -269,7 +384,7 @@ namespace clt
     constexpr ExpectedTy&& operator*() && noexcept
     {
       assert_true("Expect contained an error!", is_expect());
-      return std::move(expected);
+      return std::move(storage.value());
     }
 
     /// @brief Returns the stored Expect value.
@@ -277,7 +392,7 @@ namespace clt
     constexpr const ExpectedTy& value() const& noexcept
     {
       assert_true("Expect contained an error!", is_expect());
-      return expected;
+      return storage.value();
     }
 
     /// @brief Returns the stored Expect value.
@@ -285,7 +400,7 @@ namespace clt
     constexpr ExpectedTy& value() & noexcept
     {
       assert_true("Expect contained an error!", is_expect());
-      return expected;
+      return storage.value();
     }
 
     /// @brief Returns the stored Expect value.
@@ -293,7 +408,7 @@ namespace clt
     constexpr const ExpectedTy&& value() const&& noexcept
     {
       assert_true("Expect contained an error!", is_expect());
-      return expected;
+      return storage.value();
     }
 
     /// @brief Returns the stored Expect value.
@@ -301,39 +416,52 @@ namespace clt
     constexpr ExpectedTy&& value() && noexcept
     {
       assert_true("Expect contained an error!", is_expect());
-      return std::move(expected);
+      return std::move(storage.value());
     }
 
     /// @brief Returns the stored error value.
     /// @return The error value.
     constexpr const ErrorTy& error() const& noexcept
+      requires(!IS_PACKED)
     {
       assert_true("Expect did not contain an error!", is_error());
-      return error_v;
+      return storage.error();
     }
 
     /// @brief Returns the stored error value.
     /// @return The error value.
     constexpr ErrorTy& error() & noexcept
+      requires(!IS_PACKED)
     {
       assert_true("Expect did not contain an error!", is_error());
-      return error_v;
+      return storage.error();
     }
 
     /// @brief Returns the stored error value.
     /// @return The error value.
     constexpr const ErrorTy&& error() const&& noexcept
+      requires(!IS_PACKED)
     {
       assert_true("Expect did not contain an error!", is_error());
-      return error_v;
+      return std::move(storage.error());
     }
 
     /// @brief Returns the stored error value.
     /// @return The error value.
     constexpr ErrorTy&& error() && noexcept
+      requires(!IS_PACKED)
+    {
+      assert_true("Expect did not contain an error!", is_error());
+      return std::move(storage.error());
+    }
+
+    /// @brief Returns the stored error value (stored in a niche of ExpectedTy).
+    /// @return The error value.
+    constexpr ErrorTy error() const& noexcept
+      requires IS_PACKED
     {
       assert_true("Expect did not contain an error!", is_error());
-      return std::move(error_v);
+      return storage.error();
     }
 
     /// @brief Returns the Expect value if contained, else 'default_value'
@@ -342,7 +470,7 @@ namespace clt
     template<std::convertible_to<ExpectedTy> U>
     constexpr ExpectedTy value_or(U&& default_value) const&
     {
-      return is_error_v ? static_cast<ExpectedTy>(std::forward<U>(default_value))
+      return is_error() ? static_cast<ExpectedTy>(std::forward<U>(default_value))
                         : **this;
     }
     /// @brief Returns the Expect value if contained, else 'default_value'
@@ -351,7 +479,7 @@ namespace clt
     template<std::convertible_to<ExpectedTy> U>
     constexpr ExpectedTy value_or(U&& default_value) &&
     {
-      return is_error_v ? static_cast<ExpectedTy>(std::forward<U>(default_value))
+      return is_error() ? static_cast<ExpectedTy>(std::forward<U>(default_value))
                         : std::move(**this);
     }
 
@@ -364,7 +492,7 @@ namespace clt
                && std::convertible_to<std::invoke_result_t<Fn>, ExpectedTy>
     constexpr ExpectedTy value_or(Fn&& default_value) const&
     {
-      return is_error_v ? static_cast<ExpectedTy>(std::forward<Fn>(default_value)())
+      return is_error() ? static_cast<ExpectedTy>(std::forward<Fn>(default_value)())
                         : **this;
     }
 
@@ -373,7 +501,7 @@ namespace clt
                && std::convertible_to<std::invoke_result_t<Fn>, ExpectedTy>
     constexpr ExpectedTy value_or(Fn&& default_value) &&
     {
-      return is_error_v ? static_cast<ExpectedTy>(std::forward<Fn>(default_value)())
+      return is_error() ? static_cast<ExpectedTy>(std::forward<Fn>(default_value)())
                         : std::move(**this);
     }
 
@@ -550,14 +678,14 @@ namespace clt
     constexpr const ExpectedTy& value_or_abort(
         void (*on_abort)(void) noexcept = nullptr) const& noexcept
     {
-      if (is_error_v)
+      if (is_error())
       {
         if (on_abort)
           on_abort();
         std::abort();
       }
       else
-        return expected;
+        return storage.value();
     }
 
     /// @brief Returns the expected value, or aborts if it does not exist.
@@ -566,14 +694,14 @@ namespace clt
     constexpr ExpectedTy& value_or_abort(
         void (*on_abort)(void) noexcept = nullptr) & noexcept
     {
-      if (is_error_v)
+      if (is_error())
       {
         if (on_abort)
           on_abort();
         std::abort();
       }
       else
-        return expected;
+        return storage.value();
     }
 
     /// @brief Returns the expected value, or aborts if it does not exist.
@@ -582,14 +710,14 @@ namespace clt
     constexpr const ExpectedTy&& value_or_abort(
         void (*on_abort)(void) noexcept = nullptr) const&& noexcept
     {
-      if (is_error_v)
+      if (is_error())
       {
         if (on_abort)
           on_abort();
         std::abort();
       }
       else
-        return expected;
+        return storage.value();
     }
     /// @brief Returns the expected value, or aborts if it does not exist.
     /// @param on_abort The function to call before aborting or null
@@ -597,14 +725,14 @@ namespace clt
     constexpr ExpectedTy&& value_or_abort(
         void (*on_abort)(void) noexcept = nullptr) && noexcept
     {
-      if (is_error_v)
+      if (is_error())
       {
         if (on_abort)
           on_abort();
         std::abort();
       }
       else
-        return std::move(expected);
+        return std::move(storage.value());
     }
 
     template<typename Ser>
@@ -0,0 +1,1121 @@
+/*****************************************************************/ /**
+ * @file   flat_map.h
+ * @brief  Contains FlatMap and FlatSet, open-addressing hash tables.
+ * The tables are Swiss tables: each slot has a control byte which is
+ * either EMPTY, DELETED or the 7 low bits of the hash of its key.
+ * Control bytes are grouped by 16 and a whole group is compared at
+ * once using SSE2 (x86_64), NEON (ARM) or a portable fallback: most
+ * lookups only compare a single key.
+ * All the slots are stored contiguously in a single allocation.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_FLAT_MAP
+#define HG_COLT_FLAT_MAP
+
+#include <bit>
+#include <cstring>
+#include <utility>
+#include <colt/hash.h>
+#include <colt/dsa/common.h>
+#include <colt/mem/allocator_ref.h>
+
+#if defined(COLT_x86_64)
+  #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+  #include <arm_neon.h>
+  #define COLT_FLAT_MAP_NEON
+#endif // COLT_x86_64
+
+namespace clt::details::flat
+{
+  /// @brief The type of a control byte
+  using ctrl_t = i8;
+
+  /// @brief Control byte of an empty slot
+  static constexpr ctrl_t EMPTY = -128;
+  /// @brief Control byte of a slot whose object was erased (tombstone)
+  static constexpr ctrl_t DELETED = -2;
+  /// @brief The count of control bytes compared at once
+  static constexpr size_t GROUP_WIDTH = 16;
+
+  /// @brief Mask of the matching slots of a group.
+  /// Each slot is represented by (1 << SHIFT) bits of which only the
+  /// highest can be set.
+  /// @tparam SHIFT log2 of the count of bits per slot
+  template<u32 SHIFT>
+  class BitMask
+  {
+    /// @brief The mask
+    u64 mask;
+
+  public:
+    /// @brief Constructor
+    /// @param mask The mask
+    explicit constexpr BitMask(u64 mask) noexcept
+        : mask(mask)
+    {
+    }
+
+    /// @brief Check if any slot matched
+    explicit constexpr operator bool() const noexcept { return mask != 0; }
+
+    /// @brief Returns the index of the first matching slot
+    /// @return The index of the first matching slot
+    /// @pre The mask is not empty
+    constexpr u32 lowest() const noexcept
+    {
+      return static_cast<u32>(std::countr_zero(mask)) >> SHIFT;
+    }
+
+    /// @brief Removes the first matching slot from the mask
+    constexpr void clear_lowest() noexcept { mask &= mask - 1; }
+  };
+
+  /// @brief Group of GROUP_WIDTH control bytes
+  class Group
+  {
+#if defined(COLT_x86_64)
+    /// @brief The control bytes
+    __m128i ctrl;
+
+    /// @brief Converts the result of a comparison to a BitMask
+    static BitMask<0> to_mask(__m128i cmp) noexcept
+    {
+      return BitMask<0>(static_cast<u32>(_mm_movemask_epi8(cmp)));
+    }
+
+  public:
+    /// @brief The type of the masks returned
+    using mask_t = BitMask<0>;
+
+    /// @brief Loads the group beginning at 'ptr'
+    /// @param ptr Pointer to GROUP_WIDTH control bytes
+    explicit Group(const ctrl_t* ptr) noexcept
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)))
+    {
+    }
+
+    /// @brief Returns the slots whose control byte is 'h2'
+    /// @param h2 The 7 low bits of a hash
+    /// @return The matching slots
+    mask_t match(u8 h2) const noexcept
+    {
+      return to_mask(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(h2)), ctrl));
+    }
+
+    /// @brief Returns the empty slots
+    /// @return The empty slots
+    mask_t match_empty() const noexcept
+    {
+      return to_mask(_mm_cmpeq_epi8(_mm_set1_epi8(EMPTY), ctrl));
+    }
+
+    /// @brief Returns the empty or deleted slots.
+    /// These are the only control bytes whose highest bit is set.
+    /// @return The empty or deleted slots
+    mask_t match_free() const noexcept { return to_mask(ctrl); }
+#elif defined(COLT_FLAT_MAP_NEON)
+    /// @brief The control bytes
+    uint8x16_t ctrl;
+
+    /// @brief Converts the result of a comparison to a BitMask.
+    /// Each byte of the comparison is narrowed to 4 bits.
+    static BitMask<2> to_mask(uint8x16_t cmp) noexcept
+    {
+      const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+      return BitMask<2>(
+          vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ULL);
+    }
+
+  public:
+    /// @brief The type of the masks returned
+    using mask_t = BitMask<2>;
+
+    /// @brief Loads the group beginning at 'ptr'
+    /// @param ptr Pointer to GROUP_WIDTH control bytes
+    explicit Group(const ctrl_t* ptr) noexcept
+        : ctrl(vld1q_u8(reinterpret_cast<const u8*>(ptr)))
+    {
+    }
+
+    /// @brief Returns the slots whose control byte is 'h2'
+    /// @param h2 The 7 low bits of a hash
+    /// @return The matching slots
+    mask_t match(u8 h2) const noexcept
+    {
+      return to_mask(vceqq_u8(ctrl, vdupq_n_u8(h2)));
+    }
+
+    /// @brief Returns the empty slots
+    /// @return The empty slots
+    mask_t match_empty() const noexcept
+    {
+      return to_mask(vceqq_u8(ctrl, vdupq_n_u8(static_cast<u8>(EMPTY))));
+    }
+
+    /// @brief Returns the empty or deleted slots.
+    /// These are the only control bytes whose highest bit is set.
+    /// @return The empty or deleted slots
+    mask_t match_free() const noexcept
+    {
+      return to_mask(vcltq_s8(vreinterpretq_s8_u8(ctrl), vdupq_n_s8(0)));
+    }
+#else
+    /// @brief The control bytes
+    const ctrl_t* ctrl;
+
+    /// @brief Returns the slots for which 'pred' returns true
+    template<typename Fn>
+    BitMask<0> to_mask(Fn pred) const noexcept
+    {
+      u64 mask = 0;
+      for (size_t i = 0; i < GROUP_WIDTH; i++)
+        mask |= static_cast<u64>(pred(ctrl[i])) << i;
+      return BitMask<0>(mask);
+    }
+
+  public:
+    /// @brief The type of the masks returned
+    using mask_t = BitMask<0>;
+
+    /// @brief Loads the group beginning at 'ptr'
+    /// @param ptr Pointer to GROUP_WIDTH control bytes
+    explicit Group(const ctrl_t* ptr) noexcept
+        : ctrl(ptr)
+    {
+    }
+
+    /// @brief Returns the slots whose control byte is 'h2'
+    /// @param h2 The 7 low bits of a hash
+    /// @return The matching slots
+    mask_t match(u8 h2) const noexcept
+    {
+      return to_mask([h2](ctrl_t c) { return c == static_cast<ctrl_t>(h2); });
+    }
+
+    /// @brief Returns the empty slots
+    /// @return The empty slots
+    mask_t match_empty() const noexcept
+    {
+      return to_mask([](ctrl_t c) { return c == EMPTY; });
+    }
+
+    /// @brief Returns the empty or deleted slots
+    /// @return The empty or deleted slots
+    mask_t match_free() const noexcept
+    {
+      return to_mask([](ctrl_t c) { return c < 0; });
+    }
+#endif // COLT_x86_64
+  };
+
+  template<typename Slot, bool IS_CONST>
+  /// @brief Forward iterator over the full slots of a table
+  /// @tparam Slot The type of the slots
+  /// @tparam IS_CONST True if the objects can't be modified
+  class FlatIterator
+  {
+    template<typename, bool>
+    friend class FlatIterator;
+
+    /// @brief The control byte of the current slot
+    const ctrl_t* ctrl = nullptr;
+    /// @brief The end of the control bytes
+    const ctrl_t* ctrl_end = nullptr;
+    /// @brief The current slot
+    Slot* slot = nullptr;
+
+    /// @brief Skips the empty and deleted slots
+    constexpr void skip_free() noexcept
+    {
+      while (ctrl != ctrl_end && *ctrl < 0)
+      {
+        ++ctrl;
+        ++slot;
+      }
+    }
+
+  public:
+    /// @brief The type of the objects
+    using value_type = Slot;
+    /// @brief The type of references to the objects
+    using reference = std::conditional_t<IS_CONST, const Slot&, Slot&>;
+    /// @brief The type of pointers to the objects
+    using pointer = std::conditional_t<IS_CONST, const Slot*, Slot*>;
+    /// @brief The type of the difference of two iterators
+    using difference_type = std::ptrdiff_t;
+    /// @brief The category of the iterator
+    using iterator_category = std::forward_iterator_tag;
+
+    constexpr FlatIterator() noexcept = default;
+
+    /// @brief Constructs an iterator to the first full slot from 'slot'
+    /// @param ctrl The control byte of 'slot'
+    /// @param ctrl_end The end of the control bytes
+    /// @param slot The slot
+    constexpr FlatIterator(
+        const ctrl_t* ctrl, const ctrl_t* ctrl_end, Slot* slot) noexcept
+        : ctrl(ctrl)
+        , ctrl_end(ctrl_end)
+        , slot(slot)
+    {
+      skip_free();
+    }
+
+    /// @brief Converts a mutable iterator to a constant one
+    /// @param it The iterator
+    template<bool OTHER_CONST>
+      requires(IS_CONST && !OTHER_CONST)
+    constexpr FlatIterator(const FlatIterator<Slot, OTHER_CONST>& it) noexcept
+        : ctrl(it.ctrl)
+        , ctrl_end(it.ctrl_end)
+        , slot(it.slot)
+    {
+    }
+
+    /// @brief Returns the current object
+    /// @return The current object
+    constexpr reference operator*() const noexcept { return *slot; }
+    /// @brief Returns the current object
+    /// @return The current object
+    constexpr pointer operator->() const noexcept { return slot; }
+
+    /// @brief Advances to the next full slot
+    /// @return Self
+    constexpr FlatIterator& operator++() noexcept
+    {
+      ++ctrl;
+      ++slot;
+      skip_free();
+      return *this;
+    }
+
+    /// @brief Advances to the next full slot
+    /// @return The iterator before advancing
+    constexpr FlatIterator operator++(int) noexcept
+    {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    /// @brief Compares two iterators
+    /// @param other The other iterator
+    /// @return True if both iterators point to the same slot
+    constexpr bool operator==(const FlatIterator& other) const noexcept
+    {
+      return ctrl == other.ctrl;
+    }
+  };
+
+  template<
+      typename Key, typename Slot, typename KeyOf, typename HASH, typename KEY_EQUAL,
+      meta::Allocator ALLOCATOR>
+  /// @brief Swiss table, the implementation of FlatMap and FlatSet.
+  /// The capacity is either 0 or a power of 2 (multiple of GROUP_WIDTH),
+  /// and the table is grown when it is 7/8 full.
+  /// Groups are probed using triangular probing, which visits all the groups.
+  /// @tparam Key The key type
+  /// @tparam Slot The type stored in the table
+  /// @tparam KeyOf Functor returning the key of a slot
+  /// @tparam HASH The hasher object
+  /// @tparam KEY_EQUAL The key comparator
+  /// @tparam ALLOCATOR The allocator
+  class FlatTable : private ALLOCATOR
+  {
+    static_assert(
+        alignof(Slot) <= ALLOCATOR::alignment,
+        "The alignment of the allocator is not enough for the objects!");
+
+    /// @brief The slots (followed by the control bytes) or null
+    Slot* slots = nullptr;
+    /// @brief The control bytes (one for each slot) or null
+    ctrl_t* ctrl = nullptr;
+    /// @brief The capacity (0 or power of 2 >= GROUP_WIDTH)
+    size_t cap = 0;
+    /// @brief The count of full slots
+    size_t count = 0;
+    /// @brief The count of empty slots that can be filled before growing
+    size_t growth_left = 0;
+    /// @brief The hasher
+    [[no_unique_address]] HASH hasher;
+    /// @brief The comparator
+    [[no_unique_address]] KEY_EQUAL equal;
+
+    /// @brief The maximum count of objects of a table of capacity 'cap'
+    /// @param cap The capacity
+    /// @return The maximum count of objects (7/8 of 'cap')
+    static constexpr size_t max_load(size_t cap) noexcept { return cap - cap / 8; }
+
+    /// @brief Returns the smallest capacity that can hold 'size' objects
+    /// @param size The count of objects
+    /// @return The capacity
+    static constexpr size_t capacity_for(size_t size) noexcept
+    {
+      size_t cap = GROUP_WIDTH;
+      while (max_load(cap) < size)
+        cap *= 2;
+      return cap;
+    }
+
+    /// @brief Returns the 7 bits stored in the control byte
+    /// @param hash The hash
+    /// @return The low 7 bits of the hash
+    static constexpr u8 h2_of(size_t hash) noexcept { return hash & 0x7F; }
+
+    /// @brief Returns the index of the first group to probe
+    /// @param hash The hash
+    /// @return The remaining bits of the hash
+    static constexpr size_t h1_of(size_t hash) noexcept { return hash >> 7; }
+
+    /// @brief Marks a slot as full, empty or deleted
+    /// @param index The index of the slot
+    /// @param value The value of its control byte
+    void set_ctrl(size_t index, ctrl_t value) noexcept { ctrl[index] = value; }
+
+    /// @brief Returns the index of the first empty or deleted slot to
+    /// which an object of hash 'hash' can be inserted.
+    /// @param hash The hash of the object
+    /// @return The index of a free slot
+    /// @pre The table is not full
+    size_t find_free(size_t hash) const noexcept
+    {
+      const size_t group_mask = cap / GROUP_WIDTH - 1;
+      size_t group            = h1_of(hash) & group_mask;
+      for (size_t i = 1;; ++i)
+      {
+        auto mask = Group{ctrl + group * GROUP_WIDTH}.match_free();
+        if (mask)
+          return group * GROUP_WIDTH + mask.lowest();
+        group = (group + i) & group_mask;
+      }
+    }
+
+    /// @brief Allocates a new block and moves the objects to it
+    /// @param new_cap The new capacity (power of 2 >= GROUP_WIDTH)
+    void resize(size_t new_cap) noexcept
+    {
+      auto blk = ALLOCATOR::alloc(new_cap * (sizeof(Slot) + 1));
+      assert_true("Allocation failed!", !blk.is_null());
+
+      Slot* old_slots      = slots;
+      ctrl_t* old_ctrl     = ctrl;
+      const size_t old_cap = cap;
+
+      slots = static_cast<Slot*>(blk.ptr());
+      ctrl  = reinterpret_cast<ctrl_t*>(slots + new_cap);
+      cap   = new_cap;
+      std::memset(ctrl, static_cast<u8>(EMPTY), new_cap);
+      growth_left = max_load(new_cap) - count;
+
+      if (old_slots == nullptr)
+        return;
+      for (size_t i = 0; i < old_cap; i++)
+      {
+        if (old_ctrl[i] < 0)
+          continue;
+        const size_t hash  = hasher(KeyOf{}(old_slots[i]));
+        const size_t index = find_free(hash);
+        set_ctrl(index, static_cast<ctrl_t>(h2_of(hash)));
+        new (slots + index) Slot(std::move(old_slots[i]));
+        old_slots[i].~Slot();
+      }
+      ALLOCATOR::dealloc({old_slots, old_cap * (sizeof(Slot) + 1)});
+    }
+
+    /// @brief Makes space for an object, growing the table if needed
+    void prepare_insert() noexcept
+    {
+      if (growth_left != 0)
+        return;
+      // If many slots are deleted, rehashing reclaims them
+      if (cap != 0 && count <= max_load(cap) / 2)
+        resize(cap);
+      else
+        resize(cap == 0 ? GROUP_WIDTH : cap * 2);
+    }
+
+    /// @brief Destroys all the objects
+    void destroy_all() noexcept
+    {
+      if constexpr (!std::is_trivially_destructible_v<Slot>)
+      {
+        for (size_t i = 0; i < cap; i++)
+          if (ctrl[i] >= 0)
+            slots[i].~Slot();
+      }
+    }
+
+  public:
+    /// @brief The iterator type
+    using iterator = FlatIterator<Slot, false>;
+    /// @brief The const iterator type
+    using const_iterator = FlatIterator<Slot, true>;
+
+    /// @brief Constructor
+    /// @param alloc The allocator
+    explicit FlatTable(const ALLOCATOR& alloc) noexcept
+        : ALLOCATOR(alloc)
+    {
+    }
+
+    /// @brief Copy constructor
+    /// @param other The table to copy
+    FlatTable(const FlatTable& other) noexcept(
+        std::is_nothrow_copy_constructible_v<Slot>)
+        : ALLOCATOR(other)
+        , hasher(other.hasher)
+        , equal(other.equal)
+    {
+      if (other.count == 0)
+        return;
+      resize(capacity_for(other.count));
+      for (const auto& slot : other)
+      {
+        const size_t hash  = hasher(KeyOf{}(slot));
+        const size_t index = find_free(hash);
+        new (slots + index) Slot(slot);
+        set_ctrl(index, static_cast<ctrl_t>(h2_of(hash)));
+        ++count;
+        --growth_left;
+      }
+    }
+
+    /// @brief Move constructor
+    /// @param other The table whose resources to steal
+    FlatTable(FlatTable&& other) noexcept
+        : ALLOCATOR(other)
+        , slots(std::exchange(other.slots, nullptr))
+        , ctrl(std::exchange(other.ctrl, nullptr))
+        , cap(std::exchange(other.cap, 0))
+        , count(std::exchange(other.count, 0))
+        , growth_left(std::exchange(other.growth_left, 0))
+        , hasher(other.hasher)
+        , equal(other.equal)
+    {
+    }
+
+    /// @brief Copy assignment operator
+    /// @param other The table to copy
+    /// @return Self
+    FlatTable& operator=(const FlatTable& other) noexcept(
+        std::is_nothrow_copy_constructible_v<Slot>)
+    {
+      assert_true("Self assignment is prohibited!", &other != this);
+      FlatTable copy = other;
+      return *this = std::move(copy);
+    }
+
+    /// @brief Move assignment operator, swaps every member (allocator included)
+    /// @param other The table to swap with
+    /// @return Self
+    FlatTable& operator=(FlatTable&& other) noexcept
+    {
+      assert_true("Self assignment is prohibited!", &other != this);
+      if constexpr (!std::is_empty_v<ALLOCATOR>)
+        std::swap(static_cast<ALLOCATOR&>(other), static_cast<ALLOCATOR&>(*this));
+      std::swap(slots, other.slots);
+      std::swap(ctrl, other.ctrl);
+      std::swap(cap, other.cap);
+      std::swap(count, other.count);
+      std::swap(growth_left, other.growth_left);
+      std::swap(hasher, other.hasher);
+      std::swap(equal, other.equal);
+      return *this;
+    }
+
+    /// @brief Destroys all the objects and frees the memory
+    ~FlatTable() noexcept
+    {
+      if (slots == nullptr)
+        return;
+      destroy_all();
+      ALLOCATOR::dealloc({slots, cap * (sizeof(Slot) + 1)});
+    }
+
+    /// @brief Returns the count of objects in the table
+    /// @return The count of objects
+    size_t size() const noexcept { return count; }
+    /// @brief Returns the count of slots of the table
+    /// @return The capacity
+    size_t capacity() const noexcept { return cap; }
+    /// @brief Check if the table is empty
+    /// @return True if the table is empty
+    bool is_empty() const noexcept { return count == 0; }
+    /// @brief Returns the current load factor
+    /// @return size() / capacity()
+    float load_factor() const noexcept
+    {
+      return cap == 0 ? 0.0f : static_cast<float>(count) / static_cast<float>(cap);
+    }
+
+    /// @brief Returns the allocator
+    /// @return The allocator
+    const ALLOCATOR& get_allocator() const noexcept { return *this; }
+
+    /// @brief Ensures 'size' objects can be stored without growing
+    /// @param size The count of objects
+    void reserve(size_t size) noexcept
+    {
+      if (size > count + growth_left)
+        resize(capacity_for(size));
+    }
+
+    /// @brief Destroys all the objects (the memory is kept)
+    void clear() noexcept
+    {
+      if (slots == nullptr)
+        return;
+      destroy_all();
+      std::memset(ctrl, static_cast<u8>(EMPTY), cap);
+      count       = 0;
+      growth_left = max_load(cap);
+    }
+
+    /// @brief Returns the index of the slot whose key is equal to 'key'
+    /// @tparam K The type of the key
+    /// @param key The key
+    /// @param hash The hash of the key
+    /// @return The index of the slot or capacity() if not found
+    template<typename K>
+    size_t find_index(const K& key, size_t hash) const noexcept
+    {
+      if (cap == 0)
+        return cap;
+      const size_t group_mask = cap / GROUP_WIDTH - 1;
+      const u8 h2             = h2_of(hash);
+      size_t group            = h1_of(hash) & group_mask;
+      for (size_t i = 1;; ++i)
+      {
+        const Group grp{ctrl + group * GROUP_WIDTH};
+        for (auto mask = grp.match(h2); mask; mask.clear_lowest())
+        {
+          const size_t index = group * GROUP_WIDTH + mask.lowest();
+          if (HEDLEY_LIKELY(equal(KeyOf{}(slots[index]), key)))
+            return index;
+        }
+        // Insertion never skips a group with an empty slot
+        if (HEDLEY_LIKELY(grp.match_empty()))
+          return cap;
+        group = (group + i) & group_mask;
+      }
+    }
+
+    /// @brief Hashes a key
+    /// @tparam K The type of the key
+    /// @param key The key
+    /// @return The hash of the key
+    template<typename K>
+    size_t hash(const K& key) const noexcept
+    {
+      return static_cast<size_t>(hasher(key));
+    }
+
+    /// @brief Finds the slot of 'key' or constructs a new one using 'make'
+    /// @tparam K The type of the key
+    /// @tparam Fn The type of the functor
+    /// @param key The key
+    /// @param make Functor constructing the object in the pointer it receives
+    /// @return Pair of iterator to the slot and true if it was inserted
+    template<typename K, typename Fn>
+    std::pair<iterator, bool> find_or_insert(const K& key, Fn&& make)
+    {
+      const size_t hash = this->hash(key);
+      if (size_t index = find_index(key, hash); index != cap)
+        return {iterator_at(index), false};
+      prepare_insert();
+      const size_t index = find_free(hash);
+      make(slots + index);
+      if (ctrl[index] == EMPTY)
+        --growth_left;
+      set_ctrl(index, static_cast<ctrl_t>(h2_of(hash)));
+      ++count;
+      return {iterator_at(index), true};
+    }
+
+    /// @brief Destroys the object of a slot
+    /// @param index The index of the slot (which must be full)
+    void erase_at(size_t index) noexcept
+    {
+      assert_true("Invalid index!", index < cap && ctrl[index] >= 0);
+      slots[index].~Slot();
+      --count;
+      // A probe stops at a group containing an empty slot: the slot can
+      // only be marked empty if its group already contains one.
+      const size_t group = index / GROUP_WIDTH * GROUP_WIDTH;
+      if (Group{ctrl + group}.match_empty())
+      {
+        set_ctrl(index, EMPTY);
+        ++growth_left;
+      }
+      else
+        set_ctrl(index, DELETED);
+    }
+
+    /// @brief Returns the index of the slot pointed to by an iterator
+    /// @param it The iterator (not end())
+    /// @return The index of the slot
+    size_t index_of(const_iterator it) const noexcept
+    {
+      return static_cast<size_t>(&*it - slots);
+    }
+
+    /// @brief Returns an iterator to a slot
+    /// @param index The index of the slot (or capacity())
+    /// @return Iterator to the slot
+    iterator iterator_at(size_t index) noexcept
+    {
+      return {ctrl + index, ctrl + cap, slots + index};
+    }
+
+    /// @brief Returns an iterator to a slot
+    /// @param index The index of the slot (or capacity())
+    /// @return Iterator to the slot
+    const_iterator iterator_at(size_t index) const noexcept
+    {
+      return {ctrl + index, ctrl + cap, slots + index};
+    }
+
+    /// @brief Returns the object stored in a slot
+    /// @param index The index of the slot (which must be full)
+    /// @return The object
+    Slot& slot_at(size_t index) noexcept { return slots[index]; }
+    /// @brief Returns the object stored in a slot
+    /// @param index The index of the slot (which must be full)
+    /// @return The object
+    const Slot& slot_at(size_t index) const noexcept { return slots[index]; }
+
+    /// @brief Returns an iterator to the first object
+    iterator begin() noexcept { return iterator_at(0); }
+    /// @brief Returns an iterator past the last object
+    iterator end() noexcept { return iterator_at(cap); }
+    /// @brief Returns an iterator to the first object
+    const_iterator begin() const noexcept { return iterator_at(0); }
+    /// @brief Returns an iterator past the last object
+    const_iterator end() const noexcept { return iterator_at(cap); }
+  };
+
+  /// @brief Returns the key of a pair
+  struct KeyOfPair
+  {
+    template<typename Pair>
+    constexpr const auto& operator()(const Pair& pair) const noexcept
+    {
+      return pair.first;
+    }
+  };
+
+  /// @brief Returns the key of a set (the object itself)
+  struct KeyOfSelf
+  {
+    template<typename T>
+    constexpr const T& operator()(const T& value) const noexcept
+    {
+      return value;
+    }
+  };
+
+  /// @brief Check if HASH and KEY_EQUAL allow heterogeneous lookups
+  template<typename HASH, typename KEY_EQUAL>
+  concept transparent_lookup = requires {
+    typename HASH::is_transparent;
+    typename KEY_EQUAL::is_transparent;
+  };
+
+  /// @brief The type of the keys used for lookups.
+  /// If lookups are heterogeneous, K is deduced, else Key is used
+  /// (which allows implicit conversions to Key).
+  template<bool IS_TRANSPARENT>
+  struct KeyArg
+  {
+    template<typename K, typename Key>
+    using type = K;
+  };
+
+  /// @brief The type of the keys used for lookups (not transparent)
+  template<>
+  struct KeyArg<false>
+  {
+    template<typename K, typename Key>
+    using type = Key;
+  };
+} // namespace clt::details::flat
+
+namespace clt
+{
+  template<
+      typename Key, typename Value, meta::Allocator ALLOCATOR,
+      typename HASH = clt::default_hash,
+      typename KEY_EQUAL = std::equal_to<Key>>
+  /// @brief Open-addressing hash map (Swiss table).
+  /// The pairs are stored contiguously: inserting may invalidate all the
+  /// iterators and references. Keys must not be modified through iterators.
+  /// If both HASH and KEY_EQUAL are transparent (such as uni::CaseFoldHash
+  /// and uni::CaseFoldEqual), lookups can be done using any comparable type.
+  /// @tparam Key The key type
+  /// @tparam Value The value type
+  /// @tparam ALLOCATOR The allocator
+  /// @tparam HASH The hasher object
+  /// @tparam KEY_EQUAL The key comparator
+  class BasicFlatMap
+  {
+    /// @brief The underlying table
+    using table_t = details::flat::FlatTable<
+        Key, std::pair<Key, Value>, details::flat::KeyOfPair, HASH, KEY_EQUAL,
+        ALLOCATOR>;
+
+    /// @brief The underlying table
+    table_t table;
+
+    /// @brief True if lookups can be done using any comparable type
+    static constexpr bool IS_TRANSPARENT =
+        details::flat::transparent_lookup<HASH, KEY_EQUAL>;
+
+    /// @brief Check if K can be used for lookups
+    template<typename K>
+    static constexpr bool is_key = std::same_as<K, Key> || IS_TRANSPARENT;
+
+    /// @brief The type of the keys used for lookups
+    template<typename K>
+    using key_arg =
+        typename details::flat::KeyArg<IS_TRANSPARENT>::template type<K, Key>;
+
+  public:
+    /// @brief The type of the objects stored
+    using value_type = std::pair<Key, Value>;
+    /// @brief The iterator type
+    using iterator = typename table_t::iterator;
+    /// @brief The const iterator type
+    using const_iterator = typename table_t::const_iterator;
+
+    /// @brief Constructs an empty map
+    /// @param alloc The allocator
+    explicit BasicFlatMap(const ALLOCATOR& alloc) noexcept
+        : table(alloc)
+    {
+    }
+
+    /// @brief Constructs an empty map (when allocator is global)
+    BasicFlatMap() noexcept
+      requires(ALLOCATOR::is_global_allocator_ref)
+        : table(ALLOCATOR{})
+    {
+    }
+
+    /// @brief Returns the count of pairs
+    /// @return The count of pairs
+    size_t size() const noexcept { return table.size(); }
+    /// @brief Returns the count of slots
+    /// @return The capacity
+    size_t capacity() const noexcept { return table.capacity(); }
+    /// @brief Check if the map is empty
+    /// @return True if the map is empty
+    bool is_empty() const noexcept { return table.is_empty(); }
+    /// @brief Returns the load factor
+    /// @return size() / capacity()
+    float load_factor() const noexcept { return table.load_factor(); }
+    /// @brief Returns the allocator
+    /// @return The allocator
+    const ALLOCATOR& get_allocator() const noexcept { return table.get_allocator(); }
+
+    /// @brief Ensures 'size' pairs can be stored without growing
+    /// @param size The count of pairs
+    void reserve(size_t size) noexcept { table.reserve(size); }
+    /// @brief Destroys all the pairs (the memory is kept)
+    void clear() noexcept { table.clear(); }
+
+    /// @brief Returns an iterator to the pair whose key is 'key'
+    /// @tparam K The type of the key
+    /// @param key The key
+    /// @return Iterator to the pair or end()
+    template<typename K = Key>
+    iterator find(const key_arg<K>& key) noexcept
+    {
+      return table.iterator_at(table.find_index(key, table.hash(key)));
+    }
+
+    /// @brief Returns an iterator to the pair whose key is 'key'
+    /// @tparam K The type of the key
+    /// @param key The key
+    /// @return Iterator to the pair or end()
+    template<typename K = Key>
+    const_iterator find(const key_arg<K>& key) const noexcept
+    {
+      return table.iterator_at(table.find_index(key, table.hash(key)));
+    }
+
+    /// @brief Returns a pointer to the value whose key is 'key'
+    /// @tparam K The type of the key
+    /// @param key The key
+    /// @return Pointer to the value or null
+    template<typename K = Key>
+    Value* get(const key_arg<K>& key) noexcept
+    {
+      const size_t index = table.find_index(key, table.hash(key));
+      return index == table.capacity() ? nullptr : &table.slot_at(index).second;
+    }
+
+    /// @brief Returns a pointer to the value whose key is 'key'
+    /// @tparam K The type of the key
+    /// @param key The key
+    /// @return Pointer to the value or null
+    template<typename K = Key>
+    const Value* get(const key_arg<K>& key) const noexcept
+    {
+      const size_t index = table.find_index(key, table.hash(key));
+      return index == table.capacity() ? nullptr : &table.slot_at(index).second;
+    }
+
+    /// @brief Check if the map contains a key
+    /// @tparam K The type of the key
+    /// @param key The key
+    /// @return True if the map contains 'key'
+    template<typename K = Key>
+    bool contains(const key_arg<K>& key) const noexcept
+    {
+      return table.find_index(key, table.hash(key)) != table.capacity();
+    }
+
+    /// @brief Inserts a pair if 'key' is not already in the map
+    /// @tparam K The type of the key
+    /// @tparam ...Args The types of the arguments
+    /// @param key The key
+    /// @param ...args The arguments to forward to the constructor of Value
+    /// @return Pair of iterator to the pair and true if it was inserted
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+    {
+      // The key must be converted to be hashed as a Key
+      if constexpr (!is_key<std::remove_cvref_t<K>>)
+        return try_emplace(Key(std::forward<K>(key)), std::forward<Args>(args)...);
+      else
+        return table.find_or_insert(
+            key,
+            [&](value_type* ptr)
+            {
+              new (ptr) value_type(
+                  std::piecewise_construct,
+                  std::forward_as_tuple(std::forward<K>(key)),
+                  std::forward_as_tuple(std::forward<Args>(args)...));
+            });
+    }
+
+    /// @brief Inserts a pair if its key is not already in the map
+    /// @param pair The pair to insert
+    /// @return Pair of iterator to the pair and true if it was inserted
+    std::pair<iterator, bool> insert(value_type pair)
+    {
+      return try_emplace(std::move(pair.first), std::move(pair.second));
+    }
+
+    /// @brief Inserts or assigns the value of a key
+    /// @tparam K The type of the key
+    /// @tparam V The type of the value
+    /// @param key The key
+    /// @param value The value
+    /// @return Pair of iterator to the pair and true if it was inserted
+    template<typename K, typename V>
+    std::pair<iterator, bool> insert_or_assign(K&& key, V&& value)
+    {
+      auto ret = try_emplace(std::forward<K>(key), std::forward<V>(value));
+      if (!ret.second)
+        ret.first->second = std::forward<V>(value);
+      return ret;
+    }
+
+    /// @brief Returns the value of 'key', default constructing it if needed
+    /// @param key The key
+    /// @return The value
+    Value& operator[](const Key& key) { return try_emplace(key).first->second; }
+    /// @brief Returns the value of 'key', default constructing it if needed
+    /// @param key The key
+    /// @return The value
+    Value& operator[](Key&& key)
+    {
+      return try_emplace(std::move(key)).first->second;
+    }
+
+    /// @brief Erases the pair whose key is 'key'
+    /// @tparam K The type of the key
+    /// @param key The key
+    /// @return True if a pair was erased
+    template<typename K = Key>
+    bool erase(const key_arg<K>& key) noexcept
+    {
+      const size_t index = table.find_index(key, table.hash(key));
+      if (index == table.capacity())
+        return false;
+      table.erase_at(index);
+      return true;
+    }
+
+    /// @brief Erases the pair pointed to by an iterator
+    /// @param it The iterator (not end())
+    void erase(const_iterator it) noexcept { table.erase_at(table.index_of(it)); }
+
+    /// @brief Returns an iterator to the first pair
+    iterator begin() noexcept { return table.begin(); }
+    /// @brief Returns an iterator past the last pair
+    iterator end() noexcept { return table.end(); }
+    /// @brief Returns an iterator to the first pair
+    const_iterator begin() const noexcept { return table.begin(); }
+    /// @brief Returns an iterator past the last pair
+    const_iterator end() const noexcept { return table.end(); }
+  };
+
+  template<
+      typename T, meta::Allocator ALLOCATOR,
+      typename HASH      = clt::default_hash,
+      typename KEY_EQUAL = std::equal_to<T>>
+  /// @brief Open-addressing hash set (Swiss table).
+  /// The objects are stored contiguously: inserting may invalidate all the
+  /// iterators and references.
+  /// If both HASH and KEY_EQUAL are transparent (such as uni::CaseFoldHash
+  /// and uni::CaseFoldEqual), lookups can be done using any comparable type.
+  /// @tparam T The type to store
+  /// @tparam ALLOCATOR The allocator
+  /// @tparam HASH The hasher object
+  /// @tparam KEY_EQUAL The comparator
+  class BasicFlatSet
+  {
+    /// @brief The underlying table
+    using table_t = details::flat::FlatTable<
+        T, T, details::flat::KeyOfSelf, HASH, KEY_EQUAL, ALLOCATOR>;
+
+    /// @brief The underlying table
+    table_t table;
+
+    /// @brief True if lookups can be done using any comparable type
+    static constexpr bool IS_TRANSPARENT =
+        details::flat::transparent_lookup<HASH, KEY_EQUAL>;
+
+    /// @brief Check if K can be used for lookups
+    template<typename K>
+    static constexpr bool is_key = std::same_as<K, T> || IS_TRANSPARENT;
+
+    /// @brief The type of the keys used for lookups
+    template<typename K>
+    using key_arg =
+        typename details::flat::KeyArg<IS_TRANSPARENT>::template type<K, T>;
+
+  public:
+    /// @brief The type of the objects stored
+    using value_type = T;
+    /// @brief The iterator type (objects can't be modified)
+    using iterator = typename table_t::const_iterator;
+    /// @brief The const iterator type
+    using const_iterator = typename table_t::const_iterator;
+
+    /// @brief Constructs an empty set
+    /// @param alloc The allocator
+    explicit BasicFlatSet(const ALLOCATOR& alloc) noexcept
+        : table(alloc)
+    {
+    }
+
+    /// @brief Constructs an empty set (when allocator is global)
+    BasicFlatSet() noexcept
+      requires(ALLOCATOR::is_global_allocator_ref)
+        : table(ALLOCATOR{})
+    {
+    }
+
+    /// @brief Returns the count of objects
+    /// @return The count of objects
+    size_t size() const noexcept { return table.size(); }
+    /// @brief Returns the count of slots
+    /// @return The capacity
+    size_t capacity() const noexcept { return table.capacity(); }
+    /// @brief Check if the set is empty
+    /// @return True if the set is empty
+    bool is_empty() const noexcept { return table.is_empty(); }
+    /// @brief Returns the load factor
+    /// @return size() / capacity()
+    float load_factor() const noexcept { return table.load_factor(); }
+    /// @brief Returns the allocator
+    /// @return The allocator
+    const ALLOCATOR& get_allocator() const noexcept { return table.get_allocator(); }
+
+    /// @brief Ensures 'size' objects can be stored without growing
+    /// @param size The count of objects
+    void reserve(size_t size) noexcept { table.reserve(size); }
+    /// @brief Destroys all the objects (the memory is kept)
+    void clear() noexcept { table.clear(); }
+
+    /// @brief Returns an iterator to the object equal to 'key'
+    /// @tparam K The type of the key
+    /// @param key The key
+    /// @return Iterator to the object or end()
+    template<typename K = T>
+    const_iterator find(const key_arg<K>& key) const noexcept
+    {
+      return table.iterator_at(table.find_index(key, table.hash(key)));
+    }
+
+    /// @brief Check if the set contains an object
+    /// @tparam K The type of the key
+    /// @param key The key
+    /// @return True if the set contains 'key'
+    template<typename K = T>
+    bool contains(const key_arg<K>& key) const noexcept
+    {
+      return table.find_index(key, table.hash(key)) != table.capacity();
+    }
+
+    /// @brief Inserts an object if it is not already in the set
+    /// @tparam K The type of the object
+    /// @param value The object
+    /// @return Pair of iterator to the object and true if it was inserted
+    template<typename K>
+      requires std::constructible_from<T, K&&>
+    std::pair<const_iterator, bool> insert(K&& value)
+    {
+      // The object must be converted to be hashed as a T
+      if constexpr (!is_key<std::remove_cvref_t<K>>)
+        return insert(T(std::forward<K>(value)));
+      else
+        return table.find_or_insert(
+            value, [&](T* ptr) { new (ptr) T(std::forward<K>(value)); });
+    }
+
+    /// @brief Erases the object equal to 'key'
+    /// @tparam K The type of the key
+    /// @param key The key
+    /// @return True if an object was erased
+    template<typename K = T>
+    bool erase(const key_arg<K>& key) noexcept
+    {
+      const size_t index = table.find_index(key, table.hash(key));
+      if (index == table.capacity())
+        return false;
+      table.erase_at(index);
+      return true;
+    }
+
+    /// @brief Erases the object pointed to by an iterator
+    /// @param it The iterator (not end())
+    void erase(const_iterator it) noexcept { table.erase_at(table.index_of(it)); }
+
+    /// @brief Returns an iterator to the first object
+    const_iterator begin() const noexcept { return table.begin(); }
+    /// @brief Returns an iterator past the last object
+    const_iterator end() const noexcept { return table.end(); }
+  };
+
+  /// @brief FlatMap using the default global allocator
+  template<
+      typename Key, typename Value, typename HASH = clt::default_hash,
+      typename KEY_EQUAL = std::equal_to<Key>>
+  using FlatMap =
+      BasicFlatMap<Key, Value, decltype(mem::GlobalAllocator), HASH, KEY_EQUAL>;
+
+  /// @brief FlatSet using the default global allocator
+  template<
+      typename T, typename HASH = clt::default_hash,
+      typename KEY_EQUAL = std::equal_to<T>>
+  using FlatSet = BasicFlatSet<T, decltype(mem::GlobalAllocator), HASH, KEY_EQUAL>;
+} // namespace clt
+
+#endif // !HG_COLT_FLAT_MAP
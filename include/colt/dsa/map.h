@@ -10,16 +10,50 @@
 
 #include <tsl/hopscotch_map.h>
 #include <colt/hash.h>
+#include <colt/mem/std_alloc.h>
 
 namespace clt
 {
-  /// @brief Hash Map
+  /// @brief Hash Map.
+  /// If both HASH and KEY_EQUAL are transparent (such as uni::CaseFoldHash
+  /// and uni::CaseFoldEqual), lookups can be done using any comparable type.
+  /// The memory is obtained from ALLOCATOR, which must be copyable
+  /// (use a LocalAllocatorRef to allocate from a local allocator).
+  /// By default, this is Mallocator: the memory comes from malloc, not
+  /// from 'operator new' (as it did with std::allocator).
   /// @tparam Key The key type
   /// @tparam Value The value type
   /// @tparam HASH The hasher object
-  template<typename Key, typename Value, typename HASH = clt::uhash<clt::murmur64a_h>>
-  class Map : public tsl::hopscotch_map<Key, Value, HASH>
+  /// @tparam KEY_EQUAL The key comparator
+  /// @tparam ALLOCATOR The allocator
+  template<
+      typename Key, typename Value, typename HASH = clt::default_hash,
+      typename KEY_EQUAL = std::equal_to<Key>,
+      meta::Allocator ALLOCATOR = mem::Mallocator>
+  class Map
+      : public tsl::hopscotch_map<
+            Key, Value, HASH, KEY_EQUAL,
+            mem::StdAllocator<std::pair<Key, Value>, ALLOCATOR>>
   {
+    /// @brief The base class
+    using Base = tsl::hopscotch_map<
+        Key, Value, HASH, KEY_EQUAL,
+        mem::StdAllocator<std::pair<Key, Value>, ALLOCATOR>>;
+
+  public:
+    using Base::Base;
+
+    /// @brief Default constructor
+    Map()
+      requires std::is_default_constructible_v<ALLOCATOR>
+    = default;
+
+    /// @brief Constructs an empty Map using 'alloc'
+    /// @param alloc The allocator
+    explicit Map(const ALLOCATOR& alloc)
+        : Base(typename Base::allocator_type{alloc})
+    {
+    }
   };
 } // namespace clt
 
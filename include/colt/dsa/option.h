@@ -10,61 +10,151 @@
 #define HG_DSA_OPTION
 
 #include "colt/dsa/common.h"
+#include "colt/meta/niche.h"
 
 namespace clt
 {
+  namespace details
+  {
+    template<typename T, bool NICHE = meta::has_niche<T>>
+    /// @brief The storage of an Option: a buffer and a flag.
+    /// @tparam T The optional type
+    class OptionStorage
+    {
+      /// @brief Buffer for the optional object
+      alignas(T) char opt_buffer[sizeof(T)];
+      /// @brief True if no object is contained
+      bool is_none_v = true;
+
+    public:
+      /// @brief Constructs an empty storage
+      constexpr OptionStorage() noexcept = default;
+
+      /// @brief Check if the storage does not contain an object
+      /// @return True if empty
+      constexpr bool is_none() const noexcept { return is_none_v; }
+
+      /// @brief Returns a pointer to the object
+      /// @return Pointer to the object
+      constexpr T* ptr() noexcept { return ptr_to<T*>(opt_buffer); }
+      /// @brief Returns a pointer to the object
+      /// @return Pointer to the object
+      constexpr const T* ptr() const noexcept
+      {
+        return ptr_to<const T*>(opt_buffer);
+      }
+
+      /// @brief Marks the object constructed in the buffer as existing
+      constexpr void set_value() noexcept { is_none_v = false; }
+
+      /// @brief Destroys the object (the storage must not be empty)
+      constexpr void destroy() noexcept(std::is_nothrow_destructible_v<T>)
+      {
+        ptr()->~T();
+        is_none_v = true;
+      }
+    };
+
+    template<typename T>
+    /// @brief The storage of an Option whose type has a niche: the
+    ///        object, which is the niche 0 when empty (see meta::niche).
+    /// @tparam T The optional type
+    class OptionStorage<T, true>
+    {
+      /// @brief The object or the niche 0
+      T value = meta::niche<T>::make(0);
+
+    public:
+      /// @brief Constructs an empty storage
+      constexpr OptionStorage() noexcept = default;
+
+      /// @brief Check if the storage does not contain an object
+      /// @return True if empty
+      constexpr bool is_none() const noexcept
+      {
+        return meta::niche<T>::index_of(value) == 0;
+      }
+
+      /// @brief Returns a pointer to the object
+      /// @return Pointer to the object
+      constexpr T* ptr() noexcept { return &value; }
+      /// @brief Returns a pointer to the object
+      /// @return Pointer to the object
+      constexpr const T* ptr() const noexcept { return &value; }
+
+      /// @brief Stores an object (the storage must be empty)
+      /// @param obj The object to store
+      constexpr void set_value(const T& obj) noexcept
+      {
+        value = obj;
+        assert_true(
+            "Niches of a type cannot be stored in an Option!",
+            meta::niche<T>::index_of(value) == meta::niche<T>::count);
+      }
+
+      /// @brief Destroys the object (the storage must not be empty)
+      constexpr void destroy() noexcept { value = meta::niche<T>::make(0); }
+    };
+  } // namespace details
+
   template<typename T>
   /// @brief Manages an optionally contained value.
+  /// If T has a niche (see meta::niche), the Option is the same size as T
+  /// (as for pointers or reflected enums).
   /// @tparam T The optional type to hold
   class Option
   {
-    /// @brief Buffer for the optional object
-    alignas(T) char opt_buffer[sizeof(T)];
-    /// @brief True if no object is contained
-    bool is_none_v;
+    /// @brief The object and whether it exists
+    details::OptionStorage<T> storage;
+
+    template<typename... Args>
+    /// @brief Constructs the object (the Option must be empty).
+    /// The object is constructed by the Option itself, as types with
+    /// private constructors befriend Option for in place construction.
+    /// @param ...args The arguments forwarded to the constructor
+    constexpr void construct(Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<T, Args...>)
+    {
+      if constexpr (meta::has_niche<T>)
+        storage.set_value(T(std::forward<Args>(args)...));
+      else
+      {
+        new (storage.ptr()) T(std::forward<Args>(args)...);
+        storage.set_value();
+      }
+    }
 
   public:
     /// @brief Destroy the stored value if it exists, and sets the Option to an empty one.
     /// Called automatically by the destructor.
     constexpr void reset() noexcept(std::is_nothrow_destructible_v<T>)
     {
-      if (!is_none_v)
-      {
-        ptr_to<T*>(opt_buffer)->~T();
-        is_none_v = true;
-      }
+      if (is_value())
+        storage.destroy();
     }
 
     /// @brief Constructs an empty Option.
-    constexpr Option() noexcept
-        : is_none_v(true)
-    {
-    }
+    constexpr Option() noexcept = default;
 
     /// @brief Constructs an empty Option.
     /// Same as Option().
     /// @param  NoneT: use None
-    constexpr Option(none_t) noexcept
-        : is_none_v(true)
-    {
-    }
+    constexpr Option(none_t) noexcept {}
 
     /// @brief Copy constructs an object into the Option.
     /// @param to_copy The object to copy
     constexpr Option(const T& to_copy) noexcept(
         std::is_nothrow_copy_constructible_v<T>)
-        : is_none_v(false)
     {
-      new (opt_buffer) T(to_copy);
+      construct(to_copy);
     }
 
     /// @brief Move constructs an object into the Option
     /// @param to_move The object to move
     constexpr Option(T&& to_move) noexcept(std::is_nothrow_move_constructible_v<T>)
       requires(!std::is_trivial_v<T>)
-        : is_none_v(false)
     {
-      new (opt_buffer) T(std::move(to_move));
+      construct(std::move(to_move));
     }
 
     template<typename... Args>
@@ -74,29 +164,26 @@ namespace clt
     /// @param ...args The argument pack
     constexpr Option(in_place_t, Args&&... args) noexcept(
         std::is_nothrow_constructible_v<T, Args...>)
-        : is_none_v(false)
     {
-      new (opt_buffer) T(std::forward<Args>(args)...);
+      construct(std::forward<Args>(args)...);
     }
 
     /// @brief Copy constructor.
     /// @param to_copy The Option to copy
     constexpr Option(const Option& to_copy) noexcept(
         std::is_nothrow_copy_constructible_v<T>)
-        : is_none_v(to_copy.is_none_v)
     {
-      if (!is_none_v)
-        new (opt_buffer) T(*ptr_to<const T*>(to_copy.opt_buffer));
+      if (to_copy.is_value())
+        construct(*to_copy.storage.ptr());
     }
 
     /// @brief Move constructor.
     /// @param to_move The Option to move
     constexpr Option(Option&& to_move) noexcept(
         std::is_nothrow_move_constructible_v<T>)
-        : is_none_v(to_move.is_none_v)
     {
-      if (!is_none_v)
-        new (opt_buffer) T(std::move(*ptr_to<T*>(to_move.opt_buffer)));
+      if (to_move.is_value())
+        construct(std::move(*to_move.storage.ptr()));
     }
 
     /// @brief Copy assignment operator
@@ -108,10 +195,7 @@ namespace clt
       assert_true("Self assignment is prohibited!", &to_copy != this);
       reset();
       if (to_copy.is_value())
-      {
-        is_none_v = false;
-        new (opt_buffer) T(*ptr_to<const T*>(to_copy.opt_buffer));
-      }
+        construct(*to_copy.storage.ptr());
       return *this;
     }
 
@@ -124,10 +208,7 @@ namespace clt
       assert_true("Self assignment is prohibited!", &to_move != this);
       reset();
       if (to_move.is_value())
-      {
-        is_none_v = false;
-        new (opt_buffer) T(std::move(*ptr_to<T*>(to_move.opt_buffer)));
-      }
+        construct(std::move(*to_move.storage.ptr()));
       return *this;
     }
 
@@ -138,8 +219,7 @@ namespace clt
         std::is_nothrow_destructible_v<T> && std::is_nothrow_copy_constructible_v<T>)
     {
       reset();
-      is_none_v = false;
-      new (opt_buffer) T(to_copy);
+      construct(to_copy);
       return *this;
     }
 
@@ -150,8 +230,7 @@ namespace clt
         std::is_nothrow_destructible_v<T> && std::is_nothrow_move_constructible_v<T>)
     {
       reset();
-      is_none_v = false;
-      new (opt_buffer) T(std::move(to_move));
+      construct(std::move(to_move));
       return *this;
     }
 
@@ -171,24 +250,24 @@ namespace clt
 
     /// @brief Check if the Option contains a value.
     /// @return True if the Option contains a value
-    explicit constexpr operator bool() const noexcept { return !is_none_v; }
+    explicit constexpr operator bool() const noexcept { return is_value(); }
 
     /// @brief Check if the Option contains a value.
     /// Same as !is_none().
     /// @return True if the Option contains a value
-    constexpr bool is_value() const noexcept { return !is_none_v; }
+    constexpr bool is_value() const noexcept { return !storage.is_none(); }
 
     /// @brief Check if the Option does not contain a value.
     /// Same as !is_value().
     /// @return True if the Option does not contain a value
-    constexpr bool is_none() const noexcept { return is_none_v; }
+    constexpr bool is_none() const noexcept { return storage.is_none(); }
 
     /// @brief Returns the stored value.
     /// @return The value
     constexpr const T* operator->() const noexcept
     {
       assert_true("Option does not contain a value!", is_value());
-      return ptr_to<const T*>(opt_buffer);
+      return storage.ptr();
     }
 
     /// @brief Returns the stored value.
@@ -196,7 +275,7 @@ namespace clt
     constexpr T* operator->() noexcept
     {
       assert_true("Option does not contain a value!", is_value());
-      return ptr_to<T*>(opt_buffer);
+      return storage.ptr();
     }
 
     /// @brief Returns the stored value.
@@ -204,7 +283,7 @@ namespace clt
     constexpr const T& operator*() const& noexcept
     {
       assert_true("Option does not contain a value!", is_value());
-      return *ptr_to<const T*>(opt_buffer);
+      return *storage.ptr();
     }
 
     /// @brief Returns the stored value.
@@ -212,7 +291,7 @@ namespace clt
     constexpr T& operator*() & noexcept
     {
       assert_true("Option does not contain a value!", is_value());
-      return *ptr_to<T*>(opt_buffer);
+      return *storage.ptr();
     }
 
     /// @brief Returns the stored value.
@@ -220,7 +299,7 @@ namespace clt
     constexpr const T&& operator*() const&& noexcept
     {
       assert_true("Option does not contain a value!", is_value());
-      return *ptr_to<const T*>(opt_buffer);
+      return *storage.ptr();
     }
 
     /// @brief Returns the stored value.
@@ -228,7 +307,7 @@ namespace clt
     constexpr T&& operator*() && noexcept
     {
       assert_true("Option does not contain a value!", is_value());
-      return std::move(*ptr_to<T*>(opt_buffer));
+      return std::move(*storage.ptr());
     }
 
     /// @brief Returns the stored value.
@@ -236,7 +315,7 @@ namespace clt
     constexpr const T& value() const& noexcept
     {
       assert_true("Option does not contain a value!", is_value());
-      return *ptr_to<const T*>(opt_buffer);
+      return *storage.ptr();
     }
 
     /// @brief Returns the stored value.
@@ -244,7 +323,7 @@ namespace clt
     constexpr T& value() & noexcept
     {
       assert_true("Option does not contain a value!", is_value());
-      return *ptr_to<T*>(opt_buffer);
+      return *storage.ptr();
     }
 
     /// @brief Returns the stored value.
@@ -252,7 +331,7 @@ namespace clt
     constexpr const T&& value() const&& noexcept
     {
       assert_true("Option does not contain a value!", is_value());
-      return *ptr_to<const T*>(opt_buffer);
+      return *storage.ptr();
     }
 
     /// @brief Returns the stored value.
@@ -261,19 +340,19 @@ namespace clt
     constexpr T&& value() && noexcept
     {
       assert_true("Option does not contain a value!", is_value());
-      return std::move(*ptr_to<T*>(opt_buffer));
+      return std::move(*storage.ptr());
     }
 
     template<std::convertible_to<T> U>
     constexpr T value_or(U&& default_value) const&
     {
-      return is_none_v ? static_cast<T>(std::forward<U>(default_value)) : **this;
+      return is_none() ? static_cast<T>(std::forward<U>(default_value)) : **this;
     }
 
     template<std::convertible_to<T> U>
     constexpr T value_or(U&& default_value) &&
     {
-      return is_none_v ? static_cast<T>(std::forward<U>(default_value))
+      return is_none() ? static_cast<T>(std::forward<U>(default_value))
                        : std::move(**this);
     }
 
@@ -285,14 +364,14 @@ namespace clt
       requires std::invocable<Fn> && std::convertible_to<std::invoke_result_t<Fn>, T>
     constexpr T value_or(Fn&& default_value) const&
     {
-      return is_none_v ? static_cast<T>(std::forward<Fn>(default_value)()) : **this;
+      return is_none() ? static_cast<T>(std::forward<Fn>(default_value)()) : **this;
     }
 
     template<typename Fn>
       requires std::invocable<Fn> && std::convertible_to<std::invoke_result_t<Fn>, T>
     constexpr T value_or(Fn&& default_value) &&
     {
-      return is_none_v ? static_cast<T>(std::forward<Fn>(default_value)())
+      return is_none() ? static_cast<T>(std::forward<Fn>(default_value)())
                        : std::move(**this);
     }
 
@@ -304,14 +383,14 @@ namespace clt
       requires std::convertible_to<std::invoke_result_t<Fn>, T> && std::copy_constructible<T>
     constexpr Option<T> or_else(Fn&& default_value) const&
     {
-      return is_none_v ? static_cast<T>(std::forward<Fn>(default_value)()) : *this;
+      return is_none() ? static_cast<T>(std::forward<Fn>(default_value)()) : *this;
     }
 
     template<typename Fn>
       requires std::convertible_to<std::invoke_result_t<Fn>, T> && std::move_constructible<T>
     constexpr Option<T> or_else(Fn&& default_value) &&
     {
-      return is_none_v ? static_cast<T>(std::forward<Fn>(default_value)())
+      return is_none() ? static_cast<T>(std::forward<Fn>(default_value)())
                        : std::move(*this);
     }
 
@@ -0,0 +1,550 @@
+/*****************************************************************/ /**
+ * @file   rope.h
+ * @brief  Contains BasicRope, a string for large editable buffers.
+ * The text is split in chunks of at most CHUNK units, which are the
+ * nodes of a balanced tree (a treap whose keys are implicit).
+ * Each node caches the LenInfo and count of line feeds of its chunk
+ * and of its subtree, so that inserting, erasing, indexing by code
+ * point and searching for a line are all O(log n) (plus the scan of
+ * a single chunk).
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_ROPE
+#define HG_COLT_ROPE
+
+#include <bit>
+#include <cstring>
+#include <utility>
+#include <colt/dsa/string_view.h>
+#include <colt/mem/allocator_ref.h>
+
+namespace clt
+{
+  template<StringEncoding ENCODING, meta::Allocator ALLOCATOR, size_t CHUNK = 512>
+    requires(CHUNK >= 4)
+  /// @brief Balanced tree of chunks of text.
+  /// All the positions are expressed in code points.
+  /// Inserting text in a chunk that has enough free space does not
+  /// allocate: other insertions split the chunk at the insertion point.
+  /// Lines are separated by line feeds ('\n').
+  /// @tparam ENCODING The encoding of the text
+  /// @tparam ALLOCATOR The allocator from which the nodes are allocated
+  /// @tparam CHUNK The maximum count of units of a chunk
+  class BasicRope
+    : private ALLOCATOR
+  {
+    /// @brief The character type
+    using char_t = meta::encoding_to_char_t<ENCODING>;
+    /// @brief The view type
+    using view_t = BasicStringView<ENCODING>;
+
+    /// @brief The cached informations of a chunk or of a subtree
+    struct Info
+    {
+      /// @brief The count of code points and of units
+      uni::LenInfo len;
+      /// @brief The count of line feeds
+      size_t newlines;
+
+      /// @brief Combines the informations of adjacent texts
+      /// @param a The informations of the first text
+      /// @param b The informations of the second text
+      /// @return The informations of the concatenation of both texts
+      friend constexpr Info operator+(Info a, Info b) noexcept
+      {
+        return {
+            {a.len.strlen + b.len.strlen, a.len.unitlen + b.len.unitlen},
+            a.newlines + b.newlines};
+      }
+    };
+
+    /// @brief A node of the tree, owning a chunk
+    struct Node
+    {
+      /// @brief The text before the chunk
+      Node* left = nullptr;
+      /// @brief The text after the chunk
+      Node* right = nullptr;
+      /// @brief The priority of the node (greater than its children)
+      u64 priority;
+      /// @brief The informations of the chunk
+      Info self;
+      /// @brief The informations of the subtree
+      Info total;
+      /// @brief The storage of the chunk
+      alignas(char_t) u8 storage[CHUNK * sizeof(char_t)];
+
+      /// @brief Returns the units of the chunk
+      /// @return Pointer to the units of the chunk
+      char_t* text() noexcept { return ptr_to<char_t*>(storage); }
+      /// @brief Returns the units of the chunk
+      /// @return Pointer to the units of the chunk
+      const char_t* text() const noexcept { return ptr_to<const char_t*>(storage); }
+    };
+
+    /// @brief The root of the tree (null if empty)
+    Node* root = nullptr;
+    /// @brief The state of the generator of priorities
+    u64 seed = 0x9E3779B97F4A7C15;
+
+    /// @brief Returns the informations of a subtree
+    /// @param node The subtree (can be null)
+    /// @return The informations of the subtree
+    static constexpr Info total_of(const Node* node) noexcept
+    {
+      return node == nullptr ? Info{} : node->total;
+    }
+
+    /// @brief Updates the informations of the subtree of a node
+    /// @param node The node whose children changed
+    static constexpr void update(Node* node) noexcept
+    {
+      node->total = total_of(node->left) + node->self + total_of(node->right);
+    }
+
+    /// @brief Computes the informations of a text
+    /// @param ptr The units of the text
+    /// @param units The count of units
+    /// @return The informations of the text
+    static Info info_of(const char_t* ptr, size_t units) noexcept
+    {
+      if (units == 0)
+        return {};
+      size_t newlines = 0;
+      if constexpr (sizeof(char_t) == 1)
+      {
+        // a line feed can never be part of a multi-unit sequence
+        for (size_t i = 0; i < units; i++)
+          newlines += std::bit_cast<u8>(ptr[i]) == '\n';
+      }
+      else
+      {
+        for (auto it = uni::CodePointIterator<ENCODING>(ptr);
+             it.current() != ptr + units; ++it)
+          newlines += *it == U'\n';
+      }
+      if constexpr (!is_variadic_encoding(ENCODING))
+        return {{units, units}, newlines};
+      else
+        return {{uni::countlen(ptr, units), units}, newlines};
+    }
+
+    /// @brief Returns the offset in units of a code point of a chunk
+    /// @param ptr The units of the chunk
+    /// @param points The index of the code point (<= code point count)
+    /// @return The offset of the code point in units
+    static size_t units_of(const char_t* ptr, size_t points) noexcept
+    {
+      if constexpr (!is_variadic_encoding(ENCODING))
+        return points;
+      else
+      {
+        auto it = uni::CodePointIterator<ENCODING>(ptr);
+        for (size_t i = 0; i < points; i++)
+          ++it;
+        return static_cast<size_t>(it.current() - ptr);
+      }
+    }
+
+    /// @brief Returns the count of units that can be taken from a text
+    /// without splitting a code point
+    /// @param ptr The units of the text
+    /// @param units The count of units of the text
+    /// @return The count of units of the next chunk (<= CHUNK)
+    static size_t take_of(const char_t* ptr, size_t units) noexcept
+    {
+      size_t take = clt::min(units, CHUNK);
+      if constexpr (meta::is_any_of<char_t, Char8>)
+      {
+        while (take < units && ptr[take].is_trail())
+          --take;
+      }
+      else if constexpr (meta::is_any_of<char_t, Char16BE, Char16LE>)
+      {
+        if (take < units && ptr[take].is_trail_surrogate())
+          --take;
+      }
+      return take;
+    }
+
+    /// @brief Allocates a node containing a copy of a text
+    /// @param ptr The units of the text
+    /// @param units The count of units (<= CHUNK)
+    /// @return The new node
+    Node* new_node(const char_t* ptr, size_t units) noexcept
+    {
+      assert_true("Chunk too big!", units <= CHUNK);
+      auto blk = ALLOCATOR::alloc(sizeof(Node));
+      assert_true("Could not allocate memory!", !blk.is_null());
+      auto node = new (blk.ptr()) Node;
+      // splitmix64
+      seed += 0x9E3779B97F4A7C15;
+      u64 z          = seed;
+      z              = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+      z              = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+      node->priority = z ^ (z >> 31);
+      if (units != 0)
+        std::memcpy(node->text(), ptr, units * sizeof(char_t));
+      node->self  = info_of(ptr, units);
+      node->total = node->self;
+      return node;
+    }
+
+    /// @brief Frees a subtree
+    /// @param node The subtree (can be null)
+    void free_tree(Node* node) noexcept
+    {
+      if (node == nullptr)
+        return;
+      free_tree(node->left);
+      free_tree(node->right);
+      ALLOCATOR::dealloc({node, sizeof(Node)});
+    }
+
+    /// @brief Concatenates two subtrees
+    /// @param a The first subtree (can be null)
+    /// @param b The second subtree (can be null)
+    /// @return The concatenation
+    static Node* merge(Node* a, Node* b) noexcept
+    {
+      if (a == nullptr)
+        return b;
+      if (b == nullptr)
+        return a;
+      if (a->priority > b->priority)
+      {
+        a->right = merge(a->right, b);
+        update(a);
+        return a;
+      }
+      b->left = merge(a, b->left);
+      update(b);
+      return b;
+    }
+
+    /// @brief Splits a subtree at a code point boundary
+    /// @param node The subtree (can be null)
+    /// @param units The offset in units of the split
+    /// @return The subtrees before and after 'units'
+    std::pair<Node*, Node*> split(Node* node, size_t units) noexcept
+    {
+      if (node == nullptr)
+        return {nullptr, nullptr};
+      const size_t left = total_of(node->left).len.unitlen;
+      if (units <= left)
+      {
+        auto [a, b] = split(node->left, units);
+        node->left  = b;
+        update(node);
+        return {a, node};
+      }
+      units -= left;
+      if (units >= node->self.len.unitlen)
+      {
+        auto [a, b] = split(node->right, units - node->self.len.unitlen);
+        node->right = a;
+        update(node);
+        return {node, b};
+      }
+      // the split point is inside of the chunk
+      Node* tail =
+          new_node(node->text() + units, node->self.len.unitlen - units);
+      Node* right = std::exchange(node->right, nullptr);
+      node->self  = info_of(node->text(), units);
+      update(node);
+      return {node, merge(tail, right)};
+    }
+
+    /// @brief Inserts a text in the chunk containing an offset if it has
+    /// enough free space
+    /// @param node The subtree (can be null)
+    /// @param units The offset in units of the insertion
+    /// @param str The text to insert (at most CHUNK units)
+    /// @return True if the text was inserted
+    static bool insert_in_place(Node* node, size_t units, view_t str) noexcept
+    {
+      if (node == nullptr)
+        return false;
+      const size_t left = total_of(node->left).len.unitlen;
+      // at a boundary, the text is appended to the previous chunk if possible
+      if (units <= left && insert_in_place(node->left, units, str))
+        return update(node), true;
+      if (units < left)
+        return false;
+      units -= left;
+      const size_t size = node->self.len.unitlen;
+      if (units <= size && size + str.unit_len() <= CHUNK)
+      {
+        char_t* text = node->text();
+        std::memmove(text + units + str.unit_len(), text + units,
+            (size - units) * sizeof(char_t));
+        std::memcpy(text + units, str.data(), str.unit_len() * sizeof(char_t));
+        node->self = node->self + info_of(str.data(), str.unit_len());
+        return update(node), true;
+      }
+      if (units < size || !insert_in_place(node->right, units - size, str))
+        return false;
+      return update(node), true;
+    }
+
+    /// @brief Converts a code point index to an offset in units
+    /// @param index The index of the code point (<= size())
+    /// @return The offset in units
+    size_t to_units(size_t index) const noexcept
+    {
+      size_t units = 0;
+      for (const Node* node = root; node != nullptr;)
+      {
+        const Info left = total_of(node->left);
+        if (index < left.len.strlen)
+        {
+          node = node->left;
+          continue;
+        }
+        index -= left.len.strlen;
+        units += left.len.unitlen;
+        if (index <= node->self.len.strlen)
+          return units + units_of(node->text(), index);
+        index -= node->self.len.strlen;
+        units += node->self.len.unitlen;
+        node = node->right;
+      }
+      return units;
+    }
+
+    template<typename Fn>
+    /// @brief Calls 'fn' with a view over each chunk of a subtree, in order
+    /// @tparam Fn The function type
+    /// @param node The subtree
+    /// @param fn The function to call
+    static void for_each_chunk(const Node* node, Fn& fn)
+    {
+      if (node == nullptr)
+        return;
+      for_each_chunk(node->left, fn);
+      fn(view_t{node->text(), node->self.len.unitlen});
+      for_each_chunk(node->right, fn);
+    }
+
+  public:
+    /// @brief Constructor
+    /// @param alloc Reference to the allocator
+    BasicRope(const ALLOCATOR& alloc) noexcept
+        : ALLOCATOR(alloc)
+    {
+    }
+
+    /// @brief Constructs a rope containing a copy of a text
+    /// @param alloc Reference to the allocator
+    /// @param str The text
+    BasicRope(const ALLOCATOR& alloc, view_t str) noexcept
+        : ALLOCATOR(alloc)
+    {
+      insert(0, str);
+    }
+
+    BasicRope(const BasicRope&)            = delete;
+    BasicRope& operator=(const BasicRope&) = delete;
+
+    /// @brief Move constructor
+    /// @param to_move The rope whose nodes to steal
+    BasicRope(BasicRope&& to_move) noexcept
+        : ALLOCATOR(static_cast<const ALLOCATOR&>(to_move))
+        , root(std::exchange(to_move.root, nullptr))
+        , seed(to_move.seed)
+    {
+    }
+
+    /// @brief Move assignment operator, swaps every member (allocator included)
+    /// @param to_move The rope being assigned
+    /// @return Self
+    BasicRope& operator=(BasicRope&& to_move) noexcept
+    {
+      assert_true("Self assignment is prohibited!", &to_move != this);
+      std::swap(static_cast<ALLOCATOR&>(to_move), static_cast<ALLOCATOR&>(*this));
+      std::swap(to_move.root, root);
+      std::swap(to_move.seed, seed);
+      return *this;
+    }
+
+    /// @brief Destructor, frees all the nodes
+    ~BasicRope() noexcept { free_tree(root); }
+
+    /// @brief Returns the count of code points
+    /// @return The count of code points
+    size_t size() const noexcept { return total_of(root).len.strlen; }
+    /// @brief Returns the count of units
+    /// @return The count of units
+    size_t unit_len() const noexcept { return total_of(root).len.unitlen; }
+    /// @brief Returns the count and units of code points
+    /// @return The LenInfo of the whole text
+    uni::LenInfo len() const noexcept { return total_of(root).len; }
+    /// @brief Returns the count of lines (the count of line feeds + 1)
+    /// @return The count of lines
+    size_t line_count() const noexcept { return total_of(root).newlines + 1; }
+    /// @brief Check if the rope does not contain any code point
+    /// @return True if empty
+    bool is_empty() const noexcept { return root == nullptr; }
+
+    /// @brief Inserts a text before a code point
+    /// @param index The index of the code point (<= size())
+    /// @param str The text to insert
+    void insert(size_t index, view_t str) noexcept
+    {
+      assert_true("Invalid index!", index <= size());
+      if (str.is_empty())
+        return;
+      const size_t units = to_units(index);
+      if (str.unit_len() <= CHUNK && insert_in_place(root, units, str))
+        return;
+
+      Node* middle = nullptr;
+      for (const char_t* ptr = str.data(); ptr != str.data() + str.unit_len();)
+      {
+        const size_t take = take_of(ptr, str.data() + str.unit_len() - ptr);
+        middle            = merge(middle, new_node(ptr, take));
+        ptr += take;
+      }
+      auto [a, b] = split(root, units);
+      root        = merge(merge(a, middle), b);
+    }
+
+    /// @brief Appends a text
+    /// @param str The text to append
+    void append(view_t str) noexcept { insert(size(), str); }
+
+    /// @brief Erases code points
+    /// @param index The index of the first code point to erase
+    /// @param count The count of code points to erase
+    void erase(size_t index, size_t count) noexcept
+    {
+      assert_true("Invalid range!", index + count <= size());
+      if (count == 0)
+        return;
+      const size_t from = to_units(index);
+      const size_t to   = to_units(index + count);
+      auto [ab, c]      = split(root, to);
+      auto [a, b]       = split(ab, from);
+      free_tree(b);
+      root = merge(a, c);
+    }
+
+    /// @brief Removes all the text
+    void clear() noexcept
+    {
+      free_tree(root);
+      root = nullptr;
+    }
+
+    /// @brief Returns the code point at index 'index'
+    /// @param index The index (< size())
+    /// @return The code point
+    char32_t operator[](size_t index) const noexcept
+    {
+      assert_true("Invalid index!", index < size());
+      const Node* node = root;
+      while (true)
+      {
+        const size_t left = total_of(node->left).len.strlen;
+        if (index < left)
+        {
+          node = node->left;
+          continue;
+        }
+        index -= left;
+        if (index < node->self.len.strlen)
+        {
+          const char_t* ptr = node->text();
+          return *uni::CodePointIterator<ENCODING>(ptr + units_of(ptr, index));
+        }
+        index -= node->self.len.strlen;
+        node = node->right;
+      }
+    }
+
+    /// @brief Returns the index of the first code point of a line
+    /// @param line The line (starting at 0, < line_count())
+    /// @return The index of the code point following the 'line'-th line feed
+    size_t line_start(size_t line) const noexcept
+    {
+      assert_true("Invalid line!", line < line_count());
+      size_t index = 0;
+      for (const Node* node = root; line != 0;)
+      {
+        const Info left = total_of(node->left);
+        if (line <= left.newlines)
+        {
+          node = node->left;
+          continue;
+        }
+        line -= left.newlines;
+        index += left.len.strlen;
+        if (line <= node->self.newlines)
+        {
+          auto it = uni::CodePointIterator<ENCODING>(node->text());
+          for (;; ++index)
+          {
+            if (*it++ == U'\n' && --line == 0)
+              return index + 1;
+          }
+        }
+        line -= node->self.newlines;
+        index += node->self.len.strlen;
+        node = node->right;
+      }
+      return index;
+    }
+
+    /// @brief Returns the line containing a code point
+    /// @param index The index of the code point (<= size())
+    /// @return The count of line feeds before 'index'
+    size_t line_of(size_t index) const noexcept
+    {
+      assert_true("Invalid index!", index <= size());
+      size_t line = 0;
+      for (const Node* node = root; node != nullptr;)
+      {
+        const Info left = total_of(node->left);
+        if (index < left.len.strlen)
+        {
+          node = node->left;
+          continue;
+        }
+        index -= left.len.strlen;
+        line += left.newlines;
+        if (index <= node->self.len.strlen)
+        {
+          const size_t units = units_of(node->text(), index);
+          return line + info_of(node->text(), units).newlines;
+        }
+        index -= node->self.len.strlen;
+        line += node->self.newlines;
+        node = node->right;
+      }
+      return line;
+    }
+
+    template<typename Fn>
+    /// @brief Calls 'fn' with a view over each chunk, in order.
+    /// The views can be iterated over using CodePointIterator.
+    /// @tparam Fn The function type
+    /// @param fn The function to call
+    void for_each_chunk(Fn&& fn) const
+    {
+      for_each_chunk(root, fn);
+    }
+  };
+
+  /// @brief ASCII rope using the default global allocator
+  using Rope = BasicRope<StringEncoding::ASCII, decltype(mem::GlobalAllocator)>;
+  /// @brief UTF8 rope using the default global allocator
+  using u8Rope = BasicRope<StringEncoding::UTF8, decltype(mem::GlobalAllocator)>;
+  /// @brief UTF16 rope using the default global allocator
+  using u16Rope = BasicRope<StringEncoding::UTF16, decltype(mem::GlobalAllocator)>;
+  /// @brief UTF32 rope using the default global allocator
+  using u32Rope = BasicRope<StringEncoding::UTF32, decltype(mem::GlobalAllocator)>;
+} // namespace clt
+
+#endif // !HG_COLT_ROPE
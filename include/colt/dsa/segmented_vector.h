@@ -0,0 +1,521 @@
+/*****************************************************************/ /**
+ * @file   segmented_vector.h
+ * @brief  Contains BasicSegmentedVector, a dynamic array whose objects
+ * are stored in fixed size chunks and thus never move.
+ * Pointers and references to the objects stay valid while the
+ * container grows, which makes it a dense replacement for lists of
+ * individually allocated nodes.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_SEGMENTED_VECTOR
+#define HG_COLT_SEGMENTED_VECTOR
+
+#include <bit>
+#include <iterator>
+#include <colt/dsa/vector.h>
+
+namespace clt
+{
+  template<typename T, size_t CHUNK, meta::Allocator ALLOCATOR>
+    requires(std::has_single_bit(CHUNK))
+  /// @brief Dynamic size array storing its objects in chunks of CHUNK objects.
+  /// Growing allocates a new chunk: the objects are never moved, so pointers
+  /// to them are only invalidated by popping them.
+  /// Indexing is O(1): the chunk is obtained by a shift, the offset in the
+  /// chunk by a mask.
+  /// Chunks are never freed before 'shrink_to_fit' or the destructor.
+  /// @tparam T The type stored in the Vector
+  /// @tparam CHUNK The count of objects per chunk (power of 2)
+  /// @tparam ALLOCATOR The allocator
+  class BasicSegmentedVector
+    : private ALLOCATOR
+  {
+    /// @brief log2(CHUNK)
+    static constexpr size_t CHUNK_SHIFT = std::countr_zero(CHUNK);
+    /// @brief Mask to obtain the offset in a chunk
+    static constexpr size_t CHUNK_MASK = CHUNK - 1;
+
+    /// @brief The chunks (whose pointers may move, contrary to the objects)
+    BasicVector<T*, ALLOCATOR> chunks;
+    /// @brief Count of active objects
+    size_t blk_size = 0;
+
+    /// @brief Allocates a new chunk
+    void push_chunk() noexcept
+    {
+      auto blk = ALLOCATOR::alloc(CHUNK * sizeof(T));
+      assert_true("Could not allocate memory!", !blk.is_null());
+      chunks.push_back(static_cast<T*>(blk.ptr()));
+    }
+
+    /// @brief Returns a pointer to where to construct the next object
+    /// @return Pointer to the storage of the next object
+    T* next_slot() noexcept
+    {
+      if (blk_size == capacity())
+        push_chunk();
+      return chunks[blk_size >> CHUNK_SHIFT] + (blk_size & CHUNK_MASK);
+    }
+
+    template<bool IS_CONST>
+    /// @brief Random access iterator over a BasicSegmentedVector
+    /// @tparam IS_CONST True if the iterator is over const objects
+    class Iterator
+    {
+      /// @brief The (possibly const) Vector type
+      using vec_t = meta::match_cv_t<
+          std::conditional_t<IS_CONST, const void, void>, BasicSegmentedVector>;
+
+      /// @brief The Vector
+      vec_t* vec;
+      /// @brief The index in the Vector
+      size_t index;
+
+    public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type        = std::remove_cv_t<T>;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = std::conditional_t<IS_CONST, const T*, T*>;
+      using reference         = std::conditional_t<IS_CONST, const T&, T&>;
+
+      constexpr Iterator() noexcept
+          : vec(nullptr)
+          , index(0)
+      {
+      }
+
+      /// @brief Constructor
+      /// @param vec The Vector
+      /// @param index The index in the Vector
+      constexpr Iterator(vec_t* vec, size_t index) noexcept
+          : vec(vec)
+          , index(index)
+      {
+      }
+
+      /// @brief Converts an iterator to a const iterator
+      constexpr operator Iterator<true>() const noexcept
+        requires(!IS_CONST)
+      {
+        return {vec, index};
+      }
+
+      reference operator*() const noexcept { return (*vec)[index]; }
+      pointer operator->() const noexcept { return &(*vec)[index]; }
+      reference operator[](difference_type n) const noexcept
+      {
+        return (*vec)[index + n];
+      }
+
+      constexpr Iterator& operator++() noexcept
+      {
+        ++index;
+        return *this;
+      }
+      constexpr Iterator operator++(int) noexcept
+      {
+        auto copy = *this;
+        ++index;
+        return copy;
+      }
+      constexpr Iterator& operator--() noexcept
+      {
+        --index;
+        return *this;
+      }
+      constexpr Iterator operator--(int) noexcept
+      {
+        auto copy = *this;
+        --index;
+        return copy;
+      }
+      constexpr Iterator& operator+=(difference_type n) noexcept
+      {
+        index += n;
+        return *this;
+      }
+      constexpr Iterator& operator-=(difference_type n) noexcept
+      {
+        index -= n;
+        return *this;
+      }
+      friend constexpr Iterator operator+(Iterator it, difference_type n) noexcept
+      {
+        return it += n;
+      }
+      friend constexpr Iterator operator+(difference_type n, Iterator it) noexcept
+      {
+        return it += n;
+      }
+      friend constexpr Iterator operator-(Iterator it, difference_type n) noexcept
+      {
+        return it -= n;
+      }
+      friend constexpr difference_type operator-(Iterator a, Iterator b) noexcept
+      {
+        return static_cast<difference_type>(a.index)
+               - static_cast<difference_type>(b.index);
+      }
+      friend constexpr bool operator==(Iterator a, Iterator b) noexcept
+      {
+        return a.index == b.index;
+      }
+      friend constexpr auto operator<=>(Iterator a, Iterator b) noexcept
+      {
+        return a.index <=> b.index;
+      }
+    };
+
+  public:
+    /// @brief The value type stored in the list
+    using value_type = T;
+    /// @brief The count of objects per chunk
+    static constexpr size_t chunk_size = CHUNK;
+    /// @brief The iterator type
+    using iterator = Iterator<false>;
+    /// @brief The const iterator type
+    using const_iterator = Iterator<true>;
+
+    /// @brief The maximum count of items that can be stored
+    /// @return The maximum theoretical size of the container
+    static size_t max_size() noexcept { return std::numeric_limits<size_t>::max(); }
+
+    /// @brief Constructor
+    /// @param alloc Reference to the allocator to use
+    BasicSegmentedVector(const ALLOCATOR& alloc) noexcept
+        : ALLOCATOR(alloc)
+        , chunks(alloc)
+    {
+    }
+
+    /// @brief Reserve 'reserve' objects constructor
+    /// @param alloc Reference to the allocator
+    /// @param reserve The count of objects to allocate for
+    BasicSegmentedVector(const ALLOCATOR& alloc, size_t reserve) noexcept
+        : BasicSegmentedVector(alloc)
+    {
+      this->reserve(reserve);
+    }
+
+    /// @brief Copies the objects of a View
+    /// @param alloc Reference to the allocator
+    /// @param to_copy The objects to copy
+    BasicSegmentedVector(const ALLOCATOR& alloc, View<T> to_copy) noexcept(
+        std::is_nothrow_copy_constructible_v<T>)
+        : BasicSegmentedVector(alloc, to_copy.size())
+    {
+      append_range(to_copy);
+    }
+
+    /// @brief Copy constructor, copy the content from 'to_copy'
+    /// @param to_copy The Vector whose objects to copy
+    BasicSegmentedVector(const BasicSegmentedVector& to_copy) noexcept(
+        std::is_nothrow_copy_constructible_v<T>)
+        : BasicSegmentedVector(
+              static_cast<const ALLOCATOR&>(to_copy), to_copy.size())
+    {
+      to_copy.for_each_chunk([this](View<T> chunk) { append_range(chunk); });
+    }
+
+    /// @brief Destroy the active objects and copy the content from 'to_copy'.
+    /// @param to_copy The Vector whose objects to copy
+    /// @return Self
+    BasicSegmentedVector& operator=(const BasicSegmentedVector& to_copy) noexcept(
+        std::is_nothrow_copy_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+    {
+      assert_true("Self assignment is prohibited!", &to_copy != this);
+      clear();
+      to_copy.for_each_chunk([this](View<T> chunk) { append_range(chunk); });
+      return *this;
+    }
+
+    /// @brief Move constructor
+    /// @param to_move The Vector whose resources to steal
+    BasicSegmentedVector(BasicSegmentedVector&& to_move) noexcept
+        : ALLOCATOR(static_cast<const ALLOCATOR&>(to_move))
+        , chunks(std::move(to_move.chunks))
+        , blk_size(std::exchange(to_move.blk_size, 0))
+    {
+    }
+
+    /// @brief Move assignment operator, swaps every member (allocator included)
+    /// @param to_move The Vector being assigned
+    /// @return Self
+    BasicSegmentedVector& operator=(BasicSegmentedVector&& to_move) noexcept
+    {
+      assert_true("Self assignment is prohibited!", &to_move != this);
+      std::swap(static_cast<ALLOCATOR&>(to_move), static_cast<ALLOCATOR&>(*this));
+      chunks = std::move(to_move.chunks);
+      std::swap(to_move.blk_size, blk_size);
+      return *this;
+    }
+
+    /// @brief Destructor, destroy all active objects and free memory
+    ~BasicSegmentedVector() noexcept(std::is_nothrow_destructible_v<T>)
+    {
+      //register freeing even if destructor throws to avoid memory leaks
+      ON_SCOPE_EXIT
+      {
+        for (auto chunk : chunks)
+          ALLOCATOR::dealloc({chunk, CHUNK * sizeof(T)});
+        blk_size = 0;
+      };
+      clear();
+    }
+
+    /// @brief Returns the count of active objects in the Vector
+    /// @return The count of objects in the Vector
+    size_t size() const noexcept { return blk_size; }
+    /// @brief Returns the count of objects the allocated chunks can hold
+    /// @return The capacity of the Vector (multiple of CHUNK)
+    size_t capacity() const noexcept { return chunks.size() * CHUNK; }
+    /// @brief Check if the Vector does not contain any object.
+    /// Same as: size() == 0
+    /// @return True if the Vector is empty
+    bool is_empty() const noexcept { return blk_size == 0; }
+
+    /// @brief Returns the object at index 'index' of the Vector.
+    /// @param index The index of the object
+    /// @return The object at index 'index'
+    const T& operator[](size_t index) const noexcept
+    {
+      assert_true("Invalid index!", index < this->size());
+      return chunks[index >> CHUNK_SHIFT][index & CHUNK_MASK];
+    }
+
+    /// @brief Returns a reference to the object at index 'index' of the Vector.
+    /// @param index The index of the object
+    /// @return The object at index 'index'
+    T& operator[](size_t index) noexcept
+    {
+      assert_true("Invalid index!", index < this->size());
+      return chunks[index >> CHUNK_SHIFT][index & CHUNK_MASK];
+    }
+
+    /// @brief Returns the count of chunks containing active objects
+    /// @return The count of chunks to iterate over
+    size_t chunk_count() const noexcept
+    {
+      return (blk_size + CHUNK_MASK) >> CHUNK_SHIFT;
+    }
+
+    /// @brief Returns the active objects of a chunk.
+    /// Distinct chunks can be processed concurrently.
+    /// @param index The index of the chunk (< chunk_count())
+    /// @return Span over the active objects of the chunk
+    Span<T> chunk(size_t index) noexcept
+    {
+      assert_true("Invalid index!", index < chunk_count());
+      const size_t start = index << CHUNK_SHIFT;
+      return {chunks[index], clt::min(CHUNK, blk_size - start)};
+    }
+
+    /// @brief Returns the active objects of a chunk.
+    /// Distinct chunks can be processed concurrently.
+    /// @param index The index of the chunk (< chunk_count())
+    /// @return View over the active objects of the chunk
+    View<T> chunk(size_t index) const noexcept
+    {
+      assert_true("Invalid index!", index < chunk_count());
+      const size_t start = index << CHUNK_SHIFT;
+      return {chunks[index], clt::min(CHUNK, blk_size - start)};
+    }
+
+    template<typename Fn>
+    /// @brief Calls 'fn' on a Span over each chunk, in order
+    /// @tparam Fn The function type
+    /// @param fn The function to call
+    void for_each_chunk(Fn&& fn)
+    {
+      for (size_t i = 0; i < chunk_count(); i++)
+        fn(chunk(i));
+    }
+
+    template<typename Fn>
+    /// @brief Calls 'fn' on a View over each chunk, in order
+    /// @tparam Fn The function type
+    /// @param fn The function to call
+    void for_each_chunk(Fn&& fn) const
+    {
+      for (size_t i = 0; i < chunk_count(); i++)
+        fn(chunk(i));
+    }
+
+    /// @brief Allocates the chunks required to hold 'by_more' more objects
+    /// @param by_more The count of objects to reserve for
+    void reserve(size_t by_more) noexcept
+    {
+      const size_t required = (blk_size + by_more + CHUNK_MASK) >> CHUNK_SHIFT;
+      if (required <= chunks.size())
+        return;
+      chunks.reserve_exact(required - chunks.size());
+      while (chunks.size() < required)
+        push_chunk();
+    }
+
+    /// @brief Frees the chunks that do not contain any active object
+    void shrink_to_fit() noexcept
+    {
+      while (chunks.size() > chunk_count())
+      {
+        ALLOCATOR::dealloc({chunks.back(), CHUNK * sizeof(T)});
+        chunks.pop_back();
+      }
+      chunks.shrink_to_fit();
+    }
+
+    /// @brief Appends copies of all the objects of a range.
+    /// @param range The objects to copy (which must not be part of the Vector)
+    void append_range(View<T> range) noexcept(
+        std::is_nothrow_copy_constructible_v<T>)
+    {
+      reserve(range.size());
+      size_t copied = 0;
+      while (copied != range.size())
+      {
+        const size_t offset = blk_size & CHUNK_MASK;
+        const size_t count  = clt::min(CHUNK - offset, range.size() - copied);
+        details::contiguous_copy(
+            range.data() + copied, chunks[blk_size >> CHUNK_SHIFT] + offset, count);
+        copied += count;
+        blk_size += count;
+      }
+    }
+
+    /// @brief Push an object at the end of the Vector by copying
+    /// @param to_copy The object to copy at the end of the Vector
+    /// @return Reference to the new object (whose address never changes)
+    T& push_back(const T& to_copy) noexcept(std::is_nothrow_copy_constructible_v<T>)
+    {
+      T* ptr = new (next_slot()) T(to_copy);
+      ++blk_size;
+      return *ptr;
+    }
+
+    /// @brief Push an object at the end of the Vector by moving
+    /// @param to_move The object to move at the end of the Vector
+    /// @return Reference to the new object (whose address never changes)
+    T& push_back(T&& to_move) noexcept(std::is_nothrow_move_constructible_v<T>)
+      requires(!std::is_trivial_v<T>)
+    {
+      T* ptr = new (next_slot()) T(std::move(to_move));
+      ++blk_size;
+      return *ptr;
+    }
+
+    template<typename... Args>
+    /// @brief Emplace an object at the end of the Vector
+    /// @tparam ...Args The parameter pack
+    /// @param  in_place_t tag type
+    /// @param ...args The argument pack to forward to the constructor
+    /// @return Reference to the new object (whose address never changes)
+    T& push_back(in_place_t, Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<T, Args...>)
+    {
+      T* ptr = new (next_slot()) T(std::forward<Args>(args)...);
+      ++blk_size;
+      return *ptr;
+    }
+
+    /// @brief Pops an item from the back of the Vector.
+    void pop_back() noexcept(std::is_nothrow_destructible_v<T>)
+    {
+      assert_true("Vector is empty!", !this->is_empty());
+      --blk_size;
+      chunks[blk_size >> CHUNK_SHIFT][blk_size & CHUNK_MASK].~T();
+    }
+
+    /// @brief Pops N item from the back of the Vector.
+    /// @param count The number of item to pop from the back
+    void pop_back_n(size_t count) noexcept(std::is_nothrow_destructible_v<T>)
+    {
+      assert_true(
+          "Vector is does not contain enought elements!", count <= this->size());
+      for (size_t i = 0; i < count; i++)
+        pop_back();
+    }
+
+    /// @brief Removes all the item from the Vector.
+    /// This does not free the chunks.
+    void clear() noexcept(std::is_nothrow_destructible_v<T>)
+    {
+      if constexpr (!std::is_trivially_destructible_v<T>)
+      {
+        for_each_chunk(
+            [](Span<T> chunk)
+            { details::contiguous_destruct(chunk.data(), chunk.size()); });
+      }
+      blk_size = 0;
+    }
+
+    /// @brief Returns the first item in the Vector.
+    /// @return The first item in the Vector.
+    const T& front() const noexcept { return (*this)[0]; }
+    /// @brief Returns the first item in the Vector.
+    /// @return The first item in the Vector.
+    T& front() noexcept { return (*this)[0]; }
+    /// @brief Returns the last item in the Vector.
+    /// @return The last item in the Vector.
+    const T& back() const noexcept { return (*this)[blk_size - 1]; }
+    /// @brief Returns the last item in the Vector.
+    /// @return The last item in the Vector.
+    T& back() noexcept { return (*this)[blk_size - 1]; }
+
+    /// @brief Returns an iterator the beginning of the Vector
+    /// @return Iterator to the beginning of the Vector
+    iterator begin() noexcept { return {this, 0}; }
+    /// @brief Returns an iterator the beginning of the Vector
+    /// @return Iterator to the beginning of the Vector
+    const_iterator begin() const noexcept { return {this, 0}; }
+    /// @brief Returns an iterator the end of the Vector
+    /// @return Iterator to the end of the Vector
+    iterator end() noexcept { return {this, blk_size}; }
+    /// @brief Returns an iterator the end of the Vector
+    /// @return Iterator to the end of the Vector
+    const_iterator end() const noexcept { return {this, blk_size}; }
+
+    /// @brief Check if every object of v1 and v2 are equal
+    /// @param v1 The first Vector
+    /// @param v2 The second Vector
+    /// @return True if both Vector are equal
+    friend bool operator==(const BasicSegmentedVector& v1, View<T> v2) noexcept
+    {
+      if (v1.size() != v2.size())
+        return false;
+      for (size_t i = 0; i < v1.size(); i++)
+        if (v1[i] != v2[i])
+          return false;
+      return true;
+    }
+
+    /// @brief Lexicographically compare a Vector and a View
+    /// @param v1 The Vector
+    /// @param v2 The View
+    /// @return Result of comparison
+    friend auto operator<=>(const BasicSegmentedVector& v1, View<T> v2) noexcept
+    {
+      return std::lexicographical_compare_three_way(
+          v1.begin(), v1.end(), v2.begin(), v2.end());
+    }
+  };
+
+  /// @brief SegmentedVector using the default global allocator
+  /// @tparam T The type
+  /// @tparam CHUNK The count of objects per chunk (power of 2)
+  /// @tparam ALLOCATOR The allocator
+  template<
+      typename T, size_t CHUNK = 64,
+      meta::Allocator ALLOCATOR = decltype(mem::GlobalAllocator)>
+  using SegmentedVector = BasicSegmentedVector<T, CHUNK, ALLOCATOR>;
+} // namespace clt
+
+template<typename T, size_t CHUNK, typename ALLOCATOR>
+  requires fmt::is_formattable<T>::value
+struct fmt::formatter<clt::BasicSegmentedVector<T, CHUNK, ALLOCATOR>>
+  : public fmt::formatter<clt::BasicVector<T, ALLOCATOR>>
+{
+};
+
+#endif // !HG_COLT_SEGMENTED_VECTOR
@@ -10,15 +10,47 @@
 
 #include <tsl/hopscotch_set.h>
 #include <colt/hash.h>
+#include <colt/mem/std_alloc.h>
 
 namespace clt
 {
-  /// @brief Hash Set
+  /// @brief Hash Set.
+  /// If both HASH and KEY_EQUAL are transparent (such as uni::CaseFoldHash
+  /// and uni::CaseFoldEqual), lookups can be done using any comparable type.
+  /// The memory is obtained from ALLOCATOR, which must be copyable
+  /// (use a LocalAllocatorRef to allocate from a local allocator).
+  /// By default, this is Mallocator: the memory comes from malloc, not
+  /// from 'operator new' (as it did with std::allocator).
   /// @tparam T The value to store
   /// @tparam HASH The hasher object
-  template<typename T, typename HASH = clt::uhash<clt::murmur64a_h>>
-  class Set : public tsl::hopscotch_set<T, HASH, u32>
+  /// @tparam KEY_EQUAL The value comparator
+  /// @tparam ALLOCATOR The allocator
+  template<
+      typename T, typename HASH = clt::default_hash,
+      typename KEY_EQUAL = std::equal_to<T>,
+      meta::Allocator ALLOCATOR = mem::Mallocator>
+  class Set
+      : public tsl::hopscotch_set<
+            T, HASH, KEY_EQUAL, mem::StdAllocator<T, ALLOCATOR>>
   {
+    /// @brief The base class
+    using Base =
+        tsl::hopscotch_set<T, HASH, KEY_EQUAL, mem::StdAllocator<T, ALLOCATOR>>;
+
+  public:
+    using Base::Base;
+
+    /// @brief Default constructor
+    Set()
+      requires std::is_default_constructible_v<ALLOCATOR>
+    = default;
+
+    /// @brief Constructs an empty Set using 'alloc'
+    /// @param alloc The allocator
+    explicit Set(const ALLOCATOR& alloc)
+        : Base(typename Base::allocator_type{alloc})
+    {
+    }
   };
 } // namespace clt
 
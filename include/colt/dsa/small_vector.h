@@ -0,0 +1,572 @@
+/*****************************************************************/ /**
+ * @file   small_vector.h
+ * @brief  Contains BasicSmallVector, a Vector that stores up to N
+ * objects inline (in the object itself).
+ * The allocator is only used once more than N objects are pushed,
+ * which avoids allocations for the (many) containers that usually
+ * hold a few objects, such as operands or argument lists.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_SMALL_VECTOR
+#define HG_COLT_SMALL_VECTOR
+
+#include <colt/dsa/vector.h>
+
+namespace clt
+{
+  template<
+      typename T, size_t N, meta::Allocator ALLOCATOR,
+      meta::GrowthPolicy GROWTH = DefaultGrowth>
+    requires(N != 0)
+  /// @brief Dynamic size array, that stores up to N objects inline.
+  /// The inline storage is part of the object: moving a BasicSmallVector
+  /// whose objects are inline moves its objects one by one (which is why
+  /// a StackAllocator, that cannot be moved, is not used).
+  /// Once spilled to the allocator, the objects are never moved back
+  /// inline, unless 'shrink_to_fit' is called.
+  /// @tparam T The type stored in the Vector
+  /// @tparam N The count of objects stored inline
+  /// @tparam ALLOCATOR The allocator used on overflow
+  /// @tparam GROWTH The growth policy used when the Vector is full
+  class BasicSmallVector
+    : private ALLOCATOR
+  {
+    /// @brief Pointer to the inline storage or to the allocated block
+    T* blk_ptr;
+    /// @brief Capacity (count) of objects of the block (>= N)
+    size_t blk_capacity = N;
+    /// @brief Count of active objects in the block
+    size_t blk_size = 0;
+    /// @brief The inline storage
+    alignas(T) std::byte inline_storage[sizeof(T) * N];
+
+    /// @brief Check if objects can be moved using 'memcpy'
+    static constexpr bool is_trivially_relocatable =
+        std::is_trivially_move_constructible_v<T>
+        && std::is_trivially_destructible_v<T>;
+
+    /// @brief Returns a pointer to the inline storage
+    /// @return Pointer to the inline storage
+    T* inline_ptr() noexcept { return reinterpret_cast<T*>(inline_storage); }
+    /// @brief Returns a pointer to the inline storage
+    /// @return Pointer to the inline storage
+    const T* inline_ptr() const noexcept
+    {
+      return reinterpret_cast<const T*>(inline_storage);
+    }
+
+    /// @brief Frees the allocated block (if any) and uses the inline storage.
+    /// The objects must have been destroyed or moved.
+    void release() noexcept
+    {
+      if (!is_inline())
+        ALLOCATOR::dealloc({blk_ptr, blk_capacity * sizeof(T)});
+      blk_ptr      = inline_ptr();
+      blk_capacity = N;
+    }
+
+    /// @brief Grows the allocated block without moving the objects if possible.
+    /// @param new_size The new size in bytes of the block
+    /// @return True if the block was grown
+    bool grow_in_place(size_t new_size) noexcept
+    {
+      if (is_inline())
+        return false;
+      mem::MemBlock blk = {blk_ptr, blk_capacity * sizeof(T)};
+      if constexpr (meta::ExpandingAllocator<ALLOCATOR>)
+      {
+        if (ALLOCATOR::expand(blk, new_size))
+        {
+          blk_capacity = blk.size() / sizeof(T);
+          return true;
+        }
+      }
+      if constexpr (
+          meta::ReallocatableAllocator<ALLOCATOR> && is_trivially_relocatable)
+      {
+        if (ALLOCATOR::realloc(blk, new_size))
+        {
+          blk_ptr      = static_cast<T*>(blk.ptr());
+          blk_capacity = blk.size() / sizeof(T);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /// @brief Moves the objects to a new block of 'capacity' objects.
+    /// If 'capacity' is at most N, the objects are moved inline.
+    /// @param capacity The new capacity (>= size())
+    void relocate(size_t capacity) noexcept(
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+    {
+      T* old_ptr          = blk_ptr;
+      const size_t old_cp = blk_capacity;
+      mem::MemBlock new_blk =
+          capacity <= N ? mem::MemBlock{inline_ptr(), N * sizeof(T)}
+                        : ALLOCATOR::alloc(capacity * sizeof(T));
+      //register freeing the memory to avoid leaks in case of exceptions
+      ON_SCOPE_EXIT
+      {
+        if (old_ptr != inline_ptr())
+          ALLOCATOR::dealloc({old_ptr, old_cp * sizeof(T)});
+        blk_ptr      = static_cast<T*>(new_blk.ptr());
+        blk_capacity = new_blk.size() / sizeof(T);
+      };
+      details::contiguous_destructive_move(
+          old_ptr, static_cast<T*>(new_blk.ptr()), blk_size);
+    }
+
+    /// @brief Adds 'plus_capacity' objects to the capacity
+    /// @param plus_capacity The count of objects to add to the capacity
+    void reserve_obj(size_t plus_capacity) noexcept(
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+    {
+      if (plus_capacity == 0)
+        return;
+      if (grow_in_place((blk_capacity + plus_capacity) * sizeof(T)))
+        return;
+      relocate(blk_capacity + plus_capacity);
+    }
+
+    /// @brief Grows the Vector (using GROWTH) if it cannot hold 'required' objects
+    /// @param required The count of objects the Vector must be able to hold
+    void grow_for(size_t required) noexcept(
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+    {
+      if (required <= blk_capacity)
+        return;
+      reserve_obj(GROWTH::grow(blk_capacity, required, sizeof(T)) - blk_capacity);
+    }
+
+    /// @brief Steals the objects (or the block) of another Vector.
+    /// The current Vector must be empty and its objects inline.
+    /// @param to_move The Vector whose objects to steal
+    void steal(BasicSmallVector& to_move) noexcept(
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+    {
+      if (to_move.is_inline())
+      {
+        details::contiguous_destructive_move(
+            to_move.blk_ptr, blk_ptr, to_move.blk_size);
+        blk_size = std::exchange(to_move.blk_size, 0);
+        return;
+      }
+      blk_ptr      = std::exchange(to_move.blk_ptr, to_move.inline_ptr());
+      blk_capacity = std::exchange(to_move.blk_capacity, N);
+      blk_size     = std::exchange(to_move.blk_size, 0);
+    }
+
+  public:
+    /// @brief The value type stored in the list
+    using value_type = T;
+    /// @brief The count of objects that can be stored inline
+    static constexpr size_t inline_capacity = N;
+
+    /// @brief The maximum count of items that can be stored
+    /// @return The maximum theoretical size of the container
+    static size_t max_size() noexcept { return std::numeric_limits<size_t>::max(); }
+
+    /// @brief Default constructor (when the allocator is default constructible)
+    BasicSmallVector() noexcept
+      requires std::is_default_constructible_v<ALLOCATOR>
+        : blk_ptr(inline_ptr())
+    {
+    }
+
+    /// @brief Constructor
+    /// @param alloc Reference to the allocator to use on overflow
+    BasicSmallVector(const ALLOCATOR& alloc) noexcept
+        : ALLOCATOR(alloc)
+        , blk_ptr(inline_ptr())
+    {
+    }
+
+    /// @brief Reserve 'reserve' objects constructor
+    /// @param alloc Reference to the allocator
+    /// @param reserve The count of objects to be able to store
+    BasicSmallVector(const ALLOCATOR& alloc, size_t reserve) noexcept
+        : BasicSmallVector(alloc)
+    {
+      reserve_exact(reserve);
+    }
+
+    /// @brief Copies the objects of a View
+    /// @param alloc Reference to the allocator
+    /// @param to_copy The objects to copy
+    BasicSmallVector(const ALLOCATOR& alloc, View<T> to_copy) noexcept(
+        std::is_nothrow_copy_constructible_v<T>)
+        : BasicSmallVector(alloc, to_copy.size())
+    {
+      details::contiguous_copy(to_copy.data(), blk_ptr, to_copy.size());
+      blk_size = to_copy.size();
+    }
+
+    template<typename... Args>
+    /// @brief Constructs 'size' objects using 'args'
+    /// @tparam ...Args The parameter pack
+    /// @param alloc Reference to the allocator to use
+    /// @param size The count of object to construct
+    /// @param  Tag helper
+    /// @param ...args The argument pack
+    BasicSmallVector(
+        const ALLOCATOR& alloc, size_t size, in_place_t,
+        Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+        : BasicSmallVector(alloc, size)
+    {
+      details::contiguous_construct(blk_ptr, size, std::forward<Args>(args)...);
+      blk_size = size;
+    }
+
+    /// @brief Constructs a Vector from an initializer_list
+    /// @param alloc Reference to the allocator to use
+    /// @param list The initializer list
+    BasicSmallVector(const ALLOCATOR& alloc, std::initializer_list<T> list) noexcept(
+        std::is_nothrow_copy_constructible_v<T>)
+        : BasicSmallVector(alloc, View<T>{std::data(list), std::size(list)})
+    {
+    }
+
+    /// @brief Copy constructor, copy the content from 'to_copy'.
+    /// The objects are stored inline if they fit.
+    /// @param to_copy The Vector whose objects to copy
+    BasicSmallVector(const BasicSmallVector& to_copy) noexcept(
+        std::is_nothrow_copy_constructible_v<T>)
+        : BasicSmallVector(static_cast<const ALLOCATOR&>(to_copy), to_copy.to_view())
+    {
+    }
+
+    /// @brief Destroy the active objects and copy the content from 'to_copy'.
+    /// @param to_copy The Vector whose objects to copy
+    /// @return Self
+    BasicSmallVector& operator=(const BasicSmallVector& to_copy) noexcept(
+        std::is_nothrow_copy_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+    {
+      assert_true("Self assignment is prohibited!", &to_copy != this);
+      clear();
+      reserve_exact(to_copy.blk_size);
+      details::contiguous_copy(to_copy.blk_ptr, blk_ptr, to_copy.blk_size);
+      blk_size = to_copy.blk_size;
+      return *this;
+    }
+
+    /// @brief Move constructor.
+    /// Inline objects are moved one by one, allocated blocks are stolen.
+    /// @param to_move The Vector whose resources to steal
+    BasicSmallVector(BasicSmallVector&& to_move) noexcept(
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+        : ALLOCATOR(static_cast<const ALLOCATOR&>(to_move))
+        , blk_ptr(inline_ptr())
+    {
+      steal(to_move);
+    }
+
+    /// @brief Move assignment operator.
+    /// The allocator is taken from 'to_move' if its block is stolen.
+    /// @param to_move The Vector being assigned
+    /// @return Self
+    BasicSmallVector& operator=(BasicSmallVector&& to_move) noexcept(
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+    {
+      assert_true("Self assignment is prohibited!", &to_move != this);
+      clear();
+      if (!to_move.is_inline())
+      {
+        release();
+        static_cast<ALLOCATOR&>(*this) = static_cast<const ALLOCATOR&>(to_move);
+        steal(to_move);
+        return *this;
+      }
+      // our storage (inline or not) can always hold the inline objects
+      details::contiguous_destructive_move(
+          to_move.blk_ptr, blk_ptr, to_move.blk_size);
+      blk_size = std::exchange(to_move.blk_size, 0);
+      return *this;
+    }
+
+    /// @brief Destructor, destroy all active objects and free memory
+    ~BasicSmallVector() noexcept(std::is_nothrow_destructible_v<T>)
+    {
+      //register freeing even if destructor throws to avoid memory leaks
+      ON_SCOPE_EXIT
+      {
+        release();
+        blk_size = 0;
+      };
+      details::contiguous_destruct(blk_ptr, blk_size);
+    }
+
+    /// @brief Check if the objects are stored inline
+    /// @return True if the allocator is not used
+    bool is_inline() const noexcept { return blk_ptr == inline_ptr(); }
+
+    /// @brief Returns a pointer to the beginning of the data
+    /// @return Const pointer to the beginning of the data (never null)
+    const T* data() const noexcept { return blk_ptr; }
+    /// @brief Returns a pointer to the beginning of the data
+    /// @return Pointer to the beginning of the data (never null)
+    T* data() noexcept { return blk_ptr; }
+
+    /// @brief Returns the count of active objects in the Vector
+    /// @return The count of objects in the Vector
+    size_t size() const noexcept { return blk_size; }
+    /// @brief Returns the capacity of the current storage
+    /// @return The capacity of the current storage (>= N)
+    size_t capacity() const noexcept { return blk_capacity; }
+
+    /// @brief Returns the object at index 'index' of the Vector.
+    /// @param index The index of the object
+    /// @return The object at index 'index'
+    const T& operator[](size_t index) const noexcept
+    {
+      assert_true("Invalid index!", index < this->size());
+      return blk_ptr[index];
+    }
+
+    /// @brief Returns a reference to the object at index 'index' of the Vector.
+    /// @param index The index of the object
+    /// @return The object at index 'index'
+    T& operator[](size_t index) noexcept
+    {
+      assert_true("Invalid index!", index < this->size());
+      return blk_ptr[index];
+    }
+
+    /// @brief Check if the Vector does not contain any object.
+    /// Same as: size() == 0
+    /// @return True if the Vector is empty
+    bool is_empty() const noexcept { return blk_size == 0; }
+
+    /// @brief Reserve 'by_more' object
+    /// @param by_more The count of object to reserve for
+    void reserve(size_t by_more) noexcept(
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+    {
+      reserve_obj(by_more);
+    }
+
+    /// @brief Ensures that 'additional' objects can be pushed without growing.
+    /// @param additional The count of objects to be able to push
+    void reserve_exact(size_t additional) noexcept(
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+    {
+      if (blk_size + additional > blk_capacity)
+        reserve_obj(blk_size + additional - blk_capacity);
+    }
+
+    /// @brief Reduces the capacity of the Vector to its size.
+    /// If the objects fit inline, they are moved inline and the
+    /// allocated block is freed.
+    void shrink_to_fit() noexcept(
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+    {
+      if (is_inline() || blk_size == blk_capacity)
+        return;
+      if constexpr (
+          meta::ReallocatableAllocator<ALLOCATOR> && is_trivially_relocatable)
+      {
+        mem::MemBlock blk = {blk_ptr, blk_capacity * sizeof(T)};
+        if (blk_size > N && ALLOCATOR::realloc(blk, blk_size * sizeof(T)))
+        {
+          blk_ptr      = static_cast<T*>(blk.ptr());
+          blk_capacity = blk.size() / sizeof(T);
+          return;
+        }
+      }
+      relocate(blk_size);
+    }
+
+    /// @brief Appends copies of all the objects of a range.
+    /// The Vector grows at most once.
+    /// @param range The objects to copy (which can be part of the Vector)
+    void append_range(View<T> range) noexcept(
+        std::is_nothrow_copy_constructible_v<T>
+        && std::is_nothrow_move_constructible_v<T>
+        && std::is_nothrow_destructible_v<T>)
+    {
+      const T* from = range.data();
+      // growing invalidates 'range' if it is part of the Vector
+      const bool is_inner = blk_ptr <= from && from < blk_ptr + blk_size;
+      const size_t offset = is_inner ? static_cast<size_t>(from - blk_ptr) : 0;
+      grow_for(blk_size + range.size());
+      if (is_inner)
+        from = blk_ptr + offset;
+      details::contiguous_copy(from, blk_ptr + blk_size, range.size());
+      blk_size += range.size();
+    }
+
+    /// @brief Push an object at the end of the Vector by copying
+    /// @param to_copy The object to copy at the end of the Vector
+    void push_back(const T& to_copy) noexcept(
+        std::is_nothrow_copy_constructible_v<T>)
+    {
+      if (blk_size == blk_capacity)
+      {
+        // 'to_copy' may be part of the Vector
+        T copy = to_copy;
+        grow_for(blk_size + 1);
+        new (blk_ptr + blk_size) T(std::move(copy));
+      }
+      else
+        new (blk_ptr + blk_size) T(to_copy);
+      ++blk_size;
+    }
+
+    /// @brief Push an object at the end of the Vector by moving
+    /// @param to_move The object to move at the end of the Vector
+    void push_back(T&& to_move) noexcept(std::is_nothrow_move_constructible_v<T>)
+      requires(!std::is_trivial_v<T>)
+    {
+      if (blk_size == blk_capacity)
+        grow_for(blk_size + 1);
+      new (blk_ptr + blk_size) T(std::move(to_move));
+      ++blk_size;
+    }
+
+    template<typename... Args>
+    /// @brief Emplace an object at the end of the Vector
+    /// @tparam ...Args The parameter pack
+    /// @param  in_place_t tag type
+    /// @param ...args The argument pack to forward to the constructor
+    void push_back(in_place_t, Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<T, Args...>)
+    {
+      if (blk_size == blk_capacity)
+        grow_for(blk_size + 1);
+      new (blk_ptr + blk_size) T(std::forward<Args>(args)...);
+      ++blk_size;
+    }
+
+    /// @brief Pops an item from the back of the Vector.
+    void pop_back() noexcept(std::is_nothrow_destructible_v<T>)
+    {
+      assert_true("Vector is empty!", !this->is_empty());
+      --blk_size;
+      blk_ptr[blk_size].~T();
+    }
+
+    /// @brief Pops N item from the back of the Vector.
+    /// @param count The number of item to pop from the back
+    void pop_back_n(size_t count) noexcept(std::is_nothrow_destructible_v<T>)
+    {
+      assert_true(
+          "Vector is does not contain enought elements!", count <= this->size());
+      for (size_t i = blk_size - count; i < blk_size; i++)
+        blk_ptr[i].~T();
+      blk_size -= count;
+    }
+
+    /// @brief Removes all the item from the Vector.
+    /// This does not modify the capacity of the Vector.
+    void clear() noexcept(std::is_nothrow_destructible_v<T>)
+    {
+      details::contiguous_destruct(blk_ptr, blk_size);
+      blk_size = 0;
+    }
+
+    /// @brief Returns the first item in the Vector.
+    /// @return The first item in the Vector.
+    const T& front() const noexcept
+    {
+      assert_true("Vector is empty!", !this->is_empty());
+      return *blk_ptr;
+    }
+
+    /// @brief Returns the first item in the Vector.
+    /// @return The first item in the Vector.
+    T& front() noexcept
+    {
+      assert_true("Vector is empty!", !this->is_empty());
+      return *blk_ptr;
+    }
+
+    /// @brief Returns the last item in the Vector.
+    /// @return The last item in the Vector.
+    const T& back() const noexcept
+    {
+      assert_true("Vector is empty!", !this->is_empty());
+      return blk_ptr[blk_size - 1];
+    }
+
+    /// @brief Returns the last item in the Vector.
+    /// @return The last item in the Vector.
+    T& back() noexcept
+    {
+      assert_true("Vector is empty!", !this->is_empty());
+      return blk_ptr[blk_size - 1];
+    }
+
+    /// @brief Returns an iterator the beginning of the Vector
+    /// @return Iterator to the beginning of the Vector
+    T* begin() noexcept { return blk_ptr; }
+    /// @brief Returns an iterator the beginning of the Vector
+    /// @return Iterator to the beginning of the Vector
+    const T* begin() const noexcept { return blk_ptr; }
+
+    /// @brief Returns an iterator the end of the Vector
+    /// @return Iterator to the end of the Vector
+    T* end() noexcept { return blk_ptr + blk_size; }
+    /// @brief Returns an iterator the end of the Vector
+    /// @return Iterator to the end of the Vector
+    const T* end() const noexcept { return blk_ptr + blk_size; }
+
+    /// @brief Converts a Vector to a View
+    /// @return View over the whole Vector
+    operator View<T>() const noexcept { return {begin(), end()}; }
+
+    /// @brief Converts a Vector to a Span
+    /// @return Span over the whole Vector
+    operator Span<T>() noexcept { return {begin(), end()}; }
+
+    /// @brief Returns a span over the Vector
+    /// @return Span of the Vector
+    Span<T> to_view() noexcept { return *this; }
+    /// @brief Returns a view over the Vector
+    /// @return View of the Vector
+    View<T> to_view() const noexcept { return *this; }
+
+    /// @brief Check if every object of v1 and v2 are equal
+    /// @param v1 The first Vector
+    /// @param v2 The second Vector
+    /// @return True if both Vector are equal
+    friend bool operator==(const BasicSmallVector& v1, View<T> v2) noexcept
+    {
+      if (v1.size() != v2.size())
+        return false;
+      for (size_t i = 0; i < v1.size(); i++)
+        if (v1[i] != v2[i])
+          return false;
+      return true;
+    }
+
+    /// @brief Lexicographically compare two vectors
+    /// @param v1 The first vector
+    /// @param v2 The second vector
+    /// @return Result of comparison
+    friend auto operator<=>(const BasicSmallVector& v1, View<T> v2) noexcept
+    {
+      return std::lexicographical_compare_three_way(
+          v1.begin(), v1.end(), v2.begin(), v2.end());
+    }
+  };
+
+  /// @brief SmallVector spilling to the default global allocator
+  /// @tparam T The type
+  /// @tparam N The count of objects stored inline
+  /// @tparam ALLOCATOR The allocator used on overflow
+  template<
+      typename T, size_t N,
+      meta::Allocator ALLOCATOR = decltype(mem::GlobalAllocator)>
+  using SmallVector = BasicSmallVector<T, N, ALLOCATOR>;
+} // namespace clt
+
+template<typename T, size_t N, typename ALLOCATOR, typename GROWTH>
+  requires fmt::is_formattable<T>::value
+struct fmt::formatter<clt::BasicSmallVector<T, N, ALLOCATOR, GROWTH>>
+  : public fmt::formatter<clt::BasicVector<T, ALLOCATOR, GROWTH>>
+{
+};
+
+#endif // !HG_COLT_SMALL_VECTOR
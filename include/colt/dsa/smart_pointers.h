@@ -1,7 +1,9 @@
 #ifndef HG_COLT_SMART_POINTERS
 #define HG_COLT_SMART_POINTERS
 
+#include <atomic>
 #include <colt/mem/allocator_ref.h>
+#include <colt/meta/niche.h>
 
 namespace clt
 {
@@ -202,6 +204,625 @@ namespace clt
     }
     return UniquePtr<T, mem::LocalAllocatorRef<std::remove_cvref_t<decltype(ref)>>>(ref, blk);
   }
+
+  namespace details
+  {
+    template<typename T, typename Alloc, typename... Args>
+    /// @brief Allocates a T using an allocator and constructs it.
+    /// The memory is freed if the constructor throws.
+    /// @tparam T The type to construct
+    /// @param alloc The allocator
+    /// @param args... The arguments to forward to the constructor
+    /// @return Pointer to the constructed object
+    constexpr T* allocate_object(Alloc& alloc, Args&&... args) noexcept(
+        std::is_nothrow_constructible_v<T, Args...>)
+    {
+      auto blk = alloc.alloc(sizeof(T));
+      assert_true("Could not allocate memory!", !blk.is_null());
+      if constexpr (std::is_nothrow_constructible_v<T, Args...>)
+      {
+        return new (blk.ptr()) T(std::forward<Args>(args)...);
+      }
+      else
+      {
+        try
+        {
+          return new (blk.ptr()) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+          alloc.dealloc(blk);
+          throw;
+        }
+      }
+    }
+
+    template<bool ATOMIC>
+    /// @brief A reference count, atomic or not
+    class RefCount
+    {
+      /// @brief The count
+      std::conditional_t<ATOMIC, std::atomic<u64>, u64> count;
+
+    public:
+      /// @brief Constructs a count
+      /// @param value The initial count
+      constexpr RefCount(u64 value) noexcept
+          : count(value)
+      {
+      }
+
+      RefCount(const RefCount&)            = delete;
+      RefCount& operator=(const RefCount&) = delete;
+
+      /// @brief Increments the count
+      constexpr void increment() noexcept
+      {
+        if constexpr (ATOMIC)
+          count.fetch_add(1, std::memory_order_relaxed);
+        else
+          ++count;
+      }
+
+      /// @brief Decrements the count.
+      /// Acquires the writes of the other owners if the count drops to 0
+      /// (so that the object can be destroyed).
+      /// @return True if the count dropped to 0
+      constexpr bool decrement() noexcept
+      {
+        if constexpr (ATOMIC)
+          return count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        else
+          return --count == 0;
+      }
+
+      /// @brief Returns the count
+      /// @return The count (a snapshot if atomic)
+      constexpr u64 value() const noexcept
+      {
+        if constexpr (ATOMIC)
+          return count.load(std::memory_order_relaxed);
+        else
+          return count;
+      }
+    };
+
+    template<typename T, bool ATOMIC>
+    /// @brief The control block and object of a BasicRcPtr, which are
+    ///        allocated in a single MemBlock
+    struct RcBox
+    {
+      /// @brief The count of BasicRcPtr owning the object
+      RefCount<ATOMIC> count;
+      /// @brief The object
+      T value;
+
+      template<typename... Args>
+      /// @brief Constructs the object with a count of 1
+      /// @param args... The arguments to forward to the constructor
+      constexpr RcBox(in_place_t, Args&&... args) noexcept(
+          std::is_nothrow_constructible_v<T, Args...>)
+          : count(1)
+          , value(std::forward<Args>(args)...)
+      {
+      }
+    };
+  } // namespace details
+
+  template<typename T, meta::Allocator ALLOCATOR, bool ATOMIC>
+  /// @brief Reference counted pointer that frees the object when its last
+  /// owner is destroyed.
+  /// The count and the object are allocated in a single block (see make_rc
+  /// and make_arc). The count is only atomic if ATOMIC is true: use RcPtr
+  /// for objects owned by a single thread and ArcPtr for objects shared by
+  /// many threads.
+  /// @tparam T The type of the object
+  /// @tparam ALLOCATOR The allocator
+  /// @tparam ATOMIC True to use an atomic count
+  class BasicRcPtr : private ALLOCATOR
+  {
+    /// @brief The type of the block allocated
+    using box_t = details::RcBox<T, ATOMIC>;
+    /// @brief The allocator (which may be const-qualified)
+    using allocator_t = std::remove_cv_t<ALLOCATOR>;
+
+    /// @brief The control block and object or null
+    box_t* box = nullptr;
+
+    /// @brief Releases the ownership of the object
+    constexpr void release_box() noexcept(std::is_nothrow_destructible_v<T>)
+    {
+      if (box == nullptr || !box->count.decrement())
+        return;
+      ON_SCOPE_EXIT
+      {
+        ALLOCATOR::dealloc({box, sizeof(box_t)});
+      };
+      box->~box_t();
+    }
+
+  public:
+    BasicRcPtr() = delete;
+
+    /// @brief Constructs an empty BasicRcPtr
+    /// @param alloc The allocator
+    constexpr BasicRcPtr(const ALLOCATOR& alloc) noexcept
+        : ALLOCATOR(alloc)
+    {
+    }
+
+    template<typename... Args>
+    /// @brief Allocates and constructs an object owned by the pointer.
+    /// Use make_rc, make_arc, make_local_rc or make_local_arc instead.
+    /// @param alloc The allocator
+    /// @param args... The arguments to forward to the constructor
+    constexpr BasicRcPtr(
+        const ALLOCATOR& alloc, in_place_t,
+        Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>)
+        : ALLOCATOR(alloc)
+        , box(details::allocate_object<box_t>(
+              static_cast<allocator_t&>(*this), InPlace,
+              std::forward<Args>(args)...))
+    {
+    }
+
+    /// @brief Copy constructor, shares the ownership of the object
+    /// @param copy The pointer to copy
+    constexpr BasicRcPtr(const BasicRcPtr& copy) noexcept
+        : ALLOCATOR(copy)
+        , box(copy.box)
+    {
+      if (box != nullptr)
+        box->count.increment();
+    }
+
+    /// @brief Move constructor, steals the ownership of 'move'
+    /// @param move The pointer whose ownership to steal
+    constexpr BasicRcPtr(BasicRcPtr&& move) noexcept
+        : ALLOCATOR(move)
+        , box(std::exchange(move.box, nullptr))
+    {
+    }
+
+    /// @brief Copy assignment operator
+    /// @param copy The pointer to copy
+    /// @return Self
+    constexpr BasicRcPtr& operator=(const BasicRcPtr& copy) noexcept(
+        std::is_nothrow_destructible_v<T>)
+    {
+      // Copy then swap, as 'copy' may be owned by the object
+      auto tmp = copy;
+      std::swap(static_cast<allocator_t&>(tmp), static_cast<allocator_t&>(*this));
+      std::swap(box, tmp.box);
+      return *this;
+    }
+
+    /// @brief Move assignment operator
+    /// @param move The pointer whose content to swap with
+    /// @return Self
+    constexpr BasicRcPtr& operator=(BasicRcPtr&& move) noexcept
+    {
+      std::swap(static_cast<allocator_t&>(move), static_cast<allocator_t&>(*this));
+      std::swap(box, move.box);
+      return *this;
+    }
+
+    /// @brief Destructor, frees the object if this was its last owner
+    constexpr ~BasicRcPtr() noexcept(std::is_nothrow_destructible_v<T>)
+    {
+      release_box();
+    }
+
+    /// @brief Releases the ownership of the object (the pointer is then null)
+    constexpr void reset() noexcept(std::is_nothrow_destructible_v<T>)
+    {
+      release_box();
+      box = nullptr;
+    }
+
+    /// @brief Returns the count of owners of the object
+    /// @return The count of owners (0 if null)
+    constexpr u64 use_count() const noexcept
+    {
+      return box == nullptr ? 0 : box->count.value();
+    }
+
+    /// @brief Returns a pointer to the object
+    /// @return The object or null
+    constexpr T* get() const noexcept
+    {
+      return box == nullptr ? nullptr : &box->value;
+    }
+
+    /// @brief Check if the pointer is null
+    /// @return True if null
+    constexpr bool is_null() const noexcept { return box == nullptr; }
+
+    /// @brief Check if the pointer is not null
+    explicit constexpr operator bool() const noexcept { return !is_null(); }
+
+    /// @brief Check if two pointers own the same object
+    /// @param other The other pointer
+    /// @return True if both own the same object (or are null)
+    constexpr bool operator==(const BasicRcPtr& other) const noexcept
+    {
+      return box == other.box;
+    }
+
+    /// @brief Dereference operator
+    /// @return Dereferences pointer
+    constexpr T& operator*() const noexcept
+    {
+      assert_true("RcPtr was null!", !is_null());
+      return box->value;
+    }
+
+    /// @brief Dereference operator
+    /// @return Dereferences pointer
+    constexpr T* operator->() const noexcept
+    {
+      assert_true("RcPtr was null!", !is_null());
+      return &box->value;
+    }
+  };
+
+  /// @brief Reference counted pointer for objects owned by a single thread
+  /// @tparam T The type of the object
+  /// @tparam ALLOCATOR The allocator
+  template<typename T, meta::Allocator ALLOCATOR = decltype(mem::GlobalAllocator)>
+  using RcPtr = BasicRcPtr<T, ALLOCATOR, false>;
+
+  /// @brief Reference counted pointer for objects shared by many threads
+  /// @tparam T The type of the object
+  /// @tparam ALLOCATOR The allocator
+  template<typename T, meta::Allocator ALLOCATOR = decltype(mem::GlobalAllocator)>
+  using ArcPtr = BasicRcPtr<T, ALLOCATOR, true>;
+
+  template<typename T, typename... Args>
+  /// @brief Constructs a RcPtr using a global allocator
+  /// @tparam T The type to construct
+  /// @param args... The arguments to forward to the constructor
+  /// @return RcPtr
+  constexpr auto make_rc(Args&&... args) noexcept(
+      std::is_nothrow_constructible_v<T, Args...>)
+  {
+    return RcPtr<T>(mem::GlobalAllocator, InPlace, std::forward<Args>(args)...);
+  }
+
+  template<typename T, typename... Args>
+  /// @brief Constructs an ArcPtr using a global allocator
+  /// @tparam T The type to construct
+  /// @param args... The arguments to forward to the constructor
+  /// @return ArcPtr
+  constexpr auto make_arc(Args&&... args) noexcept(
+      std::is_nothrow_constructible_v<T, Args...>)
+  {
+    return ArcPtr<T>(mem::GlobalAllocator, InPlace, std::forward<Args>(args)...);
+  }
+
+  template<typename T, meta::Allocator Alloc, typename... Args>
+  /// @brief Constructs a RcPtr using a local allocator
+  /// @tparam T The type to construct
+  /// @param ref The local allocator
+  /// @param args... The arguments to forward to the constructor
+  /// @return RcPtr
+  constexpr auto make_local_rc(Alloc& ref, Args&&... args) noexcept(
+      std::is_nothrow_constructible_v<T, Args...>)
+  {
+    return RcPtr<T, mem::LocalAllocatorRef<Alloc>>(
+        ref, InPlace, std::forward<Args>(args)...);
+  }
+
+  template<typename T, meta::Allocator Alloc, typename... Args>
+  /// @brief Constructs an ArcPtr using a local allocator
+  /// @tparam T The type to construct
+  /// @param ref The local allocator
+  /// @param args... The arguments to forward to the constructor
+  /// @return ArcPtr
+  constexpr auto make_local_arc(Alloc& ref, Args&&... args) noexcept(
+      std::is_nothrow_constructible_v<T, Args...>)
+  {
+    return ArcPtr<T, mem::LocalAllocatorRef<Alloc>>(
+        ref, InPlace, std::forward<Args>(args)...);
+  }
+
+  template<bool ATOMIC>
+  /// @brief Reference count stored in an object, used by IntrusivePtr.
+  /// Objects inherit from IntrusiveCount (or AtomicIntrusiveCount if shared
+  /// by many threads). Copying an object does not copy its count.
+  /// @code{.cpp}
+  /// struct Node : public IntrusiveCount
+  /// {
+  ///   int value;
+  /// };
+  /// auto node = make_intrusive<Node>(10);
+  /// @endcode
+  /// @tparam ATOMIC True to use an atomic count
+  class BasicIntrusiveCount
+  {
+    /// @brief The count of IntrusivePtr owning the object
+    mutable details::RefCount<ATOMIC> intrusive_count = 0;
+
+  public:
+    template<typename T, meta::Allocator ALLOCATOR>
+    friend class IntrusivePtr;
+
+    /// @brief Constructs a count of 0
+    constexpr BasicIntrusiveCount() noexcept = default;
+    /// @brief Does not copy the count
+    constexpr BasicIntrusiveCount(const BasicIntrusiveCount&) noexcept {}
+    /// @brief Does not copy the count
+    /// @return Self
+    constexpr BasicIntrusiveCount& operator=(const BasicIntrusiveCount&) noexcept
+    {
+      return *this;
+    }
+
+    /// @brief Returns the count of IntrusivePtr owning the object
+    /// @return The count (a snapshot if atomic)
+    constexpr u64 use_count() const noexcept { return intrusive_count.value(); }
+  };
+
+  /// @brief Non-atomic intrusive count
+  using IntrusiveCount = BasicIntrusiveCount<false>;
+  /// @brief Atomic intrusive count
+  using AtomicIntrusiveCount = BasicIntrusiveCount<true>;
+
+  namespace meta
+  {
+    /// @brief Check if a type stores its reference count (see IntrusiveCount)
+    template<typename T>
+    concept intrusively_counted =
+        std::derived_from<T, BasicIntrusiveCount<false>>
+        || std::derived_from<T, BasicIntrusiveCount<true>>;
+  } // namespace meta
+
+  template<typename T, meta::Allocator ALLOCATOR = decltype(mem::GlobalAllocator)>
+  /// @brief Reference counted pointer whose count is stored in the object.
+  /// As the count is stored in the object, an IntrusivePtr can be created
+  /// from a raw pointer to an object owned by other IntrusivePtr.
+  /// The object must have been allocated (with sizeof(T)) by the allocator:
+  /// use make_intrusive or make_local_intrusive.
+  /// @tparam T The type of the object (inheriting from IntrusiveCount)
+  /// @tparam ALLOCATOR The allocator
+  class IntrusivePtr : private ALLOCATOR
+  {
+    static_assert(
+        meta::intrusively_counted<T>,
+        "T must inherit from IntrusiveCount or AtomicIntrusiveCount!");
+
+    /// @brief The allocator (which may be const-qualified)
+    using allocator_t = std::remove_cv_t<ALLOCATOR>;
+
+    /// @brief The object or null
+    T* ptr = nullptr;
+
+    /// @brief Releases the ownership of the object
+    constexpr void release_ptr() noexcept(std::is_nothrow_destructible_v<T>)
+    {
+      if (ptr == nullptr || !ptr->intrusive_count.decrement())
+        return;
+      ON_SCOPE_EXIT
+      {
+        ALLOCATOR::dealloc({ptr, sizeof(T)});
+      };
+      ptr->~T();
+    }
+
+  public:
+    IntrusivePtr() = delete;
+
+    /// @brief Constructs an empty IntrusivePtr
+    /// @param alloc The allocator
+    constexpr IntrusivePtr(const ALLOCATOR& alloc) noexcept
+        : ALLOCATOR(alloc)
+    {
+    }
+
+    /// @brief Shares the ownership of an object.
+    /// @param alloc The allocator that allocated the object
+    /// @param ptr The object (allocated by 'alloc') or null
+    constexpr IntrusivePtr(const ALLOCATOR& alloc, T* ptr) noexcept
+        : ALLOCATOR(alloc)
+        , ptr(ptr)
+    {
+      if (ptr != nullptr)
+        ptr->intrusive_count.increment();
+    }
+
+    /// @brief Copy constructor, shares the ownership of the object
+    /// @param copy The pointer to copy
+    constexpr IntrusivePtr(const IntrusivePtr& copy) noexcept
+        : IntrusivePtr(copy, copy.ptr)
+    {
+    }
+
+    /// @brief Move constructor, steals the ownership of 'move'
+    /// @param move The pointer whose ownership to steal
+    constexpr IntrusivePtr(IntrusivePtr&& move) noexcept
+        : ALLOCATOR(move)
+        , ptr(std::exchange(move.ptr, nullptr))
+    {
+    }
+
+    /// @brief Copy assignment operator
+    /// @param copy The pointer to copy
+    /// @return Self
+    constexpr IntrusivePtr& operator=(const IntrusivePtr& copy) noexcept(
+        std::is_nothrow_destructible_v<T>)
+    {
+      // Copy then swap, as 'copy' may be owned by the object
+      auto tmp = copy;
+      std::swap(static_cast<allocator_t&>(tmp), static_cast<allocator_t&>(*this));
+      std::swap(ptr, tmp.ptr);
+      return *this;
+    }
+
+    /// @brief Move assignment operator
+    /// @param move The pointer whose content to swap with
+    /// @return Self
+    constexpr IntrusivePtr& operator=(IntrusivePtr&& move) noexcept
+    {
+      std::swap(static_cast<allocator_t&>(move), static_cast<allocator_t&>(*this));
+      std::swap(ptr, move.ptr);
+      return *this;
+    }
+
+    /// @brief Destructor, frees the object if this was its last owner
+    constexpr ~IntrusivePtr() noexcept(std::is_nothrow_destructible_v<T>)
+    {
+      release_ptr();
+    }
+
+    /// @brief Releases the ownership of the object (the pointer is then null)
+    constexpr void reset() noexcept(std::is_nothrow_destructible_v<T>)
+    {
+      release_ptr();
+      ptr = nullptr;
+    }
+
+    /// @brief Returns the count of owners of the object
+    /// @return The count of owners (0 if null)
+    constexpr u64 use_count() const noexcept
+    {
+      return ptr == nullptr ? 0 : ptr->use_count();
+    }
+
+    /// @brief Returns a pointer to the object
+    /// @return The object or null
+    constexpr T* get() const noexcept { return ptr; }
+
+    /// @brief Check if the pointer is null
+    /// @return True if null
+    constexpr bool is_null() const noexcept { return ptr == nullptr; }
+
+    /// @brief Check if the pointer is not null
+    explicit constexpr operator bool() const noexcept { return !is_null(); }
+
+    /// @brief Check if two pointers own the same object
+    /// @param other The other pointer
+    /// @return True if both own the same object (or are null)
+    constexpr bool operator==(const IntrusivePtr& other) const noexcept
+    {
+      return ptr == other.ptr;
+    }
+
+    /// @brief Dereference operator
+    /// @return Dereferences pointer
+    constexpr T& operator*() const noexcept
+    {
+      assert_true("IntrusivePtr was null!", !is_null());
+      return *ptr;
+    }
+
+    /// @brief Dereference operator
+    /// @return Dereferences pointer
+    constexpr T* operator->() const noexcept
+    {
+      assert_true("IntrusivePtr was null!", !is_null());
+      return ptr;
+    }
+  };
+
+  template<typename T, typename... Args>
+  /// @brief Constructs an IntrusivePtr using a global allocator
+  /// @tparam T The type to construct
+  /// @param args... The arguments to forward to the constructor
+  /// @return IntrusivePtr
+  constexpr auto make_intrusive(Args&&... args) noexcept(
+      std::is_nothrow_constructible_v<T, Args...>)
+  {
+    auto ptr = details::allocate_object<T>(
+        mem::GlobalAllocator, std::forward<Args>(args)...);
+    return IntrusivePtr<T>(mem::GlobalAllocator, ptr);
+  }
+
+  template<typename T, meta::Allocator Alloc, typename... Args>
+  /// @brief Constructs an IntrusivePtr using a local allocator
+  /// @tparam T The type to construct
+  /// @param ref The local allocator
+  /// @param args... The arguments to forward to the constructor
+  /// @return IntrusivePtr
+  constexpr auto make_local_intrusive(Alloc& ref, Args&&... args) noexcept(
+      std::is_nothrow_constructible_v<T, Args...>)
+  {
+    return IntrusivePtr<T, mem::LocalAllocatorRef<Alloc>>(
+        ref, details::allocate_object<T>(ref, std::forward<Args>(args)...));
+  }
+
+  template<typename T>
+    requires std::is_object_v<T>
+  /// @brief Non-owning pointer that is never null.
+  /// The null pointer is then a niche (usable at compile time): an
+  /// Option<NonNull<T>> is the same size as a T*. Raw pointers have no
+  /// niches, as nullptr is a valid value of a T*.
+  class NonNull
+  {
+    /// @brief The pointer (only null for the niche)
+    T* ptr;
+
+    /// @brief Constructs the niche
+    constexpr NonNull(std::nullptr_t) noexcept
+        : ptr(nullptr)
+    {
+    }
+
+    friend struct meta::niche<NonNull>;
+
+  public:
+    NonNull() = delete;
+
+    /// @brief Constructor
+    /// @param ptr The pointer (which must not be null)
+    constexpr NonNull(T* ptr) noexcept
+        : ptr(ptr)
+    {
+      assert_true("NonNull cannot be null!", ptr != nullptr);
+    }
+
+    MAKE_DEFAULT_COPY_AND_MOVE_FOR(NonNull);
+
+    /// @brief Returns the pointer
+    /// @return The pointer (never null)
+    constexpr T* get() const noexcept { return ptr; }
+    /// @brief Converts to the pointer
+    /// @return The pointer (never null)
+    constexpr operator T*() const noexcept { return ptr; }
+    /// @brief Dereferences the pointer
+    /// @return The pointed object
+    constexpr T& operator*() const noexcept { return *ptr; }
+    /// @brief Dereferences the pointer
+    /// @return The pointer (never null)
+    constexpr T* operator->() const noexcept { return ptr; }
+
+    /// @brief Compares two pointers
+    /// @param other The other pointer
+    /// @return True if both point to the same object
+    constexpr bool operator==(const NonNull& other) const noexcept = default;
+  };
+
+  namespace meta
+  {
+    /// @brief The null pointer is never a NonNull
+    template<typename T>
+    struct niche<NonNull<T>>
+    {
+      /// @brief The null pointer
+      static constexpr size_t count = 1;
+
+      /// @brief Returns the niche
+      /// @return The NonNull storing nullptr
+      static constexpr NonNull<T> make(size_t) noexcept { return {nullptr}; }
+
+      /// @brief Returns the index of the niche 'ptr'
+      /// @param ptr The pointer
+      /// @return 0 if 'ptr' is the niche, else 1
+      static constexpr size_t index_of(const NonNull<T>& ptr) noexcept
+      {
+        return ptr.ptr == nullptr ? 0 : 1;
+      }
+    };
+  } // namespace meta
 } // namespace clt
 
 #endif // !HG_COLT_SMART_POINTERS
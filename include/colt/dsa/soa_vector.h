@@ -0,0 +1,433 @@
+/*****************************************************************/ /**
+ * @file   soa_vector.h
+ * @brief  Contains BasicSoAVector, a dynamic array of reflected
+ * structs stored as a structure of arrays.
+ * Each member registered through `COLT_DECLARE_TYPE` is stored in its
+ * own contiguous column: a pass that only reads one or two members of
+ * each object only touches the memory of these columns, which can
+ * also be processed using SIMD.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_SOA_VECTOR
+#define HG_COLT_SOA_VECTOR
+
+#include <memory>
+#include <utility>
+#include <colt/dsa/vector.h>
+#include <colt/meta/reflect.h>
+
+namespace clt
+{
+  namespace details
+  {
+    /// @brief Helper to obtain the alignment of the columns
+    /// @tparam List The type_list of the members
+    template<typename List>
+    struct soa_columns;
+
+    /// @brief Helper to obtain the alignment of the columns
+    /// @tparam ...Ts The types of the members
+    template<typename... Ts>
+    struct soa_columns<meta::type_list<Ts...>>
+    {
+      /// @brief The greatest alignment of the columns
+      static constexpr size_t alignment = clt::max({alignof(Ts)..., size_t(1)});
+    };
+  } // namespace details
+
+  template<
+      typename T, meta::Allocator ALLOCATOR,
+      meta::GrowthPolicy GROWTH = DefaultGrowth>
+    requires meta::reflectable<T>
+             && (meta::reflect<T>::kind() == meta::EntityKind::IS_CLASS)
+             && (meta::reflect<T>::members_type::size != 0)
+             && (details::soa_columns<typename meta::reflect<T>::members_type>::
+                     alignment
+                 <= ALLOCATOR::alignment)
+  /// @brief Dynamic size array of T, storing each registered member of T
+  /// in its own contiguous array (column).
+  /// All the columns live in a single block obtained from ALLOCATOR.
+  /// The members of T that were not registered are not stored: reading
+  /// back an object ('load') default constructs it first.
+  /// @tparam T The reflected type (through COLT_DECLARE_TYPE)
+  /// @tparam ALLOCATOR The allocator
+  /// @tparam GROWTH The growth policy used when the Vector is full
+  class BasicSoAVector
+    : private ALLOCATOR
+  {
+    /// @brief The type_list of the registered members
+    using members_t = typename meta::reflect<T>::members_type;
+    /// @brief The count of columns
+    static constexpr size_t COLUMNS = members_t::size;
+
+  public:
+    template<size_t I>
+      requires(I < COLUMNS)
+    /// @brief The type of the column 'I'
+    using column_t = std::remove_cv_t<typename members_t::template get<I>>;
+
+  private:
+    /// @brief The allocated block (can be null)
+    mem::MemBlock blk = mem::nullblk;
+    /// @brief The beginning of each column (null if not allocated)
+    void* columns[COLUMNS] = {};
+    /// @brief Capacity (count) of objects of each column
+    size_t blk_capacity = 0;
+    /// @brief Count of active objects
+    size_t blk_size = 0;
+
+    template<typename Fn>
+    /// @brief Calls 'fn' with std::integral_constant<size_t, I> for each column
+    /// @tparam Fn The function type
+    /// @param fn The function
+    static constexpr void for_each_index(Fn&& fn)
+    {
+      [&]<size_t... I>(std::index_sequence<I...>) {
+        (fn(std::integral_constant<size_t, I>{}), ...);
+      }(std::make_index_sequence<COLUMNS>{});
+    }
+
+    /// @brief Computes the size of a block whose columns hold 'capacity' objects
+    /// @param capacity The capacity of the columns
+    /// @param offsets The offset of each column in the block
+    /// @return The size of the block
+    static size_t layout(size_t capacity, size_t (&offsets)[COLUMNS]) noexcept
+    {
+      size_t size = 0;
+      for_each_index(
+          [&]<size_t I>(std::integral_constant<size_t, I>)
+          {
+            constexpr size_t ALIGN = alignof(column_t<I>);
+            size       = (size + ALIGN - 1) & ~(ALIGN - 1);
+            offsets[I] = size;
+            size += capacity * sizeof(column_t<I>);
+          });
+      return size;
+    }
+
+    /// @brief Moves the objects to a new block of 'capacity' objects
+    /// @param capacity The new capacity (>= size())
+    void relocate(size_t capacity) noexcept
+    {
+      size_t offsets[COLUMNS];
+      auto new_blk = ALLOCATOR::alloc(layout(capacity, offsets));
+      assert_true("Could not allocate memory!", !new_blk.is_null());
+      for_each_index(
+          [&]<size_t I>(std::integral_constant<size_t, I>)
+          {
+            auto to = ptr_to<column_t<I>*>(
+                static_cast<u8*>(new_blk.ptr()) + offsets[I]);
+            if (columns[I] != nullptr)
+              details::contiguous_destructive_move(
+                  column<I>().data(), to, blk_size);
+            columns[I] = to;
+          });
+      if (!blk.is_null())
+        ALLOCATOR::dealloc(blk);
+      blk          = new_blk;
+      blk_capacity = capacity;
+    }
+
+    /// @brief Grows the Vector (using GROWTH) if it cannot hold 'required' objects
+    /// @param required The count of objects the Vector must be able to hold
+    void grow_for(size_t required) noexcept
+    {
+      if (required <= blk_capacity)
+        return;
+      relocate(GROWTH::grow(blk_capacity, required, sizeof(T)));
+    }
+
+    /// @brief Destroys the objects of the columns
+    void destruct() noexcept
+    {
+      for_each_index(
+          [&]<size_t I>(std::integral_constant<size_t, I>)
+          {
+            if (columns[I] != nullptr)
+              details::contiguous_destruct(column<I>().data(), blk_size);
+          });
+      blk_size = 0;
+    }
+
+    template<bool IS_CONST>
+    /// @brief Proxy to the members of an object of the Vector
+    /// @tparam IS_CONST True if the members can only be read
+    class Row
+    {
+      /// @brief The (possibly const) Vector type
+      using vec_t = meta::match_cv_t<
+          std::conditional_t<IS_CONST, const void, void>, BasicSoAVector>;
+
+      /// @brief The Vector
+      vec_t* vec;
+      /// @brief The index of the object
+      size_t index;
+
+    public:
+      /// @brief Constructor
+      /// @param vec The Vector
+      /// @param index The index of the object
+      constexpr Row(vec_t* vec, size_t index) noexcept
+          : vec(vec)
+          , index(index)
+      {
+      }
+
+      template<size_t I>
+      /// @brief Returns the member 'I' of the object
+      /// @return Reference to the member
+      auto& get() const noexcept
+      {
+        return vec->template column<I>()[index];
+      }
+
+      /// @brief Assigns each registered member of an object to the row
+      /// @param obj The object whose members to copy
+      /// @return Self
+      const Row& operator=(const T& obj) const noexcept
+        requires(!IS_CONST)
+      {
+        size_t i = 0;
+        meta::reflect<T>::apply_on_members(
+            obj,
+            [&]<typename Ty>(const Ty& value)
+            {
+              using column = std::remove_cv_t<Ty>;
+              static_cast<column*>(vec->columns[i++])[index] = value;
+            });
+        return *this;
+      }
+
+      /// @brief Materializes the object (see BasicSoAVector::load)
+      /// @return The object
+      operator T() const noexcept
+        requires std::is_default_constructible_v<T>
+      {
+        return vec->load(index);
+      }
+    };
+
+  public:
+    /// @brief The value type stored in the list
+    using value_type = T;
+    /// @brief The proxy type of the objects
+    using row_t = Row<false>;
+    /// @brief The const proxy type of the objects
+    using const_row_t = Row<true>;
+
+    /// @brief The count of columns (registered members of T)
+    /// @return The count of columns
+    static constexpr size_t column_count() noexcept { return COLUMNS; }
+
+    /// @brief Constructor
+    /// @param alloc Reference to the allocator to use
+    BasicSoAVector(const ALLOCATOR& alloc) noexcept
+        : ALLOCATOR(alloc)
+    {
+    }
+
+    /// @brief Reserve 'reserve' objects constructor
+    /// @param alloc Reference to the allocator
+    /// @param reserve The count of objects to allocate for
+    BasicSoAVector(const ALLOCATOR& alloc, size_t reserve) noexcept
+        : ALLOCATOR(alloc)
+    {
+      reserve_exact(reserve);
+    }
+
+    /// @brief Copy constructor, copy the content from 'to_copy'
+    /// @param to_copy The Vector whose objects to copy
+    BasicSoAVector(const BasicSoAVector& to_copy) noexcept
+        : BasicSoAVector(static_cast<const ALLOCATOR&>(to_copy), to_copy.size())
+    {
+      for_each_index(
+          [&]<size_t I>(std::integral_constant<size_t, I>)
+          {
+            auto from = to_copy.template column<I>();
+            details::contiguous_copy(
+                from.data(), static_cast<column_t<I>*>(columns[I]), from.size());
+          });
+      blk_size = to_copy.size();
+    }
+
+    /// @brief Move constructor
+    /// @param to_move The Vector whose resources to steal
+    BasicSoAVector(BasicSoAVector&& to_move) noexcept
+        : ALLOCATOR(static_cast<const ALLOCATOR&>(to_move))
+        , blk(std::exchange(to_move.blk, mem::nullblk))
+        , blk_capacity(std::exchange(to_move.blk_capacity, 0))
+        , blk_size(std::exchange(to_move.blk_size, 0))
+    {
+      for (size_t i = 0; i < COLUMNS; i++)
+        columns[i] = std::exchange(to_move.columns[i], nullptr);
+    }
+
+    /// @brief Move assignment operator, swaps every member (allocator included)
+    /// @param to_move The Vector being assigned
+    /// @return Self
+    BasicSoAVector& operator=(BasicSoAVector&& to_move) noexcept
+    {
+      assert_true("Self assignment is prohibited!", &to_move != this);
+      std::swap(static_cast<ALLOCATOR&>(to_move), static_cast<ALLOCATOR&>(*this));
+      std::swap(to_move.blk, blk);
+      std::swap(to_move.columns, columns);
+      std::swap(to_move.blk_capacity, blk_capacity);
+      std::swap(to_move.blk_size, blk_size);
+      return *this;
+    }
+
+    BasicSoAVector& operator=(const BasicSoAVector&) = delete;
+
+    /// @brief Destructor, destroy all active objects and free memory
+    ~BasicSoAVector() noexcept
+    {
+      destruct();
+      if (!blk.is_null())
+        ALLOCATOR::dealloc(blk);
+    }
+
+    /// @brief Returns the count of active objects in the Vector
+    /// @return The count of objects in the Vector
+    size_t size() const noexcept { return blk_size; }
+    /// @brief Returns the capacity of the columns
+    /// @return The capacity of the columns
+    size_t capacity() const noexcept { return blk_capacity; }
+    /// @brief Check if the Vector does not contain any object.
+    /// Same as: size() == 0
+    /// @return True if the Vector is empty
+    bool is_empty() const noexcept { return blk_size == 0; }
+
+    template<size_t I>
+      requires(I < COLUMNS)
+    /// @brief Returns the column of the member 'I' (in registration order)
+    /// @return Span over the active objects of the column
+    Span<column_t<I>> column() noexcept
+    {
+      return {static_cast<column_t<I>*>(columns[I]), blk_size};
+    }
+
+    template<size_t I>
+      requires(I < COLUMNS)
+    /// @brief Returns the column of the member 'I' (in registration order)
+    /// @return View over the active objects of the column
+    View<column_t<I>> column() const noexcept
+    {
+      return {static_cast<const column_t<I>*>(columns[I]), blk_size};
+    }
+
+    /// @brief Returns a proxy to the object at index 'index'
+    /// @param index The index of the object
+    /// @return Proxy to the members of the object
+    row_t operator[](size_t index) noexcept
+    {
+      assert_true("Invalid index!", index < this->size());
+      return {this, index};
+    }
+
+    /// @brief Returns a proxy to the object at index 'index'
+    /// @param index The index of the object
+    /// @return Proxy to the members of the object
+    const_row_t operator[](size_t index) const noexcept
+    {
+      assert_true("Invalid index!", index < this->size());
+      return {this, index};
+    }
+
+    /// @brief Materializes the object at index 'index'.
+    /// The object is default constructed, then its registered members
+    /// are assigned from the columns.
+    /// @param index The index of the object
+    /// @return The object
+    T load(size_t index) const noexcept
+      requires std::is_default_constructible_v<T>
+    {
+      assert_true("Invalid index!", index < this->size());
+      T obj{};
+      size_t i = 0;
+      meta::reflect<T>::apply_on_members(
+          obj, [&]<typename Ty>(Ty& value)
+          { value = static_cast<const Ty*>(columns[i++])[index]; });
+      return obj;
+    }
+
+    /// @brief Ensures that 'additional' objects can be pushed without growing.
+    /// @param additional The count of objects to be able to push
+    void reserve_exact(size_t additional) noexcept
+    {
+      if (blk_size + additional > blk_capacity)
+        relocate(blk_size + additional);
+    }
+
+    /// @brief Reduces the capacity of the Vector to its size.
+    void shrink_to_fit() noexcept
+    {
+      if (blk_size == blk_capacity)
+        return;
+      if (blk_size != 0)
+        return relocate(blk_size);
+      ALLOCATOR::dealloc(blk);
+      blk          = mem::nullblk;
+      blk_capacity = 0;
+      for (auto& column : columns)
+        column = nullptr;
+    }
+
+    /// @brief Push an object at the end of the Vector by copying its
+    /// registered members to the columns
+    /// @param to_copy The object to copy at the end of the Vector
+    void push_back(const T& to_copy) noexcept
+    {
+      grow_for(blk_size + 1);
+      size_t i = 0;
+      meta::reflect<T>::apply_on_members(
+          to_copy,
+          [&]<typename Ty>(const Ty& value)
+          {
+            using column = std::remove_cv_t<Ty>;
+            new (static_cast<column*>(columns[i++]) + blk_size) column(value);
+          });
+      ++blk_size;
+    }
+
+    /// @brief Push an object at the end of the Vector by moving its
+    /// registered members to the columns
+    /// @param to_move The object to move at the end of the Vector
+    void push_back(T&& to_move) noexcept
+    {
+      grow_for(blk_size + 1);
+      size_t i = 0;
+      meta::reflect<T>::apply_on_members(
+          to_move,
+          [&]<typename Ty>(Ty& value)
+          {
+            using column = std::remove_cv_t<Ty>;
+            new (static_cast<column*>(columns[i++]) + blk_size)
+                column(std::move(value));
+          });
+      ++blk_size;
+    }
+
+    /// @brief Pops an item from the back of the Vector.
+    void pop_back() noexcept
+    {
+      assert_true("Vector is empty!", !this->is_empty());
+      --blk_size;
+      for_each_index(
+          [&]<size_t I>(std::integral_constant<size_t, I>)
+          { std::destroy_at(static_cast<column_t<I>*>(columns[I]) + blk_size); });
+    }
+
+    /// @brief Removes all the item from the Vector.
+    /// This does not modify the capacity of the Vector.
+    void clear() noexcept { destruct(); }
+  };
+
+  /// @brief SoAVector using the default global allocator
+  /// @tparam T The reflected type
+  template<typename T>
+  using SoAVector = BasicSoAVector<T, decltype(mem::GlobalAllocator)>;
+} // namespace clt
+
+#endif // !HG_COLT_SOA_VECTOR
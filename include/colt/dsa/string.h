@@ -1,8 +1,21 @@
+/*****************************************************************/ /**
+ * @file   string.h
+ * @brief  Contains BasicString, a contiguous Unicode aware string with a
+ * Small String Optimization buffer, cached code point count and middle,
+ * and copy-on-write of literals.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
 #ifndef HG_DSA_STRING
 #define HG_DSA_STRING
 
+#include <cstring>
+
 #include "string_view.h"
+#include "colt/dsa/vector.h"
 #include "colt/mem/allocator_ref.h"
+#include "colt/unicode/transcode.h"
 
 namespace clt
 {
@@ -77,30 +90,43 @@ namespace clt
     };
   } // namespace meta
 
+  /// @brief Check if a pointer (maybe) points into the const segment
+  /// of the executable.
+  /// @param ptr The pointer to check for
+  /// @return True if in const segment
+  COLTCPP_EXPORT bool maybe_in_const_segment(const void* ptr) noexcept;
+
   namespace details
   {
-    struct SSOMiddle
+    /// @brief The cached count of code points of a long string
+    struct SSOCount
     {
       size_t value{};
     };
 
-    struct SSOCount
+    /// @brief The cached unit offset of the middle code point of a long string
+    struct SSOMiddle
     {
       size_t value{};
     };
 
-    template<bool CACHE_MIDDLE>
-    using SSOCacheMiddle =
-        std::conditional_t<CACHE_MIDDLE, SSOCount, meta::empty_t<SSOCount>>;
-    template<bool CACHE_COUNT>
+    template<bool HAS_COUNT>
     using SSOCacheCount =
-        std::conditional_t<CACHE_COUNT, SSOMiddle, meta::empty_t<SSOMiddle>>;
+        std::conditional_t<HAS_COUNT, SSOCount, meta::empty_t<SSOCount>>;
+    template<bool HAS_MIDDLE>
+    using SSOCacheMiddle =
+        std::conditional_t<HAS_MIDDLE, SSOMiddle, meta::empty_t<SSOMiddle>>;
 
-    template<meta::CharType Ty, bool CACHE_MIDDLE, bool CACHE_COUNT>
+    /// @brief The informations of a string that is not stored in the SSO buffer
+    /// @tparam Ty The char type
+    /// @tparam HAS_COUNT True if the count of code points is cached
+    /// @tparam HAS_MIDDLE True if the offset to the middle code point is cached
+    template<meta::CharType Ty, bool HAS_COUNT, bool HAS_MIDDLE>
     class SSOLongInfo
-        : private SSOCacheCount<CACHE_COUNT>
-        , private SSOCacheMiddle<CACHE_MIDDLE>
+        : private SSOCacheCount<HAS_COUNT>
+        , private SSOCacheMiddle<HAS_MIDDLE>
     {
+      /// @brief The characters (not written to if borrowed from a literal)
       Ty* _ptr;
 
     public:
@@ -111,27 +137,28 @@ namespace clt
       constexpr auto& ptr() const noexcept { return _ptr; }
 
       constexpr auto& count() noexcept
-        requires CACHE_COUNT
+        requires HAS_COUNT
       {
-        return SSOCacheCount<CACHE_COUNT>::value;
+        return SSOCacheCount<HAS_COUNT>::value;
       }
       constexpr auto& count() const noexcept
-        requires CACHE_COUNT
+        requires HAS_COUNT
       {
-        return SSOCacheCount<CACHE_COUNT>::value;
+        return SSOCacheCount<HAS_COUNT>::value;
       }
       constexpr auto& middle() noexcept
-        requires CACHE_MIDDLE
+        requires HAS_MIDDLE
       {
-        return SSOCacheMiddle<CACHE_MIDDLE>::value;
+        return SSOCacheMiddle<HAS_MIDDLE>::value;
       }
       constexpr auto& middle() const noexcept
-        requires CACHE_COUNT
+        requires HAS_MIDDLE
       {
-        return SSOCacheMiddle<CACHE_MIDDLE>::value;
+        return SSOCacheMiddle<HAS_MIDDLE>::value;
       }
     };
 
+    /// @brief The SSO buffer, or the informations of a long string
     template<meta::StringCustomization CUSTOMIZATION>
     class SSOBuffer
     {
@@ -141,9 +168,7 @@ namespace clt
     private:
       union
       {
-        SSOLongInfo<
-            meta::encoding_to_char_t<CUSTOMIZATION.ENCODING>,
-            CUSTOMIZATION.CACHE_MIDDLE, CUSTOMIZATION.CACHE_COUNT>
+        SSOLongInfo<char_t, CUSTOMIZATION.has_count(), CUSTOMIZATION.has_middle()>
             _long;
 
         char_t _buffer[clt::max(
@@ -191,6 +216,21 @@ namespace clt
     };
   } // namespace details
 
+  /// @brief Contiguous Unicode aware string.
+  /// The characters are stored in one of three states:
+  /// - short: in the SSO buffer (if HAS_BUFFER), the count of code points
+  ///   being cached in the capacity (if HAS_COUNT).
+  /// - borrowed: the string was constructed from a literal in the const
+  ///   segment (if HAS_COW), which is only copied on the first modification.
+  /// - long: in memory obtained from ALLOCATOR.
+  ///
+  /// When HAS_COUNT (and HAS_MIDDLE), the count of code points (and the
+  /// offset to the middle code point) is updated incrementally by each
+  /// modification: only the appended units are counted (using the SIMD
+  /// `countlen` and `count_and_middle` kernels). Copies, moves and switches
+  /// between the states never count the code points again.
+  /// @tparam CUSTOMIZATION The customization of the string
+  /// @tparam ALLOCATOR The allocator
   template<meta::StringCustomization CUSTOMIZATION, typename ALLOCATOR>
   class BasicString : private ALLOCATOR
   {
@@ -206,157 +246,537 @@ namespace clt
     static constexpr bool HAS_MIDDLE = CUSTOMIZATION.has_middle();
     /// @brief True if the string supports Copy On Write for literals
     static constexpr bool HAS_COW = CUSTOMIZATION.has_cow();
-    /// @brief The size of the SSO buffer
+    /// @brief The size of the SSO buffer (including the NUL-terminator)
     static constexpr size_t SSO_SIZE =
         CUSTOMIZATION.buffer_bytesize() / sizeof(char_t);
 
   private:
+    /// @brief Set in '_capacity' if the characters are in the SSO buffer
+    static constexpr size_t SHORT_FLAG = size_t(1) << (sizeof(size_t) * 8 - 1);
+
+    /// @brief The SSO buffer, or the pointer to the characters
     details::SSOBuffer<CUSTOMIZATION> _ptr_or_buffer;
+    /// @brief The count of units (not including the NUL-terminator)
     size_t _size;
+    /// @brief The capacity in units (including the NUL-terminator) of the
+    ///        allocated characters, 0 if borrowed, or SHORT_FLAG | count of
+    ///        code points (0 if not HAS_COUNT) if in the SSO buffer
     size_t _capacity;
 
+    /// @brief Check if the characters are stored in the SSO buffer
+    /// @return True if short
     HEDLEY_ALWAYS_INLINE
-    bool _is_long() const noexcept
-      requires HAS_BUFFER
+    bool _is_short() const noexcept
     {
-      return _capacity != SSO_SIZE;
+      if constexpr (HAS_BUFFER)
+        return (_capacity & SHORT_FLAG) != 0;
+      else
+        return false;
     }
 
-    /// @brief The true size of the string (including NUL terminator)
-    /// @return _size + 1 to account for terminator
-    size_t _true_size() const noexcept { return _size + (size_t)(_size != 0); }
+    /// @brief Check if the characters are borrowed from a literal
+    /// @return True if borrowed (the characters must not be modified)
+    HEDLEY_ALWAYS_INLINE
+    bool _is_borrowed() const noexcept { return _capacity == 0; }
 
-    /// @brief Allocates more memory for the string.
-    /// This modifies the capacity (and data()).
-    /// @param new_capacity The new capacity
-    void alloc(size_t new_capacity) noexcept
+    /// @brief Returns the cached count of code points
+    /// @return The count of code points
+    size_t _cached_count() const noexcept
+      requires HAS_COUNT
+    {
+      return _is_short() ? _capacity & ~SHORT_FLAG : _ptr_or_buffer.count();
+    }
+
+    /// @brief Sets the cached count of code points (if HAS_COUNT)
+    /// @param count The count of code points
+    void _set_count([[maybe_unused]] size_t count) noexcept
+    {
+      if constexpr (HAS_COUNT)
+      {
+        if (_is_short())
+          _capacity = SHORT_FLAG | count;
+        else
+          _ptr_or_buffer.count() = count;
+      }
+    }
+
+    /// @brief Returns the unit offset of the middle code point (of index
+    ///        size() / 2, or 0 if empty)
+    /// @return The offset (only cached if not short)
+    size_t _middle_offset() const noexcept
+      requires HAS_MIDDLE
     {
       if constexpr (HAS_BUFFER)
       {
-        // No allocations needed
-        if (new_capacity < SSO_SIZE)
+        if (_is_short())
         {
-          _capacity = SSO_SIZE;
-          return;
+          const auto buffer = _ptr_or_buffer.buffer();
+          return uni::iterator_index_front(buffer, _cached_count() / 2) - buffer;
         }
       }
-      auto blk = ALLOCATOR::alloc((new_capacity + _capacity) * sizeof(char_t));
-      ::memcpy(blk.ptr(), data(), _true_size() * sizeof(char_t));
-      dealloc();
-      _ptr_or_buffer.ptr() = ptr_to<char_t*>(blk.ptr());
-      _capacity            = new_capacity;
+      return _ptr_or_buffer.middle();
     }
 
-    /// @brief Deallocates current allocated memory.
-    /// This does not modify any of the members.
-    void dealloc() noexcept
+    /// @brief Counts the code points of units and finds the middle one
+    /// @param ptr The units
+    /// @param units The count of units
+    /// @return The count and the unit offset of the code point of index count / 2
+    static std::pair<size_t, size_t> _count_and_middle(
+        const char_t* ptr, size_t units) noexcept
+    {
+      // 'count_and_middle' finds the code point of index count / 2 - 1
+      // if the count is even, else of index count / 2 or count / 2 + 1
+      auto [count, middle] = uni::count_and_middle(ptr, units);
+      if (count % 2 == 0 && count != 0)
+        middle = uni::iterator_index_front(ptr + middle, 1) - ptr;
+      else if (count != 0 && uni::countlen(ptr, middle) != count / 2)
+        middle = uni::iterator_index_back(ptr + middle, 1) - ptr;
+      return {count, middle};
+    }
+
+    /// @brief Returns a pointer to the characters (which may be borrowed)
+    /// @return Pointer to the characters
+    const char_t* _data() const noexcept
     {
+      if constexpr (HAS_BUFFER)
+        return _is_short() ? _ptr_or_buffer.buffer() : _ptr_or_buffer.ptr();
+      else
+        return _ptr_or_buffer.ptr();
+    }
+
+    /// @brief Returns a pointer to the characters, that must not be borrowed
+    /// @return Pointer to the characters
+    char_t* _data_mut() noexcept
+    {
+      assert_true("Borrowed characters cannot be modified!", !_is_borrowed());
+      return const_cast<char_t*>(_data());
+    }
+
+    /// @brief Makes the string empty (without deallocating)
+    void _reset_empty() noexcept
+    {
+      _size = 0;
       if constexpr (HAS_BUFFER)
       {
-        if (_is_long())
-          ALLOCATOR::dealloc({_ptr_or_buffer.ptr(), _capacity * sizeof(char_t)});
-        // No need to deallocate as internal buffer is used instead
+        _capacity                  = SHORT_FLAG;
+        _ptr_or_buffer.buffer()[0] = char_t{};
       }
       else
-        ALLOCATOR::dealloc(
-            {(void*)((uintptr_t)_ptr_or_buffer.ptr() * (size_t)(_capacity != 0)),
-             _capacity * sizeof(char_t)});
-      // The multiplication by (_capacity != 0) is used to eliminate
-      // the case where the BasicString is initialized to "".
+      {
+        _capacity            = 0;
+        _ptr_or_buffer.ptr() =
+            const_cast<char_t*>(meta::empty_string_literal<char_t>());
+      }
     }
 
-  public:
-    /// @brief Constructs an empty string
-    BasicString(const ALLOCATOR& ALLOC) noexcept
-      requires HAS_BUFFER
-        : ALLOCATOR(ALLOC)
-        , _size(0)
-        , _capacity(SSO_SIZE)
+    /// @brief References characters without copying them
+    /// @param ptr The characters (NUL-terminated, which must outlive the string)
+    /// @param units The count of units
+    void _borrow(const char_t* ptr, size_t units) noexcept
+    {
+      _ptr_or_buffer.ptr() = const_cast<char_t*>(ptr);
+      _size                = units;
+      _capacity            = 0;
+      if constexpr (HAS_MIDDLE)
+      {
+        const auto [count, middle] = _count_and_middle(ptr, units);
+        _ptr_or_buffer.count()     = count;
+        _ptr_or_buffer.middle()    = middle;
+      }
+      else if constexpr (HAS_COUNT)
+        _ptr_or_buffer.count() = uni::countlen(ptr, units);
+    }
+
+    /// @brief Deallocates the characters if allocated.
+    /// This does not modify any of the members.
+    void _dealloc() noexcept
+    {
+      if (!_is_short() && !_is_borrowed())
+        ALLOCATOR::dealloc({_ptr_or_buffer.ptr(), _capacity * sizeof(char_t)});
+    }
+
+    /// @brief Grows the allocated characters without copying them if possible
+    /// @param new_capacity The new capacity (in units)
+    /// @return True if the characters were grown
+    bool _grow_in_place(size_t new_capacity) noexcept
     {
-      _ptr_or_buffer.buffer()[0] = '\0';
+      mem::MemBlock blk = {_ptr_or_buffer.ptr(), _capacity * sizeof(char_t)};
+      if constexpr (meta::ExpandingAllocator<ALLOCATOR>)
+      {
+        if (ALLOCATOR::expand(blk, new_capacity * sizeof(char_t)))
+        {
+          _capacity = blk.size() / sizeof(char_t);
+          return true;
+        }
+      }
+      if constexpr (meta::ReallocatableAllocator<ALLOCATOR>)
+      {
+        if (ALLOCATOR::realloc(blk, new_capacity * sizeof(char_t)))
+        {
+          _ptr_or_buffer.ptr() = static_cast<char_t*>(blk.ptr());
+          _capacity            = blk.size() / sizeof(char_t);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /// @brief Moves the characters to allocated memory.
+    /// The cached count and middle are preserved.
+    /// @param new_capacity The capacity (in units, > _size)
+    void _to_long(size_t new_capacity) noexcept
+    {
+      if (!_is_short() && !_is_borrowed() && _grow_in_place(new_capacity))
+        return;
+      [[maybe_unused]] size_t count  = 0;
+      [[maybe_unused]] size_t middle = 0;
+      if constexpr (HAS_COUNT)
+        count = _cached_count();
+      if constexpr (HAS_MIDDLE)
+        middle = _middle_offset();
+
+      auto blk       = ALLOCATOR::alloc(new_capacity * sizeof(char_t));
+      const auto ptr = static_cast<char_t*>(blk.ptr());
+      std::memcpy(ptr, _data(), _size * sizeof(char_t));
+      ptr[_size] = char_t{};
+      _dealloc();
+      _ptr_or_buffer.ptr() = ptr;
+      _capacity            = blk.size() / sizeof(char_t);
+      if constexpr (HAS_COUNT)
+        _ptr_or_buffer.count() = count;
+      if constexpr (HAS_MIDDLE)
+        _ptr_or_buffer.middle() = middle;
+    }
+
+    /// @brief Ensures the characters are not borrowed and that 'units'
+    ///        units (and the NUL-terminator) can be stored.
+    /// The cached count and middle are preserved.
+    /// @param units The count of units to store
+    /// @param exact If true, allocates exactly, else uses DefaultGrowth
+    void _make_room(size_t units, bool exact = false) noexcept
+    {
+      if (_is_short())
+      {
+        if (units < SSO_SIZE)
+          return;
+      }
+      else if (_is_borrowed())
+      {
+        if constexpr (HAS_BUFFER)
+        {
+          // Copies the literal to the SSO buffer
+          if (units < SSO_SIZE)
+          {
+            const char_t* from = _ptr_or_buffer.ptr();
+            size_t count       = 0;
+            if constexpr (HAS_COUNT)
+              count = _ptr_or_buffer.count();
+            std::memcpy(_ptr_or_buffer.buffer(), from, _size * sizeof(char_t));
+            _ptr_or_buffer.buffer()[_size] = char_t{};
+            _capacity                      = SHORT_FLAG | count;
+            return;
+          }
+        }
+      }
+      else if (units < _capacity)
+        return;
+      const size_t required = units + 1;
+      _to_long(
+          exact ? required
+                : DefaultGrowth::grow(capacity(), required, sizeof(char_t)));
+    }
+
+    /// @brief Adds to the size units written after the end of the string.
+    /// The middle is moved from the nearest known code point: either the
+    /// previous middle, or the middle of the written units.
+    /// @param len The count of units written (which must fit in the capacity)
+    /// @param count The count of code points of the units (if HAS_COUNT)
+    /// @param middle The offset to the code point of index count / 2 of
+    ///               the units (if HAS_MIDDLE)
+    void _commit(
+        size_t len, [[maybe_unused]] size_t count,
+        [[maybe_unused]] size_t middle) noexcept
+    {
+      [[maybe_unused]] size_t old_count = 0;
       if constexpr (HAS_COUNT)
+        old_count = _cached_count();
+      const auto ptr        = _data_mut();
+      const size_t old_size = _size;
+      _size += len;
+      ptr[_size] = char_t{};
+
+      if constexpr (HAS_MIDDLE)
       {
-        if (_is_long())
-          _ptr_or_buffer.count() = 0;
+        if (!_is_short())
+        {
+          const size_t target = (old_count + count) / 2;
+          const char_t* at;
+          if (target >= old_count)
+          {
+            // In the written units: from their middle
+            const size_t anchor = old_count + count / 2;
+            at                  = ptr + old_size + middle;
+            if (target >= anchor)
+              at = uni::iterator_index_front(at, target - anchor);
+            else
+              at = uni::iterator_index_back(at, anchor - target);
+          }
+          else
+          {
+            at = uni::iterator_index_front(
+                ptr + _ptr_or_buffer.middle(), target - old_count / 2);
+          }
+          _ptr_or_buffer.middle() = at - ptr;
+        }
       }
+      _set_count(old_count + count);
+    }
+
+    /// @brief Adds to the size units written after the end of the string,
+    ///        counting their code points
+    /// @param len The count of units written (which must fit in the capacity)
+    void _commit_counted(size_t len) noexcept
+    {
+      const auto units = _data() + _size;
       if constexpr (HAS_MIDDLE)
       {
-        if (_is_long())
-          _ptr_or_buffer.middle() = 0;
+        const auto [count, middle] = _count_and_middle(units, len);
+        _commit(len, count, middle);
+      }
+      else if constexpr (HAS_COUNT)
+        _commit(len, uni::countlen(units, len), 0);
+      else
+        _commit(len, 0, 0);
+    }
+
+    /// @brief Appends units whose count of code points is known
+    /// @param units The units to append (which may be part of the string)
+    /// @param len The count of units
+    /// @param count The count of code points of the units (if HAS_COUNT)
+    /// @param middle The offset to the code point of index count / 2 of
+    ///               the units (if HAS_MIDDLE)
+    void _append(
+        const char_t* units, size_t len, size_t count, size_t middle) noexcept
+    {
+      if (len == 0)
+        return;
+      // The units may be part of the string, which may be moved
+      const char_t* old_data = _data();
+      const bool is_self     = units >= old_data && units <= old_data + _size;
+      const size_t self_at   = is_self ? units - old_data : 0;
+
+      _make_room(_size + len);
+      const auto ptr = _data_mut();
+      std::memmove(
+          ptr + _size, is_self ? ptr + self_at : units, len * sizeof(char_t));
+      _commit(len, count, middle);
+    }
+
+    /// @brief Appends units, counting their code points
+    /// @param units The units to append
+    /// @param len The count of units
+    void _append_counted(const char_t* units, size_t len) noexcept
+    {
+      if (len == 0)
+        return;
+      if constexpr (HAS_MIDDLE)
+      {
+        const auto [count, middle] = _count_and_middle(units, len);
+        _append(units, len, count, middle);
+      }
+      else if constexpr (HAS_COUNT)
+        _append(units, len, uni::countlen(units, len), 0);
+      else
+        _append(units, len, 0, 0);
+    }
+
+    /// @brief Returns a pointer to the code point of index 'index'.
+    /// The nearest of the start, the middle and the end is used.
+    /// @param index The index (<= size())
+    /// @return Pointer to the code point
+    const char_t* _iter_at(size_t index) const noexcept
+    {
+      const auto ptr = data();
+      if constexpr (HAS_COUNT)
+      {
+        const size_t count = _cached_count();
+        if constexpr (HAS_MIDDLE)
+        {
+          if (!_is_short())
+          {
+            const size_t half  = count / 2;
+            const auto middle  = ptr + _ptr_or_buffer.middle();
+            if (index >= half && index - half <= count - index)
+              return uni::iterator_index_front(middle, index - half);
+            if (index < half && half - index < index)
+              return uni::iterator_index_back(middle, half - index);
+          }
+        }
+        if (count - index < index)
+          return uni::iterator_index_back(ptr + _size, count - index);
       }
+      return uni::iterator_index_front(ptr, index);
     }
 
-    BasicString(const ALLOCATOR& ALLOC) noexcept
-      requires(!HAS_BUFFER)
-        : ALLOCATOR(ALLOC)
-        , _size(0)
-        , _capacity(0)
+  public:
+    /// @brief Constructs an empty string
+    /// @param alloc The allocator
+    BasicString(const ALLOCATOR& alloc) noexcept
+        : ALLOCATOR(alloc)
     {
-      _ptr_or_buffer.ptr() = meta::empty_string_literal<char_t>();
+      _reset_empty();
     }
 
+    /// @brief Constructs a string from a literal.
+    /// If HAS_COW and the literal is in the const segment, the literal
+    /// is not copied until the string is modified.
+    /// @param alloc The allocator
+    /// @param literal The literal
     template<size_t N>
     BasicString(
-        const ALLOCATOR& ALLOC, const UnicodeLiteral<char_t, N>& literal) noexcept
-        : BasicString(ALLOC, BasicStringView<STR_ENCODING, false>(literal))
+        const ALLOCATOR& alloc, const UnicodeLiteral<char_t, N>& literal) noexcept
+        : ALLOCATOR(alloc)
     {
+      if constexpr (HAS_COW)
+      {
+        if (maybe_in_const_segment(literal.data()))
+        {
+          _borrow(literal.data(), N - 1);
+          return;
+        }
+      }
+      _reset_empty();
+      _make_room(N - 1, true);
+      _append_counted(literal.data(), N - 1);
     }
 
+    /// @brief Constructs a string by copying a view
+    /// @param alloc The allocator
+    /// @param str The view to copy
+    /// @param added_capacity The capacity to reserve in addition to the view
     template<bool IS_ZSTRING>
     BasicString(
-        const ALLOCATOR& ALLOC, BasicStringView<STR_ENCODING, IS_ZSTRING> str,
+        const ALLOCATOR& alloc, BasicStringView<STR_ENCODING, IS_ZSTRING> str,
         size_t added_capacity = 0) noexcept
-        : ALLOCATOR(ALLOC)
-        , _size(0)
-        , _capacity(SSO_SIZE)
+        : ALLOCATOR(alloc)
     {
-      const size_t size = str.unit_len();
-      // The size must still be 0 when call is done to not copy anything
-      alloc(size + added_capacity + 1);
-      _size = size;
+      _reset_empty();
+      _make_room(str.unit_len() + added_capacity, true);
+      _append_counted(str.data(), str.unit_len());
+    }
 
-      const auto cache_data = data();
-      ::memcpy(cache_data, str.data(), sizeof(char_t) * _size);
-      cache_data[_size] = '\0';
+    /// @brief Copy constructor.
+    /// Short strings copy their buffer, borrowed strings share the literal.
+    /// The cached count and middle are copied.
+    /// @param other The string to copy
+    BasicString(const BasicString& other) noexcept
+        : ALLOCATOR(other)
+        , _ptr_or_buffer(other._ptr_or_buffer)
+        , _size(other._size)
+        , _capacity(other._capacity)
+    {
+      if (_is_short() || _is_borrowed())
+        return;
+      _reset_empty();
+      _make_room(other._size, true);
+      std::memcpy(_data_mut(), other.data(), (other._size + 1) * sizeof(char_t));
+      _size = other._size;
+      if constexpr (HAS_COUNT)
+        _set_count(other._cached_count());
       if constexpr (HAS_MIDDLE)
       {
-        if (_is_long())
-        {
-          auto [count, middle]    = uni::count_and_middle(cache_data, _size);
-          _ptr_or_buffer.count()  = count;
-          _ptr_or_buffer.middle() = middle;
-        }
-      }
-      else if constexpr (HAS_COUNT)
-      {
-        if (_is_long())
-          _ptr_or_buffer.count() = uni::countlen(cache_data, _size);
+        if (!_is_short())
+          _ptr_or_buffer.middle() = other._ptr_or_buffer.middle();
       }
     }
 
-    ~BasicString() { dealloc(); }
+    /// @brief Move constructor (leaves 'other' empty)
+    /// @param other The string whose resources to steal
+    BasicString(BasicString&& other) noexcept
+        : ALLOCATOR(other)
+        , _ptr_or_buffer(other._ptr_or_buffer)
+        , _size(other._size)
+        , _capacity(other._capacity)
+    {
+      other._reset_empty();
+    }
 
-    /// @brief Returns a pointer to the data owned by the string
-    /// @return Pointer to the data owned by the string
-    const char_t* data() const noexcept
+    /// @brief Copy assignment operator
+    /// @param other The string to copy
+    /// @return Self
+    BasicString& operator=(const BasicString& other) noexcept
     {
-      if constexpr (HAS_BUFFER)
-        return _is_long() ? _ptr_or_buffer.ptr() : _ptr_or_buffer.buffer();
-      else
-        return _ptr_or_buffer.ptr();
+      if (this != &other)
+        *this = BasicString(other);
+      return *this;
     }
 
-    /// @brief Returns a pointer to the data owned by the string
-    /// @return Pointer to the data owned by the string
+    /// @brief Move assignment operator, swaps every member (allocator included)
+    /// @param other The string being assigned
+    /// @return Self
+    BasicString& operator=(BasicString&& other) noexcept
+    {
+      assert_true("Self assignment is prohibited!", &other != this);
+      std::swap(static_cast<ALLOCATOR&>(other), static_cast<ALLOCATOR&>(*this));
+      std::swap(_ptr_or_buffer, other._ptr_or_buffer);
+      std::swap(_size, other._size);
+      std::swap(_capacity, other._capacity);
+      return *this;
+    }
+
+    /// @brief Destructor
+    ~BasicString() noexcept { _dealloc(); }
+
+    /// @brief Returns a pointer to the characters of the string
+    /// @return Pointer to the (NUL-terminated) characters
+    const char_t* data() const noexcept { return _data(); }
+
+    /// @brief Returns a pointer to the characters of the string.
+    /// If the characters are borrowed, they are copied.
+    /// @return Pointer to the (NUL-terminated) characters
     char_t* data() noexcept
     {
-      // Thanks Scott!
-      return const_cast<char_t*>(static_cast<const BasicString&>(*this).data());
+      if (_is_borrowed())
+        _make_room(_size, true);
+      return _data_mut();
     }
 
     /// @brief Returns the capacity of the string
-    /// @return The capacity of the string
-    size_t capacity() const noexcept { return _capacity; }
+    /// @return The count of units (including the NUL-terminator) that can
+    ///         be stored without allocating, or 0 if borrowed
+    size_t capacity() const noexcept
+    {
+      if (_is_short())
+        return SSO_SIZE;
+      return _capacity;
+    }
+
+    /// @brief Check if the characters are borrowed from a literal (which
+    ///        was not copied, see NO_COPY_IF_CONST)
+    /// @return True if borrowed
+    bool is_borrowed() const noexcept { return _is_borrowed(); }
+
+    /// @brief Ensures 'units' units can be stored without allocating
+    /// @param units The count of units (not including the NUL-terminator)
+    void reserve(size_t units) noexcept
+    {
+      if (units > _size)
+        _make_room(units, true);
+    }
+
+    /// @brief Unsafe, grows the size to 'size' units.
+    /// The units after the end of the string (which must be in the capacity,
+    /// see 'reserve' and the non-const 'data') must have been written: only
+    /// their code points are counted.
+    /// @param size The new size (in units, < capacity())
+    void _Unsafe_size(size_t size) noexcept
+    {
+      assert_true("Invalid size!", _size <= size);
+      if (size == _size)
+        return;
+      assert_true("Size must be in the capacity!", size < capacity());
+      _commit_counted(size - _size);
+    }
 
     /// @brief Returns the count of code points in the string
     /// This does not include the NUL terminator.
@@ -364,12 +784,17 @@ namespace clt
     size_t size() const noexcept
     {
       if constexpr (HAS_COUNT)
-        return _is_long() ? _ptr_or_buffer.count()
-                          : uni::countlen(_ptr_or_buffer.buffer(), _size);
+        return _cached_count();
+      else if constexpr (!is_variadic_encoding(STR_ENCODING))
+        return _size;
       else
         return uni::countlen(data(), _size);
     }
 
+    /// @brief Returns the count of code points and of units of the string
+    /// @return The LenInfo of the string
+    uni::LenInfo len() const noexcept { return {size(), _size}; }
+
     /// @brief Returns an iterator to the start of the string
     /// @return Iterator to the start of the string
     uni::CodePointIterator<STR_ENCODING> begin() const noexcept { return data(); }
@@ -413,43 +838,114 @@ namespace clt
       return npos;
     }
 
-    /// @brief Shortens the view from the front by 1.
+    /// @brief Removes all the characters.
+    /// A borrowed string stops referencing its literal.
+    void clear() noexcept
+    {
+      if (_is_borrowed())
+      {
+        _reset_empty();
+        return;
+      }
+      _size            = 0;
+      _data_mut()[0]   = char_t{};
+      _set_count(0);
+      if constexpr (HAS_MIDDLE)
+      {
+        if (!_is_short())
+          _ptr_or_buffer.middle() = 0;
+      }
+    }
+
+    /// @brief Removes the first code point.
     /// @return Self
-    BasicString& pop_front() noexcept {}
+    BasicString& pop_front() noexcept { return pop_front_n(1); }
 
-    /// @brief Shortens the view from the front by N.
-    /// @param N The number of objects to pop
+    /// @brief Removes the first N code points.
+    /// A borrowed string is not copied (the rest of the literal is referenced).
+    /// @param N The number of code points to remove
     /// @return Self
-    BasicString& pop_front_n(size_t N) noexcept {}
+    BasicString& pop_front_n(size_t N) noexcept
+    {
+      assert_true("Invalid N for pop_front_n", N <= size());
+      if (N == 0)
+        return *this;
+      const auto ptr       = _data();
+      const size_t removed = uni::iterator_index_front(ptr, N) - ptr;
+      [[maybe_unused]] size_t new_count = 0;
+      if constexpr (HAS_COUNT)
+        new_count = _cached_count() - N;
+      if constexpr (HAS_MIDDLE)
+      {
+        // The new middle is after the old one
+        if (!_is_short())
+        {
+          const size_t old_half = (new_count + N) / 2;
+          const auto middle     = uni::iterator_index_front(
+              ptr + _ptr_or_buffer.middle(), N + new_count / 2 - old_half);
+          _ptr_or_buffer.middle() = (middle - ptr) - removed;
+        }
+      }
+      if (_is_borrowed())
+        _ptr_or_buffer.ptr() += removed;
+      else
+      {
+        const auto mut = _data_mut();
+        std::memmove(mut, mut + removed, (_size - removed + 1) * sizeof(char_t));
+      }
+      _size -= removed;
+      _set_count(new_count);
+      return *this;
+    }
 
-    /// @brief Shortens the view from the back by 1.
+    /// @brief Removes the last code point.
     /// @return Self
     BasicString& pop_back() noexcept { return pop_back_n(1); }
 
-    /// @brief Shortens the view from the back by N.
-    /// @param N The number of objects to pop
+    /// @brief Removes the last N code points.
+    /// @param N The number of code points to remove
     /// @return Self
     BasicString& pop_back_n(size_t N) noexcept
     {
-      assert_true("Invalid N for pop_back_n", N < size());
-      const auto cache_data = data();
-      auto iter             = uni::iterator_index_back(cache_data + _size, N);
+      assert_true("Invalid N for pop_back_n", N <= size());
+      if (N == 0)
+        return *this;
+      // The NUL-terminator must be written
+      if (_is_borrowed())
+        _make_room(_size, true);
+      const auto ptr  = _data_mut();
+      const auto iter = uni::iterator_index_back(ptr + _size, N);
+      [[maybe_unused]] size_t new_count = 0;
+      if constexpr (HAS_COUNT)
+        new_count = _cached_count() - N;
       if constexpr (HAS_MIDDLE)
       {
-        if (_is_long())
+        // The new middle is before the old one
+        if (!_is_short())
         {
-          auto middle = uni::iterator_index_front(iter, N / 2);
-          _ptr_or_buffer.middle() -= middle - iter;
-          _ptr_or_buffer.count() -= N;
+          const size_t old_half = (new_count + N) / 2;
+          const auto middle     = uni::iterator_index_back(
+              ptr + _ptr_or_buffer.middle(), old_half - new_count / 2);
+          _ptr_or_buffer.middle() = new_count == 0 ? 0 : middle - ptr;
         }
       }
-      else if constexpr (HAS_COUNT)
-      {
-        if (_is_long())
-          _ptr_or_buffer.count() -= N;
-      }
-      _size = iter - cache_data;
-      *iter = '\0';
+      _size = iter - ptr;
+      *iter = char_t{};
+      _set_count(new_count);
+      return *this;
+    }
+
+    /// @brief Appends a code point
+    /// @param chr The code point (which must be representable in the encoding)
+    /// @return Self
+    BasicString& push_back(char32_t chr) noexcept
+    {
+      assert_true(
+          "Code point is not representable!",
+          uni::details::encoded_units<char_t>(chr) != 0);
+      char_t units[4];
+      const size_t len = uni::details::unchecked_encode(chr, units) - units;
+      _append(units, len, 1, 0);
       return *this;
     }
 
@@ -463,15 +959,31 @@ namespace clt
     char32_t operator[](size_t index) const noexcept { return index_front(index); }
 
     /// @brief Returns the char at index 'index'.
+    /// The nearest of the start, the cached middle and the end (if
+    /// HAS_COUNT) is used as a starting point.
     /// @pre index < size()
     /// @param index The index of the char to return
     /// @return The char at index 'index'
-    char32_t index_front(size_t index) const noexcept;
+    char32_t index_front(size_t index) const noexcept
+    {
+      assert_true("Invalid index!", index < size());
+      return uni::index_front(_iter_at(index), 0);
+    }
+
     /// @brief Returns the char at index 'index' starting from the end.
     /// @pre index < size()
     /// @param index The index of the char to return
     /// @return The char at index 'index' starting from the end
-    char32_t index_back(size_t index) const noexcept;
+    char32_t index_back(size_t index) const noexcept
+    {
+      if constexpr (HAS_COUNT)
+      {
+        assert_true("Invalid index!", index < size());
+        return index_front(size() - 1 - index);
+      }
+      else
+        return uni::index_back(data() + _size - 1, index);
+    }
 
     /// @brief Get the front of the view.
     /// @return The first item of the view
@@ -492,11 +1004,7 @@ namespace clt
     /// @brief Returns a NUL-terminated string.
     /// This is always guaranteed to work without allocation.
     /// @return NUL-terminated string
-    auto c_str() const noexcept { return data(); }
-    /// @brief Returns a NUL-terminated string.
-    /// This is always guaranteed to work without allocation.
-    /// @return NUL-terminated string
-    auto c_str() noexcept { return data(); }
+    const char_t* c_str() const noexcept { return data(); }
 
     /// @brief Returns a StringView over the characters
     /// @return StringView over all the characters
@@ -522,44 +1030,45 @@ namespace clt
       return {data(), _size};
     }
 
+    /// @brief Appends a literal
+    /// @param str The literal
+    /// @return Self
     template<size_t SIZE>
     BasicString& operator+=(const UnicodeLiteral<char_t, SIZE>& str) noexcept
     {
       return *this += (BasicStringView<STR_ENCODING, false>)str;
     }
 
+    /// @brief Appends a view (only its code points are counted)
+    /// @param str The view
+    /// @return Self
     template<bool IS_ZSTR>
     BasicString& operator+=(
         const BasicStringView<STR_ENCODING, IS_ZSTR>& str) noexcept
     {
-      auto len = str.unit_len();
-      if (len + _true_size() > capacity())
-        alloc(len + _true_size());
-      const auto cache_data = data();
-      ::memcpy(cache_data + _size, str.data(), len * sizeof(char_t));
-      _size += len;
-      cache_data[_size] = '\0';
+      _append_counted(str.data(), str.unit_len());
+      return *this;
+    }
+
+    /// @brief Appends a string (whose cached count and middle are reused)
+    /// @param str The string
+    /// @return Self
+    BasicString& operator+=(const BasicString& str) noexcept
+    {
       if constexpr (HAS_MIDDLE)
-      {
-        if (_is_long())
-        {
-          const auto [count, middle] = uni::count_and_middle(str.data(), len);
-          _ptr_or_buffer.count() += count;
-          _ptr_or_buffer.middle() += middle;
-        }
-      }
+        _append(str.data(), str._size, str._cached_count(), str._middle_offset());
       else if constexpr (HAS_COUNT)
-      {
-        if (_is_long())
-        {
-          const auto cache_len = uni::countlen(str.data(), len);
-          _ptr_or_buffer.count() += cache_len;
-        }
-      }
-
+        _append(str.data(), str._size, str._cached_count(), 0);
+      else
+        _append(str.data(), str._size, 0, 0);
       return *this;
     }
 
+    friend bool operator==(const BasicString& v1, const BasicString& v2) noexcept
+    {
+      return v1.to_zview() == v2.to_zview();
+    }
+
     template<meta::CharType ENCODING2, size_t N>
     friend constexpr auto operator==(
         const BasicString& v1, const UnicodeLiteral<ENCODING2, N>& v2) noexcept
@@ -601,12 +1110,6 @@ namespace clt
     }
   };
 
-  /// @brief Check if a pointer (maybe) points into the const segment
-  /// of the executable.
-  /// @param ptr The pointer to check for
-  /// @return True if in const segment
-  bool maybe_in_const_segment(const void* ptr) noexcept;
-
   /// @brief Represents a String with the default customization
   using String = BasicString<
       meta::StringCustomization{StringEncoding::UTF8, 24, true, true, true},
@@ -670,96 +1173,6 @@ namespace clt
     using enum clt::StringEncoding;
     return make_string<UTF32>(std::forward<Ty>(args)...);
   }
-
-  template<meta::StringCustomization CUSTOMIZATION, typename ALLOCATOR>
-  char32_t BasicString<CUSTOMIZATION, ALLOCATOR>::index_front(
-      size_t index) const noexcept
-  {
-    assert_true("Invalid index!", index < size());
-    // If the size is not cached, then computing the size
-    // will take more time than just indexing.
-    if constexpr (HAS_MIDDLE)
-    {
-      if (_is_long())
-      {
-        const size_t cached_size         = size();
-        const size_t middle_cached_size  = cached_size / 2;
-        const size_t quarter_cached_size = cached_size / 4;
-        if (index >= middle_cached_size)
-        {
-          return uni::index_front(
-              _ptr_or_buffer.ptr() + _ptr_or_buffer.middle(),
-              index - middle_cached_size);
-        }
-        if (index > quarter_cached_size)
-        {
-          return uni::index_back(
-              _ptr_or_buffer.ptr() + _ptr_or_buffer.middle(),
-              middle_cached_size - index);
-        }
-        return uni::index_front(_ptr_or_buffer.ptr(), index);
-      }
-      return uni::index_front(_ptr_or_buffer.buffer(), index);
-    }
-    else if constexpr (HAS_COUNT)
-    {
-      if (_is_long())
-      {
-        if (index >= _ptr_or_buffer.count() / 2)
-          return uni::index_back(
-              _ptr_or_buffer.ptr(), _ptr_or_buffer.count() - index);
-        return uni::index_front(_ptr_or_buffer.ptr(), index);
-      }
-      return uni::index_front(_ptr_or_buffer.buffer(), index);
-    }
-    else
-      return uni::index_front(data(), index);
-  }
-
-  template<meta::StringCustomization CUSTOMIZATION, typename ALLOCATOR>
-  char32_t BasicString<CUSTOMIZATION, ALLOCATOR>::index_back(
-      size_t index) const noexcept
-  {
-    assert_true("Invalid index!", index < size());
-    // If the size is not cached, then computing the size
-    // will take more time than just indexing.
-    if constexpr (HAS_MIDDLE)
-    {
-      if (_is_long())
-      {
-        const size_t cached_size         = size();
-        const size_t middle_cached_size  = cached_size / 2;
-        const size_t quarter_cached_size = 3 * (cached_size / 4);
-        if (index >= middle_cached_size)
-        {
-          return uni::index_back(
-              _ptr_or_buffer.ptr() + _ptr_or_buffer.middle(),
-              middle_cached_size - index);
-        }
-        if (index > quarter_cached_size)
-        {
-          return uni::index_front(
-              _ptr_or_buffer.ptr() + _ptr_or_buffer.middle(),
-              index - middle_cached_size);
-        }
-        return uni::index_back(_ptr_or_buffer.ptr() + _size - 1, index);
-      }
-      return uni::index_back(_ptr_or_buffer.buffer() + _size - 1, index);
-    }
-    else if constexpr (HAS_COUNT)
-    {
-      if (_is_long())
-      {
-        if (index >= _ptr_or_buffer.count() / 2)
-          return uni::index_front(
-              _ptr_or_buffer.ptr(), _ptr_or_buffer.count() - index);
-        return uni::index_back(data() + _size - 1, index);
-      }
-      return uni::index_back(_ptr_or_buffer.buffer() + _size - 1, index);
-    }
-    else
-      return uni::index_back(data() + _size - 1, index);
-  }
 } // namespace clt
 
 template<clt::meta::StringCustomization CUSTOMIZATION, typename ALLOCATOR>
@@ -776,7 +1189,7 @@ struct fmt::formatter<clt::BasicString<CUSTOMIZATION, ALLOCATOR>>
   template<typename FormatContext>
   auto format(const to_format& vec, FormatContext& ctx) const
   {
-    return format_to(ctx.out(), "{}", vec.to_view());
+    return fmt::format_to(ctx.out(), "{}", vec.to_view());
   }
 };
 
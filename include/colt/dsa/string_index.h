@@ -0,0 +1,404 @@
+/*****************************************************************//**
+ * @file   string_index.h
+ * @brief  Contains BasicCodePointIndex, a sparse index mapping code
+ *         point indices of a view to unit offsets, and BasicUTF16OffsetIndex,
+ *         which maps the offsets of a UTF8 view to UTF16 offsets (as used
+ *         by the Language Server Protocol) and back.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_DSA_STRING_INDEX
+#define HG_DSA_STRING_INDEX
+
+#include <algorithm>
+
+#include "colt/dsa/string_view.h"
+#include "colt/dsa/vector.h"
+
+namespace clt
+{
+  /// @brief Sparse index over the code points of a BasicStringView.
+  /// The unit offset of one code point every STRIDE code points is stored,
+  /// so that random access decodes at most STRIDE - 1 code points
+  /// instead of half of the view.
+  /// The index is built lazily on the first query, and can then be reused
+  /// for indexing, sub-views and iterator advances.
+  /// For fixed width encodings, no checkpoint is stored.
+  /// @warning The index does not own the characters of the view.
+  /// @warning As the index is built lazily, the first query is not
+  ///          thread-safe: call 'build' before sharing the index.
+  /// @tparam ENCODING The encoding of the view
+  /// @tparam ALLOCATOR The allocator used for the checkpoints
+  /// @tparam STRIDE The count of code points between two checkpoints
+  template<StringEncoding ENCODING, meta::Allocator ALLOCATOR, size_t STRIDE = 64>
+    requires(STRIDE != 0)
+  class BasicCodePointIndex
+  {
+  public:
+    /// @brief The underlying character type
+    using underlying_type = meta::encoding_to_char_t<ENCODING>;
+    /// @brief The view type whose code points are indexed
+    using view_t = BasicStringView<ENCODING>;
+
+    /// @brief True if the encoding is not variadic (no checkpoints are needed)
+    static constexpr bool IS_FIXED_WIDTH = !is_variadic_encoding(ENCODING);
+
+  private:
+    /// @brief The indexed view
+    view_t _view;
+    /// @brief The offset of the code points whose index is a multiple of STRIDE
+    mutable BasicVector<size_t, ALLOCATOR> _checkpoints;
+    /// @brief The count of code points in the view
+    mutable size_t _count = 0;
+    /// @brief True if the checkpoints were computed
+    mutable bool _built = IS_FIXED_WIDTH;
+
+    /// @brief Computes the checkpoints and the count of code points
+    constexpr void build_checkpoints() const noexcept
+    {
+      const auto begin = _view.data();
+      const auto size  = _view.unit_len();
+      _checkpoints.reserve(size / STRIDE + 1);
+
+      size_t count       = 0;
+      size_t until_store = 0;
+      for (size_t i = 0; i < size; i++)
+      {
+        if constexpr (meta::is_any_of<underlying_type, Char8>)
+        {
+          if (begin[i].is_trail())
+            continue;
+        }
+        else
+        {
+          if (begin[i].is_trail_surrogate())
+            continue;
+        }
+        if (until_store == 0)
+        {
+          _checkpoints.push_back(i);
+          until_store = STRIDE;
+        }
+        --until_store;
+        ++count;
+      }
+      _count = count;
+      _built = true;
+    }
+
+  public:
+    /// @brief Constructs an index over 'view' (when allocator is local).
+    /// No checkpoint is computed until the first query.
+    /// @param alloc Reference to the allocator to use
+    /// @param view The view to index
+    constexpr BasicCodePointIndex(const ALLOCATOR& alloc, view_t view) noexcept
+        : _view(view)
+        , _checkpoints(alloc)
+    {
+      if constexpr (IS_FIXED_WIDTH)
+        _count = view.unit_len();
+    }
+
+    /// @brief Constructs an index over 'view' (when allocator is global).
+    /// No checkpoint is computed until the first query.
+    /// @param view The view to index
+    constexpr BasicCodePointIndex(view_t view) noexcept
+      requires(ALLOCATOR::is_global_allocator_ref)
+        : BasicCodePointIndex(ALLOCATOR{}, view)
+    {
+    }
+
+    MAKE_DEFAULT_COPY_AND_MOVE_FOR(BasicCodePointIndex);
+
+    /// @brief Computes the checkpoints if they were not already computed.
+    /// This is done automatically by all the queries.
+    constexpr void build() const noexcept
+    {
+      if constexpr (!IS_FIXED_WIDTH)
+      {
+        if (!_built)
+          build_checkpoints();
+      }
+    }
+
+    /// @brief Check if the checkpoints were computed
+    /// @return True if no query will need to compute the checkpoints
+    constexpr bool is_built() const noexcept { return _built; }
+
+    /// @brief Returns the indexed view
+    /// @return The indexed view
+    constexpr view_t view() const noexcept { return _view; }
+
+    /// @brief Returns the count of code points of the indexed view
+    /// @return The count of code points
+    constexpr size_t size() const noexcept
+    {
+      build();
+      return _count;
+    }
+
+    /// @brief Returns the unit offset of the code point at index 'index'.
+    /// @pre index <= size() (size() returns the unit length of the view)
+    /// @param index The code point index
+    /// @return The unit offset of the code point
+    constexpr size_t offset(size_t index) const noexcept
+    {
+      assert_true("Invalid index!", index <= size());
+      if constexpr (IS_FIXED_WIDTH)
+        return index;
+      else
+      {
+        if (index == _count)
+          return _view.unit_len();
+        const auto start = _view.data() + _checkpoints[index / STRIDE];
+        return uni::iterator_index_front(start, index % STRIDE) - _view.data();
+      }
+    }
+
+    /// @brief Returns the code point index of the code point starting at 'ptr'.
+    /// @pre 'ptr' points to the start of a code point of the view or to its end
+    /// @param ptr The pointer to the start of the code point
+    /// @return The code point index
+    constexpr size_t index_of(const underlying_type* ptr) const noexcept
+    {
+      assert_true(
+          "Pointer is not part of the view!", _view.data() <= ptr,
+          ptr <= _view.data() + _view.unit_len());
+      const size_t unit_offset = ptr - _view.data();
+      if constexpr (IS_FIXED_WIDTH)
+        return unit_offset;
+      else
+      {
+        build();
+        if (_checkpoints.is_empty())
+          return 0;
+        // Last checkpoint that is before 'ptr'
+        const auto it =
+            std::upper_bound(_checkpoints.begin(), _checkpoints.end(), unit_offset)
+            - 1;
+        const auto start = _view.data() + *it;
+        return (it - _checkpoints.begin()) * STRIDE
+               + uni::countlen(start, unit_offset - *it);
+      }
+    }
+
+    /// @brief Returns the code point at index 'index'.
+    /// @pre index < size()
+    /// @param index The index of the code point
+    /// @return The code point at index 'index'
+    constexpr char32_t operator[](size_t index) const noexcept
+    {
+      assert_true("Invalid index!", index < size());
+      return *iterator(index);
+    }
+
+    /// @brief Returns an iterator to the code point at index 'index'.
+    /// @pre index <= size()
+    /// @param index The index of the code point
+    /// @return Iterator to the code point at index 'index'
+    constexpr uni::CodePointIterator<ENCODING> iterator(size_t index) const noexcept
+    {
+      return _view.data() + offset(index);
+    }
+
+    /// @brief Advances an iterator of the view by 'n' code points.
+    /// @pre The resulting code point index is in [0, size()]
+    /// @param it The iterator to advance
+    /// @param n The count of code points to advance by (can be negative)
+    /// @return The advanced iterator
+    constexpr uni::CodePointIterator<ENCODING> advance(
+        uni::CodePointIterator<ENCODING> it, ptrdiff_t n) const noexcept
+    {
+      const size_t index = index_of(it.current());
+      assert_true(
+          "Invalid advance!", implies(n < 0, static_cast<size_t>(-n) <= index));
+      return iterator(index + n);
+    }
+
+    /// @brief Returns a view over 'count' code points starting at 'start'.
+    /// @pre start + count <= size()
+    /// @param start The index of the first code point
+    /// @param count The count of code points
+    /// @return View over the code points
+    constexpr view_t substr(size_t start, size_t count) const noexcept
+    {
+      assert_true("Invalid sub-view!", start + count <= size());
+      const size_t begin = offset(start);
+      return view_t{_view.data() + begin, _view.data() + offset(start + count)};
+    }
+  };
+
+  /// @brief Code point index using the default global allocator
+  /// @tparam ENCODING The encoding of the view
+  /// @tparam STRIDE The count of code points between two checkpoints
+  template<StringEncoding ENCODING, size_t STRIDE = 64>
+  using CodePointIndex =
+      BasicCodePointIndex<ENCODING, decltype(mem::GlobalAllocator), STRIDE>;
+
+  /// @brief Sparse index mapping UTF8 offsets of a view to UTF16 offsets.
+  /// The UTF16 offset of every STRIDE bytes, and the UTF8 offset of every
+  /// STRIDE UTF16 units are stored, so that a conversion (in any direction)
+  /// counts the UTF16 units of at most a few STRIDE bytes, instead of
+  /// all the bytes before the offset.
+  /// The index is built lazily on the first query (which counts the UTF16
+  /// units of the whole view), and is usually built once per line.
+  /// @warning The index does not own the characters of the view.
+  /// @warning The view must be valid UTF8.
+  /// @warning As the index is built lazily, the first query is not
+  ///          thread-safe: call 'build' before sharing the index.
+  /// @tparam ALLOCATOR The allocator used for the checkpoints
+  /// @tparam STRIDE The count of units between two checkpoints
+  template<meta::Allocator ALLOCATOR, size_t STRIDE = 64>
+    requires(STRIDE != 0)
+  class BasicUTF16OffsetIndex
+  {
+  public:
+    /// @brief The view type whose offsets are indexed
+    using view_t = BasicStringView<StringEncoding::UTF8>;
+
+  private:
+    /// @brief A UTF8 offset and its UTF16 offset
+    struct Checkpoint
+    {
+      /// @brief The offset in bytes
+      size_t utf8;
+      /// @brief The offset in UTF16 units
+      size_t utf16;
+    };
+
+    /// @brief The indexed view
+    view_t _view;
+    /// @brief The UTF16 offset of the bytes whose offset is a multiple of STRIDE
+    mutable BasicVector<size_t, ALLOCATOR> _by_utf8;
+    /// @brief The code point containing the UTF16 units whose offset is a
+    ///        multiple of STRIDE
+    mutable BasicVector<Checkpoint, ALLOCATOR> _by_utf16;
+    /// @brief The count of UTF16 units of the view
+    mutable size_t _utf16_len = 0;
+    /// @brief True if the checkpoints were computed
+    mutable bool _built = false;
+
+    /// @brief Computes the checkpoints and the count of UTF16 units
+    constexpr void build_checkpoints() const noexcept
+    {
+      const auto begin = _view.data();
+      const auto size  = _view.unit_len();
+      _by_utf8.reserve(size / STRIDE + 1);
+
+      size_t len = 0;
+      for (size_t i = 0; i < size; i += STRIDE)
+      {
+        _by_utf8.push_back(len);
+        len += uni::utf16_len(begin + i, clt::min(STRIDE, size - i));
+      }
+      _utf16_len = len;
+
+      _by_utf16.reserve(len / STRIDE + 1);
+      size_t block = 0;
+      for (size_t target = 0; target <= len; target += STRIDE)
+      {
+        // Last block starting with at most 'target' UTF16 units before it
+        while (block + 1 < _by_utf8.size() && _by_utf8[block + 1] <= target)
+          ++block;
+        const size_t start = block * STRIDE;
+        const size_t base  = _by_utf8.is_empty() ? 0 : _by_utf8[block];
+        const size_t utf8 =
+            start
+            + uni::utf16_to_utf8_offset(begin + start, size - start, target - base);
+        _by_utf16.push_back(
+            Checkpoint{utf8, base + uni::utf16_len(begin + start, utf8 - start)});
+      }
+      _built = true;
+    }
+
+  public:
+    /// @brief Constructs an index over 'view' (when allocator is local).
+    /// No checkpoint is computed until the first query.
+    /// @param alloc Reference to the allocator to use
+    /// @param view The view to index
+    constexpr BasicUTF16OffsetIndex(const ALLOCATOR& alloc, view_t view) noexcept
+        : _view(view)
+        , _by_utf8(alloc)
+        , _by_utf16(alloc)
+    {
+    }
+
+    /// @brief Constructs an index over 'view' (when allocator is global).
+    /// No checkpoint is computed until the first query.
+    /// @param view The view to index
+    constexpr BasicUTF16OffsetIndex(view_t view) noexcept
+      requires(ALLOCATOR::is_global_allocator_ref)
+        : BasicUTF16OffsetIndex(ALLOCATOR{}, view)
+    {
+    }
+
+    MAKE_DEFAULT_COPY_AND_MOVE_FOR(BasicUTF16OffsetIndex);
+
+    /// @brief Computes the checkpoints if they were not already computed.
+    /// This is done automatically by all the queries.
+    constexpr void build() const noexcept
+    {
+      if (!_built)
+        build_checkpoints();
+    }
+
+    /// @brief Check if the checkpoints were computed
+    /// @return True if no query will need to compute the checkpoints
+    constexpr bool is_built() const noexcept { return _built; }
+
+    /// @brief Returns the indexed view
+    /// @return The indexed view
+    constexpr view_t view() const noexcept { return _view; }
+
+    /// @brief Returns the count of UTF16 units needed to encode the view
+    /// @return The count of UTF16 units
+    constexpr size_t utf16_len() const noexcept
+    {
+      build();
+      return _utf16_len;
+    }
+
+    /// @brief Returns the UTF16 offset of a UTF8 offset.
+    /// @pre utf8_offset <= view().unit_len(), and is the start of a code point
+    /// @param utf8_offset The offset in bytes
+    /// @return The count of UTF16 units before 'utf8_offset'
+    constexpr size_t utf16_offset(size_t utf8_offset) const noexcept
+    {
+      assert_true("Invalid offset!", utf8_offset <= _view.unit_len());
+      build();
+      if (utf8_offset == _view.unit_len())
+        return _utf16_len;
+      const size_t block = utf8_offset / STRIDE;
+      return _by_utf8[block]
+             + uni::utf16_len(_view.data() + block * STRIDE, utf8_offset % STRIDE);
+    }
+
+    /// @brief Returns the UTF8 offset of a UTF16 offset.
+    /// If 'utf16_offset' is in the middle of a surrogate pair, the offset of
+    /// the code point encoded by the pair is returned.
+    /// @param utf16_offset The offset in UTF16 units
+    /// @return The offset in bytes of the code point (or the unit length of
+    ///         the view if 'utf16_offset' is not less than utf16_len())
+    constexpr size_t utf8_offset(size_t utf16_offset) const noexcept
+    {
+      build();
+      if (utf16_offset >= _utf16_len)
+        return _view.unit_len();
+      const auto& checkpoint = _by_utf16[utf16_offset / STRIDE];
+      return checkpoint.utf8
+             + uni::utf16_to_utf8_offset(
+                 _view.data() + checkpoint.utf8,
+                 _view.unit_len() - checkpoint.utf8,
+                 utf16_offset - checkpoint.utf16);
+    }
+  };
+
+  /// @brief UTF16 offset index using the default global allocator
+  /// @tparam STRIDE The count of units between two checkpoints
+  template<size_t STRIDE = 64>
+  using UTF16OffsetIndex =
+      BasicUTF16OffsetIndex<decltype(mem::GlobalAllocator), STRIDE>;
+} // namespace clt
+
+#endif // !HG_DSA_STRING_INDEX
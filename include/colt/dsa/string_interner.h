@@ -0,0 +1,321 @@
+/*****************************************************************/ /**
+ * @file   string_interner.h
+ * @brief  Contains StringInterner, which deduplicates strings and
+ * represents each of them by a compact handle.
+ * Handles compare and hash in O(1): they are meant to replace the
+ * strings (such as identifiers) in the data structures of a program.
+ * The characters are stored in append-only arenas, and the interner
+ * is sharded so that multiple threads can intern concurrently.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_STRING_INTERNER
+#define HG_COLT_STRING_INTERNER
+
+#include <bit>
+#include <mutex>
+#include <cstring>
+#include <colt/hash.h>
+#include <colt/dsa/option.h>
+#include <colt/dsa/flat_map.h>
+#include <colt/dsa/string_view.h>
+#include <colt/mem/arena_alloc.h>
+
+namespace clt
+{
+  /// @brief Handle to a string interned in a StringInterner.
+  /// Two handles obtained from the same interner are equal if and
+  /// only if the strings they represent are equal.
+  struct StringHandle
+  {
+    /// @brief The shard (low bits) and index in that shard (high bits)
+    u32 value;
+
+    /// @brief Compares two handles (in O(1))
+    /// @param other The other handle
+    /// @return True if both represent the same string
+    constexpr bool operator==(const StringHandle& other) const noexcept = default;
+  };
+
+  namespace meta
+  {
+    /// @brief StringHandle is hashed as its value
+    template<>
+    struct is_contiguously_hashable<StringHandle> : public std::true_type
+    {
+    };
+
+    /// @brief UINT32_MAX is never a StringHandle: the last index of a shard
+    /// is never used. Option<StringHandle> is then the same size as a handle.
+    template<>
+    struct niche<StringHandle>
+    {
+      /// @brief The handle UINT32_MAX
+      static constexpr size_t count = 1;
+
+      /// @brief Returns the niche
+      /// @return The handle UINT32_MAX
+      static constexpr StringHandle make(size_t) noexcept { return {UINT32_MAX}; }
+
+      /// @brief Returns the index of the niche 'handle'
+      /// @param handle The handle
+      /// @return 0 if 'handle' is the niche, else 1
+      static constexpr size_t index_of(const StringHandle& handle) noexcept
+      {
+        return handle.value == UINT32_MAX ? 0 : 1;
+      }
+    };
+  } // namespace meta
+
+  template<
+      StringEncoding ENCODING, u32 SHARD_COUNT = 16,
+      meta::Allocator Backing        = mem::Mallocator,
+      meta::hash_algorithm HASH_ALGO = COLT_DEFAULT_HASH_ALGORITHM>
+    requires(std::has_single_bit(SHARD_COUNT)) && (SHARD_COUNT <= 256)
+            && std::is_default_constructible_v<Backing>
+  /// @brief Deduplicates strings, returning a StringHandle for each one.
+  /// The strings are hashed once (without any lock held) and the hash
+  /// selects one of the SHARD_COUNT shards. Each shard owns a mutex,
+  /// a FlatSet mapping strings to handles, an arena storing the characters
+  /// (followed by a NUL-terminator) and a table of the interned strings.
+  /// The characters are never moved: views obtained through 'lookup' are
+  /// valid as long as the interner is alive.
+  /// 'lookup' does not lock: the handle must have been obtained by the
+  /// current thread or transferred to it through proper synchronization.
+  /// @tparam ENCODING The encoding of the strings
+  /// @tparam SHARD_COUNT The count of shards (1 for single threaded use)
+  /// @tparam Backing The allocator from which the memory is obtained
+  /// @tparam HASH_ALGO The hashing algorithm
+  class StringInterner
+  {
+    /// @brief The character type
+    using char_t = meta::encoding_to_char_t<ENCODING>;
+    /// @brief The view type
+    using view_t = BasicStringView<ENCODING>;
+
+    /// @brief The count of bits of a handle used to store the shard
+    static constexpr u32 SHARD_BITS = std::countr_zero(SHARD_COUNT);
+    /// @brief The count of strings in the first segment of a table
+    static constexpr u32 FIRST_SEGMENT = 256;
+    /// @brief log2(FIRST_SEGMENT)
+    static constexpr u32 FIRST_SEGMENT_BITS = std::countr_zero(FIRST_SEGMENT);
+    /// @brief The maximum count of segments of a table
+    static constexpr u32 MAX_SEGMENTS = 33 - FIRST_SEGMENT_BITS - SHARD_BITS;
+    /// @brief The maximum count of strings in a shard
+    static constexpr u64 MAX_PER_SHARD = (u64)1 << (32 - SHARD_BITS);
+
+    /// @brief An interned string, as stored in the set of a shard
+    struct Entry
+    {
+      /// @brief The interned string
+      view_t str;
+      /// @brief The hash of 'str'
+      u64 hash;
+      /// @brief The handle of 'str'
+      StringHandle handle;
+    };
+
+    /// @brief Returns the precomputed hash of an entry
+    struct EntryHash
+    {
+      /// @brief Returns the hash of an entry
+      /// @param entry The entry
+      /// @return entry.hash
+      constexpr u64 operator()(const Entry& entry) const noexcept
+      {
+        return entry.hash;
+      }
+    };
+
+    /// @brief Compares the strings of entries (ignoring their handles)
+    struct EntryEqual
+    {
+      /// @brief Check if two entries represent the same string
+      /// @param a The first entry
+      /// @param b The second entry
+      /// @return True if the strings are equal
+      constexpr bool operator()(const Entry& a, const Entry& b) const noexcept
+      {
+        return a.hash == b.hash && a.str.unit_len() == b.str.unit_len()
+               && std::memcmp(
+                      a.str.data(), b.str.data(),
+                      a.str.unit_len() * sizeof(char_t))
+                      == 0;
+      }
+    };
+
+    /// @brief A shard (aligned to avoid false sharing between shards)
+    struct alignas(64) Shard
+    {
+      /// @brief Protects all the members of the shard
+      mutable std::mutex mtx{};
+      /// @brief The set of interned strings
+      BasicFlatSet<Entry, Backing, EntryHash, EntryEqual> set{Backing{}};
+      /// @brief The storage of the characters
+      mem::ArenaAllocator<Backing, 64 * 1024, alignof(char_t)> chars{};
+      /// @brief The interned strings, by index. Segment 'i' can hold
+      /// FIRST_SEGMENT << i strings: segments never move.
+      view_t* segments[MAX_SEGMENTS] = {};
+      /// @brief The count of interned strings
+      u32 count = 0;
+    };
+
+    /// @brief The shards
+    Shard shards[SHARD_COUNT];
+
+    /// @brief Returns the segment and offset at which an index is stored
+    /// @param index The index in the shard
+    /// @return Pair of segment and offset in that segment
+    static constexpr std::pair<u32, u32> locate(u32 index) noexcept
+    {
+      const u64 i     = (u64)index + FIRST_SEGMENT;
+      const u32 bit   = static_cast<u32>(std::bit_width(i)) - 1;
+      const u64 first = (u64)1 << bit;
+      return {bit - FIRST_SEGMENT_BITS, static_cast<u32>(i - first)};
+    }
+
+    /// @brief Hashes a string
+    /// @param str The string
+    /// @return The hash of the units of the string
+    static u64 hash_of(view_t str) noexcept
+    {
+      HASH_ALGO h;
+      h(str.data(), str.unit_len() * sizeof(char_t));
+      return static_cast<u64>(static_cast<typename HASH_ALGO::result_type>(h));
+    }
+
+    /// @brief Returns the shard of a string
+    /// @param hash The hash of the string
+    /// @return The index of the shard
+    static constexpr u32 shard_of(u64 hash) noexcept
+    {
+      // The low bits of the hash are used by the FlatSet
+      if constexpr (SHARD_BITS == 0)
+        return 0;
+      else
+        return static_cast<u32>(hash >> (64 - SHARD_BITS));
+    }
+
+    /// @brief Copies a string to a shard and registers it.
+    /// The mutex of the shard must be locked.
+    /// @param shard The shard
+    /// @param index The index of the shard
+    /// @param str The string (not in the shard)
+    /// @param hash The hash of the string
+    /// @return The handle of the string
+    static StringHandle push(Shard& shard, u32 index, view_t str, u64 hash) noexcept
+    {
+      assert_true(
+          "Too many strings were interned!", shard.count < MAX_PER_SHARD - 1);
+      auto [segment, offset] = locate(shard.count);
+      if (shard.segments[segment] == nullptr)
+      {
+        auto blk = Backing{}.alloc(sizeof(view_t) * ((u64)FIRST_SEGMENT << segment));
+        assert_true("Could not allocate memory!", !blk.is_null());
+        shard.segments[segment] = static_cast<view_t*>(blk.ptr());
+      }
+      auto blk = shard.chars.alloc((str.unit_len() + 1) * sizeof(char_t));
+      assert_true("Could not allocate memory!", !blk.is_null());
+      auto ptr = static_cast<char_t*>(blk.ptr());
+      if (!str.is_empty())
+        std::memcpy(ptr, str.data(), str.unit_len() * sizeof(char_t));
+      ptr[str.unit_len()] = char_t{};
+
+      const auto copy   = view_t{ptr, str.unit_len()};
+      const auto handle = StringHandle{(shard.count << SHARD_BITS) | index};
+      new (shard.segments[segment] + offset) view_t(copy);
+      shard.set.insert(Entry{copy, hash, handle});
+      ++shard.count;
+      return handle;
+    }
+
+  public:
+    /// @brief The type of the handles
+    using handle_t = StringHandle;
+
+    StringInterner() noexcept             = default;
+    StringInterner(const StringInterner&) = delete;
+    StringInterner(StringInterner&&)      = delete;
+
+    /// @brief Interns a string.
+    /// This function is thread safe.
+    /// @param str The string to intern
+    /// @return The handle of the string (the same for equal strings)
+    StringHandle intern(view_t str) noexcept
+    {
+      const u64 hash    = hash_of(str);
+      const u32 index   = shard_of(hash);
+      auto& shard       = shards[index];
+      const Entry probe = {str, hash, {0}};
+
+      auto lock = std::scoped_lock{shard.mtx};
+      if (auto it = shard.set.find(probe); it != shard.set.end())
+        return it->handle;
+      return push(shard, index, str, hash);
+    }
+
+    /// @brief Returns the handle of a string if it was already interned.
+    /// This function is thread safe.
+    /// @param str The string to search for
+    /// @return The handle of the string or None
+    Option<StringHandle> find(view_t str) const noexcept
+    {
+      const u64 hash    = hash_of(str);
+      auto& shard       = shards[shard_of(hash)];
+      const Entry probe = {str, hash, {0}};
+
+      auto lock = std::scoped_lock{shard.mtx};
+      if (auto it = shard.set.find(probe); it != shard.set.end())
+        return it->handle;
+      return None;
+    }
+
+    /// @brief Returns the string represented by a handle.
+    /// This function does not lock (see the class documentation).
+    /// @param handle The handle (obtained from the current interner)
+    /// @return The interned string, NUL-terminated
+    BasicZStringView<ENCODING> lookup(StringHandle handle) const noexcept
+    {
+      const auto& shard      = shards[handle.value & (SHARD_COUNT - 1)];
+      auto [segment, offset] = locate(handle.value >> SHARD_BITS);
+      assert_true(
+          "Invalid handle!", segment < MAX_SEGMENTS,
+          shard.segments[segment] != nullptr);
+      const view_t str = shard.segments[segment][offset];
+      return {str.data(), str.unit_len()};
+    }
+
+    /// @brief Returns the count of interned strings.
+    /// This function is thread safe.
+    /// @return The count of interned strings
+    size_t size() const noexcept
+    {
+      size_t size = 0;
+      for (auto& shard : shards)
+      {
+        auto lock = std::scoped_lock{shard.mtx};
+        size += shard.count;
+      }
+      return size;
+    }
+
+    /// @brief Frees the tables of all the shards
+    ~StringInterner() noexcept
+    {
+      for (auto& shard : shards)
+      {
+        for (u32 i = 0; i < MAX_SEGMENTS; i++)
+        {
+          if (shard.segments[i] == nullptr)
+            continue;
+          Backing{}.dealloc(
+              {static_cast<void*>(shard.segments[i]),
+               sizeof(view_t) * ((u64)FIRST_SEGMENT << i)});
+        }
+      }
+    }
+  };
+} // namespace clt
+
+#endif // !HG_COLT_STRING_INTERNER
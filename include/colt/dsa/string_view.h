@@ -9,10 +9,14 @@
 #ifndef HG_DSA_STRING_VIEW
 #define HG_DSA_STRING_VIEW
 
+#include <bit>
+#include <algorithm>
 #include <zpp_bits.h>
 
 #include <colt/unicode/unicode.h>
 #include <colt/algo/iterator.h>
+#include <colt/dsa/expect.h>
+#include <colt/hash.h>
 
 namespace clt
 {
@@ -135,22 +139,246 @@ namespace clt
 
     MAKE_DEFAULT_COPY_AND_MOVE_FOR(BasicStringView);
 
+    /// @brief Constructs a view from untrusted units, validating the encoding.
+    /// The validation also computes the code point count, which avoids
+    /// a second counting pass.
+    /// @param ptr The start of the units
+    /// @param size The unit count
+    /// @return The view and its LenInfo, or INVALID_INPUT
+    static constexpr Expect<std::pair<BasicStringView, uni::LenInfo>, uni::ConvError>
+        from_validated(const underlying_type* ptr, size_t size) noexcept
+      requires(!ZSTRING)
+    {
+      auto len = uni::validate(ptr, size);
+      if (len.is_none())
+        return {Error, uni::ConvError::INVALID_INPUT};
+      return std::pair{BasicStringView{ptr, size}, *len};
+    }
+
+    /// @brief Constructs a view from untrusted bytes (as returned by
+    /// ViewOfFile::view), validating the encoding.
+    /// The validation also computes the code point count, which avoids
+    /// a second counting pass.
+    /// @pre The bytes must be aligned for 'underlying_type'
+    /// @param bytes The bytes
+    /// @return The view and its LenInfo, or INVALID_INPUT if the
+    ///         encoding is invalid or the byte count is not a multiple
+    ///         of the unit size
+    static Expect<std::pair<BasicStringView, uni::LenInfo>, uni::ConvError>
+        from_validated(View<u8> bytes) noexcept
+      requires(!ZSTRING)
+    {
+      assert_true(
+          "Unaligned bytes!",
+          reinterpret_cast<uintptr_t>(bytes.data()) % alignof(underlying_type) == 0);
+      if (bytes.size() % sizeof(underlying_type) != 0)
+        return {Error, uni::ConvError::INVALID_INPUT};
+      return from_validated(
+          ptr_to<const underlying_type*>(bytes.data()),
+          bytes.size() / sizeof(underlying_type));
+    }
+
     /// @brief Returned by find when not found
     static constexpr size_t npos = (size_t)-1;
 
+    /// @brief Searches for the first occurrence of a code point.
+    /// The code point is encoded to the encoding of the view, which
+    /// allows searching units (rather than decoding each code point).
+    /// @param chr The code point to search for
+    /// @param starting_offset The unit offset from which to start searching
+    /// @return The unit offset of the code point or npos if not found
     constexpr size_t find(char32_t chr, size_t starting_offset = 0) const noexcept
     {
-      auto _begin = uni::CodePointIterator<ENCODING>(_ptr + clt::min(starting_offset, unit_len()));
-      auto _end = uni::CodePointIterator<ENCODING>(_ptr + unit_len());
+      underlying_type needle[underlying_max_sequence()];
+      const size_t count = encode_needle(chr, needle);
+      if (count == 0)
+        return npos;
+      return find_units(needle, count, starting_offset);
+    }
+
+    /// @brief Searches for the first occurrence of a sub-view.
+    /// @tparam ZSTRING2 True if the sub-view is NUL-terminated
+    /// @param strv The view to search for
+    /// @param starting_offset The unit offset from which to start searching
+    /// @return The unit offset of the sub-view or npos if not found
+    template<bool ZSTRING2>
+    constexpr size_t find(
+        const BasicStringView<ENCODING, ZSTRING2>& strv,
+        size_t starting_offset = 0) const noexcept
+    {
+      return find_units(strv.data(), strv.unit_len(), starting_offset);
+    }
+
+    /// @brief Searches for the first occurrence of any of the code points.
+    /// For ASCII and UTF8 views, if all the code points are ASCII,
+    /// the search is performed using SIMD instructions.
+    /// @param chrs The code points to search for
+    /// @param starting_offset The unit offset from which to start searching
+    /// @return The unit offset of the first code point found or npos if not found
+    constexpr size_t find_any(
+        View<char32_t> chrs, size_t starting_offset = 0) const noexcept
+    {
+      if (chrs.size() == 1)
+        return find(chrs[0], starting_offset);
+      if (starting_offset >= unit_len() || chrs.empty())
+        return npos;
+
+      if constexpr (meta::is_any_of<underlying_type, char, Char8>)
+      {
+        // ASCII bytes never appear in a multi-byte UTF8 sequence,
+        // so we can search the bytes directly.
+        if (!std::is_constant_evaluated()
+            && chrs.size() <= uni::details::FIND_ANY_MAX
+            && std::all_of(
+                chrs.begin(), chrs.end(), [](char32_t c) { return c < 0x80; }))
+        {
+          char8_t units[uni::details::FIND_ANY_MAX];
+          for (size_t i = 0; i < chrs.size(); i++)
+            units[i] = static_cast<char8_t>(chrs[i]);
+          auto begin = ptr_to<const char8_t*>(_ptr + starting_offset);
+          auto end   = ptr_to<const char8_t*>(_ptr + unit_len());
+          auto found = uni::details::find_any8(begin, end, units, chrs.size());
+          if (found == end)
+            return npos;
+          return static_cast<size_t>(found - begin) + starting_offset;
+        }
+      }
+
+      auto _begin = uni::CodePointIterator<ENCODING>(_ptr + starting_offset);
+      auto _end   = uni::CodePointIterator<ENCODING>(_ptr + unit_len());
       while (_begin != _end)
       {
-        if (*_begin == chr)
+        if (std::find(chrs.begin(), chrs.end(), *_begin) != chrs.end())
           return _begin.current() - _ptr;
-        _begin++;
+        ++_begin;
       }
       return npos;
     }
 
+  private:
+    /// @brief Returns the maximum count of units forming a code point
+    /// @return The maximum count of units forming a code point
+    static consteval size_t underlying_max_sequence() noexcept
+    {
+      if constexpr (std::same_as<underlying_type, char>)
+        return 1;
+      else
+        return underlying_type::max_sequence;
+    }
+
+    /// @brief Encodes a code point to the encoding of the view.
+    /// @param chr The code point to encode
+    /// @param result The array in which to write the units
+    /// @return The number of units written or 0 if 'chr' cannot be represented
+    static constexpr size_t encode_needle(
+        char32_t chr, underlying_type (&result)[underlying_max_sequence()]) noexcept
+    {
+      if (chr > uni::CODE_POINT_MAX)
+        return 0;
+      if constexpr (std::same_as<underlying_type, char>)
+      {
+        if (chr > 0x7F)
+          return 0;
+        result[0] = static_cast<char>(chr);
+        return 1;
+      }
+      else if constexpr (std::same_as<underlying_type, Char8>)
+      {
+        char8_t buffer[Char8::max_sequence];
+        const Char32 from[1] = {chr};
+        const Char32* from_ptr = from;
+        char8_t* result_ptr    = buffer;
+        if (uni::to_utf8(from_ptr, 1, result_ptr, Char8::max_sequence)
+            != uni::ConvError::NO_ERROR)
+          return 0;
+        for (char8_t* ptr = buffer; ptr != result_ptr; ++ptr)
+          result[ptr - buffer] = *ptr;
+        return result_ptr - buffer;
+      }
+      else if constexpr (meta::is_any_of<underlying_type, Char16BE, Char16LE>)
+      {
+        char16_t buffer[2];
+        auto end = uni::unsafe_utf32to16(chr, buffer);
+        for (char16_t* ptr = buffer; ptr != end; ++ptr)
+          result[ptr - buffer] = underlying_type{*ptr};
+        return end - buffer;
+      }
+      else
+      {
+        result[0] = underlying_type{chr};
+        return 1;
+      }
+    }
+
+    /// @brief Searches for the first unit equal to 'unit' in [begin, end).
+    /// @param begin The start of the range
+    /// @param end The end of the range
+    /// @param unit The unit to search for
+    /// @return Pointer to the unit or 'end' if not found
+    static constexpr const underlying_type* find_unit(
+        const underlying_type* begin, const underlying_type* end,
+        underlying_type unit) noexcept
+    {
+      if (std::is_constant_evaluated())
+      {
+        while (begin != end && *begin != unit)
+          ++begin;
+        return begin;
+      }
+      // The units are compared in their storage endianness
+      if constexpr (sizeof(underlying_type) == sizeof(char8_t))
+        return ptr_to<const underlying_type*>(uni::details::find8(
+            ptr_to<const char8_t*>(begin), ptr_to<const char8_t*>(end),
+            std::bit_cast<char8_t>(unit)));
+      else if constexpr (sizeof(underlying_type) == sizeof(char16_t))
+        return ptr_to<const underlying_type*>(uni::details::find16(
+            ptr_to<const char16_t*>(begin), ptr_to<const char16_t*>(end),
+            unit.in_endian()));
+      else
+        return ptr_to<const underlying_type*>(uni::details::find32(
+            ptr_to<const char32_t*>(begin), ptr_to<const char32_t*>(end),
+            unit.in_endian()));
+    }
+
+    /// @brief Searches for the first occurrence of a sequence of units.
+    /// @param needle The units to search for
+    /// @param count The number of units to search for
+    /// @param starting_offset The unit offset from which to start searching
+    /// @return The unit offset of the sequence or npos if not found
+    constexpr size_t find_units(
+        const underlying_type* needle, size_t count,
+        size_t starting_offset) const noexcept
+    {
+      if (count == 0)
+        return starting_offset <= unit_len() ? starting_offset : npos;
+      if (count > unit_len() || starting_offset > unit_len() - count)
+        return npos;
+
+      auto current = _ptr + starting_offset;
+      // The last position (exclusive) at which 'needle' can start
+      const auto last = _ptr + (unit_len() - count) + 1;
+      while (current != last)
+      {
+        // Search for the first unit, then compare the rest
+        current = find_unit(current, last, needle[0]);
+        if (current == last)
+          return npos;
+        if (std::is_constant_evaluated())
+        {
+          if (std::equal(needle + 1, needle + count, current + 1))
+            return current - _ptr;
+        }
+        else if (
+            std::memcmp(
+                current + 1, needle + 1, (count - 1) * sizeof(underlying_type))
+            == 0)
+          return current - _ptr;
+        ++current;
+      }
+      return npos;
+    }
+
+  public:
     /// @brief Returns an iterator to the start of the view
     /// @return Iterator to the start of the view
     constexpr uni::CodePointIterator<ENCODING> begin() const noexcept
@@ -414,6 +642,19 @@ namespace clt
           v1.begin(), v1.end(), v2.begin(), v2.end());
     }
 
+    /// @brief Hashes the units of a view.
+    /// This is usable in constant evaluation (see 'hash_units'): a view
+    /// has the same hash at compile-time and at runtime.
+    /// @tparam Algo The hashing algorithm
+    /// @param algo The hashing algorithm object
+    /// @param str The view to hash
+    template<meta::hash_algorithm Algo>
+    friend constexpr void hash_append(
+        Algo& algo, const BasicStringView& str) noexcept
+    {
+      hash_units(algo, str.data(), str.unit_len());
+    }
+
     /// @brief Serializes a view
     /// @tparam Ser The archive type
     /// @param archive The archive
@@ -460,6 +701,19 @@ namespace clt
     return {std::array<T, SIZE>::data(), SIZE - 1};
   }
 
+  /// @brief Hashes the units of a literal (without its NUL-terminator).
+  /// The result is the same as hashing the view of the literal.
+  /// @tparam Algo The hashing algorithm
+  /// @tparam T The code unit type
+  /// @tparam SIZE The size of the literal in code units
+  /// @param algo The hashing algorithm object
+  /// @param str The literal to hash
+  template<meta::hash_algorithm Algo, meta::CharType T, size_t SIZE>
+  constexpr void hash_append(Algo& algo, const UnicodeLiteral<T, SIZE>& str) noexcept
+  {
+    hash_units(algo, str.data(), SIZE - 1);
+  }
+
   /// @brief Represents a NUL-terminated StringView
   /// @tparam ENCODING The encoding of the StringView
   template<StringEncoding ENCODING>
@@ -8,28 +8,116 @@
 #ifndef HG_COLT_TRIE
 #define HG_COLT_TRIE
 
+#include <string>
+#include <utility>
 #include <tsl/htrie_map.h>
 #include <tsl/htrie_set.h>
 #include <colt/hash.h>
+#include <colt/dsa/option.h>
+#include <colt/dsa/string_view.h>
 
 namespace clt
 {
-  /// @brief TrieSet
+  /// @brief TrieSet.
+  /// Contrary to Set, no allocator can be specified: tsl::htrie_set
+  /// does not support custom allocators.
   /// @tparam T The value to store
   /// @tparam HASH The hasher object
-  template<typename T, typename HASH = clt::uhash<clt::murmur64a_h>>
+  template<typename T, typename HASH = clt::default_hash>
   class TrieSet : public tsl::htrie_set<T, HASH, u32>
   {
   };
 
-  /// @brief TrieMap
+  /// @brief TrieMap.
+  /// Contrary to Map, no allocator can be specified: tsl::htrie_map
+  /// does not support custom allocators.
   /// @tparam Key The key type
   /// @tparam Value The value type
   /// @tparam HASH The hasher object
-  template<
-      typename Key, typename Value, typename HASH = clt::uhash<clt::murmur64a_h>>
+  template<typename Key, typename Value, typename HASH = clt::default_hash>
   class TrieMap : public tsl::htrie_map<Key, Value, HASH, u32>
   {
+    /// @brief The tsl map
+    using base_t = tsl::htrie_map<Key, Value, HASH, u32>;
+
+    template<typename It>
+    /// @brief Returns the count of units of the key of an iterator.
+    /// The key is written to a buffer that is reused by all the calls
+    /// of the thread, rather than to a new string.
+    /// @param it The iterator (which must not be the end)
+    /// @return The count of units of the key
+    static size_t key_len(const It& it)
+    {
+      thread_local std::basic_string<Key> buffer;
+      it.key(buffer);
+      return buffer.size();
+    }
+
+  public:
+    /// @brief The iterator type
+    using iterator = typename base_t::iterator;
+    /// @brief The const iterator type
+    using const_iterator = typename base_t::const_iterator;
+
+    /// @brief Searches for the longest key that is a prefix of a string.
+    /// Contrary to 'longest_prefix_ks', the length of the key is returned.
+    /// For tables known at compile-time, prefer meta::token_table.
+    /// @param str The string
+    /// @param size The count of units of the string
+    /// @return None if no key is a prefix of 'str', else the key and its
+    ///         count of units
+    Option<std::pair<iterator, size_t>> longest_match(
+        const Key* str, size_t size)
+    {
+      auto it = base_t::longest_prefix_ks(str, size);
+      if (it == base_t::end())
+        return None;
+      const size_t len = key_len(it);
+      return std::pair{it, len};
+    }
+
+    /// @brief Searches for the longest key that is a prefix of a string.
+    /// Contrary to 'longest_prefix_ks', the length of the key is returned.
+    /// For tables known at compile-time, prefer meta::token_table.
+    /// @param str The string
+    /// @param size The count of units of the string
+    /// @return None if no key is a prefix of 'str', else the key and its
+    ///         count of units
+    Option<std::pair<const_iterator, size_t>> longest_match(
+        const Key* str, size_t size) const
+    {
+      auto it = base_t::longest_prefix_ks(str, size);
+      if (it == base_t::cend())
+        return None;
+      const size_t len = key_len(it);
+      return std::pair{it, len};
+    }
+
+    /// @brief Searches for the longest key that is a prefix of a view
+    /// @tparam ENCODING The encoding of the view (whose units are Key)
+    /// @tparam ZSTRING If the view is NUL-terminated
+    /// @param str The view
+    /// @return None if no key is a prefix of 'str', else the key and its
+    ///         count of units
+    template<StringEncoding ENCODING, bool ZSTRING>
+      requires std::same_as<meta::encoding_to_char_t<ENCODING>, Key>
+    auto longest_match(BasicStringView<ENCODING, ZSTRING> str)
+    {
+      return longest_match(str.data(), str.unit_len());
+    }
+
+    /// @brief Searches for the longest key that is a prefix of a view
+    /// @tparam ENCODING The encoding of the view (whose units are Key)
+    /// @tparam ZSTRING If the view is NUL-terminated
+    /// @param str The view
+    /// @return None if no key is a prefix of 'str', else the key and its
+    ///         count of units
+    template<StringEncoding ENCODING, bool ZSTRING>
+      requires std::same_as<meta::encoding_to_char_t<ENCODING>, Key>
+    auto longest_match(BasicStringView<ENCODING, ZSTRING> str) const
+    {
+      return longest_match(str.data(), str.unit_len());
+    }
   };
 } // namespace clt
 
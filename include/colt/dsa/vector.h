@@ -4,12 +4,74 @@
 #include <colt/dsa/common.h>
 #include <colt/mem/allocator_ref.h>
 
+namespace clt::meta
+{
+  template<typename T>
+  /// @brief A growth policy computes the new capacity of a growing container
+  concept GrowthPolicy =
+      requires(size_t capacity, size_t required, size_t obj_size) {
+        {
+          T::grow(capacity, required, obj_size)
+        } -> std::same_as<size_t>;
+      };
+} // namespace clt::meta
+
 namespace clt
 {
+  template<size_t NUM, size_t DEN, size_t MIN = 16>
+    requires(NUM > DEN) && (DEN != 0) && (MIN != 0)
+  /// @brief Growth policy that multiplies the capacity by NUM / DEN
+  /// @tparam NUM The numerator of the growth factor
+  /// @tparam DEN The denominator of the growth factor
+  /// @tparam MIN The minimum count of objects to grow by
+  struct GeometricGrowth
+  {
+    /// @brief Computes the new capacity of a container
+    /// @param capacity The current capacity (in objects)
+    /// @param required The minimum capacity required (in objects)
+    /// @param  The size of an object
+    /// @return The new capacity (>= required)
+    static constexpr size_t grow(size_t capacity, size_t required, size_t) noexcept
+    {
+      const size_t by = capacity / DEN * (NUM - DEN);
+      return clt::max(required, capacity + clt::max(by, MIN));
+    }
+  };
+
+  template<size_t PAGE_SIZE = 4096, size_t NUM = 2, size_t DEN = 1>
+    requires(std::has_single_bit(PAGE_SIZE))
+  /// @brief Geometric growth policy for big containers, that rounds the size
+  /// of the allocation up to a multiple of PAGE_SIZE, so that no memory is
+  /// wasted at the end of the last page.
+  /// @tparam PAGE_SIZE The size of a page
+  /// @tparam NUM The numerator of the growth factor
+  /// @tparam DEN The denominator of the growth factor
+  struct PageRoundedGrowth
+  {
+    /// @brief Computes the new capacity of a container
+    /// @param capacity The current capacity (in objects)
+    /// @param required The minimum capacity required (in objects)
+    /// @param obj_size The size of an object
+    /// @return The new capacity (>= required)
+    static constexpr size_t grow(
+        size_t capacity, size_t required, size_t obj_size) noexcept
+    {
+      const size_t count = GeometricGrowth<NUM, DEN, 1>::grow(capacity, required, 0);
+      const size_t bytes = (count * obj_size + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+      return bytes / obj_size;
+    }
+  };
+
+  /// @brief Growth policy used by default (doubles the capacity)
+  using DefaultGrowth = GeometricGrowth<2, 1>;
 
-  template<typename T, meta::Allocator ALLOCATOR>
+  template<
+      typename T, meta::Allocator ALLOCATOR,
+      meta::GrowthPolicy GROWTH = DefaultGrowth>
   /// @brief Dynamic size array, that can make use of a local allocator
   /// @tparam T The type stored in the Vector
+  /// @tparam ALLOCATOR The allocator
+  /// @tparam GROWTH The growth policy used when the Vector is full
   class BasicVector
     : private ALLOCATOR
   {
@@ -20,12 +82,49 @@ namespace clt
     /// @brief Count of active objects in the block
     size_t blk_size = 0;
 
-    constexpr void reserve_obj(size_t plus_capacity) noexcept(
+    /// @brief Check if objects can be moved using 'memcpy'
+    static constexpr bool is_trivially_relocatable =
+        std::is_trivially_move_constructible_v<T>
+        && std::is_trivially_destructible_v<T>;
+
+    /// @brief Grows the block without moving the objects if possible.
+    /// The allocator is asked to expand the block in place, then (for
+    /// trivially relocatable objects) to reallocate it.
+    /// @param new_size The new size in bytes of the block
+    /// @return True if the block was grown
+    constexpr bool grow_in_place(size_t new_size) noexcept
+    {
+      if (blk_ptr == nullptr || std::is_constant_evaluated())
+        return false;
+      mem::MemBlock blk = {blk_ptr, blk_capacity * sizeof(T)};
+      if constexpr (meta::ExpandingAllocator<ALLOCATOR>)
+      {
+        if (ALLOCATOR::expand(blk, new_size))
+        {
+          blk_capacity = blk.size() / sizeof(T);
+          return true;
+        }
+      }
+      if constexpr (
+          meta::ReallocatableAllocator<ALLOCATOR> && is_trivially_relocatable)
+      {
+        if (ALLOCATOR::realloc(blk, new_size))
+        {
+          blk_ptr      = static_cast<T*>(blk.ptr());
+          blk_capacity = blk.size() / sizeof(T);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /// @brief Moves the objects to a new block of 'capacity' objects
+    /// @param capacity The new capacity (>= size())
+    constexpr void relocate(size_t capacity) noexcept(
         std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
     {
-      if (plus_capacity == 0)
-        return;
-      auto new_blk = ALLOCATOR::alloc((blk_capacity + plus_capacity) * sizeof(T));
+      auto new_blk =
+          capacity == 0 ? mem::nullblk : ALLOCATOR::alloc(capacity * sizeof(T));
       //register freeing the memory to avoid leaks in case of exceptions
       ON_SCOPE_EXIT
       {
@@ -39,6 +138,26 @@ namespace clt
           blk_ptr, static_cast<T*>(new_blk.ptr()), blk_size);
     }
 
+    constexpr void reserve_obj(size_t plus_capacity) noexcept(
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+    {
+      if (plus_capacity == 0)
+        return;
+      if (grow_in_place((blk_capacity + plus_capacity) * sizeof(T)))
+        return;
+      relocate(blk_capacity + plus_capacity);
+    }
+
+    /// @brief Grows the Vector (using GROWTH) if it cannot hold 'required' objects
+    /// @param required The count of objects the Vector must be able to hold
+    constexpr void grow_for(size_t required) noexcept(
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+    {
+      if (required <= blk_capacity)
+        return;
+      reserve_obj(GROWTH::grow(blk_capacity, required, sizeof(T)) - blk_capacity);
+    }
+
   public:
     /// @brief The value type stored in the list
     using value_type = T;
@@ -227,13 +346,65 @@ namespace clt
       reserve_obj(by_more);
     }
 
+    /// @brief Ensures that 'additional' objects can be pushed without growing.
+    /// Contrary to the growth that happens on insertion, the Vector is not
+    /// grown more than necessary.
+    /// @param additional The count of objects to be able to push
+    constexpr void reserve_exact(size_t additional) noexcept(
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+    {
+      if (blk_size + additional > blk_capacity)
+        reserve_obj(blk_size + additional - blk_capacity);
+    }
+
+    /// @brief Reduces the capacity of the Vector to its size.
+    /// If the Vector is empty, its memory is freed.
+    constexpr void shrink_to_fit() noexcept(
+        std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>)
+    {
+      if (blk_size == blk_capacity)
+        return;
+      if constexpr (
+          meta::ReallocatableAllocator<ALLOCATOR> && is_trivially_relocatable)
+      {
+        mem::MemBlock blk = {blk_ptr, blk_capacity * sizeof(T)};
+        if (blk_size != 0 && !std::is_constant_evaluated()
+            && ALLOCATOR::realloc(blk, blk_size * sizeof(T)))
+        {
+          blk_ptr      = static_cast<T*>(blk.ptr());
+          blk_capacity = blk.size() / sizeof(T);
+          return;
+        }
+      }
+      relocate(blk_size);
+    }
+
+    /// @brief Appends copies of all the objects of a range.
+    /// The Vector grows at most once.
+    /// @param range The objects to copy (which can be part of the Vector)
+    constexpr void append_range(View<T> range) noexcept(
+        std::is_nothrow_copy_constructible_v<T>
+        && std::is_nothrow_move_constructible_v<T>
+        && std::is_nothrow_destructible_v<T>)
+    {
+      const T* from = range.data();
+      // growing invalidates 'range' if it is part of the Vector
+      const bool is_inner = blk_ptr <= from && from < blk_ptr + blk_size;
+      const size_t offset = is_inner ? static_cast<size_t>(from - blk_ptr) : 0;
+      grow_for(blk_size + range.size());
+      if (is_inner)
+        from = blk_ptr + offset;
+      details::contiguous_copy(from, blk_ptr + blk_size, range.size());
+      blk_size += range.size();
+    }
+
     /// @brief Push an object at the end of the Vector by copying
     /// @param to_copy The object to copy at the end of the Vector
     constexpr void push_back(const T& to_copy) noexcept(
         std::is_nothrow_copy_constructible_v<T>)
     {
       if (blk_size == blk_capacity)
-        reserve(blk_capacity + 16);
+        grow_for(blk_size + 1);
       new (blk_ptr + blk_size) T(to_copy);
       ++blk_size;
     }
@@ -247,7 +418,7 @@ namespace clt
       requires(!std::is_trivial_v<T>)
     {
       if (blk_size == blk_capacity)
-        reserve(blk_capacity + 16);
+        grow_for(blk_size + 1);
       new (blk_ptr + blk_size) T(std::move(to_move));
       ++blk_size;
     }
@@ -261,7 +432,7 @@ namespace clt
         std::is_nothrow_constructible_v<T, Args...>)
     {
       if (blk_size == blk_capacity)
-        reserve(blk_capacity + 16);
+        grow_for(blk_size + 1);
       new (blk_ptr + blk_size) T(std::forward<Args>(args)...);
       ++blk_size;
     }
@@ -401,8 +572,9 @@ namespace clt
   }
 } // namespace clt
 
-template<clt::meta::formattable T, typename ALLOCATOR>
-struct fmt::formatter<clt::BasicVector<T, ALLOCATOR>>
+template<typename T, typename ALLOCATOR, typename GROWTH>
+  requires fmt::is_formattable<T>::value
+struct fmt::formatter<clt::BasicVector<T, ALLOCATOR, GROWTH>>
 {
   bool human_readable = false;
 
@@ -422,8 +594,9 @@ struct fmt::formatter<clt::BasicVector<T, ALLOCATOR>>
     return it;
   }
 
-  template<typename FormatContext>
-  auto format(const clt::BasicVector<T, ALLOCATOR>& vec, FormatContext& ctx)
+  // Also used by the formatters of the other vectors (such as SmallVector)
+  template<typename VECTOR, typename FormatContext>
+  auto format(const VECTOR& vec, FormatContext& ctx)
   {
     auto fmt_to = ctx.out();
     if (human_readable)
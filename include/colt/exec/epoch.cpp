@@ -0,0 +1,304 @@
+/*****************************************************************/ /**
+ * @file   epoch.cpp
+ * @brief  Contains the implementation of `epoch.h`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "epoch.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace clt::exec
+{
+  /// @brief An object waiting for reclamation
+  struct RetiredObject
+  {
+    /// @brief The object
+    void* obj;
+    /// @brief The function reclaiming the object
+    Reclaimer reclaimer;
+    /// @brief The context of the reclaimer
+    void* ctx;
+    /// @brief The epoch at which the object was retired
+    u64 epoch;
+  };
+
+  /// @brief The record of a thread in a domain (aligned to avoid false
+  ///        sharing between the epochs of the threads)
+  struct alignas(64) details::EpochRecord
+  {
+    /// @brief The epoch observed by the thread (0 if not pinned)
+    std::atomic<u64> epoch = 0;
+    /// @brief True while a thread owns the record
+    std::atomic<bool> in_use = true;
+    /// @brief The next record of the domain (never modified once pushed)
+    EpochRecord* next = nullptr;
+    /// @brief The count of alive guards (only accessed by the owner)
+    u32 nesting = 0;
+    /// @brief The count of retirements since the last reclamation
+    u32 retired = 0;
+    /// @brief Protects 'limbo', which is only contended by 'synchronize'
+    mutable std::mutex mutex;
+    /// @brief The objects retired by the thread that were not reclaimed
+    std::vector<RetiredObject> limbo;
+  };
+
+  /// @brief The identifiers of the domains that were not destroyed
+  struct LiveDomains
+  {
+    /// @brief Protects the members
+    std::mutex mutex;
+    /// @brief The identifiers of the alive domains
+    std::vector<u64> ids;
+    /// @brief The identifier of the next domain
+    u64 next_id = 0;
+
+    /// @brief Check if a domain is alive (the mutex must be locked)
+    /// @param id The identifier of the domain
+    /// @return True if the domain was not destroyed
+    bool is_alive(u64 id) const noexcept
+    {
+      return std::find(ids.begin(), ids.end(), id) != ids.end();
+    }
+  };
+
+  /// @brief Returns the alive domains
+  /// @return The alive domains (never destroyed: threads may exit late)
+  static LiveDomains& live_domains() noexcept
+  {
+    static LiveDomains* domains = new LiveDomains();
+    return *domains;
+  }
+
+  /// @brief The records owned by a thread, released when it exits
+  struct ThreadRecords
+  {
+    /// @brief The record of a domain
+    struct Entry
+    {
+      /// @brief The identifier of the domain
+      u64 domain;
+      /// @brief The record owned in that domain
+      details::EpochRecord* record;
+    };
+
+    /// @brief The records (most threads use a single domain)
+    std::vector<Entry> entries;
+
+    /// @brief Returns the record owned in a domain
+    /// @param domain The identifier of the domain
+    /// @return The record or null if the thread never used the domain
+    details::EpochRecord* find(u64 domain) const noexcept
+    {
+      for (auto& entry : entries)
+        if (entry.domain == domain)
+          return entry.record;
+      return nullptr;
+    }
+
+    ~ThreadRecords() noexcept
+    {
+      // The records of the destroyed domains were freed
+      auto& live = live_domains();
+      auto lock  = std::scoped_lock{live.mutex};
+      for (auto& entry : entries)
+      {
+        if (!live.is_alive(entry.domain))
+          continue;
+        // The retired objects stay in the record, until it is reused
+        entry.record->nesting = 0;
+        entry.record->epoch.store(0, std::memory_order_release);
+        entry.record->in_use.store(false, std::memory_order_release);
+      }
+    }
+  };
+
+  /// @brief The records of the current thread
+  static thread_local ThreadRecords thread_records;
+
+  EpochGuard::~EpochGuard() noexcept
+  {
+    if (record != nullptr && --record->nesting == 0)
+      record->epoch.store(0, std::memory_order_release);
+  }
+
+  EpochDomain::EpochDomain() noexcept
+  {
+    auto& live = live_domains();
+    auto lock  = std::scoped_lock{live.mutex};
+    id         = live.next_id++;
+    live.ids.push_back(id);
+  }
+
+  EpochDomain::~EpochDomain() noexcept
+  {
+    {
+      // Exiting threads must not release their records anymore
+      auto& live = live_domains();
+      auto lock  = std::scoped_lock{live.mutex};
+      live.ids.erase(std::find(live.ids.begin(), live.ids.end(), id));
+    }
+    auto* rec = records.load(std::memory_order_acquire);
+    while (rec != nullptr)
+    {
+      assert_true("A thread is pinned to a destroyed domain!", rec->nesting == 0);
+      reclaim(*rec, true);
+      delete std::exchange(rec, rec->next);
+    }
+  }
+
+  details::EpochRecord& EpochDomain::record() noexcept
+  {
+    if (auto* rec = thread_records.find(id); rec != nullptr) [[likely]]
+      return *rec;
+
+    // Reuses the record of a thread that exited
+    details::EpochRecord* found = nullptr;
+    for (auto* rec = records.load(std::memory_order_acquire); rec != nullptr;
+         rec       = rec->next)
+    {
+      bool expected = false;
+      if (!rec->in_use.load(std::memory_order_relaxed)
+          && rec->in_use.compare_exchange_strong(
+              expected, true, std::memory_order_acquire))
+      {
+        found = rec;
+        break;
+      }
+    }
+    if (found == nullptr)
+    {
+      found     = new details::EpochRecord();
+      auto head = records.load(std::memory_order_relaxed);
+      do
+        found->next = head;
+      while (!records.compare_exchange_weak(
+          head, found, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // Forgets the records of the destroyed domains
+    {
+      auto& live = live_domains();
+      auto lock  = std::scoped_lock{live.mutex};
+      std::erase_if(
+          thread_records.entries,
+          [&](const ThreadRecords::Entry& entry)
+          { return !live.is_alive(entry.domain); });
+    }
+    thread_records.entries.push_back({id, found});
+    return *found;
+  }
+
+  EpochGuard EpochDomain::pin() noexcept
+  {
+    auto& rec = record();
+    if (rec.nesting++ == 0)
+    {
+      rec.epoch.store(
+          global_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      // Orders the publication of the epoch before the loads of the reader
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+    return EpochGuard{&rec};
+  }
+
+  bool EpochDomain::is_pinned() noexcept
+  {
+    auto* rec = thread_records.find(id);
+    return rec != nullptr && rec->nesting != 0;
+  }
+
+  bool EpochDomain::try_advance() noexcept
+  {
+    u64 current = global_epoch.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (auto* rec = records.load(std::memory_order_acquire); rec != nullptr;
+         rec       = rec->next)
+    {
+      const u64 epoch = rec->epoch.load(std::memory_order_acquire);
+      if (epoch != 0 && epoch != current)
+        return false;
+    }
+    return global_epoch.compare_exchange_strong(
+        current, current + 1, std::memory_order_seq_cst,
+        std::memory_order_relaxed);
+  }
+
+  size_t EpochDomain::reclaim(details::EpochRecord& rec, bool all) noexcept
+  {
+    const u64 current = global_epoch.load(std::memory_order_acquire);
+    auto lock         = std::scoped_lock{rec.mutex};
+    size_t kept       = 0;
+    for (auto& retired : rec.limbo)
+    {
+      // Threads pinned at 'retired.epoch' unpinned before the second advance
+      if (all || retired.epoch + 2 <= current)
+        retired.reclaimer(retired.obj, retired.ctx);
+      else
+        rec.limbo[kept++] = retired;
+    }
+    const size_t reclaimed = rec.limbo.size() - kept;
+    rec.limbo.resize(kept);
+    return reclaimed;
+  }
+
+  void EpochDomain::retire(void* obj, Reclaimer reclaimer, void* ctx) noexcept
+  {
+    auto& rec = record();
+    // Orders the unlinking of the object before reading the epoch
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const u64 current = global_epoch.load(std::memory_order_relaxed);
+    {
+      auto lock = std::scoped_lock{rec.mutex};
+      rec.limbo.push_back({obj, reclaimer, ctx, current});
+    }
+    if (++rec.retired >= RETIRE_PERIOD)
+    {
+      rec.retired = 0;
+      try_advance();
+      reclaim(rec, false);
+    }
+  }
+
+  size_t EpochDomain::collect() noexcept
+  {
+    try_advance();
+    return reclaim(record(), false);
+  }
+
+  void EpochDomain::synchronize() noexcept
+  {
+    assert_true("The current thread must not be pinned!", !is_pinned());
+    const u64 target = global_epoch.load(std::memory_order_seq_cst) + 2;
+    while (global_epoch.load(std::memory_order_acquire) < target)
+    {
+      if (!try_advance())
+        std::this_thread::yield();
+    }
+    for (auto* rec = records.load(std::memory_order_acquire); rec != nullptr;
+         rec       = rec->next)
+      reclaim(*rec, false);
+  }
+
+  size_t EpochDomain::pending() const noexcept
+  {
+    size_t count = 0;
+    for (auto* rec = records.load(std::memory_order_acquire); rec != nullptr;
+         rec       = rec->next)
+    {
+      auto lock = std::scoped_lock{rec->mutex};
+      count += rec->limbo.size();
+    }
+    return count;
+  }
+
+  EpochDomain& EpochDomain::global() noexcept
+  {
+    static EpochDomain* domain = new EpochDomain();
+    return *domain;
+  }
+} // namespace clt::exec
@@ -0,0 +1,209 @@
+/*****************************************************************/ /**
+ * @file   epoch.h
+ * @brief  Contains EpochDomain, an epoch-based reclamation scheme for
+ * lock-free data structures.
+ * Readers pin the domain for the duration of their traversal (which is
+ * a store and a fence on a record owned by their thread), while writers
+ * retire the nodes they unlinked instead of freeing them. A retired node
+ * is reclaimed once the global epoch advanced twice: an advance requires
+ * every pinned thread to have observed the current epoch, so no reader
+ * can still hold a reference to the node.
+ * @code{.cpp}
+ * // Reader
+ * auto guard = domain.pin();
+ * Node* node = head.load(std::memory_order_acquire);
+ * ... // 'node' cannot be reclaimed until 'guard' is destroyed
+ * // Writer
+ * Node* old = head.exchange(new_node, std::memory_order_acq_rel);
+ * domain.retire(old, allocator); // destroyed then freed through 'allocator'
+ * @endcode
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_EXEC_EPOCH
+#define HG_EXEC_EPOCH
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "colt/typedefs.h"
+#include "colt/mem/allocator_ref.h"
+#include "colt/coltcpp_export.h"
+
+namespace clt::exec
+{
+  class EpochDomain;
+
+  namespace details
+  {
+    struct EpochRecord;
+  } // namespace details
+
+  /// @brief Reclaims a retired object
+  /// @param obj The object passed to 'retire'
+  /// @param ctx The context passed to 'retire'
+  using Reclaimer = void (*)(void* obj, void* ctx) noexcept;
+
+  /// @brief Keeps the current thread pinned to an EpochDomain.
+  /// The objects loaded from a structure protected by the domain while
+  /// the guard is alive are not reclaimed before the guard is destroyed.
+  /// Guards of the same thread can be nested.
+  class EpochGuard
+  {
+    friend class EpochDomain;
+
+    /// @brief The record of the current thread (null if moved from)
+    details::EpochRecord* record;
+
+    /// @brief Constructor
+    /// @param record The (pinned) record of the current thread
+    explicit EpochGuard(details::EpochRecord* record) noexcept
+        : record(record)
+    {
+    }
+
+  public:
+    EpochGuard(const EpochGuard&)            = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+    EpochGuard& operator=(EpochGuard&&)      = delete;
+
+    /// @brief Move constructor
+    /// @param other The guard to move from (which then does not unpin)
+    EpochGuard(EpochGuard&& other) noexcept
+        : record(std::exchange(other.record, nullptr))
+    {
+    }
+
+    /// @brief Unpins the current thread (if this is the outermost guard).
+    /// The guard must be destroyed by the thread that created it.
+    COLTCPP_EXPORT ~EpochGuard() noexcept;
+  };
+
+  /// @brief A domain of epoch-based reclamation.
+  /// Each thread using a domain is given a record (reused once the thread
+  /// exits) on which it publishes the epoch it observed while pinned, and
+  /// that holds the objects it retired: pinning and retiring never lock
+  /// shared state. Every RETIRE_PERIOD retirements, the retiring thread
+  /// tries to advance the epoch and reclaims its own objects.
+  /// The structures sharing a domain delay the reclamation of each other:
+  /// a structure whose readers stay pinned for a long time should use its
+  /// own domain.
+  class EpochDomain
+  {
+    /// @brief The current epoch (starts at 1: 0 marks unpinned records)
+    alignas(64) std::atomic<u64> global_epoch = 1;
+    /// @brief The records of the threads (only pushed, until destruction)
+    alignas(64) std::atomic<details::EpochRecord*> records = nullptr;
+    /// @brief The unique identifier of the domain (never reused, so that
+    ///        threads can detect that a domain they used was destroyed)
+    u64 id;
+
+    /// @brief Returns the record of the current thread, acquiring one if
+    ///        the thread never used this domain
+    /// @return The record of the current thread
+    COLTCPP_EXPORT details::EpochRecord& record() noexcept;
+
+    /// @brief Advances the global epoch if all the pinned threads observed it
+    /// @return True if the epoch was advanced
+    COLTCPP_EXPORT bool try_advance() noexcept;
+
+    /// @brief Reclaims the safe objects of a record
+    /// @param rec The record
+    /// @param all If true, reclaims all the objects (even the unsafe ones)
+    /// @return The count of reclaimed objects
+    COLTCPP_EXPORT size_t reclaim(details::EpochRecord& rec, bool all) noexcept;
+
+  public:
+    /// @brief The count of retirements of a thread after which it tries
+    ///        to reclaim its objects
+    static constexpr u32 RETIRE_PERIOD = 64;
+
+    /// @brief Constructor
+    COLTCPP_EXPORT EpochDomain() noexcept;
+
+    EpochDomain(const EpochDomain&)            = delete;
+    EpochDomain(EpochDomain&&)                 = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+    EpochDomain& operator=(EpochDomain&&)      = delete;
+
+    /// @brief Reclaims all the retired objects.
+    /// No thread may be pinned or retire concurrently.
+    COLTCPP_EXPORT ~EpochDomain() noexcept;
+
+    /// @brief Pins the current thread until the returned guard is destroyed
+    /// @return The guard (which must not outlive the domain)
+    [[nodiscard]] COLTCPP_EXPORT EpochGuard pin() noexcept;
+
+    /// @brief Check if the current thread is pinned to this domain
+    /// @return True if an EpochGuard of this domain is alive in this thread
+    [[nodiscard]] COLTCPP_EXPORT bool is_pinned() noexcept;
+
+    /// @brief Retires an object, that is reclaimed once no thread can hold
+    ///        a reference to it.
+    /// The object must be unreachable for threads that pin after the call.
+    /// The reclaimer may run on any thread using the domain, and must not
+    /// pin or retire to this domain.
+    /// @param obj The object
+    /// @param reclaimer The function reclaiming 'obj'
+    /// @param ctx The context passed to 'reclaimer'
+    COLTCPP_EXPORT void retire(
+        void* obj, Reclaimer reclaimer, void* ctx = nullptr) noexcept;
+
+    /// @brief Retires an object allocated from an allocator, that is
+    ///        destroyed then deallocated once no thread can hold a reference
+    ///        to it.
+    /// The allocator must be thread-safe, and must outlive the reclamation:
+    /// call 'synchronize' before destroying a local allocator.
+    /// @tparam T The type of the object
+    /// @tparam A The type of the allocator
+    /// @param obj The object (of a block of size 'sizeof(T)')
+    /// @param alloc The allocator that allocated 'obj'
+    template<typename T, meta::Allocator A>
+    void retire(T* obj, A& alloc) noexcept
+    {
+      static_assert(
+          std::is_nothrow_destructible_v<T>, "Destructor must be noexcept!");
+      constexpr bool GLOBAL = mem::details::is_global_allocator_v<A>;
+      // Global allocators are stateless: no pointer is kept to 'alloc'
+      void* ctx = GLOBAL ? nullptr : static_cast<void*>(std::addressof(alloc));
+      retire(
+          obj,
+          +[](void* ptr, void* state) noexcept
+          {
+            std::destroy_at(static_cast<T*>(ptr));
+            mem::details::allocator_of<A>(state).dealloc({ptr, sizeof(T)});
+          },
+          ctx);
+    }
+
+    /// @brief Tries to advance the epoch, then reclaims the objects of the
+    ///        current thread that are safe to reclaim
+    /// @return The count of reclaimed objects
+    COLTCPP_EXPORT size_t collect() noexcept;
+
+    /// @brief Waits until all the objects retired (by any thread) before
+    ///        the call are reclaimed.
+    /// This blocks until every thread pinned during the call unpins: the
+    /// current thread must not be pinned.
+    COLTCPP_EXPORT void synchronize() noexcept;
+
+    /// @brief Returns the current epoch
+    /// @return The global epoch
+    u64 epoch() const noexcept
+    {
+      return global_epoch.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Returns the count of retired objects that were not reclaimed
+    /// @return The count of pending objects (of all the threads)
+    [[nodiscard]] COLTCPP_EXPORT size_t pending() const noexcept;
+
+    /// @brief Returns the domain shared by the structures of the library
+    /// @return The global domain (never destroyed)
+    COLTCPP_EXPORT static EpochDomain& global() noexcept;
+  };
+} // namespace clt::exec
+
+#endif // !HG_EXEC_EPOCH
@@ -0,0 +1,692 @@
+/*****************************************************************/ /**
+ * @file   scheduler.cpp
+ * @brief  Contains the implementation of `scheduler.h`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "scheduler.h"
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "colt/mem/simple_alloc.h"
+
+#if defined(COLT_LINUX)
+  #include <sched.h>
+#elif defined(COLT_WINDOWS)
+  #define NOMINMAX
+  #define WIN32_LEAN_AND_MEAN
+  #include <Windows.h>
+#endif
+
+namespace clt::exec::details
+{
+  /// @brief The count of frames allocated at once by a FrameCache
+  static constexpr size_t FRAMES_PER_CHUNK = 64;
+  /// @brief The count of times an idle thread looks for work before sleeping
+  static constexpr u32 SPIN_COUNT = 64;
+
+  /// @brief Cache of task frames owned by a worker.
+  /// Only the worker allocates from the cache: frames freed by other
+  /// threads (whose tasks were stolen) are pushed to 'remote', which the
+  /// worker takes as a whole once 'local' is empty.
+  struct FrameCache
+  {
+    /// @brief The frames that can be allocated (owner only)
+    Task* local = nullptr;
+    /// @brief The chunks of frames (owner only)
+    std::vector<mem::MemBlock> chunks;
+    /// @brief The frames freed by other threads
+    alignas(64) std::atomic<Task*> remote = nullptr;
+
+    /// @brief Allocates a frame of TASK_FRAME_SIZE bytes (owner only)
+    /// @param alloc The allocator of the chunks
+    /// @return The frame or null on failure
+    Task* allocate(mem::AnyAllocatorRef alloc) noexcept
+    {
+      if (local == nullptr)
+        local = remote.exchange(nullptr, std::memory_order_acquire);
+      if (local == nullptr)
+      {
+        auto chunk = alloc.alloc(TASK_FRAME_SIZE * FRAMES_PER_CHUNK);
+        if (chunk.is_null())
+          return nullptr;
+        chunks.push_back(chunk);
+        auto begin = static_cast<u8*>(chunk.ptr());
+        for (size_t i = 0; i < FRAMES_PER_CHUNK; i++)
+        {
+          auto frame  = reinterpret_cast<Task*>(begin + i * TASK_FRAME_SIZE);
+          frame->next = local;
+          local       = frame;
+        }
+      }
+      Task* ret = local;
+      local     = ret->next;
+      return ret;
+    }
+
+    /// @brief Returns a frame to the cache from its owner
+    /// @param task The frame
+    void free_local(Task* task) noexcept
+    {
+      task->next = local;
+      local      = task;
+    }
+
+    /// @brief Returns a frame to the cache from another thread
+    /// @param task The frame
+    void free_remote(Task* task) noexcept
+    {
+      Task* head = remote.load(std::memory_order_relaxed);
+      do
+        task->next = head;
+      while (!remote.compare_exchange_weak(
+          head, task, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    /// @brief Frees all the chunks (once no task can run anymore)
+    /// @param alloc The allocator of the chunks
+    void release(mem::AnyAllocatorRef alloc) noexcept
+    {
+      for (auto chunk : chunks)
+        alloc.dealloc(chunk);
+      chunks.clear();
+      local = nullptr;
+      remote.store(nullptr, std::memory_order_relaxed);
+    }
+  };
+
+  /// @brief Chase-Lev work-stealing deque of tasks.
+  /// The owner pushes and pops at the bottom, thieves steal at the top.
+  /// This follows "Correct and Efficient Work-Stealing for Weak Memory
+  /// Models" (Lê, Pop, Cohen, Zappa Nardelli, 2013).
+  class WorkDeque
+  {
+    /// @brief Circular array of tasks
+    struct Ring
+    {
+      /// @brief The capacity minus 1 (capacity is a power of 2)
+      i64 mask;
+      /// @brief The tasks
+      std::unique_ptr<std::atomic<Task*>[]> slots;
+
+      /// @brief Constructor
+      /// @param capacity The capacity (power of 2)
+      Ring(i64 capacity)
+          : mask(capacity - 1)
+          , slots(std::make_unique<std::atomic<Task*>[]>(capacity))
+      {
+      }
+
+      /// @brief Returns the slot of an index
+      /// @param i The index
+      /// @return The slot
+      std::atomic<Task*>& operator[](i64 i) noexcept { return slots[i & mask]; }
+    };
+
+    /// @brief The index at which thieves steal
+    alignas(64) std::atomic<i64> top = 0;
+    /// @brief The index at which the owner pushes
+    alignas(64) std::atomic<i64> bottom = 0;
+    /// @brief The current ring
+    std::atomic<Ring*> ring;
+    /// @brief All the rings (owner only): previous rings may still be read
+    ///        by thieves, so they are only freed with the deque
+    std::vector<std::unique_ptr<Ring>> rings;
+
+    /// @brief Replaces the ring by one of twice its capacity (owner only)
+    /// @param current The current ring
+    /// @param t The top index
+    /// @param b The bottom index
+    /// @return The new ring
+    Ring* grow(Ring* current, i64 t, i64 b)
+    {
+      auto next = std::make_unique<Ring>((current->mask + 1) * 2);
+      for (i64 i = t; i != b; i++)
+      {
+        auto task = (*current)[i].load(std::memory_order_relaxed);
+        (*next)[i].store(task, std::memory_order_relaxed);
+      }
+      Ring* ret = next.get();
+      rings.push_back(std::move(next));
+      ring.store(ret, std::memory_order_release);
+      return ret;
+    }
+
+  public:
+    /// @brief Constructor
+    /// @param capacity The initial capacity (power of 2)
+    WorkDeque(i64 capacity = 256)
+    {
+      rings.push_back(std::make_unique<Ring>(capacity));
+      ring.store(rings.back().get(), std::memory_order_relaxed);
+    }
+
+    /// @brief Pushes a task at the bottom (owner only)
+    /// @param task The task
+    void push(Task* task)
+    {
+      const i64 b = bottom.load(std::memory_order_relaxed);
+      const i64 t = top.load(std::memory_order_acquire);
+      Ring* a     = ring.load(std::memory_order_relaxed);
+      if (b - t > a->mask)
+        a = grow(a, t, b);
+      (*a)[b].store(task, std::memory_order_relaxed);
+      // Publishes the task (and its frame) to the thieves
+      bottom.store(b + 1, std::memory_order_release);
+    }
+
+    /// @brief Pops the task at the bottom (owner only)
+    /// @return The task or null if empty
+    Task* pop() noexcept
+    {
+      const i64 b = bottom.load(std::memory_order_relaxed) - 1;
+      Ring* a     = ring.load(std::memory_order_relaxed);
+      bottom.store(b, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      i64 t = top.load(std::memory_order_relaxed);
+      if (t > b)
+      {
+        // Empty
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+      }
+      Task* task = (*a)[b].load(std::memory_order_relaxed);
+      if (t == b)
+      {
+        // Last task: race against thieves
+        if (!top.compare_exchange_strong(
+                t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+          task = nullptr;
+        bottom.store(b + 1, std::memory_order_relaxed);
+      }
+      return task;
+    }
+
+    /// @brief Steals the task at the top (any thread)
+    /// @return The task or null if empty or lost to another thread
+    Task* steal() noexcept
+    {
+      i64 t = top.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const i64 b = bottom.load(std::memory_order_acquire);
+      if (t >= b)
+        return nullptr;
+      Ring* a    = ring.load(std::memory_order_acquire);
+      Task* task = (*a)[t].load(std::memory_order_relaxed);
+      if (!top.compare_exchange_strong(
+              t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return nullptr;
+      return task;
+    }
+
+    /// @brief Check if the deque appears empty (any thread)
+    /// @return True if no task could be stolen when checked
+    bool is_empty() const noexcept
+    {
+      return top.load(std::memory_order_acquire)
+             >= bottom.load(std::memory_order_acquire);
+    }
+  };
+
+  /// @brief A worker thread
+  struct alignas(64) Worker
+  {
+    /// @brief The deque of the tasks spawned by the worker
+    WorkDeque deque;
+    /// @brief The cache of frames of the worker
+    FrameCache frames;
+    /// @brief The state of the random generator choosing the victims
+    u64 rng;
+    /// @brief The index of the worker
+    u32 index;
+    /// @brief The logical processor to which the worker is pinned (or -1)
+    u32 cpu = static_cast<u32>(-1);
+    /// @brief The thread
+    std::thread thread;
+  };
+
+  /// @brief The worker running on the current thread (or null)
+  static thread_local Worker* current_worker = nullptr;
+  /// @brief The scheduler of 'current_worker' (or null)
+  static thread_local const SchedulerImpl* current_scheduler = nullptr;
+
+  /// @brief Returns the logical processors allowed for the process,
+  /// ordered so that all the physical cores come before SMT siblings.
+  /// @return The logical processors (empty if pinning is unsupported)
+  static std::vector<u32> ordered_cpus() noexcept
+  {
+    // (rank among the siblings of its core, cpu)
+    std::vector<std::pair<u32, u32>> cpus;
+#if defined(COLT_LINUX)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0)
+      return {};
+    std::vector<u32> cores;
+    for (u32 cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+      if (!CPU_ISSET(cpu, &set))
+        continue;
+      // The first sibling of the core identifies the core
+      u32 core = cpu;
+      char path[96];
+      std::snprintf(
+          path, sizeof(path),
+          "/sys/devices/system/cpu/cpu%u/topology/thread_siblings_list", cpu);
+      if (FILE* file = std::fopen(path, "r"))
+      {
+        if (std::fscanf(file, "%u", &core) != 1)
+          core = cpu;
+        std::fclose(file);
+      }
+      const auto rank = std::count(cores.begin(), cores.end(), core);
+      cores.push_back(core);
+      cpus.push_back({static_cast<u32>(rank), cpu});
+    }
+#elif defined(COLT_WINDOWS)
+    DWORD length = 0;
+    GetLogicalProcessorInformation(nullptr, &length);
+    std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> infos(
+        length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+    if (infos.empty() || !GetLogicalProcessorInformation(infos.data(), &length))
+      return {};
+    for (const auto& info : infos)
+    {
+      if (info.Relationship != RelationProcessorCore)
+        continue;
+      u32 rank = 0;
+      for (u32 cpu = 0; cpu < sizeof(ULONG_PTR) * 8; cpu++)
+      {
+        if (info.ProcessorMask & (ULONG_PTR{1} << cpu))
+          cpus.push_back({rank++, cpu});
+      }
+    }
+#endif
+    std::sort(cpus.begin(), cpus.end());
+    std::vector<u32> ret;
+    for (auto [rank, cpu] : cpus)
+      ret.push_back(cpu);
+    return ret;
+  }
+
+  /// @brief Pins the current thread to a logical processor
+  /// @param cpu The logical processor
+  static void pin_current_thread(u32 cpu) noexcept
+  {
+#if defined(COLT_LINUX)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+#elif defined(COLT_WINDOWS)
+    SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << cpu);
+#else
+    (void)cpu;
+#endif
+  }
+
+  /// @brief The workers and queues of a Scheduler
+  class SchedulerImpl
+  {
+    /// @brief The allocator of task frames
+    mem::AnyAllocatorRef frame_allocator;
+    /// @brief The workers
+    std::vector<std::unique_ptr<Worker>> workers;
+    /// @brief Protects 'injected'
+    std::mutex inject_mutex;
+    /// @brief The tasks submitted by threads that are not workers
+    std::deque<Task*> injected;
+    /// @brief The size of 'injected'
+    std::atomic<size_t> injected_count = 0;
+    /// @brief Incremented when work is submitted or a group completes
+    std::atomic<u32> event = 0;
+    /// @brief The count of threads sleeping on 'event'
+    std::atomic<u32> sleepers = 0;
+    /// @brief The count of successful steals
+    std::atomic<u64> steals = 0;
+    /// @brief True if the workers must stop
+    std::atomic<bool> stopping = false;
+
+    /// @brief Wakes a sleeping thread (if any)
+    /// @param all True to wake all the sleeping threads
+    void signal(bool all) noexcept
+    {
+      event.fetch_add(1, std::memory_order_seq_cst);
+      if (sleepers.load(std::memory_order_seq_cst) == 0)
+        return;
+      if (all)
+        event.notify_all();
+      else
+        event.notify_one();
+    }
+
+    /// @brief Pops a task submitted by a thread that is not a worker
+    /// @return The task or null
+    Task* pop_injected() noexcept
+    {
+      if (injected_count.load(std::memory_order_acquire) == 0)
+        return nullptr;
+      std::scoped_lock lock = std::scoped_lock{inject_mutex};
+      if (injected.empty())
+        return nullptr;
+      Task* task = injected.front();
+      injected.pop_front();
+      injected_count.store(injected.size(), std::memory_order_release);
+      return task;
+    }
+
+    /// @brief Looks for a task to run
+    /// @param self The worker of the current thread (or null)
+    /// @return The task or null
+    Task* find_work(Worker* self) noexcept
+    {
+      if (self != nullptr)
+      {
+        if (Task* task = self->deque.pop())
+          return task;
+      }
+      if (Task* task = pop_injected())
+        return task;
+      // Start from a random victim to spread the steals
+      const size_t count = workers.size();
+      size_t start       = 0;
+      if (self != nullptr)
+      {
+        self->rng ^= self->rng << 13;
+        self->rng ^= self->rng >> 7;
+        self->rng ^= self->rng << 17;
+        start = static_cast<size_t>(self->rng % count);
+      }
+      for (size_t i = 0; i < count; i++)
+      {
+        Worker* victim = workers[(start + i) % count].get();
+        if (victim == self)
+          continue;
+        if (Task* task = victim->deque.steal())
+        {
+          steals.fetch_add(1, std::memory_order_relaxed);
+          return task;
+        }
+      }
+      return nullptr;
+    }
+
+    /// @brief Check if any task could be found
+    /// @return True if a queue appears non-empty
+    bool has_work() const noexcept
+    {
+      if (injected_count.load(std::memory_order_acquire) != 0)
+        return true;
+      return std::any_of(
+          workers.begin(), workers.end(),
+          [](const auto& worker) { return !worker->deque.is_empty(); });
+    }
+
+    /// @brief Runs a task, frees its frame and completes it in its group
+    /// @param task The task to run
+    void run(Task* task) noexcept
+    {
+      TaskGroup* group = task->group;
+      task->invoke(task);
+      free_task(task);
+      // The group may be destroyed as soon as 'pending' reaches 0
+      if (group->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        signal(true);
+    }
+
+    /// @brief Sleeps until work is submitted or a group completes,
+    /// unless 'done' already returns true
+    /// @param done Returns true if the thread must not sleep
+    template<typename Fn>
+    void sleep_unless(Fn&& done) noexcept
+    {
+      sleepers.fetch_add(1, std::memory_order_seq_cst);
+      const u32 current = event.load(std::memory_order_seq_cst);
+      if (!done() && !has_work())
+        event.wait(current, std::memory_order_seq_cst);
+      sleepers.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    /// @brief The loop of the worker threads
+    /// @param self The worker of the thread
+    void worker_loop(Worker* self) noexcept
+    {
+      current_worker    = self;
+      current_scheduler = this;
+      if (self->cpu != static_cast<u32>(-1))
+        pin_current_thread(self->cpu);
+      u32 idle = 0;
+      while (!stopping.load(std::memory_order_acquire))
+      {
+        if (Task* task = find_work(self))
+        {
+          run(task);
+          idle = 0;
+        }
+        else if (++idle < SPIN_COUNT)
+          std::this_thread::yield();
+        else
+        {
+          sleep_unless([this]
+                       { return stopping.load(std::memory_order_acquire); });
+          idle = 0;
+        }
+      }
+      current_worker    = nullptr;
+      current_scheduler = nullptr;
+    }
+
+  public:
+    /// @brief Starts the workers
+    /// @param options The options
+    SchedulerImpl(const SchedulerOptions& options)
+        : frame_allocator(options.frame_allocator)
+    {
+      u32 count = options.workers;
+      if (count == 0)
+        count = std::max(std::thread::hardware_concurrency(), 1U);
+      std::vector<u32> cpus;
+      if (options.pinning == WorkerPinning::SpreadCores)
+        cpus = ordered_cpus();
+      for (u32 i = 0; i < count; i++)
+      {
+        auto worker   = std::make_unique<Worker>();
+        worker->index = i;
+        worker->rng   = 0x9E37'79B9'7F4A'7C15ULL * (i + 1);
+        if (!cpus.empty())
+          worker->cpu = cpus[i % cpus.size()];
+        workers.push_back(std::move(worker));
+      }
+      // All the workers must exist before any of them steals
+      for (auto& worker : workers)
+        worker->thread =
+            std::thread(&SchedulerImpl::worker_loop, this, worker.get());
+    }
+
+    /// @brief Stops and joins the workers, then frees the frames
+    ~SchedulerImpl() noexcept
+    {
+      stopping.store(true, std::memory_order_release);
+      signal(true);
+      for (auto& worker : workers)
+        worker->thread.join();
+      for (auto& worker : workers)
+        worker->frames.release(frame_allocator);
+    }
+
+    /// @brief Returns the worker of the current thread
+    /// @return The worker or null if the thread is not a worker of 'this'
+    Worker* worker_of_current_thread() const noexcept
+    {
+      return current_scheduler == this ? current_worker : nullptr;
+    }
+
+    /// @brief Allocates a task frame
+    /// @param size The size of the frame
+    /// @return The frame or null
+    Task* allocate_task(size_t size) noexcept
+    {
+      Worker* self = worker_of_current_thread();
+      Task* task   = nullptr;
+      if (self != nullptr && size <= TASK_FRAME_SIZE)
+      {
+        task = self->frames.allocate(frame_allocator);
+        if (task != nullptr)
+        {
+          task->owner = &self->frames;
+          task->size  = TASK_FRAME_SIZE;
+        }
+        return task;
+      }
+      auto blk = frame_allocator.alloc(size);
+      if (blk.is_null())
+        return nullptr;
+      task        = static_cast<Task*>(blk.ptr());
+      task->owner = nullptr;
+      task->size  = blk.size();
+      return task;
+    }
+
+    /// @brief Frees a task frame
+    /// @param task The frame
+    void free_task(Task* task) noexcept
+    {
+      if (task->owner == nullptr)
+        frame_allocator.dealloc({task, task->size});
+      else if (Worker* self = worker_of_current_thread();
+               self != nullptr && &self->frames == task->owner)
+        task->owner->free_local(task);
+      else
+        task->owner->free_remote(task);
+    }
+
+    /// @brief Makes a task available to the workers
+    /// @param task The task
+    void submit(Task* task) noexcept
+    {
+      if (Worker* self = worker_of_current_thread())
+        self->deque.push(task);
+      else
+      {
+        std::scoped_lock lock = std::scoped_lock{inject_mutex};
+        injected.push_back(task);
+        injected_count.store(injected.size(), std::memory_order_release);
+      }
+      signal(false);
+    }
+
+    /// @brief Runs tasks until all the tasks of 'group' completed
+    /// @param group The group
+    void wait(TaskGroup& group) noexcept
+    {
+      Worker* self = worker_of_current_thread();
+      auto done    = [&group]
+      { return group.pending.load(std::memory_order_acquire) == 0; };
+      u32 idle = 0;
+      while (!done())
+      {
+        if (Task* task = find_work(self))
+        {
+          run(task);
+          idle = 0;
+        }
+        else if (++idle < SPIN_COUNT)
+          std::this_thread::yield();
+        else
+        {
+          sleep_unless(done);
+          idle = 0;
+        }
+      }
+    }
+
+    /// @brief Returns the count of workers
+    /// @return The count of workers
+    u32 worker_count() const noexcept { return static_cast<u32>(workers.size()); }
+
+    /// @brief Returns a worker
+    /// @param index The index of the worker
+    /// @return The worker
+    const Worker& worker(u32 index) const noexcept { return *workers[index]; }
+
+    /// @brief Returns the count of successful steals
+    /// @return The count of successful steals
+    u64 steal_count() const noexcept
+    {
+      return steals.load(std::memory_order_relaxed);
+    }
+  };
+
+  mem::AnyAllocatorRef default_frame_allocator() noexcept
+  {
+    // malloc is thread-safe
+    static mem::Mallocator alloc;
+    return alloc;
+  }
+} // namespace clt::exec::details
+
+namespace clt::exec
+{
+  Scheduler::Scheduler(SchedulerOptions options) noexcept
+      : impl(new details::SchedulerImpl(options))
+  {
+  }
+
+  Scheduler::~Scheduler() noexcept
+  {
+    delete impl;
+  }
+
+  details::Task* Scheduler::allocate_task(size_t size) noexcept
+  {
+    return impl->allocate_task(size);
+  }
+
+  void Scheduler::submit(details::Task* task) noexcept
+  {
+    impl->submit(task);
+  }
+
+  void Scheduler::wait(TaskGroup& group) noexcept
+  {
+    impl->wait(group);
+  }
+
+  u32 Scheduler::worker_count() const noexcept
+  {
+    return impl->worker_count();
+  }
+
+  Option<u32> Scheduler::current_worker() const noexcept
+  {
+    if (auto worker = impl->worker_of_current_thread())
+      return worker->index;
+    return None;
+  }
+
+  Option<u32> Scheduler::pinned_cpu(u32 worker) const noexcept
+  {
+    assert_true("Invalid worker index!", worker < impl->worker_count());
+    const u32 cpu = impl->worker(worker).cpu;
+    if (cpu == static_cast<u32>(-1))
+      return None;
+    return cpu;
+  }
+
+  u64 Scheduler::steal_count() const noexcept
+  {
+    return impl->steal_count();
+  }
+
+  Scheduler& default_scheduler() noexcept
+  {
+    static Scheduler scheduler;
+    return scheduler;
+  }
+} // namespace clt::exec
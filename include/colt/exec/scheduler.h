@@ -0,0 +1,241 @@
+/*****************************************************************/ /**
+ * @file   scheduler.h
+ * @brief  Contains Scheduler and TaskGroup, the execution model of the
+ * library: a pool of workers that balance tasks through work stealing.
+ * Each worker owns a Chase-Lev deque: it pushes and pops the tasks it
+ * spawns at the bottom (LIFO, hot in cache), while idle workers steal
+ * from the top (FIFO, the largest remaining work).
+ * Task frames are allocated from a cache local to the spawning worker,
+ * so that spawning does not go through a global lock.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_EXEC_SCHEDULER
+#define HG_EXEC_SCHEDULER
+
+#include <atomic>
+#include <concepts>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "colt/typedefs.h"
+#include "colt/dsa/option.h"
+#include "colt/mem/allocator_ref.h"
+#include "colt/coltcpp_export.h"
+
+namespace clt::exec
+{
+  class Scheduler;
+  class TaskGroup;
+
+  /// @brief How workers are pinned to logical processors
+  enum class WorkerPinning : u8
+  {
+    /// @brief Workers are not pinned: the OS migrates them freely
+    None,
+    /// @brief Each worker is pinned to a logical processor, spreading the
+    /// workers over physical cores before using their SMT siblings
+    SpreadCores,
+  };
+
+  namespace details
+  {
+    class SchedulerImpl;
+    struct FrameCache;
+
+    /// @brief Header of a task frame, followed by the callable
+    struct Task
+    {
+      /// @brief Runs then destroys the callable
+      void (*invoke)(Task*) noexcept;
+      /// @brief The group of the task
+      TaskGroup* group;
+      /// @brief The cache that allocated the frame (null if the frame was
+      ///        allocated from the frame allocator directly)
+      FrameCache* owner;
+      /// @brief The next frame (used by the free lists)
+      Task* next;
+      /// @brief The size of the frame
+      size_t size;
+    };
+
+    /// @brief The size of the frames cached by workers.
+    /// Larger frames are allocated from the frame allocator.
+    inline constexpr size_t TASK_FRAME_SIZE = 128;
+
+    /// @brief Returns the allocator used by default for task frames
+    /// @return Reference to a thread-safe allocator (malloc)
+    COLTCPP_EXPORT mem::AnyAllocatorRef default_frame_allocator() noexcept;
+  } // namespace details
+
+  /// @brief The options of a Scheduler
+  struct SchedulerOptions
+  {
+    /// @brief The count of workers (0 for the count of hardware threads)
+    u32 workers = 0;
+    /// @brief How the workers are pinned to logical processors
+    WorkerPinning pinning = WorkerPinning::None;
+    /// @brief The allocator of task frames, which must be thread-safe.
+    /// Workers allocate chunks of frames from it, and frames that do not
+    /// fit in TASK_FRAME_SIZE (or spawned by non-worker threads).
+    mem::AnyAllocatorRef frame_allocator = details::default_frame_allocator();
+  };
+
+  /// @brief A pool of workers executing tasks through work stealing.
+  /// Tasks are spawned in a TaskGroup, whose 'wait' runs the pending
+  /// tasks of the pool rather than blocking, so that groups can be
+  /// nested (a task may spawn and wait for its own group) without
+  /// exhausting the workers.
+  /// Threads that are not workers of the pool can spawn and wait too:
+  /// their tasks go through a shared queue.
+  /// @code{.cpp}
+  /// Scheduler pool;
+  /// TaskGroup group = {pool};
+  /// for (auto& file : files)
+  ///   group.spawn([&file] { compile(file); });
+  /// group.wait();
+  /// @endcode
+  class Scheduler
+  {
+    friend class TaskGroup;
+
+    /// @brief The workers and queues
+    details::SchedulerImpl* impl;
+
+    /// @brief Allocates a task frame
+    /// @param size The size of the frame (including the Task header)
+    /// @return The frame or null on failure
+    COLTCPP_EXPORT details::Task* allocate_task(size_t size) noexcept;
+
+    /// @brief Makes a task available to the workers
+    /// @param task The task to submit
+    COLTCPP_EXPORT void submit(details::Task* task) noexcept;
+
+    /// @brief Runs tasks until all the tasks of 'group' completed
+    /// @param group The group to wait for
+    COLTCPP_EXPORT void wait(TaskGroup& group) noexcept;
+
+  public:
+    /// @brief Starts the workers
+    /// @param options The options of the scheduler
+    COLTCPP_EXPORT Scheduler(SchedulerOptions options = {}) noexcept;
+
+    Scheduler(const Scheduler&)            = delete;
+    Scheduler(Scheduler&&)                 = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+    Scheduler& operator=(Scheduler&&)      = delete;
+
+    /// @brief Stops and joins the workers.
+    /// All the groups must have been waited for.
+    COLTCPP_EXPORT ~Scheduler() noexcept;
+
+    /// @brief Returns the count of workers
+    /// @return The count of workers
+    [[nodiscard]] COLTCPP_EXPORT u32 worker_count() const noexcept;
+
+    /// @brief Returns the index of the worker running the current thread
+    /// @return The index of the worker or None if the current thread is
+    ///         not a worker of this scheduler
+    [[nodiscard]] COLTCPP_EXPORT Option<u32> current_worker() const noexcept;
+
+    /// @brief Returns the logical processor to which a worker is pinned
+    /// @param worker The index of the worker
+    /// @return The logical processor or None if the worker is not pinned
+    [[nodiscard]] COLTCPP_EXPORT Option<u32> pinned_cpu(u32 worker) const noexcept;
+
+    /// @brief Returns the count of tasks stolen by workers from another deque
+    /// @return The count of successful steals
+    [[nodiscard]] COLTCPP_EXPORT u64 steal_count() const noexcept;
+  };
+
+  /// @brief Returns the scheduler shared by the parallel paths of the library.
+  /// It is started on the first call, with one worker per hardware thread.
+  /// @return The default scheduler
+  COLTCPP_EXPORT Scheduler& default_scheduler() noexcept;
+
+  /// @brief A group of tasks that can be waited for.
+  /// Tasks must not throw. A group must not be destroyed before all its
+  /// tasks completed: the destructor waits for them.
+  class TaskGroup
+  {
+    friend class details::SchedulerImpl;
+
+    /// @brief The scheduler running the tasks
+    Scheduler* sched;
+    /// @brief The count of tasks that did not complete
+    std::atomic<u32> pending = 0;
+
+  public:
+    /// @brief Constructor
+    /// @param sched The scheduler running the tasks
+    TaskGroup(Scheduler& sched = default_scheduler()) noexcept
+        : sched(&sched)
+    {
+    }
+
+    TaskGroup(const TaskGroup&)            = delete;
+    TaskGroup(TaskGroup&&)                 = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    TaskGroup& operator=(TaskGroup&&)      = delete;
+
+    /// @brief Waits for all the tasks of the group
+    ~TaskGroup() noexcept { wait(); }
+
+    /// @brief Spawns a task executing 'fn'.
+    /// If no frame can be allocated for the task, 'fn' runs immediately.
+    /// @tparam Fn The callable type
+    /// @param fn The callable (which is moved in the task frame)
+    template<typename Fn>
+      requires std::invocable<std::decay_t<Fn>&>
+    void spawn(Fn&& fn) noexcept
+    {
+      using F = std::decay_t<Fn>;
+      static_assert(
+          alignof(F) <= alignof(std::max_align_t),
+          "Over-aligned callables are not supported!");
+      constexpr size_t OFFSET =
+          (sizeof(details::Task) + alignof(F) - 1) / alignof(F) * alignof(F);
+
+      details::Task* task = sched->allocate_task(OFFSET + sizeof(F));
+      if (task == nullptr) [[unlikely]]
+      {
+        fn();
+        return;
+      }
+      new (reinterpret_cast<u8*>(task) + OFFSET) F(std::forward<Fn>(fn));
+      task->invoke = [](details::Task* self) noexcept
+      {
+        auto ptr = std::launder(
+            reinterpret_cast<F*>(reinterpret_cast<u8*>(self) + OFFSET));
+        (*ptr)();
+        ptr->~F();
+      };
+      task->group = this;
+      pending.fetch_add(1, std::memory_order_relaxed);
+      sched->submit(task);
+    }
+
+    /// @brief Runs tasks of the scheduler until all the tasks of the
+    /// group completed
+    void wait() noexcept
+    {
+      if (pending.load(std::memory_order_acquire) != 0)
+        sched->wait(*this);
+    }
+
+    /// @brief Returns the count of tasks that did not complete
+    /// @return The count of pending tasks
+    [[nodiscard]] u32 pending_count() const noexcept
+    {
+      return pending.load(std::memory_order_acquire);
+    }
+
+    /// @brief Returns the scheduler of the group
+    /// @return The scheduler running the tasks
+    [[nodiscard]] Scheduler& scheduler() const noexcept { return *sched; }
+  };
+} // namespace clt::exec
+
+#endif // !HG_EXEC_SCHEDULER
@@ -0,0 +1,314 @@
+/*****************************************************************/ /**
+ * @file   hash.cpp
+ * @brief  Contains the SIMD implementations of the bulk path of wyhash_h.
+ * Big keys are hashed by 8 accumulators of 64-bit: each 64 bytes stripe
+ * of the key (XORed with a secret) is multiplied 32x32->64 and added
+ * to the accumulators, which are scrambled every 16 stripes. This is
+ * the same structure as the one used by XXH3, which vectorizes well.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "hash.h"
+#include "colt/algo/detect_simd.h"
+
+#if defined(COLT_x86_64)
+  #include <immintrin.h>
+#endif // COLT_x86_64
+
+/// @brief The size of a stripe (processed by 8 accumulators)
+static constexpr size_t STRIPE_LEN = 64;
+/// @brief The count of 64-bit integers of the secret
+static constexpr size_t SECRET_COUNT = 24;
+/// @brief The count of stripes processed before each scrambling
+static constexpr size_t STRIPES_PER_BLOCK = SECRET_COUNT - 8;
+/// @brief The size of a block (processed before each scrambling)
+static constexpr size_t BLOCK_LEN = STRIPE_LEN * STRIPES_PER_BLOCK;
+/// @brief The multiplier used when scrambling the accumulators
+static constexpr clt::u32 SCRAMBLE_PRIME = 0x9E3779B1U;
+
+/// @brief Generates the secret using wyrand
+/// @return The secret
+static consteval std::array<clt::u64, SECRET_COUNT> make_secret() noexcept
+{
+  using namespace clt;
+  std::array<u64, SECRET_COUNT> ret{};
+  u64 seed = wyhash_h::SECRET[0];
+  for (auto& i : ret)
+  {
+    seed += wyhash_h::SECRET[0];
+    i = wyhash_h::mix(seed, seed ^ wyhash_h::SECRET[1]);
+  }
+  return ret;
+}
+
+/// @brief The secret: stripe 's' of a block is XORed with SECRET[s..s+8]
+alignas(64) static constexpr std::array<clt::u64, SECRET_COUNT> SECRET =
+    make_secret();
+
+/// @brief Function accumulating 'stripes' stripes of 'ptr' into 'acc'
+using accumulate_t = void (*)(
+    clt::u64* acc, const clt::u8* ptr, const clt::u64* key,
+    size_t stripes) noexcept;
+/// @brief Function scrambling the accumulators 'acc'
+using scramble_t = void (*)(clt::u64* acc, const clt::u64* key) noexcept;
+
+#pragma region // DEFAULT: accumulate scramble
+
+[[maybe_unused]] static void accumulate_default(
+    clt::u64* acc, const clt::u8* ptr, const clt::u64* key,
+    size_t stripes) noexcept
+{
+  using namespace clt;
+  for (size_t s = 0; s < stripes; s++, ptr += STRIPE_LEN)
+  {
+    for (size_t i = 0; i < 8; i++)
+    {
+      u64 data;
+      std::memcpy(&data, ptr + i * sizeof(u64), sizeof(u64));
+      const u64 data_key = data ^ key[s + i];
+      acc[i ^ 1] += data;
+      acc[i] += (data_key & 0xFFFFFFFF) * (data_key >> 32);
+    }
+  }
+}
+
+[[maybe_unused]] static void scramble_default(
+    clt::u64* acc, const clt::u64* key) noexcept
+{
+  for (size_t i = 0; i < 8; i++)
+  {
+    acc[i] ^= acc[i] >> 47;
+    acc[i] ^= key[i];
+    acc[i] *= SCRAMBLE_PRIME;
+  }
+}
+
+#pragma endregion
+
+#if defined(COLT_x86_64)
+
+  #pragma region // accumulate scramble SSE2, AVX2
+
+static COLT_FORCE_SSE2 void accumulate_SSE2(
+    clt::u64* acc, const clt::u8* ptr, const clt::u64* key,
+    size_t stripes) noexcept
+{
+  __m128i vacc[4];
+  for (size_t i = 0; i < 4; i++)
+    vacc[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(acc) + i);
+  for (size_t s = 0; s < stripes; s++, ptr += STRIPE_LEN)
+  {
+    for (size_t i = 0; i < 4; i++)
+    {
+      const __m128i data =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr) + i);
+      const __m128i vkey =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(key + s) + i);
+      const __m128i data_key = _mm_xor_si128(data, vkey);
+      const __m128i product =
+          _mm_mul_epu32(data_key, _mm_srli_epi64(data_key, 32));
+      // Swap the 64-bit halves: acc[i ^ 1] += data[i]
+      const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+      vacc[i] = _mm_add_epi64(vacc[i], _mm_add_epi64(product, swapped));
+    }
+  }
+  for (size_t i = 0; i < 4; i++)
+    _mm_store_si128(reinterpret_cast<__m128i*>(acc) + i, vacc[i]);
+}
+
+static COLT_FORCE_SSE2 void scramble_SSE2(
+    clt::u64* acc, const clt::u64* key) noexcept
+{
+  const __m128i prime = _mm_set1_epi32(SCRAMBLE_PRIME);
+  for (size_t i = 0; i < 4; i++)
+  {
+    auto ptr    = reinterpret_cast<__m128i*>(acc) + i;
+    __m128i val = _mm_load_si128(ptr);
+    val         = _mm_xor_si128(val, _mm_srli_epi64(val, 47));
+    val         = _mm_xor_si128(
+        val, _mm_loadu_si128(reinterpret_cast<const __m128i*>(key) + i));
+    // 64-bit by 32-bit multiplication
+    const __m128i lo = _mm_mul_epu32(val, prime);
+    const __m128i hi = _mm_mul_epu32(_mm_srli_epi64(val, 32), prime);
+    _mm_store_si128(ptr, _mm_add_epi64(lo, _mm_slli_epi64(hi, 32)));
+  }
+}
+
+static COLT_FORCE_AVX2 void accumulate_AVX2(
+    clt::u64* acc, const clt::u8* ptr, const clt::u64* key,
+    size_t stripes) noexcept
+{
+  __m256i vacc[2];
+  for (size_t i = 0; i < 2; i++)
+    vacc[i] = _mm256_load_si256(reinterpret_cast<const __m256i*>(acc) + i);
+  for (size_t s = 0; s < stripes; s++, ptr += STRIPE_LEN)
+  {
+    for (size_t i = 0; i < 2; i++)
+    {
+      const __m256i data =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr) + i);
+      const __m256i vkey =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key + s) + i);
+      const __m256i data_key = _mm256_xor_si256(data, vkey);
+      const __m256i product =
+          _mm256_mul_epu32(data_key, _mm256_srli_epi64(data_key, 32));
+      // Swap the 64-bit halves: acc[i ^ 1] += data[i]
+      const __m256i swapped =
+          _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+      vacc[i] = _mm256_add_epi64(vacc[i], _mm256_add_epi64(product, swapped));
+    }
+  }
+  for (size_t i = 0; i < 2; i++)
+    _mm256_store_si256(reinterpret_cast<__m256i*>(acc) + i, vacc[i]);
+}
+
+static COLT_FORCE_AVX2 void scramble_AVX2(
+    clt::u64* acc, const clt::u64* key) noexcept
+{
+  const __m256i prime = _mm256_set1_epi32(SCRAMBLE_PRIME);
+  for (size_t i = 0; i < 2; i++)
+  {
+    auto ptr    = reinterpret_cast<__m256i*>(acc) + i;
+    __m256i val = _mm256_load_si256(ptr);
+    val         = _mm256_xor_si256(val, _mm256_srli_epi64(val, 47));
+    val         = _mm256_xor_si256(
+        val, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key) + i));
+    // 64-bit by 32-bit multiplication
+    const __m256i lo = _mm256_mul_epu32(val, prime);
+    const __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(val, 32), prime);
+    _mm256_store_si256(ptr, _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32)));
+  }
+}
+
+  #pragma endregion
+
+#elif defined(COLT_ARM_7or8)
+
+  #pragma region // accumulate scramble NEON
+
+static COLT_FORCE_NEON void accumulate_NEON(
+    clt::u64* acc, const clt::u8* ptr, const clt::u64* key,
+    size_t stripes) noexcept
+{
+  uint64x2_t vacc[4];
+  for (size_t i = 0; i < 4; i++)
+    vacc[i] = vld1q_u64(acc + 2 * i);
+  for (size_t s = 0; s < stripes; s++, ptr += STRIPE_LEN)
+  {
+    for (size_t i = 0; i < 4; i++)
+    {
+      const uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(ptr + 16 * i));
+      const uint64x2_t data_key = veorq_u64(data, vld1q_u64(key + s + 2 * i));
+      const uint64x2_t product =
+          vmull_u32(vmovn_u64(data_key), vshrn_n_u64(data_key, 32));
+      // Swap the 64-bit halves: acc[i ^ 1] += data[i]
+      const uint64x2_t swapped = vextq_u64(data, data, 1);
+      vacc[i] = vaddq_u64(vacc[i], vaddq_u64(product, swapped));
+    }
+  }
+  for (size_t i = 0; i < 4; i++)
+    vst1q_u64(acc + 2 * i, vacc[i]);
+}
+
+static COLT_FORCE_NEON void scramble_NEON(
+    clt::u64* acc, const clt::u64* key) noexcept
+{
+  const uint32x2_t prime = vdup_n_u32(SCRAMBLE_PRIME);
+  for (size_t i = 0; i < 4; i++)
+  {
+    uint64x2_t val = vld1q_u64(acc + 2 * i);
+    val            = veorq_u64(val, vshrq_n_u64(val, 47));
+    val            = veorq_u64(val, vld1q_u64(key + 2 * i));
+    // 64-bit by 32-bit multiplication
+    const uint64x2_t lo = vmull_u32(vmovn_u64(val), prime);
+    const uint64x2_t hi = vmull_u32(vshrn_n_u64(val, 32), prime);
+    vst1q_u64(acc + 2 * i, vaddq_u64(lo, vshlq_n_u64(hi, 32)));
+  }
+}
+
+  #pragma endregion
+
+#endif // COLT_x86_64
+
+/// @brief Hashes a big key using ACCUMULATE and SCRAMBLE
+/// @tparam ACCUMULATE The function accumulating stripes
+/// @tparam SCRAMBLE The function scrambling the accumulators
+/// @param key The key to hash
+/// @param len The length in bytes of the key (>= STRIPE_LEN)
+/// @param seed The seed
+/// @return The hash of the key
+template<accumulate_t ACCUMULATE, scramble_t SCRAMBLE>
+static clt::u64 hash_bulk(const void* key, size_t len, clt::u64 seed) noexcept
+{
+  using namespace clt;
+  // The initial values of the accumulators (same as XXH3)
+  alignas(32) u64 acc[8] = {0x00000000C2B2AE3DULL, 0x9E3779B185EBCA87ULL,
+                            0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL,
+                            0x85EBCA77C2B2AE63ULL, 0x0000000085EBCA77ULL,
+                            0x27D4EB2F165667C5ULL, 0x000000009E3779B1ULL};
+  for (auto& i : acc)
+    i ^= seed;
+
+  auto ptr            = static_cast<const u8*>(key);
+  const size_t blocks = (len - 1) / BLOCK_LEN;
+  for (size_t i = 0; i < blocks; i++, ptr += BLOCK_LEN)
+  {
+    ACCUMULATE(acc, ptr, SECRET.data(), STRIPES_PER_BLOCK);
+    SCRAMBLE(acc, SECRET.data() + STRIPES_PER_BLOCK);
+  }
+  // The last stripes, and the last 64 bytes (which may overlap)
+  ACCUMULATE(acc, ptr, SECRET.data(), ((len - 1) % BLOCK_LEN) / STRIPE_LEN);
+  ACCUMULATE(
+      acc, static_cast<const u8*>(key) + len - STRIPE_LEN,
+      SECRET.data() + STRIPES_PER_BLOCK - 1, 1);
+
+  u64 result = len * 0x9E3779B185EBCA87ULL ^ seed;
+  for (size_t i = 0; i < 4; i++)
+    result += wyhash_h::mix(
+        acc[2 * i] ^ SECRET[2 * i], acc[2 * i + 1] ^ SECRET[2 * i + 1]);
+  return wyhash_h::mix(result ^ wyhash_h::SECRET[0], wyhash_h::SECRET[1]);
+}
+
+clt::u64 clt::details::wyhash_bulk(const void* key, size_t len, u64 seed) noexcept
+{
+  using bulk_t = u64 (*)(const void*, size_t, u64) noexcept;
+#if defined(COLT_x86_64)
+  static const bulk_t FN =
+      choose_simd_implementation<simd_flag::AVX2, simd_flag::DEFAULT>{}(
+          &hash_bulk<&accumulate_AVX2, &scramble_AVX2>,
+          &hash_bulk<&accumulate_SSE2, &scramble_SSE2>);
+#elif defined(COLT_ARM_7or8)
+  static const bulk_t FN =
+      choose_simd_implementation<simd_flag::NEON, simd_flag::DEFAULT>{}(
+          &hash_bulk<&accumulate_NEON, &scramble_NEON>,
+          &hash_bulk<&accumulate_default, &scramble_default>);
+#else
+  static constexpr bulk_t FN = &hash_bulk<&accumulate_default, &scramble_default>;
+#endif // COLT_x86_64
+  return (*FN)(key, len, seed);
+}
+
+clt::View<clt::details::wyhash_bulk_t> clt::details::wyhash_bulk_kernels() noexcept
+{
+  struct Kernels
+  {
+    std::array<wyhash_bulk_t, 3> fns;
+    size_t count;
+  };
+  static const Kernels KERNELS = []() noexcept
+  {
+    Kernels ret = {{&hash_bulk<&accumulate_default, &scramble_default>}, 1};
+#if defined(COLT_x86_64)
+    // SSE2 is part of x86_64
+    ret.fns[ret.count++] = &hash_bulk<&accumulate_SSE2, &scramble_SSE2>;
+    if (is_enabled(detect_hardware_architectures(), simd_flag::AVX2))
+      ret.fns[ret.count++] = &hash_bulk<&accumulate_AVX2, &scramble_AVX2>;
+#elif defined(COLT_ARM_7or8)
+    if (is_enabled(detect_hardware_architectures(), simd_flag::NEON))
+      ret.fns[ret.count++] = &hash_bulk<&accumulate_NEON, &scramble_NEON>;
+#endif // COLT_x86_64
+    return ret;
+  }();
+  return {KERNELS.fns.data(), KERNELS.count};
+}
@@ -13,11 +13,56 @@
 #define HG_COLT_HASH
 
 #include <bit>
+#include <array>
 #include <random>
+#include <cstring>
+#include <concepts>
+#include <type_traits>
 #include "typedefs.h"
+#include <colt/coltcpp_export.h>
+
+#ifndef COLT_DEFAULT_HASH_ALGORITHM
+  /// @brief The hashing algorithm used by default by the hash containers
+  /// (Map, Set, FlatMap, TrieMap...) and StringInterner.
+  /// It can be defined (for the whole project, on the command line)
+  /// to another algorithm, such as clt::murmur64a_h.
+  #define COLT_DEFAULT_HASH_ALGORITHM clt::wyhash_h
+#endif // !COLT_DEFAULT_HASH_ALGORITHM
 
 namespace clt
 {
+  // All the algorithms below hash bytes through 'operator()(const u8*, size_t)'
+  // which is usable in constant evaluation (and gives the same result as at
+  // runtime). The 'const void*' overload is the runtime interface.
+  // To hash objects other than bytes at compile-time, see 'hash_units'.
+
+  namespace details
+  {
+    template<std::unsigned_integral T>
+    /// @brief Unaligned read of an integer (in host endianness).
+    /// In constant evaluation, the integer is assembled byte per byte.
+    /// @tparam T The unsigned integer type
+    /// @param ptr The pointer from which to read
+    /// @return The integer read
+    constexpr T load_unaligned(const u8* ptr) noexcept
+    {
+      if (std::is_constant_evaluated())
+      {
+        T value = 0;
+        for (size_t i = 0; i < sizeof(T); i++)
+        {
+          const size_t byte =
+              std::endian::native == std::endian::little ? i : sizeof(T) - 1 - i;
+          value |= static_cast<T>(ptr[i]) << (8 * byte);
+        }
+        return value;
+      }
+      T value;
+      std::memcpy(&value, ptr, sizeof(T));
+      return value;
+    }
+  } // namespace details
+
   /// @brief Hash Algorithm that makes use of FNV1a
   class fnv1a_h
   {
@@ -31,24 +76,33 @@ namespace clt
     /// @brief Hashes bytes
     /// @param key The key to hash
     /// @param len The length in bytes
-    constexpr void operator()(const void* key, size_t len) noexcept
+    constexpr void operator()(const u8* key, size_t len) noexcept
     {
-      auto p = static_cast<const u8*>(key);
-      auto e = p + len;
-      for (; p < e; ++p)
-        state_ = (state_ ^ *p) * 1099511628211u;
+      for (auto end = key + len; key != end; ++key)
+        state_ = (state_ ^ *key) * 1099511628211u;
+    }
+
+    /// @brief Hashes bytes
+    /// @param key The key to hash
+    /// @param len The length in bytes
+    void operator()(const void* key, size_t len) noexcept
+    {
+      (*this)(static_cast<const u8*>(key), len);
     }
 
     /// @brief Returns the result of hashing
-    explicit operator result_type() const noexcept { return state_; }
+    constexpr explicit operator result_type() const noexcept { return state_; }
   };
 
-  /// @brief Hash Algorithm that makes use of MurmurHash64a
+  /// @brief Hash Algorithm that makes use of MurmurHash64a.
+  /// Each call is seeded by the result of the previous one, so that
+  /// hashing multiple fields gives a different result than hashing
+  /// their concatenation.
   class murmur64a_h
   {
     /// @brief The state
     u64 h = 0;
-    /// @brief The seed
+    /// @brief The seed (of the next call)
     u64 seed;
 
     HEDLEY_ALWAYS_INLINE
@@ -101,27 +155,16 @@ namespace clt
     {
     }
 
-    /// @brief Hashes bytes
+    /// @brief Hashes bytes.
+    /// The result does not depend on the alignment of 'key'.
     /// @param key The key to hash
     /// @param len The length in bytes
-    void operator()(const void* key, size_t len) noexcept
+    constexpr void operator()(const u8* key, size_t len) noexcept
     {
-      h               = seed ^ (len * m);
-      auto ptr        = (const u8*)key;
-      const u64 left  = uintptr_t(ptr) % 8;
-      const u64 right = (len - left) % 8;
-      size_t i        = 0;
-
-      unaligned_xor(ptr, left, h);
-      i += left;
-
-      h ^= h >> r;
-      h *= m;
-      h ^= h >> r;
-
-      for (; i < len; i += sizeof(u64))
+      h = seed ^ (len * m);
+      for (auto end = key + (len & ~size_t(7)); key != end; key += sizeof(u64))
       {
-        uint64_t k = *reinterpret_cast<const u64*>(ptr + i);
+        u64 k = details::load_unaligned<u64>(key);
         k *= m;
         k ^= k >> r;
         k *= m;
@@ -130,15 +173,24 @@ namespace clt
         h *= m;
       }
 
-      unaligned_xor(ptr + i, right, h);
+      unaligned_xor(key, len & 7, h);
 
       h ^= h >> r;
       h *= m;
       h ^= h >> r;
+      seed = h;
+    }
+
+    /// @brief Hashes bytes
+    /// @param key The key to hash
+    /// @param len The length in bytes
+    void operator()(const void* key, size_t len) noexcept
+    {
+      (*this)(static_cast<const u8*>(key), len);
     }
 
     /// @brief Returns the result of hashing
-    explicit operator result_type() const noexcept { return h; }
+    constexpr explicit operator result_type() const noexcept { return h; }
   };
 
   /// @brief Hash Algorithm that makes use of SipHash-2-4
@@ -239,44 +291,234 @@ namespace clt
             | u64(key[14]) << 8 | u64(key[15]);
     }
 
-    /// @brief Hashes bytes
+    /// @brief Hashes bytes.
+    /// The result does not depend on the alignment of 'key'.
     /// @param key The key to hash
     /// @param len The length in bytes of the key
-    void operator()(const void* key, size_t len) noexcept
+    constexpr void operator()(const u8* key, size_t len) noexcept
     {
-      auto ptr = static_cast<const u8*>(key);
-
-      const u64 left  = uintptr_t(ptr) % 8;
-      const u64 right = (len - left) % 8;
-      size_t i        = 0;
-      auto b          = len << 56;
-
-      unaligned_or(ptr, left, b);
-      v3 ^= b;
-      for (u64 r = 0; r < dROUNDS; ++r)
-        apply_round(*this);
-      v0 ^= b;
-      i += left;
-
-      for (; i < len; i += sizeof(u64))
+      for (auto end = key + (len & ~size_t(7)); key != end; key += sizeof(u64))
       {
-        u64 m = *reinterpret_cast<const u64*>(ptr + i);
+        const u64 m = details::load_unaligned<u64>(key);
         v3 ^= m;
         for (u64 r = 0; r < cROUNDS; ++r)
           apply_round(*this);
         v0 ^= m;
       }
 
-      unaligned_or(ptr + i, right, b);
+      // The last block contains the remaining bytes and the length
+      u64 b = static_cast<u64>(len) << 56;
+      unaligned_or(key, len & 7, b);
       v3 ^= b;
-      for (u64 r = 0; r < dROUNDS; ++r)
+      for (u64 r = 0; r < cROUNDS; ++r)
         apply_round(*this);
       v0 ^= b;
+
       v2 ^= 0xff;
+      for (u64 r = 0; r < dROUNDS; ++r)
+        apply_round(*this);
+    }
+
+    /// @brief Hashes bytes
+    /// @param key The key to hash
+    /// @param len The length in bytes of the key
+    void operator()(const void* key, size_t len) noexcept
+    {
+      (*this)(static_cast<const u8*>(key), len);
     }
 
     /// @brief Returns the result of hashing
-    explicit operator result_type() const noexcept { return v0 ^ v1 ^ v2 ^ v3; }
+    constexpr explicit operator result_type() const noexcept
+    {
+      return v0 ^ v1 ^ v2 ^ v3;
+    }
+  };
+
+  namespace details
+  {
+    /// @brief Hashes a big key using the SIMD extensions of the CPU.
+    /// This is the bulk path of wyhash_h, selected at runtime on the first
+    /// call (AVX2 or SSE2 on x86_64, NEON on ARM).
+    /// @param key The key to hash
+    /// @param len The length in bytes of the key (>= wyhash_h::BULK_SIZE)
+    /// @param seed The seed
+    /// @return The hash of the key
+    COLTCPP_EXPORT u64 wyhash_bulk(const void* key, size_t len, u64 seed) noexcept;
+
+    /// @brief A bulk path of wyhash_h (see 'wyhash_bulk')
+    using wyhash_bulk_t = u64 (*)(const void* key, size_t len, u64 seed) noexcept;
+
+    /// @brief Returns every bulk path of wyhash_h compiled for the current
+    /// architecture and supported by the CPU, starting with the scalar one.
+    /// This is meant for tests: all of them must return the same hash.
+    /// @return The bulk paths
+    COLTCPP_EXPORT View<wyhash_bulk_t> wyhash_bulk_kernels() noexcept;
+  } // namespace details
+
+  /// @brief Hash Algorithm that makes use of wyhash (final version 4).
+  /// Keys of at least BULK_SIZE bytes are hashed using an XXH3-like
+  /// accumulation over 8 lanes (vectorized using AVX2, SSE2 or NEON),
+  /// whose accumulators are then mixed using wyhash: such keys cannot
+  /// be hashed in constant evaluation.
+  /// Each call is seeded by the result of the previous one, so that
+  /// hashing multiple fields gives a different result than hashing
+  /// their concatenation.
+  class wyhash_h
+  {
+    /// @brief The state (the seed of the next call)
+    u64 state;
+
+    HEDLEY_ALWAYS_INLINE
+    /// @brief Multiplies two 64-bit integers to a 128-bit integer
+    /// @param a The first integer (receives the low bits)
+    /// @param b The second integer (receives the high bits)
+    static constexpr void mum(u64& a, u64& b) noexcept
+    {
+#ifdef __SIZEOF_INT128__
+      __extension__ using u128 = unsigned __int128;
+
+      u128 r = a;
+      r *= b;
+      a = static_cast<u64>(r);
+      b = static_cast<u64>(r >> 64);
+#else
+      const u64 ha = a >> 32, hb = b >> 32, la = (u32)a, lb = (u32)b;
+      const u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+      const u64 t  = rl + (rm0 << 32);
+      u64 c        = t < rl;
+      const u64 lo = t + (rm1 << 32);
+      c += lo < t;
+      a = lo;
+      b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif // __SIZEOF_INT128__
+    }
+
+    HEDLEY_ALWAYS_INLINE
+    /// @brief Unaligned read of 8 bytes
+    /// @param ptr The pointer from which to read
+    /// @return The bytes read
+    static constexpr u64 read8(const u8* ptr) noexcept
+    {
+      return details::load_unaligned<u64>(ptr);
+    }
+
+    HEDLEY_ALWAYS_INLINE
+    /// @brief Unaligned read of 4 bytes
+    /// @param ptr The pointer from which to read
+    /// @return The bytes read
+    static constexpr u64 read4(const u8* ptr) noexcept
+    {
+      return details::load_unaligned<u32>(ptr);
+    }
+
+    /// @brief Hashes a key of less than BULK_SIZE bytes
+    /// @param ptr The key to hash
+    /// @param len The length in bytes of the key
+    /// @param seed The seed
+    /// @return The hash of the key
+    static constexpr u64 hash(const u8* ptr, size_t len, u64 seed) noexcept
+    {
+      seed ^= mix(seed ^ SECRET[0], SECRET[1]);
+      u64 a, b;
+      if (HEDLEY_LIKELY(len <= 16))
+      {
+        if (HEDLEY_LIKELY(len >= 4))
+        {
+          const size_t mid = (len >> 3) << 2;
+          a = (read4(ptr) << 32) | read4(ptr + mid);
+          b = (read4(ptr + len - 4) << 32) | read4(ptr + len - 4 - mid);
+        }
+        else if (HEDLEY_LIKELY(len > 0))
+        {
+          a = ((u64)ptr[0] << 16) | ((u64)ptr[len >> 1] << 8) | ptr[len - 1];
+          b = 0;
+        }
+        else
+          a = b = 0;
+      }
+      else
+      {
+        size_t i = len;
+        if (HEDLEY_UNLIKELY(i > 48))
+        {
+          u64 see1 = seed, see2 = seed;
+          do
+          {
+            seed = mix(read8(ptr) ^ SECRET[1], read8(ptr + 8) ^ seed);
+            see1 = mix(read8(ptr + 16) ^ SECRET[2], read8(ptr + 24) ^ see1);
+            see2 = mix(read8(ptr + 32) ^ SECRET[3], read8(ptr + 40) ^ see2);
+            ptr += 48;
+            i -= 48;
+          } while (HEDLEY_LIKELY(i > 48));
+          seed ^= see1 ^ see2;
+        }
+        while (HEDLEY_UNLIKELY(i > 16))
+        {
+          seed = mix(read8(ptr) ^ SECRET[1], read8(ptr + 8) ^ seed);
+          i -= 16;
+          ptr += 16;
+        }
+        a = read8(ptr + i - 16);
+        b = read8(ptr + i - 8);
+      }
+      a ^= SECRET[1];
+      b ^= seed;
+      mum(a, b);
+      return mix(a ^ SECRET[0] ^ len, b ^ SECRET[1]);
+    }
+
+  public:
+    /// @brief The result type of hashing
+    using result_type = size_t;
+
+    /// @brief The default secret of wyhash
+    static constexpr u64 SECRET[4] = {
+        0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull,
+        0x589965cc75374cc3ull};
+
+    /// @brief Keys of at least BULK_SIZE bytes are hashed using SIMD
+    static constexpr size_t BULK_SIZE = 1024;
+
+    /// @brief Constructor
+    /// @param seed The starting seed
+    constexpr wyhash_h(u64 seed = 0) noexcept
+        : state(seed)
+    {
+    }
+
+    HEDLEY_ALWAYS_INLINE
+    /// @brief Mixes two 64-bit integers (folded 128-bit multiplication)
+    /// @param a The first integer
+    /// @param b The second integer
+    /// @return The mixed result
+    static constexpr u64 mix(u64 a, u64 b) noexcept
+    {
+      mum(a, b);
+      return a ^ b;
+    }
+
+    /// @brief Hashes bytes.
+    /// In constant evaluation, 'len' must be less than BULK_SIZE.
+    /// @param key The key to hash
+    /// @param len The length in bytes
+    constexpr void operator()(const u8* key, size_t len) noexcept
+    {
+      if (HEDLEY_UNLIKELY(len >= BULK_SIZE))
+        state = details::wyhash_bulk(key, len, state);
+      else
+        state = hash(key, len, state);
+    }
+
+    /// @brief Hashes bytes
+    /// @param key The key to hash
+    /// @param len The length in bytes
+    void operator()(const void* key, size_t len) noexcept
+    {
+      (*this)(static_cast<const u8*>(key), len);
+    }
+
+    /// @brief Returns the result of hashing
+    constexpr explicit operator result_type() const noexcept { return state; }
   };
 
   namespace meta
@@ -294,6 +536,43 @@ namespace clt
         };
   } // namespace meta
 
+  template<meta::hash_algorithm Algo, typename T>
+  /// @brief Hashes the object representation of 'count' objects.
+  /// Contrary to calling 'algo(ptr, count * sizeof(T))', this is usable in
+  /// constant evaluation (if the algorithm is): the objects are then
+  /// decomposed into bytes (using std::bit_cast) and the result is the same
+  /// as at runtime.
+  /// @tparam Algo The hashing algorithm
+  /// @tparam T The type of the objects (which must be trivially copyable)
+  /// @param algo The hashing algorithm object
+  /// @param ptr The beginning of the objects
+  /// @param count The count of objects
+  constexpr void hash_units(Algo& algo, const T* ptr, size_t count) noexcept
+  {
+    static_assert(
+        std::is_trivially_copyable_v<T>, "Only object representations are hashed!");
+    if constexpr (std::same_as<T, u8>)
+      algo(ptr, count);
+    else
+    {
+      if (std::is_constant_evaluated())
+      {
+        // (transient allocation: freed before the end of constant evaluation)
+        u8* bytes = new u8[count * sizeof(T)];
+        for (size_t i = 0; i < count; i++)
+        {
+          const auto repr = std::bit_cast<std::array<u8, sizeof(T)>>(ptr[i]);
+          for (size_t j = 0; j < sizeof(T); j++)
+            bytes[i * sizeof(T) + j] = repr[j];
+        }
+        algo(static_cast<const u8*>(bytes), count * sizeof(T));
+        delete[] bytes;
+      }
+      else
+        algo(static_cast<const void*>(ptr), count * sizeof(T));
+    }
+  }
+
   /// @brief Hash Append function must be overloaded for each hashable type.
   /// The goal of this function is to expose which data to hash using Algo.
   /// @tparam Algo The hashing algorithm
@@ -321,22 +600,53 @@ namespace clt
     {
     };
 
+    /// @brief Enums are hashed as their underlying type
+    /// @tparam T The type
+    template<typename T>
+      requires std::is_enum_v<T>
+    struct is_contiguously_hashable<T> : public std::true_type
+    {
+    };
+
     /// @brief Shorthand for is_contiguously_hashable<T>::value
     /// @tparam T The type
     template<typename T>
     static constexpr bool is_contiguously_hashable_v =
         is_contiguously_hashable<T>::value;
 
+    /// @brief Arrays of contiguously hashable types are contiguously hashable
+    /// @tparam T The type of the elements
+    /// @tparam N The count of elements
+    template<typename T, size_t N>
+    struct is_contiguously_hashable<T[N]>
+        : public std::bool_constant<is_contiguously_hashable_v<T>>
+    {
+    };
+
+    /// @brief Arrays of contiguously hashable types are contiguously hashable
+    /// @tparam T The type of the elements
+    /// @tparam N The count of elements
+    template<typename T, size_t N>
+    struct is_contiguously_hashable<std::array<T, N>>
+        : public std::bool_constant<
+              is_contiguously_hashable_v<T>
+              && sizeof(std::array<T, N>) == N * sizeof(T)>
+    {
+    };
+
     /// @brief Shorthand for is_contiguously_hashable<T>::value
     template<typename T>
     concept contiguously_hashable = is_contiguously_hashable_v<T>;
 
-    /// @brief Check if a type is can be hashed
+    /// @brief Check if a type is can be hashed.
+    /// 'hash_append' is found through ADL (on the algorithm) so that the
+    /// overloads declared after this concept (such as the one of reflected
+    /// types) are considered.
     template<typename T>
     concept hashable =
         contiguously_hashable<T> || requires(const T& value, fnv1a_h a) {
           {
-            clt::hash_append(a, value)
+            hash_append(a, value)
           } -> std::same_as<void>;
         };
   } // namespace meta
@@ -350,7 +660,7 @@ namespace clt
   template<meta::hash_algorithm Algo, meta::contiguously_hashable T>
   constexpr void hash_append(Algo& h, const T& v)
   {
-    h(std::addressof(v), sizeof(v));
+    hash_units(h, std::addressof(v), 1);
   }
 
   /// @brief Hash Append for floating point types.
@@ -362,9 +672,8 @@ namespace clt
   template<meta::hash_algorithm Algo, std::floating_point T>
   constexpr void hash_append(Algo& h, const T& v)
   {
-    if (v == static_cast<T>(0))
-      v = static_cast<T>(0);
-    h(std::addressof(v), sizeof(v));
+    const T value = v == static_cast<T>(0) ? static_cast<T>(0) : v;
+    hash_units(h, std::addressof(value), 1);
   }
 
   /// @brief Universal hasher.
@@ -387,7 +696,24 @@ namespace clt
       hash_append(h, t);
       return static_cast<result_type>(h);
     }
+
+    /// @brief Hashes an array of contiguously hashable objects.
+    /// This is the interface expected by TrieMap and TrieSet.
+    /// @tparam T The type of the objects
+    /// @param ptr The beginning of the array
+    /// @param size The count of objects in the array
+    /// @return The hash of the array
+    template<meta::contiguously_hashable T>
+    constexpr result_type operator()(const T* ptr, size_t size) const noexcept
+    {
+      HashAlgorithm h;
+      hash_units(h, ptr, size);
+      return static_cast<result_type>(h);
+    }
   };
+
+  /// @brief The universal hasher used by default by the hash containers
+  using default_hash = uhash<COLT_DEFAULT_HASH_ALGORITHM>;
 } // namespace clt
 
 #endif // !HG_COLT_HASH
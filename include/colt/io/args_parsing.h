@@ -12,6 +12,12 @@
  * value_desc<> is the description of the value to receive by the option.
  * alias<> is an alias name for the option.
  * 
+ * Options and aliases are looked up in a meta::Map, for which a perfect
+ * hash is generated at compile-time: parsing does not allocate (except
+ * when parsing values whose type allocates, such as std::string).
+ * An argument '@path' is replaced by the arguments contained in the
+ * response file 'path' (separated by whitespaces, see ArgumentStream).
+ * 
  * @code{.cpp}
  * using Args = meta::type_list<
  *   Opt<"test", callback<[](){ ... }>>,
@@ -33,8 +39,10 @@
 
 #include "colt/io/print.h"
 #include "colt/io/parse.h"
+#include "colt/io/mmap.h"
 #include "colt/typedefs.h"
 #include "colt/meta/string_literal.h"
+#include "colt/meta/string_switch.h"
 #include "colt/meta/traits.h"
 
 namespace clt::cl
@@ -562,9 +570,177 @@ namespace clt::cl
       std::exit(0);
     }
 
+    /// @brief The maximum count of response files that can be read
+    inline constexpr size_t MAX_RESPONSE_FILES = 256;
+
+    /// @brief Maps a response file for the rest of the program.
+    /// Its arguments are views of the mapping (as the arguments of the
+    /// program are views of argv), so that they can be stored as views
+    /// by the options: the mapping is thus never unmapped.
+    /// @param path The path of the file
+    /// @return None on errors, else the content of the file
+    inline Option<Span<char>> map_response_file(const char* path) noexcept
+    {
+      static std::array<ViewOfFile, MAX_RESPONSE_FILES> FILES;
+      static size_t count = 0;
+      if (count == FILES.size())
+        return None;
+      // The arguments are unquoted in place: as the mapping is copy-on-write,
+      // only the pages containing quotes or backslashes are copied.
+      auto view = ViewOfFile::open(path, ViewOfFile::CopyOnWrite);
+      if (view.is_none())
+        return None;
+      FILES[count] = std::move(*view);
+      auto bytes   = FILES[count++].span();
+      return Span<char>{ptr_to<char*>(bytes.data()), bytes.size()};
+    }
+
+    /// @brief The arguments to parse: the arguments of the program, in which
+    /// the response files ('@path') are expanded (recursively).
+    /// The arguments of a response file are separated by whitespaces.
+    /// Quotes (single or double) can be used to include whitespaces in an
+    /// argument, and a backslash escapes the next character (except in
+    /// single quotes).
+    class ArgumentStream
+    {
+      /// @brief The maximum nesting of response files
+      static constexpr size_t MAX_DEPTH = 16;
+      /// @brief The maximum size of the path of a response file
+      static constexpr size_t MAX_PATH_SIZE = 4096;
+
+      /// @brief The arguments of the program
+      const char** argv;
+      /// @brief The count of arguments of the program
+      u64 argc;
+      /// @brief The index of the next argument of the program
+      u64 index = 1;
+      /// @brief The rest of each of the response files being read
+      std::array<Span<char>, MAX_DEPTH> files{};
+      /// @brief The count of response files being read
+      size_t depth = 0;
+      /// @brief True if response files are expanded
+      bool expand = true;
+
+      /// @brief Check if a character separates arguments
+      /// @param chr The character
+      /// @return True if whitespace
+      static constexpr bool is_space(char chr) noexcept
+      {
+        return chr == ' ' || chr == '\t' || chr == '\n' || chr == '\r'
+               || chr == '\v' || chr == '\f';
+      }
+
+      /// @brief Extracts the next argument of a response file.
+      /// The quotes and backslashes are removed in place.
+      /// @param rest The rest of the file (which is updated)
+      /// @return None if the file does not contain more arguments
+      static Option<std::string_view> next_token(Span<char>& rest) noexcept
+      {
+        size_t i = 0;
+        while (i < rest.size() && is_space(rest[i]))
+          ++i;
+        if (i == rest.size())
+          return None;
+
+        char* const start = rest.data() + i;
+        char* write       = start;
+        char quote        = 0;
+        for (; i < rest.size(); i++)
+        {
+          char chr = rest[i];
+          if (quote == 0 && is_space(chr))
+            break;
+          if (quote != 0 && chr == quote)
+          {
+            quote = 0;
+            continue;
+          }
+          if (quote == 0 && (chr == '"' || chr == '\''))
+          {
+            quote = chr;
+            continue;
+          }
+          if (chr == '\\' && quote != '\'' && i + 1 < rest.size())
+            chr = rest[++i];
+          // Arguments without quotes or backslashes are never written to
+          if (write != rest.data() + i)
+            *write = chr;
+          ++write;
+        }
+        rest = rest.subspan(clt::min(i + 1, rest.size()));
+        return std::string_view{start, static_cast<size_t>(write - start)};
+      }
+
+      /// @brief Starts reading a response file
+      /// @param path The path of the response file
+      void push_response_file(std::string_view path) noexcept
+      {
+        if (depth == MAX_DEPTH)
+        {
+          print_error("Response files are nested too deeply ('@{}')!", path);
+          std::exit(1);
+        }
+        std::array<char, MAX_PATH_SIZE> buffer;
+        if (path.size() >= buffer.size())
+        {
+          print_error("Path of response file '{}' is too long!", path);
+          std::exit(1);
+        }
+        std::copy(path.begin(), path.end(), buffer.begin());
+        buffer[path.size()] = '\0';
+        auto content        = map_response_file(buffer.data());
+        if (content.is_none())
+        {
+          print_error("Could not read response file '{}'!", path);
+          std::exit(1);
+        }
+        files[depth++] = *content;
+      }
+
+    public:
+      /// @brief Constructor
+      /// @param argc The count of arguments of the program
+      /// @param argv The arguments (the first of which is skipped)
+      constexpr ArgumentStream(u64 argc, const char** argv) noexcept
+          : argv(argv)
+          , argc(argc)
+      {
+      }
+
+      /// @brief Stops expanding response files (after '--')
+      void stop_expanding() noexcept { expand = false; }
+
+      /// @brief Returns the next argument to parse
+      /// @return None if there are no more arguments
+      Option<std::string_view> next() noexcept
+      {
+        while (true)
+        {
+          std::string_view arg;
+          if (depth != 0)
+          {
+            auto token = next_token(files[depth - 1]);
+            if (token.is_none())
+            {
+              --depth;
+              continue;
+            }
+            arg = *token;
+          }
+          else if (index < argc)
+            arg = argv[index++];
+          else
+            return None;
+
+          if (!expand || arg.size() < 2 || arg.front() != '@')
+            return arg;
+          push_response_file(arg.substr(1));
+        }
+      }
+    };
+
     void handle_non_positional(
-        std::string_view arg, u64& i, u64 argc, const char** argv,
-        auto& CONST_MAP) noexcept
+        std::string_view arg, ArgumentStream& args, auto& CONST_MAP) noexcept
     {
       arg.remove_prefix(1); // pop '-'
       std::string_view to_parse = arg;
@@ -580,16 +756,19 @@ namespace clt::cl
           return;
         }
 
-        //not enough arguments...
-        if (equal_index == std::string_view::npos && i == argc - 1)
-        {
-          print_error("'{}' expects an argument!", arg);
-          std::exit(1);
-        }
         //invoke callback...
         ParsingResult err;
         if (equal_index == std::string_view::npos)
-          err = (*(*opt).second)(argv[++i]);
+        {
+          auto value = args.next();
+          //not enough arguments...
+          if (value.is_none())
+          {
+            print_error("'{}' expects an argument!", arg);
+            std::exit(1);
+          }
+          err = (*(*opt).second)(*value);
+        }
         else
           err = (*(*opt).second)(arg.substr(equal_index + 1));
 
@@ -640,6 +819,9 @@ namespace clt::cl
     //Positional argument table, contains pointers to the function to call
     //when a non-positional argument is detected.
     static constexpr meta::Map CONST_MAP = details::generate_opt_table(OptList{});
+    static_assert(
+        CONST_MAP.hash.is_valid,
+        "No perfect hash found for the options with any seed!");
     //Positional argument table, contains pointers to the function to call
     //when a positional argument is detected.
     static constexpr auto POS_TABLE =
@@ -647,26 +829,29 @@ namespace clt::cl
 
     u64 pos_id          = 0;
     bool is_parsing_pos = false;
-    for (u64 i = 1; i < static_cast<u64>(argc); i++)
+    details::ArgumentStream args = {static_cast<u64>(argc), argv};
+    for (auto next = args.next(); next.is_value(); next = args.next())
     {
-      std::string_view arg = argv[i];
+      std::string_view arg = *next;
       if (arg.empty() || arg.front() != '-' || is_parsing_pos)
         details::handle_positional(arg, pos_id, POS_TABLE);
       else
       {
-        if (arg == "--")
+        using Builtin = meta::string_switch<"--", "-help">;
+        switch (Builtin::match(arg))
         {
+        case Builtin::index_of<"--">:
           is_parsing_pos = true;
-          continue;
-        }
-
-        if (arg == "-help")
+          args.stop_expanding();
+          break;
+        case Builtin::index_of<"-help">:
           details::print_help(
               OptList{}, PosList{}, OptPosList{}, OptGroupList{}, name,
               description);
-        else
-          details::handle_non_positional(
-              arg, i, static_cast<u64>(argc), argv, CONST_MAP);
+          break;
+        default:
+          details::handle_non_positional(arg, args, CONST_MAP);
+        }
       }
     }
     if (pos_id < PosList::size)
@@ -0,0 +1,673 @@
+#include "async_io.h"
+#include <colt/num/math.h>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#ifdef COLT_LINUX
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <sys/syscall.h>
+  #include <linux/io_uring.h>
+#endif // COLT_LINUX
+
+namespace clt::details
+{
+  /// @brief The maximum count of bytes of a single read or write
+  static constexpr size_t MAX_ASYNC_IO_SIZE = 0x7FFFF000;
+
+  /// @brief A queued request
+  struct AsyncIORequest
+  {
+    /// @brief The kind of request
+    IORequestKind kind;
+    /// @brief The access of the file
+    File::FileAccess access;
+    /// @brief The file number (unused for opens)
+    int fd;
+    /// @brief The path (for opens)
+    const char* path;
+    /// @brief The buffer (for reads and writes)
+    u8* buffer;
+    /// @brief The size of the buffer
+    size_t size;
+    /// @brief The offset in the file
+    u64 offset;
+    /// @brief The value returned in the completion
+    u64 user_data;
+  };
+
+  /// @brief Interface of the backends
+  class AsyncIOImpl
+  {
+  protected:
+    /// @brief Creates a File from a file number
+    /// @param fd The file number
+    /// @param access The access of the file
+    /// @return The file
+    static File make_file(int fd, File::FileAccess access) noexcept
+    {
+      return File{fd, access};
+    }
+
+  public:
+    virtual ~AsyncIOImpl() noexcept = default;
+
+    /// @brief Returns the backend
+    virtual AsyncIOBackend backend() const noexcept = 0;
+    /// @brief Returns the capacity
+    virtual size_t capacity() const noexcept = 0;
+    /// @brief Returns the count of pending requests
+    virtual size_t pending() const noexcept = 0;
+    /// @brief Queues a request
+    /// @return False if full
+    virtual bool queue(const AsyncIORequest& request) noexcept = 0;
+    /// @brief Submits the queued requests
+    virtual size_t submit() noexcept = 0;
+    /// @brief Obtains the available completions
+    virtual size_t poll(Span<IOCompletion> out) noexcept = 0;
+    /// @brief Waits for at least 'min_count' completions
+    virtual size_t wait(Span<IOCompletion> out, size_t min_count) noexcept = 0;
+
+    /// @brief Waits for all the pending requests
+    void drain() noexcept
+    {
+      IOCompletion buffer[32];
+      // (no completions are obtained if the backend failed)
+      while (pending() != 0)
+        if (wait(buffer, pending()) == 0)
+          break;
+    }
+  };
+
+  /// @brief Executes the requests using blocking I/O on a pool of threads
+  class ThreadPoolAsyncIO final : public AsyncIOImpl
+  {
+    /// @brief The maximum count of pending requests
+    const size_t max_pending;
+    /// @brief The requests that were queued but not submitted
+    std::vector<AsyncIORequest> queued;
+    /// @brief Protects 'work', 'done' and 'stop'
+    std::mutex mutex;
+    /// @brief Notified when requests are submitted
+    std::condition_variable has_work;
+    /// @brief Notified when requests complete
+    std::condition_variable has_done;
+    /// @brief The submitted requests
+    std::deque<AsyncIORequest> work;
+    /// @brief The completions that were not obtained
+    std::vector<IOCompletion> done;
+    /// @brief The count of submitted requests whose completion was not obtained
+    std::atomic<size_t> in_flight = 0;
+    /// @brief True if the threads must stop
+    bool stop = false;
+    /// @brief The threads
+    std::vector<std::thread> threads;
+
+    /// @brief Returns the negation of errno (or -1 if not set)
+    /// @return Negative error code
+    static i64 error_code() noexcept { return errno != 0 ? -errno : -1; }
+
+    /// @brief Executes a request
+    /// @param request The request to execute
+    /// @return The completion
+    static IOCompletion execute(const AsyncIORequest& request) noexcept
+    {
+      IOCompletion ret = {request.user_data, 0, request.kind, request.access};
+      errno            = 0;
+      switch_no_default(request.kind)
+      {
+      case IORequestKind::Open:
+        if (auto file = File::open(request.path, request.access); file.is_value())
+          ret.result = file->fileno();
+        else
+          ret.result = error_code();
+        break;
+      case IORequestKind::Read:
+        if (auto read = make_file(request.fd, File::Read)
+                            .read_at({request.buffer, request.size}, request.offset);
+            read.is_value())
+          ret.result = static_cast<i64>(*read);
+        else
+          ret.result = error_code();
+        break;
+      case IORequestKind::Write:
+        if (auto write =
+                make_file(request.fd, File::Write)
+                    .write_at({request.buffer, request.size}, request.offset);
+            write.is_value())
+          ret.result = static_cast<i64>(*write);
+        else
+          ret.result = error_code();
+        break;
+      case IORequestKind::Close:
+        make_file(request.fd, request.access).close();
+        break;
+      }
+      return ret;
+    }
+
+    /// @brief The function executed by the threads
+    void worker() noexcept
+    {
+      auto lock = std::unique_lock{mutex};
+      while (true)
+      {
+        has_work.wait(lock, [this]() { return stop || !work.empty(); });
+        if (work.empty())
+          return;
+        auto request = work.front();
+        work.pop_front();
+        lock.unlock();
+        auto completion = execute(request);
+        lock.lock();
+        done.push_back(completion);
+        has_done.notify_all();
+      }
+    }
+
+    /// @brief Moves the completions to 'out'
+    /// @param out Where to write the completions
+    /// @return The count of completions written
+    size_t harvest(Span<IOCompletion> out) noexcept
+    {
+      const size_t count = clt::min(out.size(), done.size());
+      std::memcpy(
+          out.data(), done.data() + done.size() - count,
+          count * sizeof(IOCompletion));
+      done.resize(done.size() - count);
+      in_flight -= count;
+      return count;
+    }
+
+  public:
+    /// @brief Constructor
+    /// @param capacity The maximum count of pending requests
+    /// @param thread_count The count of threads
+    ThreadPoolAsyncIO(size_t capacity, u32 thread_count) noexcept
+        : max_pending(capacity)
+    {
+      queued.reserve(capacity);
+      done.reserve(capacity);
+      for (u32 i = 0; i < clt::max(thread_count, 1U); i++)
+        threads.emplace_back([this]() { worker(); });
+    }
+
+    ~ThreadPoolAsyncIO() noexcept override
+    {
+      drain();
+      {
+        auto lock = std::scoped_lock{mutex};
+        stop      = true;
+      }
+      has_work.notify_all();
+      for (auto& thread : threads)
+        thread.join();
+    }
+
+    AsyncIOBackend backend() const noexcept override
+    {
+      return AsyncIOBackend::ThreadPool;
+    }
+    size_t capacity() const noexcept override { return max_pending; }
+    size_t pending() const noexcept override { return queued.size() + in_flight; }
+
+    bool queue(const AsyncIORequest& request) noexcept override
+    {
+      if (pending() == max_pending)
+        return false;
+      queued.push_back(request);
+      return true;
+    }
+
+    size_t submit() noexcept override
+    {
+      const size_t count = queued.size();
+      if (count == 0)
+        return 0;
+      {
+        auto lock = std::scoped_lock{mutex};
+        work.insert(work.end(), queued.begin(), queued.end());
+      }
+      in_flight += count;
+      queued.clear();
+      has_work.notify_all();
+      return count;
+    }
+
+    size_t poll(Span<IOCompletion> out) noexcept override
+    {
+      auto lock = std::scoped_lock{mutex};
+      return harvest(out);
+    }
+
+    size_t wait(Span<IOCompletion> out, size_t min_count) noexcept override
+    {
+      submit();
+      min_count = clt::min({min_count, out.size(), pending()});
+      auto lock = std::unique_lock{mutex};
+      has_done.wait(lock, [&]() { return done.size() >= min_count; });
+      return harvest(out);
+    }
+  };
+
+#ifdef COLT_LINUX
+  /// @brief Executes the requests using io_uring
+  class IOUringAsyncIO final : public AsyncIOImpl
+  {
+    /// @brief A memory mapping of the ring
+    struct Mapping
+    {
+      /// @brief The start of the mapping (or null)
+      void* ptr = nullptr;
+      /// @brief The size of the mapping
+      size_t size = 0;
+    };
+
+    /// @brief The io_uring file descriptor
+    int ring_fd = -1;
+    /// @brief The mapping of the submission queue ring
+    Mapping sq_ring = {};
+    /// @brief The mapping of the completion queue ring
+    Mapping cq_ring = {};
+    /// @brief The mapping of the submission queue entries
+    Mapping sqe_ring = {};
+
+    /// @brief The head of the submission queue (written by the kernel)
+    u32* sq_head = nullptr;
+    /// @brief The tail of the submission queue
+    u32* sq_tail = nullptr;
+    /// @brief The mask of indices in the submission queue
+    u32 sq_mask = 0;
+    /// @brief The count of entries of the submission queue
+    u32 sq_entries = 0;
+    /// @brief The indices of the submission queue entries
+    u32* sq_array = nullptr;
+    /// @brief The submission queue entries
+    io_uring_sqe* sqes = nullptr;
+    /// @brief The head of the completion queue
+    u32* cq_head = nullptr;
+    /// @brief The tail of the completion queue (written by the kernel)
+    u32* cq_tail = nullptr;
+    /// @brief The mask of indices in the completion queue
+    u32 cq_mask = 0;
+    /// @brief The completion queue entries
+    io_uring_cqe* cqes = nullptr;
+
+    /// @brief The tail of the submission queue not yet published
+    u32 local_tail = 0;
+    /// @brief The count of entries written but not submitted
+    u32 queued = 0;
+
+    /// @brief The kind, access and user data of the requests in flight
+    std::vector<AsyncIORequest> slots;
+    /// @brief The free indices of 'slots'
+    std::vector<u32> free_slots;
+    /// @brief The slots and errors of the requests refused by io_uring_enter
+    std::vector<std::pair<u32, i32>> refused;
+
+    /// @brief Maps a file of 'size' bytes of the ring
+    /// @param size The size of the mapping
+    /// @param offset The offset of the mapping (IORING_OFF_*)
+    /// @return The mapping (whose pointer is null on errors)
+    Mapping map(size_t size, u64 offset) noexcept
+    {
+      void* ptr = ::mmap(
+          nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd,
+          static_cast<off_t>(offset));
+      if (ptr == MAP_FAILED)
+        return {};
+      return {ptr, size};
+    }
+
+    /// @brief Unmaps a mapping of the ring
+    /// @param mapping The mapping
+    static void unmap(Mapping mapping) noexcept
+    {
+      if (mapping.ptr != nullptr)
+        ::munmap(mapping.ptr, mapping.size);
+    }
+
+    /// @brief Calls io_uring_enter
+    /// @param to_submit The count of entries to submit
+    /// @param min_complete The count of completions to wait for
+    /// @param flags The flags
+    /// @return The result of the system call
+    int enter(u32 to_submit, u32 min_complete, u32 flags) noexcept
+    {
+      int ret;
+      do
+        ret = static_cast<int>(::syscall(
+            __NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr,
+            0));
+      while (ret < 0 && errno == EINTR);
+      return ret;
+    }
+
+    /// @brief Converts an access to the flags and mode of 'open'
+    /// @param access The access
+    /// @return The flags and the mode (same as File::open)
+    static std::pair<int, ::mode_t> open_flags(File::FileAccess access) noexcept
+    {
+      switch_no_default(access)
+      {
+      case File::Read:
+        return {O_RDONLY, S_IRUSR};
+      case File::Write:
+        return {O_WRONLY | O_CREAT, S_IRUSR | S_IWUSR};
+      case File::Append:
+        return {O_WRONLY | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR};
+      case File::Create:
+        return {O_WRONLY | O_EXCL | O_CREAT, S_IRUSR | S_IWUSR};
+      }
+    }
+
+    /// @brief Removes the entries that were not submitted from the
+    ///        submission queue, which then complete with 'error'
+    /// @param error The (negative) error code of the completions
+    void refuse_queued(i32 error) noexcept
+    {
+      for (u32 i = queued; i != 0; i--)
+      {
+        const auto& sqe = sqes[(local_tail - i) & sq_mask];
+        refused.emplace_back(static_cast<u32>(sqe.user_data), error);
+      }
+      // The kernel only reads the entries in io_uring_enter
+      local_tail -= queued;
+      queued = 0;
+      std::atomic_ref<u32>{*sq_tail}.store(local_tail, std::memory_order_release);
+    }
+
+    /// @brief Moves the available completions to 'out'
+    /// @param out Where to write the completions
+    /// @return The count of completions written
+    size_t harvest(Span<IOCompletion> out) noexcept
+    {
+      size_t count = 0;
+      while (!refused.empty() && count != out.size())
+      {
+        const auto [index, error] = refused.back();
+        const auto& slot          = slots[index];
+        out[count++] = {slot.user_data, error, slot.kind, slot.access};
+        free_slots.push_back(index);
+        refused.pop_back();
+      }
+
+      u32 head       = *cq_head;
+      const u32 tail =
+          std::atomic_ref<u32>{*cq_tail}.load(std::memory_order_acquire);
+      while (head != tail && count != out.size())
+      {
+        const auto& cqe   = cqes[head & cq_mask];
+        const auto& slot  = slots[cqe.user_data];
+        out[count++]      = {slot.user_data, cqe.res, slot.kind, slot.access};
+        free_slots.push_back(static_cast<u32>(cqe.user_data));
+        head++;
+      }
+      std::atomic_ref<u32>{*cq_head}.store(head, std::memory_order_release);
+      return count;
+    }
+
+  public:
+    /// @brief Constructor, check 'is_valid' for errors
+    /// @param capacity The maximum count of pending requests
+    IOUringAsyncIO(u32 capacity) noexcept
+    {
+      io_uring_params params;
+      std::memset(&params, 0, sizeof params);
+      ring_fd = static_cast<int>(::syscall(
+          __NR_io_uring_setup, clt::max(capacity, 1U), &params));
+      if (ring_fd < 0 || !(params.features & IORING_FEAT_NODROP))
+        return;
+
+      sq_ring = map(
+          params.sq_off.array + params.sq_entries * sizeof(u32), IORING_OFF_SQ_RING);
+      cq_ring = map(
+          params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe),
+          IORING_OFF_CQ_RING);
+      sqe_ring = map(params.sq_entries * sizeof(io_uring_sqe), IORING_OFF_SQES);
+      if (sq_ring.ptr == nullptr || cq_ring.ptr == nullptr
+          || sqe_ring.ptr == nullptr)
+        return;
+
+      auto sq    = static_cast<u8*>(sq_ring.ptr);
+      auto cq    = static_cast<u8*>(cq_ring.ptr);
+      sq_head    = ptr_to<u32*>(sq + params.sq_off.head);
+      sq_tail    = ptr_to<u32*>(sq + params.sq_off.tail);
+      sq_mask    = *ptr_to<u32*>(sq + params.sq_off.ring_mask);
+      sq_entries = params.sq_entries;
+      sq_array   = ptr_to<u32*>(sq + params.sq_off.array);
+      sqes       = static_cast<io_uring_sqe*>(sqe_ring.ptr);
+      cq_head    = ptr_to<u32*>(cq + params.cq_off.head);
+      cq_tail    = ptr_to<u32*>(cq + params.cq_off.tail);
+      cq_mask    = *ptr_to<u32*>(cq + params.cq_off.ring_mask);
+      cqes       = ptr_to<io_uring_cqe*>(cq + params.cq_off.cqes);
+      local_tail = *sq_tail;
+
+      // The completion queue is at least as large as the submission
+      // queue: limiting the requests in flight avoids overflowing it.
+      slots.resize(sq_entries);
+      free_slots.reserve(sq_entries);
+      refused.reserve(sq_entries);
+      for (u32 i = sq_entries; i != 0; i--)
+        free_slots.push_back(i - 1);
+    }
+
+    ~IOUringAsyncIO() noexcept override
+    {
+      if (is_valid())
+        drain();
+      unmap(sqe_ring);
+      unmap(cq_ring);
+      unmap(sq_ring);
+      if (ring_fd >= 0)
+        ::close(ring_fd);
+    }
+
+    /// @brief Check if the ring was created successfully
+    /// @return True if valid
+    bool is_valid() const noexcept { return sqes != nullptr; }
+
+    AsyncIOBackend backend() const noexcept override
+    {
+      return AsyncIOBackend::IOUring;
+    }
+    size_t capacity() const noexcept override { return sq_entries; }
+    size_t pending() const noexcept override
+    {
+      return sq_entries - free_slots.size();
+    }
+
+    bool queue(const AsyncIORequest& request) noexcept override
+    {
+      if (free_slots.empty())
+        return false;
+      const u32 slot = free_slots.back();
+      free_slots.pop_back();
+      slots[slot] = request;
+
+      // As the requests in flight are limited to the size of the
+      // submission queue, an entry is always free.
+      const u32 index = local_tail & sq_mask;
+      auto& sqe       = sqes[index];
+      std::memset(&sqe, 0, sizeof sqe);
+      sqe.user_data = slot;
+      switch_no_default(request.kind)
+      {
+      case IORequestKind::Open:
+      {
+        auto [flags, mode] = open_flags(request.access);
+        sqe.opcode         = IORING_OP_OPENAT;
+        sqe.fd             = AT_FDCWD;
+        sqe.addr           = reinterpret_cast<u64>(request.path);
+        sqe.len            = mode;
+        sqe.open_flags     = static_cast<u32>(flags);
+        break;
+      }
+      case IORequestKind::Read:
+      case IORequestKind::Write:
+        sqe.opcode = request.kind == IORequestKind::Read ? IORING_OP_READ
+                                                         : IORING_OP_WRITE;
+        sqe.fd     = request.fd;
+        sqe.addr   = reinterpret_cast<u64>(request.buffer);
+        sqe.len    = static_cast<u32>(clt::min(request.size, MAX_ASYNC_IO_SIZE));
+        sqe.off    = request.offset;
+        break;
+      case IORequestKind::Close:
+        sqe.opcode = IORING_OP_CLOSE;
+        sqe.fd     = request.fd;
+        break;
+      }
+      sq_array[index] = index;
+      local_tail++;
+      queued++;
+      return true;
+    }
+
+    size_t submit() noexcept override
+    {
+      if (queued == 0)
+        return 0;
+      std::atomic_ref<u32>{*sq_tail}.store(local_tail, std::memory_order_release);
+      const int ret = enter(queued, 0, 0);
+      if (ret < 0)
+      {
+        // Nothing was submitted: the requests fail rather than staying
+        // pending forever
+        refuse_queued(-errno);
+        return 0;
+      }
+      queued -= static_cast<u32>(ret);
+      return static_cast<size_t>(ret);
+    }
+
+    size_t poll(Span<IOCompletion> out) noexcept override { return harvest(out); }
+
+    size_t wait(Span<IOCompletion> out, size_t min_count) noexcept override
+    {
+      submit();
+      // (the requests that are still queued cannot complete)
+      min_count    = clt::min({min_count, out.size(), pending() - queued});
+      size_t count = harvest(out);
+      while (count < min_count)
+      {
+        const auto missing = static_cast<u32>(min_count - count);
+        if (enter(0, missing, IORING_ENTER_GETEVENTS) < 0)
+          break;
+        count += harvest(out.subspan(count));
+      }
+      return count;
+    }
+  };
+#endif // COLT_LINUX
+} // namespace clt::details
+
+namespace clt
+{
+  AsyncIO::~AsyncIO() noexcept
+  {
+    delete impl;
+  }
+
+  AsyncIOBackend AsyncIO::backend() const noexcept
+  {
+    return impl->backend();
+  }
+
+  size_t AsyncIO::capacity() const noexcept
+  {
+    return impl->capacity();
+  }
+
+  size_t AsyncIO::pending() const noexcept
+  {
+    return impl->pending();
+  }
+
+  ErrorFlag AsyncIO::queue_open(
+      const char* path, File::FileAccess access, u64 user_data) noexcept
+  {
+    if (impl->queue(
+            {IORequestKind::Open, access, -1, path, nullptr, 0, 0, user_data}))
+      return ErrorFlag::success();
+    return ErrorFlag::error();
+  }
+
+  ErrorFlag AsyncIO::queue_read(
+      const File& file, Span<u8> out, u64 offset, u64 user_data) noexcept
+  {
+    if (impl->queue(
+            {IORequestKind::Read, file.file_access(), file.fileno(), nullptr,
+             out.data(), clt::min(out.size(), details::MAX_ASYNC_IO_SIZE), offset,
+             user_data}))
+      return ErrorFlag::success();
+    return ErrorFlag::error();
+  }
+
+  ErrorFlag AsyncIO::queue_write(
+      const File& file, View<u8> out, u64 offset, u64 user_data) noexcept
+  {
+    if (impl->queue(
+            {IORequestKind::Write, file.file_access(), file.fileno(), nullptr,
+             const_cast<u8*>(out.data()),
+             clt::min(out.size(), details::MAX_ASYNC_IO_SIZE), offset, user_data}))
+      return ErrorFlag::success();
+    return ErrorFlag::error();
+  }
+
+  ErrorFlag AsyncIO::queue_close(File& file, u64 user_data) noexcept
+  {
+    if (!impl->queue(
+            {IORequestKind::Close, file.file_access(), file.fileno(), nullptr,
+             nullptr, 0, 0, user_data}))
+      return ErrorFlag::error();
+    file.handle = -1;
+    return ErrorFlag::success();
+  }
+
+  size_t AsyncIO::submit() noexcept
+  {
+    return impl->submit();
+  }
+
+  size_t AsyncIO::poll(Span<IOCompletion> out) noexcept
+  {
+    return impl->poll(out);
+  }
+
+  size_t AsyncIO::wait(Span<IOCompletion> out, size_t min_count) noexcept
+  {
+    return impl->wait(out, min_count);
+  }
+
+  Option<AsyncIO> AsyncIO::create(
+      u32 capacity, AsyncIOBackend backend, u32 threads) noexcept
+  {
+#ifdef COLT_LINUX
+    if (backend != AsyncIOBackend::ThreadPool)
+    {
+      auto ring = new (std::nothrow) details::IOUringAsyncIO(capacity);
+      if (ring != nullptr && ring->is_valid())
+        return AsyncIO{ring};
+      delete ring;
+      if (backend == AsyncIOBackend::IOUring)
+        return None;
+    }
+#else
+    if (backend == AsyncIOBackend::IOUring)
+      return None;
+#endif // COLT_LINUX
+    auto pool = new (std::nothrow) details::ThreadPoolAsyncIO(capacity, threads);
+    if (pool == nullptr)
+      return None;
+    return AsyncIO{pool};
+  }
+} // namespace clt
@@ -0,0 +1,196 @@
+/*****************************************************************/ /**
+ * @file   async_io.h
+ * @brief  Contains AsyncIO, a submission/completion queue of file
+ * operations (open, read, write and close).
+ * Requests are queued, submitted by batches and complete out of order:
+ * reading many files costs a few system calls in total rather than
+ * a few blocking system calls per file.
+ * On Linux, the requests are executed by io_uring. Elsewhere (or if
+ * io_uring is not available) they are executed by a pool of threads.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_ASYNC_IO
+#define HG_COLT_ASYNC_IO
+
+#include <colt/typedefs.h>
+#include <colt/dsa/option.h>
+#include <colt/io/file.h>
+
+namespace clt
+{
+  /// @brief The backend executing the requests of an AsyncIO
+  enum class AsyncIOBackend : u8
+  {
+    /// @brief io_uring if available, else ThreadPool
+    Automatic,
+    /// @brief io_uring (Linux only)
+    IOUring,
+    /// @brief A pool of threads doing blocking I/O
+    ThreadPool,
+  };
+
+  /// @brief The kind of request
+  enum class IORequestKind : u8
+  {
+    /// @brief Opens a file
+    Open,
+    /// @brief Reads from a file at an offset
+    Read,
+    /// @brief Writes to a file at an offset
+    Write,
+    /// @brief Closes a file
+    Close,
+  };
+
+  /// @brief The result of a request
+  struct IOCompletion
+  {
+    /// @brief The value passed when the request was queued
+    u64 user_data;
+    /// @brief Negative on errors (-errno for io_uring), else the count of
+    ///        bytes for reads and writes, the file number for opens, and
+    ///        0 for closes
+    i64 result;
+    /// @brief The kind of request
+    IORequestKind kind;
+    /// @brief The access of the opened file (for opens)
+    File::FileAccess access;
+
+    /// @brief Check if the request failed
+    /// @return True on errors
+    [[nodiscard]] constexpr bool is_error() const noexcept { return result < 0; }
+
+    /// @brief Returns the file opened by an Open request
+    /// @return None if not an Open or on errors, else the opened file
+    [[nodiscard]] Option<File> file() const noexcept
+    {
+      if (kind != IORequestKind::Open || is_error())
+        return None;
+      return File{static_cast<int>(result), access};
+    }
+  };
+
+  namespace details
+  {
+    /// @brief Interface of the backends (implemented in async_io.cpp)
+    class AsyncIOImpl;
+  } // namespace details
+
+  /// @brief Batches file operations and delivers their completions.
+  /// Requests are queued through the 'queue_*' methods, sent to the
+  /// backend using 'submit' (or 'wait'), and their completions are
+  /// obtained through 'poll' or 'wait', in any order.
+  /// The buffers (and paths) must stay valid until the completion of
+  /// their request. At most 'capacity()' requests can be in flight.
+  class AsyncIO
+  {
+    /// @brief The backend
+    details::AsyncIOImpl* impl;
+
+    /// @brief Constructor
+    /// @param impl The backend
+    AsyncIO(details::AsyncIOImpl* impl) noexcept
+        : impl(impl)
+    {
+    }
+
+    template<typename>
+    friend class Option; // for in place construction
+
+  public:
+    AsyncIO(const AsyncIO&)            = delete;
+    AsyncIO& operator=(const AsyncIO&) = delete;
+
+    /// @brief Move constructor
+    /// @param to_move The queue to move
+    AsyncIO(AsyncIO&& to_move) noexcept
+        : impl(std::exchange(to_move.impl, nullptr))
+    {
+    }
+    /// @brief Move assignment operator
+    /// @param to_move The queue to move
+    /// @return Self
+    AsyncIO& operator=(AsyncIO&& to_move) noexcept
+    {
+      std::swap(impl, to_move.impl);
+      return *this;
+    }
+
+    /// @brief Destructor, waits for the requests in flight
+    COLTCPP_EXPORT ~AsyncIO() noexcept;
+
+    /// @brief Returns the backend executing the requests
+    /// @return IOUring or ThreadPool
+    [[nodiscard]] COLTCPP_EXPORT AsyncIOBackend backend() const noexcept;
+    /// @brief Returns the maximum count of requests in flight
+    /// @return The capacity
+    [[nodiscard]] COLTCPP_EXPORT size_t capacity() const noexcept;
+    /// @brief Returns the count of requests queued or in flight whose
+    ///        completion was not yet obtained
+    /// @return The count of pending requests
+    [[nodiscard]] COLTCPP_EXPORT size_t pending() const noexcept;
+
+    /// @brief Queues opening the file at 'path'
+    /// @param path The path (which must be valid until completion)
+    /// @param access The access mode of the file
+    /// @param user_data The value returned in the completion
+    /// @return Error if 'capacity()' requests are pending
+    [[nodiscard]] COLTCPP_EXPORT ErrorFlag queue_open(
+        const char* path, File::FileAccess access, u64 user_data) noexcept;
+    /// @brief Queues reading from 'file' at 'offset' into 'out'.
+    /// Reads of more than 2GiB only fill the first 2GiB.
+    /// @param file The file from which to read
+    /// @param out The buffer (which must be valid until completion)
+    /// @param offset The offset in the file
+    /// @param user_data The value returned in the completion
+    /// @return Error if 'capacity()' requests are pending
+    [[nodiscard]] COLTCPP_EXPORT ErrorFlag queue_read(
+        const File& file, Span<u8> out, u64 offset, u64 user_data) noexcept;
+    /// @brief Queues writing 'out' to 'file' at 'offset'.
+    /// Writes of more than 2GiB only write the first 2GiB.
+    /// @param file The file to which to write
+    /// @param out The bytes (which must be valid until completion)
+    /// @param offset The offset in the file
+    /// @param user_data The value returned in the completion
+    /// @return Error if 'capacity()' requests are pending
+    [[nodiscard]] COLTCPP_EXPORT ErrorFlag queue_write(
+        const File& file, View<u8> out, u64 offset, u64 user_data) noexcept;
+    /// @brief Queues closing 'file', which is marked as closed.
+    /// No requests on 'file' may be queued after this one.
+    /// @param file The file to close
+    /// @param user_data The value returned in the completion
+    /// @return Error if 'capacity()' requests are pending
+    [[nodiscard]] COLTCPP_EXPORT ErrorFlag queue_close(
+        File& file, u64 user_data) noexcept;
+
+    /// @brief Sends all the queued requests to the backend.
+    /// If the backend refuses the requests, they complete with an error
+    /// (as obtained by 'poll' or 'wait').
+    /// @return The count of requests sent
+    COLTCPP_EXPORT size_t submit() noexcept;
+    /// @brief Obtains the completions that are available, without blocking
+    /// @param out Where to write the completions
+    /// @return The count of completions written to 'out'
+    [[nodiscard]] COLTCPP_EXPORT size_t poll(Span<IOCompletion> out) noexcept;
+    /// @brief Submits the queued requests, and waits for at least
+    ///        'min(min_count, pending())' completions
+    /// @param out Where to write the completions
+    /// @param min_count The minimum count of completions to wait for
+    /// @return The count of completions written to 'out'
+    [[nodiscard]] COLTCPP_EXPORT size_t wait(
+        Span<IOCompletion> out, size_t min_count = 1) noexcept;
+
+    /// @brief Creates a queue
+    /// @param capacity The maximum count of requests in flight
+    /// @param backend The backend to use
+    /// @param threads The count of threads (for the ThreadPool backend)
+    /// @return None if the backend could not be created
+    [[nodiscard]] COLTCPP_EXPORT static Option<AsyncIO> create(
+        u32 capacity = 256, AsyncIOBackend backend = AsyncIOBackend::Automatic,
+        u32 threads = 4) noexcept;
+  };
+} // namespace clt
+
+#endif // !HG_COLT_ASYNC_IO
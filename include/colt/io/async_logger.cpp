@@ -0,0 +1,287 @@
+#include "async_logger.h"
+#include <bit>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace clt::details
+{
+  /// @brief The size from which the writer thread writes its buffer
+  static constexpr size_t LOG_WRITE_SIZE = 256 * 1024;
+
+  /// @brief Single-producer single-consumer ring of bytes.
+  /// The producer only publishes whole records, so the consumer never
+  /// observes a partial record.
+  struct LogRing
+  {
+    /// @brief The count of bytes read (written by the consumer)
+    alignas(64) std::atomic<u64> head = 0;
+    /// @brief The count of bytes written (written by the producer)
+    alignas(64) std::atomic<u64> tail = 0;
+    /// @brief The thread producing into the ring
+    std::thread::id owner;
+    /// @brief The bytes (of size 'mask + 1')
+    std::unique_ptr<u8[]> buffer;
+    /// @brief The size of the ring minus 1
+    size_t mask;
+
+    /// @brief Constructor
+    /// @param owner The thread producing into the ring
+    /// @param size The size of the ring (power of 2)
+    LogRing(std::thread::id owner, size_t size)
+        : owner(owner)
+        , buffer(std::make_unique<u8[]>(size))
+        , mask(size - 1)
+    {
+    }
+  };
+
+  /// @brief The ring used by the current thread for the last logger used
+  struct LogRingCache
+  {
+    /// @brief The identifier of the logger (0 for none)
+    u64 logger_id = 0;
+    /// @brief The ring of the current thread in that logger
+    LogRing* ring = nullptr;
+  };
+
+  /// @brief The cache of the current thread
+  static thread_local LogRingCache ring_cache;
+  /// @brief The last logger identifier given
+  static std::atomic<u64> last_logger_id = 0;
+
+  /// @brief The writer thread and rings
+  class AsyncLoggerImpl
+  {
+    /// @brief The file to which to write
+    File& sink;
+    /// @brief The size of the rings
+    const size_t ring_size;
+    /// @brief The maximum time before a record is written
+    const std::chrono::milliseconds interval;
+    /// @brief The identifier of the logger (for 'ring_cache')
+    const u64 id = ++last_logger_id;
+    /// @brief Protects 'rings', 'requested', 'completed' and 'stop'
+    std::mutex mutex;
+    /// @brief Notified to wake the writer thread
+    std::condition_variable wake;
+    /// @brief Notified when the writer thread completes a flush
+    std::condition_variable flushed;
+    /// @brief The rings of all the threads that logged
+    std::vector<std::unique_ptr<LogRing>> rings;
+    /// @brief The count of flushes requested
+    u64 requested = 0;
+    /// @brief The count of flushes completed
+    u64 completed = 0;
+    /// @brief True if the writer thread must stop
+    bool stop = false;
+    /// @brief True while the writer thread waits for records
+    std::atomic<bool> sleeping = false;
+    /// @brief The count of bytes that could not be written
+    std::atomic<size_t> lost = 0;
+    /// @brief The writer thread
+    std::thread writer;
+
+    /// @brief Returns the ring of the current thread, creating it if needed
+    /// @return The ring of the current thread
+    LogRing& ring_of_thread() noexcept
+    {
+      if (ring_cache.logger_id == id)
+        return *ring_cache.ring;
+      const auto thread_id = std::this_thread::get_id();
+      std::scoped_lock lock{mutex};
+      LogRing* ring = nullptr;
+      for (auto& i : rings)
+      {
+        if (i->owner == thread_id)
+          ring = i.get();
+      }
+      if (ring == nullptr)
+        ring = rings.emplace_back(std::make_unique<LogRing>(thread_id, ring_size))
+                   .get();
+      ring_cache = {id, ring};
+      return *ring;
+    }
+
+    /// @brief Writes 'out' to the sink, and clears it
+    /// @param out The bytes to write
+    void write(std::vector<u8>& out) noexcept
+    {
+      size_t written = 0;
+      while (written != out.size())
+      {
+        auto ret = sink.write(View<u8>{out.data() + written, out.size() - written});
+        if (ret.is_none() || *ret == 0)
+          break;
+        written += *ret;
+      }
+      lost.fetch_add(out.size() - written, std::memory_order_relaxed);
+      out.clear();
+    }
+
+    /// @brief Moves the content of a ring to 'out' (writing it if needed)
+    /// @param ring The ring to consume
+    /// @param out The bytes to write
+    /// @return True if the ring was not empty
+    bool drain(LogRing& ring, std::vector<u8>& out) noexcept
+    {
+      const u64 head = ring.head.load(std::memory_order_relaxed);
+      const u64 tail = ring.tail.load(std::memory_order_acquire);
+      for (u64 i = head; i != tail;)
+      {
+        const size_t offset = static_cast<size_t>(i) & ring.mask;
+        const size_t size =
+            clt::min(static_cast<size_t>(tail - i), ring.mask + 1 - offset);
+        const u8* bytes = ring.buffer.get() + offset;
+        out.insert(out.end(), bytes, bytes + size);
+        if (out.size() >= LOG_WRITE_SIZE)
+          write(out);
+        i += size;
+      }
+      ring.head.store(tail, std::memory_order_release);
+      return head != tail;
+    }
+
+    /// @brief The function executed by the writer thread
+    void run() noexcept
+    {
+      std::vector<u8> out;
+      out.reserve(LOG_WRITE_SIZE + ring_size);
+      std::vector<LogRing*> snapshot;
+      std::unique_lock lock{mutex};
+      for (;;)
+      {
+        const u64 request   = requested;
+        const bool stopping = stop;
+        snapshot.clear();
+        for (auto& i : rings)
+          snapshot.push_back(i.get());
+        lock.unlock();
+
+        bool any = false;
+        for (auto i : snapshot)
+          any |= drain(*i, out);
+        if (!out.empty())
+          write(out);
+        if (request != completed)
+          sink.flush().discard();
+
+        lock.lock();
+        if (request != completed)
+        {
+          completed = request;
+          flushed.notify_all();
+        }
+        if (stopping)
+          break;
+        if (!any && !stop && requested == completed)
+        {
+          sleeping.store(true, std::memory_order_relaxed);
+          wake.wait_for(lock, interval);
+          sleeping.store(false, std::memory_order_relaxed);
+        }
+      }
+    }
+
+  public:
+    /// @brief Constructor, starts the writer thread
+    /// @param sink The file to which to write
+    /// @param ring_size The size of the ring of each thread (power of 2)
+    /// @param interval The maximum time before a record is written
+    AsyncLoggerImpl(File& sink, size_t ring_size, std::chrono::milliseconds interval)
+        : sink(sink)
+        , ring_size(ring_size)
+        , interval(interval)
+        , writer([this]() { run(); })
+    {
+    }
+
+    /// @brief Destructor, writes all the records and stops the writer thread
+    ~AsyncLoggerImpl() noexcept
+    {
+      {
+        std::scoped_lock lock{mutex};
+        stop = true;
+      }
+      wake.notify_one();
+      writer.join();
+    }
+
+    /// @brief Copies a record into the ring of the current thread
+    /// @param record The record
+    void push(View<u8> record) noexcept
+    {
+      LogRing& ring   = ring_of_thread();
+      const u8* bytes = record.data();
+      const u64 size  = clt::min(record.size(), ring_size);
+      const u64 tail  = ring.tail.load(std::memory_order_relaxed);
+      u64 used        = tail - ring.head.load(std::memory_order_acquire);
+      while (ring_size - used < size)
+      {
+        // The ring is full: wait for the writer thread to consume it
+        if (sleeping.load(std::memory_order_relaxed))
+          wake.notify_one();
+        std::this_thread::yield();
+        used = tail - ring.head.load(std::memory_order_acquire);
+      }
+      const size_t offset = static_cast<size_t>(tail) & ring.mask;
+      const size_t first  = clt::min(static_cast<size_t>(size), ring_size - offset);
+      std::memcpy(ring.buffer.get() + offset, bytes, first);
+      std::memcpy(ring.buffer.get(), bytes + first, size - first);
+      ring.tail.store(tail + size, std::memory_order_release);
+      // Wake the writer thread early if the ring is getting full
+      if (used + size > ring_size / 2 && sleeping.load(std::memory_order_relaxed))
+        wake.notify_one();
+    }
+
+    /// @brief Blocks until all the records logged before the call are written
+    void flush() noexcept
+    {
+      std::unique_lock lock{mutex};
+      const u64 request = ++requested;
+      wake.notify_one();
+      flushed.wait(lock, [&]() { return completed >= request; });
+    }
+
+    /// @brief Returns the count of bytes that could not be written
+    /// @return The count of bytes lost on write errors
+    size_t lost_bytes() const noexcept
+    {
+      return lost.load(std::memory_order_relaxed);
+    }
+  };
+} // namespace clt::details
+
+namespace clt
+{
+  AsyncLogger::AsyncLogger(
+      File& sink, size_t ring_size, std::chrono::milliseconds interval)
+      : impl(nullptr)
+  {
+    assert_true("Ring size must be a power of 2!", std::has_single_bit(ring_size));
+    impl = new details::AsyncLoggerImpl(sink, ring_size, interval);
+  }
+
+  AsyncLogger::~AsyncLogger() noexcept
+  {
+    delete impl;
+  }
+
+  void AsyncLogger::push(View<u8> record) noexcept
+  {
+    impl->push(record);
+  }
+
+  void AsyncLogger::flush() noexcept
+  {
+    impl->flush();
+  }
+
+  size_t AsyncLogger::lost_bytes() const noexcept
+  {
+    return impl->lost_bytes();
+  }
+} // namespace clt
@@ -0,0 +1,224 @@
+/*****************************************************************/ /**
+ * @file   async_logger.h
+ * @brief  Contains AsyncLogger, a logger whose records are written to
+ * a file by a background thread.
+ * Each thread formats its records into its own single-producer
+ * single-consumer ring of bytes (without any lock), and the writer
+ * thread coalesces the content of all the rings into large writes.
+ * Records of a level lower than COLT_LOG_MIN_LEVEL are compiled out.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_ASYNC_LOGGER
+#define HG_COLT_ASYNC_LOGGER
+
+#include <atomic>
+#include <chrono>
+
+#include <colt/io/print.h>
+
+#ifndef COLT_LOG_MIN_LEVEL
+  /// @brief The minimum level of the records that are compiled.
+  /// It can be defined (for the whole project, on the command line)
+  /// to another level, such as clt::LogLevel::Warn.
+  #ifdef COLT_DEBUG
+    #define COLT_LOG_MIN_LEVEL clt::LogLevel::Trace
+  #else
+    #define COLT_LOG_MIN_LEVEL clt::LogLevel::Info
+  #endif // COLT_DEBUG
+#endif // !COLT_LOG_MIN_LEVEL
+
+namespace clt
+{
+  /// @brief The severity of a record
+  enum class LogLevel : u8
+  {
+    /// @brief Very detailed information
+    Trace,
+    /// @brief Information useful while debugging
+    Debug,
+    /// @brief General information
+    Info,
+    /// @brief Something unexpected that can be recovered from
+    Warn,
+    /// @brief An error
+    Error,
+    /// @brief An error that cannot be recovered from
+    Fatal,
+    /// @brief Disables all the records (only used as a minimum level)
+    Off,
+  };
+
+  /// @brief The default size of the ring of each thread
+  static constexpr size_t DEFAULT_LOG_RING_SIZE = 64 * 1024;
+
+  namespace details
+  {
+    /// @brief The writer thread and rings (implemented in async_logger.cpp)
+    class AsyncLoggerImpl;
+
+    /// @brief Returns the prefix of the records of a level
+    /// @param level The level
+    /// @return The prefix
+    constexpr std::string_view log_level_prefix(LogLevel level) noexcept
+    {
+      switch_no_default(level)
+      {
+      case LogLevel::Trace:
+        return "Trace: ";
+      case LogLevel::Debug:
+        return "Debug: ";
+      case LogLevel::Info:
+        return "Message: ";
+      case LogLevel::Warn:
+        return "Warning: ";
+      case LogLevel::Error:
+        return "Error: ";
+      case LogLevel::Fatal:
+        return "FATAL: ";
+      case LogLevel::Off:
+        return "";
+      }
+    }
+  } // namespace details
+
+  /// @brief Logger whose records are written by a background thread.
+  /// Logging only formats the record (on the stack) and copies it into
+  /// the ring of the calling thread: it neither locks nor performs any
+  /// system call (unless the ring is full, in which case it waits for
+  /// the writer thread). The records of a thread are written in order,
+  /// and are never interleaved with the records of other threads.
+  /// Records are written at most 'interval' after being logged, or
+  /// when 'flush' is called, and all of them are written on destruction.
+  /// @code{.cpp}
+  /// AsyncLogger logger = {File::get_stderr()};
+  /// logger.info("Processing {} files...", count);
+  /// @endcode
+  class AsyncLogger
+  {
+    /// @brief The writer thread and rings
+    details::AsyncLoggerImpl* impl;
+    /// @brief The minimum level of the records that are written
+    std::atomic<LogLevel> min_level = COLT_LOG_MIN_LEVEL;
+
+    /// @brief Copies a formatted record into the ring of the thread.
+    /// Records larger than the ring are truncated.
+    /// @param record The record
+    COLTCPP_EXPORT void push(View<u8> record) noexcept;
+
+  public:
+    /// @brief Constructor, starts the writer thread
+    /// @param sink The file to which to write (which must outlive the logger)
+    /// @param ring_size The size of the ring of each thread (power of 2)
+    /// @param interval The maximum time before a record is written
+    COLTCPP_EXPORT AsyncLogger(
+        File& sink, size_t ring_size = DEFAULT_LOG_RING_SIZE,
+        std::chrono::milliseconds interval = std::chrono::milliseconds{10});
+
+    AsyncLogger(const AsyncLogger&)            = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    /// @brief Destructor, writes all the records and stops the writer thread.
+    /// No thread may log while the logger is destroyed.
+    COLTCPP_EXPORT ~AsyncLogger() noexcept;
+
+    /// @brief Changes the minimum level of the records that are written.
+    /// Levels lower than COLT_LOG_MIN_LEVEL are always compiled out.
+    /// @param level The new minimum level
+    void set_level(LogLevel level) noexcept
+    {
+      min_level.store(level, std::memory_order_relaxed);
+    }
+    /// @brief Returns the minimum level of the records that are written
+    /// @return The minimum level
+    [[nodiscard]] LogLevel level() const noexcept
+    {
+      return min_level.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Blocks until all the records logged (by any thread) before
+    ///        the call are written (and the sink is flushed)
+    COLTCPP_EXPORT void flush() noexcept;
+
+    /// @brief Returns the count of bytes that could not be written to the sink
+    /// @return The count of bytes lost on write errors
+    [[nodiscard]] COLTCPP_EXPORT size_t lost_bytes() const noexcept;
+
+    template<LogLevel LEVEL, meta::StringLiteral endl = "\n", typename... Args>
+      requires(LEVEL != LogLevel::Off)
+    /// @brief Formats and logs a record (prepending the prefix of its level).
+    /// Compiles to nothing if 'LEVEL' is lower than COLT_LOG_MIN_LEVEL.
+    /// @tparam LEVEL The level of the record
+    /// @tparam ...Args The types of the arguments to format
+    /// @param fmt The format string
+    /// @param ...args The arguments to format
+    void log(fmt_str<Args...> fmt, Args&&... args) noexcept
+    {
+      if constexpr (LEVEL >= COLT_LOG_MIN_LEVEL)
+      {
+        if (LEVEL < level())
+          return;
+        fmt::basic_memory_buffer<char, 1024> buffer;
+        constexpr auto prefix = details::log_level_prefix(LEVEL);
+        buffer.append(prefix.data(), prefix.data() + prefix.size());
+        fmt::format_to(std::back_inserter(buffer), fmt, std::forward<Args>(args)...);
+        if constexpr (endl.size() != 0)
+          buffer.append(endl.value, endl.value + endl.size());
+        push({reinterpret_cast<const u8*>(buffer.data()), buffer.size()});
+      }
+    }
+
+    template<meta::StringLiteral endl = "\n", typename... Args>
+    /// @brief Formats and logs a record of level Trace
+    /// @param fmt The format string
+    /// @param ...args The arguments to format
+    void trace(fmt_str<Args...> fmt, Args&&... args) noexcept
+    {
+      log<LogLevel::Trace, endl>(fmt, std::forward<Args>(args)...);
+    }
+    template<meta::StringLiteral endl = "\n", typename... Args>
+    /// @brief Formats and logs a record of level Debug
+    /// @param fmt The format string
+    /// @param ...args The arguments to format
+    void debug(fmt_str<Args...> fmt, Args&&... args) noexcept
+    {
+      log<LogLevel::Debug, endl>(fmt, std::forward<Args>(args)...);
+    }
+    template<meta::StringLiteral endl = "\n", typename... Args>
+    /// @brief Formats and logs a record of level Info
+    /// @param fmt The format string
+    /// @param ...args The arguments to format
+    void info(fmt_str<Args...> fmt, Args&&... args) noexcept
+    {
+      log<LogLevel::Info, endl>(fmt, std::forward<Args>(args)...);
+    }
+    template<meta::StringLiteral endl = "\n", typename... Args>
+    /// @brief Formats and logs a record of level Warn
+    /// @param fmt The format string
+    /// @param ...args The arguments to format
+    void warn(fmt_str<Args...> fmt, Args&&... args) noexcept
+    {
+      log<LogLevel::Warn, endl>(fmt, std::forward<Args>(args)...);
+    }
+    template<meta::StringLiteral endl = "\n", typename... Args>
+    /// @brief Formats and logs a record of level Error
+    /// @param fmt The format string
+    /// @param ...args The arguments to format
+    void error(fmt_str<Args...> fmt, Args&&... args) noexcept
+    {
+      log<LogLevel::Error, endl>(fmt, std::forward<Args>(args)...);
+    }
+    template<meta::StringLiteral endl = "\n", typename... Args>
+    /// @brief Formats and logs a record of level Fatal, and flushes the logger
+    /// @param fmt The format string
+    /// @param ...args The arguments to format
+    void fatal(fmt_str<Args...> fmt, Args&&... args) noexcept
+    {
+      log<LogLevel::Fatal, endl>(fmt, std::forward<Args>(args)...);
+      flush();
+    }
+  };
+} // namespace clt
+
+#endif // !HG_COLT_ASYNC_LOGGER
@@ -0,0 +1,555 @@
+/*****************************************************************/ /**
+ * @file   binary_archive.h
+ * @brief  Contains BasicBinaryWriter and BasicBinaryReader, archives
+ * that (de)serialize reflected types and any type providing a
+ * 'serialize(Ser&, T&)' hook (such as Bitfields, Option or StringView).
+ * The archive starts with a header (magic, format, endianness and the
+ * version of the schema), followed by the serialized values:
+ * - integers, enums and floating points are stored with a fixed width
+ *   in the endianness of the archive
+ * - sizes (of strings and ranges) are stored as LEB128 varints
+ * - contiguously hashable types are copied as is when the endianness
+ *   of the archive is the native one.
+ * Readers can read in place from a ViewOfFile: strings and bytes are
+ * then views of the mapping rather than copies.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_BINARY_ARCHIVE
+#define HG_COLT_BINARY_ARCHIVE
+
+#include <bit>
+#include <cstring>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <colt/typedefs.h>
+#include <colt/dsa/option.h>
+#include <colt/dsa/vector.h>
+#include <colt/meta/reflect.h>
+#include <colt/io/file.h>
+#include <colt/io/mmap.h>
+
+namespace clt
+{
+  /// @brief The magic number starting an archive ("CLTB" in little endian)
+  static constexpr u32 ARCHIVE_MAGIC = 0x42544C43;
+  /// @brief The version of the format of the archives
+  static constexpr u8 ARCHIVE_FORMAT_VERSION = 1;
+  /// @brief The size of the header of an archive
+  static constexpr size_t ARCHIVE_HEADER_SIZE = 12;
+
+  namespace details
+  {
+    /// @brief The result of serializing values (convertible to std::errc,
+    ///        like the results of zpp::bits, so that hooks can be shared)
+    struct ArchiveResult
+    {
+      /// @brief The error code (std::errc{} on success)
+      std::errc code{};
+
+      /// @brief Converts the result to its error code
+      constexpr operator std::errc() const noexcept { return code; }
+      /// @brief Check if the result represents an error
+      /// @return True on errors
+      [[nodiscard]] constexpr bool is_error() const noexcept
+      {
+        return code != std::errc{};
+      }
+      /// @brief Check if the result represents a success
+      /// @return True on success
+      [[nodiscard]] constexpr bool is_success() const noexcept
+      {
+        return !is_error();
+      }
+    };
+
+    /// @brief Unsigned integer of the same size as T
+    template<typename T>
+    using archive_bits_t = std::conditional_t<
+        sizeof(T) == 1, u8,
+        std::conditional_t<
+            sizeof(T) == 2, u16, std::conditional_t<sizeof(T) == 4, u32, u64>>>;
+
+    template<std::endian ENDIAN, typename T>
+    /// @brief Converts a scalar to its representation in an archive
+    /// @param value The scalar
+    /// @return The bits of the representation
+    constexpr archive_bits_t<T> to_archive_endian(T value) noexcept
+    {
+      const auto bits = std::bit_cast<archive_bits_t<T>>(value);
+      if constexpr (ENDIAN == std::endian::little)
+        return htol(bits);
+      else
+        return htob(bits);
+    }
+
+    template<std::endian ENDIAN, typename T>
+    /// @brief Converts the representation of a scalar in an archive to it
+    /// @param bits The bits of the representation
+    /// @return The scalar
+    constexpr T from_archive_endian(archive_bits_t<T> bits) noexcept
+    {
+      if constexpr (ENDIAN == std::endian::little)
+        return std::bit_cast<T>(ltoh(bits));
+      else
+        return std::bit_cast<T>(btoh(bits));
+    }
+
+    /// @brief Check if a type is stored as a fixed width scalar
+    template<typename T>
+    concept archive_scalar =
+        (std::is_arithmetic_v<T> || std::is_enum_v<T>) && sizeof(T) <= 8;
+
+    /// @brief Check if a type can be copied as is to an archive of endianness E.
+    /// This is the case for contiguously hashable types (no padding and no
+    /// floating points) if the endianness of the archive is the native one.
+    template<typename T, std::endian E>
+    concept archive_memcpyable =
+        meta::is_contiguously_hashable_v<T> && std::is_trivially_copyable_v<T>
+        && !std::is_pointer_v<T> && (E == std::endian::native || sizeof(T) == 1);
+
+    /// @brief Check if a type provides a static 'serialize' hook
+    template<typename T, typename Ser>
+    concept has_serialize_hook =
+        requires(Ser& archive, T& value) { T::serialize(archive, value); };
+
+    /// @brief Check if a type is a contiguous range of known size
+    template<typename T>
+    concept archive_range =
+        std::ranges::contiguous_range<T> && std::ranges::sized_range<T>;
+  } // namespace details
+
+  template<std::endian ENDIAN = std::endian::little>
+    requires(ENDIAN == std::endian::little || ENDIAN == std::endian::big)
+  /// @brief Archive whose values are serialized to memory.
+  /// @code{.cpp}
+  /// BinaryWriter writer{MODULE_SCHEMA_VERSION};
+  /// if (writer(module_name, interface).is_success())
+  ///   writer.write_to(*file).discard();
+  /// @endcode
+  /// @tparam ENDIAN The endianness of the archive
+  class BasicBinaryWriter
+  {
+    /// @brief The bytes of the archive
+    Vector<u8> data = Vector<u8>{mem::GlobalAllocator};
+
+    /// @brief Appends bytes
+    /// @param ptr The bytes
+    /// @param size The count of bytes
+    void append(const void* ptr, size_t size) noexcept
+    {
+      data.append_range(View<u8>{static_cast<const u8*>(ptr), size});
+    }
+
+    /// @brief Appends a LEB128 varint
+    /// @param value The value to write
+    void write_varint(u64 value) noexcept
+    {
+      u8 buffer[10];
+      size_t size = 0;
+      do
+      {
+        buffer[size] = static_cast<u8>(value & 0x7F) | (value > 0x7F ? 0x80 : 0);
+        ++size;
+        value >>= 7;
+      } while (value != 0);
+      append(buffer, size);
+    }
+
+    template<typename T>
+    /// @brief Serializes a value
+    /// @param value The value to serialize
+    /// @return The result
+    details::ArchiveResult write_one(const T& value) noexcept
+    {
+      using namespace details;
+      if constexpr (
+          std::same_as<T, std::string_view> || std::same_as<T, std::string>)
+      {
+        write_varint(value.size());
+        append(value.data(), value.size());
+        return {};
+      }
+      else if constexpr (archive_memcpyable<T, ENDIAN>)
+      {
+        append(&value, sizeof(T));
+        return {};
+      }
+      else if constexpr (archive_scalar<T>)
+      {
+        if constexpr (std::same_as<T, bool>)
+          return write_one(static_cast<u8>(value));
+        else if constexpr (std::is_enum_v<T>)
+          return write_one(static_cast<std::underlying_type_t<T>>(value));
+        else
+        {
+          const auto bits = to_archive_endian<ENDIAN>(value);
+          append(&bits, sizeof(bits));
+          return {};
+        }
+      }
+      else if constexpr (has_serialize_hook<T, BasicBinaryWriter>)
+        return T::serialize(*this, const_cast<T&>(value));
+      else if constexpr (meta::reflectable<T> && std::is_class_v<T>)
+        return ::serialize(*this, const_cast<T&>(value));
+      else if constexpr (std::is_bounded_array_v<T>)
+        return write_elements(value, std::extent_v<T>);
+      else if constexpr (details::archive_range<T>)
+      {
+        const size_t size = std::ranges::size(value);
+        write_varint(size);
+        return write_elements(std::ranges::data(value), size);
+      }
+      else
+        static_assert(!std::same_as<T, T>, "Type is not serializable!");
+    }
+
+    template<typename T>
+    /// @brief Serializes 'size' values
+    /// @param values The values
+    /// @param size The count of values
+    /// @return The result
+    details::ArchiveResult write_elements(const T* values, size_t size) noexcept
+    {
+      if constexpr (details::archive_memcpyable<T, ENDIAN>)
+      {
+        append(values, size * sizeof(T));
+        return {};
+      }
+      else
+      {
+        for (size_t i = 0; i < size; i++)
+        {
+          if (auto error = write_one(values[i]); error.is_error())
+            return error;
+        }
+        return {};
+      }
+    }
+
+  public:
+    /// @brief Constructor, writes the header of the archive
+    /// @param version The version of the schema of the serialized values
+    explicit BasicBinaryWriter(u32 version = 0) noexcept
+    {
+      const u32 header[3] = {
+          htol(ARCHIVE_MAGIC),
+          htol(static_cast<u32>(
+              ARCHIVE_FORMAT_VERSION | (u32(ENDIAN == std::endian::big) << 8))),
+          htol(version)};
+      static_assert(sizeof(header) == ARCHIVE_HEADER_SIZE);
+      append(header, sizeof(header));
+    }
+
+    /// @brief The kind of the archive (for 'serialize' hooks)
+    /// @return zpp::bits::kind::out
+    static constexpr zpp::bits::kind kind() noexcept { return zpp::bits::kind::out; }
+
+    template<typename... Args>
+    /// @brief Serializes values in order
+    /// @param ...args The values to serialize
+    /// @return The result (of the first error)
+    details::ArchiveResult operator()(const Args&... args) noexcept
+    {
+      details::ArchiveResult result = {};
+      ((result = result.is_error() ? result : write_one(args)), ...);
+      return result;
+    }
+
+    /// @brief Returns the bytes of the archive (including the header)
+    /// @return The bytes of the archive
+    [[nodiscard]] View<u8> bytes() const noexcept { return data; }
+    /// @brief Returns the size of the archive (including the header)
+    /// @return The size of the archive
+    [[nodiscard]] size_t size() const noexcept { return data.size(); }
+
+    /// @brief Writes the archive to a file
+    /// @param file The file to which to write
+    /// @return Error if not all the bytes could be written
+    [[nodiscard]] ErrorFlag write_to(File& file) const noexcept
+    {
+      for (size_t written = 0; written != data.size();)
+      {
+        auto write =
+            file.write(View<u8>{data.data() + written, data.size() - written});
+        if (write.is_none() || *write == 0)
+          return ErrorFlag::error();
+        written += *write;
+      }
+      return ErrorFlag::success();
+    }
+  };
+
+  template<std::endian ENDIAN = std::endian::little>
+    requires(ENDIAN == std::endian::little || ENDIAN == std::endian::big)
+  /// @brief Archive whose values are deserialized from memory.
+  /// Strings views and bytes (std::string_view, StringView, and
+  /// std::span<const std::byte>) are deserialized as views of the
+  /// memory of the archive: they are valid as long as the memory is.
+  /// @code{.cpp}
+  /// auto file = ViewOfFile::open("module.bin");
+  /// auto reader = BinaryReader::open(*file, MODULE_SCHEMA_VERSION);
+  /// if (reader.is_none() || (*reader)(module_name, interface).is_error())
+  ///   ...
+  /// @endcode
+  /// @tparam ENDIAN The endianness of the archive
+  class BasicBinaryReader
+  {
+    /// @brief The next byte to read
+    const u8* current;
+    /// @brief The end of the archive
+    const u8* end;
+
+    /// @brief Constructor
+    /// @param bytes The bytes following the header
+    BasicBinaryReader(View<u8> bytes) noexcept
+        : current(bytes.data())
+        , end(bytes.data() + bytes.size())
+    {
+    }
+
+    template<typename>
+    friend class Option; // for in place construction
+
+    /// @brief Consumes 'size' bytes
+    /// @param size The count of bytes
+    /// @return The consumed bytes or nullptr if not enough bytes remain
+    const u8* consume(size_t size) noexcept
+    {
+      if (static_cast<size_t>(end - current) < size)
+        return nullptr;
+      return std::exchange(current, current + size);
+    }
+
+    /// @brief Reads a LEB128 varint
+    /// @param value Where to write the value
+    /// @return The result
+    details::ArchiveResult read_varint(u64& value) noexcept
+    {
+      value = 0;
+      for (u32 shift = 0; shift < 64; shift += 7)
+      {
+        if (current == end)
+          return {std::errc::result_out_of_range};
+        const u8 byte = *current++;
+        if (shift == 63 && (byte & 0x7E) != 0)
+          return {std::errc::value_too_large};
+        value |= static_cast<u64>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+          return {};
+      }
+      return {std::errc::value_too_large};
+    }
+
+    /// @brief Reads a size, checking that at least 'size * min_item_size'
+    ///        bytes remain
+    /// @param size Where to write the size
+    /// @param min_item_size The minimum size of an item
+    /// @return The result
+    details::ArchiveResult read_size(size_t& size, size_t min_item_size) noexcept
+    {
+      u64 value;
+      if (auto error = read_varint(value); error.is_error())
+        return error;
+      if (min_item_size != 0
+          && value > static_cast<u64>(end - current) / min_item_size)
+        return {std::errc::result_out_of_range};
+      size = static_cast<size_t>(value);
+      return {};
+    }
+
+    template<typename T>
+    /// @brief Deserializes a value
+    /// @param value Where to write the value
+    /// @return The result
+    details::ArchiveResult read_one(T& value) noexcept
+    {
+      using namespace details;
+      if constexpr (
+          std::same_as<T, std::string_view>
+          || std::same_as<T, std::span<const std::byte>> || std::same_as<T, View<u8>>
+          || std::same_as<T, std::string>)
+      {
+        size_t size;
+        if (auto error = read_size(size, 1); error.is_error())
+          return error;
+        const u8* bytes = consume(size);
+        if constexpr (std::same_as<T, std::string>)
+          value.assign(ptr_to<const char*>(bytes), size);
+        else
+          value = T{ptr_to<const typename T::value_type*>(bytes), size};
+        return {};
+      }
+      else if constexpr (archive_memcpyable<T, ENDIAN>)
+      {
+        const u8* bytes = consume(sizeof(T));
+        if (bytes == nullptr)
+          return {std::errc::result_out_of_range};
+        std::memcpy(&value, bytes, sizeof(T));
+        return {};
+      }
+      else if constexpr (archive_scalar<T>)
+      {
+        if constexpr (std::same_as<T, bool>)
+        {
+          u8 byte = 0;
+          if (auto error = read_one(byte); error.is_error())
+            return error;
+          value = byte != 0;
+          return {};
+        }
+        else if constexpr (std::is_enum_v<T>)
+        {
+          std::underlying_type_t<T> underlying{};
+          if (auto error = read_one(underlying); error.is_error())
+            return error;
+          value = static_cast<T>(underlying);
+          return {};
+        }
+        else
+        {
+          const u8* bytes = consume(sizeof(T));
+          if (bytes == nullptr)
+            return {std::errc::result_out_of_range};
+          archive_bits_t<T> bits;
+          std::memcpy(&bits, bytes, sizeof(T));
+          value = from_archive_endian<ENDIAN, T>(bits);
+          return {};
+        }
+      }
+      else if constexpr (has_serialize_hook<T, BasicBinaryReader>)
+        return T::serialize(*this, value);
+      else if constexpr (meta::reflectable<T> && std::is_class_v<T>)
+        return ::serialize(*this, value);
+      else if constexpr (std::is_bounded_array_v<T>)
+        return read_elements(value, std::extent_v<T>);
+      else if constexpr (
+          archive_range<T>
+          && requires(T& range, size_t size) { range.resize(size); })
+      {
+        using value_t = std::ranges::range_value_t<T>;
+        size_t size;
+        if (auto error = read_size(size, archive_memcpyable<value_t, ENDIAN>
+                                             ? sizeof(value_t)
+                                             : 0); error.is_error())
+          return error;
+        value.resize(size);
+        return read_elements(std::ranges::data(value), size);
+      }
+      else if constexpr (requires(T& range, std::ranges::range_value_t<T>&& item) {
+                           range.clear();
+                           range.push_back(std::move(item));
+                         })
+      {
+        using value_t = std::ranges::range_value_t<T>;
+        size_t size;
+        if (auto error = read_size(size, 0); error.is_error())
+          return error;
+        value.clear();
+        for (size_t i = 0; i < size; i++)
+        {
+          value_t item{};
+          if (auto error = read_one(item); error.is_error())
+            return error;
+          value.push_back(std::move(item));
+        }
+        return {};
+      }
+      else
+        static_assert(!std::same_as<T, T>, "Type is not deserializable!");
+    }
+
+    template<typename T>
+    /// @brief Deserializes 'size' values
+    /// @param values Where to write the values
+    /// @param size The count of values
+    /// @return The result
+    details::ArchiveResult read_elements(T* values, size_t size) noexcept
+    {
+      if constexpr (details::archive_memcpyable<T, ENDIAN>)
+      {
+        const u8* bytes = consume(size * sizeof(T));
+        if (bytes == nullptr)
+          return {std::errc::result_out_of_range};
+        if (size != 0)
+          std::memcpy(values, bytes, size * sizeof(T));
+        return {};
+      }
+      else
+      {
+        for (size_t i = 0; i < size; i++)
+        {
+          if (auto error = read_one(values[i]); error.is_error())
+            return error;
+        }
+        return {};
+      }
+    }
+
+  public:
+    /// @brief The kind of the archive (for 'serialize' hooks)
+    /// @return zpp::bits::kind::in
+    static constexpr zpp::bits::kind kind() noexcept { return zpp::bits::kind::in; }
+
+    template<typename... Args>
+    /// @brief Deserializes values in order
+    /// @param ...args Where to write the values
+    /// @return The result (of the first error)
+    details::ArchiveResult operator()(Args&&... args) noexcept
+    {
+      details::ArchiveResult result = {};
+      ((result = result.is_error() ? result : read_one(args)), ...);
+      return result;
+    }
+
+    /// @brief Returns the count of bytes that were not read
+    /// @return The count of bytes remaining
+    [[nodiscard]] size_t remaining() const noexcept
+    {
+      return static_cast<size_t>(end - current);
+    }
+
+    /// @brief Opens an archive, validating its header
+    /// @param bytes The bytes of the archive (which must outlive the reader)
+    /// @param version The expected version of the schema
+    /// @return None if the header is invalid or the version does not match
+    [[nodiscard]] static Option<BasicBinaryReader> open(
+        View<u8> bytes, u32 version = 0) noexcept
+    {
+      if (bytes.size() < ARCHIVE_HEADER_SIZE)
+        return None;
+      u32 header[3];
+      std::memcpy(header, bytes.data(), ARCHIVE_HEADER_SIZE);
+      const u32 format = static_cast<u32>(
+          ARCHIVE_FORMAT_VERSION | (u32(ENDIAN == std::endian::big) << 8));
+      if (ltoh(header[0]) != ARCHIVE_MAGIC || ltoh(header[1]) != format
+          || ltoh(header[2]) != version)
+        return None;
+      return Option<BasicBinaryReader>{InPlace, bytes.subspan(ARCHIVE_HEADER_SIZE)};
+    }
+
+    /// @brief Opens an archive from a mapped file, validating its header
+    /// @param file The mapped file (which must outlive the reader)
+    /// @param version The expected version of the schema
+    /// @return None if the header is invalid or the version does not match
+    [[nodiscard]] static Option<BasicBinaryReader> open(
+        const ViewOfFile& file, u32 version = 0) noexcept
+    {
+      auto bytes = file.view();
+      if (bytes.is_none())
+        return None;
+      return open(*bytes, version);
+    }
+  };
+
+  /// @brief Archive writer (little endian)
+  using BinaryWriter = BasicBinaryWriter<>;
+  /// @brief Archive reader (little endian)
+  using BinaryReader = BasicBinaryReader<>;
+} // namespace clt
+
+#endif // !HG_COLT_BINARY_ARCHIVE
@@ -0,0 +1,418 @@
+/*****************************************************************/ /**
+ * @file   buffered_file.h
+ * @brief  Contains BasicBufferedReader and BasicBufferedWriter.
+ * File::read and File::write issue a system call per call, which is
+ * very expensive for small reads and writes (as single bytes).
+ * These wrappers read and write through a buffer obtained from an
+ * allocator, and only call into the File once the buffer is empty
+ * (for reads) or full (for writes).
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_BUFFERED_FILE
+#define HG_COLT_BUFFERED_FILE
+
+#include <cstring>
+#include <utility>
+#include <colt/io/file.h>
+#include <colt/dsa/string_view.h>
+#include <colt/mem/allocator_ref.h>
+
+namespace clt
+{
+  /// @brief The default size of the buffer of buffered readers and writers
+  inline constexpr size_t DEFAULT_FILE_BUFFER_SIZE = 64 * 1024;
+
+  template<meta::Allocator ALLOCATOR>
+  /// @brief Reads from a File through a buffer.
+  /// The views returned by 'peek', 'read_until' and 'read_line' point
+  /// into the buffer: they are invalidated by any other call that reads
+  /// from the reader.
+  /// @tparam ALLOCATOR The allocator used for the buffer
+  class BasicBufferedReader : private ALLOCATOR
+  {
+    /// @brief The file from which to read (or null if moved from)
+    File* file;
+    /// @brief The buffer
+    mem::MemBlock blk;
+    /// @brief The offset of the first unread byte in the buffer
+    size_t start = 0;
+    /// @brief The offset past the last unread byte in the buffer
+    size_t end = 0;
+    /// @brief True if the end of the file was hit
+    bool hit_eof = false;
+    /// @brief True if reading from the file failed
+    bool hit_error = false;
+
+    /// @brief Returns a pointer to the buffer
+    /// @return Pointer to the buffer
+    u8* buffer() const noexcept { return static_cast<u8*>(blk.ptr()); }
+
+    /// @brief Reads from the file into the free space of the buffer.
+    /// The unread bytes are moved to the start of the buffer first.
+    /// @return The count of bytes read (0 on EOF or errors)
+    size_t fill() noexcept
+    {
+      if (hit_eof || hit_error)
+        return 0;
+      if (start != 0)
+      {
+        std::memmove(buffer(), buffer() + start, end - start);
+        end -= start;
+        start = 0;
+      }
+      if (end == blk.size())
+        return 0;
+      auto read = file->read(Span<u8>{buffer() + end, blk.size() - end});
+      if (read.is_none())
+        hit_error = true;
+      else if (*read == 0)
+        hit_eof = true;
+      else
+        end += *read;
+      return read.value_or(0);
+    }
+
+    /// @brief Grows the buffer to hold at least 'size' bytes
+    /// @param size The new minimum size of the buffer
+    void grow(size_t size) noexcept
+    {
+      auto new_blk = ALLOCATOR::alloc(clt::max(size, blk.size() * 2));
+      std::memcpy(new_blk.ptr(), buffer() + start, end - start);
+      ALLOCATOR::dealloc(blk);
+      blk = new_blk;
+      end -= start;
+      start = 0;
+    }
+
+    /// @brief Ensures that at least 'size' bytes are buffered (if possible).
+    /// @param size The count of bytes to buffer
+    void ensure(size_t size) noexcept
+    {
+      if (size > blk.size())
+        grow(size);
+      while (end - start < size && fill() != 0)
+        ;
+    }
+
+  public:
+    BasicBufferedReader()                                      = delete;
+    BasicBufferedReader(const BasicBufferedReader&)            = delete;
+    BasicBufferedReader& operator=(const BasicBufferedReader&) = delete;
+    BasicBufferedReader& operator=(BasicBufferedReader&&)      = delete;
+
+    /// @brief Constructor
+    /// @param alloc The allocator of the buffer
+    /// @param file The file from which to read (must outlive the reader)
+    /// @param buffer_size The initial size of the buffer
+    BasicBufferedReader(
+        const ALLOCATOR& alloc, File& file,
+        size_t buffer_size = DEFAULT_FILE_BUFFER_SIZE) noexcept
+        : ALLOCATOR(alloc)
+        , file(&file)
+        , blk(ALLOCATOR::alloc(clt::max(buffer_size, size_t{1})))
+    {
+    }
+
+    /// @brief Move constructor
+    /// @param to_move The reader to move
+    BasicBufferedReader(BasicBufferedReader&& to_move) noexcept
+        : ALLOCATOR(static_cast<const ALLOCATOR&>(to_move))
+        , file(std::exchange(to_move.file, nullptr))
+        , blk(std::exchange(to_move.blk, mem::MemBlock{}))
+        , start(std::exchange(to_move.start, 0))
+        , end(std::exchange(to_move.end, 0))
+        , hit_eof(to_move.hit_eof)
+        , hit_error(to_move.hit_error)
+    {
+    }
+
+    /// @brief Destructor, frees the buffer
+    ~BasicBufferedReader() noexcept
+    {
+      if (!blk.is_null())
+        ALLOCATOR::dealloc(blk);
+    }
+
+    /// @brief Returns the size of the buffer
+    /// @return The size of the buffer
+    [[nodiscard]] size_t buffer_size() const noexcept { return blk.size(); }
+    /// @brief Returns the count of bytes read from the file but not consumed
+    /// @return The count of buffered bytes
+    [[nodiscard]] size_t buffered() const noexcept { return end - start; }
+    /// @brief Check if reading from the file failed
+    /// @return True on errors
+    [[nodiscard]] bool has_error() const noexcept { return hit_error; }
+    /// @brief Check if all the bytes of the file were consumed
+    /// @return True if there is nothing left to read
+    [[nodiscard]] bool is_eof() noexcept
+    {
+      if (start == end)
+        fill();
+      return start == end;
+    }
+
+    /// @brief Returns the next byte without consuming it
+    /// @return None on EOF or errors, else the next byte
+    [[nodiscard]] Option<u8> peek() noexcept
+    {
+      if (start == end && fill() == 0)
+        return None;
+      return buffer()[start];
+    }
+
+    /// @brief Returns the next 'size' bytes without consuming them.
+    /// The buffer is grown if it cannot hold 'size' bytes.
+    /// @param size The count of bytes to peek
+    /// @return View of at most 'size' bytes (less on EOF or errors)
+    [[nodiscard]] View<u8> peek(size_t size) noexcept
+    {
+      ensure(size);
+      return {buffer() + start, clt::min(size, end - start)};
+    }
+
+    /// @brief Consumes 'size' bytes (at most the count of buffered bytes)
+    /// @param size The count of bytes to consume
+    void consume(size_t size) noexcept { start += clt::min(size, end - start); }
+
+    /// @brief Reads a single byte
+    /// @return None on EOF or errors, else the byte read
+    [[nodiscard]] Option<u8> read() noexcept
+    {
+      if (start == end && fill() == 0)
+        return None;
+      return buffer()[start++];
+    }
+
+    /// @brief Reads multiple bytes.
+    /// Reads that are larger than the buffer do not go through the buffer.
+    /// @param out Where to write the read bytes
+    /// @return None on errors or the number of bytes read (0 on EOF)
+    [[nodiscard]] Option<size_t> read(Span<u8> out) noexcept
+    {
+      size_t copied = clt::min(out.size(), end - start);
+      std::memcpy(out.data(), buffer() + start, copied);
+      start += copied;
+      while (copied != out.size())
+      {
+        if (out.size() - copied >= blk.size())
+        {
+          if (hit_eof || hit_error)
+            break;
+          auto read = file->read(out.subspan(copied));
+          if (read.is_none())
+            hit_error = true;
+          else if (*read == 0)
+            hit_eof = true;
+          else
+            copied += *read;
+          continue;
+        }
+        if (fill() == 0)
+          break;
+        const size_t size = clt::min(out.size() - copied, end - start);
+        std::memcpy(out.data() + copied, buffer() + start, size);
+        start += size;
+        copied += size;
+      }
+      if (copied == 0 && hit_error)
+        return None;
+      return copied;
+    }
+
+    /// @brief Reads until 'delim' (included) is found.
+    /// The buffer is grown if the bytes until 'delim' do not fit in it.
+    /// If the end of the file is hit before finding 'delim', the remaining
+    /// bytes are returned.
+    /// @param delim The delimiter
+    /// @return None if no bytes are left, else a view (valid until the
+    ///         next read) of the bytes read
+    [[nodiscard]] Option<View<u8>> read_until(u8 delim) noexcept
+    {
+      size_t searched = 0;
+      while (true)
+      {
+        const u8* begin = buffer() + start;
+        if (auto found = static_cast<const u8*>(
+                std::memchr(begin + searched, delim, end - start - searched));
+            found != nullptr)
+        {
+          const size_t size = static_cast<size_t>(found - begin) + 1;
+          start += size;
+          return View<u8>{begin, size};
+        }
+        searched = end - start;
+        if (end == blk.size() && start == 0)
+          grow(blk.size() * 2);
+        if (fill() == 0 && (hit_eof || hit_error))
+          break;
+      }
+      if (start == end)
+        return None;
+      View<u8> rest = {buffer() + start, end - start};
+      start         = end;
+      return rest;
+    }
+
+    /// @brief Reads a line, without its line terminator ('\n' or "\r\n")
+    /// @return None if no bytes are left, else a view (valid until the
+    ///         next read) of the line
+    [[nodiscard]] Option<View<u8>> read_line() noexcept
+    {
+      auto line = read_until('\n');
+      if (line.is_none())
+        return None;
+      View<u8> ret = *line;
+      if (!ret.empty() && ret.back() == '\n')
+        ret = ret.first(ret.size() - 1);
+      if (!ret.empty() && ret.back() == '\r')
+        ret = ret.first(ret.size() - 1);
+      return ret;
+    }
+  };
+
+  template<meta::Allocator ALLOCATOR>
+  /// @brief Writes to a File through a buffer.
+  /// The buffer is written to the file when it is full, on 'flush',
+  /// and on destruction.
+  /// @tparam ALLOCATOR The allocator used for the buffer
+  class BasicBufferedWriter : private ALLOCATOR
+  {
+    /// @brief The file to which to write (or null if moved from)
+    File* file;
+    /// @brief The buffer
+    mem::MemBlock blk;
+    /// @brief The count of bytes in the buffer
+    size_t size = 0;
+
+    /// @brief Returns a pointer to the buffer
+    /// @return Pointer to the buffer
+    u8* buffer() const noexcept { return static_cast<u8*>(blk.ptr()); }
+
+    /// @brief Writes all the bytes of 'out' directly to the file
+    /// @param out The bytes to write
+    /// @return Success or failure
+    ErrorFlag write_all(View<u8> out) noexcept
+    {
+      while (!out.empty())
+      {
+        auto written = file->write(out);
+        if (written.is_none() || *written == 0)
+          return ErrorFlag::error();
+        out = out.subspan(*written);
+      }
+      return ErrorFlag::success();
+    }
+
+  public:
+    BasicBufferedWriter()                                      = delete;
+    BasicBufferedWriter(const BasicBufferedWriter&)            = delete;
+    BasicBufferedWriter& operator=(const BasicBufferedWriter&) = delete;
+    BasicBufferedWriter& operator=(BasicBufferedWriter&&)      = delete;
+
+    /// @brief Constructor
+    /// @param alloc The allocator of the buffer
+    /// @param file The file to which to write (must outlive the writer)
+    /// @param buffer_size The size of the buffer
+    BasicBufferedWriter(
+        const ALLOCATOR& alloc, File& file,
+        size_t buffer_size = DEFAULT_FILE_BUFFER_SIZE) noexcept
+        : ALLOCATOR(alloc)
+        , file(&file)
+        , blk(ALLOCATOR::alloc(clt::max(buffer_size, size_t{1})))
+    {
+    }
+
+    /// @brief Move constructor
+    /// @param to_move The writer to move
+    BasicBufferedWriter(BasicBufferedWriter&& to_move) noexcept
+        : ALLOCATOR(static_cast<const ALLOCATOR&>(to_move))
+        , file(std::exchange(to_move.file, nullptr))
+        , blk(std::exchange(to_move.blk, mem::MemBlock{}))
+        , size(std::exchange(to_move.size, 0))
+    {
+    }
+
+    /// @brief Destructor, flushes and frees the buffer
+    ~BasicBufferedWriter() noexcept
+    {
+      if (blk.is_null())
+        return;
+      flush().discard();
+      ALLOCATOR::dealloc(blk);
+    }
+
+    /// @brief Returns the size of the buffer
+    /// @return The size of the buffer
+    [[nodiscard]] size_t buffer_size() const noexcept { return blk.size(); }
+    /// @brief Returns the count of bytes not yet written to the file
+    /// @return The count of buffered bytes
+    [[nodiscard]] size_t buffered() const noexcept { return size; }
+
+    /// @brief Writes the buffered bytes to the file.
+    /// This does not synchronize the file with the disk (see File::flush).
+    /// @return Success or failure (in which case the bytes are discarded)
+    [[nodiscard]] ErrorFlag flush() noexcept
+    {
+      if (size == 0)
+        return ErrorFlag::success();
+      auto ret = write_all({buffer(), size});
+      size     = 0;
+      return ret;
+    }
+
+    /// @brief Writes a single byte
+    /// @param out The byte to write
+    /// @return Success or failure
+    [[nodiscard]] ErrorFlag write(u8 out) noexcept
+    {
+      if (size == blk.size())
+      {
+        if (auto ret = flush(); ret.is_error())
+          return ret;
+      }
+      buffer()[size++] = out;
+      return ErrorFlag::success();
+    }
+
+    /// @brief Writes multiple bytes.
+    /// Writes that are larger than the buffer do not go through the buffer.
+    /// @param out The bytes to write
+    /// @return Success or failure
+    [[nodiscard]] ErrorFlag write(View<u8> out) noexcept
+    {
+      if (out.size() <= blk.size() - size)
+      {
+        std::memcpy(buffer() + size, out.data(), out.size());
+        size += out.size();
+        return ErrorFlag::success();
+      }
+      if (auto ret = flush(); ret.is_error())
+        return ret;
+      if (out.size() >= blk.size())
+        return write_all(out);
+      std::memcpy(buffer(), out.data(), out.size());
+      size = out.size();
+      return ErrorFlag::success();
+    }
+
+    template<StringEncoding ENCODING, bool ZSTRING>
+    /// @brief Writes the units of a string
+    /// @param out The string to write
+    /// @return Success or failure
+    [[nodiscard]] ErrorFlag write(BasicStringView<ENCODING, ZSTRING> out) noexcept
+    {
+      return write(View<u8>{
+          ptr_to<const u8*>(out.data()),
+          out.unit_len() * sizeof(typename decltype(out)::underlying_type)});
+    }
+  };
+
+  /// @brief BufferedReader using the global allocator
+  using BufferedReader = BasicBufferedReader<decltype(mem::GlobalAllocator)>;
+  /// @brief BufferedWriter using the global allocator
+  using BufferedWriter = BasicBufferedWriter<decltype(mem::GlobalAllocator)>;
+} // namespace clt
+
+#endif // !HG_COLT_BUFFERED_FILE
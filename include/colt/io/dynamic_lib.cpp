@@ -6,6 +6,11 @@
  * @date   August 2024
  *********************************************************************/
 #include "dynamic_lib.h"
+#include <cstring>
+#include "colt/dsa/flat_map.h"
+#include "colt/mem/arena_alloc.h"
+#include "colt/mem/simple_alloc.h"
+#include "colt/hash.h"
 
 #ifdef COLT_WINDOWS
   #define NOMINMAX
@@ -15,12 +20,92 @@
   #include <dlfcn.h>
 #endif // COLT_WINDOWS
 
+namespace clt::details
+{
+  /// @brief Hashes the names of symbols
+  struct SymbolNameHash
+  {
+    size_t operator()(std::string_view name) const noexcept
+    {
+      wyhash_h h;
+      h(name.data(), name.size());
+      return static_cast<size_t>(static_cast<u64>(h));
+    }
+  };
+
+  struct SymbolCache
+  {
+    /// @brief The resolved symbols (null for symbols that do not exist)
+    FlatMap<std::string_view, void*, SymbolNameHash> symbols;
+    /// @brief The storage of the names (the keys of 'symbols')
+    mem::ArenaAllocator<mem::Mallocator, 4096, 1> names;
+
+    /// @brief Returns the cached symbol 'name', resolving it if needed
+    /// @param lib The library
+    /// @param name The name of the symbol
+    /// @return The symbol or null if it does not exist
+    void* resolve(const DynamicLib& lib, ZStringView name) noexcept
+    {
+      const std::string_view key = {name.data(), name.unit_len()};
+      if (auto found = symbols.get(key); found != nullptr)
+        return *found;
+      void* symbol = lib.find_symbol(name.c_str());
+      // The names passed by the user may not outlive the cache
+      auto blk = names.alloc(key.size());
+      std::memcpy(blk.ptr(), key.data(), key.size());
+      symbols.try_emplace(
+          std::string_view{static_cast<const char*>(blk.ptr()), key.size()},
+          symbol);
+      return symbol;
+    }
+  };
+} // namespace clt::details
+
 namespace clt
 {
+  void* DynamicLib::resolve(ZStringView name)
+  {
+    if (is_closed())
+      return nullptr;
+    if (_cache == nullptr)
+      _cache = new details::SymbolCache();
+    return _cache->resolve(*this, name);
+  }
+
+  size_t DynamicLib::resolve_all(View<ZStringView> names, Span<void*> symbols)
+  {
+    assert_true(
+        "'names' and 'symbols' must have the same size!",
+        names.size() == symbols.size());
+    if (is_closed())
+    {
+      std::fill(symbols.begin(), symbols.end(), nullptr);
+      return names.size();
+    }
+    if (_cache == nullptr)
+      _cache = new details::SymbolCache();
+    _cache->symbols.reserve(_cache->symbols.size() + names.size());
+
+    size_t not_found = 0;
+    for (size_t i = 0; i < names.size(); i++)
+    {
+      symbols[i] = _cache->resolve(*this, names[i]);
+      not_found += static_cast<size_t>(symbols[i] == nullptr);
+    }
+    return not_found;
+  }
+
+  size_t DynamicLib::cached_count() const noexcept
+  {
+    return _cache == nullptr ? 0 : _cache->symbols.size();
+  }
+
 #ifdef COLT_WINDOWS
   void DynamicLib::close()
   {
     FreeLibrary((HMODULE)_handle);
+    _handle = nullptr;
+    delete std::exchange(_cache, nullptr);
   }
 
   void* DynamicLib::find_symbol(const char* name) const
@@ -38,7 +123,8 @@ namespace clt
     return None;
   }
 
-  Option<DynamicLib> DynamicLib::open(const char* path) noexcept
+  Option<DynamicLib> DynamicLib::open(
+      const char* path, [[maybe_unused]] Binding binding) noexcept
   {
     assert_true("Path must not be NUL!", path != nullptr);
     auto ptr = LoadLibrary(path);
@@ -50,6 +136,8 @@ namespace clt
   void DynamicLib::close()
   {
     dlclose(_handle);
+    _handle = nullptr;
+    delete std::exchange(_cache, nullptr);
   }
 
   void* DynamicLib::find_symbol(const char* name) const
@@ -67,10 +155,10 @@ namespace clt
     return None;
   }
 
-  Option<DynamicLib> DynamicLib::open(const char* path) noexcept
+  Option<DynamicLib> DynamicLib::open(const char* path, Binding binding) noexcept
   {
     assert_true("Path must not be null!", path != nullptr);
-    auto ptr = dlopen(path, RTLD_LAZY);
+    auto ptr = dlopen(path, binding == Binding::Now ? RTLD_NOW : RTLD_LAZY);
     if (ptr)
       return DynamicLib((void*)ptr);
     return None;
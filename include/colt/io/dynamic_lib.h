@@ -1,7 +1,11 @@
 /*****************************************************************//**
  * @file   dynamic_lib.h
  * @brief  Contains `DynamicLib`, which represents a dynamic library
- *         in an OS agnostic way.
+ *         in an OS agnostic way, and `LazySymbol`, a function of a
+ *         library that is only resolved when first called.
+ * Symbols resolved through `resolve` or `resolve_all` are cached by the
+ * library: resolving the same entry points again does not go through
+ * the OS loader.
  * 
  * @author RPC
  * @date   August 2024
@@ -9,17 +13,26 @@
 #ifndef HG_OS_DYNAMIC_LIB
 #define HG_OS_DYNAMIC_LIB
 
+#include <atomic>
 #include <filesystem>
 #include "colt/dsa/option.h"
 #include "colt/dsa/string_view.h"
 
 namespace clt
 {
+  namespace details
+  {
+    /// @brief The cache of the symbols resolved by a DynamicLib
+    struct SymbolCache;
+  } // namespace details
+
   /// @brief Represents a dynamic library in an platform-agnostic way.
   class DynamicLib
   {
     /// @brief The handle to the library
     void* _handle = nullptr;
+    /// @brief The cache of resolved symbols (created on the first 'resolve')
+    details::SymbolCache* _cache = nullptr;
 
     /// @brief Constructs a library with
     /// @param handle The pointer to the handle
@@ -28,6 +41,20 @@ namespace clt
     {
     }
   public:
+    /// @brief When the symbols referenced by a library are bound.
+    /// This is only meaningful on POSIX: Windows binds the imports of a
+    /// library when loading it.
+    enum class Binding : u8
+    {
+      /// @brief Functions are bound on their first call (RTLD_LAZY):
+      /// faster to open, but the first call of each function is slower
+      Lazy,
+      /// @brief All the symbols are bound when opening (RTLD_NOW):
+      /// slower to open, but fails early on undefined symbols
+      Now,
+    };
+    using enum Binding;
+
     /// @brief Default constructor. Returns a library that is not open
     DynamicLib()                             = default;
     DynamicLib(const DynamicLib&)            = delete;
@@ -37,6 +64,7 @@ namespace clt
     /// @param other The library whose handle to steal
     DynamicLib(DynamicLib&& other) noexcept
         : _handle(std::exchange(other._handle, nullptr))
+        , _cache(std::exchange(other._cache, nullptr))
     {
     }
     /// @brief Move assignment operator
@@ -46,6 +74,7 @@ namespace clt
     {
       assert_true("Self assignment is prohibited!", &other != this);
       std::swap(_handle, other._handle);
+      std::swap(_cache, other._cache);
       return *this;
     }
     /// @brief Destructor, calls close if not already closed.
@@ -63,7 +92,7 @@ namespace clt
     /// @return True if not closed
     bool is_open() const noexcept { return _handle != nullptr; }
 
-    /// @brief Closes the library.
+    /// @brief Closes the library (and clears the cache of symbols).
     /// This is done automatically by the destructor.
     COLTCPP_EXPORT void close();
     /// @brief Searches for a symbol in the currently loaded library
@@ -103,19 +132,119 @@ namespace clt
       return reinterpret_cast<Ty>(sym);
     }
 
+    /// @brief Searches for a symbol, caching the result.
+    /// Symbols that are not found are also cached.
+    /// If `is_closed()`, always returns null.
+    /// @param name The symbol's name
+    /// @return null if not found or pointer to that symbol
+    COLTCPP_EXPORT void* resolve(ZStringView name);
+    /// @brief Searches for multiple symbols, caching the results.
+    /// The cache is grown once for all the symbols.
+    /// @param names The names of the symbols
+    /// @param symbols The symbols (null if not found), of the size of 'names'
+    /// @return The count of symbols that were not found
+    COLTCPP_EXPORT size_t resolve_all(
+        View<ZStringView> names, Span<void*> symbols);
+    /// @brief Returns the count of symbols in the cache
+    /// @return The count of symbols resolved through 'resolve'
+    COLTCPP_EXPORT size_t cached_count() const noexcept;
+
     /// @brief Opens the current process as a dynamic library
     /// @return None on errors
     COLTCPP_EXPORT static Option<DynamicLib> open() noexcept;
     /// @brief Opens a dynamic library with path 'path'
     /// @param path The path to the dynamic library
+    /// @param binding When the symbols of the library are bound
     /// @return None on errors
-    COLTCPP_EXPORT static Option<DynamicLib> open(const char* path) noexcept;
+    COLTCPP_EXPORT static Option<DynamicLib> open(
+        const char* path, Binding binding = Lazy) noexcept;
     /// @brief Opens a dynamic library with path 'path'
     /// @param path The path to the dynamic library
+    /// @param binding When the symbols of the library are bound
     /// @return None on errors
-    static Option<DynamicLib> open(ZStringView path) noexcept
+    static Option<DynamicLib> open(
+        ZStringView path, Binding binding = Lazy) noexcept
+    {
+      return open(path.c_str(), binding);
+    }
+  };
+
+  template<typename Fn>
+  class LazySymbol;
+
+  template<typename Ret, typename... Args>
+  /// @brief Function of a DynamicLib that is resolved when first called.
+  /// This makes it possible to declare hundreds of entry points without
+  /// paying for their resolution on startup:
+  /// @code{.cpp}
+  /// static const LazySymbol<int(const char*)> plugin_init = {lib, "init"};
+  /// plugin_init("config"); // resolved here
+  /// @endcode
+  /// Calling a function that does not exist is a fatal error: use 'bind'
+  /// to check if it exists. Concurrent calls are safe (the library must
+  /// outlive the symbol).
+  /// @tparam Ret The return type of the function
+  /// @tparam ...Args The parameters of the function
+  class LazySymbol<Ret(Args...)>
+  {
+    /// @brief The type of the function
+    using fn_t = Ret (*)(Args...);
+
+    /// @brief The library containing the function
+    const DynamicLib* lib;
+    /// @brief The name of the function (which must outlive the symbol)
+    const char* name;
+    /// @brief The function (null if not bound yet)
+    mutable std::atomic<fn_t> symbol = nullptr;
+
+    /// @brief Binds the function, aborting if it does not exist
+    /// @return The function
+    fn_t bind_or_abort() const noexcept
+    {
+      if (!bind())
+        clt::unreachable("Lazily bound symbol was not found!");
+      return symbol.load(std::memory_order_relaxed);
+    }
+
+  public:
+    /// @brief Constructor, does not resolve the function
+    /// @param lib The library containing the function
+    /// @param name The name of the function (which must outlive the symbol)
+    LazySymbol(const DynamicLib& lib, const char* name) noexcept
+        : lib(&lib)
+        , name(name)
+    {
+    }
+
+    /// @brief Resolves the function if it was not already
+    /// @return True if the function exists
+    bool bind() const noexcept
+    {
+      if (symbol.load(std::memory_order_acquire) != nullptr)
+        return true;
+      auto ptr = reinterpret_cast<fn_t>(lib->find_symbol(name));
+      if (ptr == nullptr)
+        return false;
+      symbol.store(ptr, std::memory_order_release);
+      return true;
+    }
+
+    /// @brief Check if the function was already resolved
+    /// @return True if resolved
+    bool is_bound() const noexcept
+    {
+      return symbol.load(std::memory_order_relaxed) != nullptr;
+    }
+
+    /// @brief Calls the function, resolving it on the first call
+    /// @param ...args The arguments to forward
+    /// @return The result of the function
+    Ret operator()(Args... args) const
     {
-      return open(path.c_str());
+      fn_t fn = symbol.load(std::memory_order_acquire);
+      if (HEDLEY_UNLIKELY(fn == nullptr))
+        fn = bind_or_abort();
+      return fn(std::forward<Args>(args)...);
     }
   };
 } // namespace clt::os
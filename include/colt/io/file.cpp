@@ -1,4 +1,5 @@
 #include "file.h"
+#include <colt/num/math.h>
 
 #ifdef COLT_WINDOWS
   #include <io.h>
@@ -140,26 +141,158 @@ namespace clt
     return None;
   }
 
+  /// @brief The maximum count of bytes passed to a single system call
+  static constexpr size_t MAX_IO_CHUNK = 1ULL << 30;
+
   Option<size_t> File::read(Span<u8> out) noexcept
   {
     if (!is_open() || access != FileAccess::Read)
       return None;
-    // TODO: overflow check
-    auto read = _read(this->fileno(), out.data(), (unsigned int)out.size_bytes());
-    if (read < 0)
-      return None;
-    return Option<size_t>((size_t)read);
+    // _read takes an unsigned int: read by chunks
+    size_t total = 0;
+    while (total != out.size())
+    {
+      const auto chunk = (unsigned int)clt::min(out.size() - total, MAX_IO_CHUNK);
+      auto read        = _read(this->fileno(), out.data() + total, chunk);
+      if (read < 0)
+        return total == 0 ? Option<size_t>(None) : Option<size_t>(total);
+      total += (size_t)read;
+      if ((unsigned int)read != chunk)
+        break;
+    }
+    return Option<size_t>(total);
   }
 
   Option<size_t> File::write(View<u8> out) noexcept
   {
     if (!is_open() || access == FileAccess::Read)
       return None;
-    // TODO: overflow check
-    auto write = _write(this->fileno(), out.data(), (unsigned int)out.size_bytes());
-    if (write < 0)
+    // _write takes an unsigned int: write by chunks
+    size_t total = 0;
+    while (total != out.size())
+    {
+      const auto chunk = (unsigned int)clt::min(out.size() - total, MAX_IO_CHUNK);
+      auto write       = _write(this->fileno(), out.data() + total, chunk);
+      if (write <= 0)
+        return total == 0 ? Option<size_t>(None) : Option<size_t>(total);
+      total += (size_t)write;
+    }
+    return Option<size_t>(total);
+  }
+
+  /// @brief Returns an OVERLAPPED whose offset is 'offset'
+  /// @param offset The offset in the file
+  /// @return OVERLAPPED structure
+  static OVERLAPPED overlapped_at(u64 offset) noexcept
+  {
+    OVERLAPPED ret{};
+    ret.Offset     = (DWORD)(offset & 0xFFFFFFFF);
+    ret.OffsetHigh = (DWORD)(offset >> 32);
+    return ret;
+  }
+
+  /// @brief Returns the current position of a file
+  /// @param handle The file
+  /// @return None on errors, else the position
+  static Option<LARGE_INTEGER> file_position(HANDLE handle) noexcept
+  {
+    LARGE_INTEGER ret{};
+    if (!SetFilePointerEx(handle, LARGE_INTEGER{}, &ret, FILE_CURRENT))
       return None;
-    return Option<size_t>((size_t)write);
+    return ret;
+  }
+
+  Option<size_t> File::read_at(Span<u8> out, u64 offset) noexcept
+  {
+    if (!is_open() || access != FileAccess::Read)
+      return None;
+    auto handle = (HANDLE)_get_osfhandle(this->fileno());
+    // ReadFile moves the position of synchronous handles: restore it
+    auto position = file_position(handle);
+    if (position.is_none())
+      return None;
+    ON_SCOPE_EXIT
+    {
+      SetFilePointerEx(handle, *position, nullptr, FILE_BEGIN);
+    };
+    size_t total = 0;
+    while (total != out.size())
+    {
+      auto overlapped   = overlapped_at(offset + total);
+      const auto chunk  = (DWORD)clt::min(out.size() - total, MAX_IO_CHUNK);
+      DWORD read        = 0;
+      if (!ReadFile(handle, out.data() + total, chunk, &read, &overlapped))
+      {
+        if (GetLastError() == ERROR_HANDLE_EOF)
+          break;
+        return None;
+      }
+      total += read;
+      if (read != chunk)
+        break;
+    }
+    return Option<size_t>(total);
+  }
+
+  Option<size_t> File::write_at(View<u8> out, u64 offset) noexcept
+  {
+    if (!is_open() || access == FileAccess::Read)
+      return None;
+    auto handle = (HANDLE)_get_osfhandle(this->fileno());
+    // WriteFile moves the position of synchronous handles: restore it
+    auto position = file_position(handle);
+    if (position.is_none())
+      return None;
+    ON_SCOPE_EXIT
+    {
+      SetFilePointerEx(handle, *position, nullptr, FILE_BEGIN);
+    };
+    size_t total = 0;
+    while (total != out.size())
+    {
+      auto overlapped  = overlapped_at(offset + total);
+      const auto chunk = (DWORD)clt::min(out.size() - total, MAX_IO_CHUNK);
+      DWORD write      = 0;
+      if (!WriteFile(handle, out.data() + total, chunk, &write, &overlapped)
+          || write == 0)
+        return None;
+      total += write;
+    }
+    return Option<size_t>(total);
+  }
+
+  Option<size_t> File::readv(View<Span<u8>> out) noexcept
+  {
+    if (!is_open() || access != FileAccess::Read)
+      return None;
+    // No vectored I/O on file descriptors: read buffer by buffer
+    size_t total = 0;
+    for (auto buffer : out)
+    {
+      auto read = this->read(buffer);
+      if (read.is_none())
+        return total == 0 ? Option<size_t>(None) : Option<size_t>(total);
+      total += *read;
+      if (*read != buffer.size())
+        break;
+    }
+    return Option<size_t>(total);
+  }
+
+  Option<size_t> File::writev(View<View<u8>> out) noexcept
+  {
+    if (!is_open() || access == FileAccess::Read)
+      return None;
+    // No vectored I/O on file descriptors: write buffer by buffer
+    size_t total = 0;
+    for (auto buffer : out)
+    {
+      auto write = this->write(buffer);
+      if (write.is_none() || *write != buffer.size())
+        return None;
+      total += *write;
+    }
+    return Option<size_t>(total);
   }
 
   bool File::is_eof() const noexcept
@@ -199,8 +332,11 @@ namespace clt
 #else // linux
 
   #include <sys/stat.h>
+  #include <sys/uio.h>
   #include <unistd.h>
   #include <fcntl.h>
+  #include <cerrno>
+  #include <climits>
 
 namespace clt
 {
@@ -345,6 +481,119 @@ namespace clt
     return Option<size_t>((size_t)write);
   }
 
+  Option<size_t> File::read_at(Span<u8> out, u64 offset) noexcept
+  {
+    if (!is_open() || access != FileAccess::Read)
+      return None;
+    size_t total = 0;
+    while (total != out.size())
+    {
+      auto read = ::pread(
+          this->fileno(), out.data() + total, out.size() - total,
+          (off_t)(offset + total));
+      if (read < 0)
+      {
+        if (errno == EINTR)
+          continue;
+        return None;
+      }
+      if (read == 0)
+        break;
+      total += (size_t)read;
+    }
+    return Option<size_t>(total);
+  }
+
+  Option<size_t> File::write_at(View<u8> out, u64 offset) noexcept
+  {
+    if (!is_open() || access == FileAccess::Read)
+      return None;
+    size_t total = 0;
+    while (total != out.size())
+    {
+      auto write = ::pwrite(
+          this->fileno(), out.data() + total, out.size() - total,
+          (off_t)(offset + total));
+      if (write < 0 && errno == EINTR)
+        continue;
+      if (write <= 0)
+        return None;
+      total += (size_t)write;
+    }
+    return Option<size_t>(total);
+  }
+
+  /// @brief The maximum count of buffers passed to a single system call
+  static constexpr size_t MAX_IOVEC = IOV_MAX;
+
+  Option<size_t> File::readv(View<Span<u8>> out) noexcept
+  {
+    if (!is_open() || access != FileAccess::Read)
+      return None;
+    ::iovec iov[MAX_IOVEC];
+    size_t total = 0;
+    size_t index = 0;
+    while (index != out.size())
+    {
+      const size_t count = clt::min(out.size() - index, MAX_IOVEC);
+      size_t expected    = 0;
+      for (size_t i = 0; i < count; i++)
+      {
+        iov[i]    = {out[index + i].data(), out[index + i].size()};
+        expected += out[index + i].size();
+      }
+      auto read = ::readv(this->fileno(), iov, (int)count);
+      if (read < 0 && errno == EINTR)
+        continue;
+      if (read < 0)
+        return total == 0 ? Option<size_t>(None) : Option<size_t>(total);
+      total += (size_t)read;
+      if ((size_t)read != expected)
+        break;
+      index += count;
+    }
+    return Option<size_t>(total);
+  }
+
+  Option<size_t> File::writev(View<View<u8>> out) noexcept
+  {
+    if (!is_open() || access == FileAccess::Read)
+      return None;
+    ::iovec iov[MAX_IOVEC];
+    size_t total = 0;
+    // The buffer to write, and the count of its bytes already written
+    size_t index   = 0;
+    size_t written = 0;
+    while (index != out.size())
+    {
+      size_t count = 0;
+      for (size_t i = index; i < out.size() && count < MAX_IOVEC; i++)
+      {
+        const size_t skip = i == index ? written : 0;
+        iov[count++]      = {
+            const_cast<u8*>(out[i].data()) + skip, out[i].size() - skip};
+      }
+      auto write = ::writev(this->fileno(), iov, (int)count);
+      if (write < 0 && errno == EINTR)
+        continue;
+      if (write < 0)
+        return None;
+      total += (size_t)write;
+      // Skip the buffers that were written entirely
+      size_t remaining = (size_t)write;
+      while (index != out.size() && remaining >= out[index].size() - written)
+      {
+        remaining -= out[index].size() - written;
+        written = 0;
+        index++;
+      }
+      written += remaining;
+      if (write == 0 && index != out.size())
+        return None;
+    }
+    return Option<size_t>(total);
+  }
+
   bool File::is_eof() const noexcept
   {
     if (!is_open())
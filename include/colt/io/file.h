@@ -7,9 +7,23 @@
 
 namespace clt
 {
+  struct IOCompletion;
+  struct Pipe;
+  class AsyncIO;
+
+  namespace details
+  {
+    class AsyncIOImpl;
+  }
+
   /// @brief Represents a file handle
   class File
   {
+    friend struct IOCompletion;
+    friend struct Pipe;
+    friend class AsyncIO;
+    friend class details::AsyncIOImpl;
+
   public:
     /// @brief The file access when opening
     enum class FileAccess : u8
@@ -116,6 +130,47 @@ namespace clt
     /// @return None on errors or the number of bytes written
     [[nodiscard]] COLTCPP_EXPORT Option<size_t> write(View<u8> out) noexcept;
 
+    /// @brief Reads multiple bytes from a file, starting at 'offset'.
+    /// The current position of the file is not used, which allows
+    /// reading concurrently from the same file.
+    /// On Windows, the position is moved by the read and then restored:
+    /// concurrent calls then leave an unspecified position, and must not
+    /// be mixed with 'read' or 'write'.
+    /// @param out Where to write the read bytes
+    /// @param offset The offset in the file from which to read
+    /// @return None on errors or the number of bytes read
+    [[nodiscard]] COLTCPP_EXPORT Option<size_t> read_at(
+        Span<u8> out, u64 offset) noexcept;
+
+    /// @brief Writes multiple bytes to a file, starting at 'offset'.
+    /// Short writes are retried until all the bytes are written.
+    /// On Windows, the position is moved by the write and then restored
+    /// (see 'read_at').
+    /// If the file is opened as read, returns None.
+    /// If the file is not opened, returns None.
+    /// @param out The bytes to write
+    /// @param offset The offset in the file at which to write
+    /// @return None on errors or the number of bytes written
+    [[nodiscard]] COLTCPP_EXPORT Option<size_t> write_at(
+        View<u8> out, u64 offset) noexcept;
+
+    /// @brief Reads into multiple buffers (scatter read), in order.
+    /// On Linux, this is a single system call for up to 'IOV_MAX' buffers.
+    /// Reading stops once a buffer could not be filled entirely.
+    /// If the file is not opened as read, returns None.
+    /// @param out The buffers in which to write the read bytes
+    /// @return None on errors or the total number of bytes read
+    [[nodiscard]] COLTCPP_EXPORT Option<size_t> readv(View<Span<u8>> out) noexcept;
+
+    /// @brief Writes multiple buffers (gather write), in order.
+    /// On Linux, this is a single system call for up to 'IOV_MAX' buffers.
+    /// Short writes are retried until all the bytes are written.
+    /// If the file is opened as read, returns None.
+    /// If the file is not opened, returns None.
+    /// @param out The buffers to write
+    /// @return None on errors or the total number of bytes written
+    [[nodiscard]] COLTCPP_EXPORT Option<size_t> writev(View<View<u8>> out) noexcept;
+
     /// @brief Check if the current file has hit the EOF.
     /// If the file is not open, returns false.
     /// @return True if the end of file was hit
@@ -0,0 +1,594 @@
+/*****************************************************************/ /**
+ * @file   hash_index.h
+ * @brief  Contains BasicHashIndexWriter and BasicHashIndex, a read-only
+ * hash table format that is queried in place (for example from a
+ * ViewOfFile), without any deserialization.
+ * The index is relocatable (it only contains offsets) and all its
+ * integers are stored in the endianness of the index:
+ * - a header of HASH_INDEX_HEADER_SIZE bytes (magic, format, endianness,
+ *   the version of the schema, the kinds of the keys and values, a
+ *   fingerprint of the hashing algorithm and a checksum of the rest)
+ * - the slots (a power of two, at most half full, linearly probed):
+ *   each slot is the tag (hash | 1, or 0 if empty), the key and the
+ *   value, stored as 64-bit integers
+ * - the blob containing the strings (the key or value of a slot is
+ *   then the offset of the string: its 32-bit length then its bytes).
+ * The hash of a key is computed by the hashing algorithm over the
+ * representation of the key in the index (as uhash does for bytes):
+ * an index whose algorithm differs from the one of the reader is
+ * rejected on open, rather than failing every lookup.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_HASH_INDEX
+#define HG_COLT_HASH_INDEX
+
+#include <bit>
+#include <cstring>
+#include <algorithm>
+
+#include <colt/hash.h>
+#include <colt/io/binary_archive.h>
+
+namespace clt
+{
+  /// @brief The magic number starting a hash index ("CLTH" in little endian)
+  static constexpr u32 HASH_INDEX_MAGIC = 0x48544C43;
+  /// @brief The version of the format of the hash indices
+  static constexpr u16 HASH_INDEX_FORMAT_VERSION = 1;
+  /// @brief The size of the header of a hash index (which aligns the slots)
+  static constexpr size_t HASH_INDEX_HEADER_SIZE = 64;
+  /// @brief The size of a slot of a hash index
+  static constexpr size_t HASH_INDEX_SLOT_SIZE = 3 * sizeof(u64);
+
+  namespace details
+  {
+    /// @brief Views over bytes (such as std::string_view or StringView),
+    ///        which are stored in the blob of a hash index.
+    template<typename T>
+    concept index_string =
+        std::is_trivially_copyable_v<T> && requires(const T& str) {
+          { str.data()[0] };
+          { str.size() } -> std::convertible_to<size_t>;
+        } && sizeof(*std::declval<const T&>().data()) == 1
+        && std::constructible_from<
+            T, decltype(std::declval<const T&>().data()), size_t>;
+
+    /// @brief Types that can be the keys of a hash index
+    template<typename T>
+    concept index_key =
+        ((std::integral<T> || std::is_enum_v<T>) && sizeof(T) <= 8)
+        || index_string<T>;
+
+    /// @brief Types that can be the values of a hash index
+    template<typename T>
+    concept index_value = archive_scalar<T> || index_string<T>;
+
+    /// @brief Returns the count of bytes of a string
+    /// @param str The string
+    /// @return The count of bytes of the string
+    template<index_string T>
+    constexpr size_t index_string_len(const T& str) noexcept
+    {
+      if constexpr (requires { str.unit_len(); })
+        return str.unit_len();
+      else
+        return static_cast<size_t>(str.size());
+    }
+
+    /// @brief Returns the kinds of the keys and values stored in the header.
+    /// Bit 0 is set if the keys are strings, bit 1 if the values are, and
+    /// bit 2 if the values are floating points.
+    /// @return The kinds
+    template<index_key Key, index_value Value>
+    constexpr u8 index_kinds() noexcept
+    {
+      return static_cast<u8>(
+          u8(index_string<Key>) | u8(index_string<Value>) << 1
+          | u8(std::is_floating_point_v<Value>) << 2);
+    }
+
+    /// @brief The header of a hash index (whose fields are stored in the
+    ///        endianness of the index)
+    struct HashIndexHeader
+    {
+      /// @brief HASH_INDEX_MAGIC
+      u32 magic;
+      /// @brief HASH_INDEX_FORMAT_VERSION
+      u16 format;
+      /// @brief 1 if big endian, 0 if little endian
+      u8 endian;
+      /// @brief The kinds of the keys and values (see index_kinds)
+      u8 kinds;
+      /// @brief The version of the schema of the keys and values
+      u32 version;
+      /// @brief The size of the keys (if not strings)
+      u8 key_size;
+      /// @brief The size of the values (if not strings)
+      u8 value_size;
+      /// @brief Reserved (0)
+      u16 reserved;
+      /// @brief The hash of HASH_INDEX_MAGIC by the hashing algorithm
+      u64 fingerprint;
+      /// @brief The count of slots (a power of two)
+      u64 slot_count;
+      /// @brief The count of entries
+      u64 entry_count;
+      /// @brief The offset of the blob (from the start of the index)
+      u64 blob_offset;
+      /// @brief The size of the blob
+      u64 blob_size;
+      /// @brief The hash of the bytes following the header
+      u64 checksum;
+
+      /// @brief Converts the fields to or from the endianness of an index
+      /// @tparam ENDIAN The endianness of the index
+      /// @tparam TO True to convert to the index, false from it
+      /// @return The converted header
+      template<std::endian ENDIAN, bool TO>
+      constexpr HashIndexHeader convert() const noexcept
+      {
+        auto conv = []<typename T>(T value)
+        {
+          if constexpr (TO)
+            return std::bit_cast<T>(to_archive_endian<ENDIAN>(value));
+          else
+            return from_archive_endian<ENDIAN, T>(
+                std::bit_cast<archive_bits_t<T>>(value));
+        };
+        return {
+            conv(magic),       conv(format),      endian,
+            kinds,             conv(version),     key_size,
+            value_size,        conv(reserved),    conv(fingerprint),
+            conv(slot_count),  conv(entry_count), conv(blob_offset),
+            conv(blob_size),   conv(checksum)};
+      }
+    };
+    static_assert(
+        sizeof(HashIndexHeader) == HASH_INDEX_HEADER_SIZE,
+        "The header must not contain padding!");
+
+    /// @brief Returns the result of a hashing algorithm as a 64-bit integer
+    /// @tparam HASH_ALGO The hashing algorithm
+    /// @param algo The hashing algorithm object
+    /// @return The result
+    template<meta::hash_algorithm HASH_ALGO>
+    u64 index_hash_result(const HASH_ALGO& algo) noexcept
+    {
+      return static_cast<u64>(static_cast<typename HASH_ALGO::result_type>(algo));
+    }
+
+    /// @brief Returns the fingerprint of a hashing algorithm (the hash of
+    ///        HASH_INDEX_MAGIC in little endian)
+    /// @tparam HASH_ALGO The hashing algorithm
+    /// @return The fingerprint
+    template<meta::hash_algorithm HASH_ALGO>
+    u64 index_fingerprint() noexcept
+    {
+      HASH_ALGO algo;
+      const u32 magic = htol(HASH_INDEX_MAGIC);
+      algo(&magic, sizeof(magic));
+      return index_hash_result(algo);
+    }
+
+    /// @brief Encodes a scalar as stored in a slot
+    /// @tparam ENDIAN The endianness of the index
+    /// @param value The scalar
+    /// @return The 64-bit integer (in the endianness of the index)
+    template<std::endian ENDIAN, archive_scalar T>
+    u64 index_encode_scalar(T value) noexcept
+    {
+      return to_archive_endian<ENDIAN>(
+          static_cast<u64>(std::bit_cast<archive_bits_t<T>>(value)));
+    }
+
+    /// @brief Decodes a scalar stored in a slot
+    /// @tparam ENDIAN The endianness of the index
+    /// @param bits The 64-bit integer (in the endianness of the index)
+    /// @return The scalar
+    template<std::endian ENDIAN, archive_scalar T>
+    T index_decode_scalar(u64 bits) noexcept
+    {
+      return std::bit_cast<T>(
+          static_cast<archive_bits_t<T>>(from_archive_endian<ENDIAN, u64>(bits)));
+    }
+
+    /// @brief Hashes a key as stored in a hash index
+    /// @tparam HASH_ALGO The hashing algorithm
+    /// @tparam ENDIAN The endianness of the index
+    /// @param key The key
+    /// @return The hash of the key
+    template<meta::hash_algorithm HASH_ALGO, std::endian ENDIAN, index_key Key>
+    u64 index_hash_key(const Key& key) noexcept
+    {
+      HASH_ALGO algo;
+      if constexpr (index_string<Key>)
+        hash_units(algo, key.data(), index_string_len(key));
+      else
+      {
+        // The bytes of the key in the index: independent of the host
+        const auto bits = to_archive_endian<ENDIAN>(key);
+        hash_units(algo, &bits, 1);
+      }
+      return index_hash_result(algo);
+    }
+
+    /// @brief Loads a 64-bit integer from the bytes of a hash index
+    /// @param ptr The pointer from which to read
+    /// @return The integer (in the endianness of the index)
+    inline u64 index_load(const u8* ptr) noexcept
+    {
+      u64 value;
+      std::memcpy(&value, ptr, sizeof(value));
+      return value;
+    }
+  } // namespace details
+
+  template<
+      details::index_key Key, details::index_value Value,
+      meta::hash_algorithm HASH_ALGO = COLT_DEFAULT_HASH_ALGORITHM,
+      std::endian ENDIAN             = std::endian::little>
+    requires(ENDIAN == std::endian::little || ENDIAN == std::endian::big)
+  /// @brief Builds a hash index (see BasicHashIndex).
+  /// @code{.cpp}
+  /// HashIndexWriter<StringView, u64> writer{SYMBOLS_VERSION};
+  /// writer.insert_all(symbols); // a Map or a FlatMap
+  /// writer.write_to(*file).discard();
+  /// @endcode
+  /// @tparam Key The key type (integer, enum or view over bytes)
+  /// @tparam Value The value type (scalar or view over bytes)
+  /// @tparam HASH_ALGO The hashing algorithm
+  /// @tparam ENDIAN The endianness of the index
+  class BasicHashIndexWriter
+  {
+    /// @brief An entry of the index (encoded as stored in its slot)
+    struct Entry
+    {
+      /// @brief The hash of the key
+      u64 hash;
+      /// @brief The encoded key
+      u64 key;
+      /// @brief The encoded value
+      u64 value;
+    };
+
+    /// @brief The entries
+    Vector<Entry> entries = Vector<Entry>{mem::GlobalAllocator};
+    /// @brief The strings
+    Vector<u8> blob = Vector<u8>{mem::GlobalAllocator};
+    /// @brief The version of the schema
+    u32 version;
+
+    /// @brief Encodes a key or a value
+    /// @param value The key or value
+    /// @return The 64-bit integer stored in the slot
+    template<typename T>
+    u64 encode(const T& value) noexcept
+    {
+      if constexpr (details::index_string<T>)
+      {
+        const size_t len = details::index_string_len(value);
+        assert_true("String too long for a hash index!", len <= UINT32_MAX);
+        const u64 offset = blob.size();
+        const u32 size   = details::to_archive_endian<ENDIAN>(static_cast<u32>(len));
+        blob.append_range(
+            View<u8>{reinterpret_cast<const u8*>(&size), sizeof(size)});
+        blob.append_range(
+            View<u8>{reinterpret_cast<const u8*>(value.data()), len});
+        return details::to_archive_endian<ENDIAN>(offset);
+      }
+      else
+        return details::index_encode_scalar<ENDIAN>(value);
+    }
+
+  public:
+    /// @brief Constructor
+    /// @param version The version of the schema of the keys and values
+    explicit BasicHashIndexWriter(u32 version = 0) noexcept
+        : version(version)
+    {
+    }
+
+    /// @brief Adds an entry to the index.
+    /// @pre The key was not already inserted
+    /// @param key The key
+    /// @param value The value
+    void insert(const Key& key, const Value& value) noexcept
+    {
+      const u64 hash = details::index_hash_key<HASH_ALGO, ENDIAN>(key);
+      entries.push_back(Entry{hash, encode(key), encode(value)});
+    }
+
+    /// @brief Adds all the entries of a map (such as a Map or a FlatMap)
+    /// @tparam MapLike The map type (whose keys and values are convertible
+    ///         to Key and Value)
+    /// @param map The map
+    template<typename MapLike>
+    void insert_all(const MapLike& map) noexcept
+    {
+      for (const auto& [key, value] : map)
+        insert(key, value);
+    }
+
+    /// @brief Returns the count of entries
+    /// @return The count of entries
+    [[nodiscard]] size_t size() const noexcept { return entries.size(); }
+
+    /// @brief Returns the bytes of the index
+    /// @return The index
+    [[nodiscard]] Vector<u8> build() const noexcept
+    {
+      const size_t slot_count  = std::bit_ceil(std::max<size_t>(2 * size(), 1));
+      const size_t blob_offset = HASH_INDEX_HEADER_SIZE
+                                 + slot_count * HASH_INDEX_SLOT_SIZE;
+      Vector<u8> ret = Vector<u8>{
+          mem::GlobalAllocator, blob_offset + blob.size(), InPlace, u8{0}};
+
+      u8* slots = ret.data() + HASH_INDEX_HEADER_SIZE;
+      for (const auto& entry : entries)
+      {
+        const u64 tag = details::to_archive_endian<ENDIAN>(entry.hash | 1);
+        size_t index  = entry.hash & (slot_count - 1);
+        while (details::index_load(slots + index * HASH_INDEX_SLOT_SIZE) != 0)
+        {
+          // (strings are stored at distinct offsets: only scalars are checked)
+          if constexpr (!details::index_string<Key>)
+          {
+            const u8* slot = slots + index * HASH_INDEX_SLOT_SIZE;
+            assert_true(
+                "Duplicate key in a hash index!",
+                details::index_load(slot) != tag
+                    || details::index_load(slot + sizeof(u64)) != entry.key);
+          }
+          index = (index + 1) & (slot_count - 1);
+        }
+        const u64 slot[3] = {tag, entry.key, entry.value};
+        std::memcpy(slots + index * HASH_INDEX_SLOT_SIZE, slot, sizeof(slot));
+      }
+      std::memcpy(ret.data() + blob_offset, blob.data(), blob.size());
+
+      HASH_ALGO checksum;
+      checksum(
+          ret.data() + HASH_INDEX_HEADER_SIZE,
+          ret.size() - HASH_INDEX_HEADER_SIZE);
+      const details::HashIndexHeader header = {
+          HASH_INDEX_MAGIC,
+          HASH_INDEX_FORMAT_VERSION,
+          static_cast<u8>(ENDIAN == std::endian::big),
+          details::index_kinds<Key, Value>(),
+          version,
+          static_cast<u8>(details::index_string<Key> ? 0 : sizeof(Key)),
+          static_cast<u8>(details::index_string<Value> ? 0 : sizeof(Value)),
+          0,
+          details::index_fingerprint<HASH_ALGO>(),
+          slot_count,
+          size(),
+          blob_offset,
+          blob.size(),
+          details::index_hash_result(checksum)};
+      const auto stored = header.template convert<ENDIAN, true>();
+      std::memcpy(ret.data(), &stored, sizeof(stored));
+      return ret;
+    }
+
+    /// @brief Writes the index to a file
+    /// @param file The file to which to write
+    /// @return Error if not all the bytes could be written
+    [[nodiscard]] ErrorFlag write_to(File& file) const noexcept
+    {
+      const auto data = build();
+      for (size_t written = 0; written != data.size();)
+      {
+        auto write =
+            file.write(View<u8>{data.data() + written, data.size() - written});
+        if (write.is_none() || *write == 0)
+          return ErrorFlag::error();
+        written += *write;
+      }
+      return ErrorFlag::success();
+    }
+  };
+
+  template<
+      details::index_key Key, details::index_value Value,
+      meta::hash_algorithm HASH_ALGO = COLT_DEFAULT_HASH_ALGORITHM,
+      std::endian ENDIAN             = std::endian::little>
+    requires(ENDIAN == std::endian::little || ENDIAN == std::endian::big)
+  /// @brief Read-only hash table queried in place (see hash_index.h).
+  /// String values are views of the memory of the index: they are valid
+  /// as long as the memory is.
+  /// @code{.cpp}
+  /// auto file  = ViewOfFile::open("symbols.idx");
+  /// auto index = HashIndex<StringView, u64>::open(*file, SYMBOLS_VERSION);
+  /// if (index.is_none()) // missing, corrupted or outdated index
+  ///   ...
+  /// auto value = index->find("main");
+  /// @endcode
+  /// @tparam Key The key type (integer, enum or view over bytes)
+  /// @tparam Value The value type (scalar or view over bytes)
+  /// @tparam HASH_ALGO The hashing algorithm
+  /// @tparam ENDIAN The endianness of the index
+  class BasicHashIndex
+  {
+    /// @brief The slots
+    const u8* slots;
+    /// @brief The blob of strings
+    const u8* blob;
+    /// @brief The size of the blob
+    u64 blob_size;
+    /// @brief The count of slots minus one
+    u64 mask;
+    /// @brief The count of entries
+    u64 count;
+    /// @brief The expected checksum
+    u64 checksum;
+
+    /// @brief Constructor
+    /// @param bytes The bytes of the index
+    /// @param header The (validated) header of the index
+    BasicHashIndex(View<u8> bytes, const details::HashIndexHeader& header) noexcept
+        : slots(bytes.data() + HASH_INDEX_HEADER_SIZE)
+        , blob(bytes.data() + header.blob_offset)
+        , blob_size(header.blob_size)
+        , mask(header.slot_count - 1)
+        , count(header.entry_count)
+        , checksum(header.checksum)
+    {
+    }
+
+    template<typename>
+    friend class Option; // for in place construction
+
+    /// @brief Returns the string at an offset of the blob
+    /// @param encoded The encoded offset
+    /// @param ptr Where to write the start of the string
+    /// @param len Where to write the count of bytes of the string
+    /// @return False if the string is out of the bounds of the blob
+    bool string_at(u64 encoded, const u8*& ptr, size_t& len) const noexcept
+    {
+      const u64 offset = details::from_archive_endian<ENDIAN, u64>(encoded);
+      if (offset > blob_size || blob_size - offset < sizeof(u32))
+        return false;
+      u32 size;
+      std::memcpy(&size, blob + offset, sizeof(size));
+      len = details::from_archive_endian<ENDIAN, u32>(size);
+      ptr = blob + offset + sizeof(u32);
+      return len <= blob_size - offset - sizeof(u32);
+    }
+
+    /// @brief Check if the key of a slot is equal to 'key'
+    /// @param encoded The encoded key of the slot
+    /// @param key The key
+    /// @return True if equal
+    bool is_key(u64 encoded, const Key& key) const noexcept
+    {
+      if constexpr (details::index_string<Key>)
+      {
+        const u8* ptr;
+        size_t len;
+        return string_at(encoded, ptr, len)
+               && len == details::index_string_len(key)
+               && std::memcmp(ptr, key.data(), len) == 0;
+      }
+      else
+        return encoded == details::index_encode_scalar<ENDIAN>(key);
+    }
+
+  public:
+    /// @brief Returns the count of entries
+    /// @return The count of entries
+    [[nodiscard]] size_t size() const noexcept { return count; }
+
+    /// @brief Searches for the value associated with 'key'
+    /// @param key The key whose value to find
+    /// @return None if not found, else the value
+    [[nodiscard]] Option<Value> find(const Key& key) const noexcept
+    {
+      const u64 hash = details::index_hash_key<HASH_ALGO, ENDIAN>(key);
+      const u64 tag  = details::to_archive_endian<ENDIAN>(hash | 1);
+      // (bounded, as the slots of a corrupted index may all be used)
+      for (u64 i = 0, index = hash & mask; i <= mask;
+           i++, index = (index + 1) & mask)
+      {
+        const u8* slot = slots + index * HASH_INDEX_SLOT_SIZE;
+        const u64 stored = details::index_load(slot);
+        if (stored == 0)
+          return None;
+        if (stored != tag || !is_key(details::index_load(slot + sizeof(u64)), key))
+          continue;
+        const u64 value = details::index_load(slot + 2 * sizeof(u64));
+        if constexpr (details::index_string<Value>)
+        {
+          using unit_t =
+              std::remove_cvref_t<decltype(*std::declval<Value>().data())>;
+          const u8* ptr;
+          size_t len;
+          if (!string_at(value, ptr, len))
+            return None;
+          return Value{reinterpret_cast<const unit_t*>(ptr), len};
+        }
+        else
+          return details::index_decode_scalar<ENDIAN, Value>(value);
+      }
+      return None;
+    }
+
+    /// @brief Check if the index contains a key
+    /// @param key The key to search for
+    /// @return True if the key is part of the index
+    [[nodiscard]] bool contains(const Key& key) const noexcept
+    {
+      return find(key).is_value();
+    }
+
+    /// @brief Check the checksum of the index (which reads all its bytes).
+    /// 'open' only validates the header: this detects corrupted indices.
+    /// @return True if the checksum matches
+    [[nodiscard]] bool verify() const noexcept
+    {
+      HASH_ALGO algo;
+      algo(slots, static_cast<size_t>(blob + blob_size - slots));
+      return details::index_hash_result(algo) == checksum;
+    }
+
+    /// @brief Opens an index, validating its header
+    /// @param bytes The bytes of the index (which must outlive the index)
+    /// @param version The expected version of the schema
+    /// @return None if the header is invalid, if the version does not match
+    ///         or if the index was built using another hashing algorithm
+    [[nodiscard]] static Option<BasicHashIndex> open(
+        View<u8> bytes, u32 version = 0) noexcept
+    {
+      if (bytes.size() < HASH_INDEX_HEADER_SIZE)
+        return None;
+      details::HashIndexHeader stored;
+      std::memcpy(&stored, bytes.data(), sizeof(stored));
+      const auto header = stored.template convert<ENDIAN, false>();
+      if (header.magic != HASH_INDEX_MAGIC
+          || header.format != HASH_INDEX_FORMAT_VERSION
+          || header.endian != u8(ENDIAN == std::endian::big)
+          || header.kinds != details::index_kinds<Key, Value>()
+          || header.version != version
+          || header.key_size != (details::index_string<Key> ? 0 : sizeof(Key))
+          || header.value_size
+                 != (details::index_string<Value> ? 0 : sizeof(Value))
+          || header.fingerprint != details::index_fingerprint<HASH_ALGO>())
+        return None;
+      // The slots and the blob must be part of 'bytes'
+      const u64 max_slots =
+          (bytes.size() - HASH_INDEX_HEADER_SIZE) / HASH_INDEX_SLOT_SIZE;
+      if (!std::has_single_bit(header.slot_count) || header.slot_count > max_slots
+          || header.entry_count >= header.slot_count
+          || header.blob_offset
+                 != HASH_INDEX_HEADER_SIZE
+                        + header.slot_count * HASH_INDEX_SLOT_SIZE
+          || header.blob_size > bytes.size() - header.blob_offset)
+        return None;
+      return Option<BasicHashIndex>{InPlace, bytes, header};
+    }
+
+    /// @brief Opens an index from a mapped file, validating its header
+    /// @param file The mapped file (which must outlive the index)
+    /// @param version The expected version of the schema
+    /// @return None if the header is invalid, if the version does not match
+    ///         or if the index was built using another hashing algorithm
+    [[nodiscard]] static Option<BasicHashIndex> open(
+        const ViewOfFile& file, u32 version = 0) noexcept
+    {
+      auto bytes = file.view();
+      if (bytes.is_none())
+        return None;
+      return open(*bytes, version);
+    }
+  };
+
+  /// @brief Hash index writer (little endian)
+  template<details::index_key Key, details::index_value Value>
+  using HashIndexWriter = BasicHashIndexWriter<Key, Value>;
+  /// @brief Hash index (little endian)
+  template<details::index_key Key, details::index_value Value>
+  using HashIndex = BasicHashIndex<Key, Value>;
+} // namespace clt
+
+#endif // !HG_COLT_HASH_INDEX
@@ -0,0 +1,337 @@
+#include "job_runner.h"
+#include <colt/io/pipe.h>
+#include <colt/mem/arena_alloc.h>
+#include <colt/num/math.h>
+#include <cstring>
+#include <deque>
+#include <thread>
+#include <vector>
+
+namespace clt::details
+{
+  /// @brief The minimum free space of an output buffer before a read
+  static constexpr size_t MIN_OUTPUT_READ = 4096;
+
+  /// @brief The jobs and the arena
+  class JobRunnerImpl
+  {
+    using clock = std::chrono::steady_clock;
+
+    /// @brief A job
+    struct Job
+    {
+      /// @brief The command line (ending with a nullptr, copied in the arena)
+      std::vector<const char*> command_line;
+      /// @brief The jobs that depend on this one
+      std::vector<JobID> dependents = {};
+      /// @brief The count of dependencies that did not finish
+      u32 unfinished = 0;
+      /// @brief True if a dependency did not succeed
+      bool failed_dependency = false;
+      /// @brief The result
+      JobResult result = {};
+      /// @brief The time at which the job became ready
+      clock::time_point ready_at = {};
+      /// @brief The time at which the subprocess started
+      clock::time_point started_at = {};
+      /// @brief The output buffer (allocated from the arena)
+      mem::MemBlock output = {};
+      /// @brief The count of bytes of 'output' that were written
+      size_t output_size = 0;
+      /// @brief The subprocess while running
+      Option<Subprocess> process = None;
+      /// @brief The output pipe of the subprocess while running
+      Option<File> pipe = None;
+    };
+
+    /// @brief The maximum count of subprocesses running at the same time
+    const u32 max_parallel;
+    /// @brief The options used to open the subprocesses
+    const Subprocess::SubprocessOption options;
+    /// @brief The arena from which the arguments and outputs are allocated
+    mem::ArenaAllocator<mem::PageAllocator> arena;
+    /// @brief The jobs (in a deque, as Subprocess cannot be copied and its
+    ///        move constructor is not noexcept)
+    std::deque<Job> jobs;
+    /// @brief The jobs that are ready to run
+    std::deque<JobID> ready;
+    /// @brief The jobs that are running
+    std::vector<JobID> running;
+
+    /// @brief Copies a string in the arena
+    /// @param str The NUL-terminated string
+    /// @return The copy or nullptr on errors
+    const char* copy_string(const char* str) noexcept
+    {
+      const size_t size = std::strlen(str) + 1;
+      auto blk          = arena.alloc(size);
+      if (blk.is_null())
+        return nullptr;
+      std::memcpy(blk.ptr(), str, size);
+      return static_cast<const char*>(blk.ptr());
+    }
+
+    /// @brief Ensures that the output buffer of a job has free space
+    /// @param job The job
+    /// @return False on allocation failures
+    bool reserve_output(Job& job) noexcept
+    {
+      if (job.output.size() - job.output_size >= MIN_OUTPUT_READ)
+        return true;
+      const size_t new_size =
+          clt::max(job.output.size() * 2, job.output_size + MIN_OUTPUT_READ);
+      // The last allocation of the arena can grow in place
+      if (arena.expand(job.output, new_size))
+        return true;
+      auto blk = arena.alloc(new_size);
+      if (blk.is_null())
+        return false;
+      if (job.output_size != 0)
+        std::memcpy(blk.ptr(), job.output.ptr(), job.output_size);
+      job.output = blk;
+      return true;
+    }
+
+    /// @brief Marks a job as finished, and updates its dependents
+    /// @param id The job whose status was set
+    void finish(JobID id) noexcept
+    {
+      std::vector<JobID> finished = {id};
+      while (!finished.empty())
+      {
+        Job& job = jobs[finished.back()];
+        finished.pop_back();
+        job.result.output = {
+            static_cast<const u8*>(job.output.ptr()), job.output_size};
+        const bool failed = !job.result.is_success();
+        for (auto dependent : job.dependents)
+        {
+          Job& next = jobs[dependent];
+          next.failed_dependency |= failed;
+          if (--next.unfinished != 0)
+            continue;
+          if (next.failed_dependency)
+          {
+            next.result.status = JobStatus::Skipped;
+            finished.push_back(dependent);
+          }
+          else
+          {
+            next.ready_at = clock::now();
+            ready.push_back(dependent);
+          }
+        }
+      }
+    }
+
+    /// @brief Starts a job that is ready
+    /// @param id The job
+    void spawn(JobID id) noexcept
+    {
+      Job& job               = jobs[id];
+      const auto start       = clock::now();
+      job.result.timing.wait = start - job.ready_at;
+      job.process            = Subprocess::open(
+          View<const char*>{job.command_line.data(), job.command_line.size()},
+          options | Subprocess::COMBINE_STDOUT_STDERR);
+      job.started_at          = clock::now();
+      job.result.timing.spawn = job.started_at - start;
+      if (job.process.is_none())
+      {
+        job.result.status = JobStatus::SpawnFailed;
+        finish(id);
+        return;
+      }
+      job.pipe = job.process->get_stdout();
+      running.push_back(id);
+    }
+
+    /// @brief Joins a job whose output ended
+    /// @param id The job
+    void join(JobID id) noexcept
+    {
+      Job& job  = jobs[id];
+      auto code = job.process->join();
+      job.process.reset();
+      job.pipe.reset();
+      job.result.timing.run = clock::now() - job.started_at;
+      job.result.exit_code  = code.value_or(-1);
+      job.result.status =
+          code.is_value() && *code == 0 ? JobStatus::Succeeded : JobStatus::Failed;
+      finish(id);
+    }
+
+    /// @brief Reads the available output of a job
+    /// @param id The job
+    /// @return True if the output ended
+    bool read_output(JobID id) noexcept
+    {
+      Job& job = jobs[id];
+      if (!reserve_output(job))
+        return true;
+      auto read = job.pipe->read(Span<u8>{
+          static_cast<u8*>(job.output.ptr()) + job.output_size,
+          job.output.size() - job.output_size});
+      if (read.is_none() || *read == 0)
+        return true;
+      job.output_size += *read;
+      return false;
+    }
+
+  public:
+    /// @brief Constructor
+    /// @param max_parallel The maximum count of subprocesses running at
+    ///        the same time (0 for the count of hardware threads)
+    /// @param options The options used to open the subprocesses
+    JobRunnerImpl(u32 max_parallel, Subprocess::SubprocessOption options) noexcept
+        : max_parallel(
+              max_parallel != 0 ? max_parallel
+                                : clt::max(std::thread::hardware_concurrency(), 1U))
+        , options(options)
+    {
+    }
+
+    /// @brief Returns the maximum count of subprocesses running at the same time
+    /// @return The maximum count of subprocesses running at the same time
+    u32 parallelism() const noexcept { return max_parallel; }
+
+    /// @brief Returns the count of jobs
+    /// @return The count of jobs
+    size_t size() const noexcept { return jobs.size(); }
+
+    /// @brief Returns the result of a job
+    /// @param job The job
+    /// @return The result
+    const JobResult& result(JobID job) const noexcept
+    {
+      assert_true("Invalid job!", job < jobs.size());
+      return jobs[job].result;
+    }
+
+    /// @brief Adds a job
+    /// @param command_line The command line (ending with a nullptr)
+    /// @param dependencies The dependencies (added before)
+    /// @return The identifier of the job
+    JobID add(View<const char*> command_line, View<JobID> dependencies) noexcept
+    {
+      assert_true(
+          "command_line must be terminated with a NULL!",
+          !command_line.empty() && command_line.back() == nullptr);
+      const auto id = static_cast<JobID>(jobs.size());
+      Job& job      = jobs.emplace_back();
+      job.command_line.reserve(command_line.size());
+      for (auto arg : command_line)
+        job.command_line.push_back(arg == nullptr ? nullptr : copy_string(arg));
+      for (auto dependency : dependencies)
+      {
+        assert_true("Dependencies must be added before!", dependency < id);
+        Job& dep = jobs[dependency];
+        if (dep.result.status == JobStatus::Pending)
+        {
+          dep.dependents.push_back(id);
+          ++job.unfinished;
+        }
+        else
+          job.failed_dependency |= !dep.result.is_success();
+      }
+      return id;
+    }
+
+    /// @brief Runs all the pending jobs
+    /// @return True if all the jobs succeeded
+    bool run() noexcept
+    {
+      const auto now = clock::now();
+      for (JobID id = 0; id < jobs.size(); id++)
+      {
+        Job& job = jobs[id];
+        if (job.result.status != JobStatus::Pending || job.unfinished != 0)
+          continue;
+        // Only possible for a job added after its dependency failed
+        if (job.failed_dependency)
+        {
+          job.result.status = JobStatus::Skipped;
+          finish(id);
+          continue;
+        }
+        job.ready_at = now;
+        ready.push_back(id);
+      }
+
+      std::vector<PollEntry> entries;
+      while (!ready.empty() || !running.empty())
+      {
+        while (running.size() < max_parallel && !ready.empty())
+        {
+          const JobID id = ready.front();
+          ready.pop_front();
+          spawn(id);
+        }
+        if (running.empty())
+          continue;
+
+        entries.clear();
+        for (auto id : running)
+          entries.push_back(PollEntry{&*jobs[id].pipe});
+        // On errors, read anyway: reading at worst blocks
+        const bool polled =
+            poll_readable(Span<PollEntry>{entries}, std::chrono::milliseconds{-1})
+                .is_value();
+        for (size_t i = running.size(); i-- != 0;)
+        {
+          if (polled && !entries[i].readable)
+            continue;
+          const JobID id = running[i];
+          if (!read_output(id))
+            continue;
+          running.erase(running.begin() + i);
+          join(id);
+        }
+      }
+
+      bool success = true;
+      for (auto& job : jobs)
+        success &= job.result.is_success();
+      return success;
+    }
+  };
+} // namespace clt::details
+
+namespace clt
+{
+  JobRunner::JobRunner(u32 max_parallel, Subprocess::SubprocessOption opt) noexcept
+      : impl(new details::JobRunnerImpl(max_parallel, opt))
+  {
+  }
+
+  JobRunner::~JobRunner() noexcept
+  {
+    delete impl;
+  }
+
+  JobID JobRunner::add(
+      View<const char*> command_line, View<JobID> dependencies) noexcept
+  {
+    return impl->add(command_line, dependencies);
+  }
+
+  bool JobRunner::run() noexcept
+  {
+    return impl->run();
+  }
+
+  const JobResult& JobRunner::result(JobID job) const noexcept
+  {
+    return impl->result(job);
+  }
+
+  size_t JobRunner::size() const noexcept
+  {
+    return impl->size();
+  }
+
+  u32 JobRunner::max_parallel() const noexcept
+  {
+    return impl->parallelism();
+  }
+} // namespace clt
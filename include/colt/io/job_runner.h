@@ -0,0 +1,157 @@
+/*****************************************************************/ /**
+ * @file   job_runner.h
+ * @brief  Contains JobRunner, which runs a graph of commands as
+ * subprocesses, keeping a bounded count of them busy.
+ * The output of the subprocesses is streamed (using poll_readable)
+ * into buffers allocated from an arena, so that a single thread can
+ * drive all the subprocesses without ever blocking on one of them.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_JOB_RUNNER
+#define HG_COLT_JOB_RUNNER
+
+#include <chrono>
+#include <colt/typedefs.h>
+#include <colt/io/subprocess.h>
+
+namespace clt
+{
+  /// @brief Identifier of a job (returned by JobRunner::add)
+  using JobID = u32;
+
+  /// @brief The status of a job
+  enum class JobStatus : u8
+  {
+    /// @brief The job did not run yet
+    Pending,
+    /// @brief The job exited with a code of 0
+    Succeeded,
+    /// @brief The job exited with a non-zero code (or could not be joined)
+    Failed,
+    /// @brief The subprocess of the job could not be started
+    SpawnFailed,
+    /// @brief The job did not run as one of its dependencies did not succeed
+    Skipped,
+  };
+
+  /// @brief The time spent by a job in each of its phases
+  struct JobTiming
+  {
+    /// @brief From its dependencies being done to the start of its spawn
+    std::chrono::nanoseconds wait{0};
+    /// @brief Spent starting the subprocess
+    std::chrono::nanoseconds spawn{0};
+    /// @brief From the start of the subprocess to the end of its output
+    ///        and its exit
+    std::chrono::nanoseconds run{0};
+  };
+
+  /// @brief The result of a job
+  struct JobResult
+  {
+    /// @brief The status of the job
+    JobStatus status = JobStatus::Pending;
+    /// @brief The exit code (if the job ran)
+    int exit_code = 0;
+    /// @brief The output (stdout and stderr combined) of the job, which
+    ///        is valid as long as the runner is
+    View<u8> output = {};
+    /// @brief The time spent in each phase
+    JobTiming timing = {};
+
+    /// @brief Check if the job succeeded
+    /// @return True if the job exited with a code of 0
+    [[nodiscard]] bool is_success() const noexcept
+    {
+      return status == JobStatus::Succeeded;
+    }
+  };
+
+  namespace details
+  {
+    /// @brief The jobs and the arena (implemented in job_runner.cpp)
+    class JobRunnerImpl;
+  } // namespace details
+
+  /// @brief Runs commands as subprocesses, respecting their dependencies.
+  /// At most 'max_parallel()' subprocesses run at the same time. Jobs are
+  /// started in the order in which they become ready, and a job whose
+  /// dependency did not succeed is skipped.
+  /// @code{.cpp}
+  /// JobRunner runner;
+  /// const char* compile[] = {"cc", "-c", "a.c", nullptr};
+  /// const char* link[]    = {"cc", "a.o", "-o", "a", nullptr};
+  /// JobID a = runner.add(compile);
+  /// JobID b = runner.add(link, View<JobID>{&a, 1});
+  /// if (!runner.run())
+  ///   ...
+  /// @endcode
+  class JobRunner
+  {
+    /// @brief The jobs and the arena
+    details::JobRunnerImpl* impl;
+
+  public:
+    /// @brief Constructor
+    /// @param max_parallel The maximum count of subprocesses running at
+    ///        the same time (0 for the count of hardware threads)
+    /// @param opt The options used to open the subprocesses
+    ///        (COMBINE_STDOUT_STDERR is always added)
+    COLTCPP_EXPORT JobRunner(
+        u32 max_parallel = 0,
+        Subprocess::SubprocessOption opt =
+            Subprocess::INHERIT_ENV | Subprocess::SEARCH_USER_PATH) noexcept;
+
+    JobRunner(const JobRunner&)            = delete;
+    JobRunner& operator=(const JobRunner&) = delete;
+
+    /// @brief Move constructor
+    /// @param to_move The runner to move
+    JobRunner(JobRunner&& to_move) noexcept
+        : impl(std::exchange(to_move.impl, nullptr))
+    {
+    }
+    /// @brief Move assignment operator
+    /// @param to_move The runner to move
+    /// @return Self
+    JobRunner& operator=(JobRunner&& to_move) noexcept
+    {
+      std::swap(impl, to_move.impl);
+      return *this;
+    }
+
+    /// @brief Destructor, frees the outputs of the jobs
+    COLTCPP_EXPORT ~JobRunner() noexcept;
+
+    /// @brief Adds a job.
+    /// The arguments are copied: they do not need to outlive the call.
+    /// @param command_line The command (starting with the executable,
+    ///        and ending with a nullptr)
+    /// @param dependencies The jobs that must succeed before this one
+    ///        (which must have been added before)
+    /// @return The identifier of the job
+    [[nodiscard]] COLTCPP_EXPORT JobID add(
+        View<const char*> command_line, View<JobID> dependencies = {}) noexcept;
+
+    /// @brief Runs all the pending jobs, and waits for all of them to finish
+    /// @return True if all the jobs succeeded
+    COLTCPP_EXPORT bool run() noexcept;
+
+    /// @brief Returns the result of a job
+    /// @param job The identifier of the job
+    /// @return The result of the job
+    [[nodiscard]] COLTCPP_EXPORT const JobResult& result(JobID job) const noexcept;
+
+    /// @brief Returns the count of jobs
+    /// @return The count of jobs added
+    [[nodiscard]] COLTCPP_EXPORT size_t size() const noexcept;
+
+    /// @brief Returns the maximum count of subprocesses running at the same time
+    /// @return The maximum count of subprocesses running at the same time
+    [[nodiscard]] COLTCPP_EXPORT u32 max_parallel() const noexcept;
+  };
+} // namespace clt
+
+#endif // !HG_COLT_JOB_RUNNER
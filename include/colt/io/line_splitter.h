@@ -0,0 +1,244 @@
+/*****************************************************************/ /**
+ * @file   line_splitter.h
+ * @brief  Contains LineSplitter and ChunkSplitter, which split a view
+ * (usually of a ViewOfFile) in lines or in delimiter-aligned chunks.
+ * The returned views point directly into the split view: nothing is
+ * copied. Delimiters are found using the SIMD dispatched 'find8'.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_LINE_SPLITTER
+#define HG_COLT_LINE_SPLITTER
+
+#include <colt/dsa/string_view.h>
+
+namespace clt
+{
+  namespace details
+  {
+    template<StringEncoding ENCODING>
+    /// @brief Searches for 'delim' in [begin, end)
+    /// @param begin The start of the range
+    /// @param end The end of the range
+    /// @param delim The delimiter
+    /// @return Pointer to the delimiter or 'end'
+    inline const meta::encoding_to_char_t<ENCODING>* find_delim(
+        const meta::encoding_to_char_t<ENCODING>* begin,
+        const meta::encoding_to_char_t<ENCODING>* end, u8 delim) noexcept
+    {
+      using ptr_t = meta::encoding_to_char_t<ENCODING>;
+      return ptr_to<const ptr_t*>(uni::details::find8(
+          ptr_to<const char8_t*>(begin), ptr_to<const char8_t*>(end),
+          static_cast<char8_t>(delim)));
+    }
+  } // namespace details
+
+  template<StringEncoding ENCODING = StringEncoding::ASCII>
+    requires(sizeof(meta::encoding_to_char_t<ENCODING>) == 1)
+  /// @brief Range over the lines of a view.
+  /// The lines do not contain their terminator ('\n' or "\r\n").
+  /// A last line without a terminator is returned if it is not empty.
+  /// @code{.cpp}
+  /// auto file = ViewOfFile::open("input.txt");
+  /// for (StringView line : LineSplitter{*file->view()})
+  ///   process(line);
+  /// @endcode
+  /// @tparam ENCODING The encoding of the view (ASCII or UTF8)
+  class LineSplitter
+  {
+    using ptr_t  = meta::encoding_to_char_t<ENCODING>;
+    using view_t = BasicStringView<ENCODING>;
+
+    /// @brief The view to split
+    view_t view;
+
+  public:
+    /// @brief Iterator over the lines
+    class Iterator
+    {
+      /// @brief The start of the current line
+      const ptr_t* _begin;
+      /// @brief The terminator of the current line (or the end of the view)
+      const ptr_t* _newline;
+      /// @brief The end of the view
+      const ptr_t* _end;
+
+    public:
+      using value_type        = view_t;
+      using difference_type   = std::ptrdiff_t;
+      using iterator_category = std::forward_iterator_tag;
+
+      /// @brief Constructs an iterator to the line starting at 'begin'
+      /// @param begin The start of a line
+      /// @param end The end of the view
+      Iterator(const ptr_t* begin, const ptr_t* end) noexcept
+          : _begin(begin)
+          , _newline(details::find_delim<ENCODING>(begin, end, '\n'))
+          , _end(end)
+      {
+      }
+
+      /// @brief Default constructor
+      Iterator() noexcept
+          : _begin(nullptr)
+          , _newline(nullptr)
+          , _end(nullptr)
+      {
+      }
+
+      MAKE_DEFAULT_COPY_AND_MOVE_FOR(Iterator);
+
+      /// @brief Returns the current line (without its terminator)
+      /// @return View over the current line
+      view_t operator*() const noexcept
+      {
+        const ptr_t* last = _newline;
+        if (last != _begin && last != _end && last[-1] == '\r')
+          --last;
+        return view_t{_begin, last};
+      }
+
+      /// @brief Advances to the next line
+      /// @return Self
+      Iterator& operator++() noexcept
+      {
+        assert_true("Cannot advance past the end!", _begin != _end);
+        _begin   = _newline == _end ? _end : _newline + 1;
+        _newline = details::find_delim<ENCODING>(_begin, _end, '\n');
+        return *this;
+      }
+
+      /// @brief Advances to the next line
+      /// @return Copy of the iterator before advancing
+      Iterator operator++(int) noexcept
+      {
+        auto copy = *this;
+        ++(*this);
+        return copy;
+      }
+
+      /// @brief Check if two iterators point to the same line
+      /// @return True if both iterators point to the same line
+      friend bool operator==(const Iterator& a, const Iterator& b) noexcept
+      {
+        return a._begin == b._begin;
+      }
+    };
+
+    /// @brief Constructor
+    /// @param view The view to split
+    constexpr LineSplitter(view_t view) noexcept
+        : view(view)
+    {
+    }
+
+    /// @brief Constructor from bytes (as returned by ViewOfFile::view).
+    /// The bytes are not validated.
+    /// @param bytes The bytes to split
+    LineSplitter(View<u8> bytes) noexcept
+        : view(ptr_to<const ptr_t*>(bytes.data()), bytes.size())
+    {
+    }
+
+    /// @brief Returns an iterator to the first line
+    /// @return Iterator to the first line
+    Iterator begin() const noexcept
+    {
+      return {view.data(), view.data() + view.unit_len()};
+    }
+    /// @brief Returns an iterator past the last line
+    /// @return Iterator past the last line
+    Iterator end() const noexcept
+    {
+      const auto end = view.data() + view.unit_len();
+      return {end, end};
+    }
+  };
+
+  template<StringEncoding ENCODING = StringEncoding::ASCII>
+    requires(sizeof(meta::encoding_to_char_t<ENCODING>) == 1)
+  /// @brief Splits a view in (at most) N chunks that end on a delimiter,
+  /// to process a file in parallel without splitting any line.
+  /// Chunk 'i' starts at the first line start at or after 'i * size / N'
+  /// (so chunks can be empty if lines are longer than 'size / N').
+  /// Chunks can be obtained in any order, and each costs two searches.
+  /// @code{.cpp}
+  /// auto chunks = ChunkSplitter{*file->view(), thread_count};
+  /// for (size_t i = 0; i < chunks.size(); i++)
+  ///   threads.emplace_back([=]() { process(LineSplitter{chunks[i]}); });
+  /// @endcode
+  /// @tparam ENCODING The encoding of the view (ASCII or UTF8)
+  class ChunkSplitter
+  {
+    using ptr_t  = meta::encoding_to_char_t<ENCODING>;
+    using view_t = BasicStringView<ENCODING>;
+
+    /// @brief The view to split
+    view_t view;
+    /// @brief The count of chunks
+    size_t count;
+    /// @brief The delimiter ending the chunks
+    u8 delim;
+
+    /// @brief Returns the start of chunk 'index'
+    /// @param index The index of the chunk (<= count)
+    /// @return The start of the chunk (or the end of the view)
+    const ptr_t* boundary(size_t index) const noexcept
+    {
+      const ptr_t* begin = view.data();
+      const ptr_t* end   = begin + view.unit_len();
+      if (index == 0)
+        return begin;
+      if (index == count)
+        return end;
+      // The first line start at or after 'target'
+      const size_t size   = view.unit_len();
+      const size_t target = (size / count) * index + (size % count) * index / count;
+      if (target == 0)
+        return begin;
+      const ptr_t* found =
+          details::find_delim<ENCODING>(begin + target - 1, end, delim);
+      return found == end ? end : found + 1;
+    }
+
+  public:
+    /// @brief Constructor
+    /// @param view The view to split
+    /// @param count The count of chunks (at least 1)
+    /// @param delim The delimiter ending the chunks
+    ChunkSplitter(view_t view, size_t count, u8 delim = '\n') noexcept
+        : view(view)
+        , count(clt::max(count, size_t{1}))
+        , delim(delim)
+    {
+    }
+
+    /// @brief Constructor from bytes (as returned by ViewOfFile::view).
+    /// The bytes are not validated.
+    /// @param bytes The bytes to split
+    /// @param count The count of chunks (at least 1)
+    /// @param delim The delimiter ending the chunks
+    ChunkSplitter(View<u8> bytes, size_t count, u8 delim = '\n') noexcept
+        : ChunkSplitter(
+              view_t{ptr_to<const ptr_t*>(bytes.data()), bytes.size()}, count, delim)
+    {
+    }
+
+    /// @brief Returns the count of chunks
+    /// @return The count of chunks
+    size_t size() const noexcept { return count; }
+
+    /// @brief Returns a chunk (which ends with the delimiter unless it is
+    ///        the last chunk of a view that does not end with it)
+    /// @param index The index of the chunk
+    /// @return The chunk
+    view_t operator[](size_t index) const noexcept
+    {
+      assert_true("Invalid index!", index < count);
+      return view_t{boundary(index), boundary(index + 1)};
+    }
+  };
+} // namespace clt
+
+#endif // !HG_COLT_LINE_SPLITTER
@@ -1,4 +1,6 @@
 #include "mmap.h"
+#include <colt/num/math.h>
+#include <colt/trace.h>
 
 #ifdef COLT_WINDOWS
   #define NOMINMAX
@@ -9,8 +11,17 @@
   #include <sys/stat.h>
   #include <fcntl.h>
   #include <unistd.h>
+  #include <cstdio>
 #endif // COLT_WINDOWS
 
+#ifdef COLT_LINUX
+  #include <sys/syscall.h>
+  #ifndef MFD_CLOEXEC
+    // From <linux/memfd.h>
+    #define MFD_CLOEXEC 1U
+  #endif // !MFD_CLOEXEC
+#endif // COLT_LINUX
+
 #ifdef COLT_WINDOWS
 
 namespace clt
@@ -37,11 +48,56 @@ namespace clt
   VirtualPage VirtualPage::allocate(
       bytes byte, PageAccess access, void* hint) noexcept
   {
-    auto ret = VirtualAlloc(
-        hint, byte.size, MEM_COMMIT | MEM_RESERVE, convert_access(access));
+    return allocate(byte, access, PageOption::NoOption, AnyNumaNode, hint);
+  }
+
+  VirtualPage VirtualPage::allocate(
+      bytes byte, PageAccess access, PageOption options, u32 numa_node,
+      void* hint) noexcept
+  {
+    size_t size = byte.size;
+    DWORD type  = MEM_COMMIT | MEM_RESERVE;
+    // Windows does not provide transparent huge pages: both options
+    // require MEM_LARGE_PAGES (which requires 'SeLockMemoryPrivilege').
+    if (is_enabled(options, PageOption::TransparentHugePages)
+        || is_enabled(options, PageOption::ExplicitHugePages))
+    {
+      const size_t large = large_page_size().size;
+      if (large != 0)
+      {
+        size = (size + large - 1) / large * large;
+        type |= MEM_LARGE_PAGES;
+      }
+      else if (is_enabled(options, PageOption::ExplicitHugePages))
+        return VirtualPage(nullptr, 0);
+    }
+    auto try_alloc = [&](DWORD type) -> void*
+    {
+      if (numa_node == AnyNumaNode)
+        return VirtualAlloc(hint, size, type, convert_access(access));
+      return VirtualAllocExNuma(
+          GetCurrentProcess(), hint, size, type, convert_access(access),
+          static_cast<DWORD>(numa_node));
+    };
+    auto ret = try_alloc(type);
+    // Transparent huge pages are a hint: fallback to normal pages
+    if (ret == nullptr && (type & MEM_LARGE_PAGES)
+        && !is_enabled(options, PageOption::ExplicitHugePages))
+    {
+      size = byte.size;
+      ret  = try_alloc(MEM_COMMIT | MEM_RESERVE);
+    }
     if (HEDLEY_UNLIKELY(ret == nullptr))
       return VirtualPage(nullptr, 0);
-    return VirtualPage(ret, byte.size);
+    // Large pages are always resident: only normal pages are touched.
+    if (is_enabled(options, PageOption::Populate) && access == ReadWrite
+        && size == byte.size)
+    {
+      const size_t page = page_size().size;
+      for (size_t i = 0; i < size; i += page)
+        static_cast<volatile u8*>(ret)[i] = 0;
+    }
+    return VirtualPage(ret, size);
   }
 
   void VirtualPage::deallocate(const VirtualPage& page) noexcept
@@ -50,6 +106,12 @@ namespace clt
       VirtualFree(page.begin_, 0, MEM_RELEASE);
   }
 
+  bool VirtualPage::protect(void* begin, bytes size, PageAccess access) noexcept
+  {
+    DWORD old;
+    return VirtualProtect(begin, size.size, convert_access(access), &old) != 0;
+  }
+
   bytes VirtualPage::page_size() noexcept
   {
     // cache the result of GetSystemInfo
@@ -62,6 +124,13 @@ namespace clt
     return bytes{PAGE_SIZE};
   }
 
+  bytes VirtualPage::large_page_size() noexcept
+  {
+    // cache the result of GetLargePageMinimum
+    static size_t LARGE_PAGE_SIZE = GetLargePageMinimum();
+    return bytes{LARGE_PAGE_SIZE};
+  }
+
   void VirtualPage::flush_icache(const void* start, size_t offset) noexcept
   {
     assert_true(
@@ -71,10 +140,265 @@ namespace clt
     // use __builtin___clear_cache() for linux
   }
 
+  DualMapping VirtualPage::allocate_dual(bytes byte) noexcept
+  {
+    const size_t page = page_size().size;
+    const size_t size = (byte.size + page - 1) / page * page;
+    HANDLE mapping    = CreateFileMappingW(
+        INVALID_HANDLE_VALUE, nullptr, PAGE_EXECUTE_READWRITE,
+        static_cast<DWORD>(static_cast<u64>(size) >> 32),
+        static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+    if (mapping == nullptr)
+      return {};
+    void* write = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+    void* exec  = write == nullptr ? nullptr
+                                   : MapViewOfFile(
+                                        mapping, FILE_MAP_READ | FILE_MAP_EXECUTE,
+                                        0, 0, size);
+    // The views keep the mapping alive
+    CloseHandle(mapping);
+    if (exec == nullptr)
+    {
+      if (write != nullptr)
+        UnmapViewOfFile(write);
+      return {};
+    }
+    return {VirtualPage(write, size), VirtualPage(exec, size)};
+  }
+
+  void VirtualPage::deallocate_dual(const DualMapping& mapping) noexcept
+  {
+    if (mapping.is_null())
+      return;
+    UnmapViewOfFile(mapping.writable.begin_);
+    UnmapViewOfFile(mapping.executable.begin_);
+  }
+
 } // namespace clt
 
 #else // !COLT_WINDOWS
 
+namespace clt
+{
+  static int convert_access(VirtualPage::PageAccess access) noexcept
+  {
+    using enum VirtualPage::PageAccess;
+    switch_no_default(access)
+    {
+    case None:
+      return PROT_NONE;
+    case ReadExecute:
+      return PROT_READ | PROT_EXEC;
+    case WriteExecute:
+      return PROT_READ | PROT_WRITE | PROT_EXEC;
+    case ReadWrite:
+      return PROT_READ | PROT_WRITE;
+    case ReadOnly:
+      return PROT_READ;
+    }
+  }
+
+  VirtualPage VirtualPage::allocate(
+      bytes byte, PageAccess access, void* hint) noexcept
+  {
+    return allocate(byte, access, PageOption::NoOption, AnyNumaNode, hint);
+  }
+
+  /// @brief Binds the pages of [addr, addr + size) to a NUMA node.
+  /// This uses the 'mbind' system call directly to not depend on libnuma.
+  /// @param addr The beginning of the pages
+  /// @param size The size of the pages
+  /// @param numa_node The NUMA node
+  /// @return True on success (always true if NUMA is not supported)
+  static bool bind_to_numa_node(
+      [[maybe_unused]] void* addr, [[maybe_unused]] size_t size,
+      [[maybe_unused]] u32 numa_node) noexcept
+  {
+  #if defined(COLT_LINUX) && defined(SYS_mbind)
+    // MPOL_BIND from <linux/mempolicy.h>
+    constexpr int MPOL_BIND = 2;
+    constexpr u32 BITS      = sizeof(unsigned long) * 8;
+    constexpr u32 MAX_NODES = 1024;
+    if (numa_node >= MAX_NODES)
+      return false;
+    unsigned long mask[MAX_NODES / BITS] = {};
+    mask[numa_node / BITS]               = 1UL << (numa_node % BITS);
+    return syscall(SYS_mbind, addr, size, MPOL_BIND, mask, MAX_NODES + 1, 0) == 0;
+  #else
+    // NUMA binding is not supported: the node is ignored
+    return true;
+  #endif // COLT_LINUX && SYS_mbind
+  }
+
+  VirtualPage VirtualPage::allocate(
+      bytes byte, PageAccess access, PageOption options, u32 numa_node,
+      void* hint) noexcept
+  {
+    const size_t large = large_page_size().size;
+    const bool thp     = is_enabled(options, PageOption::TransparentHugePages);
+    const bool huge    = is_enabled(options, PageOption::ExplicitHugePages);
+    const bool numa    = numa_node != AnyNumaNode;
+    if (huge && large == 0)
+      return VirtualPage(nullptr, 0);
+
+    size_t size = byte.size;
+    if ((huge || thp) && large != 0)
+      size = (size + large - 1) / large * large;
+
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+  #ifdef MAP_HUGETLB
+    if (huge)
+      flags |= MAP_HUGETLB;
+  #endif // MAP_HUGETLB
+  #ifdef MAP_POPULATE
+    // Pre-faulting must happen after binding to the NUMA node
+    if (is_enabled(options, PageOption::Populate) && !numa)
+      flags |= MAP_POPULATE;
+  #endif // MAP_POPULATE
+
+    // Transparent huge pages are only used for aligned regions:
+    // over-allocate to be able to align the beginning of the mapping.
+    const size_t over = thp && !huge && large != 0 ? large : 0;
+    auto ret = mmap(hint, size + over, convert_access(access), flags, -1, 0);
+    if (HEDLEY_UNLIKELY(ret == MAP_FAILED))
+      return VirtualPage(nullptr, 0);
+    if (over != 0)
+    {
+      auto begin   = static_cast<u8*>(ret);
+      auto aligned = reinterpret_cast<u8*>(
+          (reinterpret_cast<uintptr_t>(begin) + large - 1) / large * large);
+      if (aligned != begin)
+        munmap(begin, static_cast<size_t>(aligned - begin));
+      if (const size_t tail = over - static_cast<size_t>(aligned - begin); tail != 0)
+        munmap(aligned + size, tail);
+      ret = aligned;
+  #ifdef MADV_HUGEPAGE
+      madvise(ret, size, MADV_HUGEPAGE);
+  #endif // MADV_HUGEPAGE
+    }
+    if (numa && !bind_to_numa_node(ret, size, numa_node))
+    {
+      munmap(ret, size);
+      return VirtualPage(nullptr, 0);
+    }
+    if (numa && is_enabled(options, PageOption::Populate))
+    {
+  #ifdef MADV_POPULATE_WRITE
+      if (access == ReadWrite || access == WriteExecute)
+        madvise(ret, size, MADV_POPULATE_WRITE);
+  #else
+      if (access == ReadWrite || access == WriteExecute)
+      {
+        const size_t page = page_size().size;
+        for (size_t i = 0; i < size; i += page)
+          static_cast<volatile u8*>(ret)[i] = 0;
+      }
+  #endif // MADV_POPULATE_WRITE
+    }
+    return VirtualPage(ret, size);
+  }
+
+  void VirtualPage::deallocate(const VirtualPage& page) noexcept
+  {
+    if (page.begin_ != nullptr)
+      munmap(page.begin_, page.size_);
+  }
+
+  bool VirtualPage::protect(void* begin, bytes size, PageAccess access) noexcept
+  {
+    return mprotect(begin, size.size, convert_access(access)) == 0;
+  }
+
+  bytes VirtualPage::page_size() noexcept
+  {
+    // cache the result of sysconf
+    static size_t PAGE_SIZE = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return bytes{PAGE_SIZE};
+  }
+
+  bytes VirtualPage::large_page_size() noexcept
+  {
+    // cache the result of parsing /proc/meminfo
+    static size_t LARGE_PAGE_SIZE = []() -> size_t
+    {
+  #ifdef COLT_LINUX
+      FILE* file = std::fopen("/proc/meminfo", "r");
+      if (file == nullptr)
+        return 0;
+      char line[128];
+      size_t result = 0;
+      while (std::fgets(line, sizeof line, file) != nullptr)
+      {
+        unsigned long kb;
+        if (std::sscanf(line, "Hugepagesize: %lu kB", &kb) == 1)
+        {
+          result = static_cast<size_t>(kb) * 1024;
+          break;
+        }
+      }
+      std::fclose(file);
+      return result;
+  #else
+      return 0;
+  #endif // COLT_LINUX
+    }();
+    return bytes{LARGE_PAGE_SIZE};
+  }
+
+  void VirtualPage::flush_icache(const void* start, size_t offset) noexcept
+  {
+    assert_true(
+        "If start is not null, offset must not be 0!",
+        implies(start != nullptr, offset != 0));
+    if (start != nullptr)
+    {
+      auto begin = static_cast<char*>(const_cast<void*>(start));
+      __builtin___clear_cache(begin, begin + offset);
+    }
+  }
+
+  DualMapping VirtualPage::allocate_dual([[maybe_unused]] bytes byte) noexcept
+  {
+  #if defined(COLT_LINUX) && defined(SYS_memfd_create)
+    const size_t page = page_size().size;
+    const size_t size = (byte.size + page - 1) / page * page;
+    // Called through 'syscall' to not depend on the version of the libc
+    const int fd =
+        static_cast<int>(syscall(SYS_memfd_create, "colt-code", MFD_CLOEXEC));
+    if (fd == -1)
+      return {};
+    void* write = MAP_FAILED;
+    void* exec  = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+    {
+      write = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (write != MAP_FAILED)
+        exec = mmap(nullptr, size, PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0);
+    }
+    // The mappings keep the memory object alive
+    ::close(fd);
+    if (exec == MAP_FAILED)
+    {
+      if (write != MAP_FAILED)
+        munmap(write, size);
+      return {};
+    }
+    return {VirtualPage(write, size), VirtualPage(exec, size)};
+  #else
+    // Apple requires 'mach_vm_remap' (and MAP_JIT on Apple Silicon)
+    return {};
+  #endif // COLT_LINUX && SYS_memfd_create
+  }
+
+  void VirtualPage::deallocate_dual(const DualMapping& mapping) noexcept
+  {
+    if (mapping.is_null())
+      return;
+    deallocate(mapping.writable);
+    deallocate(mapping.executable);
+  }
+} // namespace clt
+
 #endif // COLT_WINDOWS
 
 namespace clt
@@ -82,16 +406,15 @@ namespace clt
 #ifdef COLT_WINDOWS
   bool ViewOfFile::is_closed() const noexcept
   {
-    return file_handle == nullptr && mapping_handle == nullptr
-           && view_map == nullptr;
+    return file_handle == nullptr;
   }
 
   void ViewOfFile::close()
   {
-    if (view_map != nullptr)
+    if (map_ptr != nullptr)
     {
-      UnmapViewOfFile(view_map);
-      view_map = nullptr;
+      UnmapViewOfFile(map_ptr);
+      map_ptr = nullptr;
     }
     if (mapping_handle != nullptr)
     {
@@ -100,83 +423,297 @@ namespace clt
     }
     CloseHandle((HANDLE)file_handle);
     file_handle = nullptr;
+    map_size    = 0;
+    delta       = 0;
   }
 
-  Option<View<u8>> ViewOfFile::view() const noexcept
+  ErrorFlag ViewOfFile::remap(size_t size) noexcept
   {
-    if (file_handle == nullptr)
-      return View<u8>{(const u8*)nullptr, (size_t)0};
-    LARGE_INTEGER value;
-    if (GetFileSizeEx(file_handle, &value) == 0)
-      return None;
-    return View<u8>{(const u8*)view_map, (size_t)value.QuadPart};
+    if (map_ptr != nullptr)
+      UnmapViewOfFile(map_ptr);
+    if (mapping_handle != nullptr)
+      CloseHandle((HANDLE)mapping_handle);
+    map_ptr        = nullptr;
+    mapping_handle = nullptr;
+    map_size       = 0;
+    delta          = 0;
+    if (size == 0)
+      return ErrorFlag::success();
+
+    static const u64 GRANULARITY = []()
+    {
+      SYSTEM_INFO info;
+      GetSystemInfo(&info);
+      return (u64)info.dwAllocationGranularity;
+    }();
+    const u64 aligned = view_offset & ~(GRANULARITY - 1);
+    const u64 end     = view_offset + size;
+
+    DWORD protect = PAGE_READONLY;
+    DWORD desired = FILE_MAP_READ;
+    if (access == ReadWrite)
+    {
+      protect = PAGE_READWRITE;
+      desired = FILE_MAP_WRITE;
+    }
+    else if (access == CopyOnWrite)
+    {
+      protect = PAGE_WRITECOPY;
+      desired = FILE_MAP_COPY;
+    }
+    // For ReadWrite mappings, this extends the file if needed
+    auto map = CreateFileMapping(
+        (HANDLE)file_handle, nullptr, protect, (DWORD)(end >> 32),
+        (DWORD)(end & 0xFFFFFFFF), nullptr);
+    if (map == nullptr)
+      return ErrorFlag::error();
+    auto view = MapViewOfFile(
+        map, desired, (DWORD)(aligned >> 32), (DWORD)(aligned & 0xFFFFFFFF),
+        (SIZE_T)(end - aligned));
+    if (view == nullptr)
+    {
+      CloseHandle(map);
+      return ErrorFlag::error();
+    }
+    mapping_handle = (void*)map;
+    map_ptr        = view;
+    map_size       = (size_t)(end - aligned);
+    delta          = (size_t)(view_offset - aligned);
+    return ErrorFlag::success();
+  }
+
+  ErrorFlag ViewOfFile::advise(AccessHint hint, size_t offset, size_t size) noexcept
+  {
+    if (map_ptr == nullptr || offset >= this->size())
+      return ErrorFlag::success();
+    u8* begin = static_cast<u8*>(map_ptr) + delta + offset;
+    size      = clt::min(size, this->size() - offset);
+    switch_no_default(hint)
+    {
+    case Normal:
+    case Sequential:
+    case Random:
+      // No equivalent once the file is opened
+      return ErrorFlag::success();
+    case WillNeed:
+    {
+      WIN32_MEMORY_RANGE_ENTRY entry = {begin, size};
+      if (PrefetchVirtualMemory(GetCurrentProcess(), 1, &entry, 0) == 0)
+        return ErrorFlag::error();
+      return ErrorFlag::success();
+    }
+    case DontNeed:
+      // Unlocking pages that are not locked removes them from the working set
+      VirtualUnlock(begin, size);
+      return ErrorFlag::success();
+    }
+  }
+
+  ErrorFlag ViewOfFile::flush() noexcept
+  {
+    if (map_ptr == nullptr || access != ReadWrite)
+      return ErrorFlag::success();
+    if (FlushViewOfFile(map_ptr, map_size) == 0
+        || FlushFileBuffers((HANDLE)file_handle) == 0)
+      return ErrorFlag::error();
+    return ErrorFlag::success();
+  }
+
+  ErrorFlag ViewOfFile::grow(size_t new_size) noexcept
+  {
+    assert_true("Only ReadWrite views can grow!", access == ReadWrite);
+    assert_true("The new size must be greater!", new_size >= size());
+    return remap(new_size);
+  }
+
+  Option<ViewOfFile> ViewOfFile::open(const char* ptr, MapAccess access)
+  {
+    return open(ptr, 0, TO_END, access);
   }
 
-  Option<ViewOfFile> ViewOfFile::open(const char* ptr)
+  Option<ViewOfFile> ViewOfFile::open(
+      const char* ptr, u64 offset, size_t size, MapAccess access)
   {
+    COLT_TRACE_SCOPE("ViewOfFile::open");
     auto handle = CreateFile(
-        ptr, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        ptr, access == ReadWrite ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
         FILE_ATTRIBUTE_NORMAL, nullptr);
     if (handle == INVALID_HANDLE_VALUE)
       return None;
     LARGE_INTEGER file_size;
-    if (GetFileSizeEx(handle, &file_size) && file_size.QuadPart == 0)
-      return ViewOfFile((void*)handle, nullptr, nullptr);
-
-    auto map = CreateFileMapping(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
-    if (map == nullptr)
+    if (GetFileSizeEx(handle, &file_size) == 0
+        || offset > (u64)file_size.QuadPart)
     {
       CloseHandle(handle);
       return None;
     }
+    auto ret = ViewOfFile((void*)handle, access, offset);
+    if (ret.remap(clt::min(size, (size_t)((u64)file_size.QuadPart - offset)))
+            .is_error())
+      return None;
+    return Option<ViewOfFile>(std::move(ret));
+  }
 
-    auto view = MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
-    if (view == nullptr)
-    {
-      CloseHandle(map);
-      CloseHandle(handle);
+  Option<ViewOfFile> ViewOfFile::create(const char* ptr, size_t size)
+  {
+    COLT_TRACE_SCOPE("ViewOfFile::create");
+    auto handle = CreateFile(
+        ptr, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
       return None;
-    }
-    return ViewOfFile((void*)handle, (void*)map, view);
+    auto ret = ViewOfFile((void*)handle, ReadWrite, 0);
+    if (ret.remap(size).is_error())
+      return None;
+    return Option<ViewOfFile>(std::move(ret));
   }
 #else
   bool ViewOfFile::is_closed() const noexcept
   {
-    return mmap_handle == nullptr;
+    return map_ptr == nullptr && fd == -1;
   }
 
   void ViewOfFile::close()
   {
-    munmap(mmap_handle, (off_t)file_size);
-    mmap_handle = nullptr;
+    if (map_ptr != nullptr)
+      munmap(map_ptr, map_size);
+    if (fd != -1)
+      ::close(fd);
+    map_ptr  = nullptr;
+    fd       = -1;
+    map_size = 0;
+    delta    = 0;
   }
 
-  Option<View<u8>> ViewOfFile::view() const noexcept
+  ErrorFlag ViewOfFile::remap(size_t size) noexcept
   {
-    return View<u8>{(const u8*)mmap_handle, file_size * (size_t)(mmap_handle != 0)};
+    const u64 page    = VirtualPage::page_size().size;
+    const u64 aligned = view_offset & ~(page - 1);
+    const size_t new_size = size == 0 ? 0 : (size_t)(view_offset - aligned) + size;
+  #ifdef COLT_LINUX
+    if (map_ptr != nullptr && new_size != 0)
+    {
+      void* addr = mremap(map_ptr, map_size, new_size, MREMAP_MAYMOVE);
+      if (addr == MAP_FAILED)
+        return ErrorFlag::error();
+      map_ptr  = addr;
+      map_size = new_size;
+      return ErrorFlag::success();
+    }
+  #endif // COLT_LINUX
+    if (map_ptr != nullptr)
+      munmap(map_ptr, map_size);
+    map_ptr  = nullptr;
+    map_size = 0;
+    delta    = 0;
+    if (new_size == 0)
+      return ErrorFlag::success();
+
+    const int prot  = access == ReadOnly ? PROT_READ : PROT_READ | PROT_WRITE;
+    const int flags = access == CopyOnWrite ? MAP_PRIVATE : MAP_SHARED;
+    void* addr      = mmap(nullptr, new_size, prot, flags, fd, (off_t)aligned);
+    if (addr == MAP_FAILED)
+      return ErrorFlag::error();
+    map_ptr  = addr;
+    map_size = new_size;
+    delta    = (size_t)(view_offset - aligned);
+    return ErrorFlag::success();
   }
 
-  Option<ViewOfFile> ViewOfFile::open(const char* ptr)
+  ErrorFlag ViewOfFile::advise(AccessHint hint, size_t offset, size_t size) noexcept
   {
-    int fd = ::open(ptr, O_RDWR);
+    if (map_ptr == nullptr || offset >= this->size())
+      return ErrorFlag::success();
+    // madvise requires a page aligned address
+    const uintptr_t page  = VirtualPage::page_size().size;
+    const uintptr_t begin = (uintptr_t)map_ptr + delta + offset;
+    const uintptr_t start = begin & ~(page - 1);
+    size                  = clt::min(size, this->size() - offset);
+
+    int advice = MADV_NORMAL;
+    switch_no_default(hint)
+    {
+    case Normal:
+      advice = MADV_NORMAL;
+      break;
+    case Sequential:
+      advice = MADV_SEQUENTIAL;
+      break;
+    case Random:
+      advice = MADV_RANDOM;
+      break;
+    case WillNeed:
+      advice = MADV_WILLNEED;
+      break;
+    case DontNeed:
+      advice = MADV_DONTNEED;
+      break;
+    }
+    if (madvise((void*)start, begin + size - start, advice) != 0)
+      return ErrorFlag::error();
+    return ErrorFlag::success();
+  }
+
+  ErrorFlag ViewOfFile::flush() noexcept
+  {
+    if (map_ptr == nullptr || access != ReadWrite)
+      return ErrorFlag::success();
+    if (msync(map_ptr, map_size, MS_SYNC) != 0)
+      return ErrorFlag::error();
+    return ErrorFlag::success();
+  }
+
+  ErrorFlag ViewOfFile::grow(size_t new_size) noexcept
+  {
+    assert_true("Only ReadWrite views can grow!", access == ReadWrite);
+    assert_true("The new size must be greater!", new_size >= size());
+    if (ftruncate(fd, (off_t)(view_offset + new_size)) != 0)
+      return ErrorFlag::error();
+    return remap(new_size);
+  }
+
+  Option<ViewOfFile> ViewOfFile::open(const char* ptr, MapAccess access)
+  {
+    return open(ptr, 0, TO_END, access);
+  }
+
+  Option<ViewOfFile> ViewOfFile::open(
+      const char* ptr, u64 offset, size_t size, MapAccess access)
+  {
+    COLT_TRACE_SCOPE("ViewOfFile::open");
+    int fd = ::open(ptr, access == ReadWrite ? O_RDWR : O_RDONLY);
     if (fd == -1)
       return None;
 
     struct stat sb;
-    if (fstat(fd, &sb) != 0)
+    if (fstat(fd, &sb) != 0 || offset > (u64)sb.st_size)
     {
       ::close(fd);
       return None;
     }
-    off_t file_size = sb.st_size;
-    void* addr      = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
-    if (addr == MAP_FAILED)
-    {
-      ::close(fd);
+    auto ret = ViewOfFile(fd, access, offset);
+    if (ret.remap(clt::min(size, (size_t)((u64)sb.st_size - offset))).is_error())
       return None;
+    // Only ReadWrite mappings need the file descriptor (to grow)
+    if (access != ReadWrite)
+    {
+      ::close(ret.fd);
+      ret.fd = -1;
     }
-    ::close(fd);
-    return ViewOfFile{addr, (size_t)file_size};
+    return Option<ViewOfFile>(std::move(ret));
+  }
+
+  Option<ViewOfFile> ViewOfFile::create(const char* ptr, size_t size)
+  {
+    COLT_TRACE_SCOPE("ViewOfFile::create");
+    int fd = ::open(ptr, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fd == -1)
+      return None;
+    auto ret = ViewOfFile(fd, ReadWrite, 0);
+    if (ftruncate(fd, (off_t)size) != 0 || ret.remap(size).is_error())
+      return None;
+    return Option<ViewOfFile>(std::move(ret));
   }
 #endif // COLT_WINDOWS
 } // namespace clt
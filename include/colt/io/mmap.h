@@ -1,15 +1,83 @@
 #ifndef HG_COLT_MMAP
 #define HG_COLT_MMAP
 
+#include <bit>
+#include <limits>
 #include <colt/typedefs.h>
 #include <colt/dsa/option.h>
 #include <colt/dsa/string_view.h>
 
 namespace clt
 {
+  /// @brief Options for the allocation of pages (which can be combined)
+  enum class PageOption : u8
+  {
+    /// @brief No option: the pages are of the default size
+    NoOption = 0,
+    /// @brief Asks the OS to back the pages with huge pages when possible.
+    /// On Linux, the allocation is aligned to `large_page_size()` and
+    /// advised with `MADV_HUGEPAGE` (transparent huge pages).
+    TransparentHugePages = 1,
+    /// @brief Requires the pages to be huge pages: the allocation fails
+    /// if none are available (`MAP_HUGETLB` on Linux, `MEM_LARGE_PAGES`
+    /// on Windows, which requires the 'SeLockMemoryPrivilege').
+    ExplicitHugePages = 2,
+    /// @brief Pre-faults the pages (`MAP_POPULATE` on Linux), which avoids
+    /// the cost of page faults on first access.
+    Populate = 4,
+  };
+
+  /// @brief Combines two PageOption
+  /// @param a The first option
+  /// @param b The second option
+  /// @return a | b
+  constexpr PageOption operator|(PageOption a, PageOption b) noexcept
+  {
+    return static_cast<PageOption>(static_cast<u8>(a) | static_cast<u8>(b));
+  }
+
+  /// @brief Check if an option is part of options
+  /// @param options The options
+  /// @param option The option to check for
+  /// @return True if 'option' is part of 'options'
+  constexpr bool is_enabled(PageOption options, PageOption option) noexcept
+  {
+    return (static_cast<u8>(options) & static_cast<u8>(option)) != 0;
+  }
+
+  namespace mem
+  {
+    template<PageOption OPTIONS>
+    struct BasicPageAllocator;
+
+    template<u64 QUARANTINE_BUDGET, bool GUARD_BEFORE, u64 ALIGN>
+      requires(std::has_single_bit(ALIGN)) && (ALIGN <= 4096)
+    class GuardPageAllocator;
+
+    template<u64 REGION_SIZE, u64 ALIGN>
+      requires(std::has_single_bit(ALIGN)) && (ALIGN <= 4096)
+    class ExecutableArena;
+  } // namespace mem
+
+  class VirtualPage;
+
+  /// @brief The same pages mapped twice: once writable, once executable.
+  /// Code can be written through one view while it executes through the
+  /// other, without ever having pages that are both writable and executable.
+  struct DualMapping;
+
   /// @brief Represents a memory page
   class VirtualPage
   {
+    template<PageOption OPTIONS>
+    friend struct mem::BasicPageAllocator;
+    template<u64 QUARANTINE_BUDGET, bool GUARD_BEFORE, u64 ALIGN>
+      requires(std::has_single_bit(ALIGN)) && (ALIGN <= 4096)
+    friend class mem::GuardPageAllocator;
+    template<u64 REGION_SIZE, u64 ALIGN>
+      requires(std::has_single_bit(ALIGN)) && (ALIGN <= 4096)
+    friend class mem::ExecutableArena;
+
     /// @brief The pointer to the start of the block (or null)
     void* begin_ = nullptr;
     /// @brief The size of the block or 0 if null
@@ -68,17 +136,58 @@ namespace clt
     COLTCPP_EXPORT
     static VirtualPage allocate(
         bytes byte, PageAccess access, void* hint = nullptr) noexcept;
+
+    /// @brief Represents the absence of preference for a NUMA node
+    static constexpr u32 AnyNumaNode = std::numeric_limits<u32>::max();
+
+    /// @brief Allocates a new page, using huge pages or a NUMA node if requested.
+    /// If huge pages are requested, the size is rounded up to a multiple
+    /// of `large_page_size()`. NUMA binding is only supported on Linux and
+    /// Windows (it is ignored on other platforms).
+    /// @param byte The size in bytes of the page
+    /// @param access The access type for the allocated page
+    /// @param options The options of the allocation
+    /// @param numa_node The NUMA node on which to allocate or AnyNumaNode
+    /// @param hint Hint address to where to allocate the page
+    /// @return Allocated Page or Page for which is_null is true on errors
+    COLTCPP_EXPORT
+    static VirtualPage allocate(
+        bytes byte, PageAccess access, PageOption options,
+        u32 numa_node = AnyNumaNode, void* hint = nullptr) noexcept;
+
     /// @brief Deallocates a page that was created through `allocate`
     /// @param page The page to deallocate
     COLTCPP_EXPORT
     static void deallocate(const VirtualPage& page) noexcept;
 
+    /// @brief Changes the access of the pages in [begin, begin + size).
+    /// @param begin The beginning of the pages (multiple of `page_size()`)
+    /// @param size The size of the pages to protect
+    /// @param access The new access type of the pages
+    /// @return True on success
+    COLTCPP_EXPORT
+    static bool protect(void* begin, bytes size, PageAccess access) noexcept;
+
+    /// @brief Changes the access of the current page
+    /// @param access The new access type of the page
+    /// @return True on success
+    bool protect(PageAccess access) noexcept
+    {
+      return VirtualPage::protect(begin_, bytes{size_}, access);
+    }
+
     /// @brief Returns the default page size of the current OS.
     /// The result of the underlying system call is cached.
     /// @return The default page size of the current OS
     COLTCPP_EXPORT
     static bytes page_size() noexcept;
 
+    /// @brief Returns the size of huge pages of the current OS.
+    /// The result of the underlying system call is cached.
+    /// @return The size of huge pages, or 0 if they are not supported
+    COLTCPP_EXPORT
+    static bytes large_page_size() noexcept;
+
     /// @brief Flush the instruction cache.
     /// This function should be called if an application generate or
     /// modify code in memory.
@@ -90,68 +199,164 @@ namespace clt
 
     /// @brief Flushes the instruction cache of the current page
     void flush_icache() noexcept { VirtualPage::flush_icache(ptr(), size()); }
+
+    /// @brief Maps pages twice: once as ReadWrite, once as ReadExecute.
+    /// This uses a shared memory object ('memfd_create' on Linux, a
+    /// page-file backed mapping on Windows). It is not supported on other
+    /// platforms, and may be denied by hardened kernels.
+    /// @param byte The size in bytes of the pages
+    /// @return The mapping, or a mapping for which is_null is true on errors
+    COLTCPP_EXPORT
+    static DualMapping allocate_dual(bytes byte) noexcept;
+
+    /// @brief Unmaps both views of pages created through `allocate_dual`
+    /// @param mapping The mapping to deallocate
+    COLTCPP_EXPORT
+    static void deallocate_dual(const DualMapping& mapping) noexcept;
   };
 
-  /// @brief Represents a view over a read-only memory mapped file.
-  class ViewOfFile
+  struct DualMapping
   {
-#ifdef COLT_WINDOWS
-    void* file_handle;
-    void* mapping_handle;
-    void* view_map;
+    /// @brief The view through which the pages are written
+    VirtualPage writable;
+    /// @brief The view through which the pages are executed
+    VirtualPage executable;
 
-    ViewOfFile(void* file, void* mapping, void* view) noexcept
-        : file_handle(file)
-        , mapping_handle(mapping)
-        , view_map(view)
-    {
-    }
+    /// @brief Check if the mapping failed
+    /// @return True if the mapping is null
+    bool is_null() const noexcept { return writable.is_null(); }
+  };
 
+  /// @brief Represents a view over a memory mapped file (or a range of it).
+  /// Only the mapped range is faulted in: a multi-GB file can be processed
+  /// by mapping successive ranges, and hinted with 'advise'.
+  class ViewOfFile
+  {
   public:
-    ViewOfFile(ViewOfFile&& other) noexcept
-        : file_handle(std::exchange(other.file_handle, nullptr))
-        , mapping_handle(std::exchange(other.mapping_handle, nullptr))
-        , view_map(std::exchange(other.view_map, nullptr))
+    /// @brief The access of a mapping
+    enum class MapAccess : u8
     {
-    }
+      /// @brief The mapping can only be read
+      ReadOnly,
+      /// @brief The mapping can be written, and writes modify the file
+      ReadWrite,
+      /// @brief The mapping can be written, but the writes are private
+      /// to the mapping (copy-on-write): the file is not modified
+      CopyOnWrite,
+    };
+    using enum MapAccess;
 
-    ViewOfFile& operator=(ViewOfFile&& other) noexcept
+    /// @brief Hints on the way a mapping will be accessed
+    enum class AccessHint : u8
     {
-      assert_true("Self assignment is prohibited!", &other != this);
+      /// @brief No special treatment
+      Normal,
+      /// @brief The pages are accessed sequentially (more read-ahead)
+      Sequential,
+      /// @brief The pages are accessed randomly (less read-ahead)
+      Random,
+      /// @brief The pages will be accessed soon (asynchronous prefetch)
+      WillNeed,
+      /// @brief The pages will not be accessed soon (they can be evicted).
+      /// The private writes to a CopyOnWrite mapping are discarded.
+      DontNeed,
+    };
+    using enum AccessHint;
 
-      std::swap(file_handle, other.file_handle);
-      std::swap(mapping_handle, other.mapping_handle);
-      std::swap(view_map, other.view_map);
+    /// @brief Size to pass to 'open' to map until the end of the file
+    static constexpr size_t TO_END = std::numeric_limits<size_t>::max();
 
-      return *this;
-    }
+  private:
+#ifdef COLT_WINDOWS
+    /// @brief The file handle (null if closed)
+    void* file_handle = nullptr;
+    /// @brief The file mapping handle (null if nothing is mapped)
+    void* mapping_handle = nullptr;
 #else
-    void* mmap_handle;
-    size_t file_size;
+    /// @brief The file descriptor, only kept open for ReadWrite mappings
+    int fd = -1;
+#endif // COLT_WINDOWS
+    /// @brief The start of the mapping (aligned to the allocation granularity)
+    void* map_ptr = nullptr;
+    /// @brief The size of the mapping (0 if nothing is mapped)
+    size_t map_size = 0;
+    /// @brief The count of bytes of the mapping that precede the view
+    size_t delta = 0;
+    /// @brief The offset in the file of the start of the view
+    u64 view_offset = 0;
+    /// @brief The access of the mapping
+    MapAccess access = ReadOnly;
 
-    ViewOfFile(void* file, size_t size) noexcept
-        : mmap_handle(file)
-        , file_size(size)
+#ifdef COLT_WINDOWS
+    /// @brief Constructor, the range must then be mapped using 'remap'
+    /// @param file The file handle
+    /// @param access The access of the mapping
+    /// @param offset The offset in the file of the start of the view
+    ViewOfFile(void* file, MapAccess access, u64 offset) noexcept
+        : file_handle(file)
+        , view_offset(offset)
+        , access(access)
+    {
+    }
+#else
+    /// @brief Constructor, the range must then be mapped using 'remap'
+    /// @param fd The file descriptor
+    /// @param access The access of the mapping
+    /// @param offset The offset in the file of the start of the view
+    ViewOfFile(int fd, MapAccess access, u64 offset) noexcept
+        : fd(fd)
+        , view_offset(offset)
+        , access(access)
     {
     }
+#endif // COLT_WINDOWS
+
+    /// @brief Maps 'size' bytes of the file starting at 'view_offset'.
+    /// The previous mapping (if any) is unmapped.
+    /// @param size The size of the view
+    /// @return Success or failure (in which case nothing is mapped)
+    COLTCPP_EXPORT ErrorFlag remap(size_t size) noexcept;
 
   public:
+    /// @brief Move constructor
+    /// @param other The view to move
     ViewOfFile(ViewOfFile&& other) noexcept
-        : mmap_handle(std::exchange(other.mmap_handle, nullptr))
-        , file_size(std::exchange(other.file_size, 0))
+        :
+#ifdef COLT_WINDOWS
+        file_handle(std::exchange(other.file_handle, nullptr))
+        , mapping_handle(std::exchange(other.mapping_handle, nullptr))
+#else
+        fd(std::exchange(other.fd, -1))
+#endif // COLT_WINDOWS
+        , map_ptr(std::exchange(other.map_ptr, nullptr))
+        , map_size(std::exchange(other.map_size, 0))
+        , delta(std::exchange(other.delta, 0))
+        , view_offset(std::exchange(other.view_offset, 0))
+        , access(other.access)
     {
     }
 
+    /// @brief Move assignment operator
+    /// @param other The view to move
+    /// @return Self
     ViewOfFile& operator=(ViewOfFile&& other) noexcept
     {
       assert_true("Self assignment is prohibited!", &other != this);
-      std::swap(mmap_handle, other.mmap_handle);
-      std::swap(file_size, other.file_size);
+#ifdef COLT_WINDOWS
+      std::swap(file_handle, other.file_handle);
+      std::swap(mapping_handle, other.mapping_handle);
+#else
+      std::swap(fd, other.fd);
+#endif // COLT_WINDOWS
+      std::swap(map_ptr, other.map_ptr);
+      std::swap(map_size, other.map_size);
+      std::swap(delta, other.delta);
+      std::swap(view_offset, other.view_offset);
+      std::swap(access, other.access);
       return *this;
     }
-#endif // COLT_WINDOWS
 
-    /// @brief Default constructor. Returns a library that is not open
+    /// @brief Default constructor. Returns a view that is not open
     ViewOfFile()                             = default;
     ViewOfFile(const ViewOfFile&)            = delete;
     ViewOfFile& operator=(const ViewOfFile&) = delete;
@@ -162,32 +367,104 @@ namespace clt
       if (is_open())
         close();
     }
-    /// @brief True if the current library is open/
+    /// @brief True if the current view is open
     /// @return True if not closed
     bool is_open() const noexcept { return !is_closed(); }
 
-    /// @brief True if the current library is not open.
-    /// A default constructed library is closed.
+    /// @brief True if the current view is not open.
+    /// A default constructed view is closed.
     /// @return True if not open
     COLTCPP_EXPORT bool is_closed() const noexcept;
     /// @brief Closes the view.
     /// This is done automatically by the destructor.
     COLTCPP_EXPORT void close();
 
-    /// @brief Returns a view of bytes over the file.
+    /// @brief Returns the access of the mapping
+    /// @return The access of the mapping
+    MapAccess map_access() const noexcept { return access; }
+    /// @brief Returns the offset in the file of the start of the view
+    /// @return The offset of the view
+    u64 offset() const noexcept { return view_offset; }
+    /// @brief Returns the size of the view
+    /// @return The size in bytes of the view
+    size_t size() const noexcept { return map_size - delta; }
+
+    /// @brief Returns a view of bytes over the mapped range.
     /// If the file is not opened, returns an empty view.
     /// None is only returned on OS failures.
-    /// @return None on OS failures, else view over the file.
-    COLTCPP_EXPORT Option<View<u8>> view() const noexcept;
+    /// @return None on OS failures, else view over the mapped range.
+    Option<View<u8>> view() const noexcept
+    {
+      if (map_ptr == nullptr)
+        return View<u8>{(const u8*)nullptr, (size_t)0};
+      return View<u8>{static_cast<const u8*>(map_ptr) + delta, size()};
+    }
+
+    /// @brief Returns a writable view over the mapped range.
+    /// @pre map_access() != ReadOnly
+    /// @return Writable view over the mapped range
+    Span<u8> span() noexcept
+    {
+      assert_true("The mapping is read-only!", access != ReadOnly);
+      if (map_ptr == nullptr)
+        return Span<u8>{(u8*)nullptr, (size_t)0};
+      return Span<u8>{static_cast<u8*>(map_ptr) + delta, size()};
+    }
 
-    /// @brief Opens a view of a file
+    /// @brief Hints the OS on how a range of the view will be accessed.
+    /// On Windows, only WillNeed (PrefetchVirtualMemory) and DontNeed
+    /// (which removes the pages from the working set) have an effect.
+    /// @param hint The access hint
+    /// @param offset The offset in the view of the range
+    /// @param size The size of the range (clamped to the view)
+    /// @return Success or failure
+    [[nodiscard]] COLTCPP_EXPORT ErrorFlag advise(
+        AccessHint hint, size_t offset = 0, size_t size = TO_END) noexcept;
+
+    /// @brief Writes the modified pages of a ReadWrite mapping to the file.
+    /// Does nothing for other mappings.
+    /// @return Success or failure
+    [[nodiscard]] COLTCPP_EXPORT ErrorFlag flush() noexcept;
+
+    /// @brief Grows a ReadWrite view (and the file) to 'new_size' bytes.
+    /// The added bytes are zeros. The mapping can move: any pointer to
+    /// the previous view is invalidated.
+    /// @pre map_access() == ReadWrite && new_size >= size()
+    /// @param new_size The new size of the view
+    /// @return Success or failure
+    [[nodiscard]] COLTCPP_EXPORT ErrorFlag grow(size_t new_size) noexcept;
+
+    /// @brief Opens a view of a whole file
     /// @param ptr The file path
+    /// @param access The access of the mapping
     /// @return None on errors or opened ViewOfFile
-    COLTCPP_EXPORT static Option<ViewOfFile> open(const char* ptr);
-    /// @brief Opens a view of a file
+    COLTCPP_EXPORT static Option<ViewOfFile> open(
+        const char* ptr, MapAccess access = ReadOnly);
+    /// @brief Opens a view of a whole file
+    /// @param ptr The file path
+    /// @param access The access of the mapping
+    /// @return None on errors or opened ViewOfFile
+    static Option<ViewOfFile> open(ZStringView ptr, MapAccess access = ReadOnly)
+    {
+      return open(ptr.c_str(), access);
+    }
+
+    /// @brief Opens a view of a range of a file.
+    /// The offset does not need to be aligned to the page size.
+    /// @param ptr The file path
+    /// @param offset The offset of the range (at most the file size)
+    /// @param size The size of the range (clamped to the end of the file)
+    /// @param access The access of the mapping
+    /// @return None on errors or opened ViewOfFile
+    COLTCPP_EXPORT static Option<ViewOfFile> open(
+        const char* ptr, u64 offset, size_t size, MapAccess access = ReadOnly);
+
+    /// @brief Creates (or truncates) a file of 'size' zeros and maps it
+    ///        as ReadWrite, to write an output through the mapping.
     /// @param ptr The file path
+    /// @param size The size of the file
     /// @return None on errors or opened ViewOfFile
-    static Option<ViewOfFile> open(ZStringView ptr) { return open(ptr.c_str()); }
+    COLTCPP_EXPORT static Option<ViewOfFile> create(const char* ptr, size_t size);
   };
 } // namespace clt
 
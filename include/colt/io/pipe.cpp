@@ -0,0 +1,150 @@
+#include "pipe.h"
+#include <colt/num/math.h>
+#include <limits>
+#include <vector>
+
+#ifdef COLT_WINDOWS
+  #include <io.h>
+  #include <fcntl.h>
+  #define NOMINMAX
+  #include <Windows.h>
+#else
+  #include <cerrno>
+  #include <fcntl.h>
+  #include <poll.h>
+  #include <unistd.h>
+#endif // COLT_WINDOWS
+
+namespace clt
+{
+  /// @brief The size of the buffer used when bytes cannot be spliced
+  static constexpr size_t FORWARD_BUFFER_SIZE = 16 * 1024;
+
+  /// @brief Copies at most 'max_size' bytes from 'from' to 'to' through a buffer
+  /// @param from The file from which to read
+  /// @param to The file to which to write
+  /// @param max_size The maximum count of bytes to copy
+  /// @return None on errors, else the count of bytes copied
+  static Option<size_t> copy_through_buffer(
+      File& from, File& to, size_t max_size) noexcept
+  {
+    u8 buffer[FORWARD_BUFFER_SIZE];
+    auto read = from.read(Span<u8>{buffer, clt::min(max_size, FORWARD_BUFFER_SIZE)});
+    if (read.is_none())
+      return None;
+    for (size_t written = 0; written != *read;)
+    {
+      auto write = to.write(View<u8>{buffer + written, *read - written});
+      if (write.is_none() || *write == 0)
+        return None;
+      written += *write;
+    }
+    return read;
+  }
+
+#ifdef COLT_WINDOWS
+  Option<Pipe> Pipe::create() noexcept
+  {
+    int fds[2];
+    if (_pipe(fds, 64 * 1024, _O_BINARY | _O_NOINHERIT) != 0)
+      return None;
+    return {InPlace, Pipe{File{fds[0], File::Read}, File{fds[1], File::Write}}};
+  }
+
+  Option<size_t> poll_readable(
+      Span<PollEntry> entries, std::chrono::milliseconds timeout) noexcept
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (;;)
+    {
+      size_t count = 0;
+      for (auto& i : entries)
+      {
+        HANDLE handle   = (HANDLE)_get_osfhandle(i.file->fileno());
+        DWORD available = 0;
+        i.readable      = false;
+        i.closed        = false;
+        if (!PeekNamedPipe(handle, nullptr, 0, nullptr, &available, nullptr))
+        {
+          if (GetLastError() != ERROR_BROKEN_PIPE)
+            return None;
+          i.closed = true;
+        }
+        i.readable = i.closed || available != 0;
+        count += static_cast<size_t>(i.readable);
+      }
+      if (count != 0
+          || (timeout.count() >= 0
+              && std::chrono::steady_clock::now() - start >= timeout))
+        return count;
+      Sleep(1);
+    }
+  }
+
+  Option<size_t> forward(File& from, File& to, size_t max_size) noexcept
+  {
+    if (!from.is_open() || !to.is_open() || from.file_access() != File::Read
+        || to.file_access() == File::Read)
+      return None;
+    return copy_through_buffer(from, to, max_size);
+  }
+#else
+  Option<Pipe> Pipe::create() noexcept
+  {
+    int fds[2];
+    if (::pipe(fds) != 0)
+      return None;
+    ::fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    ::fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return {InPlace, Pipe{File{fds[0], File::Read}, File{fds[1], File::Write}}};
+  }
+
+  Option<size_t> poll_readable(
+      Span<PollEntry> entries, std::chrono::milliseconds timeout) noexcept
+  {
+    std::vector<pollfd> fds;
+    fds.reserve(entries.size());
+    for (auto& i : entries)
+      fds.push_back(pollfd{i.file->fileno(), POLLIN, 0});
+    const int wait = timeout.count() < 0
+                         ? -1
+                         : static_cast<int>(clt::min<i64>(
+                             timeout.count(), std::numeric_limits<int>::max()));
+    int ready;
+    do
+      ready = ::poll(fds.data(), static_cast<nfds_t>(fds.size()), wait);
+    while (ready == -1 && errno == EINTR);
+    if (ready == -1)
+      return None;
+    size_t count = 0;
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+      const auto events   = fds[i].revents;
+      entries[i].closed   = (events & POLLHUP) != 0;
+      entries[i].readable = (events & (POLLIN | POLLHUP | POLLERR | POLLNVAL)) != 0;
+      count += static_cast<size_t>(entries[i].readable);
+    }
+    return count;
+  }
+
+  Option<size_t> forward(File& from, File& to, size_t max_size) noexcept
+  {
+    if (!from.is_open() || !to.is_open() || from.file_access() != File::Read
+        || to.file_access() == File::Read)
+      return None;
+  #ifdef COLT_LINUX
+    ssize_t moved;
+    do
+      moved = ::splice(
+          from.fileno(), nullptr, to.fileno(), nullptr, max_size, SPLICE_F_MOVE);
+    while (moved == -1 && errno == EINTR);
+    if (moved >= 0)
+      return static_cast<size_t>(moved);
+    // Neither file is a pipe (or 'to' is opened for appending)
+    if (errno != EINVAL)
+      return None;
+  #endif // COLT_LINUX
+    return copy_through_buffer(from, to, max_size);
+  }
+#endif // COLT_WINDOWS
+} // namespace clt
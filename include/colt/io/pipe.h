@@ -0,0 +1,78 @@
+/*****************************************************************/ /**
+ * @file   pipe.h
+ * @brief  Contains Pipe, poll_readable and forward, to stream the
+ * output of many subprocesses (or any pipe) without blocking.
+ * Pipes are represented by File, so they can be read through any
+ * reader of File (such as BufferedReader) once polled as readable.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_PIPE
+#define HG_COLT_PIPE
+
+#include <chrono>
+#include <colt/typedefs.h>
+#include <colt/dsa/option.h>
+#include <colt/io/file.h>
+
+namespace clt
+{
+  /// @brief An anonymous pipe
+  struct Pipe
+  {
+    /// @brief The end from which to read
+    File read_end;
+    /// @brief The end to which to write
+    File write_end;
+
+    /// @brief Closes both ends of the pipe
+    void close() noexcept
+    {
+      read_end.close();
+      write_end.close();
+    }
+
+    /// @brief Creates an anonymous pipe
+    /// @return None on errors, else the pipe
+    [[nodiscard]] COLTCPP_EXPORT static Option<Pipe> create() noexcept;
+  };
+
+  /// @brief A file whose readiness to poll
+  struct PollEntry
+  {
+    /// @brief The file to poll (a pipe, such as Subprocess::get_stdout())
+    const File* file;
+    /// @brief Set to true if a read will not block (data or end of file)
+    bool readable = false;
+    /// @brief Set to true if the write end was closed.
+    /// Data may still be available to read until a read returns 0.
+    bool closed = false;
+  };
+
+  /// @brief Waits until at least one of the files is readable (or closed).
+  /// A single read of a readable file does not block: reading as many
+  /// subprocesses as needed is done by polling then reading in a loop.
+  /// On Linux this uses poll. On Windows, anonymous pipes do not support
+  /// overlapped I/O, so the pipes are peeked until one is readable.
+  /// @param entries The files to poll (whose flags are updated)
+  /// @param timeout The maximum time to wait (negative to wait forever)
+  /// @return None on errors, else the count of readable or closed files
+  ///         (0 if the timeout elapsed)
+  [[nodiscard]] COLTCPP_EXPORT Option<size_t> poll_readable(
+      Span<PollEntry> entries, std::chrono::milliseconds timeout) noexcept;
+
+  /// @brief Moves at most 'max_size' bytes from 'from' to 'to', as a single
+  ///        read of 'from' (which does not block if 'from' is readable).
+  /// On Linux, if either file is a pipe, the bytes are moved by the kernel
+  /// using splice (without copying them to user space). Else the bytes
+  /// are copied through a buffer.
+  /// @param from The file from which to read
+  /// @param to The file to which to write
+  /// @param max_size The maximum count of bytes to move
+  /// @return None on errors, else the count of bytes moved (0 on end of file)
+  [[nodiscard]] COLTCPP_EXPORT Option<size_t> forward(
+      File& from, File& to, size_t max_size = 64 * 1024) noexcept;
+} // namespace clt
+
+#endif // !HG_COLT_PIPE
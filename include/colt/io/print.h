@@ -13,6 +13,7 @@
 #include <cstdio>
 
 #include "colt/io/file.h"
+#include "colt/dsa/vector.h"
 #include "colt/meta/string_literal.h"
 #include "console_effect.h"
 
@@ -42,6 +43,134 @@ namespace clt
     return fmt::format_to_n(std::forward<OutputIt>(it), n, fmt, std::forward<Args>(args)...);
   }
 
+  namespace details
+  {
+    /// @brief Check if a container is a BasicString (whose capacity
+    ///        includes the NUL-terminator)
+    template<typename Container>
+    concept FormatString = requires { Container::STR_ENCODING; };
+  } // namespace details
+
+  namespace meta
+  {
+    /// @brief A container of bytes that FormatBuffer can write into.
+    /// BasicVector<char or u8> and BasicString (UTF8 or ASCII) are supported.
+    template<typename Container>
+    concept FormatContainer = requires(Container& c, size_t n) {
+      { c.data() } -> std::convertible_to<const void*>;
+      c.capacity();
+      c._Unsafe_size(n);
+    } && sizeof(*std::declval<Container&>().data()) == 1;
+  } // namespace meta
+
+  /// @brief {fmt} buffer writing directly after the end of a BasicString or
+  ///        a BasicVector.
+  /// The memory is obtained from the allocator of the container (with
+  /// DefaultGrowth), so the output is never copied: `fmt::format_to` with
+  /// `fmt::appender(buffer)` writes in the container.
+  /// The container must not be used before the buffer is flushed (which
+  /// is done on destruction).
+  /// @tparam Container The container type
+  template<meta::FormatContainer Container>
+  class FormatBuffer final : public fmt::detail::buffer<char>
+  {
+    /// @brief The container written into
+    Container& container;
+    /// @brief The size of the container before formatting
+    size_t base;
+
+    /// @brief Returns the size of the container
+    size_t container_size() const noexcept
+    {
+      if constexpr (details::FormatString<Container>)
+        return container.unit_len();
+      else
+        return container.size();
+    }
+
+    /// @brief Returns the count of bytes that can be stored in the container
+    size_t container_capacity() const noexcept
+    {
+      if constexpr (details::FormatString<Container>)
+        return container.capacity() - 1;
+      else
+        return container.capacity();
+    }
+
+    /// @brief Points the buffer to the capacity of the container
+    void reset_storage() noexcept
+    {
+      // Materializes a borrowed string
+      char* data = ptr_to<char*>(container.data());
+      this->set(data + base, container_capacity() - base);
+    }
+
+    /// @brief Commits the written bytes, then grows the container
+    /// @param capacity The capacity of the buffer required
+    void grow_container(size_t capacity) noexcept
+    {
+      flush();
+      const size_t required = base + capacity;
+      const size_t total    = DefaultGrowth::grow(container_capacity(), required, 1);
+      if constexpr (details::FormatString<Container>)
+        container.reserve(total);
+      else
+        container.reserve_exact(total - container.size());
+      reset_storage();
+    }
+
+#if FMT_VERSION >= 110000
+    /// @brief The grow function of the buffer
+    static void grow(fmt::detail::buffer<char>& buf, size_t capacity) noexcept
+    {
+      static_cast<FormatBuffer&>(buf).grow_container(capacity);
+    }
+#else
+    /// @brief Grows the buffer
+    /// @param capacity The capacity of the buffer required
+    void grow(size_t capacity) noexcept final { grow_container(capacity); }
+#endif // FMT_VERSION >= 110000
+
+  public:
+    /// @brief Constructs a buffer appending to 'container'
+    /// @param container The container (which must outlive the buffer)
+    FormatBuffer(Container& container) noexcept
+#if FMT_VERSION >= 110000
+        : fmt::detail::buffer<char>(&FormatBuffer::grow)
+        , container(container)
+#else
+        : container(container)
+#endif // FMT_VERSION >= 110000
+        , base(container_size())
+    {
+      reset_storage();
+    }
+
+    FormatBuffer(const FormatBuffer&)            = delete;
+    FormatBuffer& operator=(const FormatBuffer&) = delete;
+
+    /// @brief Flushes the buffer
+    ~FormatBuffer() noexcept { flush(); }
+
+    /// @brief Sets the size of the container to include the written bytes.
+    /// For BasicString, only the written bytes are counted.
+    void flush() noexcept { container._Unsafe_size(base + this->size()); }
+  };
+
+  template<meta::FormatContainer Container, typename... Args>
+  /// @brief Formats a string, appending it to a BasicString or a BasicVector.
+  /// The output is written directly in the container (see FormatBuffer).
+  /// @tparam ...Args The types of the arguments to format
+  /// @param container The container to append to
+  /// @param fmt The format string
+  /// @param ...args The arguments to format
+  void format_into(
+      Container& container, fmt_str<Args...> fmt, Args&&... args) noexcept
+  {
+    FormatBuffer<Container> buffer = {container};
+    fmt::format_to(fmt::appender(buffer), fmt, std::forward<Args>(args)...);
+  }
+
   template<meta::StringLiteral endl = "\n", typename... Args>
   /// @brief Formats and prints a string to 'file'
   /// @tparam ...Args The types of the arguments to format
@@ -1,4 +1,5 @@
 #include "subprocess.h"
+#include "colt/trace.h"
 
 namespace clt
 {
@@ -72,6 +73,7 @@ namespace clt
       View<const char*> command_line, SubprocessOption opt,
       View<const char*> env) noexcept
   {
+    COLT_TRACE_SCOPE("Subprocess::open");
     assert_true(
         "command_line must be terminated with a NULL!",
         !command_line.empty() && command_line.back() == nullptr);
@@ -4,6 +4,7 @@
 #include <exception> // for std::terminate
 #include <colt/dsa/option.h>
 #include <colt/io/file.h>
+#include <colt/io/pipe.h>
 #include <subprocess.h/subprocess.h>
 
 namespace clt
@@ -82,11 +83,15 @@ namespace clt
     /// @return The stdin handle of the process
     [[nodiscard]] COLTCPP_EXPORT File get_stdin() const noexcept;
 
-    /// @brief Return the stdout handle of the subprocess
+    /// @brief Return the stdout handle of the subprocess.
+    /// The handle is a pipe, which can be polled using 'poll_readable'
+    /// or streamed using 'forward' (see pipe.h).
     /// @return The stdout handle of the process
     [[nodiscard]] COLTCPP_EXPORT File get_stdout() const noexcept;
 
-    /// @brief Return the stderr handle of the subprocess
+    /// @brief Return the stderr handle of the subprocess.
+    /// The handle is a pipe, which can be polled using 'poll_readable'
+    /// or streamed using 'forward' (see pipe.h).
     /// @return The stderr handle of the process
     [[nodiscard]]
     COLTCPP_EXPORT File get_stderr() const noexcept;
@@ -0,0 +1,248 @@
+/*****************************************************************/ /**
+ * @file   text_chunks.h
+ * @brief  Contains text_chunks and decode_chunks, which turn a view, a
+ * ViewOfFile or a BufferedReader in lazy ranges (Generator) of chunks.
+ * Each stage of a pipeline then processes a batch of (by default) 16 KiB
+ * that fits in the L1 cache, rather than one code point at a time or a
+ * whole intermediate string:
+ * @code{.cpp}
+ * auto file   = ViewOfFile::open("input.txt");
+ * auto chunks = text_chunks<StringEncoding::UTF8>(*file);
+ * for (View<char32_t> batch : decode_chunks(std::move(*chunks)))
+ *   tokenize(batch);
+ * @endcode
+ * Chunks never split a code point (as long as the text is valid).
+ * As all the adapters are coroutines, they have an overload taking an
+ * allocator (std::allocator_arg, alloc) from which to allocate the frame.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_TEXT_CHUNKS
+#define HG_COLT_TEXT_CHUNKS
+
+#include <colt/algo/generator.h>
+#include <colt/dsa/string_view.h>
+#include <colt/io/buffered_file.h>
+#include <colt/io/mmap.h>
+
+namespace clt
+{
+  /// @brief The default count of units of the chunks of 'text_chunks'
+  inline constexpr size_t DEFAULT_TEXT_CHUNK_SIZE = 16 * 1024;
+  /// @brief The default count of code points of the batches of 'decode_chunks'
+  inline constexpr size_t DEFAULT_DECODE_BATCH_SIZE = 4 * 1024;
+
+  namespace details
+  {
+    /// @brief Returns the end of the last complete code point of a chunk.
+    /// The code point that is split by the end of the chunk is excluded,
+    /// unless the chunk would become empty (which only happens for
+    /// invalid text): a chunk is never empty.
+    /// @tparam ptr_t The char type
+    /// @param begin The start of the chunk
+    /// @param end The end of the chunk (different from 'begin')
+    /// @return The end of the chunk
+    template<typename ptr_t>
+    constexpr const ptr_t* chunk_end(const ptr_t* begin, const ptr_t* end) noexcept
+    {
+      const ptr_t* cut = end;
+      if constexpr (std::same_as<ptr_t, Char8>)
+      {
+        // A code point is at most 4 units: its lead is in the last 4 units
+        const ptr_t* lead = end - 1;
+        while (lead != begin && end - lead < 4 && lead->is_trail())
+          --lead;
+        const u8 unit    = static_cast<u8>(*lead);
+        const auto units = unit >= 0xF0 ? 4 : unit >= 0xE0 ? 3 : 1 + (unit >= 0xC0);
+        if (end - lead < units)
+          cut = lead;
+      }
+      else if constexpr (meta::is_any_of<ptr_t, Char16BE, Char16LE>)
+      {
+        if (end[-1].is_lead_surrogate())
+          cut = end - 1;
+      }
+      return cut == begin ? end : cut;
+    }
+  } // namespace details
+
+  template<StringEncoding ENCODING>
+  /// @brief Splits a view in chunks of at most 'size' units.
+  /// @param alloc The allocator of the frame
+  /// @param view The view to split (whose content must outlive the range)
+  /// @param size The maximum count of units of a chunk
+  /// @return Range over the chunks
+  Generator<BasicStringView<ENCODING>> text_chunks(
+      std::allocator_arg_t, [[maybe_unused]] mem::AnyAllocatorRef alloc,
+      BasicStringView<ENCODING> view, size_t size = DEFAULT_TEXT_CHUNK_SIZE)
+  {
+    assert_true("Chunks cannot be empty!", size != 0);
+    const auto* begin = view.data();
+    const auto* end   = begin + view.unit_len();
+    while (begin != end)
+    {
+      const auto* cut = static_cast<size_t>(end - begin) <= size
+                            ? end
+                            : details::chunk_end(begin, begin + size);
+      co_yield BasicStringView<ENCODING>{begin, cut};
+      begin = cut;
+    }
+  }
+
+  template<StringEncoding ENCODING>
+  /// @brief Splits a view in chunks of at most 'size' units.
+  /// @param view The view to split (whose content must outlive the range)
+  /// @param size The maximum count of units of a chunk
+  /// @return Range over the chunks
+  Generator<BasicStringView<ENCODING>> text_chunks(
+      BasicStringView<ENCODING> view, size_t size = DEFAULT_TEXT_CHUNK_SIZE)
+  {
+    return text_chunks<ENCODING>(
+        std::allocator_arg, mem::GlobalAllocator, view, size);
+  }
+
+  template<StringEncoding ENCODING = StringEncoding::ASCII>
+    requires(sizeof(meta::encoding_to_char_t<ENCODING>) == 1)
+  /// @brief Splits the content of a mapped file in chunks of at most
+  ///        'size' bytes. The content is not validated.
+  /// The OS is hinted that the view is read sequentially.
+  /// @tparam ENCODING The encoding of the file (ASCII or UTF8)
+  /// @param alloc The allocator of the frame
+  /// @param file The mapped file (which must outlive the range)
+  /// @param size The maximum count of bytes of a chunk
+  /// @return None on OS failures, else range over the chunks
+  Option<Generator<BasicStringView<ENCODING>>> text_chunks(
+      std::allocator_arg_t, mem::AnyAllocatorRef alloc, ViewOfFile& file,
+      size_t size = DEFAULT_TEXT_CHUNK_SIZE)
+  {
+    using ptr_t = meta::encoding_to_char_t<ENCODING>;
+    file.advise(ViewOfFile::AccessHint::Sequential).discard();
+    const auto bytes = file.view();
+    if (bytes.is_none())
+      return None;
+    return text_chunks<ENCODING>(
+        std::allocator_arg, alloc,
+        BasicStringView<ENCODING>{
+            ptr_to<const ptr_t*>(bytes->data()), bytes->size()},
+        size);
+  }
+
+  template<StringEncoding ENCODING = StringEncoding::ASCII>
+    requires(sizeof(meta::encoding_to_char_t<ENCODING>) == 1)
+  /// @brief Splits the content of a mapped file in chunks of at most
+  ///        'size' bytes. The content is not validated.
+  /// The OS is hinted that the view is read sequentially.
+  /// @tparam ENCODING The encoding of the file (ASCII or UTF8)
+  /// @param file The mapped file (which must outlive the range)
+  /// @param size The maximum count of bytes of a chunk
+  /// @return None on OS failures, else range over the chunks
+  Option<Generator<BasicStringView<ENCODING>>> text_chunks(
+      ViewOfFile& file, size_t size = DEFAULT_TEXT_CHUNK_SIZE)
+  {
+    return text_chunks<ENCODING>(
+        std::allocator_arg, mem::GlobalAllocator, file, size);
+  }
+
+  template<StringEncoding ENCODING = StringEncoding::ASCII, typename ALLOCATOR>
+    requires(sizeof(meta::encoding_to_char_t<ENCODING>) == 1)
+  /// @brief Reads chunks of at most 'size' bytes from a reader.
+  /// Each chunk points into the buffer of the reader, and is consumed
+  /// when the range is advanced: the reader must not be used while
+  /// iterating. The content is not validated.
+  /// @tparam ENCODING The encoding of the file (ASCII or UTF8)
+  /// @param alloc The allocator of the frame
+  /// @param reader The reader (which must outlive the range)
+  /// @param size The maximum count of bytes of a chunk
+  /// @return Range over the chunks
+  Generator<BasicStringView<ENCODING>> text_chunks(
+      std::allocator_arg_t, [[maybe_unused]] mem::AnyAllocatorRef alloc,
+      BasicBufferedReader<ALLOCATOR>& reader, size_t size = DEFAULT_TEXT_CHUNK_SIZE)
+  {
+    using ptr_t = meta::encoding_to_char_t<ENCODING>;
+    assert_true("Chunks cannot be empty!", size != 0);
+    while (true)
+    {
+      // Less than 'size' bytes are only returned on EOF or errors
+      const auto bytes = reader.peek(size);
+      if (bytes.empty())
+        break;
+      const auto* begin = ptr_to<const ptr_t*>(bytes.data());
+      const auto* cut   = bytes.size() < size
+                              ? begin + bytes.size()
+                              : details::chunk_end(begin, begin + bytes.size());
+      co_yield BasicStringView<ENCODING>{begin, cut};
+      reader.consume(static_cast<size_t>(cut - begin));
+    }
+  }
+
+  template<StringEncoding ENCODING = StringEncoding::ASCII, typename ALLOCATOR>
+    requires(sizeof(meta::encoding_to_char_t<ENCODING>) == 1)
+  /// @brief Reads chunks of at most 'size' bytes from a reader.
+  /// Each chunk points into the buffer of the reader, and is consumed
+  /// when the range is advanced: the reader must not be used while
+  /// iterating. The content is not validated.
+  /// @tparam ENCODING The encoding of the file (ASCII or UTF8)
+  /// @param reader The reader (which must outlive the range)
+  /// @param size The maximum count of bytes of a chunk
+  /// @return Range over the chunks
+  Generator<BasicStringView<ENCODING>> text_chunks(
+      BasicBufferedReader<ALLOCATOR>& reader, size_t size = DEFAULT_TEXT_CHUNK_SIZE)
+  {
+    return text_chunks<ENCODING>(
+        std::allocator_arg, mem::GlobalAllocator, reader, size);
+  }
+
+  template<size_t BATCH = DEFAULT_DECODE_BATCH_SIZE, StringEncoding ENCODING>
+    requires(BATCH != 0)
+  /// @brief Decodes chunks of text in batches of at most BATCH code points.
+  /// The batch buffer is part of the frame (allocated from 'alloc').
+  /// Invalid units are decoded as U+FFFD REPLACEMENT CHARACTER.
+  /// @tparam BATCH The maximum count of code points of a batch
+  /// @param alloc The allocator of the frame
+  /// @param chunks The chunks (as returned by 'text_chunks')
+  /// @return Range over the batches, valid until the range is advanced
+  Generator<View<char32_t>> decode_chunks(
+      std::allocator_arg_t, [[maybe_unused]] mem::AnyAllocatorRef alloc,
+      Generator<BasicStringView<ENCODING>> chunks)
+  {
+    char32_t batch[BATCH];
+    size_t count = 0;
+    for (const auto& chunk : chunks)
+    {
+      const auto* ptr = chunk.data();
+      const auto* end = ptr + chunk.unit_len();
+      while (ptr != end)
+      {
+        const auto* next = ptr;
+        if (!uni::details::checked_decode(next, end, batch[count]))
+          batch[count] = U'\uFFFD', next = ptr + 1;
+        ptr = next;
+        if (++count == BATCH)
+        {
+          co_yield View<char32_t>{batch, count};
+          count = 0;
+        }
+      }
+    }
+    if (count != 0)
+      co_yield View<char32_t>{batch, count};
+  }
+
+  template<size_t BATCH = DEFAULT_DECODE_BATCH_SIZE, StringEncoding ENCODING>
+    requires(BATCH != 0)
+  /// @brief Decodes chunks of text in batches of at most BATCH code points.
+  /// The batch buffer is part of the frame.
+  /// Invalid units are decoded as U+FFFD REPLACEMENT CHARACTER.
+  /// @tparam BATCH The maximum count of code points of a batch
+  /// @param chunks The chunks (as returned by 'text_chunks')
+  /// @return Range over the batches, valid until the range is advanced
+  Generator<View<char32_t>> decode_chunks(
+      Generator<BasicStringView<ENCODING>> chunks)
+  {
+    return decode_chunks<BATCH>(
+        std::allocator_arg, mem::GlobalAllocator, std::move(chunks));
+  }
+} // namespace clt
+
+#endif // !HG_COLT_TEXT_CHUNKS
@@ -0,0 +1,420 @@
+/*****************************************************************/ /**
+ * @file   tree_hash.h
+ * @brief  Contains BasicTreeHash, the hash of a (large) range of bytes,
+ * such as a ViewOfFile, computed as a Merkle tree over chunks.
+ * The bytes are split in chunks of 'chunk_size' bytes (the last one can
+ * be shorter), which are hashed independently, in parallel on the
+ * workers of a Scheduler (see par::for_each_chunk). Using wyhash_h (the
+ * default), chunks of at least wyhash_h::BULK_SIZE bytes are hashed using
+ * SIMD lanes: fingerprinting a file is then bound by reading it.
+ * The hashes of the chunks are combined pairwise (the last hash of an
+ * odd level is carried to the next level) and the root of the tree is
+ * combined with the size and the chunk size.
+ * The hashes of the chunks can be persisted (see 'save' and 'open'), so
+ * that after a modification only the chunks that changed are rehashed
+ * (see 'update'). The persisted format is little endian:
+ * - a header of TREE_HASH_HEADER_SIZE bytes (magic, format, chunk size,
+ *   size, a fingerprint of the hashing algorithm and a checksum of the
+ *   hashes of the chunks)
+ * - the hashes of the chunks, as 64-bit integers.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_TREE_HASH
+#define HG_COLT_TREE_HASH
+
+#include <cstring>
+#include <algorithm>
+
+#include <colt/hash.h>
+#include <colt/dsa/vector.h>
+#include <colt/algo/parallel.h>
+#include <colt/io/file.h>
+#include <colt/io/mmap.h>
+
+namespace clt
+{
+  /// @brief The magic number starting a tree hash ("CLTT" in little endian)
+  static constexpr u32 TREE_HASH_MAGIC = 0x54544C43;
+  /// @brief The version of the format of the persisted tree hashes
+  static constexpr u16 TREE_HASH_FORMAT_VERSION = 1;
+  /// @brief The size of the header of a persisted tree hash
+  static constexpr size_t TREE_HASH_HEADER_SIZE = 40;
+  /// @brief The default size of the chunks of a tree hash
+  static constexpr size_t TREE_HASH_CHUNK_SIZE = 64 * 1024;
+
+  namespace details
+  {
+    /// @brief The header of a persisted tree hash (in little endian)
+    struct TreeHashHeader
+    {
+      /// @brief TREE_HASH_MAGIC
+      u32 magic;
+      /// @brief TREE_HASH_FORMAT_VERSION
+      u16 format;
+      /// @brief Reserved (0)
+      u16 reserved;
+      /// @brief The size of the chunks
+      u64 chunk_size;
+      /// @brief The count of bytes hashed
+      u64 size;
+      /// @brief The hash of TREE_HASH_MAGIC by the hashing algorithm
+      u64 fingerprint;
+      /// @brief The hash of the bytes following the header
+      u64 checksum;
+
+      /// @brief Converts the fields to or from little endian
+      /// @return The converted header
+      constexpr TreeHashHeader convert() const noexcept
+      {
+        // (htol and ltoh are the same conversion)
+        return {htol(magic),      htol(format),      htol(reserved),
+                htol(chunk_size), htol(size),        htol(fingerprint),
+                htol(checksum)};
+      }
+    };
+    static_assert(
+        sizeof(TreeHashHeader) == TREE_HASH_HEADER_SIZE,
+        "The header must not contain padding!");
+
+    /// @brief Returns the result of a hashing algorithm as a 64-bit integer
+    /// @tparam HASH_ALGO The hashing algorithm
+    /// @param algo The hashing algorithm object
+    /// @return The result
+    template<meta::hash_algorithm HASH_ALGO>
+    u64 tree_hash_result(const HASH_ALGO& algo) noexcept
+    {
+      return static_cast<u64>(static_cast<typename HASH_ALGO::result_type>(algo));
+    }
+
+    /// @brief Returns the fingerprint of a hashing algorithm (the hash of
+    ///        TREE_HASH_MAGIC in little endian)
+    /// @tparam HASH_ALGO The hashing algorithm
+    /// @return The fingerprint
+    template<meta::hash_algorithm HASH_ALGO>
+    u64 tree_hash_fingerprint() noexcept
+    {
+      HASH_ALGO algo;
+      const u32 magic = htol(TREE_HASH_MAGIC);
+      algo(&magic, sizeof(magic));
+      return tree_hash_result(algo);
+    }
+
+    /// @brief Hashes 64-bit integers (in little endian, so that the result
+    ///        does not depend on the host)
+    /// @tparam HASH_ALGO The hashing algorithm
+    /// @param values The integers
+    /// @return The hash of the integers
+    template<meta::hash_algorithm HASH_ALGO, size_t N>
+    u64 tree_hash_combine(const u64 (&values)[N]) noexcept
+    {
+      u64 bytes[N];
+      for (size_t i = 0; i < N; i++)
+        bytes[i] = htol(values[i]);
+      HASH_ALGO algo;
+      algo(static_cast<const void*>(bytes), sizeof(bytes));
+      return tree_hash_result(algo);
+    }
+  } // namespace details
+
+  template<meta::hash_algorithm HASH_ALGO = COLT_DEFAULT_HASH_ALGORITHM>
+  /// @brief The hash of a range of bytes as a Merkle tree over chunks
+  ///        (see tree_hash.h).
+  /// @code{.cpp}
+  /// auto file = ViewOfFile::open(path);
+  /// auto hash = TreeHash::hash(*file);
+  /// ...
+  /// // After a write of 'size' bytes at 'offset' (the file is remapped)
+  /// hash->update(*file->view(), offset, size);
+  /// if (hash->root() != previous_root)
+  ///   rebuild();
+  /// @endcode
+  /// @tparam HASH_ALGO The hashing algorithm
+  class BasicTreeHash
+  {
+    /// @brief The size of the chunks
+    size_t chunk_size_;
+    /// @brief The count of bytes hashed
+    size_t size_;
+    /// @brief The hashes of the chunks
+    Vector<u64> chunks;
+
+    /// @brief Constructor (the hashes of the chunks are zeros)
+    /// @param chunk_size The size of the chunks
+    /// @param size The count of bytes hashed
+    BasicTreeHash(size_t chunk_size, size_t size) noexcept
+        : chunk_size_(chunk_size)
+        , size_(size)
+        , chunks(mem::GlobalAllocator, chunk_count_of(size), InPlace, u64{0})
+    {
+    }
+
+    /// @brief Returns the count of chunks of a range
+    /// @param size The size of the range
+    /// @return The count of chunks
+    size_t chunk_count_of(size_t size) const noexcept
+    {
+      return size / chunk_size_ + size_t(size % chunk_size_ != 0);
+    }
+
+    /// @brief Hashes the chunks [first, last) of 'bytes', in parallel
+    /// @param bytes The bytes
+    /// @param first The first chunk
+    /// @param last The end of the chunks
+    /// @param opt The options (of which 'grain' is a count of chunks)
+    /// @return The count of chunks hashed
+    size_t hash_chunks(
+        View<u8> bytes, size_t first, size_t last, par::Options opt) noexcept
+    {
+      if (first >= last)
+        return 0;
+      par::for_each_chunk(
+          last - first,
+          [&](size_t begin, size_t end)
+          {
+            for (size_t i = first + begin; i < first + end; i++)
+            {
+              const size_t offset = i * chunk_size_;
+              HASH_ALGO algo;
+              algo(
+                  static_cast<const void*>(bytes.data() + offset),
+                  std::min(chunk_size_, bytes.size() - offset));
+              chunks[i] = details::tree_hash_result(algo);
+            }
+          },
+          opt);
+      return last - first;
+    }
+
+  public:
+    /// @brief Hashes a range of bytes
+    /// @param bytes The bytes to hash
+    /// @param chunk_size The size of the chunks (not 0)
+    /// @param opt The options (of which 'grain' is a count of chunks)
+    /// @return The tree hash of 'bytes'
+    static BasicTreeHash hash(
+        View<u8> bytes, size_t chunk_size = TREE_HASH_CHUNK_SIZE,
+        par::Options opt = {.grain = 1}) noexcept
+    {
+      assert_true("The chunk size must not be 0!", chunk_size != 0);
+      BasicTreeHash ret = {chunk_size, bytes.size()};
+      ret.hash_chunks(bytes, 0, ret.chunks.size(), opt);
+      return ret;
+    }
+
+    /// @brief Hashes the bytes of a view of a file.
+    /// The OS is hinted that the view is read sequentially.
+    /// @param file The view of the file
+    /// @param chunk_size The size of the chunks (not 0)
+    /// @param opt The options (of which 'grain' is a count of chunks)
+    /// @return None on OS failures, else the tree hash of the view
+    static Option<BasicTreeHash> hash(
+        ViewOfFile& file, size_t chunk_size = TREE_HASH_CHUNK_SIZE,
+        par::Options opt = {.grain = 1}) noexcept
+    {
+      file.advise(ViewOfFile::AccessHint::Sequential).discard();
+      auto bytes = file.view();
+      if (bytes.is_none())
+        return None;
+      return hash(*bytes, chunk_size, opt);
+    }
+
+    /// @brief Rehashes the chunks of 'bytes' that changed since the last hash.
+    /// These are the chunks overlapping [offset, offset + size), and, if the
+    /// count of bytes changed, the chunks from the last one that both
+    /// versions share.
+    /// @pre The bytes only changed in [offset, offset + size), after the end
+    ///      of the old bytes, or were truncated
+    /// @param bytes The (new version of the) bytes
+    /// @param offset The offset of the modified range
+    /// @param size The size of the modified range
+    /// @param opt The options (of which 'grain' is a count of chunks)
+    /// @return The count of chunks rehashed
+    size_t update(
+        View<u8> bytes, size_t offset, size_t size,
+        par::Options opt = {.grain = 1}) noexcept
+    {
+      const size_t old_count = chunks.size();
+      const size_t new_count = chunk_count_of(bytes.size());
+      if (new_count < old_count)
+        chunks.pop_back_n(old_count - new_count);
+      else
+      {
+        chunks.reserve_exact(new_count - old_count);
+        while (chunks.size() != new_count)
+          chunks.push_back(u64{0});
+      }
+
+      // The chunks whose size changed, and the new chunks
+      size_t first = new_count;
+      if (bytes.size() != size_)
+        first = std::min(bytes.size(), size_) / chunk_size_;
+      size_ = bytes.size();
+
+      // The chunks overlapping the modified range (in the new bytes)
+      size_t dirty_first = new_count;
+      size_t dirty_last  = new_count;
+      if (size != 0 && offset < bytes.size())
+      {
+        dirty_first = offset / chunk_size_;
+        dirty_last  = chunk_count_of(
+            bytes.size() - offset < size ? bytes.size() : offset + size);
+      }
+
+      // (both ranges end at most at 'new_count')
+      if (first == new_count)
+        return hash_chunks(bytes, dirty_first, dirty_last, opt);
+      if (dirty_last < first)
+      {
+        return hash_chunks(bytes, dirty_first, dirty_last, opt)
+               + hash_chunks(bytes, first, new_count, opt);
+      }
+      return hash_chunks(bytes, std::min(dirty_first, first), new_count, opt);
+    }
+
+    /// @brief Returns the size of the chunks
+    /// @return The size of the chunks
+    [[nodiscard]] size_t chunk_size() const noexcept { return chunk_size_; }
+
+    /// @brief Returns the count of bytes hashed
+    /// @return The count of bytes hashed
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+
+    /// @brief Returns the hashes of the chunks
+    /// @return The hashes of the chunks
+    [[nodiscard]] View<u64> chunk_hashes() const noexcept
+    {
+      return View<u64>{chunks.data(), chunks.size()};
+    }
+
+    /// @brief Returns the root of the tree, combined with the size and the
+    ///        chunk size (this combines all the hashes of the chunks).
+    /// @return The hash of the bytes
+    [[nodiscard]] u64 root() const noexcept
+    {
+      Vector<u64> level =
+          Vector<u64>{mem::GlobalAllocator, chunks.size(), InPlace, u64{0}};
+      for (size_t i = 0; i < chunks.size(); i++)
+        level[i] = chunks[i];
+      size_t count = level.size();
+      for (; count > 1; count = (count + 1) / 2)
+      {
+        for (size_t i = 0; i < count / 2; i++)
+        {
+          level[i] = details::tree_hash_combine<HASH_ALGO>(
+              {level[2 * i], level[2 * i + 1]});
+        }
+        if (count % 2 != 0)
+          level[count / 2] = level[count - 1];
+      }
+      const u64 tree = count == 0 ? 0 : level[0];
+      return details::tree_hash_combine<HASH_ALGO>(
+          {tree, static_cast<u64>(size_), static_cast<u64>(chunk_size_)});
+    }
+
+    /// @brief Returns the persisted form of the hash (see 'open')
+    /// @return The bytes of the persisted hash
+    [[nodiscard]] Vector<u8> save() const noexcept
+    {
+      const size_t hashes = chunks.size() * sizeof(u64);
+      Vector<u8> ret      = Vector<u8>{
+          mem::GlobalAllocator, TREE_HASH_HEADER_SIZE + hashes, InPlace, u8{0}};
+      u8* ptr = ret.data() + TREE_HASH_HEADER_SIZE;
+      for (size_t i = 0; i < chunks.size(); i++)
+      {
+        const u64 value = htol(chunks[i]);
+        std::memcpy(ptr + i * sizeof(u64), &value, sizeof(value));
+      }
+      HASH_ALGO checksum;
+      checksum(static_cast<const void*>(ptr), hashes);
+      const details::TreeHashHeader header = {
+          TREE_HASH_MAGIC,
+          TREE_HASH_FORMAT_VERSION,
+          0,
+          chunk_size_,
+          size_,
+          details::tree_hash_fingerprint<HASH_ALGO>(),
+          details::tree_hash_result(checksum)};
+      const auto stored = header.convert();
+      std::memcpy(ret.data(), &stored, sizeof(stored));
+      return ret;
+    }
+
+    /// @brief Writes the persisted form of the hash to a file
+    /// @param file The file to which to write
+    /// @return Error if not all the bytes could be written
+    [[nodiscard]] ErrorFlag write_to(File& file) const noexcept
+    {
+      const auto data = save();
+      for (size_t written = 0; written != data.size();)
+      {
+        auto write =
+            file.write(View<u8>{data.data() + written, data.size() - written});
+        if (write.is_none() || *write == 0)
+          return ErrorFlag::error();
+        written += *write;
+      }
+      return ErrorFlag::success();
+    }
+
+    /// @brief Loads a persisted hash (see 'save').
+    /// Hashes of another format, of another hashing algorithm, truncated
+    /// or corrupted are rejected.
+    /// @param bytes The bytes of the persisted hash
+    /// @return None if the bytes are not a valid persisted hash
+    [[nodiscard]] static Option<BasicTreeHash> open(View<u8> bytes) noexcept
+    {
+      if (bytes.size() < TREE_HASH_HEADER_SIZE)
+        return None;
+      details::TreeHashHeader header;
+      std::memcpy(&header, bytes.data(), sizeof(header));
+      header = header.convert();
+      if (header.magic != TREE_HASH_MAGIC
+          || header.format != TREE_HASH_FORMAT_VERSION
+          || header.fingerprint != details::tree_hash_fingerprint<HASH_ALGO>()
+          || header.chunk_size == 0
+          || static_cast<size_t>(header.size) != header.size
+          || static_cast<size_t>(header.chunk_size) != header.chunk_size)
+        return None;
+
+      const size_t count = header.size / header.chunk_size
+                           + size_t(header.size % header.chunk_size != 0);
+      if ((bytes.size() - TREE_HASH_HEADER_SIZE) / sizeof(u64) != count
+          || (bytes.size() - TREE_HASH_HEADER_SIZE) % sizeof(u64) != 0)
+        return None;
+
+      const u8* ptr = bytes.data() + TREE_HASH_HEADER_SIZE;
+      HASH_ALGO checksum;
+      checksum(static_cast<const void*>(ptr), count * sizeof(u64));
+      if (details::tree_hash_result(checksum) != header.checksum)
+        return None;
+
+      BasicTreeHash ret = {
+          static_cast<size_t>(header.chunk_size), static_cast<size_t>(header.size)};
+      for (size_t i = 0; i < count; i++)
+      {
+        u64 value;
+        std::memcpy(&value, ptr + i * sizeof(u64), sizeof(value));
+        ret.chunks[i] = ltoh(value);
+      }
+      return ret;
+    }
+
+    /// @brief Loads a persisted hash from a view of a file (see 'save')
+    /// @param file The view of the file
+    /// @return None if the bytes are not a valid persisted hash
+    [[nodiscard]] static Option<BasicTreeHash> open(const ViewOfFile& file) noexcept
+    {
+      auto bytes = file.view();
+      if (bytes.is_none())
+        return None;
+      return open(*bytes);
+    }
+  };
+
+  /// @brief Tree hash using the default hashing algorithm
+  using TreeHash = BasicTreeHash<>;
+} // namespace clt
+
+#endif // !HG_COLT_TREE_HASH
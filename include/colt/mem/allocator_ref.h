@@ -1,6 +1,6 @@
 /*****************************************************************//**
  * @file   allocator_ref.h
- * @brief  Contains GlobalAllocatorRef and LocalAllocatorRef.
+ * @brief  Contains GlobalAllocatorRef, LocalAllocatorRef and AnyAllocatorRef.
  * These types are the actual allocators inherited by data structures.
  * 
  * @author RPC
@@ -14,8 +14,6 @@
 
 namespace clt::mem
 {
-  // TODO: add polymorphic allocator.
-
   /// @brief Reference to a global allocator
   /// @tparam ALIGN The alignment of the allocator
   /// @tparam ALLOC The allocation function
@@ -54,8 +52,8 @@ namespace clt::mem
     /// @brief Expand a MemBlock
     /// @param sz The MemBlock
     /// @param dt The new size
-    /// @return MemBlock
-    MemBlock expand(MemBlock sz, u64 dt) const
+    /// @return True if expansion was done successfully
+    bool expand(MemBlock& sz, u64 dt) const
       requires(EXPAND != nullptr)
     {
       return EXPAND(sz, dt);
@@ -64,8 +62,8 @@ namespace clt::mem
     /// @brief Reallocates a MemBlock
     /// @param sz The MemBlock
     /// @param dt The new size
-    /// @return MemBlock
-    MemBlock realloc(MemBlock sz, u64 dt) const
+    /// @return True if reallocation was successful
+    bool realloc(MemBlock& sz, u64 dt) const
       requires(REALLOC != nullptr)
     {
       return REALLOC(sz, dt);
@@ -121,7 +119,7 @@ namespace clt::mem
     /// @param sz The block
     /// @param dt The new size
     /// @return The result of expansion
-    MemBlock expand(MemBlock sz, u64 dt) const
+    bool expand(MemBlock& sz, u64 dt) const
       requires meta::ExpandingAllocator<T>
     {
       return ptr->expand(sz, dt);
@@ -131,15 +129,21 @@ namespace clt::mem
     /// @param sz The block
     /// @param dt The new size
     /// @return The result of reallocation
-    MemBlock realloc(MemBlock sz, u64 dt) const
+    bool realloc(MemBlock& sz, u64 dt) const
       requires meta::ReallocatableAllocator<T>
     {
       return ptr->realloc(sz, dt);
     }
+
+    /// @brief Check if two references refer to the same allocator
+    /// @param other The other reference
+    /// @return True if both references refer to the same allocator
+    bool operator==(const LocalAllocatorRef& other) const noexcept = default;
   };
 
-  /// @brief The default global allocator
-  inline FreeList<Mallocator, 16, size_t{4096}, size_t{4096}> DefaultGlobalAllocator;
+  /// @brief The default global allocator.
+  /// Blocks of [16, 4096] bytes are cached, in size classes of 16 bytes.
+  inline SegregatedFreeList<Mallocator, 16, 4096> DefaultGlobalAllocator;
 
   /// @brief Global alloc
   /// @param size The size of the block
@@ -156,10 +160,28 @@ namespace clt::mem
     DefaultGlobalAllocator.dealloc(blk);
   }
 
+  /// @brief Global expand
+  /// @param blk The block
+  /// @param size The new size
+  /// @return True if expansion was done successfully
+  inline bool global_expand(MemBlock& blk, u64 size) noexcept
+  {
+    return DefaultGlobalAllocator.expand(blk, size);
+  }
+
+  /// @brief Global realloc
+  /// @param blk The block
+  /// @param size The new size
+  /// @return True if reallocation was successful
+  inline bool global_realloc(MemBlock& blk, u64 size) noexcept
+  {
+    return DefaultGlobalAllocator.realloc(blk, size);
+  }
+
   /// @brief The default GlobalAllocatorRef used by make_*
   static constexpr GlobalAllocatorRef<
       decltype(DefaultGlobalAllocator)::alignment, &global_alloc, &global_dealloc,
-      nullptr, nullptr, nullptr>
+      nullptr, &global_expand, &global_realloc>
       GlobalAllocator;
 } // namespace clt::mem
 
@@ -168,6 +190,192 @@ namespace clt::meta
   /// @brief Reference to either a global allocator or a local allocator
   template<typename T>
   concept AllocatorRef =
-      Allocator<T> && std::same_as<bool, decltype(T::is_global_allocator_ref)>;
+      Allocator<T>
+      && std::same_as<bool, std::decay_t<decltype(T::is_global_allocator_ref)>>;
 }
+
+namespace clt::mem
+{
+  /// @brief The table of functions used by AnyAllocatorRef.
+  /// Each function takes the state of the allocator as first argument.
+  /// A table exists for each type of allocator (see 'AnyAllocatorRef').
+  struct AllocatorVTable
+  {
+    /// @brief The allocation function
+    MemBlock (*alloc)(void*, u64) noexcept;
+    /// @brief The deallocation function
+    void (*dealloc)(void*, MemBlock) noexcept;
+    /// @brief The owning function or null if not supported
+    bool (*owns)(void*, MemBlock) noexcept;
+    /// @brief The expansion function or null if not supported
+    bool (*expand)(void*, MemBlock&, u64) noexcept;
+    /// @brief The reallocation function or null if not supported
+    bool (*realloc)(void*, MemBlock&, u64) noexcept;
+  };
+
+  namespace details
+  {
+    /// @brief True if T is a (stateless) GlobalAllocatorRef
+    template<typename T>
+    inline constexpr bool is_global_allocator_v = requires {
+      requires meta::AllocatorRef<T>;
+      requires T::is_global_allocator_ref;
+    };
+
+    /// @brief Returns the allocator stored in a type-erased state.
+    /// Stateless global allocators are not stored (the state is null).
+    /// @tparam T The type of the allocator
+    /// @param state The state (never null for local allocators)
+    /// @return Reference to the allocator
+    template<meta::Allocator T>
+    T& allocator_of(void* state) noexcept
+    {
+      if constexpr (is_global_allocator_v<T>)
+      {
+        static T global;
+        return global;
+      }
+      else
+        return *static_cast<T*>(state);
+    }
+
+    /// @brief The table of functions of an allocator of type T.
+    /// As the table is a constant, a single table exists per type.
+    template<meta::Allocator T>
+    inline constexpr AllocatorVTable vtable_of = {
+        +[](void* st, u64 sz) noexcept { return allocator_of<T>(st).alloc(sz); },
+        +[](void* st, MemBlock blk) noexcept { allocator_of<T>(st).dealloc(blk); },
+        []() -> decltype(AllocatorVTable::owns)
+        {
+          if constexpr (meta::OwningAllocator<T>)
+            return +[](void* st, MemBlock blk) noexcept
+            { return allocator_of<T>(st).owns(blk); };
+          else
+            return nullptr;
+        }(),
+        []() -> decltype(AllocatorVTable::expand)
+        {
+          if constexpr (meta::ExpandingAllocator<T>)
+            return +[](void* st, MemBlock& blk, u64 sz) noexcept
+            { return allocator_of<T>(st).expand(blk, sz); };
+          else
+            return nullptr;
+        }(),
+        []() -> decltype(AllocatorVTable::realloc)
+        {
+          if constexpr (meta::ReallocatableAllocator<T>)
+            return +[](void* st, MemBlock& blk, u64 sz) noexcept
+            { return allocator_of<T>(st).realloc(blk, sz); };
+          else
+            return nullptr;
+        }(),
+    };
+  } // namespace details
+
+  /// @brief Type-erased reference to an allocator.
+  /// Contrary to GlobalAllocatorRef and LocalAllocatorRef, the type of
+  /// the allocator is not part of the type: data structures using an
+  /// AnyAllocatorRef can cross API (or DynamicLib) boundaries.
+  /// The reference is a pointer to the allocator and a pointer to a
+  /// table of functions shared by all allocators of the same type:
+  /// each operation costs a single indirect call.
+  /// As the alignment must be known at compile time, only allocators
+  /// whose alignment is at least 'alignment' can be referenced.
+  class AnyAllocatorRef
+  {
+    /// @brief The table of functions (never null)
+    const AllocatorVTable* vtable;
+    /// @brief The allocator (null for global allocators)
+    void* state;
+
+  public:
+    /// @brief Helper flag
+    static constexpr bool is_global_allocator_ref = false;
+
+    /// @brief The alignment of the allocator
+    static constexpr u64 alignment = alignof(std::max_align_t);
+
+    /// @brief Constructs a reference to the default global allocator
+    AnyAllocatorRef() noexcept
+        : AnyAllocatorRef(GlobalAllocator)
+    {
+    }
+
+    /// @brief Constructs a reference to a local allocator.
+    /// The allocator must outlive the reference.
+    /// @tparam T The type of the allocator
+    /// @param alloc The allocator
+    template<meta::Allocator T>
+      requires(!std::same_as<std::remove_cv_t<T>, AnyAllocatorRef>)
+              && (!std::is_const_v<T>) && (!details::is_global_allocator_v<T>)
+              && (T::alignment >= alignment)
+    AnyAllocatorRef(T& alloc) noexcept
+        : vtable(&details::vtable_of<T>)
+        , state(&alloc)
+    {
+    }
+
+    /// @brief Constructs a reference to a global allocator
+    /// @tparam T The type of the global allocator
+    /// @param alloc The global allocator (which is stateless)
+    template<meta::AllocatorRef T>
+      requires(details::is_global_allocator_v<T>) && (T::alignment >= alignment)
+    AnyAllocatorRef([[maybe_unused]] const T& alloc) noexcept
+        : vtable(&details::vtable_of<T>)
+        , state(nullptr)
+    {
+    }
+
+    AnyAllocatorRef(AnyAllocatorRef&&)                 = default;
+    AnyAllocatorRef& operator=(AnyAllocatorRef&&)      = default;
+    AnyAllocatorRef(const AnyAllocatorRef&)            = default;
+    AnyAllocatorRef& operator=(const AnyAllocatorRef&) = default;
+
+    /// @brief Allocates a MemBlock of size u64
+    /// @param sz The size
+    /// @return The allocated MemBlock
+    MemBlock alloc(u64 sz) const noexcept { return vtable->alloc(state, sz); }
+    /// @brief Deallocates a MemBlock
+    /// @param sz The block to deallocate
+    void dealloc(MemBlock sz) const noexcept { vtable->dealloc(state, sz); }
+
+    /// @brief Check if the referenced allocator provides 'owns'
+    /// @return True if 'owns' may be called
+    bool can_own() const noexcept { return vtable->owns != nullptr; }
+
+    /// @brief Check if a block is owned by the referenced allocator.
+    /// The referenced allocator must provide 'owns' (see 'can_own').
+    /// @param sz The block
+    /// @return True if owned by this allocator
+    bool owns(MemBlock sz) const noexcept
+    {
+      assert_true("The allocator does not provide 'owns'!", can_own());
+      return vtable->owns(state, sz);
+    }
+
+    /// @brief Expands a block, if the referenced allocator supports it
+    /// @param sz The block
+    /// @param dt The new size
+    /// @return True if expansion was done successfully
+    bool expand(MemBlock& sz, u64 dt) const noexcept
+    {
+      return vtable->expand != nullptr && vtable->expand(state, sz, dt);
+    }
+
+    /// @brief Reallocates a block, if the referenced allocator supports it
+    /// @param sz The block
+    /// @param dt The new size
+    /// @return True if reallocation was successful
+    bool realloc(MemBlock& sz, u64 dt) const noexcept
+    {
+      return vtable->realloc != nullptr && vtable->realloc(state, sz, dt);
+    }
+
+    /// @brief Check if two references refer to the same allocator
+    /// @param other The other reference
+    /// @return True if both references refer to the same allocator
+    bool operator==(const AnyAllocatorRef& other) const noexcept = default;
+  };
+} // namespace clt::mem
+
 #endif //!HG_ALLOCATOR_REF
\ No newline at end of file
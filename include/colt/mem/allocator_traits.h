@@ -63,9 +63,9 @@ namespace clt::mem
   /// @brief Represents an owning function
   using fn_owns_t = bool(*)(mem::MemBlock);
   /// @brief Represents an expansion function
-  using fn_expand_t = mem::MemBlock(*)(mem::MemBlock, u64);
+  using fn_expand_t = bool(*)(mem::MemBlock&, u64);
   /// @brief Represents a reallocation function
-  using fn_realloc_t = mem::MemBlock(*)(mem::MemBlock, u64);
+  using fn_realloc_t = bool(*)(mem::MemBlock&, u64);
 }
 
 #endif //!HG_COLT_ALLOCATOR_TRAITS
\ No newline at end of file
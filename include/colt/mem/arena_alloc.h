@@ -0,0 +1,265 @@
+/*****************************************************************/ /**
+ * @file   arena_alloc.h
+ * @brief  Contains PageAllocator, HugePageAllocator and ArenaAllocator.
+ * ArenaAllocator is a bump-pointer allocator that allocates from
+ * big chunks of memory, which are only freed all at once.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_ARENA_ALLOC
+#define HG_COLT_ARENA_ALLOC
+
+#include <new>
+#include "simple_alloc.h"
+#include "colt/num/math.h"
+#include "colt/io/mmap.h"
+
+namespace clt::mem
+{
+  template<PageOption OPTIONS>
+  /// @brief Allocator that maps (read-write) pages directly from the OS.
+  /// Allocations are rounded up to a multiple of the page size.
+  /// This allocator should be used as a backing allocator for
+  /// allocators that request big chunks of memory.
+  /// @tparam OPTIONS The options used to allocate the pages
+  struct BasicPageAllocator
+  {
+    /// @brief Alignment of returned MemBlock (smallest page size)
+    static constexpr u64 alignment = 4096;
+
+    /// @brief Allocates a MemBlock
+    /// @param size The size of the allocation
+    /// @return Allocated MemBlock or an empty MemBlock on failure
+    MemBlock alloc(u64 size) const noexcept
+    {
+      if (size == 0)
+        return nullblk;
+      const u64 page = VirtualPage::page_size().size;
+      auto blk       = VirtualPage::allocate(
+          bytes{(size + page - 1) / page * page},
+          VirtualPage::PageAccess::ReadWrite, OPTIONS);
+      return {blk.begin_, blk.size_};
+    }
+
+    /// @brief Deallocates a MemBlock that was allocated using the current allocator
+    /// @param blk The block whose resources to free
+    void dealloc(MemBlock blk) const noexcept
+    {
+      VirtualPage::deallocate(VirtualPage{blk.ptr(), blk.size()});
+    }
+  };
+
+  /// @brief Allocator that maps pages of the default size
+  using PageAllocator = BasicPageAllocator<PageOption::NoOption>;
+  /// @brief Allocator that maps pages backed by transparent huge pages
+  /// if possible (allocations are rounded to `VirtualPage::large_page_size()`)
+  using HugePageAllocator = BasicPageAllocator<PageOption::TransparentHugePages>;
+
+  template<
+      meta::Allocator Backing, u64 CHUNK_SIZE = 64 * 1024,
+      u64 ALIGN = alignof(std::max_align_t)>
+    requires(ALIGN <= Backing::alignment) && (std::has_single_bit(ALIGN))
+  /// @brief Bump-pointer allocator over chained chunks.
+  /// Memory is obtained from 'Backing' in chunks of (at least) CHUNK_SIZE
+  /// bytes: allocating only consists of incrementing a pointer.
+  /// Deallocating does nothing: the memory is only reclaimed through
+  /// 'reset', 'rewind' or on destruction. The last allocation can be
+  /// expanded in place, which allows a growing container to not move.
+  /// @tparam Backing The allocator from which to obtain the chunks
+  /// @tparam CHUNK_SIZE The minimum size of a chunk
+  /// @tparam ALIGN The alignment of returned MemBlock
+  class ArenaAllocator : private Backing
+  {
+    /// @brief Header stored at the beginning of each chunk
+    struct Chunk
+    {
+      /// @brief The previous chunk or null
+      Chunk* prev;
+      /// @brief The size of the chunk (including the header)
+      u64 size;
+    };
+
+    /// @brief The size of the header (preserving alignment)
+    static constexpr u64 HEADER_SIZE = round_to_alignment<ALIGN>(sizeof(Chunk));
+
+    static_assert(CHUNK_SIZE > HEADER_SIZE, "CHUNK_SIZE is too small!");
+
+    /// @brief The current chunk or null
+    Chunk* current = nullptr;
+    /// @brief The top of the current chunk
+    u8* top = nullptr;
+    /// @brief The end of the current chunk
+    u8* chunk_end = nullptr;
+    /// @brief The last allocation (which can be expanded) or null
+    u8* last = nullptr;
+
+    /// @brief Returns the beginning of the usable memory of a chunk
+    /// @param chunk The chunk
+    /// @return Pointer to the byte following the header
+    static u8* begin_of(Chunk* chunk) noexcept
+    {
+      return reinterpret_cast<u8*>(chunk) + HEADER_SIZE;
+    }
+
+    /// @brief Returns the end of a chunk
+    /// @param chunk The chunk
+    /// @return Pointer to the byte following the chunk
+    static u8* end_of(Chunk* chunk) noexcept
+    {
+      return reinterpret_cast<u8*>(chunk) + chunk->size;
+    }
+
+    /// @brief Allocates a new chunk and makes it the current one
+    /// @param aligned_size The aligned size that the chunk must be able to hold
+    /// @return True on success
+    bool new_chunk(u64 aligned_size) noexcept
+    {
+      auto blk = Backing::alloc(clt::max(CHUNK_SIZE, aligned_size + HEADER_SIZE));
+      if (blk.is_null())
+        return false;
+      current   = new (blk.ptr()) Chunk{current, blk.size()};
+      top       = begin_of(current);
+      chunk_end = end_of(current);
+      return true;
+    }
+
+    /// @brief Returns the current chunk to the backing allocator
+    void pop_chunk() noexcept
+    {
+      auto prev = current->prev;
+      Backing::dealloc({static_cast<void*>(current), current->size});
+      current = prev;
+    }
+
+  public:
+    constexpr ArenaAllocator() noexcept   = default;
+    ArenaAllocator(const ArenaAllocator&) = delete;
+    ArenaAllocator(ArenaAllocator&&)      = delete;
+
+    /// @brief Alignment of returned MemBlock
+    static constexpr u64 alignment = ALIGN;
+
+    /// @brief Position in the arena, obtained through 'marker'
+    struct Marker
+    {
+      /// @brief The chunk that was current
+      void* chunk;
+      /// @brief The top of that chunk
+      u8* top;
+    };
+
+    /// @brief Allocates a MemBlock
+    /// @param size The size of the allocation
+    /// @return Allocated MemBlock or an empty MemBlock on failure
+    MemBlock alloc(u64 size) noexcept
+    {
+      if (size == 0)
+        return nullblk;
+      const u64 aligned_size = round_to_alignment<ALIGN>(size);
+      if (static_cast<u64>(chunk_end - top) < aligned_size
+          && !new_chunk(aligned_size))
+        return nullblk;
+      last = top;
+      top += aligned_size;
+      return {last, size};
+    }
+
+    /// @brief Does nothing: memory is reclaimed through 'reset' and 'rewind'
+    /// @param blk The block to deallocate
+    void dealloc([[maybe_unused]] MemBlock blk) noexcept
+    {
+      assert_true("ArenaAllocator must own the block to free!", this->owns(blk));
+    }
+
+    /// @brief Check if the current allocator owns 'blk'.
+    /// This runs in linear time of the number of chunks.
+    /// @param blk The MemBlock to check
+    /// @return True if 'blk' was allocated through the current allocator
+    bool owns(MemBlock blk) const noexcept
+    {
+      if (blk.is_null())
+        return true;
+      auto ptr = static_cast<const u8*>(blk.ptr());
+      for (auto chunk = current; chunk != nullptr; chunk = chunk->prev)
+      {
+        const u8* end = chunk == current ? top : end_of(chunk);
+        if (begin_of(chunk) <= ptr && ptr < end)
+          return true;
+      }
+      return false;
+    }
+
+    /// @brief Expands a block in place if possible.
+    /// Only the last allocation can be expanded.
+    /// @param blk The block to expand
+    /// @param delta The new size
+    /// @return True if expansion was done successfully
+    bool expand(MemBlock& blk, u64 delta) noexcept
+    {
+      assert_true("ArenaAllocator must own the block to expand!", this->owns(blk));
+      if (blk.is_null())
+      {
+        blk = alloc(delta);
+        return !blk.is_null();
+      }
+      if (blk.ptr() != last || delta == 0)
+        return false;
+      const u64 aligned_size = round_to_alignment<ALIGN>(delta);
+      if (static_cast<u64>(chunk_end - last) < aligned_size)
+        return false; //not enough memory
+      top = last + aligned_size;
+      blk = MemBlock{last, delta};
+      return true;
+    }
+
+    /// @brief Returns a marker to the current position in the arena
+    /// @return Marker to pass to 'rewind'
+    Marker marker() const noexcept { return {current, top}; }
+
+    /// @brief Frees all the allocations done after 'marker' was obtained.
+    /// Chunks allocated since are returned to the backing allocator.
+    /// @param marker The marker (obtained through 'marker()')
+    void rewind(Marker marker) noexcept
+    {
+      while (current != marker.chunk)
+      {
+        assert_true("Invalid marker!", current != nullptr);
+        pop_chunk();
+      }
+      last = nullptr;
+      if (current == nullptr)
+      {
+        top = chunk_end = nullptr;
+        return;
+      }
+      assert_true(
+          "Invalid marker!",
+          begin_of(current) <= marker.top && marker.top <= end_of(current));
+      top       = marker.top;
+      chunk_end = end_of(current);
+    }
+
+    /// @brief Frees all the allocations.
+    /// The first chunk is kept to be reused by the next allocations.
+    void reset() noexcept
+    {
+      last = nullptr;
+      if (current == nullptr)
+        return;
+      while (current->prev != nullptr)
+        pop_chunk();
+      top       = begin_of(current);
+      chunk_end = end_of(current);
+    }
+
+    /// @brief Returns all the chunks to the backing allocator
+    ~ArenaAllocator() noexcept
+    {
+      while (current != nullptr)
+        pop_chunk();
+    }
+  };
+} // namespace clt::mem
+
+#endif // !HG_COLT_ARENA_ALLOC
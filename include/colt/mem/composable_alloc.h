@@ -700,6 +700,407 @@ namespace clt::mem
     }
   };
 
+  /// @brief The statistics collected by a StatsAllocator
+  enum class StatsFlag : u8
+  {
+    /// @brief No statistics
+    NONE = 0,
+    /// @brief The count of calls to 'alloc' and 'dealloc'
+    CALLS = 1,
+    /// @brief The live, peak and total allocated bytes
+    BYTES = 2,
+    /// @brief The histogram of the allocation sizes
+    HISTOGRAM = 4,
+    /// @brief The count of calls (and successes) of 'expand' and 'realloc'
+    RESIZE = 8,
+    /// @brief The count of allocations of each call site
+    CALL_SITES = 16,
+    /// @brief All the statistics
+    ALL = CALLS | BYTES | HISTOGRAM | RESIZE | CALL_SITES,
+  };
+
+  /// @brief Combines two StatsFlag
+  /// @param a The first flag
+  /// @param b The second flag
+  /// @return a | b
+  constexpr StatsFlag operator|(StatsFlag a, StatsFlag b) noexcept
+  {
+    return static_cast<StatsFlag>(static_cast<u8>(a) | static_cast<u8>(b));
+  }
+
+  /// @brief Check if a flag is enabled
+  /// @param flags The flags
+  /// @param flag The flag to check for
+  /// @return True if 'flag' is part of 'flags'
+  constexpr bool is_enabled(StatsFlag flags, StatsFlag flag) noexcept
+  {
+    return (static_cast<u8>(flags) & static_cast<u8>(flag)) != 0;
+  }
+
+  /// @brief Snapshot of the statistics of a StatsAllocator.
+  /// Only the statistics enabled by 'flags' are meaningful.
+  struct AllocatorStats
+  {
+    /// @brief The count of buckets of the histogram
+    static constexpr size_t HISTOGRAM_SIZE = 16;
+    /// @brief The maximum count of tracked call sites
+    static constexpr size_t CALL_SITE_COUNT = 16;
+
+    /// @brief The count of allocations of a call site
+    struct CallSite
+    {
+      /// @brief The file name or null if the entry is empty
+      const char* file = nullptr;
+      /// @brief The line number
+      u32 line = 0;
+      /// @brief The count of allocations
+      u64 count = 0;
+      /// @brief The count of allocated bytes
+      u64 bytes = 0;
+    };
+
+    /// @brief The statistics that were collected
+    StatsFlag flags = StatsFlag::NONE;
+    /// @brief The count of calls to 'alloc'
+    u64 alloc_count = 0;
+    /// @brief The count of calls to 'alloc' that returned 'nullblk'
+    u64 failed_alloc_count = 0;
+    /// @brief The count of calls to 'dealloc'
+    u64 dealloc_count = 0;
+    /// @brief The count of bytes currently allocated
+    u64 live_bytes = 0;
+    /// @brief The maximum value of 'live_bytes'
+    u64 peak_bytes = 0;
+    /// @brief The count of bytes ever allocated
+    u64 total_bytes = 0;
+    /// @brief The count of calls to 'expand'
+    u64 expand_count = 0;
+    /// @brief The count of calls to 'expand' that succeeded
+    u64 expand_success = 0;
+    /// @brief The count of calls to 'realloc'
+    u64 realloc_count = 0;
+    /// @brief The count of calls to 'realloc' that succeeded
+    u64 realloc_success = 0;
+    /// @brief The count of allocations in each bucket (see 'bucket_of')
+    u64 histogram[HISTOGRAM_SIZE] = {};
+    /// @brief The allocations of each call site
+    CallSite call_sites[CALL_SITE_COUNT] = {};
+    /// @brief The count of allocations whose call site could not be tracked
+    u64 untracked_call_sites = 0;
+
+    /// @brief Returns the bucket of the histogram of an allocation size.
+    /// The bucket 0 contains the sizes <= 16, the bucket N > 0 the sizes
+    /// in (16 << (N - 1), 16 << N], and the last one all the bigger sizes.
+    /// @param size The size of the allocation
+    /// @return The index of the bucket
+    static constexpr size_t bucket_of(u64 size) noexcept
+    {
+      if (size <= 16)
+        return 0;
+      return clt::min<size_t>(std::bit_width(size - 1) - 4, HISTOGRAM_SIZE - 1);
+    }
+
+    /// @brief Returns the greatest size of a bucket (except the last one)
+    /// @param index The index of the bucket
+    /// @return The greatest size contained in the bucket
+    static constexpr u64 bucket_upper(size_t index) noexcept
+    {
+      return u64{16} << index;
+    }
+  };
+
+  template<meta::Allocator allocator, StatsFlag FLAGS = StatsFlag::ALL>
+  /// @brief Allocator that collects statistics about the calls to its allocator.
+  /// This helps to find which allocator of a composed stack serves requests.
+  /// Each statistic of FLAGS is a relaxed atomic counter: the statistics
+  /// that are not enabled are compiled out.
+  /// The call sites are captured through a defaulted 'source_location'
+  /// parameter of 'alloc': allocations done through a LocalAllocatorRef
+  /// are thus attributed to the reference.
+  class StatsAllocator : private allocator
+  {
+    /// @brief Counter
+    using counter_t = std::atomic<u64>;
+
+    /// @brief The counters of CALLS
+    struct Calls
+    {
+      counter_t alloc_count   = 0;
+      counter_t failed_count  = 0;
+      counter_t dealloc_count = 0;
+    };
+
+    /// @brief The counters of BYTES
+    struct Bytes
+    {
+      counter_t live  = 0;
+      counter_t peak  = 0;
+      counter_t total = 0;
+    };
+
+    /// @brief The counters of HISTOGRAM
+    struct Histogram
+    {
+      counter_t buckets[AllocatorStats::HISTOGRAM_SIZE] = {};
+    };
+
+    /// @brief The counters of RESIZE
+    struct Resize
+    {
+      counter_t expand_count    = 0;
+      counter_t expand_success  = 0;
+      counter_t realloc_count   = 0;
+      counter_t realloc_success = 0;
+    };
+
+    /// @brief A call site (identified by its key)
+    struct CallSite
+    {
+      /// @brief The key of the call site or 0 if empty
+      counter_t key = 0;
+      /// @brief The file name
+      std::atomic<const char*> file = nullptr;
+      /// @brief The line number
+      std::atomic<u32> line = 0;
+      /// @brief The count of allocations
+      counter_t count = 0;
+      /// @brief The count of allocated bytes
+      counter_t bytes = 0;
+    };
+
+    /// @brief The counters of CALL_SITES (open addressing table)
+    struct CallSites
+    {
+      /// @brief The call sites
+      CallSite sites[AllocatorStats::CALL_SITE_COUNT] = {};
+      /// @brief The count of allocations that could not be tracked
+      counter_t untracked = 0;
+    };
+
+    /// @brief T if FLAG is enabled, else an empty type
+    template<StatsFlag FLAG, typename T>
+    using counters_t =
+        std::conditional_t<is_enabled(FLAGS, FLAG), T, meta::empty_t<T>>;
+
+    /// @brief The enabled counters
+    [[no_unique_address]] counters_t<StatsFlag::CALLS, Calls> calls{};
+    [[no_unique_address]] counters_t<StatsFlag::BYTES, Bytes> memory{};
+    [[no_unique_address]] counters_t<StatsFlag::HISTOGRAM, Histogram> histogram{};
+    [[no_unique_address]] counters_t<StatsFlag::RESIZE, Resize> resize{};
+    [[no_unique_address]] counters_t<StatsFlag::CALL_SITES, CallSites> sites{};
+
+    /// @brief Increments a counter
+    /// @param counter The counter
+    /// @param value The value to add
+    static void add(counter_t& counter, u64 value = 1) noexcept
+    {
+      counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /// @brief Adds to the live bytes, updating the peak
+    /// @param size The count of bytes to add
+    void add_live(u64 size) noexcept
+    {
+      auto live = memory.live.fetch_add(size, std::memory_order_relaxed) + size;
+      auto peak = memory.peak.load(std::memory_order_relaxed);
+      while (peak < live
+             && !memory.peak.compare_exchange_weak(
+                 peak, live, std::memory_order_relaxed))
+        ;
+    }
+
+    /// @brief Registers a new block
+    /// @param blk The allocated block
+    void on_alloc(MemBlock blk) noexcept
+    {
+      if constexpr (is_enabled(FLAGS, StatsFlag::BYTES))
+      {
+        add(memory.total, blk.size());
+        add_live(blk.size());
+      }
+      if constexpr (is_enabled(FLAGS, StatsFlag::HISTOGRAM))
+        add(histogram.buckets[AllocatorStats::bucket_of(blk.size())]);
+    }
+
+    /// @brief Registers a block whose size changed
+    /// @param old_size The old size of the block
+    /// @param new_size The new size of the block
+    void on_resize(u64 old_size, u64 new_size) noexcept
+    {
+      if constexpr (is_enabled(FLAGS, StatsFlag::BYTES))
+      {
+        if (new_size > old_size)
+        {
+          add(memory.total, new_size - old_size);
+          add_live(new_size - old_size);
+        }
+        else
+          memory.live.fetch_sub(old_size - new_size, std::memory_order_relaxed);
+      }
+    }
+
+    /// @brief Registers the allocation of a call site
+    /// @param src The call site
+    /// @param size The size of the allocation
+    void on_call_site(const source_location& src, u64 size) noexcept
+    {
+      // 0 represents an empty entry: the highest bit is always set
+      const u64 key =
+          (reinterpret_cast<uintptr_t>(src.file_name()) * 0x9E3779B97F4A7C15ULL
+           ^ src.line())
+          | (u64{1} << 63);
+      constexpr size_t COUNT = AllocatorStats::CALL_SITE_COUNT;
+      for (size_t i = 0; i != COUNT; ++i)
+      {
+        auto& site    = sites.sites[(key + i) % COUNT];
+        u64 site_key  = site.key.load(std::memory_order_relaxed);
+        if (site_key == 0
+            && site.key.compare_exchange_strong(
+                site_key, key, std::memory_order_relaxed))
+        {
+          site.file.store(src.file_name(), std::memory_order_relaxed);
+          site.line.store(src.line(), std::memory_order_relaxed);
+          site_key = key;
+        }
+        if (site_key == key)
+        {
+          add(site.count);
+          add(site.bytes, size);
+          return;
+        }
+      }
+      add(sites.untracked);
+    }
+
+  public:
+    /// @brief Alignment of returned MemBlock
+    static constexpr u64 alignment = allocator::alignment;
+
+    /// @brief Allocates a MemBlock
+    /// @param size The size of the allocation
+    /// @param src The call site (captured if CALL_SITES is enabled)
+    /// @return Allocated MemBlock or empty MemBlock
+    MemBlock alloc(
+        u64 size, source_location src = source_location::current()) noexcept
+    {
+      auto blk = allocator::alloc(size);
+      if constexpr (is_enabled(FLAGS, StatsFlag::CALLS))
+      {
+        add(calls.alloc_count);
+        if (blk.is_null())
+          add(calls.failed_count);
+      }
+      if constexpr (is_enabled(FLAGS, StatsFlag::CALL_SITES))
+        on_call_site(src, size);
+      if (!blk.is_null())
+        on_alloc(blk);
+      return blk;
+    }
+
+    /// @brief Deallocates a MemBlock that was allocated using the current allocator
+    /// @param to_free The block whose resources to free
+    void dealloc(MemBlock to_free) noexcept
+    {
+      if constexpr (is_enabled(FLAGS, StatsFlag::CALLS))
+        add(calls.dealloc_count);
+      if constexpr (is_enabled(FLAGS, StatsFlag::BYTES))
+        memory.live.fetch_sub(to_free.size(), std::memory_order_relaxed);
+      allocator::dealloc(to_free);
+    }
+
+    /// @brief Check if the current allocator owns 'blk'
+    /// @param blk The MemBlock to check
+    /// @return True if 'blk' was allocated through the current allocator
+    bool owns(MemBlock blk) const noexcept
+      requires meta::OwningAllocator<allocator>
+    {
+      return allocator::owns(blk);
+    }
+
+    /// @brief Reallocates a MemBlock
+    /// @param blk The block to reallocate
+    /// @param n The new size of the block
+    /// @return True if reallocation was successful
+    bool realloc(MemBlock& blk, u64 n) noexcept
+      requires meta::ReallocatableAllocator<allocator>
+    {
+      const u64 old_size = blk.size();
+      const bool success = allocator::realloc(blk, n);
+      if constexpr (is_enabled(FLAGS, StatsFlag::RESIZE))
+      {
+        add(resize.realloc_count);
+        add(resize.realloc_success, success);
+      }
+      if (success)
+        on_resize(old_size, blk.size());
+      return success;
+    }
+
+    /// @brief Expands a block in place if possible
+    /// @param blk The block to expand
+    /// @param delta The new size
+    /// @return True if expansion was done successfully
+    bool expand(MemBlock& blk, u64 delta) noexcept
+      requires meta::ExpandingAllocator<allocator>
+    {
+      const u64 old_size = blk.size();
+      const bool success = allocator::expand(blk, delta);
+      if constexpr (is_enabled(FLAGS, StatsFlag::RESIZE))
+      {
+        add(resize.expand_count);
+        add(resize.expand_success, success);
+      }
+      if (success)
+        on_resize(old_size, blk.size());
+      return success;
+    }
+
+    /// @brief Returns a snapshot of the statistics
+    /// @return The statistics (only the ones of FLAGS are meaningful)
+    AllocatorStats stats() const noexcept
+    {
+      constexpr auto relaxed = std::memory_order_relaxed;
+      AllocatorStats ret;
+      ret.flags = FLAGS;
+      if constexpr (is_enabled(FLAGS, StatsFlag::CALLS))
+      {
+        ret.alloc_count        = calls.alloc_count.load(relaxed);
+        ret.failed_alloc_count = calls.failed_count.load(relaxed);
+        ret.dealloc_count      = calls.dealloc_count.load(relaxed);
+      }
+      if constexpr (is_enabled(FLAGS, StatsFlag::BYTES))
+      {
+        ret.live_bytes  = memory.live.load(relaxed);
+        ret.peak_bytes  = memory.peak.load(relaxed);
+        ret.total_bytes = memory.total.load(relaxed);
+      }
+      if constexpr (is_enabled(FLAGS, StatsFlag::HISTOGRAM))
+      {
+        for (size_t i = 0; i != AllocatorStats::HISTOGRAM_SIZE; ++i)
+          ret.histogram[i] = histogram.buckets[i].load(relaxed);
+      }
+      if constexpr (is_enabled(FLAGS, StatsFlag::RESIZE))
+      {
+        ret.expand_count    = resize.expand_count.load(relaxed);
+        ret.expand_success  = resize.expand_success.load(relaxed);
+        ret.realloc_count   = resize.realloc_count.load(relaxed);
+        ret.realloc_success = resize.realloc_success.load(relaxed);
+      }
+      if constexpr (is_enabled(FLAGS, StatsFlag::CALL_SITES))
+      {
+        for (size_t i = 0; i != AllocatorStats::CALL_SITE_COUNT; ++i)
+        {
+          auto& site = sites.sites[i];
+          ret.call_sites[i] = {
+              site.file.load(relaxed), site.line.load(relaxed),
+              site.count.load(relaxed), site.bytes.load(relaxed)};
+        }
+        ret.untracked_call_sites = sites.untracked.load(relaxed);
+      }
+      return ret;
+    }
+  };
+
   template<meta::Allocator allocator>
   /// @brief Thread safe allocator
   class ThreadSafeAllocator : private allocator
@@ -769,6 +1170,393 @@ namespace clt::mem
       return allocator::expand(blk, delta);
     }
   };
+
+  template<
+      meta::Allocator allocator, u64 LOWER, u64 UPPER, u64 STEP = 16,
+      size_t MAGAZINE_SIZE = 32>
+    requires(LOWER >= sizeof(void*)) && (UPPER >= LOWER) && (MAGAZINE_SIZE >= 2)
+            && (std::has_single_bit(STEP)) && ((UPPER - LOWER) % STEP == 0)
+  /// @brief Thread safe allocator that keeps a cache of blocks per thread.
+  /// The range [LOWER, UPPER] is split in size classes of STEP bytes (as for
+  /// SegregatedFreeList), and each thread owns a magazine per size class:
+  /// a block allocated and deallocated by the same thread never requires
+  /// synchronization. A block deallocated by another thread is pushed
+  /// (lock-free) to the return queue of the thread that owns it, which
+  /// takes it back when its magazine is empty.
+  /// Magazines are refilled from and flushed to 'allocator' in batches
+  /// of MAGAZINE_SIZE / 2 blocks: only then is a mutex locked.
+  /// Sizes out of range are forwarded to 'allocator' under that mutex.
+  /// The state of this allocator is shared by all of its instances.
+  class ThreadCachingAllocator
+  {
+    /// @brief A Node contains a pointer to the next Node
+    struct Node
+    {
+      Node* next;
+    };
+
+    /// @brief The count of size classes
+    static constexpr size_t CLASS_COUNT = (UPPER - LOWER) / STEP + 1;
+    /// @brief The count of blocks allocated or freed at once
+    static constexpr size_t BATCH_SIZE = MAGAZINE_SIZE / 2;
+
+    struct Cache;
+
+    /// @brief Header preceding each block of the range
+    struct Header
+    {
+      /// @brief The cache that owns the block
+      Cache* owner;
+      /// @brief The size class of the block
+      size_t index;
+    };
+
+    /// @brief The aligned size of the header
+    static constexpr u64 HEADER_SIZE =
+        round_to_alignment<allocator::alignment>(sizeof(Header));
+
+    /// @brief The cache of a thread
+    struct Cache
+    {
+      /// @brief The magazine of each size class
+      Node* magazines[CLASS_COUNT] = {};
+      /// @brief The count of blocks in each magazine
+      u32 counts[CLASS_COUNT] = {};
+      /// @brief The blocks freed by other threads (MPSC stack)
+      std::atomic<Node*> returned = nullptr;
+      /// @brief The next cache of the registry
+      Cache* next = nullptr;
+      /// @brief True if a thread is using the cache
+      bool in_use = true;
+    };
+
+    /// @brief The state shared by all threads
+    struct Registry : public allocator
+    {
+      /// @brief Protects the allocator and the list of caches
+      std::mutex mtx{};
+      /// @brief All the caches ever created
+      Cache* caches = nullptr;
+
+      /// @brief Returns all the blocks and caches to the allocator
+      ~Registry() noexcept
+      {
+        while (caches != nullptr)
+        {
+          auto next = caches->next;
+          release(caches);
+          caches->~Cache();
+          allocator::dealloc({static_cast<void*>(caches), sizeof(Cache)});
+          caches = next;
+        }
+      }
+    };
+
+    /// @brief The cache used by the current thread
+    struct LocalCache
+    {
+      /// @brief The cache or null if not yet acquired
+      Cache* cache = nullptr;
+
+      /// @brief Releases the cache so that it can be reused by another thread
+      ~LocalCache() noexcept
+      {
+        if (cache == nullptr)
+          return;
+        auto lock = std::scoped_lock(registry.mtx);
+        release(cache);
+        cache->in_use = false;
+      }
+    };
+
+    /// @brief The shared state
+    static inline Registry registry{};
+    /// @brief The cache of the current thread
+    static inline thread_local LocalCache local{};
+
+    /// @brief Check if a size is in range
+    /// @param n The size to check
+    /// @return True if LOWER <= n && n <= UPPER
+    static constexpr bool is_in_range(size_t n) noexcept
+    {
+      return LOWER <= n && n <= UPPER;
+    }
+
+    /// @brief Returns the size class of a size in range
+    /// @param n The size (in range)
+    /// @return The index of the size class
+    static constexpr size_t class_of(size_t n) noexcept
+    {
+      return (n - LOWER + STEP - 1) >> std::countr_zero(STEP);
+    }
+
+    /// @brief Returns the size of the blocks of a size class
+    /// @param index The index of the size class
+    /// @return The size of the blocks
+    static constexpr u64 size_of(size_t index) noexcept
+    {
+      return LOWER + index * STEP;
+    }
+
+    /// @brief Returns the header of a block of the range
+    /// @param ptr The pointer to the block
+    /// @return The header of the block
+    static Header* header_of(void* ptr) noexcept
+    {
+      return reinterpret_cast<Header*>(static_cast<u8*>(ptr) - HEADER_SIZE);
+    }
+
+    /// @brief Pushes a block to a magazine
+    /// @param cache The cache that owns the block
+    /// @param index The size class of the block
+    /// @param ptr The block
+    static void push(Cache* cache, size_t index, void* ptr) noexcept
+    {
+      cache->magazines[index] = new (ptr) Node{cache->magazines[index]};
+      ++cache->counts[index];
+    }
+
+    /// @brief Pops a block from a magazine that is not empty
+    /// @param cache The cache
+    /// @param index The size class of the block
+    /// @return The block
+    static Node* pop(Cache* cache, size_t index) noexcept
+    {
+      auto node               = cache->magazines[index];
+      cache->magazines[index] = node->next;
+      --cache->counts[index];
+      return node;
+    }
+
+    /// @brief Moves the blocks freed by other threads to the magazines
+    /// @param cache The cache
+    static void drain(Cache* cache) noexcept
+    {
+      auto node = cache->returned.exchange(nullptr, std::memory_order_acquire);
+      while (node != nullptr)
+      {
+        auto next = node->next;
+        push(cache, header_of(node)->index, node);
+        node = next;
+      }
+    }
+
+    /// @brief Returns the blocks of a magazine to the allocator.
+    /// The mutex must be locked.
+    /// @param cache The cache
+    /// @param index The size class
+    /// @param keep The count of blocks to keep in the magazine
+    static void flush(Cache* cache, size_t index, size_t keep) noexcept
+    {
+      while (cache->counts[index] > keep)
+      {
+        auto header = header_of(pop(cache, index));
+        registry.dealloc({static_cast<void*>(header), HEADER_SIZE + size_of(index)});
+      }
+    }
+
+    /// @brief Returns all the blocks of a cache to the allocator.
+    /// The mutex must be locked.
+    /// @param cache The cache
+    static void release(Cache* cache) noexcept
+    {
+      drain(cache);
+      for (size_t i = 0; i != CLASS_COUNT; ++i)
+        flush(cache, i, 0);
+    }
+
+    /// @brief Allocates a batch of blocks in a magazine
+    /// @param cache The cache
+    /// @param index The size class
+    /// @return True if at least a block was allocated
+    static bool refill(Cache* cache, size_t index) noexcept
+    {
+      auto lock = std::scoped_lock(registry.mtx);
+      for (size_t i = 0; i != BATCH_SIZE; ++i)
+      {
+        auto blk = registry.alloc(HEADER_SIZE + size_of(index));
+        if (blk.is_null())
+          break;
+        new (blk.ptr()) Header{cache, index};
+        push(cache, index, static_cast<u8*>(blk.ptr()) + HEADER_SIZE);
+      }
+      return cache->counts[index] != 0;
+    }
+
+    /// @brief Returns the cache of the current thread, acquiring one if needed
+    /// @return The cache or null on failure
+    static Cache* local_cache() noexcept
+    {
+      if (local.cache != nullptr)
+        return local.cache;
+      auto lock = std::scoped_lock(registry.mtx);
+      // reuse the cache of a thread that exited
+      for (auto cache = registry.caches; cache != nullptr; cache = cache->next)
+      {
+        if (!cache->in_use)
+        {
+          cache->in_use = true;
+          return local.cache = cache;
+        }
+      }
+      auto blk = registry.alloc(sizeof(Cache));
+      if (blk.is_null())
+        return nullptr;
+      auto cache      = new (blk.ptr()) Cache{};
+      cache->next     = registry.caches;
+      registry.caches = cache;
+      return local.cache = cache;
+    }
+
+  public:
+    /// @brief Alignment of returned MemBlock
+    static constexpr u64 alignment = allocator::alignment;
+
+    /// @brief Allocates a MemBlock.
+    /// Sizes in range are rounded up to their size class.
+    /// @param size The size of the allocation
+    /// @return Allocated MemBlock or an empty MemBlock on failure
+    MemBlock alloc(u64 size) noexcept
+    {
+      if (!is_in_range(size))
+      {
+        auto lock = std::scoped_lock(registry.mtx);
+        return registry.alloc(size);
+      }
+      auto cache = local_cache();
+      if (cache == nullptr)
+        return nullblk;
+      const size_t index = class_of(size);
+      if (cache->magazines[index] == nullptr)
+      {
+        drain(cache);
+        if (cache->magazines[index] == nullptr && !refill(cache, index))
+          return nullblk;
+      }
+      return {pop(cache, index), size_of(index)};
+    }
+
+    /// @brief Deallocates a MemBlock that was allocated using the current allocator.
+    /// The block may be deallocated by any thread.
+    /// @param blk The block whose resources to free
+    void dealloc(MemBlock blk) noexcept
+    {
+      //'nullblk' is not in range: it is forwarded to the allocator
+      if (!is_in_range(blk.size()))
+      {
+        auto lock = std::scoped_lock(registry.mtx);
+        registry.dealloc(blk);
+        return;
+      }
+      auto header = header_of(blk.ptr());
+      auto owner  = header->owner;
+      if (owner == local.cache)
+      {
+        push(owner, header->index, blk.ptr());
+        if (owner->counts[header->index] > MAGAZINE_SIZE)
+        {
+          auto lock = std::scoped_lock(registry.mtx);
+          flush(owner, header->index, BATCH_SIZE);
+        }
+        return;
+      }
+      // Return the block to the thread that owns it
+      auto node = static_cast<Node*>(blk.ptr());
+      auto head = owner->returned.load(std::memory_order_relaxed);
+      do
+        node->next = head;
+      while (!owner->returned.compare_exchange_weak(
+          head, node, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    /// @brief Expands a block in place if possible.
+    /// A block in range can grow up to the size of its class.
+    /// @param blk The block to expand
+    /// @param delta The new size
+    /// @return True if expansion was done successfully
+    bool expand(MemBlock& blk, u64 delta) noexcept
+    {
+      if (!is_in_range(blk.size()))
+      {
+        if constexpr (meta::ExpandingAllocator<allocator>)
+        {
+          if (is_in_range(delta))
+            return false;
+          auto lock = std::scoped_lock(registry.mtx);
+          return registry.expand(blk, delta);
+        }
+        else
+          return false;
+      }
+      if (!is_in_range(delta) || size_of(header_of(blk.ptr())->index) < delta)
+        return false;
+      blk = MemBlock{blk.ptr(), delta};
+      return true;
+    }
+  };
 } // namespace clt::mem
 
+template<>
+struct fmt::formatter<clt::mem::AllocatorStats>
+{
+  template<typename ParseContext>
+  constexpr auto parse(ParseContext& ctx)
+  {
+    return ctx.begin();
+  }
+
+  template<typename FormatContext>
+  auto format(const clt::mem::AllocatorStats& stats, FormatContext& ctx) const
+  {
+    using namespace clt;
+    using enum mem::StatsFlag;
+    using Stats = mem::AllocatorStats;
+
+    auto fmt_to = ctx.out();
+    if (mem::is_enabled(stats.flags, CALLS))
+      fmt_to = fmt::format_to(
+          fmt_to, "calls: {} alloc ({} failed), {} dealloc\n", stats.alloc_count,
+          stats.failed_alloc_count, stats.dealloc_count);
+    if (mem::is_enabled(stats.flags, BYTES))
+      fmt_to = fmt::format_to(
+          fmt_to, "bytes: {} live, {} peak, {} total\n", stats.live_bytes,
+          stats.peak_bytes, stats.total_bytes);
+    if (mem::is_enabled(stats.flags, RESIZE))
+      fmt_to = fmt::format_to(
+          fmt_to, "resize: {}/{} expand, {}/{} realloc\n", stats.expand_success,
+          stats.expand_count, stats.realloc_success, stats.realloc_count);
+    if (mem::is_enabled(stats.flags, HISTOGRAM))
+    {
+      fmt_to = fmt::format_to(fmt_to, "histogram:\n");
+      for (size_t i = 0; i != Stats::HISTOGRAM_SIZE; ++i)
+      {
+        if (stats.histogram[i] == 0)
+          continue;
+        if (i == Stats::HISTOGRAM_SIZE - 1)
+          fmt_to = fmt::format_to(
+              fmt_to, "  > {}: {}\n", Stats::bucket_upper(i - 1),
+              stats.histogram[i]);
+        else
+          fmt_to = fmt::format_to(
+              fmt_to, "  <= {}: {}\n", Stats::bucket_upper(i), stats.histogram[i]);
+      }
+    }
+    if (mem::is_enabled(stats.flags, CALL_SITES))
+    {
+      fmt_to = fmt::format_to(fmt_to, "call sites:\n");
+      for (const auto& site : stats.call_sites)
+      {
+        if (site.file != nullptr)
+          fmt_to = fmt::format_to(
+              fmt_to, "  {}:{}: {} alloc ({} bytes)\n", site.file, site.line,
+              site.count, site.bytes);
+      }
+      if (stats.untracked_call_sites != 0)
+        fmt_to = fmt::format_to(
+            fmt_to, "  untracked: {} alloc\n", stats.untracked_call_sites);
+    }
+    return fmt_to;
+  }
+};
+
 #endif //!HG_COLT_COMPOSABLE_ALLOC
\ No newline at end of file
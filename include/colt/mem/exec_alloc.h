@@ -0,0 +1,322 @@
+/*****************************************************************/ /**
+ * @file   exec_alloc.h
+ * @brief  Contains ExecutableArena.
+ * ExecutableArena is a bump-pointer allocator of executable memory,
+ * for just-in-time compilers. It never has pages that are both writable
+ * and executable (W^X), and batches the protection changes and
+ * instruction cache flushes of all the code written since the last
+ * 'finalize' (rather than doing them per function).
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_EXEC_ALLOC
+#define HG_COLT_EXEC_ALLOC
+
+#include <new>
+#include "simple_alloc.h"
+#include "colt/num/math.h"
+#include "colt/io/mmap.h"
+
+namespace clt::mem
+{
+  /// @brief The strategy used by an ExecutableArena to never have pages
+  /// that are both writable and executable
+  enum class CodeMapping : u8
+  {
+    /// @brief Pages are switched from ReadWrite to ReadExecute
+    Toggle,
+    /// @brief Pages are mapped twice, as ReadWrite and ReadExecute
+    DualMapped,
+  };
+
+  template<u64 REGION_SIZE = 1024 * 1024, u64 ALIGN = 16>
+    requires(std::has_single_bit(ALIGN)) && (ALIGN <= 4096)
+  /// @brief Bump-pointer allocator of code over chained regions of pages.
+  /// Blocks are returned writable: once the code is written, 'finalize'
+  /// makes all the code written since the last call executable.
+  /// Two strategies are available:
+  /// - DualMapped: each region is mapped twice (see `VirtualPage::allocate_dual`).
+  ///   Code is written through the writable view and executed through the
+  ///   executable view: 'finalize' only flushes the instruction cache.
+  /// - Toggle: pages are ReadWrite until 'finalize' makes them ReadExecute
+  ///   (in a single protection change per region). As a page can't be
+  ///   both, allocations following a 'finalize' begin on a new page.
+  /// If dual mapping is not supported, the arena falls back to Toggle.
+  /// Deallocating does nothing: the memory is only reclaimed through
+  /// 'reset' or on destruction. It is not thread safe.
+  /// @code{.cpp}
+  /// ExecutableArena<> arena;
+  /// auto code = arena.alloc_code(size);
+  /// emit_function(code.writable);
+  /// arena.finalize();
+  /// reinterpret_cast<int (*)()>(code.executable)();
+  /// @endcode
+  /// @tparam REGION_SIZE The minimum size of a region
+  /// @tparam ALIGN The alignment of returned MemBlock
+  class ExecutableArena
+  {
+  public:
+    using enum CodeMapping;
+
+    /// @brief A block of code
+    struct CodeBlock
+    {
+      /// @brief The block through which to write the code
+      MemBlock writable;
+      /// @brief The address at which the code executes (after 'finalize')
+      const void* executable;
+    };
+
+  private:
+    /// @brief Header stored at the beginning of each region.
+    /// The header is never executable: it is the only content of the
+    /// first page of the region, which is never made executable in Toggle
+    /// mode, and is not accessible through the executable view in
+    /// DualMapped mode.
+    struct Region
+    {
+      /// @brief The previous region or null
+      Region* prev;
+      /// @brief The beginning of the region in the executable view
+      u8* exec;
+      /// @brief The size of the region (including the header)
+      size_t size;
+      /// @brief The offset of the first byte that is not finalized
+      size_t sealed;
+      /// @brief The offset of the first free byte (for previous regions)
+      size_t used;
+    };
+
+    /// @brief The current region (or null)
+    Region* current = nullptr;
+    /// @brief The offset of the first free byte of the current region
+    size_t top = 0;
+    /// @brief The count of protection changes done by 'finalize'
+    size_t protect_count = 0;
+    /// @brief The mapping used for the regions
+    CodeMapping mapping;
+
+    /// @brief Returns the size of the header of the regions (a page)
+    /// @return The size of the header of the regions
+    static size_t header_size() noexcept { return VirtualPage::page_size().size; }
+
+    /// @brief Returns the beginning of a region in the writable view
+    /// @param region The region
+    /// @return The beginning of the region
+    static u8* begin_of(Region* region) noexcept
+    {
+      return reinterpret_cast<u8*>(region);
+    }
+
+    /// @brief Unmaps a region
+    /// @param region The region to unmap
+    void unmap(Region* region) const noexcept
+    {
+      const VirtualPage writable = {begin_of(region), region->size};
+      if (mapping == Toggle)
+        VirtualPage::deallocate(writable);
+      else
+        VirtualPage::deallocate_dual({writable, {region->exec, region->size}});
+    }
+
+    /// @brief Maps a new region and makes it the current one
+    /// @param aligned_size The aligned size that the region must be able to hold
+    /// @return True on success
+    bool new_region(u64 aligned_size) noexcept
+    {
+      const size_t page = VirtualPage::page_size().size;
+      auto size_of      = [&]() -> size_t
+      {
+        const size_t size = clt::max(REGION_SIZE, header_size() + aligned_size);
+        return (size + page - 1) / page * page;
+      };
+      u8* write   = nullptr;
+      u8* exec    = nullptr;
+      size_t size = size_of();
+      if (mapping == DualMapped)
+      {
+        auto dual = VirtualPage::allocate_dual(bytes{size});
+        if (!dual.is_null())
+        {
+          write = static_cast<u8*>(dual.writable.ptr());
+          exec  = static_cast<u8*>(dual.executable.ptr());
+          // The header must not be executable through the executable view
+          if (!VirtualPage::protect(
+                  exec, bytes{page}, VirtualPage::PageAccess::None))
+          {
+            VirtualPage::deallocate_dual(dual);
+            return false;
+          }
+        }
+        else if (current != nullptr)
+          return false;
+        else
+        {
+          // Dual mapping is not supported: all the regions are toggled
+          mapping = Toggle;
+          size    = size_of();
+        }
+      }
+      if (mapping == Toggle)
+      {
+        auto pages = VirtualPage::allocate(
+            bytes{size}, VirtualPage::PageAccess::ReadWrite);
+        if (pages.is_null())
+          return false;
+        write = exec = static_cast<u8*>(pages.ptr());
+      }
+      if (current != nullptr)
+        current->used = top;
+      top     = header_size();
+      current = new (write) Region{current, exec, size, top, top};
+      return true;
+    }
+
+    /// @brief Makes the code of a region executable
+    /// @param region The region (whose 'used' is up to date)
+    /// @return True on success
+    bool seal(Region* region) noexcept
+    {
+      const size_t sealed = region->sealed;
+      const size_t used   = region->used;
+      if (mapping == Toggle)
+      {
+        // 'sealed' is always a multiple of the page size
+        const size_t page = VirtualPage::page_size().size;
+        const size_t end  = (used + page - 1) / page * page;
+        ++protect_count;
+        if (!VirtualPage::protect(
+                begin_of(region) + sealed, bytes{end - sealed},
+                VirtualPage::PageAccess::ReadExecute))
+          return false;
+        region->used = end;
+      }
+      VirtualPage::flush_icache(region->exec + sealed, used - sealed);
+      region->sealed = region->used;
+      return true;
+    }
+
+  public:
+    /// @brief Constructor, does not map any page
+    /// @param mapping The preferred mapping (DualMapped falls back to Toggle)
+    explicit constexpr ExecutableArena(CodeMapping mapping = DualMapped) noexcept
+        : mapping(mapping)
+    {
+    }
+    ExecutableArena(const ExecutableArena&) = delete;
+    ExecutableArena(ExecutableArena&&)      = delete;
+
+    /// @brief Alignment of returned MemBlock
+    static constexpr u64 alignment = ALIGN;
+
+    /// @brief Allocates a writable MemBlock of code
+    /// @param size The size of the allocation
+    /// @return Allocated MemBlock or an empty MemBlock on failure
+    MemBlock alloc(u64 size) noexcept
+    {
+      if (size == 0)
+        return nullblk;
+      const u64 aligned_size = round_to_alignment<ALIGN>(size);
+      if ((current == nullptr || current->size - top < aligned_size)
+          && !new_region(aligned_size))
+        return nullblk;
+      auto ptr = begin_of(current) + top;
+      top += aligned_size;
+      return {ptr, size};
+    }
+
+    /// @brief Allocates a block of code
+    /// @param size The size of the allocation
+    /// @return The block (whose 'writable' is empty on failure)
+    CodeBlock alloc_code(u64 size) noexcept
+    {
+      auto blk = alloc(size);
+      if (blk.is_null())
+        return {nullblk, nullptr};
+      const size_t offset = static_cast<size_t>(
+          static_cast<u8*>(blk.ptr()) - begin_of(current));
+      return {blk, current->exec + offset};
+    }
+
+    /// @brief Does nothing: memory is reclaimed through 'reset'
+    /// @param blk The block to deallocate
+    void dealloc([[maybe_unused]] MemBlock blk) noexcept
+    {
+      assert_true("ExecutableArena must own the block to free!", this->owns(blk));
+    }
+
+    /// @brief Check if the current allocator owns 'blk' (a writable block).
+    /// This runs in linear time of the number of regions.
+    /// @param blk The MemBlock to check
+    /// @return True if 'blk' was allocated through the current allocator
+    bool owns(MemBlock blk) const noexcept
+    {
+      return blk.is_null() || executable_of(blk.ptr()) != nullptr;
+    }
+
+    /// @brief Returns the executable address of writable code.
+    /// This runs in linear time of the number of regions.
+    /// @param writable The address of writable code returned by 'alloc'
+    /// @return The executable address or null if not owned by the arena
+    const void* executable_of(const void* writable) const noexcept
+    {
+      auto ptr = static_cast<const u8*>(writable);
+      for (auto region = current; region != nullptr; region = region->prev)
+      {
+        const u8* begin = begin_of(region);
+        const u8* end   = begin + (region == current ? top : region->used);
+        if (begin + header_size() <= ptr && ptr < end)
+          return region->exec + (ptr - begin);
+      }
+      return nullptr;
+    }
+
+    /// @brief Makes all the code allocated since the last call executable.
+    /// In Toggle mode, this does a single protection change per region,
+    /// and the code can't be written anymore.
+    /// @return True on success
+    bool finalize() noexcept
+    {
+      if (current == nullptr)
+        return true;
+      current->used = top;
+      // Only the regions allocated since the last call are not sealed
+      for (auto region = current; region != nullptr; region = region->prev)
+      {
+        if (region->sealed == region->used)
+          break;
+        if (!seal(region))
+          return false;
+      }
+      top = current->used;
+      return true;
+    }
+
+    /// @brief Returns the mapping used by the arena.
+    /// This may change from DualMapped to Toggle on the first allocation.
+    /// @return The mapping used by the arena
+    CodeMapping code_mapping() const noexcept { return mapping; }
+
+    /// @brief Returns the count of protection changes done by 'finalize'
+    /// @return The count of protection changes (always 0 if DualMapped)
+    size_t protection_changes() const noexcept { return protect_count; }
+
+    /// @brief Unmaps all the regions, invalidating all the code
+    void reset() noexcept
+    {
+      while (current != nullptr)
+      {
+        auto prev = current->prev;
+        unmap(current);
+        current = prev;
+      }
+      top = 0;
+    }
+
+    /// @brief Unmaps all the regions
+    ~ExecutableArena() noexcept { reset(); }
+  };
+} // namespace clt::mem
+
+#endif // !HG_COLT_EXEC_ALLOC
@@ -0,0 +1,194 @@
+/*****************************************************************/ /**
+ * @file   guard_alloc.h
+ * @brief  Contains GuardPageAllocator.
+ * GuardPageAllocator is a debugging allocator that places each
+ * allocation against an inaccessible page, so that overflows and
+ * use-after-free fault at the exact instruction that caused them.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_GUARD_ALLOC
+#define HG_COLT_GUARD_ALLOC
+
+#include "simple_alloc.h"
+#include "colt/num/math.h"
+#include "colt/io/mmap.h"
+
+namespace clt::mem
+{
+  template<
+      u64 QUARANTINE_BUDGET = 0, bool GUARD_BEFORE = false,
+      u64 ALIGN = alignof(std::max_align_t)>
+    requires(std::has_single_bit(ALIGN)) && (ALIGN <= 4096)
+  /// @brief Allocator that maps each allocation in its own pages, followed
+  /// (or preceded if GUARD_BEFORE) by a guard page that can't be accessed.
+  /// The end of the block is placed against the guard page: an overflow
+  /// faults immediately (up to the ALIGN - 1 bytes of padding).
+  /// If GUARD_BEFORE, the beginning of the block is placed after the guard
+  /// page, which detects underflows instead.
+  /// When freed, the pages are made inaccessible and kept in a quarantine
+  /// so that use-after-free faults, as long as the total size of the
+  /// quarantined pages does not exceed QUARANTINE_BUDGET bytes (the oldest
+  /// pages are unmapped first).
+  /// This allocator is costly (at least 2 pages per allocation and 2
+  /// system calls): it should only be used to hunt memory bugs.
+  /// It is not thread safe (see ThreadSafeAllocator).
+  /// @tparam QUARANTINE_BUDGET The maximum size (in bytes) of the quarantine
+  /// @tparam GUARD_BEFORE If true, detects underflows rather than overflows
+  /// @tparam ALIGN The alignment of returned MemBlock
+  class GuardPageAllocator
+  {
+    /// @brief Pages mapped for an allocation (including the guard page)
+    struct Region
+    {
+      /// @brief The beginning of the pages
+      u8* begin;
+      /// @brief The size of the pages
+      size_t size;
+    };
+
+    /// @brief The storage of the quarantine (mapped on first use)
+    VirtualPage storage = {};
+    /// @brief The quarantine: ring buffer of freed regions (or null)
+    Region* quarantine = nullptr;
+    /// @brief The capacity of the quarantine
+    size_t capacity = 0;
+    /// @brief The index of the oldest region of the quarantine
+    size_t head = 0;
+    /// @brief The count of regions in the quarantine
+    size_t count = 0;
+    /// @brief The size of the regions in the quarantine
+    size_t quarantined = 0;
+
+    /// @brief Returns the pages mapped for a block
+    /// @param blk The block (not null)
+    /// @return The pages mapped for 'blk'
+    static Region region_of(MemBlock blk) noexcept
+    {
+      const size_t page = VirtualPage::page_size().size;
+      const size_t data =
+          (round_to_alignment<ALIGN>(blk.size()) + page - 1) / page * page;
+      auto ptr = static_cast<u8*>(blk.ptr());
+      if constexpr (GUARD_BEFORE)
+        return {ptr - page, data + page};
+      else
+      {
+        auto addr = reinterpret_cast<uintptr_t>(ptr);
+        return {ptr - addr % page, data + page};
+      }
+    }
+
+    /// @brief Unmaps a region
+    /// @param region The region to unmap
+    static void unmap(Region region) noexcept
+    {
+      VirtualPage::deallocate(VirtualPage{region.begin, region.size});
+    }
+
+    /// @brief Unmaps the oldest region of the quarantine
+    void pop_oldest() noexcept
+    {
+      unmap(quarantine[head]);
+      quarantined -= quarantine[head].size;
+      head = (head + 1) % capacity;
+      --count;
+    }
+
+    /// @brief Maps the storage of the quarantine
+    /// @return True on success
+    bool map_quarantine() noexcept
+    {
+      // Each region is at least 2 pages: this is the maximum count
+      const size_t page = VirtualPage::page_size().size;
+      const size_t max  = clt::max(QUARANTINE_BUDGET / (2 * page), size_t{1});
+      storage = VirtualPage::allocate(
+          bytes{max * sizeof(Region)}, VirtualPage::PageAccess::ReadWrite);
+      if (storage.is_null())
+        return false;
+      quarantine = static_cast<Region*>(storage.ptr());
+      capacity   = max;
+      return true;
+    }
+
+  public:
+    constexpr GuardPageAllocator() noexcept       = default;
+    GuardPageAllocator(const GuardPageAllocator&) = delete;
+    GuardPageAllocator(GuardPageAllocator&&)      = delete;
+
+    /// @brief Alignment of returned MemBlock
+    static constexpr u64 alignment = ALIGN;
+
+    /// @brief Allocates a MemBlock
+    /// @param size The size of the allocation
+    /// @return Allocated MemBlock or an empty MemBlock on failure
+    MemBlock alloc(u64 size) noexcept
+    {
+      if (size == 0)
+        return nullblk;
+      const size_t page    = VirtualPage::page_size().size;
+      const size_t aligned = round_to_alignment<ALIGN>(size);
+      const size_t data    = (aligned + page - 1) / page * page;
+      auto pages           = VirtualPage::allocate(
+          bytes{data + page}, VirtualPage::PageAccess::ReadWrite);
+      if (pages.is_null())
+        return nullblk;
+      auto begin = static_cast<u8*>(pages.ptr());
+      auto guard = GUARD_BEFORE ? begin : begin + data;
+      if (!VirtualPage::protect(
+              guard, bytes{page}, VirtualPage::PageAccess::None))
+      {
+        VirtualPage::deallocate(pages);
+        return nullblk;
+      }
+      if constexpr (GUARD_BEFORE)
+        return {begin + page, size};
+      else
+        return {guard - aligned, size};
+    }
+
+    /// @brief Deallocates a MemBlock.
+    /// The pages are made inaccessible and quarantined if possible.
+    /// @param blk The block to deallocate
+    void dealloc(MemBlock blk) noexcept
+    {
+      if (blk.is_null())
+        return;
+      const Region region = region_of(blk);
+      if (region.size > QUARANTINE_BUDGET
+          || (quarantine == nullptr && !map_quarantine())
+          || !VirtualPage::protect(
+              region.begin, bytes{region.size}, VirtualPage::PageAccess::None))
+      {
+        unmap(region);
+        return;
+      }
+      // Make space for the region, unmapping the oldest ones
+      while (count == capacity || quarantined + region.size > QUARANTINE_BUDGET)
+        pop_oldest();
+      quarantine[(head + count) % capacity] = region;
+      quarantined += region.size;
+      ++count;
+    }
+
+    /// @brief Returns the size of the pages in the quarantine
+    /// @return The size of the pages in the quarantine (<= QUARANTINE_BUDGET)
+    size_t quarantined_bytes() const noexcept { return quarantined; }
+
+    /// @brief Unmaps all the pages of the quarantine
+    void flush_quarantine() noexcept
+    {
+      while (count != 0)
+        pop_oldest();
+    }
+
+    /// @brief Unmaps the pages of the quarantine
+    ~GuardPageAllocator() noexcept
+    {
+      flush_quarantine();
+      VirtualPage::deallocate(storage);
+    }
+  };
+} // namespace clt::mem
+
+#endif // !HG_COLT_GUARD_ALLOC
@@ -8,6 +8,7 @@
 #ifndef HG_COLT_SIMPLE_ALLOC
 #define HG_COLT_SIMPLE_ALLOC
 
+#include <bit>
 #include <cstdlib>
 #include "allocator_traits.h"
 
@@ -85,6 +86,12 @@ namespace clt::mem
     /// @return True if reallocation was successful
     bool realloc(MemBlock& blk, u64 sz) const noexcept
     {
+      if (sz == 0)
+      {
+        dealloc(blk);
+        blk = nullblk;
+        return true;
+      }
       auto ptr = std::realloc(blk.ptr(), sz);
       if (ptr == nullptr)
         return false;
@@ -369,6 +376,329 @@ namespace clt::mem
       }
     }
   };
+
+  template<
+      meta::Allocator allocator, u64 LOWER, u64 UPPER, u64 STEP = 16,
+      size_t MAX_SAVED = 16>
+    requires(LOWER >= sizeof(void*)) && (UPPER >= LOWER) && (MAX_SAVED != 0)
+            && (std::has_single_bit(STEP)) && ((UPPER - LOWER) % STEP == 0)
+  /// @brief FreeList that keeps one linked list per size class.
+  /// The range [LOWER, UPPER] is split in size classes of STEP bytes:
+  /// allocations in that range are rounded up to the size of their class,
+  /// so that any saved block of that class can be returned.
+  /// Contrary to FreeList, no search is done: both allocating and
+  /// deallocating a block of the range are done in constant time.
+  /// 'MAX_SAVED' fixes a limit of maximum saved blocks per size class.
+  class SegregatedFreeList : private allocator
+  {
+    /// @brief A Node contains a pointer to the next Node
+    struct Node
+    {
+      Node* next;
+    };
+
+    /// @brief The count of size classes
+    static constexpr size_t CLASS_COUNT = (UPPER - LOWER) / STEP + 1;
+
+    /// @brief The saved blocks of each size class
+    Node* roots[CLASS_COUNT] = {};
+    /// @brief The count of saved blocks of each size class
+    u32 saved_count[CLASS_COUNT] = {};
+
+    /// @brief Check if a size is in range
+    /// @param n The size to check
+    /// @return True if LOWER <= n && n <= UPPER
+    static constexpr bool is_in_range(size_t n) noexcept
+    {
+      return LOWER <= n && n <= UPPER;
+    }
+
+    /// @brief Returns the size class of a size in range
+    /// @param n The size (in range)
+    /// @return The index of the size class
+    static constexpr size_t class_of(size_t n) noexcept
+    {
+      return (n - LOWER + STEP - 1) >> std::countr_zero(STEP);
+    }
+
+    /// @brief Returns the size of the blocks of a size class
+    /// @param index The index of the size class
+    /// @return The size of the blocks
+    static constexpr u64 size_of(size_t index) noexcept
+    {
+      return LOWER + index * STEP;
+    }
+
+  public:
+    constexpr SegregatedFreeList() noexcept       = default;
+    SegregatedFreeList(const SegregatedFreeList&) = delete;
+    SegregatedFreeList(SegregatedFreeList&&)      = delete;
+
+    /// @brief Alignment of returned MemBlock
+    static constexpr u64 alignment = allocator::alignment;
+
+    /// @brief Allocates a MemBlock.
+    /// Sizes in range are rounded up to their size class.
+    /// @param size The size of the allocation
+    /// @return Allocated MemBlock or an empty MemBlock on failure
+    constexpr MemBlock alloc(u64 n) noexcept
+    {
+      if (!is_in_range(n))
+        return allocator::alloc(n);
+      const size_t index = class_of(n);
+      if (Node* node = roots[index]; node != nullptr)
+      {
+        roots[index] = node->next;
+        --saved_count[index];
+        return {node, size_of(index)};
+      }
+      return allocator::alloc(size_of(index));
+    }
+
+    /// @brief Deallocates a MemBlock that was allocated using the current allocator
+    /// @param to_free The block whose resources to free
+    constexpr void dealloc(MemBlock blk) noexcept
+    {
+      //'nullblk' will never be registered: they are deallocated
+      if (!is_in_range(blk.size()))
+      {
+        allocator::dealloc(blk);
+        return;
+      }
+      const size_t index = class_of(blk.size());
+      if (saved_count[index] == MAX_SAVED)
+      {
+        allocator::dealloc({blk.ptr(), size_of(index)});
+        return;
+      }
+      roots[index] = new (blk.ptr()) Node{roots[index]};
+      ++saved_count[index];
+    }
+
+    /// @brief Check if the current allocator owns 'blk'
+    /// @param blk The MemBlock to check
+    /// @return True if 'blk' was allocated through the current allocator
+    constexpr bool owns(MemBlock blk) const noexcept
+      requires meta::OwningAllocator<allocator>
+    {
+      return allocator::owns(blk);
+    }
+
+    /// @brief Expands a block in place if possible.
+    /// A block in range can grow up to the size of its class.
+    /// @param blk The block to expand
+    /// @param delta The new size
+    /// @return True if expansion was done successfully
+    constexpr bool expand(MemBlock& blk, u64 delta) noexcept
+    {
+      if (!is_in_range(blk.size()))
+      {
+        if constexpr (meta::ExpandingAllocator<allocator>)
+          return !is_in_range(delta) && allocator::expand(blk, delta);
+        else
+          return false;
+      }
+      if (!is_in_range(delta) || size_of(class_of(blk.size())) < delta)
+        return false;
+      blk = MemBlock{blk.ptr(), delta};
+      return true;
+    }
+
+    /// @brief Reallocates a MemBlock.
+    /// Blocks that stay in their class are expanded in place, blocks
+    /// out of range are reallocated by the underlying allocator.
+    /// @param blk The block to reallocate
+    /// @param n The new size of the block
+    /// @return True if reallocation was successful
+    constexpr bool realloc(MemBlock& blk, u64 n) noexcept
+    {
+      if (blk.size() == n)
+        return true;
+      if (blk.is_null())
+      {
+        blk = alloc(n);
+        return !blk.is_null();
+      }
+      if (n == 0)
+      {
+        dealloc(blk);
+        blk = nullblk;
+        return true;
+      }
+      if constexpr (meta::ReallocatableAllocator<allocator>)
+      {
+        if (!is_in_range(blk.size()) && !is_in_range(n))
+          return allocator::realloc(blk, n);
+      }
+      if (expand(blk, n))
+        return true;
+      return details::realloc_with_copy(*this, *this, blk, n);
+    }
+
+    /// @brief Returns all the block owned by the list to the underlying allocator
+    constexpr ~SegregatedFreeList() noexcept
+    {
+      for (size_t i = 0; i != CLASS_COUNT; ++i)
+      {
+        while (roots[i] != nullptr)
+        {
+          auto next = roots[i]->next;
+          allocator::dealloc({static_cast<void*>(roots[i]), size_of(i)});
+          roots[i] = next;
+        }
+      }
+    }
+  };
+
+  template<
+      u64 OBJ_SIZE, u64 ALIGN, meta::Allocator Backing,
+      u64 SLAB_SIZE = 64 * 1024>
+    requires(OBJ_SIZE != 0) && (std::has_single_bit(ALIGN))
+            && (ALIGN <= Backing::alignment)
+  /// @brief Allocator of fixed size objects.
+  /// Memory is obtained from 'Backing' in slabs of SLAB_SIZE bytes, which
+  /// are carved into equal slots of (at least) OBJ_SIZE bytes.
+  /// Freed slots are kept in an intrusive free list, stored inside the
+  /// slots themselves: both allocating and deallocating run in constant time.
+  /// Slabs are only returned to 'Backing' on destruction.
+  /// Several pools can be stacked by size class using Segregator.
+  /// @tparam OBJ_SIZE The size of the objects
+  /// @tparam ALIGN The alignment of the objects
+  /// @tparam Backing The allocator from which to obtain the slabs
+  /// @tparam SLAB_SIZE The size of a slab
+  class PoolAllocator : private Backing
+  {
+    /// @brief A Node contains a pointer to the next Node
+    struct Node
+    {
+      Node* next;
+    };
+
+    /// @brief Header stored at the beginning of each slab
+    struct Slab
+    {
+      /// @brief The previous slab or null
+      Slab* prev;
+    };
+
+    /// @brief The size of a slot (which must be able to store a Node)
+    static constexpr u64 SLOT_SIZE = round_to_alignment<ALIGN>(
+        OBJ_SIZE < sizeof(Node) ? sizeof(Node) : OBJ_SIZE);
+    /// @brief The size of the header (preserving alignment)
+    static constexpr u64 HEADER_SIZE = round_to_alignment<ALIGN>(sizeof(Slab));
+
+    static_assert(SLAB_SIZE >= HEADER_SIZE + SLOT_SIZE, "SLAB_SIZE is too small!");
+
+    /// @brief The free list
+    Node* free_list = nullptr;
+    /// @brief The most recent slab or null
+    Slab* slabs = nullptr;
+    /// @brief The first slot of the most recent slab that was never allocated
+    u8* top = nullptr;
+    /// @brief The end of the slots of the most recent slab
+    u8* slab_end = nullptr;
+
+    /// @brief Allocates a new slab whose slots are carved on demand
+    /// @return True on success
+    bool new_slab() noexcept
+    {
+      auto blk = Backing::alloc(SLAB_SIZE);
+      if (blk.is_null())
+        return false;
+      slabs    = new (blk.ptr()) Slab{slabs};
+      top      = static_cast<u8*>(blk.ptr()) + HEADER_SIZE;
+      slab_end = top + slot_per_slab * SLOT_SIZE;
+      return true;
+    }
+
+  public:
+    constexpr PoolAllocator() noexcept  = default;
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator(PoolAllocator&&)      = delete;
+
+    /// @brief Alignment of returned MemBlock
+    static constexpr u64 alignment = ALIGN;
+    /// @brief The count of objects per slab
+    static constexpr u64 slot_per_slab = (SLAB_SIZE - HEADER_SIZE) / SLOT_SIZE;
+
+    /// @brief Allocates a MemBlock
+    /// @param size The size of the allocation (<= OBJ_SIZE)
+    /// @return Allocated MemBlock or an empty MemBlock on failure
+    MemBlock alloc(u64 size) noexcept
+    {
+      assert_true(
+          "PoolAllocator cannot allocate more than OBJ_SIZE!", size <= OBJ_SIZE);
+      if (size == 0 || size > OBJ_SIZE)
+        return nullblk;
+      if (free_list != nullptr)
+      {
+        auto node = free_list;
+        free_list = node->next;
+        return {node, size};
+      }
+      if (top == slab_end && !new_slab())
+        return nullblk;
+      auto ptr = top;
+      top += SLOT_SIZE;
+      return {ptr, size};
+    }
+
+    /// @brief Deallocates a MemBlock that was allocated using the current allocator
+    /// @param blk The block whose resources to free
+    void dealloc(MemBlock blk) noexcept
+    {
+      assert_true("PoolAllocator must own the block to free!", this->owns(blk));
+      if (!blk.is_null())
+        free_list = new (blk.ptr()) Node{free_list};
+    }
+
+    /// @brief Check if the current allocator owns 'blk'.
+    /// This runs in linear time of the number of slabs.
+    /// @param blk The MemBlock to check
+    /// @return True if 'blk' was allocated through the current allocator
+    bool owns(MemBlock blk) const noexcept
+    {
+      if (blk.is_null())
+        return true;
+      auto ptr = static_cast<const u8*>(blk.ptr());
+      for (auto slab = slabs; slab != nullptr; slab = slab->prev)
+      {
+        auto begin = reinterpret_cast<const u8*>(slab);
+        if (begin + HEADER_SIZE <= ptr && ptr < begin + SLAB_SIZE)
+          return true;
+      }
+      return false;
+    }
+
+    /// @brief Expands a block in place if possible.
+    /// A block can grow up to OBJ_SIZE.
+    /// @param blk The block to expand
+    /// @param delta The new size
+    /// @return True if expansion was done successfully
+    bool expand(MemBlock& blk, u64 delta) noexcept
+    {
+      if (blk.is_null())
+      {
+        blk = alloc(delta);
+        return !blk.is_null();
+      }
+      if (delta == 0 || delta > OBJ_SIZE)
+        return false;
+      blk = MemBlock{blk.ptr(), delta};
+      return true;
+    }
+
+    /// @brief Returns all the slabs to the backing allocator
+    ~PoolAllocator() noexcept
+    {
+      while (slabs != nullptr)
+      {
+        auto prev = slabs->prev;
+        Backing::dealloc({static_cast<void*>(slabs), SLAB_SIZE});
+        slabs = prev;
+      }
+    }
+  };
 } // namespace clt::mem
 
 #endif //!HG_COLT_SIMPLE_ALLOC
\ No newline at end of file
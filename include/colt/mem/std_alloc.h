@@ -0,0 +1,129 @@
+/*****************************************************************/ /**
+ * @file   std_alloc.h
+ * @brief  Contains StdAllocator, which adapts colt allocators to
+ * the allocator requirements of the standard library.
+ * This allows standard (or third-party) containers to allocate
+ * using the allocators of colt.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_STD_ALLOC
+#define HG_COLT_STD_ALLOC
+
+#include <new>
+#include <type_traits>
+#include "allocator_ref.h"
+
+namespace clt::mem
+{
+  template<typename T, meta::Allocator ALLOCATOR>
+    requires std::copy_constructible<ALLOCATOR>
+  /// @brief Adapts a colt allocator to a standard allocator.
+  /// ALLOCATOR is stored by copy: it should be a stateless allocator
+  /// (such as Mallocator or GlobalAllocatorRef) or a reference to an
+  /// allocator (such as LocalAllocatorRef or AnyAllocatorRef).
+  /// As required by the standard, failure to allocate throws std::bad_alloc.
+  /// @tparam T The type to allocate
+  /// @tparam ALLOCATOR The colt allocator
+  class StdAllocator
+  {
+    template<typename U, meta::Allocator A>
+      requires std::copy_constructible<A>
+    friend class StdAllocator;
+
+    static_assert(
+        alignof(T) <= ALLOCATOR::alignment,
+        "The alignment of the allocator is not enough for T!");
+
+    /// @brief The allocator (compiled out if stateless)
+    [[no_unique_address]] ALLOCATOR allocator;
+
+  public:
+    /// @brief The type to allocate
+    using value_type = T;
+    /// @brief Stateless allocators always compare equal
+    using is_always_equal = std::is_empty<ALLOCATOR>;
+    /// @brief The allocator is moved with the container
+    using propagate_on_container_move_assignment = std::true_type;
+    /// @brief The allocator is swapped with the container
+    using propagate_on_container_swap = std::true_type;
+
+    /// @brief Rebinds the allocator to another type
+    /// @tparam U The new type to allocate
+    template<typename U>
+    struct rebind
+    {
+      /// @brief The rebound allocator
+      using other = StdAllocator<U, ALLOCATOR>;
+    };
+
+    /// @brief Default constructor (for stateless allocators)
+    constexpr StdAllocator() noexcept
+      requires std::is_default_constructible_v<ALLOCATOR>
+    = default;
+
+    /// @brief Constructs an adapter over 'alloc'
+    /// @param alloc The allocator
+    constexpr StdAllocator(const ALLOCATOR& alloc) noexcept
+        : allocator(alloc)
+    {
+    }
+
+    /// @brief Converting constructor (used when rebinding)
+    /// @tparam U The type of the other allocator
+    /// @param other The allocator to copy
+    template<typename U>
+    constexpr StdAllocator(const StdAllocator<U, ALLOCATOR>& other) noexcept
+        : allocator(other.allocator)
+    {
+    }
+
+    constexpr StdAllocator(const StdAllocator&) noexcept            = default;
+    constexpr StdAllocator& operator=(const StdAllocator&) noexcept = default;
+
+    /// @brief Allocates an array of 'count' objects (without constructing them)
+    /// @param count The number of objects
+    /// @return Pointer to the array
+    /// @throw std::bad_alloc if the allocation failed
+    T* allocate(size_t count)
+    {
+      if (count == 0)
+        return nullptr;
+      if (count > std::numeric_limits<size_t>::max() / sizeof(T))
+        throw std::bad_array_new_length();
+      auto blk = allocator.alloc(count * sizeof(T));
+      if (blk.is_null())
+        throw std::bad_alloc();
+      return static_cast<T*>(blk.ptr());
+    }
+
+    /// @brief Deallocates an array obtained through 'allocate'
+    /// @param ptr The pointer to the array
+    /// @param count The number of objects (as passed to 'allocate')
+    void deallocate(T* ptr, size_t count) noexcept
+    {
+      if (count != 0)
+        allocator.dealloc({static_cast<void*>(ptr), count * sizeof(T)});
+    }
+
+    /// @brief Returns the underlying colt allocator
+    /// @return The underlying colt allocator
+    const ALLOCATOR& get_allocator() const noexcept { return allocator; }
+
+    /// @brief Check if memory allocated by one allocator can be freed by the other
+    /// @tparam U The type of the other allocator
+    /// @param other The other allocator
+    /// @return True if both allocators are interchangeable
+    template<typename U>
+    constexpr bool operator==(const StdAllocator<U, ALLOCATOR>& other) const noexcept
+    {
+      if constexpr (std::is_empty_v<ALLOCATOR>)
+        return true;
+      else
+        return allocator == other.allocator;
+    }
+  };
+} // namespace clt::mem
+
+#endif // !HG_COLT_STD_ALLOC
@@ -12,19 +12,237 @@
 #include <algorithm>
 #include <utility>
 #include <numeric>
+#include <concepts>
 
 #include "colt/dsa/option.h"
 
 namespace clt::meta
 {
+  /// @brief Maximum count of items of a Map for which a perfect hash is
+  /// generated (bigger tables are searched using a binary search)
+  inline constexpr size_t PERFECT_HASH_MAX_SIZE = 1024;
+
+  namespace details
+  {
+    template<typename T>
+    /// @brief Types for which a perfect hash can be generated at compile-time:
+    /// integers, enums, and views over bytes (such as std::string_view)
+    concept perfect_hashable =
+        std::integral<T> || std::is_enum_v<T> || requires(const T& str) {
+          { str.data()[0] };
+          { str.size() } -> std::convertible_to<size_t>;
+        } && sizeof(*std::declval<const T&>().data()) == 1;
+
+    /// @brief Finalizer of MurmurHash3, used to mix the bits of hashes
+    /// @param x The value to mix
+    /// @return The mixed value
+    constexpr u64 perfect_mix(u64 x) noexcept
+    {
+      x ^= x >> 33;
+      x *= 0xFF51AFD7ED558CCD;
+      x ^= x >> 33;
+      x *= 0xC4CEB9FE1A85EC53;
+      return x ^ (x >> 33);
+    }
+
+    template<perfect_hashable T>
+    /// @brief Hashes a key (usable at compile-time)
+    /// @tparam T The type of the key
+    /// @param key The key to hash
+    /// @return The hash of the key
+    constexpr u64 perfect_hash(const T& key) noexcept
+    {
+      if constexpr (std::integral<T> || std::is_enum_v<T>)
+        return perfect_mix(static_cast<u64>(key));
+      else
+      {
+        size_t size = key.size();
+        if constexpr (requires { key.unit_len(); })
+          size = key.unit_len();
+        // FNV-1a
+        u64 hash = 0xCBF29CE484222325;
+        for (size_t i = 0; i < size; i++)
+          hash = (hash ^ static_cast<u8>(key.data()[i])) * 0x100000001B3;
+        return perfect_mix(hash ^ size);
+      }
+    }
+
+    template<size_t Size>
+    /// @brief Minimal perfect hash of 'Size' keys (CHD: compress, hash and
+    /// displace).
+    /// A key's hash selects a bucket, whose displacement is mixed with that
+    /// hash to obtain the key's slot: the displacements are searched for at
+    /// construction so that no two keys share a slot.
+    /// If no displacement of a bucket is found, the search is retried with
+    /// another seed (which is mixed with the hashes, reshuffling the
+    /// buckets and the slots): only keys whose hashes are equal make the
+    /// perfect hash invalid.
+    /// @tparam Size The count of keys
+    struct PerfectHashIndex
+    {
+      /// @brief The count of buckets (about four keys per bucket)
+      static constexpr size_t BUCKETS = Size / 4 + 1;
+      /// @brief The maximum displacement tried for a bucket
+      static constexpr u16 MAX_DISPLACEMENT = 0xFFFF;
+      /// @brief The count of seeds tried before giving up
+      static constexpr u64 MAX_SEEDS = 8;
+
+      /// @brief The displacement of each bucket
+      std::array<u16, BUCKETS> displacement{};
+      /// @brief The index of the key stored in each slot
+      std::array<u16, Size> slots{};
+      /// @brief The seed mixed with the hashes (0 for the first attempt)
+      u64 seed = 0;
+      /// @brief False if no perfect hash could be found
+      bool is_valid = false;
+
+      /// @brief Returns the slot of a key
+      /// @param hash The seeded hash of the key
+      /// @param disp The displacement of the bucket of the key
+      /// @return The slot of the key
+      static constexpr size_t slot_of(u64 hash, u64 disp) noexcept
+      {
+        return perfect_mix(hash + disp * 0x9E3779B97F4A7C15) % (Size + (Size == 0));
+      }
+
+      /// @brief Mixes a hash with the seed
+      /// @param hash The hash of the key
+      /// @param seed The seed
+      /// @return The seeded hash
+      static constexpr u64 seeded(u64 hash, u64 seed) noexcept
+      {
+        return seed == 0 ? hash : perfect_mix(hash ^ seed);
+      }
+
+      constexpr PerfectHashIndex() noexcept = default;
+
+      /// @brief Builds the perfect hash of keys
+      /// @param hashes The hash of each key (which must all be different)
+      constexpr PerfectHashIndex(const std::array<u64, Size>& hashes) noexcept
+      {
+        std::array<u64, Size> mixed{};
+        for (u64 i = 0; i < MAX_SEEDS && !is_valid; i++)
+        {
+          seed = i * 0x9E3779B97F4A7C15;
+          for (size_t j = 0; j < Size; j++)
+            mixed[j] = seeded(hashes[j], seed);
+          is_valid = try_build(mixed);
+        }
+      }
+
+      /// @brief Returns the index of the only key that can have a hash
+      /// @param hash The hash of the key
+      /// @return The index of the key to compare against
+      constexpr size_t find(u64 hash) const noexcept
+      {
+        hash = seeded(hash, seed);
+        return slots[slot_of(hash, displacement[hash % BUCKETS])];
+      }
+
+    private:
+      /// @brief Searches for the displacements of the buckets
+      /// @param hashes The seeded hash of each key
+      /// @return False if a bucket could not be placed
+      constexpr bool try_build(const std::array<u64, Size>& hashes) noexcept
+      {
+        displacement = {};
+        slots        = {};
+
+        // the keys, grouped by bucket
+        std::array<u16, Size> keys{};
+        std::array<u16, BUCKETS + 1> start{};
+        for (size_t i = 0; i < Size; i++)
+          ++start[hashes[i] % BUCKETS + 1];
+        for (size_t i = 0; i < BUCKETS; i++)
+          start[i + 1] += start[i];
+        std::array<u16, BUCKETS + 1> next = start;
+        for (size_t i = 0; i < Size; i++)
+          keys[next[hashes[i] % BUCKETS]++] = static_cast<u16>(i);
+
+        // the buckets with the most keys are placed first
+        std::array<u16, BUCKETS> order{};
+        for (size_t i = 0; i < BUCKETS; i++)
+          order[i] = static_cast<u16>(i);
+        std::sort(
+            order.begin(), order.end(),
+            [&](u16 a, u16 b)
+            { return start[a + 1] - start[a] > start[b + 1] - start[b]; });
+
+        std::array<bool, Size> used{};
+        std::array<size_t, Size> pending{};
+        for (auto bucket : order)
+        {
+          const size_t count = start[bucket + 1] - start[bucket];
+          if (count == 0)
+            break;
+          bool placed = false;
+          for (u32 disp = 0; disp <= MAX_DISPLACEMENT && !placed; disp++)
+          {
+            placed = true;
+            for (size_t i = 0; i < count && placed; i++)
+            {
+              pending[i] = slot_of(hashes[keys[start[bucket] + i]], disp);
+              placed     = !used[pending[i]]
+                       && std::find(pending.begin(), pending.begin() + i, pending[i])
+                              == pending.begin() + i;
+            }
+            if (!placed)
+              continue;
+            for (size_t i = 0; i < count; i++)
+            {
+              used[pending[i]]  = true;
+              slots[pending[i]] = keys[start[bucket] + i];
+            }
+            displacement[bucket] = static_cast<u16>(disp);
+          }
+          // (two keys with the same hash can never be placed)
+          if (!placed)
+            return false;
+        }
+        return true;
+      }
+    };
+
+    template<typename T, size_t Size>
+    /// @brief The perfect hash of a table of 'Size' keys of type T.
+    /// The perfect hash of tables that cannot be hashed is always invalid.
+    using perfect_hash_of = PerfectHashIndex<
+        (perfect_hashable<T> && Size <= PERFECT_HASH_MAX_SIZE) ? Size : 0>;
+
+    template<typename T, size_t Size, typename Fn>
+    /// @brief Builds a perfect hash of the keys of a table, if possible
+    /// @tparam T The type of the keys
+    /// @tparam Size The count of keys
+    /// @param get_key Function returning the key at an index
+    /// @return The perfect hash (invalid if it could not be built)
+    constexpr perfect_hash_of<T, Size> make_perfect_hash(Fn&& get_key) noexcept
+    {
+      if constexpr (
+          perfect_hashable<T> && Size != 0 && Size <= PERFECT_HASH_MAX_SIZE)
+      {
+        std::array<u64, Size> hashes{};
+        for (size_t i = 0; i < Size; i++)
+          hashes[i] = perfect_hash(get_key(i));
+        return PerfectHashIndex<Size>{hashes};
+      }
+      else
+        return {};
+    }
+  } // namespace details
+
   template<typename Key, typename Value, std::size_t Size>
-  /// @brief constexpr Map for compile-time lookups
+  /// @brief constexpr Map for compile-time lookups.
+  /// A minimal perfect hash of the keys is generated for integral, enum
+  /// and string keys, so that 'find' is one hash and one comparison.
+  /// Other (and very large) tables are searched using a binary search.
   /// @tparam Key The Key type
   /// @tparam Value The Value type
   struct Map
   {
     /// @brief The data in which to search
     std::array<std::pair<Key, Value>, Size> data;
+    /// @brief The perfect hash of the keys (invalid if not generated)
+    details::perfect_hash_of<Key, Size> hash{};
 
     constexpr Map(std::array<std::pair<Key, Value>, Size> data)
         : data(data)
@@ -38,6 +256,8 @@ namespace clt::meta
       assert_true(
           "Items not unique!",
           std::adjacent_find(data.begin(), data.end()) == data.end());
+      hash = details::make_perfect_hash<Key, Size>(
+          [this](size_t i) -> const Key& { return this->data[i].first; });
     }
 
     [[nodiscard]]
@@ -49,6 +269,16 @@ namespace clt::meta
     {
       if constexpr (Size == 0)
         return None;
+      if constexpr (details::perfect_hashable<Key>)
+      {
+        if (hash.is_valid)
+        {
+          const auto& pair = data[hash.find(details::perfect_hash(key))];
+          if (pair.first == key)
+            return pair.second;
+          return None;
+        }
+      }
 
       u64 low  = 0;
       u64 high = Size - 1;
@@ -74,7 +304,8 @@ namespace clt::meta
   };
 
   template<typename Key, typename Value, std::size_t Size>
-  /// @brief constexpr BiMap for compile-time lookups
+  /// @brief constexpr BiMap for compile-time lookups.
+  /// As for Map, lookups in both directions use a perfect hash if possible.
   /// @tparam Key The Key type
   /// @tparam Value The Value type
   struct BiMap
@@ -83,6 +314,10 @@ namespace clt::meta
     std::array<std::pair<Key, Value>, Size> data_f;
     /// @brief The data in which to search
     std::array<std::pair<Key, Value>, Size> data_b;
+    /// @brief The perfect hash of the keys of 'data_f'
+    details::perfect_hash_of<Key, Size> hash_f{};
+    /// @brief The perfect hash of the values of 'data_b'
+    details::perfect_hash_of<Value, Size> hash_b{};
 
     constexpr BiMap(std::array<std::pair<Key, Value>, Size> data)
         : data_f(data)
@@ -109,6 +344,10 @@ namespace clt::meta
               data_b.begin(), data_b.end(),
               [](const pair_t& a, const pair_t& b) { return a.second == b.second; })
               == data_b.end());
+      hash_f = details::make_perfect_hash<Key, Size>(
+          [this](size_t i) -> const Key& { return this->data_f[i].first; });
+      hash_b = details::make_perfect_hash<Value, Size>(
+          [this](size_t i) -> const Value& { return this->data_b[i].second; });
     }
 
     [[nodiscard]]
@@ -120,6 +359,16 @@ namespace clt::meta
     {
       if constexpr (Size == 0)
         return None;
+      if constexpr (details::perfect_hashable<Key>)
+      {
+        if (hash_f.is_valid)
+        {
+          const auto& pair = data_f[hash_f.find(details::perfect_hash(key))];
+          if (pair.first == key)
+            return pair.second;
+          return None;
+        }
+      }
 
       u64 low  = 0;
       u64 high = Size - 1;
@@ -152,6 +401,16 @@ namespace clt::meta
     {
       if constexpr (Size == 0)
         return None;
+      if constexpr (details::perfect_hashable<Value>)
+      {
+        if (hash_b.is_valid)
+        {
+          const auto& pair = data_b[hash_b.find(details::perfect_hash(value))];
+          if (pair.second == value)
+            return pair.first;
+          return None;
+        }
+      }
 
       u64 low  = 0;
       u64 high = Size - 1;
@@ -0,0 +1,193 @@
+/*****************************************************************/ /**
+ * @file   niche.h
+ * @brief  Contains 'niche', the customization point declaring the invalid
+ *         representations of a type, and 'dense_values', which maps the
+ *         values of a small type to consecutive indices.
+ * Option<T> stores its empty state in a niche of T, and Expect<T, E>
+ * stores small errors (whose values are dense) in the niches of T:
+ * both are then the same size as T.
+ * Raw pointers have no niches (nullptr is a valid T*): NonNull<T> (see
+ * dsa/smart_pointers.h) makes the null pointer a niche.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_META_NICHE
+#define HG_META_NICHE
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace clt::meta
+{
+  /// @brief Declares the invalid representations (niches) of a type.
+  /// A specialization provides:
+  /// - 'count': the number of niches of the type
+  /// - 'make(size_t i)': returns the niche 'i' (with i < count)
+  /// - 'index_of(const T&)': returns the index of a niche, or 'count' if the
+  ///   object is a valid value.
+  /// A niche must never be produced by valid code: Option<T> uses the niche 0
+  /// to represent None.
+  /// @code{.cpp}
+  /// struct Handle { u32 value; }; // UINT32_MAX is never a valid Handle
+  /// template<>
+  /// struct clt::meta::niche<Handle>
+  /// {
+  ///   static constexpr size_t count = 1;
+  ///   static constexpr Handle make(size_t) noexcept { return {UINT32_MAX}; }
+  ///   static constexpr size_t index_of(const Handle& h) noexcept
+  ///   {
+  ///     return h.value == UINT32_MAX ? 0 : 1;
+  ///   }
+  /// };
+  /// @endcode
+  /// @tparam T The type
+  template<typename T>
+  struct niche
+  {
+    /// @brief No niches by default
+    static constexpr size_t count = 0;
+  };
+
+  /// @brief Check if a type has niches that can store the state of an Option
+  /// or the error of an Expect.
+  /// @tparam T The type
+  template<typename T>
+  concept has_niche =
+      std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>
+      && (niche<T>::count > 0) && requires(const T& obj, size_t i) {
+           { niche<T>::make(i) } -> std::same_as<T>;
+           { niche<T>::index_of(obj) } -> std::same_as<size_t>;
+         };
+
+  /// @brief Maps the values of small types (like error codes) to the
+  /// consecutive indices [0, count).
+  /// A specialization provides:
+  /// - 'count': the number of values of the type
+  /// - 'to_index(const T&)': returns the index of a value
+  /// - 'from_index(size_t i)': returns the value of index 'i'
+  /// @tparam T The type
+  template<typename T>
+  struct dense_values
+  {
+    /// @brief Not dense by default
+    static constexpr size_t count = 0;
+  };
+
+  /// @brief bool has 2 values
+  template<>
+  struct dense_values<bool>
+  {
+    /// @brief false and true
+    static constexpr size_t count = 2;
+
+    /// @brief Returns the index of a value
+    /// @param value The value
+    /// @return 0 for false, 1 for true
+    static constexpr size_t to_index(bool value) noexcept { return value; }
+    /// @brief Returns the value of an index
+    /// @param index The index
+    /// @return false for 0, true for 1
+    static constexpr bool from_index(size_t index) noexcept { return index != 0; }
+  };
+
+  /// @brief Check if a type has dense values (see dense_values)
+  /// @tparam T The type
+  template<typename T>
+  concept has_dense_values =
+      std::is_trivially_copyable_v<T> && (dense_values<T>::count > 0)
+      && requires(const T& obj, size_t i) {
+           { dense_values<T>::to_index(obj) } -> std::same_as<size_t>;
+           { dense_values<T>::from_index(i) } -> std::same_as<T>;
+         };
+
+  namespace details
+  {
+    /// @brief The niches of an enum whose values are [0, COUNT): the values
+    ///        of the underlying type greater or equal to COUNT.
+    /// Specialized for reflected enums (see ADD_REFLECTION_FOR_CONSECUTIVE_ENUM).
+    /// @tparam E The enum type
+    /// @tparam COUNT The number of enumerators
+    template<typename E, size_t COUNT>
+      requires std::is_enum_v<E>
+    struct enum_niche
+    {
+      /// @brief The underlying type of the enum
+      using underlying_t = std::underlying_type_t<E>;
+
+      static_assert(
+          COUNT - 1 <= static_cast<size_t>(std::numeric_limits<underlying_t>::max()),
+          "Too many enumerators for the underlying type!");
+
+      /// @brief The values in [COUNT, max]
+      static constexpr size_t count =
+          static_cast<size_t>(std::numeric_limits<underlying_t>::max())
+          - (COUNT - 1);
+
+      /// @brief Returns the niche 'i'
+      /// @param i The index of the niche
+      /// @return The enum of value 'COUNT + i'
+      static constexpr E make(size_t i) noexcept
+      {
+        return static_cast<E>(static_cast<underlying_t>(COUNT + i));
+      }
+
+      /// @brief Returns the index of the niche 'value'
+      /// @param value The enum
+      /// @return The index of the niche or 'count' if not a niche
+      static constexpr size_t index_of(E value) noexcept
+      {
+        const auto raw = static_cast<underlying_t>(value);
+        if constexpr (std::is_signed_v<underlying_t>)
+        {
+          if (raw < 0)
+            return count;
+        }
+        if (static_cast<size_t>(raw) < COUNT)
+          return count;
+        return static_cast<size_t>(raw) - COUNT;
+      }
+    };
+
+    /// @brief The dense values of an enum whose values are [0, COUNT).
+    /// Specialized for reflected enums (see ADD_REFLECTION_FOR_CONSECUTIVE_ENUM).
+    /// @tparam E The enum type
+    /// @tparam COUNT The number of enumerators
+    template<typename E, size_t COUNT>
+      requires std::is_enum_v<E>
+    struct enum_dense_values
+    {
+      /// @brief The number of enumerators
+      static constexpr size_t count = COUNT;
+
+      /// @brief Returns the index of a value
+      /// @param value The value
+      /// @return The underlying value of the enum
+      static constexpr size_t to_index(E value) noexcept
+      {
+        return static_cast<size_t>(value);
+      }
+      /// @brief Returns the value of an index
+      /// @param index The index
+      /// @return The enum whose underlying value is 'index'
+      static constexpr E from_index(size_t index) noexcept
+      {
+        return static_cast<E>(index);
+      }
+    };
+  } // namespace details
+
+  /// @brief Check if the errors of type 'E' fit in the niches of 'T'.
+  /// Expect<T, E> is then the same size as T.
+  /// @tparam T The expected type
+  /// @tparam E The error type
+  template<typename T, typename E>
+  concept error_fits_in_niche =
+      has_niche<T> && has_dense_values<E>
+      && (dense_values<E>::count <= niche<T>::count);
+} // namespace clt::meta
+
+#endif // !HG_META_NICHE
@@ -18,6 +18,7 @@
 #include <colt/hash.h>
 #include <colt/algo/iterator.h>
 #include <colt/dsa/option.h>
+#include <colt/meta/niche.h>
 #include <colt/dsa/string_view.h>
 #include <colt/meta/map.h>
 
@@ -479,12 +480,47 @@ namespace clt::meta
 
   template<typename T>
   concept reflectable_enum = std::is_enum_v<T> && clt::meta::is_reflectable_v<T>;
+
+  namespace details
+  {
+    /// @brief Sums the sizes of the types of a type_list
+    /// @tparam List The type_list
+    template<typename List>
+    struct sizeof_all;
+
+    /// @brief Sums the sizes of the types of a type_list
+    /// @tparam ...Ts The types of the type_list
+    template<typename... Ts>
+    struct sizeof_all<type_list<Ts...>>
+        : public std::integral_constant<size_t, (sizeof(Ts) + ... + 0)>
+    {
+    };
+  } // namespace details
+
+  /// @brief Check if a reflected type can be hashed by hashing its bytes.
+  /// This is the case if its registered members are all contiguously
+  /// hashable, and cover all the bytes of the type (no padding, and no
+  /// member that was not registered).
+  /// @tparam T The type declared through COLT_DECLARE_TYPE
+  template<typename T>
+  static constexpr bool is_reflected_contiguously_hashable_v =
+      reflect<T>::members_type::template apply<std::remove_cv>::template remove_if<
+          is_contiguously_hashable>::size
+          == 0
+      && details::sizeof_all<typename reflect<T>::members_type>::value == sizeof(T)
+      && std::has_unique_object_representations_v<T>;
 } // namespace clt::meta
 
 namespace clt
 {
   template<meta::hash_algorithm Algo, meta::reflectable T>
-    requires(!meta::hashable<T> && !meta::is_contiguously_hashable_v<T>)
+    requires(std::is_class_v<T> && !meta::is_contiguously_hashable_v<T>)
+  /// @brief Hash Append for reflected types that are not contiguously
+  /// hashable: each registered member is hashed in order.
+  /// @tparam Algo The hashing algorithm
+  /// @tparam T The reflected type
+  /// @param algo The hashing algorithm object
+  /// @param self The object to hash
   static constexpr void hash_append(Algo& algo, const T& self)
   {
     using namespace clt::meta;
@@ -540,20 +576,24 @@ constexpr static auto serialize(auto& archive, T& self)
 * Declare all built-in types
 ****************************/
 
-DECLARE_BUILTIN_TYPE(char);
-DECLARE_BUILTIN_TYPE(char8_t);
-DECLARE_BUILTIN_TYPE(char16_t);
-DECLARE_BUILTIN_TYPE(char32_t);
-DECLARE_BUILTIN_TYPE(i8);
-DECLARE_BUILTIN_TYPE(u8);
-DECLARE_BUILTIN_TYPE(i16);
-DECLARE_BUILTIN_TYPE(u16);
-DECLARE_BUILTIN_TYPE(i32);
-DECLARE_BUILTIN_TYPE(u32);
-DECLARE_BUILTIN_TYPE(i64);
-DECLARE_BUILTIN_TYPE(u64);
-DECLARE_BUILTIN_TYPE(float);
-DECLARE_BUILTIN_TYPE(double);
+// In 'clt' so that the typedefs (i8, u8...) can be named unqualified
+namespace clt
+{
+  DECLARE_BUILTIN_TYPE(char);
+  DECLARE_BUILTIN_TYPE(char8_t);
+  DECLARE_BUILTIN_TYPE(char16_t);
+  DECLARE_BUILTIN_TYPE(char32_t);
+  DECLARE_BUILTIN_TYPE(i8);
+  DECLARE_BUILTIN_TYPE(u8);
+  DECLARE_BUILTIN_TYPE(i16);
+  DECLARE_BUILTIN_TYPE(u16);
+  DECLARE_BUILTIN_TYPE(i32);
+  DECLARE_BUILTIN_TYPE(u32);
+  DECLARE_BUILTIN_TYPE(i64);
+  DECLARE_BUILTIN_TYPE(u64);
+  DECLARE_BUILTIN_TYPE(float);
+  DECLARE_BUILTIN_TYPE(double);
+} // namespace clt
 
 //We no longer need this macro
 #undef DECLARE_BUILTIN_TYPE
@@ -643,10 +683,8 @@ DECLARE_BUILTIN_TYPE(double);
   template<>                                                                        \
   struct clt::meta::is_contiguously_hashable<TYPE>                                  \
   {                                                                                 \
-    static constexpr bool value = reflect<TYPE>::members_type::template remove_if<  \
-                                      is_contiguously_hashable>::size               \
-                                      == 0                                          \
-                                  && !has_padding_v<TYPE>;                          \
+    static constexpr bool value =                                                   \
+        clt::meta::is_reflected_contiguously_hashable_v<TYPE>;                      \
   }
 
 #define COLT_DETAILS_EXPAND_ENUM(en) , en
@@ -668,6 +706,24 @@ DECLARE_BUILTIN_TYPE(double);
     static constexpr clt::meta::EntityKind value = clt::meta::EntityKind::IS_ENUM;                      \
   };                                                                                                    \
   template<>                                                                                            \
+  struct clt::meta::niche<namespace_name::name>                                                         \
+      : public clt::meta::details::enum_niche<                                                          \
+            namespace_name::name,                                                                       \
+            std::array{std::string_view{#first} COLT_FOR_EACH(                                          \
+                COLT_DETAILS_STRINGIZE_ENUM, __VA_ARGS__)}                                              \
+                .size()>                                                                                \
+  {                                                                                                     \
+  };                                                                                                    \
+  template<>                                                                                            \
+  struct clt::meta::dense_values<namespace_name::name>                                                  \
+      : public clt::meta::details::enum_dense_values<                                                   \
+            namespace_name::name,                                                                       \
+            std::array{std::string_view{#first} COLT_FOR_EACH(                                          \
+                COLT_DETAILS_STRINGIZE_ENUM, __VA_ARGS__)}                                              \
+                .size()>                                                                                \
+  {                                                                                                     \
+  };                                                                                                    \
+  template<>                                                                                            \
   struct clt::meta::reflect<namespace_name::name>                                                       \
   {                                                                                                     \
     using enum_type = std::underlying_type_t<namespace_name::name>;                                     \
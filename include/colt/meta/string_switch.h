@@ -0,0 +1,158 @@
+/*****************************************************************/ /**
+ * @file   string_switch.h
+ * @brief  Contains string_switch, used to dispatch on strings known at
+ *         compile-time (replacing chains of comparisons).
+ * The keys are hashed at compile-time: a minimal perfect hash of these
+ * hashes is built (and verified to be free of collisions), so that
+ * matching a string is one hash, one lookup and one comparison.
+ * The index of the matching key can then be used in a 'switch':
+ * @code{.cpp}
+ * using Command = meta::string_switch<"--", "-help">;
+ * switch (Command::match(arg))
+ * {
+ * case Command::index_of<"--">:
+ *   ...
+ * case Command::index_of<"-help">:
+ *   ...
+ * default: // Command::npos
+ *   ...
+ * }
+ * @endcode
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_META_STRING_SWITCH
+#define HG_META_STRING_SWITCH
+
+#include <array>
+#include <string_view>
+
+#include "colt/hash.h"
+#include "colt/meta/map.h"
+#include "colt/meta/string_literal.h"
+
+namespace clt::meta
+{
+  namespace details
+  {
+    template<typename T>
+    /// @brief Views over bytes (such as std::string_view or StringView)
+    concept byte_view = requires(const T& str) {
+      { str.data()[0] };
+      { str.size() } -> std::convertible_to<size_t>;
+    } && sizeof(*std::declval<const T&>().data()) == 1;
+
+    template<byte_view T>
+    /// @brief Returns the count of bytes of a view
+    /// @param str The view
+    /// @return The count of bytes of the view
+    constexpr size_t byte_len(const T& str) noexcept
+    {
+      if constexpr (requires { str.unit_len(); })
+        return str.unit_len();
+      else
+        return static_cast<size_t>(str.size());
+    }
+
+    template<hash_algorithm Algo, typename Byte>
+    /// @brief Hashes bytes (usable at compile-time)
+    /// @tparam Algo The hashing algorithm
+    /// @param ptr The beginning of the bytes
+    /// @param len The count of bytes
+    /// @return The hash of the bytes
+    constexpr u64 switch_hash(const Byte* ptr, size_t len) noexcept
+    {
+      Algo algo;
+      hash_units(algo, ptr, len);
+      return static_cast<u64>(static_cast<typename Algo::result_type>(algo));
+    }
+
+    template<typename T, size_t N>
+    /// @brief Check if an array contains the same value twice
+    /// @param array The array
+    /// @return True if two items are equal
+    constexpr bool has_duplicates(const std::array<T, N>& array) noexcept
+    {
+      for (size_t i = 0; i < N; i++)
+        for (size_t j = i + 1; j < N; j++)
+          if (array[i] == array[j])
+            return true;
+      return false;
+    }
+  } // namespace details
+
+  template<hash_algorithm Algo, StringLiteral... KEYS>
+  /// @brief Dispatches on strings known at compile-time (see string_switch).
+  /// @tparam Algo The hashing algorithm (usable in constant evaluation)
+  /// @tparam KEYS The strings to match
+  struct basic_string_switch
+  {
+    /// @brief The count of keys
+    static constexpr size_t size = sizeof...(KEYS);
+    /// @brief Returned by 'match' if no key matches
+    static constexpr size_t npos = size;
+
+    static_assert(size != 0, "string_switch requires at least one key!");
+    static_assert(
+        size <= PERFECT_HASH_MAX_SIZE, "Too many keys for a string_switch!");
+
+    /// @brief The keys
+    static constexpr std::array<std::string_view, size> keys = {
+        std::string_view{KEYS.value, KEYS.size()}...};
+    /// @brief The hash of each key
+    static constexpr std::array<u64, size> hashes = {
+        details::switch_hash<Algo>(KEYS.value, KEYS.size())...};
+
+    static_assert(!details::has_duplicates(keys), "Keys must be unique!");
+    static_assert(
+        !details::has_duplicates(hashes),
+        "Two keys have the same hash: use another hashing algorithm!");
+
+    /// @brief The perfect hash of the keys
+    static constexpr details::PerfectHashIndex<size> table{hashes};
+
+    static_assert(
+        table.is_valid, "No perfect hash of the keys was found with any seed!");
+
+    template<StringLiteral KEY>
+      requires((
+          (std::string_view{KEY.value, KEY.size()}
+           == std::string_view{KEYS.value, KEYS.size()})
+          || ...))
+    /// @brief The index of a key (which must be one of the keys)
+    static constexpr size_t index_of = []
+    {
+      size_t i = 0;
+      while (keys[i] != std::string_view{KEY.value, KEY.size()})
+        ++i;
+      return i;
+    }();
+
+    template<details::byte_view T>
+    /// @brief Returns the index of the key equal to a string
+    /// @param str The string to match
+    /// @return The index of the key equal to 'str' or npos if none
+    static constexpr size_t match(const T& str) noexcept
+    {
+      const size_t len   = details::byte_len(str);
+      const u64 hash     = details::switch_hash<Algo>(str.data(), len);
+      const size_t index = table.find(hash);
+      // (the hash check avoids comparing with the wrong key)
+      if (hashes[index] != hash || keys[index].size() != len)
+        return npos;
+      for (size_t i = 0; i < len; i++)
+        if (static_cast<u8>(str.data()[i]) != static_cast<u8>(keys[index][i]))
+          return npos;
+      return index;
+    }
+  };
+
+  template<StringLiteral... KEYS>
+  /// @brief Dispatches on strings known at compile-time, using the default
+  ///        hashing algorithm.
+  /// @tparam KEYS The strings to match
+  using string_switch = basic_string_switch<COLT_DEFAULT_HASH_ALGORITHM, KEYS...>;
+} // namespace clt::meta
+
+#endif // !HG_META_STRING_SWITCH
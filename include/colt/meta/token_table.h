@@ -0,0 +1,264 @@
+/*****************************************************************/ /**
+ * @file   token_table.h
+ * @brief  Contains token_table, a longest-match recognizer of tokens
+ *         known at compile-time (such as operators or keywords).
+ * A DFA recognizing the tokens is built at compile-time: each distinct
+ * byte of the tokens is mapped to a class (all the other bytes share the
+ * class 0, which leads to the dead state), so that the transition table
+ * only has a column per distinct byte of the tokens.
+ * Matching a token is then a table lookup per byte, without hashing or
+ * pointer chasing (as opposed to TrieMap::longest_prefix).
+ * @code{.cpp}
+ * using Operators = meta::token_table<"+", "++", "+=", "-", "->">;
+ * auto match = Operators::longest_match(str);
+ * if (match.is_value() && match->id == Operators::index_of<"->">)
+ *   ...
+ * @endcode
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_META_TOKEN_TABLE
+#define HG_META_TOKEN_TABLE
+
+#include <array>
+#include <limits>
+#include <string_view>
+
+#include "colt/dsa/option.h"
+#include "colt/meta/niche.h"
+#include "colt/meta/string_literal.h"
+#include "colt/meta/string_switch.h"
+
+namespace clt::meta
+{
+  /// @brief The result of token_table::longest_match
+  struct TokenMatch
+  {
+    /// @brief The index of the token in the table
+    size_t id;
+    /// @brief The length in bytes of the token (never 0)
+    size_t len;
+
+    /// @brief Compares two matches
+    friend constexpr bool operator==(const TokenMatch&, const TokenMatch&) =
+        default;
+  };
+
+  /// @brief Tokens are never empty: a length of 0 is a niche.
+  /// Option<TokenMatch> is the same size as TokenMatch (and usable in
+  /// constant evaluation).
+  template<>
+  struct niche<TokenMatch>
+  {
+    /// @brief The match of length 0
+    static constexpr size_t count = 1;
+
+    /// @brief Returns the niche (of length 0)
+    /// @return The niche
+    static constexpr TokenMatch make(size_t) noexcept { return {0, 0}; }
+
+    /// @brief Returns the index of the niche 'match'
+    /// @param match The match
+    /// @return 0 if 'match' is of length 0, else 1
+    static constexpr size_t index_of(const TokenMatch& match) noexcept
+    {
+      return match.len == 0 ? 0 : 1;
+    }
+  };
+
+  namespace details
+  {
+    /// @brief The state of a DFA from which no token can be matched
+    inline constexpr u16 DEAD_STATE = 0;
+    /// @brief The starting state of a DFA
+    inline constexpr u16 START_STATE = 1;
+
+    /// @brief The classes of the bytes of tokens
+    struct ByteClasses
+    {
+      /// @brief The class of each byte (0 for bytes not in any token)
+      std::array<u8, 256> of{};
+      /// @brief The count of classes (including the class 0)
+      size_t count = 1;
+      /// @brief False if the tokens use all the bytes
+      bool is_valid = true;
+    };
+
+    template<size_t N>
+    /// @brief Gives a class to each distinct byte of the tokens
+    /// @param tokens The tokens
+    /// @return The classes of the bytes
+    constexpr ByteClasses token_classes(
+        const std::array<std::string_view, N>& tokens) noexcept
+    {
+      ByteClasses ret;
+      for (auto token : tokens)
+      {
+        for (char c : token)
+        {
+          auto& cls = ret.of[static_cast<u8>(c)];
+          if (cls != 0)
+            continue;
+          if (ret.count == 256)
+            ret.is_valid = false;
+          else
+            cls = static_cast<u8>(ret.count++);
+        }
+      }
+      return ret;
+    }
+
+    template<size_t N>
+    /// @brief Returns the upper bound of the count of states of the DFA
+    /// @param tokens The tokens
+    /// @return The count of bytes of the tokens, plus the dead and start
+    ///         states
+    constexpr size_t max_token_states(
+        const std::array<std::string_view, N>& tokens) noexcept
+    {
+      size_t ret = 2;
+      for (auto token : tokens)
+        ret += token.size();
+      return ret;
+    }
+
+    template<size_t STATES, size_t CLASSES>
+    /// @brief The DFA recognizing tokens (a trie over the byte classes)
+    struct TokenDFA
+    {
+      /// @brief The next state of each (state, class)
+      std::array<u16, STATES * CLASSES> next{};
+      /// @brief The token accepted by each state plus one (0 if none)
+      std::array<u32, STATES> accept{};
+      /// @brief The count of states used
+      size_t count = START_STATE + 1;
+      /// @brief False if two tokens are equal
+      bool is_valid = true;
+    };
+
+    template<size_t STATES, size_t CLASSES, size_t N>
+    /// @brief Builds the DFA recognizing tokens
+    /// @param tokens The tokens
+    /// @param classes The classes of the bytes of the tokens
+    /// @return The DFA (whose count of states is at most STATES)
+    constexpr TokenDFA<STATES, CLASSES> build_token_dfa(
+        const std::array<std::string_view, N>& tokens,
+        const ByteClasses& classes) noexcept
+    {
+      TokenDFA<STATES, CLASSES> ret;
+      for (size_t id = 0; id < N; id++)
+      {
+        size_t state = START_STATE;
+        for (char c : tokens[id])
+        {
+          auto& next = ret.next[state * CLASSES + classes.of[static_cast<u8>(c)]];
+          if (next == DEAD_STATE)
+            next = static_cast<u16>(ret.count++);
+          state = next;
+        }
+        ret.is_valid &= ret.accept[state] == 0;
+        ret.accept[state] = static_cast<u32>(id + 1);
+      }
+      return ret;
+    }
+
+    template<size_t COUNT, size_t STATES, size_t CLASSES>
+    /// @brief Copies the states used by a DFA to a smaller DFA
+    /// @tparam COUNT The count of states used by the DFA
+    /// @param dfa The DFA
+    /// @return The DFA of COUNT states
+    constexpr TokenDFA<COUNT, CLASSES> shrink_token_dfa(
+        const TokenDFA<STATES, CLASSES>& dfa) noexcept
+    {
+      TokenDFA<COUNT, CLASSES> ret;
+      for (size_t i = 0; i < ret.next.size(); i++)
+        ret.next[i] = dfa.next[i];
+      for (size_t i = 0; i < ret.accept.size(); i++)
+        ret.accept[i] = dfa.accept[i];
+      ret.count    = dfa.count;
+      ret.is_valid = dfa.is_valid;
+      return ret;
+    }
+  } // namespace details
+
+  template<StringLiteral... KEYS>
+  /// @brief Longest-match recognizer of tokens known at compile-time.
+  /// The id of a token is its index in KEYS (see index_of).
+  /// @tparam KEYS The tokens (which must be unique and non-empty)
+  struct token_table
+  {
+    /// @brief The count of tokens
+    static constexpr size_t size = sizeof...(KEYS);
+
+    static_assert(size != 0, "token_table requires at least one token!");
+    static_assert(
+        ((KEYS.size() != 0) && ...), "Tokens of a token_table cannot be empty!");
+
+    /// @brief The tokens
+    static constexpr std::array<std::string_view, size> keys = {
+        std::string_view{KEYS.value, KEYS.size()}...};
+
+  private:
+    /// @brief The classes of the bytes
+    static constexpr details::ByteClasses classes = details::token_classes(keys);
+
+    static_assert(classes.is_valid, "Tokens cannot use all the bytes!");
+
+    /// @brief The DFA, with an upper bound on its count of states
+    static constexpr auto max_dfa =
+        details::build_token_dfa<details::max_token_states(keys), classes.count>(
+            keys, classes);
+
+    static_assert(max_dfa.is_valid, "Tokens must be unique!");
+    static_assert(
+        max_dfa.count <= std::numeric_limits<u16>::max(),
+        "Too many states in the DFA of the tokens!");
+
+    /// @brief The DFA recognizing the tokens (using the exact count of states)
+    static constexpr auto dfa = details::shrink_token_dfa<max_dfa.count>(max_dfa);
+
+  public:
+    /// @brief The count of states of the DFA (including the dead state)
+    static constexpr size_t state_count = dfa.count;
+
+    template<StringLiteral KEY>
+      requires((
+          (std::string_view{KEY.value, KEY.size()}
+           == std::string_view{KEYS.value, KEYS.size()})
+          || ...))
+    /// @brief The id of a token (which must be one of the tokens)
+    static constexpr size_t index_of = []
+    {
+      size_t i = 0;
+      while (keys[i] != std::string_view{KEY.value, KEY.size()})
+        ++i;
+      return i;
+    }();
+
+    template<details::byte_view T>
+    /// @brief Returns the longest token that is a prefix of 'str'
+    /// @param str The string to match
+    /// @return None if no token is a prefix of 'str', else the token
+    static constexpr Option<TokenMatch> longest_match(const T& str) noexcept
+    {
+      const size_t len = details::byte_len(str);
+      const auto ptr   = str.data();
+
+      Option<TokenMatch> ret = None;
+      size_t state           = details::START_STATE;
+      for (size_t i = 0; i < len; i++)
+      {
+        state =
+            dfa.next[state * classes.count + classes.of[static_cast<u8>(ptr[i])]];
+        if (state == details::DEAD_STATE)
+          break;
+        if (const u32 accept = dfa.accept[state]; accept != 0)
+          ret = TokenMatch{accept - size_t(1), i + 1};
+      }
+      return ret;
+    }
+  };
+} // namespace clt::meta
+
+#endif // !HG_META_TOKEN_TABLE
@@ -11,19 +11,16 @@
 #include <concepts>
 #include <utility>
 #include <compare>
+#include <limits>
 
 #include "fmt/format.h"
 #include "colt/dsa/option.h"
 #include "colt/typedefs.h"
 #include "colt/mem/composable_alloc.h"
+#include "colt/num/overflow.h"
 #include "gmp.h"
 
-#define COLT_MAKE_OPERATOR(op, mpz_fn, type, arg_expr)            \
-  BigInt& operator COLT_CONCAT(op, =)(type rhs) noexcept          \
-  {                                                               \
-    mpz_fn(storage, storage, arg_expr);                           \
-    return *this;                                                 \
-  }                                                               \
+#define COLT_MAKE_BINARY_OPERATOR(op, type)                       \
   friend BigInt operator op(const BigInt& lhs, type rhs) noexcept \
   {                                                               \
     BigInt result = lhs;                                          \
@@ -31,68 +28,722 @@
     return result;                                                \
   }
 
-#define COLT_MAKE_ASSIGNMENT(mpz_fn, type) \
-  BigInt& operator=(type rhs) noexcept     \
-  {                                        \
-    mpz_fn(storage, rhs);                  \
-    return *this;                          \
-  }
+#define COLT_MAKE_OPERATOR(op, small_fn, mpz_fn)                          \
+  BigInt& operator COLT_CONCAT(op, =)(const BigInt& rhs) noexcept         \
+  {                                                                       \
+    return apply(                                                         \
+        rhs, small_fn, [](mpz_ptr r, mpz_srcptr a, mpz_srcptr b) noexcept \
+        { mpz_fn(r, a, b); });                                            \
+  }                                                                       \
+  COLT_MAKE_BINARY_OPERATOR(op, const BigInt&)
 
-#define COLT_MAKE_OVERLOAD_OPERATOR_U32_BIGINT(op, mpz_fn)   \
-  COLT_MAKE_OPERATOR(op, COLT_CONCAT(mpz_fn, _ui), u32, rhs) \
-  COLT_MAKE_OPERATOR(op, mpz_fn, const BigInt&, rhs.storage)
+#define COLT_MAKE_INT_OPERATOR(op, small_fn, mpz_fn, type)          \
+  BigInt& operator COLT_CONCAT(op, =)(type rhs) noexcept            \
+  {                                                                 \
+    return apply_int(                                               \
+        rhs, small_fn, [](mpz_ptr r, mpz_srcptr a, type b) noexcept \
+        { mpz_fn(r, a, b); });                                      \
+  }                                                                 \
+  COLT_MAKE_BINARY_OPERATOR(op, type)
 
-#define COLT_MAKE_OVERLOAD_OPERATOR_U32_I32_BIGINT(op, mpz_fn) \
-  COLT_MAKE_OPERATOR(op, COLT_CONCAT(mpz_fn, _ui), u32, rhs)   \
-  COLT_MAKE_OPERATOR(op, COLT_CONCAT(mpz_fn, _si), i32, rhs)   \
-  COLT_MAKE_OPERATOR(op, mpz_fn, const BigInt&, rhs.storage)
+#define COLT_MAKE_OVERLOAD_OPERATOR_U32_BIGINT(op, small_fn, mpz_fn)  \
+  COLT_MAKE_INT_OPERATOR(op, small_fn, COLT_CONCAT(mpz_fn, _ui), u32) \
+  COLT_MAKE_OPERATOR(op, small_fn, mpz_fn)
 
-#define COLT_MAKE_OVERLOAD_ASSIGNMENT(mpz_fn)         \
-  COLT_MAKE_ASSIGNMENT(COLT_CONCAT(mpz_fn, _ui), u32) \
-  COLT_MAKE_ASSIGNMENT(COLT_CONCAT(mpz_fn, _si), i32) \
-  COLT_MAKE_ASSIGNMENT(COLT_CONCAT(mpz_fn, _d), f64)
+#define COLT_MAKE_OVERLOAD_OPERATOR_U32_I32_BIGINT(op, small_fn, mpz_fn) \
+  COLT_MAKE_INT_OPERATOR(op, small_fn, COLT_CONCAT(mpz_fn, _ui), u32)    \
+  COLT_MAKE_INT_OPERATOR(op, small_fn, COLT_CONCAT(mpz_fn, _si), i32)    \
+  COLT_MAKE_OPERATOR(op, small_fn, mpz_fn)
+
+/// @brief Evaluates the expression, then applies 'op' with any value
+///        accepted by 'Num::operator op='
+#define COLT_MAKE_EXPR_ANY_OPERATOR(op, Expr)                           \
+  template<typename T>                                                  \
+  friend Num operator op(const Expr& lhs, const T& rhs) noexcept        \
+    requires requires(Num& result, const T& value) {                    \
+      result COLT_CONCAT(op, =) value;                                  \
+    }                                                                   \
+  {                                                                     \
+    Num result = lhs;                                                   \
+    result COLT_CONCAT(op, =) rhs;                                      \
+    return result;                                                      \
+  }
+
+/// @brief Applies 'op' between an expression and a number, reusing the
+///        storage of the number if it is a temporary
+#define COLT_MAKE_EXPR_OPERATOR(op, Expr)                                  \
+  COLT_MAKE_EXPR_ANY_OPERATOR(op, Expr)                                    \
+  friend Num operator op(const Num& lhs, const Expr& rhs) noexcept         \
+    requires requires(Num& result, const Num& value) {                     \
+      result COLT_CONCAT(op, =) value;                                     \
+    }                                                                      \
+  {                                                                        \
+    Num result = lhs;                                                      \
+    result COLT_CONCAT(op, =) rhs;                                         \
+    return result;                                                         \
+  }                                                                        \
+  friend Num operator op(Num&& lhs, const Expr& rhs) noexcept              \
+    requires requires(Num& result, const Num& value) {                     \
+      result COLT_CONCAT(op, =) value;                                     \
+    }                                                                      \
+  {                                                                        \
+    lhs COLT_CONCAT(op, =) rhs;                                            \
+    return std::move(lhs);                                                 \
+  }                                                                        \
+  friend Num operator op(const Expr& lhs, Num&& rhs) noexcept              \
+    requires requires(Num& result, const Num& value) {                     \
+      result COLT_CONCAT(op, =) value;                                     \
+    }                                                                      \
+  {                                                                        \
+    Num result = lhs;                                                      \
+    result COLT_CONCAT(op, =) rhs;                                         \
+    return result;                                                         \
+  }
 
 namespace clt::num
 {
+  namespace details
+  {
+    /// @brief Returns the absolute value of an integer
+    /// @param value The integer
+    /// @return The absolute value (which does not overflow)
+    constexpr u64 magnitude(i64 value) noexcept
+    {
+      return value < 0 ? 0 - static_cast<u64>(value) : static_cast<u64>(value);
+    }
+
+    /// @brief Returns the count of digits of an integer in a base
+    /// @param value The absolute value of the integer
+    /// @param base The base
+    /// @return The count of digits
+    constexpr size_t digit_count(u64 value, int base) noexcept
+    {
+      size_t count = 1;
+      for (; value >= static_cast<u64>(base); value /= static_cast<u64>(base))
+        ++count;
+      return count;
+    }
+
+    /// @brief Sets an initialized mpz_t to a 64-bit integer
+    /// @param out The mpz_t
+    /// @param value The value
+    inline void mpz_set_i64(mpz_ptr out, i64 value) noexcept
+    {
+      // 'long' is 32-bit on Windows
+      if constexpr (sizeof(long) >= sizeof(i64))
+        mpz_set_si(out, static_cast<long>(value));
+      else
+      {
+        const u64 abs = magnitude(value);
+        mpz_import(out, 1, 1, sizeof(u64), 0, 0, &abs);
+        if (value < 0)
+          mpz_neg(out, out);
+      }
+    }
+
+    /// @brief Compares an mpz_t to a 64-bit integer
+    /// @param a The mpz_t
+    /// @param b The integer
+    /// @return Negative, zero or positive (as mpz_cmp)
+    inline int mpz_cmp_i64(mpz_srcptr a, i64 b) noexcept
+    {
+      // 'long' is 32-bit on Windows
+      if constexpr (sizeof(long) >= sizeof(i64))
+        return mpz_cmp_si(a, static_cast<long>(b));
+      else
+      {
+        mpz_t value;
+        mpz_init(value);
+        mpz_set_i64(value, b);
+        const int cmp = mpz_cmp(a, value);
+        mpz_clear(value);
+        return cmp;
+      }
+    }
+
+    /// @brief Converts an mpz_t to a 64-bit integer if it fits
+    /// @param in The mpz_t
+    /// @param out The value to which to write
+    /// @return False if the value does not fit
+    inline bool mpz_get_i64(mpz_srcptr in, i64& out) noexcept
+    {
+      if (mpz_sizeinbase(in, 2) > 63)
+        return false;
+      if constexpr (sizeof(long) >= sizeof(i64))
+        out = static_cast<i64>(mpz_get_si(in));
+      else
+      {
+        u64 abs = 0;
+        mpz_export(&abs, nullptr, 1, sizeof(u64), 0, 0, in);
+        out = mpz_sgn(in) < 0 ? -static_cast<i64>(abs) : static_cast<i64>(abs);
+      }
+      return true;
+    }
+
+    /// @brief Converts the result of a comparison to an ordering
+    /// @param cmp The result of the comparison
+    /// @return The ordering
+    constexpr std::strong_ordering to_ordering(int cmp) noexcept
+    {
+      if (cmp < 0)
+        return std::strong_ordering::less;
+      else if (cmp == 0)
+        return std::strong_ordering::equivalent;
+      else
+        return std::strong_ordering::greater;
+    }
+  } // namespace details
+
+  template<typename Num>
+  class MulAddExpr;
+
+  template<typename Num>
+  /// @brief Lazy product of two numbers (BigInt or BigRational), evaluated
+  /// in the storage of the number to which it is assigned (or converted).
+  /// Adding or subtracting a number results in a MulAddExpr, which is
+  /// evaluated using a single mpz_addmul or mpz_submul for BigInt.
+  /// Any other operation evaluates the product first.
+  /// Products of temporaries are never lazy: they are evaluated in the
+  /// storage of the temporary, so the expression only refers to lvalues.
+  /// @warning The expression stores references to its operands: prefer
+  ///          converting it to a number to storing it (using 'auto').
+  class MulExpr
+  {
+    /// @brief The left hand side
+    const Num& lhs;
+    /// @brief The right hand side
+    const Num& rhs;
+
+    friend Num;
+    friend class MulAddExpr<Num>;
+
+  public:
+    /// @brief Constructor
+    /// @param lhs The left hand side
+    /// @param rhs The right hand side
+    constexpr MulExpr(const Num& lhs, const Num& rhs) noexcept
+        : lhs(lhs)
+        , rhs(rhs)
+    {
+    }
+
+    /// @brief Evaluates the expression
+    /// @return The result
+    operator Num() const noexcept
+    {
+      Num result;
+      result = *this;
+      return result;
+    }
+
+    /// @brief Evaluates the expression
+    /// @return The result
+    Num eval() const noexcept { return *this; }
+
+    /// @brief Fused multiply-add
+    friend MulAddExpr<Num> operator+(const MulExpr& a, const Num& b) noexcept
+    {
+      return {b, false, a, false};
+    }
+    /// @brief Fused multiply-add
+    friend MulAddExpr<Num> operator+(const Num& a, const MulExpr& b) noexcept
+    {
+      return {a, false, b, false};
+    }
+    /// @brief Fused multiply-sub
+    friend MulAddExpr<Num> operator-(const MulExpr& a, const Num& b) noexcept
+    {
+      return {b, true, a, false};
+    }
+    /// @brief Fused multiply-sub
+    friend MulAddExpr<Num> operator-(const Num& a, const MulExpr& b) noexcept
+    {
+      return {a, false, b, true};
+    }
+    /// @brief Fused multiply-add in the storage of a temporary
+    friend Num operator+(const MulExpr& a, Num&& b) noexcept
+    {
+      b += a;
+      return std::move(b);
+    }
+    /// @brief Fused multiply-add in the storage of a temporary
+    friend Num operator+(Num&& a, const MulExpr& b) noexcept
+    {
+      a += b;
+      return std::move(a);
+    }
+    /// @brief Fused multiply-sub in the storage of a temporary
+    friend Num operator-(const MulExpr& a, Num&& b) noexcept
+    {
+      b -= a;
+      b.neg();
+      return std::move(b);
+    }
+    /// @brief Fused multiply-sub in the storage of a temporary
+    friend Num operator-(Num&& a, const MulExpr& b) noexcept
+    {
+      a -= b;
+      return std::move(a);
+    }
+
+    COLT_MAKE_EXPR_ANY_OPERATOR(+, MulExpr)
+    COLT_MAKE_EXPR_ANY_OPERATOR(-, MulExpr)
+    COLT_MAKE_EXPR_OPERATOR(*, MulExpr)
+    COLT_MAKE_EXPR_OPERATOR(/, MulExpr)
+    COLT_MAKE_EXPR_OPERATOR(%, MulExpr)
+    COLT_MAKE_EXPR_OPERATOR(&, MulExpr)
+    COLT_MAKE_EXPR_OPERATOR(|, MulExpr)
+    COLT_MAKE_EXPR_OPERATOR(^, MulExpr)
+    COLT_MAKE_EXPR_ANY_OPERATOR(<<, MulExpr)
+    COLT_MAKE_EXPR_ANY_OPERATOR(>>, MulExpr)
+
+    /// @brief Returns the negated result
+    /// @return The negated result
+    Num operator-() const noexcept
+    {
+      Num result = *this;
+      result.neg();
+      return result;
+    }
+
+    template<typename T>
+    /// @brief Compares the result
+    /// @param b The value to compare against
+    /// @return The result of the comparison
+    std::strong_ordering operator<=>(const T& b) const noexcept
+    {
+      return eval() <=> b;
+    }
+
+    template<typename T>
+    /// @brief Compares the result
+    /// @param b The value to compare against
+    /// @return The result of the comparison
+    bool operator==(const T& b) const noexcept
+    {
+      return eval() == b;
+    }
+  };
+
+  template<typename Num>
+  /// @brief Lazy '(+/-)addend (+/-) lhs * rhs', evaluated in the storage of
+  /// the number to which it is assigned (or converted).
+  /// For BigInt, this uses a single mpz_addmul or mpz_submul.
+  /// Any other operation evaluates the expression first.
+  /// @warning The expression stores references to its operands: prefer
+  ///          converting it to a number to storing it (using 'auto').
+  class MulAddExpr
+  {
+    /// @brief The addend
+    const Num& addend;
+    /// @brief The product
+    MulExpr<Num> product;
+    /// @brief True to subtract the addend
+    bool negate_addend;
+    /// @brief True to subtract the product
+    bool negate_product;
+
+    friend Num;
+
+  public:
+    /// @brief Constructor
+    /// @param addend The addend
+    /// @param negate_addend True to subtract the addend
+    /// @param product The product
+    /// @param negate_product True to subtract the product
+    constexpr MulAddExpr(
+        const Num& addend, bool negate_addend, MulExpr<Num> product,
+        bool negate_product) noexcept
+        : addend(addend)
+        , product(product)
+        , negate_addend(negate_addend)
+        , negate_product(negate_product)
+    {
+    }
+
+    /// @brief Evaluates the expression
+    /// @return The result
+    operator Num() const noexcept
+    {
+      Num result;
+      result = *this;
+      return result;
+    }
+
+    /// @brief Evaluates the expression
+    /// @return The result
+    Num eval() const noexcept { return *this; }
+
+    COLT_MAKE_EXPR_OPERATOR(+, MulAddExpr)
+    COLT_MAKE_EXPR_OPERATOR(-, MulAddExpr)
+    COLT_MAKE_EXPR_OPERATOR(*, MulAddExpr)
+    COLT_MAKE_EXPR_OPERATOR(/, MulAddExpr)
+    COLT_MAKE_EXPR_OPERATOR(%, MulAddExpr)
+    COLT_MAKE_EXPR_OPERATOR(&, MulAddExpr)
+    COLT_MAKE_EXPR_OPERATOR(|, MulAddExpr)
+    COLT_MAKE_EXPR_OPERATOR(^, MulAddExpr)
+    COLT_MAKE_EXPR_ANY_OPERATOR(<<, MulAddExpr)
+    COLT_MAKE_EXPR_ANY_OPERATOR(>>, MulAddExpr)
+
+    /// @brief Returns the negated result
+    /// @return The negated result
+    Num operator-() const noexcept
+    {
+      Num result = *this;
+      result.neg();
+      return result;
+    }
+
+    template<typename T>
+    /// @brief Compares the result
+    /// @param b The value to compare against
+    /// @return The result of the comparison
+    std::strong_ordering operator<=>(const T& b) const noexcept
+    {
+      return eval() <=> b;
+    }
+
+    template<typename T>
+    /// @brief Compares the result
+    /// @param b The value to compare against
+    /// @return The result of the comparison
+    bool operator==(const T& b) const noexcept
+    {
+      return eval() == b;
+    }
+  };
+
   /// @brief Represent a signed integer of arbitrary precision.
-  /// All BigInt allocate memory, thus avoid temporaries, and
-  /// always make use of '[+-*/]=' whenever possible.
+  /// Integers that fit in 64 bits are stored inline: operations on them
+  /// use the checked_* helpers, and only promote the integer to an mpz_t
+  /// (which allocates memory) on overflow. Big integers allocate memory,
+  /// thus avoid temporaries, and always make use of '[+-*/]=' whenever
+  /// possible.
+  /// The product of two BigInt is lazy (see MulExpr): 'x = a * b + c'
+  /// and 'x += a * b' are evaluated in 'x' using a single mpz_addmul.
   class BigInt
   {
-    mpz_t storage{};
+    /// @brief The storage of the integer
+    union Storage
+    {
+      /// @brief The value if stored inline
+      i64 small;
+      /// @brief The value if promoted
+      mpz_t big;
+    };
+
+    /// @brief The value (mutable as 'internal_storage' promotes it)
+    mutable Storage storage = {0};
+    /// @brief True if the value is stored inline
+    mutable bool is_small = true;
+
+    BigInt(mpz_t storage) noexcept
+        : is_small(false)
+    {
+      this->storage.big[0] = storage[0];
+    }
+
+    /// @brief Converts the value to an mpz_t if it is stored inline
+    void promote() const noexcept
+    {
+      if (!is_small)
+        return;
+      const i64 value = storage.small;
+      mpz_init(storage.big);
+      details::mpz_set_i64(storage.big, value);
+      is_small = false;
+    }
+
+    /// @brief Stores the value inline if it fits in 64 bits
+    void demote() noexcept
+    {
+      if (i64 value; !is_small && details::mpz_get_i64(storage.big, value))
+      {
+        mpz_clear(storage.big);
+        storage.small = value;
+        is_small      = true;
+      }
+    }
+
+    /// @brief Sets the value to an inline value
+    /// @param value The value
+    /// @return Self
+    BigInt& assign_small(i64 value) noexcept
+    {
+      if (!is_small)
+        mpz_clear(storage.big);
+      storage.small = value;
+      is_small      = true;
+      return *this;
+    }
+
+    template<typename Fn>
+    /// @brief Calls 'fn' with the value as an mpz_t (using a temporary
+    ///        if the value is stored inline)
+    /// @param fn The function to call with a mpz_srcptr
+    void with_mpz(Fn&& fn) const noexcept
+    {
+      if (!is_small)
+        return fn(static_cast<mpz_srcptr>(storage.big));
+      mpz_t tmp;
+      mpz_init(tmp);
+      details::mpz_set_i64(tmp, storage.small);
+      fn(static_cast<mpz_srcptr>(tmp));
+      mpz_clear(tmp);
+    }
+
+    template<typename SmallFn, typename MpzFn>
+    /// @brief Applies an operation, inline if it does not overflow
+    /// @param rhs The right hand side of the operation
+    /// @param small_fn The checked operation (returns true on overflow)
+    /// @param mpz_fn The operation on mpz_t
+    /// @return Self
+    BigInt& apply(const BigInt& rhs, SmallFn small_fn, MpzFn mpz_fn) noexcept
+    {
+      if (is_small && rhs.is_small)
+      {
+        if (i64 result; !small_fn(storage.small, rhs.storage.small, &result))
+          return assign_small(result);
+      }
+      // If 'rhs' is 'this', it is promoted too
+      promote();
+      rhs.with_mpz([&](mpz_srcptr value)
+                   { mpz_fn(storage.big, storage.big, value); });
+      return *this;
+    }
+
+    template<typename T, typename SmallFn, typename MpzFn>
+    /// @brief Applies an operation, inline if it does not overflow
+    /// @param rhs The right hand side of the operation
+    /// @param small_fn The checked operation (returns true on overflow)
+    /// @param mpz_fn The operation on mpz_t
+    /// @return Self
+    BigInt& apply_int(T rhs, SmallFn small_fn, MpzFn mpz_fn) noexcept
+    {
+      if (is_small)
+      {
+        if (i64 result; !small_fn(storage.small, static_cast<i64>(rhs), &result))
+          return assign_small(result);
+      }
+      promote();
+      mpz_fn(storage.big, storage.big, rhs);
+      return *this;
+    }
+
+    /// @brief Addition of inline values
+    /// @return True on overflow
+    static bool small_add(i64 a, i64 b, i64* result) noexcept
+    {
+      return checked_add(a, b, result);
+    }
+
+    /// @brief Subtraction of inline values
+    /// @return True on overflow
+    static bool small_sub(i64 a, i64 b, i64* result) noexcept
+    {
+      return checked_sub(a, b, result);
+    }
 
-    BigInt(mpz_t storage) noexcept { this->storage[0] = storage[0]; }
+    /// @brief Multiplication of inline values
+    /// @return True on overflow
+    static bool small_mul(i64 a, i64 b, i64* result) noexcept
+    {
+      return checked_mul(a, b, result);
+    }
+
+    /// @brief Truncated division (like mpz_tdiv_q) of inline values
+    /// @return True on overflow
+    static bool small_div(i64 a, i64 b, i64* result) noexcept
+    {
+      assert_true("Division by zero!", b != 0);
+      if (b == -1)
+        return checked_sub<i64>(0, a, result);
+      *result = a / b;
+      return false;
+    }
+
+    /// @brief Non-negative remainder (like mpz_mod) of inline values
+    /// @return False
+    static bool small_mod(i64 a, i64 b, i64* result) noexcept
+    {
+      assert_true("Division by zero!", b != 0);
+      i64 mod = b == -1 ? 0 : a % b;
+      if (mod < 0)
+        mod = b < 0 ? mod - b : mod + b;
+      *result = mod;
+      return false;
+    }
+
+    /// @brief Bitwise and of inline values
+    /// @return False
+    static bool small_and(i64 a, i64 b, i64* result) noexcept
+    {
+      *result = a & b;
+      return false;
+    }
+
+    /// @brief Bitwise or of inline values
+    /// @return False
+    static bool small_or(i64 a, i64 b, i64* result) noexcept
+    {
+      *result = a | b;
+      return false;
+    }
+
+    /// @brief Bitwise xor of inline values
+    /// @return False
+    static bool small_xor(i64 a, i64 b, i64* result) noexcept
+    {
+      *result = a ^ b;
+      return false;
+    }
+
+    /// @brief Left shift (like mpz_mul_2exp) of inline values
+    /// @return True on overflow
+    static bool small_shl(i64 a, i64 b, i64* result) noexcept
+    {
+      if (b < 63)
+        return checked_mul(a, i64{1} << b, result);
+      *result = 0;
+      return a != 0;
+    }
+
+    /// @brief Right shift rounding to -infinity (like mpz_fdiv_q_2exp) of
+    ///        inline values
+    /// @return False
+    static bool small_shr(i64 a, i64 b, i64* result) noexcept
+    {
+      *result = b < 63 ? a >> b : (a < 0 ? -1 : 0);
+      return false;
+    }
+
+    /// @brief Sets the value to '(+/-)addend (+/-) a * b'.
+    /// Uses mpz_addmul/mpz_submul if the value is the addend or does
+    /// not alias the operands.
+    /// @param addend The addend (or null)
+    /// @param negate_addend True to subtract the addend
+    /// @param a The left hand side of the product
+    /// @param b The right hand side of the product
+    /// @param negate_product True to subtract the product
+    /// @return Self
+    BigInt& fused_mul_add(
+        const BigInt* addend, bool negate_addend, const BigInt& a, const BigInt& b,
+        bool negate_product) noexcept
+    {
+      if (a.is_small && b.is_small && (addend == nullptr || addend->is_small))
+      {
+        i64 product, sum = addend == nullptr ? 0 : addend->storage.small;
+        if (!checked_mul(a.storage.small, b.storage.small, &product)
+            && !(negate_product && checked_sub<i64>(0, product, &product))
+            && !(negate_addend && checked_sub<i64>(0, sum, &sum))
+            && !checked_add(sum, product, &sum))
+          return assign_small(sum);
+      }
+      const bool fuse = addend == this || (this != &a && this != &b);
+      // Keeps the current mpz_t (even for an inline addend) to reuse it
+      promote();
+      if (fuse && addend == nullptr)
+        mpz_set_ui(storage.big, 0);
+      else if (fuse && addend != this && addend->is_small)
+        details::mpz_set_i64(storage.big, addend->storage.small);
+      else if (fuse && addend != this)
+        mpz_set(storage.big, addend->storage.big);
+      // -addend + product == -(addend - product): negating the addend
+      // first would modify the operands if they alias it
+      const bool submul = negate_product != negate_addend;
+      a.with_mpz(
+          [&](mpz_srcptr lhs)
+          {
+            b.with_mpz(
+                [&](mpz_srcptr rhs)
+                {
+                  if (!fuse)
+                    mpz_mul(storage.big, lhs, rhs);
+                  else if (submul)
+                    mpz_submul(storage.big, lhs, rhs);
+                  else
+                    mpz_addmul(storage.big, lhs, rhs);
+                });
+          });
+      if (fuse)
+        return negate_addend ? neg() : *this;
+      // 'this' is one of the operands: the product was computed first
+      if (negate_product)
+        neg();
+      if (addend != nullptr)
+        return negate_addend ? (*this -= *addend) : (*this += *addend);
+      return *this;
+    }
 
   public:
     /// @brief Constructor, sets the value to 0
-    BigInt() noexcept { mpz_init(storage); }
+    BigInt() noexcept = default;
     /// @brief Constructor, sets the value to 'value'
     /// @param value The initial value
-    explicit BigInt(i32 value) noexcept { mpz_init_set_si(storage, value); }
+    explicit BigInt(i32 value) noexcept
+        : storage{value}
+    {
+    }
     /// @brief Constructor, sets the value to 'value'
     /// @param value The initial value
-    explicit BigInt(u32 value) noexcept { mpz_init_set_ui(storage, value); }
+    explicit BigInt(u32 value) noexcept
+        : storage{value}
+    {
+    }
+    /// @brief Constructor, sets the value to 'value'
+    /// @param value The initial value
+    explicit BigInt(i64 value) noexcept
+        : storage{value}
+    {
+    }
     /// @brief Constructor, sets the value to 'value'
     /// @param value The initial value
-    explicit BigInt(double value) noexcept { mpz_init_set_d(storage, value); }
+    explicit BigInt(u64 value) noexcept
+    {
+      if (value <= static_cast<u64>(std::numeric_limits<i64>::max()))
+        storage.small = static_cast<i64>(value);
+      else
+      {
+        mpz_init(storage.big);
+        mpz_import(storage.big, 1, 1, sizeof(u64), 0, 0, &value);
+        is_small = false;
+      }
+    }
+    /// @brief Constructor, sets the value to 'value' (truncated)
+    /// @param value The initial value
+    explicit BigInt(double value) noexcept { *this = value; }
     /// @brief Copy constructor, sets the value to 'value'
     /// @param copy The initial value
-    BigInt(const BigInt& copy) noexcept { mpz_init_set(storage, copy.storage); }
+    BigInt(const BigInt& copy) noexcept
+        : is_small(copy.is_small)
+    {
+      if (is_small)
+        storage.small = copy.storage.small;
+      else
+        mpz_init_set(storage.big, copy.storage.big);
+    }
     /// @brief Copy assignment operator
     /// @param copy The value to copy
     /// @return Self
     BigInt& operator=(const BigInt& copy) noexcept
     {
       assert_true("Self assignment is prohibited!", this != &copy);
-      mpz_set(storage, copy.storage);
+      if (copy.is_small)
+        return assign_small(copy.storage.small);
+      if (is_small)
+        mpz_init_set(storage.big, copy.storage.big);
+      else
+        mpz_set(storage.big, copy.storage.big);
+      is_small = false;
       return *this;
     }
     /// @brief Move constructor
     /// @param move The initial value
     BigInt(BigInt&& move) noexcept
+        : storage(move.storage)
+        , is_small(std::exchange(move.is_small, true))
     {
-      mpz_init(storage);
-      mpz_swap(storage, move.storage);
+      move.storage.small = 0;
     }
     /// @brief Move assignment operator
     /// @param move The value to move
@@ -100,51 +751,151 @@ namespace clt::num
     BigInt& operator=(BigInt&& move) noexcept
     {
       assert_true("Self assignment is prohibited!", this != &move);
-      mpz_swap(storage, move.storage);
+      swap(move);
       return *this;
     }
 
-    COLT_MAKE_OVERLOAD_OPERATOR_U32_BIGINT(+, mpz_add);
+    COLT_MAKE_OVERLOAD_OPERATOR_U32_BIGINT(+, &small_add, mpz_add);
     template<typename T>
     BigInt& add(const T& value) noexcept
     {
       return *this += value;
     }
 
-    COLT_MAKE_OVERLOAD_OPERATOR_U32_BIGINT(-, mpz_sub);
+    COLT_MAKE_OVERLOAD_OPERATOR_U32_BIGINT(-, &small_sub, mpz_sub);
     template<typename T>
     BigInt& sub(const T& value) noexcept
     {
       return *this -= value;
     }
 
-    COLT_MAKE_OVERLOAD_OPERATOR_U32_I32_BIGINT(*, mpz_mul);
+    COLT_MAKE_INT_OPERATOR(*, &small_mul, mpz_mul_ui, u32)
+    COLT_MAKE_INT_OPERATOR(*, &small_mul, mpz_mul_si, i32)
+    /// @brief Multiplies by 'rhs'
+    /// @param rhs The right hand side
+    /// @return Self
+    BigInt& operator*=(const BigInt& rhs) noexcept
+    {
+      return apply(
+          rhs, &small_mul,
+          [](mpz_ptr r, mpz_srcptr a, mpz_srcptr b) noexcept { mpz_mul(r, a, b); });
+    }
+    /// @brief Lazy product (evaluated on assignment or conversion to BigInt)
+    /// @param lhs The left hand side
+    /// @param rhs The right hand side
+    /// @return The product expression
+    friend MulExpr<BigInt> operator*(const BigInt& lhs, const BigInt& rhs) noexcept
+    {
+      return {lhs, rhs};
+    }
+    /// @brief Product, evaluated in the storage of the temporary
+    /// @param lhs The left hand side
+    /// @param rhs The right hand side
+    /// @return The product
+    friend BigInt operator*(BigInt&& lhs, const BigInt& rhs) noexcept
+    {
+      lhs *= rhs;
+      return std::move(lhs);
+    }
+    /// @brief Product, evaluated in the storage of the temporary
+    /// @param lhs The left hand side
+    /// @param rhs The right hand side
+    /// @return The product
+    friend BigInt operator*(const BigInt& lhs, BigInt&& rhs) noexcept
+    {
+      rhs *= lhs;
+      return std::move(rhs);
+    }
+    /// @brief Product, evaluated in the storage of the temporary
+    /// @param lhs The left hand side
+    /// @param rhs The right hand side
+    /// @return The product
+    friend BigInt operator*(BigInt&& lhs, BigInt&& rhs) noexcept
+    {
+      lhs *= rhs;
+      return std::move(lhs);
+    }
+
+    /// @brief Assignment operator, evaluates a product in the current storage
+    /// @param expr The expression
+    /// @return Self
+    BigInt& operator=(const MulExpr<BigInt>& expr) noexcept
+    {
+      return fused_mul_add(nullptr, false, expr.lhs, expr.rhs, false);
+    }
+    /// @brief Assignment operator, evaluates a fused multiply-add in the
+    ///        current storage
+    /// @param expr The expression
+    /// @return Self
+    BigInt& operator=(const MulAddExpr<BigInt>& expr) noexcept
+    {
+      return fused_mul_add(
+          &expr.addend, expr.negate_addend, expr.product.lhs, expr.product.rhs,
+          expr.negate_product);
+    }
+    /// @brief Adds a product (using mpz_addmul)
+    /// @param expr The product
+    /// @return Self
+    BigInt& operator+=(const MulExpr<BigInt>& expr) noexcept
+    {
+      return fused_mul_add(this, false, expr.lhs, expr.rhs, false);
+    }
+    /// @brief Subtracts a product (using mpz_submul)
+    /// @param expr The product
+    /// @return Self
+    BigInt& operator-=(const MulExpr<BigInt>& expr) noexcept
+    {
+      return fused_mul_add(this, false, expr.lhs, expr.rhs, true);
+    }
+
     template<typename T>
     BigInt& mul(const T& value) noexcept
     {
       return *this *= value;
     }
 
-    COLT_MAKE_OVERLOAD_OPERATOR_U32_BIGINT(/, mpz_tdiv_q);
+    COLT_MAKE_OVERLOAD_OPERATOR_U32_BIGINT(/, &small_div, mpz_tdiv_q);
     template<typename T>
     BigInt& div(const T& value) noexcept
     {
       return *this /= value;
     }
 
-    COLT_MAKE_OPERATOR(%, mpz_mod, const BigInt&, rhs.storage)
-    COLT_MAKE_OPERATOR(%, mpz_mod_ui, u32, rhs)
+    COLT_MAKE_OPERATOR(%, &small_mod, mpz_mod)
+    COLT_MAKE_INT_OPERATOR(%, &small_mod, mpz_mod_ui, u32)
     template<typename T>
     BigInt& mod(const T& value) noexcept
     {
       return *this %= value;
     }
 
-    COLT_MAKE_OVERLOAD_ASSIGNMENT(mpz_set);
+    /// @brief Assignment operator
+    /// @param rhs The new value
+    /// @return Self
+    BigInt& operator=(u32 rhs) noexcept { return assign_small(rhs); }
+    /// @brief Assignment operator
+    /// @param rhs The new value
+    /// @return Self
+    BigInt& operator=(i32 rhs) noexcept { return assign_small(rhs); }
+    /// @brief Assignment operator
+    /// @param rhs The new value (truncated)
+    /// @return Self
+    BigInt& operator=(f64 rhs) noexcept
+    {
+      // NaN fails both comparisons
+      if (rhs >= -0x1p63 && rhs < 0x1p63)
+        return assign_small(static_cast<i64>(rhs));
+      promote();
+      mpz_set_d(storage.big, rhs);
+      return *this;
+    }
+
+    COLT_MAKE_INT_OPERATOR(<<, &small_shl, mpz_mul_2exp, u32)
+    COLT_MAKE_INT_OPERATOR(>>, &small_shr, mpz_fdiv_q_2exp, u32)
 
-    COLT_MAKE_OPERATOR(&, mpz_and, const BigInt&, rhs.storage);
-    COLT_MAKE_OPERATOR(|, mpz_ior, const BigInt&, rhs.storage);
-    COLT_MAKE_OPERATOR(^, mpz_xor, const BigInt&, rhs.storage);
+    COLT_MAKE_OPERATOR(&, &small_and, mpz_and);
+    COLT_MAKE_OPERATOR(|, &small_or, mpz_ior);
+    COLT_MAKE_OPERATOR(^, &small_xor, mpz_xor);
 
     BigInt& operator++() noexcept
     {
@@ -168,20 +919,31 @@ namespace clt::num
     BigInt operator--(int) noexcept
     {
       BigInt tmp = *this;
-      operator++();
+      operator--();
       return tmp;
     }
 
     /// @brief Returns the sign of the number.
     /// Return 0 for 0, +1 for positive numbers, and -1 for negative numbers.
     /// @return The sign of the number
-    int sgn() const noexcept { return mpz_sgn(storage); }
+    int sgn() const noexcept
+    {
+      if (is_small)
+        return (storage.small > 0) - (storage.small < 0);
+      return mpz_sgn(storage.big);
+    }
 
     /// @brief Negates the current number
     /// @return Self
     BigInt& neg() noexcept
     {
-      mpz_neg(storage, storage);
+      if (is_small && storage.small != std::numeric_limits<i64>::min())
+      {
+        storage.small = -storage.small;
+        return *this;
+      }
+      promote();
+      mpz_neg(storage.big, storage.big);
       return *this;
     }
 
@@ -199,13 +961,13 @@ namespace clt::num
     /// @return The result of the comparison
     std::strong_ordering operator<=>(const BigInt& b) const noexcept
     {
-      auto cmp = mpz_cmp(storage, b.storage);
-      if (cmp < 0)
-        return std::strong_ordering::less;
-      else if (cmp == 0)
-        return std::strong_ordering::equivalent;
-      else
-        return std::strong_ordering::greater;
+      if (is_small && b.is_small)
+        return storage.small <=> b.storage.small;
+      if (b.is_small)
+        return *this <=> b.storage.small;
+      if (is_small)
+        return 0 <=> (b <=> storage.small);
+      return details::to_ordering(mpz_cmp(storage.big, b.storage.big));
     }
 
     /// @brief Compare equal
@@ -221,13 +983,18 @@ namespace clt::num
     /// @return The result of the comparison
     std::strong_ordering operator<=>(double b) const noexcept
     {
-      auto cmp = mpz_cmp_d(storage, b);
-      if (cmp < 0)
-        return std::strong_ordering::less;
-      else if (cmp == 0)
-        return std::strong_ordering::equivalent;
-      else
-        return std::strong_ordering::greater;
+      if (is_small && b >= -0x1p63 && b < 0x1p63)
+      {
+        // Exact: 'trunc' is representable as a double
+        const i64 trunc = static_cast<i64>(b);
+        if (storage.small != trunc)
+          return storage.small <=> trunc;
+        return details::to_ordering(
+            (static_cast<double>(trunc) > b) - (static_cast<double>(trunc) < b));
+      }
+      int cmp;
+      with_mpz([&](mpz_srcptr value) { cmp = mpz_cmp_d(value, b); });
+      return details::to_ordering(cmp);
     }
 
     /// @brief Compare equal
@@ -243,13 +1010,9 @@ namespace clt::num
     /// @return The result of the comparison
     std::strong_ordering operator<=>(u32 b) const noexcept
     {
-      auto cmp = mpz_cmp_ui(storage, b);
-      if (cmp < 0)
-        return std::strong_ordering::less;
-      else if (cmp == 0)
-        return std::strong_ordering::equivalent;
-      else
-        return std::strong_ordering::greater;
+      if (is_small)
+        return storage.small <=> static_cast<i64>(b);
+      return details::to_ordering(mpz_cmp_ui(storage.big, b));
     }
 
     /// @brief Compare equal
@@ -265,13 +1028,9 @@ namespace clt::num
     /// @return The result of the comparison
     std::strong_ordering operator<=>(i32 b) const noexcept
     {
-      auto cmp = mpz_cmp_si(storage, b);
-      if (cmp < 0)
-        return std::strong_ordering::less;
-      else if (cmp == 0)
-        return std::strong_ordering::equivalent;
-      else
-        return std::strong_ordering::greater;
+      if (is_small)
+        return storage.small <=> static_cast<i64>(b);
+      return details::to_ordering(mpz_cmp_si(storage.big, b));
     }
 
     /// @brief Compare equal
@@ -282,6 +1041,40 @@ namespace clt::num
       return (*this <=> b) == std::strong_ordering::equivalent;
     }
 
+    /// @brief Comparison operator
+    /// @param b The other value to compare against
+    /// @return The result of the comparison
+    std::strong_ordering operator<=>(i64 b) const noexcept
+    {
+      if (is_small)
+        return storage.small <=> b;
+      // Never through a BigInt: 'operator<=>(const BigInt&)' calls this
+      return details::to_ordering(details::mpz_cmp_i64(storage.big, b));
+    }
+
+    /// @brief Compare equal
+    /// @param b The other value to compare against
+    /// @return The result of the comparison
+    bool operator==(i64 b) const noexcept
+    {
+      return (*this <=> b) == std::strong_ordering::equivalent;
+    }
+
+    /// @brief Check if the value is stored inline (without allocation)
+    /// @return True if the value is stored inline
+    bool is_inline() const noexcept { return is_small; }
+
+    /// @brief Converts the value to a 64-bit integer if it fits
+    /// @return None if the value does not fit in an i64
+    Option<i64> to_i64() const noexcept
+    {
+      if (is_small)
+        return storage.small;
+      if (i64 value; details::mpz_get_i64(storage.big, value))
+        return value;
+      return None;
+    }
+
     /// @brief Returns the number of characters needed to represent
     ///        the integer in a specific base.
     /// @param base The base used to represent the string
@@ -289,21 +1082,37 @@ namespace clt::num
     size_t str_size(int base = 10) const noexcept
     {
       //TODO: add check for base
-      const bool is_neg = mpz_sgn(storage) == -1;
-      return mpz_sizeinbase(storage, base) + (size_t)is_neg;
+      const bool is_neg = sgn() == -1;
+      if (is_small)
+        return details::digit_count(details::magnitude(storage.small), base)
+               + (size_t)is_neg;
+      return mpz_sizeinbase(storage.big, base) + (size_t)is_neg;
     }
 
     /// @brief Returns the internal mpz_t.
-    /// @warning Never call mpz_clear on the result
+    /// @warning Never call mpz_clear on the result. This promotes the
+    ///          value to an mpz_t if it is stored inline.
     /// @param out The out parameter to which to write the storage
-    void internal_storage(mpz_t out) const noexcept { out[0] = *storage; }
+    void internal_storage(mpz_t out) const noexcept
+    {
+      promote();
+      out[0] = *storage.big;
+    }
 
     /// @brief Swaps two BigInt
     /// @param with The BigInt to swap with
-    void swap(BigInt& with) noexcept { mpz_swap(storage, with.storage); }
+    void swap(BigInt& with) noexcept
+    {
+      std::swap(storage, with.storage);
+      std::swap(is_small, with.is_small);
+    }
 
     /// @brief Destructor, frees any resource used
-    ~BigInt() noexcept { mpz_clear(storage); }
+    ~BigInt() noexcept
+    {
+      if (!is_small)
+        mpz_clear(storage.big);
+    }
 
     /// @brief Creates a BigInt from a string
     /// Set the value of rop from str, a null-terminated C string in base base.
@@ -318,18 +1127,24 @@ namespace clt::num
     /// @return None if 'str' is not a valid string
     static Option<BigInt> from(const char* str, int base = 0) noexcept
     {
-      if (BigInt value; mpz_set_str(value.storage, str, base) == 0)
-        return std::move(value);
-      return None;
+      BigInt value;
+      value.promote();
+      if (mpz_set_str(value.storage.big, str, base) != 0)
+        return None;
+      value.demote();
+      return value;
     }
   };
+
 } // namespace clt::num
 
+#undef COLT_MAKE_BINARY_OPERATOR
 #undef COLT_MAKE_OPERATOR
-#undef COLT_MAKE_ASSIGNMENT
+#undef COLT_MAKE_INT_OPERATOR
 #undef COLT_MAKE_OVERLOAD_OPERATOR_U32_BIGINT
 #undef COLT_MAKE_OVERLOAD_OPERATOR_U32_I32_BIGINT
-#undef COLT_MAKE_OVERLOAD_ASSIGNMENT
+#undef COLT_MAKE_EXPR_ANY_OPERATOR
+#undef COLT_MAKE_EXPR_OPERATOR
 
 template<>
 /// @brief {fmt} specialization of BigInt
@@ -346,6 +1161,9 @@ struct fmt::formatter<clt::num::BigInt>
   auto format(const clt::num::BigInt& op, FormatContext& ctx) const
   {
     using namespace clt::mem;
+    // Inline values do not need GMP
+    if (auto value = op.to_i64(); value.is_value())
+      return fmt::format_to(ctx.out(), "{}", *value);
     // Use stack spaces if possible else use malloc
     FallbackAllocator<StackAllocator<2048, 1>, Mallocator> allocator;
     // + 1 for NUL terminator
@@ -366,4 +1184,26 @@ struct fmt::formatter<clt::num::BigInt>
   }
 };
 
+template<typename Num>
+/// @brief {fmt} specialization of MulExpr
+struct fmt::formatter<clt::num::MulExpr<Num>> : fmt::formatter<Num>
+{
+  template<typename FormatContext>
+  auto format(const clt::num::MulExpr<Num>& op, FormatContext& ctx) const
+  {
+    return fmt::formatter<Num>::format(op.eval(), ctx);
+  }
+};
+
+template<typename Num>
+/// @brief {fmt} specialization of MulAddExpr
+struct fmt::formatter<clt::num::MulAddExpr<Num>> : fmt::formatter<Num>
+{
+  template<typename FormatContext>
+  auto format(const clt::num::MulAddExpr<Num>& op, FormatContext& ctx) const
+  {
+    return fmt::formatter<Num>::format(op.eval(), ctx);
+  }
+};
+
 #endif // !HG_NUM_BIG_INT
@@ -11,87 +11,288 @@
 #include <concepts>
 #include <utility>
 #include <compare>
+#include <numeric>
 
 #include "big_int.h"
 
-#define COLT_MAKE_OPERATOR(op, mpq_fn, type, arg_expr)                      \
-  BigRational& operator COLT_CONCAT(op, =)(type rhs) noexcept               \
+#define COLT_MAKE_OPERATOR(op, small_fn, mpq_fn)                            \
+  BigRational& operator COLT_CONCAT(op, =)(const BigRational& rhs) noexcept \
   {                                                                         \
-    mpq_fn(storage, storage, arg_expr);                                     \
-    return *this;                                                           \
+    return apply(                                                           \
+        rhs, small_fn, [](mpq_ptr r, mpq_srcptr a, mpq_srcptr b) noexcept   \
+        { mpq_fn(r, a, b); });                                              \
   }                                                                         \
-  friend BigRational operator op(const BigRational& lhs, type rhs) noexcept \
+  friend BigRational operator op(                                           \
+      const BigRational& lhs, const BigRational& rhs) noexcept              \
   {                                                                         \
     BigRational result = lhs;                                               \
     result COLT_CONCAT(op, =) rhs;                                          \
     return result;                                                          \
   }
 
-#define COLT_MAKE_ASSIGNMENT(mpq_fn, type)  \
-  BigRational& operator=(type rhs) noexcept \
-  {                                         \
-    mpq_fn(storage, rhs);                   \
-    return *this;                           \
-  }
-
-#define COLT_MAKE_OVERLOAD_OPERATOR_BigRational(op, mpq_fn) \
-  COLT_MAKE_OPERATOR(op, mpq_fn, const BigRational&, rhs.storage)
-
-#define COLT_MAKE_OVERLOAD_ASSIGNMENT(mpz_fn) \
-  COLT_MAKE_ASSIGNMENT(COLT_CONCAT(mpz_fn, _d), f64)
-
 namespace clt::num
 {
-  /// @brief Represent a signed integer of arbitrary precision.
-  /// All BigRational allocate memory, thus avoid temporaries, and
+  /// @brief Represent a rational number of arbitrary precision.
+  /// Rationals whose numerator and denominator fit in 64 bits are stored
+  /// inline: operations on them use the checked_* helpers, and only
+  /// promote the rational to an mpq_t (which allocates memory) on overflow.
+  /// Big rationals allocate memory, thus avoid temporaries, and
   /// always make use of '[+-*/]=' whenever possible.
+  /// The product of two BigRational is lazy (see MulExpr): 'x = a * b + c'
+  /// is evaluated in the storage of 'x'.
   class BigRational
   {
-    mpq_t storage{};
+    /// @brief An inline rational in canonical form: the denominator
+    ///        is positive, and has no common factor with the numerator
+    struct Fraction
+    {
+      /// @brief The numerator
+      i64 num;
+      /// @brief The denominator (> 0)
+      i64 den;
+    };
+
+    /// @brief The storage of the rational
+    union Storage
+    {
+      /// @brief The value if stored inline
+      Fraction small;
+      /// @brief The value if promoted
+      mpq_t big;
+    };
+
+    /// @brief The value (mutable as 'internal_storage' promotes it)
+    mutable Storage storage = {Fraction{0, 1}};
+    /// @brief True if the value is stored inline
+    mutable bool is_small = true;
+
+    /// @brief Builds a canonical fraction
+    /// @param num The numerator
+    /// @param den The denominator (!= 0)
+    /// @param result The result to which to write
+    /// @return True on overflow
+    static bool make_small(i64 num, i64 den, Fraction* result) noexcept
+    {
+      assert_true("Division by zero!", den != 0);
+      if (den < 0
+          && (checked_sub<i64>(0, num, &num) || checked_sub<i64>(0, den, &den)))
+        return true;
+      const auto gcd = static_cast<i64>(
+          std::gcd(details::magnitude(num), static_cast<u64>(den)));
+      *result = {num / gcd, den / gcd};
+      return false;
+    }
+
+    /// @brief Sum of inline values
+    /// @return True on overflow
+    static bool small_add(Fraction a, Fraction b, Fraction* result) noexcept
+    {
+      const auto gcd = static_cast<i64>(
+          std::gcd(static_cast<u64>(a.den), static_cast<u64>(b.den)));
+      i64 lhs, rhs, num, den;
+      if (checked_mul(a.num, b.den / gcd, &lhs)
+          || checked_mul(b.num, a.den / gcd, &rhs) || checked_add(lhs, rhs, &num)
+          || checked_mul(a.den, b.den / gcd, &den))
+        return true;
+      return make_small(num, den, result);
+    }
+
+    /// @brief Difference of inline values
+    /// @return True on overflow
+    static bool small_sub(Fraction a, Fraction b, Fraction* result) noexcept
+    {
+      return checked_sub<i64>(0, b.num, &b.num) || small_add(a, b, result);
+    }
+
+    /// @brief Product of inline values
+    /// @return True on overflow
+    static bool small_mul(Fraction a, Fraction b, Fraction* result) noexcept
+    {
+      if (a.num == 0 || b.num == 0)
+      {
+        *result = {0, 1};
+        return false;
+      }
+      // Fractions are canonical: only cross factors can be simplified
+      const auto gcd_a = static_cast<i64>(
+          std::gcd(details::magnitude(a.num), static_cast<u64>(b.den)));
+      const auto gcd_b = static_cast<i64>(
+          std::gcd(details::magnitude(b.num), static_cast<u64>(a.den)));
+      return checked_mul(a.num / gcd_a, b.num / gcd_b, &result->num)
+             || checked_mul(a.den / gcd_b, b.den / gcd_a, &result->den);
+    }
+
+    /// @brief Quotient of inline values
+    /// @return True on overflow
+    static bool small_div(Fraction a, Fraction b, Fraction* result) noexcept
+    {
+      assert_true("Division by zero!", b.num != 0);
+      Fraction inverse = {b.den, b.num};
+      if (inverse.den < 0
+          && (checked_sub<i64>(0, inverse.num, &inverse.num)
+              || checked_sub<i64>(0, inverse.den, &inverse.den)))
+        return true;
+      return small_mul(a, inverse, result);
+    }
+
+    /// @brief Converts the value to an mpq_t if it is stored inline
+    void promote() const noexcept
+    {
+      if (!is_small)
+        return;
+      const Fraction value = storage.small;
+      mpq_init(storage.big);
+      details::mpz_set_i64(mpq_numref(storage.big), value.num);
+      details::mpz_set_i64(mpq_denref(storage.big), value.den);
+      is_small = false;
+    }
+
+    /// @brief Stores the value inline if its numerator and denominator
+    ///        fit in 64 bits
+    void demote() noexcept
+    {
+      Fraction value;
+      if (is_small || !details::mpz_get_i64(mpq_numref(storage.big), value.num)
+          || !details::mpz_get_i64(mpq_denref(storage.big), value.den))
+        return;
+      mpq_clear(storage.big);
+      storage.small = value;
+      is_small      = true;
+    }
+
+    /// @brief Sets the value to an inline value
+    /// @param value The value (in canonical form)
+    /// @return Self
+    BigRational& assign_small(Fraction value) noexcept
+    {
+      if (!is_small)
+        mpq_clear(storage.big);
+      storage.small = value;
+      is_small      = true;
+      return *this;
+    }
+
+    template<typename Fn>
+    /// @brief Calls 'fn' with the value as an mpq_t (using a temporary
+    ///        if the value is stored inline)
+    /// @param fn The function to call with a mpq_srcptr
+    void with_mpq(Fn&& fn) const noexcept
+    {
+      if (!is_small)
+        return fn(static_cast<mpq_srcptr>(storage.big));
+      BigRational tmp = *this;
+      tmp.promote();
+      fn(static_cast<mpq_srcptr>(tmp.storage.big));
+    }
+
+    template<typename SmallFn, typename MpqFn>
+    /// @brief Applies an operation, inline if it does not overflow
+    /// @param rhs The right hand side of the operation
+    /// @param small_fn The checked operation (returns true on overflow)
+    /// @param mpq_fn The operation on mpq_t
+    /// @return Self
+    BigRational& apply(
+        const BigRational& rhs, SmallFn small_fn, MpqFn mpq_fn) noexcept
+    {
+      if (is_small && rhs.is_small)
+      {
+        if (Fraction result; !small_fn(storage.small, rhs.storage.small, &result))
+          return assign_small(result);
+      }
+      // If 'rhs' is 'this', it is promoted too
+      promote();
+      rhs.with_mpq([&](mpq_srcptr value)
+                   { mpq_fn(storage.big, storage.big, value); });
+      return *this;
+    }
+
+    /// @brief Sets the value to '(+/-)addend (+/-) a * b'.
+    /// There is no fused multiply-add for mpq_t: the product is computed in
+    /// the current storage if it does not alias the operands.
+    /// @param addend The addend (or null)
+    /// @param negate_addend True to subtract the addend
+    /// @param a The left hand side of the product
+    /// @param b The right hand side of the product
+    /// @param negate_product True to subtract the product
+    /// @return Self
+    BigRational& fused_mul_add(
+        const BigRational* addend, bool negate_addend, const BigRational& a,
+        const BigRational& b, bool negate_product) noexcept
+    {
+      if (a.is_small && b.is_small && (addend == nullptr || addend->is_small))
+      {
+        Fraction product;
+        Fraction sum = addend == nullptr ? Fraction{0, 1} : addend->storage.small;
+        if (!small_mul(a.storage.small, b.storage.small, &product)
+            && !(negate_product && checked_sub<i64>(0, product.num, &product.num))
+            && !(negate_addend && checked_sub<i64>(0, sum.num, &sum.num))
+            && !small_add(sum, product, &sum))
+          return assign_small(sum);
+      }
+      if (this == addend || this == &a || this == &b)
+      {
+        BigRational result;
+        result.fused_mul_add(addend, negate_addend, a, b, negate_product);
+        swap(result);
+        return *this;
+      }
+      promote();
+      a.with_mpq(
+          [&](mpq_srcptr lhs)
+          { b.with_mpq([&](mpq_srcptr rhs) { mpq_mul(storage.big, lhs, rhs); }); });
+      if (negate_product)
+        mpq_neg(storage.big, storage.big);
+      if (addend == nullptr)
+        return *this;
+      return negate_addend ? (*this -= *addend) : (*this += *addend);
+    }
 
   public:
     /// @brief Constructor, sets the value to 0
-    BigRational() noexcept { mpq_init(storage); }
+    BigRational() noexcept = default;
     /// @brief Constructor, sets the value to 'value'
     /// @param num The numerator
     /// @param denom The denominator
     explicit BigRational(i32 num, u32 denom = 1) noexcept
     {
-      mpq_init(storage);
-      mpq_set_si(storage, num, denom);
-      mpq_canonicalize(storage);
+      make_small(num, denom, &storage.small);
     }
     /// @brief Constructor, sets the value to 'value'
     /// @param num The numerator
     /// @param denom The denominator
     explicit BigRational(u32 num, u32 denom = 1) noexcept
     {
-      mpq_init(storage);
-      mpq_set_ui(storage, num, denom);
-      mpq_canonicalize(storage);
+      make_small(num, denom, &storage.small);
     }
     /// @brief Constructor, sets the value to 'value'
     /// @param value The initial value
     explicit BigRational(const BigInt& value) noexcept
     {
+      if (auto small = value.to_i64(); small.is_value())
+      {
+        storage.small = {*small, 1};
+        return;
+      }
       mpz_t _value;
-      mpq_init(storage);
+      promote();
       value.internal_storage(_value);
-      mpq_set_z(storage, _value);
+      mpq_set_z(storage.big, _value);
     }
     /// @brief Constructor, sets the value to 'value'
     /// @param value The initial value
-    explicit BigRational(double value) noexcept
-    {
-      mpq_init(storage);
-      mpq_set_d(storage, value);
-    }
+    explicit BigRational(double value) noexcept { *this = value; }
     /// @brief Copy constructor, sets the value to 'value'
     /// @param copy The initial value
     BigRational(const BigRational& copy) noexcept
+        : is_small(copy.is_small)
     {
-      mpq_init(storage);
-      mpq_set(storage, copy.storage);
+      if (is_small)
+        storage.small = copy.storage.small;
+      else
+      {
+        mpq_init(storage.big);
+        mpq_set(storage.big, copy.storage.big);
+      }
     }
     /// @brief Copy assignment operator
     /// @param copy The value to copy
@@ -99,15 +300,21 @@ namespace clt::num
     BigRational& operator=(const BigRational& copy) noexcept
     {
       assert_true("Self assignment is prohibited!", this != &copy);
-      mpq_set(storage, copy.storage);
+      if (copy.is_small)
+        return assign_small(copy.storage.small);
+      if (is_small)
+        mpq_init(storage.big);
+      mpq_set(storage.big, copy.storage.big);
+      is_small = false;
       return *this;
     }
     /// @brief Move constructor
     /// @param move The initial value
     BigRational(BigRational&& move) noexcept
+        : storage(move.storage)
+        , is_small(std::exchange(move.is_small, true))
     {
-      mpq_init(storage);
-      mpq_swap(storage, move.storage);
+      move.storage.small = {0, 1};
     }
     /// @brief Move assignment operator
     /// @param move The value to move
@@ -115,39 +322,128 @@ namespace clt::num
     BigRational& operator=(BigRational&& move) noexcept
     {
       assert_true("Self assignment is prohibited!", this != &move);
-      mpq_swap(storage, move.storage);
+      swap(move);
       return *this;
     }
 
-    COLT_MAKE_OVERLOAD_OPERATOR_BigRational(+, mpq_add);
+    COLT_MAKE_OPERATOR(+, &small_add, mpq_add);
     template<typename T>
     BigRational& add(const T& value) noexcept
     {
       return *this += value;
     }
 
-    COLT_MAKE_OVERLOAD_OPERATOR_BigRational(-, mpq_sub);
+    COLT_MAKE_OPERATOR(-, &small_sub, mpq_sub);
     template<typename T>
     BigRational& sub(const T& value) noexcept
     {
       return *this -= value;
     }
 
-    COLT_MAKE_OVERLOAD_OPERATOR_BigRational(*, mpq_mul);
+    /// @brief Multiplies by 'rhs'
+    /// @param rhs The right hand side
+    /// @return Self
+    BigRational& operator*=(const BigRational& rhs) noexcept
+    {
+      return apply(
+          rhs, &small_mul,
+          [](mpq_ptr r, mpq_srcptr a, mpq_srcptr b) noexcept { mpq_mul(r, a, b); });
+    }
+    /// @brief Lazy product (evaluated on assignment or conversion to
+    ///        BigRational)
+    /// @param lhs The left hand side
+    /// @param rhs The right hand side
+    /// @return The product expression
+    friend MulExpr<BigRational> operator*(
+        const BigRational& lhs, const BigRational& rhs) noexcept
+    {
+      return {lhs, rhs};
+    }
+    /// @brief Product, evaluated in the storage of the temporary
+    /// @param lhs The left hand side
+    /// @param rhs The right hand side
+    /// @return The product
+    friend BigRational operator*(BigRational&& lhs, const BigRational& rhs) noexcept
+    {
+      lhs *= rhs;
+      return std::move(lhs);
+    }
+    /// @brief Product, evaluated in the storage of the temporary
+    /// @param lhs The left hand side
+    /// @param rhs The right hand side
+    /// @return The product
+    friend BigRational operator*(const BigRational& lhs, BigRational&& rhs) noexcept
+    {
+      rhs *= lhs;
+      return std::move(rhs);
+    }
+    /// @brief Product, evaluated in the storage of the temporary
+    /// @param lhs The left hand side
+    /// @param rhs The right hand side
+    /// @return The product
+    friend BigRational operator*(BigRational&& lhs, BigRational&& rhs) noexcept
+    {
+      lhs *= rhs;
+      return std::move(lhs);
+    }
     template<typename T>
     BigRational& mul(const T& value) noexcept
     {
       return *this *= value;
     }
 
-    COLT_MAKE_OVERLOAD_OPERATOR_BigRational(/, mpq_div);
+    /// @brief Assignment operator, evaluates a product in the current storage
+    /// @param expr The expression
+    /// @return Self
+    BigRational& operator=(const MulExpr<BigRational>& expr) noexcept
+    {
+      return fused_mul_add(nullptr, false, expr.lhs, expr.rhs, false);
+    }
+    /// @brief Assignment operator, evaluates a multiply-add in the current
+    ///        storage
+    /// @param expr The expression
+    /// @return Self
+    BigRational& operator=(const MulAddExpr<BigRational>& expr) noexcept
+    {
+      return fused_mul_add(
+          &expr.addend, expr.negate_addend, expr.product.lhs, expr.product.rhs,
+          expr.negate_product);
+    }
+    /// @brief Adds a product
+    /// @param expr The product
+    /// @return Self
+    BigRational& operator+=(const MulExpr<BigRational>& expr) noexcept
+    {
+      return fused_mul_add(this, false, expr.lhs, expr.rhs, false);
+    }
+    /// @brief Subtracts a product
+    /// @param expr The product
+    /// @return Self
+    BigRational& operator-=(const MulExpr<BigRational>& expr) noexcept
+    {
+      return fused_mul_add(this, false, expr.lhs, expr.rhs, true);
+    }
+
+    COLT_MAKE_OPERATOR(/, &small_div, mpq_div);
     template<typename T>
     BigRational& div(const T& value) noexcept
     {
       return *this /= value;
     }
 
-    COLT_MAKE_OVERLOAD_ASSIGNMENT(mpq_set);
+    /// @brief Assignment operator
+    /// @param rhs The new value (converted exactly)
+    /// @return Self
+    BigRational& operator=(f64 rhs) noexcept
+    {
+      // NaN fails both comparisons
+      if (rhs >= -0x1p63 && rhs < 0x1p63 && static_cast<i64>(rhs) == rhs)
+        return assign_small({static_cast<i64>(rhs), 1});
+      promote();
+      mpq_set_d(storage.big, rhs);
+      demote();
+      return *this;
+    }
 
     BigRational& operator++() noexcept
     {
@@ -171,20 +467,31 @@ namespace clt::num
     BigRational operator--(int) noexcept
     {
       BigRational tmp = *this;
-      operator++();
+      operator--();
       return tmp;
     }
 
     /// @brief Returns the sign of the number.
     /// Return 0 for 0, +1 for positive numbers, and -1 for negative numbers.
     /// @return The sign of the number
-    int sgn() const noexcept { return mpq_sgn(storage); }
+    int sgn() const noexcept
+    {
+      if (is_small)
+        return (storage.small.num > 0) - (storage.small.num < 0);
+      return mpq_sgn(storage.big);
+    }
 
     /// @brief Negates the current number
     /// @return Self
     BigRational& neg() noexcept
     {
-      mpq_neg(storage, storage);
+      if (is_small && storage.small.num != std::numeric_limits<i64>::min())
+      {
+        storage.small.num = -storage.small.num;
+        return *this;
+      }
+      promote();
+      mpq_neg(storage.big, storage.big);
       return *this;
     }
 
@@ -202,7 +509,11 @@ namespace clt::num
     /// @return The result of the comparison
     bool operator==(const BigRational& b) const noexcept
     {
-      return mpq_equal(storage, b.storage);
+      // Inline values are canonical
+      if (is_small && b.is_small)
+        return storage.small.num == b.storage.small.num
+               && storage.small.den == b.storage.small.den;
+      return (*this <=> b) == std::strong_ordering::equivalent;
     }
 
     /// @brief Comparison operator
@@ -210,15 +521,24 @@ namespace clt::num
     /// @return The result of the comparison
     std::strong_ordering operator<=>(const BigRational& b) const noexcept
     {
-      auto cmp = mpq_cmp(storage, b.storage);
-      if (cmp < 0)
-        return std::strong_ordering::less;
-      else if (cmp == 0)
-        return std::strong_ordering::equivalent;
-      else
-        return std::strong_ordering::greater;
+      if (is_small && b.is_small)
+      {
+        i64 lhs, rhs;
+        if (!checked_mul(storage.small.num, b.storage.small.den, &lhs)
+            && !checked_mul(b.storage.small.num, storage.small.den, &rhs))
+          return lhs <=> rhs;
+      }
+      int cmp;
+      with_mpq(
+          [&](mpq_srcptr lhs)
+          { b.with_mpq([&](mpq_srcptr rhs) { cmp = mpq_cmp(lhs, rhs); }); });
+      return details::to_ordering(cmp);
     }
 
+    /// @brief Check if the value is stored inline (without allocation)
+    /// @return True if the value is stored inline
+    bool is_inline() const noexcept { return is_small; }
+
     /// @brief Returns the number of characters needed to represent
     ///        the integer in a specific base.
     /// @param base The base used to represent the string
@@ -226,22 +546,48 @@ namespace clt::num
     size_t str_size(int base = 10) const noexcept
     {
       //TODO: add check for base
-      const bool is_neg = mpq_sgn(storage) == -1;
-      return mpz_sizeinbase(mpq_numref(storage), base) + 1 + (size_t)is_neg
-             + mpz_sizeinbase(mpq_denref(storage), base);
+      const bool is_neg = sgn() == -1;
+      if (is_small)
+        return details::digit_count(details::magnitude(storage.small.num), base) + 1
+               + (size_t)is_neg
+               + details::digit_count(static_cast<u64>(storage.small.den), base);
+      return mpz_sizeinbase(mpq_numref(storage.big), base) + 1 + (size_t)is_neg
+             + mpz_sizeinbase(mpq_denref(storage.big), base);
     }
 
     /// @brief Returns the internal mpq_t.
-    /// @warning Never call mpq_clear on the result
+    /// @warning Never call mpq_clear on the result. This promotes the
+    ///          value to an mpq_t if it is stored inline.
     /// @param out The out parameter to which to write the storage
-    void internal_storage(mpq_t out) const noexcept { out[0] = *storage; }
+    void internal_storage(mpq_t out) const noexcept
+    {
+      promote();
+      out[0] = *storage.big;
+    }
+
+    /// @brief Returns the inline numerator and denominator
+    /// @return None if the value is not stored inline
+    Option<std::pair<i64, i64>> to_fraction() const noexcept
+    {
+      if (is_small)
+        return std::pair{storage.small.num, storage.small.den};
+      return None;
+    }
 
     /// @brief Swaps two BigRational
     /// @param with The BigRational to swap with
-    void swap(BigRational& with) noexcept { mpq_swap(storage, with.storage); }
+    void swap(BigRational& with) noexcept
+    {
+      std::swap(storage, with.storage);
+      std::swap(is_small, with.is_small);
+    }
 
     /// @brief Destructor, frees any resource used
-    ~BigRational() noexcept { mpq_clear(storage); }
+    ~BigRational() noexcept
+    {
+      if (!is_small)
+        mpq_clear(storage.big);
+    }
 
     /// @brief Creates a BigRational from a string (integer or fraction separated by '/')
     /// Set the value of rop from str, a null-terminated C string in base base.
@@ -256,20 +602,21 @@ namespace clt::num
     /// @return None if 'str' is not a valid string
     static Option<BigRational> from(const char* str, int base = 0) noexcept
     {
-      if (BigRational value; mpq_set_str(value.storage, str, base) == 0)
-      {
-        mpq_canonicalize(value.storage);
-        return std::move(value);
-      }
-      return None;
+      BigRational value;
+      value.promote();
+      if (mpq_set_str(value.storage.big, str, base) != 0)
+        return None;
+      // A zero denominator would make mpq_canonicalize divide by zero
+      if (mpz_sgn(mpq_denref(value.storage.big)) == 0)
+        return None;
+      mpq_canonicalize(value.storage.big);
+      value.demote();
+      return value;
     }
   };
 } // namespace clt::num
 
 #undef COLT_MAKE_OPERATOR
-#undef COLT_MAKE_ASSIGNMENT
-#undef COLT_MAKE_OVERLOAD_OPERATOR_BigRational
-#undef COLT_MAKE_OVERLOAD_ASSIGNMENT
 
 template<>
 /// @brief {fmt} specialization of BigRational
@@ -286,6 +633,13 @@ struct fmt::formatter<clt::num::BigRational>
   auto format(const clt::num::BigRational& op, FormatContext& ctx) const
   {
     using namespace clt::mem;
+    // Inline values do not need GMP
+    if (auto value = op.to_fraction(); value.is_value())
+    {
+      if (value->second == 1)
+        return fmt::format_to(ctx.out(), "{}", value->first);
+      return fmt::format_to(ctx.out(), "{}/{}", value->first, value->second);
+    }
     // Use stack spaces if possible else use malloc
     FallbackAllocator<StackAllocator<2048, 1>, Mallocator> allocator;
     // + 1 for NUL terminator
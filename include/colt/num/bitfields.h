@@ -3,6 +3,9 @@
  * @brief  Contains portable bitfield helpers.
  * The bitfield has zero-overhead and compiles to the same code
  * as using a normal bitfield.
+ * `unpack_many` and `pack_many` extract or insert a single field
+ * over arrays of Bitfields, and BitfieldsColumns converts arrays of
+ * Bitfields to one column per field (struct of arrays).
  * 
  * @author RPC
  * @date   August 2024
@@ -10,13 +13,16 @@
 #ifndef HG_BIT_BITFIELDS
 #define HG_BIT_BITFIELDS
 
+#include <algorithm>
 #include <concepts>
 
 #include "colt/num/math.h"
 #include "colt/dsa/common.h"
 #include "colt/meta/traits.h"
+#include "colt/meta/niche.h"
 #include "colt/typedefs.h"
 #include "colt/hash.h"
+#include "colt/algo/detect_simd.h"
 
 namespace clt
 {
@@ -74,8 +80,6 @@ namespace clt
 
     /// @brief The type of the field ID
     using index_t = typename Field0::type;
-    /// @brief The number of fields
-    static constexpr size_t field_count = 1 + sizeof...(Fields);
 
     /// @brief The underlying storage
     Ty storage = {0};
@@ -127,7 +131,7 @@ namespace clt
     /// @tparam index The field index (starting at 0)
     /// @param value The value to assign for that field
     template<u64 index>
-    void set_field(Ty value) noexcept
+    constexpr void set_field(Ty value) noexcept
     {
       const auto info = field_info(index);
       // Set the bits whose value to modify to 0
@@ -142,12 +146,50 @@ namespace clt
     /// @param ...value The value to use to initialize the fields
     template<size_t... Is, std::convertible_to<Ty>... Ints>
       requires(sizeof...(Is) == sizeof...(Ints))
-    void set_fields(std::index_sequence<Is...>, Ints... value) noexcept
+    constexpr void set_fields(std::index_sequence<Is...>, Ints... value) noexcept
     {
       (set_field<Is + 1>(value), ...);
     }
 
   public:
+    /// @brief The underlying type
+    using underlying_type = Ty;
+    /// @brief The type used to identify the fields
+    using name_t = index_t;
+    /// @brief The number of fields
+    static constexpr size_t field_count = 1 + sizeof...(Fields);
+
+    /// @brief Returns the name of the field at index 'index'
+    /// @tparam index The field index (starting at 0)
+    /// @return The name of the field
+    template<size_t index>
+      requires(index < field_count)
+    static consteval name_t field_name() noexcept
+    {
+      constexpr name_t NAMES[] = {Field0::value, Fields::value...};
+      return NAMES[index];
+    }
+
+    /// @brief Returns the offset (from the least significant bit) of a field
+    /// @tparam index The ID of the field
+    /// @return The offset of the field
+    template<auto index>
+      requires std::same_as<index_t, decltype(index)>
+    static consteval u64 field_offset() noexcept
+    {
+      return field_info<index>().first;
+    }
+
+    /// @brief Returns the size in bits of a field
+    /// @tparam index The ID of the field
+    /// @return The size of the field
+    template<auto index>
+      requires std::same_as<index_t, decltype(index)>
+    static consteval u64 field_size() noexcept
+    {
+      return field_info<index>().second;
+    }
+
     /// @brief Constructs an empty Bitfields (set to all zeros)
     constexpr Bitfields() noexcept
         : storage(0)
@@ -216,6 +258,212 @@ namespace clt
       return archive(self.storage);
     }
   };
+
+  /// @brief Check if a type is a specialization of 'Bitfields'
+  template<typename T>
+  concept BitfieldsType = requires {
+    typename T::underlying_type;
+    typename T::name_t;
+    T::field_count;
+  } && sizeof(T) == sizeof(typename T::underlying_type);
+
+  namespace details
+  {
+    /// @brief Extracts the field 'index' of each Bitfields of 'from'
+    /// @tparam B The Bitfields type
+    /// @tparam index The ID of the field
+    /// @param from The Bitfields
+    /// @param to The result (of the same size)
+    /// @param size The count of Bitfields
+    template<BitfieldsType B, auto index>
+    constexpr void unpack_default(const B* from, u64* to, size_t size) noexcept
+    {
+      // The shift and mask are constants: this loop is vectorized
+      for (size_t i = 0; i < size; i++)
+        to[i] = static_cast<u64>(from[i].template get<index>());
+    }
+
+    /// @brief Inserts the field 'index' of each Bitfields of 'to'
+    /// @tparam B The Bitfields type
+    /// @tparam index The ID of the field
+    /// @param from The values of the field
+    /// @param to The Bitfields to modify (of the same size)
+    /// @param size The count of Bitfields
+    template<BitfieldsType B, auto index>
+    constexpr void pack_default(const u64* from, B* to, size_t size) noexcept
+    {
+      using Ty = typename B::underlying_type;
+      for (size_t i = 0; i < size; i++)
+        to[i].template set<index>(static_cast<Ty>(from[i]));
+    }
+
+#if defined(COLT_x86_64)
+    /// @brief AVX2 version of 'unpack_default' (256-bit shifts and masks)
+    template<BitfieldsType B, auto index>
+    COLT_FORCE_AVX2 void unpack_AVX2(const B* from, u64* to, size_t size) noexcept
+    {
+      for (size_t i = 0; i < size; i++)
+        to[i] = static_cast<u64>(from[i].template get<index>());
+    }
+
+    /// @brief AVX2 version of 'pack_default' (256-bit shifts and masks)
+    template<BitfieldsType B, auto index>
+    COLT_FORCE_AVX2 void pack_AVX2(const u64* from, B* to, size_t size) noexcept
+    {
+      using Ty = typename B::underlying_type;
+      for (size_t i = 0; i < size; i++)
+        to[i].template set<index>(static_cast<Ty>(from[i]));
+    }
+#endif // COLT_x86_64
+
+    /// @brief Chooses the implementation of 'unpack_many' (once) and calls it
+    template<BitfieldsType B, auto index>
+    void unpack_dispatch(const B* from, u64* to, size_t size) noexcept
+    {
+#if defined(COLT_x86_64)
+      static const auto FN =
+          choose_simd_implementation<simd_flag::AVX2, simd_flag::DEFAULT>{}(
+              &unpack_AVX2<B, index>, &unpack_default<B, index>);
+      (*FN)(from, to, size);
+#else
+      unpack_default<B, index>(from, to, size);
+#endif // COLT_x86_64
+    }
+
+    /// @brief Chooses the implementation of 'pack_many' (once) and calls it
+    template<BitfieldsType B, auto index>
+    void pack_dispatch(const u64* from, B* to, size_t size) noexcept
+    {
+#if defined(COLT_x86_64)
+      static const auto FN =
+          choose_simd_implementation<simd_flag::AVX2, simd_flag::DEFAULT>{}(
+              &pack_AVX2<B, index>, &pack_default<B, index>);
+      (*FN)(from, to, size);
+#else
+      pack_default<B, index>(from, to, size);
+#endif // COLT_x86_64
+    }
+  } // namespace details
+
+  template<auto index, BitfieldsType B>
+  /// @brief Extracts the field 'index' of all the Bitfields of 'from'.
+  /// This is equivalent to `to[i] = from[i].get<index>()`.
+  /// @tparam index The ID of the field
+  /// @tparam B The Bitfields type
+  /// @param from The Bitfields
+  /// @param to The values of the field (of the same size as 'from')
+  /// @note 'std::span<const B>' is used rather than 'View<B>' as the
+  ///       latter cannot be used to deduce 'B'.
+  constexpr void unpack_many(std::span<const B> from, Span<u64> to) noexcept
+  {
+    assert_true(
+        "'from' and 'to' must have the same size!", from.size() == to.size());
+    if (std::is_constant_evaluated())
+      details::unpack_default<B, index>(from.data(), to.data(), from.size());
+    else
+      details::unpack_dispatch<B, index>(from.data(), to.data(), from.size());
+  }
+
+  template<auto index, BitfieldsType B>
+  /// @brief Inserts the field 'index' of all the Bitfields of 'to'.
+  /// This is equivalent to `to[i].set<index>(from[i])`: only as much
+  /// bits as the field can store are kept, the other fields are unchanged.
+  /// @tparam index The ID of the field
+  /// @tparam B The Bitfields type
+  /// @param from The values of the field
+  /// @param to The Bitfields to modify (of the same size as 'from')
+  constexpr void pack_many(View<u64> from, Span<B> to) noexcept
+  {
+    assert_true(
+        "'from' and 'to' must have the same size!", from.size() == to.size());
+    if (std::is_constant_evaluated())
+      details::pack_default<B, index>(from.data(), to.data(), from.size());
+    else
+      details::pack_dispatch<B, index>(from.data(), to.data(), from.size());
+  }
+
+  template<BitfieldsType B>
+  /// @brief Struct of arrays view of Bitfields: one column per field.
+  /// The columns are provided by the user, in the order of the fields.
+  /// @code{.cpp}
+  /// u64 opcodes[N], payloads[N], paddings[N];
+  /// auto columns = BitfieldsColumns<Type>{opcodes, payloads, paddings};
+  /// columns.unpack(instructions);
+  /// // ... process 'columns.column<FieldName::OpCode>()'
+  /// columns.pack(instructions);
+  /// @endcode
+  /// @tparam B The Bitfields type
+  class BitfieldsColumns
+  {
+    /// @brief The name type of the fields
+    using name_t = typename B::name_t;
+
+    /// @brief The columns (in the order of the fields)
+    std::array<Span<u64>, B::field_count> columns;
+
+    /// @brief Returns the position of the field of ID 'index'
+    /// @tparam index The ID of the field
+    /// @return The position of the field, or 'field_count' if not a field
+    template<name_t index>
+    static consteval size_t position_of() noexcept
+    {
+      return []<size_t... Is>(std::index_sequence<Is...>)
+      {
+        size_t ret = B::field_count;
+        ((B::template field_name<Is>() == index ? (ret = Is, 0) : 0), ...);
+        return ret;
+      }(std::make_index_sequence<B::field_count>{});
+    }
+
+  public:
+    template<std::convertible_to<Span<u64>>... Spans>
+      requires(sizeof...(Spans) == B::field_count)
+    /// @brief Constructs the columns
+    /// @param ...spans The columns (one per field, all of the same size)
+    constexpr BitfieldsColumns(Spans&&... spans) noexcept
+        : columns{Span<u64>(spans)...}
+    {
+      assert_true(
+          "All the columns must have the same size!",
+          std::ranges::all_of(
+              columns, [&](auto col) { return col.size() == size(); }));
+    }
+
+    /// @brief Returns the count of Bitfields in each column
+    /// @return The count of rows
+    constexpr size_t size() const noexcept { return columns[0].size(); }
+
+    /// @brief Returns the column of the field of ID 'index'
+    /// @tparam index The ID of the field
+    /// @return The column
+    template<name_t index>
+      requires(position_of<index>() != B::field_count)
+    constexpr Span<u64> column() const noexcept
+    {
+      return columns[position_of<index>()];
+    }
+
+    /// @brief Extracts all the fields of 'from' into the columns
+    /// @param from The Bitfields (of size 'size()')
+    constexpr void unpack(View<B> from) const noexcept
+    {
+      [&]<size_t... Is>(std::index_sequence<Is...>)
+      {
+        (unpack_many<B::template field_name<Is>()>(from, columns[Is]), ...);
+      }(std::make_index_sequence<B::field_count>{});
+    }
+
+    /// @brief Writes all the fields of the columns to 'to'
+    /// @param to The Bitfields (of size 'size()')
+    constexpr void pack(Span<B> to) const noexcept
+    {
+      [&]<size_t... Is>(std::index_sequence<Is...>)
+      {
+        (pack_many<B::template field_name<Is>()>(View<u64>{columns[Is]}, to),
+         ...);
+      }(std::make_index_sequence<B::field_count>{});
+    }
+  };
 } // namespace clt::bit
 
 namespace clt::meta
@@ -225,6 +473,61 @@ namespace clt::meta
       : public std::true_type
   {
   };
+
+  /// @brief Declares the field of a Bitfields whose non-zero values are
+  /// never used (usually a padding field), which gives niches to the
+  /// Bitfields: Option<B> is then the same size as B.
+  /// @code{.cpp}
+  /// template<>
+  /// struct clt::meta::bitfields_niche_field<Instruction>
+  /// {
+  ///   static constexpr auto value = FieldName::Padding;
+  /// };
+  /// @endcode
+  /// @tparam B The Bitfields
+  template<typename B>
+  struct bitfields_niche_field
+  {
+  };
+
+  /// @brief The niches of a Bitfields are the non-zero values of the field
+  /// declared by bitfields_niche_field.
+  template<std::unsigned_integral Ty, typename Field0, typename... Fields>
+    requires requires {
+      bitfields_niche_field<clt::Bitfields<Ty, Field0, Fields...>>::value;
+    }
+  struct niche<clt::Bitfields<Ty, Field0, Fields...>>
+  {
+    /// @brief The Bitfields type
+    using bitfields_t = clt::Bitfields<Ty, Field0, Fields...>;
+    /// @brief The name of the field whose non-zero values are niches
+    static constexpr auto FIELD = bitfields_niche_field<bitfields_t>::value;
+    /// @brief The size of that field
+    static constexpr u64 FIELD_SIZE = bitfields_t::template field_size<FIELD>();
+
+    /// @brief The non-zero values of the field
+    static constexpr size_t count =
+        FIELD_SIZE >= 64 ? SIZE_MAX : ((size_t)1 << FIELD_SIZE) - 1;
+
+    /// @brief Returns the niche 'i'
+    /// @param i The index of the niche
+    /// @return A Bitfields whose field is 'i + 1' (and other fields 0)
+    static constexpr bitfields_t make(size_t i) noexcept
+    {
+      bitfields_t ret;
+      ret.template set<FIELD>(static_cast<Ty>(i + 1));
+      return ret;
+    }
+
+    /// @brief Returns the index of the niche 'value'
+    /// @param value The Bitfields
+    /// @return The index of the niche or 'count' if not a niche
+    static constexpr size_t index_of(const bitfields_t& value) noexcept
+    {
+      const auto field = value.template get<FIELD>();
+      return field == 0 ? count : static_cast<size_t>(field) - 1;
+    }
+  };
 } // namespace clt::meta
 
 #endif // !HG_BIT_BITFIELDS
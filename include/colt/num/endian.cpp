@@ -0,0 +1,171 @@
+/*****************************************************************/ /**
+ * @file   endian.cpp
+ * @brief  Contains the SIMD implementations of `bswap_copy`.
+ * Each vector is loaded, its bytes are reversed inside each integer using
+ * a byte shuffle (pshufb on SSE4.2/AVX2, vrev on NEON), then stored: the
+ * conversion can be done in place.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "endian.h"
+#include "colt/algo/detect_simd.h"
+
+#if defined(COLT_x86_64)
+  #include <immintrin.h>
+#endif // COLT_x86_64
+
+/// @brief Function byteswapping 'size' integers
+template<typename T>
+using bswap_t = void (*)(const T* from, T* to, size_t size) noexcept;
+
+#pragma region // DEFAULT: bswap_copy
+
+/// @brief Integer by integer implementation
+/// @tparam T The integer type
+template<typename T>
+static void bswap_default(const T* from, T* to, size_t size) noexcept
+{
+  for (size_t i = 0; i < size; i++)
+    to[i] = clt::byteswap(from[i]);
+}
+
+#pragma endregion
+
+#if defined(COLT_x86_64)
+
+  #pragma region // bswap_copy SSE42 AVX2
+
+/// @brief Returns the byte in a 16 bytes lane that becomes byte 'i'
+/// @tparam T The integer type
+/// @param i The index of the byte
+/// @return The index of the byte to shuffle in position 'i'
+template<typename T>
+static constexpr char shuffle_index(size_t i) noexcept
+{
+  return static_cast<char>(
+      i / sizeof(T) * sizeof(T) + sizeof(T) - 1 - i % sizeof(T));
+}
+
+/// @brief SSE4.2 implementation (pshufb is part of SSSE3)
+/// @tparam T The integer type (16, 32 or 64-bit)
+template<typename T>
+static COLT_FORCE_SSE42 void bswap_SSE42(const T* from, T* to, size_t size) noexcept
+{
+  constexpr size_t LANES = sizeof(__m128i) / sizeof(T);
+  const __m128i mask     = _mm_setr_epi8(
+      shuffle_index<T>(0), shuffle_index<T>(1), shuffle_index<T>(2),
+      shuffle_index<T>(3), shuffle_index<T>(4), shuffle_index<T>(5),
+      shuffle_index<T>(6), shuffle_index<T>(7), shuffle_index<T>(8),
+      shuffle_index<T>(9), shuffle_index<T>(10), shuffle_index<T>(11),
+      shuffle_index<T>(12), shuffle_index<T>(13), shuffle_index<T>(14),
+      shuffle_index<T>(15));
+  size_t i = 0;
+  for (; i + LANES <= size; i += LANES)
+  {
+    const __m128i values = _mm_loadu_si128((const __m128i*)(from + i));
+    _mm_storeu_si128((__m128i*)(to + i), _mm_shuffle_epi8(values, mask));
+  }
+  bswap_default(from + i, to + i, size - i);
+}
+
+/// @brief AVX2 implementation (the shuffle is done on each 16 bytes lane)
+/// @tparam T The integer type (16, 32 or 64-bit)
+template<typename T>
+static COLT_FORCE_AVX2 void bswap_AVX2(const T* from, T* to, size_t size) noexcept
+{
+  constexpr size_t LANES = sizeof(__m256i) / sizeof(T);
+  const __m256i mask     = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+      shuffle_index<T>(0), shuffle_index<T>(1), shuffle_index<T>(2),
+      shuffle_index<T>(3), shuffle_index<T>(4), shuffle_index<T>(5),
+      shuffle_index<T>(6), shuffle_index<T>(7), shuffle_index<T>(8),
+      shuffle_index<T>(9), shuffle_index<T>(10), shuffle_index<T>(11),
+      shuffle_index<T>(12), shuffle_index<T>(13), shuffle_index<T>(14),
+      shuffle_index<T>(15)));
+  size_t i = 0;
+  // Two vectors per iteration: the loop is bound by loads and stores
+  for (; i + 2 * LANES <= size; i += 2 * LANES)
+  {
+    const __m256i a = _mm256_loadu_si256((const __m256i*)(from + i));
+    const __m256i b = _mm256_loadu_si256((const __m256i*)(from + i + LANES));
+    _mm256_storeu_si256((__m256i*)(to + i), _mm256_shuffle_epi8(a, mask));
+    _mm256_storeu_si256((__m256i*)(to + i + LANES), _mm256_shuffle_epi8(b, mask));
+  }
+  if (i + LANES <= size)
+  {
+    const __m256i a = _mm256_loadu_si256((const __m256i*)(from + i));
+    _mm256_storeu_si256((__m256i*)(to + i), _mm256_shuffle_epi8(a, mask));
+    i += LANES;
+  }
+  bswap_default(from + i, to + i, size - i);
+}
+
+  #pragma endregion
+
+#elif defined(COLT_ARM_7or8)
+
+  #pragma region // bswap_copy NEON
+
+/// @brief NEON implementation
+/// @tparam T The integer type (16, 32 or 64-bit)
+template<typename T>
+static COLT_FORCE_NEON void bswap_NEON(const T* from, T* to, size_t size) noexcept
+{
+  constexpr size_t LANES = sizeof(uint8x16_t) / sizeof(T);
+  size_t i               = 0;
+  for (; i + LANES <= size; i += LANES)
+  {
+    const uint8x16_t values = vld1q_u8((const clt::u8*)(from + i));
+    uint8x16_t result;
+    if constexpr (sizeof(T) == 2)
+      result = vrev16q_u8(values);
+    else if constexpr (sizeof(T) == 4)
+      result = vrev32q_u8(values);
+    else
+      result = vrev64q_u8(values);
+    vst1q_u8((clt::u8*)(to + i), result);
+  }
+  bswap_default(from + i, to + i, size - i);
+}
+
+  #pragma endregion
+
+#endif // COLT_x86_64
+
+/// @brief Chooses the implementation (once) and calls it
+/// @tparam T The integer type (16, 32 or 64-bit)
+template<typename T>
+static void bswap_dispatch(const T* from, T* to, size_t size) noexcept
+{
+  using namespace clt;
+#if defined(COLT_x86_64)
+  static const bswap_t<T> FN = choose_simd_implementation<
+      simd_flag::AVX2, simd_flag::SSE42, simd_flag::DEFAULT>{}(
+      &bswap_AVX2<T>, &bswap_SSE42<T>, &bswap_default<T>);
+#elif defined(COLT_ARM_7or8)
+  static const bswap_t<T> FN =
+      choose_simd_implementation<simd_flag::NEON, simd_flag::DEFAULT>{}(
+          &bswap_NEON<T>, &bswap_default<T>);
+#else
+  static constexpr bswap_t<T> FN = &bswap_default<T>;
+#endif // COLT_x86_64
+  (*FN)(from, to, size);
+}
+
+namespace clt::details
+{
+  void bswap_copy(const u16* from, u16* to, size_t size) noexcept
+  {
+    bswap_dispatch(from, to, size);
+  }
+
+  void bswap_copy(const u32* from, u32* to, size_t size) noexcept
+  {
+    bswap_dispatch(from, to, size);
+  }
+
+  void bswap_copy(const u64* from, u64* to, size_t size) noexcept
+  {
+    bswap_dispatch(from, to, size);
+  }
+} // namespace clt::details
@@ -0,0 +1,122 @@
+/*****************************************************************/ /**
+ * @file   endian.h
+ * @brief  Contains bswap_span and convert_endian, which convert the
+ * endianness of whole spans of integers (vectorized using SSE4.2/AVX2
+ * byte shuffles or NEON byte reversals).
+ * Use them rather than a loop of `byteswap`/`btoh` when loading or
+ * writing many values, such as big-endian object files or UTF-16BE text.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_NUM_ENDIAN
+#define HG_NUM_ENDIAN
+
+#include <algorithm>
+#include <cstring>
+#include <concepts>
+
+#include "colt/typedefs.h"
+
+namespace clt
+{
+  namespace details
+  {
+    /// @brief Byteswaps 'size' integers of 'from' to 'to' (which may be equal)
+    /// @param from The integers to byteswap
+    /// @param to The result (which must not partially overlap 'from')
+    /// @param size The count of integers
+    COLTCPP_EXPORT void bswap_copy(const u16* from, u16* to, size_t size) noexcept;
+    /// @brief Byteswaps 'size' integers of 'from' to 'to' (which may be equal)
+    /// @param from The integers to byteswap
+    /// @param to The result (which must not partially overlap 'from')
+    /// @param size The count of integers
+    COLTCPP_EXPORT void bswap_copy(const u32* from, u32* to, size_t size) noexcept;
+    /// @brief Byteswaps 'size' integers of 'from' to 'to' (which may be equal)
+    /// @param from The integers to byteswap
+    /// @param to The result (which must not partially overlap 'from')
+    /// @param size The count of integers
+    COLTCPP_EXPORT void bswap_copy(const u64* from, u64* to, size_t size) noexcept;
+
+    template<std::unsigned_integral T>
+    /// @brief Calls the 'bswap_copy' overload of the size of T
+    /// @param from The integers to byteswap
+    /// @param to The result (which must not partially overlap 'from')
+    /// @param size The count of integers
+    void bswap_sized(const T* from, T* to, size_t size) noexcept
+    {
+      if constexpr (sizeof(T) == 2)
+        bswap_copy(
+            reinterpret_cast<const u16*>(from), reinterpret_cast<u16*>(to), size);
+      else if constexpr (sizeof(T) == 4)
+        bswap_copy(
+            reinterpret_cast<const u32*>(from), reinterpret_cast<u32*>(to), size);
+      else if constexpr (sizeof(T) == 8)
+        bswap_copy(
+            reinterpret_cast<const u64*>(from), reinterpret_cast<u64*>(to), size);
+      else
+      {
+        for (size_t i = 0; i < size; i++)
+          to[i] = byteswap(from[i]);
+      }
+    }
+  } // namespace details
+
+  template<std::unsigned_integral T>
+  /// @brief Swaps the bytes of all the integers of a span, in place.
+  /// This is equivalent to applying `byteswap` to each integer.
+  /// @tparam T The unsigned integer type
+  /// @param values The values whose bytes to swap
+  constexpr void bswap_span(Span<T> values) noexcept
+  {
+    if constexpr (sizeof(T) > 1)
+    {
+      if (std::is_constant_evaluated())
+      {
+        for (auto& i : values)
+          i = byteswap(i);
+      }
+      else
+        details::bswap_sized(values.data(), values.data(), values.size());
+    }
+  }
+
+  template<std::unsigned_integral T>
+  /// @brief Converts integers encoded in the 'from_endian' endianness to
+  /// the 'to_endian' endianness.
+  /// As an example, `convert_endian(file, values, big, native)` reads
+  /// big-endian values.
+  /// @tparam T The unsigned integer type
+  /// @param from The values to convert
+  /// @param to The result (of the same size, may be equal to 'from')
+  /// @param from_endian The endianness of 'from'
+  /// @param to_endian The endianness of the result
+  constexpr void convert_endian(
+      View<T> from, Span<T> to, TargetEndian from_endian,
+      TargetEndian to_endian) noexcept
+  {
+    assert_true(
+        "'from' and 'to' must have the same size!", from.size() == to.size());
+    if (sizeof(T) == 1 || from_endian == to_endian)
+    {
+      if (from.data() == to.data())
+        return;
+      if (std::is_constant_evaluated())
+        std::copy(from.begin(), from.end(), to.begin());
+      else
+        std::memcpy(to.data(), from.data(), from.size_bytes());
+    }
+    else if constexpr (sizeof(T) > 1)
+    {
+      if (std::is_constant_evaluated())
+      {
+        for (size_t i = 0; i < from.size(); i++)
+          to[i] = byteswap(from[i]);
+      }
+      else
+        details::bswap_sized(from.data(), to.data(), from.size());
+    }
+  }
+} // namespace clt
+
+#endif // !HG_NUM_ENDIAN
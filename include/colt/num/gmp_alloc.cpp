@@ -0,0 +1,125 @@
+#include "gmp_alloc.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "gmp.h"
+
+namespace clt::num::details
+{
+  /// @brief The allocator used by GMP (null if GMP uses its own functions)
+  static const GmpAllocatorNode* current_node = nullptr;
+  /// @brief The allocator set by 'set_gmp_allocator'
+  static GmpAllocatorNode root_node = {};
+
+  /// @brief The functions used by GMP before installing an allocator
+  static void* (*fallback_alloc)(size_t)                  = nullptr;
+  static void* (*fallback_realloc)(void*, size_t, size_t) = nullptr;
+  static void (*fallback_free)(void*, size_t)             = nullptr;
+
+  /// @brief Returns the installed allocator that owns a block.
+  /// Allocators that do not provide 'owns' are assumed to own the block.
+  /// @param blk The block
+  /// @return The allocator or null if the fallback functions own the block
+  static const GmpAllocatorNode* owner_of(mem::MemBlock blk) noexcept
+  {
+    for (auto node = current_node; node != nullptr; node = node->previous)
+    {
+      if (!node->alloc.can_own() || node->alloc.owns(blk))
+        return node;
+    }
+    return nullptr;
+  }
+
+  /// @brief Allocates a block (GMP does not handle allocation failures)
+  /// @param node The allocator
+  /// @param size The size of the block
+  /// @return The block
+  static void* allocate(const GmpAllocatorNode& node, size_t size) noexcept
+  {
+    auto blk = node.alloc.alloc(size);
+    if (blk.is_null() && size != 0)
+    {
+      std::fputs("GMP: allocation failed!\n", stderr);
+      std::abort();
+    }
+    return blk.ptr();
+  }
+
+  static void* gmp_alloc(size_t size) noexcept
+  {
+    return allocate(*current_node, size);
+  }
+
+  static void gmp_free(void* ptr, size_t size) noexcept
+  {
+    if (auto owner = owner_of({ptr, size}); owner != nullptr)
+      owner->alloc.dealloc({ptr, size});
+    else
+      fallback_free(ptr, size);
+  }
+
+  static void* gmp_realloc(void* ptr, size_t old_size, size_t new_size) noexcept
+  {
+    // Blocks stay in the allocator that owns them: big numbers created
+    // before a ScopedGmpAllocator remain valid after it
+    auto owner = owner_of({ptr, old_size});
+    if (owner == nullptr)
+      return fallback_realloc(ptr, old_size, new_size);
+    mem::MemBlock blk = {ptr, old_size};
+    if (owner->alloc.expand(blk, new_size) || owner->alloc.realloc(blk, new_size))
+      return blk.ptr();
+    void* result = allocate(*owner, new_size);
+    std::memcpy(result, ptr, clt::min(old_size, new_size));
+    owner->alloc.dealloc({ptr, old_size});
+    return result;
+  }
+
+  /// @brief Installs an allocator
+  /// @param node The allocator (or null to restore the fallback functions)
+  static void install(const GmpAllocatorNode* node) noexcept
+  {
+    if (current_node == nullptr)
+      mp_get_memory_functions(&fallback_alloc, &fallback_realloc, &fallback_free);
+    current_node = node;
+    if (node == nullptr)
+      mp_set_memory_functions(fallback_alloc, fallback_realloc, fallback_free);
+    else
+      mp_set_memory_functions(&gmp_alloc, &gmp_realloc, &gmp_free);
+  }
+} // namespace clt::num::details
+
+namespace clt::num
+{
+  void set_gmp_allocator(mem::AnyAllocatorRef alloc) noexcept
+  {
+    assert_true(
+        "Cannot set the GMP allocator while a ScopedGmpAllocator is alive!",
+        details::current_node == nullptr
+            || details::current_node == &details::root_node);
+    details::root_node = {alloc, nullptr};
+    details::install(&details::root_node);
+  }
+
+  void reset_gmp_allocator() noexcept
+  {
+    assert_true(
+        "Cannot reset the GMP allocator while a ScopedGmpAllocator is alive!",
+        details::current_node == nullptr
+            || details::current_node == &details::root_node);
+    details::install(nullptr);
+  }
+
+  ScopedGmpAllocator::ScopedGmpAllocator(mem::AnyAllocatorRef alloc) noexcept
+      : node{alloc, details::current_node}
+  {
+    details::install(&node);
+  }
+
+  ScopedGmpAllocator::~ScopedGmpAllocator() noexcept
+  {
+    assert_true(
+        "ScopedGmpAllocator must be destroyed in reverse order!",
+        details::current_node == &node);
+    details::install(node.previous);
+  }
+} // namespace clt::num
@@ -0,0 +1,88 @@
+/*****************************************************************/ /**
+ * @file   gmp_alloc.h
+ * @brief  Contains set_gmp_allocator and ScopedGmpAllocator, which route
+ * the allocations of GMP (done by BigInt and BigRational) through colt
+ * allocators (using mp_set_memory_functions).
+ * By default, GMP allocates using malloc: these allocations never show
+ * up in the statistics of a StatsAllocator, and cannot be grouped in an
+ * ArenaAllocator.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_NUM_GMP_ALLOC
+#define HG_NUM_GMP_ALLOC
+
+#include "colt/mem/allocator_ref.h"
+
+namespace clt::num
+{
+  namespace details
+  {
+    /// @brief An installed GMP allocator
+    struct GmpAllocatorNode
+    {
+      /// @brief The allocator
+      mem::AnyAllocatorRef alloc;
+      /// @brief The allocator installed before (or null)
+      const GmpAllocatorNode* previous;
+    };
+  } // namespace details
+
+  /// @brief Routes all the allocations of GMP through 'alloc'.
+  /// The allocator must outlive all the big numbers allocated through it.
+  /// Blocks allocated before the call are still freed correctly if 'alloc'
+  /// provides 'owns', else all the big numbers must be freed before the call.
+  /// @warning As GMP memory functions are global, this must be called while
+  ///          no other thread uses GMP, and 'alloc' must be thread-safe if
+  ///          big numbers are used by multiple threads.
+  /// @param alloc The allocator to use
+  COLTCPP_EXPORT void set_gmp_allocator(mem::AnyAllocatorRef alloc) noexcept;
+
+  /// @brief Restores the default GMP allocation functions (malloc).
+  /// All the big numbers allocated by the allocator that was set must have
+  /// been freed.
+  COLTCPP_EXPORT void reset_gmp_allocator() noexcept;
+
+  /// @brief Routes the allocations of GMP through an allocator for the
+  /// lifetime of the object, then restores the previous allocator.
+  /// Blocks that the allocator does not own (allocated before the scope)
+  /// are reallocated and freed through the previous allocator. This makes
+  /// it possible to group all the big numbers of a pass in an arena, and
+  /// to free them in a single reset:
+  /// @code{.cpp}
+  /// mem::ArenaAllocator<mem::PageAllocator> arena;
+  /// {
+  ///   ScopedGmpAllocator scope = {arena};
+  ///   fold_constants();
+  /// }
+  /// arena.reset();
+  /// @endcode
+  /// @warning GMP may move the limbs of a big number that is modified to a
+  ///          new block: no big number allocated or modified in the scope may
+  ///          outlive it (values that fit in 64 bits are stored inline, and
+  ///          are not concerned). Big numbers created before the scope can
+  ///          be read and destroyed in it if the allocator provides 'owns'
+  ///          (such as an ArenaAllocator).
+  class ScopedGmpAllocator
+  {
+    /// @brief The allocator installed by the scope
+    details::GmpAllocatorNode node;
+
+  public:
+    /// @brief Installs 'alloc' as the GMP allocator
+    /// @param alloc The allocator (which must outlive the scope)
+    COLTCPP_EXPORT ScopedGmpAllocator(mem::AnyAllocatorRef alloc) noexcept;
+
+    ScopedGmpAllocator(ScopedGmpAllocator&&)                 = delete;
+    ScopedGmpAllocator(const ScopedGmpAllocator&)            = delete;
+    ScopedGmpAllocator& operator=(ScopedGmpAllocator&&)      = delete;
+    ScopedGmpAllocator& operator=(const ScopedGmpAllocator&) = delete;
+
+    /// @brief Restores the previous GMP allocator.
+    /// Scopes must be destroyed in the reverse order of their construction.
+    COLTCPP_EXPORT ~ScopedGmpAllocator() noexcept;
+  };
+} // namespace clt::num
+
+#endif // !HG_NUM_GMP_ALLOC
@@ -0,0 +1,373 @@
+/*****************************************************************/ /**
+ * @file   overflow.cpp
+ * @brief  Contains the SIMD implementations of the span overloads of
+ * checked_add and checked_sub.
+ * Each vector of lanes is computed wrapping, and the overflow of each
+ * lane is detected without branches: on AVX2 using the sign bits of the
+ * operands (signed) or a biased comparison (unsigned), and on NEON by
+ * comparing the wrapping result to the saturating one.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "overflow.h"
+#include "colt/algo/detect_simd.h"
+
+#if defined(COLT_x86_64)
+  #include <immintrin.h>
+#endif // COLT_x86_64
+
+/// @brief Function computing 'size' lanes, returning the first that overflowed
+template<typename T>
+using lanes_t =
+    size_t (*)(const T* a, const T* b, T* result, size_t size) noexcept;
+
+#pragma region // DEFAULT: checked_lanes
+
+/// @brief Lane by lane implementation
+/// @tparam T The integer type
+/// @tparam SUB True for subtraction, false for addition
+template<typename T, bool SUB>
+[[maybe_unused]] static size_t checked_default(
+    const T* a, const T* b, T* result, size_t size) noexcept
+{
+  using namespace clt;
+  if constexpr (SUB)
+    return details::checked_lanes<T, &checked_sub<T>>(a, b, result, size);
+  else
+    return details::checked_lanes<T, &checked_add<T>>(a, b, result, size);
+}
+
+#pragma endregion
+
+#if defined(COLT_x86_64)
+
+  #pragma region // checked_lanes AVX2
+
+/// @brief AVX2 implementation
+/// @tparam T The integer type (32 or 64-bit)
+/// @tparam SUB True for subtraction, false for addition
+template<typename T, bool SUB>
+static COLT_FORCE_AVX2 size_t checked_AVX2(
+    const T* a, const T* b, T* result, size_t size) noexcept
+{
+  constexpr size_t LANES = sizeof(__m256i) / sizeof(T);
+  constexpr bool IS_64   = sizeof(T) == sizeof(clt::u64);
+
+  size_t first = size;
+  size_t i     = 0;
+  for (; i + LANES <= size; i += LANES)
+  {
+    const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    __m256i vr;
+    if constexpr (IS_64)
+      vr = SUB ? _mm256_sub_epi64(va, vb) : _mm256_add_epi64(va, vb);
+    else
+      vr = SUB ? _mm256_sub_epi32(va, vb) : _mm256_add_epi32(va, vb);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), vr);
+
+    // The sign bit of each lane of 'overflow' is set on overflow
+    __m256i overflow;
+    if constexpr (std::is_signed_v<T>)
+    {
+      if constexpr (SUB)
+        overflow = _mm256_and_si256(
+            _mm256_xor_si256(va, vb), _mm256_xor_si256(va, vr));
+      else
+        overflow = _mm256_and_si256(
+            _mm256_xor_si256(va, vr), _mm256_xor_si256(vb, vr));
+    }
+    else
+    {
+      // Unsigned comparison: flipping the sign bits preserves the order
+      const __m256i bias = IS_64 ? _mm256_set1_epi64x(INT64_MIN)
+                                 : _mm256_set1_epi32(INT32_MIN);
+      const __m256i ba   = _mm256_xor_si256(va, bias);
+      const __m256i br   = _mm256_xor_si256(vr, bias);
+      // Overflow if 'r < a' (addition) or 'r > a' (subtraction)
+      if constexpr (IS_64)
+        overflow = SUB ? _mm256_cmpgt_epi64(br, ba) : _mm256_cmpgt_epi64(ba, br);
+      else
+        overflow = SUB ? _mm256_cmpgt_epi32(br, ba) : _mm256_cmpgt_epi32(ba, br);
+    }
+
+    int mask;
+    if constexpr (IS_64)
+      mask = _mm256_movemask_pd(_mm256_castsi256_pd(overflow));
+    else
+      mask = _mm256_movemask_ps(_mm256_castsi256_ps(overflow));
+    if (HEDLEY_UNLIKELY(mask != 0) && first == size)
+      first = i + std::countr_zero(static_cast<unsigned>(mask));
+  }
+  const size_t tail =
+      checked_default<T, SUB>(a + i, b + i, result + i, size - i);
+  if (first == size && tail != size - i)
+    first = i + tail;
+  return first;
+}
+
+  #pragma endregion
+
+#elif defined(COLT_ARM_7or8)
+
+  #pragma region // checked_lanes NEON
+
+/// @brief NEON operations on vectors of T
+/// @tparam T The integer type (32 or 64-bit)
+template<typename T>
+struct NeonLanes;
+
+template<>
+struct NeonLanes<clt::i32>
+{
+  using vector_t = int32x4_t;
+
+  static COLT_FORCE_NEON vector_t load(const clt::i32* ptr) noexcept
+  {
+    return vld1q_s32(ptr);
+  }
+  static COLT_FORCE_NEON void store(clt::i32* ptr, vector_t v) noexcept
+  {
+    vst1q_s32(ptr, v);
+  }
+  static COLT_FORCE_NEON vector_t add(vector_t a, vector_t b) noexcept
+  {
+    return vaddq_s32(a, b);
+  }
+  static COLT_FORCE_NEON vector_t sub(vector_t a, vector_t b) noexcept
+  {
+    return vsubq_s32(a, b);
+  }
+  static COLT_FORCE_NEON vector_t qadd(vector_t a, vector_t b) noexcept
+  {
+    return vqaddq_s32(a, b);
+  }
+  static COLT_FORCE_NEON vector_t qsub(vector_t a, vector_t b) noexcept
+  {
+    return vqsubq_s32(a, b);
+  }
+  static COLT_FORCE_NEON uint64x2_t bits(vector_t v) noexcept
+  {
+    return vreinterpretq_u64_s32(v);
+  }
+};
+
+template<>
+struct NeonLanes<clt::u32>
+{
+  using vector_t = uint32x4_t;
+
+  static COLT_FORCE_NEON vector_t load(const clt::u32* ptr) noexcept
+  {
+    return vld1q_u32(ptr);
+  }
+  static COLT_FORCE_NEON void store(clt::u32* ptr, vector_t v) noexcept
+  {
+    vst1q_u32(ptr, v);
+  }
+  static COLT_FORCE_NEON vector_t add(vector_t a, vector_t b) noexcept
+  {
+    return vaddq_u32(a, b);
+  }
+  static COLT_FORCE_NEON vector_t sub(vector_t a, vector_t b) noexcept
+  {
+    return vsubq_u32(a, b);
+  }
+  static COLT_FORCE_NEON vector_t qadd(vector_t a, vector_t b) noexcept
+  {
+    return vqaddq_u32(a, b);
+  }
+  static COLT_FORCE_NEON vector_t qsub(vector_t a, vector_t b) noexcept
+  {
+    return vqsubq_u32(a, b);
+  }
+  static COLT_FORCE_NEON uint64x2_t bits(vector_t v) noexcept
+  {
+    return vreinterpretq_u64_u32(v);
+  }
+};
+
+template<>
+struct NeonLanes<clt::i64>
+{
+  using vector_t = int64x2_t;
+
+  static COLT_FORCE_NEON vector_t load(const clt::i64* ptr) noexcept
+  {
+    return vld1q_s64(ptr);
+  }
+  static COLT_FORCE_NEON void store(clt::i64* ptr, vector_t v) noexcept
+  {
+    vst1q_s64(ptr, v);
+  }
+  static COLT_FORCE_NEON vector_t add(vector_t a, vector_t b) noexcept
+  {
+    return vaddq_s64(a, b);
+  }
+  static COLT_FORCE_NEON vector_t sub(vector_t a, vector_t b) noexcept
+  {
+    return vsubq_s64(a, b);
+  }
+  static COLT_FORCE_NEON vector_t qadd(vector_t a, vector_t b) noexcept
+  {
+    return vqaddq_s64(a, b);
+  }
+  static COLT_FORCE_NEON vector_t qsub(vector_t a, vector_t b) noexcept
+  {
+    return vqsubq_s64(a, b);
+  }
+  static COLT_FORCE_NEON uint64x2_t bits(vector_t v) noexcept
+  {
+    return vreinterpretq_u64_s64(v);
+  }
+};
+
+template<>
+struct NeonLanes<clt::u64>
+{
+  using vector_t = uint64x2_t;
+
+  static COLT_FORCE_NEON vector_t load(const clt::u64* ptr) noexcept
+  {
+    return vld1q_u64(ptr);
+  }
+  static COLT_FORCE_NEON void store(clt::u64* ptr, vector_t v) noexcept
+  {
+    vst1q_u64(ptr, v);
+  }
+  static COLT_FORCE_NEON vector_t add(vector_t a, vector_t b) noexcept
+  {
+    return vaddq_u64(a, b);
+  }
+  static COLT_FORCE_NEON vector_t sub(vector_t a, vector_t b) noexcept
+  {
+    return vsubq_u64(a, b);
+  }
+  static COLT_FORCE_NEON vector_t qadd(vector_t a, vector_t b) noexcept
+  {
+    return vqaddq_u64(a, b);
+  }
+  static COLT_FORCE_NEON vector_t qsub(vector_t a, vector_t b) noexcept
+  {
+    return vqsubq_u64(a, b);
+  }
+  static COLT_FORCE_NEON uint64x2_t bits(vector_t v) noexcept { return v; }
+};
+
+/// @brief NEON implementation
+/// @tparam T The integer type (32 or 64-bit)
+/// @tparam SUB True for subtraction, false for addition
+template<typename T, bool SUB>
+static COLT_FORCE_NEON size_t checked_NEON(
+    const T* a, const T* b, T* result, size_t size) noexcept
+{
+  using Lanes            = NeonLanes<T>;
+  constexpr size_t LANES = 16 / sizeof(T);
+
+  size_t first = size;
+  size_t i     = 0;
+  for (; i + LANES <= size; i += LANES)
+  {
+    const auto va = Lanes::load(a + i);
+    const auto vb = Lanes::load(b + i);
+    const auto vr = SUB ? Lanes::sub(va, vb) : Lanes::add(va, vb);
+    const auto vq = SUB ? Lanes::qsub(va, vb) : Lanes::qadd(va, vb);
+    Lanes::store(result + i, vr);
+    // A lane overflowed if the wrapping and saturating results differ
+    const uint64x2_t diff = veorq_u64(Lanes::bits(vr), Lanes::bits(vq));
+    if (HEDLEY_UNLIKELY((vgetq_lane_u64(diff, 0) | vgetq_lane_u64(diff, 1)) != 0)
+        && first == size)
+    {
+      for (size_t j = 0; j < LANES && first == size; j++)
+      {
+        T ignore;
+        if (SUB ? clt::checked_sub(a[i + j], b[i + j], &ignore)
+                : clt::checked_add(a[i + j], b[i + j], &ignore))
+          first = i + j;
+      }
+    }
+  }
+  const size_t tail =
+      checked_default<T, SUB>(a + i, b + i, result + i, size - i);
+  if (first == size && tail != size - i)
+    first = i + tail;
+  return first;
+}
+
+  #pragma endregion
+
+#endif // COLT_x86_64
+
+/// @brief Chooses the implementation (once) and calls it
+/// @tparam T The integer type (32 or 64-bit)
+/// @tparam SUB True for subtraction, false for addition
+template<typename T, bool SUB>
+static size_t checked_dispatch(
+    const T* a, const T* b, T* result, size_t size) noexcept
+{
+  using namespace clt;
+#if defined(COLT_x86_64)
+  static const lanes_t<T> FN =
+      choose_simd_implementation<simd_flag::AVX2, simd_flag::DEFAULT>{}(
+          &checked_AVX2<T, SUB>, &checked_default<T, SUB>);
+#elif defined(COLT_ARM_7or8)
+  static const lanes_t<T> FN =
+      choose_simd_implementation<simd_flag::NEON, simd_flag::DEFAULT>{}(
+          &checked_NEON<T, SUB>, &checked_default<T, SUB>);
+#else
+  static constexpr lanes_t<T> FN = &checked_default<T, SUB>;
+#endif // COLT_x86_64
+  return (*FN)(a, b, result, size);
+}
+
+namespace clt::details
+{
+  size_t checked_add_lanes(
+      const i32* a, const i32* b, i32* result, size_t size) noexcept
+  {
+    return checked_dispatch<i32, false>(a, b, result, size);
+  }
+
+  size_t checked_add_lanes(
+      const u32* a, const u32* b, u32* result, size_t size) noexcept
+  {
+    return checked_dispatch<u32, false>(a, b, result, size);
+  }
+
+  size_t checked_add_lanes(
+      const i64* a, const i64* b, i64* result, size_t size) noexcept
+  {
+    return checked_dispatch<i64, false>(a, b, result, size);
+  }
+
+  size_t checked_add_lanes(
+      const u64* a, const u64* b, u64* result, size_t size) noexcept
+  {
+    return checked_dispatch<u64, false>(a, b, result, size);
+  }
+
+  size_t checked_sub_lanes(
+      const i32* a, const i32* b, i32* result, size_t size) noexcept
+  {
+    return checked_dispatch<i32, true>(a, b, result, size);
+  }
+
+  size_t checked_sub_lanes(
+      const u32* a, const u32* b, u32* result, size_t size) noexcept
+  {
+    return checked_dispatch<u32, true>(a, b, result, size);
+  }
+
+  size_t checked_sub_lanes(
+      const i64* a, const i64* b, i64* result, size_t size) noexcept
+  {
+    return checked_dispatch<i64, true>(a, b, result, size);
+  }
+
+  size_t checked_sub_lanes(
+      const u64* a, const u64* b, u64* result, size_t size) noexcept
+  {
+    return checked_dispatch<u64, true>(a, b, result, size);
+  }
+} // namespace clt::details
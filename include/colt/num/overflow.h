@@ -1,6 +1,12 @@
 /*****************************************************************/ /**
  * @file   check_overflow.h
- * @brief  Contains checked_* to detect overflow.
+ * @brief  Contains checked_* to detect overflow, and saturating_* which
+ * clamp the result on overflow.
+ * Both support 128-bit integers (i128 and u128) if the compiler provides
+ * them. checked_add, checked_sub and checked_mul also have overloads taking
+ * spans, which compute all the lanes at once (vectorized using AVX2 or NEON
+ * for 32 and 64-bit integers) and return the index of the first lane that
+ * overflowed.
  * 
  * @author RPC
  * @date   August 2024
@@ -8,8 +14,10 @@
 #ifndef HG_NUM_CHECK_OVERFLOW
 #define HG_NUM_CHECK_OVERFLOW
 
+#include <bit>
 #include <concepts>
 #include <limits>
+#include <type_traits>
 
 #include "hedley.h"
 #include "colt/typedefs.h"
@@ -20,18 +28,160 @@
 
 namespace clt
 {
+#ifdef __SIZEOF_INT128__
+  #define COLT_HAS_INT128
+  /// @brief signed 128-bit integer
+  __extension__ using i128 = __int128;
+  /// @brief unsigned 128-bit integer
+  __extension__ using u128 = unsigned __int128;
+#endif // __SIZEOF_INT128__
+
+  /// @brief Integers supported by checked_* and saturating_*
+  template<typename T>
+  concept checked_integral = std::integral<T>
+#ifdef COLT_HAS_INT128
+                             || std::same_as<T, i128> || std::same_as<T, u128>
+#endif // COLT_HAS_INT128
+      ;
+
+  namespace details
+  {
+    template<typename T>
+    /// @brief The unsigned integer of the same size as T
+    struct unsigned_of
+    {
+      using type = std::make_unsigned_t<T>;
+    };
+
+#ifdef COLT_HAS_INT128
+    template<>
+    struct unsigned_of<i128>
+    {
+      using type = u128;
+    };
+
+    template<>
+    struct unsigned_of<u128>
+    {
+      using type = u128;
+    };
+#endif // COLT_HAS_INT128
+
+    template<typename T>
+    /// @brief The unsigned integer of the same size as T
+    using unsigned_of_t = typename unsigned_of<T>::type;
+
+    template<typename T>
+    /// @brief True if T is signed (std::is_signed_v is false for 128-bit
+    ///        integers in strict mode)
+    inline constexpr bool is_signed_int = static_cast<T>(-1) < static_cast<T>(0);
+
+    template<typename T>
+    /// @brief The maximum value of T
+    inline constexpr T max_int = static_cast<T>(
+        static_cast<unsigned_of_t<T>>(~unsigned_of_t<T>{0}) >> is_signed_int<T>);
+
+    template<typename T>
+    /// @brief The minimum value of T
+    inline constexpr T min_int =
+        is_signed_int<T> ? static_cast<T>(-max_int<T> - 1) : static_cast<T>(0);
+
+    template<typename T>
+    /// @brief Portable checked addition (on two's complement representation)
+    /// @return True on overflow
+    constexpr bool add_fallback(T a, T b, T* result) noexcept
+    {
+      using U     = unsigned_of_t<T>;
+      const U r   = static_cast<U>(static_cast<U>(a) + static_cast<U>(b));
+      *result     = static_cast<T>(r);
+      if constexpr (is_signed_int<T>)
+      {
+        // The sign of the result differs from the signs of both operands
+        return static_cast<T>(
+                   (static_cast<U>(a) ^ r) & (static_cast<U>(b) ^ r))
+               < 0;
+      }
+      else
+        return r < static_cast<U>(a);
+    }
+
+    template<typename T>
+    /// @brief Portable checked subtraction (on two's complement representation)
+    /// @return True on overflow
+    constexpr bool sub_fallback(T a, T b, T* result) noexcept
+    {
+      using U     = unsigned_of_t<T>;
+      const U r   = static_cast<U>(static_cast<U>(a) - static_cast<U>(b));
+      *result     = static_cast<T>(r);
+      if constexpr (is_signed_int<T>)
+      {
+        // The operands have different signs, and the sign of the result
+        // differs from the sign of 'a'
+        return static_cast<T>(
+                   (static_cast<U>(a) ^ static_cast<U>(b))
+                   & (static_cast<U>(a) ^ r))
+               < 0;
+      }
+      else
+        return b > a;
+    }
+
+    template<typename T>
+    /// @brief Returns the absolute value of 'a' as an unsigned integer
+    /// @return |a| (which does not overflow for the minimum value)
+    constexpr unsigned_of_t<T> magnitude_of(T a) noexcept
+    {
+      using U = unsigned_of_t<T>;
+      if constexpr (is_signed_int<T>)
+        return a < 0 ? static_cast<U>(U{0} - static_cast<U>(a)) : static_cast<U>(a);
+      else
+        return a;
+    }
+
+    template<typename T>
+    /// @brief Portable checked multiplication
+    /// @return True on overflow
+    constexpr bool mul_fallback(T a, T b, T* result) noexcept
+    {
+      if constexpr (sizeof(T) < sizeof(i64))
+      {
+        // The product is exact in 64 bits
+        using W = std::conditional_t<is_signed_int<T>, i64, u64>;
+        const W r = static_cast<W>(a) * static_cast<W>(b);
+        *result   = static_cast<T>(r);
+        return static_cast<W>(*result) != r;
+      }
+      else
+      {
+        using U         = unsigned_of_t<T>;
+        const U ua      = magnitude_of(a);
+        const U ub      = magnitude_of(b);
+        const U r       = ua * ub;
+        const bool wrap = ua != 0 && r / ua != ub;
+        if constexpr (is_signed_int<T>)
+        {
+          const bool negative = (a < 0) != (b < 0);
+          *result             = static_cast<T>(negative ? U{0} - r : r);
+          return wrap || r > static_cast<U>(max_int<T>) + U{negative};
+        }
+        else
+        {
+          *result = static_cast<T>(r);
+          return wrap;
+        }
+      }
+    }
+  } // namespace details
+
   /// @brief Computes the sum of two numbers, and returns true on overflow
   /// @tparam T The integer type
   /// @param a The first integer
   /// @param b The second integer
   /// @param result The result to which to write
   /// @return True on overflow
-  template<std::integral T>
+  template<checked_integral T>
   constexpr bool checked_add(T a, T b, T* result) noexcept
   {
-    static_assert(
-        sizeof(T) <= 8,
-        "checked_* operations only work on integer of size <= 8 bytes!");
 #if defined(COLT_GNU) || defined(COLT_CLANG)
     if (!std::is_constant_evaluated())
       return __builtin_add_overflow(a, b, result);
@@ -48,25 +198,7 @@ namespace clt
         return static_cast<bool>(_addcarry_u64(0, a, b, result));
     }
 #endif
-    if constexpr (sizeof(T) < 8)
-    {
-      T cast  = (T)a + (T)b;
-      *result = (T)cast;
-      return cast > std::numeric_limits<T>::max()
-             || cast < std::numeric_limits<T>::min();
-    }
-    else if constexpr (std::same_as<i64, T>)
-    {
-      *result = a + b;
-      return (b > 0 && a > std::numeric_limits<T>::max() - b)
-             || (b < 0 && a < std::numeric_limits<T>::min() - b);
-    }
-    else // u64
-    {
-      T cast  = (T)a + (T)b;
-      *result = cast;
-      return cast < a;
-    }
+    return details::add_fallback(a, b, result);
   }
 
   /// @brief Computes the difference of two numbers, and returns true on overflow
@@ -75,12 +207,9 @@ namespace clt
   /// @param b The second integer
   /// @param result The result to which to write
   /// @return True on overflow
-  template<std::integral T>
+  template<checked_integral T>
   constexpr bool checked_sub(T a, T b, T* result) noexcept
   {
-    static_assert(
-        sizeof(T) <= 8,
-        "checked_* operations only work on integer of size <= 8 bytes!");
 #if defined(COLT_GNU) || defined(COLT_CLANG)
     if (!std::is_constant_evaluated())
       return __builtin_sub_overflow(a, b, result);
@@ -97,25 +226,7 @@ namespace clt
         return static_cast<bool>(_subborrow_u64(0, a, b, result));
     }
 #endif
-    if constexpr (sizeof(T) < 8)
-    {
-      T cast  = (T)a - (T)b;
-      *result = (T)cast;
-      return cast > std::numeric_limits<T>::max()
-             || cast < std::numeric_limits<T>::min();
-    }
-    else if constexpr (std::same_as<i64, T>)
-    {
-      *result = a - b;
-      return (b < 0 && a > std::numeric_limits<T>::max() + b)
-             || (b > 0 && a < std::numeric_limits<T>::min() + b);
-    }
-    else // u64
-    {
-      T cast  = (T)a - (T)b;
-      *result = cast;
-      return cast > a;
-    }
+    return details::sub_fallback(a, b, result);
   }
 
   /// @brief Computes the product of two numbers, and returns true on overflow
@@ -124,12 +235,9 @@ namespace clt
   /// @param b The second integer
   /// @param result The result to which to write
   /// @return True on overflow
-  template<std::integral T>
+  template<checked_integral T>
   constexpr bool checked_mul(T a, T b, T* result) noexcept
   {
-    static_assert(
-        sizeof(T) <= 8,
-        "checked_* operations only work on integer of size <= 8 bytes!");
 #if defined(COLT_GNU) || defined(COLT_CLANG)
     if (!std::is_constant_evaluated())
       return __builtin_mul_overflow(a, b, result);
@@ -144,76 +252,244 @@ namespace clt
       if constexpr (std::same_as<i64, T>)
       {
         *result = a * b;
-        return static_cast<bool>(__mulh(a, b) != 0);
+        // The high bits must be the sign extension of the low bits
+        return static_cast<bool>(__mulh(a, b) != (*result >> 63));
       }
     }
 #endif
-    if constexpr (sizeof(T) < 8)
-    {
-      T cast  = (T)a * (T)b;
-      *result = (T)cast;
-      return cast > std::numeric_limits<T>::max()
-             || cast < std::numeric_limits<T>::min();
-    }
-    else if constexpr (std::same_as<i64, T>)
-    {
-      *result = (T)a * (T)b;
-      return (a == -1 && b == std::numeric_limits<T>::min())
-             || (b == -1 && a == std::numeric_limits<T>::min())
-             || (b != 0 && a > std::numeric_limits<T>::max() / b)
-             || (b != 0 && a < std::numeric_limits<T>::min() / b);
-    }
-    else // u64
-    {
-      T cast  = (T)a * (T)b;
-      *result = cast;
-      return a != 0 && cast / a != b;
-    }
+    return details::mul_fallback(a, b, result);
   }
 
   /// @brief Computes the quotient of two numbers, and returns true on overflow.
   /// If 'b' is zero, this function will still perform the division.
   /// The only case where an overflow can happen is for signed division
-  /// of std::numeric_limits<T>::min() and -1.
+  /// of the minimum value of T and -1 (the result is then the minimum value).
   /// @tparam T The integer type
   /// @param a The first integer
   /// @param b The second integer
   /// @param result The result to which to write
   /// @return True on overflow
-  template<std::integral T>
+  template<checked_integral T>
   constexpr bool checked_div(T a, T b, T* result) noexcept
   {
-    static_assert(
-        sizeof(T) <= 8,
-        "checked_* operations only work on integer of size <= 8 bytes!");
+    if constexpr (details::is_signed_int<T>)
+    {
+      if (a == details::min_int<T> && b == static_cast<T>(-1))
+      {
+        *result = a;
+        return true;
+      }
+    }
     *result = a / b;
-    if constexpr (std::is_signed_v<T>)
-      return (a == std::numeric_limits<T>::min() && b == -1)
-             || (b == std::numeric_limits<T>::min() && a == -1);
     return false;
   }
 
   /// @brief Computes the remainder of two numbers, and returns true on overflow.
   /// If 'b' is zero, this function will still perform the division.
   /// The only case where an overflow can happen is for signed division
-  /// of std::numeric_limits<T>::min() and -1.
+  /// of the minimum value of T and -1 (the result is then zero).
   /// @tparam T The integer type
   /// @param a The first integer
   /// @param b The second integer
   /// @param result The result to which to write
   /// @return True on overflow
-  template<std::integral T>
+  template<checked_integral T>
   constexpr bool checked_rem(T a, T b, T* result) noexcept
   {
-    static_assert(
-        sizeof(T) <= 8,
-        "checked_* operations only work on integer of size <= 8 bytes!");
+    if constexpr (details::is_signed_int<T>)
+    {
+      if (a == details::min_int<T> && b == static_cast<T>(-1))
+      {
+        *result = 0;
+        return true;
+      }
+    }
     *result = a % b;
-    if constexpr (std::is_signed_v<T>)
-      return (a == std::numeric_limits<T>::min() && b == -1)
-             || (b == std::numeric_limits<T>::min() && a == -1);
     return false;
   }
+
+  /// @brief Computes the sum of two numbers, clamping the result on overflow
+  /// @tparam T The integer type
+  /// @param a The first integer
+  /// @param b The second integer
+  /// @return The sum, or the minimum/maximum value of T on overflow
+  template<checked_integral T>
+  constexpr T saturating_add(T a, T b) noexcept
+  {
+    if (T result; !checked_add(a, b, &result))
+      return result;
+    if constexpr (details::is_signed_int<T>)
+      return b < 0 ? details::min_int<T> : details::max_int<T>;
+    else
+      return details::max_int<T>;
+  }
+
+  /// @brief Computes the difference of two numbers, clamping the result on
+  ///        overflow
+  /// @tparam T The integer type
+  /// @param a The first integer
+  /// @param b The second integer
+  /// @return The difference, or the minimum/maximum value of T on overflow
+  template<checked_integral T>
+  constexpr T saturating_sub(T a, T b) noexcept
+  {
+    if (T result; !checked_sub(a, b, &result))
+      return result;
+    if constexpr (details::is_signed_int<T>)
+      return b < 0 ? details::max_int<T> : details::min_int<T>;
+    else
+      return details::min_int<T>;
+  }
+
+  /// @brief Computes the product of two numbers, clamping the result on
+  ///        overflow
+  /// @tparam T The integer type
+  /// @param a The first integer
+  /// @param b The second integer
+  /// @return The product, or the minimum/maximum value of T on overflow
+  template<checked_integral T>
+  constexpr T saturating_mul(T a, T b) noexcept
+  {
+    if (T result; !checked_mul(a, b, &result))
+      return result;
+    if constexpr (details::is_signed_int<T>)
+      return (a < 0) != (b < 0) ? details::min_int<T> : details::max_int<T>;
+    else
+      return details::max_int<T>;
+  }
+
+  /// @brief Computes the quotient of two numbers, clamping the result on
+  ///        overflow. 'b' must not be zero.
+  /// @tparam T The integer type
+  /// @param a The first integer
+  /// @param b The second integer
+  /// @return The quotient, or the maximum value of T on overflow
+  template<checked_integral T>
+  constexpr T saturating_div(T a, T b) noexcept
+  {
+    if (T result; !checked_div(a, b, &result))
+      return result;
+    return details::max_int<T>;
+  }
+
+  namespace details
+  {
+    /// @brief Lane by lane checked_* for integers without vectorized kernels
+    /// @return The index of the first lane that overflowed, or 'size'
+    template<typename T, bool (*FN)(T, T, T*) noexcept>
+    constexpr size_t checked_lanes(
+        const T* a, const T* b, T* result, size_t size) noexcept
+    {
+      size_t first = size;
+      for (size_t i = 0; i < size; i++)
+      {
+        if (FN(a[i], b[i], result + i) && first == size)
+          first = i;
+      }
+      return first;
+    }
+
+    /// @brief Vectorized checked_add (AVX2, NEON or lane by lane)
+    /// @return The index of the first lane that overflowed, or 'size'
+    COLTCPP_EXPORT size_t checked_add_lanes(
+        const i32* a, const i32* b, i32* result, size_t size) noexcept;
+    /// @brief Vectorized checked_add (AVX2, NEON or lane by lane)
+    /// @return The index of the first lane that overflowed, or 'size'
+    COLTCPP_EXPORT size_t checked_add_lanes(
+        const u32* a, const u32* b, u32* result, size_t size) noexcept;
+    /// @brief Vectorized checked_add (AVX2, NEON or lane by lane)
+    /// @return The index of the first lane that overflowed, or 'size'
+    COLTCPP_EXPORT size_t checked_add_lanes(
+        const i64* a, const i64* b, i64* result, size_t size) noexcept;
+    /// @brief Vectorized checked_add (AVX2, NEON or lane by lane)
+    /// @return The index of the first lane that overflowed, or 'size'
+    COLTCPP_EXPORT size_t checked_add_lanes(
+        const u64* a, const u64* b, u64* result, size_t size) noexcept;
+
+    /// @brief Vectorized checked_sub (AVX2, NEON or lane by lane)
+    /// @return The index of the first lane that overflowed, or 'size'
+    COLTCPP_EXPORT size_t checked_sub_lanes(
+        const i32* a, const i32* b, i32* result, size_t size) noexcept;
+    /// @brief Vectorized checked_sub (AVX2, NEON or lane by lane)
+    /// @return The index of the first lane that overflowed, or 'size'
+    COLTCPP_EXPORT size_t checked_sub_lanes(
+        const u32* a, const u32* b, u32* result, size_t size) noexcept;
+    /// @brief Vectorized checked_sub (AVX2, NEON or lane by lane)
+    /// @return The index of the first lane that overflowed, or 'size'
+    COLTCPP_EXPORT size_t checked_sub_lanes(
+        const i64* a, const i64* b, i64* result, size_t size) noexcept;
+    /// @brief Vectorized checked_sub (AVX2, NEON or lane by lane)
+    /// @return The index of the first lane that overflowed, or 'size'
+    COLTCPP_EXPORT size_t checked_sub_lanes(
+        const u64* a, const u64* b, u64* result, size_t size) noexcept;
+
+    template<typename T>
+    /// @brief True if T has vectorized kernels
+    inline constexpr bool has_vectorized_lanes =
+        std::same_as<T, i32> || std::same_as<T, u32> || std::same_as<T, i64>
+        || std::same_as<T, u64>;
+  } // namespace details
+
+  /// @brief Computes the sums of each lane of 'a' and 'b'.
+  /// All the lanes are computed (lanes that overflow are wrapped), which
+  /// makes it possible to fold a whole vector and report the first lane
+  /// that overflowed.
+  /// @tparam T The integer type
+  /// @param a The first integers
+  /// @param b The second integers (of the same size as 'a')
+  /// @param result The results (of the same size as 'a')
+  /// @return The index of the first lane that overflowed, or a.size()
+  template<checked_integral T>
+  size_t checked_add(View<T> a, View<T> b, Span<T> result) noexcept
+  {
+    assert_true(
+        "Spans must be of the same size!", a.size() == b.size(),
+        a.size() == result.size());
+    if constexpr (details::has_vectorized_lanes<T>)
+      return details::checked_add_lanes(a.data(), b.data(), result.data(), a.size());
+    else
+      return details::checked_lanes<T, &checked_add<T>>(
+          a.data(), b.data(), result.data(), a.size());
+  }
+
+  /// @brief Computes the differences of each lane of 'a' and 'b'.
+  /// All the lanes are computed (lanes that overflow are wrapped).
+  /// @tparam T The integer type
+  /// @param a The first integers
+  /// @param b The second integers (of the same size as 'a')
+  /// @param result The results (of the same size as 'a')
+  /// @return The index of the first lane that overflowed, or a.size()
+  template<checked_integral T>
+  size_t checked_sub(View<T> a, View<T> b, Span<T> result) noexcept
+  {
+    assert_true(
+        "Spans must be of the same size!", a.size() == b.size(),
+        a.size() == result.size());
+    if constexpr (details::has_vectorized_lanes<T>)
+      return details::checked_sub_lanes(a.data(), b.data(), result.data(), a.size());
+    else
+      return details::checked_lanes<T, &checked_sub<T>>(
+          a.data(), b.data(), result.data(), a.size());
+  }
+
+  /// @brief Computes the products of each lane of 'a' and 'b'.
+  /// All the lanes are computed (lanes that overflow are wrapped).
+  /// Multiplication is not vectorized: AVX2 and NEON have no instruction
+  /// returning the high bits of 64-bit products.
+  /// @tparam T The integer type
+  /// @param a The first integers
+  /// @param b The second integers (of the same size as 'a')
+  /// @param result The results (of the same size as 'a')
+  /// @return The index of the first lane that overflowed, or a.size()
+  template<checked_integral T>
+  size_t checked_mul(View<T> a, View<T> b, Span<T> result) noexcept
+  {
+    assert_true(
+        "Spans must be of the same size!", a.size() == b.size(),
+        a.size() == result.size());
+    return details::checked_lanes<T, &checked_mul<T>>(
+        a.data(), b.data(), result.data(), a.size());
+  }
 } // namespace clt
 
 #endif // !HG_NUM_CHECK_OVERFLOW
@@ -0,0 +1,181 @@
+/*****************************************************************/ /**
+ * @file   perf_counters.cpp
+ * @brief  Contains the implementation of `perf_counters.h`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "perf_counters.h"
+
+#include <utility>
+
+#if defined(COLT_LINUX)
+  #include <cstring>
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif // COLT_LINUX
+
+namespace clt
+{
+#if defined(COLT_LINUX)
+  /// @brief The configuration of each PerfCounter
+  static constexpr u64 PERF_CONFIGS[PERF_COUNTER_COUNT] = {
+      PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+  /// @brief The result of reading a group (PERF_FORMAT_GROUP with the
+  ///        enabled and running times)
+  struct PerfGroupRead
+  {
+    /// @brief The count of values
+    u64 nr;
+    /// @brief The time during which the group was enabled
+    u64 time_enabled;
+    /// @brief The time during which the group was on the PMU
+    u64 time_running;
+    /// @brief The values (in the order in which the counters were opened)
+    u64 values[PERF_COUNTER_COUNT];
+  };
+
+  PerfCounters::PerfCounters() noexcept
+  {
+    fds.fill(-1);
+    for (u8 i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size   = sizeof(attr);
+      attr.type   = PERF_TYPE_HARDWARE;
+      attr.config = PERF_CONFIGS[i];
+      // The leader starts disabled: the group is enabled at once
+      attr.disabled    = opened == 0;
+      attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+                         | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      // User space only: allowed with 'perf_event_paranoid' <= 2
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+      // Current thread, any CPU
+      const int fd = static_cast<int>(syscall(
+          SYS_perf_event_open, &attr, 0, -1, opened == 0 ? -1 : fds[0],
+          PERF_FLAG_FD_CLOEXEC));
+      if (fd == -1)
+        continue;
+      fds[opened]   = fd;
+      order[opened] = static_cast<PerfCounter>(i);
+      available_ |= static_cast<u8>(1 << i);
+      ++opened;
+    }
+    if (opened != 0)
+    {
+      ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+  }
+
+  PerfCounters::~PerfCounters() noexcept
+  {
+    // The members are closed before the leader
+    for (u8 i = opened; i != 0; i--)
+      ::close(fds[i - 1]);
+  }
+
+  PerfCounts PerfCounters::read() const noexcept
+  {
+    PerfCounts ret;
+    if (opened != 0)
+    {
+      PerfGroupRead group;
+      const auto size = static_cast<ssize_t>(
+          sizeof(u64) * 3 + sizeof(u64) * static_cast<size_t>(opened));
+      if (::read(fds[0], &group, sizeof(group)) == size && group.nr == opened)
+      {
+        // The group was multiplexed with other events: extrapolates
+        const double scale =
+            group.time_running == 0 || group.time_running >= group.time_enabled
+                ? 1.0
+                : static_cast<double>(group.time_enabled)
+                      / static_cast<double>(group.time_running);
+        for (u8 i = 0; i < opened; i++)
+        {
+          ret.values[static_cast<u8>(order[i])] =
+              scale == 1.0 ? group.values[i]
+                           : static_cast<u64>(
+                                 static_cast<double>(group.values[i]) * scale);
+        }
+        ret.available = available_;
+      }
+    }
+    ret.ticks = trace::details::timestamp();
+    return ret;
+  }
+#else
+  PerfCounters::PerfCounters() noexcept
+  {
+    fds.fill(-1);
+  }
+
+  PerfCounters::~PerfCounters() noexcept = default;
+
+  PerfCounts PerfCounters::read() const noexcept
+  {
+    PerfCounts ret;
+    ret.ticks = trace::details::timestamp();
+    return ret;
+  }
+#endif // COLT_LINUX
+
+  PerfCounters::PerfCounters(PerfCounters&& other) noexcept
+      : fds(std::exchange(other.fds, {-1, -1, -1, -1}))
+      , order(other.order)
+      , opened(std::exchange(other.opened, u8(0)))
+      , available_(std::exchange(other.available_, u8(0)))
+  {
+  }
+
+  PerfCounters& PerfCounters::operator=(PerfCounters&& other) noexcept
+  {
+    std::swap(fds, other.fds);
+    std::swap(order, other.order);
+    std::swap(opened, other.opened);
+    std::swap(available_, other.available_);
+    return *this;
+  }
+
+  const PerfCounters& PerfCounters::this_thread() noexcept
+  {
+    static thread_local PerfCounters counters;
+    return counters;
+  }
+
+  void PerfRegion::add(const PerfCounts& counts) noexcept
+  {
+    ticks.fetch_add(counts.ticks, std::memory_order_relaxed);
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; i++)
+      values[i].fetch_add(counts.values[i], std::memory_order_relaxed);
+    available.fetch_and(counts.available, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  PerfCounts PerfRegion::total() const noexcept
+  {
+    PerfCounts ret;
+    if (count() == 0)
+      return ret;
+    ret.ticks = ticks.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < PERF_COUNTER_COUNT; i++)
+      ret.values[i] = values[i].load(std::memory_order_relaxed);
+    ret.available = available.load(std::memory_order_relaxed);
+    return ret;
+  }
+
+  void PerfRegion::reset() noexcept
+  {
+    ticks.store(0, std::memory_order_relaxed);
+    for (auto& value : values)
+      value.store(0, std::memory_order_relaxed);
+    available.store(0xFF, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+  }
+} // namespace clt
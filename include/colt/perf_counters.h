@@ -0,0 +1,326 @@
+/*****************************************************************/ /**
+ * @file   perf_counters.h
+ * @brief  Contains PerfCounters, which reads the hardware performance
+ * counters (cycles, instructions, cache misses and branch misses) of the
+ * current thread, and PerfRegion, which aggregates the counts of a region
+ * of code over all the threads executing it.
+ *
+ * @code{.cpp}
+ * static PerfRegion region = {"transcode"};
+ * void transcode(...)
+ * {
+ *   COLT_PERF_SCOPE(region); // also a trace zone named "transcode"
+ *   ...
+ * }
+ * ...
+ * print("{}", region.total());
+ * @endcode
+ *
+ * On Linux, the counters are opened through `perf_event_open` as a single
+ * group (read in one system call, and scheduled together so that the
+ * counts are consistent). Elsewhere, or if the kernel does not allow it
+ * (see /proc/sys/kernel/perf_event_paranoid), only the timestamp counter
+ * is read: 'PerfCounts::is_available' reports which counters were read.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_PERF_COUNTERS
+#define HG_COLT_PERF_COUNTERS
+
+#include <array>
+#include <atomic>
+
+#include <fmt/format.h>
+
+#include "colt/typedefs.h"
+#include "colt/macros.h"
+#include "colt/trace.h"
+#include "colt/coltcpp_export.h"
+
+namespace clt
+{
+  /// @brief The hardware counters read by PerfCounters
+  enum class PerfCounter : u8
+  {
+    /// @brief The CPU cycles
+    CYCLES,
+    /// @brief The retired instructions
+    INSTRUCTIONS,
+    /// @brief The last level cache misses
+    CACHE_MISSES,
+    /// @brief The mispredicted branches
+    BRANCH_MISSES,
+  };
+
+  /// @brief The count of PerfCounter
+  inline constexpr size_t PERF_COUNTER_COUNT = 4;
+
+  /// @brief The counts of a region of code
+  struct PerfCounts
+  {
+    /// @brief The timestamp counter (always available, see 'trace.h')
+    u64 ticks = 0;
+    /// @brief The value of each PerfCounter
+    std::array<u64, PERF_COUNTER_COUNT> values = {};
+    /// @brief The bit (1 << PerfCounter) is set if the counter was read
+    u8 available = 0;
+
+    /// @brief Check if a counter was read
+    /// @param counter The counter
+    /// @return True if 'counter' is available
+    constexpr bool is_available(PerfCounter counter) const noexcept
+    {
+      return (available & (1 << static_cast<u8>(counter))) != 0;
+    }
+
+    /// @brief Returns the value of a counter
+    /// @param counter The counter
+    /// @return The value (0 if not available)
+    constexpr u64 operator[](PerfCounter counter) const noexcept
+    {
+      return values[static_cast<u8>(counter)];
+    }
+
+    /// @brief Returns the instructions per cycle
+    /// @return The IPC (0 if not available)
+    constexpr double ipc() const noexcept
+    {
+      if (!is_available(PerfCounter::CYCLES)
+          || !is_available(PerfCounter::INSTRUCTIONS)
+          || (*this)[PerfCounter::CYCLES] == 0)
+        return 0.0;
+      return static_cast<double>((*this)[PerfCounter::INSTRUCTIONS])
+             / static_cast<double>((*this)[PerfCounter::CYCLES]);
+    }
+
+    /// @brief Adds counts (only the counters available in both are kept,
+    ///        unless this is empty)
+    /// @param other The counts to add
+    /// @return Self
+    constexpr PerfCounts& operator+=(const PerfCounts& other) noexcept
+    {
+      available = ticks == 0 && available == 0 ? other.available
+                                               : u8(available & other.available);
+      ticks += other.ticks;
+      for (size_t i = 0; i < PERF_COUNTER_COUNT; i++)
+        values[i] += other.values[i];
+      return *this;
+    }
+
+    /// @brief Returns the counts between two readings
+    /// @param end The last reading
+    /// @param begin The first reading
+    /// @return The difference
+    friend constexpr PerfCounts operator-(
+        const PerfCounts& end, const PerfCounts& begin) noexcept
+    {
+      PerfCounts ret = {
+          end.ticks - begin.ticks, {}, u8(end.available & begin.available)};
+      for (size_t i = 0; i < PERF_COUNTER_COUNT; i++)
+        ret.values[i] = end.values[i] - begin.values[i];
+      return ret;
+    }
+  };
+
+  /// @brief Returns the name of a counter
+  /// @param counter The counter
+  /// @return The name (such as "cycles")
+  constexpr const char* to_str(PerfCounter counter) noexcept
+  {
+    switch_no_default(counter)
+    {
+    case PerfCounter::CYCLES:
+      return "cycles";
+    case PerfCounter::INSTRUCTIONS:
+      return "instructions";
+    case PerfCounter::CACHE_MISSES:
+      return "cache-misses";
+    case PerfCounter::BRANCH_MISSES:
+      return "branch-misses";
+    }
+  }
+
+  /// @brief The hardware counters of the thread that created them.
+  /// The counters run from the construction: reading them costs a
+  /// system call (and the timestamp counter), so a region is measured by
+  /// reading before and after it (see PerfScope).
+  class PerfCounters
+  {
+    /// @brief The file descriptors (-1 if not opened), the first opened
+    ///        one being the leader of the group
+    std::array<int, PERF_COUNTER_COUNT> fds;
+    /// @brief The counters that were opened (in the order of the group)
+    std::array<PerfCounter, PERF_COUNTER_COUNT> order;
+    /// @brief The count of opened counters
+    u8 opened = 0;
+    /// @brief The bit (1 << PerfCounter) is set if the counter was opened
+    u8 available_ = 0;
+
+  public:
+    /// @brief Opens the counters of the current thread.
+    /// The counters that cannot be opened are not available.
+    COLTCPP_EXPORT PerfCounters() noexcept;
+    /// @brief Closes the counters
+    COLTCPP_EXPORT ~PerfCounters() noexcept;
+
+    PerfCounters(const PerfCounters&)            = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /// @brief Move constructor
+    /// @param other The counters to move from (which are then closed)
+    COLTCPP_EXPORT PerfCounters(PerfCounters&& other) noexcept;
+    /// @brief Move assignment operator
+    /// @param other The counters to move from (which are then closed)
+    /// @return Self
+    COLTCPP_EXPORT PerfCounters& operator=(PerfCounters&& other) noexcept;
+
+    /// @brief Reads the counters.
+    /// Should be called by the thread that created the counters (the
+    /// counters only count the events of that thread).
+    /// @return The counts since the construction
+    [[nodiscard]] COLTCPP_EXPORT PerfCounts read() const noexcept;
+
+    /// @brief Returns the counters that were opened
+    /// @return The bit (1 << PerfCounter) is set if the counter is available
+    constexpr u8 available() const noexcept { return available_; }
+
+    /// @brief Check if a counter was opened
+    /// @param counter The counter
+    /// @return True if 'counter' is available
+    constexpr bool is_available(PerfCounter counter) const noexcept
+    {
+      return (available_ & (1 << static_cast<u8>(counter))) != 0;
+    }
+
+    /// @brief Returns the counters of the current thread (opened on the
+    ///        first call of each thread)
+    /// @return The counters of the current thread
+    COLTCPP_EXPORT static const PerfCounters& this_thread() noexcept;
+  };
+
+  /// @brief The counts of a region of code, summed over all the threads
+  ///        (and over all the executions of the region)
+  class PerfRegion
+  {
+    /// @brief The name of the region
+    const char* name_;
+    /// @brief The summed ticks
+    std::atomic<u64> ticks = 0;
+    /// @brief The summed counters
+    std::array<std::atomic<u64>, PERF_COUNTER_COUNT> values = {};
+    /// @brief The counters available in all the added counts
+    std::atomic<u8> available = 0xFF;
+    /// @brief The count of added counts
+    std::atomic<u64> count_ = 0;
+
+  public:
+    /// @brief Constructor
+    /// @param name The name of the region (which must outlive the region,
+    ///        such as a string literal)
+    constexpr PerfRegion(const char* name) noexcept
+        : name_(name)
+    {
+    }
+
+    PerfRegion(const PerfRegion&)            = delete;
+    PerfRegion& operator=(const PerfRegion&) = delete;
+
+    /// @brief Returns the name of the region
+    /// @return The name
+    constexpr const char* name() const noexcept { return name_; }
+
+    /// @brief Adds the counts of an execution of the region (thread-safe)
+    /// @param counts The counts
+    COLTCPP_EXPORT void add(const PerfCounts& counts) noexcept;
+
+    /// @brief Returns the summed counts
+    /// @return The counts (empty if none were added)
+    [[nodiscard]] COLTCPP_EXPORT PerfCounts total() const noexcept;
+
+    /// @brief Returns the count of executions that were added
+    /// @return The count of calls to 'add'
+    u64 count() const noexcept { return count_.load(std::memory_order_relaxed); }
+
+    /// @brief Resets the region (no thread may add concurrently)
+    COLTCPP_EXPORT void reset() noexcept;
+  };
+
+  /// @brief Adds the counts of its lifetime to a PerfRegion, and records
+  ///        its lifetime as a trace zone named like the region
+  class PerfScope
+  {
+    /// @brief The trace zone (started before reading the counters)
+    trace::ScopedZone zone;
+    /// @brief The region to add to
+    PerfRegion& region;
+    /// @brief The counters of the current thread
+    const PerfCounters& counters;
+    /// @brief The counts at the beginning of the scope
+    PerfCounts begin;
+
+  public:
+    /// @brief Starts measuring
+    /// @param region The region to add the counts to
+    /// @param src The location of the zone
+    PerfScope(
+        PerfRegion& region,
+        source_location src = source_location::current()) noexcept
+        : zone(region.name(), src)
+        , region(region)
+        , counters(PerfCounters::this_thread())
+        , begin(counters.read())
+    {
+    }
+
+    PerfScope(const PerfScope&)            = delete;
+    PerfScope(PerfScope&&)                 = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+    PerfScope& operator=(PerfScope&&)      = delete;
+
+    /// @brief Adds the counts to the region (before the zone ends)
+    ~PerfScope() noexcept { region.add(counters.read() - begin); }
+  };
+} // namespace clt
+
+#ifdef COLT_DISABLE_PERF_COUNTERS
+  /// @brief Adds the counts of the current scope to 'region' (disabled)
+  #define COLT_PERF_SCOPE(region) static_cast<void>(0)
+#else
+  /// @brief Adds the counts of the current scope to 'region' (a PerfRegion)
+  #define COLT_PERF_SCOPE(region) \
+    const ::clt::PerfScope COLT_CONCAT(colt_perf_scope_, __LINE__) = {region}
+#endif // COLT_DISABLE_PERF_COUNTERS
+
+template<>
+/// @brief {fmt} specialization of PerfCounts.
+/// Prints the available counters, such as:
+/// "1200 ticks, 1000 cycles, 2000 instructions (2.00 IPC), 3 cache-misses,
+/// 1 branch-misses".
+struct fmt::formatter<clt::PerfCounts>
+{
+  template<typename ParseContext>
+  constexpr auto parse(ParseContext& ctx)
+  {
+    return ctx.begin();
+  }
+
+  template<typename FormatContext>
+  auto format(const clt::PerfCounts& counts, FormatContext& ctx) const
+  {
+    using namespace clt;
+    auto out = fmt::format_to(ctx.out(), "{} ticks", counts.ticks);
+    for (u8 i = 0; i < PERF_COUNTER_COUNT; i++)
+    {
+      const auto counter = static_cast<PerfCounter>(i);
+      if (!counts.is_available(counter))
+        continue;
+      out = fmt::format_to(out, ", {} {}", counts[counter], to_str(counter));
+      if (counter == PerfCounter::INSTRUCTIONS && counts.ipc() != 0.0)
+        out = fmt::format_to(out, " ({:.2f} IPC)", counts.ipc());
+    }
+    return out;
+  }
+};
+
+#endif // !HG_COLT_PERF_COUNTERS
@@ -0,0 +1,558 @@
+/*****************************************************************/ /**
+ * @file   trace.cpp
+ * @brief  Contains the ring buffers and exporters of `trace.h`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "trace.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "colt/io/file.h"
+
+namespace clt::trace
+{
+  namespace details
+  {
+    std::atomic<bool> recording = false;
+  } // namespace details
+
+  /// @brief An event as stored in a ring buffer
+  struct RawEvent
+  {
+    /// @brief The name of the zone
+    const char* name;
+    /// @brief The location of the zone
+    source_location src;
+    /// @brief The beginning timestamp
+    u64 begin;
+    /// @brief The end timestamp
+    u64 end;
+  };
+
+  /// @brief The ring buffer of a thread
+  struct ThreadBuffer
+  {
+    /// @brief The events (of a power of 2 size)
+    std::unique_ptr<RawEvent[]> events;
+    /// @brief The capacity - 1
+    u64 mask;
+    /// @brief The count of events written (only written by the owner)
+    std::atomic<u64> head = 0;
+    /// @brief The index of the thread (in the exported traces)
+    u32 thread;
+    /// @brief False once the owning thread exited
+    std::atomic<bool> alive = true;
+    /// @brief The name of the thread (NUL-terminated)
+    char name[64] = {};
+
+    /// @brief Constructor
+    /// @param capacity The capacity (a power of 2)
+    /// @param thread The index of the thread
+    ThreadBuffer(u64 capacity, u32 thread) noexcept
+        : events(std::make_unique_for_overwrite<RawEvent[]>(capacity))
+        , mask(capacity - 1)
+        , thread(thread)
+    {
+    }
+  };
+
+  /// @brief The buffers of all the threads and the calibration of the clock
+  struct Registry
+  {
+    /// @brief Protects the registry
+    std::mutex mutex;
+    /// @brief The buffers (which are only freed on exit, but reused
+    ///        once they are empty and their thread exited)
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    /// @brief The capacity of the new buffers
+    u64 capacity = DEFAULT_EVENTS_PER_THREAD;
+    /// @brief The index of the next thread
+    u32 next_thread = 0;
+    /// @brief The timestamp of 'start'
+    u64 start_ticks = 0;
+    /// @brief The time of 'start'
+    std::chrono::steady_clock::time_point start_time = {};
+  };
+
+  /// @brief Returns the registry
+  /// @return The registry (never destroyed: threads may record on exit)
+  static Registry& registry() noexcept
+  {
+    static Registry* registry = new Registry();
+    return *registry;
+  }
+
+  /// @brief Marks the buffer of a thread as reusable when the thread exits
+  struct ThreadGuard
+  {
+    /// @brief The buffer of the current thread (or null)
+    ThreadBuffer* buffer = nullptr;
+
+    ~ThreadGuard() noexcept
+    {
+      if (buffer != nullptr)
+        buffer->alive.store(false, std::memory_order_release);
+    }
+  };
+
+  /// @brief The buffer of the current thread
+  static thread_local ThreadGuard current_thread;
+
+  /// @brief Returns the buffer of the current thread, registering it if needed
+  /// @return The buffer of the current thread
+  static ThreadBuffer& thread_buffer() noexcept
+  {
+    if (current_thread.buffer != nullptr) [[likely]]
+      return *current_thread.buffer;
+    auto& reg       = registry();
+    auto lock       = std::scoped_lock{reg.mutex};
+    const u32 index = reg.next_thread++;
+    // Reuses the empty buffer (of the current capacity) of a thread that exited
+    for (auto& buffer : reg.buffers)
+    {
+      if (!buffer->alive.load(std::memory_order_acquire)
+          && buffer->head.load(std::memory_order_relaxed) == 0
+          && buffer->mask + 1 == reg.capacity)
+      {
+        buffer->alive.store(true, std::memory_order_relaxed);
+        buffer->thread  = index;
+        buffer->name[0] = '\0';
+        return *(current_thread.buffer = buffer.get());
+      }
+    }
+    reg.buffers.push_back(std::make_unique<ThreadBuffer>(reg.capacity, index));
+    return *(current_thread.buffer = reg.buffers.back().get());
+  }
+
+  void details::record(
+      const char* name, const source_location& src, u64 begin, u64 end) noexcept
+  {
+    auto& buffer   = thread_buffer();
+    const u64 head = buffer.head.load(std::memory_order_relaxed);
+    buffer.events[head & buffer.mask] = {name, src, begin, end};
+    // Publishes the event to 'collect'
+    buffer.head.store(head + 1, std::memory_order_release);
+  }
+
+  void start(u32 events_per_thread) noexcept
+  {
+    auto& reg = registry();
+    {
+      auto lock       = std::scoped_lock{reg.mutex};
+      reg.capacity    = std::bit_ceil(std::max<u64>(events_per_thread, 2));
+      reg.start_ticks = details::timestamp();
+      reg.start_time  = std::chrono::steady_clock::now();
+    }
+    details::recording.store(true, std::memory_order_release);
+  }
+
+  void stop() noexcept
+  {
+    details::recording.store(false, std::memory_order_release);
+  }
+
+  void clear() noexcept
+  {
+    auto& reg = registry();
+    auto lock = std::scoped_lock{reg.mutex};
+    for (auto& buffer : reg.buffers)
+      buffer->head.store(0, std::memory_order_relaxed);
+  }
+
+  void set_thread_name(std::string_view name) noexcept
+  {
+    auto& buffer      = thread_buffer();
+    auto lock         = std::scoped_lock{registry().mutex};
+    const size_t size = std::min(name.size(), sizeof(buffer.name) - 1);
+    std::memcpy(buffer.name, name.data(), size);
+    buffer.name[size] = '\0';
+  }
+
+  u64 overwritten_count() noexcept
+  {
+    auto& reg = registry();
+    auto lock = std::scoped_lock{reg.mutex};
+    u64 count = 0;
+    for (auto& buffer : reg.buffers)
+    {
+      const u64 head = buffer->head.load(std::memory_order_acquire);
+      count += head > buffer->mask + 1 ? head - (buffer->mask + 1) : 0;
+    }
+    return count;
+  }
+
+  /// @brief The name of a thread in the exported traces
+  struct ThreadName
+  {
+    /// @brief The index of the thread
+    u32 thread;
+    /// @brief The name of the thread (empty if not named)
+    std::string name;
+  };
+
+  /// @brief Copies the recorded events and the name of the threads
+  /// @param names The names of the threads (that recorded events)
+  /// @return The events sorted by thread then beginning
+  static std::vector<Event> collect(std::vector<ThreadName>* names) noexcept
+  {
+    auto& reg = registry();
+    auto lock = std::scoped_lock{reg.mutex};
+
+    // Converts the ticks to nanoseconds using the steady clock since 'start'
+    const u64 ticks = details::timestamp() - reg.start_ticks;
+    const double ns = std::chrono::duration<double, std::nano>(
+                          std::chrono::steady_clock::now() - reg.start_time)
+                          .count();
+    const double ns_per_tick = ticks == 0 ? 1.0 : ns / static_cast<double>(ticks);
+    auto to_ns               = [&](u64 timestamp)
+    {
+      // Events recorded before the last 'start' are clamped to 0
+      if (timestamp < reg.start_ticks)
+        return u64{0};
+      return static_cast<u64>(
+          static_cast<double>(timestamp - reg.start_ticks) * ns_per_tick);
+    };
+
+    std::vector<Event> events;
+    for (auto& buffer : reg.buffers)
+    {
+      const u64 head  = buffer->head.load(std::memory_order_acquire);
+      const u64 count = std::min(head, buffer->mask + 1);
+      if (count != 0 && names != nullptr)
+        names->push_back({buffer->thread, buffer->name});
+      const size_t first = events.size();
+      for (u64 i = head - count; i < head; i++)
+      {
+        const auto& raw = buffer->events[i & buffer->mask];
+        const u64 begin = to_ns(raw.begin);
+        const u64 end   = std::max(begin, to_ns(raw.end));
+        events.push_back({raw.name, raw.src, buffer->thread, begin, end - begin});
+      }
+      // Zones are recorded when they end: sorts by beginning, enclosing
+      // zones before the zones they contain
+      std::sort(
+          events.begin() + first, events.end(),
+          [](const Event& a, const Event& b)
+          {
+            if (a.begin_ns != b.begin_ns)
+              return a.begin_ns < b.begin_ns;
+            return a.duration_ns > b.duration_ns;
+          });
+    }
+    std::sort(
+        events.begin(), events.end(),
+        [](const Event& a, const Event& b)
+        {
+          if (a.thread != b.thread)
+            return a.thread < b.thread;
+          if (a.begin_ns != b.begin_ns)
+            return a.begin_ns < b.begin_ns;
+          return a.duration_ns > b.duration_ns;
+        });
+    return events;
+  }
+
+  std::vector<Event> collect() noexcept
+  {
+    return collect(nullptr);
+  }
+
+  /// @brief Buffers the output of the exporters, writing it in chunks
+  class TraceWriter
+  {
+    /// @brief The size above which the buffer is written
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    /// @brief The file to write to
+    File& file;
+    /// @brief The buffered output
+    std::string buffer;
+    /// @brief True if a write failed
+    bool failed = false;
+
+  public:
+    /// @brief Constructor
+    /// @param file The file to write to
+    TraceWriter(File& file) noexcept
+        : file(file)
+    {
+    }
+
+    /// @brief Returns the buffer, writing it if it is large enough
+    /// @return The buffer to append to
+    std::string& out() noexcept
+    {
+      if (buffer.size() >= CHUNK_SIZE)
+        flush();
+      return buffer;
+    }
+
+    /// @brief Writes the buffer
+    void flush() noexcept
+    {
+      if (!failed && !buffer.empty())
+      {
+        auto written = file.write(
+            View<u8>{ptr_to<const u8*>(buffer.data()), buffer.size()});
+        failed = written.is_none() || *written != buffer.size();
+      }
+      buffer.clear();
+    }
+
+    /// @brief Writes the rest of the output
+    /// @return Error if a write failed
+    ErrorFlag finish() noexcept
+    {
+      flush();
+      return failed ? ErrorFlag::error() : ErrorFlag::success();
+    }
+  };
+
+  /// @brief Appends a string as a JSON string literal
+  /// @param out The output
+  /// @param str The string
+  static void append_json_string(std::string& out, std::string_view str) noexcept
+  {
+    out.push_back('"');
+    for (char c : str)
+    {
+      if (c == '"' || c == '\\')
+        out.push_back('\\');
+      if (static_cast<unsigned char>(c) < 0x20)
+        fmt::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<int>(c));
+      else
+        out.push_back(c);
+    }
+    out.push_back('"');
+  }
+
+  ErrorFlag write_chrome_trace(File& file) noexcept
+  {
+    std::vector<ThreadName> names;
+    const auto events = collect(&names);
+
+    auto writer = TraceWriter{file};
+    writer.out() += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& [thread, name] : names)
+    {
+      if (name.empty())
+        continue;
+      auto& out = writer.out();
+      fmt::format_to(
+          std::back_inserter(out),
+          "{}\n{{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":{},"
+          "\"args\":{{\"name\":",
+          first ? "" : ",", thread);
+      append_json_string(out, name);
+      out += "}}";
+      first = false;
+    }
+    for (const auto& event : events)
+    {
+      // Timestamps are in microseconds
+      auto& out = writer.out();
+      fmt::format_to(std::back_inserter(out), "{}\n{{\"name\":", first ? "" : ",");
+      append_json_string(out, event.name);
+      fmt::format_to(
+          std::back_inserter(out),
+          ",\"cat\":\"colt\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},"
+          "\"dur\":{:.3f},\"args\":{{\"function\":",
+          event.thread, static_cast<double>(event.begin_ns) / 1000.0,
+          static_cast<double>(event.duration_ns) / 1000.0);
+      append_json_string(out, event.src.function_name());
+      out += ",\"file\":";
+      append_json_string(out, event.src.file_name());
+      fmt::format_to(std::back_inserter(out), ",\"line\":{}}}}}", event.src.line());
+      first = false;
+    }
+    writer.out() += "\n]}\n";
+    return writer.finish();
+  }
+
+  /// @brief Encodes protobuf messages (the subset used by Perfetto traces)
+  namespace protobuf
+  {
+    /// @brief Appends a varint
+    /// @param out The output
+    /// @param value The value to encode
+    static void varint(std::string& out, u64 value) noexcept
+    {
+      while (value >= 0x80)
+      {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+      }
+      out.push_back(static_cast<char>(value));
+    }
+
+    /// @brief Appends a varint field
+    /// @param out The output
+    /// @param field The field number
+    /// @param value The value
+    static void field(std::string& out, u32 field, u64 value) noexcept
+    {
+      varint(out, u64{field} << 3); // wire type 0: varint
+      varint(out, value);
+    }
+
+    /// @brief Appends a length-delimited field (string or message)
+    /// @param out The output
+    /// @param field The field number
+    /// @param bytes The content of the field
+    static void field(std::string& out, u32 field, std::string_view bytes) noexcept
+    {
+      varint(out, (u64{field} << 3) | 2); // wire type 2: length-delimited
+      varint(out, bytes.size());
+      out += bytes;
+    }
+  } // namespace protobuf
+
+  /// @brief The field numbers of the Perfetto protos
+  /// (protos/perfetto/trace/trace_packet.proto and track_event/*.proto)
+  enum PerfettoField : u32
+  {
+    TRACE_PACKET                 = 1,
+    PACKET_TIMESTAMP             = 8,
+    PACKET_SEQUENCE_ID           = 10,
+    PACKET_TRACK_EVENT           = 11,
+    PACKET_TRACK_DESCRIPTOR      = 60,
+    TRACK_DESCRIPTOR_UUID        = 1,
+    TRACK_DESCRIPTOR_THREAD      = 4,
+    THREAD_DESCRIPTOR_PID        = 1,
+    THREAD_DESCRIPTOR_TID        = 2,
+    THREAD_DESCRIPTOR_NAME       = 5,
+    TRACK_EVENT_DEBUG_ANNOTATION = 4,
+    TRACK_EVENT_TYPE             = 9,
+    TRACK_EVENT_TRACK_UUID       = 11,
+    TRACK_EVENT_CATEGORIES       = 22,
+    TRACK_EVENT_NAME             = 23,
+    DEBUG_ANNOTATION_UINT        = 3,
+    DEBUG_ANNOTATION_STRING      = 6,
+    DEBUG_ANNOTATION_NAME        = 10,
+    TYPE_SLICE_BEGIN             = 1,
+    TYPE_SLICE_END               = 2,
+  };
+
+  /// @brief The sequence of all the packets (there is a single writer)
+  static constexpr u64 PERFETTO_SEQUENCE = 1;
+
+  /// @brief Returns the uuid of the track of a thread
+  /// @param thread The index of the thread
+  /// @return The uuid
+  static constexpr u64 thread_uuid(u32 thread) noexcept
+  {
+    return 0xC017'0000'0000 + thread;
+  }
+
+  /// @brief Appends a packet to the trace
+  /// @param out The output
+  /// @param packet The content of the packet
+  static void append_packet(std::string& out, const std::string& packet) noexcept
+  {
+    protobuf::field(out, TRACE_PACKET, packet);
+  }
+
+  /// @brief Appends a slice begin or end packet
+  /// @param out The output
+  /// @param packet The buffer used to build the packet
+  /// @param message The buffer used to build the track event
+  /// @param timestamp The timestamp of the packet
+  /// @param thread The index of the thread
+  /// @param event The event (null for a slice end)
+  static void append_slice(
+      std::string& out, std::string& packet, std::string& message, u64 timestamp,
+      u32 thread, const Event* event) noexcept
+  {
+    message.clear();
+    protobuf::field(
+        message, TRACK_EVENT_TYPE, event ? TYPE_SLICE_BEGIN : TYPE_SLICE_END);
+    protobuf::field(message, TRACK_EVENT_TRACK_UUID, thread_uuid(thread));
+    if (event != nullptr)
+    {
+      protobuf::field(message, TRACK_EVENT_CATEGORIES, "colt");
+      protobuf::field(message, TRACK_EVENT_NAME, event->name);
+      std::string annotation;
+      protobuf::field(annotation, DEBUG_ANNOTATION_NAME, "function");
+      protobuf::field(
+          annotation, DEBUG_ANNOTATION_STRING, event->src.function_name());
+      protobuf::field(message, TRACK_EVENT_DEBUG_ANNOTATION, annotation);
+      annotation.clear();
+      protobuf::field(annotation, DEBUG_ANNOTATION_NAME, "file");
+      protobuf::field(annotation, DEBUG_ANNOTATION_STRING, event->src.file_name());
+      protobuf::field(message, TRACK_EVENT_DEBUG_ANNOTATION, annotation);
+      annotation.clear();
+      protobuf::field(annotation, DEBUG_ANNOTATION_NAME, "line");
+      protobuf::field(annotation, DEBUG_ANNOTATION_UINT, event->src.line());
+      protobuf::field(message, TRACK_EVENT_DEBUG_ANNOTATION, annotation);
+    }
+    packet.clear();
+    protobuf::field(packet, PACKET_TIMESTAMP, timestamp);
+    protobuf::field(packet, PACKET_SEQUENCE_ID, PERFETTO_SEQUENCE);
+    protobuf::field(packet, PACKET_TRACK_EVENT, message);
+    append_packet(out, packet);
+  }
+
+  ErrorFlag write_perfetto_trace(File& file) noexcept
+  {
+    std::vector<ThreadName> names;
+    const auto events = collect(&names);
+
+    auto writer = TraceWriter{file};
+    std::string packet, message, thread;
+    // A track per thread
+    for (const auto& [index, name] : names)
+    {
+      thread.clear();
+      protobuf::field(thread, THREAD_DESCRIPTOR_PID, 1);
+      protobuf::field(thread, THREAD_DESCRIPTOR_TID, index + 1);
+      protobuf::field(
+          thread, THREAD_DESCRIPTOR_NAME,
+          name.empty() ? fmt::format("Thread {}", index) : name);
+      message.clear();
+      protobuf::field(message, TRACK_DESCRIPTOR_UUID, thread_uuid(index));
+      protobuf::field(message, TRACK_DESCRIPTOR_THREAD, thread);
+      packet.clear();
+      protobuf::field(packet, PACKET_SEQUENCE_ID, PERFETTO_SEQUENCE);
+      protobuf::field(packet, PACKET_TRACK_DESCRIPTOR, message);
+      append_packet(writer.out(), packet);
+    }
+
+    // Slices must be nested: the zones that ended are closed before
+    // opening the next one (events are sorted by beginning per thread)
+    std::vector<const Event*> open;
+    auto close_until = [&](u64 timestamp)
+    {
+      while (!open.empty()
+             && open.back()->begin_ns + open.back()->duration_ns <= timestamp)
+      {
+        const Event* event = open.back();
+        append_slice(
+            writer.out(), packet, message, event->begin_ns + event->duration_ns,
+            event->thread, nullptr);
+        open.pop_back();
+      }
+    };
+    for (size_t i = 0; i < events.size(); i++)
+    {
+      const auto& event = events[i];
+      if (!open.empty() && open.back()->thread != event.thread)
+        close_until(~u64{0});
+      close_until(event.begin_ns);
+      append_slice(
+          writer.out(), packet, message, event.begin_ns, event.thread, &event);
+      open.push_back(&event);
+    }
+    close_until(~u64{0});
+    return writer.finish();
+  }
+} // namespace clt::trace
@@ -0,0 +1,205 @@
+/*****************************************************************/ /**
+ * @file   trace.h
+ * @brief  Contains scoped tracing zones, recorded in per-thread ring
+ * buffers and exported as Chrome trace events (JSON) or as a Perfetto
+ * trace (protobuf), which can both be opened in ui.perfetto.dev.
+ *
+ * @code{.cpp}
+ * void compile(const char* path)
+ * {
+ *   COLT_TRACE_SCOPE("compile");
+ *   ...
+ * }
+ * trace::start();
+ * compile("main.ct");
+ * trace::stop();
+ * auto file = File::open("trace.json", File::Write);
+ * (void)trace::write_chrome_trace(*file);
+ * @endcode
+ *
+ * A zone reads the timestamp counter (rdtsc on x86, cntvct on AArch64,
+ * the steady clock elsewhere) on entry and on exit, and only writes an
+ * event when it ends: when tracing is not started, a zone costs a load
+ * and a branch. Defining COLT_DISABLE_TRACING removes the zones entirely.
+ * Zones can be used in constexpr functions (they do nothing during
+ * constant evaluation).
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_COLT_TRACE
+#define HG_COLT_TRACE
+
+#include <atomic>
+#include <chrono>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "colt/typedefs.h"
+#include "colt/macros.h"
+#include "colt/coltcpp_export.h"
+
+#if defined(COLT_x86_64)
+  #if defined(COLT_MSVC)
+    #include <intrin.h>
+  #else
+    #include <x86intrin.h>
+  #endif // COLT_MSVC
+#endif // COLT_x86_64
+
+namespace clt
+{
+  class File;
+}
+
+namespace clt::trace
+{
+  /// @brief The default capacity (in events) of the buffer of a thread
+  inline constexpr u32 DEFAULT_EVENTS_PER_THREAD = 16 * 1024;
+
+  namespace details
+  {
+    /// @brief True while zones are recorded
+    COLTCPP_EXPORT extern std::atomic<bool> recording;
+
+    /// @brief Reads the timestamp counter
+    /// @return The timestamp (in an unspecified unit, converted on export)
+    HEDLEY_ALWAYS_INLINE u64 timestamp() noexcept
+    {
+#if defined(COLT_x86_64)
+      return __rdtsc();
+#elif defined(__aarch64__) && !defined(COLT_MSVC)
+      u64 value;
+      asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+      return value;
+#else
+      using namespace std::chrono;
+      const auto now = steady_clock::now().time_since_epoch();
+      return static_cast<u64>(duration_cast<nanoseconds>(now).count());
+#endif // COLT_x86_64
+    }
+
+    /// @brief Writes an event in the buffer of the current thread
+    /// @param name The name of the zone
+    /// @param src The location of the zone
+    /// @param begin The timestamp of the beginning of the zone
+    /// @param end The timestamp of the end of the zone
+    COLTCPP_EXPORT void record(
+        const char* name, const source_location& src, u64 begin, u64 end) noexcept;
+  } // namespace details
+
+  /// @brief Starts recording zones.
+  /// Each thread records its zones in a ring buffer, allocated on its
+  /// first zone: when full, the oldest events are overwritten.
+  /// @param events_per_thread The capacity of the buffers that are not
+  ///        yet allocated (rounded up to a power of 2)
+  COLTCPP_EXPORT void start(
+      u32 events_per_thread = DEFAULT_EVENTS_PER_THREAD) noexcept;
+
+  /// @brief Stops recording zones (the recorded events are kept).
+  /// Zones that already started are still recorded when they end.
+  COLTCPP_EXPORT void stop() noexcept;
+
+  /// @brief Check if zones are being recorded
+  /// @return True between 'start' and 'stop'
+  inline bool is_recording() noexcept
+  {
+    return details::recording.load(std::memory_order_relaxed);
+  }
+
+  /// @brief Discards all the recorded events.
+  /// No zone may end concurrently (this should be called after 'stop').
+  COLTCPP_EXPORT void clear() noexcept;
+
+  /// @brief Names the current thread in the exported traces
+  /// @param name The name (truncated to 63 bytes)
+  COLTCPP_EXPORT void set_thread_name(std::string_view name) noexcept;
+
+  /// @brief A recorded zone
+  struct Event
+  {
+    /// @brief The name of the zone
+    const char* name;
+    /// @brief The location of the zone
+    source_location src;
+    /// @brief The index of the thread that recorded the zone
+    u32 thread;
+    /// @brief The beginning of the zone, in nanoseconds since 'start'
+    u64 begin_ns;
+    /// @brief The duration of the zone in nanoseconds
+    u64 duration_ns;
+  };
+
+  /// @brief Returns the recorded events, sorted by thread then beginning.
+  /// No zone should end concurrently (this should be called after 'stop'):
+  /// the oldest events of a buffer may be overwritten while copied.
+  /// @return The recorded events
+  [[nodiscard]] COLTCPP_EXPORT std::vector<Event> collect() noexcept;
+
+  /// @brief Returns the count of events overwritten because a ring buffer
+  ///        was full
+  /// @return The count of lost events since the last 'clear'
+  [[nodiscard]] COLTCPP_EXPORT u64 overwritten_count() noexcept;
+
+  /// @brief Writes the recorded events as Chrome trace events (JSON).
+  /// The file can be opened in chrome://tracing or ui.perfetto.dev.
+  /// @param file The file to write to
+  /// @return Error if writing to 'file' failed
+  [[nodiscard]] COLTCPP_EXPORT ErrorFlag write_chrome_trace(File& file) noexcept;
+
+  /// @brief Writes the recorded events as a Perfetto trace (protobuf).
+  /// The file can be opened in ui.perfetto.dev or queried through the
+  /// trace processor.
+  /// @param file The file to write to
+  /// @return Error if writing to 'file' failed
+  [[nodiscard]] COLTCPP_EXPORT ErrorFlag write_perfetto_trace(File& file) noexcept;
+
+  /// @brief Records the duration of its lifetime as a zone
+  class ScopedZone
+  {
+    /// @brief The name of the zone
+    const char* name;
+    /// @brief The location of the zone
+    source_location src;
+    /// @brief The beginning of the zone (0 if not recorded)
+    u64 begin = 0;
+
+  public:
+    /// @brief Starts a zone (if recording)
+    /// @param name The name of the zone (which must outlive the traces,
+    ///        such as a string literal)
+    /// @param src The location of the zone
+    constexpr ScopedZone(
+        const char* name, source_location src = source_location::current()) noexcept
+        : name(name)
+        , src(src)
+    {
+      if (!std::is_constant_evaluated() && is_recording())
+        begin = details::timestamp();
+    }
+
+    ScopedZone(const ScopedZone&)            = delete;
+    ScopedZone(ScopedZone&&)                 = delete;
+    ScopedZone& operator=(const ScopedZone&) = delete;
+    ScopedZone& operator=(ScopedZone&&)      = delete;
+
+    /// @brief Ends the zone (and records it if it started while recording)
+    constexpr ~ScopedZone() noexcept
+    {
+      if (!std::is_constant_evaluated() && begin != 0)
+        details::record(name, src, begin, details::timestamp());
+    }
+  };
+} // namespace clt::trace
+
+#ifdef COLT_DISABLE_TRACING
+  /// @brief Records the current scope as a zone named 'name' (disabled)
+  #define COLT_TRACE_SCOPE(name) static_cast<void>(0)
+#else
+  /// @brief Records the current scope as a zone named 'name'
+  #define COLT_TRACE_SCOPE(name) \
+    const ::clt::trace::ScopedZone COLT_CONCAT(colt_trace_zone_, __LINE__) = {name}
+#endif // COLT_DISABLE_TRACING
+
+#endif // !HG_COLT_TRACE
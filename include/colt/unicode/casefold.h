@@ -0,0 +1,429 @@
+/*****************************************************************//**
+ * @file   casefold.h
+ * @brief  Contains case-insensitive comparison and hashing of views.
+ *
+ * `casefold` returns the full case folding of a code point.
+ * `casefold_compare` compares two views of any encoding once folded.
+ * `casefold_hash` hashes a view once folded (encoding independent).
+ * `casefold_into` writes the case folding of a view to a buffer.
+ * None of these functions allocate: CaseFoldHash and CaseFoldEqual
+ * can thus be used as the hasher and comparator of a Map or Set to
+ * perform case-insensitive lookups without folding the key first.
+ * The folding is the full case folding of `CaseFolding.txt` (statuses
+ * C and F): it is locale independent, so the Turkic mappings are ignored.
+ * Runs of ASCII are folded using SIMD instructions for ASCII and UTF8.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_UNICODE_CASEFOLD
+#define HG_UNICODE_CASEFOLD
+
+#include <compare>
+#include "colt/hash.h"
+#include "colt/dsa/string_view.h"
+#include "transcode.h"
+#include "properties.h"
+
+namespace clt::uni
+{
+  /// @brief The maximum count of code points of the folding of a code point
+  inline constexpr size_t CASEFOLD_MAX = 3;
+
+  /// @brief The full case folding of a code point
+  struct CaseFolded
+  {
+    /// @brief The code points (only the first 'count' are valid)
+    char32_t code_points[CASEFOLD_MAX];
+    /// @brief The count of code points [1, CASEFOLD_MAX]
+    u8 count;
+
+    /// @brief Returns the first code point
+    /// @return Pointer to the first code point
+    constexpr const char32_t* begin() const noexcept { return code_points; }
+    /// @brief Returns the end of the code points
+    /// @return Pointer past the last code point
+    constexpr const char32_t* end() const noexcept { return code_points + count; }
+  };
+
+  /// @brief Returns the full case folding of a code point.
+  /// @code{.cpp}
+  /// static_assert(uni::casefold(U'A').code_points[0] == U'a');
+  /// static_assert(uni::casefold(U'\u00DF').count == 2); // "ss"
+  /// @endcode
+  /// @param code_point The code point to fold
+  /// @return The code points it folds to (itself if it does not fold)
+  constexpr CaseFolded casefold(char32_t code_point) noexcept
+  {
+    const uint32_t* entry = details::casefold_mapping(code_point);
+    return {
+        {static_cast<char32_t>(code_point + entry[0]),
+         static_cast<char32_t>(entry[1]), static_cast<char32_t>(entry[2])},
+        static_cast<u8>(1 + (u8)(entry[1] != 0) + (u8)(entry[2] != 0))};
+  }
+
+  namespace details
+  {
+    /// @brief Check if an encoding is handled by the ASCII SIMD kernels
+    /// @param encoding The encoding
+    /// @return True for ASCII and UTF8
+    constexpr bool is_casefold8_encoding(StringEncoding encoding) noexcept
+    {
+      return encoding == StringEncoding::ASCII || encoding == StringEncoding::UTF8;
+    }
+
+    /// @brief Decodes a code point of a (supposedly valid) view.
+    /// Invalid units are decoded as U+FFFD, one unit at a time.
+    /// @tparam T The char type
+    /// @param ptr The start of the code point (advanced past it)
+    /// @param end The end of the view
+    /// @return The decoded code point
+    template<meta::CharType T>
+    constexpr char32_t lossy_decode(const T*& ptr, const T* end) noexcept
+    {
+      char32_t cp;
+      if (checked_decode(ptr, end, cp)) [[likely]]
+        return cp;
+      ++ptr;
+      return U'\uFFFD';
+    }
+
+    /// @brief Stream of the folded code points of a view
+    /// @tparam ENCODING The encoding of the view
+    template<StringEncoding ENCODING>
+    class CaseFoldCursor
+    {
+      using ptr_t = meta::encoding_to_char_t<ENCODING>;
+
+      /// @brief The next unit to fold
+      const ptr_t* _ptr;
+      /// @brief The end of the view
+      const ptr_t* _end;
+      /// @brief The folding of the last decoded code point
+      CaseFolded _folded = {{}, 0};
+      /// @brief The index of the next code point of '_folded' to return
+      u8 _index = 0;
+
+    public:
+      /// @brief Constructs a stream over the units [ptr, end)
+      /// @param ptr The start of the units
+      /// @param end The end of the units
+      constexpr CaseFoldCursor(const ptr_t* ptr, const ptr_t* end) noexcept
+          : _ptr(ptr)
+          , _end(end)
+      {
+      }
+
+      /// @brief Check if all the folded code points were returned
+      /// @return True if there are no more code points
+      constexpr bool is_end() const noexcept
+      {
+        return _index == _folded.count && _ptr == _end;
+      }
+
+      /// @brief Returns the next folded code point
+      /// @return The next folded code point
+      /// @pre !is_end()
+      constexpr char32_t next() noexcept
+      {
+        if (_index == _folded.count)
+        {
+          _folded = casefold(lossy_decode(_ptr, _end));
+          _index  = 0;
+        }
+        return _folded.code_points[_index++];
+      }
+    };
+
+    /// @brief Check if a type is a BasicStringView
+    template<typename T>
+    struct is_string_view : std::false_type
+    {
+    };
+
+    /// @brief Check if a type is a BasicStringView
+    template<StringEncoding ENCODING, bool ZSTRING>
+    struct is_string_view<BasicStringView<ENCODING, ZSTRING>> : std::true_type
+    {
+    };
+
+    /// @brief Check if a type is a (possibly cv-qualified) BasicStringView
+    template<typename T>
+    concept StringViewType = is_string_view<std::remove_cvref_t<T>>::value;
+
+    /// @brief A BasicStringView or a type convertible to one using 'to_view()'
+    /// (such as BasicString) or 'to_zview()' (such as UnicodeLiteral).
+    template<typename T>
+    concept StringViewLike =
+        StringViewType<T>
+        || requires(const T& str) {
+             { str.to_view() } -> StringViewType;
+           }
+        || requires(const T& str) {
+             { str.to_zview() } -> StringViewType;
+           };
+
+    /// @brief Returns the view of a StringViewLike
+    /// @tparam T The view, string or literal type
+    /// @param str The view, string or literal
+    /// @return The view
+    template<StringViewLike T>
+    constexpr auto as_view(const T& str) noexcept
+    {
+      if constexpr (StringViewType<T>)
+        return str;
+      else if constexpr (requires { str.to_view(); })
+        return str.to_view();
+      else
+        return str.to_zview();
+    }
+  } // namespace details
+
+  /// @brief Compares the full case folding of two views.
+  /// The views are compared lexicographically by folded code points, which
+  /// means that the result does not depend on the encodings of the views.
+  /// For ASCII and UTF8, the common ASCII prefix is skipped using SIMD.
+  /// @code{.cpp}
+  /// assert(uni::casefold_compare("Hello"_UTF8, "hELLO"_UTF8) == 0);
+  /// @endcode
+  /// @tparam T The first view, string or literal type
+  /// @tparam U The second view, string or literal type
+  /// @param a_str The first view, string or literal
+  /// @param b_str The second view, string or literal
+  /// @return Result of the comparison of the folded views
+  template<details::StringViewLike T, details::StringViewLike U>
+  constexpr std::strong_ordering casefold_compare(
+      const T& a_str, const U& b_str) noexcept
+  {
+    const auto a                       = details::as_view(a_str);
+    const auto b                       = details::as_view(b_str);
+    constexpr StringEncoding ENCODING1 = decltype(a)::STR_ENCODING;
+    constexpr StringEncoding ENCODING2 = decltype(b)::STR_ENCODING;
+
+    auto a_ptr       = a.data();
+    auto b_ptr       = b.data();
+    const auto a_end = a_ptr + a.unit_len();
+    const auto b_end = b_ptr + b.unit_len();
+    if constexpr (
+        details::is_casefold8_encoding(ENCODING1)
+        && details::is_casefold8_encoding(ENCODING2))
+    {
+      if (!std::is_constant_evaluated())
+      {
+        const size_t prefix = details::casefold_prefix8(
+            ptr_to<const char*>(a_ptr), ptr_to<const char*>(b_ptr),
+            std::min(a.unit_len(), b.unit_len()));
+        a_ptr += prefix;
+        b_ptr += prefix;
+      }
+    }
+    details::CaseFoldCursor<ENCODING1> a_cursor = {a_ptr, a_end};
+    details::CaseFoldCursor<ENCODING2> b_cursor = {b_ptr, b_end};
+    while (!a_cursor.is_end() && !b_cursor.is_end())
+    {
+      const char32_t a_cp = a_cursor.next();
+      const char32_t b_cp = b_cursor.next();
+      if (a_cp != b_cp)
+        return a_cp <=> b_cp;
+    }
+    return !a_cursor.is_end() <=> !b_cursor.is_end();
+  }
+
+  /// @brief Check if the full case folding of two views are equal.
+  /// @tparam T The first view, string or literal type
+  /// @tparam U The second view, string or literal type
+  /// @param a The first view, string or literal
+  /// @param b The second view, string or literal
+  /// @return True if both views are equal once folded
+  template<details::StringViewLike T, details::StringViewLike U>
+  constexpr bool casefold_equal(const T& a, const U& b) noexcept
+  {
+    return casefold_compare(a, b) == 0;
+  }
+
+  /// @brief Returns the number of units needed to write the case folding of 'view'.
+  /// Use this function to allocate the output of 'casefold_into' once.
+  /// @tparam T The view, string or literal type
+  /// @param str The view, string or literal to fold
+  /// @return The number of units of the folded view
+  template<details::StringViewLike T>
+  constexpr size_t casefold_size(const T& str) noexcept
+  {
+    const auto view  = details::as_view(str);
+    using ptr_t      = typename decltype(view)::underlying_type;
+    const ptr_t* ptr = view.data();
+    const ptr_t* end = ptr + view.unit_len();
+    size_t result    = 0;
+    while (ptr != end)
+    {
+      for (char32_t cp : casefold(details::lossy_decode(ptr, end)))
+        result += details::encoded_units<ptr_t>(cp);
+    }
+    return result;
+  }
+
+  /// @brief Writes the full case folding of 'view' to 'to' (in the same encoding).
+  /// For ASCII and UTF8, runs of ASCII are folded using SIMD.
+  /// On error, the content of 'to' is unspecified.
+  /// @tparam T The view, string or literal type
+  /// @param str The view, string or literal to fold
+  /// @param to The buffer where to write
+  /// @return The number of units written or NOT_ENOUGH_SPACE
+  template<details::StringViewLike T>
+  constexpr Expect<size_t, ConvError> casefold_into(
+      const T& str,
+      Span<typename decltype(details::as_view(str))::underlying_type> to) noexcept
+  {
+    const auto view                   = details::as_view(str);
+    constexpr StringEncoding ENCODING = decltype(view)::STR_ENCODING;
+    using ptr_t                       = typename decltype(view)::underlying_type;
+    const ptr_t* ptr    = view.data();
+    const ptr_t* end    = ptr + view.unit_len();
+    ptr_t* result       = to.data();
+    ptr_t* const max_to = result + to.size();
+    while (ptr != end)
+    {
+      if constexpr (details::is_casefold8_encoding(ENCODING))
+      {
+        if (!std::is_constant_evaluated())
+        {
+          const size_t count = details::casefold8(
+              ptr_to<const char*>(ptr),
+              std::min<size_t>(end - ptr, max_to - result), ptr_to<char*>(result));
+          ptr += count;
+          result += count;
+          if (ptr == end)
+            break;
+        }
+      }
+      for (char32_t cp : casefold(details::lossy_decode(ptr, end)))
+      {
+        if (static_cast<size_t>(max_to - result) < details::encoded_units<ptr_t>(cp))
+          return {Error, ConvError::NOT_ENOUGH_SPACE};
+        result = details::unchecked_encode(cp, result);
+      }
+    }
+    return static_cast<size_t>(result - to.data());
+  }
+
+  namespace details
+  {
+    /// @brief Appends the full case folding of 'view' to a hashing algorithm.
+    /// The folding is hashed as UTF8, in chunks of CHUNK_SIZE bytes (except
+    /// for the last one): as the chunks do not depend on the encoding of the
+    /// view, neither does the result (for any algorithm).
+    /// @tparam Algo The hashing algorithm
+    /// @tparam ENCODING The encoding of the view
+    /// @tparam ZSTRING True if the view is NUL-terminated
+    /// @param algo The hashing algorithm object
+    /// @param view The view to hash
+    template<meta::hash_algorithm Algo, StringEncoding ENCODING, bool ZSTRING>
+    void casefold_hash_append(
+        Algo& algo, const BasicStringView<ENCODING, ZSTRING>& view) noexcept
+    {
+      using ptr_t                        = meta::encoding_to_char_t<ENCODING>;
+      static constexpr size_t CHUNK_SIZE = 64;
+
+      char buffer[CHUNK_SIZE];
+      size_t size      = 0;
+      const ptr_t* ptr = view.data();
+      const ptr_t* end = ptr + view.unit_len();
+      while (ptr != end)
+      {
+        if constexpr (is_casefold8_encoding(ENCODING))
+        {
+          const size_t count = casefold8(
+              ptr_to<const char*>(ptr),
+              std::min<size_t>(end - ptr, CHUNK_SIZE - size), buffer + size);
+          ptr += count;
+          size += count;
+        }
+        if (size == CHUNK_SIZE)
+        {
+          algo(buffer, CHUNK_SIZE);
+          size = 0;
+          continue;
+        }
+        if (ptr == end)
+          break;
+        for (char32_t cp : casefold(lossy_decode(ptr, end)))
+        {
+          Char8 units[4];
+          const auto units_end = unchecked_encode(cp, units);
+          for (auto unit = units; unit != units_end; ++unit)
+          {
+            buffer[size++] = static_cast<char>(*unit);
+            if (size == CHUNK_SIZE)
+            {
+              algo(buffer, CHUNK_SIZE);
+              size = 0;
+            }
+          }
+        }
+      }
+      if (size != 0)
+        algo(buffer, size);
+    }
+  } // namespace details
+
+  /// @brief Hashes the full case folding of a view.
+  /// Views that are equal using 'casefold_compare' have the same hash,
+  /// whatever their encodings.
+  /// @tparam Algo The hashing algorithm
+  /// @tparam T The view, string or literal type
+  /// @param str The view, string or literal to hash
+  /// @return The hash of the folded view
+  template<meta::hash_algorithm Algo = fnv1a_h, details::StringViewLike T>
+  typename Algo::result_type casefold_hash(const T& str) noexcept
+  {
+    Algo algo;
+    details::casefold_hash_append(algo, details::as_view(str));
+    return static_cast<typename Algo::result_type>(algo);
+  }
+
+  /// @brief Case-insensitive hasher, to use with CaseFoldEqual in a Map or Set.
+  /// As it is transparent, both views and strings of any encoding can be
+  /// looked up without allocating.
+  /// @code{.cpp}
+  /// Map<u8StringView, int, uni::CaseFoldHash<>, uni::CaseFoldEqual> keywords;
+  /// keywords.find("WHILE"_UTF8); // finds "while"
+  /// @endcode
+  /// @tparam Algo The hashing algorithm (see 'casefold_hash')
+  template<meta::hash_algorithm Algo = fnv1a_h>
+  struct CaseFoldHash
+  {
+    /// @brief Allows heterogeneous lookups
+    using is_transparent = void;
+
+    /// @brief Hashes the full case folding of a view or string
+    /// @tparam T The view or string type
+    /// @param str The view or string to hash
+    /// @return The hash of the folded view
+    template<details::StringViewLike T>
+    size_t operator()(const T& str) const noexcept
+    {
+      return static_cast<size_t>(casefold_hash<Algo>(str));
+    }
+  };
+
+  /// @brief Case-insensitive equality, to use with CaseFoldHash in a Map or Set.
+  struct CaseFoldEqual
+  {
+    /// @brief Allows heterogeneous lookups
+    using is_transparent = void;
+
+    /// @brief Check if two views or strings are equal once folded
+    /// @tparam T The first view or string type
+    /// @tparam U The second view or string type
+    /// @param a The first view or string
+    /// @param b The second view or string
+    /// @return True if both are equal once folded
+    template<details::StringViewLike T, details::StringViewLike U>
+    constexpr bool operator()(const T& a, const U& b) const noexcept
+    {
+      return casefold_equal(a, b);
+    }
+  };
+} // namespace clt::uni
+
+#endif // !HG_UNICODE_CASEFOLD
@@ -0,0 +1,162 @@
+/*****************************************************************//**
+ * @file   display_width.h
+ * @brief  Contains display_width, offset_to_column and column_to_offset,
+ *         which compute the count of terminal columns of a view (used to
+ *         place carets under the source of diagnostics).
+ * The width of each code point is read from the generated Display_Width
+ * table (see 'details::display_width_of'):
+ * - 0 for marks (Mn, Me), format and control characters (Cf, Cc), Hangul
+ *   medial vowels and final consonants and default ignorable code points
+ * - 2 for East Asian wide and fullwidth code points (W, F), and for emoji
+ *   that are displayed as emoji by default (Emoji_Presentation)
+ * - 1 for all the other code points.
+ * The width of a view is the sum of the widths of its code points (as
+ * 'wcswidth', without grapheme cluster segmentation). Invalid units are
+ * displayed as U+FFFD REPLACEMENT CHARACTER.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_UNICODE_DISPLAY_WIDTH
+#define HG_UNICODE_DISPLAY_WIDTH
+
+#include <limits>
+
+#include "colt/dsa/string_view.h"
+#include "properties.h"
+
+namespace clt::uni
+{
+  /// @brief Returns the count of terminal columns of a code point
+  /// @param code_point The code point
+  /// @return 0, 1 or 2
+  constexpr u8 display_width(char32_t code_point) noexcept
+  {
+    return details::display_width_of(code_point);
+  }
+
+  namespace details
+  {
+    /// @brief The result of 'scan_columns'
+    template<typename ptr_t>
+    struct ColumnScan
+    {
+      /// @brief The unit at which the scan stopped
+      const ptr_t* ptr;
+      /// @brief The count of columns before 'ptr'
+      size_t column;
+    };
+
+    /// @brief Advances over the code points of [begin, end) until the one
+    ///        that covers 'column' (whose last column is 'column' or more).
+    /// Printable ASCII is of width 1: for UTF8, runs of printable ASCII are
+    /// skipped using SIMD instructions, without decoding.
+    /// @tparam ENCODING The encoding of the range
+    /// @param begin The start of the range
+    /// @param end The end of the range
+    /// @param column The column at which to stop
+    /// @return The code point covering 'column' (or 'end') and its column
+    template<StringEncoding ENCODING>
+    constexpr ColumnScan<meta::encoding_to_char_t<ENCODING>> scan_columns(
+        const meta::encoding_to_char_t<ENCODING>* begin,
+        const meta::encoding_to_char_t<ENCODING>* end, size_t column) noexcept
+    {
+      using ptr_t = meta::encoding_to_char_t<ENCODING>;
+
+      size_t current   = 0;
+      const ptr_t* ptr = begin;
+      while (ptr < end)
+      {
+        u32 unit;
+        if constexpr (meta::is_any_of<ptr_t, char, Char8>)
+          unit = static_cast<u8>(*ptr);
+        else
+          unit = ptr->as_host();
+
+        if (unit >= 0x20 && unit < 0x7F)
+        {
+          const ptr_t* run_end = ptr + 1;
+          if constexpr (meta::is_any_of<ptr_t, char, Char8>)
+          {
+            if (!std::is_constant_evaluated())
+            {
+              run_end = ptr_to<const ptr_t*>(find_nonprint8(
+                  ptr_to<const char8_t*>(ptr), ptr_to<const char8_t*>(end)));
+            }
+          }
+          const size_t take = std::min<size_t>(run_end - ptr, column - current);
+          ptr += take;
+          current += take;
+          if (ptr != run_end)
+            break;
+          continue;
+        }
+
+        // Invalid units are displayed as U+FFFD (of width 1)
+        const ptr_t* next = ptr;
+        char32_t cp;
+        if (!checked_decode(next, end, cp))
+          cp = U'\uFFFD', next = ptr + 1;
+        const size_t width = display_width_of(cp);
+        if (width > column - current)
+          break;
+        current += width;
+        ptr = next;
+      }
+      return {ptr, current};
+    }
+  } // namespace details
+
+  /// @brief Returns the count of terminal columns of a view.
+  /// @tparam ENCODING The encoding of the view
+  /// @param view The view
+  /// @return The sum of the widths of the code points of 'view'
+  template<StringEncoding ENCODING>
+  constexpr size_t display_width(BasicStringView<ENCODING> view) noexcept
+  {
+    return details::scan_columns<ENCODING>(
+               view.data(), view.data() + view.unit_len(),
+               std::numeric_limits<size_t>::max())
+        .column;
+  }
+
+  /// @brief Returns the column at which the unit at 'offset' is displayed.
+  /// @pre 'offset' is the start of a code point (or the end of 'view')
+  /// @tparam ENCODING The encoding of the view
+  /// @param view The view (usually a line)
+  /// @param offset The offset in units from the start of 'view'
+  /// @return The count of columns of the units before 'offset'
+  template<StringEncoding ENCODING>
+  constexpr size_t offset_to_column(
+      BasicStringView<ENCODING> view, size_t offset) noexcept
+  {
+    assert_true("Offset out of bounds!", offset <= view.unit_len());
+    return details::scan_columns<ENCODING>(
+               view.data(), view.data() + offset,
+               std::numeric_limits<size_t>::max())
+        .column;
+  }
+
+  /// @brief Returns the offset of the code point displayed at 'column'.
+  /// The zero-width code points following a code point are displayed
+  /// with it: the offset returned is the one of the first code point
+  /// covering 'column' (of the second column of a wide code point...).
+  /// @warning The view must be valid Unicode
+  /// @tparam ENCODING The encoding of the view
+  /// @param view The view (usually a line)
+  /// @param column The column (starting at 0)
+  /// @return The offset in units of the code point, or the unit length of
+  ///         'view' if 'column' is past its last column
+  template<StringEncoding ENCODING>
+  constexpr size_t column_to_offset(
+      BasicStringView<ENCODING> view, size_t column) noexcept
+  {
+    return static_cast<size_t>(
+        details::scan_columns<ENCODING>(
+            view.data(), view.data() + view.unit_len(), column)
+            .ptr
+        - view.data());
+  }
+} // namespace clt::uni
+
+#endif // !HG_UNICODE_DISPLAY_WIDTH
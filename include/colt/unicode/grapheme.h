@@ -0,0 +1,284 @@
+/*****************************************************************//**
+ * @file   grapheme.h
+ * @brief  Contains GraphemeIterator, an iterator over the extended
+ *         grapheme clusters of a BasicStringView (UAX #29).
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_UNICODE_GRAPHEME
+#define HG_UNICODE_GRAPHEME
+
+#include "colt/dsa/string_view.h"
+#include "properties.h"
+
+namespace clt::uni
+{
+  /// @brief Iterator over the extended grapheme clusters of a BasicStringView.
+  /// Boundaries are determined using the rules of UAX #29 (GB3 to GB999),
+  /// backed by the generated Grapheme_Cluster_Break tables.
+  /// As no rule joins two ASCII characters other than CR LF, runs of ASCII
+  /// are split in single unit clusters without running the state machine.
+  /// For UTF8, the end of such runs is found using SIMD instructions.
+  /// @warning The view must be valid Unicode
+  /// @tparam ENCODING The encoding of the view
+  template<StringEncoding ENCODING>
+  class GraphemeIterator
+  {
+    using ptr_t = meta::encoding_to_char_t<ENCODING>;
+    using GCB   = Grapheme_Cluster_Break;
+
+    /// @brief The start of the current cluster
+    const ptr_t* _begin;
+    /// @brief The end of the current cluster
+    const ptr_t* _next;
+    /// @brief The end of the view
+    const ptr_t* _end;
+    /// @brief The end of the last ASCII run found (UTF8 only)
+    const ptr_t* _ascii_end;
+
+    /// @brief Returns the value of a unit in the host endianness
+    /// @param ptr The unit
+    /// @return The unit
+    static constexpr u32 unit_of(const ptr_t* ptr) noexcept
+    {
+      if constexpr (meta::is_any_of<ptr_t, char>)
+        return static_cast<u8>(*ptr);
+      else if constexpr (meta::is_any_of<ptr_t, Char8>)
+        return static_cast<u8>(*ptr);
+      else
+        return ptr->as_host();
+    }
+
+    /// @brief Check if there is a boundary between 'prev' and 'next'.
+    /// This handles all the rules that do not need more context than
+    /// the pair of code points (GB3 to GB9b).
+    /// @param prev The property of the previous code point
+    /// @param next The property of the next code point
+    /// @return True if the pair is never split
+    static constexpr bool is_joined_pair(GCB prev, GCB next) noexcept
+    {
+      using enum GCB;
+      // GB3
+      if (prev == CR && next == LF)
+        return true;
+      // GB4, GB5
+      if (is_one_of(prev, CN, CR, LF) || is_one_of(next, CN, CR, LF))
+        return false;
+      // GB6
+      if (prev == L && is_one_of(next, L, V, LV, LVT))
+        return true;
+      // GB7
+      if (is_one_of(prev, LV, V) && is_one_of(next, V, T))
+        return true;
+      // GB8
+      if (is_one_of(prev, LVT, T) && next == T)
+        return true;
+      // GB9, GB9a, GB9b
+      return is_one_of(next, EX, ZWJ, SM) || prev == PP;
+    }
+
+    /// @brief Returns the end of the cluster starting at 'ptr' (state machine)
+    /// @param ptr The start of the cluster (!= _end)
+    /// @return The end of the cluster
+    constexpr const ptr_t* cluster_end(const ptr_t* ptr) const noexcept
+    {
+      using enum GCB;
+
+      CodePointIterator<ENCODING> it = ptr;
+      char32_t cp                    = *it;
+      GCB prev                       = get<GCB>(cp);
+      // GB9c: 0 (no consonant), 1 (consonant), 2 (consonant then linker)
+      u8 conjunct = get<InCB>(cp) == InCB::Consonant;
+      // GB11: ExtPict Extend* (ZWJ)?
+      bool pictographic = has<Extended_Pictographic>(cp);
+      // GB12, GB13: count of regional indicators
+      size_t regional = prev == RI;
+      for (++it; it.current() != _end; ++it)
+      {
+        cp               = *it;
+        const GCB next   = get<GCB>(cp);
+        const InCB incb  = get<InCB>(cp);
+        const bool picto = has<Extended_Pictographic>(cp);
+        bool joined      = is_joined_pair(prev, next);
+        if (!joined && !is_one_of(prev, CN, CR, LF))
+        {
+          // GB9c
+          joined |= conjunct == 2 && incb == InCB::Consonant;
+          // GB11
+          joined |= pictographic && prev == ZWJ && picto;
+          // GB12, GB13
+          joined |= prev == RI && next == RI && regional % 2 == 1;
+        }
+        if (!joined)
+          break;
+
+        // Update the context of the rules
+        if (incb == InCB::Consonant)
+          conjunct = 1;
+        else if (incb == InCB::Linker && conjunct != 0)
+          conjunct = 2;
+        else if (incb != InCB::Extend)
+          conjunct = 0;
+        pictographic =
+            picto || (pictographic && prev != ZWJ && is_one_of(next, EX, ZWJ));
+        regional = next == RI ? regional + 1 : 0;
+        prev     = next;
+      }
+      return it.current();
+    }
+
+    /// @brief Computes '_next' from '_begin'
+    constexpr void find_next() noexcept
+    {
+      if (_begin == _end)
+      {
+        _next = _end;
+        return;
+      }
+      const u32 unit = unit_of(_begin);
+      if (unit < 0x80)
+      {
+        // The fast path: ASCII followed by ASCII (or the end of the view)
+        const ptr_t* after = _begin + 1;
+        bool is_ascii_run  = false;
+        if constexpr (meta::is_any_of<ptr_t, Char8>)
+        {
+          if (!std::is_constant_evaluated())
+          {
+            if (_ascii_end <= _begin)
+            {
+              _ascii_end = ptr_to<const Char8*>(details::find_first_not(
+                  ptr_to<const char*>(_begin), ptr_to<const char*>(_end),
+                  CharClass::ASCII));
+            }
+            is_ascii_run = after == _end || after < _ascii_end;
+          }
+          else
+            is_ascii_run = after == _end || unit_of(after) < 0x80;
+        }
+        else
+          is_ascii_run = after == _end || unit_of(after) < 0x80;
+        if (is_ascii_run)
+        {
+          // GB3: CR LF is the only cluster of two ASCII characters
+          _next = after + (unit == '\r' && after != _end && unit_of(after) == '\n');
+          return;
+        }
+      }
+      _next = cluster_end(_begin);
+    }
+
+  public:
+    /// @brief Constructs an iterator to the cluster starting at 'begin'
+    /// @param begin The start of a cluster
+    /// @param end The end of the view
+    constexpr GraphemeIterator(const ptr_t* begin, const ptr_t* end) noexcept
+        : _begin(begin)
+        , _next(begin)
+        , _end(end)
+        , _ascii_end(begin)
+    {
+      find_next();
+    }
+
+    /// @brief Constructs an iterator to the first cluster of 'view'
+    /// @param view The view whose clusters to iterate over
+    constexpr GraphemeIterator(BasicStringView<ENCODING> view) noexcept
+        : GraphemeIterator(view.data(), view.data() + view.unit_len())
+    {
+    }
+
+    MAKE_DEFAULT_COPY_AND_MOVE_FOR(GraphemeIterator);
+
+    /// @brief Returns the start of the current cluster
+    /// @return The start of the current cluster
+    constexpr const ptr_t* current() const noexcept { return _begin; }
+
+    /// @brief Returns the current cluster
+    /// @return View over the current cluster
+    constexpr BasicStringView<ENCODING> operator*() const noexcept
+    {
+      return BasicStringView<ENCODING>{_begin, _next};
+    }
+
+    /// @brief Advances to the next cluster
+    /// @return Self
+    constexpr GraphemeIterator& operator++() noexcept
+    {
+      assert_true("Cannot advance past the end!", _begin != _end);
+      _begin = _next;
+      find_next();
+      return *this;
+    }
+
+    /// @brief Advances to the next cluster
+    /// @return Copy of the iterator before advancing
+    constexpr GraphemeIterator operator++(int) noexcept
+    {
+      auto copy = *this;
+      ++(*this);
+      return copy;
+    }
+
+    /// @brief Check if two iterators point to the same cluster
+    /// @return True if both iterators point to the same cluster
+    friend constexpr bool operator==(
+        const GraphemeIterator& a, const GraphemeIterator& b) noexcept
+    {
+      return a._begin == b._begin;
+    }
+  };
+
+  /// @brief Range over the extended grapheme clusters of a view
+  /// @tparam ENCODING The encoding of the view
+  template<StringEncoding ENCODING>
+  struct GraphemeRange
+  {
+    /// @brief The view whose clusters to iterate over
+    BasicStringView<ENCODING> view;
+
+    /// @brief Returns an iterator to the first cluster
+    /// @return Iterator to the first cluster
+    constexpr GraphemeIterator<ENCODING> begin() const noexcept { return view; }
+
+    /// @brief Returns an iterator past the last cluster
+    /// @return Iterator past the last cluster
+    constexpr GraphemeIterator<ENCODING> end() const noexcept
+    {
+      const auto end = view.data() + view.unit_len();
+      return {end, end};
+    }
+  };
+
+  /// @brief Returns a range over the extended grapheme clusters of 'view'.
+  /// @code{.cpp}
+  /// for (auto cluster : uni::graphemes(view))
+  ///   fmt::println("{}", cluster);
+  /// @endcode
+  /// @tparam ENCODING The encoding of the view
+  /// @param view The view whose clusters to iterate over
+  /// @return Range over the clusters of 'view'
+  template<StringEncoding ENCODING>
+  constexpr GraphemeRange<ENCODING> graphemes(
+      BasicStringView<ENCODING> view) noexcept
+  {
+    return {view};
+  }
+
+  /// @brief Returns the count of extended grapheme clusters of 'view'.
+  /// @tparam ENCODING The encoding of the view
+  /// @param view The view whose clusters to count
+  /// @return The count of clusters
+  template<StringEncoding ENCODING>
+  constexpr size_t grapheme_count(BasicStringView<ENCODING> view) noexcept
+  {
+    size_t count     = 0;
+    const auto range = graphemes(view);
+    for (auto it = range.begin(); it != range.end(); ++it)
+      ++count;
+    return count;
+  }
+} // namespace clt::uni
+
+#endif // !HG_UNICODE_GRAPHEME
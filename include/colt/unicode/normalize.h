@@ -0,0 +1,608 @@
+/*****************************************************************//**
+ * @file   normalize.h
+ * @brief  Contains the canonical normalization forms (NFC, NFD) of views.
+ *
+ * `quick_check` runs the NF[C|D]_Quick_Check algorithm of UAX #15.
+ * `Normalizer` streams the normalized code points of a view.
+ * `normalize` returns the normalization of a view: as most text is
+ * already normalized, the input view is returned as is (without
+ * allocating) if it passes the quick check or normalizes to itself.
+ * Otherwise, the result is allocated (once) into the given allocator.
+ * Runs of code points that are always normalized (< U+0300 for NFC,
+ * < U+00C0 for NFD) are skipped using SIMD instructions for UTF8.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_UNICODE_NORMALIZE
+#define HG_UNICODE_NORMALIZE
+
+#include <algorithm>
+#include "colt/mem/allocator_ref.h"
+#include "casefold.h"
+
+namespace clt::uni
+{
+  /// @brief The canonical normalization forms
+  enum class NormalizationForm : u8
+  {
+    /// @brief Canonical Decomposition, followed by Canonical Composition
+    NFC,
+    /// @brief Canonical Decomposition
+    NFD
+  };
+
+  /// @brief The result of the quick check of a view
+  enum class QuickCheck : u8
+  {
+    /// @brief The view is not normalized
+    NO,
+    /// @brief The view may be normalized (normalize it to know)
+    MAYBE,
+    /// @brief The view is normalized
+    YES
+  };
+
+  /// @brief The maximum count of code points of the full canonical
+  /// decomposition of a code point
+  inline constexpr size_t DECOMPOSITION_MAX = 4;
+
+  namespace details
+  {
+    /// @brief The first Hangul syllable
+    inline constexpr char32_t HANGUL_SBASE = 0xAC00;
+    /// @brief The first leading consonant (L) jamo
+    inline constexpr char32_t HANGUL_LBASE = 0x1100;
+    /// @brief The first vowel (V) jamo
+    inline constexpr char32_t HANGUL_VBASE = 0x1161;
+    /// @brief The trailing consonant (T) jamo before the first one
+    inline constexpr char32_t HANGUL_TBASE = 0x11A7;
+    /// @brief The count of L jamo
+    inline constexpr u32 HANGUL_LCOUNT = 19;
+    /// @brief The count of V jamo
+    inline constexpr u32 HANGUL_VCOUNT = 21;
+    /// @brief The count of T jamo (plus one for no T)
+    inline constexpr u32 HANGUL_TCOUNT = 28;
+    /// @brief The count of syllables sharing the same L jamo
+    inline constexpr u32 HANGUL_NCOUNT = HANGUL_VCOUNT * HANGUL_TCOUNT;
+    /// @brief The count of Hangul syllables
+    inline constexpr u32 HANGUL_SCOUNT = HANGUL_LCOUNT * HANGUL_NCOUNT;
+
+    /// @brief Returns the canonical combining class of a code point.
+    /// The result is the index of the class in Canonical_Combining_Class,
+    /// which preserves the ordering of the numeric classes.
+    /// @param code_point The code point
+    /// @return The canonical combining class (0 for starters)
+    constexpr u8 combining_class(char32_t code_point) noexcept
+    {
+      return static_cast<u8>(get<Canonical_Combining_Class>(code_point));
+    }
+
+    /// @brief Writes the full canonical decomposition of a code point
+    /// @param code_point The code point to decompose
+    /// @param to The output (of at least DECOMPOSITION_MAX code points)
+    /// @return The count of code points written
+    constexpr u8 decompose(char32_t code_point, char32_t* to) noexcept
+    {
+      const u32 syllable = static_cast<u32>(code_point - HANGUL_SBASE);
+      if (syllable < HANGUL_SCOUNT)
+      {
+        to[0] = HANGUL_LBASE + syllable / HANGUL_NCOUNT;
+        to[1] = HANGUL_VBASE + (syllable % HANGUL_NCOUNT) / HANGUL_TCOUNT;
+        to[2] = HANGUL_TBASE + syllable % HANGUL_TCOUNT;
+        return 2 + (u8)(to[2] != HANGUL_TBASE);
+      }
+      const u32 packed = canonical_decomposition(code_point);
+      if (packed == 0)
+      {
+        to[0] = code_point;
+        return 1;
+      }
+      const u8 size = static_cast<u8>(packed & 0b111);
+      for (u8 i = 0; i != size; ++i)
+        to[i] = static_cast<char32_t>(Decomposition_pool[(packed >> 3) + i]);
+      return size;
+    }
+
+    /// @brief Returns the primary composite of two code points
+    /// @param first The first code point
+    /// @param second The second code point
+    /// @return The primary composite or 0 if they do not compose
+    constexpr char32_t compose(char32_t first, char32_t second) noexcept
+    {
+      const u32 l = static_cast<u32>(first - HANGUL_LBASE);
+      const u32 v = static_cast<u32>(second - HANGUL_VBASE);
+      if (l < HANGUL_LCOUNT && v < HANGUL_VCOUNT)
+        return HANGUL_SBASE + (l * HANGUL_VCOUNT + v) * HANGUL_TCOUNT;
+      const u32 lv = static_cast<u32>(first - HANGUL_SBASE);
+      const u32 t  = static_cast<u32>(second - HANGUL_TBASE);
+      if (lv < HANGUL_SCOUNT && lv % HANGUL_TCOUNT == 0 && t - 1 < HANGUL_TCOUNT - 1)
+        return first + t;
+
+      const u64 key = (static_cast<u64>(first) << 21) | second;
+      const auto begin = std::begin(Composition_pairs);
+      const auto end   = std::end(Composition_pairs);
+      const auto it    = std::lower_bound(begin, end, key);
+      if (it == end || *it != key)
+        return 0;
+      return Composition_composites[it - begin];
+    }
+
+    /// @brief Check if a code point never interacts with the ones before it.
+    /// The normalization of a view can thus be split before such code points.
+    /// @tparam FORM The normalization form
+    /// @param code_point The code point
+    /// @return True if there is a normalization boundary before 'code_point'
+    template<NormalizationForm FORM>
+    constexpr bool is_boundary_before(char32_t code_point) noexcept
+    {
+      char32_t decomposed[DECOMPOSITION_MAX];
+      decompose(code_point, decomposed);
+      // Code points that compose with a previous one are NFC_QC=Maybe
+      if constexpr (FORM == NormalizationForm::NFC)
+        if (get<NFC_Quick_Check>(decomposed[0]) != NFC_Quick_Check::Y)
+          return false;
+      return combining_class(decomposed[0]) == 0;
+    }
+
+    /// @brief Returns the quick check result of a code point
+    /// @tparam FORM The normalization form
+    /// @param code_point The code point
+    /// @return The value of NF[C|D]_Quick_Check
+    template<NormalizationForm FORM>
+    constexpr QuickCheck quick_check_of(char32_t code_point) noexcept
+    {
+      if constexpr (FORM == NormalizationForm::NFC)
+      {
+        switch (get<NFC_Quick_Check>(code_point))
+        {
+        case NFC_Quick_Check::N:
+          return QuickCheck::NO;
+        case NFC_Quick_Check::M:
+          return QuickCheck::MAYBE;
+        default:
+          return QuickCheck::YES;
+        }
+      }
+      else
+        return get<NFD_Quick_Check>(code_point) == NFD_Quick_Check::Y
+                   ? QuickCheck::YES
+                   : QuickCheck::NO;
+    }
+
+    /// @brief The result of 'quick_check_scan'
+    /// @tparam T The char type
+    template<meta::CharType T>
+    struct QuickCheckScan
+    {
+      /// @brief The result of the quick check
+      QuickCheck result;
+      /// @brief The last normalization boundary before the first code
+      /// point that failed the check (the end if the result is YES).
+      /// Everything before it is already normalized.
+      const T* boundary;
+    };
+
+    /// @brief Runs the quick check algorithm of UAX #15 over [ptr, end).
+    /// For UTF8, runs of code points below U+0300 (NFC) or U+00C0 (NFD)
+    /// are skipped using SIMD, as they are all starters that are normalized.
+    /// @tparam FORM The normalization form
+    /// @tparam T The char type
+    /// @param ptr The start of the units
+    /// @param end The end of the units
+    /// @return The result and the last boundary before the first failure
+    template<NormalizationForm FORM, meta::CharType T>
+    constexpr QuickCheckScan<T> quick_check_scan(const T* ptr, const T* end) noexcept
+    {
+      constexpr bool IS_NFC       = FORM == NormalizationForm::NFC;
+      constexpr char32_t FAST     = IS_NFC ? 0x0300 : 0x00C0;
+      constexpr char8_t FAST_LEAD = IS_NFC ? 0xCC : 0xC3;
+
+      QuickCheck result = QuickCheck::YES;
+      // Only updated while the result is YES
+      const T* boundary = ptr;
+      u8 last_class     = 0;
+      while (ptr != end)
+      {
+        if constexpr (meta::is_any_of<T, Char8>)
+        {
+          if (!std::is_constant_evaluated())
+          {
+            // Continuation bytes are all less than FAST_LEAD: this stops
+            // on the lead byte of the first code point greater than FAST.
+            const T* skip = ptr_to<const T*>(find_ge8(
+                ptr_to<const char8_t*>(ptr), ptr_to<const char8_t*>(end),
+                FAST_LEAD));
+            if (skip != ptr)
+            {
+              // The last code point skipped is at most 2 units
+              if (result == QuickCheck::YES)
+                boundary = skip - 1 - ((static_cast<u8>(skip[-1]) & 0xC0) == 0x80);
+              last_class = 0;
+              ptr        = skip;
+              if (ptr == end)
+                break;
+            }
+          }
+        }
+        const T* start    = ptr;
+        const char32_t cp = lossy_decode(ptr, end);
+        if (cp < FAST)
+        {
+          if (result == QuickCheck::YES)
+            boundary = start;
+          last_class = 0;
+          continue;
+        }
+        const u8 cls = combining_class(cp);
+        if (cls != 0 && last_class > cls)
+          return {QuickCheck::NO, boundary};
+        const QuickCheck check = quick_check_of<FORM>(cp);
+        if (check == QuickCheck::NO)
+          return {QuickCheck::NO, boundary};
+        if (check == QuickCheck::MAYBE)
+          result = QuickCheck::MAYBE;
+        else if (cls == 0 && result == QuickCheck::YES)
+          boundary = start;
+        last_class = cls;
+      }
+      return {result, result == QuickCheck::YES ? end : boundary};
+    }
+  } // namespace details
+
+  /// @brief Runs the quick check algorithm of UAX #15 on a view.
+  /// @code{.cpp}
+  /// static_assert(uni::quick_check<NFC>(StringView{"abc"}) == QuickCheck::YES);
+  /// @endcode
+  /// @tparam FORM The normalization form
+  /// @tparam T The view, string or literal type
+  /// @param str The view, string or literal to check
+  /// @return YES if normalized, NO if not, MAYBE if it cannot be known quickly
+  template<NormalizationForm FORM, details::StringViewLike T>
+  constexpr QuickCheck quick_check(const T& str) noexcept
+  {
+    const auto view = details::as_view(str);
+    if constexpr (decltype(view)::STR_ENCODING == StringEncoding::ASCII)
+      return QuickCheck::YES;
+    else
+    {
+      const auto ptr = view.data();
+      return details::quick_check_scan<FORM>(ptr, ptr + view.unit_len()).result;
+    }
+  }
+
+  /// @brief Stream of the normalized code points of a view.
+  /// The view is split in segments starting at normalization boundaries,
+  /// which are decomposed, put in canonical order, then composed (NFC).
+  /// Segments are stored inline, unless they are longer than INLINE_CAPACITY
+  /// code points in which case they are stored in the allocator.
+  /// @warning The view must be valid Unicode
+  /// @tparam ENCODING The encoding of the view
+  /// @tparam FORM The normalization form
+  /// @tparam ALLOCATOR The allocator used for long segments
+  template<
+      StringEncoding ENCODING, NormalizationForm FORM, meta::Allocator ALLOCATOR>
+  class Normalizer : private ALLOCATOR
+  {
+    using ptr_t = meta::encoding_to_char_t<ENCODING>;
+
+    /// @brief The count of code points of a segment stored inline
+    static constexpr size_t INLINE_CAPACITY = 32;
+
+    /// @brief The start of the next segment
+    CodePointIterator<ENCODING> _it;
+    /// @brief The end of the view
+    const ptr_t* _end;
+    /// @brief The allocated segment (null if stored inline)
+    mem::MemBlock _blk = {};
+    /// @brief The count of code points of the current segment
+    size_t _size = 0;
+    /// @brief The index of the next code point of the segment to return
+    size_t _index = 0;
+    /// @brief The inline segment
+    char32_t _inline[INLINE_CAPACITY];
+
+    /// @brief Returns the current segment
+    /// @return Pointer to the current segment
+    char32_t* segment() noexcept
+    {
+      return _blk.is_null() ? _inline : static_cast<char32_t*>(_blk.ptr());
+    }
+
+    /// @brief Returns the capacity of the current segment
+    /// @return The capacity in code points
+    size_t capacity() const noexcept
+    {
+      return _blk.is_null() ? INLINE_CAPACITY : _blk.size() / sizeof(char32_t);
+    }
+
+    /// @brief Doubles the capacity of the segment
+    void grow() noexcept
+    {
+      auto new_blk = ALLOCATOR::alloc(capacity() * 2 * sizeof(char32_t));
+      std::copy_n(segment(), _size, static_cast<char32_t*>(new_blk.ptr()));
+      if (!_blk.is_null())
+        ALLOCATOR::dealloc(_blk);
+      _blk = new_blk;
+    }
+
+    /// @brief Sorts each run of non-starters by canonical combining class.
+    /// The sort is stable, and starters are never moved.
+    /// @param ptr The segment
+    /// @param size The count of code points of the segment
+    static void canonical_order(char32_t* ptr, size_t size) noexcept
+    {
+      for (size_t i = 1; i < size; ++i)
+      {
+        const char32_t cp = ptr[i];
+        const u8 cls      = details::combining_class(cp);
+        if (cls == 0)
+          continue;
+        size_t j = i;
+        for (; j != 0 && details::combining_class(ptr[j - 1]) > cls; --j)
+          ptr[j] = ptr[j - 1];
+        ptr[j] = cp;
+      }
+    }
+
+    /// @brief Composes a segment in canonical order (in place)
+    /// @param ptr The segment
+    /// @param size The count of code points of the segment
+    /// @return The count of code points of the composed segment
+    static size_t canonical_compose(char32_t* ptr, size_t size) noexcept
+    {
+      if (size < 2)
+        return size;
+      size_t starter = 0;
+      // 0xFF: the segment does not start with a starter
+      u8 last_class = details::combining_class(ptr[0]) == 0 ? 0 : 0xFF;
+      size_t result = 1;
+      for (size_t i = 1; i != size; ++i)
+      {
+        const char32_t cp = ptr[i];
+        const u8 cls      = details::combining_class(cp);
+        // 'cp' is blocked from the starter by the previous code point
+        // if it is a starter, or has a greater or equal class.
+        if (last_class == 0 || last_class < cls)
+        {
+          if (const char32_t composite = details::compose(ptr[starter], cp))
+          {
+            ptr[starter] = composite;
+            continue;
+          }
+        }
+        if (cls == 0)
+          starter = result;
+        last_class    = cls;
+        ptr[result++] = cp;
+      }
+      return result;
+    }
+
+    /// @brief Normalizes the next segment
+    void next_segment() noexcept
+    {
+      _size  = 0;
+      _index = 0;
+      while (_it.current() != _end)
+      {
+        const char32_t cp = *_it;
+        if (_size != 0 && details::is_boundary_before<FORM>(cp))
+          break;
+        if (capacity() - _size < DECOMPOSITION_MAX)
+          grow();
+        _size += details::decompose(cp, segment() + _size);
+        ++_it;
+      }
+      canonical_order(segment(), _size);
+      if constexpr (FORM == NormalizationForm::NFC)
+        _size = canonical_compose(segment(), _size);
+    }
+
+  public:
+    /// @brief Constructs a stream over the units [begin, end)
+    /// @param alloc The allocator used for long segments
+    /// @param begin The start of the units (must be a normalization boundary)
+    /// @param end The end of the units
+    Normalizer(const ALLOCATOR& alloc, const ptr_t* begin, const ptr_t* end) noexcept
+        : ALLOCATOR(alloc)
+        , _it(begin)
+        , _end(end)
+    {
+    }
+
+    /// @brief Constructs a stream over a view
+    /// @param alloc The allocator used for long segments
+    /// @param view The view to normalize
+    Normalizer(const ALLOCATOR& alloc, BasicStringView<ENCODING> view) noexcept
+        : Normalizer(alloc, view.data(), view.data() + view.unit_len())
+    {
+    }
+
+    MAKE_DELETE_COPY_AND_MOVE_FOR(Normalizer);
+
+    /// @brief Destructor, frees the segment if it was allocated
+    ~Normalizer() noexcept
+    {
+      if (!_blk.is_null())
+        ALLOCATOR::dealloc(_blk);
+    }
+
+    /// @brief Check if all the normalized code points were returned
+    /// @return True if there are no more code points
+    bool is_end() const noexcept { return _index == _size && _it.current() == _end; }
+
+    /// @brief Returns the next normalized code point
+    /// @return The next normalized code point
+    /// @pre !is_end()
+    char32_t next() noexcept
+    {
+      assert_true("Normalizer is empty!", !is_end());
+      if (_index == _size)
+        next_segment();
+      return segment()[_index++];
+    }
+  };
+
+  /// @brief The normalization of a view.
+  /// If the view was already normalized, this is the view itself: else
+  /// this owns the normalized units, which are allocated in the allocator.
+  /// @tparam ENCODING The encoding of the view
+  /// @tparam FORM The normalization form
+  /// @tparam ALLOCATOR The allocator
+  template<
+      StringEncoding ENCODING, NormalizationForm FORM, meta::Allocator ALLOCATOR>
+  class Normalized : private ALLOCATOR
+  {
+    using ptr_t = meta::encoding_to_char_t<ENCODING>;
+
+    /// @brief The normalized view
+    BasicStringView<ENCODING> _view;
+    /// @brief The block owning the normalized units (null if none)
+    mem::MemBlock _blk = {};
+
+  public:
+    /// @brief Normalizes a view.
+    /// This does not allocate if the view is already normalized. Else,
+    /// the view is first normalized without writing to know the size
+    /// of the result and whether it differs from the input.
+    /// Only the units after the first normalization boundary before the
+    /// first code point that fails the quick check are normalized.
+    /// @param alloc The allocator
+    /// @param view The view to normalize
+    Normalized(const ALLOCATOR& alloc, BasicStringView<ENCODING> view) noexcept
+        : ALLOCATOR(alloc)
+        , _view(view)
+    {
+      if constexpr (ENCODING != StringEncoding::ASCII)
+      {
+        const ptr_t* ptr  = view.data();
+        const ptr_t* end  = ptr + view.unit_len();
+        const auto result = details::quick_check_scan<FORM>(ptr, end);
+        if (result.result == QuickCheck::YES)
+          return;
+
+        size_t size  = static_cast<size_t>(result.boundary - ptr);
+        bool changed = false;
+        {
+          Normalizer<ENCODING, FORM, ALLOCATOR> normalizer = {
+              *this, result.boundary, end};
+          CodePointIterator<ENCODING> input = result.boundary;
+          while (!normalizer.is_end())
+          {
+            const char32_t cp = normalizer.next();
+            size += details::encoded_units<ptr_t>(cp);
+            if (!changed && input.current() != end && *input == cp)
+              ++input;
+            else
+              changed = true;
+          }
+          if (!changed && input.current() == end)
+            return;
+        }
+
+        _blk            = ALLOCATOR::alloc(size * sizeof(ptr_t));
+        ptr_t* to       = static_cast<ptr_t*>(_blk.ptr());
+        ptr_t* to_begin = to;
+        to              = std::copy(ptr, result.boundary, to);
+        Normalizer<ENCODING, FORM, ALLOCATOR> normalizer = {
+            *this, result.boundary, end};
+        while (!normalizer.is_end())
+          to = details::unchecked_encode(normalizer.next(), to);
+        _view = BasicStringView<ENCODING>{to_begin, to};
+      }
+    }
+
+    /// @brief Move constructor
+    /// @param other The normalization to move from
+    Normalized(Normalized&& other) noexcept
+        : ALLOCATOR(static_cast<ALLOCATOR&&>(other))
+        , _view(other._view)
+        , _blk(std::exchange(other._blk, mem::MemBlock{}))
+    {
+    }
+
+    Normalized(const Normalized&)            = delete;
+    Normalized& operator=(const Normalized&) = delete;
+    Normalized& operator=(Normalized&&)      = delete;
+
+    /// @brief Destructor, frees the normalized units if they were allocated
+    ~Normalized() noexcept
+    {
+      if (!_blk.is_null())
+        ALLOCATOR::dealloc(_blk);
+    }
+
+    /// @brief Returns the normalized view
+    /// @return The normalized view
+    BasicStringView<ENCODING> view() const noexcept { return _view; }
+    /// @brief Returns the normalized view
+    /// @return The normalized view
+    BasicStringView<ENCODING> operator*() const noexcept { return _view; }
+    /// @brief Returns the normalized view
+    /// @return The normalized view
+    BasicStringView<ENCODING> to_view() const noexcept { return _view; }
+
+    /// @brief Check if the normalization had to be allocated
+    /// @return False if the view was already normalized
+    bool is_allocated() const noexcept { return !_blk.is_null(); }
+  };
+
+  /// @brief Returns the normalization of a view.
+  /// This only allocates (exactly once) if the view is not normalized:
+  /// in that case, the result owns the normalized units.
+  /// @code{.cpp}
+  /// auto nfc = uni::normalize<NFC>("é"_UTF8, mem::GlobalAllocator);
+  /// assert(*nfc == "é"_UTF8);
+  /// @endcode
+  /// @tparam FORM The normalization form
+  /// @tparam T The view, string or literal type
+  /// @tparam ALLOCATOR The allocator
+  /// @param str The view, string or literal to normalize
+  /// @param alloc The allocator in which to allocate the result if needed
+  /// @return The normalization of 'str'
+  template<
+      NormalizationForm FORM, details::StringViewLike T, meta::Allocator ALLOCATOR>
+  auto normalize(const T& str, const ALLOCATOR& alloc) noexcept
+  {
+    const auto view = details::as_view(str);
+    return Normalized<decltype(view)::STR_ENCODING, FORM, ALLOCATOR>(
+        alloc, BasicStringView<decltype(view)::STR_ENCODING>{view});
+  }
+
+  /// @brief Check if a view is normalized (without allocating).
+  /// @tparam FORM The normalization form
+  /// @tparam T The view, string or literal type
+  /// @tparam ALLOCATOR The allocator used for (very) long segments
+  /// @param str The view, string or literal to check
+  /// @param alloc The allocator used for segments of more than 32 code points
+  /// @return True if 'str' is normalized
+  template<
+      NormalizationForm FORM, details::StringViewLike T, meta::Allocator ALLOCATOR>
+  bool is_normalized(const T& str, const ALLOCATOR& alloc) noexcept
+  {
+    const auto view                   = details::as_view(str);
+    constexpr StringEncoding ENCODING = decltype(view)::STR_ENCODING;
+    const auto ptr                    = view.data();
+    const auto end                    = ptr + view.unit_len();
+    const auto result                 = details::quick_check_scan<FORM>(ptr, end);
+    if (result.result != QuickCheck::MAYBE)
+      return result.result == QuickCheck::YES;
+    Normalizer<ENCODING, FORM, ALLOCATOR> normalizer = {alloc, result.boundary, end};
+    CodePointIterator<ENCODING> input                = result.boundary;
+    while (!normalizer.is_end())
+    {
+      if (input.current() == end || *input != normalizer.next())
+        return false;
+      ++input;
+    }
+    return input.current() == end;
+  }
+
+  /// @brief Shorthand for NormalizationForm::NFC
+  inline constexpr NormalizationForm NFC = NormalizationForm::NFC;
+  /// @brief Shorthand for NormalizationForm::NFD
+  inline constexpr NormalizationForm NFD = NormalizationForm::NFD;
+} // namespace clt::uni
+
+#endif // !HG_UNICODE_NORMALIZE
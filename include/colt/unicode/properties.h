@@ -4,6 +4,9 @@
 
 #include <cstdint>
 
+#include "colt/typedefs.h"
+#include "gen/property_tables.h"
+
 namespace clt::uni {
 enum class ASCII_Hex_Digit : uint8_t {
   N = 0,
@@ -2665,6 +2668,870 @@ enum class kEH_NoRotate : uint8_t {
   True = Y,
 };
 
+/// @brief Returns the value of an enumerated or binary property of a code point.
+/// The lookup is done in constant time using the generated tables.
+/// @code{.cpp}
+/// static_assert(uni::get<General_Category>(U'A') == General_Category::Lu);
+/// @endcode
+/// @tparam Prop The property (General_Category, Script, XID_Start...)
+/// @param code_point The code point
+/// @return The value of the property
+template<typename Prop>
+constexpr Prop get(char32_t code_point) noexcept = delete;
+
+/// @brief Check if a code point has a binary property.
+/// The hot properties (XID_Start, XID_Continue, White_Space...) are bit-packed
+/// in the same table, so that checking any of them is at most three loads.
+/// @tparam Prop The binary property (XID_Start, White_Space...)
+/// @param code_point The code point
+/// @return True if the code point has the property
+template<typename Prop>
+constexpr bool has(char32_t code_point) noexcept = delete;
+
+template<>
+constexpr General_Category get<General_Category>(char32_t code_point) noexcept {
+  return static_cast<General_Category>(details::trie_lookup<4, 5>(
+      details::General_Category_top, details::General_Category_mid, details::General_Category_leaf, code_point));
+}
+
+template<>
+constexpr Canonical_Combining_Class get<Canonical_Combining_Class>(char32_t code_point) noexcept {
+  return static_cast<Canonical_Combining_Class>(details::trie_lookup<4, 6>(
+      details::Canonical_Combining_Class_top, details::Canonical_Combining_Class_mid, details::Canonical_Combining_Class_leaf, code_point));
+}
+
+template<>
+constexpr Bidi_Class get<Bidi_Class>(char32_t code_point) noexcept {
+  return static_cast<Bidi_Class>(details::trie_lookup<3, 7>(
+      details::Bidi_Class_top, details::Bidi_Class_mid, details::Bidi_Class_leaf, code_point));
+}
+
+template<>
+constexpr Decomposition_Type get<Decomposition_Type>(char32_t code_point) noexcept {
+  return static_cast<Decomposition_Type>(details::trie_lookup<4, 6>(
+      details::Decomposition_Type_top, details::Decomposition_Type_mid, details::Decomposition_Type_leaf, code_point));
+}
+
+template<>
+constexpr Numeric_Type get<Numeric_Type>(char32_t code_point) noexcept {
+  return static_cast<Numeric_Type>(details::trie_lookup<4, 5>(
+      details::Numeric_Type_top, details::Numeric_Type_mid, details::Numeric_Type_leaf, code_point));
+}
+
+template<>
+constexpr East_Asian_Width get<East_Asian_Width>(char32_t code_point) noexcept {
+  return static_cast<East_Asian_Width>(details::trie_lookup<4, 6>(
+      details::East_Asian_Width_top, details::East_Asian_Width_mid, details::East_Asian_Width_leaf, code_point));
+}
+
+template<>
+constexpr Line_Break get<Line_Break>(char32_t code_point) noexcept {
+  return static_cast<Line_Break>(details::trie_lookup<4, 5>(
+      details::Line_Break_top, details::Line_Break_mid, details::Line_Break_leaf, code_point));
+}
+
+template<>
+constexpr Joining_Type get<Joining_Type>(char32_t code_point) noexcept {
+  return static_cast<Joining_Type>(details::trie_lookup<4, 6>(
+      details::Joining_Type_top, details::Joining_Type_mid, details::Joining_Type_leaf, code_point));
+}
+
+template<>
+constexpr Joining_Group get<Joining_Group>(char32_t code_point) noexcept {
+  return static_cast<Joining_Group>(details::trie_lookup<6, 6>(
+      details::Joining_Group_top, details::Joining_Group_mid, details::Joining_Group_leaf, code_point));
+}
+
+template<>
+constexpr Script get<Script>(char32_t code_point) noexcept {
+  return static_cast<Script>(details::trie_lookup<4, 5>(
+      details::Script_top, details::Script_mid, details::Script_leaf, code_point));
+}
+
+template<>
+constexpr Block get<Block>(char32_t code_point) noexcept {
+  return static_cast<Block>(details::trie_lookup<4, 5>(
+      details::Block_top, details::Block_mid, details::Block_leaf, code_point));
+}
+
+template<>
+constexpr Age get<Age>(char32_t code_point) noexcept {
+  return static_cast<Age>(details::trie_lookup<4, 5>(
+      details::Age_top, details::Age_mid, details::Age_leaf, code_point));
+}
+
+template<>
+constexpr Hangul_Syllable_Type get<Hangul_Syllable_Type>(char32_t code_point) noexcept {
+  return static_cast<Hangul_Syllable_Type>(details::trie_lookup<5, 7>(
+      details::Hangul_Syllable_Type_top, details::Hangul_Syllable_Type_mid, details::Hangul_Syllable_Type_leaf, code_point));
+}
+
+template<>
+constexpr Indic_Positional_Category get<Indic_Positional_Category>(char32_t code_point) noexcept {
+  return static_cast<Indic_Positional_Category>(details::trie_lookup<4, 7>(
+      details::Indic_Positional_Category_top, details::Indic_Positional_Category_mid, details::Indic_Positional_Category_leaf, code_point));
+}
+
+template<>
+constexpr Indic_Syllabic_Category get<Indic_Syllabic_Category>(char32_t code_point) noexcept {
+  return static_cast<Indic_Syllabic_Category>(details::trie_lookup<5, 7>(
+      details::Indic_Syllabic_Category_top, details::Indic_Syllabic_Category_mid, details::Indic_Syllabic_Category_leaf, code_point));
+}
+
+template<>
+constexpr Vertical_Orientation get<Vertical_Orientation>(char32_t code_point) noexcept {
+  return static_cast<Vertical_Orientation>(details::trie_lookup<5, 5>(
+      details::Vertical_Orientation_top, details::Vertical_Orientation_mid, details::Vertical_Orientation_leaf, code_point));
+}
+
+template<>
+constexpr Grapheme_Cluster_Break get<Grapheme_Cluster_Break>(char32_t code_point) noexcept {
+  return static_cast<Grapheme_Cluster_Break>(details::trie_lookup<4, 6>(
+      details::Grapheme_Cluster_Break_top, details::Grapheme_Cluster_Break_mid, details::Grapheme_Cluster_Break_leaf, code_point));
+}
+
+template<>
+constexpr Word_Break get<Word_Break>(char32_t code_point) noexcept {
+  return static_cast<Word_Break>(details::trie_lookup<4, 5>(
+      details::Word_Break_top, details::Word_Break_mid, details::Word_Break_leaf, code_point));
+}
+
+template<>
+constexpr Sentence_Break get<Sentence_Break>(char32_t code_point) noexcept {
+  return static_cast<Sentence_Break>(details::trie_lookup<4, 5>(
+      details::Sentence_Break_top, details::Sentence_Break_mid, details::Sentence_Break_leaf, code_point));
+}
+
+template<>
+constexpr Indic_Conjunct_Break get<Indic_Conjunct_Break>(char32_t code_point) noexcept {
+  return static_cast<Indic_Conjunct_Break>(details::trie_lookup<4, 6>(
+      details::Indic_Conjunct_Break_top, details::Indic_Conjunct_Break_mid, details::Indic_Conjunct_Break_leaf, code_point));
+}
+
+template<>
+constexpr NFD_Quick_Check get<NFD_Quick_Check>(char32_t code_point) noexcept {
+  return static_cast<NFD_Quick_Check>(details::trie_lookup<4, 6>(
+      details::NFD_Quick_Check_top, details::NFD_Quick_Check_mid, details::NFD_Quick_Check_leaf, code_point));
+}
+
+template<>
+constexpr NFC_Quick_Check get<NFC_Quick_Check>(char32_t code_point) noexcept {
+  return static_cast<NFC_Quick_Check>(details::trie_lookup<4, 6>(
+      details::NFC_Quick_Check_top, details::NFC_Quick_Check_mid, details::NFC_Quick_Check_leaf, code_point));
+}
+
+template<>
+constexpr NFKD_Quick_Check get<NFKD_Quick_Check>(char32_t code_point) noexcept {
+  return static_cast<NFKD_Quick_Check>(details::trie_lookup<4, 6>(
+      details::NFKD_Quick_Check_top, details::NFKD_Quick_Check_mid, details::NFKD_Quick_Check_leaf, code_point));
+}
+
+template<>
+constexpr NFKC_Quick_Check get<NFKC_Quick_Check>(char32_t code_point) noexcept {
+  return static_cast<NFKC_Quick_Check>(details::trie_lookup<4, 6>(
+      details::NFKC_Quick_Check_top, details::NFKC_Quick_Check_mid, details::NFKC_Quick_Check_leaf, code_point));
+}
+
+template<>
+constexpr bool has<XID_Start>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties0_top, details::Binary_Properties0_mid, details::Binary_Properties0_leaf, code_point) >> 0) & 1;
+}
+template<>
+constexpr XID_Start get<XID_Start>(char32_t code_point) noexcept {
+  return static_cast<XID_Start>(has<XID_Start>(code_point));
+}
+
+template<>
+constexpr bool has<XID_Continue>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties0_top, details::Binary_Properties0_mid, details::Binary_Properties0_leaf, code_point) >> 1) & 1;
+}
+template<>
+constexpr XID_Continue get<XID_Continue>(char32_t code_point) noexcept {
+  return static_cast<XID_Continue>(has<XID_Continue>(code_point));
+}
+
+template<>
+constexpr bool has<ID_Start>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties0_top, details::Binary_Properties0_mid, details::Binary_Properties0_leaf, code_point) >> 2) & 1;
+}
+template<>
+constexpr ID_Start get<ID_Start>(char32_t code_point) noexcept {
+  return static_cast<ID_Start>(has<ID_Start>(code_point));
+}
+
+template<>
+constexpr bool has<ID_Continue>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties0_top, details::Binary_Properties0_mid, details::Binary_Properties0_leaf, code_point) >> 3) & 1;
+}
+template<>
+constexpr ID_Continue get<ID_Continue>(char32_t code_point) noexcept {
+  return static_cast<ID_Continue>(has<ID_Continue>(code_point));
+}
+
+template<>
+constexpr bool has<White_Space>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties0_top, details::Binary_Properties0_mid, details::Binary_Properties0_leaf, code_point) >> 4) & 1;
+}
+template<>
+constexpr White_Space get<White_Space>(char32_t code_point) noexcept {
+  return static_cast<White_Space>(has<White_Space>(code_point));
+}
+
+template<>
+constexpr bool has<Pattern_White_Space>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties0_top, details::Binary_Properties0_mid, details::Binary_Properties0_leaf, code_point) >> 5) & 1;
+}
+template<>
+constexpr Pattern_White_Space get<Pattern_White_Space>(char32_t code_point) noexcept {
+  return static_cast<Pattern_White_Space>(has<Pattern_White_Space>(code_point));
+}
+
+template<>
+constexpr bool has<Pattern_Syntax>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties0_top, details::Binary_Properties0_mid, details::Binary_Properties0_leaf, code_point) >> 6) & 1;
+}
+template<>
+constexpr Pattern_Syntax get<Pattern_Syntax>(char32_t code_point) noexcept {
+  return static_cast<Pattern_Syntax>(has<Pattern_Syntax>(code_point));
+}
+
+template<>
+constexpr bool has<Alphabetic>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties0_top, details::Binary_Properties0_mid, details::Binary_Properties0_leaf, code_point) >> 7) & 1;
+}
+template<>
+constexpr Alphabetic get<Alphabetic>(char32_t code_point) noexcept {
+  return static_cast<Alphabetic>(has<Alphabetic>(code_point));
+}
+
+template<>
+constexpr bool has<Uppercase>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties0_top, details::Binary_Properties0_mid, details::Binary_Properties0_leaf, code_point) >> 8) & 1;
+}
+template<>
+constexpr Uppercase get<Uppercase>(char32_t code_point) noexcept {
+  return static_cast<Uppercase>(has<Uppercase>(code_point));
+}
+
+template<>
+constexpr bool has<Lowercase>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties0_top, details::Binary_Properties0_mid, details::Binary_Properties0_leaf, code_point) >> 9) & 1;
+}
+template<>
+constexpr Lowercase get<Lowercase>(char32_t code_point) noexcept {
+  return static_cast<Lowercase>(has<Lowercase>(code_point));
+}
+
+template<>
+constexpr bool has<Default_Ignorable_Code_Point>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties0_top, details::Binary_Properties0_mid, details::Binary_Properties0_leaf, code_point) >> 10) & 1;
+}
+template<>
+constexpr Default_Ignorable_Code_Point get<Default_Ignorable_Code_Point>(char32_t code_point) noexcept {
+  return static_cast<Default_Ignorable_Code_Point>(has<Default_Ignorable_Code_Point>(code_point));
+}
+
+template<>
+constexpr bool has<Extended_Pictographic>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties0_top, details::Binary_Properties0_mid, details::Binary_Properties0_leaf, code_point) >> 11) & 1;
+}
+template<>
+constexpr Extended_Pictographic get<Extended_Pictographic>(char32_t code_point) noexcept {
+  return static_cast<Extended_Pictographic>(has<Extended_Pictographic>(code_point));
+}
+
+template<>
+constexpr bool has<Emoji>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties0_top, details::Binary_Properties0_mid, details::Binary_Properties0_leaf, code_point) >> 12) & 1;
+}
+template<>
+constexpr Emoji get<Emoji>(char32_t code_point) noexcept {
+  return static_cast<Emoji>(has<Emoji>(code_point));
+}
+
+template<>
+constexpr bool has<Regional_Indicator>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties0_top, details::Binary_Properties0_mid, details::Binary_Properties0_leaf, code_point) >> 13) & 1;
+}
+template<>
+constexpr Regional_Indicator get<Regional_Indicator>(char32_t code_point) noexcept {
+  return static_cast<Regional_Indicator>(has<Regional_Indicator>(code_point));
+}
+
+template<>
+constexpr bool has<Grapheme_Extend>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties0_top, details::Binary_Properties0_mid, details::Binary_Properties0_leaf, code_point) >> 14) & 1;
+}
+template<>
+constexpr Grapheme_Extend get<Grapheme_Extend>(char32_t code_point) noexcept {
+  return static_cast<Grapheme_Extend>(has<Grapheme_Extend>(code_point));
+}
+
+template<>
+constexpr bool has<Math>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties0_top, details::Binary_Properties0_mid, details::Binary_Properties0_leaf, code_point) >> 15) & 1;
+}
+template<>
+constexpr Math get<Math>(char32_t code_point) noexcept {
+  return static_cast<Math>(has<Math>(code_point));
+}
+
+template<>
+constexpr bool has<Bidi_Control>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties1_top, details::Binary_Properties1_mid, details::Binary_Properties1_leaf, code_point) >> 0) & 1;
+}
+template<>
+constexpr Bidi_Control get<Bidi_Control>(char32_t code_point) noexcept {
+  return static_cast<Bidi_Control>(has<Bidi_Control>(code_point));
+}
+
+template<>
+constexpr bool has<Join_Control>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties1_top, details::Binary_Properties1_mid, details::Binary_Properties1_leaf, code_point) >> 1) & 1;
+}
+template<>
+constexpr Join_Control get<Join_Control>(char32_t code_point) noexcept {
+  return static_cast<Join_Control>(has<Join_Control>(code_point));
+}
+
+template<>
+constexpr bool has<Dash>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties1_top, details::Binary_Properties1_mid, details::Binary_Properties1_leaf, code_point) >> 2) & 1;
+}
+template<>
+constexpr Dash get<Dash>(char32_t code_point) noexcept {
+  return static_cast<Dash>(has<Dash>(code_point));
+}
+
+template<>
+constexpr bool has<Hyphen>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties1_top, details::Binary_Properties1_mid, details::Binary_Properties1_leaf, code_point) >> 3) & 1;
+}
+template<>
+constexpr Hyphen get<Hyphen>(char32_t code_point) noexcept {
+  return static_cast<Hyphen>(has<Hyphen>(code_point));
+}
+
+template<>
+constexpr bool has<Quotation_Mark>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties1_top, details::Binary_Properties1_mid, details::Binary_Properties1_leaf, code_point) >> 4) & 1;
+}
+template<>
+constexpr Quotation_Mark get<Quotation_Mark>(char32_t code_point) noexcept {
+  return static_cast<Quotation_Mark>(has<Quotation_Mark>(code_point));
+}
+
+template<>
+constexpr bool has<Terminal_Punctuation>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties1_top, details::Binary_Properties1_mid, details::Binary_Properties1_leaf, code_point) >> 5) & 1;
+}
+template<>
+constexpr Terminal_Punctuation get<Terminal_Punctuation>(char32_t code_point) noexcept {
+  return static_cast<Terminal_Punctuation>(has<Terminal_Punctuation>(code_point));
+}
+
+template<>
+constexpr bool has<Other_Math>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties1_top, details::Binary_Properties1_mid, details::Binary_Properties1_leaf, code_point) >> 6) & 1;
+}
+template<>
+constexpr Other_Math get<Other_Math>(char32_t code_point) noexcept {
+  return static_cast<Other_Math>(has<Other_Math>(code_point));
+}
+
+template<>
+constexpr bool has<Hex_Digit>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties1_top, details::Binary_Properties1_mid, details::Binary_Properties1_leaf, code_point) >> 7) & 1;
+}
+template<>
+constexpr Hex_Digit get<Hex_Digit>(char32_t code_point) noexcept {
+  return static_cast<Hex_Digit>(has<Hex_Digit>(code_point));
+}
+
+template<>
+constexpr bool has<ASCII_Hex_Digit>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties1_top, details::Binary_Properties1_mid, details::Binary_Properties1_leaf, code_point) >> 8) & 1;
+}
+template<>
+constexpr ASCII_Hex_Digit get<ASCII_Hex_Digit>(char32_t code_point) noexcept {
+  return static_cast<ASCII_Hex_Digit>(has<ASCII_Hex_Digit>(code_point));
+}
+
+template<>
+constexpr bool has<Other_Alphabetic>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties1_top, details::Binary_Properties1_mid, details::Binary_Properties1_leaf, code_point) >> 9) & 1;
+}
+template<>
+constexpr Other_Alphabetic get<Other_Alphabetic>(char32_t code_point) noexcept {
+  return static_cast<Other_Alphabetic>(has<Other_Alphabetic>(code_point));
+}
+
+template<>
+constexpr bool has<Ideographic>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties1_top, details::Binary_Properties1_mid, details::Binary_Properties1_leaf, code_point) >> 10) & 1;
+}
+template<>
+constexpr Ideographic get<Ideographic>(char32_t code_point) noexcept {
+  return static_cast<Ideographic>(has<Ideographic>(code_point));
+}
+
+template<>
+constexpr bool has<Diacritic>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties1_top, details::Binary_Properties1_mid, details::Binary_Properties1_leaf, code_point) >> 11) & 1;
+}
+template<>
+constexpr Diacritic get<Diacritic>(char32_t code_point) noexcept {
+  return static_cast<Diacritic>(has<Diacritic>(code_point));
+}
+
+template<>
+constexpr bool has<Extender>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties1_top, details::Binary_Properties1_mid, details::Binary_Properties1_leaf, code_point) >> 12) & 1;
+}
+template<>
+constexpr Extender get<Extender>(char32_t code_point) noexcept {
+  return static_cast<Extender>(has<Extender>(code_point));
+}
+
+template<>
+constexpr bool has<Other_Lowercase>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties1_top, details::Binary_Properties1_mid, details::Binary_Properties1_leaf, code_point) >> 13) & 1;
+}
+template<>
+constexpr Other_Lowercase get<Other_Lowercase>(char32_t code_point) noexcept {
+  return static_cast<Other_Lowercase>(has<Other_Lowercase>(code_point));
+}
+
+template<>
+constexpr bool has<Other_Uppercase>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties1_top, details::Binary_Properties1_mid, details::Binary_Properties1_leaf, code_point) >> 14) & 1;
+}
+template<>
+constexpr Other_Uppercase get<Other_Uppercase>(char32_t code_point) noexcept {
+  return static_cast<Other_Uppercase>(has<Other_Uppercase>(code_point));
+}
+
+template<>
+constexpr bool has<Noncharacter_Code_Point>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties1_top, details::Binary_Properties1_mid, details::Binary_Properties1_leaf, code_point) >> 15) & 1;
+}
+template<>
+constexpr Noncharacter_Code_Point get<Noncharacter_Code_Point>(char32_t code_point) noexcept {
+  return static_cast<Noncharacter_Code_Point>(has<Noncharacter_Code_Point>(code_point));
+}
+
+template<>
+constexpr bool has<Other_Grapheme_Extend>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 6>(
+      details::Binary_Properties2_top, details::Binary_Properties2_mid, details::Binary_Properties2_leaf, code_point) >> 0) & 1;
+}
+template<>
+constexpr Other_Grapheme_Extend get<Other_Grapheme_Extend>(char32_t code_point) noexcept {
+  return static_cast<Other_Grapheme_Extend>(has<Other_Grapheme_Extend>(code_point));
+}
+
+template<>
+constexpr bool has<IDS_Binary_Operator>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 6>(
+      details::Binary_Properties2_top, details::Binary_Properties2_mid, details::Binary_Properties2_leaf, code_point) >> 1) & 1;
+}
+template<>
+constexpr IDS_Binary_Operator get<IDS_Binary_Operator>(char32_t code_point) noexcept {
+  return static_cast<IDS_Binary_Operator>(has<IDS_Binary_Operator>(code_point));
+}
+
+template<>
+constexpr bool has<IDS_Trinary_Operator>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 6>(
+      details::Binary_Properties2_top, details::Binary_Properties2_mid, details::Binary_Properties2_leaf, code_point) >> 2) & 1;
+}
+template<>
+constexpr IDS_Trinary_Operator get<IDS_Trinary_Operator>(char32_t code_point) noexcept {
+  return static_cast<IDS_Trinary_Operator>(has<IDS_Trinary_Operator>(code_point));
+}
+
+template<>
+constexpr bool has<IDS_Unary_Operator>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 6>(
+      details::Binary_Properties2_top, details::Binary_Properties2_mid, details::Binary_Properties2_leaf, code_point) >> 3) & 1;
+}
+template<>
+constexpr IDS_Unary_Operator get<IDS_Unary_Operator>(char32_t code_point) noexcept {
+  return static_cast<IDS_Unary_Operator>(has<IDS_Unary_Operator>(code_point));
+}
+
+template<>
+constexpr bool has<Radical>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 6>(
+      details::Binary_Properties2_top, details::Binary_Properties2_mid, details::Binary_Properties2_leaf, code_point) >> 4) & 1;
+}
+template<>
+constexpr Radical get<Radical>(char32_t code_point) noexcept {
+  return static_cast<Radical>(has<Radical>(code_point));
+}
+
+template<>
+constexpr bool has<Unified_Ideograph>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 6>(
+      details::Binary_Properties2_top, details::Binary_Properties2_mid, details::Binary_Properties2_leaf, code_point) >> 5) & 1;
+}
+template<>
+constexpr Unified_Ideograph get<Unified_Ideograph>(char32_t code_point) noexcept {
+  return static_cast<Unified_Ideograph>(has<Unified_Ideograph>(code_point));
+}
+
+template<>
+constexpr bool has<Other_Default_Ignorable_Code_Point>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 6>(
+      details::Binary_Properties2_top, details::Binary_Properties2_mid, details::Binary_Properties2_leaf, code_point) >> 6) & 1;
+}
+template<>
+constexpr Other_Default_Ignorable_Code_Point get<Other_Default_Ignorable_Code_Point>(char32_t code_point) noexcept {
+  return static_cast<Other_Default_Ignorable_Code_Point>(has<Other_Default_Ignorable_Code_Point>(code_point));
+}
+
+template<>
+constexpr bool has<Deprecated>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 6>(
+      details::Binary_Properties2_top, details::Binary_Properties2_mid, details::Binary_Properties2_leaf, code_point) >> 7) & 1;
+}
+template<>
+constexpr Deprecated get<Deprecated>(char32_t code_point) noexcept {
+  return static_cast<Deprecated>(has<Deprecated>(code_point));
+}
+
+template<>
+constexpr bool has<Soft_Dotted>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 6>(
+      details::Binary_Properties2_top, details::Binary_Properties2_mid, details::Binary_Properties2_leaf, code_point) >> 8) & 1;
+}
+template<>
+constexpr Soft_Dotted get<Soft_Dotted>(char32_t code_point) noexcept {
+  return static_cast<Soft_Dotted>(has<Soft_Dotted>(code_point));
+}
+
+template<>
+constexpr bool has<Logical_Order_Exception>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 6>(
+      details::Binary_Properties2_top, details::Binary_Properties2_mid, details::Binary_Properties2_leaf, code_point) >> 9) & 1;
+}
+template<>
+constexpr Logical_Order_Exception get<Logical_Order_Exception>(char32_t code_point) noexcept {
+  return static_cast<Logical_Order_Exception>(has<Logical_Order_Exception>(code_point));
+}
+
+template<>
+constexpr bool has<Other_ID_Start>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 6>(
+      details::Binary_Properties2_top, details::Binary_Properties2_mid, details::Binary_Properties2_leaf, code_point) >> 10) & 1;
+}
+template<>
+constexpr Other_ID_Start get<Other_ID_Start>(char32_t code_point) noexcept {
+  return static_cast<Other_ID_Start>(has<Other_ID_Start>(code_point));
+}
+
+template<>
+constexpr bool has<Other_ID_Continue>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 6>(
+      details::Binary_Properties2_top, details::Binary_Properties2_mid, details::Binary_Properties2_leaf, code_point) >> 11) & 1;
+}
+template<>
+constexpr Other_ID_Continue get<Other_ID_Continue>(char32_t code_point) noexcept {
+  return static_cast<Other_ID_Continue>(has<Other_ID_Continue>(code_point));
+}
+
+template<>
+constexpr bool has<ID_Compat_Math_Continue>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 6>(
+      details::Binary_Properties2_top, details::Binary_Properties2_mid, details::Binary_Properties2_leaf, code_point) >> 12) & 1;
+}
+template<>
+constexpr ID_Compat_Math_Continue get<ID_Compat_Math_Continue>(char32_t code_point) noexcept {
+  return static_cast<ID_Compat_Math_Continue>(has<ID_Compat_Math_Continue>(code_point));
+}
+
+template<>
+constexpr bool has<ID_Compat_Math_Start>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 6>(
+      details::Binary_Properties2_top, details::Binary_Properties2_mid, details::Binary_Properties2_leaf, code_point) >> 13) & 1;
+}
+template<>
+constexpr ID_Compat_Math_Start get<ID_Compat_Math_Start>(char32_t code_point) noexcept {
+  return static_cast<ID_Compat_Math_Start>(has<ID_Compat_Math_Start>(code_point));
+}
+
+template<>
+constexpr bool has<Sentence_Terminal>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 6>(
+      details::Binary_Properties2_top, details::Binary_Properties2_mid, details::Binary_Properties2_leaf, code_point) >> 14) & 1;
+}
+template<>
+constexpr Sentence_Terminal get<Sentence_Terminal>(char32_t code_point) noexcept {
+  return static_cast<Sentence_Terminal>(has<Sentence_Terminal>(code_point));
+}
+
+template<>
+constexpr bool has<Variation_Selector>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 6>(
+      details::Binary_Properties2_top, details::Binary_Properties2_mid, details::Binary_Properties2_leaf, code_point) >> 15) & 1;
+}
+template<>
+constexpr Variation_Selector get<Variation_Selector>(char32_t code_point) noexcept {
+  return static_cast<Variation_Selector>(has<Variation_Selector>(code_point));
+}
+
+template<>
+constexpr bool has<Prepended_Concatenation_Mark>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties3_top, details::Binary_Properties3_mid, details::Binary_Properties3_leaf, code_point) >> 0) & 1;
+}
+template<>
+constexpr Prepended_Concatenation_Mark get<Prepended_Concatenation_Mark>(char32_t code_point) noexcept {
+  return static_cast<Prepended_Concatenation_Mark>(has<Prepended_Concatenation_Mark>(code_point));
+}
+
+template<>
+constexpr bool has<Modifier_Combining_Mark>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties3_top, details::Binary_Properties3_mid, details::Binary_Properties3_leaf, code_point) >> 1) & 1;
+}
+template<>
+constexpr Modifier_Combining_Mark get<Modifier_Combining_Mark>(char32_t code_point) noexcept {
+  return static_cast<Modifier_Combining_Mark>(has<Modifier_Combining_Mark>(code_point));
+}
+
+template<>
+constexpr bool has<Cased>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties3_top, details::Binary_Properties3_mid, details::Binary_Properties3_leaf, code_point) >> 2) & 1;
+}
+template<>
+constexpr Cased get<Cased>(char32_t code_point) noexcept {
+  return static_cast<Cased>(has<Cased>(code_point));
+}
+
+template<>
+constexpr bool has<Case_Ignorable>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties3_top, details::Binary_Properties3_mid, details::Binary_Properties3_leaf, code_point) >> 3) & 1;
+}
+template<>
+constexpr Case_Ignorable get<Case_Ignorable>(char32_t code_point) noexcept {
+  return static_cast<Case_Ignorable>(has<Case_Ignorable>(code_point));
+}
+
+template<>
+constexpr bool has<Changes_When_Lowercased>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties3_top, details::Binary_Properties3_mid, details::Binary_Properties3_leaf, code_point) >> 4) & 1;
+}
+template<>
+constexpr Changes_When_Lowercased get<Changes_When_Lowercased>(char32_t code_point) noexcept {
+  return static_cast<Changes_When_Lowercased>(has<Changes_When_Lowercased>(code_point));
+}
+
+template<>
+constexpr bool has<Changes_When_Uppercased>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties3_top, details::Binary_Properties3_mid, details::Binary_Properties3_leaf, code_point) >> 5) & 1;
+}
+template<>
+constexpr Changes_When_Uppercased get<Changes_When_Uppercased>(char32_t code_point) noexcept {
+  return static_cast<Changes_When_Uppercased>(has<Changes_When_Uppercased>(code_point));
+}
+
+template<>
+constexpr bool has<Changes_When_Titlecased>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties3_top, details::Binary_Properties3_mid, details::Binary_Properties3_leaf, code_point) >> 6) & 1;
+}
+template<>
+constexpr Changes_When_Titlecased get<Changes_When_Titlecased>(char32_t code_point) noexcept {
+  return static_cast<Changes_When_Titlecased>(has<Changes_When_Titlecased>(code_point));
+}
+
+template<>
+constexpr bool has<Changes_When_Casefolded>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties3_top, details::Binary_Properties3_mid, details::Binary_Properties3_leaf, code_point) >> 7) & 1;
+}
+template<>
+constexpr Changes_When_Casefolded get<Changes_When_Casefolded>(char32_t code_point) noexcept {
+  return static_cast<Changes_When_Casefolded>(has<Changes_When_Casefolded>(code_point));
+}
+
+template<>
+constexpr bool has<Changes_When_Casemapped>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties3_top, details::Binary_Properties3_mid, details::Binary_Properties3_leaf, code_point) >> 8) & 1;
+}
+template<>
+constexpr Changes_When_Casemapped get<Changes_When_Casemapped>(char32_t code_point) noexcept {
+  return static_cast<Changes_When_Casemapped>(has<Changes_When_Casemapped>(code_point));
+}
+
+template<>
+constexpr bool has<Grapheme_Base>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties3_top, details::Binary_Properties3_mid, details::Binary_Properties3_leaf, code_point) >> 9) & 1;
+}
+template<>
+constexpr Grapheme_Base get<Grapheme_Base>(char32_t code_point) noexcept {
+  return static_cast<Grapheme_Base>(has<Grapheme_Base>(code_point));
+}
+
+template<>
+constexpr bool has<Grapheme_Link>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties3_top, details::Binary_Properties3_mid, details::Binary_Properties3_leaf, code_point) >> 10) & 1;
+}
+template<>
+constexpr Grapheme_Link get<Grapheme_Link>(char32_t code_point) noexcept {
+  return static_cast<Grapheme_Link>(has<Grapheme_Link>(code_point));
+}
+
+template<>
+constexpr bool has<Full_Composition_Exclusion>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties3_top, details::Binary_Properties3_mid, details::Binary_Properties3_leaf, code_point) >> 11) & 1;
+}
+template<>
+constexpr Full_Composition_Exclusion get<Full_Composition_Exclusion>(char32_t code_point) noexcept {
+  return static_cast<Full_Composition_Exclusion>(has<Full_Composition_Exclusion>(code_point));
+}
+
+template<>
+constexpr bool has<Expands_On_NFD>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties3_top, details::Binary_Properties3_mid, details::Binary_Properties3_leaf, code_point) >> 12) & 1;
+}
+template<>
+constexpr Expands_On_NFD get<Expands_On_NFD>(char32_t code_point) noexcept {
+  return static_cast<Expands_On_NFD>(has<Expands_On_NFD>(code_point));
+}
+
+template<>
+constexpr bool has<Expands_On_NFC>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties3_top, details::Binary_Properties3_mid, details::Binary_Properties3_leaf, code_point) >> 13) & 1;
+}
+template<>
+constexpr Expands_On_NFC get<Expands_On_NFC>(char32_t code_point) noexcept {
+  return static_cast<Expands_On_NFC>(has<Expands_On_NFC>(code_point));
+}
+
+template<>
+constexpr bool has<Expands_On_NFKD>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties3_top, details::Binary_Properties3_mid, details::Binary_Properties3_leaf, code_point) >> 14) & 1;
+}
+template<>
+constexpr Expands_On_NFKD get<Expands_On_NFKD>(char32_t code_point) noexcept {
+  return static_cast<Expands_On_NFKD>(has<Expands_On_NFKD>(code_point));
+}
+
+template<>
+constexpr bool has<Expands_On_NFKC>(char32_t code_point) noexcept {
+  return (details::trie_lookup<3, 5>(
+      details::Binary_Properties3_top, details::Binary_Properties3_mid, details::Binary_Properties3_leaf, code_point) >> 15) & 1;
+}
+template<>
+constexpr Expands_On_NFKC get<Expands_On_NFKC>(char32_t code_point) noexcept {
+  return static_cast<Expands_On_NFKC>(has<Expands_On_NFKC>(code_point));
+}
+
+template<>
+constexpr bool has<Changes_When_NFKC_Casefolded>(char32_t code_point) noexcept {
+  return (details::trie_lookup<5, 6>(
+      details::Binary_Properties4_top, details::Binary_Properties4_mid, details::Binary_Properties4_leaf, code_point) >> 0) & 1;
+}
+template<>
+constexpr Changes_When_NFKC_Casefolded get<Changes_When_NFKC_Casefolded>(char32_t code_point) noexcept {
+  return static_cast<Changes_When_NFKC_Casefolded>(has<Changes_When_NFKC_Casefolded>(code_point));
+}
+
+template<>
+constexpr bool has<Emoji_Presentation>(char32_t code_point) noexcept {
+  return (details::trie_lookup<5, 6>(
+      details::Binary_Properties4_top, details::Binary_Properties4_mid, details::Binary_Properties4_leaf, code_point) >> 1) & 1;
+}
+template<>
+constexpr Emoji_Presentation get<Emoji_Presentation>(char32_t code_point) noexcept {
+  return static_cast<Emoji_Presentation>(has<Emoji_Presentation>(code_point));
+}
+
+template<>
+constexpr bool has<Emoji_Modifier>(char32_t code_point) noexcept {
+  return (details::trie_lookup<5, 6>(
+      details::Binary_Properties4_top, details::Binary_Properties4_mid, details::Binary_Properties4_leaf, code_point) >> 2) & 1;
+}
+template<>
+constexpr Emoji_Modifier get<Emoji_Modifier>(char32_t code_point) noexcept {
+  return static_cast<Emoji_Modifier>(has<Emoji_Modifier>(code_point));
+}
+
+template<>
+constexpr bool has<Emoji_Modifier_Base>(char32_t code_point) noexcept {
+  return (details::trie_lookup<5, 6>(
+      details::Binary_Properties4_top, details::Binary_Properties4_mid, details::Binary_Properties4_leaf, code_point) >> 3) & 1;
+}
+template<>
+constexpr Emoji_Modifier_Base get<Emoji_Modifier_Base>(char32_t code_point) noexcept {
+  return static_cast<Emoji_Modifier_Base>(has<Emoji_Modifier_Base>(code_point));
+}
+
+template<>
+constexpr bool has<Emoji_Component>(char32_t code_point) noexcept {
+  return (details::trie_lookup<5, 6>(
+      details::Binary_Properties4_top, details::Binary_Properties4_mid, details::Binary_Properties4_leaf, code_point) >> 4) & 1;
+}
+template<>
+constexpr Emoji_Component get<Emoji_Component>(char32_t code_point) noexcept {
+  return static_cast<Emoji_Component>(has<Emoji_Component>(code_point));
+}
+
+template<>
+constexpr bool has<Bidi_Mirrored>(char32_t code_point) noexcept {
+  return (details::trie_lookup<5, 6>(
+      details::Binary_Properties4_top, details::Binary_Properties4_mid, details::Binary_Properties4_leaf, code_point) >> 5) & 1;
+}
+template<>
+constexpr Bidi_Mirrored get<Bidi_Mirrored>(char32_t code_point) noexcept {
+  return static_cast<Bidi_Mirrored>(has<Bidi_Mirrored>(code_point));
+}
+
 } // namespace clt::uni
 
 #endif // !__COLT_UNICODE_PROPERTIES__
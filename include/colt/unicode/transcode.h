@@ -0,0 +1,545 @@
+/*****************************************************************/ /**
+ * @file   transcode.h
+ * @brief  Contains bulk conversions between all the StringEncoding.
+ *
+ * `transcode_size` returns the number of units needed to convert
+ * a whole string to another encoding.
+ * `transcode` converts a whole string to another encoding.
+ * Both functions validate their input.
+ * Whenever possible, the conversions are forwarded to simdutf.
+ * Non-host UTF32 is byteswapped in bulk (see `bswap_span`) to host UTF32
+ * and forwarded to simdutf. ASCII is handled by scalar fallbacks.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_UNI_TRANSCODE
+#define HG_UNI_TRANSCODE
+
+#include "unicode.h"
+#include "colt/dsa/expect.h"
+#include "colt/num/endian.h"
+#include "colt/trace.h"
+
+namespace clt::uni
+{
+  /// @brief Returns the number of 'To' units needed to convert 'from'.
+  /// Use this function to allocate the output of 'transcode' once.
+  /// @tparam To The destination char type
+  /// @tparam From The source char type
+  /// @param from The units to convert
+  /// @return The number of units or INVALID_INPUT
+  /// @note 'std::span<const From>' is used rather than 'View<From>' as the
+  ///       latter cannot be used to deduce 'From'.
+  template<meta::CharType To, meta::CharType From>
+  constexpr Expect<size_t, ConvError> transcode_size(
+      std::span<const From> from) noexcept;
+
+  /// @brief Converts all the units of 'from' to the encoding of 'To'.
+  /// On error, the content of 'to' is unspecified.
+  /// @tparam To The destination char type
+  /// @tparam From The source char type
+  /// @param from The units to convert
+  /// @param to The buffer where to write
+  /// @return The number of units written, INVALID_INPUT or NOT_ENOUGH_SPACE
+  template<meta::CharType To, meta::CharType From>
+  constexpr Expect<size_t, ConvError> transcode(
+      std::span<const From> from, Span<To> to) noexcept;
+
+  namespace details
+  {
+    /// @brief Returns the number of units needed to encode a code point.
+    /// @tparam To The destination char type
+    /// @param cp The (valid) code point
+    /// @return The number of units or 0 if 'cp' is not representable
+    template<meta::CharType To>
+    constexpr size_t encoded_units(char32_t cp) noexcept
+    {
+      if constexpr (std::same_as<To, char>)
+        return static_cast<size_t>(cp < 0x80);
+      if constexpr (std::same_as<To, Char8>)
+        return 1 + (size_t)(cp >= 0x80) + (size_t)(cp >= 0x800)
+               + (size_t)(cp >= 0x10000);
+      if constexpr (meta::is_any_of<To, Char16LE, Char16BE>)
+        return 1 + (size_t)!is_in_bmp(cp);
+      if constexpr (meta::is_any_of<To, Char32LE, Char32BE>)
+        return 1;
+    }
+
+    /// @brief Encodes a code point.
+    /// @tparam To The destination char type
+    /// @param cp The (valid and representable) code point
+    /// @param to The buffer where to write (must have enough space)
+    /// @return Pointer to after the last written unit
+    template<meta::CharType To>
+    constexpr To* unchecked_encode(char32_t cp, To* to) noexcept
+    {
+      if constexpr (std::same_as<To, char>)
+        *to++ = static_cast<char>(cp);
+      if constexpr (std::same_as<To, Char8>)
+      {
+        if (cp < 0x80) [[likely]]
+          *to++ = Char8(static_cast<char8_t>(cp));
+        else if (cp < 0x800)
+        {
+          *to++ = Char8(static_cast<char8_t>((cp >> 6) | 0xc0));
+          *to++ = Char8(static_cast<char8_t>((cp & 0x3f) | 0x80));
+        }
+        else if (cp < 0x10000)
+        {
+          *to++ = Char8(static_cast<char8_t>((cp >> 12) | 0xe0));
+          *to++ = Char8(static_cast<char8_t>(((cp >> 6) & 0x3f) | 0x80));
+          *to++ = Char8(static_cast<char8_t>((cp & 0x3f) | 0x80));
+        }
+        else
+        {
+          *to++ = Char8(static_cast<char8_t>((cp >> 18) | 0xf0));
+          *to++ = Char8(static_cast<char8_t>(((cp >> 12) & 0x3f) | 0x80));
+          *to++ = Char8(static_cast<char8_t>(((cp >> 6) & 0x3f) | 0x80));
+          *to++ = Char8(static_cast<char8_t>((cp & 0x3f) | 0x80));
+        }
+      }
+      if constexpr (meta::is_any_of<To, Char16LE, Char16BE>)
+      {
+        char16_t buffer[2];
+        const auto end = unsafe_utf32to16(cp, buffer);
+        for (auto ptr = buffer; ptr != end; ++ptr)
+          *to++ = To(*ptr);
+      }
+      if constexpr (meta::is_any_of<To, Char32LE, Char32BE>)
+        *to++ = To(cp);
+      return to;
+    }
+
+    /// @brief Scalar implementation of 'transcode_size'
+    /// @tparam To The destination char type
+    /// @tparam From The source char type
+    /// @param from The units to convert
+    /// @return The number of units or INVALID_INPUT
+    template<meta::CharType To, meta::CharType From>
+    constexpr Expect<size_t, ConvError> transcode_size_default(
+        std::span<const From> from) noexcept
+    {
+      const From* ptr = from.data();
+      const From* end = ptr + from.size();
+      size_t result   = 0;
+      char32_t cp;
+      while (ptr != end)
+      {
+        if (!checked_decode(ptr, end, cp)) [[unlikely]]
+          return {Error, ConvError::INVALID_INPUT};
+        const size_t units = encoded_units<To>(cp);
+        if (units == 0) [[unlikely]]
+          return {Error, ConvError::INVALID_INPUT};
+        result += units;
+      }
+      return result;
+    }
+
+    /// @brief Scalar implementation of 'transcode'
+    /// @tparam To The destination char type
+    /// @tparam From The source char type
+    /// @param from The units to convert
+    /// @param to The buffer where to write
+    /// @return The number of units written, INVALID_INPUT or NOT_ENOUGH_SPACE
+    template<meta::CharType To, meta::CharType From>
+    constexpr Expect<size_t, ConvError> transcode_default(
+        std::span<const From> from, Span<To> to) noexcept
+    {
+      const From* ptr   = from.data();
+      const From* end   = ptr + from.size();
+      To* result        = to.data();
+      To* const max_res = result + to.size();
+      char32_t cp;
+      while (ptr != end)
+      {
+        if (!checked_decode(ptr, end, cp)) [[unlikely]]
+          return {Error, ConvError::INVALID_INPUT};
+        const size_t units = encoded_units<To>(cp);
+        if (units == 0) [[unlikely]]
+          return {Error, ConvError::INVALID_INPUT};
+        if (static_cast<size_t>(max_res - result) < units)
+          return {Error, ConvError::NOT_ENOUGH_SPACE};
+        result = unchecked_encode(cp, result);
+      }
+      return static_cast<size_t>(result - to.data());
+    }
+
+    /// @brief Check if a char type is handled by simdutf.
+    /// simdutf only handles UTF32 in host endianness.
+    template<typename T>
+    concept SimdutfCharType = meta::is_any_of<T, Char8, Char16LE, Char16BE, Char32>;
+
+    /// @brief Check if a conversion from 'From' to 'To' is forwarded to simdutf
+    template<typename To, typename From>
+    concept SimdutfTranscodable =
+        (SimdutfCharType<To> && SimdutfCharType<From>)
+        || (std::same_as<From, char> && meta::is_any_of<To, char, Char8>)
+        || (std::same_as<From, Char8> && std::same_as<To, char>);
+
+    /// @brief Validates 'from' using simdutf
+    /// @tparam From The source char type
+    /// @param from The units to validate
+    /// @return True if valid
+    template<meta::CharType From>
+    bool simdutf_validate(std::span<const From> from) noexcept
+    {
+      if constexpr (std::same_as<From, char>)
+        return simdutf::validate_ascii(from.data(), from.size());
+      if constexpr (std::same_as<From, Char8>)
+        return simdutf::validate_utf8(ptr_to<const char*>(from.data()), from.size());
+      if constexpr (std::same_as<From, Char16LE>)
+        return simdutf::validate_utf16le(
+            ptr_to<const char16_t*>(from.data()), from.size());
+      if constexpr (std::same_as<From, Char16BE>)
+        return simdutf::validate_utf16be(
+            ptr_to<const char16_t*>(from.data()), from.size());
+      if constexpr (std::same_as<From, Char32>)
+        return simdutf::validate_utf32(
+            ptr_to<const char32_t*>(from.data()), from.size());
+    }
+
+    /// @brief Returns the number of 'To' needed to encode a valid 'from'
+    /// @tparam To The destination char type
+    /// @tparam From The source char type
+    /// @param from The (valid) units
+    /// @return The number of units needed
+    template<meta::CharType To, meta::CharType From>
+      requires SimdutfTranscodable<To, From>
+    size_t simdutf_length(std::span<const From> from) noexcept
+    {
+      const auto ptr  = from.data();
+      const auto size = from.size();
+      if constexpr (sizeof(To) == sizeof(From))
+        return size;
+      else if constexpr (std::same_as<From, Char8> && sizeof(To) == 2)
+        return simdutf::utf16_length_from_utf8(ptr_to<const char*>(ptr), size);
+      else if constexpr (std::same_as<From, Char8>)
+        return simdutf::utf32_length_from_utf8(ptr_to<const char*>(ptr), size);
+      else if constexpr (std::same_as<From, Char16LE> && std::same_as<To, Char8>)
+        return simdutf::utf8_length_from_utf16le(
+            ptr_to<const char16_t*>(ptr), size);
+      else if constexpr (std::same_as<From, Char16BE> && std::same_as<To, Char8>)
+        return simdutf::utf8_length_from_utf16be(
+            ptr_to<const char16_t*>(ptr), size);
+      else if constexpr (std::same_as<From, Char16LE>)
+        return simdutf::utf32_length_from_utf16le(
+            ptr_to<const char16_t*>(ptr), size);
+      else if constexpr (std::same_as<From, Char16BE>)
+        return simdutf::utf32_length_from_utf16be(
+            ptr_to<const char16_t*>(ptr), size);
+      else if constexpr (std::same_as<To, Char8>)
+        return simdutf::utf8_length_from_utf32(ptr_to<const char32_t*>(ptr), size);
+      else
+        return simdutf::utf16_length_from_utf32(ptr_to<const char32_t*>(ptr), size);
+    }
+
+    /// @brief Returns the maximum number of 'To' needed to encode 'count' 'From'.
+    /// If the output has at least that capacity, no size query is needed.
+    /// @tparam To The destination char type
+    /// @tparam From The source char type
+    /// @param count The number of 'From'
+    /// @return The worst case number of 'To'
+    template<meta::CharType To, meta::CharType From>
+    constexpr size_t transcode_worst_case(size_t count) noexcept
+    {
+      // UTF16 -> UTF8: a single unit (BMP) may need 3 bytes.
+      // UTF32 -> UTF8: 4 bytes, UTF32 -> UTF16: 2 units.
+      if constexpr (sizeof(From) == 2 && sizeof(To) == 1)
+        return count * 3;
+      else if constexpr (sizeof(From) == 4)
+        return count * (Char8::max_sequence / sizeof(To));
+      else
+        return count;
+    }
+
+    /// @brief Converts a (valid) 'from' using simdutf.
+    /// 'to' must have enough space.
+    /// @tparam To The destination char type
+    /// @tparam From The source char type
+    /// @param from The units to convert
+    /// @param to The result
+    /// @return The number of units written
+    template<meta::CharType To, meta::CharType From>
+      requires SimdutfTranscodable<To, From>
+    size_t simdutf_convert_valid(std::span<const From> from, To* to) noexcept
+    {
+      const auto ptr  = from.data();
+      const auto size = from.size();
+      if constexpr (sizeof(From) == sizeof(To) && sizeof(From) == 2)
+      {
+        if constexpr (std::same_as<From, To>)
+          std::memcpy(to, ptr, size * sizeof(From));
+        else
+          simdutf::change_endianness_utf16(
+              ptr_to<const char16_t*>(ptr), size, ptr_to<char16_t*>(to));
+        return size;
+      }
+      else if constexpr (sizeof(From) == sizeof(To))
+      {
+        // ASCII <-> UTF8 or identity
+        std::memcpy(to, ptr, size * sizeof(From));
+        return size;
+      }
+      else if constexpr (std::same_as<From, Char8> && std::same_as<To, Char16LE>)
+        return simdutf::convert_valid_utf8_to_utf16le(
+            ptr_to<const char*>(ptr), size, ptr_to<char16_t*>(to));
+      else if constexpr (std::same_as<From, Char8> && std::same_as<To, Char16BE>)
+        return simdutf::convert_valid_utf8_to_utf16be(
+            ptr_to<const char*>(ptr), size, ptr_to<char16_t*>(to));
+      else if constexpr (std::same_as<From, Char8> && std::same_as<To, Char32>)
+        return simdutf::convert_valid_utf8_to_utf32(
+            ptr_to<const char*>(ptr), size, ptr_to<char32_t*>(to));
+      else if constexpr (std::same_as<From, Char16LE> && std::same_as<To, Char8>)
+        return simdutf::convert_valid_utf16le_to_utf8(
+            ptr_to<const char16_t*>(ptr), size, ptr_to<char*>(to));
+      else if constexpr (std::same_as<From, Char16BE> && std::same_as<To, Char8>)
+        return simdutf::convert_valid_utf16be_to_utf8(
+            ptr_to<const char16_t*>(ptr), size, ptr_to<char*>(to));
+      else if constexpr (std::same_as<From, Char16LE> && std::same_as<To, Char32>)
+        return simdutf::convert_valid_utf16le_to_utf32(
+            ptr_to<const char16_t*>(ptr), size, ptr_to<char32_t*>(to));
+      else if constexpr (std::same_as<From, Char16BE> && std::same_as<To, Char32>)
+        return simdutf::convert_valid_utf16be_to_utf32(
+            ptr_to<const char16_t*>(ptr), size, ptr_to<char32_t*>(to));
+      else if constexpr (std::same_as<From, Char32> && std::same_as<To, Char8>)
+        return simdutf::convert_valid_utf32_to_utf8(
+            ptr_to<const char32_t*>(ptr), size, ptr_to<char*>(to));
+      else if constexpr (std::same_as<From, Char32> && std::same_as<To, Char16LE>)
+        return simdutf::convert_valid_utf32_to_utf16le(
+            ptr_to<const char32_t*>(ptr), size, ptr_to<char16_t*>(to));
+      else if constexpr (std::same_as<From, Char32> && std::same_as<To, Char16BE>)
+        return simdutf::convert_valid_utf32_to_utf16be(
+            ptr_to<const char32_t*>(ptr), size, ptr_to<char16_t*>(to));
+    }
+
+    /// @brief Converts and validates 'from' in a single pass using simdutf.
+    /// 'to' must have a capacity of at least 'transcode_worst_case'.
+    /// @tparam To The destination char type
+    /// @tparam From The source char type
+    /// @param from The units to convert
+    /// @param to The result
+    /// @return The number of units written or INVALID_INPUT
+    template<meta::CharType To, meta::CharType From>
+      requires SimdutfTranscodable<To, From>
+    Expect<size_t, ConvError> simdutf_convert(
+        std::span<const From> from, To* to) noexcept
+    {
+      if constexpr (sizeof(From) == sizeof(To))
+      {
+        // No single pass kernels exist for these pairs
+        if (!simdutf_validate(from))
+          return {Error, ConvError::INVALID_INPUT};
+        return simdutf_convert_valid(from, to);
+      }
+      else
+      {
+        const auto ptr  = from.data();
+        const auto size = from.size();
+        simdutf::result res;
+        if constexpr (std::same_as<From, Char8> && std::same_as<To, Char16LE>)
+          res = simdutf::convert_utf8_to_utf16le_with_errors(
+              ptr_to<const char*>(ptr), size, ptr_to<char16_t*>(to));
+        else if constexpr (std::same_as<From, Char8> && std::same_as<To, Char16BE>)
+          res = simdutf::convert_utf8_to_utf16be_with_errors(
+              ptr_to<const char*>(ptr), size, ptr_to<char16_t*>(to));
+        else if constexpr (std::same_as<From, Char8> && std::same_as<To, Char32>)
+          res = simdutf::convert_utf8_to_utf32_with_errors(
+              ptr_to<const char*>(ptr), size, ptr_to<char32_t*>(to));
+        else if constexpr (std::same_as<From, Char16LE> && std::same_as<To, Char8>)
+          res = simdutf::convert_utf16le_to_utf8_with_errors(
+              ptr_to<const char16_t*>(ptr), size, ptr_to<char*>(to));
+        else if constexpr (std::same_as<From, Char16BE> && std::same_as<To, Char8>)
+          res = simdutf::convert_utf16be_to_utf8_with_errors(
+              ptr_to<const char16_t*>(ptr), size, ptr_to<char*>(to));
+        else if constexpr (std::same_as<From, Char16LE> && std::same_as<To, Char32>)
+          res = simdutf::convert_utf16le_to_utf32_with_errors(
+              ptr_to<const char16_t*>(ptr), size, ptr_to<char32_t*>(to));
+        else if constexpr (std::same_as<From, Char16BE> && std::same_as<To, Char32>)
+          res = simdutf::convert_utf16be_to_utf32_with_errors(
+              ptr_to<const char16_t*>(ptr), size, ptr_to<char32_t*>(to));
+        else if constexpr (std::same_as<From, Char32> && std::same_as<To, Char8>)
+          res = simdutf::convert_utf32_to_utf8_with_errors(
+              ptr_to<const char32_t*>(ptr), size, ptr_to<char*>(to));
+        else if constexpr (std::same_as<From, Char32> && std::same_as<To, Char16LE>)
+          res = simdutf::convert_utf32_to_utf16le_with_errors(
+              ptr_to<const char32_t*>(ptr), size, ptr_to<char16_t*>(to));
+        else if constexpr (std::same_as<From, Char32> && std::same_as<To, Char16BE>)
+          res = simdutf::convert_utf32_to_utf16be_with_errors(
+              ptr_to<const char32_t*>(ptr), size, ptr_to<char16_t*>(to));
+        if (res.error != simdutf::error_code::SUCCESS)
+          return {Error, ConvError::INVALID_INPUT};
+        return res.count;
+      }
+    }
+
+    /// @brief The count of non-host UTF32 swapped at once to host UTF32
+    inline constexpr size_t SWAP_CHUNK = 512;
+
+    /// @brief Byteswaps UTF32 units to the other endianness
+    /// @tparam To The destination char type
+    /// @tparam From The source char type
+    /// @param from The units to swap
+    /// @param to The result (of the same size, may be equal to 'from')
+    template<meta::CharType To, meta::CharType From>
+      requires(sizeof(To) == 4) && (sizeof(From) == 4)
+    void swap_utf32(std::span<const From> from, To* to) noexcept
+    {
+      // The source endianness does not matter: only that both differ
+      convert_endian(
+          View<u32>{ptr_to<const u32*>(from.data()), from.size()},
+          Span<u32>{ptr_to<u32*>(to), from.size()}, TargetEndian::big,
+          TargetEndian::little);
+    }
+
+    /// @brief 'transcode_size' from non-host UTF32: chunks of 'from' are
+    /// swapped to host UTF32 (as UTF32 units are independent, each chunk
+    /// can be measured separately).
+    /// @tparam To The destination char type
+    /// @param from The units to convert
+    /// @return The number of units or INVALID_INPUT
+    template<meta::CharType To>
+    Expect<size_t, ConvError> transcode_size_swapped(
+        std::span<const Char32Other> from) noexcept
+    {
+      using ToHost = std::conditional_t<std::same_as<To, Char32Other>, Char32, To>;
+      Char32 buffer[SWAP_CHUNK];
+      size_t result = 0;
+      while (!from.empty())
+      {
+        const auto chunk = from.first(std::min(from.size(), SWAP_CHUNK));
+        from             = from.subspan(chunk.size());
+        swap_utf32(chunk, buffer);
+        auto size = transcode_size<ToHost>(View<Char32>{buffer, chunk.size()});
+        if (size.is_error())
+          return size;
+        result += *size;
+      }
+      return result;
+    }
+
+    /// @brief 'transcode' to non-host UTF32: converts to host UTF32 then
+    /// byteswaps the written units in place.
+    /// @tparam From The source char type
+    /// @param from The units to convert
+    /// @param to The buffer where to write
+    /// @return The number of units written, INVALID_INPUT or NOT_ENOUGH_SPACE
+    template<meta::CharType From>
+      requires(!std::same_as<From, Char32Other>)
+    Expect<size_t, ConvError> transcode_to_swapped(
+        std::span<const From> from, Span<Char32Other> to) noexcept
+    {
+      auto host = ptr_to<Char32*>(to.data());
+      auto size = transcode<Char32>(from, Span<Char32>{host, to.size()});
+      if (size.is_expect())
+        bswap_span(Span<u32>{ptr_to<u32*>(host), *size});
+      return size;
+    }
+
+    /// @brief 'transcode' from non-host UTF32: chunks of 'from' are
+    /// swapped to host UTF32 and converted one after the other.
+    /// @tparam To The destination char type
+    /// @param from The units to convert
+    /// @param to The buffer where to write
+    /// @return The number of units written, INVALID_INPUT or NOT_ENOUGH_SPACE
+    template<meta::CharType To>
+    Expect<size_t, ConvError> transcode_swapped(
+        std::span<const Char32Other> from, Span<To> to) noexcept
+    {
+      if constexpr (std::same_as<To, Char32Other>)
+      {
+        // Validating needs host UTF32, but the output can be copied as is.
+        if (to.size() < from.size())
+          return {Error, ConvError::NOT_ENOUGH_SPACE};
+        auto host = ptr_to<Char32*>(to.data());
+        swap_utf32(from, host);
+        const bool valid = simdutf::validate_utf32(
+            ptr_to<const char32_t*>(host), from.size());
+        if (!valid)
+          return {Error, ConvError::INVALID_INPUT};
+        bswap_span(Span<u32>{ptr_to<u32*>(host), from.size()});
+        return from.size();
+      }
+      else
+      {
+        Char32 buffer[SWAP_CHUNK];
+        size_t written = 0;
+        while (!from.empty())
+        {
+          const auto chunk = from.first(std::min(from.size(), SWAP_CHUNK));
+          from             = from.subspan(chunk.size());
+          swap_utf32(chunk, buffer);
+          auto size = transcode<To>(
+              View<Char32>{buffer, chunk.size()}, to.subspan(written));
+          if (size.is_error())
+            return size;
+          written += *size;
+        }
+        return written;
+      }
+    }
+  } // namespace details
+
+  template<meta::CharType To, meta::CharType From>
+  constexpr Expect<size_t, ConvError> transcode_size(
+      std::span<const From> from) noexcept
+  {
+    COLT_TRACE_SCOPE("uni::transcode_size");
+    if (std::is_constant_evaluated())
+      return details::transcode_size_default<To>(from);
+    else if constexpr (details::SimdutfTranscodable<To, From>)
+    {
+      if (!details::simdutf_validate(from))
+        return {Error, ConvError::INVALID_INPUT};
+      // ASCII is a subset of UTF8: UTF8 -> ASCII needs ASCII input.
+      if constexpr (std::same_as<To, char> && !std::same_as<From, char>)
+      {
+        if (!simdutf::validate_ascii(ptr_to<const char*>(from.data()), from.size()))
+          return {Error, ConvError::INVALID_INPUT};
+      }
+      return details::simdutf_length<To>(from);
+    }
+    else if constexpr (std::same_as<From, Char32Other>)
+      return details::transcode_size_swapped<To>(from);
+    else if constexpr (std::same_as<To, Char32Other>)
+      return transcode_size<Char32>(from);
+    else
+      return details::transcode_size_default<To>(from);
+  }
+
+  template<meta::CharType To, meta::CharType From>
+  constexpr Expect<size_t, ConvError> transcode(
+      std::span<const From> from, Span<To> to) noexcept
+  {
+    COLT_TRACE_SCOPE("uni::transcode");
+    if (std::is_constant_evaluated())
+      return details::transcode_default(from, to);
+    else if constexpr (details::SimdutfTranscodable<To, From>)
+    {
+      if constexpr (std::same_as<To, char> && !std::same_as<From, char>)
+      {
+        if (!simdutf::validate_ascii(ptr_to<const char*>(from.data()), from.size()))
+          return {Error, ConvError::INVALID_INPUT};
+      }
+      // Fast path: the output is big enough for any input,
+      // so validation and conversion can be done in a single pass.
+      if (to.size() >= details::transcode_worst_case<To, From>(from.size()))
+        return details::simdutf_convert(from, to.data());
+
+      auto size = transcode_size<To>(from);
+      if (size.is_error())
+        return size;
+      if (*size > to.size())
+        return {Error, ConvError::NOT_ENOUGH_SPACE};
+      return details::simdutf_convert_valid(from, to.data());
+    }
+    else if constexpr (std::same_as<From, Char32Other>)
+      return details::transcode_swapped(from, to);
+    else if constexpr (std::same_as<To, Char32Other>)
+      return details::transcode_to_swapped(from, to);
+    else
+      return details::transcode_default(from, to);
+  }
+} // namespace clt::uni
+
+#endif // !HG_UNI_TRANSCODE
@@ -8,6 +8,7 @@
 #include "unicode.h"
 #include "colt/num/math.h"
 #include "colt/algo/detect_simd.h"
+#include "properties.h"
 
 #pragma region // DEFAULT: len8 len16[BL]E
 
@@ -75,6 +76,511 @@ static size_t unitlen32default(const char32_t* ptr) noexcept
 
 #pragma endregion
 
+#pragma region // DEFAULT: find8 find16 find32 find_any8
+
+static const char8_t* find8default(
+    const char8_t* begin, const char8_t* end, char8_t unit) noexcept
+{
+  while (begin != end)
+  {
+    if (*begin == unit)
+      return begin;
+    ++begin;
+  }
+  return end;
+}
+
+static const char16_t* find16default(
+    const char16_t* begin, const char16_t* end, char16_t unit) noexcept
+{
+  while (begin != end)
+  {
+    if (*begin == unit)
+      return begin;
+    ++begin;
+  }
+  return end;
+}
+
+static const char32_t* find32default(
+    const char32_t* begin, const char32_t* end, char32_t unit) noexcept
+{
+  while (begin != end)
+  {
+    if (*begin == unit)
+      return begin;
+    ++begin;
+  }
+  return end;
+}
+
+static const char8_t* find_any8default(
+    const char8_t* begin, const char8_t* end, const char8_t* units,
+    size_t count) noexcept
+{
+  while (begin != end)
+  {
+    for (size_t i = 0; i < count; i++)
+      if (*begin == units[i])
+        return begin;
+    ++begin;
+  }
+  return end;
+}
+
+#pragma endregion
+
+#pragma region // DEFAULT: validate8 validate16[BL]E
+
+/// @brief Validates the UTF8 sequences starting before 'stop'.
+/// @param ptr The start of the sequences (advanced)
+/// @param stop The pointer after which no sequence should start
+/// @param end The end of the input (a sequence may not go past it)
+/// @param len The code point count (incremented)
+/// @return True if valid
+static bool validate8range(
+    const char8_t*& ptr, const char8_t* stop, const char8_t* end,
+    size_t& len) noexcept
+{
+  auto from      = clt::ptr_to<const clt::Char8*>(ptr);
+  const auto max = clt::ptr_to<const clt::Char8*>(end);
+  char32_t cp;
+  while (from < clt::ptr_to<const clt::Char8*>(stop))
+  {
+    if (!clt::uni::details::checked_decode(from, max, cp))
+      return false;
+    ++len;
+  }
+  ptr = clt::ptr_to<const char8_t*>(from);
+  return true;
+}
+
+/// @brief Validates the UTF16 sequences starting before 'stop'.
+/// @tparam SWAP If true, the units are byteswapped
+/// @param ptr The start of the sequences (advanced)
+/// @param stop The pointer after which no sequence should start
+/// @param end The end of the input (a sequence may not go past it)
+/// @param len The code point count (incremented)
+/// @return True if valid
+template<bool SWAP>
+static bool validate16range(
+    const char16_t*& ptr, const char16_t* stop, const char16_t* end,
+    size_t& len) noexcept
+{
+  while (ptr < stop)
+  {
+    const char16_t first = SWAP ? clt::byteswap(*ptr) : *ptr;
+    if (clt::uni::is_trail_surrogate(first))
+      return false;
+    if (clt::uni::is_lead_surrogate(first))
+    {
+      if (end - ptr < 2)
+        return false;
+      const char16_t second = SWAP ? clt::byteswap(ptr[1]) : ptr[1];
+      if (!clt::uni::is_trail_surrogate(second))
+        return false;
+      ++ptr;
+    }
+    ++ptr;
+    ++len;
+  }
+  return true;
+}
+
+static clt::Option<clt::uni::LenInfo> validate8default(
+    const char8_t* ptr, size_t size) noexcept
+{
+  size_t len = 0;
+  if (!validate8range(ptr, ptr + size, ptr + size, len))
+    return clt::None;
+  return clt::uni::LenInfo{len, size};
+}
+
+template<bool SWAP>
+static clt::Option<clt::uni::LenInfo> validate16default(
+    const char16_t* ptr, size_t size) noexcept
+{
+  size_t len = 0;
+  if (!validate16range<SWAP>(ptr, ptr + size, ptr + size, len))
+    return clt::None;
+  return clt::uni::LenInfo{len, size};
+}
+
+#pragma endregion
+
+#pragma region // DEFAULT: count_and_middle8 count_and_middle16[BL]E
+
+// The middle is the offset of the code point with index 'middle_index'.
+// All versions count the code points of both halves in a single pass,
+// then move from the middle unit to that code point.
+
+/// @brief Returns the index of the middle code point.
+/// This matches the adjustment done by the scalar 'uni::count_and_middle'.
+/// @param count The number of code points
+/// @param lhs The number of code points starting before the middle unit
+/// @return The index of the middle code point
+static size_t middle_index(size_t count, size_t lhs) noexcept
+{
+  const size_t half = count / 2;
+  size_t index      = lhs;
+  if (lhs < half)
+    index = half;
+  else if (count - lhs < half)
+    index = count - half;
+  if (count % 2 == 0 && count != 0)
+    --index;
+  return index;
+}
+
+/// @brief Returns the index of the 'n'th (starting at 0) set bit of 'mask'
+/// @tparam T The unsigned integer type
+/// @param mask The mask (must contain more than 'n' set bits)
+/// @param n The number of set bits to skip
+/// @return The index of the set bit
+template<typename T>
+static size_t nth_set_bit(T mask, size_t n) noexcept
+{
+  for (; n != 0; --n)
+    mask &= mask - 1;
+  return (size_t)std::countr_zero(mask);
+}
+
+/// @brief Check if a UTF16 unit is not a trail surrogate
+/// @tparam SWAP If true, the unit is byteswapped
+/// @param unit The unit to check
+/// @return True if 'unit' starts a code point
+template<bool SWAP>
+static bool is_lead16(char16_t unit) noexcept
+{
+  return !clt::uni::is_trail_surrogate(SWAP ? clt::byteswap(unit) : unit);
+}
+
+/// @brief Counts the code points starting in [ptr, end)
+/// @param ptr The start of the range
+/// @param end The end of the range
+/// @return The number of non-trail bytes
+static size_t count8range(const char8_t* ptr, const char8_t* end) noexcept
+{
+  size_t len = 0;
+  for (; ptr < end; ++ptr)
+    len += (size_t)(!clt::uni::is_trail(*ptr));
+  return len;
+}
+
+/// @brief Counts the code points starting in [ptr, end)
+/// @tparam SWAP If true, the units are byteswapped
+/// @param ptr The start of the range
+/// @param end The end of the range
+/// @return The number of non-trail surrogate units
+template<bool SWAP>
+static size_t count16range(const char16_t* ptr, const char16_t* end) noexcept
+{
+  size_t len = 0;
+  for (; ptr < end; ++ptr)
+    len += (size_t)is_lead16<SWAP>(*ptr);
+  return len;
+}
+
+/// @brief Returns the start of the code point of index 'target'.
+/// @param ptr The pointer from which to search
+/// @param end The end of the range
+/// @param index The number of code points starting before 'ptr'
+/// @param target The index of the code point (index <= target)
+/// @return Pointer to the start of the code point or 'end'
+static const char8_t* seek8range(
+    const char8_t* ptr, const char8_t* end, size_t index, size_t target) noexcept
+{
+  for (; ptr < end; ++ptr)
+  {
+    if (clt::uni::is_trail(*ptr))
+      continue;
+    if (index == target)
+      return ptr;
+    ++index;
+  }
+  return end;
+}
+
+/// @brief Returns the start of the code point of index 'target'.
+/// @tparam SWAP If true, the units are byteswapped
+/// @param ptr The pointer from which to search
+/// @param end The end of the range
+/// @param index The number of code points starting before 'ptr'
+/// @param target The index of the code point (index <= target)
+/// @return Pointer to the start of the code point or 'end'
+template<bool SWAP>
+static const char16_t* seek16range(
+    const char16_t* ptr, const char16_t* end, size_t index, size_t target) noexcept
+{
+  for (; ptr < end; ++ptr)
+  {
+    if (!is_lead16<SWAP>(*ptr))
+      continue;
+    if (index == target)
+      return ptr;
+    ++index;
+  }
+  return end;
+}
+
+static std::pair<size_t, size_t> count_and_middle8default(
+    const char8_t* ptr, size_t size) noexcept
+{
+  const auto end      = ptr + size;
+  auto middle         = ptr + size / 2;
+  size_t index        = count8range(ptr, middle);
+  const size_t count  = index + count8range(middle, end);
+  const size_t target = middle_index(count, index);
+  while (index > target)
+    index -= (size_t)(!clt::uni::is_trail(*--middle));
+  return {count, seek8range(middle, end, index, target) - ptr};
+}
+
+template<bool SWAP>
+static std::pair<size_t, size_t> count_and_middle16default(
+    const char16_t* ptr, size_t size) noexcept
+{
+  const auto end      = ptr + size;
+  auto middle         = ptr + size / 2;
+  size_t index        = count16range<SWAP>(ptr, middle);
+  const size_t count  = index + count16range<SWAP>(middle, end);
+  const size_t target = middle_index(count, index);
+  while (index > target)
+    index -= (size_t)is_lead16<SWAP>(*--middle);
+  return {count, seek16range<SWAP>(middle, end, index, target) - ptr};
+}
+
+#pragma endregion
+
+#pragma region // DEFAULT: skip_class8
+
+/// @brief Nibble lookup tables classifying ASCII characters.
+/// A byte is part of the class if (lo[byte & 0xF] & hi[byte >> 4]) != 0.
+/// Each distinct row (set of low nibbles of a high nibble) is assigned
+/// a bit: as ASCII only has 8 high nibbles, any class fits in 8 bits.
+/// As the high nibble of non-ASCII bytes maps to 0, they are never matched.
+struct NibbleTable
+{
+  /// @brief The table indexed by the low nibble
+  u8 lo[16];
+  /// @brief The table indexed by the high nibble
+  u8 hi[16];
+};
+
+/// @brief Computes the nibble lookup tables of a class of characters
+/// @param cls The class of character
+/// @return The nibble lookup tables
+static constexpr NibbleTable make_nibble_table(clt::CharClass cls) noexcept
+{
+  NibbleTable table{};
+  u16 rows[8] = {};
+  u8 next_bit = 0;
+  for (u8 hi = 0; hi < 8; hi++)
+  {
+    u16 row = 0;
+    for (u8 lo = 0; lo < 16; lo++)
+      row |= (u16)clt::is_of_class((char)((hi << 4) | lo), cls) << lo;
+    if (row == 0)
+      continue;
+    // Reuse the bit of an identical row
+    u8 bit = next_bit;
+    for (u8 i = 0; i < next_bit; i++)
+      if (rows[i] == row)
+        bit = i;
+    if (bit == next_bit)
+      rows[next_bit++] = row;
+    table.hi[hi] = (u8)(1 << bit);
+    for (u8 lo = 0; lo < 16; lo++)
+      if (row & (1 << lo))
+        table.lo[lo] |= (u8)(1 << bit);
+  }
+  return table;
+}
+
+/// @brief The nibble lookup tables of each CharClass
+static constexpr auto NIBBLE_TABLES = []() constexpr
+{
+  std::array<NibbleTable, clt::CHAR_CLASS_COUNT> tables{};
+  for (size_t i = 0; i < tables.size(); i++)
+    tables[i] = make_nibble_table(static_cast<clt::CharClass>(i));
+  return tables;
+}();
+
+static const char* skip_class8default(
+    const char* begin, const char* end, const NibbleTable& table) noexcept
+{
+  while (begin != end)
+  {
+    const u8 unit = static_cast<u8>(*begin);
+    if ((table.lo[unit & 0xF] & table.hi[unit >> 4]) == 0)
+      return begin;
+    ++begin;
+  }
+  return end;
+}
+
+/// @brief Classifies a non-ASCII code point using the property tables
+/// @param cp The code point to classify
+/// @param cls The class of character
+/// @return True if the code point is of class 'cls'
+static bool is_of_class32(char32_t cp, clt::CharClass cls) noexcept
+{
+  using namespace clt::uni;
+  using enum clt::CharClass;
+
+  switch_no_default(cls)
+  {
+  case CNTRL:
+    return get<General_Category>(cp) == General_Category::Cc;
+  case DIGIT:
+    return get<General_Category>(cp) == General_Category::Nd;
+  case LOWER:
+    return has<Lowercase>(cp);
+  case UPPER:
+    return has<Uppercase>(cp);
+  case ALPHA:
+    return has<Alphabetic>(cp);
+  case ALNUM:
+    return has<Alphabetic>(cp)
+           || get<General_Category>(cp) == General_Category::Nd;
+  case PUNCT:
+    return is_General_Category_P(get<General_Category>(cp));
+  case GRAPH:
+    return !is_General_Category_C(get<General_Category>(cp))
+           && !is_General_Category_Z(get<General_Category>(cp));
+  case SPACE:
+    return has<White_Space>(cp);
+  case BLANK:
+    return get<General_Category>(cp) == General_Category::Zs;
+  case IDENT_START:
+    return has<XID_Start>(cp);
+  case IDENT_CONTINUE:
+    return has<XID_Continue>(cp);
+  case ASCII:
+    return false;
+  }
+}
+
+#pragma endregion
+
+#pragma region // DEFAULT: casefold_prefix8 casefold8
+
+static size_t casefold_prefix8default(
+    const char* a, const char* b, size_t size) noexcept
+{
+  size_t i = 0;
+  for (; i != size; ++i)
+  {
+    if (static_cast<u8>(a[i] | b[i]) > 0x7F
+        || clt::tolower(a[i]) != clt::tolower(b[i]))
+      break;
+  }
+  return i;
+}
+
+static size_t casefold8default(const char* from, size_t size, char* to) noexcept
+{
+  size_t i = 0;
+  for (; i != size && static_cast<u8>(from[i]) < 0x80; ++i)
+    to[i] = clt::tolower(from[i]);
+  return i;
+}
+
+#pragma endregion
+
+#pragma region // DEFAULT: find_ge8
+
+static const char8_t* find_ge8default(
+    const char8_t* begin, const char8_t* end, char8_t unit) noexcept
+{
+  while (begin != end)
+  {
+    if (*begin >= unit)
+      return begin;
+    ++begin;
+  }
+  return end;
+}
+
+#pragma endregion
+
+#pragma region // DEFAULT: find_nonprint8
+
+static const char8_t* find_nonprint8default(
+    const char8_t* begin, const char8_t* end) noexcept
+{
+  while (begin != end)
+  {
+    if (*begin < 0x20 || *begin > 0x7E)
+      return begin;
+    ++begin;
+  }
+  return end;
+}
+
+#pragma endregion
+
+#pragma region // DEFAULT: utf16_len8 utf16_offset8
+
+// The UTF16 units of a code point are attributed to its first byte:
+// 1 for each non-trail byte, plus 1 for each byte starting a 4 bytes
+// sequence (which is encoded as a surrogate pair).
+
+/// @brief Returns the count of UTF16 units of the code point starting at 'unit'
+/// @param unit The byte
+/// @return 0 for trail bytes, 2 for bytes starting a 4 bytes sequence, else 1
+static size_t utf16_units8(char8_t unit) noexcept
+{
+  return (size_t)(!clt::uni::is_trail(unit)) + (size_t)(unit >= 0xF0);
+}
+
+/// @brief Counts the UTF16 units of the code points starting in [ptr, end)
+/// @param ptr The start of the range
+/// @param end The end of the range
+/// @return The number of UTF16 units
+static size_t utf16_count8range(const char8_t* ptr, const char8_t* end) noexcept
+{
+  size_t len = 0;
+  for (; ptr < end; ++ptr)
+    len += utf16_units8(*ptr);
+  return len;
+}
+
+/// @brief Returns the start of the code point whose UTF16 units contain
+///        the UTF16 unit of index 'target'.
+/// @param ptr The pointer from which to search
+/// @param end The end of the range
+/// @param index The number of UTF16 units before 'ptr'
+/// @param target The index of the UTF16 unit (index <= target)
+/// @return Pointer to the start of the code point or 'end'
+static const char8_t* utf16_seek8range(
+    const char8_t* ptr, const char8_t* end, size_t index, size_t target) noexcept
+{
+  for (; ptr < end; ++ptr)
+  {
+    const size_t units = utf16_units8(*ptr);
+    if (units == 0)
+      continue;
+    if (index + units > target)
+      return ptr;
+    index += units;
+  }
+  return end;
+}
+
+static size_t utf16_len8default(const char8_t* ptr, size_t size) noexcept
+{
+  return utf16_count8range(ptr, ptr + size);
+}
+
+static size_t utf16_offset8default(
+    const char8_t* ptr, size_t size, size_t target) noexcept
+{
+  return utf16_seek8range(ptr, ptr + size, 0, target) - ptr;
+}
+
+#pragma endregion
+
 #if defined(COLT_x86_64)
 
   #pragma region // len8 SSE2, AVX2, AXV512BW
@@ -542,108 +1048,1510 @@ static COLT_FORCE_AVX512F size_t unitlen32AVX512F(const char32_t* ptr) noexcept
 }
   #pragma endregion
 
-#elif defined(COLT_ARM_7or8)
+  #pragma region // find8 find16 find32 find_any8 SSE2
 
-// See link below for vshrn
-// https://community.arm.com/arm-community-blogs/b/infrastructure-solutions-blog/posts/porting-x86-vector-bitmask-optimizations-to-arm-neon
+// The find kernels operate on bounded ranges, so unaligned loads
+// are used and the remaining units are handled by the default version.
 
-  #pragma region // unitlen16 NEON
-static COLT_FORCE_NEON size_t unitlen16NEON(const char16_t* ptr) noexcept
+static COLT_FORCE_SSE2 const char8_t* find8SSE2(
+    const char8_t* begin, const char8_t* end, char8_t unit) noexcept
 {
-  const auto copy = ptr;
-  while (uintptr_t(ptr) % alignof(uint16x8_t) != 0)
+  const __m128i needle      = _mm_set1_epi8((char)unit);
+  constexpr auto PACK_COUNT = sizeof(__m128i) / sizeof(u8);
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
   {
-    if (*ptr == 0)
-      return ptr - copy;
-    ++ptr;
+    __m128i values    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    __m128i cmp       = _mm_cmpeq_epi8(values, needle);
+    unsigned int mask = _mm_movemask_epi8(cmp);
+    if (mask != 0)
+      return begin + std::countr_zero(mask);
+    begin += PACK_COUNT;
   }
+  return find8default(begin, end, unit);
+}
 
-  // Zero mask
-  const uint16x8_t zero     = vdupq_n_u16(0);
-  constexpr auto PACK_COUNT = sizeof(uint16x8_t) / sizeof(u16);
-  u64 mask;
-  while (true)
+static COLT_FORCE_SSE2 const char16_t* find16SSE2(
+    const char16_t* begin, const char16_t* end, char16_t unit) noexcept
+{
+  const __m128i needle      = _mm_set1_epi16((short)unit);
+  constexpr auto PACK_COUNT = sizeof(__m128i) / sizeof(u16);
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
   {
-    uint16x8_t values   = vld1q_u16(reinterpret_cast<const u16*>(ptr));
-    uint16x8_t cmp      = vceqq_u16(values, zero);
-    const uint8x8_t res = vshrn_n_u16(cmp, 8);
-    mask                = vget_lane_u64(vreinterpret_u64_u8(res), 0);
+    __m128i values    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    __m128i cmp       = _mm_cmpeq_epi16(values, needle);
+    unsigned int mask = _mm_movemask_epi8(cmp);
     if (mask != 0)
-      break;
-    ptr += PACK_COUNT;
+      return begin + std::countr_zero(mask) / 2;
+    begin += PACK_COUNT;
   }
-  return (ptr - copy) + std::countr_zero(mask) / 8;
+  return find16default(begin, end, unit);
 }
-  #pragma endregion
 
-  #pragma region // unitlen32 NEON
-static COLT_FORCE_NEON size_t unitlen32NEON(const char32_t* ptr) noexcept
+static COLT_FORCE_SSE2 const char32_t* find32SSE2(
+    const char32_t* begin, const char32_t* end, char32_t unit) noexcept
 {
-  const auto copy = ptr;
-  while (uintptr_t(ptr) % alignof(uint32x4_t) != 0)
+  const __m128i needle      = _mm_set1_epi32((int)unit);
+  constexpr auto PACK_COUNT = sizeof(__m128i) / sizeof(u32);
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
   {
-    if (*ptr == 0)
-      return ptr - copy;
-    ++ptr;
+    __m128i values    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    __m128i cmp       = _mm_cmpeq_epi32(values, needle);
+    unsigned int mask = _mm_movemask_epi8(cmp);
+    if (mask != 0)
+      return begin + std::countr_zero(mask) / 4;
+    begin += PACK_COUNT;
   }
+  return find32default(begin, end, unit);
+}
 
-  // Zero mask
-  const uint32x4_t zero     = vdupq_n_u32(0);
-  constexpr auto PACK_COUNT = sizeof(uint32x4_t) / sizeof(u32);
-  u64 mask;
-  while (true)
+static COLT_FORCE_SSE2 const char8_t* find_any8SSE2(
+    const char8_t* begin, const char8_t* end, const char8_t* units,
+    size_t count) noexcept
+{
+  __m128i needles[clt::uni::details::FIND_ANY_MAX];
+  for (size_t i = 0; i < count; i++)
+    needles[i] = _mm_set1_epi8((char)units[i]);
+
+  constexpr auto PACK_COUNT = sizeof(__m128i) / sizeof(u8);
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
   {
-    uint32x4_t values    = vld1q_u32(reinterpret_cast<const u32*>(ptr));
-    uint32x4_t cmp       = vceqq_u32(values, zero);
-    const uint16x4_t res = vshrn_n_u32(cmp, 8);
-    mask                 = vget_lane_u64(vreinterpret_u64_u16(res), 0);
+    __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    __m128i cmp    = _mm_setzero_si128();
+    for (size_t i = 0; i < count; i++)
+      cmp = _mm_or_si128(cmp, _mm_cmpeq_epi8(values, needles[i]));
+    unsigned int mask = _mm_movemask_epi8(cmp);
     if (mask != 0)
-      break;
-    ptr += PACK_COUNT;
+      return begin + std::countr_zero(mask);
+    begin += PACK_COUNT;
   }
-  return (ptr - copy) + std::countr_zero(mask) / 16;
+  return find_any8default(begin, end, units, count);
 }
+
   #pragma endregion
 
-  #pragma region // len8 NEON
-static COLT_FORCE_NEON clt::uni::LenInfo len8NEON(const char8_t* ptr) noexcept
+  #pragma region // find8 find16 find32 find_any8 AVX2
+
+static COLT_FORCE_AVX2 const char8_t* find8AVX2(
+    const char8_t* begin, const char8_t* end, char8_t unit) noexcept
 {
-  const auto copy = ptr;
-  size_t len      = 0;
-  // We can't use sequence_length here as the goal is to align
-  // and most likely adding sequence_length will not align the pointer.
-  while (uintptr_t(ptr) % alignof(uint8x16_t) != 0)
+  const __m256i needle      = _mm256_set1_epi8((char)unit);
+  constexpr auto PACK_COUNT = sizeof(__m256i) / sizeof(u8);
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
   {
-    if (*ptr == '\0')
-      return {len, static_cast<size_t>(ptr - copy)};
-    len += (size_t)(!clt::uni::is_trail(*ptr));
-    ++ptr;
+    __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    __m256i cmp    = _mm256_cmpeq_epi8(values, needle);
+    unsigned int mask = _mm256_movemask_epi8(cmp);
+    if (mask != 0)
+      return begin + std::countr_zero(mask);
+    begin += PACK_COUNT;
   }
+  return find8default(begin, end, unit);
+}
 
-  // Zero mask
-  const uint8x16_t zero        = vdupq_n_u8(0);
-  const uint8x16_t trail_mask  = vdupq_n_u8((u8)0b1100'0000);
-  const uint8x16_t trail_value = vdupq_n_u8((u8)0b1000'0000);
-  constexpr auto PACK_COUNT    = sizeof(uint8x16_t) / sizeof(u8);
-  u64 mask;
-  while (true)
+static COLT_FORCE_AVX2 const char16_t* find16AVX2(
+    const char16_t* begin, const char16_t* end, char16_t unit) noexcept
+{
+  const __m256i needle      = _mm256_set1_epi16((short)unit);
+  constexpr auto PACK_COUNT = sizeof(__m256i) / sizeof(u16);
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
   {
-    uint8x16_t values   = vld1q_u8(reinterpret_cast<const u8*>(ptr));
-    uint8x16_t cmp      = vceqq_u8(values, zero);
-    const uint8x8_t res = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
-    mask                = vget_lane_u64(vreinterpret_u64_u8(res), 0);
+    __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    __m256i cmp    = _mm256_cmpeq_epi16(values, needle);
+    unsigned int mask = _mm256_movemask_epi8(cmp);
     if (mask != 0)
-      break;
-    uint8x16_t is_trail = vandq_u8(values, trail_mask);
-    is_trail            = vceqq_u8(is_trail, trail_value);
-    len += PACK_COUNT
-           - std::popcount(vget_lane_u64(
-                 vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(is_trail), 4)),
-                 0))
-                 / 4;
-    ptr += PACK_COUNT;
+      return begin + std::countr_zero(mask) / 2;
+    begin += PACK_COUNT;
   }
-  while (true)
+  return find16default(begin, end, unit);
+}
+
+static COLT_FORCE_AVX2 const char32_t* find32AVX2(
+    const char32_t* begin, const char32_t* end, char32_t unit) noexcept
+{
+  const __m256i needle      = _mm256_set1_epi32((int)unit);
+  constexpr auto PACK_COUNT = sizeof(__m256i) / sizeof(u32);
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    __m256i cmp    = _mm256_cmpeq_epi32(values, needle);
+    unsigned int mask = _mm256_movemask_epi8(cmp);
+    if (mask != 0)
+      return begin + std::countr_zero(mask) / 4;
+    begin += PACK_COUNT;
+  }
+  return find32default(begin, end, unit);
+}
+
+static COLT_FORCE_AVX2 const char8_t* find_any8AVX2(
+    const char8_t* begin, const char8_t* end, const char8_t* units,
+    size_t count) noexcept
+{
+  __m256i needles[clt::uni::details::FIND_ANY_MAX];
+  for (size_t i = 0; i < count; i++)
+    needles[i] = _mm256_set1_epi8((char)units[i]);
+
+  constexpr auto PACK_COUNT = sizeof(__m256i) / sizeof(u8);
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    __m256i cmp    = _mm256_setzero_si256();
+    for (size_t i = 0; i < count; i++)
+      cmp = _mm256_or_si256(cmp, _mm256_cmpeq_epi8(values, needles[i]));
+    unsigned int mask = _mm256_movemask_epi8(cmp);
+    if (mask != 0)
+      return begin + std::countr_zero(mask);
+    begin += PACK_COUNT;
+  }
+  return find_any8default(begin, end, units, count);
+}
+
+  #pragma endregion
+
+  #pragma region // find8 find16 find32 find_any8 AVX512BW
+
+// As AVX512 provides masked loads (that do not fault on masked
+// elements), the tail is handled without falling back to scalar code.
+
+static COLT_FORCE_AVX512BW const char8_t* find8AVX512BW(
+    const char8_t* begin, const char8_t* end, char8_t unit) noexcept
+{
+  const __m512i needle      = _mm512_set1_epi8((char)unit);
+  constexpr auto PACK_COUNT = sizeof(__m512i) / sizeof(u8);
+  __mmask64 mask;
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    __m512i values = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(begin));
+    mask           = _mm512_cmpeq_epi8_mask(values, needle);
+    if (mask != 0)
+      return begin + std::countr_zero(mask);
+    begin += PACK_COUNT;
+  }
+  if (begin == end)
+    return end;
+  const __mmask64 load = ~0ULL >> (PACK_COUNT - (end - begin));
+  __m512i values       = _mm512_maskz_loadu_epi8(load, begin);
+  mask                 = _mm512_mask_cmpeq_epi8_mask(load, values, needle);
+  return mask != 0 ? begin + std::countr_zero(mask) : end;
+}
+
+static COLT_FORCE_AVX512BW const char16_t* find16AVX512BW(
+    const char16_t* begin, const char16_t* end, char16_t unit) noexcept
+{
+  const __m512i needle      = _mm512_set1_epi16((short)unit);
+  constexpr auto PACK_COUNT = sizeof(__m512i) / sizeof(u16);
+  __mmask32 mask;
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    __m512i values = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(begin));
+    mask           = _mm512_cmpeq_epi16_mask(values, needle);
+    if (mask != 0)
+      return begin + std::countr_zero(mask);
+    begin += PACK_COUNT;
+  }
+  if (begin == end)
+    return end;
+  const __mmask32 load = ~0U >> (PACK_COUNT - (end - begin));
+  __m512i values       = _mm512_maskz_loadu_epi16(load, begin);
+  mask                 = _mm512_mask_cmpeq_epi16_mask(load, values, needle);
+  return mask != 0 ? begin + std::countr_zero(mask) : end;
+}
+
+static COLT_FORCE_AVX512F const char32_t* find32AVX512F(
+    const char32_t* begin, const char32_t* end, char32_t unit) noexcept
+{
+  const __m512i needle      = _mm512_set1_epi32((int)unit);
+  constexpr auto PACK_COUNT = sizeof(__m512i) / sizeof(u32);
+  __mmask16 mask;
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    __m512i values = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(begin));
+    mask           = _mm512_cmpeq_epi32_mask(values, needle);
+    if (mask != 0)
+      return begin + std::countr_zero((unsigned int)mask);
+    begin += PACK_COUNT;
+  }
+  if (begin == end)
+    return end;
+  const __mmask16 load = (__mmask16)(0xFFFFU >> (PACK_COUNT - (end - begin)));
+  __m512i values       = _mm512_maskz_loadu_epi32(load, begin);
+  mask                 = _mm512_mask_cmpeq_epi32_mask(load, values, needle);
+  return mask != 0 ? begin + std::countr_zero((unsigned int)mask) : end;
+}
+
+static COLT_FORCE_AVX512BW const char8_t* find_any8AVX512BW(
+    const char8_t* begin, const char8_t* end, const char8_t* units,
+    size_t count) noexcept
+{
+  __m512i needles[clt::uni::details::FIND_ANY_MAX];
+  for (size_t i = 0; i < count; i++)
+    needles[i] = _mm512_set1_epi8((char)units[i]);
+
+  constexpr auto PACK_COUNT = sizeof(__m512i) / sizeof(u8);
+  __mmask64 mask;
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    __m512i values = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(begin));
+    mask           = 0;
+    for (size_t i = 0; i < count; i++)
+      mask |= _mm512_cmpeq_epi8_mask(values, needles[i]);
+    if (mask != 0)
+      return begin + std::countr_zero(mask);
+    begin += PACK_COUNT;
+  }
+  if (begin == end)
+    return end;
+  const __mmask64 load = ~0ULL >> (PACK_COUNT - (end - begin));
+  __m512i values       = _mm512_maskz_loadu_epi8(load, begin);
+  mask                 = 0;
+  for (size_t i = 0; i < count; i++)
+    mask |= _mm512_mask_cmpeq_epi8_mask(load, values, needles[i]);
+  return mask != 0 ? begin + std::countr_zero(mask) : end;
+}
+  #pragma endregion
+
+  #pragma region // validate8 validate16 SSE2
+
+// SSE2 does not provide byte shuffles: ASCII (or surrogate-free) blocks
+// are skipped, and the other blocks are validated by the default version.
+
+static COLT_FORCE_SSE2 clt::Option<clt::uni::LenInfo> validate8SSE2(
+    const char8_t* ptr, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m128i) / sizeof(u8);
+  const auto end            = ptr + size;
+  size_t len                = 0;
+  while (static_cast<size_t>(end - ptr) >= PACK_COUNT)
+  {
+    __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+    if (_mm_movemask_epi8(values) == 0)
+    {
+      len += PACK_COUNT;
+      ptr += PACK_COUNT;
+      continue;
+    }
+    if (!validate8range(ptr, ptr + PACK_COUNT, end, len))
+      return clt::None;
+  }
+  if (!validate8range(ptr, end, end, len))
+    return clt::None;
+  return clt::uni::LenInfo{len, size};
+}
+
+template<bool SWAP>
+static COLT_FORCE_SSE2 clt::Option<clt::uni::LenInfo> validate16SSE2(
+    const char16_t* ptr, size_t size) noexcept
+{
+  const __m128i surrogate_mask  = _mm_set1_epi16(SWAP ? (u16)0x00F8 : (u16)0xF800);
+  const __m128i surrogate_value = _mm_set1_epi16(SWAP ? (u16)0x00D8 : (u16)0xD800);
+  constexpr auto PACK_COUNT     = sizeof(__m128i) / sizeof(u16);
+  const auto end                = ptr + size;
+  size_t len                    = 0;
+  while (static_cast<size_t>(end - ptr) >= PACK_COUNT)
+  {
+    __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+    __m128i is_sur = _mm_and_si128(values, surrogate_mask);
+    is_sur         = _mm_cmpeq_epi16(is_sur, surrogate_value);
+    if (_mm_movemask_epi8(is_sur) == 0)
+    {
+      len += PACK_COUNT;
+      ptr += PACK_COUNT;
+      continue;
+    }
+    if (!validate16range<SWAP>(ptr, ptr + PACK_COUNT, end, len))
+      return clt::None;
+  }
+  if (!validate16range<SWAP>(ptr, end, end, len))
+    return clt::None;
+  return clt::uni::LenInfo{len, size};
+}
+  #pragma endregion
+
+  #pragma region // validate8 validate16 AVX2
+
+// UTF8 validation uses the lookup algorithm from:
+// "Validating UTF-8 In Less Than One Instruction Per Byte"
+// (John Keiser, Daniel Lemire), also used by simdjson and simdutf.
+// Each error is represented by a bit: the error bits of the high
+// and low nibbles of a byte and of the high nibble of the next byte
+// are looked up, and an error occurred if the 3 lookups share a bit.
+// Continuation bytes are counted in the same pass.
+// These versions are also used when AVX512BW is available.
+
+/// @brief Returns 'input' shifted right by N bytes, with the last N bytes of 'prev'
+/// @tparam N The number of bytes
+/// @param input The current input
+/// @param prev The previous input
+/// @return [prev[32 - N], prev[31], input[0], ..., input[31 - N]]
+template<int N>
+static COLT_FORCE_AVX2 __m256i prev8AVX2(__m256i input, __m256i prev) noexcept
+{
+  return _mm256_alignr_epi8(
+      input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - N);
+}
+
+/// @brief Returns a non-zero vector if the 32 bytes are not valid UTF8
+/// @param input The current input
+/// @param prev The previous input
+/// @return Non-zero on errors
+static COLT_FORCE_AVX2 __m256i check_utf8AVX2(__m256i input, __m256i prev) noexcept
+{
+  // Error bits
+  constexpr u8 TOO_SHORT  = 1 << 0; // 11______ 0_______ or 11______ 11______
+  constexpr u8 TOO_LONG   = 1 << 1; // 0_______ 10______
+  constexpr u8 OVERLONG_3 = 1 << 2; // 11100000 100_____
+  constexpr u8 TOO_LARGE  = 1 << 3; // 11110100 1001____ ...
+  constexpr u8 SURROGATE  = 1 << 4; // 11101101 101_____
+  constexpr u8 OVERLONG_2 = 1 << 5; // 1100000_ 10______
+  constexpr u8 TOO_LARGE_1000 = 1 << 6; // 11110101 1000____ ...
+  constexpr u8 OVERLONG_4     = 1 << 6; // 11110000 1000____
+  constexpr u8 TWO_CONTS      = 1 << 7; // 10______ 10______
+  constexpr u8 CARRY          = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+  // clang-format off
+  const __m256i byte_1_high_table = _mm256_setr_epi8(
+      TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+      TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+      TOO_SHORT | OVERLONG_2, TOO_SHORT, TOO_SHORT | OVERLONG_3 | SURROGATE,
+      TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,
+      TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+      TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+      TOO_SHORT | OVERLONG_2, TOO_SHORT, TOO_SHORT | OVERLONG_3 | SURROGATE,
+      TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4);
+  const __m256i byte_1_low_table = _mm256_setr_epi8(
+      CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4, CARRY | OVERLONG_2, CARRY, CARRY,
+      CARRY | TOO_LARGE, CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+      CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4, CARRY | OVERLONG_2, CARRY, CARRY,
+      CARRY | TOO_LARGE, CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000,
+      CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+      CARRY | TOO_LARGE | TOO_LARGE_1000, CARRY | TOO_LARGE | TOO_LARGE_1000);
+  const __m256i byte_2_high_table = _mm256_setr_epi8(
+      TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+      TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+      TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+      TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+      TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+      TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+      TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+      TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+      TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+      TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+      TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+      TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+      TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+      TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+  // clang-format on
+
+  const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+  const __m256i prev1      = prev8AVX2<1>(input, prev);
+  const __m256i byte_1_high = _mm256_shuffle_epi8(
+      byte_1_high_table,
+      _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble));
+  const __m256i byte_1_low = _mm256_shuffle_epi8(
+      byte_1_low_table, _mm256_and_si256(prev1, low_nibble));
+  const __m256i byte_2_high = _mm256_shuffle_epi8(
+      byte_2_high_table,
+      _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble));
+  const __m256i special =
+      _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+  // The third and fourth bytes of 3 and 4 bytes sequences must be
+  // continuations: these are the only valid TWO_CONTS.
+  const __m256i prev2 = prev8AVX2<2>(input, prev);
+  const __m256i prev3 = prev8AVX2<3>(input, prev);
+  // Only 111_____ will be >= 0x80
+  const __m256i is_third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80));
+  // Only 1111____ will be >= 0x80
+  const __m256i is_fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80));
+  const __m256i must23    = _mm256_and_si256(
+      _mm256_or_si256(is_third, is_fourth), _mm256_set1_epi8((u8)0x80));
+  return _mm256_xor_si256(must23, special);
+}
+
+static COLT_FORCE_AVX2 clt::Option<clt::uni::LenInfo> validate8AVX2(
+    const char8_t* ptr, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m256i) / sizeof(u8);
+  const auto end            = ptr + size;
+  // A sequence is incomplete if one of the last 3 bytes is a lead that
+  // requires more bytes than there are remaining in the block.
+  const __m256i max_value = _mm256_setr_epi8(
+      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (u8)(0xF0 - 1), (u8)(0xE0 - 1),
+      (u8)(0xC0 - 1));
+  // Continuation bytes are the only ones < -64 as signed integers
+  const __m256i trail_max = _mm256_set1_epi8(-64);
+
+  __m256i error           = _mm256_setzero_si256();
+  __m256i prev            = _mm256_setzero_si256();
+  __m256i prev_incomplete = _mm256_setzero_si256();
+  size_t trail_count      = 0;
+
+  // The last block is padded with NUL (which is ASCII):
+  // this also catches sequences that are truncated by 'end'.
+  alignas(__m256i) u8 last[PACK_COUNT] = {0};
+  const size_t remaining               = size % PACK_COUNT;
+  if (remaining != 0)
+    std::memcpy(last, end - remaining, remaining);
+
+  const char8_t* const last_block = end - remaining;
+  while (true)
+  {
+    const bool is_last = ptr == last_block;
+    __m256i input =
+        is_last ? _mm256_load_si256(reinterpret_cast<const __m256i*>(last))
+                : _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+    if (_mm256_movemask_epi8(input) == 0)
+    {
+      // ASCII: the previous block must not end with an incomplete sequence
+      error = _mm256_or_si256(error, prev_incomplete);
+      prev_incomplete = _mm256_setzero_si256();
+    }
+    else
+    {
+      error           = _mm256_or_si256(error, check_utf8AVX2(input, prev));
+      prev_incomplete = _mm256_subs_epu8(input, max_value);
+      trail_count += std::popcount(
+          (unsigned int)_mm256_movemask_epi8(_mm256_cmpgt_epi8(trail_max, input)));
+    }
+    prev = input;
+    if (is_last)
+      break;
+    ptr += PACK_COUNT;
+  }
+  if (!_mm256_testz_si256(error, error))
+    return clt::None;
+  return clt::uni::LenInfo{size - trail_count, size};
+}
+
+template<bool SWAP>
+static COLT_FORCE_AVX2 clt::Option<clt::uni::LenInfo> validate16AVX2(
+    const char16_t* ptr, size_t size) noexcept
+{
+  const __m256i surrogate_mask =
+      _mm256_set1_epi16(SWAP ? (u16)0x00F8 : (u16)0xF800);
+  const __m256i surrogate_value =
+      _mm256_set1_epi16(SWAP ? (u16)0x00D8 : (u16)0xD800);
+  constexpr auto PACK_COUNT = sizeof(__m256i) / sizeof(u16);
+  const auto end            = ptr + size;
+  size_t len                = 0;
+  while (static_cast<size_t>(end - ptr) >= PACK_COUNT)
+  {
+    __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+    __m256i is_sur = _mm256_and_si256(values, surrogate_mask);
+    is_sur         = _mm256_cmpeq_epi16(is_sur, surrogate_value);
+    if (_mm256_testz_si256(is_sur, is_sur))
+    {
+      len += PACK_COUNT;
+      ptr += PACK_COUNT;
+      continue;
+    }
+    if (!validate16range<SWAP>(ptr, ptr + PACK_COUNT, end, len))
+      return clt::None;
+  }
+  if (!validate16range<SWAP>(ptr, end, end, len))
+    return clt::None;
+  return clt::uni::LenInfo{len, size};
+}
+  #pragma endregion
+
+  #pragma region // count_and_middle8 count_and_middle16 SSE2
+
+/// @brief Returns the mask of the bytes that start a code point
+/// @param ptr The start of the 16 bytes
+/// @return Mask containing a set bit for each non-trail byte
+static COLT_FORCE_SSE2 u32 lead8SSE2(const char8_t* ptr) noexcept
+{
+  const __m128i trail_mask  = _mm_set1_epi8((u8)0b1100'0000);
+  const __m128i trail_value = _mm_set1_epi8((u8)0b1000'0000);
+  __m128i values   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+  __m128i is_trail = _mm_and_si128(values, trail_mask);
+  is_trail         = _mm_cmpeq_epi8(is_trail, trail_value);
+  return ~(u32)_mm_movemask_epi8(is_trail) & 0xFFFF;
+}
+
+/// @brief Returns the mask of the units that start a code point.
+/// Each unit is represented by 2 bits, of which the lowest can be set.
+/// @tparam SWAP If true, the units are byteswapped
+/// @param ptr The start of the 8 units
+/// @return Mask containing a set bit for each non-trail surrogate unit
+template<bool SWAP>
+static COLT_FORCE_SSE2 u32 lead16SSE2(const char16_t* ptr) noexcept
+{
+  const __m128i trail_mask  = _mm_set1_epi16(SWAP ? (u16)0x00FC : (u16)0xFC00);
+  const __m128i trail_value = _mm_set1_epi16(SWAP ? (u16)0x00DC : (u16)0xDC00);
+  __m128i values   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+  __m128i is_trail = _mm_and_si128(values, trail_mask);
+  is_trail         = _mm_cmpeq_epi16(is_trail, trail_value);
+  return ~(u32)_mm_movemask_epi8(is_trail) & 0x5555;
+}
+
+static COLT_FORCE_SSE2 size_t count8SSE2(
+    const char8_t* ptr, const char8_t* end) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m128i) / sizeof(u8);
+  size_t len                = 0;
+  while (static_cast<size_t>(end - ptr) >= PACK_COUNT)
+  {
+    len += std::popcount(lead8SSE2(ptr));
+    ptr += PACK_COUNT;
+  }
+  return len + count8range(ptr, end);
+}
+
+template<bool SWAP>
+static COLT_FORCE_SSE2 size_t count16SSE2(
+    const char16_t* ptr, const char16_t* end) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m128i) / sizeof(u16);
+  size_t len                = 0;
+  while (static_cast<size_t>(end - ptr) >= PACK_COUNT)
+  {
+    len += std::popcount(lead16SSE2<SWAP>(ptr));
+    ptr += PACK_COUNT;
+  }
+  return len + count16range<SWAP>(ptr, end);
+}
+
+static COLT_FORCE_SSE2 std::pair<size_t, size_t> count_and_middle8SSE2(
+    const char8_t* ptr, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m128i) / sizeof(u8);
+  const auto end            = ptr + size;
+  auto middle               = ptr + size / 2;
+  size_t index              = count8SSE2(ptr, middle);
+  const size_t count        = index + count8SSE2(middle, end);
+  const size_t target       = middle_index(count, index);
+  // Move back until at most 'target' code points start before 'middle'
+  while (index > target)
+  {
+    if (static_cast<size_t>(middle - ptr) < PACK_COUNT)
+    {
+      middle = ptr;
+      index  = 0;
+      break;
+    }
+    middle -= PACK_COUNT;
+    index -= std::popcount(lead8SSE2(middle));
+  }
+  while (static_cast<size_t>(end - middle) >= PACK_COUNT)
+  {
+    const u32 mask     = lead8SSE2(middle);
+    const size_t block = std::popcount(mask);
+    if (index + block > target)
+      return {count, middle - ptr + nth_set_bit(mask, target - index)};
+    index += block;
+    middle += PACK_COUNT;
+  }
+  return {count, seek8range(middle, end, index, target) - ptr};
+}
+
+template<bool SWAP>
+static COLT_FORCE_SSE2 std::pair<size_t, size_t> count_and_middle16SSE2(
+    const char16_t* ptr, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m128i) / sizeof(u16);
+  const auto end            = ptr + size;
+  auto middle               = ptr + size / 2;
+  size_t index              = count16SSE2<SWAP>(ptr, middle);
+  const size_t count        = index + count16SSE2<SWAP>(middle, end);
+  const size_t target       = middle_index(count, index);
+  // Move back until at most 'target' code points start before 'middle'
+  while (index > target)
+  {
+    if (static_cast<size_t>(middle - ptr) < PACK_COUNT)
+    {
+      middle = ptr;
+      index  = 0;
+      break;
+    }
+    middle -= PACK_COUNT;
+    index -= std::popcount(lead16SSE2<SWAP>(middle));
+  }
+  while (static_cast<size_t>(end - middle) >= PACK_COUNT)
+  {
+    const u32 mask     = lead16SSE2<SWAP>(middle);
+    const size_t block = std::popcount(mask);
+    if (index + block > target)
+      return {count, middle - ptr + nth_set_bit(mask, target - index) / 2};
+    index += block;
+    middle += PACK_COUNT;
+  }
+  return {count, seek16range<SWAP>(middle, end, index, target) - ptr};
+}
+  #pragma endregion
+
+  #pragma region // count_and_middle8 count_and_middle16 AVX2
+
+/// @brief Returns the mask of the bytes that start a code point
+/// @param ptr The start of the 32 bytes
+/// @return Mask containing a set bit for each non-trail byte
+static COLT_FORCE_AVX2 u32 lead8AVX2(const char8_t* ptr) noexcept
+{
+  const __m256i trail_mask  = _mm256_set1_epi8((u8)0b1100'0000);
+  const __m256i trail_value = _mm256_set1_epi8((u8)0b1000'0000);
+  __m256i values   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+  __m256i is_trail = _mm256_and_si256(values, trail_mask);
+  is_trail         = _mm256_cmpeq_epi8(is_trail, trail_value);
+  return ~(u32)_mm256_movemask_epi8(is_trail);
+}
+
+/// @brief Returns the mask of the units that start a code point.
+/// Each unit is represented by 2 bits, of which the lowest can be set.
+/// @tparam SWAP If true, the units are byteswapped
+/// @param ptr The start of the 16 units
+/// @return Mask containing a set bit for each non-trail surrogate unit
+template<bool SWAP>
+static COLT_FORCE_AVX2 u32 lead16AVX2(const char16_t* ptr) noexcept
+{
+  const __m256i trail_mask  = _mm256_set1_epi16(SWAP ? (u16)0x00FC : (u16)0xFC00);
+  const __m256i trail_value = _mm256_set1_epi16(SWAP ? (u16)0x00DC : (u16)0xDC00);
+  __m256i values   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+  __m256i is_trail = _mm256_and_si256(values, trail_mask);
+  is_trail         = _mm256_cmpeq_epi16(is_trail, trail_value);
+  return ~(u32)_mm256_movemask_epi8(is_trail) & 0x5555'5555;
+}
+
+static COLT_FORCE_AVX2 size_t count8AVX2(
+    const char8_t* ptr, const char8_t* end) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m256i) / sizeof(u8);
+  size_t len                = 0;
+  while (static_cast<size_t>(end - ptr) >= PACK_COUNT)
+  {
+    len += std::popcount(lead8AVX2(ptr));
+    ptr += PACK_COUNT;
+  }
+  return len + count8range(ptr, end);
+}
+
+template<bool SWAP>
+static COLT_FORCE_AVX2 size_t count16AVX2(
+    const char16_t* ptr, const char16_t* end) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m256i) / sizeof(u16);
+  size_t len                = 0;
+  while (static_cast<size_t>(end - ptr) >= PACK_COUNT)
+  {
+    len += std::popcount(lead16AVX2<SWAP>(ptr));
+    ptr += PACK_COUNT;
+  }
+  return len + count16range<SWAP>(ptr, end);
+}
+
+static COLT_FORCE_AVX2 std::pair<size_t, size_t> count_and_middle8AVX2(
+    const char8_t* ptr, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m256i) / sizeof(u8);
+  const auto end            = ptr + size;
+  auto middle               = ptr + size / 2;
+  size_t index              = count8AVX2(ptr, middle);
+  const size_t count        = index + count8AVX2(middle, end);
+  const size_t target       = middle_index(count, index);
+  // Move back until at most 'target' code points start before 'middle'
+  while (index > target)
+  {
+    if (static_cast<size_t>(middle - ptr) < PACK_COUNT)
+    {
+      middle = ptr;
+      index  = 0;
+      break;
+    }
+    middle -= PACK_COUNT;
+    index -= std::popcount(lead8AVX2(middle));
+  }
+  while (static_cast<size_t>(end - middle) >= PACK_COUNT)
+  {
+    const u32 mask     = lead8AVX2(middle);
+    const size_t block = std::popcount(mask);
+    if (index + block > target)
+      return {count, middle - ptr + nth_set_bit(mask, target - index)};
+    index += block;
+    middle += PACK_COUNT;
+  }
+  return {count, seek8range(middle, end, index, target) - ptr};
+}
+
+template<bool SWAP>
+static COLT_FORCE_AVX2 std::pair<size_t, size_t> count_and_middle16AVX2(
+    const char16_t* ptr, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m256i) / sizeof(u16);
+  const auto end            = ptr + size;
+  auto middle               = ptr + size / 2;
+  size_t index              = count16AVX2<SWAP>(ptr, middle);
+  const size_t count        = index + count16AVX2<SWAP>(middle, end);
+  const size_t target       = middle_index(count, index);
+  // Move back until at most 'target' code points start before 'middle'
+  while (index > target)
+  {
+    if (static_cast<size_t>(middle - ptr) < PACK_COUNT)
+    {
+      middle = ptr;
+      index  = 0;
+      break;
+    }
+    middle -= PACK_COUNT;
+    index -= std::popcount(lead16AVX2<SWAP>(middle));
+  }
+  while (static_cast<size_t>(end - middle) >= PACK_COUNT)
+  {
+    const u32 mask     = lead16AVX2<SWAP>(middle);
+    const size_t block = std::popcount(mask);
+    if (index + block > target)
+      return {count, middle - ptr + nth_set_bit(mask, target - index) / 2};
+    index += block;
+    middle += PACK_COUNT;
+  }
+  return {count, seek16range<SWAP>(middle, end, index, target) - ptr};
+}
+  #pragma endregion
+
+  #pragma region // count_and_middle8 count_and_middle16 AVX512BW
+
+// As AVX512 provides masked loads (that do not fault on masked
+// elements), the tail is handled without falling back to scalar code.
+
+/// @brief Returns the mask of the bytes that start a code point
+/// @param ptr The start of the 64 bytes
+/// @param load The mask of the bytes to load
+/// @return Mask containing a set bit for each loaded non-trail byte
+static COLT_FORCE_AVX512BW u64 lead8AVX512BW(
+    const char8_t* ptr, __mmask64 load) noexcept
+{
+  const __m512i trail_mask  = _mm512_set1_epi8((u8)0b1100'0000);
+  const __m512i trail_value = _mm512_set1_epi8((u8)0b1000'0000);
+  __m512i values            = _mm512_maskz_loadu_epi8(load, ptr);
+  values                    = _mm512_and_si512(values, trail_mask);
+  return _mm512_mask_cmpneq_epi8_mask(load, values, trail_value);
+}
+
+/// @brief Returns the mask of the units that start a code point
+/// @tparam SWAP If true, the units are byteswapped
+/// @param ptr The start of the 32 units
+/// @param load The mask of the units to load
+/// @return Mask containing a set bit for each loaded non-trail surrogate unit
+template<bool SWAP>
+static COLT_FORCE_AVX512BW u32 lead16AVX512BW(
+    const char16_t* ptr, __mmask32 load) noexcept
+{
+  const __m512i trail_mask  = _mm512_set1_epi16(SWAP ? (u16)0x00FC : (u16)0xFC00);
+  const __m512i trail_value = _mm512_set1_epi16(SWAP ? (u16)0x00DC : (u16)0xDC00);
+  __m512i values            = _mm512_maskz_loadu_epi16(load, ptr);
+  values                    = _mm512_and_si512(values, trail_mask);
+  return _mm512_mask_cmpneq_epi16_mask(load, values, trail_value);
+}
+
+static COLT_FORCE_AVX512BW size_t count8AVX512BW(
+    const char8_t* ptr, const char8_t* end) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m512i) / sizeof(u8);
+  size_t len                = 0;
+  while (static_cast<size_t>(end - ptr) >= PACK_COUNT)
+  {
+    len += std::popcount(lead8AVX512BW(ptr, ~0ULL));
+    ptr += PACK_COUNT;
+  }
+  if (ptr == end)
+    return len;
+  const __mmask64 load = ~0ULL >> (PACK_COUNT - (end - ptr));
+  return len + std::popcount(lead8AVX512BW(ptr, load));
+}
+
+template<bool SWAP>
+static COLT_FORCE_AVX512BW size_t count16AVX512BW(
+    const char16_t* ptr, const char16_t* end) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m512i) / sizeof(u16);
+  size_t len                = 0;
+  while (static_cast<size_t>(end - ptr) >= PACK_COUNT)
+  {
+    len += std::popcount(lead16AVX512BW<SWAP>(ptr, ~0U));
+    ptr += PACK_COUNT;
+  }
+  if (ptr == end)
+    return len;
+  const __mmask32 load = ~0U >> (PACK_COUNT - (end - ptr));
+  return len + std::popcount(lead16AVX512BW<SWAP>(ptr, load));
+}
+
+static COLT_FORCE_AVX512BW std::pair<size_t, size_t> count_and_middle8AVX512BW(
+    const char8_t* ptr, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m512i) / sizeof(u8);
+  const auto end            = ptr + size;
+  auto middle               = ptr + size / 2;
+  size_t index              = count8AVX512BW(ptr, middle);
+  const size_t count        = index + count8AVX512BW(middle, end);
+  const size_t target       = middle_index(count, index);
+  // Move back until at most 'target' code points start before 'middle'
+  while (index > target)
+  {
+    if (static_cast<size_t>(middle - ptr) < PACK_COUNT)
+    {
+      middle = ptr;
+      index  = 0;
+      break;
+    }
+    middle -= PACK_COUNT;
+    index -= std::popcount(lead8AVX512BW(middle, ~0ULL));
+  }
+  while (middle != end)
+  {
+    const auto remaining = static_cast<size_t>(end - middle);
+    const __mmask64 load =
+        remaining >= PACK_COUNT ? ~0ULL : ~0ULL >> (PACK_COUNT - remaining);
+    const u64 mask     = lead8AVX512BW(middle, load);
+    const size_t block = std::popcount(mask);
+    if (index + block > target)
+      return {count, middle - ptr + nth_set_bit(mask, target - index)};
+    index += block;
+    middle += clt::min(remaining, PACK_COUNT);
+  }
+  return {count, size};
+}
+
+template<bool SWAP>
+static COLT_FORCE_AVX512BW std::pair<size_t, size_t> count_and_middle16AVX512BW(
+    const char16_t* ptr, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m512i) / sizeof(u16);
+  const auto end            = ptr + size;
+  auto middle               = ptr + size / 2;
+  size_t index              = count16AVX512BW<SWAP>(ptr, middle);
+  const size_t count        = index + count16AVX512BW<SWAP>(middle, end);
+  const size_t target       = middle_index(count, index);
+  // Move back until at most 'target' code points start before 'middle'
+  while (index > target)
+  {
+    if (static_cast<size_t>(middle - ptr) < PACK_COUNT)
+    {
+      middle = ptr;
+      index  = 0;
+      break;
+    }
+    middle -= PACK_COUNT;
+    index -= std::popcount(lead16AVX512BW<SWAP>(middle, ~0U));
+  }
+  while (middle != end)
+  {
+    const auto remaining = static_cast<size_t>(end - middle);
+    const __mmask32 load =
+        remaining >= PACK_COUNT ? ~0U : ~0U >> (PACK_COUNT - remaining);
+    const u32 mask     = lead16AVX512BW<SWAP>(middle, load);
+    const size_t block = std::popcount(mask);
+    if (index + block > target)
+      return {count, middle - ptr + nth_set_bit(mask, target - index)};
+    index += block;
+    middle += clt::min(remaining, PACK_COUNT);
+  }
+  return {count, size};
+}
+  #pragma endregion
+
+  #pragma region // skip_class8 AVX2, AVX512BW
+
+// SSE2 does not provide byte shuffles (pshufb is SSSE3), so the
+// default version of skip_class8 is used instead of an SSE2 one.
+
+static COLT_FORCE_AVX2 const char* skip_class8AVX2(
+    const char* begin, const char* end, const NibbleTable& table) noexcept
+{
+  // The shuffle operates on each 128-bit lane: broadcast the tables
+  const __m256i lo = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.lo)));
+  const __m256i hi = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.hi)));
+  const __m256i nibble      = _mm256_set1_epi8(0x0F);
+  constexpr auto PACK_COUNT = sizeof(__m256i) / sizeof(u8);
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    __m256i lo_cls = _mm256_shuffle_epi8(lo, _mm256_and_si256(values, nibble));
+    __m256i hi_cls = _mm256_shuffle_epi8(
+        hi, _mm256_and_si256(_mm256_srli_epi16(values, 4), nibble));
+    __m256i cls = _mm256_and_si256(lo_cls, hi_cls);
+    unsigned int mask = _mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(cls, _mm256_setzero_si256()));
+    if (mask != 0)
+      return begin + std::countr_zero(mask);
+    begin += PACK_COUNT;
+  }
+  return skip_class8default(begin, end, table);
+}
+
+/// @brief Returns the mask of the (loaded) units of 'values' that are of the class
+static COLT_FORCE_AVX512BW __mmask64 classify8AVX512BW(
+    __m512i values, __m512i lo, __m512i hi, __mmask64 load) noexcept
+{
+  const __m512i nibble = _mm512_set1_epi8(0x0F);
+  __m512i lo_cls = _mm512_shuffle_epi8(lo, _mm512_and_si512(values, nibble));
+  __m512i hi_cls = _mm512_shuffle_epi8(
+      hi, _mm512_and_si512(_mm512_srli_epi16(values, 4), nibble));
+  return _mm512_mask_test_epi8_mask(load, lo_cls, hi_cls);
+}
+
+static COLT_FORCE_AVX512BW const char* skip_class8AVX512BW(
+    const char* begin, const char* end, const NibbleTable& table) noexcept
+{
+  // The shuffle operates on each 128-bit lane: broadcast the tables
+  const __m512i lo = _mm512_broadcast_i32x4(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.lo)));
+  const __m512i hi = _mm512_broadcast_i32x4(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.hi)));
+  constexpr auto PACK_COUNT = sizeof(__m512i) / sizeof(u8);
+  __mmask64 mask;
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    __m512i values = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(begin));
+    mask           = ~classify8AVX512BW(values, lo, hi, ~0ULL);
+    if (mask != 0)
+      return begin + std::countr_zero(mask);
+    begin += PACK_COUNT;
+  }
+  if (begin == end)
+    return end;
+  const __mmask64 load = ~0ULL >> (PACK_COUNT - (end - begin));
+  __m512i values       = _mm512_maskz_loadu_epi8(load, begin);
+  mask                 = ~classify8AVX512BW(values, lo, hi, load) & load;
+  return mask != 0 ? begin + std::countr_zero(mask) : end;
+}
+  #pragma endregion
+
+  #pragma region // casefold_prefix8 casefold8 SSE2, AVX2, AVX512BW
+
+/// @brief Folds the upper case ASCII letters of 'values' to lower case.
+/// Non-ASCII units are negative, and are thus never in ['A', 'Z'].
+static COLT_FORCE_SSE2 __m128i fold8SSE2(__m128i values) noexcept
+{
+  const __m128i upper = _mm_and_si128(
+      _mm_cmpgt_epi8(values, _mm_set1_epi8('A' - 1)),
+      _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), values));
+  return _mm_or_si128(values, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+static COLT_FORCE_SSE2 size_t casefold_prefix8SSE2(
+    const char* a, const char* b, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m128i) / sizeof(u8);
+  size_t i                  = 0;
+  for (; size - i >= PACK_COUNT; i += PACK_COUNT)
+  {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    // The units that differ once folded or that are not ASCII
+    unsigned int mask =
+        ~_mm_movemask_epi8(_mm_cmpeq_epi8(fold8SSE2(va), fold8SSE2(vb)));
+    mask = (mask | _mm_movemask_epi8(_mm_or_si128(va, vb))) & 0xFFFF;
+    if (mask != 0)
+      return i + std::countr_zero(mask);
+  }
+  return i + casefold_prefix8default(a + i, b + i, size - i);
+}
+
+static COLT_FORCE_SSE2 size_t casefold8SSE2(
+    const char* from, size_t size, char* to) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m128i) / sizeof(u8);
+  size_t i                  = 0;
+  for (; size - i >= PACK_COUNT; i += PACK_COUNT)
+  {
+    __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(from + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(to + i), fold8SSE2(values));
+    const unsigned int mask = _mm_movemask_epi8(values);
+    if (mask != 0)
+      return i + std::countr_zero(mask);
+  }
+  return i + casefold8default(from + i, size - i, to + i);
+}
+
+/// @brief Folds the upper case ASCII letters of 'values' to lower case
+static COLT_FORCE_AVX2 __m256i fold8AVX2(__m256i values) noexcept
+{
+  const __m256i upper = _mm256_and_si256(
+      _mm256_cmpgt_epi8(values, _mm256_set1_epi8('A' - 1)),
+      _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), values));
+  return _mm256_or_si256(values, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+static COLT_FORCE_AVX2 size_t casefold_prefix8AVX2(
+    const char* a, const char* b, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m256i) / sizeof(u8);
+  size_t i                  = 0;
+  for (; size - i >= PACK_COUNT; i += PACK_COUNT)
+  {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    // The units that differ once folded or that are not ASCII
+    unsigned int mask =
+        ~_mm256_movemask_epi8(_mm256_cmpeq_epi8(fold8AVX2(va), fold8AVX2(vb)));
+    mask |= _mm256_movemask_epi8(_mm256_or_si256(va, vb));
+    if (mask != 0)
+      return i + std::countr_zero(mask);
+  }
+  return i + casefold_prefix8SSE2(a + i, b + i, size - i);
+}
+
+static COLT_FORCE_AVX2 size_t casefold8AVX2(
+    const char* from, size_t size, char* to) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m256i) / sizeof(u8);
+  size_t i                  = 0;
+  for (; size - i >= PACK_COUNT; i += PACK_COUNT)
+  {
+    __m256i values =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(to + i), fold8AVX2(values));
+    const unsigned int mask = _mm256_movemask_epi8(values);
+    if (mask != 0)
+      return i + std::countr_zero(mask);
+  }
+  return i + casefold8SSE2(from + i, size - i, to + i);
+}
+
+/// @brief Folds the upper case ASCII letters of 'values' to lower case
+static COLT_FORCE_AVX512BW __m512i fold8AVX512BW(__m512i values) noexcept
+{
+  const __mmask64 upper = _mm512_cmplt_epu8_mask(
+      _mm512_sub_epi8(values, _mm512_set1_epi8('A')), _mm512_set1_epi8(26));
+  return _mm512_mask_add_epi8(values, upper, values, _mm512_set1_epi8(0x20));
+}
+
+static COLT_FORCE_AVX512BW size_t casefold_prefix8AVX512BW(
+    const char* a, const char* b, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m512i) / sizeof(u8);
+  size_t i                  = 0;
+  __mmask64 load            = ~0ULL;
+  while (i != size)
+  {
+    if (size - i < PACK_COUNT)
+      load = ~0ULL >> (PACK_COUNT - (size - i));
+    __m512i va = _mm512_maskz_loadu_epi8(load, a + i);
+    __m512i vb = _mm512_maskz_loadu_epi8(load, b + i);
+    // The units that differ once folded or that are not ASCII
+    __mmask64 mask = _mm512_cmpneq_epi8_mask(fold8AVX512BW(va), fold8AVX512BW(vb))
+                     | _mm512_movepi8_mask(_mm512_or_si512(va, vb));
+    if (mask != 0)
+      return i + std::countr_zero(mask);
+    i += std::popcount(load);
+  }
+  return size;
+}
+
+static COLT_FORCE_AVX512BW size_t casefold8AVX512BW(
+    const char* from, size_t size, char* to) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m512i) / sizeof(u8);
+  size_t i                  = 0;
+  __mmask64 load            = ~0ULL;
+  while (i != size)
+  {
+    if (size - i < PACK_COUNT)
+      load = ~0ULL >> (PACK_COUNT - (size - i));
+    __m512i values = _mm512_maskz_loadu_epi8(load, from + i);
+    _mm512_mask_storeu_epi8(to + i, load, fold8AVX512BW(values));
+    const __mmask64 mask = _mm512_movepi8_mask(values);
+    if (mask != 0)
+      return i + std::countr_zero(mask);
+    i += std::popcount(load);
+  }
+  return size;
+}
+  #pragma endregion
+
+  #pragma region // find_ge8 SSE2, AVX2, AVX512BW
+
+// There is no unsigned comparison of bytes before AVX512: a byte is
+// greater or equal to 'unit' if it is left unchanged by max(byte, unit).
+
+static COLT_FORCE_SSE2 const char8_t* find_ge8SSE2(
+    const char8_t* begin, const char8_t* end, char8_t unit) noexcept
+{
+  const __m128i needle      = _mm_set1_epi8((char)unit);
+  constexpr auto PACK_COUNT = sizeof(__m128i) / sizeof(u8);
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    __m128i values    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    __m128i cmp       = _mm_cmpeq_epi8(_mm_max_epu8(values, needle), values);
+    unsigned int mask = _mm_movemask_epi8(cmp);
+    if (mask != 0)
+      return begin + std::countr_zero(mask);
+    begin += PACK_COUNT;
+  }
+  return find_ge8default(begin, end, unit);
+}
+
+static COLT_FORCE_AVX2 const char8_t* find_ge8AVX2(
+    const char8_t* begin, const char8_t* end, char8_t unit) noexcept
+{
+  const __m256i needle      = _mm256_set1_epi8((char)unit);
+  constexpr auto PACK_COUNT = sizeof(__m256i) / sizeof(u8);
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    __m256i cmp    = _mm256_cmpeq_epi8(_mm256_max_epu8(values, needle), values);
+    unsigned int mask = _mm256_movemask_epi8(cmp);
+    if (mask != 0)
+      return begin + std::countr_zero(mask);
+    begin += PACK_COUNT;
+  }
+  return find_ge8SSE2(begin, end, unit);
+}
+
+static COLT_FORCE_AVX512BW const char8_t* find_ge8AVX512BW(
+    const char8_t* begin, const char8_t* end, char8_t unit) noexcept
+{
+  const __m512i needle      = _mm512_set1_epi8((char)unit);
+  constexpr auto PACK_COUNT = sizeof(__m512i) / sizeof(u8);
+  __mmask64 mask;
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    __m512i values = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(begin));
+    mask           = _mm512_cmpge_epu8_mask(values, needle);
+    if (mask != 0)
+      return begin + std::countr_zero(mask);
+    begin += PACK_COUNT;
+  }
+  if (begin == end)
+    return end;
+  const __mmask64 load = ~0ULL >> (PACK_COUNT - (end - begin));
+  __m512i values       = _mm512_maskz_loadu_epi8(load, begin);
+  mask                 = _mm512_mask_cmpge_epu8_mask(load, values, needle);
+  return mask != 0 ? begin + std::countr_zero(mask) : end;
+}
+  #pragma endregion
+
+  #pragma region // find_nonprint8 SSE2, AVX2, AVX512BW
+
+// As signed bytes, the non-ASCII bytes are negative: a byte is printable
+// ASCII if it is (signed) greater than 0x1F and less than 0x7F.
+
+static COLT_FORCE_SSE2 const char8_t* find_nonprint8SSE2(
+    const char8_t* begin, const char8_t* end) noexcept
+{
+  const __m128i low         = _mm_set1_epi8(0x1F);
+  const __m128i high        = _mm_set1_epi8(0x7F);
+  constexpr auto PACK_COUNT = sizeof(__m128i) / sizeof(u8);
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    __m128i print  = _mm_and_si128(
+        _mm_cmpgt_epi8(values, low), _mm_cmplt_epi8(values, high));
+    unsigned int mask = ~_mm_movemask_epi8(print) & 0xFFFF;
+    if (mask != 0)
+      return begin + std::countr_zero(mask);
+    begin += PACK_COUNT;
+  }
+  return find_nonprint8default(begin, end);
+}
+
+static COLT_FORCE_AVX2 const char8_t* find_nonprint8AVX2(
+    const char8_t* begin, const char8_t* end) noexcept
+{
+  const __m256i low         = _mm256_set1_epi8(0x1F);
+  const __m256i high        = _mm256_set1_epi8(0x7F);
+  constexpr auto PACK_COUNT = sizeof(__m256i) / sizeof(u8);
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    __m256i print  = _mm256_and_si256(
+        _mm256_cmpgt_epi8(values, low), _mm256_cmpgt_epi8(high, values));
+    unsigned int mask = ~static_cast<unsigned int>(_mm256_movemask_epi8(print));
+    if (mask != 0)
+      return begin + std::countr_zero(mask);
+    begin += PACK_COUNT;
+  }
+  return find_nonprint8SSE2(begin, end);
+}
+
+static COLT_FORCE_AVX512BW const char8_t* find_nonprint8AVX512BW(
+    const char8_t* begin, const char8_t* end) noexcept
+{
+  const __m512i low         = _mm512_set1_epi8(0x1F);
+  const __m512i high        = _mm512_set1_epi8(0x7F);
+  constexpr auto PACK_COUNT = sizeof(__m512i) / sizeof(u8);
+  __mmask64 mask;
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    __m512i values = _mm512_loadu_si512(reinterpret_cast<const __m512i*>(begin));
+    mask           = ~_mm512_mask_cmplt_epi8_mask(
+        _mm512_cmpgt_epi8_mask(values, low), values, high);
+    if (mask != 0)
+      return begin + std::countr_zero(mask);
+    begin += PACK_COUNT;
+  }
+  if (begin == end)
+    return end;
+  const __mmask64 load = ~0ULL >> (PACK_COUNT - (end - begin));
+  __m512i values       = _mm512_maskz_loadu_epi8(load, begin);
+  const __mmask64 print = _mm512_mask_cmplt_epi8_mask(
+      _mm512_cmpgt_epi8_mask(values, low), values, high);
+  mask = load & ~print;
+  return mask != 0 ? begin + std::countr_zero(mask) : end;
+}
+  #pragma endregion
+
+  #pragma region // utf16_len8 utf16_offset8 SSE2, AVX2, AVX512BW
+
+// A byte starts a 4 bytes sequence if it is (unsigned) greater or equal
+// to 0xF0, that is if max(byte, 0xF0) == byte.
+
+/// @brief Returns the count of UTF16 units of the code points starting in
+///        16 bytes.
+/// @param ptr The start of the 16 bytes
+/// @return The number of UTF16 units
+static COLT_FORCE_SSE2 size_t utf16_units8SSE2(const char8_t* ptr) noexcept
+{
+  const __m128i quad = _mm_set1_epi8((u8)0xF0);
+  __m128i values     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+  __m128i is_quad    = _mm_cmpeq_epi8(_mm_max_epu8(values, quad), values);
+  return std::popcount(lead8SSE2(ptr))
+         + std::popcount((u32)_mm_movemask_epi8(is_quad));
+}
+
+static COLT_FORCE_SSE2 size_t utf16_len8SSE2(
+    const char8_t* ptr, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m128i) / sizeof(u8);
+  const auto end            = ptr + size;
+  size_t len                = 0;
+  while (static_cast<size_t>(end - ptr) >= PACK_COUNT)
+  {
+    len += utf16_units8SSE2(ptr);
+    ptr += PACK_COUNT;
+  }
+  return len + utf16_count8range(ptr, end);
+}
+
+static COLT_FORCE_SSE2 size_t utf16_offset8SSE2(
+    const char8_t* ptr, size_t size, size_t target) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m128i) / sizeof(u8);
+  const auto end            = ptr + size;
+  auto current              = ptr;
+  size_t index              = 0;
+  // Skip the blocks whose code points all end before 'target'
+  while (static_cast<size_t>(end - current) >= PACK_COUNT)
+  {
+    const size_t block = utf16_units8SSE2(current);
+    if (index + block > target)
+      break;
+    index += block;
+    current += PACK_COUNT;
+  }
+  return utf16_seek8range(current, end, index, target) - ptr;
+}
+
+/// @brief Returns the count of UTF16 units of the code points starting in
+///        32 bytes.
+/// @param ptr The start of the 32 bytes
+/// @return The number of UTF16 units
+static COLT_FORCE_AVX2 size_t utf16_units8AVX2(const char8_t* ptr) noexcept
+{
+  const __m256i quad = _mm256_set1_epi8((u8)0xF0);
+  __m256i values  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+  __m256i is_quad = _mm256_cmpeq_epi8(_mm256_max_epu8(values, quad), values);
+  return std::popcount(lead8AVX2(ptr))
+         + std::popcount((u32)_mm256_movemask_epi8(is_quad));
+}
+
+static COLT_FORCE_AVX2 size_t utf16_len8AVX2(
+    const char8_t* ptr, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m256i) / sizeof(u8);
+  const auto end            = ptr + size;
+  size_t len                = 0;
+  while (static_cast<size_t>(end - ptr) >= PACK_COUNT)
+  {
+    len += utf16_units8AVX2(ptr);
+    ptr += PACK_COUNT;
+  }
+  return len + utf16_len8SSE2(ptr, end - ptr);
+}
+
+static COLT_FORCE_AVX2 size_t utf16_offset8AVX2(
+    const char8_t* ptr, size_t size, size_t target) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m256i) / sizeof(u8);
+  const auto end            = ptr + size;
+  auto current              = ptr;
+  size_t index              = 0;
+  // Skip the blocks whose code points all end before 'target'
+  while (static_cast<size_t>(end - current) >= PACK_COUNT)
+  {
+    const size_t block = utf16_units8AVX2(current);
+    if (index + block > target)
+      break;
+    index += block;
+    current += PACK_COUNT;
+  }
+  return utf16_seek8range(current, end, index, target) - ptr;
+}
+
+/// @brief Returns the count of UTF16 units of the code points starting in
+///        the loaded bytes of 64 bytes.
+/// @param ptr The start of the 64 bytes
+/// @param load The mask of the bytes to load
+/// @return The number of UTF16 units
+static COLT_FORCE_AVX512BW size_t utf16_units8AVX512BW(
+    const char8_t* ptr, __mmask64 load) noexcept
+{
+  const __m512i quad     = _mm512_set1_epi8((u8)0xF0);
+  __m512i values         = _mm512_maskz_loadu_epi8(load, ptr);
+  const __mmask64 is_quad = _mm512_mask_cmpge_epu8_mask(load, values, quad);
+  return std::popcount(lead8AVX512BW(ptr, load)) + std::popcount(is_quad);
+}
+
+static COLT_FORCE_AVX512BW size_t utf16_len8AVX512BW(
+    const char8_t* ptr, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m512i) / sizeof(u8);
+  const auto end            = ptr + size;
+  size_t len                = 0;
+  while (static_cast<size_t>(end - ptr) >= PACK_COUNT)
+  {
+    len += utf16_units8AVX512BW(ptr, ~0ULL);
+    ptr += PACK_COUNT;
+  }
+  if (ptr == end)
+    return len;
+  const __mmask64 load = ~0ULL >> (PACK_COUNT - (end - ptr));
+  return len + utf16_units8AVX512BW(ptr, load);
+}
+
+static COLT_FORCE_AVX512BW size_t utf16_offset8AVX512BW(
+    const char8_t* ptr, size_t size, size_t target) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(__m512i) / sizeof(u8);
+  const auto end            = ptr + size;
+  auto current              = ptr;
+  size_t index              = 0;
+  // Skip the blocks whose code points all end before 'target'
+  while (static_cast<size_t>(end - current) >= PACK_COUNT)
+  {
+    const size_t block = utf16_units8AVX512BW(current, ~0ULL);
+    if (index + block > target)
+      break;
+    index += block;
+    current += PACK_COUNT;
+  }
+  return utf16_seek8range(current, end, index, target) - ptr;
+}
+  #pragma endregion
+
+#elif defined(COLT_ARM_7or8)
+
+// See link below for vshrn
+// https://community.arm.com/arm-community-blogs/b/infrastructure-solutions-blog/posts/porting-x86-vector-bitmask-optimizations-to-arm-neon
+
+  #pragma region // unitlen16 NEON
+static COLT_FORCE_NEON size_t unitlen16NEON(const char16_t* ptr) noexcept
+{
+  const auto copy = ptr;
+  while (uintptr_t(ptr) % alignof(uint16x8_t) != 0)
+  {
+    if (*ptr == 0)
+      return ptr - copy;
+    ++ptr;
+  }
+
+  // Zero mask
+  const uint16x8_t zero     = vdupq_n_u16(0);
+  constexpr auto PACK_COUNT = sizeof(uint16x8_t) / sizeof(u16);
+  u64 mask;
+  while (true)
+  {
+    uint16x8_t values   = vld1q_u16(reinterpret_cast<const u16*>(ptr));
+    uint16x8_t cmp      = vceqq_u16(values, zero);
+    const uint8x8_t res = vshrn_n_u16(cmp, 8);
+    mask                = vget_lane_u64(vreinterpret_u64_u8(res), 0);
+    if (mask != 0)
+      break;
+    ptr += PACK_COUNT;
+  }
+  return (ptr - copy) + std::countr_zero(mask) / 8;
+}
+  #pragma endregion
+
+  #pragma region // unitlen32 NEON
+static COLT_FORCE_NEON size_t unitlen32NEON(const char32_t* ptr) noexcept
+{
+  const auto copy = ptr;
+  while (uintptr_t(ptr) % alignof(uint32x4_t) != 0)
+  {
+    if (*ptr == 0)
+      return ptr - copy;
+    ++ptr;
+  }
+
+  // Zero mask
+  const uint32x4_t zero     = vdupq_n_u32(0);
+  constexpr auto PACK_COUNT = sizeof(uint32x4_t) / sizeof(u32);
+  u64 mask;
+  while (true)
+  {
+    uint32x4_t values    = vld1q_u32(reinterpret_cast<const u32*>(ptr));
+    uint32x4_t cmp       = vceqq_u32(values, zero);
+    const uint16x4_t res = vshrn_n_u32(cmp, 8);
+    mask                 = vget_lane_u64(vreinterpret_u64_u16(res), 0);
+    if (mask != 0)
+      break;
+    ptr += PACK_COUNT;
+  }
+  return (ptr - copy) + std::countr_zero(mask) / 16;
+}
+  #pragma endregion
+
+  #pragma region // len8 NEON
+static COLT_FORCE_NEON clt::uni::LenInfo len8NEON(const char8_t* ptr) noexcept
+{
+  const auto copy = ptr;
+  size_t len      = 0;
+  // We can't use sequence_length here as the goal is to align
+  // and most likely adding sequence_length will not align the pointer.
+  while (uintptr_t(ptr) % alignof(uint8x16_t) != 0)
+  {
+    if (*ptr == '\0')
+      return {len, static_cast<size_t>(ptr - copy)};
+    len += (size_t)(!clt::uni::is_trail(*ptr));
+    ++ptr;
+  }
+
+  // Zero mask
+  const uint8x16_t zero        = vdupq_n_u8(0);
+  const uint8x16_t trail_mask  = vdupq_n_u8((u8)0b1100'0000);
+  const uint8x16_t trail_value = vdupq_n_u8((u8)0b1000'0000);
+  constexpr auto PACK_COUNT    = sizeof(uint8x16_t) / sizeof(u8);
+  u64 mask;
+  while (true)
+  {
+    uint8x16_t values   = vld1q_u8(reinterpret_cast<const u8*>(ptr));
+    uint8x16_t cmp      = vceqq_u8(values, zero);
+    const uint8x8_t res = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    mask                = vget_lane_u64(vreinterpret_u64_u8(res), 0);
+    if (mask != 0)
+      break;
+    uint8x16_t is_trail = vandq_u8(values, trail_mask);
+    is_trail            = vceqq_u8(is_trail, trail_value);
+    len += PACK_COUNT
+           - std::popcount(vget_lane_u64(
+                 vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(is_trail), 4)),
+                 0))
+                 / 4;
+    ptr += PACK_COUNT;
+  }
+  while (true)
   {
     if (*ptr == '\0')
       return {len, static_cast<size_t>(ptr - copy)};
@@ -709,6 +2617,465 @@ static COLT_FORCE_NEON clt::uni::LenInfo len16NEON(const char16_t* ptr) noexcept
 }
   #pragma endregion
 
+  #pragma region // find8 find16 find32 find_any8 NEON
+static COLT_FORCE_NEON const char8_t* find8NEON(
+    const char8_t* begin, const char8_t* end, char8_t unit) noexcept
+{
+  const uint8x16_t needle   = vdupq_n_u8((u8)unit);
+  constexpr auto PACK_COUNT = sizeof(uint8x16_t) / sizeof(u8);
+  u64 mask;
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    uint8x16_t values   = vld1q_u8(reinterpret_cast<const u8*>(begin));
+    uint8x16_t cmp      = vceqq_u8(values, needle);
+    const uint8x8_t res = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    mask                = vget_lane_u64(vreinterpret_u64_u8(res), 0);
+    if (mask != 0)
+      return begin + std::countr_zero(mask) / 4;
+    begin += PACK_COUNT;
+  }
+  return find8default(begin, end, unit);
+}
+
+static COLT_FORCE_NEON const char16_t* find16NEON(
+    const char16_t* begin, const char16_t* end, char16_t unit) noexcept
+{
+  const uint16x8_t needle   = vdupq_n_u16((u16)unit);
+  constexpr auto PACK_COUNT = sizeof(uint16x8_t) / sizeof(u16);
+  u64 mask;
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    uint16x8_t values   = vld1q_u16(reinterpret_cast<const u16*>(begin));
+    uint16x8_t cmp      = vceqq_u16(values, needle);
+    const uint8x8_t res = vshrn_n_u16(cmp, 8);
+    mask                = vget_lane_u64(vreinterpret_u64_u8(res), 0);
+    if (mask != 0)
+      return begin + std::countr_zero(mask) / 8;
+    begin += PACK_COUNT;
+  }
+  return find16default(begin, end, unit);
+}
+
+static COLT_FORCE_NEON const char32_t* find32NEON(
+    const char32_t* begin, const char32_t* end, char32_t unit) noexcept
+{
+  const uint32x4_t needle   = vdupq_n_u32((u32)unit);
+  constexpr auto PACK_COUNT = sizeof(uint32x4_t) / sizeof(u32);
+  u64 mask;
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    uint32x4_t values    = vld1q_u32(reinterpret_cast<const u32*>(begin));
+    uint32x4_t cmp       = vceqq_u32(values, needle);
+    const uint16x4_t res = vshrn_n_u32(cmp, 8);
+    mask                 = vget_lane_u64(vreinterpret_u64_u16(res), 0);
+    if (mask != 0)
+      return begin + std::countr_zero(mask) / 16;
+    begin += PACK_COUNT;
+  }
+  return find32default(begin, end, unit);
+}
+
+static COLT_FORCE_NEON const char8_t* find_any8NEON(
+    const char8_t* begin, const char8_t* end, const char8_t* units,
+    size_t count) noexcept
+{
+  uint8x16_t needles[clt::uni::details::FIND_ANY_MAX];
+  for (size_t i = 0; i < count; i++)
+    needles[i] = vdupq_n_u8((u8)units[i]);
+
+  constexpr auto PACK_COUNT = sizeof(uint8x16_t) / sizeof(u8);
+  u64 mask;
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    uint8x16_t values = vld1q_u8(reinterpret_cast<const u8*>(begin));
+    uint8x16_t cmp    = vdupq_n_u8(0);
+    for (size_t i = 0; i < count; i++)
+      cmp = vorrq_u8(cmp, vceqq_u8(values, needles[i]));
+    const uint8x8_t res = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    mask                = vget_lane_u64(vreinterpret_u64_u8(res), 0);
+    if (mask != 0)
+      return begin + std::countr_zero(mask) / 4;
+    begin += PACK_COUNT;
+  }
+  return find_any8default(begin, end, units, count);
+}
+  #pragma endregion
+
+  #pragma region // validate8 validate16 NEON
+
+// ASCII (or surrogate-free) blocks are skipped, and the other blocks
+// are validated by the default version.
+
+static COLT_FORCE_NEON clt::Option<clt::uni::LenInfo> validate8NEON(
+    const char8_t* ptr, size_t size) noexcept
+{
+  const uint8x16_t ascii_max = vdupq_n_u8(0x7F);
+  constexpr auto PACK_COUNT  = sizeof(uint8x16_t) / sizeof(u8);
+  const auto end             = ptr + size;
+  size_t len                 = 0;
+  while (static_cast<size_t>(end - ptr) >= PACK_COUNT)
+  {
+    uint8x16_t values   = vld1q_u8(reinterpret_cast<const u8*>(ptr));
+    uint8x16_t cmp      = vcgtq_u8(values, ascii_max);
+    const uint8x8_t res = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    if (vget_lane_u64(vreinterpret_u64_u8(res), 0) == 0)
+    {
+      len += PACK_COUNT;
+      ptr += PACK_COUNT;
+      continue;
+    }
+    if (!validate8range(ptr, ptr + PACK_COUNT, end, len))
+      return clt::None;
+  }
+  if (!validate8range(ptr, end, end, len))
+    return clt::None;
+  return clt::uni::LenInfo{len, size};
+}
+
+template<bool SWAP>
+static COLT_FORCE_NEON clt::Option<clt::uni::LenInfo> validate16NEON(
+    const char16_t* ptr, size_t size) noexcept
+{
+  const uint16x8_t surrogate_mask  = vdupq_n_u16(SWAP ? (u16)0x00F8 : (u16)0xF800);
+  const uint16x8_t surrogate_value = vdupq_n_u16(SWAP ? (u16)0x00D8 : (u16)0xD800);
+  constexpr auto PACK_COUNT        = sizeof(uint16x8_t) / sizeof(u16);
+  const auto end                   = ptr + size;
+  size_t len                       = 0;
+  while (static_cast<size_t>(end - ptr) >= PACK_COUNT)
+  {
+    uint16x8_t values   = vld1q_u16(reinterpret_cast<const u16*>(ptr));
+    uint16x8_t is_sur   = vandq_u16(values, surrogate_mask);
+    is_sur              = vceqq_u16(is_sur, surrogate_value);
+    const uint8x8_t res = vshrn_n_u16(is_sur, 8);
+    if (vget_lane_u64(vreinterpret_u64_u8(res), 0) == 0)
+    {
+      len += PACK_COUNT;
+      ptr += PACK_COUNT;
+      continue;
+    }
+    if (!validate16range<SWAP>(ptr, ptr + PACK_COUNT, end, len))
+      return clt::None;
+  }
+  if (!validate16range<SWAP>(ptr, end, end, len))
+    return clt::None;
+  return clt::uni::LenInfo{len, size};
+}
+  #pragma endregion
+
+  #pragma region // count_and_middle8 count_and_middle16 NEON
+
+/// @brief Returns the mask of the bytes that start a code point.
+/// Each byte is represented by 4 bits, of which the lowest can be set.
+/// @param ptr The start of the 16 bytes
+/// @return Mask containing a set bit for each non-trail byte
+static COLT_FORCE_NEON u64 lead8NEON(const char8_t* ptr) noexcept
+{
+  const uint8x16_t trail_mask  = vdupq_n_u8((u8)0b1100'0000);
+  const uint8x16_t trail_value = vdupq_n_u8((u8)0b1000'0000);
+  uint8x16_t values            = vld1q_u8(reinterpret_cast<const u8*>(ptr));
+  uint8x16_t is_trail          = vandq_u8(values, trail_mask);
+  is_trail                     = vceqq_u8(is_trail, trail_value);
+  const uint8x8_t res = vshrn_n_u16(vreinterpretq_u16_u8(is_trail), 4);
+  return ~vget_lane_u64(vreinterpret_u64_u8(res), 0) & 0x1111'1111'1111'1111ULL;
+}
+
+/// @brief Returns the mask of the units that start a code point.
+/// Each unit is represented by 8 bits, of which the lowest can be set.
+/// @tparam SWAP If true, the units are byteswapped
+/// @param ptr The start of the 8 units
+/// @return Mask containing a set bit for each non-trail surrogate unit
+template<bool SWAP>
+static COLT_FORCE_NEON u64 lead16NEON(const char16_t* ptr) noexcept
+{
+  const uint16x8_t trail_mask  = vdupq_n_u16(SWAP ? (u16)0x00FC : (u16)0xFC00);
+  const uint16x8_t trail_value = vdupq_n_u16(SWAP ? (u16)0x00DC : (u16)0xDC00);
+  uint16x8_t values            = vld1q_u16(reinterpret_cast<const u16*>(ptr));
+  uint16x8_t is_trail          = vandq_u16(values, trail_mask);
+  is_trail                     = vceqq_u16(is_trail, trail_value);
+  const uint8x8_t res          = vshrn_n_u16(is_trail, 4);
+  return ~vget_lane_u64(vreinterpret_u64_u8(res), 0) & 0x0101'0101'0101'0101ULL;
+}
+
+static COLT_FORCE_NEON size_t count8NEON(
+    const char8_t* ptr, const char8_t* end) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(uint8x16_t) / sizeof(u8);
+  size_t len                = 0;
+  while (static_cast<size_t>(end - ptr) >= PACK_COUNT)
+  {
+    len += std::popcount(lead8NEON(ptr));
+    ptr += PACK_COUNT;
+  }
+  return len + count8range(ptr, end);
+}
+
+template<bool SWAP>
+static COLT_FORCE_NEON size_t count16NEON(
+    const char16_t* ptr, const char16_t* end) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(uint16x8_t) / sizeof(u16);
+  size_t len                = 0;
+  while (static_cast<size_t>(end - ptr) >= PACK_COUNT)
+  {
+    len += std::popcount(lead16NEON<SWAP>(ptr));
+    ptr += PACK_COUNT;
+  }
+  return len + count16range<SWAP>(ptr, end);
+}
+
+static COLT_FORCE_NEON std::pair<size_t, size_t> count_and_middle8NEON(
+    const char8_t* ptr, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(uint8x16_t) / sizeof(u8);
+  const auto end            = ptr + size;
+  auto middle               = ptr + size / 2;
+  size_t index              = count8NEON(ptr, middle);
+  const size_t count        = index + count8NEON(middle, end);
+  const size_t target       = middle_index(count, index);
+  // Move back until at most 'target' code points start before 'middle'
+  while (index > target)
+  {
+    if (static_cast<size_t>(middle - ptr) < PACK_COUNT)
+    {
+      middle = ptr;
+      index  = 0;
+      break;
+    }
+    middle -= PACK_COUNT;
+    index -= std::popcount(lead8NEON(middle));
+  }
+  while (static_cast<size_t>(end - middle) >= PACK_COUNT)
+  {
+    const u64 mask     = lead8NEON(middle);
+    const size_t block = std::popcount(mask);
+    if (index + block > target)
+      return {count, middle - ptr + nth_set_bit(mask, target - index) / 4};
+    index += block;
+    middle += PACK_COUNT;
+  }
+  return {count, seek8range(middle, end, index, target) - ptr};
+}
+
+template<bool SWAP>
+static COLT_FORCE_NEON std::pair<size_t, size_t> count_and_middle16NEON(
+    const char16_t* ptr, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(uint16x8_t) / sizeof(u16);
+  const auto end            = ptr + size;
+  auto middle               = ptr + size / 2;
+  size_t index              = count16NEON<SWAP>(ptr, middle);
+  const size_t count        = index + count16NEON<SWAP>(middle, end);
+  const size_t target       = middle_index(count, index);
+  // Move back until at most 'target' code points start before 'middle'
+  while (index > target)
+  {
+    if (static_cast<size_t>(middle - ptr) < PACK_COUNT)
+    {
+      middle = ptr;
+      index  = 0;
+      break;
+    }
+    middle -= PACK_COUNT;
+    index -= std::popcount(lead16NEON<SWAP>(middle));
+  }
+  while (static_cast<size_t>(end - middle) >= PACK_COUNT)
+  {
+    const u64 mask     = lead16NEON<SWAP>(middle);
+    const size_t block = std::popcount(mask);
+    if (index + block > target)
+      return {count, middle - ptr + nth_set_bit(mask, target - index) / 8};
+    index += block;
+    middle += PACK_COUNT;
+  }
+  return {count, seek16range<SWAP>(middle, end, index, target) - ptr};
+}
+  #pragma endregion
+
+  #pragma region // skip_class8 NEON
+
+/// @brief Looks up each byte of 'index' in 'table' (indices must be < 16)
+static COLT_FORCE_NEON uint8x16_t lookup16NEON(
+    uint8x16_t table, uint8x16_t index) noexcept
+{
+  #if defined(__aarch64__) || defined(_M_ARM64)
+  return vqtbl1q_u8(table, index);
+  #else
+  const uint8x8x2_t split = {{vget_low_u8(table), vget_high_u8(table)}};
+  return vcombine_u8(
+      vtbl2_u8(split, vget_low_u8(index)), vtbl2_u8(split, vget_high_u8(index)));
+  #endif
+}
+
+static COLT_FORCE_NEON const char* skip_class8NEON(
+    const char* begin, const char* end, const NibbleTable& table) noexcept
+{
+  const uint8x16_t lo       = vld1q_u8(table.lo);
+  const uint8x16_t hi       = vld1q_u8(table.hi);
+  const uint8x16_t nibble   = vdupq_n_u8(0x0F);
+  constexpr auto PACK_COUNT = sizeof(uint8x16_t) / sizeof(u8);
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    uint8x16_t values = vld1q_u8(reinterpret_cast<const u8*>(begin));
+    uint8x16_t lo_cls = lookup16NEON(lo, vandq_u8(values, nibble));
+    uint8x16_t hi_cls = lookup16NEON(hi, vshrq_n_u8(values, 4));
+    // 0xFF for each unit that is not of the class
+    uint8x16_t cmp   = vceqq_u8(vandq_u8(lo_cls, hi_cls), vdupq_n_u8(0));
+    const u64 mask   = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4)), 0);
+    if (mask != 0)
+      return begin + std::countr_zero(mask) / 4;
+    begin += PACK_COUNT;
+  }
+  return skip_class8default(begin, end, table);
+}
+  #pragma endregion
+
+  #pragma region // casefold_prefix8 casefold8 NEON
+
+/// @brief Folds the upper case ASCII letters of 'values' to lower case
+static COLT_FORCE_NEON uint8x16_t fold8NEON(uint8x16_t values) noexcept
+{
+  const uint8x16_t upper =
+      vcltq_u8(vsubq_u8(values, vdupq_n_u8('A')), vdupq_n_u8(26));
+  return vorrq_u8(values, vandq_u8(upper, vdupq_n_u8(0x20)));
+}
+
+static COLT_FORCE_NEON size_t casefold_prefix8NEON(
+    const char* a, const char* b, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(uint8x16_t) / sizeof(u8);
+  size_t i                  = 0;
+  for (; size - i >= PACK_COUNT; i += PACK_COUNT)
+  {
+    uint8x16_t va = vld1q_u8(reinterpret_cast<const u8*>(a + i));
+    uint8x16_t vb = vld1q_u8(reinterpret_cast<const u8*>(b + i));
+    // 0xFF for each unit that differs once folded or that is not ASCII
+    uint8x16_t cmp = vmvnq_u8(vceqq_u8(fold8NEON(va), fold8NEON(vb)));
+    cmp            = vorrq_u8(
+        cmp, vcltq_s8(vreinterpretq_s8_u8(vorrq_u8(va, vb)), vdupq_n_s8(0)));
+    const uint8x8_t res = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    const u64 mask      = vget_lane_u64(vreinterpret_u64_u8(res), 0);
+    if (mask != 0)
+      return i + std::countr_zero(mask) / 4;
+  }
+  return i + casefold_prefix8default(a + i, b + i, size - i);
+}
+
+static COLT_FORCE_NEON size_t casefold8NEON(
+    const char* from, size_t size, char* to) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(uint8x16_t) / sizeof(u8);
+  size_t i                  = 0;
+  for (; size - i >= PACK_COUNT; i += PACK_COUNT)
+  {
+    uint8x16_t values = vld1q_u8(reinterpret_cast<const u8*>(from + i));
+    vst1q_u8(reinterpret_cast<u8*>(to + i), fold8NEON(values));
+    uint8x16_t cmp = vcltq_s8(vreinterpretq_s8_u8(values), vdupq_n_s8(0));
+    const uint8x8_t res = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    const u64 mask      = vget_lane_u64(vreinterpret_u64_u8(res), 0);
+    if (mask != 0)
+      return i + std::countr_zero(mask) / 4;
+  }
+  return i + casefold8default(from + i, size - i, to + i);
+}
+  #pragma endregion
+
+  #pragma region // find_ge8 NEON
+static COLT_FORCE_NEON const char8_t* find_ge8NEON(
+    const char8_t* begin, const char8_t* end, char8_t unit) noexcept
+{
+  const uint8x16_t needle   = vdupq_n_u8((u8)unit);
+  constexpr auto PACK_COUNT = sizeof(uint8x16_t) / sizeof(u8);
+  u64 mask;
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    uint8x16_t values   = vld1q_u8(reinterpret_cast<const u8*>(begin));
+    uint8x16_t cmp      = vcgeq_u8(values, needle);
+    const uint8x8_t res = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    mask                = vget_lane_u64(vreinterpret_u64_u8(res), 0);
+    if (mask != 0)
+      return begin + std::countr_zero(mask) / 4;
+    begin += PACK_COUNT;
+  }
+  return find_ge8default(begin, end, unit);
+}
+  #pragma endregion
+
+  #pragma region // find_nonprint8 NEON
+static COLT_FORCE_NEON const char8_t* find_nonprint8NEON(
+    const char8_t* begin, const char8_t* end) noexcept
+{
+  const int8x16_t low       = vdupq_n_s8(0x1F);
+  const int8x16_t high      = vdupq_n_s8(0x7F);
+  constexpr auto PACK_COUNT = sizeof(uint8x16_t) / sizeof(u8);
+  u64 mask;
+  while (static_cast<size_t>(end - begin) >= PACK_COUNT)
+  {
+    int8x16_t values = vld1q_s8(reinterpret_cast<const i8*>(begin));
+    // (signed comparisons: the non-ASCII bytes are negative)
+    uint8x16_t cmp =
+        vmvnq_u8(vandq_u8(vcgtq_s8(values, low), vcltq_s8(values, high)));
+    const uint8x8_t res = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    mask                = vget_lane_u64(vreinterpret_u64_u8(res), 0);
+    if (mask != 0)
+      return begin + std::countr_zero(mask) / 4;
+    begin += PACK_COUNT;
+  }
+  return find_nonprint8default(begin, end);
+}
+  #pragma endregion
+
+  #pragma region // utf16_len8 utf16_offset8 NEON
+
+/// @brief Returns the count of UTF16 units of the code points starting in
+///        16 bytes.
+/// @param ptr The start of the 16 bytes
+/// @return The number of UTF16 units
+static COLT_FORCE_NEON size_t utf16_units8NEON(const char8_t* ptr) noexcept
+{
+  const uint8x16_t quad = vdupq_n_u8((u8)0xF0);
+  uint8x16_t values     = vld1q_u8(reinterpret_cast<const u8*>(ptr));
+  uint8x16_t is_quad    = vcgeq_u8(values, quad);
+  const uint8x8_t res   = vshrn_n_u16(vreinterpretq_u16_u8(is_quad), 4);
+  const u64 mask =
+      vget_lane_u64(vreinterpret_u64_u8(res), 0) & 0x1111'1111'1111'1111ULL;
+  return std::popcount(lead8NEON(ptr)) + std::popcount(mask);
+}
+
+static COLT_FORCE_NEON size_t utf16_len8NEON(
+    const char8_t* ptr, size_t size) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(uint8x16_t) / sizeof(u8);
+  const auto end            = ptr + size;
+  size_t len                = 0;
+  while (static_cast<size_t>(end - ptr) >= PACK_COUNT)
+  {
+    len += utf16_units8NEON(ptr);
+    ptr += PACK_COUNT;
+  }
+  return len + utf16_count8range(ptr, end);
+}
+
+static COLT_FORCE_NEON size_t utf16_offset8NEON(
+    const char8_t* ptr, size_t size, size_t target) noexcept
+{
+  constexpr auto PACK_COUNT = sizeof(uint8x16_t) / sizeof(u8);
+  const auto end            = ptr + size;
+  auto current              = ptr;
+  size_t index              = 0;
+  // Skip the blocks whose code points all end before 'target'
+  while (static_cast<size_t>(end - current) >= PACK_COUNT)
+  {
+    const size_t block = utf16_units8NEON(current);
+    if (index + block > target)
+      break;
+    index += block;
+    current += PACK_COUNT;
+  }
+  return utf16_seek8range(current, end, index, target) - ptr;
+}
+  #pragma endregion
+
 #endif // COLT_x86_64
 
 /// @brief Function pointer for len8
@@ -719,6 +3086,48 @@ using len16_fn_t = clt::uni::LenInfo (*)(const char16_t*) noexcept;
 using unitlen16_fn_t = size_t (*)(const char16_t*) noexcept;
 /// @brief Function pointer for unitlen32
 using unitlen32_fn_t = size_t (*)(const char32_t*) noexcept;
+/// @brief Function pointer for find8
+using find8_fn_t =
+    const char8_t* (*)(const char8_t*, const char8_t*, char8_t) noexcept;
+/// @brief Function pointer for find16
+using find16_fn_t =
+    const char16_t* (*)(const char16_t*, const char16_t*, char16_t) noexcept;
+/// @brief Function pointer for find32
+using find32_fn_t =
+    const char32_t* (*)(const char32_t*, const char32_t*, char32_t) noexcept;
+/// @brief Function pointer for find_any8
+using find_any8_fn_t = const char8_t* (*)(const char8_t*, const char8_t*,
+                                           const char8_t*, size_t) noexcept;
+/// @brief Function pointer for validate8
+using validate8_fn_t =
+    clt::Option<clt::uni::LenInfo> (*)(const char8_t*, size_t) noexcept;
+/// @brief Function pointer for validate16
+using validate16_fn_t =
+    clt::Option<clt::uni::LenInfo> (*)(const char16_t*, size_t) noexcept;
+/// @brief Function pointer for count_and_middle8
+using count_and_middle8_fn_t =
+    std::pair<size_t, size_t> (*)(const char8_t*, size_t) noexcept;
+/// @brief Function pointer for count_and_middle16
+using count_and_middle16_fn_t =
+    std::pair<size_t, size_t> (*)(const char16_t*, size_t) noexcept;
+/// @brief Function pointer for skip_class8
+using skip_class8_fn_t =
+    const char* (*)(const char*, const char*, const NibbleTable&) noexcept;
+
+/// @brief Function pointer for casefold_prefix8
+using casefold_prefix8_fn_t = size_t (*)(const char*, const char*, size_t) noexcept;
+/// @brief Function pointer for casefold8
+using casefold8_fn_t = size_t (*)(const char*, size_t, char*) noexcept;
+/// @brief Function pointer for find_ge8
+using find_ge8_fn_t =
+    const char8_t* (*)(const char8_t*, const char8_t*, char8_t) noexcept;
+/// @brief Function pointer for find_nonprint8
+using find_nonprint8_fn_t =
+    const char8_t* (*)(const char8_t*, const char8_t*) noexcept;
+/// @brief Function pointer for utf16_len8
+using utf16_len8_fn_t = size_t (*)(const char8_t*, size_t) noexcept;
+/// @brief Function pointer for utf16_offset8
+using utf16_offset8_fn_t = size_t (*)(const char8_t*, size_t, size_t) noexcept;
 
 /// @brief Type containing pointer to SIMD versions
 struct SIMDImpl
@@ -733,6 +3142,40 @@ struct SIMDImpl
   unitlen16_fn_t unit16;
   /// @brief unitlen32 function pointer
   unitlen32_fn_t unit32;
+  /// @brief find8 function pointer
+  find8_fn_t find8;
+  /// @brief find16 function pointer
+  find16_fn_t find16;
+  /// @brief find32 function pointer
+  find32_fn_t find32;
+  /// @brief find_any8 function pointer
+  find_any8_fn_t find_any8;
+  /// @brief validate8 function pointer
+  validate8_fn_t validate8;
+  /// @brief validate16le function pointer
+  validate16_fn_t validate16le;
+  /// @brief validate16be function pointer
+  validate16_fn_t validate16be;
+  /// @brief count_and_middle8 function pointer
+  count_and_middle8_fn_t count_and_middle8;
+  /// @brief count_and_middle16le function pointer
+  count_and_middle16_fn_t count_and_middle16le;
+  /// @brief count_and_middle16be function pointer
+  count_and_middle16_fn_t count_and_middle16be;
+  /// @brief skip_class8 function pointer
+  skip_class8_fn_t skip_class8;
+  /// @brief casefold_prefix8 function pointer
+  casefold_prefix8_fn_t casefold_prefix8;
+  /// @brief casefold8 function pointer
+  casefold8_fn_t casefold8;
+  /// @brief find_ge8 function pointer
+  find_ge8_fn_t find_ge8;
+  /// @brief find_nonprint8 function pointer
+  find_nonprint8_fn_t find_nonprint8;
+  /// @brief utf16_len8 function pointer
+  utf16_len8_fn_t utf16_len8;
+  /// @brief utf16_offset8 function pointer
+  utf16_offset8_fn_t utf16_offset8;
 };
 
 /// @brief Returns the SIMD implementation function pointers.
@@ -749,28 +3192,62 @@ static const SIMDImpl& get_colt_unicode_simd() noexcept
       simd_flag::AVX512BW, simd_flag::AVX2, simd_flag::DEFAULT>{}(
       SIMDImpl{
           &len8AVX512BW, &len16AVX512BW<SWAP>, &len16AVX512BW<!SWAP>,
-          &unitlen16AVX512BW, &unitlen32AVX512F},
+          &unitlen16AVX512BW, &unitlen32AVX512F, &find8AVX512BW, &find16AVX512BW,
+          &find32AVX512F, &find_any8AVX512BW, &validate8AVX2, &validate16AVX2<SWAP>,
+          &validate16AVX2<!SWAP>, &count_and_middle8AVX512BW,
+          &count_and_middle16AVX512BW<SWAP>, &count_and_middle16AVX512BW<!SWAP>,
+          &skip_class8AVX512BW, &casefold_prefix8AVX512BW,
+          &casefold8AVX512BW, &find_ge8AVX512BW, &find_nonprint8AVX512BW,
+          &utf16_len8AVX512BW, &utf16_offset8AVX512BW},
       SIMDImpl{
           &len8AVX2, &len16AVX2<SWAP>, &len16AVX2<!SWAP>, &unitlen16AVX2,
-          &unitlen32AVX2},
+          &unitlen32AVX2, &find8AVX2, &find16AVX2, &find32AVX2, &find_any8AVX2,
+          &validate8AVX2, &validate16AVX2<SWAP>, &validate16AVX2<!SWAP>,
+          &count_and_middle8AVX2, &count_and_middle16AVX2<SWAP>,
+          &count_and_middle16AVX2<!SWAP>, &skip_class8AVX2, &casefold_prefix8AVX2,
+          &casefold8AVX2, &find_ge8AVX2, &find_nonprint8AVX2, &utf16_len8AVX2,
+          &utf16_offset8AVX2},
       SIMDImpl{
           &len8SSE2, &len16SSE2<SWAP>, &len16SSE2<!SWAP>, &unitlen16SSE2,
-          &unitlen32SSE2});
+          &unitlen32SSE2, &find8SSE2, &find16SSE2, &find32SSE2, &find_any8SSE2,
+          &validate8SSE2, &validate16SSE2<SWAP>, &validate16SSE2<!SWAP>,
+          &count_and_middle8SSE2, &count_and_middle16SSE2<SWAP>,
+          &count_and_middle16SSE2<!SWAP>, &skip_class8default, &casefold_prefix8SSE2,
+          &casefold8SSE2, &find_ge8SSE2, &find_nonprint8SSE2, &utf16_len8SSE2,
+          &utf16_offset8SSE2});
   return ret;
 #elif defined(COLT_ARM_7or8)
   static auto ret =
       choose_simd_implementation<simd_flag::NEON, simd_flag::DEFAULT>{}(
           SIMDImpl{
               &len8NEON, &len16NEON<SWAP>, &len16NEON<!SWAP>, &unitlen16NEON,
-              &unitlen32NEON},
+              &unitlen32NEON, &find8NEON, &find16NEON, &find32NEON,
+              &find_any8NEON, &validate8NEON, &validate16NEON<SWAP>,
+              &validate16NEON<!SWAP>, &count_and_middle8NEON,
+              &count_and_middle16NEON<SWAP>, &count_and_middle16NEON<!SWAP>,
+              &skip_class8NEON, &casefold_prefix8NEON, &casefold8NEON,
+              &find_ge8NEON, &find_nonprint8NEON, &utf16_len8NEON,
+              &utf16_offset8NEON},
           SIMDImpl{
               &len8default, &len16LEdefault, &len16BEdefault, &unitlen16default,
-              &unitlen32default});
+              &unitlen32default, &find8default, &find16default, &find32default,
+              &find_any8default, &validate8default, &validate16default<SWAP>,
+              &validate16default<!SWAP>, &count_and_middle8default,
+              &count_and_middle16default<SWAP>, &count_and_middle16default<!SWAP>,
+              &skip_class8default, &casefold_prefix8default, &casefold8default,
+              &find_ge8default, &find_nonprint8default, &utf16_len8default,
+              &utf16_offset8default});
   return ret;
 #else
   static auto ret = SIMDImpl{
-      &len8default, &len16LEdefault, &len16BEdefault, &unitlen16default,
-      &unitlen32default};
+      &len8default,      &len16LEdefault,   &len16BEdefault,
+      &unitlen16default, &unitlen32default, &find8default,
+      &find16default,    &find32default,    &find_any8default,
+      &validate8default, &validate16default<SWAP>, &validate16default<!SWAP>,
+      &count_and_middle8default, &count_and_middle16default<SWAP>,
+      &count_and_middle16default<!SWAP>, &skip_class8default,
+      &casefold_prefix8default, &casefold8default, &find_ge8default,
+      &find_nonprint8default, &utf16_len8default, &utf16_offset8default};
   return ret;
 #endif // COLT_x86_64
 }
@@ -806,4 +3283,120 @@ size_t clt::uni::details::unitlen16(const char16_t* ptr) noexcept
 size_t clt::uni::details::unitlen32(const char32_t* ptr) noexcept
 {
   return get_colt_unicode_simd().unit32(ptr);
-}
\ No newline at end of file
+}
+const char8_t* clt::uni::details::find8(
+    const char8_t* begin, const char8_t* end, char8_t unit) noexcept
+{
+  return get_colt_unicode_simd().find8(begin, end, unit);
+}
+
+const char16_t* clt::uni::details::find16(
+    const char16_t* begin, const char16_t* end, char16_t unit) noexcept
+{
+  return get_colt_unicode_simd().find16(begin, end, unit);
+}
+
+const char32_t* clt::uni::details::find32(
+    const char32_t* begin, const char32_t* end, char32_t unit) noexcept
+{
+  return get_colt_unicode_simd().find32(begin, end, unit);
+}
+
+const char8_t* clt::uni::details::find_any8(
+    const char8_t* begin, const char8_t* end, const char8_t* units,
+    size_t count) noexcept
+{
+  assert_true("Too many units to search for!", count <= FIND_ANY_MAX);
+  return get_colt_unicode_simd().find_any8(begin, end, units, count);
+}
+
+clt::Option<clt::uni::LenInfo> clt::uni::details::validate8(
+    const char8_t* ptr, size_t size) noexcept
+{
+  return get_colt_unicode_simd().validate8(ptr, size);
+}
+
+clt::Option<clt::uni::LenInfo> clt::uni::details::validate16LE(
+    const char16_t* ptr, size_t size) noexcept
+{
+  return get_colt_unicode_simd().validate16le(ptr, size);
+}
+
+clt::Option<clt::uni::LenInfo> clt::uni::details::validate16BE(
+    const char16_t* ptr, size_t size) noexcept
+{
+  return get_colt_unicode_simd().validate16be(ptr, size);
+}
+
+std::pair<size_t, size_t> clt::uni::details::count_and_middle8(
+    const char8_t* ptr, size_t size) noexcept
+{
+  return get_colt_unicode_simd().count_and_middle8(ptr, size);
+}
+
+std::pair<size_t, size_t> clt::uni::details::count_and_middle16LE(
+    const char16_t* ptr, size_t size) noexcept
+{
+  return get_colt_unicode_simd().count_and_middle16le(ptr, size);
+}
+
+std::pair<size_t, size_t> clt::uni::details::count_and_middle16BE(
+    const char16_t* ptr, size_t size) noexcept
+{
+  return get_colt_unicode_simd().count_and_middle16be(ptr, size);
+}
+
+const char* clt::uni::details::find_first_not(
+    const char* begin, const char* end, CharClass cls) noexcept
+{
+  const auto& table = NIBBLE_TABLES[static_cast<size_t>(cls)];
+  const auto& simd  = get_colt_unicode_simd();
+  while (true)
+  {
+    begin = simd.skip_class8(begin, end, table);
+    if (begin == end || static_cast<u8>(*begin) < 0x80)
+      return begin;
+    // Non-ASCII byte: classify the code point using the property tables
+    auto ptr = ptr_to<const Char8*>(begin);
+    char32_t cp;
+    if (!checked_decode(ptr, ptr_to<const Char8*>(end), cp)
+        || !is_of_class32(cp, cls))
+      return begin;
+    begin = ptr_to<const char*>(ptr);
+  }
+}
+
+size_t clt::uni::details::casefold_prefix8(
+    const char* a, const char* b, size_t size) noexcept
+{
+  return get_colt_unicode_simd().casefold_prefix8(a, b, size);
+}
+
+size_t clt::uni::details::casefold8(
+    const char* from, size_t size, char* to) noexcept
+{
+  return get_colt_unicode_simd().casefold8(from, size, to);
+}
+
+const char8_t* clt::uni::details::find_ge8(
+    const char8_t* begin, const char8_t* end, char8_t unit) noexcept
+{
+  return get_colt_unicode_simd().find_ge8(begin, end, unit);
+}
+
+const char8_t* clt::uni::details::find_nonprint8(
+    const char8_t* begin, const char8_t* end) noexcept
+{
+  return get_colt_unicode_simd().find_nonprint8(begin, end);
+}
+
+size_t clt::uni::details::utf16_len8(const char8_t* ptr, size_t size) noexcept
+{
+  return get_colt_unicode_simd().utf16_len8(ptr, size);
+}
+
+size_t clt::uni::details::utf16_offset8(
+    const char8_t* ptr, size_t size, size_t utf16_offset) noexcept
+{
+  return get_colt_unicode_simd().utf16_offset8(ptr, size, utf16_offset);
+}
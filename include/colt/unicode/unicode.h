@@ -314,6 +314,80 @@ namespace clt
     //To see explanation, look at: 'clt::toupper'.
     return chr | (0b00100000 * static_cast<u8>(isupper(chr)));
   }
+
+  /// @brief Classes of characters recognized by the bulk classifiers
+  /// (see 'uni::count_leading' and 'uni::find_first_not').
+  enum class CharClass : u8
+  {
+    /// @brief Control characters (Cc for non-ASCII)
+    CNTRL,
+    /// @brief Digits (0-9, Nd for non-ASCII)
+    DIGIT,
+    /// @brief Lower case letters (Lowercase for non-ASCII)
+    LOWER,
+    /// @brief Upper case letters (Uppercase for non-ASCII)
+    UPPER,
+    /// @brief Letters (Alphabetic for non-ASCII)
+    ALPHA,
+    /// @brief Letters or digits
+    ALNUM,
+    /// @brief Punctuation characters (P* for non-ASCII)
+    PUNCT,
+    /// @brief Characters with a graphical representation
+    GRAPH,
+    /// @brief Whitespaces (White_Space for non-ASCII)
+    SPACE,
+    /// @brief Space or horizontal tab (Zs for non-ASCII)
+    BLANK,
+    /// @brief Letters or '_' (XID_Start for non-ASCII)
+    IDENT_START,
+    /// @brief Letters, digits or '_' (XID_Continue for non-ASCII)
+    IDENT_CONTINUE,
+    /// @brief Any ASCII character (never true for non-ASCII)
+    ASCII,
+  };
+
+  /// @brief The number of values of CharClass
+  static constexpr size_t CHAR_CLASS_COUNT =
+      static_cast<size_t>(CharClass::ASCII) + 1;
+
+  /// @brief Checks if an ASCII character is of class 'cls'.
+  /// Locale independent: returns false for any non-ASCII character.
+  /// @param chr The character to check
+  /// @param cls The class of character
+  /// @return True if the character is of class 'cls'
+  constexpr bool is_of_class(char chr, CharClass cls) noexcept
+  {
+    switch_no_default(cls)
+    {
+    case CharClass::CNTRL:
+      return iscntrl(chr);
+    case CharClass::DIGIT:
+      return isdigit(chr);
+    case CharClass::LOWER:
+      return islower(chr);
+    case CharClass::UPPER:
+      return isupper(chr);
+    case CharClass::ALPHA:
+      return isalpha(chr);
+    case CharClass::ALNUM:
+      return isalnum(chr);
+    case CharClass::PUNCT:
+      return ispunct(chr);
+    case CharClass::GRAPH:
+      return isgraph(chr);
+    case CharClass::SPACE:
+      return isspace(chr);
+    case CharClass::BLANK:
+      return isblank(chr);
+    case CharClass::IDENT_START:
+      return isalpha(chr) || chr == '_';
+    case CharClass::IDENT_CONTINUE:
+      return isalnum(chr) || chr == '_';
+    case CharClass::ASCII:
+      return static_cast<u8>(chr) < 0x80;
+    }
+  }
 } // namespace clt
 
 namespace clt::uni
@@ -427,6 +501,33 @@ namespace clt::uni
     requires(meta::CppCharType<T> || meta::CharType<T>)
   constexpr size_t countlen(const T* start, size_t units) noexcept;
 
+  /// @brief Returns the number of UTF16 units needed to encode a UTF8 string.
+  /// This is the UTF16 offset of the UTF8 offset 'units' (as used by the
+  /// Language Server Protocol).
+  /// @warning The string must be valid UTF8
+  /// @tparam T The UTF8 char type
+  /// @param start The start of the string
+  /// @param units The unit count
+  /// @return The number of UTF16 units
+  template<typename T>
+    requires(meta::is_any_of<T, char8_t, Char8>)
+  constexpr size_t utf16_len(const T* start, size_t units) noexcept;
+
+  /// @brief Returns the UTF8 offset of a UTF16 offset of a UTF8 string.
+  /// If 'utf16_offset' is in the middle of a surrogate pair, the offset of
+  /// the code point encoded by the pair is returned.
+  /// @warning The string must be valid UTF8
+  /// @tparam T The UTF8 char type
+  /// @param start The start of the string
+  /// @param units The unit count
+  /// @param utf16_offset The offset in UTF16 units
+  /// @return The offset in units of the code point (or 'units' if
+  ///         'utf16_offset' is not less than the UTF16 length of the string)
+  template<typename T>
+    requires(meta::is_any_of<T, char8_t, Char8>)
+  constexpr size_t utf16_to_utf8_offset(
+      const T* start, size_t units, size_t utf16_offset) noexcept;
+
   /// @brief Returns the number of code points of a NUL-terminated string
   /// @tparam T The char type
   /// @param start The string whose length to determine
@@ -485,8 +586,279 @@ namespace clt::uni
     /// @param ptr The NUL-terminated string whose unit count to return
     /// @return Return the count of char32_t forming the string
     COLTCPP_EXPORT size_t unitlen32(const char32_t* ptr) noexcept;
+
+    /// @brief The maximum number of units that can be searched for by 'find_any8'
+    static constexpr size_t FIND_ANY_MAX = 16;
+
+    /// @brief Optimized search of a byte in [begin, end).
+    /// The implementation uses SIMD instructions.
+    /// @param begin The start of the range
+    /// @param end The end of the range
+    /// @param unit The byte to search for
+    /// @return Pointer to the first byte equal to 'unit' or 'end'
+    COLTCPP_EXPORT const char8_t* find8(
+        const char8_t* begin, const char8_t* end, char8_t unit) noexcept;
+    /// @brief Optimized search of a 16-bit unit in [begin, end).
+    /// The unit is compared as is: it must be in the same endianness
+    /// as the range.
+    /// The implementation uses SIMD instructions.
+    /// @param begin The start of the range
+    /// @param end The end of the range
+    /// @param unit The 16-bit unit to search for
+    /// @return Pointer to the first unit equal to 'unit' or 'end'
+    COLTCPP_EXPORT const char16_t* find16(
+        const char16_t* begin, const char16_t* end, char16_t unit) noexcept;
+    /// @brief Optimized search of a 32-bit unit in [begin, end).
+    /// The unit is compared as is: it must be in the same endianness
+    /// as the range.
+    /// The implementation uses SIMD instructions.
+    /// @param begin The start of the range
+    /// @param end The end of the range
+    /// @param unit The 32-bit unit to search for
+    /// @return Pointer to the first unit equal to 'unit' or 'end'
+    COLTCPP_EXPORT const char32_t* find32(
+        const char32_t* begin, const char32_t* end, char32_t unit) noexcept;
+    /// @brief Optimized search of any of 'count' bytes in [begin, end).
+    /// The implementation uses SIMD instructions.
+    /// @pre count <= FIND_ANY_MAX
+    /// @param begin The start of the range
+    /// @param end The end of the range
+    /// @param units The bytes to search for
+    /// @param count The number of bytes to search for
+    /// @return Pointer to the first byte equal to any of 'units' or 'end'
+    COLTCPP_EXPORT const char8_t* find_any8(
+        const char8_t* begin, const char8_t* end, const char8_t* units,
+        size_t count) noexcept;
+
+    /// @brief Optimized validation of UTF8.
+    /// The implementation uses SIMD instructions.
+    /// @param ptr The start of the units to validate
+    /// @param size The number of units to validate
+    /// @return None if invalid UTF8, else the code point and unit count
+    COLTCPP_EXPORT Option<LenInfo> validate8(
+        const char8_t* ptr, size_t size) noexcept;
+    /// @brief Optimized validation of UTF16LE.
+    /// The implementation uses SIMD instructions.
+    /// @param ptr The start of the units to validate
+    /// @param size The number of units to validate
+    /// @return None if invalid UTF16LE, else the code point and unit count
+    COLTCPP_EXPORT Option<LenInfo> validate16LE(
+        const char16_t* ptr, size_t size) noexcept;
+    /// @brief Optimized validation of UTF16BE.
+    /// The implementation uses SIMD instructions.
+    /// @param ptr The start of the units to validate
+    /// @param size The number of units to validate
+    /// @return None if invalid UTF16BE, else the code point and unit count
+    COLTCPP_EXPORT Option<LenInfo> validate16BE(
+        const char16_t* ptr, size_t size) noexcept;
+
+    /// @brief Optimized count_and_middle for UTF8.
+    /// The implementation uses SIMD instructions.
+    /// @param ptr The start of the units
+    /// @param size The number of units
+    /// @return The code point count and the offset to the middle code point
+    COLTCPP_EXPORT std::pair<size_t, size_t> count_and_middle8(
+        const char8_t* ptr, size_t size) noexcept;
+    /// @brief Optimized count_and_middle for UTF16LE.
+    /// The implementation uses SIMD instructions.
+    /// @param ptr The start of the units
+    /// @param size The number of units
+    /// @return The code point count and the offset to the middle code point
+    COLTCPP_EXPORT std::pair<size_t, size_t> count_and_middle16LE(
+        const char16_t* ptr, size_t size) noexcept;
+    /// @brief Optimized count_and_middle for UTF16BE.
+    /// The implementation uses SIMD instructions.
+    /// @param ptr The start of the units
+    /// @param size The number of units
+    /// @return The code point count and the offset to the middle code point
+    COLTCPP_EXPORT std::pair<size_t, size_t> count_and_middle16BE(
+        const char16_t* ptr, size_t size) noexcept;
+
+    /// @brief Optimized search of the first character not of class 'cls'.
+    /// ASCII characters are classified using SIMD nibble lookups, and
+    /// the property tables are only used when a non-ASCII byte is hit.
+    /// @param begin The start of the UTF8 range
+    /// @param end The end of the UTF8 range
+    /// @param cls The class of character
+    /// @return Pointer to the first character not of class 'cls' or 'end'
+    COLTCPP_EXPORT const char* find_first_not(
+        const char* begin, const char* end, CharClass cls) noexcept;
+
+    /// @brief Optimized search of the case-insensitive common ASCII prefix.
+    /// Only the ASCII letters are folded: this stops on the first unit that
+    /// differs once folded, or that is not ASCII in either of the ranges.
+    /// @param a The first range
+    /// @param b The second range
+    /// @param size The number of units of both ranges
+    /// @return The count of units of the common prefix
+    COLTCPP_EXPORT size_t casefold_prefix8(
+        const char* a, const char* b, size_t size) noexcept;
+
+    /// @brief Optimized case folding of the leading ASCII units of a range.
+    /// This stops on the first unit that is not ASCII.
+    /// @param from The range to fold
+    /// @param size The number of units of 'from'
+    /// @param to The output (must have space for 'size' units, the ones after
+    ///           the returned count may be overwritten)
+    /// @return The count of units folded
+    COLTCPP_EXPORT size_t casefold8(
+        const char* from, size_t size, char* to) noexcept;
+
+    /// @brief Optimized search of a byte greater or equal to 'unit' in [begin, end).
+    /// The implementation uses SIMD instructions.
+    /// @param begin The start of the range
+    /// @param end The end of the range
+    /// @param unit The (unsigned) bound to search for
+    /// @return Pointer to the first byte greater or equal to 'unit' or 'end'
+    COLTCPP_EXPORT const char8_t* find_ge8(
+        const char8_t* begin, const char8_t* end, char8_t unit) noexcept;
+
+    /// @brief Optimized search of a byte that is not printable ASCII
+    ///        (in [0x20, 0x7E]) in [begin, end).
+    /// The implementation uses SIMD instructions.
+    /// @param begin The start of the range
+    /// @param end The end of the range
+    /// @return Pointer to the first byte that is not printable ASCII or 'end'
+    COLTCPP_EXPORT const char8_t* find_nonprint8(
+        const char8_t* begin, const char8_t* end) noexcept;
+
+    /// @brief Optimized count of the UTF16 units needed to encode the
+    ///        code points starting in [ptr, ptr + size).
+    /// The implementation uses SIMD instructions.
+    /// @param ptr The start of the UTF8 range
+    /// @param size The size in bytes of the range
+    /// @return The number of UTF16 units
+    COLTCPP_EXPORT size_t utf16_len8(const char8_t* ptr, size_t size) noexcept;
+
+    /// @brief Optimized search of the code point containing a UTF16 unit.
+    /// The implementation uses SIMD instructions.
+    /// @param ptr The start of the UTF8 range
+    /// @param size The size in bytes of the range
+    /// @param utf16_offset The index of the UTF16 unit
+    /// @return The offset of the code point, or 'size'
+    COLTCPP_EXPORT size_t utf16_offset8(
+        const char8_t* ptr, size_t size, size_t utf16_offset) noexcept;
+
+    /// @brief Decodes a single code point, validating the sequence.
+    /// Rejects overlong UTF8, surrogates and values over CODE_POINT_MAX.
+    /// @tparam From The source char type
+    /// @param from The start of the sequence (advanced on success)
+    /// @param end The end of the input
+    /// @param result The result in which to write the code point
+    /// @return True on success, false on invalid input
+    template<meta::CharType From>
+    constexpr bool checked_decode(
+        const From*& from, const From* end, char32_t& result) noexcept
+    {
+      if constexpr (std::same_as<From, char>)
+      {
+        if (static_cast<u8>(*from) > 0x7F)
+          return false;
+        result = static_cast<char32_t>(*from++);
+        return true;
+      }
+      if constexpr (std::same_as<From, Char8>)
+      {
+        const u8 lead = *from;
+        if (lead < 0x80) [[likely]]
+        {
+          result = lead;
+          ++from;
+          return true;
+        }
+        // The minimum code point of each sequence length (to reject overlong)
+        constexpr u32 MIN_CP[5] = {0, 0, 0x80, 0x800, 0x10000};
+        u32 size;
+        u32 cp;
+        if ((lead >> 5) == 0b110)
+          size = 2, cp = lead & 0x1F;
+        else if ((lead >> 4) == 0b1110)
+          size = 3, cp = lead & 0x0F;
+        else if ((lead >> 3) == 0b11110)
+          size = 4, cp = lead & 0x07;
+        else
+          return false;
+        if (static_cast<size_t>(end - from) < size)
+          return false;
+        for (u32 i = 1; i < size; i++)
+        {
+          if (!from[i].is_trail())
+            return false;
+          cp = (cp << 6) | (from[i] & 0x3F);
+        }
+        if (cp < MIN_CP[size] || cp > CODE_POINT_MAX
+            || (cp >= LEAD_SURROGATE_MIN && cp <= TRAIL_SURROGATE_MAX))
+          return false;
+        result = cp;
+        from += size;
+        return true;
+      }
+      if constexpr (meta::is_any_of<From, Char16LE, Char16BE>)
+      {
+        const char16_t first = from->as_host();
+        if (is_trail_surrogate(first))
+          return false;
+        if (!is_lead_surrogate(first)) [[likely]]
+        {
+          result = first;
+          ++from;
+          return true;
+        }
+        if (end - from < 2 || !from[1].is_trail_surrogate())
+          return false;
+        result = surrogate_to_cp(first, from[1].as_host());
+        from += 2;
+        return true;
+      }
+      if constexpr (meta::is_any_of<From, Char32LE, Char32BE>)
+      {
+        const char32_t cp = from->as_host();
+        if (cp > CODE_POINT_MAX
+            || (cp >= LEAD_SURROGATE_MIN && cp <= TRAIL_SURROGATE_MAX))
+          return false;
+        result = cp;
+        ++from;
+        return true;
+      }
+    }
   } // namespace details
 
+  /// @brief Returns the first character of 'view' that is not of class 'cls'.
+  /// The view is treated as UTF8: for ASCII characters, this is equivalent
+  /// to 'is_of_class', and non-ASCII code points are classified using the
+  /// Unicode property of 'cls' (XID_Continue for IDENT_CONTINUE...).
+  /// Invalid UTF8 is never part of any class.
+  /// The implementation uses SIMD instructions.
+  /// @param view The UTF8 view to search
+  /// @param cls The class of character
+  /// @return Pointer to the first character not of class 'cls' or the end of 'view'
+  inline const char* find_first_not(View<char> view, CharClass cls) noexcept
+  {
+    return details::find_first_not(view.data(), view.data() + view.size(), cls);
+  }
+
+  /// @brief Returns the count of leading units of 'view' that are of class 'cls'.
+  /// This is useful for skipping whitespaces or identifiers in a lexer.
+  /// @param view The UTF8 view to search
+  /// @param cls The class of character
+  /// @return The count of units (not code points) of class 'cls'
+  inline size_t count_leading(View<char> view, CharClass cls) noexcept
+  {
+    return find_first_not(view, cls) - view.data();
+  }
+
+  /// @brief Validates 'units' units starting at 'start'.
+  /// Overlong UTF8, unpaired surrogates and values over CODE_POINT_MAX
+  /// are rejected.
+  /// The LenInfo is computed in the same pass as the validation,
+  /// so no additional counting is required.
+  /// @tparam T The char type
+  /// @param start The start of the units
+  /// @param units The unit count
+  /// @return None if invalid, else the code point and unit count
+  template<meta::CharType T>
+  constexpr Option<LenInfo> validate(const T* start, size_t units) noexcept;
+
   /// @brief Iterator over Unicode encoded strings
   /// @tparam ENCODING The encoding
   template<StringEncoding ENCODING>
@@ -820,7 +1192,8 @@ namespace clt::uni
       auto ptr = _ptr;
       while (_index != 0)
       {
-        ptr -= 1 + uni::is_trail_surrogate(*ptr);
+        --ptr;
+        ptr -= uni::is_trail_surrogate(*ptr);
         --_index;
       }
       return ptr;
@@ -859,6 +1232,24 @@ namespace clt::uni
   {
     if constexpr (meta::is_any_of<T, char, char32_t, Char32BE, Char32LE>)
       return {unit_len, unit_len / 2};
+    if (!std::is_constant_evaluated())
+    {
+      if constexpr (meta::is_any_of<T, char8_t, Char8>)
+        return details::count_and_middle8(ptr_to<const char8_t*>(start), unit_len);
+      if constexpr (std::same_as<T, Char16LE>)
+        return details::count_and_middle16LE(
+            ptr_to<const char16_t*>(start), unit_len);
+      if constexpr (std::same_as<T, Char16BE>)
+        return details::count_and_middle16BE(
+            ptr_to<const char16_t*>(start), unit_len);
+      if constexpr (std::same_as<T, char16_t>)
+      {
+        if constexpr (StringEncoding::UTF16 == StringEncoding::UTF16LE)
+          return details::count_and_middle16LE(start, unit_len);
+        else
+          return details::count_and_middle16BE(start, unit_len);
+      }
+    }
 
     auto second = start + unit_len / 2;
     // Correct pointer
@@ -920,6 +1311,93 @@ namespace clt::uni
       return simdutf::count_utf8(ptr_to<const char*>(start), unit_len);
   }
 
+  template<typename T>
+    requires(meta::is_any_of<T, char8_t, Char8>)
+  constexpr size_t utf16_len(const T* start, size_t units) noexcept
+  {
+    if (!std::is_constant_evaluated())
+      return details::utf16_len8(ptr_to<const char8_t*>(start), units);
+
+    // The units of a code point are attributed to its first byte
+    size_t result = 0;
+    for (size_t i = 0; i < units; i++)
+    {
+      const char8_t unit = start[i];
+      result += (size_t)!is_trail(unit) + (size_t)(unit >= 0xF0);
+    }
+    return result;
+  }
+
+  template<typename T>
+    requires(meta::is_any_of<T, char8_t, Char8>)
+  constexpr size_t utf16_to_utf8_offset(
+      const T* start, size_t units, size_t utf16_offset) noexcept
+  {
+    if (!std::is_constant_evaluated())
+    {
+      return details::utf16_offset8(
+          ptr_to<const char8_t*>(start), units, utf16_offset);
+    }
+
+    size_t index = 0;
+    for (size_t i = 0; i < units; i++)
+    {
+      const char8_t unit = start[i];
+      if (is_trail(unit))
+        continue;
+      index += 1 + (size_t)(unit >= 0xF0);
+      if (index > utf16_offset)
+        return i;
+    }
+    return units;
+  }
+
+  template<meta::CharType T>
+  constexpr Option<LenInfo> validate(const T* start, size_t units) noexcept
+  {
+    assert_true(
+        "ptr cannot be null if units != 0!", implies(start == nullptr, units == 0));
+    if (std::is_constant_evaluated())
+    {
+      const T* end  = start + units;
+      size_t result = 0;
+      char32_t cp;
+      while (start != end)
+      {
+        if (!details::checked_decode(start, end, cp))
+          return None;
+        ++result;
+      }
+      return LenInfo{result, units};
+    }
+    else if constexpr (std::same_as<T, char>)
+    {
+      if (!simdutf::validate_ascii(start, units))
+        return None;
+      return LenInfo{units, units};
+    }
+    else if constexpr (std::same_as<T, Char8>)
+      return details::validate8(ptr_to<const char8_t*>(start), units);
+    else if constexpr (std::same_as<T, Char16LE>)
+      return details::validate16LE(ptr_to<const char16_t*>(start), units);
+    else if constexpr (std::same_as<T, Char16BE>)
+      return details::validate16BE(ptr_to<const char16_t*>(start), units);
+    else
+    {
+      // No need for SIMD: the loop is easily vectorized
+      bool invalid = false;
+      for (size_t i = 0; i < units; i++)
+      {
+        const char32_t cp = start[i].as_host();
+        invalid |= cp > CODE_POINT_MAX
+                   || (cp >= LEAD_SURROGATE_MIN && cp <= TRAIL_SURROGATE_MAX);
+      }
+      if (invalid)
+        return None;
+      return LenInfo{units, units};
+    }
+  }
+
   template<typename T>
     requires(meta::CppCharType<T> || meta::CharType<T>)
   constexpr size_t strlen(const T* start) noexcept
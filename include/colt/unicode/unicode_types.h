@@ -152,7 +152,7 @@ namespace clt
         return 2;
       else if ((_value >> 4) == 0b1110)
         return 3;
-      if ((_value >> 3) == 0b1110)
+      if ((_value >> 3) == 0b11110)
         return 4;
       return 1;
     }
@@ -231,7 +231,7 @@ namespace clt
         return 2;
       else if ((_value >> 4) == 0b1110)
         return 3;
-      if ((_value >> 3) == 0b1110)
+      if ((_value >> 3) == 0b11110)
         return 4;
       if constexpr (SAFE)
         return None;
@@ -0,0 +1,82 @@
+"""Runs 'coltcpp_bench' once per SIMD instruction set and merges the results.
+
+SIMD implementations are chosen once per process: each instruction set
+supported by the CPU is forced in its own run (through '--simd'), and the
+results are merged in a single JSON document:
+  {"runs": [{"simd": "AVX2", "context": ..., "dispatches": ..., "benchmarks": ...}]}
+
+Usage:
+  python run_benchmarks.py <path/to/coltcpp_bench> [-o results.json] [bench options]
+The options following the output are forwarded to each run (such as
+'--filter uni::' or '--min-time 50').
+"""
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+# The instruction sets used by the kernels of the library, in the order
+# in which they are preferred (DEFAULT is always run).
+SIMD_TIERS = ["DEFAULT", "SSE42", "AVX2", "NEON", "SVE", "SVE2"]
+
+def run(bench, simd, options):
+  """Runs the benchmarks with the implementations restricted to 'simd'.
+
+  Args:
+      bench (str): The path of the benchmark executable
+      simd (str|None): The allowed instruction sets (None for all)
+      options (list[str]): The options forwarded to the executable
+
+  Returns:
+      dict: The JSON document written by the executable
+  """
+  fd, path = tempfile.mkstemp(suffix=".json")
+  os.close(fd)
+  try:
+    args = [bench, "--json", path] + options
+    if simd is not None:
+      args += ["--simd", simd]
+    subprocess.run(args, check=True)
+    with open(path, "r", encoding="utf-8") as file:
+      return json.load(file)
+  finally:
+    os.remove(path)
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__,
+                                   formatter_class=argparse.RawDescriptionHelpFormatter)
+  parser.add_argument("bench", help="path of the 'coltcpp_bench' executable")
+  parser.add_argument("-o", "--output", default="benchmarks.json",
+                      help="path of the merged JSON results")
+  args, options = parser.parse_known_args()
+
+  # A run without benchmarks reports the instruction sets of the CPU
+  hardware = run(args.bench, None, ["--filter", "\x01"])["context"]["hardware_simd"]
+  supported = set(hardware.split("|"))
+  tiers = [tier for tier in SIMD_TIERS if tier == "DEFAULT" or tier in supported]
+
+  runs = []
+  for tier in tiers:
+    print(f"Running with SIMD restricted to '{tier}'...", file=sys.stderr)
+    result = run(args.bench, tier, options)
+    result["simd"] = tier
+    runs.append(result)
+
+  with open(args.output, "w", encoding="utf-8") as file:
+    json.dump({"runs": runs}, file, indent=2)
+
+  # Speedup of each tier over DEFAULT
+  baseline = {(b["name"], b["size"]): b["ns_per_iter"] for b in runs[0]["benchmarks"]}
+  print(f"{'benchmark':<44}{'size':>9}" + "".join(f"{t:>10}" for t in tiers))
+  for bench in runs[0]["benchmarks"]:
+    key = (bench["name"], bench["size"])
+    line = f"{bench['name']:<44}{bench['size']:>9}"
+    for result in runs:
+      times = {(b["name"], b["size"]): b["ns_per_iter"] for b in result["benchmarks"]}
+      line += f"{baseline[key] / times[key]:>9.2f}x" if key in times else f"{'-':>10}"
+    print(line)
+
+if __name__ == "__main__":
+  main()
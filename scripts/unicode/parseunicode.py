@@ -236,4 +236,82 @@ def is_assigned_character(x: CodePointInfo)->bool:
   return (x.get("General_Category") != "Cn"
     and x.get("General_Category") != "Co"
     and x.get("General_Category") != "Cs"
-  )
\ No newline at end of file
+  )
+
+@dataclasses.dataclass
+class PropertyRanges:
+  DEFAULTS : list[tuple[CodePointRange, str]]
+  RANGES   : list[tuple[CodePointRange, str]]
+
+@functools.cache
+def parse_property_file(path: str, is_single_property: bool = False)->dict[str, PropertyRanges]:
+  """Parses a property file whose lines are either `range ; property` (for binary
+  properties) or `range ; property ; value` (for enumerated properties).
+  If `is_single_property`, the lines are of the form `range ; value`, as the file
+  only contains a single enumerated property (such as `Scripts.txt`): the name
+  of that property is then an empty string.
+
+  Args:
+      path (str): The path of the file relative to the UCD folder
+      is_single_property (bool): True if the file only contains a single property
+
+  Returns:
+      dict[str, PropertyRanges]: The property name to its default values and ranges
+  """
+  PROPERTY_LIST : dict[str, PropertyRanges] = dict()
+  def add(split: list[str], to_defaults: bool):
+    RANGE = CodePointRange.from_str(split[0])
+    if is_single_property:
+      NAME, VALUE = "", split[1]
+    else:
+      NAME, VALUE = split[1], (split[2] if len(split) == 3 else None)
+    if NAME not in PROPERTY_LIST:
+      PROPERTY_LIST[NAME] = PropertyRanges([], [])
+    if to_defaults:
+      PROPERTY_LIST[NAME].DEFAULTS.append((RANGE, VALUE))
+    else:
+      PROPERTY_LIST[NAME].RANGES.append((RANGE, VALUE))
+
+  for line in colt.lines_of(PATH_UCD + path, True, False):
+    if line.startswith("# @missing: "):
+      add([i.strip() for i in line[12:].split(';')], True)
+    else:
+      add([i.strip() for i in line.split('#')[0].split(';')], False)
+  return PROPERTY_LIST
+
+@functools.cache
+def parse_casefolding()->dict[int, list[int]]:
+  """Parses the full case folding of `CaseFolding.txt` (statuses C and F).
+  The simple (S) and Turkic (T) mappings are ignored.
+
+  Returns:
+      dict[int, list[int]]: The code point to the code points it folds to
+  """
+  MAPPINGS : dict[int, list[int]] = dict()
+  for line in colt.lines_of(PATH_UCD + 'CaseFolding.txt'):
+    split = [i.strip() for i in line.split('#')[0].split(';')]
+    if split[1] not in ('C', 'F'):
+      continue
+    MAPPINGS[CodePoint.from_str(split[0]).value] = [
+      CodePoint.from_str(i).value for i in split[2].split()
+    ]
+  return MAPPINGS
+
+@functools.cache
+def parse_canonical_decompositions()->dict[int, list[int]]:
+  """Parses the (single-level) canonical decomposition mappings of `UnicodeData.txt`.
+  The compatibility mappings (whose mapping start with a `<tag>`) are ignored,
+  as are the Hangul syllables, whose decompositions are algorithmic.
+
+  Returns:
+      dict[int, list[int]]: The code point to the code points it decomposes to
+  """
+  MAPPINGS : dict[int, list[int]] = dict()
+  for line in colt.lines_of(PATH_UCD + 'UnicodeData.txt'):
+    split = [i.strip() for i in line.split(';')]
+    if len(split[5]) == 0 or split[5].startswith('<'):
+      continue
+    MAPPINGS[CodePoint.from_str(split[0]).value] = [
+      CodePoint.from_str(i).value for i in split[5].split()
+    ]
+  return MAPPINGS
@@ -0,0 +1,98 @@
+import dataclasses
+from colt import CodePoint
+
+# Count of code points covered by a trie
+CODE_POINT_COUNT = CodePoint.max_code_point() + 1
+
+def bytes_of(max_value: int)->int:
+  """Returns the size of the smallest unsigned integer that can hold 'max_value'
+
+  Args:
+      max_value (int): The max value to store
+
+  Returns:
+      int: 1, 2, 4 or 8
+  """
+  if max_value < 2**8:
+    return 1
+  if max_value < 2**16:
+    return 2
+  if max_value < 2**32:
+    return 4
+  return 8
+
+def deduplicate(values: list[int], block_size: int)->tuple[list[int], list[int]]:
+  """Splits 'values' in blocks of 'block_size' and removes all duplicate blocks.
+  Blocks are stored in the order they are first seen, which means that the
+  first block of the result is always the first block of 'values'.
+
+  Args:
+      values (list[int]): The values to split (len must be a multiple of block_size)
+      block_size (int): The size of a block
+
+  Returns:
+      tuple[list[int], list[int]]: The block index of each block, the unique blocks
+  """
+  assert len(values) % block_size == 0
+  BLOCKS  : dict[tuple, int] = dict()
+  INDICES : list[int] = []
+  DATA    : list[int] = []
+  for i in range(0, len(values), block_size):
+    block = tuple(values[i:i + block_size])
+    index = BLOCKS.get(block)
+    if index is None:
+      index = len(BLOCKS)
+      BLOCKS[block] = index
+      DATA.extend(block)
+    INDICES.append(index)
+  return INDICES, DATA
+
+@dataclasses.dataclass
+class Trie:
+  LEAF_BITS : int
+  MID_BITS  : int
+  TOP       : list[int]
+  MID       : list[int]
+  LEAF      : list[int]
+
+  def size(self)->int:
+    """Returns the size in bytes of the trie's tables"""
+    return (len(self.TOP) * bytes_of(max(self.TOP))
+      + len(self.MID) * bytes_of(max(self.MID))
+      + len(self.LEAF) * bytes_of(max(self.LEAF)))
+
+  def lookup(self, code_point: int)->int:
+    """Looks up the value of a code point (used to verify the trie)"""
+    MID_MASK  = (1 << self.MID_BITS) - 1
+    LEAF_MASK = (1 << self.LEAF_BITS) - 1
+    mid  = self.TOP[code_point >> (self.LEAF_BITS + self.MID_BITS)]
+    leaf = self.MID[(mid << self.MID_BITS) | ((code_point >> self.LEAF_BITS) & MID_MASK)]
+    return self.LEAF[(leaf << self.LEAF_BITS) | (code_point & LEAF_MASK)]
+
+def build_trie(values: list[int])->Trie:
+  """Builds the smallest three-stage trie mapping a code point to its value.
+  The code point is split as [top | mid | leaf] bits: the top bits index
+  into the top table which gives the mid block, the mid bits index into
+  that block which gives the leaf block, whose leaf bits give the value.
+  As blocks are stored in the order they are first seen, the first leaf
+  block always contains the values of the code points [0, 2^LEAF_BITS).
+
+  Args:
+      values (list[int]): The value of each code point
+
+  Returns:
+      Trie: The smallest trie found
+  """
+  assert len(values) == CODE_POINT_COUNT
+  best = None
+  for leaf_bits in range(3, 10):
+    LEAF_INDICES, LEAF = deduplicate(values, 1 << leaf_bits)
+    # 0x110000 is 17 * 2^16: the split must not cross 2^16
+    for mid_bits in range(0, min(8, 16 - leaf_bits) + 1):
+      TOP, MID = deduplicate(LEAF_INDICES, 1 << mid_bits)
+      current = Trie(leaf_bits, mid_bits, TOP, MID, LEAF)
+      if best is None or current.size() < best.size():
+        best = current
+  for i in range(0, CODE_POINT_COUNT):
+    assert best.lookup(i) == values[i]
+  return best
@@ -4,6 +4,7 @@ from colt import frac
 from colt import CodePoint
 from colt import CodePointRange
 import time
+import trie
 
 def time_fn(fn, *args, **kwargs):
   start = time.time()
@@ -26,29 +27,52 @@ def canonicalize_identifier(identifier: str):
     identifier = "_" + identifier
   return identifier.replace('.', '_').replace('-', '_').strip()
 
-def write_properties_as_cxx(PROPERTIES: dict[str, parseunicode.Property], ALLALIASES: dict[str, str]):
+def enum_keys(value: parseunicode.Property)->list[tuple[str, str]]:
+  """Returns the (key, primary key) of the enum generated for a property.
+  A key whose primary key is itself is an enumerator, the others are aliases.
+  """
+  used_key = set()
+  KEYS = []
+  for k, v in value.KEYS.items():
+    k, v = canonicalize_identifier(k), canonicalize_identifier(v)
+    if k in used_key:
+      continue
+    KEYS.append((k, v))
+    used_key.add(k)
+  return KEYS
+
+def enum_values(value: parseunicode.Property)->dict[str, int]:
+  """Returns the integral value of each key of the enum generated for a property"""
+  VALUES = dict()
+  for k, v in enum_keys(value):
+    if k == v:
+      VALUES[k] = len(VALUES)
+  for k, v in enum_keys(value):
+    VALUES[k] = VALUES[v]
+  return VALUES
+
+def enum_underlying_type(value: parseunicode.Property)->str:
+  COUNT = len([k for k, v in enum_keys(value) if k == v])
+  return f"uint{round_to_nearest_bits(COUNT)}_t"
+
+def write_properties_as_cxx(PROPERTIES: dict[str, parseunicode.Property], ALLALIASES: dict[str, str], ACCESSORS: list[str]):
   with open("../../include/colt/unicode/properties.h", "w") as file:
     print("// !! Generated by unicodedata_to_cxx.py !!", file=file)
     print(f"#ifndef __COLT_UNICODE_PROPERTIES__\n#define __COLT_UNICODE_PROPERTIES__\n\n#include <cstdint>\n", file=file)
+    print(f"#include \"colt/typedefs.h\"\n#include \"gen/property_tables.h\"\n", file=file)
     print("namespace clt::uni {", file=file)
     for key, value in PROPERTIES.items():
       if len(value.KEYS) == 0:
         continue
       print(f"enum class {value.FULLNAME}", file=file, end='')
       str = ""
-      i = 0
-      used_key = set()
-      for k, v in value.KEYS.items():
-        k, v = canonicalize_identifier(k), canonicalize_identifier(v)
-        if k in used_key:# or '#' in k:
-          continue
+      VALUES = enum_values(value)
+      for k, v in enum_keys(value):
         if k == v:
-          str += f"  {k} = {i},\n"
-          i += 1
+          str += f"  {k} = {VALUES[k]},\n"
         else:
           str += f"  {k} = {v},\n"
-        used_key.add(k)
-      print(f" : uint{round_to_nearest_bits(i)}_t {{", file=file)
+      print(f" : {enum_underlying_type(value)} {{", file=file)
       print(str, file=file, end='')
       print("};",file=file)
       if key != value.FULLNAME:
@@ -59,16 +83,351 @@ def write_properties_as_cxx(PROPERTIES: dict[str, parseunicode.Property], ALLALI
         for k, v in value.GROUP_FN.items():
           print(f"constexpr bool is_{value.FULLNAME.strip()}_{k}({value.FULLNAME.strip()} c) noexcept {{", file=file)
           print(f"  using enum {value.FULLNAME};\n  return clt::is_one_of(c, {', '.join(v)});\n}}\n", file=file)
+    print("""/// @brief Returns the value of an enumerated or binary property of a code point.
+/// The lookup is done in constant time using the generated tables.
+/// @code{.cpp}
+/// static_assert(uni::get<General_Category>(U'A') == General_Category::Lu);
+/// @endcode
+/// @tparam Prop The property (General_Category, Script, XID_Start...)
+/// @param code_point The code point
+/// @return The value of the property
+template<typename Prop>
+constexpr Prop get(char32_t code_point) noexcept = delete;
+
+/// @brief Check if a code point has a binary property.
+/// The hot properties (XID_Start, XID_Continue, White_Space...) are bit-packed
+/// in the same table, so that checking any of them is at most three loads.
+/// @tparam Prop The binary property (XID_Start, White_Space...)
+/// @param code_point The code point
+/// @return True if the code point has the property
+template<typename Prop>
+constexpr bool has(char32_t code_point) noexcept = delete;
+""", file=file)
+    for accessor in ACCESSORS:
+      print(accessor, file=file)
     print("} // namespace clt::uni\n\n#endif // !__COLT_UNICODE_PROPERTIES__", file=file)
   
 
+
+# Enumerated properties for which a lookup table is generated:
+# (property, file relative to the UCD folder, property name in the file).
+# An empty property name means that the file only contains that property.
+ENUMERATED_PROPERTIES = [
+  ("General_Category", "extracted/DerivedGeneralCategory.txt", ""),
+  ("Canonical_Combining_Class", "extracted/DerivedCombiningClass.txt", ""),
+  ("Bidi_Class", "extracted/DerivedBidiClass.txt", ""),
+  ("Decomposition_Type", "extracted/DerivedDecompositionType.txt", ""),
+  ("Numeric_Type", "extracted/DerivedNumericType.txt", ""),
+  ("East_Asian_Width", "extracted/DerivedEastAsianWidth.txt", ""),
+  ("Line_Break", "extracted/DerivedLineBreak.txt", ""),
+  ("Joining_Type", "extracted/DerivedJoiningType.txt", ""),
+  ("Joining_Group", "extracted/DerivedJoiningGroup.txt", ""),
+  ("Script", "Scripts.txt", ""),
+  ("Block", "Blocks.txt", ""),
+  ("Age", "DerivedAge.txt", ""),
+  ("Hangul_Syllable_Type", "HangulSyllableType.txt", ""),
+  ("Indic_Positional_Category", "IndicPositionalCategory.txt", ""),
+  ("Indic_Syllabic_Category", "IndicSyllabicCategory.txt", ""),
+  ("Vertical_Orientation", "VerticalOrientation.txt", ""),
+  ("Grapheme_Cluster_Break", "auxiliary/GraphemeBreakProperty.txt", ""),
+  ("Word_Break", "auxiliary/WordBreakProperty.txt", ""),
+  ("Sentence_Break", "auxiliary/SentenceBreakProperty.txt", ""),
+  ("Indic_Conjunct_Break", "DerivedCoreProperties.txt", "InCB"),
+  ("NFD_Quick_Check", "DerivedNormalizationProps.txt", "NFD_QC"),
+  ("NFC_Quick_Check", "DerivedNormalizationProps.txt", "NFC_QC"),
+  ("NFKD_Quick_Check", "DerivedNormalizationProps.txt", "NFKD_QC"),
+  ("NFKC_Quick_Check", "DerivedNormalizationProps.txt", "NFKC_QC"),
+]
+
+# Files from which all the binary properties are read
+BINARY_PROPERTY_FILES = [
+  "PropList.txt",
+  "DerivedCoreProperties.txt",
+  "DerivedNormalizationProps.txt",
+  "emoji/emoji-data.txt",
+  "extracted/DerivedBinaryProperties.txt",
+]
+
+# Binary properties that are packed in the first table: these are
+# the ones queried when lexing identifiers and skipping whitespaces.
+HOT_BINARY_PROPERTIES = [
+  "XID_Start", "XID_Continue", "ID_Start", "ID_Continue",
+  "White_Space", "Pattern_White_Space", "Pattern_Syntax", "Alphabetic",
+  "Uppercase", "Lowercase", "Default_Ignorable_Code_Point", "Extended_Pictographic",
+  "Emoji", "Regional_Indicator", "Grapheme_Extend", "Math",
+]
+
+# Count of bits of each table of packed binary properties
+BINARY_TABLE_BITS = 16
+
+def loose_match(value: str)->str:
+  """Loose matching of property values (UAX44-LM3, without the 'is' prefix)"""
+  return value.replace(' ', '').replace('_', '').replace('-', '').lower()
+
+def values_of(PROPERTY: parseunicode.Property, RANGES: parseunicode.PropertyRanges)->list[int]:
+  """Returns the enum value of each code point for an enumerated property"""
+  LOOKUP : dict[str, int] = dict()
+  VALUES = enum_values(PROPERTY)
+  for k, v in PROPERTY.KEYS.items():
+    key = loose_match(k)
+    value = VALUES[canonicalize_identifier(v)]
+    if LOOKUP.get(key, value) != value:
+      raise ValueError(f"Ambiguous value '{k}' for '{PROPERTY.FULLNAME}'!")
+    LOOKUP[key] = value
+  DEFAULTS = RANGES.DEFAULTS
+  if len(DEFAULTS) == 0:
+    DEFAULTS = [PROPERTY.DEFAULT_VALUE]
+  ret = [0] * trie.CODE_POINT_COUNT
+  # Later @missing lines override the previous ones
+  for RANGE, value in DEFAULTS + RANGES.RANGES:
+    begin, end = RANGE.begin.value, RANGE.end.value + 1
+    ret[begin:end] = [LOOKUP[loose_match(value)]] * (end - begin)
+  return ret
+
+def write_table_as_cxx(name: str, values: list[int], file):
+  TYPE = f"uint{8 * trie.bytes_of(max(values))}_t"
+  print(f"inline constexpr {TYPE} {name}[{len(values)}] = {{", file=file)
+  for i in range(0, len(values), 24):
+    print("  " + ", ".join(str(v) for v in values[i:i + 24]) + ",", file=file)
+  print("};", file=file)
+
+def write_trie_as_cxx(name: str, TRIE: trie.Trie, file)->str:
+  """Writes the tables of a trie, and returns the expression used to look it up"""
+  write_table_as_cxx(f"{name}_top", TRIE.TOP, file)
+  write_table_as_cxx(f"{name}_mid", TRIE.MID, file)
+  write_table_as_cxx(f"{name}_leaf", TRIE.LEAF, file)
+  print(f"// {name}: {TRIE.size()} bytes\n", file=file)
+  return (f"details::trie_lookup<{TRIE.LEAF_BITS}, {TRIE.MID_BITS}>(\n"
+    + f"      details::{name}_top, details::{name}_mid, details::{name}_leaf, code_point)")
+
+# Maximum count of code points resulting from the full case folding
+CASEFOLD_MAX = 3
+
+def write_casefold_as_cxx(file)->int:
+  """Writes the tables of the full case folding (`CaseFolding.txt`).
+  Each code point is mapped to an entry of `CaseFolding_mapping`: the first
+  code point of the folding is stored as a delta (modulo 2^32) from the code
+  point, so that the many mappings sharing a delta (+32, +1...) share an entry.
+  The other code points (for the full foldings) are stored as is, 0 if unused.
+  The entry 0 is the identity.
+
+  Returns:
+      int: The size in bytes of the tables
+  """
+  ENTRIES : dict[tuple, int] = {(0,) * CASEFOLD_MAX: 0}
+  VALUES  = [0] * trie.CODE_POINT_COUNT
+  for cp, MAPPING in parseunicode.parse_casefolding().items():
+    assert 0 < len(MAPPING) <= CASEFOLD_MAX
+    ENTRY = tuple([(MAPPING[0] - cp) % 2**32] + MAPPING[1:]
+      + [0] * (CASEFOLD_MAX - len(MAPPING)))
+    VALUES[cp] = ENTRIES.setdefault(ENTRY, len(ENTRIES))
+  TRIE = trie.build_trie(VALUES)
+  print(f"inline constexpr uint32_t CaseFolding_mapping[{len(ENTRIES)}][{CASEFOLD_MAX}] = {{", file=file)
+  for ENTRY in ENTRIES:
+    print("  {" + ", ".join(str(v) for v in ENTRY) + "},", file=file)
+  print("};", file=file)
+  LOOKUP = write_trie_as_cxx("CaseFolding", TRIE, file)
+  print(f"""/// @brief Returns the entry of the full case folding of a code point.
+/// The first code point of the folding is 'code_point + entry[0]' (modulo 2^32),
+/// followed by the non-zero code points of 'entry[1]' and 'entry[2]'.
+/// @param code_point The code point
+/// @return The entry of the code point in CaseFolding_mapping
+constexpr const uint32_t* casefold_mapping(char32_t code_point) noexcept {{
+  return CaseFolding_mapping[{LOOKUP.replace("details::", "")}];
+}}
+""", file=file)
+  return TRIE.size() + len(ENTRIES) * CASEFOLD_MAX * 4
+
+def write_normalization_as_cxx(file)->int:
+  """Writes the tables used by the canonical normalization forms (NFD, NFC).
+  Each code point is mapped to its full canonical decomposition, stored as
+  `offset << 3 | length` into `Decomposition_pool` (0 if it does not decompose).
+  The primary composites are stored as pairs sorted by `first << 21 | second`.
+  The Hangul syllables are not part of the tables, as they are algorithmic.
+
+  Returns:
+      int: The size in bytes of the tables
+  """
+  DECOMPOSITIONS = parseunicode.parse_canonical_decompositions()
+  def decompose(cp: int)->list[int]:
+    if cp not in DECOMPOSITIONS:
+      return [cp]
+    return [j for i in DECOMPOSITIONS[cp] for j in decompose(i)]
+
+  POOL   : list[int] = []
+  VALUES = [0] * trie.CODE_POINT_COUNT
+  for cp in DECOMPOSITIONS:
+    FULL = decompose(cp)
+    assert 0 < len(FULL) < 8
+    VALUES[cp] = (len(POOL) << 3) | len(FULL)
+    POOL.extend(FULL)
+  write_table_as_cxx("Decomposition_pool", POOL, file)
+  TRIE   = trie.build_trie(VALUES)
+  LOOKUP = write_trie_as_cxx("Decomposition", TRIE, file)
+  print(f"""/// @brief Returns the full canonical decomposition of a code point,
+/// as 'offset << 3 | length' into Decomposition_pool (0 if none).
+/// @param code_point The code point
+/// @return The packed decomposition
+constexpr uint32_t canonical_decomposition(char32_t code_point) noexcept {{
+  return {LOOKUP.replace("details::", "")};
+}}
+""", file=file)
+
+  EXCLUDED = set()
+  for RANGE, _ in parseunicode.parse_property_file("DerivedNormalizationProps.txt")["Full_Composition_Exclusion"].RANGES:
+    EXCLUDED.update(range(RANGE.begin.value, RANGE.end.value + 1))
+  PAIRS = sorted(((v[0] << 21) | v[1], cp) for cp, v in DECOMPOSITIONS.items()
+    if len(v) == 2 and cp not in EXCLUDED)
+  write_table_as_cxx("Composition_pairs", [k for k, _ in PAIRS], file)
+  write_table_as_cxx("Composition_composites", [v for _, v in PAIRS], file)
+  print(f"// Composition: {len(PAIRS) * 12} bytes\n", file=file)
+  return TRIE.size() + len(POOL) * 4 + len(PAIRS) * 12
+
+def write_display_width_as_cxx(PROPERTIES: dict[str, parseunicode.Property], ALLALIASES: dict[str, str], file)->int:
+  """Writes the table of the count of terminal columns of a code point.
+  Marks (Mn, Me), format and control characters (Cf, Cc), the Hangul
+  medial vowels and final consonants (V, T) and the default ignorable code
+  points are of width 0 (except U+00AD SOFT HYPHEN, which is displayed).
+  The wide and fullwidth (W, F) code points and the emoji displayed as
+  emoji by default (Emoji_Presentation) are of width 2, the others of width 1.
+
+  Returns:
+      int: The size in bytes of the table
+  """
+  def values(NAME: str, PATH: str)->tuple[list[int], dict[str, int]]:
+    PROPERTY = PROPERTIES[ALLALIASES[NAME]]
+    return (values_of(PROPERTY, parseunicode.parse_property_file(PATH, True)[""]),
+      enum_values(PROPERTY))
+  def ranges(PATH: str, NAME: str)->list[int]:
+    ret = []
+    for RANGE, _ in parseunicode.parse_property_file(PATH)[NAME].RANGES:
+      ret.extend(range(RANGE.begin.value, RANGE.end.value + 1))
+    return ret
+
+  GC, GC_KEYS   = values("General_Category", "extracted/DerivedGeneralCategory.txt")
+  EA, EA_KEYS   = values("East_Asian_Width", "extracted/DerivedEastAsianWidth.txt")
+  HST, HST_KEYS = values("Hangul_Syllable_Type", "HangulSyllableType.txt")
+  ZERO_GC  = {GC_KEYS[k] for k in ("Mn", "Me", "Cf", "Cc")}
+  WIDE_EA  = {EA_KEYS[k] for k in ("W", "F")}
+  ZERO_HST = {HST_KEYS[k] for k in ("V", "T")}
+
+  VALUES = [1] * trie.CODE_POINT_COUNT
+  for cp in range(trie.CODE_POINT_COUNT):
+    if EA[cp] in WIDE_EA:
+      VALUES[cp] = 2
+  for cp in ranges("emoji/emoji-data.txt", "Emoji_Presentation"):
+    VALUES[cp] = 2
+  for cp in range(trie.CODE_POINT_COUNT):
+    if GC[cp] in ZERO_GC or HST[cp] in ZERO_HST:
+      VALUES[cp] = 0
+  for cp in ranges("DerivedCoreProperties.txt", "Default_Ignorable_Code_Point"):
+    VALUES[cp] = 0
+  VALUES[0xAD] = 1
+  TRIE   = trie.build_trie(VALUES)
+  LOOKUP = write_trie_as_cxx("Display_Width", TRIE, file)
+  print(f"""/// @brief Returns the count of terminal columns of a code point (0, 1 or 2).
+/// @param code_point The code point
+/// @return The width of the code point
+constexpr uint8_t display_width_of(char32_t code_point) noexcept {{
+  return {LOOKUP.replace("details::", "")};
+}}
+""", file=file)
+  return TRIE.size()
+
+def write_property_tables_as_cxx(PROPERTIES: dict[str, parseunicode.Property], ALLALIASES: dict[str, str]):
+  ACCESSORS = []
+  TOTAL = 0
+  with open(parseunicode.PATH_OUTPUT + "property_tables.h", "w") as file:
+    print("// !! Generated by unicodedata_to_cxx.py !!", file=file)
+    print(f"#ifndef __COLT_UNICODE_PROPERTY_TABLES__\n#define __COLT_UNICODE_PROPERTY_TABLES__\n\n#include <cstdint>\n", file=file)
+    print("namespace clt::uni::details {", file=file)
+    print("""/// @brief Looks up the value of a code point in a three-stage trie.
+/// The code point is split as [top | mid | leaf] bits: the top table
+/// gives the mid block, which gives the leaf block containing the value.
+/// The first leaf block always holds the code points [0, 2^LEAF_BITS),
+/// which are thus looked up using a single load.
+/// Values greater than 0x10FFFF are treated as 0x10FFFF (a noncharacter).
+/// @tparam LEAF_BITS The count of bits indexing into a leaf block
+/// @tparam MID_BITS The count of bits indexing into a mid block
+/// @param top The top table
+/// @param mid The mid blocks
+/// @param leaf The leaf blocks
+/// @param code_point The code point whose value to return
+/// @return The value of the code point
+template<unsigned LEAF_BITS, unsigned MID_BITS, typename TOP, typename MID, typename LEAF>
+constexpr LEAF trie_lookup(const TOP* top, const MID* mid, const LEAF* leaf, char32_t code_point) noexcept {
+  constexpr uint32_t MID_MASK  = (uint32_t(1) << MID_BITS) - 1;
+  constexpr uint32_t LEAF_MASK = (uint32_t(1) << LEAF_BITS) - 1;
+  if (code_point <= LEAF_MASK)
+    return leaf[code_point];
+  code_point = code_point > 0x10FFFF ? char32_t(0x10FFFF) : code_point;
+  const uint32_t m = top[code_point >> (LEAF_BITS + MID_BITS)];
+  const uint32_t l = mid[(m << MID_BITS) | ((code_point >> LEAF_BITS) & MID_MASK)];
+  return leaf[(l << LEAF_BITS) | (code_point & LEAF_MASK)];
+}
+""", file=file)
+    for NAME, PATH, KEY in ENUMERATED_PROPERTIES:
+      PROPERTY = PROPERTIES[ALLALIASES[NAME]]
+      VALUES   = values_of(PROPERTY, parseunicode.parse_property_file(PATH, KEY == "")[KEY])
+      TRIE     = trie.build_trie(VALUES)
+      TOTAL   += TRIE.size()
+      LOOKUP   = write_trie_as_cxx(PROPERTY.FULLNAME, TRIE, file)
+      ACCESSORS.append(f"""template<>
+constexpr {PROPERTY.FULLNAME} get<{PROPERTY.FULLNAME}>(char32_t code_point) noexcept {{
+  return static_cast<{PROPERTY.FULLNAME}>({LOOKUP});
+}}
+""")
+
+    # All the binary properties, hot ones first
+    BINARY = list(HOT_BINARY_PROPERTIES)
+    RANGES : dict[str, list] = dict()
+    for PATH in BINARY_PROPERTY_FILES:
+      for NAME, RANGE in parseunicode.parse_property_file(PATH).items():
+        # Ignore the enumerated properties and the ones without an enum
+        if len(RANGE.RANGES) == 0 or RANGE.RANGES[0][1] is not None:
+          continue
+        if NAME not in ALLALIASES or len(PROPERTIES[ALLALIASES[NAME]].KEYS) == 0:
+          continue
+        NAME = PROPERTIES[ALLALIASES[NAME]].FULLNAME
+        RANGES.setdefault(NAME, []).extend(r for r, _ in RANGE.RANGES)
+        if NAME not in BINARY:
+          BINARY.append(NAME)
+    for i in range(0, len(BINARY), BINARY_TABLE_BITS):
+      VALUES = [0] * trie.CODE_POINT_COUNT
+      for bit, NAME in enumerate(BINARY[i:i + BINARY_TABLE_BITS]):
+        for RANGE in RANGES[NAME]:
+          for cp in range(RANGE.begin.value, RANGE.end.value + 1):
+            VALUES[cp] |= 1 << bit
+      TRIE   = trie.build_trie(VALUES)
+      TOTAL += TRIE.size()
+      LOOKUP = write_trie_as_cxx(f"Binary_Properties{i // BINARY_TABLE_BITS}", TRIE, file)
+      for bit, NAME in enumerate(BINARY[i:i + BINARY_TABLE_BITS]):
+        ACCESSORS.append(f"""template<>
+constexpr bool has<{NAME}>(char32_t code_point) noexcept {{
+  return ({LOOKUP} >> {bit}) & 1;
+}}
+template<>
+constexpr {NAME} get<{NAME}>(char32_t code_point) noexcept {{
+  return static_cast<{NAME}>(has<{NAME}>(code_point));
+}}
+""")
+    TOTAL += write_casefold_as_cxx(file)
+    TOTAL += write_normalization_as_cxx(file)
+    TOTAL += write_display_width_as_cxx(PROPERTIES, ALLALIASES, file)
+    print("} // namespace clt::uni::details\n\n#endif // !__COLT_UNICODE_PROPERTY_TABLES__", file=file)
+  print(f"Total size of the tables: {TOTAL} bytes")
+  return ACCESSORS
+
 try:
   # dict of name str to abrv.
   ALLALIASES = time_fn(parseunicode.parse_propertyaliases)
   # dict of abrv. str to Property
   PROPERTIES = time_fn(parseunicode.parse_propertyvalue)  
+  # Generate the lookup tables
+  ACCESSORS  = time_fn(write_property_tables_as_cxx, PROPERTIES, ALLALIASES)
+  print("Finished writing 'colt/unicode/gen/property_tables.h'!\n")
   # Convert to C++
-  time_fn(write_properties_as_cxx, PROPERTIES, ALLALIASES)
+  time_fn(write_properties_as_cxx, PROPERTIES, ALLALIASES, ACCESSORS)
   print("Finished writing 'colt/unicode/properties.h'!\n")
   
   # list of all properties
@@ -0,0 +1,78 @@
+/*****************************************************************/ /**
+ * @file   test_detect_simd.cpp
+ * @brief  Unit tests for `choose_simd_implementation`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/algo/detect_simd.h>
+#include <algorithm>
+
+static int simd_test_fast()
+{
+  return 1;
+}
+
+static int simd_test_default()
+{
+  return 0;
+}
+
+TEST_CASE("SIMD Detection")
+{
+  using namespace clt;
+
+  SECTION("Parsing")
+  {
+    auto parses_to = [](std::string_view str, simd_flag expected)
+    {
+      auto flags = parse_simd_flags(str);
+      return flags.is_value() && *flags == expected;
+    };
+    REQUIRE(parses_to("", simd_flag::DEFAULT));
+    REQUIRE(parses_to("DEFAULT", simd_flag::DEFAULT));
+    REQUIRE(parse_simd_flags("NOT_A_FLAG").is_none());
+#ifdef COLT_x86_64
+    REQUIRE(parses_to("AVX2|SSE42", simd_flag::AVX2 | simd_flag::SSE42));
+    REQUIRE(parse_simd_flags("AVX2|NEON").is_none());
+    REQUIRE(
+        fmt::format("{}", simd_flag::AVX2 | simd_flag::SSE42)
+        == "(AVX2 | SSE42 | DEFAULT)");
+#elif defined(COLT_ARM_7or8)
+    REQUIRE(parses_to("NEON|SVE2", simd_flag::NEON | simd_flag::SVE2));
+#endif // COLT_x86_64
+    REQUIRE(is_enabled(simd_flag::AVX2, simd_flag::DEFAULT));
+    REQUIRE(!is_enabled(simd_flag::AVX2, simd_flag::AVX512F));
+  }
+
+  SECTION("Override")
+  {
+    const simd_flag hardware = detect_hardware_architectures();
+    // COLT_SIMD_OVERRIDE may restrict the supported instructions
+    const simd_flag initial = detect_supported_architectures();
+    REQUIRE(is_enabled(hardware, initial));
+
+    // Disabling all the SIMD instructions forces the DEFAULT implementation
+    override_simd_support(simd_flag::DEFAULT);
+    REQUIRE(detect_supported_architectures() == simd_flag::DEFAULT);
+    auto fn = choose_simd_implementation<simd_flag::AVX2, simd_flag::DEFAULT>{}(
+        &simd_test_fast, &simd_test_default);
+    REQUIRE(fn == &simd_test_default);
+
+    // The choice is recorded
+    auto dispatches = simd_dispatches();
+    REQUIRE(!dispatches.empty());
+    REQUIRE(dispatches.back().chosen == simd_flag::DEFAULT);
+    REQUIRE(dispatches.back().function != nullptr);
+
+    override_simd_support(hardware);
+    REQUIRE(detect_supported_architectures() == hardware);
+    fn = choose_simd_implementation<simd_flag::AVX2, simd_flag::DEFAULT>{}(
+        &simd_test_fast, &simd_test_default);
+    const bool avx2 = is_enabled(hardware, simd_flag::AVX2);
+    REQUIRE(fn == (avx2 ? &simd_test_fast : &simd_test_default));
+    REQUIRE(simd_dispatches().size() == dispatches.size() + 1);
+    override_simd_support(initial);
+  }
+}
@@ -0,0 +1,115 @@
+/*****************************************************************/ /**
+ * @file   test_generator.cpp
+ * @brief  Unit tests for `Generator`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/algo/generator.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+  /// @brief Yields [0, n)
+  clt::Generator<clt::u64> iota(
+      std::allocator_arg_t, clt::mem::AnyAllocatorRef, clt::u64 n)
+  {
+    for (clt::u64 i = 0; i < n; i++)
+      co_yield i;
+  }
+
+  /// @brief Yields the squares of the values of 'values'
+  clt::Generator<clt::u64> squares(clt::Generator<clt::u64> values)
+  {
+    for (clt::u64 value : values)
+      co_yield value * value;
+  }
+
+  /// @brief Yields lvalues, which are not copied
+  clt::Generator<std::string> words(const std::vector<std::string>& words)
+  {
+    for (const auto& word : words)
+      co_yield word;
+  }
+} // namespace
+
+TEST_CASE("Generator")
+{
+  using namespace clt;
+
+  mem::StatsAllocator<mem::Mallocator> alloc;
+
+  SECTION("Frames")
+  {
+    {
+      auto gen = iota(std::allocator_arg, alloc, 5);
+      REQUIRE(alloc.stats().alloc_count == 1);
+      REQUIRE(alloc.stats().live_bytes != 0);
+      std::vector<u64> values;
+      for (u64 value : gen)
+        values.push_back(value);
+      REQUIRE(values == std::vector<u64>{0, 1, 2, 3, 4});
+    }
+    REQUIRE(alloc.stats().live_bytes == 0);
+
+    // Stopping early destroys the frame
+    {
+      auto gen = iota(std::allocator_arg, alloc, 1'000);
+      for (u64 value : gen)
+        if (value == 10)
+          break;
+    }
+    REQUIRE(alloc.stats().live_bytes == 0);
+    REQUIRE(alloc.stats().dealloc_count == 2);
+
+    // Never started
+    {
+      auto gen = iota(std::allocator_arg, alloc, 10);
+    }
+    REQUIRE(alloc.stats().live_bytes == 0);
+  }
+
+  SECTION("Stages")
+  {
+    u64 sum = 0;
+    for (u64 value : squares(iota(std::allocator_arg, alloc, 10)))
+      sum += value;
+    REQUIRE(sum == 285);
+    REQUIRE(alloc.stats().live_bytes == 0);
+
+    auto empty = squares(iota(std::allocator_arg, alloc, 0));
+    REQUIRE(empty.begin() == empty.end());
+  }
+
+  SECTION("Move")
+  {
+    auto a = iota(std::allocator_arg, alloc, 3);
+    auto b = std::move(a);
+    auto it = b.begin();
+    REQUIRE(*it == 0);
+    ++it;
+    auto c = iota(std::allocator_arg, alloc, 1);
+    c      = std::move(b);
+    REQUIRE(*it == 1);
+    it++;
+    REQUIRE(*it == 2);
+    ++it;
+    REQUIRE(it == c.end());
+  }
+
+  SECTION("References")
+  {
+    const std::vector<std::string> expected = {"a", "bc", "def"};
+    auto gen = words(expected);
+    size_t i = 0;
+    for (auto it = gen.begin(); it != gen.end(); ++it, ++i)
+    {
+      REQUIRE(&*it == &expected[i]);
+      REQUIRE(it->size() == i + 1);
+    }
+    REQUIRE(i == 3);
+  }
+  REQUIRE(alloc.stats().live_bytes == 0);
+}
@@ -0,0 +1,138 @@
+/*****************************************************************/ /**
+ * @file   test_parallel.cpp
+ * @brief  Unit tests for the parallel algorithms of `parallel.h`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/algo/parallel.h>
+#include <colt/dsa/vector.h>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+/// @brief An element sorted by key, whose index checks the stability
+struct Symbol
+{
+  clt::u64 hash  = 0;
+  clt::u32 index = 0;
+};
+
+TEST_CASE("Parallel Algorithms")
+{
+  using namespace clt;
+
+  exec::Scheduler sched        = {{.workers = 3}};
+  exec::Scheduler single       = {{.workers = 1}};
+  const par::Options opt       = {.grain = 64, .scheduler = &sched};
+  const par::Options opt_small = {.grain = 7, .scheduler = &single};
+
+  std::mt19937_64 rng{42};
+  // Sizes around the grain, to test the partial chunks
+  const size_t SIZES[] = {0, 1, 63, 64, 65, 1000, 10'007};
+
+  SECTION("for_each and transform")
+  {
+    for (size_t size : SIZES)
+    {
+      auto vec = make_vector<u64>();
+      for (size_t i = 0; i < size; i++)
+        vec.push_back(i);
+      par::for_each(vec, [](u64& value) { value *= 3; }, opt);
+      std::vector<u64> out(size);
+      par::transform(
+          View<u64>{vec}, Span<u64>{out}, [](u64 value) { return value + 1; },
+          opt);
+      for (size_t i = 0; i < size; i++)
+        REQUIRE(out[i] == i * 3 + 1);
+    }
+  }
+
+  SECTION("reduce")
+  {
+    for (size_t size : SIZES)
+    {
+      std::vector<u64> values(size);
+      std::iota(values.begin(), values.end(), u64{1});
+      REQUIRE(par::reduce(View<u64>{values}, u64{5}, std::plus<>{}, opt) ==
+              5 + size * (size + 1) / 2);
+      const size_t odd = par::transform_reduce(
+          values, size_t{0}, std::plus<>{},
+          [](u64 value) -> size_t { return value % 2; }, opt_small);
+      REQUIRE(odd == (size + 1) / 2);
+    }
+
+    // Non-associative: the same result whatever the count of workers
+    std::vector<double> values(100'000);
+    for (auto& value : values)
+      value = std::uniform_real_distribution<double>{-1e6, 1e6}(rng);
+    const double a = par::reduce(values, 0.0, std::plus<>{}, opt);
+    const double b = par::reduce(
+        values, 0.0, std::plus<>{}, {.grain = 64, .scheduler = &single});
+    REQUIRE(a == b);
+  }
+
+  SECTION("inclusive_scan")
+  {
+    for (size_t size : SIZES)
+    {
+      std::vector<u64> values(size);
+      for (auto& value : values)
+        value = rng() % 1000;
+      std::vector<u64> expected(size), result(size);
+      std::inclusive_scan(values.begin(), values.end(), expected.begin());
+      par::inclusive_scan(View<u64>{values}, Span<u64>{result}, std::plus<>{}, opt);
+      REQUIRE(result == expected);
+      // In place
+      par::inclusive_scan(values, values, std::plus<>{}, opt_small);
+      REQUIRE(values == expected);
+
+      // The chunk results must not be moved from (as strings would be)
+      if (size > 1000)
+        continue;
+      std::vector<std::string> words(size), concat(size), concat_expected(size);
+      for (auto& word : words)
+        word = std::string(1, static_cast<char>('a' + rng() % 26));
+      std::inclusive_scan(words.begin(), words.end(), concat_expected.begin());
+      par::inclusive_scan(words, concat, std::plus<>{}, opt_small);
+      REQUIRE(concat == concat_expected);
+    }
+  }
+
+  SECTION("sort")
+  {
+    for (size_t size : SIZES)
+    {
+      std::vector<Symbol> symbols(size);
+      for (u32 i = 0; i < size; i++)
+        symbols[i] = {rng() % 128, i};
+      auto expected = symbols;
+      auto by_hash  = [](const Symbol& a, const Symbol& b)
+      { return a.hash < b.hash; };
+      std::stable_sort(expected.begin(), expected.end(), by_hash);
+
+      auto merged = symbols;
+      par::sort(Span<Symbol>{merged}, by_hash, opt);
+      auto radix = symbols;
+      par::radix_sort(radix, [](const Symbol& s) { return s.hash; }, opt_small);
+      for (size_t i = 0; i < size; i++)
+      {
+        REQUIRE(merged[i].index == expected[i].index);
+        REQUIRE(radix[i].index == expected[i].index);
+      }
+    }
+
+    std::vector<u64> hashes(50'000);
+    for (auto& hash : hashes)
+      hash = rng();
+    auto expected = hashes;
+    std::sort(expected.begin(), expected.end());
+    auto copy = hashes;
+    par::radix_sort(copy, opt);
+    REQUIRE(copy == expected);
+    par::sort(hashes, std::less<>{}, opt);
+    REQUIRE(hashes == expected);
+  }
+}
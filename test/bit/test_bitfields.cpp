@@ -7,6 +7,7 @@
  *********************************************************************/
 #include "../includes.h"
 #include <colt/num/bitfields.h>
+#include <vector>
 
 TEST_CASE("Bitfields")
 {
@@ -23,4 +24,90 @@ TEST_CASE("Bitfields")
   a.set<1>(0);
   REQUIRE(a.value() == 0b00000'00'1);
   REQUIRE(a.get<1>() == 0);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Bulk Bitfields")
+{
+  using namespace clt;
+
+  enum class Field
+  {
+    OpCode,
+    Payload,
+    Padding
+  };
+  using Type = Bitfields<
+      u16, Bitfield<Field::OpCode, 4>, Bitfield<Field::Payload, 9>,
+      Bitfield<Field::Padding, 3>>;
+
+  // Returns 'size' Bitfields
+  auto make_values = [](size_t size)
+  {
+    std::vector<Type> values;
+    for (size_t i = 0; i < size; i++)
+      values.push_back(Type(InPlace, i % 16, i * 7, i % 5));
+    return values;
+  };
+  // Sizes around the vector widths, to test the tails
+  const size_t SIZES[] = {0, 1, 7, 16, 33, 100};
+
+  SECTION("unpack_many and pack_many")
+  {
+    for (size_t size : SIZES)
+    {
+      auto values = make_values(size);
+      std::vector<u64> payloads(size);
+      unpack_many<Field::Payload>(View<Type>{values}, Span<u64>{payloads});
+      for (size_t i = 0; i < size; i++)
+        REQUIRE(payloads[i] == values[i].get<Field::Payload>());
+
+      // Values larger than the field are truncated
+      for (auto& i : payloads)
+        i = ~i;
+      pack_many<Field::Payload>(View<u64>{payloads}, Span<Type>{values});
+      for (size_t i = 0; i < size; i++)
+      {
+        REQUIRE(values[i].get<Field::Payload>() == (~(i * 7) & 0x1FF));
+        REQUIRE(values[i].get<Field::OpCode>() == i % 16);
+        REQUIRE(values[i].get<Field::Padding>() == i % 5);
+      }
+    }
+  }
+
+  SECTION("BitfieldsColumns")
+  {
+    for (size_t size : SIZES)
+    {
+      auto values = make_values(size);
+      std::vector<u64> opcodes(size), payloads(size), paddings(size);
+      auto columns = BitfieldsColumns<Type>{opcodes, payloads, paddings};
+      REQUIRE(columns.size() == size);
+      columns.unpack(View<Type>{values});
+      REQUIRE(columns.column<Field::Padding>().data() == paddings.data());
+      // Only the fields of the Bitfields have a column
+      constexpr auto has_column = []<Field F>()
+      { return requires { columns.template column<F>(); }; };
+      static_assert(has_column.template operator()<Field::OpCode>());
+      static_assert(!has_column.template operator()<static_cast<Field>(3)>());
+      for (size_t i = 0; i < size; i++)
+      {
+        REQUIRE(opcodes[i] == i % 16);
+        REQUIRE(payloads[i] == ((i * 7) & 0x1FF));
+        REQUIRE(paddings[i] == i % 5);
+      }
+      std::vector<Type> packed(size);
+      columns.pack(Span<Type>{packed});
+      for (size_t i = 0; i < size; i++)
+        REQUIRE(packed[i].value() == values[i].value());
+    }
+  }
+
+  static_assert(
+      []
+      {
+        Type values[2] = {Type(InPlace, 1, 2, 3), Type(InPlace, 4, 5, 6)};
+        u64 opcodes[2];
+        unpack_many<Field::OpCode>(View<Type>{values}, Span<u64>{opcodes});
+        return opcodes[0] == 1 && opcodes[1] == 4;
+      }());
+}
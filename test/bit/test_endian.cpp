@@ -7,6 +7,8 @@
  *********************************************************************/
 #include "../includes.h"
 #include <colt/num/math.h>
+#include <colt/num/endian.h>
+#include <vector>
 
 TEST_CASE("Endianness Conversions")
 {
@@ -27,4 +29,45 @@ TEST_CASE("Endianness Conversions")
     REQUIRE(htob(host) == 0x00'80);
     REQUIRE(byteswap(host) == 0x80'00);
   }
-}
\ No newline at end of file
+}
+
+/// @brief Checks bswap_span and convert_endian against 'byteswap'
+template<typename T>
+static void check_bulk_swap()
+{
+  using namespace clt;
+  // Sizes around the vector widths, to test the tails
+  for (size_t size : {0, 1, 3, 7, 8, 15, 16, 17, 31, 33, 64, 100, 1025})
+  {
+    std::vector<T> values(size);
+    for (size_t i = 0; i < size; i++)
+      values[i] = static_cast<T>(0x0123'4567'89AB'CDEFULL * (i + 1));
+    auto swapped = values;
+    bswap_span(Span<T>{swapped});
+    for (size_t i = 0; i < size; i++)
+      REQUIRE(swapped[i] == byteswap(values[i]));
+
+    std::vector<T> result(size);
+    convert_endian(
+        View<T>{swapped}, Span<T>{result}, TargetEndian::big,
+        TargetEndian::little);
+    REQUIRE(result == values);
+    convert_endian(
+        View<T>{swapped}, Span<T>{result}, TargetEndian::big, TargetEndian::big);
+    REQUIRE(result == swapped);
+  }
+  static_assert(
+      []
+      {
+        T values[3] = {1, 2, 3};
+        bswap_span(Span<T>{values});
+        return values[2] == byteswap(T{3});
+      }());
+}
+
+TEST_CASE("Bulk Endianness Conversions")
+{
+  check_bulk_swap<clt::u16>();
+  check_bulk_swap<clt::u32>();
+  check_bulk_swap<clt::u64>();
+}
@@ -0,0 +1,134 @@
+/*****************************************************************/ /**
+ * @file   test_any_string_view.cpp
+ * @brief  Unit tests for `AnyStringView`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/dsa/any_string_view.h>
+#include <colt/dsa/string.h>
+
+TEST_CASE("AnyStringView")
+{
+  using namespace clt;
+  using enum StringEncoding;
+
+  // The same text in all the encodings (big endian obtained by transcoding)
+  const AnyStringView utf8 = "Héllo μ W\U0001F600rld!"_UTF8;
+  Char16BE utf16be[15];
+  Char32BE utf32be[14];
+  REQUIRE(utf8.transcode(Span<Char16BE>{utf16be, 15}).is_expect());
+  REQUIRE(utf8.transcode(Span<Char32BE>{utf32be, 14}).is_expect());
+  const AnyStringView views[] = {
+      utf8,
+      "Héllo μ W\U0001F600rld!"_UTF16LE,
+      BasicStringView<UTF16BE>{utf16be, 15},
+      "Héllo μ W\U0001F600rld!"_UTF32LE,
+      BasicStringView<UTF32BE>{utf32be, 14},
+  };
+
+  SECTION("Visit")
+  {
+    for (auto& view : views)
+    {
+      const auto encoding = view.visit(
+          []<StringEncoding ENCODING>(BasicStringView<ENCODING> typed)
+          {
+            REQUIRE(typed.front() == U'H');
+            REQUIRE(typed.back() == U'!');
+            return ENCODING;
+          });
+      REQUIRE(encoding == view.encoding());
+    }
+    REQUIRE(views[0].as<UTF8>().is_value());
+    REQUIRE(views[0].as<UTF16LE>().is_none());
+    REQUIRE(views[3].as<UTF32LE>()->size() == 14);
+  }
+
+  SECTION("Length")
+  {
+    for (auto& view : views)
+    {
+      REQUIRE(view.size() == 14);
+      REQUIRE(view.len().strlen == 14);
+      auto info = view.validate();
+      REQUIRE(info.is_value());
+      REQUIRE(info->strlen == 14);
+      REQUIRE(info->unitlen == view.unit_len());
+    }
+    REQUIRE(views[0].byte_len() == 19);
+    REQUIRE(views[1].byte_len() == 30);
+    REQUIRE(views[3].byte_len() == 56);
+    REQUIRE(AnyStringView{}.is_empty());
+  }
+
+  SECTION("Find")
+  {
+    const size_t offsets[] = {7, 6, 6, 6, 6};
+    for (size_t i = 0; i < std::size(views); i++)
+    {
+      REQUIRE(views[i].find(U'μ') == offsets[i]);
+      REQUIRE(views[i].find(U'z') == AnyStringView::npos);
+      // Same encoding and other encodings
+      for (auto& needle : views)
+        REQUIRE(views[i].find(needle) == 0);
+      const size_t world = views[i].find(AnyStringView{"W\U0001F600r"_UTF8});
+      REQUIRE(world != AnyStringView::npos);
+      REQUIRE(views[i].find("W\U0001F600R"_UTF8) == AnyStringView::npos);
+      REQUIRE(views[i].find(""_UTF32, 3) == 3);
+    }
+  }
+
+  SECTION("Compare and hash")
+  {
+    for (auto& v1 : views)
+    {
+      for (auto& v2 : views)
+      {
+        REQUIRE(v1 == v2);
+        REQUIRE((v1 <=> v2) == std::strong_ordering::equal);
+        REQUIRE(default_hash{}(v1) == default_hash{}(v2));
+      }
+      REQUIRE(v1 != AnyStringView{"Héllo"_UTF16});
+      REQUIRE(v1 > AnyStringView{"Héllo"_UTF16});
+      REQUIRE(v1 < AnyStringView{"I"_UTF32});
+    }
+    REQUIRE(
+        default_hash{}(AnyStringView{"a"_UTF8})
+        != default_hash{}(AnyStringView{"b"_UTF8}));
+
+    // Longer than a hash chunk
+    auto str8  = make_u8string();
+    auto str16 = make_u16string();
+    for (int i = 0; i < 300; i++)
+    {
+      str8 += "μ\U0001F600a"_UTF8;
+      str16 += "μ\U0001F600a"_UTF16;
+    }
+    REQUIRE(AnyStringView{str8} == AnyStringView{str16});
+    REQUIRE(
+        default_hash{}(AnyStringView{str8}) == default_hash{}(AnyStringView{str16}));
+  }
+
+  SECTION("Transcode")
+  {
+    for (auto& view : views)
+    {
+      auto size = view.transcode_size<Char16BE>();
+      REQUIRE(size.is_expect());
+      REQUIRE(*size == 15);
+      Char16BE buffer[15];
+      auto written = view.transcode(Span<Char16BE>{buffer, 15});
+      REQUIRE(written.is_expect());
+      REQUIRE(*written == 15);
+      REQUIRE(AnyStringView{BasicStringView<UTF16BE>(buffer, 15)} == view);
+    }
+  }
+
+  SECTION("Format")
+  {
+    for (auto& view : views)
+      REQUIRE(fmt::format("{}", view) == "Héllo μ W\U0001F600rld!");
+  }
+}
@@ -0,0 +1,165 @@
+/*****************************************************************/ /**
+ * @file   test_concurrent_map.cpp
+ * @brief  Unit tests for `ConcurrentMap`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/dsa/concurrent_map.h>
+#include <colt/mem/allocator_ref.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief Counts the blocks allocated and freed (thread-safe)
+struct CountingMallocator
+{
+  static constexpr clt::u64 alignment = clt::mem::Mallocator::alignment;
+
+  std::atomic<size_t> allocated = 0;
+  std::atomic<size_t> freed     = 0;
+
+  clt::mem::MemBlock alloc(clt::u64 size) noexcept
+  {
+    ++allocated;
+    return clt::mem::Mallocator{}.alloc(size);
+  }
+
+  void dealloc(clt::mem::MemBlock blk) noexcept
+  {
+    ++freed;
+    clt::mem::Mallocator{}.dealloc(blk);
+  }
+};
+
+TEST_CASE("ConcurrentMap")
+{
+  using namespace clt;
+
+  SECTION("Insert, find and erase")
+  {
+    ConcurrentMap<u64, std::string> map;
+    REQUIRE(map.is_empty());
+    REQUIRE(map.bucket_count() == map.MIN_BUCKETS);
+    REQUIRE(map.insert(1, "one"));
+    REQUIRE(!map.insert(1, "uno"));
+    REQUIRE(map.insert(2, "two"));
+    REQUIRE(map.size() == 2);
+    REQUIRE(map.find(1).value() == "one");
+    REQUIRE(map.find(3).is_none());
+    REQUIRE(map.contains(2));
+
+    REQUIRE(!map.insert_or_assign(1, "uno"));
+    REQUIRE(map.find(1).value() == "uno");
+    REQUIRE(map.insert_or_assign(3, "three"));
+    REQUIRE(map.update(3, [](std::string& value) { value += "!"; }));
+    REQUIRE(!map.update(4, [](std::string&) {}));
+    size_t length = 0;
+    REQUIRE(map.visit(3, [&](const std::string& value) { length = value.size(); }));
+    REQUIRE(length == 6);
+
+    REQUIRE(map.erase(2));
+    REQUIRE(!map.erase(2));
+    REQUIRE(!map.contains(2));
+    REQUIRE(map.size() == 2);
+
+    map.clear();
+    REQUIRE(map.is_empty());
+    REQUIRE(map.find(1).is_none());
+  }
+
+  SECTION("Grow")
+  {
+    ConcurrentMap<u64, u64> map;
+    for (u64 i = 0; i < 1000; i++)
+      REQUIRE(map.insert(i, i * i));
+    REQUIRE(map.size() == 1000);
+    REQUIRE(map.bucket_count() >= 1000);
+    for (u64 i = 0; i < 1000; i++)
+      REQUIRE(map.find(i).value() == i * i);
+
+    u64 sum = 0;
+    map.for_each([&](const u64& key, const u64&) { sum += key; });
+    REQUIRE(sum == 999 * 1000 / 2);
+  }
+
+  SECTION("Memory is freed through the allocator")
+  {
+    CountingMallocator counting;
+    exec::EpochDomain domain;
+    {
+      ConcurrentMap<
+          u64, u64, default_hash, std::equal_to<u64>,
+          mem::LocalAllocatorRef<CountingMallocator>>
+          map{counting, domain};
+      for (u64 i = 0; i < 200; i++)
+        map.insert(i, i);
+      for (u64 i = 0; i < 200; i += 2)
+        map.insert_or_assign(i, 0);
+      for (u64 i = 1; i < 200; i += 2)
+        map.erase(i);
+      REQUIRE(map.size() == 100);
+    }
+    REQUIRE(counting.allocated == counting.freed);
+    REQUIRE(domain.pending() == 0);
+  }
+
+  SECTION("Concurrent readers and writers")
+  {
+    constexpr u64 KEYS = 512;
+    ConcurrentMap<u64, u64> map;
+    for (u64 i = 0; i < KEYS; i += 2)
+      map.insert(i, i);
+
+    std::atomic<bool> done     = false;
+    std::atomic<size_t> errors = 0;
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; t++)
+    {
+      readers.emplace_back(
+          [&]
+          {
+            while (!done.load(std::memory_order_relaxed))
+            {
+              for (u64 i = 0; i < KEYS; i++)
+              {
+                // Values are always a multiple of their key
+                if (auto value = map.find(i); value.is_value() && i != 0)
+                  errors += *value % i != 0;
+              }
+            }
+          });
+    }
+    std::vector<std::thread> writers;
+    for (u64 t = 0; t < 2; t++)
+    {
+      writers.emplace_back(
+          [&, t]
+          {
+            for (u64 round = 1; round <= 20; round++)
+            {
+              for (u64 i = t; i < KEYS; i += 2)
+              {
+                map.insert_or_assign(i, i * round);
+                map.update(i, [&](u64& value) { value += i; });
+                if (round % 4 == 0)
+                  map.erase(i);
+              }
+            }
+          });
+    }
+    for (auto& writer : writers)
+      writer.join();
+    done = true;
+    for (auto& reader : readers)
+      reader.join();
+
+    REQUIRE(errors == 0);
+    // The last round erased every key
+    REQUIRE(map.is_empty());
+    for (u64 i = 0; i < KEYS; i++)
+      REQUIRE(map.find(i).is_none());
+  }
+}
@@ -0,0 +1,199 @@
+/*****************************************************************/ /**
+ * @file   test_concurrent_queue.cpp
+ * @brief  Unit tests for `SpscRing` and `MpmcQueue`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/dsa/concurrent_queue.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("SpscRing")
+{
+  using namespace clt;
+
+  SECTION("Push and pop")
+  {
+    SpscRing<std::string, 4> ring;
+    REQUIRE(ring.capacity() == 4);
+    REQUIRE(ring.is_empty());
+    REQUIRE(ring.pop().is_none());
+    REQUIRE(ring.push("a"));
+    REQUIRE(ring.emplace(3, 'b'));
+    REQUIRE(ring.push(std::string{"c"}));
+    REQUIRE(ring.push("d"));
+    REQUIRE(!ring.push("e"));
+    REQUIRE(ring.size() == 4);
+    REQUIRE(ring.pop().value() == "a");
+    REQUIRE(ring.pop().value() == "bbb");
+    // Wraps around
+    REQUIRE(ring.push("e"));
+    REQUIRE(ring.pop().value() == "c");
+    REQUIRE(ring.pop().value() == "d");
+    REQUIRE(ring.pop().value() == "e");
+    REQUIRE(ring.pop().is_none());
+    // The remaining elements are destroyed
+    REQUIRE(ring.push("f"));
+  }
+
+  SECTION("Batch")
+  {
+    SpscRing<int, 8> ring;
+    const std::array<int, 6> values = {0, 1, 2, 3, 4, 5};
+    REQUIRE(ring.push_batch(values) == 6);
+    REQUIRE(ring.push_batch(values) == 2);
+    std::array<int, 5> out = {};
+    REQUIRE(ring.pop_batch(out) == 5);
+    REQUIRE(out == std::array<int, 5>{0, 1, 2, 3, 4});
+    REQUIRE(ring.pop_batch(out) == 3);
+    REQUIRE(out[0] == 5);
+    REQUIRE(out[1] == 0);
+    REQUIRE(out[2] == 1);
+    REQUIRE(ring.pop_batch(out) == 0);
+  }
+
+  SECTION("Producer and consumer")
+  {
+    constexpr u64 COUNT = 100'000;
+    SpscRing<u64, 64> ring;
+    std::thread producer{[&]
+                         {
+                           u64 batch[7];
+                           for (u64 i = 0; i < COUNT;)
+                           {
+                             if (i % 3 == 0)
+                             {
+                               i += ring.push(i);
+                               continue;
+                             }
+                             const u64 count = std::min<u64>(7, COUNT - i);
+                             for (u64 j = 0; j < count; j++)
+                               batch[j] = i + j;
+                             i += ring.push_batch({batch, count});
+                           }
+                         }};
+    u64 expected = 0;
+    bool ordered = true;
+    u64 out[5];
+    while (expected != COUNT)
+    {
+      const size_t count = ring.pop_batch(out);
+      for (size_t i = 0; i < count; i++)
+        ordered &= out[i] == expected++;
+      if (auto value = ring.pop(); value.is_value())
+        ordered &= *value == expected++;
+    }
+    producer.join();
+    REQUIRE(ordered);
+    REQUIRE(ring.is_empty());
+  }
+}
+
+TEST_CASE("MpmcQueue")
+{
+  using namespace clt;
+
+  SECTION("Push and pop")
+  {
+    MpmcQueue<std::unique_ptr<int>> queue{3};
+    REQUIRE(queue.capacity() == 4);
+    REQUIRE(queue.pop().is_none());
+    for (int i = 0; i < 4; i++)
+      REQUIRE(queue.push(std::make_unique<int>(i)));
+    REQUIRE(!queue.push(std::make_unique<int>(4)));
+    REQUIRE(queue.size() == 4);
+    REQUIRE(**queue.pop() == 0);
+    REQUIRE(queue.emplace(new int(4)));
+    for (int i = 1; i < 5; i++)
+      REQUIRE(**queue.pop() == i);
+    REQUIRE(queue.is_empty());
+    // The remaining elements are destroyed
+    REQUIRE(queue.emplace(new int(5)));
+  }
+
+  SECTION("Batch")
+  {
+    MpmcQueue<int> queue{8};
+    const std::array<int, 6> values = {0, 1, 2, 3, 4, 5};
+    REQUIRE(queue.push_batch(values) == 6);
+    REQUIRE(queue.push_batch(values) == 2);
+    REQUIRE(queue.push_batch(values) == 0);
+    std::array<int, 5> out = {};
+    REQUIRE(queue.pop_batch(out) == 5);
+    REQUIRE(out == std::array<int, 5>{0, 1, 2, 3, 4});
+    REQUIRE(queue.pop_batch(out) == 3);
+    REQUIRE(out[0] == 5);
+    REQUIRE(out[2] == 1);
+    REQUIRE(queue.pop_batch(out) == 0);
+  }
+
+  SECTION("Producers and consumers")
+  {
+    constexpr u64 PER_PRODUCER = 20'000;
+    constexpr u64 PRODUCERS    = 3;
+    MpmcQueue<u64> queue{64};
+    std::atomic<u64> sum      = 0;
+    std::atomic<u64> consumed = 0;
+
+    std::vector<std::thread> threads;
+    for (u64 p = 0; p < PRODUCERS; p++)
+    {
+      threads.emplace_back(
+          [&, p]
+          {
+            const u64 first = p * PER_PRODUCER + 1;
+            for (u64 i = 0; i < PER_PRODUCER;)
+            {
+              if (p % 2 == 0)
+              {
+                i += queue.push(first + i);
+                continue;
+              }
+              u64 batch[4];
+              const u64 count = std::min<u64>(4, PER_PRODUCER - i);
+              for (u64 j = 0; j < count; j++)
+                batch[j] = first + i + j;
+              i += queue.push_batch({batch, count});
+            }
+          });
+    }
+    for (u64 c = 0; c < 2; c++)
+    {
+      threads.emplace_back(
+          [&, c]
+          {
+            u64 out[3];
+            while (consumed.load(std::memory_order_relaxed)
+                   != PRODUCERS * PER_PRODUCER)
+            {
+              if (c == 0)
+              {
+                if (auto value = queue.pop(); value.is_value())
+                {
+                  sum += *value;
+                  ++consumed;
+                }
+                continue;
+              }
+              const size_t count = queue.pop_batch(out);
+              for (size_t i = 0; i < count; i++)
+                sum += out[i];
+              consumed += count;
+            }
+          });
+    }
+    for (auto& thread : threads)
+      thread.join();
+
+    constexpr u64 TOTAL = PRODUCERS * PER_PRODUCER;
+    REQUIRE(consumed == TOTAL);
+    REQUIRE(sum == TOTAL * (TOTAL + 1) / 2);
+    REQUIRE(queue.is_empty());
+  }
+}
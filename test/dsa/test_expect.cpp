@@ -8,6 +8,9 @@
 #include "../includes.h"
 #include <string_view>
 #include <colt/dsa/expect.h>
+#include <colt/meta/reflect.h>
+
+DECLARE_ENUM_WITH_TYPE(clt::u8, expect_test, Errc, NotFound, Denied, Invalid);
 
 TEST_CASE("Expect")
 {
@@ -85,4 +88,42 @@ TEST_CASE("Expect")
     in(value).or_throw();
     REQUIRE(value.value_or(0) == 12);
   }
+  SECTION("niche")
+  {
+    using expect_test::Errc;
+    static_assert(sizeof(Expect<u32, Errc>) > sizeof(u32));
+    static_assert(sizeof(Expect<const u32*, Errc>) > sizeof(const u32*));
+    static_assert(sizeof(Expect<const u32*, bool>) > sizeof(const u32*));
+    static_assert(sizeof(Expect<Errc, bool>) == sizeof(Errc));
+    static_assert(Expect<Errc, bool>{Error, true}.error());
+
+    const u32 value = 10;
+    Expect<const u32*, Errc> b = &value;
+    REQUIRE(b.is_expect());
+    REQUIRE(*b.value() == 10);
+    b = Expect<const u32*, Errc>{Error, Errc::Denied};
+    REQUIRE(b.is_error());
+    REQUIRE(b.error() == Errc::Denied);
+    // Pointers are not packed: the error is returned by reference
+    b.error() = Errc::Invalid;
+    REQUIRE(b.error() == Errc::Invalid);
+    b = Expect<const u32*, Errc>{Error, Errc::Denied};
+    auto copy = b;
+    REQUIRE(copy.error() == Errc::Denied);
+    REQUIRE(b.value_or(nullptr) == nullptr);
+    REQUIRE(
+        b.map([](const u32* ptr) { return *ptr; }).error() == Errc::Denied);
+    REQUIRE(
+        b.or_else([](Errc err) { return Expect<const u32*, Errc>{Error, err}; })
+            .error()
+        == Errc::Denied);
+    // nullptr is an expected value
+    b = nullptr;
+    REQUIRE(b.is_expect());
+
+    Expect<Errc, bool> c = Errc::Invalid;
+    REQUIRE(c.value() == Errc::Invalid);
+    c = Expect<Errc, bool>{Error, false};
+    REQUIRE(!c.error());
+  }
 }
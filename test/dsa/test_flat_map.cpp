@@ -0,0 +1,193 @@
+/*****************************************************************/ /**
+ * @file   test_flat_map.cpp
+ * @brief  Unit tests for `FlatMap` and `FlatSet`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/dsa/flat_map.h>
+#include <colt/dsa/map.h>
+#include <colt/unicode/casefold.h>
+#include <string>
+
+TEST_CASE("FlatMap")
+{
+  using namespace clt;
+
+  SECTION("Insert and Find")
+  {
+    FlatMap<u64, u64> map;
+    REQUIRE(map.is_empty());
+    REQUIRE(!map.contains(0));
+    REQUIRE(map.find(0) == map.end());
+    for (u64 i = 0; i < 10'000; i++)
+      REQUIRE(map.try_emplace(i, i * 3).second);
+    REQUIRE(map.size() == 10'000);
+    REQUIRE(map.load_factor() <= 0.875f);
+    REQUIRE(!map.try_emplace(5, 0).second);
+    for (u64 i = 0; i < 10'000; i++)
+    {
+      REQUIRE(map.find(i) != map.end());
+      REQUIRE(*map.get(i) == i * 3);
+    }
+    REQUIRE(map.get(10'000) == nullptr);
+    map[10'000] = 1;
+    REQUIRE(map.size() == 10'001);
+    map.insert_or_assign(10'000, 2);
+    REQUIRE(map[10'000] == 2);
+
+    i64 sum = 0;
+    for (const auto& [key, value] : map)
+      sum += static_cast<i64>(value) - static_cast<i64>(key) * 3;
+    REQUIRE(sum == 2 - 30'000);
+  }
+
+  SECTION("Erase")
+  {
+    FlatMap<u64, std::string> map;
+    for (u64 i = 0; i < 1000; i++)
+      map.try_emplace(i, std::to_string(i));
+    for (u64 i = 0; i < 1000; i += 2)
+      REQUIRE(map.erase(i));
+    REQUIRE(!map.erase(0));
+    REQUIRE(map.size() == 500);
+    for (u64 i = 0; i < 1000; i++)
+      REQUIRE(map.contains(i) == (i % 2 == 1));
+    REQUIRE(*map.get(999) == "999");
+    // Erasing and inserting repeatedly reuses the deleted slots
+    const size_t capacity = map.capacity();
+    for (u64 i = 0; i < 10'000; i++)
+    {
+      map.try_emplace(5'000 + i, "tmp");
+      map.erase(map.find(5'000 + i));
+    }
+    REQUIRE(map.capacity() == capacity);
+    REQUIRE(map.size() == 500);
+    map.clear();
+    REQUIRE(map.is_empty());
+    REQUIRE(map.begin() == map.end());
+  }
+
+  SECTION("Heterogeneous Lookups")
+  {
+    using namespace clt::uni;
+    FlatMap<u8StringView, int, CaseFoldHash<>, CaseFoldEqual> map;
+    map.try_emplace("while"_UTF8, 0);
+    map.try_emplace("Straße"_UTF8, 1);
+    REQUIRE(map.find("WHILE"_UTF8)->second == 0);
+    REQUIRE(*map.get("STRASSE"_UTF8) == 1);
+    REQUIRE(map.find(StringView{"While"})->second == 0);
+    REQUIRE(!map.contains("for"_UTF8));
+  }
+
+  SECTION("Unaligned Keys")
+  {
+    // Equal keys at different addresses must hash equally
+    const char text[] = "the quick brown fox jumps over the lazy dog";
+    FlatMap<StringView, size_t> map;
+    for (size_t len = 0; len < sizeof(text); len++)
+      REQUIRE(map.try_emplace(StringView{text, len}, len).second);
+    for (size_t offset = 1; offset < 8; offset++)
+    {
+      std::string copy = std::string(offset, ' ') + text;
+      for (size_t len = 0; len < sizeof(text); len++)
+      {
+        auto found = map.get(StringView{copy.data() + offset, len});
+        REQUIRE(found != nullptr);
+        REQUIRE(*found == len);
+      }
+    }
+  }
+
+  SECTION("Copy and Move")
+  {
+    FlatMap<u64, std::string> map;
+    for (u64 i = 0; i < 100; i++)
+      map.try_emplace(i, std::string(40, 'a'));
+    auto copy = map;
+    REQUIRE(copy.size() == 100);
+    REQUIRE(*copy.get(42) == std::string(40, 'a'));
+    auto moved = std::move(copy);
+    REQUIRE(moved.size() == 100);
+    REQUIRE(copy.is_empty());
+    map = moved;
+    REQUIRE(map.size() == 100);
+  }
+
+  SECTION("Local Allocator")
+  {
+    mem::StatsAllocator<mem::Mallocator> alloc;
+    using Ref = mem::LocalAllocatorRef<decltype(alloc)>;
+    {
+      BasicFlatMap<u32, u32, Ref> map{Ref{alloc}};
+      map.reserve(1000);
+      const size_t capacity = map.capacity();
+      for (u32 i = 0; i < 1000; i++)
+        map[i] = i;
+      REQUIRE(map.capacity() == capacity);
+      REQUIRE(alloc.stats().alloc_count == 1);
+    }
+    REQUIRE(alloc.stats().live_bytes == 0);
+  }
+}
+
+TEST_CASE("FlatSet")
+{
+  using namespace clt;
+
+  FlatSet<u32> set;
+  REQUIRE(set.insert(1).second);
+  REQUIRE(!set.insert(1U).second);
+  REQUIRE(set.insert(2).second);
+  REQUIRE(set.contains(1U));
+  REQUIRE(set.size() == 2);
+  REQUIRE(set.erase(1U));
+  REQUIRE(!set.contains(1U));
+  REQUIRE(*set.begin() == 2);
+}
+
+TEST_CASE("FlatMap Benchmark", "[.][benchmark]")
+{
+  using namespace clt;
+  constexpr u64 COUNT = 100'000;
+
+  FlatMap<u64, u64> flat;
+  Map<u64, u64> map;
+  for (u64 i = 0; i < COUNT; i++)
+  {
+    flat.try_emplace(i * 7919, i);
+    map.emplace(i * 7919, i);
+  }
+
+  BENCHMARK("FlatMap insert")
+  {
+    FlatMap<u64, u64> tmp;
+    for (u64 i = 0; i < COUNT; i++)
+      tmp.try_emplace(i * 7919, i);
+    return tmp.size();
+  };
+  BENCHMARK("Map insert")
+  {
+    Map<u64, u64> tmp;
+    for (u64 i = 0; i < COUNT; i++)
+      tmp.emplace(i * 7919, i);
+    return tmp.size();
+  };
+  BENCHMARK("FlatMap lookup")
+  {
+    u64 sum = 0;
+    for (u64 i = 0; i < COUNT * 2; i++)
+      if (auto ptr = flat.get(i * 7919))
+        sum += *ptr;
+    return sum;
+  };
+  BENCHMARK("Map lookup")
+  {
+    u64 sum = 0;
+    for (u64 i = 0; i < COUNT * 2; i++)
+      if (auto it = map.find(i * 7919); it != map.end())
+        sum += it->second;
+    return sum;
+  };
+}
@@ -0,0 +1,61 @@
+/*****************************************************************/ /**
+ * @file   test_map.cpp
+ * @brief  Unit tests for `Map` and `Set`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/dsa/map.h>
+#include <colt/dsa/set.h>
+#include <colt/mem/arena_alloc.h>
+
+TEST_CASE("Map and Set")
+{
+  using namespace clt;
+
+  SECTION("Default Allocator")
+  {
+    Map<u64, u64> map;
+    Set<u64> set;
+    for (u64 i = 0; i < 1000; i++)
+    {
+      map[i] = i * 2;
+      set.insert(i);
+    }
+    REQUIRE(map.size() == 1000);
+    REQUIRE(map.at(500) == 1000);
+    REQUIRE(set.contains(999));
+  }
+
+  SECTION("Local Allocator")
+  {
+    mem::StatsAllocator<mem::Mallocator> alloc;
+    using Ref = mem::LocalAllocatorRef<decltype(alloc)>;
+    {
+      Map<u64, u64, uhash<murmur64a_h>, std::equal_to<u64>, Ref> map{Ref{alloc}};
+      Set<u64, uhash<murmur64a_h>, std::equal_to<u64>, Ref> set{Ref{alloc}};
+      for (u64 i = 0; i < 1000; i++)
+      {
+        map.emplace(i, i);
+        set.insert(i);
+      }
+      REQUIRE(map.size() == 1000);
+      REQUIRE(set.size() == 1000);
+      REQUIRE(alloc.stats().alloc_count != 0);
+    }
+    REQUIRE(alloc.stats().live_bytes == 0);
+  }
+
+  SECTION("Arena")
+  {
+    // The arena is freed at once: the map never deallocates
+    mem::ArenaAllocator<mem::Mallocator> arena;
+    using Ref = mem::LocalAllocatorRef<decltype(arena)>;
+    Map<u64, u64, uhash<murmur64a_h>, std::equal_to<u64>, Ref> map{Ref{arena}};
+    for (u64 i = 0; i < 100; i++)
+      map.emplace(i, i);
+    REQUIRE(map.at(42) == 42);
+    REQUIRE(map.get_allocator() == mem::StdAllocator<u8, Ref>{Ref{arena}});
+  }
+}
@@ -7,6 +7,22 @@
  *********************************************************************/
 #include "../includes.h"
 #include <colt/dsa/option.h>
+#include <colt/dsa/smart_pointers.h>
+#include <colt/dsa/string_interner.h>
+#include <colt/meta/reflect.h>
+#include <colt/num/bitfields.h>
+
+DECLARE_ENUM_WITH_TYPE(clt::u8, option_test, Color, Red, Green, Blue);
+
+/// @brief Bitfields whose last 4 bits are padding
+using PaddedBits =
+    clt::Bitfields<clt::u16, clt::Bitfield<0, 12>, clt::Bitfield<1, 4>>;
+
+template<>
+struct clt::meta::bitfields_niche_field<PaddedBits>
+{
+  static constexpr auto value = 1;
+};
 
 TEST_CASE("Option")
 {
@@ -70,4 +86,54 @@ TEST_CASE("Option")
     in(value).or_throw();
     REQUIRE(value.value_or(0) == 12);
   }
+  SECTION("niche")
+  {
+    using option_test::Color;
+    static_assert(sizeof(Option<u32>) > sizeof(u32));
+    static_assert(sizeof(Option<u32*>) > sizeof(u32*));
+    static_assert(sizeof(Option<NonNull<u32>>) == sizeof(u32*));
+    static_assert(sizeof(Option<Color>) == sizeof(Color));
+    static_assert(sizeof(Option<PaddedBits>) == sizeof(PaddedBits));
+    static_assert(sizeof(Option<StringHandle>) == sizeof(StringHandle));
+    // Niche layouts of enums and NonNull are usable at compile time
+    static_assert(Option<Color>{Color::Blue}.value() == Color::Blue);
+    static_assert(Option<Color>{}.is_none());
+    static_assert(Option<NonNull<const PaddedBits>>{}.is_none());
+
+    u32 value = 0;
+    Option<u32*> ptr;
+    REQUIRE(ptr.is_none());
+    // nullptr is a value
+    ptr = nullptr;
+    REQUIRE(ptr.is_value());
+    REQUIRE(*ptr == nullptr);
+    ptr = &value;
+    REQUIRE(*ptr == &value);
+    ptr.reset();
+    REQUIRE(ptr.is_none());
+
+    Option<NonNull<u32>> non_null;
+    REQUIRE(non_null.is_none());
+    non_null = NonNull{&value};
+    REQUIRE(non_null->get() == &value);
+    **non_null = 5;
+    REQUIRE(value == 5);
+    Option<NonNull<u32>> copy = non_null;
+    REQUIRE(copy.value() == NonNull{&value});
+    non_null.reset();
+    REQUIRE(non_null.is_none());
+    REQUIRE(copy.is_value());
+
+    Option<Color> color = Color::Red;
+    REQUIRE(color.value() == Color::Red);
+    color = None;
+    REQUIRE(color.is_none());
+    REQUIRE(meta::reflect<Color>::from(2).value() == Color::Blue);
+    REQUIRE(meta::reflect<Color>::from(3).is_none());
+
+    Option<PaddedBits> bits = PaddedBits(InPlace, 0xFFF, 0);
+    REQUIRE(bits->get<0>() == 0xFFF);
+    bits = None;
+    REQUIRE(bits.is_none());
+  }
 }
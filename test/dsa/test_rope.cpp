@@ -0,0 +1,108 @@
+/*****************************************************************/ /**
+ * @file   test_rope.cpp
+ * @brief  Unit tests for `BasicRope`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/dsa/rope.h>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST_CASE("Rope")
+{
+  using namespace clt;
+
+  mem::StatsAllocator<mem::Mallocator> alloc;
+  using Ref = mem::LocalAllocatorRef<decltype(alloc)>;
+
+  SECTION("Random Edits")
+  {
+    {
+      // Small chunks to exercise splitting and balancing
+      BasicRope<StringEncoding::ASCII, Ref, 16> rope = Ref{alloc};
+      std::string expected;
+      std::mt19937_64 rng{42};
+      const char* alphabet = "abcdef\n";
+      for (size_t step = 0; step < 2000; step++)
+      {
+        if (expected.empty() || rng() % 3 != 0)
+        {
+          const size_t at = rng() % (expected.size() + 1);
+          std::string str(rng() % 40, ' ');
+          for (auto& chr : str)
+            chr = alphabet[rng() % 7];
+          rope.insert(at, StringView{str.data(), str.size()});
+          expected.insert(at, str);
+        }
+        else
+        {
+          const size_t at    = rng() % expected.size();
+          const size_t count = rng() % (expected.size() - at + 1);
+          rope.erase(at, count);
+          expected.erase(at, count);
+        }
+        REQUIRE(rope.size() == expected.size());
+      }
+
+      std::string content;
+      rope.for_each_chunk(
+          [&](StringView chunk)
+          {
+            REQUIRE(chunk.unit_len() <= 16);
+            content.append(chunk.data(), chunk.unit_len());
+          });
+      REQUIRE(content == expected);
+      for (size_t i = 0; i < expected.size(); i++)
+        REQUIRE(rope[i] == static_cast<char32_t>(expected[i]));
+
+      std::vector<size_t> starts = {0};
+      for (size_t i = 0; i < expected.size(); i++)
+        if (expected[i] == '\n')
+          starts.push_back(i + 1);
+      REQUIRE(rope.line_count() == starts.size());
+      for (size_t line = 0; line < starts.size(); line++)
+      {
+        REQUIRE(rope.line_start(line) == starts[line]);
+        REQUIRE(rope.line_of(starts[line]) == line);
+      }
+    }
+    REQUIRE(alloc.stats().live_bytes == 0);
+  }
+
+  SECTION("UTF8")
+  {
+    BasicRope<StringEncoding::UTF8, Ref, 8> rope = Ref{alloc};
+    rope.append("héllo\n"_UTF8);
+    rope.append("wörld €\U0001F600"_UTF8);
+    REQUIRE(rope.size() == 14);
+    REQUIRE(rope.unit_len() == 21);
+    REQUIRE(rope[1] == U'é');
+    REQUIRE(rope[12] == U'€');
+    REQUIRE(rope[13] == U'\U0001F600');
+    REQUIRE(rope.line_start(1) == 6);
+    REQUIRE(rope.line_of(13) == 1);
+
+    // Code points are never split between chunks
+    rope.insert(12, "ààààà"_UTF8);
+    rope.for_each_chunk(
+        [](u8StringView chunk)
+        {
+          REQUIRE(chunk.unit_len() <= 8);
+          REQUIRE(uni::countlen(chunk.data(), chunk.unit_len()) == chunk.size());
+        });
+    REQUIRE(rope[16] == U'à');
+    REQUIRE(rope[17] == U'€');
+    rope.erase(1, 16);
+    REQUIRE(rope.size() == 3);
+    REQUIRE(rope[0] == U'h');
+    REQUIRE(rope[1] == U'€');
+    REQUIRE(rope.line_count() == 1);
+
+    auto moved = std::move(rope);
+    REQUIRE(rope.is_empty());
+    REQUIRE(moved.size() == 3);
+  }
+}
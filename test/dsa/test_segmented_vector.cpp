@@ -0,0 +1,102 @@
+/*****************************************************************/ /**
+ * @file   test_segmented_vector.cpp
+ * @brief  Unit tests for `BasicSegmentedVector`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/dsa/segmented_vector.h>
+#include <algorithm>
+#include <string>
+#include <thread>
+
+TEST_CASE("SegmentedVector")
+{
+  using namespace clt;
+
+  mem::StatsAllocator<mem::Mallocator> alloc;
+  using Ref = mem::LocalAllocatorRef<decltype(alloc)>;
+
+  SECTION("Stable Addresses")
+  {
+    {
+      BasicSegmentedVector<u64, 16, Ref> vec = Ref{alloc};
+      const u64* first = &vec.push_back(0);
+      for (u64 i = 1; i < 1000; i++)
+        vec.push_back(i);
+      REQUIRE(&vec.front() == first);
+      REQUIRE(vec.size() == 1000);
+      REQUIRE(vec.capacity() == 1008);
+      REQUIRE(vec.chunk_count() == 63);
+      REQUIRE(vec.chunk(62).size() == 1000 - 62 * 16);
+      for (u64 i = 0; i < 1000; i++)
+        REQUIRE(vec[i] == i);
+      REQUIRE(std::is_sorted(vec.begin(), vec.end()));
+      REQUIRE(*std::lower_bound(vec.begin(), vec.end(), 500) == 500);
+
+      vec.pop_back_n(990);
+      vec.shrink_to_fit();
+      REQUIRE(vec.capacity() == 16);
+      REQUIRE(&vec.front() == first);
+    }
+    REQUIRE(alloc.stats().live_bytes == 0);
+  }
+
+  SECTION("Non Trivial")
+  {
+    {
+      BasicSegmentedVector<std::string, 4, Ref> vec = Ref{alloc};
+      for (size_t i = 0; i < 50; i++)
+        vec.push_back(std::string(30, 'a' + i % 26));
+      auto copy = vec;
+      REQUIRE(copy.size() == 50);
+      for (size_t i = 0; i < 50; i++)
+        REQUIRE(copy[i] == vec[i]);
+
+      const std::string* data = &vec[10];
+      auto moved              = std::move(vec);
+      REQUIRE(&moved[10] == data);
+      REQUIRE(vec.is_empty());
+
+      copy = moved;
+      REQUIRE(copy[49] == std::string(30, 'a' + 49 % 26));
+      copy.clear();
+      REQUIRE(copy.is_empty());
+    }
+    REQUIRE(alloc.stats().live_bytes == 0);
+  }
+
+  SECTION("Parallel Chunks")
+  {
+    SegmentedVector<u32, 256> vec = mem::GlobalAllocator;
+    for (u32 i = 0; i < 10'000; i++)
+      vec.push_back(i);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < vec.chunk_count(); i++)
+      threads.emplace_back(
+          [chunk = vec.chunk(i)]()
+          {
+            for (auto& value : chunk)
+              value *= 2;
+          });
+    for (auto& thread : threads)
+      thread.join();
+
+    u64 sum = 0;
+    vec.for_each_chunk(
+        [&](View<u32> chunk)
+        {
+          for (auto value : chunk)
+            sum += value;
+        });
+    REQUIRE(sum == 9'999ULL * 10'000);
+    SegmentedVector<int, 2> small = mem::GlobalAllocator;
+    REQUIRE(fmt::format("{}", small) == "[]");
+    small.push_back(1);
+    small.push_back(2);
+    small.push_back(3);
+    REQUIRE(fmt::format("{:h}", small) == "1, 2 and 3");
+  }
+}
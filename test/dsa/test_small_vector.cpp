@@ -0,0 +1,110 @@
+/*****************************************************************/ /**
+ * @file   test_small_vector.cpp
+ * @brief  Unit tests for `BasicSmallVector`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/dsa/small_vector.h>
+#include <string>
+
+TEST_CASE("SmallVector")
+{
+  using namespace clt;
+
+  mem::StatsAllocator<mem::Mallocator> alloc;
+  using Ref = mem::LocalAllocatorRef<decltype(alloc)>;
+
+  SECTION("Inline Storage")
+  {
+    {
+      BasicSmallVector<u64, 8, Ref> vec = Ref{alloc};
+      for (u64 i = 0; i < 8; i++)
+        vec.push_back(i);
+      REQUIRE(vec.is_inline());
+      REQUIRE(vec.capacity() == 8);
+      REQUIRE(vec.size() == 8);
+      vec.pop_back_n(4);
+      vec.append_range(vec.to_view());
+      REQUIRE(vec == View<u64>{std::array<u64, 8>{0, 1, 2, 3, 0, 1, 2, 3}});
+    }
+    REQUIRE(alloc.stats().alloc_count == 0);
+  }
+
+  SECTION("Spill")
+  {
+    {
+      BasicSmallVector<std::string, 4, Ref> vec = Ref{alloc};
+      for (size_t i = 0; i < 100; i++)
+        vec.push_back(std::string(30, 'a' + i % 26));
+      REQUIRE(!vec.is_inline());
+      for (size_t i = 0; i < 100; i++)
+        REQUIRE(vec[i] == std::string(30, 'a' + i % 26));
+
+      // Pushing an object of the Vector while growing
+      while (vec.size() != vec.capacity())
+        vec.push_back(vec.front());
+      vec.push_back(vec.front());
+      REQUIRE(vec.back() == vec.front());
+
+      vec.pop_back_n(vec.size() - 3);
+      vec.shrink_to_fit();
+      REQUIRE(vec.is_inline());
+      REQUIRE(vec[2] == std::string(30, 'c'));
+    }
+    REQUIRE(alloc.stats().live_bytes == 0);
+  }
+
+  SECTION("Copy and Move")
+  {
+    {
+      BasicSmallVector<std::string, 2, Ref> small = Ref{alloc};
+      small.push_back(std::string(40, 'a'));
+      BasicSmallVector<std::string, 2, Ref> big = Ref{alloc};
+      for (size_t i = 0; i < 10; i++)
+        big.push_back(std::string(40, 'b'));
+
+      auto copy = small;
+      REQUIRE(copy.is_inline());
+      REQUIRE(copy == small.to_view());
+      auto big_copy = big;
+      REQUIRE(big_copy == big.to_view());
+
+      // Inline objects are moved, allocated blocks are stolen
+      auto moved = std::move(copy);
+      REQUIRE(moved.is_inline());
+      REQUIRE(copy.is_empty());
+      REQUIRE(moved[0] == std::string(40, 'a'));
+      const std::string* data = big_copy.data();
+      auto stolen             = std::move(big_copy);
+      REQUIRE(stolen.data() == data);
+      REQUIRE(big_copy.is_inline());
+      REQUIRE(big_copy.is_empty());
+
+      moved = std::move(stolen);
+      REQUIRE(moved.data() == data);
+      REQUIRE(moved.size() == 10);
+      big = std::move(small);
+      REQUIRE(!big.is_inline());
+      REQUIRE(big.size() == 1);
+      REQUIRE(big[0] == std::string(40, 'a'));
+
+      small = moved;
+      REQUIRE(small == moved.to_view());
+    }
+    REQUIRE(alloc.stats().live_bytes == 0);
+  }
+
+  SECTION("Format")
+  {
+    SmallVector<int, 4> vec = mem::GlobalAllocator;
+    REQUIRE(fmt::format("{}", vec) == "[]");
+    for (int i = 1; i < 7; i++)
+      vec.push_back(i);
+    REQUIRE(fmt::format("{}", vec) == "[1, 2, 3, 4, 5, 6]");
+    REQUIRE(fmt::format("{:h}", vec) == "1, 2, 3, 4, 5 and 6");
+    Span<int> span = vec;
+    REQUIRE(span.size() == 6);
+  }
+}
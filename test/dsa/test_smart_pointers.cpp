@@ -1,12 +1,15 @@
 /*****************************************************************/ /**
  * @file   test_smart_pointers.cpp
- * @brief  Unit tests for `UniquePtr`.
+ * @brief  Unit tests for `UniquePtr`, `RcPtr`, `ArcPtr` and `IntrusivePtr`.
  * 
  * @author RPC
  * @date   August 2024
  *********************************************************************/
 #include "../includes.h"
 #include <colt/dsa/smart_pointers.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 TEST_CASE("UniquePtr")
 {
@@ -24,4 +27,146 @@ TEST_CASE("UniquePtr")
   auto lptr = make_local_unique<int>(alloc, 5);
   REQUIRE(!lptr.is_null());
   REQUIRE(*lptr == 5);
-}
\ No newline at end of file
+}
+/// @brief Counts its destructions
+struct Counted
+{
+  int* destroyed;
+  int value;
+
+  ~Counted() noexcept { ++*destroyed; }
+};
+
+TEST_CASE("RcPtr")
+{
+  using namespace clt;
+
+  int destroyed = 0;
+  SECTION("Shared ownership")
+  {
+    auto ptr = make_rc<Counted>(&destroyed, 10);
+    REQUIRE(ptr.use_count() == 1);
+    REQUIRE(ptr->value == 10);
+    {
+      auto copy = ptr;
+      REQUIRE(copy == ptr);
+      REQUIRE(ptr.use_count() == 2);
+      copy->value = 11;
+      auto moved = std::move(copy);
+      REQUIRE(copy.is_null());
+      REQUIRE(moved.use_count() == 2);
+    }
+    REQUIRE(destroyed == 0);
+    REQUIRE((*ptr).value == 11);
+    ptr = ptr;
+    REQUIRE(ptr.use_count() == 1);
+    ptr.reset();
+    REQUIRE(ptr.is_null());
+    REQUIRE(ptr.use_count() == 0);
+    REQUIRE(destroyed == 1);
+  }
+
+  SECTION("Assignment")
+  {
+    auto a = make_rc<Counted>(&destroyed, 1);
+    auto b = make_rc<Counted>(&destroyed, 2);
+    a      = b;
+    REQUIRE(destroyed == 1);
+    REQUIRE(a->value == 2);
+    REQUIRE(b.use_count() == 2);
+    b = make_rc<Counted>(&destroyed, 3);
+    REQUIRE(a.use_count() == 1);
+  }
+
+  SECTION("Local allocator")
+  {
+    mem::StackAllocator<256> alloc;
+    {
+      auto ptr  = make_local_rc<Counted>(alloc, &destroyed, 5);
+      auto copy = ptr;
+      REQUIRE(copy->value == 5);
+      REQUIRE(alloc.owns({ptr.get(), sizeof(Counted)}));
+    }
+    REQUIRE(destroyed == 1);
+  }
+  REQUIRE(sizeof(RcPtr<int>) == sizeof(void*));
+}
+
+TEST_CASE("ArcPtr")
+{
+  using namespace clt;
+
+  std::atomic<int> destroyed = 0;
+  struct Node
+  {
+    std::atomic<int>* destroyed;
+    ~Node() noexcept { ++*destroyed; }
+  };
+
+  auto ptr = make_arc<Node>(&destroyed);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++)
+  {
+    threads.emplace_back(
+        [copy = ptr]() mutable
+        {
+          for (int j = 0; j < 1000; j++)
+          {
+            auto other = copy;
+            other.reset();
+          }
+        });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  REQUIRE(ptr.use_count() == 1);
+  REQUIRE(destroyed == 0);
+  ptr.reset();
+  REQUIRE(destroyed == 1);
+}
+
+/// @brief Object storing its count
+struct IntrusiveNode : public clt::IntrusiveCount
+{
+  int* destroyed;
+  int value;
+
+  IntrusiveNode(int* destroyed, int value) noexcept
+      : destroyed(destroyed)
+      , value(value)
+  {
+  }
+  ~IntrusiveNode() noexcept { ++*destroyed; }
+};
+
+TEST_CASE("IntrusivePtr")
+{
+  using namespace clt;
+
+  int destroyed = 0;
+  {
+    auto ptr = make_intrusive<IntrusiveNode>(&destroyed, 10);
+    REQUIRE(ptr.use_count() == 1);
+    // Can be created from the raw pointer
+    auto from_raw = IntrusivePtr<IntrusiveNode>(mem::GlobalAllocator, ptr.get());
+    REQUIRE(ptr.use_count() == 2);
+    REQUIRE(from_raw->value == 10);
+    // Copying the object does not copy its count
+    IntrusiveNode copy = *ptr;
+    REQUIRE(copy.use_count() == 0);
+    from_raw.reset();
+    REQUIRE(ptr.use_count() == 1);
+    REQUIRE(destroyed == 0);
+  }
+  // Destroyed the copy and the node
+  REQUIRE(destroyed == 2);
+
+  mem::StackAllocator<256> alloc;
+  {
+    auto ptr  = make_local_intrusive<IntrusiveNode>(alloc, &destroyed, 5);
+    auto copy = ptr;
+    REQUIRE(copy.use_count() == 2);
+  }
+  REQUIRE(destroyed == 3);
+  REQUIRE(sizeof(IntrusivePtr<IntrusiveNode>) == sizeof(void*));
+}
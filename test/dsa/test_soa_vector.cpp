@@ -0,0 +1,86 @@
+/*****************************************************************/ /**
+ * @file   test_soa_vector.cpp
+ * @brief  Unit tests for `BasicSoAVector`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/dsa/soa_vector.h>
+#include <string>
+
+struct SoAToken
+{
+  clt::u8 kind = 0;
+  clt::u64 offset = 0;
+  std::string text{};
+  clt::u32 not_registered = 10;
+};
+
+COLT_DECLARE_TYPE(SoAToken, kind, offset, text);
+
+TEST_CASE("SoAVector")
+{
+  using namespace clt;
+
+  mem::StatsAllocator<mem::Mallocator> alloc;
+  using Ref = mem::LocalAllocatorRef<decltype(alloc)>;
+
+  SECTION("Columns")
+  {
+    {
+      BasicSoAVector<SoAToken, Ref> vec = Ref{alloc};
+      STATIC_REQUIRE(vec.column_count() == 3);
+      STATIC_REQUIRE(std::same_as<decltype(vec)::column_t<2>, std::string>);
+      for (u64 i = 0; i < 1000; i++)
+        vec.push_back(SoAToken{u8(i % 7), i * 3, std::string(20, 'a' + i % 26)});
+      REQUIRE(vec.size() == 1000);
+
+      const Span<u8> kinds = vec.column<0>();
+      const View<u64> offsets = std::as_const(vec).column<1>();
+      REQUIRE(kinds.size() == 1000);
+      REQUIRE(reinterpret_cast<uintptr_t>(offsets.data()) % alignof(u64) == 0);
+      for (u64 i = 0; i < 1000; i++)
+      {
+        REQUIRE(kinds[i] == i % 7);
+        REQUIRE(offsets[i] == i * 3);
+        REQUIRE(vec[i].get<2>() == std::string(20, 'a' + i % 26));
+      }
+      // Only the columns of the registered members are stored
+      auto token = vec.load(5);
+      REQUIRE(token.offset == 15);
+      REQUIRE(token.text == std::string(20, 'f'));
+      REQUIRE(token.not_registered == 10);
+
+      token.text = "hello";
+      vec[0]     = token;
+      REQUIRE(vec[0].get<2>() == "hello");
+      REQUIRE(static_cast<SoAToken>(vec[0]).offset == 15);
+
+      auto copy = vec;
+      vec.pop_back();
+      vec.shrink_to_fit();
+      REQUIRE(vec.capacity() == 999);
+      REQUIRE(copy.size() == 1000);
+      REQUIRE(copy[999].get<2>() == std::string(20, 'a' + 999 % 26));
+
+      auto moved = std::move(copy);
+      REQUIRE(copy.is_empty());
+      REQUIRE(moved[0].get<2>() == "hello");
+      moved.clear();
+      REQUIRE(moved.is_empty());
+    }
+    auto stats = alloc.stats();
+    REQUIRE(stats.live_bytes == 0);
+  }
+
+  SECTION("Single Allocation")
+  {
+    {
+      BasicSoAVector<SoAToken, Ref> vec = {Ref{alloc}, 100};
+      for (u64 i = 0; i < 100; i++)
+        vec.push_back(SoAToken{});
+    }
+    REQUIRE(alloc.stats().alloc_count == 1);
+  }
+}
@@ -7,6 +7,7 @@
  *********************************************************************/
 #include "../includes.h"
 #include <colt/dsa/string.h>
+#include <string>
 
 using namespace clt;
 
@@ -107,4 +108,123 @@ TEMPLATE_LIST_TEST_CASE("BasicString", "[BasicString]", AllStrings)
     ab.pop_back_n(2);
     REQUIRE(ab[0] == U'1');
   }
+  SECTION("Literal is not copied")
+  {
+    const auto& literal = "Hello \u03BC World!"_UTF8;
+    StringType ab       = {mem::Mallocator{}, literal};
+    REQUIRE(ab.size() == 14);
+    REQUIRE(ab[6] == U'\u03BC');
+    if constexpr (StringType::HAS_COW)
+    {
+      REQUIRE(ab.is_borrowed());
+      REQUIRE(ab.c_str() == literal.data());
+      StringType copy = ab;
+      REQUIRE(copy.c_str() == literal.data());
+      // Removing from the front does not copy
+      copy.pop_front_n(6);
+      REQUIRE(copy.is_borrowed());
+      REQUIRE(copy.size() == 8);
+      REQUIRE(copy == "\u03BC World!"_UTF8);
+      REQUIRE(copy.index_back(1) == U'd');
+      // Modifying copies
+      copy += "!"_UTF8;
+      REQUIRE_FALSE(copy.is_borrowed());
+      REQUIRE(copy == "\u03BC World!!"_UTF8);
+      REQUIRE(copy.size() == 9);
+    }
+    ab.pop_back();
+    REQUIRE_FALSE(ab.is_borrowed());
+    REQUIRE(ab == "Hello \u03BC World"_UTF8);
+    REQUIRE(literal == "Hello \u03BC World!"_UTF8);
+  }
+  SECTION("Copy and move")
+  {
+    u8StringView a = "10\u03BC\u00BC10\u03BC\u00BC10\u03BC\u00BC10\u03BC"
+                     "\u00BC10\u03BC\u00BC10\u03BC\u00BC10\u03BC\u00BC"_UTF8;
+    StringType ab  = {mem::Mallocator{}, a};
+    StringType copy = ab;
+    REQUIRE(copy == ab);
+    REQUIRE(copy.c_str() != ab.c_str());
+    REQUIRE(copy.size() == 28);
+    REQUIRE(copy[14] == U'\u03BC');
+    StringType moved = std::move(copy);
+    REQUIRE(moved == ab);
+    REQUIRE(copy.is_empty());
+    REQUIRE(copy.size() == 0);
+    copy = moved;
+    REQUIRE(copy == ab);
+    StringType small = {mem::Mallocator{}, "1\u03BC"_UTF8};
+    copy             = std::move(small);
+    REQUIRE(copy.size() == 2);
+    REQUIRE(copy.back() == U'\u03BC');
+  }
+  SECTION("Append and pop keep the caches")
+  {
+    // Compares each index with a decoding from the start
+    auto check = [](const StringType& str, size_t count)
+    {
+      REQUIRE(str.size() == count);
+      REQUIRE(str.size() == uni::countlen(str.c_str(), str.unit_len()));
+      for (size_t i = 0; i < count; i++)
+      {
+        REQUIRE(str[i] == uni::index_front(str.c_str(), i));
+        REQUIRE(str.index_back(i) == uni::index_front(str.c_str(), count - 1 - i));
+      }
+    };
+    StringType ab = {mem::Mallocator{}};
+    check(ab, 0);
+    size_t count = 0;
+    for (size_t i = 0; i < 40; i++)
+    {
+      switch (i % 4)
+      {
+      case 0:
+        ab += "a"_UTF8;
+        count += 1;
+        break;
+      case 1:
+        ab += "\u03BC\u00BCb"_UTF8;
+        count += 3;
+        break;
+      case 2:
+        ab.push_back(U'\U0001F600');
+        count += 1;
+        break;
+      case 3:
+        ab += "\u20AC\U0001F600cd"_UTF8;
+        count += 4;
+        break;
+      }
+      check(ab, count);
+    }
+    // Self append
+    ab += ab;
+    count *= 2;
+    check(ab, count);
+    while (count > 3)
+    {
+      ab.pop_back_n(3);
+      count -= 3;
+      check(ab, count);
+      ab.pop_front();
+      count -= 1;
+      check(ab, count);
+    }
+    ab.clear();
+    check(ab, 0);
+    ab += "x\u03BC"_UTF8;
+    check(ab, 2);
+  }
+  SECTION("Reserve")
+  {
+    StringType ab = {mem::Mallocator{}, "12"_UTF8};
+    ab.reserve(100);
+    REQUIRE(ab.capacity() > 100);
+    const auto ptr = ab.c_str();
+    for (size_t i = 0; i < 98; i++)
+      ab.push_back(U'a');
+    REQUIRE(ab.c_str() == ptr);
+    REQUIRE(ab.size() == 100);
+    REQUIRE(ab.find(U'a') == 2);
+  }
 }
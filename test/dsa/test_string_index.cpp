@@ -0,0 +1,142 @@
+/*****************************************************************/ /**
+ * @file   test_string_index.cpp
+ * @brief  Unit tests for `CodePointIndex` and `UTF16OffsetIndex`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/dsa/string_index.h>
+
+TEST_CASE("CodePointIndex")
+{
+  using namespace clt;
+
+  SECTION("UTF8")
+  {
+    u8StringView a = "10μ¼10μ¼10μ¼10μ"
+                     "¼10μ¼\U0001F600一"_UTF8;
+    CodePointIndex<StringEncoding::UTF8, 4> index = a;
+    REQUIRE(!index.is_built());
+    REQUIRE(index.size() == a.size());
+    REQUIRE(index.is_built());
+    for (size_t i = 0; i < a.size(); i++)
+    {
+      REQUIRE(index[i] == a[i]);
+      REQUIRE(index.index_of(index.iterator(i).current()) == i);
+    }
+    REQUIRE(index.offset(index.size()) == a.unit_len());
+    REQUIRE(index.index_of(a.data() + a.unit_len()) == a.size());
+
+    auto sub = index.substr(2, 6);
+    REQUIRE(sub.size() == 6);
+    REQUIRE(sub[0] == U'μ');
+    REQUIRE(sub[5] == U'¼');
+    REQUIRE(index.substr(0, 0).is_empty());
+    REQUIRE(index.substr(index.size(), 0).is_empty());
+
+    auto it = index.advance(a.begin(), 20);
+    REQUIRE(*it == U'\U0001F600');
+    REQUIRE(*index.advance(it, -18) == U'μ');
+    REQUIRE(index.advance(it, 2) == a.end());
+  }
+
+  SECTION("UTF16")
+  {
+    u16StringView a = ptr_to<const Char16*>(
+        u"10μ\U0001F60010μ\U0001F60010μ\U0001F600一");
+    CodePointIndex<StringEncoding::UTF16, 3> index = a;
+    REQUIRE(index.size() == a.size());
+    for (size_t i = 0; i < a.size(); i++)
+    {
+      REQUIRE(index[i] == a[i]);
+      REQUIRE(index.index_of(index.iterator(i).current()) == i);
+    }
+    auto sub = index.substr(3, 5);
+    REQUIRE(sub.size() == 5);
+    REQUIRE(sub[0] == U'\U0001F600');
+    REQUIRE(sub[4] == U'\U0001F600');
+  }
+
+  SECTION("ASCII")
+  {
+    StringView a                                = "Hello World!";
+    CodePointIndex<StringEncoding::ASCII> index = a;
+    REQUIRE(index.is_built());
+    REQUIRE(index.size() == a.unit_len());
+    REQUIRE(index[6] == U'W');
+    REQUIRE(index.substr(6, 5).unit_len() == 5);
+  }
+
+  SECTION("EMPTY")
+  {
+    CodePointIndex<StringEncoding::UTF8> index = u8StringView{};
+    REQUIRE(index.size() == 0);
+    REQUIRE(index.offset(0) == 0);
+    REQUIRE(index.substr(0, 0).is_empty());
+  }
+}
+
+TEST_CASE("UTF16OffsetIndex")
+{
+  using namespace clt;
+
+  SECTION("Offsets")
+  {
+    u8StringView a = "10μ¼10μ¼10μ¼10μ"
+                     "¼10μ¼\U0001F600一\U0001F600x"_UTF8;
+    UTF16OffsetIndex<4> index = a;
+    REQUIRE(!index.is_built());
+    REQUIRE(index.utf16_len() == a.size() + 2);
+    REQUIRE(index.is_built());
+
+    // Compare to a conversion from the start of the view
+    const auto data = ptr_to<const char8_t*>(a.data());
+    size_t utf16    = 0;
+    for (auto it = a.begin(); it != a.end(); ++it)
+    {
+      const size_t utf8 = it.current() - a.data();
+      REQUIRE(index.utf16_offset(utf8) == utf16);
+      REQUIRE(index.utf16_offset(utf8) == uni::utf16_len(data, utf8));
+      REQUIRE(index.utf8_offset(utf16) == utf8);
+      if (*it > 0xFFFF)
+        REQUIRE(index.utf8_offset(++utf16) == utf8);
+      ++utf16;
+    }
+    REQUIRE(index.utf16_offset(a.unit_len()) == index.utf16_len());
+    REQUIRE(index.utf8_offset(index.utf16_len()) == a.unit_len());
+    REQUIRE(index.utf8_offset(index.utf16_len() + 3) == a.unit_len());
+  }
+
+  SECTION("Long Line")
+  {
+    std::u8string line;
+    for (size_t i = 0; i < 500; i++)
+      line += i % 7 == 0 ? u8"\U0001F600" : (i % 3 == 0 ? u8"无" : u8"ab");
+    const auto data  = ptr_to<const Char8*>(line.data());
+    const auto bytes = ptr_to<const char8_t*>(line.data());
+    UTF16OffsetIndex<> index = u8StringView{data, data + line.size()};
+    REQUIRE(index.utf16_len() == uni::utf16_len(bytes, line.size()));
+    for (size_t i = 0; i <= line.size(); i++)
+    {
+      if (i != line.size() && uni::is_trail(bytes[i]))
+        continue;
+      const size_t utf16 = uni::utf16_len(bytes, i);
+      REQUIRE(index.utf16_offset(i) == utf16);
+      REQUIRE(index.utf8_offset(utf16) == i);
+    }
+    for (size_t i = 0; i <= index.utf16_len(); i++)
+      REQUIRE(
+          index.utf8_offset(i)
+          == uni::utf16_to_utf8_offset(bytes, line.size(), i));
+  }
+
+  SECTION("EMPTY")
+  {
+    UTF16OffsetIndex<> index = u8StringView{};
+    REQUIRE(index.utf16_len() == 0);
+    REQUIRE(index.utf16_offset(0) == 0);
+    REQUIRE(index.utf8_offset(0) == 0);
+    REQUIRE(index.utf8_offset(5) == 0);
+  }
+}
@@ -0,0 +1,95 @@
+/*****************************************************************/ /**
+ * @file   test_string_interner.cpp
+ * @brief  Unit tests for `StringInterner`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/dsa/string_interner.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("StringInterner")
+{
+  using namespace clt;
+
+  SECTION("Intern and Lookup")
+  {
+    StringInterner<StringEncoding::ASCII> interner;
+    auto hello = interner.intern("hello");
+    auto world = interner.intern("world");
+    auto empty = interner.intern(StringView{});
+    REQUIRE(hello != world);
+    REQUIRE(hello != empty);
+    REQUIRE(interner.intern("hello") == hello);
+    REQUIRE(interner.size() == 3);
+
+    REQUIRE(interner.lookup(hello) == "hello");
+    REQUIRE(interner.lookup(world) == "world");
+    REQUIRE(interner.lookup(empty).is_empty());
+    // Interned strings are NUL-terminated
+    REQUIRE(interner.lookup(hello).c_str()[5] == '\0');
+
+    REQUIRE(interner.find("world").value() == world);
+    REQUIRE(interner.find("nope").is_none());
+    REQUIRE(uhash<murmur64a_h>{}(hello) == uhash<murmur64a_h>{}(hello));
+  }
+
+  SECTION("Stable Views")
+  {
+    StringInterner<StringEncoding::UTF8, 1> interner;
+    std::vector<StringHandle> handles;
+    const auto first = interner.intern("first"_UTF8);
+    const auto view  = interner.lookup(first);
+    for (size_t i = 0; i < 10'000; i++)
+    {
+      auto str = std::to_string(i);
+      handles.push_back(interner.intern(
+          u8StringView{ptr_to<const Char8*>(str.data()), str.size()}));
+    }
+    REQUIRE(interner.lookup(first).data() == view.data());
+    for (size_t i = 0; i < 10'000; i++)
+    {
+      auto str = interner.lookup(handles[i]);
+      REQUIRE(std::string(ptr_to<const char*>(str.data()), str.unit_len())
+              == std::to_string(i));
+    }
+    REQUIRE(interner.size() == 10'001);
+  }
+
+  SECTION("Concurrent Interning")
+  {
+    static constexpr size_t THREADS = 4;
+    static constexpr size_t COUNT   = 5'000;
+    StringInterner<StringEncoding::ASCII> interner;
+    std::vector<StringHandle> handles[THREADS];
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < THREADS; t++)
+    {
+      threads.emplace_back(
+          [&, t]()
+          {
+            // All the threads intern the same strings
+            for (size_t i = 0; i < COUNT; i++)
+            {
+              auto str = std::to_string(i);
+              handles[t].push_back(
+                  interner.intern(StringView{str.data(), str.size()}));
+            }
+          });
+    }
+    for (auto& thread : threads)
+      thread.join();
+
+    REQUIRE(interner.size() == COUNT);
+    for (size_t i = 0; i < COUNT; i++)
+    {
+      for (size_t t = 1; t < THREADS; t++)
+        REQUIRE(handles[t][i] == handles[0][i]);
+      auto str = interner.lookup(handles[0][i]);
+      REQUIRE(std::string(str.data(), str.unit_len()) == std::to_string(i));
+    }
+  }
+}
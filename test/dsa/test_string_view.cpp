@@ -67,6 +67,100 @@ TEST_CASE("StringView Indexing")
   }
 }
 
+TEST_CASE("StringView Find")
+{
+  using namespace clt;
+  SECTION("ASCII")
+  {
+    StringView a = "Hello World! This string is long enough to be searched using SIMD.";
+    REQUIRE(a.find('H') == 0);
+    REQUIRE(a.find('!') == 11);
+    REQUIRE(a.find('.') == a.unit_len() - 1);
+    REQUIRE(a.find('o', 5) == 7);
+    REQUIRE(a.find('z') == StringView::npos);
+    REQUIRE(a.find(U'\u03BC') == StringView::npos);
+    REQUIRE(a.find(StringView{"SIMD"}) == a.unit_len() - 5);
+    REQUIRE(a.find(StringView{"SIMD!"}) == StringView::npos);
+    REQUIRE(a.find(StringView{""}, 3) == 3);
+
+    const char32_t delimiters[] = {U'!', U'.', U'?'};
+    REQUIRE(a.find_any(delimiters) == 11);
+    REQUIRE(a.find_any(delimiters, 12) == a.unit_len() - 1);
+    REQUIRE(a.find_any(delimiters, a.unit_len()) == StringView::npos);
+  }
+  SECTION("UTF8")
+  {
+    u8StringView a = ptr_to<const Char8*>(
+        u8"10\u03BC\u00BC; long enough for SIMD to be used, \U0001F600 end");
+    REQUIRE(a.find(U'1') == 0);
+    REQUIRE(a.find(U'\u00BC') == 4);
+    REQUIRE(a.find(U'\U0001F600') == 41);
+    REQUIRE(a.find(U'\u00BD') == u8StringView::npos);
+    REQUIRE(a.find(u8StringView{ptr_to<const Char8*>(u8"\U0001F600 end")}) == 41);
+
+    const char32_t delimiters[] = {U',', U';'};
+    REQUIRE(a.find_any(delimiters) == 6);
+    REQUIRE(a.find_any(delimiters, 7) == 39);
+    const char32_t unicode[] = {U'\U0001F600', U'\u00BC'};
+    REQUIRE(a.find_any(unicode) == 4);
+  }
+  SECTION("UTF16")
+  {
+    u16StringView a = ptr_to<const Char16*>(
+        u"10\u03BC\u00BC; long enough for SIMD to be used, \U0001F600 end");
+    REQUIRE(a.find(U'\u00BC') == 3);
+    REQUIRE(a.find(U'\U0001F600') == 39);
+    REQUIRE(a.find(U'\U0001F601') == u16StringView::npos);
+    REQUIRE(a.find(u16StringView{ptr_to<const Char16*>(u"used")}) == 33);
+
+    const char32_t delimiters[] = {U',', U';'};
+    REQUIRE(a.find_any(delimiters) == 4);
+  }
+  SECTION("UTF32")
+  {
+    u32StringView a = ptr_to<const Char32*>(
+        U"10\u03BC\u00BC; long enough for SIMD to be used, \U0001F600 end");
+    REQUIRE(a.find(U'\u00BC') == 3);
+    REQUIRE(a.find(U'\U0001F600') == 39);
+    REQUIRE(a.find(U'd', 39) == 43);
+    REQUIRE(a.find(u32StringView{ptr_to<const Char32*>(U"end")}) == 41);
+  }
+}
+
+TEST_CASE("StringView Validation")
+{
+  using namespace clt;
+  SECTION("UTF8")
+  {
+    const char8_t str[] = u8"10\u03BC\u00BC";
+    auto bytes          = View<u8>{ptr_to<const u8*>(str), sizeof str - 1};
+    auto result         = u8StringView::from_validated(bytes);
+    REQUIRE(result.is_expect());
+    REQUIRE(result->first.unit_len() == 6);
+    REQUIRE(result->second.strlen == 4);
+    REQUIRE(result->second.unitlen == 6);
+    REQUIRE(result->first[2] == U'\u03BC');
+
+    REQUIRE(
+        u8StringView::from_validated(bytes.subspan(0, 3)).error()
+        == uni::ConvError::INVALID_INPUT);
+  }
+  SECTION("UTF16")
+  {
+    alignas(char16_t) const char16_t str[] = u"10\U0001F600";
+    auto bytes  = View<u8>{ptr_to<const u8*>(str), sizeof str - sizeof(char16_t)};
+    auto result = u16StringView::from_validated(bytes);
+    REQUIRE(result.is_expect());
+    REQUIRE(result->first.unit_len() == 4);
+    REQUIRE(result->second.strlen == 3);
+
+    // Not a multiple of the unit size
+    REQUIRE(u16StringView::from_validated(bytes.subspan(0, 3)).is_error());
+    // Lone lead surrogate
+    REQUIRE(u16StringView::from_validated(bytes.subspan(0, 6)).is_error());
+  }
+}
+
 TEST_CASE("StringView Serialization")
 {
   using namespace clt;
@@ -0,0 +1,141 @@
+/*****************************************************************/ /**
+ * @file   test_vector.cpp
+ * @brief  Unit tests for `BasicVector`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/dsa/vector.h>
+#include <colt/mem/arena_alloc.h>
+#include <string>
+
+TEST_CASE("Vector")
+{
+  using namespace clt;
+
+  SECTION("Growth In Place")
+  {
+    // The arena can expand its last allocation
+    mem::ArenaAllocator<mem::Mallocator> arena;
+    using Ref = mem::LocalAllocatorRef<decltype(arena)>;
+    BasicVector<u64, Ref> vec = Ref{arena};
+    vec.push_back(0);
+    const u64* data = vec.data();
+    for (u64 i = 1; i < 1000; i++)
+      vec.push_back(i);
+    REQUIRE(vec.data() == data);
+    for (u64 i = 0; i < 1000; i++)
+      REQUIRE(vec[i] == i);
+  }
+
+  SECTION("Growth Through Realloc")
+  {
+    mem::StatsAllocator<mem::Mallocator> alloc;
+    using Ref = mem::LocalAllocatorRef<decltype(alloc)>;
+    {
+      BasicVector<u32, Ref> vec = Ref{alloc};
+      for (u32 i = 0; i < 10'000; i++)
+        vec.push_back(i);
+      REQUIRE(vec.back() == 9'999);
+    }
+    auto stats = alloc.stats();
+    REQUIRE(stats.alloc_count == 1);
+    REQUIRE(stats.realloc_success + stats.expand_success != 0);
+    REQUIRE(stats.live_bytes == 0);
+  }
+
+  SECTION("Non Trivially Relocatable")
+  {
+    mem::StatsAllocator<mem::Mallocator> alloc;
+    using Ref = mem::LocalAllocatorRef<decltype(alloc)>;
+    {
+      BasicVector<std::string, Ref> vec = Ref{alloc};
+      for (size_t i = 0; i < 100; i++)
+        vec.push_back(std::string(30, 'a' + i % 26));
+      for (size_t i = 0; i < 100; i++)
+        REQUIRE(vec[i] == std::string(30, 'a' + i % 26));
+    }
+    // The objects are never moved using realloc
+    auto stats = alloc.stats();
+    REQUIRE(stats.realloc_count == 0);
+    REQUIRE(stats.live_bytes == 0);
+  }
+
+  SECTION("Global Allocator")
+  {
+    auto vec = make_vector<u64>();
+    for (u64 i = 0; i < 10'000; i++)
+      vec.push_back(i);
+    for (u64 i = 0; i < 10'000; i++)
+      REQUIRE(vec[i] == i);
+  }
+
+  SECTION("Growth Policy")
+  {
+    auto vec = make_vector<u8>();
+    vec.push_back(0);
+    REQUIRE(vec.capacity() == 16);
+    for (u8 i = 1; i < 17; i++)
+      vec.push_back(i);
+    REQUIRE(vec.capacity() == 32);
+
+    STATIC_REQUIRE(GeometricGrowth<3, 2>::grow(64, 65, 1) == 96);
+    STATIC_REQUIRE(GeometricGrowth<3, 2>::grow(64, 200, 1) == 200);
+    STATIC_REQUIRE(PageRoundedGrowth<>::grow(0, 1, 8) == 512);
+    STATIC_REQUIRE(PageRoundedGrowth<>::grow(512, 513, 8) == 1024);
+
+    BasicVector<u64, decltype(mem::GlobalAllocator), PageRoundedGrowth<>> big =
+        mem::GlobalAllocator;
+    big.push_back(1);
+    REQUIRE(big.capacity() == 512);
+  }
+
+  SECTION("Reserve and Shrink")
+  {
+    auto vec = make_vector<std::string>();
+    vec.reserve_exact(10);
+    REQUIRE(vec.capacity() == 10);
+    for (size_t i = 0; i < 10; i++)
+      vec.push_back(std::string(20, 'a'));
+    vec.reserve_exact(0);
+    REQUIRE(vec.capacity() == 10);
+    vec.push_back("b");
+    REQUIRE(vec.capacity() > 11);
+
+    vec.shrink_to_fit();
+    REQUIRE(vec.capacity() == 11);
+    REQUIRE(vec.back() == "b");
+    REQUIRE(vec.front() == std::string(20, 'a'));
+    vec.clear();
+    vec.shrink_to_fit();
+    REQUIRE(vec.capacity() == 0);
+    REQUIRE(vec.data() == nullptr);
+
+    auto ints = make_vector<u32>();
+    for (u32 i = 0; i < 100; i++)
+      ints.push_back(i);
+    ints.shrink_to_fit();
+    REQUIRE(ints.capacity() == 100);
+    REQUIRE(ints.back() == 99);
+  }
+
+  SECTION("Append Range")
+  {
+    mem::StatsAllocator<mem::Mallocator> alloc;
+    using Ref = mem::LocalAllocatorRef<decltype(alloc)>;
+    const std::string strs[] = {"a", "b", std::string(40, 'c')};
+    {
+      BasicVector<std::string, Ref> vec = Ref{alloc};
+      vec.append_range(View<std::string>{strs, 3});
+      REQUIRE(alloc.stats().alloc_count == 1);
+      REQUIRE(vec.size() == 3);
+      REQUIRE(vec[2] == strs[2]);
+      // Appending the Vector to itself
+      vec.append_range(vec.to_view());
+      REQUIRE(vec.size() == 6);
+      REQUIRE(vec[5] == strs[2]);
+    }
+    REQUIRE(alloc.stats().live_bytes == 0);
+  }
+}
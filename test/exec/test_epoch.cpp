@@ -0,0 +1,167 @@
+/*****************************************************************/ /**
+ * @file   test_epoch.cpp
+ * @brief  Unit tests for `EpochDomain`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/exec/epoch.h>
+#include <colt/mem/simple_alloc.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/// @brief Counts its destructions
+struct Tracked
+{
+  std::atomic<size_t>* destroyed;
+  size_t value;
+
+  ~Tracked() noexcept { ++*destroyed; }
+};
+
+TEST_CASE("EpochDomain")
+{
+  using namespace clt;
+  using namespace clt::exec;
+
+  SECTION("Pin")
+  {
+    EpochDomain domain;
+    REQUIRE(!domain.is_pinned());
+    {
+      auto guard = domain.pin();
+      REQUIRE(domain.is_pinned());
+      {
+        auto nested = domain.pin();
+        REQUIRE(domain.is_pinned());
+      }
+      REQUIRE(domain.is_pinned());
+      auto moved = std::move(guard);
+      REQUIRE(domain.is_pinned());
+    }
+    REQUIRE(!domain.is_pinned());
+  }
+
+  SECTION("Retire")
+  {
+    EpochDomain domain;
+    std::atomic<size_t> reclaimed = 0;
+    auto reclaimer                = +[](void*, void* ctx) noexcept
+    { ++*static_cast<std::atomic<size_t>*>(ctx); };
+
+    {
+      auto guard = domain.pin();
+      for (int i = 0; i < 10; i++)
+        domain.retire(nullptr, reclaimer, &reclaimed);
+      // The current thread being pinned, the epoch advances at most once
+      for (int i = 0; i < 10; i++)
+        domain.collect();
+      REQUIRE(reclaimed == 0);
+      REQUIRE(domain.pending() == 10);
+    }
+    const u64 epoch = domain.epoch();
+    domain.synchronize();
+    REQUIRE(domain.epoch() >= epoch + 2);
+    REQUIRE(reclaimed == 10);
+    REQUIRE(domain.pending() == 0);
+
+    // Reclaimed on destruction
+    {
+      EpochDomain other;
+      other.retire(nullptr, reclaimer, &reclaimed);
+    }
+    REQUIRE(reclaimed == 11);
+  }
+
+  SECTION("Retire through an allocator")
+  {
+    EpochDomain domain;
+    mem::Mallocator alloc;
+    std::atomic<size_t> destroyed = 0;
+    for (size_t i = 0; i < 3 * EpochDomain::RETIRE_PERIOD; i++)
+    {
+      auto blk = alloc.alloc(sizeof(Tracked));
+      domain.retire(new (blk.ptr()) Tracked{&destroyed, i}, alloc);
+    }
+    // Collected every RETIRE_PERIOD retirements
+    REQUIRE(destroyed > 0);
+    domain.synchronize();
+    REQUIRE(destroyed == 3 * EpochDomain::RETIRE_PERIOD);
+  }
+
+  SECTION("Concurrent readers")
+  {
+    EpochDomain domain;
+    mem::Mallocator alloc;
+    std::atomic<size_t> destroyed = 0;
+    std::atomic<Tracked*> shared  = new (alloc.alloc(sizeof(Tracked)).ptr())
+        Tracked{&destroyed, 0};
+    std::atomic<bool> done     = false;
+    std::atomic<size_t> errors = 0;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; i++)
+    {
+      readers.emplace_back(
+          [&]
+          {
+            size_t last = 0;
+            while (!done.load(std::memory_order_relaxed))
+            {
+              auto guard = domain.pin();
+              // Would be a use-after-free if reclaimed while pinned
+              const size_t value = shared.load(std::memory_order_acquire)->value;
+              errors += value < last;
+              last = value;
+            }
+          });
+    }
+    constexpr size_t WRITES = 2000;
+    for (size_t i = 1; i <= WRITES; i++)
+    {
+      auto next = new (alloc.alloc(sizeof(Tracked)).ptr()) Tracked{&destroyed, i};
+      domain.retire(shared.exchange(next, std::memory_order_acq_rel), alloc);
+      if (i % 128 == 0)
+        std::this_thread::yield();
+    }
+    done = true;
+    for (auto& reader : readers)
+      reader.join();
+
+    REQUIRE(errors == 0);
+    domain.synchronize();
+    REQUIRE(destroyed == WRITES);
+    REQUIRE(domain.pending() == 0);
+    domain.retire(shared.load(), alloc);
+  }
+
+  SECTION("Records of exited threads are reused")
+  {
+    EpochDomain domain;
+    std::atomic<size_t> reclaimed = 0;
+    auto reclaimer                = +[](void*, void* ctx) noexcept
+    { ++*static_cast<std::atomic<size_t>*>(ctx); };
+    for (int i = 0; i < 8; i++)
+    {
+      std::thread thread{[&]
+                         {
+                           auto guard = domain.pin();
+                           domain.retire(nullptr, reclaimer, &reclaimed);
+                         }};
+      thread.join();
+    }
+    // The objects of exited threads are still reclaimed
+    REQUIRE(domain.pending() == 8);
+    domain.synchronize();
+    REQUIRE(reclaimed == 8);
+  }
+
+  SECTION("Global")
+  {
+    REQUIRE(&EpochDomain::global() == &EpochDomain::global());
+    auto guard = EpochDomain::global().pin();
+    REQUIRE(EpochDomain::global().is_pinned());
+  }
+}
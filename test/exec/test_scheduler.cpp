@@ -0,0 +1,189 @@
+/*****************************************************************/ /**
+ * @file   test_scheduler.cpp
+ * @brief  Unit tests for `Scheduler` and `TaskGroup`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/exec/scheduler.h>
+#include <colt/mem/simple_alloc.h>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#ifdef COLT_LINUX
+  #include <sched.h>
+#endif // COLT_LINUX
+
+/// @brief Counts the blocks allocated and freed (thread-safe)
+struct CountingAllocator
+{
+  static constexpr clt::u64 alignment = clt::mem::Mallocator::alignment;
+
+  std::atomic<size_t> allocated = 0;
+  std::atomic<size_t> freed     = 0;
+
+  clt::mem::MemBlock alloc(clt::u64 size) noexcept
+  {
+    ++allocated;
+    return clt::mem::Mallocator{}.alloc(size);
+  }
+
+  void dealloc(clt::mem::MemBlock blk) noexcept
+  {
+    ++freed;
+    clt::mem::Mallocator{}.dealloc(blk);
+  }
+};
+
+/// @brief Computes fibonacci by spawning a task per call
+static clt::u64 parallel_fib(clt::exec::Scheduler& sched, clt::u64 n)
+{
+  if (n < 2)
+    return n;
+  clt::u64 a, b;
+  {
+    clt::exec::TaskGroup group = {sched};
+    group.spawn([&] { a = parallel_fib(sched, n - 1); });
+    b = parallel_fib(sched, n - 2);
+  }
+  return a + b;
+}
+
+TEST_CASE("Scheduler")
+{
+  using namespace clt;
+  using namespace clt::exec;
+
+  SECTION("Spawn and wait")
+  {
+    Scheduler sched = {{.workers = 4}};
+    REQUIRE(sched.worker_count() == 4);
+    REQUIRE(sched.current_worker().is_none());
+
+    // Catch assertions are not thread-safe: results are checked after
+    // The waiting thread runs tasks too (it is not a worker)
+    std::atomic<u32> count         = 0;
+    std::atomic<u32> invalid_index = 0;
+    TaskGroup group                = {sched};
+    for (size_t i = 0; i < 10'000; i++)
+    {
+      group.spawn(
+          [&]
+          {
+            if (auto worker = sched.current_worker();
+                worker.is_value() && *worker >= 4)
+              ++invalid_index;
+            count.fetch_add(1, std::memory_order_relaxed);
+          });
+    }
+    group.wait();
+    REQUIRE(group.pending_count() == 0);
+    REQUIRE(count == 10'000);
+    REQUIRE(invalid_index == 0);
+  }
+
+  SECTION("Nested groups")
+  {
+    Scheduler sched = {{.workers = 3}};
+    REQUIRE(parallel_fib(sched, 24) == 46368);
+
+    // Waiting from a worker (on a group spawned from a task)
+    std::atomic<u32> count = 0;
+    TaskGroup outer        = {sched};
+    for (size_t i = 0; i < 16; i++)
+    {
+      outer.spawn(
+          [&]
+          {
+            TaskGroup inner = {sched};
+            for (size_t j = 0; j < 64; j++)
+              inner.spawn([&] { ++count; });
+            inner.wait();
+          });
+    }
+    outer.wait();
+    REQUIRE(count == 16 * 64);
+  }
+
+  SECTION("Frames")
+  {
+    CountingAllocator alloc;
+    {
+      Scheduler sched = {{.workers = 2, .frame_allocator = alloc}};
+      // Spawned from a task: small frames come from the worker's cache
+      std::atomic<u32> small = 0;
+      std::atomic<u64> large = 0;
+      bool on_worker         = false;
+      TaskGroup group        = {sched};
+      group.spawn(
+          [&]
+          {
+            // The task may also be run by the waiting thread
+            on_worker       = sched.current_worker().is_value();
+            TaskGroup inner = {sched};
+            for (size_t i = 0; i < 1000; i++)
+              inner.spawn([&] { ++small; });
+            // Larger than a frame: allocated from the frame allocator
+            std::array<u64, 64> values{};
+            values.back() = 7;
+            for (size_t i = 0; i < 10; i++)
+              inner.spawn([&large, values] { large += values.back(); });
+          });
+      group.wait();
+      REQUIRE(small == 1000);
+      REQUIRE(large == 70);
+      // 1 (spawned from outside) + 10 (large) + chunks of frames
+      if (on_worker)
+        REQUIRE(alloc.allocated < 100);
+    }
+    REQUIRE(alloc.allocated == alloc.freed);
+  }
+
+  SECTION("External threads")
+  {
+    Scheduler sched        = {{.workers = 2}};
+    std::atomic<u32> count = 0;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; i++)
+    {
+      threads.emplace_back(
+          [&]
+          {
+            TaskGroup group = {sched};
+            for (size_t j = 0; j < 500; j++)
+              group.spawn([&] { ++count; });
+          });
+    }
+    for (auto& thread : threads)
+      thread.join();
+    REQUIRE(count == 4 * 500);
+  }
+
+  SECTION("Pinning")
+  {
+    Scheduler sched = {{.workers = 2, .pinning = WorkerPinning::SpreadCores}};
+#ifdef COLT_LINUX
+    // The workers are pinned to the processors allowed for the process
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    REQUIRE(sched_getaffinity(0, sizeof(set), &set) == 0);
+    for (u32 i = 0; i < 2; i++)
+    {
+      REQUIRE(sched.pinned_cpu(i).is_value());
+      REQUIRE(CPU_ISSET(*sched.pinned_cpu(i), &set));
+    }
+    if (CPU_COUNT(&set) > 1)
+      REQUIRE(*sched.pinned_cpu(0) != *sched.pinned_cpu(1));
+#endif // COLT_LINUX
+    Scheduler unpinned = {{.workers = 1}};
+    REQUIRE(unpinned.pinned_cpu(0).is_none());
+    TaskGroup group = {sched};
+    bool ran        = false;
+    group.spawn([&] { ran = true; });
+    group.wait();
+    REQUIRE(ran);
+  }
+}
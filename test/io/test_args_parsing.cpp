@@ -19,4 +19,34 @@ TEST_CASE("args_parsing")
 
   REQUIRE(CLT_TEST == true);
   REQUIRE(CLT_TEST2 == true);
-}
\ No newline at end of file
+}
+int CLT_COUNT = 0;
+bool CLT_TEST3 = true;
+
+using ResponseArgs = meta::type_list<
+  Opt<"count", callback<[](){ ++CLT_COUNT; }>, alias<"c">>,
+  Opt<"test3", location<CLT_TEST3>>
+>;
+
+/// @brief Writes a response file
+static void write_response_file(const char* path, const char* content)
+{
+  std::FILE* file = std::fopen(path, "wb");
+  REQUIRE(file != nullptr);
+  std::fputs(content, file);
+  std::fclose(file);
+}
+
+TEST_CASE("args_parsing response files")
+{
+  write_response_file(
+      "test_args_parsing.rsp",
+      "-count \"-co\"unt\n  '-test3'=false\t@test_args_parsing_nested.rsp -c\\ount");
+  write_response_file("test_args_parsing_nested.rsp", "\n-c\n\n");
+
+  std::array COMMANDS = {"", "-count", "@test_args_parsing.rsp", "-c"};
+  cl::parse_command_line_options<ResponseArgs>(COMMANDS.size(), COMMANDS.data());
+
+  REQUIRE(CLT_COUNT == 6);
+  REQUIRE(CLT_TEST3 == false);
+}
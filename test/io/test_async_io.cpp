@@ -0,0 +1,152 @@
+/*****************************************************************/ /**
+ * @file   test_async_io.cpp
+ * @brief  Unit tests for `AsyncIO`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/io/async_io.h>
+#include <string>
+#include <vector>
+
+#ifdef COLT_LINUX
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <filesystem>
+#endif // COLT_LINUX
+
+TEST_CASE("AsyncIO")
+{
+  using namespace clt;
+
+  constexpr size_t COUNT = 64;
+  std::vector<std::string> paths, contents;
+  for (size_t i = 0; i < COUNT; i++)
+  {
+    paths.push_back("test_async_" + std::to_string(i) + ".txt");
+    contents.push_back(std::string(100 + i * 13, 'a' + i % 26));
+  }
+
+  for (auto kind : {AsyncIOBackend::IOUring, AsyncIOBackend::ThreadPool})
+  {
+    // Small capacity: requests are queued by batches
+    auto io = AsyncIO::create(16, kind);
+    if (io.is_none())
+    {
+      // io_uring may be unavailable
+      REQUIRE(kind == AsyncIOBackend::IOUring);
+      continue;
+    }
+    REQUIRE(io->backend() == kind);
+    REQUIRE(io->capacity() >= 16);
+    std::vector<Option<File>> files(COUNT);
+    std::vector<IOCompletion> done(COUNT);
+
+    // Runs 'queue(i)' for every file, waiting for completions when full
+    auto run_all = [&](auto&& queue)
+    {
+      size_t completed = 0;
+      for (size_t i = 0; i < COUNT; i++)
+      {
+        while (!queue(i))
+          completed += io->wait({done.data() + completed, COUNT - completed});
+      }
+      while (completed != COUNT)
+        completed += io->wait({done.data() + completed, COUNT - completed});
+      REQUIRE(io->pending() == 0);
+      for (auto& completion : done)
+        REQUIRE(!completion.is_error());
+    };
+
+    run_all(
+        [&](size_t i)
+        {
+          return io->queue_open(paths[i].c_str(), File::Write, i).is_success();
+        });
+    for (auto& completion : done)
+    {
+      REQUIRE(completion.kind == IORequestKind::Open);
+      files[completion.user_data] = completion.file();
+    }
+    run_all(
+        [&](size_t i)
+        {
+          View<u8> out = {ptr_to<const u8*>(contents[i].data()), contents[i].size()};
+          return io->queue_write(*files[i], out, 0, i).is_success();
+        });
+    for (auto& completion : done)
+      REQUIRE(completion.result == (i64)contents[completion.user_data].size());
+    run_all([&](size_t i) { return io->queue_close(*files[i], i).is_success(); });
+    REQUIRE(!files[0]->is_open());
+
+    run_all(
+        [&](size_t i)
+        {
+          return io->queue_open(paths[i].c_str(), File::Read, i).is_success();
+        });
+    for (auto& completion : done)
+      files[completion.user_data] = completion.file();
+    std::vector<std::string> read(COUNT, std::string(4096, '\0'));
+    run_all(
+        [&](size_t i)
+        {
+          Span<u8> out = {ptr_to<u8*>(read[i].data()), read[i].size()};
+          return io->queue_read(*files[i], out, 0, i).is_success();
+        });
+    for (auto& completion : done)
+    {
+      const size_t i = completion.user_data;
+      REQUIRE(read[i].substr(0, completion.result) == contents[i]);
+    }
+    run_all([&](size_t i) { return io->queue_close(*files[i], i).is_success(); });
+
+    // Errors are reported in the completion
+    REQUIRE(io->queue_open("does/not/exist.txt", File::Read, 7).is_success());
+    IOCompletion error;
+    REQUIRE(io->wait({&error, 1}) == 1);
+    REQUIRE(error.is_error());
+    REQUIRE(error.user_data == 7);
+    REQUIRE(error.file().is_none());
+  }
+  for (auto& path : paths)
+    std::remove(path.c_str());
+}
+
+#ifdef COLT_LINUX
+TEST_CASE("AsyncIO Failed Submit")
+{
+  using namespace clt;
+
+  auto io = AsyncIO::create(16, AsyncIOBackend::IOUring);
+  if (io.is_none())
+    return; // io_uring may be unavailable
+
+  // Replacing the ring by /dev/null makes io_uring_enter fail
+  int ring = -1;
+  for (const auto& entry : std::filesystem::directory_iterator{"/proc/self/fd"})
+  {
+    std::error_code err;
+    if (std::filesystem::read_symlink(entry.path(), err) == "anon_inode:[io_uring]")
+      ring = std::stoi(entry.path().filename().string());
+  }
+  REQUIRE(ring >= 0);
+  const int null = ::open("/dev/null", O_RDONLY);
+  REQUIRE(::dup2(null, ring) == ring);
+  ::close(null);
+
+  REQUIRE(io->queue_open("test_async_refused.txt", File::Write, 1).is_success());
+  REQUIRE(io->queue_open("test_async_refused.txt", File::Read, 2).is_success());
+  REQUIRE(io->submit() == 0);
+  REQUIRE(io->pending() == 2);
+  IOCompletion done[2];
+  REQUIRE(io->wait(done, 2) == 2);
+  REQUIRE(io->pending() == 0);
+  for (auto& completion : done)
+  {
+    REQUIRE(completion.is_error());
+    REQUIRE(completion.file().is_none());
+  }
+  REQUIRE(done[0].user_data + done[1].user_data == 3);
+}
+#endif // COLT_LINUX
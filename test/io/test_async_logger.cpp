@@ -0,0 +1,102 @@
+/*****************************************************************/ /**
+ * @file   test_async_logger.cpp
+ * @brief  Unit tests for `AsyncLogger`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/io/async_logger.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief Returns the content of a file
+/// @param path The path of the file
+/// @return The content of the file
+static std::string read_log(const char* path)
+{
+  std::ifstream file{path, std::ios::binary};
+  std::stringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+TEST_CASE("AsyncLogger")
+{
+  using namespace clt;
+
+  SECTION("Threads")
+  {
+    constexpr size_t THREADS = 4;
+    constexpr size_t RECORDS = 5'000;
+    std::remove("test_async_logger.txt");
+    {
+      auto file = File::open("test_async_logger.txt", File::Write);
+      REQUIRE(file.is_value());
+      {
+        // Small rings to exercise waiting for the writer thread
+        AsyncLogger logger = {*file, 1024};
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < THREADS; t++)
+        {
+          threads.emplace_back(
+              [&logger, t]()
+              {
+                for (size_t i = 0; i < RECORDS; i++)
+                  logger.info("{} {}", t, i);
+              });
+        }
+        for (auto& i : threads)
+          i.join();
+        REQUIRE(logger.lost_bytes() == 0);
+        // Written on destruction
+      }
+      file->close();
+    }
+
+    std::istringstream lines{read_log("test_async_logger.txt")};
+    std::vector<size_t> next(THREADS, 0);
+    std::string line;
+    size_t count = 0;
+    while (std::getline(lines, line))
+    {
+      size_t t, i;
+      REQUIRE(std::sscanf(line.c_str(), "Message: %zu %zu", &t, &i) == 2);
+      REQUIRE(t < THREADS);
+      // The records of a thread are in order
+      REQUIRE(next[t] == i);
+      ++next[t];
+      ++count;
+    }
+    REQUIRE(count == THREADS * RECORDS);
+  }
+
+  SECTION("Levels and Flush")
+  {
+    constexpr const char* EXPECTED = "Warning: kept 1\nError: no newline";
+    std::remove("test_async_logger_flush.txt");
+    auto file = File::open("test_async_logger_flush.txt", File::Write);
+    REQUIRE(file.is_value());
+    {
+      AsyncLogger logger = {*file, 4096, std::chrono::milliseconds{1'000}};
+      logger.set_level(LogLevel::Warn);
+      REQUIRE(logger.level() == LogLevel::Warn);
+      logger.info("filtered");
+      logger.warn("kept {}", 1);
+      logger.error<"">("no newline");
+      logger.flush();
+      // Written before the interval elapsed
+      REQUIRE(read_log("test_async_logger_flush.txt") == EXPECTED);
+
+      logger.set_level(LogLevel::Off);
+      logger.fatal("filtered");
+      logger.flush();
+      REQUIRE(read_log("test_async_logger_flush.txt") == EXPECTED);
+    }
+    file->close();
+  }
+}
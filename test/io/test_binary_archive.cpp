@@ -0,0 +1,184 @@
+/*****************************************************************/ /**
+ * @file   test_binary_archive.cpp
+ * @brief  Unit tests for `BinaryWriter` and `BinaryReader`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/io/binary_archive.h>
+#include <cstdio>
+#include <vector>
+
+enum class ArchiveKind : clt::u16
+{
+  Function,
+  Global,
+};
+
+struct ArchivePoint
+{
+  clt::u32 x;
+  clt::u32 y;
+
+  constexpr auto operator<=>(const ArchivePoint&) const = default;
+};
+
+COLT_DECLARE_TYPE(ArchivePoint, x, y);
+
+struct ArchiveSymbol
+{
+  std::string_view name;
+  ArchiveKind kind;
+  double weight;
+  bool exported;
+  ArchivePoint location;
+  std::vector<clt::u32> uses;
+  std::vector<std::string> notes;
+};
+
+COLT_DECLARE_TYPE(
+    ArchiveSymbol, name, kind, weight, exported, location, uses, notes);
+
+template<std::endian ENDIAN>
+static void check_round_trip()
+{
+  using namespace clt;
+
+  const ArchiveSymbol symbol = {
+      "main", ArchiveKind::Global, 2.5,         true,
+      {3, 4}, {1, 2, 300, 70000},  {"a", "bc"}};
+  const ArchivePoint points[3] = {{1, 2}, {3, 4}, {5, 6}};
+
+  BasicBinaryWriter<ENDIAN> writer{7};
+  REQUIRE(writer(symbol, points, u64{0x0102030405060708}).is_success());
+  REQUIRE(writer.size() > ARCHIVE_HEADER_SIZE);
+
+  auto reader = BasicBinaryReader<ENDIAN>::open(writer.bytes(), 7);
+  REQUIRE(reader.is_value());
+  ArchiveSymbol read_symbol;
+  ArchivePoint read_points[3];
+  u64 integer;
+  REQUIRE((*reader)(read_symbol, read_points, integer).is_success());
+  REQUIRE(reader->remaining() == 0);
+
+  REQUIRE(read_symbol.name == "main");
+  // Zero-copy: the string is a view of the archive
+  REQUIRE(ptr_to<const u8*>(read_symbol.name.data()) > writer.bytes().data());
+  REQUIRE(read_symbol.kind == ArchiveKind::Global);
+  REQUIRE(read_symbol.weight == 2.5);
+  REQUIRE(read_symbol.exported);
+  REQUIRE(read_symbol.location == ArchivePoint{3, 4});
+  REQUIRE(read_symbol.uses == symbol.uses);
+  REQUIRE(read_symbol.notes == symbol.notes);
+  for (size_t i = 0; i < 3; i++)
+    REQUIRE(read_points[i] == points[i]);
+  REQUIRE(integer == 0x0102030405060708);
+
+  // The version of the schema must match
+  REQUIRE(BasicBinaryReader<ENDIAN>::open(writer.bytes(), 8).is_none());
+}
+
+TEST_CASE("Binary Archive")
+{
+  using namespace clt;
+
+  SECTION("Round Trip")
+  {
+    check_round_trip<std::endian::little>();
+    check_round_trip<std::endian::big>();
+  }
+
+  SECTION("Endianness")
+  {
+    BasicBinaryWriter<std::endian::big> big;
+    REQUIRE(big(u32{0x01020304}).is_success());
+    auto bytes = big.bytes().subspan(ARCHIVE_HEADER_SIZE);
+    REQUIRE(bytes.size() == 4);
+    REQUIRE(bytes[0] == 0x01);
+    REQUIRE(bytes[3] == 0x04);
+
+    BinaryWriter little;
+    REQUIRE(little(u32{0x01020304}, std::string_view{"ab"}).is_success());
+    bytes = little.bytes().subspan(ARCHIVE_HEADER_SIZE);
+    REQUIRE(bytes.size() == 7);
+    REQUIRE(bytes[0] == 0x04);
+    REQUIRE(bytes[3] == 0x01);
+    REQUIRE(bytes[4] == 2); // varint size
+
+    // An archive of the other endianness is rejected
+    REQUIRE(BinaryReader::open(big.bytes()).is_none());
+  }
+
+  SECTION("Varint")
+  {
+    BinaryWriter writer;
+    const std::vector<u8> large(300, 7);
+    REQUIRE(writer(large).is_success());
+    auto bytes = writer.bytes().subspan(ARCHIVE_HEADER_SIZE);
+    REQUIRE(bytes.size() == 302);
+    REQUIRE(bytes[0] == (0x80 | (300 & 0x7F)));
+    REQUIRE(bytes[1] == (300 >> 7));
+
+    // A varint that never ends
+    const u8 invalid[ARCHIVE_HEADER_SIZE + 11] = {
+        0x43, 0x4C, 0x54, 0x42, 1,    0,    0,    0,    0,    0,    0,   0,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01};
+    auto reader = BinaryReader::open(invalid);
+    REQUIRE(reader.is_value());
+    std::vector<u8> read;
+    REQUIRE((*reader)(read).code == std::errc::value_too_large);
+  }
+
+  SECTION("Truncated")
+  {
+    BinaryWriter writer;
+    REQUIRE(writer(std::string_view{"hello"}, u32{10}).is_success());
+    for (size_t size = ARCHIVE_HEADER_SIZE; size < writer.size(); size++)
+    {
+      auto reader = BinaryReader::open(writer.bytes().subspan(0, size));
+      REQUIRE(reader.is_value());
+      std::string_view str;
+      u32 value;
+      REQUIRE((*reader)(str, value).code == std::errc::result_out_of_range);
+    }
+    REQUIRE(BinaryReader::open(writer.bytes().subspan(0, 4)).is_none());
+
+    // Failed reads leave scalars unchanged
+    BasicBinaryWriter<std::endian::big> big;
+    REQUIRE(big(u8{1}).is_success());
+    auto reader = BasicBinaryReader<std::endian::big>::open(big.bytes());
+    REQUIRE(reader.is_value());
+    ArchiveKind kind = ArchiveKind::Global;
+    REQUIRE((*reader)(kind).code == std::errc::result_out_of_range);
+    REQUIRE(kind == ArchiveKind::Global);
+    bool flag = true;
+    REQUIRE((*reader)(flag).is_success());
+    REQUIRE((*reader)(flag).code == std::errc::result_out_of_range);
+    REQUIRE(flag);
+  }
+
+  SECTION("View Of File")
+  {
+    const std::vector<std::string> names = {"first", "second", "third"};
+    BinaryWriter writer{1};
+    REQUIRE(writer(names, ArchivePoint{10, 20}).is_success());
+
+    std::remove("test_binary_archive.bin");
+    auto file = File::open("test_binary_archive.bin", File::Write);
+    REQUIRE(file.is_value());
+    REQUIRE(writer.write_to(*file).is_success());
+    file->close();
+
+    auto view = ViewOfFile::open("test_binary_archive.bin");
+    REQUIRE(view.is_value());
+    auto reader = BinaryReader::open(*view, 1);
+    REQUIRE(reader.is_value());
+    std::vector<std::string_view> read_names;
+    ArchivePoint point;
+    REQUIRE((*reader)(read_names, point).is_success());
+    REQUIRE(read_names.size() == 3);
+    REQUIRE(read_names[1] == "second");
+    REQUIRE(point == ArchivePoint{10, 20});
+  }
+}
@@ -0,0 +1,92 @@
+/*****************************************************************/ /**
+ * @file   test_buffered_file.cpp
+ * @brief  Unit tests for `BasicBufferedReader` and `BasicBufferedWriter`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/io/buffered_file.h>
+#include <string>
+
+TEST_CASE("BufferedFile")
+{
+  using namespace clt;
+
+  mem::StatsAllocator<mem::Mallocator> alloc;
+  using Ref = mem::LocalAllocatorRef<decltype(alloc)>;
+
+  std::string expected;
+  for (size_t i = 0; i < 500; i++)
+    expected += std::to_string(i * 7) + (i % 3 == 0 ? "\r\n" : "\n");
+  expected += "no newline";
+
+  {
+    auto file = File::open("test_buffered.txt", File::Write);
+    REQUIRE(file.is_value());
+    {
+      BasicBufferedWriter<Ref> writer = {Ref{alloc}, *file, 16};
+      for (size_t i = 0; i < 100; i++)
+        REQUIRE(writer.write(static_cast<u8>(expected[i])).is_success());
+      REQUIRE(writer.buffered() == 100 % 16);
+      // Larger than the buffer: written directly
+      REQUIRE(writer
+                  .write(View<u8>{
+                      ptr_to<const u8*>(expected.data() + 100), expected.size() - 110})
+                  .is_success());
+      REQUIRE(writer.buffered() == 0);
+      REQUIRE(writer.write(StringView{expected.data() + expected.size() - 10, 10})
+                  .is_success());
+      REQUIRE(writer.buffered() == 10);
+      // Flushed on destruction
+    }
+    file->close();
+  }
+  REQUIRE(alloc.stats().live_bytes == 0);
+
+  SECTION("Lines")
+  {
+    auto file = File::open("test_buffered.txt", File::Read);
+    REQUIRE(file.is_value());
+    {
+      BasicBufferedReader<Ref> reader = {Ref{alloc}, *file, 8};
+      REQUIRE(*reader.peek() == '0');
+      REQUIRE(reader.peek(20).size() == 20);
+      REQUIRE(reader.buffer_size() >= 20);
+      for (size_t i = 0; i < 500; i++)
+      {
+        auto line = reader.read_line();
+        REQUIRE(line.is_value());
+        REQUIRE(std::string(line->begin(), line->end()) == std::to_string(i * 7));
+      }
+      auto last = reader.read_until('\n');
+      REQUIRE(last.is_value());
+      REQUIRE(std::string(last->begin(), last->end()) == "no newline");
+      REQUIRE(reader.read_line().is_none());
+      REQUIRE(reader.is_eof());
+      REQUIRE(!reader.has_error());
+    }
+    file->close();
+    REQUIRE(alloc.stats().live_bytes == 0);
+  }
+
+  SECTION("Bytes")
+  {
+    auto file = File::open("test_buffered.txt", File::Read);
+    REQUIRE(file.is_value());
+    {
+      BasicBufferedReader<Ref> reader = {Ref{alloc}, *file, 32};
+      std::string content;
+      for (size_t i = 0; i < 10; i++)
+        content += static_cast<char>(*reader.read());
+      std::string rest(expected.size(), '\0');
+      auto read = reader.read(Span<u8>{ptr_to<u8*>(rest.data()), rest.size()});
+      REQUIRE(read.is_value());
+      REQUIRE(*read == expected.size() - 10);
+      content.append(rest.data(), *read);
+      REQUIRE(content == expected);
+      REQUIRE(reader.read().is_none());
+    }
+    file->close();
+  }
+}
@@ -0,0 +1,73 @@
+/*****************************************************************/ /**
+ * @file   test_file.cpp
+ * @brief  Unit tests for `File`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/io/file.h>
+#include <string>
+#include <vector>
+
+TEST_CASE("File")
+{
+  using namespace clt;
+
+  SECTION("Vectored")
+  {
+    // More buffers than IOV_MAX, some empty
+    std::vector<std::string> strings;
+    std::vector<View<u8>> buffers;
+    std::string expected;
+    for (size_t i = 0; i < 3000; i++)
+      strings.push_back(i % 5 == 0 ? "" : std::to_string(i));
+    for (auto& str : strings)
+    {
+      buffers.push_back({ptr_to<const u8*>(str.data()), str.size()});
+      expected += str;
+    }
+
+    auto file = File::open("test_file.txt", File::Write);
+    REQUIRE(file.is_value());
+    auto written = file->writev({buffers.data(), buffers.size()});
+    REQUIRE(written.is_value());
+    REQUIRE(*written == expected.size());
+
+    const char* patch = "PATCH";
+    REQUIRE(
+        file->write_at({ptr_to<const u8*>(patch), 5}, 100).value_or(0) == 5);
+    expected.replace(100, 5, patch);
+    file->close();
+
+    file = File::open("test_file.txt", File::Read);
+    REQUIRE(file.is_value());
+    std::string first(100, '\0'), second(expected.size(), '\0');
+    std::array<Span<u8>, 2> scatter = {
+        Span<u8>{ptr_to<u8*>(first.data()), first.size()},
+        Span<u8>{ptr_to<u8*>(second.data()), second.size()}};
+    auto read = file->readv(scatter);
+    REQUIRE(read.is_value());
+    REQUIRE(*read == expected.size());
+    REQUIRE(first + second.substr(0, expected.size() - 100) == expected);
+
+    // Positional reads do not depend on the current position
+    char at[5];
+    REQUIRE(file->read_at({ptr_to<u8*>(&at[0]), 5}, 100).value_or(0) == 5);
+    REQUIRE(std::string_view{at, 5} == "PATCH");
+    REQUIRE(
+        file->read_at({ptr_to<u8*>(&at[0]), 5}, expected.size() - 2).value_or(0)
+        == 2);
+    file->close();
+
+    // Positional reads do not move the current position
+    file = File::open("test_file.txt", File::Read);
+    REQUIRE(file.is_value());
+    char before[10], after[10];
+    REQUIRE(file->read({ptr_to<u8*>(&before[0]), 10}).value_or(0) == 10);
+    REQUIRE(file->read_at({ptr_to<u8*>(&at[0]), 5}, 100).value_or(0) == 5);
+    REQUIRE(file->read({ptr_to<u8*>(&after[0]), 10}).value_or(0) == 10);
+    REQUIRE(std::string_view{after, 10} == expected.substr(10, 10));
+    file->close();
+  }
+}
@@ -0,0 +1,176 @@
+/*****************************************************************/ /**
+ * @file   test_hash_index.cpp
+ * @brief  Unit tests for `HashIndexWriter` and `HashIndex`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/io/hash_index.h>
+#include <colt/dsa/map.h>
+#include <colt/dsa/flat_map.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+enum class IndexKind : clt::u16
+{
+  Function,
+  Global,
+};
+
+template<std::endian ENDIAN>
+static void check_endian()
+{
+  using namespace clt;
+
+  BasicHashIndexWriter<u32, IndexKind, COLT_DEFAULT_HASH_ALGORITHM, ENDIAN> writer;
+  for (u32 i = 0; i < 100; i++)
+    writer.insert(i * 7, i % 2 ? IndexKind::Global : IndexKind::Function);
+  const auto bytes = writer.build();
+  REQUIRE(bytes.size() % sizeof(u64) == 0);
+
+  using Index =
+      BasicHashIndex<u32, IndexKind, COLT_DEFAULT_HASH_ALGORITHM, ENDIAN>;
+  auto index = Index::open(View<u8>{bytes.data(), bytes.size()});
+  REQUIRE(index.is_value());
+  REQUIRE(index->verify());
+  REQUIRE(index->size() == 100);
+  for (u32 i = 0; i < 100; i++)
+    REQUIRE(
+        (index->find(i * 7)
+         == (i % 2 ? IndexKind::Global : IndexKind::Function)));
+  REQUIRE(index->find(1).is_none());
+
+  // An index cannot be opened using the other endianness
+  constexpr auto OTHER =
+      ENDIAN == std::endian::little ? std::endian::big : std::endian::little;
+  REQUIRE(BasicHashIndex<u32, IndexKind, COLT_DEFAULT_HASH_ALGORITHM, OTHER>::open(
+              View<u8>{bytes.data(), bytes.size()})
+              .is_none());
+}
+
+TEST_CASE("Hash Index")
+{
+  using namespace clt;
+
+  SECTION("Strings")
+  {
+    std::vector<std::string> names;
+    for (size_t i = 0; i < 500; i++)
+      names.push_back("symbol_" + std::to_string(i));
+
+    Map<StringView, u64> symbols;
+    for (size_t i = 0; i < names.size(); i++)
+      symbols[StringView{names[i].data(), names[i].size()}] = i;
+    HashIndexWriter<StringView, u64> writer{3};
+    writer.insert_all(symbols);
+    REQUIRE(writer.size() == names.size());
+
+    const auto bytes = writer.build();
+    auto index =
+        HashIndex<StringView, u64>::open(View<u8>{bytes.data(), bytes.size()}, 3);
+    REQUIRE(index.is_value());
+    REQUIRE(index->size() == names.size());
+    for (size_t i = 0; i < names.size(); i++)
+    {
+      const StringView name = {names[i].data(), names[i].size()};
+      REQUIRE((index->find(name) == u64(i)));
+    }
+    REQUIRE(index->find("symbol_").is_none());
+    REQUIRE(index->find("").is_none());
+    REQUIRE(index->contains("symbol_42"));
+
+    // Strings as values, and StringView as key
+    FlatMap<u64, std::string_view> reverse;
+    for (size_t i = 0; i < names.size(); i++)
+      reverse.insert({u64(i), names[i]});
+    HashIndexWriter<u64, StringView> reverse_writer;
+    reverse_writer.insert(0, StringView{"zero"});
+    HashIndexWriter<u64, std::string_view> values_writer;
+    values_writer.insert_all(reverse);
+    const auto values = values_writer.build();
+    auto values_index =
+        HashIndex<u64, std::string_view>::open(
+            View<u8>{values.data(), values.size()});
+    REQUIRE(values_index.is_value());
+    REQUIRE((values_index->find(42) == std::string_view{"symbol_42"}));
+    REQUIRE(values_index->find(500).is_none());
+
+    const auto view_bytes = reverse_writer.build();
+    auto view_index       = HashIndex<u64, StringView>::open(
+        View<u8>{view_bytes.data(), view_bytes.size()});
+    REQUIRE(view_index.is_value());
+    REQUIRE(view_index->find(0).value() == StringView{"zero"});
+  }
+
+  SECTION("Empty")
+  {
+    const auto bytes = HashIndexWriter<u64, u64>{}.build();
+    auto index =
+        HashIndex<u64, u64>::open(View<u8>{bytes.data(), bytes.size()});
+    REQUIRE(index.is_value());
+    REQUIRE(index->size() == 0);
+    REQUIRE(index->find(0).is_none());
+    REQUIRE(index->verify());
+  }
+
+  SECTION("Endianness")
+  {
+    check_endian<std::endian::little>();
+    check_endian<std::endian::big>();
+  }
+
+  SECTION("Rejected")
+  {
+    HashIndexWriter<u64, double> writer{2};
+    for (u64 i = 0; i < 16; i++)
+      writer.insert(i, i * 0.5);
+    auto bytes = writer.build();
+    const View<u8> view = {bytes.data(), bytes.size()};
+
+    REQUIRE(HashIndex<u64, double>::open(view, 2).is_value());
+    // Version of the schema, types and hashing algorithm
+    REQUIRE(HashIndex<u64, double>::open(view, 1).is_none());
+    REQUIRE(HashIndex<u64, u64>::open(view, 2).is_none());
+    REQUIRE(HashIndex<u32, double>::open(view, 2).is_none());
+    REQUIRE(HashIndex<std::string_view, double>::open(view, 2).is_none());
+    REQUIRE(BasicHashIndex<u64, double, fnv1a_h>::open(view, 2).is_none());
+    // Truncated
+    REQUIRE(HashIndex<u64, double>::open(view.subspan(0, 16), 2).is_none());
+    REQUIRE(
+        HashIndex<u64, double>::open(view.subspan(0, view.size() - 8), 2)
+            .is_none());
+
+    // A corrupted payload is only detected by 'verify'
+    bytes.data()[HASH_INDEX_HEADER_SIZE + 3 * HASH_INDEX_SLOT_SIZE + 5] ^= 1;
+    auto index = HashIndex<u64, double>::open(view, 2);
+    REQUIRE(index.is_value());
+    REQUIRE(!index->verify());
+    // A corrupted header is rejected
+    bytes.data()[0] ^= 1;
+    REQUIRE(HashIndex<u64, double>::open(view, 2).is_none());
+  }
+
+  SECTION("View Of File")
+  {
+    HashIndexWriter<std::string_view, std::string_view> writer{1};
+    writer.insert("first", "1st");
+    writer.insert("second", "2nd");
+    writer.insert("third", "3rd");
+
+    std::remove("test_hash_index.bin");
+    auto file = File::open("test_hash_index.bin", File::Write);
+    REQUIRE(file.is_value());
+    REQUIRE(writer.write_to(*file).is_success());
+    file->close();
+
+    auto view = ViewOfFile::open("test_hash_index.bin");
+    REQUIRE(view.is_value());
+    auto index = HashIndex<std::string_view, std::string_view>::open(*view, 1);
+    REQUIRE(index.is_value());
+    REQUIRE(index->verify());
+    REQUIRE((index->find("second") == std::string_view{"2nd"}));
+    REQUIRE(index->find("fourth").is_none());
+  }
+}
@@ -0,0 +1,74 @@
+/*****************************************************************/ /**
+ * @file   test_job_runner.cpp
+ * @brief  Unit tests for `JobRunner`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/io/job_runner.h>
+#include <string>
+
+#ifndef COLT_WINDOWS
+TEST_CASE("JobRunner")
+{
+  using namespace clt;
+
+  /// @brief Returns the output of a job
+  auto output_of = [](const JobRunner& runner, JobID job)
+  {
+    auto out = runner.result(job).output;
+    return std::string(out.begin(), out.end());
+  };
+
+  SECTION("Dependencies")
+  {
+    JobRunner runner = {2};
+    REQUIRE(runner.max_parallel() == 2);
+
+    const char* first[]  = {"/bin/sh", "-c", "echo first", nullptr};
+    const char* large[]  = {
+        "/bin/sh", "-c", "yes 0123456789 | head -n 20000", nullptr};
+    const char* error[]  = {"/bin/sh", "-c", "echo oops >&2; exit 3", nullptr};
+    const char* second[] = {"/bin/sh", "-c", "echo second", nullptr};
+    const JobID a        = runner.add(first);
+    const JobID b        = runner.add(large);
+    const JobID c        = runner.add(error);
+    const JobID d        = runner.add(second, View<JobID>{&a, 1});
+    // Skipped: depends on a failing job
+    const JobID deps[] = {a, c};
+    const JobID e      = runner.add(second, deps);
+    const JobID f      = runner.add(second, View<JobID>{&e, 1});
+    REQUIRE(runner.size() == 6);
+
+    REQUIRE(!runner.run());
+    REQUIRE(runner.result(a).is_success());
+    REQUIRE(output_of(runner, a) == "first\n");
+    REQUIRE(runner.result(b).is_success());
+    REQUIRE(output_of(runner, b).size() == 20000 * 11);
+    REQUIRE(runner.result(c).status == JobStatus::Failed);
+    REQUIRE(runner.result(c).exit_code == 3);
+    REQUIRE(output_of(runner, c) == "oops\n");
+    REQUIRE(runner.result(d).is_success());
+    REQUIRE(output_of(runner, d) == "second\n");
+    REQUIRE(runner.result(e).status == JobStatus::Skipped);
+    REQUIRE(runner.result(f).status == JobStatus::Skipped);
+    REQUIRE(runner.result(d).timing.run.count() > 0);
+
+    // Jobs added after a run can depend on finished jobs
+    const JobID g = runner.add(second, View<JobID>{&d, 1});
+    REQUIRE(runner.run() == false); // 'c' still failed
+    REQUIRE(runner.result(g).is_success());
+  }
+
+  SECTION("Spawn Failure")
+  {
+    JobRunner runner;
+    REQUIRE(runner.max_parallel() >= 1);
+    const char* missing[] = {"/this/does/not/exist", nullptr};
+    const JobID a         = runner.add(missing);
+    REQUIRE(!runner.run());
+    REQUIRE(!runner.result(a).is_success());
+  }
+}
+#endif // !COLT_WINDOWS
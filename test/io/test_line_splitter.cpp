@@ -0,0 +1,80 @@
+/*****************************************************************/ /**
+ * @file   test_line_splitter.cpp
+ * @brief  Unit tests for `LineSplitter` and `ChunkSplitter`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/io/line_splitter.h>
+#include <colt/io/mmap.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+TEST_CASE("LineSplitter")
+{
+  using namespace clt;
+
+  SECTION("Lines")
+  {
+    std::vector<std::string> lines;
+    for (StringView line : LineSplitter{StringView{"a\r\n\nbc\nlast"}})
+      lines.emplace_back(line.data(), line.unit_len());
+    REQUIRE(lines == std::vector<std::string>{"a", "", "bc", "last"});
+
+    auto empty = LineSplitter{StringView{""}};
+    REQUIRE(empty.begin() == empty.end());
+    size_t count = 0;
+    for (auto line : LineSplitter{StringView{"\n\n"}})
+    {
+      REQUIRE(line.is_empty());
+      count++;
+    }
+    REQUIRE(count == 2);
+
+    for (u8StringView line : LineSplitter<StringEncoding::UTF8>{"é€\nñ"_UTF8})
+      REQUIRE(line.size() == (line.unit_len() == 5 ? 2 : 1));
+  }
+
+  SECTION("Mapped Chunks")
+  {
+    std::string expected;
+    for (size_t i = 0; i < 10'000; i++)
+      expected += std::string(i % 97, 'a' + i % 26) + "\n";
+    auto file = fopen("test_lines.txt", "wb");
+    REQUIRE(file != nullptr);
+    fwrite(expected.data(), 1, expected.size(), file);
+    fclose(file);
+
+    auto mapped = ViewOfFile::open("test_lines.txt");
+    REQUIRE(mapped.is_value());
+    for (size_t n : {1, 2, 7, 64})
+    {
+      auto chunks = ChunkSplitter{*mapped->view(), n};
+      REQUIRE(chunks.size() == n);
+      std::string joined;
+      size_t lines = 0;
+      for (size_t i = 0; i < chunks.size(); i++)
+      {
+        auto chunk = chunks[i];
+        // Chunks end on a newline
+        REQUIRE((chunk.is_empty() || chunk.data()[chunk.unit_len() - 1] == '\n'));
+        joined.append(chunk.data(), chunk.unit_len());
+        for (auto line : LineSplitter{chunk})
+        {
+          REQUIRE(line.unit_len() == lines % 97);
+          lines++;
+        }
+      }
+      REQUIRE(joined == expected);
+      REQUIRE(lines == 10'000);
+    }
+
+    // Lines longer than the chunks produce empty chunks
+    auto chunks = ChunkSplitter{StringView{"aaaaaaaaaa\nb"}, 4};
+    REQUIRE(chunks[0] == StringView{"aaaaaaaaaa\n"});
+    REQUIRE(chunks[1].is_empty());
+    REQUIRE(chunks[3] == StringView{"b"});
+  }
+}
@@ -0,0 +1,79 @@
+/*****************************************************************/ /**
+ * @file   test_parse.cpp
+ * @brief  Unit tests for `parse_int` and `parse_float`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/io/parse.h>
+#include <random>
+#include <string>
+
+TEST_CASE("Parse")
+{
+  using namespace clt;
+
+  SECTION("Integers")
+  {
+    REQUIRE(*parse_int<u64>("0") == 0);
+    REQUIRE(*parse_int<u64>("000000000000000000000000000042") == 42);
+    REQUIRE(*parse_int<u64>("18446744073709551615") == 18446744073709551615ULL);
+    REQUIRE(*parse_int<i64>("-9223372036854775808")
+            == std::numeric_limits<i64>::min());
+    REQUIRE(*parse_int<i64>("+9223372036854775807")
+            == std::numeric_limits<i64>::max());
+    REQUIRE(*parse_int<i8>("-128") == -128);
+    REQUIRE(*parse_int<u32>(u8StringView{"12345678"_UTF8}) == 12345678);
+    REQUIRE(*parse_int<u32>("ff", 16) == 255);
+    REQUIRE(*parse_int<i32>("-Zz", 36) == -(35 * 36 + 35));
+    REQUIRE(*parse_int<u8>("1010", 2) == 10);
+    REQUIRE(*parse_int<u32>("1234567890") == 1234567890);
+  }
+
+  SECTION("Integer Errors")
+  {
+    using enum ParsingCode;
+    REQUIRE(parse_int<u64>("").error() == EXPECTED_MORE);
+    REQUIRE(parse_int<i64>("-").error() == EXPECTED_MORE);
+    REQUIRE(parse_int<u64>("-1").error() == INVALID_VALUE);
+    REQUIRE(parse_int<u64>("a").error() == INVALID_VALUE);
+    REQUIRE(parse_int<u64>("12345678a").error() == NON_EMPTY_REM);
+    REQUIRE(parse_int<u64>("00 ").error() == NON_EMPTY_REM);
+    REQUIRE(parse_int<u32>("12", 2).error() == NON_EMPTY_REM);
+    REQUIRE(parse_int<u64>("18446744073709551616").error() == OUT_OF_RANGE);
+    REQUIRE(
+        parse_int<u64>("99999999999999999999999999").error() == OUT_OF_RANGE);
+    REQUIRE(parse_int<i64>("9223372036854775808").error() == OUT_OF_RANGE);
+    REQUIRE(parse_int<i8>("-129").error() == OUT_OF_RANGE);
+    REQUIRE(parse_int<u8>("256").error() == OUT_OF_RANGE);
+  }
+
+  SECTION("Random Integers")
+  {
+    std::mt19937_64 rng{42};
+    for (size_t i = 0; i < 10'000; i++)
+    {
+      const auto value  = static_cast<i64>(rng()) >> (rng() % 64);
+      const auto strv   = std::to_string(value);
+      const auto uvalue = rng() >> (rng() % 64);
+      const auto ustrv  = std::to_string(uvalue);
+      REQUIRE(*parse_int<i64>(strv) == value);
+      REQUIRE(*parse_int<u64>(ustrv) == uvalue);
+    }
+  }
+
+  SECTION("Floats")
+  {
+    using enum ParsingCode;
+    REQUIRE(*parse_float<double>("1.5") == 1.5);
+    REQUIRE(*parse_float<double>("+1e3") == 1000.0);
+    REQUIRE(*parse_float<double>(u8StringView{"-0.25"_UTF8}) == -0.25);
+    REQUIRE(*parse_float<float>("3.25") == 3.25f);
+    REQUIRE(*parse_float<double>("0.1") == 0.1);
+    REQUIRE(parse_float<double>("").error() == EXPECTED_MORE);
+    REQUIRE(parse_float<double>("abc").error() == INVALID_VALUE);
+    REQUIRE(parse_float<double>("1.5x").error() == NON_EMPTY_REM);
+    REQUIRE(parse_float<double>("1e999").error() == OUT_OF_RANGE);
+  }
+}
@@ -0,0 +1,122 @@
+/*****************************************************************/ /**
+ * @file   test_perf_counters.cpp
+ * @brief  Unit tests for PerfCounters and PerfRegion.
+ * The hardware counters may not be available (in containers or with a
+ * restrictive 'perf_event_paranoid'): the tests only check the counters
+ * that were opened.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/perf_counters.h>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace
+{
+  /// @brief Does some work that cannot be optimized out
+  clt::u64 work(clt::u64 count)
+  {
+    volatile clt::u64 sum = 0;
+    for (clt::u64 i = 0; i < count; i++)
+      sum = sum + i * i;
+    return sum;
+  }
+} // namespace
+
+TEST_CASE("PerfCounters")
+{
+  using namespace clt;
+
+  SECTION("Read")
+  {
+    const auto& counters = PerfCounters::this_thread();
+    REQUIRE(&counters == &PerfCounters::this_thread());
+    const auto begin = counters.read();
+    (void)work(100'000);
+    const auto counts = counters.read() - begin;
+    REQUIRE(counts.ticks > 0);
+    REQUIRE(counts.available == counters.available());
+    if (counts.is_available(PerfCounter::INSTRUCTIONS))
+      REQUIRE(counts[PerfCounter::INSTRUCTIONS] >= 100'000);
+    if (counts.is_available(PerfCounter::CYCLES))
+    {
+      REQUIRE(counts[PerfCounter::CYCLES] > 0);
+      if (counts.is_available(PerfCounter::INSTRUCTIONS))
+        REQUIRE(counts.ipc() > 0.0);
+    }
+    else
+      REQUIRE(counts.ipc() == 0.0);
+  }
+
+  SECTION("Arithmetic")
+  {
+    PerfCounts a = {10, {1, 2, 3, 4}, 0b0011};
+    PerfCounts b = {25, {4, 8, 3, 9}, 0b0111};
+    auto diff    = b - a;
+    REQUIRE(diff.ticks == 15);
+    REQUIRE(diff[PerfCounter::CYCLES] == 3);
+    REQUIRE(diff[PerfCounter::BRANCH_MISSES] == 5);
+    REQUIRE(diff.available == 0b0011);
+    REQUIRE(diff.ipc() == 2.0);
+
+    PerfCounts sum;
+    sum += b;
+    REQUIRE(sum.available == 0b0111);
+    sum += a;
+    REQUIRE(sum.available == 0b0011);
+    REQUIRE(sum.ticks == 35);
+    REQUIRE(sum[PerfCounter::INSTRUCTIONS] == 10);
+  }
+
+  SECTION("Format")
+  {
+    PerfCounts counts = {100, {50, 100, 7, 2}, 0b1111};
+    REQUIRE(
+        fmt::format("{}", counts)
+        == "100 ticks, 50 cycles, 100 instructions (2.00 IPC), 7 cache-misses, "
+           "2 branch-misses");
+    counts.available = 0b1000;
+    REQUIRE(fmt::format("{}", counts) == "100 ticks, 2 branch-misses");
+    counts.available = 0;
+    REQUIRE(fmt::format("{}", counts) == "100 ticks");
+  }
+
+  SECTION("Region")
+  {
+    static PerfRegion region = {"test_region"};
+    region.reset();
+    REQUIRE(region.count() == 0);
+    REQUIRE(region.total().ticks == 0);
+
+    auto measured = []
+    {
+      for (int i = 0; i < 10; i++)
+      {
+        COLT_PERF_SCOPE(region);
+        (void)work(1000);
+      }
+    };
+    trace::start();
+    std::thread thread{measured};
+    measured();
+    thread.join();
+    trace::stop();
+
+    REQUIRE(region.count() == 20);
+    const auto total = region.total();
+    REQUIRE(total.ticks > 0);
+    REQUIRE(total.available == PerfCounters::this_thread().available());
+    REQUIRE(std::strcmp(region.name(), "test_region") == 0);
+
+    // Each scope is also a trace zone
+    auto events = trace::collect();
+    size_t count = 0;
+    for (auto& event : events)
+      count += std::strcmp(event.name, "test_region") == 0;
+    REQUIRE(count == 20);
+    trace::clear();
+  }
+}
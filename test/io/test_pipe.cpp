@@ -0,0 +1,97 @@
+/*****************************************************************/ /**
+ * @file   test_pipe.cpp
+ * @brief  Unit tests for `Pipe`, `poll_readable` and `forward`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/io/pipe.h>
+#include <colt/io/buffered_file.h>
+#include <cstdio>
+#include <string>
+
+TEST_CASE("Pipe")
+{
+  using namespace clt;
+  using namespace std::chrono_literals;
+
+  auto a = Pipe::create();
+  auto b = Pipe::create();
+  REQUIRE(a.is_value());
+  REQUIRE(b.is_value());
+
+  SECTION("Poll")
+  {
+    PollEntry entries[2] = {{&a->read_end}, {&b->read_end}};
+    REQUIRE(*poll_readable(entries, 0ms) == 0);
+
+    const std::string msg = "hello\nworld\n";
+    auto write            = b->write_end.write(
+        View<u8>{ptr_to<const u8*>(msg.data()), msg.size()});
+    REQUIRE(*write == msg.size());
+    REQUIRE(*poll_readable(entries, -1ms) == 1);
+    REQUIRE(!entries[0].readable);
+    REQUIRE(entries[1].readable);
+    REQUIRE(!entries[1].closed);
+
+    b->write_end.close();
+    {
+      // Pipes can be read by the buffered readers
+      BufferedReader reader = {mem::GlobalAllocator, b->read_end};
+      auto line             = reader.read_line();
+      REQUIRE(line.is_value());
+      REQUIRE(std::string(line->begin(), line->end()) == "hello");
+    }
+    REQUIRE(*poll_readable(entries, 0ms) == 1);
+    REQUIRE(entries[1].closed);
+    a->close();
+    b->read_end.close();
+  }
+
+  SECTION("Forward")
+  {
+    std::string msg(100'000, '\0');
+    for (size_t i = 0; i < msg.size(); i++)
+      msg[i] = static_cast<char>('a' + i % 26);
+    std::remove("test_pipe.txt");
+    auto file = File::open("test_pipe.txt", File::Write);
+    REQUIRE(file.is_value());
+
+    size_t written = 0, forwarded = 0;
+    while (forwarded != msg.size())
+    {
+      if (written != msg.size())
+      {
+        // Pipes have a limited capacity: write a part of the message
+        const size_t size = clt::min(msg.size() - written, size_t{4096});
+        auto write        = a->write_end.write(
+            View<u8>{ptr_to<const u8*>(msg.data() + written), size});
+        REQUIRE(write.is_value());
+        written += *write;
+      }
+      // Pipe to pipe then pipe to file
+      auto moved = forward(a->read_end, b->write_end);
+      REQUIRE(moved.is_value());
+      while (*moved != 0)
+      {
+        auto to_file = forward(b->read_end, *file, *moved);
+        REQUIRE(to_file.is_value());
+        forwarded += *to_file;
+        *moved -= *to_file;
+      }
+    }
+    file->close();
+    a->close();
+    b->close();
+
+    auto read = File::open("test_pipe.txt", File::Read);
+    REQUIRE(read.is_value());
+    std::string content(msg.size() + 1, '\0');
+    REQUIRE(*read->read(Span<u8>{ptr_to<u8*>(content.data()), content.size()})
+            == msg.size());
+    content.resize(msg.size());
+    REQUIRE(content == msg);
+    read->close();
+  }
+}
@@ -0,0 +1,66 @@
+/*****************************************************************/ /**
+ * @file   test_print.cpp
+ * @brief  Unit tests for `format_into` and `FormatBuffer`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/io/print.h>
+#include <colt/dsa/string.h>
+#include <string>
+
+TEST_CASE("format_into")
+{
+  using namespace clt;
+
+  SECTION("String")
+  {
+    auto str = make_u8string();
+    format_into(str, "{} + {} = {}", 1, 2, 3);
+    REQUIRE(str == "1 + 2 = 3"_UTF8);
+    REQUIRE(str.size() == 9);
+
+    // Appends, growing out of the SSO buffer
+    std::string expected = "1 + 2 = 3";
+    for (int i = 0; i < 500; i++)
+    {
+      format_into(str, "μ{}", i);
+      expected += fmt::format("μ{}", i);
+    }
+    REQUIRE(str.unit_len() == expected.size());
+    REQUIRE(std::memcmp(str.c_str(), expected.data(), expected.size()) == 0);
+    REQUIRE(str.size() == uni::countlen(str.c_str(), str.unit_len()));
+    for (size_t i = 0; i < str.size(); i += 97)
+      REQUIRE(str[i] == uni::index_front(str.c_str(), i));
+    REQUIRE(str.back() == U'9');
+  }
+
+  SECTION("Literal")
+  {
+    auto str = make_u8string("Hello"_UTF8);
+    format_into(str, " {}!", "World");
+    REQUIRE_FALSE(str.is_borrowed());
+    REQUIRE(str == "Hello World!"_UTF8);
+    // Large output: is never stored in another buffer
+    format_into(str, "{:>10000}", '.');
+    REQUIRE(str.unit_len() == 10012);
+    REQUIRE(str.size() == 10012);
+    REQUIRE(str.back() == U'.');
+  }
+
+  SECTION("Vector")
+  {
+    auto chars = make_vector<char>();
+    format_into(chars, "{:08x}", 0xABCDu);
+    REQUIRE(chars.size() == 8);
+    REQUIRE(std::string_view{chars.data(), chars.size()} == "0000abcd");
+
+    auto bytes = make_vector<u8>();
+    for (int i = 0; i < 1000; i++)
+      format_into(bytes, "{}", i % 10);
+    REQUIRE(bytes.size() == 1000);
+    REQUIRE(bytes[999] == '9');
+    REQUIRE(bytes[10] == '0');
+  }
+}
@@ -0,0 +1,123 @@
+/*****************************************************************/ /**
+ * @file   test_text_chunks.cpp
+ * @brief  Unit tests for `text_chunks` and `decode_chunks`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/io/text_chunks.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+TEST_CASE("Text Chunks")
+{
+  using namespace clt;
+
+  mem::StatsAllocator<mem::Mallocator> alloc;
+
+  // Sequences of 1 to 4 units
+  std::string text;
+  for (size_t i = 0; i < 2'000; i++)
+    text += i % 5 == 0 ? "a" : i % 5 == 1 ? "é" : i % 5 == 2 ? "€\n" : "😀";
+  const auto utf8 =
+      u8StringView{ptr_to<const Char8*>(text.data()), text.size()};
+
+  SECTION("String View")
+  {
+    for (size_t size : {1, 3, 4, 7, 64, 100'000})
+    {
+      std::string joined;
+      for (u8StringView chunk :
+           text_chunks(std::allocator_arg, alloc, utf8, size))
+      {
+        REQUIRE(!chunk.is_empty());
+        REQUIRE(chunk.unit_len() <= size);
+        if (size >= 4)
+          REQUIRE(uni::validate(chunk.data(), chunk.unit_len()).is_value());
+        joined.append(ptr_to<const char*>(chunk.data()), chunk.unit_len());
+      }
+      REQUIRE(joined == text);
+    }
+    REQUIRE(alloc.stats().live_bytes == 0);
+
+    const auto utf16 = u16StringView{"a😀b😀"_UTF16};
+    std::vector<size_t> sizes;
+    for (u16StringView chunk : text_chunks(utf16, 2))
+      sizes.push_back(chunk.unit_len());
+    REQUIRE(sizes == std::vector<size_t>{1, 2, 1, 2});
+
+    auto empty = text_chunks(StringView{""});
+    REQUIRE(empty.begin() == empty.end());
+  }
+
+  SECTION("Files")
+  {
+    std::remove("test_text_chunks.txt");
+    auto file = File::open("test_text_chunks.txt", File::Write);
+    REQUIRE(file.is_value());
+    REQUIRE(file->write(View<u8>{ptr_to<const u8*>(text.data()), text.size()})
+                .is_value());
+    file->close();
+
+    auto mapped = ViewOfFile::open("test_text_chunks.txt");
+    REQUIRE(mapped.is_value());
+    auto chunks = text_chunks<StringEncoding::UTF8>(
+        std::allocator_arg, alloc, *mapped, 4096);
+    REQUIRE(chunks.is_value());
+    std::string joined;
+    for (u8StringView chunk : *chunks)
+    {
+      REQUIRE(chunk.unit_len() <= 4096);
+      REQUIRE(uni::validate(chunk.data(), chunk.unit_len()).is_value());
+      joined.append(ptr_to<const char*>(chunk.data()), chunk.unit_len());
+    }
+    REQUIRE(joined == text);
+
+    auto input = File::open("test_text_chunks.txt", File::Read);
+    REQUIRE(input.is_value());
+    BufferedReader reader = {mem::GlobalAllocator, *input, 16};
+    joined.clear();
+    size_t count = 0;
+    for (u8StringView chunk :
+         text_chunks<StringEncoding::UTF8>(std::allocator_arg, alloc, reader, 10))
+    {
+      REQUIRE(chunk.unit_len() <= 10);
+      REQUIRE(uni::validate(chunk.data(), chunk.unit_len()).is_value());
+      joined.append(ptr_to<const char*>(chunk.data()), chunk.unit_len());
+      count++;
+    }
+    REQUIRE(joined == text);
+    REQUIRE(count >= text.size() / 10);
+    REQUIRE(reader.is_eof());
+  }
+
+  SECTION("Decode")
+  {
+    std::vector<char32_t> expected;
+    for (auto it = uni::CodePointIterator<StringEncoding::UTF8>{utf8.data()};
+         it.current() != utf8.data() + utf8.unit_len(); ++it)
+      expected.push_back(*it);
+
+    std::vector<char32_t> decoded;
+    for (View<char32_t> batch : decode_chunks<100>(
+             std::allocator_arg, alloc,
+             text_chunks(std::allocator_arg, alloc, utf8, 333)))
+    {
+      REQUIRE(batch.size() <= 100);
+      decoded.insert(decoded.end(), batch.begin(), batch.end());
+    }
+    REQUIRE(decoded == expected);
+    REQUIRE(alloc.stats().live_bytes == 0);
+
+    // Invalid units are replaced
+    const char invalid[] = {'a', '\xFF', '\xE2', '\x82', 'b'};
+    decoded.clear();
+    for (View<char32_t> batch :
+         decode_chunks(text_chunks(u8StringView{ptr_to<const Char8*>(invalid), 5})))
+      decoded.insert(decoded.end(), batch.begin(), batch.end());
+    const char32_t bad = U'\uFFFD';
+    REQUIRE(decoded == std::vector<char32_t>{U'a', bad, bad, bad, U'b'});
+  }
+}
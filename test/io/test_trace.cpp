@@ -0,0 +1,160 @@
+/*****************************************************************/ /**
+ * @file   test_trace.cpp
+ * @brief  Unit tests for the tracing zones (`trace.h`).
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/trace.h>
+#include <colt/io/file.h>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace
+{
+  /// @brief Records nested zones
+  void traced(int depth)
+  {
+    COLT_TRACE_SCOPE("traced");
+    if (depth > 0)
+      traced(depth - 1);
+  }
+
+  /// @brief Zones do nothing during constant evaluation
+  constexpr int traced_constexpr(int value)
+  {
+    COLT_TRACE_SCOPE("traced_constexpr");
+    return value * 2;
+  }
+
+  /// @brief Reads a whole file
+  std::string read_file(const char* path)
+  {
+    std::ifstream file{path, std::ios::binary};
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+  }
+} // namespace
+
+TEST_CASE("Trace")
+{
+  using namespace clt;
+
+  trace::stop();
+  trace::clear();
+
+  SECTION("Nested zones")
+  {
+    trace::start();
+    REQUIRE(trace::is_recording());
+    traced(2);
+    trace::stop();
+    REQUIRE_FALSE(trace::is_recording());
+
+    auto events = trace::collect();
+    REQUIRE(events.size() == 3);
+    for (auto& event : events)
+    {
+      REQUIRE(std::strcmp(event.name, "traced") == 0);
+      REQUIRE(std::strstr(event.src.file_name(), "test_trace") != nullptr);
+    }
+    // Sorted by beginning: each zone contains the next one
+    for (size_t i = 1; i < events.size(); i++)
+    {
+      REQUIRE(events[i - 1].begin_ns <= events[i].begin_ns);
+      REQUIRE(
+          events[i].begin_ns + events[i].duration_ns
+          <= events[i - 1].begin_ns + events[i - 1].duration_ns);
+    }
+  }
+
+  SECTION("Not recording")
+  {
+    traced(3);
+    REQUIRE(trace::collect().empty());
+    REQUIRE(traced_constexpr(2) == 4);
+    static_assert(traced_constexpr(4) == 8);
+  }
+
+  SECTION("Threads")
+  {
+    trace::start();
+    traced(0);
+    std::thread thread{[]
+                       {
+                         trace::set_thread_name("worker");
+                         traced(1);
+                       }};
+    thread.join();
+    trace::stop();
+
+    auto events = trace::collect();
+    REQUIRE(events.size() == 3);
+    REQUIRE(events[0].thread != events.back().thread);
+    REQUIRE(events[1].thread == events[2].thread);
+  }
+
+  SECTION("Overwrite")
+  {
+    // Only applies to the buffers of new threads
+    trace::start(4);
+    std::thread thread{[]
+                       {
+                         for (int i = 0; i < 10; i++)
+                           traced(0);
+                       }};
+    thread.join();
+    trace::stop();
+    REQUIRE(trace::collect().size() == 4);
+    REQUIRE(trace::overwritten_count() == 6);
+    trace::clear();
+    REQUIRE(trace::collect().empty());
+    REQUIRE(trace::overwritten_count() == 0);
+  }
+
+  SECTION("Chrome trace")
+  {
+    trace::start();
+    trace::set_thread_name("main \"thread\"");
+    traced(1);
+    trace::stop();
+    {
+      auto file = File::open("test_trace.json", File::Write);
+      REQUIRE(file.is_value());
+      REQUIRE(trace::write_chrome_trace(*file).is_success());
+    }
+    auto json = read_file("test_trace.json");
+    REQUIRE(json.starts_with("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+    REQUIRE(json.find("\"name\":\"traced\"") != std::string::npos);
+    REQUIRE(json.find("\"ph\":\"X\"") != std::string::npos);
+    REQUIRE(json.find("\"thread_name\"") != std::string::npos);
+    REQUIRE(json.find("main \\\"thread\\\"") != std::string::npos);
+    REQUIRE(json.ends_with("]}\n"));
+  }
+
+  SECTION("Perfetto trace")
+  {
+    trace::start();
+    traced(1);
+    trace::stop();
+    {
+      auto file = File::open("test_trace.pftrace", File::Write);
+      REQUIRE(file.is_value());
+      REQUIRE(trace::write_perfetto_trace(*file).is_success());
+    }
+    auto trace = read_file("test_trace.pftrace");
+    REQUIRE(!trace.empty());
+    // Trace.packet (field 1, length-delimited)
+    REQUIRE(trace[0] == '\x0A');
+    REQUIRE(trace.find("traced") != std::string::npos);
+    REQUIRE(trace.find("colt") != std::string::npos);
+  }
+
+  trace::stop();
+  trace::clear();
+}
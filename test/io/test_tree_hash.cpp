@@ -0,0 +1,136 @@
+/*****************************************************************/ /**
+ * @file   test_tree_hash.cpp
+ * @brief  Unit tests for `TreeHash`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/io/tree_hash.h>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+TEST_CASE("Tree Hash")
+{
+  using namespace clt;
+
+  exec::Scheduler sched  = {{.workers = 3}};
+  const par::Options opt = {.grain = 1, .scheduler = &sched};
+
+  std::mt19937_64 rng{42};
+  std::vector<u8> data(100'000);
+  for (auto& byte : data)
+    byte = static_cast<u8>(rng());
+  auto view = [&] { return View<u8>{data.data(), data.size()}; };
+
+  SECTION("Chunks")
+  {
+    const auto hash = TreeHash::hash(view(), 4096, opt);
+    REQUIRE(hash.size() == data.size());
+    REQUIRE(hash.chunk_size() == 4096);
+    REQUIRE(hash.chunk_hashes().size() == 25);
+    for (size_t i = 0; i < 25; i++)
+    {
+      wyhash_h algo;
+      const size_t offset = i * 4096;
+      algo(data.data() + offset, std::min<size_t>(4096, data.size() - offset));
+      REQUIRE(hash.chunk_hashes()[i] == static_cast<u64>(algo));
+    }
+
+    // Independent of the scheduler
+    REQUIRE(TreeHash::hash(view(), 4096).root() == hash.root());
+    // The root depends on the chunk size, the size and the content
+    REQUIRE(TreeHash::hash(view(), 8192, opt).root() != hash.root());
+    REQUIRE(
+        TreeHash::hash(View<u8>{data.data(), data.size() - 1}, 4096, opt).root()
+        != hash.root());
+    data[50'000] ^= 1;
+    REQUIRE(TreeHash::hash(view(), 4096, opt).root() != hash.root());
+
+    const auto empty = TreeHash::hash(View<u8>{data.data(), size_t(0)});
+    REQUIRE(empty.chunk_hashes().empty());
+    REQUIRE(empty.root() != hash.root());
+  }
+
+  SECTION("Update")
+  {
+    auto hash = TreeHash::hash(view(), 4096, opt);
+
+    // Modification of a range spanning two chunks
+    data[4095] ^= 1;
+    data[4096] ^= 1;
+    REQUIRE(hash.update(view(), 4095, 2, opt) == 2);
+    REQUIRE(hash.root() == TreeHash::hash(view(), 4096, opt).root());
+    REQUIRE(hash.update(view(), 0, 0, opt) == 0);
+
+    // Append: the last (partial) chunk and the new ones are rehashed
+    data.resize(110'000, u8{7});
+    REQUIRE(hash.update(view(), 0, 0, opt) == 3);
+    REQUIRE(hash.root() == TreeHash::hash(view(), 4096, opt).root());
+
+    // Truncation, with a modification
+    data.resize(9000);
+    data[10] ^= 1;
+    REQUIRE(hash.update(view(), 10, 1, opt) == 2);
+    REQUIRE(hash.chunk_hashes().size() == 3);
+    REQUIRE(hash.root() == TreeHash::hash(view(), 4096, opt).root());
+
+    // Modification of the chunk whose size changed
+    data.resize(12'288);
+    data[8200] ^= 1;
+    REQUIRE(hash.update(view(), 8200, 100'000, opt) == 1);
+    REQUIRE(hash.root() == TreeHash::hash(view(), 4096, opt).root());
+  }
+
+  SECTION("Persisted")
+  {
+    const auto hash  = TreeHash::hash(view(), 4096, opt);
+    auto bytes       = hash.save();
+    const auto saved = View<u8>{bytes.data(), bytes.size()};
+    REQUIRE(bytes.size() == TREE_HASH_HEADER_SIZE + 25 * sizeof(u64));
+
+    auto loaded = TreeHash::open(saved);
+    REQUIRE(loaded.is_value());
+    REQUIRE(loaded->root() == hash.root());
+    REQUIRE(loaded->size() == hash.size());
+
+    // Only the modified chunk is rehashed
+    data[70'000] ^= 1;
+    REQUIRE(loaded->update(view(), 70'000, 1, opt) == 1);
+    REQUIRE(loaded->root() == TreeHash::hash(view(), 4096, opt).root());
+
+    // Other algorithm, truncated or corrupted
+    REQUIRE(BasicTreeHash<murmur64a_h>::open(saved).is_none());
+    REQUIRE(TreeHash::open(saved.subspan(0, 16)).is_none());
+    REQUIRE(TreeHash::open(saved.subspan(0, saved.size() - 8)).is_none());
+    bytes.data()[TREE_HASH_HEADER_SIZE + 3] ^= 1;
+    REQUIRE(TreeHash::open(saved).is_none());
+  }
+
+  SECTION("View Of File")
+  {
+    std::remove("test_tree_hash.bin");
+    auto file = File::open("test_tree_hash.bin", File::Write);
+    REQUIRE(file.is_value());
+    REQUIRE(file->write(view()).is_value());
+    file->close();
+
+    auto mapped = ViewOfFile::open("test_tree_hash.bin");
+    REQUIRE(mapped.is_value());
+    auto hash = TreeHash::hash(*mapped, 4096, opt);
+    REQUIRE(hash.is_value());
+    REQUIRE(hash->root() == TreeHash::hash(view(), 4096, opt).root());
+
+    std::remove("test_tree_hash.idx");
+    auto out = File::open("test_tree_hash.idx", File::Write);
+    REQUIRE(out.is_value());
+    REQUIRE(hash->write_to(*out).is_success());
+    out->close();
+    auto persisted = ViewOfFile::open("test_tree_hash.idx");
+    REQUIRE(persisted.is_value());
+    auto loaded = TreeHash::open(*persisted);
+    REQUIRE(loaded.is_value());
+    REQUIRE(loaded->root() == hash->root());
+  }
+}
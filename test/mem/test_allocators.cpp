@@ -0,0 +1,685 @@
+/*****************************************************************/ /**
+ * @file   test_allocators.cpp
+ * @brief  Unit tests for the allocators.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/mem/allocator_ref.h>
+#include <colt/mem/arena_alloc.h>
+#include <colt/mem/guard_alloc.h>
+#include <colt/mem/exec_alloc.h>
+#include <colt/dsa/vector.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#ifdef COLT_LINUX
+  #include <sys/wait.h>
+  #include <unistd.h>
+
+/// @brief Check if running 'fn' in a child process results in a fault
+/// @param fn The function to run
+/// @return True if the child process did not exit normally
+template<typename Fn>
+static bool faults(Fn fn)
+{
+  const pid_t pid = fork();
+  if (pid == 0)
+  {
+    fn();
+    _exit(0);
+  }
+  int status = 0;
+  waitpid(pid, &status, 0);
+  return !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+}
+#endif // COLT_LINUX
+
+/// @brief Mallocator that counts the calls to 'alloc' and 'dealloc'
+struct CountingMallocator : public clt::mem::Mallocator
+{
+  /// @brief The count of calls to 'alloc'
+  static inline size_t alloc_count = 0;
+  /// @brief The count of calls to 'dealloc'
+  static inline size_t dealloc_count = 0;
+
+  clt::mem::MemBlock alloc(clt::u64 size) const noexcept
+  {
+    ++alloc_count;
+    return Mallocator::alloc(size);
+  }
+
+  void dealloc(clt::mem::MemBlock blk) const noexcept
+  {
+    ++dealloc_count;
+    Mallocator::dealloc(blk);
+  }
+};
+
+TEST_CASE("Mallocator")
+{
+  using namespace clt;
+
+  mem::Mallocator alloc;
+  auto blk = alloc.alloc(1);
+  // Blocks are never expanded in place, even in the slack of 'malloc'
+  static_assert(!meta::ExpandingAllocator<mem::Mallocator>);
+  REQUIRE(blk.size() == 1);
+  REQUIRE(alloc.realloc(blk, 4096));
+  REQUIRE(blk.size() == 4096);
+  REQUIRE(alloc.realloc(blk, 0));
+  REQUIRE(blk.is_null());
+}
+
+TEST_CASE("SegregatedFreeList")
+{
+  using namespace clt;
+  CountingMallocator::alloc_count   = 0;
+  CountingMallocator::dealloc_count = 0;
+  {
+    mem::SegregatedFreeList<CountingMallocator, 16, 256, 16, 2> list;
+
+    // Sizes are rounded up to their size class
+    auto a = list.alloc(20);
+    REQUIRE(a.size() == 32);
+    list.dealloc(a);
+    REQUIRE(CountingMallocator::dealloc_count == 0);
+    // Any size of the same class reuses the block
+    auto b = list.alloc(30);
+    REQUIRE(b.ptr() == a.ptr());
+    REQUIRE(CountingMallocator::alloc_count == 1);
+    // Other classes do not
+    auto c = list.alloc(33);
+    REQUIRE(c.size() == 48);
+    REQUIRE(c.ptr() != b.ptr());
+
+    // Blocks can be expanded in place up to the size of their class
+    mem::MemBlock d = {b.ptr(), 17};
+    REQUIRE(list.expand(d, 32));
+    REQUIRE(!list.expand(d, 33));
+
+    // At most MAX_SAVED blocks are kept per class
+    auto e = list.alloc(32);
+    auto f = list.alloc(32);
+    list.dealloc(b);
+    list.dealloc(e);
+    list.dealloc(f);
+    REQUIRE(CountingMallocator::dealloc_count == 1);
+
+    // Out of range sizes are not cached
+    auto g = list.alloc(257);
+    REQUIRE(g.size() == 257);
+    list.dealloc(g);
+    REQUIRE(CountingMallocator::dealloc_count == 2);
+    list.dealloc(c);
+  }
+  // All the saved blocks are freed on destruction
+  REQUIRE(CountingMallocator::alloc_count == CountingMallocator::dealloc_count);
+}
+
+TEST_CASE("ArenaAllocator")
+{
+  using namespace clt;
+  CountingMallocator::alloc_count   = 0;
+  CountingMallocator::dealloc_count = 0;
+
+  SECTION("Chunks")
+  {
+    {
+      mem::ArenaAllocator<CountingMallocator, 256> arena;
+      REQUIRE(arena.alloc(0).is_null());
+      REQUIRE(CountingMallocator::alloc_count == 0);
+
+      auto a = arena.alloc(10);
+      auto b = arena.alloc(10);
+      REQUIRE(a.size() == 10);
+      REQUIRE(static_cast<u8*>(b.ptr()) == static_cast<u8*>(a.ptr()) + 16);
+      REQUIRE(CountingMallocator::alloc_count == 1);
+      REQUIRE(arena.owns(a));
+      // Deallocating does nothing
+      arena.dealloc(b);
+      REQUIRE(arena.owns(b));
+
+      // Only the last allocation can be expanded
+      REQUIRE(!arena.expand(a, 20));
+      REQUIRE(arena.expand(b, 100));
+      REQUIRE(b.size() == 100);
+      REQUIRE(!arena.expand(b, 1000));
+
+      // A new chunk is allocated when the current one is full
+      auto marker = arena.marker();
+      auto c      = arena.alloc(200);
+      REQUIRE(CountingMallocator::alloc_count == 2);
+      // Allocations bigger than a chunk get their own chunk
+      auto d = arena.alloc(1000);
+      REQUIRE(d.size() == 1000);
+      REQUIRE(CountingMallocator::alloc_count == 3);
+      REQUIRE(arena.owns(c));
+      REQUIRE(!arena.owns(mem::MemBlock{&marker, 1}));
+
+      // Rewinding frees the chunks allocated after the marker
+      arena.rewind(marker);
+      REQUIRE(CountingMallocator::dealloc_count == 2);
+      REQUIRE(!arena.owns(c));
+      auto e = arena.alloc(16);
+      REQUIRE(static_cast<u8*>(e.ptr()) == static_cast<u8*>(b.ptr()) + 112);
+
+      // Reset keeps the first chunk
+      arena.alloc(200);
+      arena.reset();
+      REQUIRE(CountingMallocator::dealloc_count == 3);
+      REQUIRE(arena.alloc(10).ptr() == a.ptr());
+    }
+    REQUIRE(CountingMallocator::alloc_count == CountingMallocator::dealloc_count);
+  }
+
+  SECTION("Pages")
+  {
+    mem::ArenaAllocator<mem::PageAllocator> arena;
+    auto a = arena.alloc(100);
+    REQUIRE(!a.is_null());
+    std::memset(a.ptr(), 0xCC, a.size());
+    auto marker = arena.marker();
+    REQUIRE(!arena.alloc(1024 * 1024).is_null());
+    arena.rewind(marker);
+    REQUIRE(arena.owns(a));
+  }
+
+  SECTION("Huge Pages")
+  {
+    mem::ArenaAllocator<mem::HugePageAllocator, 1024 * 1024> arena;
+    auto a = arena.alloc(3 * 1024 * 1024);
+    REQUIRE(!a.is_null());
+    std::memset(a.ptr(), 0xCC, a.size());
+    REQUIRE(arena.owns(a));
+  }
+
+  SECTION("BasicVector")
+  {
+    mem::ArenaAllocator<mem::Mallocator> arena;
+    using Ref = mem::LocalAllocatorRef<decltype(arena)>;
+    {
+      BasicVector<u64, Ref> vec = Ref{arena};
+      for (u64 i = 0; i < 1000; i++)
+        vec.push_back(i);
+      REQUIRE(vec.size() == 1000);
+      REQUIRE(vec[999] == 999);
+      REQUIRE(arena.owns({vec.data(), sizeof(u64)}));
+    }
+    arena.reset();
+  }
+}
+
+TEST_CASE("PoolAllocator")
+{
+  using namespace clt;
+  CountingMallocator::alloc_count   = 0;
+  CountingMallocator::dealloc_count = 0;
+
+  SECTION("Slots")
+  {
+    {
+      using Pool = mem::PoolAllocator<24, 8, CountingMallocator, 256>;
+      Pool pool;
+      REQUIRE(Pool::slot_per_slab == 10);
+      auto a = pool.alloc(24);
+      auto b = pool.alloc(10);
+      REQUIRE(b.size() == 10);
+      REQUIRE(static_cast<u8*>(b.ptr()) == static_cast<u8*>(a.ptr()) + 24);
+      REQUIRE(pool.owns(a));
+      REQUIRE(!pool.owns(mem::MemBlock{&pool, 1}));
+
+      // Freed slots are reused first
+      pool.dealloc(a);
+      REQUIRE(pool.alloc(24).ptr() == a.ptr());
+      REQUIRE(pool.expand(b, 24));
+      REQUIRE(!pool.expand(b, 25));
+
+      // A new slab is allocated when all the slots are used
+      for (size_t i = 0; i < Pool::slot_per_slab; i++)
+        REQUIRE(!pool.alloc(8).is_null());
+      REQUIRE(CountingMallocator::alloc_count == 2);
+    }
+    REQUIRE(CountingMallocator::dealloc_count == 2);
+  }
+
+  SECTION("Segregator")
+  {
+    // Pools stacked by size class
+    mem::Segregator<
+        16, mem::PoolAllocator<16, 16, mem::Mallocator>,
+        mem::Segregator<
+            64, mem::PoolAllocator<64, 16, mem::Mallocator>, CountingMallocator>>
+        alloc;
+    auto a = alloc.alloc(10);
+    auto b = alloc.alloc(40);
+    auto c = alloc.alloc(100);
+    REQUIRE(a.size() == 10);
+    REQUIRE(b.size() == 40);
+    REQUIRE(CountingMallocator::alloc_count == 1);
+    alloc.dealloc(a);
+    alloc.dealloc(b);
+    alloc.dealloc(c);
+    REQUIRE(alloc.alloc(12).ptr() == a.ptr());
+    REQUIRE(alloc.alloc(64).ptr() == b.ptr());
+  }
+}
+
+TEST_CASE("StatsAllocator")
+{
+  using namespace clt;
+
+  SECTION("Counters")
+  {
+    mem::StatsAllocator<mem::StackAllocator<256, 16>> alloc;
+    auto a = alloc.alloc(10);
+    auto b = alloc.alloc(96);
+    REQUIRE(alloc.alloc(1000).is_null());
+    REQUIRE(alloc.expand(b, 120));
+    REQUIRE(!alloc.expand(a, 20));
+    alloc.dealloc(b);
+
+    auto stats = alloc.stats();
+    REQUIRE(stats.alloc_count == 3);
+    REQUIRE(stats.failed_alloc_count == 1);
+    REQUIRE(stats.dealloc_count == 1);
+    REQUIRE(stats.live_bytes == 10);
+    REQUIRE(stats.peak_bytes == 130);
+    REQUIRE(stats.total_bytes == 130);
+    REQUIRE(stats.expand_count == 2);
+    REQUIRE(stats.expand_success == 1);
+    REQUIRE(stats.histogram[0] == 1);
+    REQUIRE(stats.histogram[mem::AllocatorStats::bucket_of(96)] == 1);
+    // Each allocation was done on a different line
+    size_t sites = 0;
+    for (auto& site : stats.call_sites)
+    {
+      if (site.file == nullptr)
+        continue;
+      ++sites;
+      REQUIRE(site.count == 1);
+    }
+    REQUIRE(sites == 3);
+
+    const auto str = fmt::format("{}", stats);
+    REQUIRE(str.find("calls: 3 alloc (1 failed), 1 dealloc") != std::string::npos);
+    REQUIRE(str.find("<= 128: 1") != std::string::npos);
+  }
+
+  SECTION("Disabled")
+  {
+    using Stats = mem::StatsAllocator<mem::Mallocator, mem::StatsFlag::CALLS>;
+    // The counters that are not enabled are compiled out
+    STATIC_REQUIRE(sizeof(Stats) < sizeof(mem::StatsAllocator<mem::Mallocator>));
+    Stats alloc;
+    alloc.dealloc(alloc.alloc(10));
+    auto stats = alloc.stats();
+    REQUIRE(stats.alloc_count == 1);
+    REQUIRE(stats.live_bytes == 0);
+    REQUIRE(fmt::format("{}", stats).find("bytes") == std::string::npos);
+  }
+}
+
+TEST_CASE("ThreadCachingAllocator")
+{
+  using namespace clt;
+  using Allocator = mem::ThreadCachingAllocator<CountingMallocator, 16, 256, 16, 8>;
+  CountingMallocator::alloc_count   = 0;
+  CountingMallocator::dealloc_count = 0;
+  Allocator alloc;
+
+  SECTION("Magazines")
+  {
+    // The magazine of the size class is refilled in batch
+    auto a = alloc.alloc(20);
+    REQUIRE(a.size() == 32);
+    const size_t allocated = CountingMallocator::alloc_count;
+    REQUIRE(allocated >= 4);
+    alloc.dealloc(a);
+    auto b = alloc.alloc(30);
+    REQUIRE(b.ptr() == a.ptr());
+    REQUIRE(CountingMallocator::alloc_count == allocated);
+
+    // Blocks can be expanded in place up to the size of their class
+    REQUIRE(alloc.expand(b, 32));
+    REQUIRE(!alloc.expand(b, 33));
+
+    // Full magazines are flushed in batch
+    std::vector<mem::MemBlock> blocks;
+    for (size_t i = 0; i < 9; i++)
+      blocks.push_back(alloc.alloc(32));
+    for (size_t i = 0; i < 6; i++)
+      alloc.dealloc(blocks[i]);
+    REQUIRE(CountingMallocator::dealloc_count == 0);
+    for (size_t i = 6; i < 9; i++)
+      alloc.dealloc(blocks[i]);
+    REQUIRE(CountingMallocator::dealloc_count != 0);
+    alloc.dealloc(b);
+
+    // Out of range sizes are not cached
+    auto c = alloc.alloc(257);
+    REQUIRE(c.size() == 257);
+    const size_t deallocated = CountingMallocator::dealloc_count;
+    alloc.dealloc(c);
+    REQUIRE(CountingMallocator::dealloc_count == deallocated + 1);
+  }
+
+  SECTION("Cross Thread")
+  {
+    std::vector<mem::MemBlock> blocks;
+    for (size_t i = 0; i < 8; i++)
+      blocks.push_back(alloc.alloc(48));
+    const size_t allocated = CountingMallocator::alloc_count;
+
+    // The blocks are returned to the thread that allocated them
+    std::thread([&]() {
+      for (auto blk : blocks)
+        alloc.dealloc(blk);
+    }).join();
+    REQUIRE(CountingMallocator::dealloc_count == 0);
+    for (size_t i = 0; i < 8; i++)
+    {
+      auto blk = alloc.alloc(48);
+      REQUIRE(std::find(blocks.begin(), blocks.end(), blk) != blocks.end());
+    }
+    REQUIRE(CountingMallocator::alloc_count == allocated);
+    for (auto blk : blocks)
+      alloc.dealloc(blk);
+
+    // The cache of a thread is released when it exits
+    std::thread([&]() { alloc.dealloc(alloc.alloc(64)); }).join();
+    REQUIRE(CountingMallocator::dealloc_count == 4);
+  }
+
+  SECTION("Stress")
+  {
+    // REQUIRE is not thread safe
+    std::atomic<bool> failed = false;
+    std::vector<std::thread> threads;
+    std::vector<mem::MemBlock> shared[4];
+    for (size_t t = 0; t < 4; t++)
+    {
+      threads.emplace_back(
+          [&, t]()
+          {
+            for (size_t i = 0; i < 1000; i++)
+            {
+              auto blk = alloc.alloc(16 + (i * 7 + t) % 300);
+              if (blk.is_null())
+              {
+                failed = true;
+                return;
+              }
+              std::memset(blk.ptr(), static_cast<int>(t), blk.size());
+              shared[t].push_back(blk);
+            }
+          });
+    }
+    for (auto& thread : threads)
+      thread.join();
+    threads.clear();
+    // Each thread frees the blocks of another thread
+    for (size_t t = 0; t < 4; t++)
+    {
+      threads.emplace_back(
+          [&, t]()
+          {
+            for (auto blk : shared[(t + 1) % 4])
+            {
+              if (*static_cast<u8*>(blk.ptr()) != (t + 1) % 4)
+                failed = true;
+              alloc.dealloc(blk);
+            }
+          });
+    }
+    for (auto& thread : threads)
+      thread.join();
+    REQUIRE(!failed);
+  }
+}
+
+/// @brief Sums the integers [0, count) pushed in a vector
+/// @tparam Alloc The allocator of the vector
+/// @param alloc The allocator
+/// @param count The number of integers
+/// @return The sum of the integers
+template<typename Alloc>
+static clt::u64 push_and_sum(const Alloc& alloc, clt::u64 count)
+{
+  clt::BasicVector<clt::u64, Alloc> vec = alloc;
+  for (clt::u64 i = 0; i < count; i++)
+    vec.push_back(i);
+  clt::u64 sum = 0;
+  for (auto i : vec)
+    sum += i;
+  return sum;
+}
+
+TEST_CASE("AnyAllocatorRef")
+{
+  using namespace clt;
+
+  SECTION("Global")
+  {
+    mem::AnyAllocatorRef ref;
+    REQUIRE(ref == mem::AnyAllocatorRef{mem::GlobalAllocator});
+    REQUIRE(!ref.can_own());
+    auto blk = ref.alloc(100);
+    REQUIRE(!blk.is_null());
+    REQUIRE(ref.realloc(blk, 1000));
+    REQUIRE(blk.size() >= 1000);
+    ref.dealloc(blk);
+    REQUIRE(push_and_sum(ref, 1000) == 999 * 500);
+  }
+
+  SECTION("Local")
+  {
+    mem::ArenaAllocator<mem::Mallocator> arena;
+    mem::StatsAllocator<mem::Mallocator> stats;
+    mem::AnyAllocatorRef a = arena;
+    mem::AnyAllocatorRef b = stats;
+    REQUIRE(a != b);
+    REQUIRE(a.can_own());
+    REQUIRE(!b.can_own());
+
+    auto blk = a.alloc(32);
+    REQUIRE(a.owns(blk));
+    // The arena can expand its last allocation
+    REQUIRE(a.expand(blk, 64));
+    REQUIRE(blk.size() == 64);
+    a.dealloc(blk);
+
+    // Vectors using different allocators have the same type
+    BasicVector<u64, mem::AnyAllocatorRef> vecs[2] = {a, b};
+    for (auto& vec : vecs)
+      for (u64 i = 0; i < 100; i++)
+        vec.push_back(i);
+    REQUIRE(vecs[0].back() == vecs[1].back());
+    REQUIRE(stats.stats().alloc_count == 1);
+  }
+}
+
+TEST_CASE("AnyAllocatorRef Benchmark", "[.][benchmark]")
+{
+  using namespace clt;
+  mem::StatsAllocator<mem::Mallocator, mem::StatsFlag::NONE> alloc;
+  mem::AnyAllocatorRef any        = alloc;
+  mem::AnyAllocatorRef any_global = mem::GlobalAllocator;
+
+  BENCHMARK("GlobalAllocatorRef")
+  {
+    return push_and_sum(mem::GlobalAllocator, 1000);
+  };
+  BENCHMARK("AnyAllocatorRef (global)")
+  {
+    return push_and_sum(any_global, 1000);
+  };
+  BENCHMARK("LocalAllocatorRef")
+  {
+    return push_and_sum(mem::LocalAllocatorRef{alloc}, 1000);
+  };
+  BENCHMARK("AnyAllocatorRef (local)")
+  {
+    return push_and_sum(any, 1000);
+  };
+}
+
+TEST_CASE("GuardPageAllocator")
+{
+  using namespace clt;
+  const size_t page = VirtualPage::page_size().size;
+
+  SECTION("Overflow")
+  {
+    mem::GuardPageAllocator<> alloc;
+    auto blk = alloc.alloc(100);
+    REQUIRE(!blk.is_null());
+    std::memset(blk.ptr(), 0xCC, blk.size());
+    // The end of the block is against the guard page
+    auto end = reinterpret_cast<uintptr_t>(blk.ptr()) + 112;
+    REQUIRE(end % page == 0);
+#ifdef COLT_LINUX
+    volatile u8* ptr = static_cast<u8*>(blk.ptr());
+    REQUIRE(!faults([&]() { ptr[111] = 1; }));
+    REQUIRE(faults([&]() { ptr[112] = 1; }));
+#endif // COLT_LINUX
+    alloc.dealloc(blk);
+    REQUIRE(alloc.quarantined_bytes() == 0);
+  }
+
+  SECTION("Underflow")
+  {
+    mem::GuardPageAllocator<0, true> alloc;
+    auto blk = alloc.alloc(3 * page);
+    REQUIRE(!blk.is_null());
+    REQUIRE(reinterpret_cast<uintptr_t>(blk.ptr()) % page == 0);
+    std::memset(blk.ptr(), 0xCC, blk.size());
+#ifdef COLT_LINUX
+    volatile u8* ptr = static_cast<u8*>(blk.ptr());
+    REQUIRE(faults([&]() { ptr[-1] = 1; }));
+#endif // COLT_LINUX
+    alloc.dealloc(blk);
+  }
+
+  SECTION("Quarantine")
+  {
+    constexpr u64 BUDGET = 64 * 1024;
+    mem::GuardPageAllocator<BUDGET> alloc;
+    auto blk = alloc.alloc(16);
+    alloc.dealloc(blk);
+    REQUIRE(alloc.quarantined_bytes() == 2 * page);
+#ifdef COLT_LINUX
+    REQUIRE(faults([&]() { *static_cast<volatile u8*>(blk.ptr()) = 1; }));
+#endif // COLT_LINUX
+    // The quarantine never exceeds its budget
+    for (size_t i = 0; i < 100; i++)
+    {
+      auto tmp = alloc.alloc(i * 100 + 1);
+      REQUIRE(!tmp.is_null());
+      alloc.dealloc(tmp);
+      REQUIRE(alloc.quarantined_bytes() <= BUDGET);
+    }
+    // Blocks bigger than the budget are unmapped directly
+    auto big = alloc.alloc(BUDGET);
+    const size_t before = alloc.quarantined_bytes();
+    alloc.dealloc(big);
+    REQUIRE(alloc.quarantined_bytes() == before);
+    alloc.flush_quarantine();
+    REQUIRE(alloc.quarantined_bytes() == 0);
+  }
+}
+
+/// @brief Writes a function returning 'value' to 'code'
+/// @return False if the architecture is not supported
+static bool emit_return(clt::mem::MemBlock code, clt::u8 value)
+{
+#if defined(__x86_64__) || defined(_M_X64)
+  // mov eax, value; ret
+  const clt::u8 bytes[] = {0xB8, value, 0, 0, 0, 0xC3};
+#elif defined(__aarch64__) || defined(_M_ARM64)
+  // mov w0, value; ret
+  const clt::u32 words[] = {0x52800000U | (clt::u32{value} << 5), 0xD65F03C0U};
+  clt::u8 bytes[sizeof words];
+  std::memcpy(bytes, words, sizeof words);
+#else
+  return false;
+#endif
+  if (code.size() < sizeof bytes)
+    return false;
+  std::memcpy(code.ptr(), bytes, sizeof bytes);
+  return true;
+}
+
+template<typename Arena>
+static void check_executable_arena(Arena& arena)
+{
+  using namespace clt;
+  using fn_t = int (*)();
+  static_assert(meta::OwningAllocator<Arena>);
+
+  typename Arena::CodeBlock functions[32];
+  for (u8 i = 0; i < 32; i++)
+  {
+    functions[i] = arena.alloc_code(i == 31 ? 64 * 1024 : 6);
+    REQUIRE(!functions[i].writable.is_null());
+    auto writable = functions[i].writable.ptr();
+    REQUIRE(arena.executable_of(writable) == functions[i].executable);
+    REQUIRE(reinterpret_cast<uintptr_t>(writable) % Arena::alignment == 0);
+    REQUIRE(arena.owns(functions[i].writable));
+    if (!emit_return(functions[i].writable, i))
+      return;
+  }
+  REQUIRE(arena.finalize());
+  // All the regions were sealed in a single protection change each
+  if (arena.code_mapping() == Arena::Toggle)
+    REQUIRE(arena.protection_changes() == 2);
+  else
+    REQUIRE(arena.protection_changes() == 0);
+  for (u8 i = 0; i < 32; i++)
+    REQUIRE(reinterpret_cast<fn_t>(functions[i].executable)() == i);
+
+  // Code allocated after 'finalize' can still be written
+  auto last = arena.alloc_code(6);
+  REQUIRE(emit_return(last.writable, 100));
+  REQUIRE(arena.finalize());
+  REQUIRE(reinterpret_cast<fn_t>(last.executable)() == 100);
+  REQUIRE(reinterpret_cast<fn_t>(functions[0].executable)() == 0);
+#ifdef COLT_LINUX
+  // W^X: finalized code can't be written through its executable address
+  auto exec = const_cast<void*>(functions[0].executable);
+  REQUIRE(faults([&]() { *static_cast<volatile u8*>(exec) = 1; }));
+  // The header of the region is not mapped in the executable view
+  if (arena.code_mapping() == Arena::DualMapped)
+  {
+    auto header = static_cast<const volatile u8*>(functions[0].executable)
+                  - VirtualPage::page_size().size;
+    REQUIRE(faults([&]() { (void)*header; }));
+  }
+#endif // COLT_LINUX
+
+  arena.reset();
+  REQUIRE(!arena.owns(last.writable));
+}
+
+TEST_CASE("ExecutableArena")
+{
+  using namespace clt;
+  using Arena = mem::ExecutableArena<64 * 1024>;
+
+  SECTION("Toggle")
+  {
+    Arena arena{Arena::Toggle};
+    check_executable_arena(arena);
+  }
+
+  SECTION("Dual Mapped")
+  {
+    Arena arena;
+    check_executable_arena(arena);
+#ifdef COLT_LINUX
+    REQUIRE(arena.code_mapping() == Arena::DualMapped);
+#endif // COLT_LINUX
+  }
+}
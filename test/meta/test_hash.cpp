@@ -0,0 +1,249 @@
+/*****************************************************************/ /**
+ * @file   test_hash.cpp
+ * @brief  Unit tests for the hashing algorithms.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/hash.h>
+#include <colt/dsa/string_view.h>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+TEST_CASE("wyhash")
+{
+  using namespace clt;
+
+  // Covers the short paths, the 48 bytes loop and the bulk path
+  std::vector<u8> data(3 * wyhash_h::BULK_SIZE + 100);
+  for (size_t i = 0; i < data.size(); i++)
+    data[i] = static_cast<u8>(i * 131 + 7);
+  auto hash = [](const u8* ptr, size_t len, u64 seed = 0)
+  {
+    wyhash_h h{seed};
+    h(ptr, len);
+    return static_cast<size_t>(h);
+  };
+
+  SECTION("Deterministic")
+  {
+    for (size_t len = 0; len < data.size(); len += 7)
+    {
+      REQUIRE(hash(data.data(), len) == hash(data.data(), len));
+      REQUIRE(hash(data.data(), len) != hash(data.data(), len, 1));
+    }
+    // Unaligned keys
+    std::vector<u8> copy(data.size() + 1);
+    std::memcpy(copy.data() + 1, data.data(), data.size());
+    REQUIRE(hash(data.data(), data.size()) == hash(copy.data() + 1, data.size()));
+  }
+
+  SECTION("Known Answers")
+  {
+    // Test vectors of wyhash final 4 (the seed is the index)
+    const std::pair<std::string_view, u64> vectors[] = {
+        {"", 0x0409638ee2bde459},
+        {"a", 0xa8412d091b5fe0a9},
+        {"abc", 0x32dd92e4b2915153},
+        {"message digest", 0x8619124089a3a16b},
+        {"abcdefghijklmnopqrstuvwxyz", 0x7a43afb61d7f5f40},
+        {"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+         0xff42329b90e50d58},
+        {"123456789012345678901234567890123456789012345678901234567890123456789"
+         "01234567890",
+         0xc39cab13b115aad3},
+    };
+    for (u64 i = 0; const auto& [key, expected] : vectors)
+    {
+      wyhash_h h{i++};
+      h(key.data(), key.size());
+      REQUIRE(static_cast<u64>(h) == expected);
+    }
+  }
+
+  SECTION("Bulk Kernels")
+  {
+    const auto kernels = details::wyhash_bulk_kernels();
+    REQUIRE(!kernels.empty());
+    // Lengths around the blocks of 1024 bytes, or not multiples of 64
+    std::vector<size_t> lengths = {1024, 1025, 1088, 2047, 2048, 2049, 3072};
+    for (size_t len = wyhash_h::BULK_SIZE; len <= data.size(); len += 29)
+      lengths.push_back(len);
+    // Unaligned keys
+    std::vector<u8> copy(data.size() + 64);
+    for (size_t offset : {0, 1, 3, 8, 17, 63})
+    {
+      std::memcpy(copy.data() + offset, data.data(), data.size());
+      for (size_t len : lengths)
+      {
+        const u8* key = copy.data() + offset;
+        for (u64 seed : {0ULL, 0x9E3779B97F4A7C15ULL})
+        {
+          const u64 expected = kernels[0](key, len, seed);
+          for (auto kernel : kernels.subspan(1))
+            REQUIRE(kernel(key, len, seed) == expected);
+          REQUIRE(hash(key, len, seed) == expected);
+        }
+      }
+    }
+  }
+
+  SECTION("Every Byte Matters")
+  {
+    for (size_t len : {1, 3, 4, 8, 16, 17, 48, 49, 100, 1023, 1024, 1025, 3000})
+    {
+      const size_t expected = hash(data.data(), len);
+      for (size_t i = 0; i < len; i++)
+      {
+        data[i] ^= 1;
+        REQUIRE(hash(data.data(), len) != expected);
+        data[i] ^= 1;
+      }
+    }
+  }
+
+  SECTION("Lengths")
+  {
+    std::unordered_set<size_t> hashes;
+    for (size_t len = 0; len < data.size(); len++)
+      hashes.insert(hash(data.data(), len));
+    REQUIRE(hashes.size() == data.size());
+  }
+
+  SECTION("Streaming")
+  {
+    // Each call is seeded by the previous one
+    wyhash_h h;
+    h(data.data(), 10);
+    h(data.data() + 10, 10);
+    REQUIRE(static_cast<size_t>(h) != hash(data.data(), 20));
+
+    std::unordered_set<size_t> hashes;
+    for (u64 i = 0; i < 10'000; i++)
+      hashes.insert(uhash<wyhash_h>{}(i));
+    REQUIRE(hashes.size() == 10'000);
+    STATIC_REQUIRE(std::same_as<default_hash, uhash<COLT_DEFAULT_HASH_ALGORITHM>>);
+    REQUIRE(default_hash{}(data.data(), 5) == hash(data.data(), 5));
+  }
+}
+
+/// @brief Hashes a value using 'Algo' (usable at compile-time)
+template<typename Algo, typename T>
+constexpr size_t hash_value(const T& value)
+{
+  Algo h;
+  hash_append(h, value);
+  return static_cast<size_t>(h);
+}
+
+TEMPLATE_TEST_CASE(
+    "constexpr hashing", "", clt::fnv1a_h, clt::murmur64a_h, clt::siphash24_h,
+    clt::wyhash_h)
+{
+  using namespace clt;
+
+  SECTION("Views")
+  {
+    constexpr size_t HELLO = hash_value<TestType>(StringView{"Hello World!"});
+    constexpr size_t HELLO_UTF8 = hash_value<TestType>("Hello World!"_UTF8);
+    constexpr size_t HELLO_UTF32 = hash_value<TestType>("Hello World!"_UTF32);
+
+    const StringView view = {"Hello World!"};
+    REQUIRE(HELLO == hash_value<TestType>(view));
+    REQUIRE(HELLO == uhash<TestType>{}(view.data(), view.unit_len()));
+    // Same units, same hash
+    REQUIRE(HELLO == HELLO_UTF8);
+    REQUIRE(HELLO_UTF8 == hash_value<TestType>("Hello World!"_UTF8.to_zview()));
+    REQUIRE(
+        HELLO_UTF32 == hash_value<TestType>(u32StringView{"Hello World!"_UTF32}));
+    REQUIRE(HELLO != HELLO_UTF32);
+  }
+
+  SECTION("Integers")
+  {
+    constexpr size_t VALUE = hash_value<TestType>(u64{0x0123456789ABCDEF});
+    constexpr size_t VALUES =
+        uhash<TestType>{}(std::array<u32, 3>{1, 2, 3}.data(), 3);
+    REQUIRE(VALUE == hash_value<TestType>(u64{0x0123456789ABCDEF}));
+    const std::array<u32, 3> values = {1, 2, 3};
+    REQUIRE(VALUES == uhash<TestType>{}(values.data(), values.size()));
+    STATIC_REQUIRE(hash_value<TestType>(0.0) == hash_value<TestType>(-0.0));
+  }
+
+  SECTION("Alignment")
+  {
+    // The result does not depend on the alignment of the key
+    std::array<u8, 80> data{};
+    for (size_t i = 0; i < data.size(); i++)
+      data[i] = static_cast<u8>(i * 37 + 1);
+    for (size_t len : {0, 1, 7, 8, 9, 15, 16, 31, 63})
+    {
+      TestType expected;
+      expected(data.data(), len);
+      for (size_t offset = 1; offset < 9; offset++)
+      {
+        std::array<u8, 80> copy{};
+        std::memcpy(copy.data() + offset, data.data(), len);
+        TestType h;
+        h(copy.data() + offset, len);
+        REQUIRE(static_cast<size_t>(h) == static_cast<size_t>(expected));
+      }
+      // Exactly sized allocations: the tail must not be read past 'len'
+      for (size_t offset = 0; offset < 8; offset++)
+      {
+        auto exact = std::make_unique<u8[]>(offset + len);
+        std::memcpy(exact.get() + offset, data.data(), len);
+        TestType h;
+        h(exact.get() + offset, len);
+        REQUIRE(static_cast<size_t>(h) == static_cast<size_t>(expected));
+      }
+    }
+  }
+
+  SECTION("Streaming")
+  {
+    // Hashing two fields is not the same as hashing the last one
+    TestType h;
+    hash_append(h, u32{1});
+    hash_append(h, u32{2});
+    REQUIRE(static_cast<size_t>(h) != hash_value<TestType>(u32{2}));
+  }
+}
+
+TEST_CASE("Hash Benchmark", "[.][benchmark]")
+{
+  using namespace clt;
+
+  std::vector<u8> data(1024 * 1024);
+  for (size_t i = 0; i < data.size(); i++)
+    data[i] = static_cast<u8>(i * 131 + 7);
+
+  BENCHMARK("murmur64a 1MiB")
+  {
+    murmur64a_h h;
+    h(data.data(), data.size());
+    return static_cast<size_t>(h);
+  };
+  BENCHMARK("wyhash 1MiB")
+  {
+    wyhash_h h;
+    h(data.data(), data.size());
+    return static_cast<size_t>(h);
+  };
+  BENCHMARK("murmur64a u64")
+  {
+    size_t ret = 0;
+    for (u64 i = 0; i < 1000; i++)
+      ret ^= uhash<murmur64a_h>{}(i);
+    return ret;
+  };
+  BENCHMARK("wyhash u64")
+  {
+    size_t ret = 0;
+    for (u64 i = 0; i < 1000; i++)
+      ret ^= uhash<wyhash_h>{}(i);
+    return ret;
+  };
+}
@@ -7,6 +7,14 @@
  *********************************************************************/
 #include "../includes.h"
 #include <colt/meta/map.h>
+#include <string_view>
+
+enum class MapColor
+{
+  Red,
+  Green,
+  Blue
+};
 
 TEST_CASE("MetaMap")
 {
@@ -46,4 +54,67 @@ TEST_CASE("MetaMap")
     REQUIRE((_k10.is_value() && *_k10 == 2));
     REQUIRE(_kNone.is_none());
   }
-}
\ No newline at end of file
+  SECTION("Perfect Hash")
+  {
+    using namespace std::string_view_literals;
+    using pair = std::pair<std::string_view, int>;
+    static constexpr auto keywords = clt::meta::Map{std::array{
+        pair{"if"sv, 0}, pair{"else"sv, 1}, pair{"while"sv, 2}, pair{"for"sv, 3},
+        pair{"return"sv, 4}, pair{"break"sv, 5}, pair{"continue"sv, 6},
+        pair{"switch"sv, 7}, pair{"case"sv, 8}, pair{"default"sv, 9}}};
+    STATIC_REQUIRE(keywords.hash.is_valid);
+    REQUIRE(*keywords.find("while"sv) == 2);
+    for (const auto& [key, value] : keywords.data)
+      REQUIRE(*keywords.find(key) == value);
+    REQUIRE(keywords.find("whilst"sv).is_none());
+    REQUIRE(keywords.find(""sv).is_none());
+
+    using cpair = std::pair<MapColor, char>;
+    static constexpr auto colors = clt::meta::BiMap{std::array{
+        cpair{MapColor::Red, 'r'}, cpair{MapColor::Green, 'g'},
+        cpair{MapColor::Blue, 'b'}}};
+    STATIC_REQUIRE(colors.hash_f.is_valid);
+    STATIC_REQUIRE(colors.hash_b.is_valid);
+    REQUIRE(*colors.find_value(MapColor::Green) == 'g');
+    REQUIRE(*colors.find_key('b') == MapColor::Blue);
+    REQUIRE(colors.find_key('x').is_none());
+  }
+  SECTION("Seeds")
+  {
+    using Index = clt::meta::details::PerfectHashIndex<64>;
+    clt::u64 state = 0;
+    for (size_t set = 0; set < 500; set++)
+    {
+      std::array<clt::u64, 64> hashes{};
+      for (auto& hash : hashes)
+        hash = clt::meta::details::perfect_mix(++state);
+      const Index index{hashes};
+      REQUIRE(index.is_valid);
+      for (size_t i = 0; i < hashes.size(); i++)
+        REQUIRE(index.find(hashes[i]) == i);
+    }
+
+    // Equal hashes can never be placed, whatever the seed
+    std::array<clt::u64, 64> hashes{};
+    for (size_t i = 0; i < hashes.size(); i++)
+      hashes[i] = i;
+    hashes[63] = hashes[0];
+    REQUIRE(!Index{hashes}.is_valid);
+  }
+  SECTION("Binary Search Fallback")
+  {
+    using pair = std::pair<int, int>;
+    constexpr size_t COUNT = clt::meta::PERFECT_HASH_MAX_SIZE + 1;
+    static constexpr auto map = []()
+    {
+      std::array<pair, COUNT> array{};
+      for (size_t i = 0; i < COUNT; i++)
+        array[i] = pair{static_cast<int>(i * 3), static_cast<int>(i)};
+      return clt::meta::Map{array};
+    }();
+    STATIC_REQUIRE(!map.hash.is_valid);
+    for (size_t i = 0; i < COUNT; i++)
+      REQUIRE(*map.find(static_cast<int>(i * 3)) == static_cast<int>(i));
+    REQUIRE(map.find(1).is_none());
+  }
+}
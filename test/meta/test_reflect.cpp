@@ -20,6 +20,39 @@ struct AB
 
 COLT_DECLARE_TYPE(AB, _ab, _abc);
 
+struct Padded
+{
+  clt::u8 a;
+  clt::u32 b;
+  float c;
+};
+
+COLT_DECLARE_TYPE(Padded, a, b, c);
+
+struct Partial
+{
+  clt::u32 a;
+  clt::u32 not_registered;
+};
+
+COLT_DECLARE_TYPE(Partial, a);
+
+enum class Kind : clt::u16
+{
+  A,
+  B
+};
+
+struct Key
+{
+  clt::u32 id;
+  Kind kind;
+  clt::u16 path[5];
+  AB ab;
+};
+
+COLT_DECLARE_TYPE(Key, id, kind, path, ab);
+
 TEST_CASE("reflect")
 {
   using namespace clt;
@@ -58,3 +91,39 @@ TEST_CASE("reflect")
     REQUIRE(clt::uhash<clt::fnv1a_h>{}(value) != 0);
   }
 }
+
+TEST_CASE("reflect hash")
+{
+  using namespace clt;
+  using namespace clt::meta;
+
+  SECTION("Contiguous Detection")
+  {
+    STATIC_REQUIRE(is_contiguously_hashable_v<Key>);
+    // Padding, floating points and unregistered members
+    STATIC_REQUIRE(!is_contiguously_hashable_v<Padded>);
+    STATIC_REQUIRE(!is_contiguously_hashable_v<Partial>);
+    STATIC_REQUIRE(hashable<Padded>);
+    STATIC_REQUIRE(hashable<Partial>);
+  }
+
+  SECTION("Contiguous Hashing")
+  {
+    const Key key = {1, Kind::B, {1, 2, 3, 4, 5}, {6, 7}};
+    // Hashed with a single call over the bytes of the object
+    fnv1a_h h;
+    h(&key, sizeof(key));
+    REQUIRE(uhash<fnv1a_h>{}(key) == static_cast<size_t>(h));
+  }
+
+  SECTION("Member-wise Hashing")
+  {
+    // Only registered members are hashed
+    REQUIRE(uhash<fnv1a_h>{}(Partial{1, 2}) == uhash<fnv1a_h>{}(Partial{1, 3}));
+    REQUIRE(uhash<fnv1a_h>{}(Partial{1, 2}) == uhash<fnv1a_h>{}(u32{1}));
+    // 0.0 and -0.0 give the same hash
+    REQUIRE(
+        uhash<fnv1a_h>{}(Padded{1, 2, 0.0f})
+        == uhash<fnv1a_h>{}(Padded{1, 2, -0.0f}));
+  }
+}
@@ -0,0 +1,71 @@
+/*****************************************************************/ /**
+ * @file   test_string_switch.cpp
+ * @brief  Unit tests for `string_switch`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/meta/string_switch.h>
+#include <colt/dsa/string_view.h>
+#include <string>
+#include <string_view>
+
+TEST_CASE("string_switch")
+{
+  using namespace clt;
+
+  SECTION("Match")
+  {
+    using Switch = meta::string_switch<"add", "sub", "mul", "div", "", "addition">;
+    STATIC_REQUIRE(Switch::size == 6);
+    STATIC_REQUIRE(Switch::index_of<"add"> == 0);
+    STATIC_REQUIRE(Switch::index_of<"addition"> == 5);
+    STATIC_REQUIRE(Switch::match(std::string_view{"mul"}) == 2);
+    STATIC_REQUIRE(Switch::match(StringView{"div"}) == 3);
+    STATIC_REQUIRE(Switch::match(std::string_view{"ad"}) == Switch::npos);
+
+    for (size_t i = 0; i < Switch::size; i++)
+    {
+      // Runtime strings that do not alias the keys
+      const std::string key{Switch::keys[i]};
+      REQUIRE(Switch::match(key) == i);
+      REQUIRE(Switch::match(StringView{key.data(), key.size()}) == i);
+      REQUIRE(Switch::match(key + "x") == Switch::npos);
+    }
+    REQUIRE(Switch::match(std::string_view{"iv"}) == Switch::npos);
+    REQUIRE(Switch::match(u8StringView{"sub"_UTF8}) == 1);
+    REQUIRE(Switch::match(std::string(1024, 'a')) == Switch::npos);
+  }
+
+  SECTION("Switch")
+  {
+    using Command = meta::string_switch<"--", "-help">;
+    auto run      = [](std::string_view arg)
+    {
+      switch (Command::match(arg))
+      {
+      case Command::index_of<"--">:
+        return 1;
+      case Command::index_of<"-help">:
+        return 2;
+      default:
+        return 0;
+      }
+    };
+    REQUIRE(run("--") == 1);
+    REQUIRE(run("-help") == 2);
+    REQUIRE(run("-hel") == 0);
+    REQUIRE(run("") == 0);
+  }
+
+  SECTION("Algorithms")
+  {
+    using Fnv1a = meta::basic_string_switch<fnv1a_h, "a", "b", "c">;
+    using Murmur = meta::basic_string_switch<murmur64a_h, "a", "b", "c">;
+    STATIC_REQUIRE(Fnv1a::match(std::string_view{"c"}) == 2);
+    STATIC_REQUIRE(Murmur::match(std::string_view{"b"}) == 1);
+    REQUIRE(Fnv1a::match(std::string{"a"}) == 0);
+    REQUIRE(Murmur::match(std::string{"d"}) == Murmur::npos);
+  }
+}
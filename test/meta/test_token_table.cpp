@@ -0,0 +1,88 @@
+/*****************************************************************/ /**
+ * @file   test_token_table.cpp
+ * @brief  Unit tests for `token_table` and `TrieMap::longest_match`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/meta/token_table.h>
+#include <colt/dsa/trie.h>
+#include <random>
+#include <string>
+#include <string_view>
+
+TEST_CASE("token_table")
+{
+  using namespace clt;
+  using meta::TokenMatch;
+
+  using Operators = meta::token_table<
+      "+", "++", "+=", "-", "--", "-=", "->", "<", "<<", "<=", "<<=", "...",
+      ".", "=", "==", "!", "!=", "and", "andalso">;
+
+  STATIC_REQUIRE(sizeof(Option<TokenMatch>) == sizeof(TokenMatch));
+
+  SECTION("Longest match")
+  {
+    STATIC_REQUIRE(
+        Operators::longest_match(std::string_view{"<<=1"})
+        == TokenMatch{Operators::index_of<"<<=">, 3});
+    STATIC_REQUIRE(
+        Operators::longest_match(StringView{"->x"})
+        == TokenMatch{Operators::index_of<"->">, 2});
+    STATIC_REQUIRE(Operators::longest_match(std::string_view{"x+"}).is_none());
+    STATIC_REQUIRE(Operators::longest_match(std::string_view{""}).is_none());
+
+    auto match = [](std::string_view str) -> Option<TokenMatch>
+    {
+      // Runtime strings that do not alias the tokens
+      const std::string copy{str};
+      return Operators::longest_match(copy);
+    };
+    // The last accepting state is kept when the DFA dies
+    REQUIRE((match("..") == TokenMatch{Operators::index_of<".">, 1}));
+    REQUIRE((match("....") == TokenMatch{Operators::index_of<"...">, 3}));
+    REQUIRE((match("<<-") == TokenMatch{Operators::index_of<"<<">, 2}));
+    REQUIRE((match("andals") == TokenMatch{Operators::index_of<"and">, 3}));
+    REQUIRE((match("andalso") == TokenMatch{Operators::index_of<"andalso">, 7}));
+    REQUIRE(match("an").is_none());
+    REQUIRE((match("!==") == TokenMatch{Operators::index_of<"!=">, 2}));
+    REQUIRE(
+        (Operators::longest_match(u8StringView{"++"_UTF8})
+         == TokenMatch{Operators::index_of<"++">, 2}));
+    for (size_t i = 0; i < Operators::size; i++)
+    {
+      const auto token = Operators::keys[i];
+      REQUIRE((match(token) == TokenMatch{i, token.size()}));
+    }
+  }
+
+  SECTION("TrieMap")
+  {
+    TrieMap<char, size_t> trie;
+    for (size_t i = 0; i < Operators::size; i++)
+      trie.insert_ks(Operators::keys[i].data(), Operators::keys[i].size(), i);
+
+    // Both recognizers agree on random strings over the tokens' bytes
+    constexpr std::string_view ALPHABET = "+-<=.!andlsox";
+    std::mt19937_64 rng{42};
+    std::string str;
+    for (size_t i = 0; i < 10'000; i++)
+    {
+      str.resize(rng() % 8);
+      for (auto& c : str)
+        c = ALPHABET[rng() % ALPHABET.size()];
+      const auto expected = trie.longest_match(str.data(), str.size());
+      const auto match    = Operators::longest_match(str);
+      REQUIRE(expected.is_value() == match.is_value());
+      if (match.is_value())
+      {
+        REQUIRE(expected->first.value() == match->id);
+        REQUIRE(expected->second == match->len);
+      }
+    }
+    REQUIRE(trie.longest_match(StringView{"+=1"}).value().second == 2);
+    REQUIRE(trie.longest_match(StringView{"1"}).is_none());
+  }
+}
@@ -173,4 +173,250 @@ TEST_CASE("BigInt")
       REQUIRE((a % b) == BigInt{0});
     }
   }
-}
\ No newline at end of file
+  SECTION("Inline")
+  {
+    constexpr i64 max = std::numeric_limits<i64>::max();
+    constexpr i64 min = std::numeric_limits<i64>::min();
+
+    auto a = BigInt{max};
+    REQUIRE(a.is_inline());
+    a += 1U;
+    REQUIRE(!a.is_inline());
+    REQUIRE(a == *BigInt::from("9223372036854775808"));
+    a -= 1U;
+    REQUIRE(a == BigInt{max});
+    REQUIRE(*a.to_i64() == max);
+
+    auto b = BigInt{min};
+    REQUIRE(b.sgn() == -1);
+    REQUIRE((-b) == *BigInt::from("9223372036854775808"));
+    REQUIRE((b / BigInt{-1}) == *BigInt::from("9223372036854775808"));
+    REQUIRE((b % BigInt{-1}) == 0);
+    REQUIRE((b * 2) == *BigInt::from("-18446744073709551616"));
+    REQUIRE(b.is_inline());
+
+    auto c = BigInt{u64{18446744073709551615ULL}};
+    REQUIRE(!c.is_inline());
+    REQUIRE(c > BigInt{max});
+    REQUIRE(BigInt{max} < c);
+    REQUIRE(c.to_i64().is_none());
+    // Promoted values against 64-bit integers (and BigInt holding them)
+    REQUIRE(c > max);
+    REQUIRE(c > min);
+    REQUIRE(-c < min);
+    REQUIRE(c != max);
+    REQUIRE((c <=> BigInt{min}) == std::strong_ordering::greater);
+    REQUIRE((BigInt{min} <=> -c) == std::strong_ordering::greater);
+
+    // Parsing small literals does not allocate
+    auto d = *BigInt::from("-123456789");
+    REQUIRE(d.is_inline());
+    REQUIRE(d == -123456789);
+    REQUIRE((d % 10U) == 1);
+    REQUIRE((d % BigInt{-10}) == 1);
+    REQUIRE((d / 10U) == -12345678);
+    REQUIRE((d & BigInt{0xFF}) == (-123456789 & 0xFF));
+    REQUIRE(d.str_size() == 10);
+    REQUIRE(fmt::format("{}", d) == "-123456789");
+    REQUIRE(fmt::format("{}", c) == "18446744073709551615");
+
+    auto e = BigInt{2.5};
+    REQUIRE(e == 2);
+    REQUIRE(e < 2.5);
+    REQUIRE(e > 1.5);
+    REQUIRE(e == 2.0);
+    REQUIRE(e < 1e30);
+    REQUIRE(BigInt{1e30} > BigInt{max});
+
+    // Overflow promotes and the operation is exact
+    auto f = BigInt{max};
+    f *= BigInt{max};
+    REQUIRE(f == *BigInt::from("85070591730234615847396907784232501249"));
+    f = 3U;
+    REQUIRE(f.is_inline());
+    REQUIRE(f-- == 3);
+    REQUIRE(f == 2);
+  }
+
+  SECTION("Fused")
+  {
+    constexpr i64 max = std::numeric_limits<i64>::max();
+    const BigInt big  = *BigInt::from("123456789012345678901234567890");
+    const BigInt two  = BigInt{2U};
+
+    // Products of lvalues are lazy
+    static_assert(std::same_as<decltype(big * two), MulExpr<BigInt>>);
+    static_assert(std::same_as<decltype(big * two + big), MulAddExpr<BigInt>>);
+    static_assert(std::same_as<decltype(big * BigInt{2}), BigInt>);
+
+    BigInt a = big * two + BigInt{1};
+    REQUIRE(a == *BigInt::from("246913578024691357802469135781"));
+    a = BigInt{1} - big * two;
+    REQUIRE(a == *BigInt::from("-246913578024691357802469135779"));
+    a = big * two - big;
+    REQUIRE(a == big);
+    a -= big * two;
+    REQUIRE(a == -big);
+    a += big * two;
+    REQUIRE(a == big);
+    a = -(big * two - big);
+    REQUIRE(a == -big);
+
+    // Inline values stay inline
+    BigInt b = BigInt{3} * BigInt{4} + BigInt{5};
+    REQUIRE(b.is_inline());
+    REQUIRE(b == 17);
+    b = BigInt{max} * two + BigInt{2};
+    REQUIRE(b == *BigInt::from("18446744073709551616"));
+    const BigInt three = BigInt{3};
+    b                  = three * three - three;
+    REQUIRE(b.is_inline());
+    REQUIRE(b == 6);
+
+    // The destination may alias the operands
+    BigInt x = BigInt{3U};
+    x        = x * big + x;
+    REQUIRE(x == *BigInt::from("370370367037037036703703703673"));
+    x = 3U;
+    x += x * x;
+    REQUIRE(x == 12);
+    x = big;
+    x = two * x - x;
+    REQUIRE(x == big);
+    x = big * x;
+    REQUIRE(x == big * big);
+    REQUIRE((big * big - BigInt{1}) > big);
+    REQUIRE(fmt::format("{}", two * two) == "4");
+    REQUIRE(fmt::format("{}", two * two + two) == "6");
+
+    // Any operation mixes expressions and numbers
+    const BigInt c = BigInt{7};
+    REQUIRE(big * two + c * c == *BigInt::from("246913578024691357802469135829"));
+    REQUIRE(big * two - c * c == *BigInt::from("246913578024691357802469135731"));
+    REQUIRE(c * c + 1U == 50);
+    REQUIRE(c * c - 1U == 48);
+    REQUIRE((c * c) % 3U == 1);
+    REQUIRE((c * c) % c == 0);
+    REQUIRE((c * c) / c == c);
+    REQUIRE((c * c) << 2U == 196);
+    REQUIRE((c * c) >> 1U == 24);
+    REQUIRE(((c * c) & BigInt{15}) == 1);
+    REQUIRE(c * c * c == 343);
+    REQUIRE(c * (c * c) == 343);
+    REQUIRE((c * c) * (c * c) == 2401);
+    REQUIRE((c + c) * (c * c) == 686);
+    REQUIRE((c * c) * (c + c) == 686);
+    REQUIRE(c * c + (c + c) == 63);
+    REQUIRE((c + c) - c * c == -35);
+    REQUIRE(c * c - (c + c) == 35);
+    REQUIRE(c * c + c + 1U == 57);
+    REQUIRE(c * c + c + c * c == 105);
+    REQUIRE(c * c + (c * c + c) == 105);
+    REQUIRE((c * c + c) * (c * c - c) == 2352);
+    REQUIRE(c + c * c == 56);
+    REQUIRE(c % (c * c) == c);
+    REQUIRE((c * c) <=> c == std::strong_ordering::greater);
+    REQUIRE(c * c == c * c);
+    REQUIRE(c < c * c);
+
+    // Conversions evaluate the expression
+    BigInt product = c * two;
+    REQUIRE(product == 14);
+    auto expr = big * two;
+    REQUIRE(expr == big + big);
+    REQUIRE(expr.eval() == big + big);
+
+    // Shifts
+    auto s = BigInt{1};
+    s <<= 100U;
+    REQUIRE(s == *BigInt::from("1267650600228229401496703205376"));
+    REQUIRE((s >> 99U) == 2);
+    REQUIRE(s.is_inline() == false);
+    REQUIRE((BigInt{-5} >> 1U) == -3);
+    REQUIRE((BigInt{-5} >> 200U) == -1);
+    REQUIRE((BigInt{5} >> 200U) == 0);
+    REQUIRE((BigInt{0} << 200U) == 0);
+    REQUIRE((BigInt{-3} << 2U) == -12);
+  }
+}
+
+TEST_CASE("BigRational")
+{
+  using namespace clt;
+  using namespace clt::num;
+
+  SECTION("Arithmetic")
+  {
+    auto a = BigRational{1, 3};
+    auto b = BigRational{1, 6};
+    REQUIRE(a.is_inline());
+    REQUIRE((a + b) == BigRational{1, 2});
+    REQUIRE((a - b) == BigRational{1, 6});
+    REQUIRE((b - a) == BigRational{-1, 6});
+    REQUIRE((a * b) == BigRational{1, 18});
+    REQUIRE((a / b) == BigRational{2});
+    REQUIRE((a / -b) == BigRational{-2});
+    REQUIRE((a - a) == BigRational{});
+    REQUIRE(BigRational{2, 4} == BigRational{1, 2});
+    REQUIRE(BigRational{0.75} == BigRational{3, 4});
+    REQUIRE(BigRational{-2, 3} < BigRational{1, 3});
+    REQUIRE(*BigRational::from("10/4") == BigRational{5, 2});
+    REQUIRE(BigRational::from("1/0").is_none());
+    REQUIRE(fmt::format("{}", BigRational{-10, 4}) == "-5/2");
+    REQUIRE(fmt::format("{}", BigRational{8, 4}) == "2");
+  }
+
+  SECTION("Overflow")
+  {
+    auto a = BigRational{BigInt{std::numeric_limits<i64>::max()}};
+    REQUIRE(a.is_inline());
+    a += BigRational{1U};
+    REQUIRE(!a.is_inline());
+    REQUIRE(a == *BigRational::from("9223372036854775808"));
+    REQUIRE(BigRational{1, 2} < a);
+    REQUIRE(a > BigRational{1, 2});
+    a *= BigRational{1, 2};
+    REQUIRE(a == *BigRational::from("4611686018427387904"));
+    REQUIRE(fmt::format("{}", a) == "4611686018427387904");
+
+    auto b = *BigRational::from("1/9223372036854775807");
+    REQUIRE(b.is_inline());
+    b *= b;
+    REQUIRE(!b.is_inline());
+    REQUIRE(b == *BigRational::from("1/85070591730234615847396907784232501249"));
+    REQUIRE(b < BigRational{1, 2});
+  }
+
+  SECTION("Fused")
+  {
+    const auto a = BigRational{1, 3};
+    const auto b = BigRational{1, 6};
+    const auto c = *BigRational::from("1/9223372036854775807");
+    static_assert(std::same_as<decltype(a * b), MulExpr<BigRational>>);
+
+    BigRational x = a * b + a;
+    REQUIRE(x == BigRational{7, 18});
+    x = a - a * b;
+    REQUIRE(x == BigRational{5, 18});
+    x = a * b - a;
+    REQUIRE(x == BigRational{-5, 18});
+    x += a * b;
+    REQUIRE(x == BigRational{-2, 9});
+    x -= a * b;
+    REQUIRE(x == BigRational{-5, 18});
+    x = c * c + a;
+    REQUIRE(!x.is_inline());
+    REQUIRE(x - a == *BigRational::from("1/85070591730234615847396907784232501249"));
+    // The destination may alias the operands
+    const BigRational y = x;
+    x                   = x * c - x;
+    REQUIRE(x == y * (c - BigRational{1U}));
+    x = y;
+    x = c * x + x;
+    REQUIRE(x == y * (c + BigRational{1U}));
+    REQUIRE(a * b + b * a == BigRational{1, 9});
+    REQUIRE((a * b) / b == a);
+    REQUIRE(a * b * BigRational{18U} == BigRational{1U});
+    REQUIRE(fmt::format("{}", a * b) == "1/18");
+  }
+}
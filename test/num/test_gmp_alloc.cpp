@@ -0,0 +1,100 @@
+/*****************************************************************/ /**
+ * @file   test_gmp_alloc.cpp
+ * @brief  Unit tests for `set_gmp_allocator` and `ScopedGmpAllocator`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/num/big_int.h>
+#include <colt/num/gmp_alloc.h>
+#include <colt/mem/arena_alloc.h>
+
+/// @brief Returns the limbs of a BigInt
+static const void* limbs_of(const clt::num::BigInt& value)
+{
+  mpz_t storage;
+  value.internal_storage(storage);
+  return storage->_mp_d;
+}
+
+TEST_CASE("GMP Allocator")
+{
+  using namespace clt;
+  using namespace clt::num;
+
+  SECTION("Stats")
+  {
+    mem::StatsAllocator<mem::Mallocator> stats;
+    set_gmp_allocator(stats);
+    {
+      auto a = *BigInt::from("123456789012345678901234567890");
+      a *= a;
+      a *= a;
+      REQUIRE(a > BigInt{0});
+    }
+    reset_gmp_allocator();
+    auto result = stats.stats();
+    REQUIRE(result.alloc_count > 0);
+    REQUIRE(result.live_bytes == 0);
+  }
+
+  SECTION("Fused")
+  {
+    const auto a = *BigInt::from("123456789012345678901234567890");
+    const auto b = *BigInt::from("98765432109876543210987654321");
+    const auto c = *BigInt::from("-1234567890123456789");
+    BigInt x     = a * b + c;
+    mem::StatsAllocator<mem::Mallocator> stats;
+    set_gmp_allocator(stats);
+    // The expressions are evaluated in the storage of 'x'
+    for (int i = 0; i < 16; ++i)
+    {
+      x = a * b + c;
+      x = a * b - c;
+      x += a * b;
+      x -= a * b;
+    }
+    reset_gmp_allocator();
+    REQUIRE(x == a * b - c);
+    REQUIRE(stats.stats().alloc_count == 0);
+  }
+
+  SECTION("Scoped Arena")
+  {
+    auto before     = *BigInt::from("123456789012345678901234567890");
+    auto to_free    = Option<BigInt>{before};
+    BigInt expected = before * before * before;
+    mem::ArenaAllocator<mem::PageAllocator> arena;
+    {
+      ScopedGmpAllocator scope = {arena};
+      auto a = *BigInt::from("98765432109876543210987654321");
+      a *= a;
+      REQUIRE(arena.owns({const_cast<void*>(limbs_of(a)), 1}));
+      // Numbers created before the scope can be read and freed
+      BigInt c = before * before;
+      c *= before;
+      REQUIRE(c == expected);
+      to_free.reset();
+      {
+        mem::ArenaAllocator<mem::PageAllocator> nested;
+        ScopedGmpAllocator nested_scope = {nested};
+        auto b = a;
+        b *= a;
+        REQUIRE(nested.owns({const_cast<void*>(limbs_of(b)), 1}));
+        // 'c' is reallocated in its own arena
+        c.neg();
+        c *= 3U;
+        REQUIRE(arena.owns({const_cast<void*>(limbs_of(c)), 1}));
+      }
+      // Small values are stored inline
+      auto d = BigInt{10};
+      d *= 10U;
+      REQUIRE(d.is_inline());
+    }
+    arena.reset();
+    REQUIRE(!arena.owns({const_cast<void*>(limbs_of(before)), 1}));
+    before /= before;
+    REQUIRE(before == 1);
+  }
+}
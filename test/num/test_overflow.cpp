@@ -0,0 +1,196 @@
+/*****************************************************************/ /**
+ * @file   test_overflow.cpp
+ * @brief  Unit tests for `checked_*` and `saturating_*`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/num/overflow.h>
+#include <vector>
+
+/// @brief Values close to the limits of T
+template<typename T>
+static std::vector<T> edge_values()
+{
+  using namespace clt;
+  constexpr T MAX = details::max_int<T>;
+  constexpr T MIN = details::min_int<T>;
+  std::vector<T> ret = {
+      MIN,        T(MIN + 1), T(MIN + 2), T(MAX / 2), T(MAX / 2 + 1), T(MAX - 1),
+      MAX,        T(0),       T(1),       T(2),       T(3)};
+  if constexpr (details::is_signed_int<T>)
+  {
+    for (T i : {T(-1), T(-2), T(-3), T(MIN / 2), T(MIN / 2 - 1)})
+      ret.push_back(i);
+  }
+  return ret;
+}
+
+/// @brief Checks that the portable fallbacks are equivalent to the builtins
+template<typename T>
+static void check_fallback()
+{
+  using namespace clt;
+  const auto values = edge_values<T>();
+  for (T a : values)
+  {
+    for (T b : values)
+    {
+      T expected, result;
+      bool overflow = checked_add(a, b, &expected);
+      REQUIRE(details::add_fallback(a, b, &result) == overflow);
+      REQUIRE(result == expected);
+      overflow = checked_sub(a, b, &expected);
+      REQUIRE(details::sub_fallback(a, b, &result) == overflow);
+      REQUIRE(result == expected);
+      overflow = checked_mul(a, b, &expected);
+      REQUIRE(details::mul_fallback(a, b, &result) == overflow);
+      REQUIRE(result == expected);
+    }
+  }
+}
+
+/// @brief Checks the span overloads against the scalar functions
+template<typename T>
+static void check_lanes()
+{
+  using namespace clt;
+  const auto values = edge_values<T>();
+  std::vector<T> a, b;
+  for (T i : values)
+  {
+    for (T j : values)
+    {
+      a.push_back(i);
+      b.push_back(j);
+    }
+  }
+  std::vector<T> result(a.size());
+  // All the prefixes, to test the lane by lane tail
+  for (size_t size : {size_t{0}, size_t{1}, size_t{5}, size_t{17}, a.size()})
+  {
+    const View<T> va = {a.data(), size};
+    const View<T> vb = {b.data(), size};
+    const Span<T> vr = {result.data(), size};
+
+    size_t first    = checked_add(va, vb, vr);
+    size_t expected = size;
+    for (size_t i = 0; i < size; i++)
+    {
+      T value;
+      if (checked_add(a[i], b[i], &value) && expected == size)
+        expected = i;
+      REQUIRE(result[i] == value);
+    }
+    REQUIRE(first == expected);
+
+    first    = checked_sub(va, vb, vr);
+    expected = size;
+    for (size_t i = 0; i < size; i++)
+    {
+      T value;
+      if (checked_sub(a[i], b[i], &value) && expected == size)
+        expected = i;
+      REQUIRE(result[i] == value);
+    }
+    REQUIRE(first == expected);
+
+    first    = checked_mul(va, vb, vr);
+    expected = size;
+    for (size_t i = 0; i < size; i++)
+    {
+      T value;
+      if (checked_mul(a[i], b[i], &value) && expected == size)
+        expected = i;
+      REQUIRE(result[i] == value);
+    }
+    REQUIRE(first == expected);
+  }
+}
+
+TEST_CASE("Overflow")
+{
+  using namespace clt;
+
+  SECTION("Fallback")
+  {
+    check_fallback<i8>();
+    check_fallback<u8>();
+    check_fallback<i16>();
+    check_fallback<u32>();
+    check_fallback<i64>();
+    check_fallback<u64>();
+#ifdef COLT_HAS_INT128
+    check_fallback<i128>();
+    check_fallback<u128>();
+#endif // COLT_HAS_INT128
+
+    static_assert([] {
+      i64 result;
+      return checked_mul<i64>(-1, details::min_int<i64>, &result)
+             && !checked_mul<i64>(-1, details::max_int<i64>, &result);
+    }());
+  }
+
+#ifdef COLT_HAS_INT128
+  SECTION("128-bit")
+  {
+    const u128 max = ~u128{0};
+    u128 result;
+    REQUIRE(checked_add(max, u128{1}, &result));
+    REQUIRE(result == 0);
+    REQUIRE(!checked_mul(u128{1} << 63, u128{1} << 64, &result));
+    REQUIRE(result == u128{1} << 127);
+    REQUIRE(checked_mul(u128{1} << 64, u128{1} << 64, &result));
+
+    i128 sresult;
+    REQUIRE(checked_div(details::min_int<i128>, i128{-1}, &sresult));
+    REQUIRE(sresult == details::min_int<i128>);
+    const i128 max_signed = details::max_int<i128>;
+    const i128 min_signed = details::min_int<i128>;
+    REQUIRE(saturating_add(max_signed, i128{1}) == max_signed);
+    REQUIRE(saturating_mul(min_signed, i128{2}) == min_signed);
+  }
+#endif // COLT_HAS_INT128
+
+  SECTION("Division")
+  {
+    i32 result;
+    REQUIRE(checked_div<i32>(INT32_MIN, -1, &result));
+    REQUIRE(result == INT32_MIN);
+    REQUIRE(checked_rem<i32>(INT32_MIN, -1, &result));
+    REQUIRE(result == 0);
+    REQUIRE(!checked_div<i32>(-1, INT32_MIN, &result));
+    REQUIRE(result == 0);
+    REQUIRE(!checked_rem<i32>(-7, 2, &result));
+    REQUIRE(result == -1);
+  }
+
+  SECTION("Saturating")
+  {
+    REQUIRE(saturating_add<i8>(100, 100) == 127);
+    REQUIRE(saturating_add<i8>(-100, -100) == -128);
+    REQUIRE(saturating_add<i8>(-100, 100) == 0);
+    REQUIRE(saturating_add<u8>(200, 100) == 255);
+    REQUIRE(saturating_sub<u8>(100, 200) == 0);
+    REQUIRE(saturating_sub<i8>(-100, 100) == -128);
+    REQUIRE(saturating_sub<i8>(100, -100) == 127);
+    REQUIRE(saturating_mul<i16>(-300, 300) == INT16_MIN);
+    REQUIRE(saturating_mul<i16>(-300, -300) == INT16_MAX);
+    REQUIRE(saturating_mul<u64>(UINT64_MAX, 2) == UINT64_MAX);
+    REQUIRE(saturating_div<i64>(INT64_MIN, -1) == INT64_MAX);
+    REQUIRE(saturating_div<i64>(-9, 2) == -4);
+    static_assert(saturating_add<u32>(UINT32_MAX, 1) == UINT32_MAX);
+  }
+
+  SECTION("Lanes")
+  {
+    check_lanes<i32>();
+    check_lanes<u32>();
+    check_lanes<i64>();
+    check_lanes<u64>();
+    check_lanes<i16>();
+    check_lanes<u8>();
+  }
+}
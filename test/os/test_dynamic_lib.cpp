@@ -24,4 +24,52 @@ TEST_CASE("DynamicLib")
   REQUIRE(current->find_symbol("1234567890qwertyuiopasdfghjklzxcvbnm") == nullptr);
   REQUIRE(current->find_symbol("CLT_test_export") == (void*)&CLT_test_export);
   REQUIRE((*current->find<int (*)(void)>("CLT_test_export"))() == 1029384756);
-}
\ No newline at end of file
+}
+TEST_CASE("DynamicLib Symbol Cache")
+{
+  using namespace clt;
+
+  auto current = DynamicLib::open();
+  REQUIRE(current.is_value());
+  REQUIRE(current->cached_count() == 0);
+
+  const ZStringView names[3] = {
+      "CLT_test_export", "1234567890qwertyuiopasdfghjklzxcvbnm", "CLT_test_export"};
+  void* symbols[3];
+  REQUIRE(current->resolve_all(names, symbols) == 1);
+  REQUIRE(symbols[0] == (void*)&CLT_test_export);
+  REQUIRE(symbols[1] == nullptr);
+  REQUIRE(symbols[2] == (void*)&CLT_test_export);
+  // Missing symbols are also cached
+  REQUIRE(current->cached_count() == 2);
+  REQUIRE(current->resolve("CLT_test_export") == (void*)&CLT_test_export);
+  REQUIRE(current->cached_count() == 2);
+
+  // Moving the library moves the cache
+  DynamicLib moved = std::move(*current);
+  REQUIRE(moved.cached_count() == 2);
+  moved.close();
+  REQUIRE(moved.is_closed());
+  REQUIRE(moved.cached_count() == 0);
+  REQUIRE(moved.resolve("CLT_test_export") == nullptr);
+
+  REQUIRE(DynamicLib::open("1234567890qwertyuiopasdfghjklzxcvbnm", DynamicLib::Now)
+              .is_none());
+}
+
+TEST_CASE("LazySymbol")
+{
+  using namespace clt;
+
+  auto current = DynamicLib::open();
+  REQUIRE(current.is_value());
+  const LazySymbol<int()> test_export = {*current, "CLT_test_export"};
+  REQUIRE(!test_export.is_bound());
+  REQUIRE(test_export() == 1029384756);
+  REQUIRE(test_export.is_bound());
+
+  const LazySymbol<int()> missing = {
+      *current, "1234567890qwertyuiopasdfghjklzxcvbnm"};
+  REQUIRE(!missing.bind());
+  REQUIRE(!missing.is_bound());
+}
@@ -24,4 +24,90 @@ TEST_CASE("ViewOfFile")
   auto current = ViewOfFile::open("test.txt");
   REQUIRE(current.is_value());
   REQUIRE(std::memcmp(current->view()->data(), view.data(), view.size()) == 0);
-}
\ No newline at end of file
+
+  SECTION("Range")
+  {
+    // The offset does not need to be aligned
+    auto range = ViewOfFile::open("test.txt", 5, 7);
+    REQUIRE(range.is_value());
+    REQUIRE(range->size() == 7);
+    REQUIRE(std::memcmp(range->view()->data(), text + 5, 7) == 0);
+    REQUIRE(range->advise(ViewOfFile::Sequential).is_success());
+    REQUIRE(range->advise(ViewOfFile::WillNeed, 2).is_success());
+
+    auto to_end = ViewOfFile::open("test.txt", 10, ViewOfFile::TO_END);
+    REQUIRE(to_end->size() == view.size() - 10);
+    REQUIRE(ViewOfFile::open("test.txt", view.size() + 1, 1).is_none());
+  }
+
+  SECTION("Copy On Write")
+  {
+    auto copy = ViewOfFile::open("test.txt", ViewOfFile::CopyOnWrite);
+    REQUIRE(copy.is_value());
+    copy->span()[0] = 'X';
+    REQUIRE(copy->view()->front() == 'X');
+    // The file is not modified
+    REQUIRE(current->view()->front() == 'T');
+  }
+
+  SECTION("Output")
+  {
+    const size_t page = VirtualPage::page_size().size;
+    {
+      auto out = ViewOfFile::create("test_out.bin", 100);
+      REQUIRE(out.is_value());
+      REQUIRE(out->size() == 100);
+      std::memset(out->span().data(), 'a', 100);
+      // Grows across multiple pages
+      REQUIRE(out->grow(3 * page).is_success());
+      REQUIRE(out->size() == 3 * page);
+      REQUIRE(out->span()[99] == 'a');
+      REQUIRE(out->span()[100] == 0);
+      out->span().back() = 'z';
+      REQUIRE(out->flush().is_success());
+    }
+    auto in = ViewOfFile::open("test_out.bin");
+    REQUIRE(in->size() == 3 * page);
+    REQUIRE(in->view()->front() == 'a');
+    REQUIRE(in->view()->back() == 'z');
+
+    auto rw = ViewOfFile::open("test_out.bin", page + 1, 10, ViewOfFile::ReadWrite);
+    REQUIRE(rw.is_value());
+    rw->span()[0] = 'b';
+    REQUIRE(rw->flush().is_success());
+    REQUIRE(in->view()->data()[page + 1] == 'b');
+  }
+}
+TEST_CASE("VirtualPage")
+{
+  using namespace clt;
+
+  const size_t page  = VirtualPage::page_size().size;
+  const size_t large = VirtualPage::large_page_size().size;
+  REQUIRE(std::has_single_bit(page));
+  REQUIRE((large == 0 || (large >= page && std::has_single_bit(large))));
+
+  SECTION("Options")
+  {
+    auto a = VirtualPage::allocate(
+        bytes{100}, VirtualPage::ReadWrite,
+        PageOption::TransparentHugePages | PageOption::Populate);
+    REQUIRE(!a.is_null());
+    REQUIRE(a.size() >= 100);
+    if (large != 0)
+    {
+      // The region is aligned for transparent huge pages
+      REQUIRE(a.size() % large == 0);
+      REQUIRE(reinterpret_cast<uintptr_t>(a.ptr()) % large == 0);
+    }
+    std::memset(a.ptr(), 0xCC, a.size());
+    VirtualPage::deallocate(a);
+
+    // Node 0 always exists
+    auto b = VirtualPage::allocate(
+        bytes{page}, VirtualPage::ReadWrite, PageOption::Populate, 0);
+    REQUIRE(!b.is_null());
+    static_cast<u8*>(b.ptr())[page - 1] = 1;
+    VirtualPage::deallocate(b);
+  }
+}
@@ -0,0 +1,1110 @@
+/*****************************************************************/ /**
+ * @file   grapheme_break_test.h
+ * @brief  The test vectors of GraphemeBreakTest-16.0.0.txt (from
+ * resources/UCD/auxiliary), without the comments.
+ * In each vector, '/' is a break (÷) and 'x' is not a break (×).
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#ifndef HG_TEST_GRAPHEME_BREAK_TEST
+#define HG_TEST_GRAPHEME_BREAK_TEST
+
+/// @brief The vectors of GraphemeBreakTest.txt
+inline constexpr const char* GRAPHEME_BREAK_TESTS[] = {
+    "/ 0020 / 0020 /",
+    "/ 0020 x 0308 / 0020 /",
+    "/ 0020 / 000D /",
+    "/ 0020 x 0308 / 000D /",
+    "/ 0020 / 000A /",
+    "/ 0020 x 0308 / 000A /",
+    "/ 0020 / 0001 /",
+    "/ 0020 x 0308 / 0001 /",
+    "/ 0020 x 200C /",
+    "/ 0020 x 0308 x 200C /",
+    "/ 0020 / 1F1E6 /",
+    "/ 0020 x 0308 / 1F1E6 /",
+    "/ 0020 / 0600 /",
+    "/ 0020 x 0308 / 0600 /",
+    "/ 0020 x 0A03 /",
+    "/ 0020 x 0308 x 0A03 /",
+    "/ 0020 / 1100 /",
+    "/ 0020 x 0308 / 1100 /",
+    "/ 0020 / 1160 /",
+    "/ 0020 x 0308 / 1160 /",
+    "/ 0020 / 11A8 /",
+    "/ 0020 x 0308 / 11A8 /",
+    "/ 0020 / AC00 /",
+    "/ 0020 x 0308 / AC00 /",
+    "/ 0020 / AC01 /",
+    "/ 0020 x 0308 / AC01 /",
+    "/ 0020 x 0903 /",
+    "/ 0020 x 0308 x 0903 /",
+    "/ 0020 / 0904 /",
+    "/ 0020 x 0308 / 0904 /",
+    "/ 0020 / 0D4E /",
+    "/ 0020 x 0308 / 0D4E /",
+    "/ 0020 / 0915 /",
+    "/ 0020 x 0308 / 0915 /",
+    "/ 0020 / 231A /",
+    "/ 0020 x 0308 / 231A /",
+    "/ 0020 x 0300 /",
+    "/ 0020 x 0308 x 0300 /",
+    "/ 0020 x 0900 /",
+    "/ 0020 x 0308 x 0900 /",
+    "/ 0020 x 094D /",
+    "/ 0020 x 0308 x 094D /",
+    "/ 0020 x 200D /",
+    "/ 0020 x 0308 x 200D /",
+    "/ 0020 / 0378 /",
+    "/ 0020 x 0308 / 0378 /",
+    "/ 000D / 0020 /",
+    "/ 000D / 0308 / 0020 /",
+    "/ 000D / 000D /",
+    "/ 000D / 0308 / 000D /",
+    "/ 000D x 000A /",
+    "/ 000D / 0308 / 000A /",
+    "/ 000D / 0001 /",
+    "/ 000D / 0308 / 0001 /",
+    "/ 000D / 200C /",
+    "/ 000D / 0308 x 200C /",
+    "/ 000D / 1F1E6 /",
+    "/ 000D / 0308 / 1F1E6 /",
+    "/ 000D / 0600 /",
+    "/ 000D / 0308 / 0600 /",
+    "/ 000D / 0A03 /",
+    "/ 000D / 0308 x 0A03 /",
+    "/ 000D / 1100 /",
+    "/ 000D / 0308 / 1100 /",
+    "/ 000D / 1160 /",
+    "/ 000D / 0308 / 1160 /",
+    "/ 000D / 11A8 /",
+    "/ 000D / 0308 / 11A8 /",
+    "/ 000D / AC00 /",
+    "/ 000D / 0308 / AC00 /",
+    "/ 000D / AC01 /",
+    "/ 000D / 0308 / AC01 /",
+    "/ 000D / 0903 /",
+    "/ 000D / 0308 x 0903 /",
+    "/ 000D / 0904 /",
+    "/ 000D / 0308 / 0904 /",
+    "/ 000D / 0D4E /",
+    "/ 000D / 0308 / 0D4E /",
+    "/ 000D / 0915 /",
+    "/ 000D / 0308 / 0915 /",
+    "/ 000D / 231A /",
+    "/ 000D / 0308 / 231A /",
+    "/ 000D / 0300 /",
+    "/ 000D / 0308 x 0300 /",
+    "/ 000D / 0900 /",
+    "/ 000D / 0308 x 0900 /",
+    "/ 000D / 094D /",
+    "/ 000D / 0308 x 094D /",
+    "/ 000D / 200D /",
+    "/ 000D / 0308 x 200D /",
+    "/ 000D / 0378 /",
+    "/ 000D / 0308 / 0378 /",
+    "/ 000A / 0020 /",
+    "/ 000A / 0308 / 0020 /",
+    "/ 000A / 000D /",
+    "/ 000A / 0308 / 000D /",
+    "/ 000A / 000A /",
+    "/ 000A / 0308 / 000A /",
+    "/ 000A / 0001 /",
+    "/ 000A / 0308 / 0001 /",
+    "/ 000A / 200C /",
+    "/ 000A / 0308 x 200C /",
+    "/ 000A / 1F1E6 /",
+    "/ 000A / 0308 / 1F1E6 /",
+    "/ 000A / 0600 /",
+    "/ 000A / 0308 / 0600 /",
+    "/ 000A / 0A03 /",
+    "/ 000A / 0308 x 0A03 /",
+    "/ 000A / 1100 /",
+    "/ 000A / 0308 / 1100 /",
+    "/ 000A / 1160 /",
+    "/ 000A / 0308 / 1160 /",
+    "/ 000A / 11A8 /",
+    "/ 000A / 0308 / 11A8 /",
+    "/ 000A / AC00 /",
+    "/ 000A / 0308 / AC00 /",
+    "/ 000A / AC01 /",
+    "/ 000A / 0308 / AC01 /",
+    "/ 000A / 0903 /",
+    "/ 000A / 0308 x 0903 /",
+    "/ 000A / 0904 /",
+    "/ 000A / 0308 / 0904 /",
+    "/ 000A / 0D4E /",
+    "/ 000A / 0308 / 0D4E /",
+    "/ 000A / 0915 /",
+    "/ 000A / 0308 / 0915 /",
+    "/ 000A / 231A /",
+    "/ 000A / 0308 / 231A /",
+    "/ 000A / 0300 /",
+    "/ 000A / 0308 x 0300 /",
+    "/ 000A / 0900 /",
+    "/ 000A / 0308 x 0900 /",
+    "/ 000A / 094D /",
+    "/ 000A / 0308 x 094D /",
+    "/ 000A / 200D /",
+    "/ 000A / 0308 x 200D /",
+    "/ 000A / 0378 /",
+    "/ 000A / 0308 / 0378 /",
+    "/ 0001 / 0020 /",
+    "/ 0001 / 0308 / 0020 /",
+    "/ 0001 / 000D /",
+    "/ 0001 / 0308 / 000D /",
+    "/ 0001 / 000A /",
+    "/ 0001 / 0308 / 000A /",
+    "/ 0001 / 0001 /",
+    "/ 0001 / 0308 / 0001 /",
+    "/ 0001 / 200C /",
+    "/ 0001 / 0308 x 200C /",
+    "/ 0001 / 1F1E6 /",
+    "/ 0001 / 0308 / 1F1E6 /",
+    "/ 0001 / 0600 /",
+    "/ 0001 / 0308 / 0600 /",
+    "/ 0001 / 0A03 /",
+    "/ 0001 / 0308 x 0A03 /",
+    "/ 0001 / 1100 /",
+    "/ 0001 / 0308 / 1100 /",
+    "/ 0001 / 1160 /",
+    "/ 0001 / 0308 / 1160 /",
+    "/ 0001 / 11A8 /",
+    "/ 0001 / 0308 / 11A8 /",
+    "/ 0001 / AC00 /",
+    "/ 0001 / 0308 / AC00 /",
+    "/ 0001 / AC01 /",
+    "/ 0001 / 0308 / AC01 /",
+    "/ 0001 / 0903 /",
+    "/ 0001 / 0308 x 0903 /",
+    "/ 0001 / 0904 /",
+    "/ 0001 / 0308 / 0904 /",
+    "/ 0001 / 0D4E /",
+    "/ 0001 / 0308 / 0D4E /",
+    "/ 0001 / 0915 /",
+    "/ 0001 / 0308 / 0915 /",
+    "/ 0001 / 231A /",
+    "/ 0001 / 0308 / 231A /",
+    "/ 0001 / 0300 /",
+    "/ 0001 / 0308 x 0300 /",
+    "/ 0001 / 0900 /",
+    "/ 0001 / 0308 x 0900 /",
+    "/ 0001 / 094D /",
+    "/ 0001 / 0308 x 094D /",
+    "/ 0001 / 200D /",
+    "/ 0001 / 0308 x 200D /",
+    "/ 0001 / 0378 /",
+    "/ 0001 / 0308 / 0378 /",
+    "/ 200C / 0020 /",
+    "/ 200C x 0308 / 0020 /",
+    "/ 200C / 000D /",
+    "/ 200C x 0308 / 000D /",
+    "/ 200C / 000A /",
+    "/ 200C x 0308 / 000A /",
+    "/ 200C / 0001 /",
+    "/ 200C x 0308 / 0001 /",
+    "/ 200C x 200C /",
+    "/ 200C x 0308 x 200C /",
+    "/ 200C / 1F1E6 /",
+    "/ 200C x 0308 / 1F1E6 /",
+    "/ 200C / 0600 /",
+    "/ 200C x 0308 / 0600 /",
+    "/ 200C x 0A03 /",
+    "/ 200C x 0308 x 0A03 /",
+    "/ 200C / 1100 /",
+    "/ 200C x 0308 / 1100 /",
+    "/ 200C / 1160 /",
+    "/ 200C x 0308 / 1160 /",
+    "/ 200C / 11A8 /",
+    "/ 200C x 0308 / 11A8 /",
+    "/ 200C / AC00 /",
+    "/ 200C x 0308 / AC00 /",
+    "/ 200C / AC01 /",
+    "/ 200C x 0308 / AC01 /",
+    "/ 200C x 0903 /",
+    "/ 200C x 0308 x 0903 /",
+    "/ 200C / 0904 /",
+    "/ 200C x 0308 / 0904 /",
+    "/ 200C / 0D4E /",
+    "/ 200C x 0308 / 0D4E /",
+    "/ 200C / 0915 /",
+    "/ 200C x 0308 / 0915 /",
+    "/ 200C / 231A /",
+    "/ 200C x 0308 / 231A /",
+    "/ 200C x 0300 /",
+    "/ 200C x 0308 x 0300 /",
+    "/ 200C x 0900 /",
+    "/ 200C x 0308 x 0900 /",
+    "/ 200C x 094D /",
+    "/ 200C x 0308 x 094D /",
+    "/ 200C x 200D /",
+    "/ 200C x 0308 x 200D /",
+    "/ 200C / 0378 /",
+    "/ 200C x 0308 / 0378 /",
+    "/ 1F1E6 / 0020 /",
+    "/ 1F1E6 x 0308 / 0020 /",
+    "/ 1F1E6 / 000D /",
+    "/ 1F1E6 x 0308 / 000D /",
+    "/ 1F1E6 / 000A /",
+    "/ 1F1E6 x 0308 / 000A /",
+    "/ 1F1E6 / 0001 /",
+    "/ 1F1E6 x 0308 / 0001 /",
+    "/ 1F1E6 x 200C /",
+    "/ 1F1E6 x 0308 x 200C /",
+    "/ 1F1E6 x 1F1E6 /",
+    "/ 1F1E6 x 0308 / 1F1E6 /",
+    "/ 1F1E6 / 0600 /",
+    "/ 1F1E6 x 0308 / 0600 /",
+    "/ 1F1E6 x 0A03 /",
+    "/ 1F1E6 x 0308 x 0A03 /",
+    "/ 1F1E6 / 1100 /",
+    "/ 1F1E6 x 0308 / 1100 /",
+    "/ 1F1E6 / 1160 /",
+    "/ 1F1E6 x 0308 / 1160 /",
+    "/ 1F1E6 / 11A8 /",
+    "/ 1F1E6 x 0308 / 11A8 /",
+    "/ 1F1E6 / AC00 /",
+    "/ 1F1E6 x 0308 / AC00 /",
+    "/ 1F1E6 / AC01 /",
+    "/ 1F1E6 x 0308 / AC01 /",
+    "/ 1F1E6 x 0903 /",
+    "/ 1F1E6 x 0308 x 0903 /",
+    "/ 1F1E6 / 0904 /",
+    "/ 1F1E6 x 0308 / 0904 /",
+    "/ 1F1E6 / 0D4E /",
+    "/ 1F1E6 x 0308 / 0D4E /",
+    "/ 1F1E6 / 0915 /",
+    "/ 1F1E6 x 0308 / 0915 /",
+    "/ 1F1E6 / 231A /",
+    "/ 1F1E6 x 0308 / 231A /",
+    "/ 1F1E6 x 0300 /",
+    "/ 1F1E6 x 0308 x 0300 /",
+    "/ 1F1E6 x 0900 /",
+    "/ 1F1E6 x 0308 x 0900 /",
+    "/ 1F1E6 x 094D /",
+    "/ 1F1E6 x 0308 x 094D /",
+    "/ 1F1E6 x 200D /",
+    "/ 1F1E6 x 0308 x 200D /",
+    "/ 1F1E6 / 0378 /",
+    "/ 1F1E6 x 0308 / 0378 /",
+    "/ 0600 x 0020 /",
+    "/ 0600 x 0308 / 0020 /",
+    "/ 0600 / 000D /",
+    "/ 0600 x 0308 / 000D /",
+    "/ 0600 / 000A /",
+    "/ 0600 x 0308 / 000A /",
+    "/ 0600 / 0001 /",
+    "/ 0600 x 0308 / 0001 /",
+    "/ 0600 x 200C /",
+    "/ 0600 x 0308 x 200C /",
+    "/ 0600 x 1F1E6 /",
+    "/ 0600 x 0308 / 1F1E6 /",
+    "/ 0600 x 0600 /",
+    "/ 0600 x 0308 / 0600 /",
+    "/ 0600 x 0A03 /",
+    "/ 0600 x 0308 x 0A03 /",
+    "/ 0600 x 1100 /",
+    "/ 0600 x 0308 / 1100 /",
+    "/ 0600 x 1160 /",
+    "/ 0600 x 0308 / 1160 /",
+    "/ 0600 x 11A8 /",
+    "/ 0600 x 0308 / 11A8 /",
+    "/ 0600 x AC00 /",
+    "/ 0600 x 0308 / AC00 /",
+    "/ 0600 x AC01 /",
+    "/ 0600 x 0308 / AC01 /",
+    "/ 0600 x 0903 /",
+    "/ 0600 x 0308 x 0903 /",
+    "/ 0600 x 0904 /",
+    "/ 0600 x 0308 / 0904 /",
+    "/ 0600 x 0D4E /",
+    "/ 0600 x 0308 / 0D4E /",
+    "/ 0600 x 0915 /",
+    "/ 0600 x 0308 / 0915 /",
+    "/ 0600 x 231A /",
+    "/ 0600 x 0308 / 231A /",
+    "/ 0600 x 0300 /",
+    "/ 0600 x 0308 x 0300 /",
+    "/ 0600 x 0900 /",
+    "/ 0600 x 0308 x 0900 /",
+    "/ 0600 x 094D /",
+    "/ 0600 x 0308 x 094D /",
+    "/ 0600 x 200D /",
+    "/ 0600 x 0308 x 200D /",
+    "/ 0600 x 0378 /",
+    "/ 0600 x 0308 / 0378 /",
+    "/ 0A03 / 0020 /",
+    "/ 0A03 x 0308 / 0020 /",
+    "/ 0A03 / 000D /",
+    "/ 0A03 x 0308 / 000D /",
+    "/ 0A03 / 000A /",
+    "/ 0A03 x 0308 / 000A /",
+    "/ 0A03 / 0001 /",
+    "/ 0A03 x 0308 / 0001 /",
+    "/ 0A03 x 200C /",
+    "/ 0A03 x 0308 x 200C /",
+    "/ 0A03 / 1F1E6 /",
+    "/ 0A03 x 0308 / 1F1E6 /",
+    "/ 0A03 / 0600 /",
+    "/ 0A03 x 0308 / 0600 /",
+    "/ 0A03 x 0A03 /",
+    "/ 0A03 x 0308 x 0A03 /",
+    "/ 0A03 / 1100 /",
+    "/ 0A03 x 0308 / 1100 /",
+    "/ 0A03 / 1160 /",
+    "/ 0A03 x 0308 / 1160 /",
+    "/ 0A03 / 11A8 /",
+    "/ 0A03 x 0308 / 11A8 /",
+    "/ 0A03 / AC00 /",
+    "/ 0A03 x 0308 / AC00 /",
+    "/ 0A03 / AC01 /",
+    "/ 0A03 x 0308 / AC01 /",
+    "/ 0A03 x 0903 /",
+    "/ 0A03 x 0308 x 0903 /",
+    "/ 0A03 / 0904 /",
+    "/ 0A03 x 0308 / 0904 /",
+    "/ 0A03 / 0D4E /",
+    "/ 0A03 x 0308 / 0D4E /",
+    "/ 0A03 / 0915 /",
+    "/ 0A03 x 0308 / 0915 /",
+    "/ 0A03 / 231A /",
+    "/ 0A03 x 0308 / 231A /",
+    "/ 0A03 x 0300 /",
+    "/ 0A03 x 0308 x 0300 /",
+    "/ 0A03 x 0900 /",
+    "/ 0A03 x 0308 x 0900 /",
+    "/ 0A03 x 094D /",
+    "/ 0A03 x 0308 x 094D /",
+    "/ 0A03 x 200D /",
+    "/ 0A03 x 0308 x 200D /",
+    "/ 0A03 / 0378 /",
+    "/ 0A03 x 0308 / 0378 /",
+    "/ 1100 / 0020 /",
+    "/ 1100 x 0308 / 0020 /",
+    "/ 1100 / 000D /",
+    "/ 1100 x 0308 / 000D /",
+    "/ 1100 / 000A /",
+    "/ 1100 x 0308 / 000A /",
+    "/ 1100 / 0001 /",
+    "/ 1100 x 0308 / 0001 /",
+    "/ 1100 x 200C /",
+    "/ 1100 x 0308 x 200C /",
+    "/ 1100 / 1F1E6 /",
+    "/ 1100 x 0308 / 1F1E6 /",
+    "/ 1100 / 0600 /",
+    "/ 1100 x 0308 / 0600 /",
+    "/ 1100 x 0A03 /",
+    "/ 1100 x 0308 x 0A03 /",
+    "/ 1100 x 1100 /",
+    "/ 1100 x 0308 / 1100 /",
+    "/ 1100 x 1160 /",
+    "/ 1100 x 0308 / 1160 /",
+    "/ 1100 / 11A8 /",
+    "/ 1100 x 0308 / 11A8 /",
+    "/ 1100 x AC00 /",
+    "/ 1100 x 0308 / AC00 /",
+    "/ 1100 x AC01 /",
+    "/ 1100 x 0308 / AC01 /",
+    "/ 1100 x 0903 /",
+    "/ 1100 x 0308 x 0903 /",
+    "/ 1100 / 0904 /",
+    "/ 1100 x 0308 / 0904 /",
+    "/ 1100 / 0D4E /",
+    "/ 1100 x 0308 / 0D4E /",
+    "/ 1100 / 0915 /",
+    "/ 1100 x 0308 / 0915 /",
+    "/ 1100 / 231A /",
+    "/ 1100 x 0308 / 231A /",
+    "/ 1100 x 0300 /",
+    "/ 1100 x 0308 x 0300 /",
+    "/ 1100 x 0900 /",
+    "/ 1100 x 0308 x 0900 /",
+    "/ 1100 x 094D /",
+    "/ 1100 x 0308 x 094D /",
+    "/ 1100 x 200D /",
+    "/ 1100 x 0308 x 200D /",
+    "/ 1100 / 0378 /",
+    "/ 1100 x 0308 / 0378 /",
+    "/ 1160 / 0020 /",
+    "/ 1160 x 0308 / 0020 /",
+    "/ 1160 / 000D /",
+    "/ 1160 x 0308 / 000D /",
+    "/ 1160 / 000A /",
+    "/ 1160 x 0308 / 000A /",
+    "/ 1160 / 0001 /",
+    "/ 1160 x 0308 / 0001 /",
+    "/ 1160 x 200C /",
+    "/ 1160 x 0308 x 200C /",
+    "/ 1160 / 1F1E6 /",
+    "/ 1160 x 0308 / 1F1E6 /",
+    "/ 1160 / 0600 /",
+    "/ 1160 x 0308 / 0600 /",
+    "/ 1160 x 0A03 /",
+    "/ 1160 x 0308 x 0A03 /",
+    "/ 1160 / 1100 /",
+    "/ 1160 x 0308 / 1100 /",
+    "/ 1160 x 1160 /",
+    "/ 1160 x 0308 / 1160 /",
+    "/ 1160 x 11A8 /",
+    "/ 1160 x 0308 / 11A8 /",
+    "/ 1160 / AC00 /",
+    "/ 1160 x 0308 / AC00 /",
+    "/ 1160 / AC01 /",
+    "/ 1160 x 0308 / AC01 /",
+    "/ 1160 x 0903 /",
+    "/ 1160 x 0308 x 0903 /",
+    "/ 1160 / 0904 /",
+    "/ 1160 x 0308 / 0904 /",
+    "/ 1160 / 0D4E /",
+    "/ 1160 x 0308 / 0D4E /",
+    "/ 1160 / 0915 /",
+    "/ 1160 x 0308 / 0915 /",
+    "/ 1160 / 231A /",
+    "/ 1160 x 0308 / 231A /",
+    "/ 1160 x 0300 /",
+    "/ 1160 x 0308 x 0300 /",
+    "/ 1160 x 0900 /",
+    "/ 1160 x 0308 x 0900 /",
+    "/ 1160 x 094D /",
+    "/ 1160 x 0308 x 094D /",
+    "/ 1160 x 200D /",
+    "/ 1160 x 0308 x 200D /",
+    "/ 1160 / 0378 /",
+    "/ 1160 x 0308 / 0378 /",
+    "/ 11A8 / 0020 /",
+    "/ 11A8 x 0308 / 0020 /",
+    "/ 11A8 / 000D /",
+    "/ 11A8 x 0308 / 000D /",
+    "/ 11A8 / 000A /",
+    "/ 11A8 x 0308 / 000A /",
+    "/ 11A8 / 0001 /",
+    "/ 11A8 x 0308 / 0001 /",
+    "/ 11A8 x 200C /",
+    "/ 11A8 x 0308 x 200C /",
+    "/ 11A8 / 1F1E6 /",
+    "/ 11A8 x 0308 / 1F1E6 /",
+    "/ 11A8 / 0600 /",
+    "/ 11A8 x 0308 / 0600 /",
+    "/ 11A8 x 0A03 /",
+    "/ 11A8 x 0308 x 0A03 /",
+    "/ 11A8 / 1100 /",
+    "/ 11A8 x 0308 / 1100 /",
+    "/ 11A8 / 1160 /",
+    "/ 11A8 x 0308 / 1160 /",
+    "/ 11A8 x 11A8 /",
+    "/ 11A8 x 0308 / 11A8 /",
+    "/ 11A8 / AC00 /",
+    "/ 11A8 x 0308 / AC00 /",
+    "/ 11A8 / AC01 /",
+    "/ 11A8 x 0308 / AC01 /",
+    "/ 11A8 x 0903 /",
+    "/ 11A8 x 0308 x 0903 /",
+    "/ 11A8 / 0904 /",
+    "/ 11A8 x 0308 / 0904 /",
+    "/ 11A8 / 0D4E /",
+    "/ 11A8 x 0308 / 0D4E /",
+    "/ 11A8 / 0915 /",
+    "/ 11A8 x 0308 / 0915 /",
+    "/ 11A8 / 231A /",
+    "/ 11A8 x 0308 / 231A /",
+    "/ 11A8 x 0300 /",
+    "/ 11A8 x 0308 x 0300 /",
+    "/ 11A8 x 0900 /",
+    "/ 11A8 x 0308 x 0900 /",
+    "/ 11A8 x 094D /",
+    "/ 11A8 x 0308 x 094D /",
+    "/ 11A8 x 200D /",
+    "/ 11A8 x 0308 x 200D /",
+    "/ 11A8 / 0378 /",
+    "/ 11A8 x 0308 / 0378 /",
+    "/ AC00 / 0020 /",
+    "/ AC00 x 0308 / 0020 /",
+    "/ AC00 / 000D /",
+    "/ AC00 x 0308 / 000D /",
+    "/ AC00 / 000A /",
+    "/ AC00 x 0308 / 000A /",
+    "/ AC00 / 0001 /",
+    "/ AC00 x 0308 / 0001 /",
+    "/ AC00 x 200C /",
+    "/ AC00 x 0308 x 200C /",
+    "/ AC00 / 1F1E6 /",
+    "/ AC00 x 0308 / 1F1E6 /",
+    "/ AC00 / 0600 /",
+    "/ AC00 x 0308 / 0600 /",
+    "/ AC00 x 0A03 /",
+    "/ AC00 x 0308 x 0A03 /",
+    "/ AC00 / 1100 /",
+    "/ AC00 x 0308 / 1100 /",
+    "/ AC00 x 1160 /",
+    "/ AC00 x 0308 / 1160 /",
+    "/ AC00 x 11A8 /",
+    "/ AC00 x 0308 / 11A8 /",
+    "/ AC00 / AC00 /",
+    "/ AC00 x 0308 / AC00 /",
+    "/ AC00 / AC01 /",
+    "/ AC00 x 0308 / AC01 /",
+    "/ AC00 x 0903 /",
+    "/ AC00 x 0308 x 0903 /",
+    "/ AC00 / 0904 /",
+    "/ AC00 x 0308 / 0904 /",
+    "/ AC00 / 0D4E /",
+    "/ AC00 x 0308 / 0D4E /",
+    "/ AC00 / 0915 /",
+    "/ AC00 x 0308 / 0915 /",
+    "/ AC00 / 231A /",
+    "/ AC00 x 0308 / 231A /",
+    "/ AC00 x 0300 /",
+    "/ AC00 x 0308 x 0300 /",
+    "/ AC00 x 0900 /",
+    "/ AC00 x 0308 x 0900 /",
+    "/ AC00 x 094D /",
+    "/ AC00 x 0308 x 094D /",
+    "/ AC00 x 200D /",
+    "/ AC00 x 0308 x 200D /",
+    "/ AC00 / 0378 /",
+    "/ AC00 x 0308 / 0378 /",
+    "/ AC01 / 0020 /",
+    "/ AC01 x 0308 / 0020 /",
+    "/ AC01 / 000D /",
+    "/ AC01 x 0308 / 000D /",
+    "/ AC01 / 000A /",
+    "/ AC01 x 0308 / 000A /",
+    "/ AC01 / 0001 /",
+    "/ AC01 x 0308 / 0001 /",
+    "/ AC01 x 200C /",
+    "/ AC01 x 0308 x 200C /",
+    "/ AC01 / 1F1E6 /",
+    "/ AC01 x 0308 / 1F1E6 /",
+    "/ AC01 / 0600 /",
+    "/ AC01 x 0308 / 0600 /",
+    "/ AC01 x 0A03 /",
+    "/ AC01 x 0308 x 0A03 /",
+    "/ AC01 / 1100 /",
+    "/ AC01 x 0308 / 1100 /",
+    "/ AC01 / 1160 /",
+    "/ AC01 x 0308 / 1160 /",
+    "/ AC01 x 11A8 /",
+    "/ AC01 x 0308 / 11A8 /",
+    "/ AC01 / AC00 /",
+    "/ AC01 x 0308 / AC00 /",
+    "/ AC01 / AC01 /",
+    "/ AC01 x 0308 / AC01 /",
+    "/ AC01 x 0903 /",
+    "/ AC01 x 0308 x 0903 /",
+    "/ AC01 / 0904 /",
+    "/ AC01 x 0308 / 0904 /",
+    "/ AC01 / 0D4E /",
+    "/ AC01 x 0308 / 0D4E /",
+    "/ AC01 / 0915 /",
+    "/ AC01 x 0308 / 0915 /",
+    "/ AC01 / 231A /",
+    "/ AC01 x 0308 / 231A /",
+    "/ AC01 x 0300 /",
+    "/ AC01 x 0308 x 0300 /",
+    "/ AC01 x 0900 /",
+    "/ AC01 x 0308 x 0900 /",
+    "/ AC01 x 094D /",
+    "/ AC01 x 0308 x 094D /",
+    "/ AC01 x 200D /",
+    "/ AC01 x 0308 x 200D /",
+    "/ AC01 / 0378 /",
+    "/ AC01 x 0308 / 0378 /",
+    "/ 0903 / 0020 /",
+    "/ 0903 x 0308 / 0020 /",
+    "/ 0903 / 000D /",
+    "/ 0903 x 0308 / 000D /",
+    "/ 0903 / 000A /",
+    "/ 0903 x 0308 / 000A /",
+    "/ 0903 / 0001 /",
+    "/ 0903 x 0308 / 0001 /",
+    "/ 0903 x 200C /",
+    "/ 0903 x 0308 x 200C /",
+    "/ 0903 / 1F1E6 /",
+    "/ 0903 x 0308 / 1F1E6 /",
+    "/ 0903 / 0600 /",
+    "/ 0903 x 0308 / 0600 /",
+    "/ 0903 x 0A03 /",
+    "/ 0903 x 0308 x 0A03 /",
+    "/ 0903 / 1100 /",
+    "/ 0903 x 0308 / 1100 /",
+    "/ 0903 / 1160 /",
+    "/ 0903 x 0308 / 1160 /",
+    "/ 0903 / 11A8 /",
+    "/ 0903 x 0308 / 11A8 /",
+    "/ 0903 / AC00 /",
+    "/ 0903 x 0308 / AC00 /",
+    "/ 0903 / AC01 /",
+    "/ 0903 x 0308 / AC01 /",
+    "/ 0903 x 0903 /",
+    "/ 0903 x 0308 x 0903 /",
+    "/ 0903 / 0904 /",
+    "/ 0903 x 0308 / 0904 /",
+    "/ 0903 / 0D4E /",
+    "/ 0903 x 0308 / 0D4E /",
+    "/ 0903 / 0915 /",
+    "/ 0903 x 0308 / 0915 /",
+    "/ 0903 / 231A /",
+    "/ 0903 x 0308 / 231A /",
+    "/ 0903 x 0300 /",
+    "/ 0903 x 0308 x 0300 /",
+    "/ 0903 x 0900 /",
+    "/ 0903 x 0308 x 0900 /",
+    "/ 0903 x 094D /",
+    "/ 0903 x 0308 x 094D /",
+    "/ 0903 x 200D /",
+    "/ 0903 x 0308 x 200D /",
+    "/ 0903 / 0378 /",
+    "/ 0903 x 0308 / 0378 /",
+    "/ 0904 / 0020 /",
+    "/ 0904 x 0308 / 0020 /",
+    "/ 0904 / 000D /",
+    "/ 0904 x 0308 / 000D /",
+    "/ 0904 / 000A /",
+    "/ 0904 x 0308 / 000A /",
+    "/ 0904 / 0001 /",
+    "/ 0904 x 0308 / 0001 /",
+    "/ 0904 x 200C /",
+    "/ 0904 x 0308 x 200C /",
+    "/ 0904 / 1F1E6 /",
+    "/ 0904 x 0308 / 1F1E6 /",
+    "/ 0904 / 0600 /",
+    "/ 0904 x 0308 / 0600 /",
+    "/ 0904 x 0A03 /",
+    "/ 0904 x 0308 x 0A03 /",
+    "/ 0904 / 1100 /",
+    "/ 0904 x 0308 / 1100 /",
+    "/ 0904 / 1160 /",
+    "/ 0904 x 0308 / 1160 /",
+    "/ 0904 / 11A8 /",
+    "/ 0904 x 0308 / 11A8 /",
+    "/ 0904 / AC00 /",
+    "/ 0904 x 0308 / AC00 /",
+    "/ 0904 / AC01 /",
+    "/ 0904 x 0308 / AC01 /",
+    "/ 0904 x 0903 /",
+    "/ 0904 x 0308 x 0903 /",
+    "/ 0904 / 0904 /",
+    "/ 0904 x 0308 / 0904 /",
+    "/ 0904 / 0D4E /",
+    "/ 0904 x 0308 / 0D4E /",
+    "/ 0904 / 0915 /",
+    "/ 0904 x 0308 / 0915 /",
+    "/ 0904 / 231A /",
+    "/ 0904 x 0308 / 231A /",
+    "/ 0904 x 0300 /",
+    "/ 0904 x 0308 x 0300 /",
+    "/ 0904 x 0900 /",
+    "/ 0904 x 0308 x 0900 /",
+    "/ 0904 x 094D /",
+    "/ 0904 x 0308 x 094D /",
+    "/ 0904 x 200D /",
+    "/ 0904 x 0308 x 200D /",
+    "/ 0904 / 0378 /",
+    "/ 0904 x 0308 / 0378 /",
+    "/ 0D4E x 0020 /",
+    "/ 0D4E x 0308 / 0020 /",
+    "/ 0D4E / 000D /",
+    "/ 0D4E x 0308 / 000D /",
+    "/ 0D4E / 000A /",
+    "/ 0D4E x 0308 / 000A /",
+    "/ 0D4E / 0001 /",
+    "/ 0D4E x 0308 / 0001 /",
+    "/ 0D4E x 200C /",
+    "/ 0D4E x 0308 x 200C /",
+    "/ 0D4E x 1F1E6 /",
+    "/ 0D4E x 0308 / 1F1E6 /",
+    "/ 0D4E x 0600 /",
+    "/ 0D4E x 0308 / 0600 /",
+    "/ 0D4E x 0A03 /",
+    "/ 0D4E x 0308 x 0A03 /",
+    "/ 0D4E x 1100 /",
+    "/ 0D4E x 0308 / 1100 /",
+    "/ 0D4E x 1160 /",
+    "/ 0D4E x 0308 / 1160 /",
+    "/ 0D4E x 11A8 /",
+    "/ 0D4E x 0308 / 11A8 /",
+    "/ 0D4E x AC00 /",
+    "/ 0D4E x 0308 / AC00 /",
+    "/ 0D4E x AC01 /",
+    "/ 0D4E x 0308 / AC01 /",
+    "/ 0D4E x 0903 /",
+    "/ 0D4E x 0308 x 0903 /",
+    "/ 0D4E x 0904 /",
+    "/ 0D4E x 0308 / 0904 /",
+    "/ 0D4E x 0D4E /",
+    "/ 0D4E x 0308 / 0D4E /",
+    "/ 0D4E x 0915 /",
+    "/ 0D4E x 0308 / 0915 /",
+    "/ 0D4E x 231A /",
+    "/ 0D4E x 0308 / 231A /",
+    "/ 0D4E x 0300 /",
+    "/ 0D4E x 0308 x 0300 /",
+    "/ 0D4E x 0900 /",
+    "/ 0D4E x 0308 x 0900 /",
+    "/ 0D4E x 094D /",
+    "/ 0D4E x 0308 x 094D /",
+    "/ 0D4E x 200D /",
+    "/ 0D4E x 0308 x 200D /",
+    "/ 0D4E x 0378 /",
+    "/ 0D4E x 0308 / 0378 /",
+    "/ 0915 / 0020 /",
+    "/ 0915 x 0308 / 0020 /",
+    "/ 0915 / 000D /",
+    "/ 0915 x 0308 / 000D /",
+    "/ 0915 / 000A /",
+    "/ 0915 x 0308 / 000A /",
+    "/ 0915 / 0001 /",
+    "/ 0915 x 0308 / 0001 /",
+    "/ 0915 x 200C /",
+    "/ 0915 x 0308 x 200C /",
+    "/ 0915 / 1F1E6 /",
+    "/ 0915 x 0308 / 1F1E6 /",
+    "/ 0915 / 0600 /",
+    "/ 0915 x 0308 / 0600 /",
+    "/ 0915 x 0A03 /",
+    "/ 0915 x 0308 x 0A03 /",
+    "/ 0915 / 1100 /",
+    "/ 0915 x 0308 / 1100 /",
+    "/ 0915 / 1160 /",
+    "/ 0915 x 0308 / 1160 /",
+    "/ 0915 / 11A8 /",
+    "/ 0915 x 0308 / 11A8 /",
+    "/ 0915 / AC00 /",
+    "/ 0915 x 0308 / AC00 /",
+    "/ 0915 / AC01 /",
+    "/ 0915 x 0308 / AC01 /",
+    "/ 0915 x 0903 /",
+    "/ 0915 x 0308 x 0903 /",
+    "/ 0915 / 0904 /",
+    "/ 0915 x 0308 / 0904 /",
+    "/ 0915 / 0D4E /",
+    "/ 0915 x 0308 / 0D4E /",
+    "/ 0915 / 0915 /",
+    "/ 0915 x 0308 / 0915 /",
+    "/ 0915 / 231A /",
+    "/ 0915 x 0308 / 231A /",
+    "/ 0915 x 0300 /",
+    "/ 0915 x 0308 x 0300 /",
+    "/ 0915 x 0900 /",
+    "/ 0915 x 0308 x 0900 /",
+    "/ 0915 x 094D /",
+    "/ 0915 x 0308 x 094D /",
+    "/ 0915 x 200D /",
+    "/ 0915 x 0308 x 200D /",
+    "/ 0915 / 0378 /",
+    "/ 0915 x 0308 / 0378 /",
+    "/ 231A / 0020 /",
+    "/ 231A x 0308 / 0020 /",
+    "/ 231A / 000D /",
+    "/ 231A x 0308 / 000D /",
+    "/ 231A / 000A /",
+    "/ 231A x 0308 / 000A /",
+    "/ 231A / 0001 /",
+    "/ 231A x 0308 / 0001 /",
+    "/ 231A x 200C /",
+    "/ 231A x 0308 x 200C /",
+    "/ 231A / 1F1E6 /",
+    "/ 231A x 0308 / 1F1E6 /",
+    "/ 231A / 0600 /",
+    "/ 231A x 0308 / 0600 /",
+    "/ 231A x 0A03 /",
+    "/ 231A x 0308 x 0A03 /",
+    "/ 231A / 1100 /",
+    "/ 231A x 0308 / 1100 /",
+    "/ 231A / 1160 /",
+    "/ 231A x 0308 / 1160 /",
+    "/ 231A / 11A8 /",
+    "/ 231A x 0308 / 11A8 /",
+    "/ 231A / AC00 /",
+    "/ 231A x 0308 / AC00 /",
+    "/ 231A / AC01 /",
+    "/ 231A x 0308 / AC01 /",
+    "/ 231A x 0903 /",
+    "/ 231A x 0308 x 0903 /",
+    "/ 231A / 0904 /",
+    "/ 231A x 0308 / 0904 /",
+    "/ 231A / 0D4E /",
+    "/ 231A x 0308 / 0D4E /",
+    "/ 231A / 0915 /",
+    "/ 231A x 0308 / 0915 /",
+    "/ 231A / 231A /",
+    "/ 231A x 0308 / 231A /",
+    "/ 231A x 0300 /",
+    "/ 231A x 0308 x 0300 /",
+    "/ 231A x 0900 /",
+    "/ 231A x 0308 x 0900 /",
+    "/ 231A x 094D /",
+    "/ 231A x 0308 x 094D /",
+    "/ 231A x 200D /",
+    "/ 231A x 0308 x 200D /",
+    "/ 231A / 0378 /",
+    "/ 231A x 0308 / 0378 /",
+    "/ 0300 / 0020 /",
+    "/ 0300 x 0308 / 0020 /",
+    "/ 0300 / 000D /",
+    "/ 0300 x 0308 / 000D /",
+    "/ 0300 / 000A /",
+    "/ 0300 x 0308 / 000A /",
+    "/ 0300 / 0001 /",
+    "/ 0300 x 0308 / 0001 /",
+    "/ 0300 x 200C /",
+    "/ 0300 x 0308 x 200C /",
+    "/ 0300 / 1F1E6 /",
+    "/ 0300 x 0308 / 1F1E6 /",
+    "/ 0300 / 0600 /",
+    "/ 0300 x 0308 / 0600 /",
+    "/ 0300 x 0A03 /",
+    "/ 0300 x 0308 x 0A03 /",
+    "/ 0300 / 1100 /",
+    "/ 0300 x 0308 / 1100 /",
+    "/ 0300 / 1160 /",
+    "/ 0300 x 0308 / 1160 /",
+    "/ 0300 / 11A8 /",
+    "/ 0300 x 0308 / 11A8 /",
+    "/ 0300 / AC00 /",
+    "/ 0300 x 0308 / AC00 /",
+    "/ 0300 / AC01 /",
+    "/ 0300 x 0308 / AC01 /",
+    "/ 0300 x 0903 /",
+    "/ 0300 x 0308 x 0903 /",
+    "/ 0300 / 0904 /",
+    "/ 0300 x 0308 / 0904 /",
+    "/ 0300 / 0D4E /",
+    "/ 0300 x 0308 / 0D4E /",
+    "/ 0300 / 0915 /",
+    "/ 0300 x 0308 / 0915 /",
+    "/ 0300 / 231A /",
+    "/ 0300 x 0308 / 231A /",
+    "/ 0300 x 0300 /",
+    "/ 0300 x 0308 x 0300 /",
+    "/ 0300 x 0900 /",
+    "/ 0300 x 0308 x 0900 /",
+    "/ 0300 x 094D /",
+    "/ 0300 x 0308 x 094D /",
+    "/ 0300 x 200D /",
+    "/ 0300 x 0308 x 200D /",
+    "/ 0300 / 0378 /",
+    "/ 0300 x 0308 / 0378 /",
+    "/ 0900 / 0020 /",
+    "/ 0900 x 0308 / 0020 /",
+    "/ 0900 / 000D /",
+    "/ 0900 x 0308 / 000D /",
+    "/ 0900 / 000A /",
+    "/ 0900 x 0308 / 000A /",
+    "/ 0900 / 0001 /",
+    "/ 0900 x 0308 / 0001 /",
+    "/ 0900 x 200C /",
+    "/ 0900 x 0308 x 200C /",
+    "/ 0900 / 1F1E6 /",
+    "/ 0900 x 0308 / 1F1E6 /",
+    "/ 0900 / 0600 /",
+    "/ 0900 x 0308 / 0600 /",
+    "/ 0900 x 0A03 /",
+    "/ 0900 x 0308 x 0A03 /",
+    "/ 0900 / 1100 /",
+    "/ 0900 x 0308 / 1100 /",
+    "/ 0900 / 1160 /",
+    "/ 0900 x 0308 / 1160 /",
+    "/ 0900 / 11A8 /",
+    "/ 0900 x 0308 / 11A8 /",
+    "/ 0900 / AC00 /",
+    "/ 0900 x 0308 / AC00 /",
+    "/ 0900 / AC01 /",
+    "/ 0900 x 0308 / AC01 /",
+    "/ 0900 x 0903 /",
+    "/ 0900 x 0308 x 0903 /",
+    "/ 0900 / 0904 /",
+    "/ 0900 x 0308 / 0904 /",
+    "/ 0900 / 0D4E /",
+    "/ 0900 x 0308 / 0D4E /",
+    "/ 0900 / 0915 /",
+    "/ 0900 x 0308 / 0915 /",
+    "/ 0900 / 231A /",
+    "/ 0900 x 0308 / 231A /",
+    "/ 0900 x 0300 /",
+    "/ 0900 x 0308 x 0300 /",
+    "/ 0900 x 0900 /",
+    "/ 0900 x 0308 x 0900 /",
+    "/ 0900 x 094D /",
+    "/ 0900 x 0308 x 094D /",
+    "/ 0900 x 200D /",
+    "/ 0900 x 0308 x 200D /",
+    "/ 0900 / 0378 /",
+    "/ 0900 x 0308 / 0378 /",
+    "/ 094D / 0020 /",
+    "/ 094D x 0308 / 0020 /",
+    "/ 094D / 000D /",
+    "/ 094D x 0308 / 000D /",
+    "/ 094D / 000A /",
+    "/ 094D x 0308 / 000A /",
+    "/ 094D / 0001 /",
+    "/ 094D x 0308 / 0001 /",
+    "/ 094D x 200C /",
+    "/ 094D x 0308 x 200C /",
+    "/ 094D / 1F1E6 /",
+    "/ 094D x 0308 / 1F1E6 /",
+    "/ 094D / 0600 /",
+    "/ 094D x 0308 / 0600 /",
+    "/ 094D x 0A03 /",
+    "/ 094D x 0308 x 0A03 /",
+    "/ 094D / 1100 /",
+    "/ 094D x 0308 / 1100 /",
+    "/ 094D / 1160 /",
+    "/ 094D x 0308 / 1160 /",
+    "/ 094D / 11A8 /",
+    "/ 094D x 0308 / 11A8 /",
+    "/ 094D / AC00 /",
+    "/ 094D x 0308 / AC00 /",
+    "/ 094D / AC01 /",
+    "/ 094D x 0308 / AC01 /",
+    "/ 094D x 0903 /",
+    "/ 094D x 0308 x 0903 /",
+    "/ 094D / 0904 /",
+    "/ 094D x 0308 / 0904 /",
+    "/ 094D / 0D4E /",
+    "/ 094D x 0308 / 0D4E /",
+    "/ 094D / 0915 /",
+    "/ 094D x 0308 / 0915 /",
+    "/ 094D / 231A /",
+    "/ 094D x 0308 / 231A /",
+    "/ 094D x 0300 /",
+    "/ 094D x 0308 x 0300 /",
+    "/ 094D x 0900 /",
+    "/ 094D x 0308 x 0900 /",
+    "/ 094D x 094D /",
+    "/ 094D x 0308 x 094D /",
+    "/ 094D x 200D /",
+    "/ 094D x 0308 x 200D /",
+    "/ 094D / 0378 /",
+    "/ 094D x 0308 / 0378 /",
+    "/ 200D / 0020 /",
+    "/ 200D x 0308 / 0020 /",
+    "/ 200D / 000D /",
+    "/ 200D x 0308 / 000D /",
+    "/ 200D / 000A /",
+    "/ 200D x 0308 / 000A /",
+    "/ 200D / 0001 /",
+    "/ 200D x 0308 / 0001 /",
+    "/ 200D x 200C /",
+    "/ 200D x 0308 x 200C /",
+    "/ 200D / 1F1E6 /",
+    "/ 200D x 0308 / 1F1E6 /",
+    "/ 200D / 0600 /",
+    "/ 200D x 0308 / 0600 /",
+    "/ 200D x 0A03 /",
+    "/ 200D x 0308 x 0A03 /",
+    "/ 200D / 1100 /",
+    "/ 200D x 0308 / 1100 /",
+    "/ 200D / 1160 /",
+    "/ 200D x 0308 / 1160 /",
+    "/ 200D / 11A8 /",
+    "/ 200D x 0308 / 11A8 /",
+    "/ 200D / AC00 /",
+    "/ 200D x 0308 / AC00 /",
+    "/ 200D / AC01 /",
+    "/ 200D x 0308 / AC01 /",
+    "/ 200D x 0903 /",
+    "/ 200D x 0308 x 0903 /",
+    "/ 200D / 0904 /",
+    "/ 200D x 0308 / 0904 /",
+    "/ 200D / 0D4E /",
+    "/ 200D x 0308 / 0D4E /",
+    "/ 200D / 0915 /",
+    "/ 200D x 0308 / 0915 /",
+    "/ 200D / 231A /",
+    "/ 200D x 0308 / 231A /",
+    "/ 200D x 0300 /",
+    "/ 200D x 0308 x 0300 /",
+    "/ 200D x 0900 /",
+    "/ 200D x 0308 x 0900 /",
+    "/ 200D x 094D /",
+    "/ 200D x 0308 x 094D /",
+    "/ 200D x 200D /",
+    "/ 200D x 0308 x 200D /",
+    "/ 200D / 0378 /",
+    "/ 200D x 0308 / 0378 /",
+    "/ 0378 / 0020 /",
+    "/ 0378 x 0308 / 0020 /",
+    "/ 0378 / 000D /",
+    "/ 0378 x 0308 / 000D /",
+    "/ 0378 / 000A /",
+    "/ 0378 x 0308 / 000A /",
+    "/ 0378 / 0001 /",
+    "/ 0378 x 0308 / 0001 /",
+    "/ 0378 x 200C /",
+    "/ 0378 x 0308 x 200C /",
+    "/ 0378 / 1F1E6 /",
+    "/ 0378 x 0308 / 1F1E6 /",
+    "/ 0378 / 0600 /",
+    "/ 0378 x 0308 / 0600 /",
+    "/ 0378 x 0A03 /",
+    "/ 0378 x 0308 x 0A03 /",
+    "/ 0378 / 1100 /",
+    "/ 0378 x 0308 / 1100 /",
+    "/ 0378 / 1160 /",
+    "/ 0378 x 0308 / 1160 /",
+    "/ 0378 / 11A8 /",
+    "/ 0378 x 0308 / 11A8 /",
+    "/ 0378 / AC00 /",
+    "/ 0378 x 0308 / AC00 /",
+    "/ 0378 / AC01 /",
+    "/ 0378 x 0308 / AC01 /",
+    "/ 0378 x 0903 /",
+    "/ 0378 x 0308 x 0903 /",
+    "/ 0378 / 0904 /",
+    "/ 0378 x 0308 / 0904 /",
+    "/ 0378 / 0D4E /",
+    "/ 0378 x 0308 / 0D4E /",
+    "/ 0378 / 0915 /",
+    "/ 0378 x 0308 / 0915 /",
+    "/ 0378 / 231A /",
+    "/ 0378 x 0308 / 231A /",
+    "/ 0378 x 0300 /",
+    "/ 0378 x 0308 x 0300 /",
+    "/ 0378 x 0900 /",
+    "/ 0378 x 0308 x 0900 /",
+    "/ 0378 x 094D /",
+    "/ 0378 x 0308 x 094D /",
+    "/ 0378 x 200D /",
+    "/ 0378 x 0308 x 200D /",
+    "/ 0378 / 0378 /",
+    "/ 0378 x 0308 / 0378 /",
+    "/ 000D x 000A / 0061 / 000A / 0308 /",
+    "/ 0061 x 0308 /",
+    "/ 0020 x 200D / 0646 /",
+    "/ 0646 x 200D / 0020 /",
+    "/ 1100 x 1100 /",
+    "/ AC00 x 11A8 / 1100 /",
+    "/ AC01 x 11A8 / 1100 /",
+    "/ 1F1E6 x 1F1E7 / 1F1E8 / 0062 /",
+    "/ 0061 / 1F1E6 x 1F1E7 / 1F1E8 / 0062 /",
+    "/ 0061 / 1F1E6 x 1F1E7 x 200D / 1F1E8 / 0062 /",
+    "/ 0061 / 1F1E6 x 200D / 1F1E7 x 1F1E8 / 0062 /",
+    "/ 0061 / 1F1E6 x 1F1E7 / 1F1E8 x 1F1E9 / 0062 /",
+    "/ 0061 x 200D /",
+    "/ 0061 x 0308 / 0062 /",
+    "/ 0061 x 0903 / 0062 /",
+    "/ 0061 / 0600 x 0062 /",
+    "/ 1F476 x 1F3FF / 1F476 /",
+    "/ 0061 x 1F3FF / 1F476 /",
+    "/ 0061 x 1F3FF / 1F476 x 200D x 1F6D1 /",
+    "/ 1F476 x 1F3FF x 0308 x 200D x 1F476 x 1F3FF /",
+    "/ 1F6D1 x 200D x 1F6D1 /",
+    "/ 0061 x 200D / 1F6D1 /",
+    "/ 2701 x 200D x 2701 /",
+    "/ 0061 x 200D / 2701 /",
+    "/ 0915 / 0924 /",
+    "/ 0915 x 094D x 0924 /",
+    "/ 0915 x 094D x 094D x 0924 /",
+    "/ 0915 x 094D x 200D x 0924 /",
+    "/ 0915 x 093C x 200D x 094D x 0924 /",
+    "/ 0915 x 093C x 094D x 200D x 0924 /",
+    "/ 0915 x 094D x 0924 x 094D x 092F /",
+    "/ 0915 x 094D / 0061 /",
+    "/ 0061 x 094D / 0924 /",
+    "/ 003F x 094D / 0924 /",
+    "/ 0915 x 094D x 094D x 0924 /",
+};
+
+#endif // !HG_TEST_GRAPHEME_BREAK_TEST
@@ -0,0 +1,156 @@
+/*****************************************************************/ /**
+ * @file   test_casefold.cpp
+ * @brief  Unit tests for the case folding functions.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/unicode/casefold.h>
+#include <colt/dsa/map.h>
+#include <colt/dsa/set.h>
+#include <string>
+#include <vector>
+
+/// @brief Folds 'view', checking that 'casefold_size' is exact
+template<typename T>
+static auto casefold_checked(const T& str)
+{
+  using namespace clt;
+  const auto view = uni::details::as_view(str);
+  using char_t    = typename decltype(view)::underlying_type;
+  std::vector<char_t> ret(uni::casefold_size(view));
+  auto written = uni::casefold_into(view, Span<char_t>{ret});
+  REQUIRE(written.is_expect());
+  REQUIRE(*written == ret.size());
+  return ret;
+}
+
+TEST_CASE("Unicode Case Folding")
+{
+  using namespace clt;
+  using namespace clt::uni;
+
+  SECTION("Code Point")
+  {
+    STATIC_REQUIRE(casefold(U'A').count == 1);
+    STATIC_REQUIRE(casefold(U'A').code_points[0] == U'a');
+    STATIC_REQUIRE(casefold(U'a').code_points[0] == U'a');
+    STATIC_REQUIRE(casefold(U'0').code_points[0] == U'0');
+    // Kelvin sign folds to ASCII
+    REQUIRE(casefold(U'\u212A').code_points[0] == U'k');
+    REQUIRE(casefold(U'Σ').code_points[0] == U'σ');
+    REQUIRE(casefold(U'\U00010400').code_points[0] == U'\U00010428');
+    // Full foldings
+    auto sharp_s = casefold(U'ß');
+    REQUIRE(sharp_s.count == 2);
+    REQUIRE(sharp_s.code_points[0] == U's');
+    REQUIRE(sharp_s.code_points[1] == U's');
+    auto i_dot = casefold(U'İ');
+    REQUIRE(std::u32string{i_dot.begin(), i_dot.end()} == U"i̇");
+    REQUIRE(casefold(U'ΐ').count == 3);
+    REQUIRE(casefold(0x10FFFF).code_points[0] == 0x10FFFF);
+  }
+
+  SECTION("Compare")
+  {
+    constexpr StringView hello = "Hello";
+    constexpr StringView abc   = "abc";
+    STATIC_REQUIRE(std::is_eq(casefold_compare(hello, StringView{"hELLO"})));
+    STATIC_REQUIRE(std::is_lt(casefold_compare(abc, StringView{"ABD"})));
+    STATIC_REQUIRE(std::is_gt(casefold_compare(abc, StringView{"AB"})));
+    REQUIRE(casefold_equal("Straße"_UTF8, "STRASSE"_UTF8));
+    REQUIRE(casefold_equal("\u212A"_UTF8, "k"_UTF8));
+    REQUIRE(casefold_equal("Σς"_UTF8, "σσ"_UTF8));
+    REQUIRE(!casefold_equal("ß"_UTF8, "s"_UTF8));
+    REQUIRE(std::is_gt(casefold_compare("ß"_UTF8, "s"_UTF8)));
+    REQUIRE(std::is_lt(casefold_compare(u8StringView{}, "s"_UTF8)));
+    REQUIRE(std::is_eq(casefold_compare(u8StringView{}, StringView{""})));
+
+    // Across encodings
+    u16StringView u16 = ptr_to<const Char16*>(u"STRASSE Σ");
+    REQUIRE(casefold_equal(u16, "straße σ"_UTF8));
+    REQUIRE(casefold_equal(StringView{"strasse"}, u16StringView{u16.data(), 7}));
+
+    // Long ASCII runs are compared using SIMD
+    std::string a(100, 'x');
+    std::string b(100, 'X');
+    a += "Z\xC3\x9F";
+    b += "z\xC3\x9F";
+    const u8StringView va = {ptr_to<const Char8*>(a.data()), a.size()};
+    const u8StringView vb = {ptr_to<const Char8*>(b.data()), b.size()};
+    REQUIRE(casefold_equal(va, vb));
+    for (size_t i = 0; i < 100; i++)
+    {
+      b[i] = 'y';
+      REQUIRE(std::is_lt(casefold_compare(va, vb)));
+      b[i] = '@';
+      REQUIRE(std::is_gt(casefold_compare(va, vb)));
+      b[i] = 'x';
+    }
+    REQUIRE(casefold_equal(va, vb));
+  }
+
+  SECTION("Into")
+  {
+    auto folded = casefold_checked("HeLLo ßİ Σ!"_UTF8);
+    REQUIRE(
+        u8StringView{folded.data(), folded.size()} == "hello ssi̇ σ!"_UTF8);
+    auto ascii = casefold_checked(StringView{"AbC_123"});
+    REQUIRE(std::string{ascii.begin(), ascii.end()} == "abc_123");
+    u16StringView u16 = ptr_to<const Char16*>(u"\U00010400X");
+    auto folded16     = casefold_checked(u16);
+    REQUIRE(
+        u16StringView{folded16.data(), folded16.size()}
+        == ptr_to<const Char16*>(u"\U00010428x"));
+
+    Char8 buffer[4];
+    REQUIRE(
+        casefold_into("ABCDE"_UTF8, Span<Char8>{buffer}).error()
+        == ConvError::NOT_ENOUGH_SPACE);
+    REQUIRE(
+        casefold_into("ABCß"_UTF8, Span<Char8>{buffer}).error()
+        == ConvError::NOT_ENOUGH_SPACE);
+    REQUIRE(*casefold_into("ABCD"_UTF8, Span<Char8>{buffer}) == 4);
+  }
+
+  SECTION("Hash")
+  {
+    u16StringView u16 = ptr_to<const Char16*>(u"STRASSE");
+    REQUIRE(casefold_hash("Straße"_UTF8) == casefold_hash(u16));
+    REQUIRE(casefold_hash(StringView{"strasse"}) == casefold_hash(u16));
+    REQUIRE(casefold_hash("\u212A"_UTF8) == casefold_hash(StringView{"K"}));
+    REQUIRE(casefold_hash("a"_UTF8) != casefold_hash("b"_UTF8));
+
+    // Chunks do not depend on the encoding
+    std::string a;
+    std::u16string b;
+    for (size_t i = 0; i < 50; i++)
+    {
+      a += "ab\xC3\x9F";
+      b += u"ABss";
+    }
+    const u8StringView va = {ptr_to<const Char8*>(a.data()), a.size()};
+    const u16StringView vb = {ptr_to<const Char16*>(b.data()), b.size()};
+    REQUIRE(casefold_hash<murmur64a_h>(va) == casefold_hash<murmur64a_h>(vb));
+    REQUIRE(casefold_hash(va) == casefold_hash(vb));
+  }
+
+  SECTION("Map")
+  {
+    Map<u8StringView, int, CaseFoldHash<>, CaseFoldEqual> map;
+    map.insert({"while"_UTF8, 0});
+    map.insert({"Straße"_UTF8, 1});
+    REQUIRE(map.find("WHILE"_UTF8)->second == 0);
+    REQUIRE(map.find("STRASSE"_UTF8)->second == 1);
+    // Heterogeneous lookups
+    REQUIRE(map.find(StringView{"While"})->second == 0);
+    REQUIRE(map.find(u16StringView{ptr_to<const Char16*>(u"strasse")})->second == 1);
+    REQUIRE(map.find("for"_UTF8) == map.end());
+
+    Set<u8StringView, CaseFoldHash<>, CaseFoldEqual> set;
+    set.insert("Σ"_UTF8);
+    REQUIRE(set.contains("σ"_UTF8));
+    REQUIRE(set.contains(StringView{"x"}) == false);
+  }
+}
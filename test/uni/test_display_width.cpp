@@ -0,0 +1,121 @@
+/*****************************************************************/ /**
+ * @file   test_display_width.cpp
+ * @brief  Unit tests for `display_width`, `offset_to_column` and
+ *         `column_to_offset`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/unicode/display_width.h>
+#include <random>
+#include <string>
+
+TEST_CASE("Display Width")
+{
+  using namespace clt;
+  using namespace clt::uni;
+
+  SECTION("Code Points")
+  {
+    STATIC_REQUIRE(display_width(U'a') == 1);
+    STATIC_REQUIRE(display_width(U'\t') == 0);
+    STATIC_REQUIRE(display_width(U'\0') == 0);
+    STATIC_REQUIRE(display_width(U'é') == 1);
+    // Combining marks, zero width joiner, variation selectors
+    STATIC_REQUIRE(display_width(U'́') == 0);
+    STATIC_REQUIRE(display_width(U'‍') == 0);
+    STATIC_REQUIRE(display_width(U'️') == 0);
+    STATIC_REQUIRE(display_width(U'­') == 1);
+    // Hangul: leading consonants are wide, vowels and finals are 0
+    STATIC_REQUIRE(display_width(U'ᄀ') == 2);
+    STATIC_REQUIRE(display_width(U'ᅡ') == 0);
+    STATIC_REQUIRE(display_width(U'가') == 2);
+    // CJK, fullwidth forms and emoji
+    STATIC_REQUIRE(display_width(U'中') == 2);
+    STATIC_REQUIRE(display_width(U'Ａ') == 2);
+    STATIC_REQUIRE(display_width(U'\U0001F600') == 2);
+    STATIC_REQUIRE(display_width(U'❤') == 1);
+    // Unassigned code points of the CJK blocks are wide
+    STATIC_REQUIRE(display_width(U'\U0003FFFD') == 2);
+  }
+
+  SECTION("Views")
+  {
+    STATIC_REQUIRE(display_width(StringView{"abc"}) == 3);
+    STATIC_REQUIRE(display_width(StringView{"a\tb"}) == 2);
+    STATIC_REQUIRE(display_width(u8StringView{"a中́b"_UTF8}) == 4);
+    STATIC_REQUIRE(display_width(u8StringView{}) == 0);
+    REQUIRE(display_width(u8StringView{"\U0001F600 ok"_UTF8}) == 5);
+    REQUIRE(display_width(u16StringView{"été"_UTF16}) == 3);
+    REQUIRE(display_width(u32StringView{"中文"_UTF32}) == 4);
+
+    // Long runs of ASCII are counted using SIMD
+    std::string line(1000, 'x');
+    line[500] = '\t';
+    line += "中";
+    const u8StringView view = {ptr_to<const Char8*>(line.data()), line.size()};
+    REQUIRE(display_width(view) == 1001);
+    REQUIRE(display_width(StringView{line.data(), 1000}) == 999);
+  }
+
+  SECTION("Printable ASCII")
+  {
+    // Every length and position of the first non-printable byte
+    std::mt19937 rng{7};
+    std::u8string bytes(200, u8'a');
+    for (auto& c : bytes)
+      c = static_cast<char8_t>(0x20 + rng() % 0x5F);
+    for (size_t size = 0; size <= 130; size++)
+    {
+      const char8_t* begin = bytes.data() + 3;
+      REQUIRE(uni::details::find_nonprint8(begin, begin + size) == begin + size);
+      for (char8_t stop : {u8'\0', u8'\x1F', u8'\x7F', u8'\x80', u8'\xFF'})
+      {
+        for (size_t i = 0; i < size; i++)
+        {
+          std::u8string copy = bytes;
+          copy[3 + i]        = stop;
+          const char8_t* ptr = copy.data() + 3;
+          REQUIRE(uni::details::find_nonprint8(ptr, ptr + size) == ptr + i);
+        }
+      }
+    }
+  }
+
+  SECTION("Columns")
+  {
+    // 'a' (0), 'e' + U+0301 (1), U+4E2D (2, 3), 'b' (4)
+    constexpr u8StringView line = "aé中b"_UTF8;
+    STATIC_REQUIRE(offset_to_column(line, 0) == 0);
+    STATIC_REQUIRE(offset_to_column(line, 1) == 1);
+    STATIC_REQUIRE(offset_to_column(line, 4) == 2);
+    STATIC_REQUIRE(offset_to_column(line, 7) == 4);
+    STATIC_REQUIRE(offset_to_column(line, 8) == 5);
+    STATIC_REQUIRE(column_to_offset(line, 0) == 0);
+    STATIC_REQUIRE(column_to_offset(line, 1) == 1);
+    STATIC_REQUIRE(column_to_offset(line, 2) == 4);
+    STATIC_REQUIRE(column_to_offset(line, 3) == 4);
+    STATIC_REQUIRE(column_to_offset(line, 4) == 7);
+    STATIC_REQUIRE(column_to_offset(line, 5) == 8);
+    STATIC_REQUIRE(column_to_offset(line, 100) == 8);
+
+    // Runtime (SIMD) and constant evaluation agree
+    std::string str;
+    for (size_t i = 0; i < 40; i++)
+      str += i % 7 == 0 ? "中" : (i % 5 == 0 ? "é" : "abcdefgh");
+    const u8StringView view = {ptr_to<const Char8*>(str.data()), str.size()};
+    const size_t width      = display_width(view);
+    size_t offset           = 0;
+    for (size_t column = 0; column <= width; column++)
+    {
+      const size_t next = column_to_offset(view, column);
+      REQUIRE(next >= offset);
+      offset = next;
+      REQUIRE(offset_to_column(view, offset) <= column);
+      REQUIRE(offset_to_column(view, offset) + 1 >= column);
+    }
+    REQUIRE(offset == view.unit_len());
+    REQUIRE(column_to_offset(view, width) == view.unit_len());
+  }
+}
@@ -0,0 +1,166 @@
+/*****************************************************************/ /**
+ * @file   test_grapheme.cpp
+ * @brief  Unit tests for `GraphemeIterator`.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/unicode/grapheme.h>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "grapheme_break_test.h"
+
+/// @brief Returns the unit length of each cluster of 'view'
+template<clt::StringEncoding ENCODING>
+static std::vector<size_t> cluster_sizes(clt::BasicStringView<ENCODING> view)
+{
+  std::vector<size_t> ret;
+  for (auto cluster : clt::uni::graphemes(view))
+    ret.push_back(cluster.unit_len());
+  return ret;
+}
+
+/// @brief Returns the unit length of each cluster of 'view'
+static std::vector<size_t> cluster_sizes(clt::u8StringView view)
+{
+  return cluster_sizes<clt::StringEncoding::UTF8>(view);
+}
+
+/// @brief A vector of GraphemeBreakTest.txt, encoded in UTF8 and UTF16
+struct GraphemeBreakVector
+{
+  /// @brief The text in UTF8
+  std::string utf8;
+  /// @brief The text in UTF16
+  std::u16string utf16;
+  /// @brief The unit length of each cluster in UTF8
+  std::vector<size_t> utf8_sizes;
+  /// @brief The unit length of each cluster in UTF16
+  std::vector<size_t> utf16_sizes;
+};
+
+/// @brief Parses a vector of GraphemeBreakTest.txt
+/// @param vector The vector (see grapheme_break_test.h)
+/// @return The text and the expected clusters
+static GraphemeBreakVector parse_break_vector(const char* vector)
+{
+  GraphemeBreakVector ret;
+  std::istringstream stream{vector};
+  std::string token;
+  size_t utf8_begin = 0, utf16_begin = 0;
+  while (stream >> token)
+  {
+    if (token == "x")
+      continue;
+    if (token == "/")
+    {
+      if (ret.utf8.size() != utf8_begin)
+      {
+        ret.utf8_sizes.push_back(ret.utf8.size() - utf8_begin);
+        ret.utf16_sizes.push_back(ret.utf16.size() - utf16_begin);
+      }
+      utf8_begin  = ret.utf8.size();
+      utf16_begin = ret.utf16.size();
+      continue;
+    }
+    const auto cp = static_cast<char32_t>(std::stoul(token, nullptr, 16));
+    if (cp < 0x80)
+      ret.utf8 += static_cast<char>(cp);
+    else if (cp < 0x800)
+    {
+      ret.utf8 += static_cast<char>(0xC0 | (cp >> 6));
+      ret.utf8 += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else if (cp < 0x10000)
+    {
+      ret.utf8 += static_cast<char>(0xE0 | (cp >> 12));
+      ret.utf8 += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      ret.utf8 += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else
+    {
+      ret.utf8 += static_cast<char>(0xF0 | (cp >> 18));
+      ret.utf8 += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+      ret.utf8 += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      ret.utf8 += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    if (cp < 0x10000)
+      ret.utf16 += static_cast<char16_t>(cp);
+    else
+    {
+      ret.utf16 += static_cast<char16_t>(0xD800 + ((cp - 0x10000) >> 10));
+      ret.utf16 += static_cast<char16_t>(0xDC00 + ((cp - 0x10000) & 0x3FF));
+    }
+  }
+  return ret;
+}
+
+TEST_CASE("Grapheme Iterator")
+{
+  using namespace clt;
+  using namespace clt::uni;
+  using sizes = std::vector<size_t>;
+
+  SECTION("ASCII")
+  {
+    REQUIRE(cluster_sizes(u8StringView{}).empty());
+    REQUIRE(cluster_sizes("abc"_UTF8) == sizes{1, 1, 1});
+    REQUIRE(cluster_sizes("a\r\nb\n\r"_UTF8) == sizes{1, 2, 1, 1, 1});
+    REQUIRE(cluster_sizes(StringView{"a\r\nb"}) == sizes{1, 2, 1});
+    STATIC_REQUIRE(grapheme_count(StringView{"a\r\nb"}) == 3);
+    // Long runs of ASCII are skipped using SIMD
+    std::string run(100, 'x');
+    run += "\r\n";
+    std::vector<size_t> expected(100, 1);
+    expected.push_back(2);
+    REQUIRE(cluster_sizes(u8StringView{ptr_to<const Char8*>(run.data()), run.size()})
+            == expected);
+  }
+
+  SECTION("UTF8")
+  {
+    // ASCII followed by a combining mark is not split (GB9)
+    REQUIRE(cluster_sizes("ae\u0301a"_UTF8) == sizes{1, 3, 1});
+    // Emoji ZWJ sequence (GB11) followed by flags (GB12, GB13)
+    const u8StringView emoji = "\U0001F469\u200D\U0001F680\U0001F1EB"
+                               "\U0001F1F7\U0001F1E8"_UTF8;
+    REQUIRE(cluster_sizes(emoji) == sizes{11, 8, 4});
+    // Hangul syllables (GB6, GB7, GB8)
+    REQUIRE(cluster_sizes("\u1100\u1161\u11A8\uAC00"_UTF8) == sizes{9, 3});
+    // Devanagari conjunct (GB9c)
+    REQUIRE(cluster_sizes("\u0915\u094D\u0937a"_UTF8) == sizes{9, 1});
+    // Controls are always split (GB4, GB5)
+    REQUIRE(cluster_sizes("\u0301\n\u0301"_UTF8) == sizes{2, 1, 2});
+
+    const u8StringView b = "e\u0301\U0001F44D\U0001F3FD!"_UTF8;
+    REQUIRE(grapheme_count(b) == 3);
+  }
+
+  SECTION("UTF16")
+  {
+    u16StringView a = ptr_to<const Char16*>(
+        u"a\u0301\U0001F469\u200D\U0001F680\U0001F1EB\U0001F1F7\r\n");
+    REQUIRE(cluster_sizes(a) == sizes{2, 5, 4, 2});
+    auto it = graphemes(a).begin();
+    REQUIRE((*it)[0] == U'a');
+    REQUIRE((*++it)[0] == U'\U0001F469');
+    REQUIRE(it.current() == a.data() + 2);
+  }
+
+  SECTION("GraphemeBreakTest")
+  {
+    for (const char* vector : GRAPHEME_BREAK_TESTS)
+    {
+      INFO(vector);
+      const auto test = parse_break_vector(vector);
+      const auto utf8 =
+          u8StringView{ptr_to<const Char8*>(test.utf8.data()), test.utf8.size()};
+      const auto utf16 = u16StringView{
+          ptr_to<const Char16*>(test.utf16.data()), test.utf16.size()};
+      REQUIRE(cluster_sizes(utf8) == test.utf8_sizes);
+      REQUIRE(cluster_sizes(utf16) == test.utf16_sizes);
+    }
+  }
+}
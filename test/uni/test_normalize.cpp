@@ -0,0 +1,125 @@
+/*****************************************************************/ /**
+ * @file   test_normalize.cpp
+ * @brief  Unit tests for the canonical normalization forms.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/unicode/normalize.h>
+#include <string>
+
+/// @brief Returns the UTF8 view of a std::string
+static clt::u8StringView as_u8(const std::string& str)
+{
+  return {clt::ptr_to<const clt::Char8*>(str.data()), str.size()};
+}
+
+TEST_CASE("Unicode Normalization")
+{
+  using namespace clt;
+  using namespace clt::uni;
+  const auto& alloc = mem::GlobalAllocator;
+
+  SECTION("Quick Check")
+  {
+    STATIC_REQUIRE(quick_check<NFC>(StringView{"abc"}) == QuickCheck::YES);
+    STATIC_REQUIRE(quick_check<NFC>(u8StringView{}) == QuickCheck::YES);
+    REQUIRE(quick_check<NFC>("caf\u00E9 \u00C0 \u00FF"_UTF8) == QuickCheck::YES);
+    REQUIRE(quick_check<NFD>("caf\u00E9"_UTF8) == QuickCheck::NO);
+    REQUIRE(quick_check<NFD>("cafe\u0301"_UTF8) == QuickCheck::YES);
+    // U+0301 may compose with the previous code point
+    REQUIRE(quick_check<NFC>("cafe\u0301"_UTF8) == QuickCheck::MAYBE);
+    // U+212B (ANGSTROM SIGN) is a singleton that never appears in NFC
+    REQUIRE(quick_check<NFC>("\u212B"_UTF8) == QuickCheck::NO);
+    // Combining marks out of canonical order
+    REQUIRE(quick_check<NFD>("a\u0301\u0316"_UTF8) == QuickCheck::NO);
+    REQUIRE(quick_check<NFD>("a\u0316\u0301"_UTF8) == QuickCheck::YES);
+    const u16StringView utf16 = ptr_to<const Char16*>(u"x\u00E9\u212B");
+    REQUIRE(quick_check<NFC>(utf16) == QuickCheck::NO);
+
+    // Long runs of code points below U+0300 are skipped using SIMD
+    std::string run;
+    for (size_t i = 0; i < 40; i++)
+      run += "\u00E9a\u02FF";
+    REQUIRE(quick_check<NFC>(as_u8(run)) == QuickCheck::YES);
+    REQUIRE(quick_check<NFD>(as_u8(run)) == QuickCheck::NO);
+    REQUIRE(quick_check<NFC>(as_u8(run + "\u0300")) == QuickCheck::MAYBE);
+  }
+
+  SECTION("Unchanged")
+  {
+    const u8StringView view = "caf\u00E9 \u4E2D\u6587 \U0001F600"_UTF8;
+    auto nfc                = normalize<NFC>(view, alloc);
+    REQUIRE(!nfc.is_allocated());
+    REQUIRE((*nfc).data() == view.data());
+    REQUIRE((*nfc).unit_len() == view.unit_len());
+
+    // Fails the quick check (MAYBE) but is already normalized
+    const u8StringView maybe = "b\u0300"_UTF8;
+    REQUIRE(quick_check<NFC>(maybe) == QuickCheck::MAYBE);
+    auto nfc2 = normalize<NFC>(maybe, alloc);
+    REQUIRE(!nfc2.is_allocated());
+    REQUIRE((*nfc2).data() == maybe.data());
+    REQUIRE(is_normalized<NFC>(maybe, alloc));
+    REQUIRE(!is_normalized<NFC>("e\u0301"_UTF8, alloc));
+    REQUIRE(!is_normalized<NFD>("\u00E9"_UTF8, alloc));
+  }
+
+  SECTION("NFC")
+  {
+    // The prefix before the first boundary is copied as is
+    auto a = normalize<NFC>("caf\u00E9 cafe\u0301"_UTF8, alloc);
+    REQUIRE(a.is_allocated());
+    REQUIRE(*a == "caf\u00E9 caf\u00E9"_UTF8);
+    // Singletons are replaced by their decomposition
+    REQUIRE(*normalize<NFC>("\u212B"_UTF8, alloc) == "\u00C5"_UTF8);
+    // U+0316 is reordered before U+0301, which then composes
+    REQUIRE(*normalize<NFC>("a\u0301\u0316"_UTF8, alloc) == "\u00E1\u0316"_UTF8);
+    // Two marks of the same class: only the first one composes
+    REQUIRE(*normalize<NFC>("a\u0301\u0300"_UTF8, alloc) == "\u00E1\u0300"_UTF8);
+    // Hangul syllables (L V T and LV T)
+    REQUIRE(
+        *normalize<NFC>("\u1100\u1161\u11A8 \uAC00\u11A8"_UTF8, alloc)
+        == "\uAC01 \uAC01"_UTF8);
+    // Composition of two starters
+    REQUIRE(*normalize<NFC>("\u0B47\u0B3E"_UTF8, alloc) == "\u0B4B"_UTF8);
+  }
+
+  SECTION("NFD")
+  {
+    REQUIRE(*normalize<NFD>("\u00E9"_UTF8, alloc) == "e\u0301"_UTF8);
+    // Recursive decomposition, in canonical order
+    REQUIRE(*normalize<NFD>("\u1E69"_UTF8, alloc) == "s\u0323\u0307"_UTF8);
+    REQUIRE(*normalize<NFD>("\uAC01"_UTF8, alloc) == "\u1100\u1161\u11A8"_UTF8);
+    REQUIRE(*normalize<NFD>("a\u0301\u0316"_UTF8, alloc) == "a\u0316\u0301"_UTF8);
+  }
+
+  SECTION("UTF16 and UTF32")
+  {
+    const u16StringView a = ptr_to<const Char16*>(u"Caf\u00E9\u212B");
+    auto nfd              = normalize<NFD>(a, alloc);
+    REQUIRE(*nfd == u16StringView{ptr_to<const Char16*>(u"Cafe\u0301A\u030A")});
+    const u32StringView b = ptr_to<const Char32*>(U"e\u0301\u1100\u1161");
+    auto nfc              = normalize<NFC>(b, alloc);
+    REQUIRE(*nfc == u32StringView{ptr_to<const Char32*>(U"\u00E9\uAC00")});
+  }
+
+  SECTION("Long Segments")
+  {
+    // Segments longer than the inline capacity are stored in the allocator
+    std::string str = "a";
+    std::string nfd = "a";
+    for (size_t i = 0; i < 40; i++)
+    {
+      str += "\u0301\u0316";
+      nfd += "\u0316";
+    }
+    for (size_t i = 0; i < 40; i++)
+      nfd += "\u0301";
+    REQUIRE(*normalize<NFD>(as_u8(str), alloc) == as_u8(nfd));
+    // Only the first U+0301 composes, the others are blocked by it
+    const std::string nfc = "\u00E1" + nfd.substr(1, nfd.size() - 3);
+    REQUIRE(*normalize<NFC>(as_u8(str), alloc) == as_u8(nfc));
+  }
+}
@@ -0,0 +1,62 @@
+/*****************************************************************/ /**
+ * @file   test_properties.cpp
+ * @brief  Unit tests for the Unicode property lookup tables.
+ *
+ * @author RPC
+ * @date   October 2026
+ *********************************************************************/
+#include "../includes.h"
+#include <colt/unicode/properties.h>
+
+TEST_CASE("Unicode Properties")
+{
+  using namespace clt::uni;
+
+  SECTION("Enumerated")
+  {
+    STATIC_REQUIRE(get<General_Category>(U'A') == General_Category::Lu);
+    STATIC_REQUIRE(get<gc>(U'a') == gc::Ll);
+    STATIC_REQUIRE(get<gc>(U'\U0001F600') == gc::So);
+    STATIC_REQUIRE(get<gc>(U'\U000E0080') == gc::Cn);
+    STATIC_REQUIRE(get<gc>(U'\xD800') == gc::Cs);
+    REQUIRE(get<gc>(0x10FFFF) == gc::Cn);
+    REQUIRE(get<gc>(0xFFFFFFFF) == gc::Cn);
+
+    REQUIRE(get<Script>(U'α') == Script::Greek);
+    REQUIRE(get<Script>(U'a') == Script::Latin);
+    REQUIRE(get<Script>(U'无') == Script::Han);
+    REQUIRE(get<East_Asian_Width>(U'无') == East_Asian_Width::W);
+    REQUIRE(get<East_Asian_Width>(0x3FFFD) == East_Asian_Width::W);
+    REQUIRE(get<East_Asian_Width>(U'a') == East_Asian_Width::Na);
+    REQUIRE(get<Grapheme_Cluster_Break>(U'\r') == Grapheme_Cluster_Break::CR);
+    REQUIRE(get<Grapheme_Cluster_Break>(U'a') == Grapheme_Cluster_Break::XX);
+    REQUIRE(get<Bidi_Class>(U'a') == Bidi_Class::L);
+    REQUIRE(get<Bidi_Class>(0x05FF) == Bidi_Class::R);
+    REQUIRE(get<Canonical_Combining_Class>(0x0301) == Canonical_Combining_Class::A);
+    REQUIRE(get<NFC_Quick_Check>(0x0301) == NFC_Quick_Check::M);
+    REQUIRE(get<Hangul_Syllable_Type>(0xAC00) == Hangul_Syllable_Type::LV);
+  }
+
+  SECTION("Binary")
+  {
+    STATIC_REQUIRE(has<XID_Start>(U'a'));
+    STATIC_REQUIRE(!has<XID_Start>(U'_'));
+    STATIC_REQUIRE(has<XID_Continue>(U'_'));
+    STATIC_REQUIRE(get<XID_Continue>(U'0') == XID_Continue::Y);
+    STATIC_REQUIRE(get<XID_Start>(U'0') == XID_Start::N);
+    REQUIRE(has<XID_Start>(U'α'));
+    REQUIRE(has<XID_Start>(U'无'));
+    REQUIRE(!has<XID_Start>(U'\U0001F600'));
+    REQUIRE(has<Extended_Pictographic>(U'\U0001F600'));
+    REQUIRE(has<White_Space>(U' '));
+    REQUIRE(has<White_Space>(0x3000));
+    REQUIRE(!has<White_Space>(U'a'));
+    REQUIRE(has<Pattern_Syntax>(U'+'));
+    REQUIRE(has<Uppercase>(U'A'));
+    REQUIRE(!has<Lowercase>(U'A'));
+    REQUIRE(has<Hex_Digit>(U'f'));
+    REQUIRE(has<Changes_When_Casefolded>(U'A'));
+    REQUIRE(has<Bidi_Mirrored>(U'('));
+    REQUIRE(!has<Bidi_Mirrored>(U'a'));
+  }
+}
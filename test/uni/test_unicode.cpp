@@ -7,6 +7,9 @@
  *********************************************************************/
 #include "../includes.h"
 #include <colt/unicode/unicode.h>
+#include <colt/unicode/transcode.h>
+#include <vector>
+#include <string_view>
 
 // Using COLT_FOR_EACH, we can generate a test for each of the strings below.
 // COLT_CONCAT(x, ...) is used to concatenate the string literal (u8, u, U).
@@ -145,6 +148,9 @@ TEST_CASE("Unicode Count and Middle")
     TEST_MIDDLE(u8"abc\u1100\u1100\u1100", 2);
     TEST_MIDDLE(u8"\u1100\u1100\u1100abcd", 9);
     TEST_MIDDLE(u8"\u1100\u1100\u1100abcdf", 9);
+    // The constant evaluated version must match the SIMD versions
+    STATIC_REQUIRE(count_and_middle(u8"ab\u1100\u1100\u1100", 11).second == 5);
+    STATIC_REQUIRE(count_and_middle(u8"abc\u1100\u1100\u1100", 12).second == 2);
   }
 
 #undef TEST_MIDDLE
@@ -302,6 +308,407 @@ TEST_CASE("Unicode UTF32 to UTF8")
   }
 }
 
+/// @brief Transcodes 'from' to 'To', checking that 'transcode_size' is exact
+template<clt::meta::CharType To, clt::meta::CharType From>
+static std::vector<To> transcode_checked(std::span<const From> from)
+{
+  using namespace clt;
+  auto size = uni::transcode_size<To>(from);
+  REQUIRE(size.is_expect());
+  std::vector<To> ret(*size);
+  auto written = uni::transcode(from, Span<To>{ret});
+  REQUIRE(written.is_expect());
+  REQUIRE(*written == *size);
+  return ret;
+}
+
+/// @brief Check that two unit sequences are bitwise equal
+template<typename T, typename U>
+static bool same_units(std::span<const T> a, const U* b, size_t b_size)
+{
+  return a.size() == b_size && sizeof(T) == sizeof(U)
+         && std::memcmp(a.data(), b, b_size * sizeof(U)) == 0;
+}
+
+TEST_CASE("Unicode Transcode")
+{
+  using namespace clt;
+  using namespace clt::uni;
+
+#define TEST_TRANSCODE(value)                                                  \
+  {                                                                            \
+    const auto size8  = (sizeof COLT_CONCAT(u8, value)) / sizeof(char8_t) - 1; \
+    const auto size16 = (sizeof COLT_CONCAT(u, value)) / sizeof(char16_t) - 1; \
+    const auto size32 = (sizeof COLT_CONCAT(U, value)) / sizeof(char32_t) - 1; \
+    auto from8 = View<Char8>{ptr_to<const Char8*>(COLT_CONCAT(u8, value)), size8}; \
+    auto to16  = transcode_checked<Char16>(from8);                             \
+    auto to32  = transcode_checked<Char32>(from8);                             \
+    REQUIRE(same_units(View<Char16>{to16}, COLT_CONCAT(u, value), size16));    \
+    REQUIRE(same_units(View<Char32>{to32}, COLT_CONCAT(U, value), size32));    \
+    auto to16o = transcode_checked<Char16Other>(View<Char32>{to32});           \
+    auto to32o = transcode_checked<Char32Other>(View<Char16Other>{to16o});     \
+    auto back  = transcode_checked<Char16>(View<Char32Other>{to32o});          \
+    REQUIRE(same_units(View<Char16>{back}, COLT_CONCAT(u, value), size16));    \
+    auto back8 = transcode_checked<Char8>(View<Char16Other>{to16o});           \
+    REQUIRE(same_units(View<Char8>{back8}, COLT_CONCAT(u8, value), size8));    \
+    back8 = transcode_checked<Char8>(View<Char32Other>{to32o});                \
+    REQUIRE(same_units(View<Char8>{back8}, COLT_CONCAT(u8, value), size8));    \
+  }
+
+  SECTION("Round Trip")
+  {
+    // TEST_STRING expects a prefix, so it is inlined here
+    TEST_TRANSCODE("\u000D");
+    TEST_TRANSCODE("±");
+    TEST_TRANSCODE("κόσμε");
+    TEST_TRANSCODE("ʈę࠵ิț");
+    TEST_TRANSCODE("");
+    TEST_TRANSCODE("0123456789");
+    TEST_TRANSCODE("a\U0001F600b\U0010FFFF߿ࠀ￿\U00010000");
+    TEST_TRANSCODE(
+        "1234567890123456789012345678901234567890无可\U0001F600否");
+  }
+
+  SECTION("Non-host UTF32 chunks")
+  {
+    // Longer than the chunks into which non-host UTF32 is swapped
+    std::vector<char32_t> str32;
+    for (size_t i = 0; i < 2000; i++)
+      str32.push_back(i % 3 == 0 ? U'\U0001F600' : U'a' + (i % 26));
+    const auto from =
+        View<Char32>{ptr_to<const Char32*>(str32.data()), str32.size()};
+    auto other = transcode_checked<Char32Other>(from);
+    auto to8   = transcode_checked<Char8>(View<Char32Other>{other});
+    auto back8 = transcode_checked<Char8>(from);
+    REQUIRE(same_units(View<Char8>{to8}, back8.data(), back8.size()));
+    auto to16 = transcode_checked<Char16>(View<Char32Other>{other});
+    REQUIRE(to16.size() == 2000 + 667);
+    auto back = transcode_checked<Char32>(View<Char16>{to16});
+    REQUIRE(same_units(View<Char32>{back}, str32.data(), str32.size()));
+
+    other[1500] = Char32Other(0xD800);
+    REQUIRE(
+        transcode_size<Char8>(View<Char32Other>{other}).error()
+        == ConvError::INVALID_INPUT);
+    std::vector<Char8> buffer8(to8.size() * 2);
+    REQUIRE(
+        transcode(View<Char32Other>{other}, Span<Char8>{buffer8}).error()
+        == ConvError::INVALID_INPUT);
+  }
+
+#undef TEST_TRANSCODE
+
+  SECTION("ASCII")
+  {
+    const char ascii[] = "Hello World!";
+    auto from          = View<char>{ascii, sizeof ascii - 1};
+    auto to8           = transcode_checked<Char8>(from);
+    REQUIRE(same_units(View<Char8>{to8}, u8"Hello World!", sizeof ascii - 1));
+    auto to32 = transcode_checked<Char32BE>(from);
+    auto back = transcode_checked<char>(View<Char32BE>{to32});
+    REQUIRE(same_units(View<char>{back}, ascii, sizeof ascii - 1));
+
+    auto non_ascii = View<Char8>{ptr_to<const Char8*>(u8"a±"), 3};
+    REQUIRE(transcode_size<char>(non_ascii).error() == ConvError::INVALID_INPUT);
+    const char invalid[] = "\x80";
+    REQUIRE(
+        transcode_size<Char16>(View<char>{invalid, 1}).error()
+        == ConvError::INVALID_INPUT);
+  }
+
+  SECTION("INVALID")
+  {
+    Char16 buffer16[16];
+    Char8 buffer8[16];
+    Char32Other buffer32[16];
+
+    // Truncated, overlong and surrogate UTF8
+    for (auto str : {u8"\xE2\x82", u8"\xC0\xAF", u8"\xED\xA0\x80", u8"\xF8"})
+    {
+      auto from = View<Char8>{
+          ptr_to<const Char8*>(str),
+          std::char_traits<char8_t>::length(str)};
+      REQUIRE(transcode_size<Char16>(from).error() == ConvError::INVALID_INPUT);
+      REQUIRE(
+          transcode(from, Span<Char16>{buffer16}).error()
+          == ConvError::INVALID_INPUT);
+      REQUIRE(
+          transcode(from, Span<Char32Other>{buffer32}).error()
+          == ConvError::INVALID_INPUT);
+    }
+
+    // Lone surrogates
+    const char16_t lone[] = {u'a', 0xD800, u'b'};
+    auto from16           = View<Char16>{ptr_to<const Char16*>(lone), 3};
+    REQUIRE(
+        transcode(from16, Span<Char8>{buffer8}).error() == ConvError::INVALID_INPUT);
+    const char32_t big[] = {U'a', 0x110000};
+    auto from32          = View<Char32>{ptr_to<const Char32*>(big), 2};
+    REQUIRE(
+        transcode(from32, Span<Char8>{buffer8}).error() == ConvError::INVALID_INPUT);
+  }
+
+  SECTION("NOT ENOUGH SPACE")
+  {
+    Char8 buffer8[4];
+    Char16Other buffer16[2];
+    auto from = View<Char32>{ptr_to<const Char32*>(U"ab\U0001F600"), 3};
+    REQUIRE(transcode_size<Char8>(from).value() == 6);
+    REQUIRE(
+        transcode(from, Span<Char8>{buffer8}).error()
+        == ConvError::NOT_ENOUGH_SPACE);
+    REQUIRE(
+        transcode(from, Span<Char16Other>{buffer16}).error()
+        == ConvError::NOT_ENOUGH_SPACE);
+    REQUIRE(transcode(from.subspan(0, 2), Span<Char8>{buffer8}).value() == 2);
+  }
+}
+
+TEST_CASE("Unicode Validate")
+{
+  using namespace clt;
+  using namespace clt::uni;
+
+  SECTION("VALID")
+  {
+    const char8_t str8[] =
+        u8"1234567890123456789012345678901234567890±无\U0001F600abc"
+        u8"ʈę࠵ิț\U0010FFFF";
+    const auto size8 = sizeof str8 / sizeof(char8_t) - 1;
+    auto len         = validate(ptr_to<const Char8*>(str8), size8);
+    REQUIRE(len.is_value());
+    REQUIRE(len->unitlen == size8);
+    REQUIRE(len->strlen == simdutf::count_utf8((const char*)str8, size8));
+
+    const char16_t str16[] =
+        u"1234567890123456789012345678901234567890±无\U0001F600abc";
+    const auto size16 = sizeof str16 / sizeof(char16_t) - 1;
+    auto len16        = validate(ptr_to<const Char16*>(str16), size16);
+    REQUIRE(len16.is_value());
+    REQUIRE(len16->unitlen == size16);
+    REQUIRE(len16->strlen == size16 - 1);
+    auto len16o = validate(MAKE_BE{} + str16, size16);
+    REQUIRE(len16o.is_value());
+    REQUIRE(len16o->strlen == size16 - 1);
+
+    REQUIRE(validate(ptr_to<const Char8*>(u8""), 0).is_value());
+    REQUIRE(validate("abc", 3)->strlen == 3);
+  }
+
+  SECTION("INVALID")
+  {
+    // Each invalid sequence is tested at every offset of a buffer
+    // bigger than the SIMD registers.
+    const std::u8string_view invalid[] = {
+        u8"\x80",         u8"\xC0\xAF",         u8"\xC1\xBF",     u8"\xE0\x80\xAF",
+        u8"\xED\xA0\x80", u8"\xF0\x80\x80\xAF", u8"\xF4\x90\x80\x80",
+        u8"\xF8\x88\x80", u8"\xE2\x82",         u8"\xC2\xC2",     u8"\xFF"};
+    for (auto seq : invalid)
+    {
+      for (size_t i = 0; i + seq.size() <= 96; i++)
+      {
+        char8_t buffer[96];
+        std::memset(buffer, 'a', sizeof buffer);
+        std::memcpy(buffer + i, seq.data(), seq.size());
+        REQUIRE(validate(ptr_to<const Char8*>(buffer), sizeof buffer).is_none());
+        // Truncated at the end of the input
+        REQUIRE(
+            validate(ptr_to<const Char8*>(buffer), i + seq.size()).is_none());
+      }
+    }
+
+    char16_t buffer16[70];
+    for (size_t i = 0; i < 70; i++)
+    {
+      std::fill(std::begin(buffer16), std::end(buffer16), u'a');
+      buffer16[i] = 0xDC00;
+      REQUIRE(validate(ptr_to<const Char16*>(buffer16), 70).is_none());
+      buffer16[i] = 0xD800;
+      REQUIRE(validate(ptr_to<const Char16*>(buffer16), 70).is_none());
+      REQUIRE(validate(ptr_to<const Char16*>(buffer16), i + 1).is_none());
+    }
+
+    const char32_t big[] = {U'a', 0x110000};
+    REQUIRE(validate(ptr_to<const Char32*>(big), 2).is_none());
+    REQUIRE(validate("\x80", 1).is_none());
+  }
+
+  SECTION("TWO BYTES")
+  {
+    // Compare all the 2-byte sequences with the scalar validation
+    char8_t buffer[40];
+    std::memset(buffer, 'a', sizeof buffer);
+    for (u32 i = 0; i < 0x10000; i++)
+    {
+      buffer[35] = static_cast<char8_t>(i >> 8);
+      buffer[36] = static_cast<char8_t>(i & 0xFF);
+      auto view  = std::span<const Char8>{ptr_to<const Char8*>(buffer), 40};
+      auto len   = validate(view.data(), view.size());
+      auto ref   = transcode_size<Char32BE>(view);
+      REQUIRE(len.is_value() == ref.is_expect());
+      if (len.is_value())
+        REQUIRE(len->strlen == *ref);
+    }
+  }
+}
+
+/// @brief Scalar count_and_middle, used as reference for the SIMD versions
+template<typename T>
+static std::pair<size_t, size_t> count_and_middle_scalar(const T* start, size_t size)
+{
+  using namespace clt::uni;
+  if (size == 0)
+    return {0, 0};
+  const auto end = start + size;
+  auto second    = start + size / 2;
+  if constexpr (std::same_as<T, clt::Char8>)
+  {
+    while (second != end && second->is_trail())
+      ++second;
+  }
+  else if (second != end && second->is_trail_surrogate())
+    ++second;
+  const auto lhs   = countlen(start, second - start);
+  const auto rhs   = countlen(second, end - second);
+  const auto count = lhs + rhs;
+  if (lhs < count / 2)
+    second = iterator_index_front(second, count / 2 - lhs);
+  else if (rhs < count / 2)
+    second = iterator_index_back(second, count / 2 - rhs);
+  if (count % 2 == 0 && count != 0)
+    second = iterator_index_back(second, 1);
+  return {count, second - start};
+}
+
+TEST_CASE("Unicode SIMD count_and_middle")
+{
+  using namespace clt;
+  using namespace clt::uni;
+
+  // Each length is tested with runs of code points of different
+  // lengths, so that the middle is reached both forward and backward.
+  const char32_t code_points[] = {U'a', U'±', U'无', U'\U0001F600'};
+  for (size_t length = 0; length < 200; length++)
+  {
+    for (size_t run = 1; run < 70; run += 17)
+    {
+      std::vector<Char32> str32;
+      for (size_t i = 0; i < length; i++)
+        str32.push_back(code_points[(i / run + length) % 4]);
+      auto str8    = transcode_checked<Char8>(View<Char32>{str32});
+      auto str16   = transcode_checked<Char16LE>(View<Char32>{str32});
+      auto str16be = transcode_checked<Char16BE>(View<Char32>{str32});
+
+      auto result = count_and_middle(str8.data(), str8.size());
+      REQUIRE(result.first == length);
+      REQUIRE(result == count_and_middle_scalar(str8.data(), str8.size()));
+      result = count_and_middle(str16.data(), str16.size());
+      REQUIRE(result.first == length);
+      REQUIRE(result == count_and_middle_scalar(str16.data(), str16.size()));
+      result = count_and_middle(str16be.data(), str16be.size());
+      REQUIRE(result.first == length);
+      REQUIRE(result == count_and_middle_scalar(str16be.data(), str16be.size()));
+    }
+  }
+}
+
+TEST_CASE("Unicode SIMD UTF16 offsets")
+{
+  using namespace clt;
+  using namespace clt::uni;
+
+  const char32_t code_points[] = {U'a', U'±', U'无', U'\U0001F600'};
+  for (size_t length = 0; length < 200; length++)
+  {
+    for (size_t run = 1; run < 70; run += 17)
+    {
+      std::vector<Char32> str32;
+      for (size_t i = 0; i < length; i++)
+        str32.push_back(code_points[(i / run + length) % 4]);
+      auto str8  = transcode_checked<Char8>(View<Char32>{str32});
+      auto str16 = transcode_checked<Char16>(View<Char32>{str32});
+
+      REQUIRE(utf16_len(str8.data(), str8.size()) == str16.size());
+      // Check each code point boundary against the transcoded prefix
+      size_t utf8 = 0, utf16 = 0;
+      for (auto cp : str32)
+      {
+        REQUIRE(utf16_len(str8.data(), utf8) == utf16);
+        REQUIRE(utf16_to_utf8_offset(str8.data(), str8.size(), utf16) == utf8);
+        const size_t units16 = cp.as_host() > 0xFFFF ? 2 : 1;
+        // Inside of the surrogate pair
+        if (units16 == 2)
+        {
+          REQUIRE(
+              utf16_to_utf8_offset(str8.data(), str8.size(), utf16 + 1) == utf8);
+        }
+        utf8 += sequence_length(str8.data()[utf8]);
+        utf16 += units16;
+      }
+      REQUIRE(
+          utf16_to_utf8_offset(str8.data(), str8.size(), utf16) == str8.size());
+      REQUIRE(
+          utf16_to_utf8_offset(str8.data(), str8.size(), utf16 + 10)
+          == str8.size());
+    }
+  }
+
+  constexpr auto STR = u8"a\u00b1\U0001F600\u65E0";
+  STATIC_REQUIRE(utf16_len(STR, 10) == 5);
+  STATIC_REQUIRE(utf16_to_utf8_offset(STR, 10, 3) == 3);
+  STATIC_REQUIRE(utf16_to_utf8_offset(STR, 10, 4) == 7);
+}
+
+TEST_CASE("Unicode Char Class")
+{
+  using namespace clt;
+  using namespace clt::uni;
+  using enum CharClass;
+
+  // Every byte and class against the scalar classifier,
+  // at every position of the SIMD blocks (and of the tail).
+  for (size_t cls = 0; cls < CHAR_CLASS_COUNT; cls++)
+  {
+    const auto char_class = static_cast<CharClass>(cls);
+    std::string str;
+    for (int i = 0; i < 128; i++)
+      if (is_of_class((char)i, char_class))
+        str.push_back((char)i);
+    for (size_t length = 0; length < 140; length++)
+    {
+      const std::string_view view = {str.data(), clt::min(length, str.size())};
+      REQUIRE(count_leading(view, char_class) == view.size());
+    }
+    for (int i = 0; i < 256; i++)
+    {
+      for (size_t position = 0; position < 130; position += 7)
+      {
+        std::string run(position, str[position % str.size()]);
+        run.push_back((char)i);
+        run += "    ";
+        const size_t expected =
+            position + (size_t)is_of_class((char)i, char_class);
+        REQUIRE(count_leading(run, char_class) >= expected);
+        if (!is_of_class((char)i, char_class))
+          REQUIRE(find_first_not(run, char_class) == run.data() + position);
+      }
+    }
+  }
+
+  // Non-ASCII characters use the property tables
+  std::string_view ident = reinterpret_cast<const char*>(
+      u8"h\u00E9llo_w\u00F6rld_\u65E0\u0661 + 1");
+  REQUIRE(count_leading(ident, IDENT_CONTINUE) == ident.find(' '));
+  REQUIRE(count_leading(ident, IDENT_START) == ident.find(' ') - 2);
+  REQUIRE(count_leading(ident, ALPHA) == 1 + 2 + 3);
+  std::string_view spaces =
+      reinterpret_cast<const char*>(u8"  \t\u3000\u00A0\n\u2028x");
+  REQUIRE(count_leading(spaces, SPACE) == spaces.size() - 1);
+  REQUIRE(count_leading(spaces, BLANK) == 2 + 1 + 3 + 2);
+  REQUIRE(count_leading("\xC3\x28", IDENT_CONTINUE) == 0);
+  REQUIRE(count_leading("", SPACE) == 0);
+}
+
 TEST_CASE("Unicode Indexing")
 {
   using namespace clt;